@@ -82,23 +82,13 @@ bool TrackSmearer::loadTable(int pdg, const char* filename, bool forceReload)
   const int nrad = mLUTHeader[ipdg]->radmap.nbins;
   const int neta = mLUTHeader[ipdg]->etamap.nbins;
   const int npt = mLUTHeader[ipdg]->ptmap.nbins;
-  mLUTEntry[ipdg] = new lutEntry_t****[nnch];
-  for (int inch = 0; inch < nnch; ++inch) {
-    mLUTEntry[ipdg][inch] = new lutEntry_t***[nrad];
-    for (int irad = 0; irad < nrad; ++irad) {
-      mLUTEntry[ipdg][inch][irad] = new lutEntry_t**[neta];
-      for (int ieta = 0; ieta < neta; ++ieta) {
-        mLUTEntry[ipdg][inch][irad][ieta] = new lutEntry_t*[npt];
-        for (int ipt = 0; ipt < npt; ++ipt) {
-          mLUTEntry[ipdg][inch][irad][ieta][ipt] = new lutEntry_t;
-          lutFile.read(reinterpret_cast<char*>(mLUTEntry[ipdg][inch][irad][ieta][ipt]), sizeof(lutEntry_t));
-          if (lutFile.gcount() != sizeof(lutEntry_t)) {
-            std::cout << " --- troubles reading covariance matrix entry for PDG " << pdg << ": " << filename << std::endl;
-            return false;
-          }
-        }
-      }
-    }
+  // the entries are stored in the file with the pt bin running fastest, as in the flat table
+  const std::size_t nEntries = static_cast<std::size_t>(nnch) * nrad * neta * npt;
+  mLUTEntry[ipdg].assign(nEntries, lutEntry_t{});
+  lutFile.read(reinterpret_cast<char*>(mLUTEntry[ipdg].data()), nEntries * sizeof(lutEntry_t));
+  if (static_cast<std::size_t>(lutFile.gcount()) != nEntries * sizeof(lutEntry_t)) {
+    std::cout << " --- troubles reading covariance matrix entry for PDG " << pdg << ": " << filename << std::endl;
+    return false;
   }
   std::cout << " --- read covariance matrix table for PDG " << pdg << ": " << filename << std::endl;
   mLUTHeader[ipdg]->print();
@@ -119,6 +109,7 @@ lutEntry_t*
   auto irad = mLUTHeader[ipdg]->radmap.find(radius);
   auto ieta = mLUTHeader[ipdg]->etamap.find(eta);
   auto ipt = mLUTHeader[ipdg]->ptmap.find(pt);
+  lutEntry_t* lutEntry = getLUTEntryAt(ipdg, inch, irad, ieta, ipt);
 
   // Interpolate if requested
   auto fraction = mLUTHeader[ipdg]->nchmap.fracPositionWithinBin(nch);
@@ -126,42 +117,42 @@ lutEntry_t*
     if (fraction > 0.5) {
       if (mWhatEfficiency == 1) {
         if (inch < mLUTHeader[ipdg]->nchmap.nbins - 1) {
-          interpolatedEff = (1.5f - fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff + (-0.5f + fraction) * mLUTEntry[ipdg][inch + 1][irad][ieta][ipt]->eff;
+          interpolatedEff = (1.5f - fraction) * lutEntry->eff + (-0.5f + fraction) * getLUTEntryAt(ipdg, inch + 1, irad, ieta, ipt)->eff;
         } else {
-          interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff;
+          interpolatedEff = lutEntry->eff;
         }
       }
       if (mWhatEfficiency == 2) {
         if (inch < mLUTHeader[ipdg]->nchmap.nbins - 1) {
-          interpolatedEff = (1.5f - fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2 + (-0.5f + fraction) * mLUTEntry[ipdg][inch + 1][irad][ieta][ipt]->eff2;
+          interpolatedEff = (1.5f - fraction) * lutEntry->eff2 + (-0.5f + fraction) * getLUTEntryAt(ipdg, inch + 1, irad, ieta, ipt)->eff2;
         } else {
-          interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2;
+          interpolatedEff = lutEntry->eff2;
         }
       }
     } else {
       float comparisonValue = mLUTHeader[ipdg]->nchmap.log ? log10(nch) : nch;
       if (mWhatEfficiency == 1) {
         if (inch > 0 && comparisonValue < mLUTHeader[ipdg]->nchmap.max) {
-          interpolatedEff = (0.5f + fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff + (0.5f - fraction) * mLUTEntry[ipdg][inch - 1][irad][ieta][ipt]->eff;
+          interpolatedEff = (0.5f + fraction) * lutEntry->eff + (0.5f - fraction) * getLUTEntryAt(ipdg, inch - 1, irad, ieta, ipt)->eff;
         } else {
-          interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff;
+          interpolatedEff = lutEntry->eff;
         }
       }
       if (mWhatEfficiency == 2) {
         if (inch > 0 && comparisonValue < mLUTHeader[ipdg]->nchmap.max) {
-          interpolatedEff = (0.5f + fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2 + (0.5f - fraction) * mLUTEntry[ipdg][inch - 1][irad][ieta][ipt]->eff2;
+          interpolatedEff = (0.5f + fraction) * lutEntry->eff2 + (0.5f - fraction) * getLUTEntryAt(ipdg, inch - 1, irad, ieta, ipt)->eff2;
         } else {
-          interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2;
+          interpolatedEff = lutEntry->eff2;
         }
       }
     }
   } else {
     if (mWhatEfficiency == 1)
-      interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff;
+      interpolatedEff = lutEntry->eff;
     if (mWhatEfficiency == 2)
-      interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2;
+      interpolatedEff = lutEntry->eff2;
   }
-  return mLUTEntry[ipdg][inch][irad][ieta][ipt];
+  return lutEntry;
 } //;
 
 /*****************************************************************/
@@ -228,6 +219,17 @@ bool TrackSmearer::smearTrack(O2Track& o2track, int pdg, float nch)
   return smearTrack(o2track, lutEntry, interpolatedEff);
 }
 
+/*****************************************************************/
+
+void TrackSmearer::smearTracks(std::vector<O2Track>& o2tracks, const std::vector<int>& pdgs, float nch, std::vector<bool>& isReconstructed)
+{
+  // tracks are smeared in their order, the random numbers are therefore the same as with smearTrack per track
+  isReconstructed.resize(o2tracks.size());
+  for (std::size_t iTrack = 0; iTrack < o2tracks.size(); ++iTrack) {
+    isReconstructed[iTrack] = smearTrack(o2tracks[iTrack], pdgs[iTrack], nch);
+  }
+}
+
 /*****************************************************************/
 // relative uncertainty on pt
 double TrackSmearer::getPtRes(int pdg, float nch, float eta, float pt)
@@ -27,6 +27,7 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "TRandom.h"
 #include "ReconstructionDataFormats/Track.h"
@@ -186,6 +187,8 @@ class TrackSmearer
 
   bool smearTrack(O2Track& o2track, lutEntry_t* lutEntry, float interpolatedEff);
   bool smearTrack(O2Track& o2track, int pdg, float nch);
+  /// Smears the tracks of the MC particles of a collision, isReconstructed is filled with the smearTrack result of each track
+  void smearTracks(std::vector<O2Track>& o2tracks, const std::vector<int>& pdgs, float nch, std::vector<bool>& isReconstructed);
   // bool smearTrack(Track& track, bool atDCA = true); // Only in DelphesO2
   double getPtRes(int pdg, float nch, float eta, float pt);
   double getEtaRes(int pdg, float nch, float eta, float pt);
@@ -222,7 +225,14 @@ class TrackSmearer
  protected:
   static constexpr unsigned int nLUTs = 8; // Number of LUT available
   lutHeader_t* mLUTHeader[nLUTs] = {nullptr};
-  lutEntry_t***** mLUTEntry[nLUTs] = {nullptr};
+  std::vector<lutEntry_t> mLUTEntry[nLUTs]; // entries of a LUT in one block, indexed (nch, radius, eta, pt) with the pt bin running fastest
+
+  lutEntry_t* getLUTEntryAt(int ipdg, int inch, int irad, int ieta, int ipt)
+  {
+    const lutHeader_t* header = mLUTHeader[ipdg];
+    return &mLUTEntry[ipdg][((static_cast<std::size_t>(inch) * header->radmap.nbins + irad) * header->etamap.nbins + ieta) * header->ptmap.nbins + ipt];
+  }
+
   bool mUseEfficiency = true;
   bool mInterpolateEfficiency = false;
   bool mSkipUnreconstructed = true; // don't smear tracks that are not reco'ed
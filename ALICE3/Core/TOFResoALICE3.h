@@ -60,13 +60,20 @@ class TOFResoALICE3 : public Parametrization
 
 float TOFResoALICE3Param(const float& momentum, const float& momentumError, const float& evtimereso, const float& length, const float& mass, const Parameters& parameters);
 
-template <o2::track::PID::ID id, typename T>
-float TOFResoALICE3ParamTrack(const T& track, const Parameters& parameters)
+/// Momentum resolution of a track used in the expected time resolution, it does not depend on the mass hypothesis
+template <typename T>
+float TOFResoALICE3MomentumError(const T& track)
 {
   const float BETA = tan(0.25f * static_cast<float>(M_PI) - 0.5f * atan(track.tgl()));
   const float sigmaP = sqrt(track.pt() * track.pt() * track.sigma1Pt() * track.sigma1Pt() + (BETA * BETA - 1.f) / (BETA * (BETA * BETA + 1.f)) * (track.tgl() / sqrt(track.tgl() * track.tgl() + 1.f) - 1.f) * track.sigmaTgl() * track.sigmaTgl());
   // const float sigmaP = std::sqrt( track.getSigma1Pt2() ) * track.pt();
-  return TOFResoALICE3Param(track.p(), sigmaP, track.collision().collisionTimeRes() * 1000.f, track.length(), o2::track::pid_constants::sMasses2Z[id], parameters);
+  return sigmaP;
+}
+
+template <o2::track::PID::ID id, typename T>
+float TOFResoALICE3ParamTrack(const T& track, const Parameters& parameters)
+{
+  return TOFResoALICE3Param(track.p(), TOFResoALICE3MomentumError(track), track.collision().collisionTimeRes() * 1000.f, track.length(), o2::track::pid_constants::sMasses2Z[id], parameters);
   // return TOFResoALICE3Param(track.p(), track.sigma1Pt(), collision.collisionTimeRes() * 1000.f, track.length(), o2::track::pid_constants::sMasses[id], parameters);
 }
 
@@ -130,6 +130,13 @@ struct OnTheFlyRichPid {
   std::vector<float> theta_min;
   std::vector<float> theta_max;
 
+  // Mass hypotheses: PDG codes, masses and Cherenkov threshold momenta, cached in init
+  static constexpr int kNHypotheses = 5;
+  static constexpr int lpdg_array[kNHypotheses] = {kElectron, kMuonMinus, kPiPlus, kKPlus, kProton};
+  int mHypothesisPdg[kNHypotheses];
+  float mHypothesisMass[kNHypotheses];
+  double mHypothesisThreshold[kNHypotheses];
+
   // Update projective geometry
   void updateProjectiveParameters()
   {
@@ -271,6 +278,14 @@ struct OnTheFlyRichPid {
 
     // Update projective parameters
     updateProjectiveParameters();
+
+    // Cache the mass hypotheses, so that the PDG database is not queried per track
+    for (int ii = 0; ii < kNHypotheses; ii++) {
+      auto pdgInfoThis = pdg->GetParticle(lpdg_array[ii]);
+      mHypothesisPdg[ii] = pdgInfoThis->PdgCode();
+      mHypothesisMass[ii] = pdgInfoThis->Mass();
+      mHypothesisThreshold[ii] = cherenkovThreshold(mHypothesisMass[ii]);
+    }
   }
 
   /// Function to convert a McParticle into a perfect Track
@@ -344,13 +359,29 @@ struct OnTheFlyRichPid {
     }
   }
 
+  /// returns the momentum threshold of the Cherenkov emission
+  /// \param mass the mass of the particle
+  double cherenkovThreshold(float mass)
+  {
+    return mass / std::sqrt(bRichRefractiveIndex * bRichRefractiveIndex - 1.0);
+  }
+
   /// returns Cherenkov angle in rad (above threshold) or bad flag (below threshold)
   /// \param momentum the momentum of the tarck
   /// \param mass the mass of the particle
   float CherenkovAngle(float momentum, float mass)
+  {
+    return CherenkovAngle(momentum, mass, cherenkovThreshold(mass));
+  }
+
+  /// returns Cherenkov angle in rad (above threshold) or bad flag (below threshold)
+  /// \param momentum the momentum of the tarck
+  /// \param mass the mass of the particle
+  /// \param threshold the momentum threshold of the Cherenkov emission for the mass
+  float CherenkovAngle(float momentum, float mass, double threshold)
   {
     // Check if particle is above the threshold
-    if (momentum > mass / std::sqrt(bRichRefractiveIndex * bRichRefractiveIndex - 1.0)) {
+    if (momentum > threshold) {
       // Calculate angle
       float angle = std::acos(std::sqrt(momentum * momentum + mass * mass) / (momentum * bRichRefractiveIndex));
 
@@ -385,9 +416,9 @@ struct OnTheFlyRichPid {
   float AngularResolution(float eta)
   {
     // Vectors for sampling (USE ANALYTICAL EXTRAPOLATION FOR BETTER RESULTS)
-    float eta_sampling[] = {-2.000000, -1.909740, -1.731184, -1.552999, -1.375325, -1.198342, -1.022276, -0.847390, -0.673976, -0.502324, -0.332683, -0.165221, 0.000000, 0.165221, 0.332683, 0.502324, 0.673976, 0.847390, 1.022276, 1.198342, 1.375325, 1.552999, 1.731184, 1.909740, 2.000000};
-    float res_ring_sampling_with_abs_walls[] = {0.0009165, 0.000977, 0.001098, 0.001198, 0.001301, 0.001370, 0.001465, 0.001492, 0.001498, 0.001480, 0.001406, 0.001315, 0.001241, 0.001325, 0.001424, 0.001474, 0.001480, 0.001487, 0.001484, 0.001404, 0.001273, 0.001197, 0.001062, 0.000965, 0.0009165};
-    float res_ring_sampling_without_abs_walls[] = {0.0009165, 0.000977, 0.001095, 0.001198, 0.001300, 0.001369, 0.001468, 0.001523, 0.001501, 0.001426, 0.001299, 0.001167, 0.001092, 0.001179, 0.001308, 0.001407, 0.001491, 0.001508, 0.001488, 0.001404, 0.001273, 0.001196, 0.001061, 0.000965, 0.0009165};
+    static constexpr float eta_sampling[] = {-2.000000, -1.909740, -1.731184, -1.552999, -1.375325, -1.198342, -1.022276, -0.847390, -0.673976, -0.502324, -0.332683, -0.165221, 0.000000, 0.165221, 0.332683, 0.502324, 0.673976, 0.847390, 1.022276, 1.198342, 1.375325, 1.552999, 1.731184, 1.909740, 2.000000};
+    static constexpr float res_ring_sampling_with_abs_walls[] = {0.0009165, 0.000977, 0.001098, 0.001198, 0.001301, 0.001370, 0.001465, 0.001492, 0.001498, 0.001480, 0.001406, 0.001315, 0.001241, 0.001325, 0.001424, 0.001474, 0.001480, 0.001487, 0.001484, 0.001404, 0.001273, 0.001197, 0.001062, 0.000965, 0.0009165};
+    static constexpr float res_ring_sampling_without_abs_walls[] = {0.0009165, 0.000977, 0.001095, 0.001198, 0.001300, 0.001369, 0.001468, 0.001523, 0.001501, 0.001426, 0.001299, 0.001167, 0.001092, 0.001179, 0.001308, 0.001407, 0.001491, 0.001508, 0.001488, 0.001404, 0.001273, 0.001196, 0.001061, 0.000965, 0.0009165};
     int size_res_vector = sizeof(eta_sampling) / sizeof(eta_sampling[0]);
     // Use binary search to find the lower and upper indices
     int lowerIndex = std::lower_bound(eta_sampling, eta_sampling + size_res_vector, eta) - eta_sampling - 1;
@@ -510,50 +541,62 @@ struct OnTheFlyRichPid {
       }
 
       // Straight to Nsigma
-      float deltaThetaBarrelRich[5], nSigmaBarrelRich[5];
-      int lpdg_array[5] = {kElectron, kMuonMinus, kPiPlus, kKPlus, kProton};
-      float masses[5];
-
-      for (int ii = 0; ii < 5; ii++) {
+      float deltaThetaBarrelRich[kNHypotheses], nSigmaBarrelRich[kNHypotheses];
+      for (int ii = 0; ii < kNHypotheses; ii++) {
         nSigmaBarrelRich[ii] = error_value;
+      }
 
-        auto pdgInfoThis = pdg->GetParticle(lpdg_array[ii]);
-        masses[ii] = pdgInfoThis->Mass();
-        float hypothesisAngleBarrelRich = CherenkovAngle(recoTrack.getP(), masses[ii]);
+      // The Nsigmas (and the resolution plots) are only defined for a measured ring
+      const bool flagRingMeasured = measuredAngleBarrelRich > error_value + 1. && barrelRICHAngularResolution > error_value + 1. && flagReachesRadiator;
+      const float recoMomentum = recoTrack.getP();
+      const float recoEta = recoTrack.getEta();
+      const float recoPt = recoMomentum / std::cosh(recoEta);
+      double recoPtResolution = 0., recoEtaResolution = 0.;
+      if (flagRingMeasured && flagIncludeTrackAngularRes && !flagRICHLoadDelphesLUTs) {
+        // independent of the mass hypothesis
+        recoPtResolution = std::pow(recoPt, 2) * std::sqrt(recoTrack.getSigma1Pt2());
+        recoEtaResolution = std::fabs(std::sin(2.0 * std::atan(std::exp(-recoEta)))) * std::sqrt(recoTrack.getSigmaTgl2());
+      }
+
+      for (int ii = 0; flagRingMeasured && ii < kNHypotheses; ii++) {
+        float hypothesisAngleBarrelRich = CherenkovAngle(recoMomentum, mHypothesisMass[ii], mHypothesisThreshold[ii]);
+        if (!(hypothesisAngleBarrelRich > error_value + 1.)) {
+          continue;
+        }
 
         // Evaluate total sigma (layer + tracking resolution)
         float barrelTotalAngularReso = barrelRICHAngularResolution;
         if (flagIncludeTrackAngularRes) {
-          double pt_resolution = std::pow(recoTrack.getP() / std::cosh(recoTrack.getEta()), 2) * std::sqrt(recoTrack.getSigma1Pt2());
-          double eta_resolution = std::fabs(std::sin(2.0 * std::atan(std::exp(-recoTrack.getEta())))) * std::sqrt(recoTrack.getSigmaTgl2());
+          double pt_resolution = recoPtResolution;
+          double eta_resolution = recoEtaResolution;
           if (flagRICHLoadDelphesLUTs) {
-            pt_resolution = mSmearer.getAbsPtRes(pdgInfoThis->PdgCode(), dNdEta, recoTrack.getEta(), recoTrack.getP() / std::cosh(recoTrack.getEta()));
-            eta_resolution = mSmearer.getAbsEtaRes(pdgInfoThis->PdgCode(), dNdEta, recoTrack.getEta(), recoTrack.getP() / std::cosh(recoTrack.getEta()));
+            pt_resolution = mSmearer.getAbsPtRes(mHypothesisPdg[ii], dNdEta, recoEta, recoPt);
+            eta_resolution = mSmearer.getAbsEtaRes(mHypothesisPdg[ii], dNdEta, recoEta, recoPt);
           }
           // cout << endl <<  "Pt resolution: " << pt_resolution << ", Eta resolution: " << eta_resolution << endl << endl;
-          float barrelTrackAngularReso = calculate_track_time_resolution_advanced(recoTrack.getP() / std::cosh(recoTrack.getEta()), recoTrack.getEta(), pt_resolution, eta_resolution, masses[ii], bRichRefractiveIndex);
+          float barrelTrackAngularReso = calculate_track_time_resolution_advanced(recoPt, recoEta, pt_resolution, eta_resolution, mHypothesisMass[ii], bRichRefractiveIndex);
           barrelTotalAngularReso = std::hypot(barrelRICHAngularResolution, barrelTrackAngularReso);
-          if (doQAplots && hypothesisAngleBarrelRich > error_value + 1. && measuredAngleBarrelRich > error_value + 1. && barrelRICHAngularResolution > error_value + 1. && flagReachesRadiator) {
-            float momentum = recoTrack.getP();
+          if (doQAplots) {
+            float momentum = recoMomentum;
             // float pseudorapidity = recoTrack.getEta();
             // float transverse_momentum = momentum / std::cosh(pseudorapidity);
-            if (ii == 0 && std::fabs(mcParticle.pdgCode()) == pdg->GetParticle(lpdg_array[0])->PdgCode()) {
+            if (ii == 0 && std::fabs(mcParticle.pdgCode()) == mHypothesisPdg[0]) {
               histos.fill(HIST("h2dBarrelAngularResTrackElecVsP"), momentum, 1000.0 * barrelTrackAngularReso);
               histos.fill(HIST("h2dBarrelAngularResTotalElecVsP"), momentum, 1000.0 * barrelTotalAngularReso);
             }
-            if (ii == 1 && std::fabs(mcParticle.pdgCode()) == pdg->GetParticle(lpdg_array[1])->PdgCode()) {
+            if (ii == 1 && std::fabs(mcParticle.pdgCode()) == mHypothesisPdg[1]) {
               histos.fill(HIST("h2dBarrelAngularResTrackMuonVsP"), momentum, 1000.0 * barrelTrackAngularReso);
               histos.fill(HIST("h2dBarrelAngularResTotalMuonVsP"), momentum, 1000.0 * barrelTotalAngularReso);
             }
-            if (ii == 2 && std::fabs(mcParticle.pdgCode()) == pdg->GetParticle(lpdg_array[2])->PdgCode()) {
+            if (ii == 2 && std::fabs(mcParticle.pdgCode()) == mHypothesisPdg[2]) {
               histos.fill(HIST("h2dBarrelAngularResTrackPionVsP"), momentum, 1000.0 * barrelTrackAngularReso);
               histos.fill(HIST("h2dBarrelAngularResTotalPionVsP"), momentum, 1000.0 * barrelTotalAngularReso);
             }
-            if (ii == 3 && std::fabs(mcParticle.pdgCode()) == pdg->GetParticle(lpdg_array[3])->PdgCode()) {
+            if (ii == 3 && std::fabs(mcParticle.pdgCode()) == mHypothesisPdg[3]) {
               histos.fill(HIST("h2dBarrelAngularResTrackKaonVsP"), momentum, 1000.0 * barrelTrackAngularReso);
               histos.fill(HIST("h2dBarrelAngularResTotalKaonVsP"), momentum, 1000.0 * barrelTotalAngularReso);
             }
-            if (ii == 4 && std::fabs(mcParticle.pdgCode()) == pdg->GetParticle(lpdg_array[4])->PdgCode()) {
+            if (ii == 4 && std::fabs(mcParticle.pdgCode()) == mHypothesisPdg[4]) {
               histos.fill(HIST("h2dBarrelAngularResTrackProtVsP"), momentum, 1000.0 * barrelTrackAngularReso);
               histos.fill(HIST("h2dBarrelAngularResTotalProtVsP"), momentum, 1000.0 * barrelTotalAngularReso);
             }
@@ -563,49 +606,47 @@ struct OnTheFlyRichPid {
         /// DISCLAIMER: here tracking is accounted only for momentum value, but not for track parameters at impact point on the
         ///             RICH radiator, since exact resolution would require photon generation and transport to photodetector.
         ///             Effects are expected to be negligible (a few tenths of a milliradian) but further studies are required !
-        if (hypothesisAngleBarrelRich > error_value + 1. && measuredAngleBarrelRich > error_value + 1. && barrelRICHAngularResolution > error_value + 1. && flagReachesRadiator) {
-          deltaThetaBarrelRich[ii] = hypothesisAngleBarrelRich - measuredAngleBarrelRich;
-          nSigmaBarrelRich[ii] = deltaThetaBarrelRich[ii] / barrelTotalAngularReso;
-        }
+        deltaThetaBarrelRich[ii] = hypothesisAngleBarrelRich - measuredAngleBarrelRich;
+        nSigmaBarrelRich[ii] = deltaThetaBarrelRich[ii] / barrelTotalAngularReso;
       }
 
       // Fill histograms
       if (doQAplots) {
-        float momentum = recoTrack.getP();
+        float momentum = recoMomentum;
         float barrelRichTheta = measuredAngleBarrelRich;
 
         if (barrelRichTheta > error_value + 1. && barrelRICHAngularResolution > error_value + 1. && flagReachesRadiator) {
           histos.fill(HIST("h2dAngleVsMomentumBarrelRICH"), momentum, barrelRichTheta);
 
-          if (std::fabs(mcParticle.pdgCode()) == pdg->GetParticle(lpdg_array[0])->PdgCode()) {
+          if (std::fabs(mcParticle.pdgCode()) == mHypothesisPdg[0]) {
             histos.fill(HIST("h2dBarrelNsigmaTrueElecVsElecHypothesis"), momentum, nSigmaBarrelRich[0]);
             histos.fill(HIST("h2dBarrelNsigmaTrueElecVsMuonHypothesis"), momentum, nSigmaBarrelRich[1]);
             histos.fill(HIST("h2dBarrelNsigmaTrueElecVsPionHypothesis"), momentum, nSigmaBarrelRich[2]);
             histos.fill(HIST("h2dBarrelNsigmaTrueElecVsKaonHypothesis"), momentum, nSigmaBarrelRich[3]);
             histos.fill(HIST("h2dBarrelNsigmaTrueElecVsProtHypothesis"), momentum, nSigmaBarrelRich[4]);
           }
-          if (std::fabs(mcParticle.pdgCode()) == pdg->GetParticle(lpdg_array[1])->PdgCode()) {
+          if (std::fabs(mcParticle.pdgCode()) == mHypothesisPdg[1]) {
             histos.fill(HIST("h2dBarrelNsigmaTrueMuonVsElecHypothesis"), momentum, nSigmaBarrelRich[0]);
             histos.fill(HIST("h2dBarrelNsigmaTrueMuonVsMuonHypothesis"), momentum, nSigmaBarrelRich[1]);
             histos.fill(HIST("h2dBarrelNsigmaTrueMuonVsPionHypothesis"), momentum, nSigmaBarrelRich[2]);
             histos.fill(HIST("h2dBarrelNsigmaTrueMuonVsKaonHypothesis"), momentum, nSigmaBarrelRich[3]);
             histos.fill(HIST("h2dBarrelNsigmaTrueMuonVsProtHypothesis"), momentum, nSigmaBarrelRich[4]);
           }
-          if (std::fabs(mcParticle.pdgCode()) == pdg->GetParticle(lpdg_array[2])->PdgCode()) {
+          if (std::fabs(mcParticle.pdgCode()) == mHypothesisPdg[2]) {
             histos.fill(HIST("h2dBarrelNsigmaTruePionVsElecHypothesis"), momentum, nSigmaBarrelRich[0]);
             histos.fill(HIST("h2dBarrelNsigmaTruePionVsMuonHypothesis"), momentum, nSigmaBarrelRich[1]);
             histos.fill(HIST("h2dBarrelNsigmaTruePionVsPionHypothesis"), momentum, nSigmaBarrelRich[2]);
             histos.fill(HIST("h2dBarrelNsigmaTruePionVsKaonHypothesis"), momentum, nSigmaBarrelRich[3]);
             histos.fill(HIST("h2dBarrelNsigmaTruePionVsProtHypothesis"), momentum, nSigmaBarrelRich[4]);
           }
-          if (std::fabs(mcParticle.pdgCode()) == pdg->GetParticle(lpdg_array[3])->PdgCode()) {
+          if (std::fabs(mcParticle.pdgCode()) == mHypothesisPdg[3]) {
             histos.fill(HIST("h2dBarrelNsigmaTrueKaonVsElecHypothesis"), momentum, nSigmaBarrelRich[0]);
             histos.fill(HIST("h2dBarrelNsigmaTrueKaonVsMuonHypothesis"), momentum, nSigmaBarrelRich[1]);
             histos.fill(HIST("h2dBarrelNsigmaTrueKaonVsPionHypothesis"), momentum, nSigmaBarrelRich[2]);
             histos.fill(HIST("h2dBarrelNsigmaTrueKaonVsKaonHypothesis"), momentum, nSigmaBarrelRich[3]);
             histos.fill(HIST("h2dBarrelNsigmaTrueKaonVsProtHypothesis"), momentum, nSigmaBarrelRich[4]);
           }
-          if (std::fabs(mcParticle.pdgCode()) == pdg->GetParticle(lpdg_array[4])->PdgCode()) {
+          if (std::fabs(mcParticle.pdgCode()) == mHypothesisPdg[4]) {
             histos.fill(HIST("h2dBarrelNsigmaTrueProtVsElecHypothesis"), momentum, nSigmaBarrelRich[0]);
             histos.fill(HIST("h2dBarrelNsigmaTrueProtVsMuonHypothesis"), momentum, nSigmaBarrelRich[1]);
             histos.fill(HIST("h2dBarrelNsigmaTrueProtVsPionHypothesis"), momentum, nSigmaBarrelRich[2]);
@@ -134,6 +134,13 @@ struct OnTheFlyTracker {
   std::vector<o2::InteractionRecord> bcData;
   o2::steer::InteractionSampler irSampler;
   o2::vertexing::PVertexer vertexer;
+  // vertexer inputs and outputs, kept between collisions to reuse their memory
+  std::vector<o2::MCCompLabel> lblTracks;
+  std::vector<o2::vertexing::PVertex> vertices;
+  std::vector<o2::vertexing::GIndex> vertexTrackIDs;
+  std::vector<o2::vertexing::V2TRef> v2tRefs;
+  std::vector<o2::MCEventLabel> lblVtx;
+  std::vector<o2::dataformats::GlobalTrackID> idxVec; // store IDs
 
   void init(o2::framework::InitContext&)
   {
@@ -304,6 +311,7 @@ struct OnTheFlyTracker {
     uint32_t multiplicityCounter = 0;
     histos.fill(HIST("hLUTMultiplicity"), dNdEta);
 
+    tracksAlice3.reserve(mcParticles.size());
     for (const auto& mcParticle : mcParticles) {
       if (!mcParticle.isPhysicalPrimary()) {
         continue;
@@ -317,13 +325,13 @@ struct OnTheFlyTracker {
       }
 
       histos.fill(HIST("hPtGenerated"), mcParticle.pt());
-      if (TMath::Abs(mcParticle.pdgCode()) == 11)
+      if (pdg == kElectron)
         histos.fill(HIST("hPtGeneratedEl"), mcParticle.pt());
-      if (TMath::Abs(mcParticle.pdgCode()) == 211)
+      else if (pdg == kPiPlus)
         histos.fill(HIST("hPtGeneratedPi"), mcParticle.pt());
-      if (TMath::Abs(mcParticle.pdgCode()) == 321)
+      else if (pdg == kKPlus)
         histos.fill(HIST("hPtGeneratedKa"), mcParticle.pt());
-      if (TMath::Abs(mcParticle.pdgCode()) == 2212)
+      else if (pdg == kProton)
         histos.fill(HIST("hPtGeneratedPr"), mcParticle.pt());
 
       if (mcParticle.pt() < minPt) {
@@ -353,13 +361,13 @@ struct OnTheFlyTracker {
 
       // Base QA (note: reco pT here)
       histos.fill(HIST("hPtReconstructed"), trackParCov.getPt());
-      if (TMath::Abs(mcParticle.pdgCode()) == 11)
+      if (pdg == kElectron)
         histos.fill(HIST("hPtReconstructedEl"), mcParticle.pt());
-      if (TMath::Abs(mcParticle.pdgCode()) == 211)
+      else if (pdg == kPiPlus)
         histos.fill(HIST("hPtReconstructedPi"), mcParticle.pt());
-      if (TMath::Abs(mcParticle.pdgCode()) == 321)
+      else if (pdg == kKPlus)
         histos.fill(HIST("hPtReconstructedKa"), mcParticle.pt());
-      if (TMath::Abs(mcParticle.pdgCode()) == 2212)
+      else if (pdg == kProton)
         histos.fill(HIST("hPtReconstructedPr"), mcParticle.pt());
 
       if (doExtraQA) {
@@ -381,14 +389,15 @@ struct OnTheFlyTracker {
     o2::vertexing::PVertex primaryVertex;
 
     if (enablePrimaryVertexing) {
-      std::vector<o2::MCCompLabel> lblTracks;
-      std::vector<o2::vertexing::PVertex> vertices;
-      std::vector<o2::vertexing::GIndex> vertexTrackIDs;
-      std::vector<o2::vertexing::V2TRef> v2tRefs;
-      std::vector<o2::MCEventLabel> lblVtx;
+      lblTracks.clear();
+      vertices.clear();
+      vertexTrackIDs.clear();
+      v2tRefs.clear();
+      lblVtx.clear();
+      idxVec.clear();
       lblVtx.emplace_back(mcCollision.globalIndex(), 1);
-      std::vector<o2::dataformats::GlobalTrackID> idxVec; // store IDs
 
+      lblTracks.reserve(tracksAlice3.size());
       idxVec.reserve(tracksAlice3.size());
       for (unsigned i = 0; i < tracksAlice3.size(); i++) {
         lblTracks.emplace_back(tracksAlice3[i].mcLabel, mcCollision.globalIndex(), 1, false);
@@ -23,6 +23,7 @@
 #include <map>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 #include "Framework/runDataProcessing.h"
 #include "Framework/RunningWorkflowInfo.h"
@@ -217,6 +218,7 @@ struct alice3decayFinder {
   Configurable<bool> doDCAplotsLc{"doDCAplotsLc", true, "do daughter prong DCA plots for Lc baryons"};
   Configurable<bool> mcSameMotherCheck{"mcSameMotherCheck", true, "check if tracks come from the same MC mother"};
   Configurable<float> dcaDaughtersSelection{"dcaDaughtersSelection", 1000.0f, "DCA between daughters (cm)"};
+  Configurable<float> massWindowPreselection{"massWindowPreselection", -1.0f, "|m - m_PDG| (GeV/c^{2}) with the prong momenta before the vertex fit, negative: no preselection"};
 
   Configurable<float> piFromD_dcaXYconstant{"piFromD_dcaXYconstant", -1.0f, "[0] in |DCAxy| > [0]+[1]/pT"};
   Configurable<float> piFromD_dcaXYpTdep{"piFromD_dcaXYpTdep", 0.0, "[1] in |DCAxy| > [0]+[1]/pT"};
@@ -298,12 +300,24 @@ struct alice3decayFinder {
     float eta;
   } lcbaryon;
 
-  template <typename TTrackType>
-  bool buildDecayCandidateTwoBody(TTrackType const& posTrackRow, TTrackType const& negTrackRow, float posMass, float negMass)
+  // prong of a candidate, its track parametrisation and momentum are computed once per collision instead of once per combination
+  struct Prong {
+    o2::track::TrackParCov trackParCov;
+    std::array<float, 3> pVec;
+  };
+  std::vector<Prong> prongs0, prongs1, prongs2;
+
+  template <typename TTracks>
+  void fillProngs(TTracks const& tracks, std::vector<Prong>& prongs)
   {
-    o2::track::TrackParCov posTrack = getTrackParCov(posTrackRow);
-    o2::track::TrackParCov negTrack = getTrackParCov(negTrackRow);
+    prongs.clear();
+    for (auto const& track : tracks) {
+      prongs.push_back({getTrackParCov(track), track.pVector()});
+    }
+  }
 
+  bool buildDecayCandidateTwoBody(o2::track::TrackParCov posTrack, o2::track::TrackParCov negTrack, float posMass, float negMass)
+  {
     //}-{}-{}-{}-{}-{}-{}-{}-{}-{}
     // Move close to minima
     int nCand = 0;
@@ -335,13 +349,8 @@ struct alice3decayFinder {
     return true;
   }
 
-  template <typename TTrackType>
-  bool buildDecayCandidateThreeBody(TTrackType const& prong0, TTrackType const& prong1, TTrackType const& prong2, float p0mass, float p1mass, float p2mass)
+  bool buildDecayCandidateThreeBody(o2::track::TrackParCov t0, o2::track::TrackParCov t1, o2::track::TrackParCov t2, float p0mass, float p1mass, float p2mass)
   {
-    o2::track::TrackParCov t0 = getTrackParCov(prong0);
-    o2::track::TrackParCov t1 = getTrackParCov(prong1);
-    o2::track::TrackParCov t2 = getTrackParCov(prong2);
-
     //}-{}-{}-{}-{}-{}-{}-{}-{}-{}
     // Move close to minima
     int nCand = 0;
@@ -499,22 +508,38 @@ struct alice3decayFinder {
     }
 
     // D mesons
+    fillProngs(tracksPiPlusFromDgrouped, prongs0);
+    fillProngs(tracksKaMinusFromDgrouped, prongs1);
+    int iPos = -1;
     for (auto const& posTrackRow : tracksPiPlusFromDgrouped) {
+      const auto& posProng = prongs0[++iPos];
+      int iNeg = -1;
       for (auto const& negTrackRow : tracksKaMinusFromDgrouped) {
+        const auto& negProng = prongs1[++iNeg];
+        if (massWindowPreselection >= 0.f && std::abs(RecoDecay::m(array{posProng.pVec, negProng.pVec}, array{o2::constants::physics::MassPionCharged, o2::constants::physics::MassKaonCharged}) - o2::constants::physics::MassD0) > massWindowPreselection)
+          continue;
         if (mcSameMotherCheck && !checkSameMother(posTrackRow, negTrackRow))
           continue;
-        if (!buildDecayCandidateTwoBody(posTrackRow, negTrackRow, o2::constants::physics::MassPionCharged, o2::constants::physics::MassKaonCharged))
+        if (!buildDecayCandidateTwoBody(posProng.trackParCov, negProng.trackParCov, o2::constants::physics::MassPionCharged, o2::constants::physics::MassKaonCharged))
           continue;
         histos.fill(HIST("hMassD"), dmeson.mass);
         histos.fill(HIST("h3dRecD"), dmeson.pt, dmeson.eta, dmeson.mass);
       }
     }
     // D mesons
+    fillProngs(tracksKaPlusFromDgrouped, prongs0);
+    fillProngs(tracksPiMinusFromDgrouped, prongs1);
+    int iPos = -1;
     for (auto const& posTrackRow : tracksKaPlusFromDgrouped) {
+      const auto& posProng = prongs0[++iPos];
+      int iNeg = -1;
       for (auto const& negTrackRow : tracksPiMinusFromDgrouped) {
+        const auto& negProng = prongs1[++iNeg];
+        if (massWindowPreselection >= 0.f && std::abs(RecoDecay::m(array{posProng.pVec, negProng.pVec}, array{o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged}) - o2::constants::physics::MassD0) > massWindowPreselection)
+          continue;
         if (mcSameMotherCheck && !checkSameMother(posTrackRow, negTrackRow))
           continue;
-        if (!buildDecayCandidateTwoBody(posTrackRow, negTrackRow, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
+        if (!buildDecayCandidateTwoBody(posProng.trackParCov, negProng.trackParCov, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
           continue;
         histos.fill(HIST("hMassDbar"), dmeson.mass);
         histos.fill(HIST("h3dRecDbar"), dmeson.pt, dmeson.eta, dmeson.mass);
@@ -551,14 +576,28 @@ struct alice3decayFinder {
     }
 
     // Lc+ baryons +4122 -> +2212 -321 +211
+    fillProngs(tracksPrPlusFromLcgrouped, prongs0);
+    fillProngs(tracksPiPlusFromLcgrouped, prongs1);
+    fillProngs(tracksKaMinusFromLcgrouped, prongs2);
+    int iProton = -1;
     for (auto const& proton : tracksPrPlusFromLcgrouped) {
+      const auto& protonProng = prongs0[++iProton];
+      int iPion = -1;
       for (auto const& pion : tracksPiPlusFromLcgrouped) {
+        const auto& pionProng = prongs1[++iPion];
         if (pion.globalIndex() == proton.globalIndex())
           continue; // avoid self
+        // the proton-pion mass can not exceed the Lc mass minus the kaon mass
+        if (massWindowPreselection >= 0.f && RecoDecay::m(array{protonProng.pVec, pionProng.pVec}, array{o2::constants::physics::MassProton, o2::constants::physics::MassPionCharged}) > o2::constants::physics::MassLambdaCPlus - o2::constants::physics::MassKaonCharged + massWindowPreselection)
+          continue;
+        int iKaon = -1;
         for (auto const& kaon : tracksKaMinusFromLcgrouped) {
+          const auto& kaonProng = prongs2[++iKaon];
+          if (massWindowPreselection >= 0.f && std::abs(RecoDecay::m(array{protonProng.pVec, kaonProng.pVec, pionProng.pVec}, array{o2::constants::physics::MassProton, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged}) - o2::constants::physics::MassLambdaCPlus) > massWindowPreselection)
+            continue;
           if (mcSameMotherCheck && (!checkSameMother(proton, kaon) || !checkSameMother(proton, pion)))
             continue;
-          if (!buildDecayCandidateThreeBody(proton, kaon, pion, o2::constants::physics::MassProton, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
+          if (!buildDecayCandidateThreeBody(protonProng.trackParCov, kaonProng.trackParCov, pionProng.trackParCov, o2::constants::physics::MassProton, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
             continue;
           histos.fill(HIST("hMassLc"), lcbaryon.mass);
           histos.fill(HIST("h3dRecLc"), lcbaryon.pt, lcbaryon.eta, lcbaryon.mass);
@@ -566,14 +605,28 @@ struct alice3decayFinder {
       }
     }
     // Lc- baryons -4122 -> -2212 +321 -211
+    fillProngs(tracksPrMinusFromLcgrouped, prongs0);
+    fillProngs(tracksPiMinusFromLcgrouped, prongs1);
+    fillProngs(tracksKaPlusFromLcgrouped, prongs2);
+    int iProton = -1;
     for (auto const& proton : tracksPrMinusFromLcgrouped) {
+      const auto& protonProng = prongs0[++iProton];
+      int iPion = -1;
       for (auto const& pion : tracksPiMinusFromLcgrouped) {
+        const auto& pionProng = prongs1[++iPion];
         if (pion.globalIndex() == proton.globalIndex())
           continue; // avoid self
+        // the proton-pion mass can not exceed the Lc mass minus the kaon mass
+        if (massWindowPreselection >= 0.f && RecoDecay::m(array{protonProng.pVec, pionProng.pVec}, array{o2::constants::physics::MassProton, o2::constants::physics::MassPionCharged}) > o2::constants::physics::MassLambdaCPlus - o2::constants::physics::MassKaonCharged + massWindowPreselection)
+          continue;
+        int iKaon = -1;
         for (auto const& kaon : tracksKaPlusFromLcgrouped) {
+          const auto& kaonProng = prongs2[++iKaon];
+          if (massWindowPreselection >= 0.f && std::abs(RecoDecay::m(array{protonProng.pVec, kaonProng.pVec, pionProng.pVec}, array{o2::constants::physics::MassProton, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged}) - o2::constants::physics::MassLambdaCPlus) > massWindowPreselection)
+            continue;
           if (mcSameMotherCheck && (!checkSameMother(proton, kaon) || !checkSameMother(proton, pion)))
             continue;
-          if (!buildDecayCandidateThreeBody(proton, kaon, pion, o2::constants::physics::MassProton, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
+          if (!buildDecayCandidateThreeBody(protonProng.trackParCov, kaonProng.trackParCov, pionProng.trackParCov, o2::constants::physics::MassProton, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
             continue;
           histos.fill(HIST("hMassLcbar"), lcbaryon.mass);
           histos.fill(HIST("h3dRecLcbar"), lcbaryon.pt, lcbaryon.eta, lcbaryon.mass);
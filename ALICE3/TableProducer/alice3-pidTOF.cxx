@@ -112,20 +112,27 @@ struct ALICE3pidTOFTask {
     }
   }
 
+  /// Same as TOFResoALICE3ParamTrack, with the terms not depending on the species computed once per track by the caller
   template <o2::track::PID::ID id>
-  float sigma(Trks::iterator track)
+  float sigma(Trks::iterator const& track, float momentumError, float evTimeReso)
   {
-    return o2::pid::tof::TOFResoALICE3ParamTrack<id>(track, resoParameters);
+    return o2::pid::tof::TOFResoALICE3Param(track.p(), momentumError, evTimeReso, track.length(), o2::track::pid_constants::sMasses2Z[id], resoParameters);
   }
   template <o2::track::PID::ID id>
-  float nsigma(Trks::iterator track)
+  float nsigma(Trks::iterator const& track, float deltaTime, float expSigma)
   {
     if (!track.hasTOF()) {
       return -999.f;
     }
-    return ((track.trackTime() - track.collision().collisionTime()) * 1000.f - o2::pid::tof::ExpTimes<Trks::iterator, id>::ComputeExpectedTime(track.tofExpMom() / o2::pid::tof::kCSPEED,
-                                                                                                                                               track.length())) /
-           sigma<id>(track);
+    return (deltaTime - o2::pid::tof::ExpTimes<Trks::iterator, id>::ComputeExpectedTime(track.tofExpMom() / o2::pid::tof::kCSPEED,
+                                                                                        track.length())) /
+           expSigma;
+  }
+  template <o2::track::PID::ID id, typename TTable>
+  void fillTable(TTable& table, Trks::iterator const& track, float momentumError, float evTimeReso, float deltaTime)
+  {
+    const float expSigma = sigma<id>(track, momentumError, evTimeReso);
+    table(expSigma, nsigma<id>(track, deltaTime, expSigma));
   }
   void process(Trks const& tracks, Coll const&)
   {
@@ -139,15 +146,20 @@ struct ALICE3pidTOFTask {
     tablePIDHe.reserve(tracks.size());
     tablePIDAl.reserve(tracks.size());
     for (auto const& trk : tracks) {
-      tablePIDEl(sigma<PID::Electron>(trk), nsigma<PID::Electron>(trk));
-      tablePIDMu(sigma<PID::Muon>(trk), nsigma<PID::Muon>(trk));
-      tablePIDPi(sigma<PID::Pion>(trk), nsigma<PID::Pion>(trk));
-      tablePIDKa(sigma<PID::Kaon>(trk), nsigma<PID::Kaon>(trk));
-      tablePIDPr(sigma<PID::Proton>(trk), nsigma<PID::Proton>(trk));
-      tablePIDDe(sigma<PID::Deuteron>(trk), nsigma<PID::Deuteron>(trk));
-      tablePIDTr(sigma<PID::Triton>(trk), nsigma<PID::Triton>(trk));
-      tablePIDHe(sigma<PID::Helium3>(trk), nsigma<PID::Helium3>(trk));
-      tablePIDAl(sigma<PID::Alpha>(trk), nsigma<PID::Alpha>(trk));
+      // terms common to all the species, computed once per track
+      const auto collision = trk.collision();
+      const float momentumError = o2::pid::tof::TOFResoALICE3MomentumError(trk);
+      const float evTimeReso = collision.collisionTimeRes() * 1000.f;
+      const float deltaTime = (trk.trackTime() - collision.collisionTime()) * 1000.f;
+      fillTable<PID::Electron>(tablePIDEl, trk, momentumError, evTimeReso, deltaTime);
+      fillTable<PID::Muon>(tablePIDMu, trk, momentumError, evTimeReso, deltaTime);
+      fillTable<PID::Pion>(tablePIDPi, trk, momentumError, evTimeReso, deltaTime);
+      fillTable<PID::Kaon>(tablePIDKa, trk, momentumError, evTimeReso, deltaTime);
+      fillTable<PID::Proton>(tablePIDPr, trk, momentumError, evTimeReso, deltaTime);
+      fillTable<PID::Deuteron>(tablePIDDe, trk, momentumError, evTimeReso, deltaTime);
+      fillTable<PID::Triton>(tablePIDTr, trk, momentumError, evTimeReso, deltaTime);
+      fillTable<PID::Helium3>(tablePIDHe, trk, momentumError, evTimeReso, deltaTime);
+      fillTable<PID::Alpha>(tablePIDAl, trk, momentumError, evTimeReso, deltaTime);
     }
   }
 };
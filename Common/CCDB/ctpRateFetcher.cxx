@@ -22,49 +22,95 @@
 
 namespace o2
 {
-double ctpRateFetcher::fetch(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, std::string sourceName)
+double ctpRateFetcher::fetch(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, const std::string& sourceName)
+{
+  const Source source = getSource(sourceName);
+  if (source == kUnknown) {
+    LOG(error) << "CTP rate for " << sourceName << " not available";
+    return -1.;
+  }
+  return fetch(ccdb, timeStamp, runNumber, source);
+}
+
+double ctpRateFetcher::fetch(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, Source source)
 {
   setupRun(runNumber, ccdb, timeStamp);
+  if (source <= kUnknown || source >= kNSources) {
+    LOG(error) << "CTP rate for source " << source << " not available";
+    return -1.;
+  }
+  // The rate only depends on the timestamp within a run: the collisions of the same timestamp reuse it
+  if (mLastRateValid[source] && mLastTimeStamp[source] == timeStamp) {
+    return mLastRate[source];
+  }
+  double rate = -1.;
+  switch (source) {
+    case kZNC:
+    case kZNCHadronic:
+      if (runNumber < 544448) {
+        rate = fetchCTPratesInputs(timeStamp, 25);
+      } else {
+        rate = fetchCTPratesClasses(timeStamp, mClassIndexZNC, "C1ZNC-B-NOPF-CRU", 6);
+      }
+      rate /= (source == kZNCHadronic ? 28. : 1.);
+      break;
+    case kT0CE:
+      rate = fetchCTPratesClasses(timeStamp, mClassIndexT0CE, "CMTVXTCE-B-NOPF");
+      break;
+    case kT0SC:
+      rate = fetchCTPratesClasses(timeStamp, mClassIndexT0SC, "CMTVXTSC-B-NOPF");
+      break;
+    case kT0VTX:
+      if (runNumber < 534202) {
+        rate = fetchCTPratesClasses(timeStamp, mClassIndexT0VTX, "minbias_TVX_L0", 3); // 2022
+      } else {
+        rate = fetchCTPratesClasses(timeStamp, mClassIndexT0VTX, "CMTVX-B-NOPF");
+        if (rate < 0.) {
+          LOG(info) << "Trying different class";
+          rate = fetchCTPratesClasses(timeStamp, mClassIndexT0VTXFallback, "CMTVX-NONE");
+          if (rate < 0) {
+            LOG(fatal) << "None of the classes used for lumi found";
+          }
+        }
+      }
+      break;
+    default:
+      break;
+  }
+  mLastTimeStamp[source] = timeStamp;
+  mLastRate[source] = rate;
+  mLastRateValid[source] = true;
+  return rate;
+}
+
+ctpRateFetcher::Source ctpRateFetcher::getSource(const std::string& sourceName)
+{
   if (sourceName.find("ZNC") != std::string::npos) {
-    if (runNumber < 544448) {
-      return fetchCTPratesInputs(ccdb, timeStamp, runNumber, 25) / (sourceName.find("hadronic") != std::string::npos ? 28. : 1.);
-    } else {
-      return fetchCTPratesClasses(ccdb, timeStamp, runNumber, "C1ZNC-B-NOPF-CRU", 6) / (sourceName.find("hadronic") != std::string::npos ? 28. : 1.);
-    }
+    return sourceName.find("hadronic") != std::string::npos ? kZNCHadronic : kZNC;
   } else if (sourceName == "T0CE") {
-    return fetchCTPratesClasses(ccdb, timeStamp, runNumber, "CMTVXTCE-B-NOPF");
+    return kT0CE;
   } else if (sourceName == "T0SC") {
-    return fetchCTPratesClasses(ccdb, timeStamp, runNumber, "CMTVXTSC-B-NOPF");
+    return kT0SC;
   } else if (sourceName == "T0VTX") {
-    if (runNumber < 534202) {
-      return fetchCTPratesClasses(ccdb, timeStamp, runNumber, "minbias_TVX_L0", 3); // 2022
-    } else {
-      double_t ret = fetchCTPratesClasses(ccdb, timeStamp, runNumber, "CMTVX-B-NOPF");
-      if (ret < 0.) {
-        LOG(info) << "Trying different class";
-        ret = fetchCTPratesClasses(ccdb, timeStamp, runNumber, "CMTVX-NONE");
-        if (ret < 0) {
-          LOG(fatal) << "None of the classes used for lumi found";
-        }
-      }
-      return ret;
-    }
+    return kT0VTX;
   }
-  LOG(error) << "CTP rate for " << sourceName << " not available";
-  return -1.;
+  return kUnknown;
 }
 
-double ctpRateFetcher::fetchCTPratesClasses(o2::ccdb::BasicCCDBManager* /*ccdb*/, uint64_t timeStamp, int /*runNumber*/, const std::string& className, int inputType)
+int ctpRateFetcher::getClassIndex(const std::string& className) const
 {
   std::vector<ctp::CTPClass> ctpcls = mConfig->getCTPClasses();
   std::vector<int> clslist = mConfig->getTriggerClassList();
-  int classIndex = -1;
   for (size_t i = 0; i < clslist.size(); i++) {
     if (ctpcls[i].name.find(className) != std::string::npos) {
-      classIndex = i;
-      break;
+      return i;
     }
   }
+  return -1;
+}
+
+double ctpRateFetcher::fetchCTPratesClasses(uint64_t timeStamp, int classIndex, const std::string& className, int inputType)
+{
   if (classIndex == -1) {
     LOG(warn) << "Trigger class " << className << " not found in CTPConfiguration";
     return -1.;
@@ -73,10 +119,9 @@ double ctpRateFetcher::fetchCTPratesClasses(o2::ccdb::BasicCCDBManager* /*ccdb*/
   return pileUpCorrection(rate.second);
 }
 
-double ctpRateFetcher::fetchCTPratesInputs(o2::ccdb::BasicCCDBManager* /*ccdb*/, uint64_t timeStamp, int /*runNumber*/, int input)
+double ctpRateFetcher::fetchCTPratesInputs(uint64_t timeStamp, int input)
 {
-  std::vector<ctp::CTPScalerRecordO2> recs = mScalers->getScalerRecordO2();
-  if (recs[0].scalersInps.size() == 48) {
+  if (mHasInputs) {
     return pileUpCorrection(mScalers->getRateGivenT(timeStamp * 1.e-3, input, 7).second);
   } else {
     LOG(error) << "Inputs not available";
@@ -89,9 +134,7 @@ double ctpRateFetcher::pileUpCorrection(double triggerRate)
   if (mLHCIFdata == nullptr) {
     LOG(fatal) << "No filling" << std::endl;
   }
-  auto bfilling = mLHCIFdata->getBunchFilling();
-  std::vector<int> bcs = bfilling.getFilledBCs();
-  double nbc = bcs.size();
+  double nbc = mNFilledBCs;
   double nTriggersPerFilledBC = triggerRate / nbc / constants::lhc::LHCRevFreq;
   double mu = -std::log(1 - nTriggersPerFilledBC);
   return mu * nbc * constants::lhc::LHCRevFreq;
@@ -124,6 +167,19 @@ void ctpRateFetcher::setupRun(int runNumber, o2::ccdb::BasicCCDBManager* ccdb, u
     LOG(fatal) << "CTPRunScalers not in database, timestamp:" << timeStamp;
   }
   mScalers->convertRawToO2();
+
+  // Quantities that do not change within the run
+  mNFilledBCs = mLHCIFdata->getBunchFilling().getFilledBCs().size();
+  const auto& recs = mScalers->getScalerRecordO2();
+  mHasInputs = !recs.empty() && recs[0].scalersInps.size() == 48;
+  mClassIndexZNC = getClassIndex("C1ZNC-B-NOPF-CRU");
+  mClassIndexT0CE = getClassIndex("CMTVXTCE-B-NOPF");
+  mClassIndexT0SC = getClassIndex("CMTVXTSC-B-NOPF");
+  mClassIndexT0VTX = getClassIndex(mRunNumber < 534202 ? "minbias_TVX_L0" : "CMTVX-B-NOPF");
+  mClassIndexT0VTXFallback = getClassIndex("CMTVX-NONE");
+  for (int i = 0; i < kNSources; i++) {
+    mLastRateValid[i] = false;
+  }
 }
 
 } // namespace o2
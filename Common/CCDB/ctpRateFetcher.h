@@ -33,14 +33,30 @@ class GRPLHCIFData;
 class ctpRateFetcher
 {
  public:
+  /// Sources of the interaction rate
+  enum Source : int {
+    kUnknown = -1,
+    kZNC = 0,
+    kZNCHadronic,
+    kT0CE,
+    kT0SC,
+    kT0VTX,
+    kNSources
+  };
+
   ctpRateFetcher() = default;
-  double fetch(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, std::string sourceName);
+  double fetch(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, const std::string& sourceName);
+  double fetch(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, Source source);
+
+  /// Converts a source name ("ZNC hadronic", "T0VTX", ...) to the corresponding source
+  static Source getSource(const std::string& sourceName);
 
   void setManualCleanup(bool manualCleanup = true) { mManualCleanup = manualCleanup; }
 
  private:
-  double fetchCTPratesInputs(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, int input);
-  double fetchCTPratesClasses(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, const std::string& className, int inputType = 1);
+  double fetchCTPratesInputs(uint64_t timeStamp, int input);
+  double fetchCTPratesClasses(uint64_t timeStamp, int classIndex, const std::string& className, int inputType = 1);
+  int getClassIndex(const std::string& className) const;
   double pileUpCorrection(double rate);
   void setupRun(int runNumber, o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp);
 
@@ -49,6 +65,18 @@ class ctpRateFetcher
   ctp::CTPConfiguration* mConfig = nullptr;
   ctp::CTPRunScalers* mScalers = nullptr;
   parameters::GRPLHCIFData* mLHCIFdata = nullptr;
+
+  // Quantities evaluated once per run
+  double mNFilledBCs = 0.;                  // Number of filled bunch crossings
+  bool mHasInputs = false;                  // Scalers of the inputs are available
+  int mClassIndexZNC = -1;                  // Index of the ZNC class
+  int mClassIndexT0CE = -1;                 // Index of the T0CE class
+  int mClassIndexT0SC = -1;                 // Index of the T0SC class
+  int mClassIndexT0VTX = -1;                // Index of the T0VTX class
+  int mClassIndexT0VTXFallback = -1;        // Index of the T0VTX class used when the default one is missing
+  uint64_t mLastTimeStamp[kNSources] = {0}; // Timestamp of the last rate computed for each source
+  double mLastRate[kNSources] = {0.};       // Last rate computed for each source
+  bool mLastRateValid[kNSources] = {false}; // The last rate of each source can be reused
 };
 } // namespace o2
 
@@ -0,0 +1,159 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CcdbPrefetcher.h
+/// \brief  Download in a background thread of the CCDB objects of the next run of a multi-run job
+///         The objects valid at the start of a run are retrieved with a private CcdbApi while the current run is processed.
+///         At the run change, a prefetched object is used only if its validity interval contains the timestamp of the
+///         query, as the local validity checking of the BasicCCDBManager does, otherwise the caller queries the CCDB
+///         synchronously, so the objects are the same as without prefetching.
+///         The prefetched objects are owned by the prefetcher and are kept until the next object of the same path is taken.
+///
+///         Usage:
+///           CcdbPrefetcher prefetcher;
+///           prefetcher.setURL(url);
+///           prefetcher.addObject<o2::parameters::GRPMagField>(path); // in init
+///           auto* grpmag = prefetcher.take<o2::parameters::GRPMagField>(path, runNumber, timestamp); // at run change, nullptr if not prefetched
+///           prefetcher.prefetch(nextRunNumber);                      // after the run change
+///
+
+#ifndef COMMON_CORE_CCDBPREFETCHER_H_
+#define COMMON_CORE_CCDBPREFETCHER_H_
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <TROOT.h>
+
+#include "CCDB/BasicCCDBManager.h"
+#include "CCDB/CcdbApi.h"
+#include "Framework/Logger.h"
+
+class CcdbPrefetcher
+{
+ public:
+  CcdbPrefetcher() = default;
+  CcdbPrefetcher(const CcdbPrefetcher&) = delete;
+  CcdbPrefetcher& operator=(const CcdbPrefetcher&) = delete;
+  ~CcdbPrefetcher() { wait(); }
+
+  void setURL(const std::string& url) { mURL = url; }
+  /// Upper limit of the creation time of the objects (in ms), as for the BasicCCDBManager, 0 for no limit
+  void setCreatedNotAfter(int64_t createdNotAfter) { mCreatedNotAfter = createdNotAfter; }
+
+  /// Registers an object to be prefetched
+  template <typename T>
+  void addObject(const std::string& path)
+  {
+    if (path.empty()) {
+      return;
+    }
+    mRetrievers[path] = [path](o2::ccdb::CcdbApi& api, int64_t timestamp, std::map<std::string, std::string>& headers, const std::string& createdNotAfter) {
+      return std::shared_ptr<void>(api.retrieveFromTFileAny<T>(path, {}, timestamp, &headers, "", createdNotAfter));
+    };
+  }
+
+  /// Starts the download of the registered objects valid at the start of a run, in a background thread
+  void prefetch(int runNumber)
+  {
+    if (mRetrievers.empty() || runNumber == mPrefetchedRun) {
+      return;
+    }
+    wait();
+    // the objects are deserialised by ROOT in the background thread
+    ROOT::EnableThreadSafety();
+    mPrefetchedRun = runNumber;
+    mPending = std::async(std::launch::async, [this, runNumber]() { return retrieve(runNumber); });
+    LOGF(info, "CcdbPrefetcher: prefetching %zu objects for run %d", mRetrievers.size(), runNumber);
+  }
+
+  /// Returns the prefetched object of a path if it was prefetched for the run and is valid at the timestamp, nullptr otherwise
+  /// Waits for the end of the prefetching of the run, if it is still running
+  template <typename T>
+  T* take(const std::string& path, int runNumber, uint64_t timestamp)
+  {
+    if (runNumber != mPrefetchedRun) {
+      return nullptr;
+    }
+    if (mPending.valid()) {
+      mPrefetched = mPending.get();
+    }
+    auto entry = mPrefetched.find(path);
+    if (entry == mPrefetched.end() || entry->second.object == nullptr) {
+      return nullptr;
+    }
+    const auto& prefetched = entry->second;
+    if (static_cast<int64_t>(timestamp) < prefetched.validFrom || static_cast<int64_t>(timestamp) >= prefetched.validUntil) {
+      LOGF(info, "CcdbPrefetcher: %s prefetched for run %d is not valid at timestamp %llu", path.data(), runNumber, timestamp);
+      return nullptr;
+    }
+    mTaken[path] = prefetched.object;
+    mPrefetched.erase(entry);
+    return static_cast<T*>(mTaken[path].get());
+  }
+
+ private:
+  struct Entry {
+    std::shared_ptr<void> object;
+    int64_t validFrom = 0;
+    int64_t validUntil = 0;
+  };
+  using Retriever = std::function<std::shared_ptr<void>(o2::ccdb::CcdbApi&, int64_t, std::map<std::string, std::string>&, const std::string&)>;
+
+  void wait()
+  {
+    if (mPending.valid()) {
+      mPending.wait();
+    }
+  }
+
+  // runs in the background thread, only uses its own CcdbApi
+  std::map<std::string, Entry> retrieve(int runNumber) const
+  {
+    std::map<std::string, Entry> entries;
+    o2::ccdb::CcdbApi api;
+    api.init(mURL);
+    const auto duration = o2::ccdb::BasicCCDBManager::getRunDuration(api, runNumber, false);
+    if (duration.first <= 0) {
+      LOGF(warning, "CcdbPrefetcher: no start of run found for run %d, nothing prefetched", runNumber);
+      return entries;
+    }
+    const std::string createdNotAfter = mCreatedNotAfter > 0 ? std::to_string(mCreatedNotAfter) : "";
+    for (const auto& [path, retriever] : mRetrievers) {
+      std::map<std::string, std::string> headers;
+      Entry entry;
+      entry.object = retriever(api, duration.first, headers, createdNotAfter);
+      if (entry.object == nullptr || headers.count("Valid-From") == 0 || headers.count("Valid-Until") == 0) {
+        continue;
+      }
+      entry.validFrom = std::stoll(headers["Valid-From"]);
+      entry.validUntil = std::stoll(headers["Valid-Until"]);
+      entries[path] = std::move(entry);
+    }
+    return entries;
+  }
+
+  std::string mURL = "http://alice-ccdb.cern.ch";
+  int64_t mCreatedNotAfter = 0;
+  std::map<std::string, Retriever> mRetrievers;        // retrieval of each registered path
+  int mPrefetchedRun = -1;                             // run of the last prefetch
+  std::future<std::map<std::string, Entry>> mPending;  // prefetch running in the background
+  std::map<std::string, Entry> mPrefetched;            // prefetched objects not taken yet
+  std::map<std::string, std::shared_ptr<void>> mTaken; // objects in use, per path
+};
+
+#endif // COMMON_CORE_CCDBPREFETCHER_H_
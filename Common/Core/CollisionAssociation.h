@@ -20,11 +20,13 @@
 #ifndef COMMON_CORE_COLLISIONASSOCIATION_H_
 #define COMMON_CORE_COLLISIONASSOCIATION_H_
 
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <utility>
 
 #include "CommonConstants/LHCConstants.h"
+#include "Common/Core/DataframeArena.h"
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/ASoAHelpers.h"
 
@@ -57,6 +59,7 @@ class CollisionAssociation
   void setIncludeUnassigned(bool enable = true) { mIncludeUnassigned = enable; }
   void setFillTableOfCollIdsPerTrack(bool fill = true) { mFillTableOfCollIdsPerTrack = fill; }
   void setBcWindow(int bcWindow = 115) { mBcWindowForOneSigma = bcWindow; }
+  void setUseSweepLine(bool enable = true) { mUseSweepLine = enable; }
 
   template <typename TTracks, typename Slice, typename Assoc, typename RevIndices>
   void runStandardAssoc(o2::aod::Collisions const& collisions,
@@ -121,10 +124,15 @@ class CollisionAssociation
                         TTracksUnfiltered const& tracksUnfiltered,
                         TTracks const& tracks,
                         TAmbiTracks const& ambiguousTracks,
-                        o2::aod::BCs const&,
+                        o2::aod::BCs const& bcs,
                         Assoc& association,
                         RevIndices& reverseIndices)
   {
+    if (mUseSweepLine) {
+      runAssocWithTimeSweep(collisions, tracksUnfiltered, tracks, ambiguousTracks, bcs, association, reverseIndices);
+      return;
+    }
+
     // cache globalBC and track time in BC for optimization
     std::vector<int64_t> globalBC;
     std::vector<int64_t> trackBCCache;
@@ -136,28 +144,18 @@ class CollisionAssociation
     if (tracks.size() > 0) {
       lastCollisionId = trackBegin.collisionId();
     }
+    // index the first BC of the ambiguous tracks by track global index, to avoid a search over the ambiguous tracks per unassigned track
+    if (mIncludeUnassigned) {
+      fillAmbiguousTrackBCs<TTracks>(ambiguousTracks);
+    }
+
     auto track = trackBegin;
     for (; track != tracks.end(); ++track) {
       int64_t trackBC = -1;
       if (track.has_collision()) {
         trackBC = track.collision().bc().globalBC();
       } else if (mIncludeUnassigned) {
-        for (const auto& ambTrack : ambiguousTracks) {
-          if constexpr (isCentralBarrel) { // FIXME: to be removed as soon as it is possible to use getId<Table>() for joined tables
-            if (ambTrack.trackId() == track.globalIndex()) {
-              if (!ambTrack.has_bc() || ambTrack.bc().size() == 0) {
-                break;
-              }
-              trackBC = ambTrack.bc().begin().globalBC();
-              break;
-            }
-          } else {
-            if (ambTrack.template getId<TTracks>() == track.globalIndex()) {
-              trackBC = ambTrack.bc().begin().globalBC();
-              break;
-            }
-          }
-        }
+        trackBC = getAmbiguousTrackBC(track.globalIndex());
       }
       globalBC.push_back(trackBC);
       trackBCCache.push_back(trackBC + track.trackTime() / o2::constants::lhc::LHCBunchSpacingNS);
@@ -177,8 +175,9 @@ class CollisionAssociation
       trackIterationWindows.push_back(std::make_pair(trackBegin, track));
     }
 
-    // define vector of vectors to store indices of compatible collisions per track
-    std::vector<std::unique_ptr<std::vector<int>>> collsPerTrack(tracksUnfiltered.size());
+    // define vector of vectors to store indices of compatible collisions per track, allocated in the arena of the dataframe
+    mArena.reset();
+    ArenaVector<ArenaVector<int>> collsPerTrack(mFillTableOfCollIdsPerTrack ? tracksUnfiltered.size() : 0, &mArena);
 
     // loop over collisions to find time-compatible tracks
     int64_t bcOffsetMax = mBcWindowForOneSigma * mNumSigmaForTimeCompat + mTimeMargin / o2::constants::lhc::LHCBunchSpacingNS;
@@ -266,10 +265,7 @@ class CollisionAssociation
             LOGP(debug, "Filling track id {} for coll id {}", trackIdx, collIdx);
             association(collIdx, trackIdx);
             if (mFillTableOfCollIdsPerTrack) {
-              if (collsPerTrack[trackIdx] == nullptr) {
-                collsPerTrack[trackIdx] = std::make_unique<std::vector<int>>();
-              }
-              collsPerTrack[trackIdx].get()->push_back(collIdx);
+              collsPerTrack[trackIdx].push_back(collIdx);
             }
           }
         }
@@ -277,20 +273,222 @@ class CollisionAssociation
     }
     // create reverse index track to collisions if enabled
     if (mFillTableOfCollIdsPerTrack) {
-      std::vector<int> empty{};
+      std::vector<int> collIds;
       for (const auto& track : tracksUnfiltered) {
+        const auto& collsThisTrack = collsPerTrack[track.globalIndex()];
+        collIds.assign(collsThisTrack.begin(), collsThisTrack.end());
+        reverseIndices(collIds);
+      }
+    }
+  }
 
-        const auto trackId = track.globalIndex();
-        if (collsPerTrack[trackId] == nullptr) {
-          reverseIndices(empty);
+  /// Same association as runAssocWithTime, computed with a single sweep over the tracks and collisions sorted in BC
+  /// The track quantities are cached once, each track only visits the collisions within its BC window and the
+  /// compatible pairs are kept in reusable buffers, before being written ordered by collision
+  template <typename TTracksUnfiltered, typename TTracks, typename TAmbiTracks, typename Assoc, typename RevIndices>
+  void runAssocWithTimeSweep(o2::aod::Collisions const& collisions,
+                             TTracksUnfiltered const& tracksUnfiltered,
+                             TTracks const& tracks,
+                             TAmbiTracks const& ambiguousTracks,
+                             o2::aod::BCs const&,
+                             Assoc& association,
+                             RevIndices& reverseIndices)
+  {
+    if (mIncludeUnassigned) {
+      fillAmbiguousTrackBCs<TTracks>(ambiguousTracks);
+    }
+
+    // collisions, sorted in BC
+    mSweepCollBC.clear();
+    mSweepCollTime.clear();
+    mSweepCollTimeRes2.clear();
+    mSweepCollIdx.clear();
+    for (const auto& collision : collisions) {
+      mSweepCollBC.push_back(collision.bc().globalBC());
+      mSweepCollTime.push_back(collision.collisionTime());
+      mSweepCollTimeRes2.push_back(collision.collisionTimeRes() * collision.collisionTimeRes());
+      mSweepCollIdx.push_back(collision.globalIndex());
+    }
+    mSweepCollOrder.resize(mSweepCollBC.size());
+    for (std::size_t i = 0; i < mSweepCollOrder.size(); i++) {
+      mSweepCollOrder[i] = i;
+    }
+    std::stable_sort(mSweepCollOrder.begin(), mSweepCollOrder.end(), [this](int a, int b) { return mSweepCollBC[a] < mSweepCollBC[b]; });
+
+    // tracks with a BC, with the quantities needed for the time compatibility, sorted in BC + track time
+    mSweepTracks.clear();
+    int trackRow = 0;
+    for (const auto& track : tracks) {
+      SweepTrack sweepTrack;
+      sweepTrack.row = trackRow++;
+      sweepTrack.globalIndex = track.globalIndex();
+      sweepTrack.bc = -1;
+      if (track.has_collision()) {
+        sweepTrack.bc = track.collision().bc().globalBC();
+      } else if (mIncludeUnassigned) {
+        sweepTrack.bc = getAmbiguousTrackBC(track.globalIndex());
+      }
+      if (sweepTrack.bc < 0) {
+        continue;
+      }
+      sweepTrack.bcWithTime = sweepTrack.bc + track.trackTime() / o2::constants::lhc::LHCBunchSpacingNS;
+      sweepTrack.time = track.trackTime();
+      sweepTrack.timeRes = track.trackTimeRes();
+      sweepTrack.thresholdType = kThresholdNone;
+      if constexpr (isCentralBarrel) {
+        if (mUsePvAssociation && track.isPVContributor()) {
+          sweepTrack.time = track.collision().collisionTime();        // if PV contributor, we assume the time to be the one of the collision
+          sweepTrack.timeRes = o2::constants::lhc::LHCBunchSpacingNS; // 1 BC
+          sweepTrack.thresholdType = kThresholdPvContributor;
+        } else if (TESTBIT(track.flags(), o2::aod::track::TrackTimeResIsRange)) {
+          sweepTrack.thresholdType = kThresholdRange;
         } else {
-          reverseIndices(*collsPerTrack[trackId].get());
+          sweepTrack.thresholdType = kThresholdGaussian;
+        }
+      } else {
+        if constexpr (TTracks::template contains<o2::aod::MFTTracks>()) {
+          sweepTrack.thresholdType = kThresholdRange;
+        } else if constexpr (TTracks::template contains<o2::aod::FwdTracks>()) {
+          sweepTrack.thresholdType = kThresholdGaussian;
         }
       }
+      mSweepTracks.push_back(sweepTrack);
     }
+    std::sort(mSweepTracks.begin(), mSweepTracks.end(), [](const SweepTrack& a, const SweepTrack& b) { return a.bcWithTime < b.bcWithTime; });
+
+    // sweep: the first collision of the BC window only moves forward since the tracks are sorted
+    const int64_t bcOffsetMax = mBcWindowForOneSigma * mNumSigmaForTimeCompat + mTimeMargin / o2::constants::lhc::LHCBunchSpacingNS;
+    mSweepPairs.clear();
+    mSweepPairTrackIdx.clear();
+    std::size_t firstColl = 0;
+    const std::size_t nColls = mSweepCollOrder.size();
+    for (const auto& sweepTrack : mSweepTracks) {
+      while (firstColl < nColls && mSweepCollBC[mSweepCollOrder[firstColl]] < sweepTrack.bcWithTime - bcOffsetMax) {
+        firstColl++;
+      }
+      for (std::size_t iColl = firstColl; iColl < nColls; iColl++) {
+        const int coll = mSweepCollOrder[iColl];
+        const int64_t collBC = mSweepCollBC[coll];
+        if (collBC > sweepTrack.bcWithTime + bcOffsetMax) {
+          break;
+        }
+        const float deltaTime = sweepTrack.time - mSweepCollTime[coll] + (sweepTrack.bc - collBC) * o2::constants::lhc::LHCBunchSpacingNS;
+        const float collTimeRes2 = mSweepCollTimeRes2[coll];
+        float thresholdTime = 0.;
+        switch (sweepTrack.thresholdType) {
+          case kThresholdPvContributor:
+            thresholdTime = sweepTrack.timeRes;
+            break;
+          case kThresholdRange:
+            thresholdTime = sweepTrack.timeRes + mNumSigmaForTimeCompat * std::sqrt(collTimeRes2) + mTimeMargin;
+            break;
+          case kThresholdGaussian:
+            thresholdTime = mNumSigmaForTimeCompat * std::sqrt(collTimeRes2 + sweepTrack.timeRes * sweepTrack.timeRes) + mTimeMargin;
+            break;
+          default:
+            break;
+        }
+        if (std::abs(deltaTime) < thresholdTime) {
+          // key ordered as in runAssocWithTime: by collision, then by track row
+          mSweepPairs.push_back((static_cast<uint64_t>(coll) << 32) | static_cast<uint32_t>(sweepTrack.row));
+          mSweepPairTrackIdx.push_back(sweepTrack.globalIndex);
+        }
+      }
+    }
+
+    // write the association ordered by collision
+    mSweepPairOrder.resize(mSweepPairs.size());
+    for (std::size_t i = 0; i < mSweepPairOrder.size(); i++) {
+      mSweepPairOrder[i] = i;
+    }
+    std::sort(mSweepPairOrder.begin(), mSweepPairOrder.end(), [this](int a, int b) { return mSweepPairs[a] < mSweepPairs[b]; });
+    for (auto iPair : mSweepPairOrder) {
+      association(mSweepCollIdx[mSweepPairs[iPair] >> 32], mSweepPairTrackIdx[iPair]);
+    }
+
+    // create reverse index track to collisions if enabled, using a flat buffer of collisions per track
+    if (mFillTableOfCollIdsPerTrack) {
+      int64_t maxTrackIdx = -1;
+      for (const auto& track : tracksUnfiltered) {
+        maxTrackIdx = std::max<int64_t>(maxTrackIdx, track.globalIndex());
+      }
+      mSweepCollsPerTrackOffsets.assign(maxTrackIdx + 2, 0);
+      for (auto iPair : mSweepPairOrder) {
+        mSweepCollsPerTrackOffsets[mSweepPairTrackIdx[iPair] + 1]++;
+      }
+      for (std::size_t i = 1; i < mSweepCollsPerTrackOffsets.size(); i++) {
+        mSweepCollsPerTrackOffsets[i] += mSweepCollsPerTrackOffsets[i - 1];
+      }
+      mSweepCollsPerTrack.resize(mSweepPairOrder.size());
+      mSweepCollsPerTrackFill.assign(mSweepCollsPerTrackOffsets.begin(), mSweepCollsPerTrackOffsets.end() - 1);
+      for (auto iPair : mSweepPairOrder) {
+        mSweepCollsPerTrack[mSweepCollsPerTrackFill[mSweepPairTrackIdx[iPair]]++] = mSweepCollIdx[mSweepPairs[iPair] >> 32];
+      }
+      std::vector<int> collIds;
+      for (const auto& track : tracksUnfiltered) {
+        const auto trackId = track.globalIndex();
+        collIds.assign(mSweepCollsPerTrack.begin() + mSweepCollsPerTrackOffsets[trackId], mSweepCollsPerTrack.begin() + mSweepCollsPerTrackOffsets[trackId + 1]);
+        reverseIndices(collIds);
+      }
+    }
+    mSweepPairTrackIdx.clear();
   }
 
  private:
+  enum ThresholdType {
+    kThresholdNone = 0,
+    kThresholdPvContributor,
+    kThresholdRange,
+    kThresholdGaussian
+  };
+  struct SweepTrack {
+    int row; // row in the (filtered) track table
+    int64_t globalIndex;
+    int64_t bc;         // BC of the track collision, or of the ambiguous track
+    int64_t bcWithTime; // BC including the track time
+    float time;
+    float timeRes;
+    int thresholdType;
+  };
+
+  template <typename TTracks, typename TAmbiTracks>
+  void fillAmbiguousTrackBCs(TAmbiTracks const& ambiguousTracks)
+  {
+    // entries are -2 for tracks without ambiguous-track entry and -1 for ambiguous tracks without BC
+    int64_t maxTrackId = -1;
+    for (const auto& ambTrack : ambiguousTracks) {
+      if constexpr (isCentralBarrel) { // FIXME: to be removed as soon as it is possible to use getId<Table>() for joined tables
+        maxTrackId = std::max<int64_t>(maxTrackId, ambTrack.trackId());
+      } else {
+        maxTrackId = std::max<int64_t>(maxTrackId, ambTrack.template getId<TTracks>());
+      }
+    }
+    mAmbTrackBC.assign(maxTrackId + 1, -2);
+    for (const auto& ambTrack : ambiguousTracks) {
+      int64_t trackId = -1;
+      if constexpr (isCentralBarrel) {
+        trackId = ambTrack.trackId();
+      } else {
+        trackId = ambTrack.template getId<TTracks>();
+      }
+      if (trackId < 0 || mAmbTrackBC[trackId] != -2) { // keep the first entry of each track
+        continue;
+      }
+      if constexpr (isCentralBarrel) {
+        mAmbTrackBC[trackId] = (!ambTrack.has_bc() || ambTrack.bc().size() == 0) ? -1 : ambTrack.bc().begin().globalBC();
+      } else {
+        mAmbTrackBC[trackId] = ambTrack.bc().begin().globalBC();
+      }
+    }
+  }
+  int64_t getAmbiguousTrackBC(int64_t trackId) const
+  {
+    if (trackId < 0 || trackId >= static_cast<int64_t>(mAmbTrackBC.size()) || mAmbTrackBC[trackId] < 0) {
+      return -1;
+    }
+    return mAmbTrackBC[trackId];
+  }
+
   float mNumSigmaForTimeCompat{4.};                                                  // number of sigma for time compatibility
   float mTimeMargin{500.};                                                           // additional time margin in ns
   int mTrackSelection{o2::aod::track_association::TrackSelection::GlobalTrackWoDCA}; // track selection for central barrel tracks (standard association only)
@@ -298,6 +496,23 @@ class CollisionAssociation
   bool mIncludeUnassigned{true};                                                     // include tracks that were originally not assigned to any collision
   bool mFillTableOfCollIdsPerTrack{false};                                           // fill additional table with vectors of compatible collisions per track
   int mBcWindowForOneSigma{115};                                                     // BC window to be multiplied by the number of sigmas to define maximum window to be considered
+  bool mUseSweepLine{false};                                                         // use runAssocWithTimeSweep in runAssocWithTime
+
+  // buffers reused between calls
+  std::vector<int64_t> mAmbTrackBC;                // first BC of the ambiguous tracks, by track global index
+  std::vector<int64_t> mSweepCollBC;               // collision BCs
+  std::vector<float> mSweepCollTime;               // collision times
+  std::vector<float> mSweepCollTimeRes2;           // squared collision time resolutions
+  std::vector<int64_t> mSweepCollIdx;              // collision global indices
+  std::vector<int> mSweepCollOrder;                // collisions ordered in BC
+  std::vector<SweepTrack> mSweepTracks;            // tracks ordered in BC
+  std::vector<uint64_t> mSweepPairs;               // compatible pairs, as collision row << 32 | track row
+  std::vector<int64_t> mSweepPairTrackIdx;         // track global index of each pair
+  std::vector<int> mSweepPairOrder;                // pairs ordered by collision and track
+  std::vector<int64_t> mSweepCollsPerTrackOffsets; // offsets of each track in mSweepCollsPerTrack
+  std::vector<int64_t> mSweepCollsPerTrackFill;    // fill positions of each track in mSweepCollsPerTrack
+  std::vector<int> mSweepCollsPerTrack;            // compatible collisions of all tracks
+  DataframeArena mArena{1 << 16};                  // collisions per track of runAssocWithTime
 };
 
 #endif // COMMON_CORE_COLLISIONASSOCIATION_H_
@@ -0,0 +1,98 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DataframeArena.h
+/// \brief  Monotonic memory arena for the temporary containers built per collision or per candidate within a dataframe
+///         The allocations are only freed, all at once, by reset(), e.g. at the beginning or at the end of each process call.
+///         The buffer grows to the peak size of the previous cycles, so that after a few dataframes the containers of
+///         a cycle are served from a single allocation.
+///
+///         Usage:
+///           DataframeArena arena;                                      // task member
+///           arena.reset();                                             // in process, no container of the previous cycle is alive
+///           ArenaVector<int> indices(&arena);                          // std::pmr::vector using the arena
+///           ArenaVector<ArenaVector<int>> indicesPerTrack(n, &arena);  // the inner vectors use the arena as well
+///
+
+#ifndef COMMON_CORE_DATAFRAMEARENA_H_
+#define COMMON_CORE_DATAFRAMEARENA_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+template <typename T>
+using ArenaVector = std::pmr::vector<T>;
+
+class DataframeArena : public std::pmr::memory_resource
+{
+ public:
+  /// \param initialSize size in bytes of the first buffer
+  explicit DataframeArena(std::size_t initialSize = 1 << 20) : mCapacity(std::max<std::size_t>(initialSize, 1024))
+  {
+    allocateBuffer();
+  }
+  DataframeArena(const DataframeArena&) = delete;
+  DataframeArena& operator=(const DataframeArena&) = delete;
+
+  /// Frees all the allocations, the containers using the arena must not be used afterwards
+  void reset()
+  {
+    mPeakBytes = std::max(mPeakBytes, mBytes);
+    if (mBytes > mCapacity) {
+      // the cycle needed allocations beyond the buffer, the next ones start from a buffer of the peak size
+      while (mCapacity < mBytes) {
+        mCapacity *= 2;
+      }
+      allocateBuffer();
+    } else {
+      mResource->release();
+    }
+    mBytes = 0;
+  }
+
+  /// Bytes allocated since the last reset
+  std::size_t bytes() const { return mBytes; }
+  /// Largest number of bytes allocated in a cycle
+  std::size_t peakBytes() const { return std::max(mPeakBytes, mBytes); }
+  /// Size of the buffer
+  std::size_t capacity() const { return mCapacity; }
+
+ private:
+  void allocateBuffer()
+  {
+    mResource.reset();
+    mBuffer.reset(new std::byte[mCapacity]);
+    mResource = std::make_unique<std::pmr::monotonic_buffer_resource>(mBuffer.get(), mCapacity, std::pmr::new_delete_resource());
+  }
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    mBytes += bytes;
+    return mResource->allocate(bytes, alignment);
+  }
+
+  // the memory is only released by reset()
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  std::size_t mCapacity;
+  std::size_t mBytes = 0;
+  std::size_t mPeakBytes = 0;
+  std::unique_ptr<std::byte[]> mBuffer;
+  std::unique_ptr<std::pmr::monotonic_buffer_resource> mResource;
+};
+
+#endif // COMMON_CORE_DATAFRAMEARENA_H_
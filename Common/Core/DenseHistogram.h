@@ -0,0 +1,223 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DenseHistogram.h
+/// \brief  Accumulator of the fills of a 1D, 2D or 3D ROOT histogram (e.g. owned by a HistogramRegistry) in dense arrays
+///         The bin of an entry is found without the virtual TH1::Fill and TAxis calls, the contents, the sum of the squared
+///         weights, the statistics and the entries are accumulated in the same way as TH1::Fill does (in double precision)
+///         and are added to the histogram by flush(), e.g. at the end of each process call, so the output is unchanged.
+///         Profiles and axes with labels are not supported.
+///
+///         Usage:
+///           DenseHistogram<2> hPtEta;
+///           hPtEta.bind(registry.add<TH2>("hPtEta", "hPtEta", kTH2F, {axisPt, axisEta}));  // in init
+///           hPtEta.fill(track.pt(), track.eta());                                          // in process
+///           hPtEta.flush();                                                                // at the end of process
+///
+
+#ifndef COMMON_CORE_DENSEHISTOGRAM_H_
+#define COMMON_CORE_DENSEHISTOGRAM_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gsl/span>
+
+#include <TArrayD.h>
+#include <TAxis.h>
+#include <TH1.h>
+#include <TProfile.h>
+
+#include "Framework/Logger.h"
+
+template <int N>
+class DenseHistogram
+{
+  static_assert(N >= 1 && N <= 3, "DenseHistogram supports 1D, 2D and 3D histograms");
+
+ public:
+  /// Binds the accumulator to a histogram, its binning is copied and the accumulated content is reset
+  void bind(std::shared_ptr<TH1> hist)
+  {
+    if (!hist || hist->GetDimension() != N || hist->InheritsFrom(TProfile::Class())) {
+      LOG(fatal) << "DenseHistogram<" << N << ">: the histogram " << (hist ? hist->GetName() : "nullptr") << " is not a " << N << "D histogram";
+    }
+    mHist = hist;
+    const TAxis* axes[3] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+    std::size_t nCells = 1;
+    for (int i = 0; i < N; i++) {
+      Axis& axis = mAxes[i];
+      axis.nBins = axes[i]->GetNbins();
+      axis.min = axes[i]->GetXmin();
+      axis.max = axes[i]->GetXmax();
+      axis.edges.clear();
+      if (axes[i]->GetXbins()->GetSize() > 0) {
+        const double* edges = axes[i]->GetXbins()->GetArray();
+        axis.edges.assign(edges, edges + axis.nBins + 1);
+      }
+      axis.stride = nCells;
+      nCells *= axis.nBins + 2; // with under- and overflow, as the global bins of ROOT
+    }
+    mContent.assign(nCells, 0.);
+    mSumw2.assign(nCells, 0.);
+    reset();
+  }
+
+  /// Adds an entry
+  template <typename... T>
+  void fill(T... values)
+  {
+    static_assert(sizeof...(T) == N || sizeof...(T) == N + 1, "DenseHistogram::fill takes N values and an optional weight");
+    const std::array<double, sizeof...(T)> args{static_cast<double>(values)...};
+    const double weight = sizeof...(T) == N + 1 ? args[N] : 1.;
+    std::size_t cell = 0;
+    bool inRange = true;
+    for (int i = 0; i < N; i++) {
+      const int bin = findBin(mAxes[i], args[i]);
+      inRange &= bin > 0 && bin <= mAxes[i].nBins;
+      cell += bin * mAxes[i].stride;
+    }
+    mContent[cell] += weight;
+    mSumw2[cell] += weight * weight;
+    mHasWeights |= weight != 1.;
+    mEntries++;
+    if (!inRange) {
+      // as TH1::Fill, the under- and overflows are not included in the statistics
+      return;
+    }
+    // same order as TH1::GetStats, TH2::GetStats and TH3::GetStats
+    mStats[0] += weight;
+    mStats[1] += weight * weight;
+    mStats[2] += weight * args[0];
+    mStats[3] += weight * args[0] * args[0];
+    if constexpr (N >= 2) {
+      mStats[4] += weight * args[1];
+      mStats[5] += weight * args[1] * args[1];
+      mStats[6] += weight * args[0] * args[1];
+    }
+    if constexpr (N == 3) {
+      mStats[7] += weight * args[2];
+      mStats[8] += weight * args[2] * args[2];
+      mStats[9] += weight * args[0] * args[2];
+      mStats[10] += weight * args[1] * args[2];
+    }
+  }
+
+  /// Adds the entries of parallel arrays of values (and weights), e.g. filled in a loop over the tracks of a collision
+  void fillN(const std::array<gsl::span<const float>, N>& values, gsl::span<const float> weights = {})
+  {
+    const std::size_t n = values[0].size();
+    for (int i = 1; i < N; i++) {
+      if (values[i].size() != n) {
+        LOG(fatal) << "DenseHistogram::fillN: arrays of different sizes for " << mHist->GetName();
+      }
+    }
+    if (!weights.empty() && weights.size() != n) {
+      LOG(fatal) << "DenseHistogram::fillN: arrays of different sizes for " << mHist->GetName();
+    }
+    for (std::size_t k = 0; k < n; k++) {
+      const double weight = weights.empty() ? 1. : weights[k];
+      if constexpr (N == 1) {
+        fill(values[0][k], weight);
+      } else if constexpr (N == 2) {
+        fill(values[0][k], values[1][k], weight);
+      } else {
+        fill(values[0][k], values[1][k], values[2][k], weight);
+      }
+    }
+  }
+
+  /// Adds the accumulated entries to the histogram and resets the accumulator
+  void flush()
+  {
+    if (mEntries == 0) {
+      return;
+    }
+    // TH1::Fill creates the sum of the squared weights at the first weight != 1
+    if (mHasWeights && mHist->GetSumw2N() == 0) {
+      mHist->Sumw2();
+    }
+    const double entries = mHist->GetEntries();
+    std::array<double, TH1::kNstat> stats{};
+    mHist->GetStats(stats.data());
+    for (std::size_t i = 0; i < kNStats; i++) {
+      stats[i] += mStats[i];
+    }
+    TArrayD* sumw2 = mHist->GetSumw2N() > 0 ? mHist->GetSumw2() : nullptr;
+    for (std::size_t cell = 0; cell < mContent.size(); cell++) {
+      if (mSumw2[cell] == 0.) {
+        continue;
+      }
+      mHist->AddBinContent(static_cast<int>(cell), mContent[cell]);
+      if (sumw2) {
+        sumw2->fArray[cell] += mSumw2[cell];
+      }
+      mContent[cell] = 0.;
+      mSumw2[cell] = 0.;
+    }
+    mHist->PutStats(stats.data());
+    mHist->SetEntries(entries + mEntries);
+    reset();
+  }
+
+  std::shared_ptr<TH1> histogram() const { return mHist; }
+  /// Number of entries accumulated since the last flush
+  std::size_t entries() const { return mEntries; }
+
+ private:
+  // size of the statistics of TH1::GetStats for the dimension
+  static constexpr std::size_t kNStats = N == 1 ? 4 : (N == 2 ? 7 : 11);
+
+  struct Axis {
+    int nBins = 0;
+    double min = 0.;
+    double max = 0.;
+    std::vector<double> edges; // only for axes with variable bin width
+    std::size_t stride = 1;    // stride of the axis in the global bin
+  };
+
+  // bin of a value as TAxis::FindFixBin, 0 for the underflow and nBins + 1 for the overflow
+  static int findBin(const Axis& axis, double value)
+  {
+    if (value < axis.min) {
+      return 0;
+    }
+    if (!(value < axis.max)) {
+      return axis.nBins + 1;
+    }
+    if (axis.edges.empty()) {
+      // same arithmetic as TAxis::FindFixBin, so that the entries close to the edges end up in the same bins
+      return 1 + static_cast<int>(axis.nBins * (value - axis.min) / (axis.max - axis.min));
+    }
+    return std::upper_bound(axis.edges.begin(), axis.edges.end(), value) - axis.edges.begin();
+  }
+
+  void reset()
+  {
+    mStats.fill(0.);
+    mEntries = 0;
+    mHasWeights = false;
+  }
+
+  std::shared_ptr<TH1> mHist;
+  std::array<Axis, N> mAxes;
+  std::vector<double> mContent; // content per global bin
+  std::vector<double> mSumw2;   // sum of the squared weights per global bin, also marks the filled bins
+  std::array<double, kNStats> mStats{};
+  std::size_t mEntries = 0;
+  bool mHasWeights = false;
+};
+
+#endif // COMMON_CORE_DENSEHISTOGRAM_H_
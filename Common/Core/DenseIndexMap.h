@@ -0,0 +1,85 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DenseIndexMap.h
+/// \brief  Map of the global indices of a table of a dataframe to the indices of the skimmed objects, e.g. to write the
+///         skimmed MC stack with remapped labels
+///         The global indices of a table are dense within a dataframe, so the new index of each original index is stored
+///         in a flat array sized once per dataframe (-1 for the objects not kept), instead of a std::map. The new indices
+///         are assigned in the order of insertion, and the original indices are kept in the same order for the writing of
+///         the skimmed tables.
+///
+///         Usage:
+///           DenseIndexMap newLabels;
+///           newLabels.reset(mcParticles.size());             // at the beginning of process
+///           newLabels.insert(mcParticle.globalIndex());      // true if added, with the new index size() - 1
+///           int label = newLabels[mcParticle.globalIndex()]; // -1 if not kept
+///           for (std::size_t i = 0; i < newLabels.size(); i++) { auto mcParticle = mcParticles.iteratorAt(newLabels.original(i)); ... }
+///
+
+#ifndef COMMON_CORE_DENSEINDEXMAP_H_
+#define COMMON_CORE_DENSEINDEXMAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Framework/Logger.h"
+
+class DenseIndexMap
+{
+ public:
+  /// Removes all the entries and prepares the map for the original indices [0, nOriginal)
+  void reset(std::size_t nOriginal)
+  {
+    mNewIndices.assign(nOriginal, -1);
+    mOriginalIndices.clear();
+  }
+
+  /// Adds an original index with the next new index, if it is not in the map yet
+  /// \return true if the index was added
+  bool insert(int64_t originalIndex)
+  {
+    if (originalIndex < 0 || originalIndex >= static_cast<int64_t>(mNewIndices.size())) {
+      LOG(fatal) << "DenseIndexMap: index " << originalIndex << " beyond the " << mNewIndices.size() << " indices of the reset";
+    }
+    if (mNewIndices[originalIndex] >= 0) {
+      return false;
+    }
+    mNewIndices[originalIndex] = mOriginalIndices.size();
+    mOriginalIndices.push_back(originalIndex);
+    return true;
+  }
+
+  bool contains(int64_t originalIndex) const { return (*this)[originalIndex] >= 0; }
+
+  /// New index of an original index, -1 if it is not in the map (or if it is not a valid index)
+  int operator[](int64_t originalIndex) const
+  {
+    if (originalIndex < 0 || originalIndex >= static_cast<int64_t>(mNewIndices.size())) {
+      return -1;
+    }
+    return mNewIndices[originalIndex];
+  }
+
+  /// Original index of a new index
+  int64_t original(std::size_t newIndex) const { return mOriginalIndices[newIndex]; }
+
+  /// Number of indices in the map
+  std::size_t size() const { return mOriginalIndices.size(); }
+
+ private:
+  std::vector<int> mNewIndices;          // new index per original index, -1 if not in the map
+  std::vector<int64_t> mOriginalIndices; // original index per new index
+};
+
+#endif // COMMON_CORE_DENSEINDEXMAP_H_
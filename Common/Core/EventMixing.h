@@ -12,6 +12,13 @@
 #ifndef ANALYSIS_CORE_EVENTMIXING_H_
 #define ANALYSIS_CORE_EVENTMIXING_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 namespace eventmixing
 {
 /// Calculate hash for an element based on 2 properties and their bins.
@@ -45,6 +52,244 @@ static int getMixingBin(const T1& vtxBins, const T1& multBins, const T2& vtx, co
   // overflow
   return -1;
 }
+
+/// N-dimensional event binning (e.g. z-vertex, centrality, event plane, occupancy) with a flat bin index
+/// Each axis is defined by its bin edges, values outside the axis range give no bin
+class MixingBinning
+{
+ public:
+  /// Add an axis with variable bin widths
+  /// \param edges Bin edges, in increasing order
+  void addAxis(std::vector<double> const& edges)
+  {
+    mEdges.push_back(edges);
+    mStrides.push_back(mNBins);
+    mNBins *= (edges.size() > 1 ? edges.size() - 1 : 1);
+  }
+  /// Add an axis with fixed bin width
+  void addAxis(int nBins, double min, double max)
+  {
+    std::vector<double> edges(nBins + 1);
+    for (int i = 0; i <= nBins; i++) {
+      edges[i] = min + i * (max - min) / nBins;
+    }
+    addAxis(edges);
+  }
+  /// \return Number of bins over all axes
+  int getNBins() const { return mNBins; }
+  /// \return Number of axes
+  int getNAxes() const { return mEdges.size(); }
+
+  /// Calculate the flat bin index of an event
+  /// \param values Value of the event for each axis, in the order of the axes
+  /// \return Bin index, or -1 if any value is outside its axis
+  template <typename... Ts>
+  int getBin(Ts... values) const
+  {
+    const double vals[] = {static_cast<double>(values)...};
+    if (sizeof...(Ts) != mEdges.size()) {
+      return -1;
+    }
+    int bin = 0;
+    for (std::size_t iAxis = 0; iAxis < mEdges.size(); iAxis++) {
+      const auto& edges = mEdges[iAxis];
+      if (edges.size() < 2 || !(vals[iAxis] >= edges.front()) || vals[iAxis] >= edges.back()) {
+        return -1;
+      }
+      const int axisBin = std::upper_bound(edges.begin(), edges.end(), vals[iAxis]) - edges.begin() - 1;
+      bin += axisBin * mStrides[iAxis];
+    }
+    return bin;
+  }
+
+ private:
+  std::vector<std::vector<double>> mEdges; // bin edges of each axis
+  std::vector<int> mStrides;               // stride of each axis in the flat bin index
+  int mNBins = 1;                          // total number of bins
+};
+
+/// Event stored in a mixing pool: event information and particle columns (one std::vector per column)
+/// \tparam TEventInfo Type of the event information (e.g. a small struct with the event quantities needed in the pair loop)
+/// \tparam TColumns Types of the particle columns
+template <typename TEventInfo, typename... TColumns>
+class MixingEvent
+{
+ public:
+  /// \return Number of particles in the event
+  std::size_t size() const { return std::get<0>(mColumns).size(); }
+  /// \return Value of the column I of a particle
+  template <std::size_t I>
+  auto const& get(std::size_t particle) const
+  {
+    return std::get<I>(mColumns)[particle];
+  }
+  /// \return Column I of the event
+  template <std::size_t I>
+  auto const& column() const
+  {
+    return std::get<I>(mColumns);
+  }
+  TEventInfo const& info() const { return mInfo; }
+  int64_t eventId() const { return mEventId; }
+  int bin() const { return mBin; }
+
+ private:
+  template <typename, typename...>
+  friend class MixingPool;
+
+  void clear()
+  {
+    std::apply([](auto&... columns) { (columns.clear(), ...); }, mColumns);
+  }
+  void add(TColumns const&... values)
+  {
+    addImpl(std::index_sequence_for<TColumns...>{}, values...);
+  }
+  template <std::size_t... Is>
+  void addImpl(std::index_sequence<Is...>, TColumns const&... values)
+  {
+    (std::get<Is>(mColumns).push_back(values), ...);
+  }
+  std::size_t getMemorySize() const
+  {
+    std::size_t memory = 0;
+    std::apply([&memory](auto const&... columns) { ((memory += columns.capacity() * sizeof(typename std::decay_t<decltype(columns)>::value_type)), ...); }, mColumns);
+    return memory;
+  }
+
+  std::tuple<std::vector<TColumns>...> mColumns;
+  TEventInfo mInfo{};
+  int64_t mEventId = -1;
+  int mBin = -1;
+};
+
+/// Mixing pool with a fixed-depth ring of events per bin
+/// The pool is meant to be a member of the task, so that the events are kept across dataframes.
+/// The storage of each slot is reused when it is overwritten, so the memory is bounded by
+/// the number of bins x (depth + 1) x the largest number of particles kept per event.
+/// Usage, per event: startEvent(), addParticle() for each particle, mixing with forEachMixedEvent()
+/// or forEachMixedPair(), and finishEvent() to store the event in the pool.
+/// \tparam TEventInfo Type of the event information
+/// \tparam TColumns Types of the particle columns
+template <typename TEventInfo, typename... TColumns>
+class MixingPool
+{
+ public:
+  using Event = MixingEvent<TEventInfo, TColumns...>;
+
+  /// \param nBins Number of event bins (e.g. MixingBinning::getNBins())
+  /// \param depth Number of events kept per bin
+  /// \param maxParticlesPerEvent Maximum number of particles kept per event, no limit if negative
+  void init(int nBins, int depth, int maxParticlesPerEvent = -1)
+  {
+    mDepth = depth;
+    mMaxParticlesPerEvent = maxParticlesPerEvent;
+    mEvents.assign(nBins, std::vector<Event>(depth));
+    mNextSlot.assign(nBins, 0);
+    mNFilled.assign(nBins, 0);
+  }
+  /// Remove all events from the pool, the allocated memory is kept
+  void clear()
+  {
+    for (auto& binEvents : mEvents) {
+      for (auto& event : binEvents) {
+        event.clear();
+        event.mEventId = -1;
+      }
+    }
+    std::fill(mNextSlot.begin(), mNextSlot.end(), 0);
+    std::fill(mNFilled.begin(), mNFilled.end(), 0);
+    mCurrent.clear();
+    mCurrent.mBin = -1;
+  }
+
+  /// Start a new event. Events with a bin outside the pool are not mixed nor stored
+  void startEvent(int bin, int64_t eventId, TEventInfo const& info = TEventInfo{})
+  {
+    mCurrent.clear();
+    mCurrent.mBin = (bin >= 0 && bin < static_cast<int>(mEvents.size())) ? bin : -1;
+    mCurrent.mEventId = eventId;
+    mCurrent.mInfo = info;
+  }
+  /// Add a particle to the current event
+  /// \return false if the particle was not added because of the limit on the number of particles per event
+  bool addParticle(TColumns const&... values)
+  {
+    if (mMaxParticlesPerEvent >= 0 && static_cast<int>(mCurrent.size()) >= mMaxParticlesPerEvent) {
+      return false;
+    }
+    mCurrent.add(values...);
+    return true;
+  }
+  /// Store the current event in the pool, overwriting the oldest event of its bin if the pool is full
+  /// Events without particles are not stored
+  void finishEvent()
+  {
+    const int bin = mCurrent.mBin;
+    if (bin < 0 || mDepth <= 0 || mCurrent.size() == 0) {
+      return;
+    }
+    auto& slot = mEvents[bin][mNextSlot[bin]];
+    std::swap(slot, mCurrent); // swapping keeps the allocated storage of both events
+    mCurrent.clear();
+    mCurrent.mBin = -1;
+    mNextSlot[bin] = (mNextSlot[bin] + 1) % mDepth;
+    mNFilled[bin] = std::min(mNFilled[bin] + 1, mDepth);
+  }
+
+  /// \return Current event
+  Event const& getCurrentEvent() const { return mCurrent; }
+  /// \return Number of events stored for a bin
+  int getNEvents(int bin) const { return (bin >= 0 && bin < static_cast<int>(mNFilled.size())) ? mNFilled[bin] : 0; }
+
+  /// Call f(current, pooled) for each event stored in the bin of the current event
+  template <typename F>
+  void forEachMixedEvent(F&& f) const
+  {
+    const int bin = mCurrent.mBin;
+    if (bin < 0) {
+      return;
+    }
+    for (int i = 0; i < mNFilled[bin]; i++) {
+      const auto& pooled = mEvents[bin][i];
+      if (pooled.mEventId != mCurrent.mEventId) {
+        f(mCurrent, pooled);
+      }
+    }
+  }
+  /// Call f(current, i, pooled, j) for each pair of a particle i of the current event and a particle j of a stored event
+  template <typename F>
+  void forEachMixedPair(F&& f) const
+  {
+    forEachMixedEvent([&f](Event const& current, Event const& pooled) {
+      for (std::size_t i = 0; i < current.size(); i++) {
+        for (std::size_t j = 0; j < pooled.size(); j++) {
+          f(current, i, pooled, j);
+        }
+      }
+    });
+  }
+
+  /// \return Approximate memory allocated for the particle columns, in bytes
+  std::size_t getMemorySize() const
+  {
+    std::size_t memory = mCurrent.getMemorySize();
+    for (const auto& binEvents : mEvents) {
+      for (const auto& event : binEvents) {
+        memory += event.getMemorySize();
+      }
+    }
+    return memory;
+  }
+
+ private:
+  std::vector<std::vector<Event>> mEvents; // ring of events per bin
+  std::vector<int> mNextSlot;              // slot to be overwritten next, per bin
+  std::vector<int> mNFilled;               // number of events stored, per bin
+  Event mCurrent;                          // event being filled
+  int mDepth = 0;                          // number of events kept per bin
+  int mMaxParticlesPerEvent = -1;          // maximum number of particles per event, no limit if negative
+};
 }; // namespace eventmixing
 
 #endif /* ANALYSIS_CORE_EVENTMIXING_H_ */
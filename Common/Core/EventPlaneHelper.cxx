@@ -102,6 +102,63 @@ void EventPlaneHelper::SumQvectors(int det, int chno, float ampl, int nmod, TCom
   sum += ampl;
 }
 
+void EventPlaneHelper::BuildChannelTables(o2::ft0::Geometry ft0geom, o2::fv0::Geometry* fv0geom, int maxHarmonic)
+{
+  /* Calculate once the azimuthal angle of each channel, with the current offsets, and
+    store cos(n*phi) and sin(n*phi) for the harmonics n = 1 to maxHarmonic. */
+  mMaxHarmonic = maxHarmonic;
+  mCosFT0.assign(maxHarmonic * kNChannelsFT0, 0.);
+  mSinFT0.assign(maxHarmonic * kNChannelsFT0, 0.);
+  mCosFV0.assign(maxHarmonic * kNChannelsFV0, 0.);
+  mSinFV0.assign(maxHarmonic * kNChannelsFV0, 0.);
+
+  ft0geom.calculateChannelCenter();
+  for (int chno = 0; chno < kNChannelsFT0; chno++) {
+    double offsetX = (chno < 96) ? mOffsetFT0AX : 0.; // Offset only for FT0-A, as in GetPhiFT0.
+    double offsetY = (chno < 96) ? mOffsetFT0AY : 0.;
+    auto chPos = ft0geom.getChannelCenter(chno);
+    double phi = TMath::ATan2(chPos.Y() + static_cast<float>(offsetY), chPos.X() + static_cast<float>(offsetX));
+    for (int n = 1; n <= maxHarmonic; n++) {
+      mCosFT0[(n - 1) * kNChannelsFT0 + chno] = TMath::Cos(phi * n);
+      mSinFT0[(n - 1) * kNChannelsFT0 + chno] = TMath::Sin(phi * n);
+    }
+  }
+  for (int chno = 0; chno < kNChannelsFV0; chno++) {
+    double phi = GetPhiFV0(chno, fv0geom);
+    for (int n = 1; n <= maxHarmonic; n++) {
+      mCosFV0[(n - 1) * kNChannelsFV0 + chno] = TMath::Cos(phi * n);
+      mSinFV0[(n - 1) * kNChannelsFV0 + chno] = TMath::Sin(phi * n);
+    }
+  }
+}
+
+void EventPlaneHelper::SumQvectors(int det, const std::vector<int>& channels, const std::vector<float>& amplitudes, int nmod, TComplex& Qvec, float& sum) const
+{
+  /* Add the Q-vectors of the provided channels to the total Q-vector given as argument,
+    as a dot product of the amplitudes with the precomputed cos(n*phi) and sin(n*phi). */
+  if (nmod < 1 || nmod > mMaxHarmonic || (det != 0 && det != 1)) {
+    printf("Channel tables not available for det = %d and n = %d. Skip\n", det, nmod);
+    return;
+  }
+  const int nChannels = (det == 0) ? kNChannelsFT0 : kNChannelsFV0;
+  const double* cosTable = (det == 0) ? &mCosFT0[(nmod - 1) * kNChannelsFT0] : &mCosFV0[(nmod - 1) * kNChannelsFV0];
+  const double* sinTable = (det == 0) ? &mSinFT0[(nmod - 1) * kNChannelsFT0] : &mSinFV0[(nmod - 1) * kNChannelsFV0];
+
+  double qx = 0.;
+  double qy = 0.;
+  for (std::size_t i = 0; i < channels.size(); i++) {
+    const int chno = channels[i];
+    if (chno < 0 || chno >= nChannels) {
+      printf("Error on channel number %d. Skip\n", chno);
+      continue;
+    }
+    qx += amplitudes[i] * cosTable[chno];
+    qy += amplitudes[i] * sinTable[chno];
+    sum += amplitudes[i];
+  }
+  Qvec += TComplex(qx, qy);
+}
+
 int EventPlaneHelper::GetCentBin(float cent)
 {
   const float centClasses[] = {0., 5., 10., 20., 30., 40., 50., 60., 80.};
@@ -68,6 +68,14 @@ class EventPlaneHelper
   // the detector and amplitude.
   void SumQvectors(int det, int chno, float ampl, int nmod, TComplex& Qvec, float& sum, o2::ft0::Geometry ft0geom, o2::fv0::Geometry* fv0geom);
 
+  // Method to precompute cos(n*phi) and sin(n*phi) of all the FT0 and FV0 channels for the
+  // harmonics n = 1 to maxHarmonic. To be called again if the offsets are changed.
+  void BuildChannelTables(o2::ft0::Geometry ft0geom, o2::fv0::Geometry* fv0geom, int maxHarmonic);
+
+  // Method to add the Q-vector and sum of amplitudes of a list of channels of FT0 (det = 0)
+  // or FV0 (det = 1), using the precomputed channel tables.
+  void SumQvectors(int det, const std::vector<int>& channels, const std::vector<float>& amplitudes, int nmod, TComplex& Qvec, float& sum) const;
+
   // Method to get the bin corresponding to a centrality percentile, according to the
   // centClasses[] array defined in Tasks/qVectorsQA.cxx.
   // Note: Any change in one task should be reflected in the other.
@@ -108,6 +116,14 @@ class EventPlaneHelper
   double mOffsetFV0rightX = 0.; // X-coordinate of the offset of FV0-A right.
   double mOffsetFV0rightY = 0.; // Y-coordinate of the offset of FV0-A right.
 
+  static constexpr int kNChannelsFT0 = 208; // 96 channels in FT0-A and 112 in FT0-C.
+  static constexpr int kNChannelsFV0 = 48;  // Readout channels in FV0-A.
+  int mMaxHarmonic = 0;                     //! Largest harmonic of the channel tables.
+  std::vector<double> mCosFT0;              //! cos(n*phi) of the FT0 channels, [(n-1)*kNChannelsFT0 + chno].
+  std::vector<double> mSinFT0;              //! sin(n*phi) of the FT0 channels.
+  std::vector<double> mCosFV0;              //! cos(n*phi) of the FV0 channels, [(n-1)*kNChannelsFV0 + chno].
+  std::vector<double> mSinFV0;              //! sin(n*phi) of the FV0 channels.
+
   ClassDefNV(EventPlaneHelper, 2)
 };
 
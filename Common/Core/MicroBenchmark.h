@@ -0,0 +1,124 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MicroBenchmark.h
+/// \brief  Minimal harness for the standalone benchmarks of the helpers (o2physics-bench-* executables)
+///         Each benchmark is a callable processing a fixed synthetic sample, timed over repetitions of a number of calls.
+///         The results are logged and can be written to a JSON file, to compare tags.
+///
+
+#ifndef COMMON_CORE_MICROBENCHMARK_H_
+#define COMMON_CORE_MICROBENCHMARK_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Framework/Logger.h"
+
+namespace o2::analysis::benchmark
+{
+
+/// Prevents the compiler from removing the computation of a value which is not used otherwise
+template <typename T>
+inline void doNotOptimize(T const& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Result {
+  std::string name;
+  std::size_t itemsPerCall = 0; // items (tracks, candidates, particles) processed per call
+  int nCalls = 0;               // calls per repetition
+  int nRepetitions = 0;
+  double minNs = 0.;    // fastest repetition, per call
+  double medianNs = 0.; // median repetition, per call
+  double meanNs = 0.;   // mean of the repetitions, per call
+};
+
+class Suite
+{
+ public:
+  /// \param nRepetitions number of timed repetitions of each benchmark
+  /// \param nCalls number of calls per repetition
+  Suite(int nRepetitions, int nCalls) : mNRepetitions(std::max(1, nRepetitions)), mNCalls(std::max(1, nCalls)) {}
+
+  /// Times a benchmark, after one untimed call
+  /// \param name name of the benchmark
+  /// \param itemsPerCall number of items processed by one call of the benchmark
+  /// \param benchmark callable without arguments
+  template <typename F>
+  void run(const std::string& name, std::size_t itemsPerCall, F&& benchmark)
+  {
+    benchmark();
+    std::vector<double> nsPerCall(mNRepetitions);
+    for (auto& ns : nsPerCall) {
+      const auto start = std::chrono::steady_clock::now();
+      for (int iCall = 0; iCall < mNCalls; iCall++) {
+        benchmark();
+      }
+      ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / mNCalls;
+    }
+    Result result;
+    result.name = name;
+    result.itemsPerCall = itemsPerCall;
+    result.nCalls = mNCalls;
+    result.nRepetitions = mNRepetitions;
+    double sum = 0.;
+    for (const auto& ns : nsPerCall) {
+      sum += ns;
+    }
+    result.meanNs = sum / mNRepetitions;
+    std::sort(nsPerCall.begin(), nsPerCall.end());
+    result.minNs = nsPerCall.front();
+    result.medianNs = nsPerCall[mNRepetitions / 2];
+    LOGF(info, "%-40s %10.1f ns/call (min %10.1f, mean %10.1f), %8.2f ns/item", name, result.medianNs, result.minNs, result.meanNs, itemsPerCall > 0 ? result.medianNs / itemsPerCall : 0.);
+    mResults.push_back(std::move(result));
+  }
+
+  const std::vector<Result>& results() const { return mResults; }
+
+  /// Writes the results to a JSON file, nothing is written for an empty file name
+  void writeJson(const std::string& fileName) const
+  {
+    if (fileName.empty()) {
+      return;
+    }
+    std::ofstream out(fileName);
+    if (!out) {
+      LOGF(error, "Cannot write the benchmark results to %s", fileName);
+      return;
+    }
+    out << "{\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < mResults.size(); i++) {
+      const Result& r = mResults[i];
+      out << (i == 0 ? "\n" : ",\n");
+      out << "    {\"name\": \"" << r.name << "\", \"items_per_call\": " << r.itemsPerCall << ", \"calls\": " << r.nCalls << ", \"repetitions\": " << r.nRepetitions
+          << ", \"min_ns\": " << r.minNs << ", \"median_ns\": " << r.medianNs << ", \"mean_ns\": " << r.meanNs << "}";
+    }
+    out << "\n  ]\n}\n";
+    LOGF(info, "Benchmark results written to %s", fileName);
+  }
+
+ private:
+  int mNRepetitions;
+  int mNCalls;
+  std::vector<Result> mResults;
+};
+
+} // namespace o2::analysis::benchmark
+
+#endif // COMMON_CORE_MICROBENCHMARK_H_
@@ -431,7 +431,17 @@ class ExpTimes
   template <typename ParamType>
   static float GetExpectedSigma(const ParamType& parameters, const TrackType& track, const float tofSignal, const float collisionTimeRes)
   {
-    const float& mom = track.p();
+    return ComputeExpectedSigma(parameters, track.p(), tofSignal, collisionTimeRes);
+  }
+
+  /// Computes the expected resolution of the t-texp-t0
+  /// \param parameters Detector response parameters
+  /// \param mom Momentum of the track of interest
+  /// \param tofSignal TOF signal of the track of interest
+  /// \param collisionTimeRes Collision time resolution of the track of interest
+  template <typename ParamType>
+  static float ComputeExpectedSigma(const ParamType& parameters, const float mom, const float tofSignal, const float collisionTimeRes)
+  {
     if (mom <= 0) {
       return -999.f;
     }
@@ -500,6 +510,86 @@ class ExpTimes
   }
 };
 
+/// \brief Class to compute the TOF response of several particle hypotheses for the same track
+/// The hypothesis-independent quantities (TOF signal, event time, corrected expected momentum and time shift) are read and computed once per track,
+/// the results are the same as the ones of ExpTimes
+template <typename TrackType>
+class ExpTimesAllSpecies
+{
+ public:
+  ExpTimesAllSpecies() = default;
+  ~ExpTimesAllSpecies() = default;
+
+  /// Reads the track quantities used by all hypotheses
+  /// \param parameters Detector response parameters
+  /// \param track Track of interest
+  template <typename ParamType>
+  void setTrack(const ParamType& parameters, const TrackType& track)
+  {
+    mHasTOF = track.hasTOF();
+    mMomentum = track.p();
+    mTOFSignal = track.tofSignal();
+    mEvTime = track.tofEvTime();
+    mEvTimeErr = track.tofEvTimeErr();
+    if (!mHasTOF) {
+      return;
+    }
+    mLength = track.length();
+    if (track.trackType() == o2::aod::track::Run2Track) {
+      mExpMom = track.tofExpMom() * kCSPEDDInv / (1.f + track.sign() * parameters.getMomentumChargeShift(track.eta()));
+      mTimeShift = 0.f;
+      mHasTimeShift = false;
+    } else {
+      mExpMom = track.tofExpMom() / (1.f + track.sign() * parameters.getMomentumChargeShift(track.eta()));
+      mTimeShift = parameters.getTimeShift(track.eta(), track.sign());
+      mHasTimeShift = true;
+    }
+  }
+
+  /// Expected signal corrected for the momentum and time shifts, as ExpTimes::GetCorrectedExpectedSignal
+  template <o2::track::PID::ID id>
+  float GetCorrectedExpectedSignal() const
+  {
+    if (!mHasTOF) {
+      return defaultReturnValue;
+    }
+    const float expTime = ExpTimes<TrackType, id>::ComputeExpectedTime(mExpMom, mLength);
+    return mHasTimeShift ? expTime + mTimeShift : expTime;
+  }
+
+  /// Expected resolution of the t-texp-t0, as ExpTimes::GetExpectedSigma
+  template <o2::track::PID::ID id, typename ParamType>
+  float GetExpectedSigma(const ParamType& parameters) const
+  {
+    return ExpTimes<TrackType, id>::ComputeExpectedSigma(parameters, mMomentum, mTOFSignal, mEvTimeErr);
+  }
+
+  /// Number of sigmas with respect to the expected time, as ExpTimes::GetSeparation
+  template <o2::track::PID::ID id>
+  float GetSeparation(const float resolution) const
+  {
+    return mHasTOF ? (mTOFSignal - mEvTime - GetCorrectedExpectedSignal<id>()) / resolution : defaultReturnValue;
+  }
+
+  /// Number of sigmas with respect to the expected time, as ExpTimes::GetSeparation
+  template <o2::track::PID::ID id, typename ParamType>
+  float GetSeparation(const ParamType& parameters) const
+  {
+    return GetSeparation<id>(GetExpectedSigma<id>(parameters));
+  }
+
+ private:
+  bool mHasTOF = false;       /// Track has a TOF signal
+  bool mHasTimeShift = false; /// Time shift applied (Run 3 tracks)
+  float mMomentum = 0.f;      /// Track momentum
+  float mTOFSignal = 0.f;     /// TOF signal
+  float mEvTime = 0.f;        /// Event time
+  float mEvTimeErr = 0.f;     /// Event time resolution
+  float mLength = 0.f;        /// Track length
+  float mExpMom = 0.f;        /// TOF expected momentum corrected for the charge shift
+  float mTimeShift = 0.f;     /// Time shift for post calibration
+};
+
 /// \brief Class to convert the trackTime to the tofSignal used for PID
 template <typename TrackType>
 class TOFSignal
@@ -74,6 +74,9 @@ class Response
   /// Gets the expected resolution of the track
   template <typename CollisionType, typename TrackType>
   float GetExpectedSigma(const CollisionType& collision, const TrackType& trk, const o2::track::PID::ID id) const;
+  /// Gets the expected resolution of the track, given its expected signal as from GetExpectedSignal
+  template <typename CollisionType, typename TrackType>
+  float GetExpectedSigma(const CollisionType& collision, const TrackType& trk, const o2::track::PID::ID id, const float expSignal) const;
   /// Gets the number of sigmas with respect the expected value
   template <typename CollisionType, typename TrackType>
   float GetNumberOfSigma(const CollisionType& collision, const TrackType& trk, const o2::track::PID::ID id) const;
@@ -116,13 +119,23 @@ inline float Response::GetExpectedSignal(const TrackType& track, const o2::track
 /// Gets the expected resolution of the measurement
 template <typename CollisionType, typename TrackType>
 inline float Response::GetExpectedSigma(const CollisionType& collision, const TrackType& track, const o2::track::PID::ID id) const
+{
+  if (!track.hasTPC()) {
+    return -999.f;
+  }
+  return GetExpectedSigma(collision, track, id, mUseDefaultResolutionParam ? GetExpectedSignal(track, id) : 0.f);
+}
+
+/// Gets the expected resolution of the measurement, the expected signal is only used by the default parametrisation
+template <typename CollisionType, typename TrackType>
+inline float Response::GetExpectedSigma(const CollisionType& collision, const TrackType& track, const o2::track::PID::ID id, const float expSignal) const
 {
   if (!track.hasTPC()) {
     return -999.f;
   }
   float resolution = 0.;
   if (mUseDefaultResolutionParam) {
-    const float reso = GetExpectedSignal(track, id) * mResolutionParamsDefault[0] * (static_cast<float>(track.tpcNClsFound()) > 0 ? std::sqrt(1. + mResolutionParamsDefault[1] / static_cast<float>(track.tpcNClsFound())) : 1.f);
+    const float reso = expSignal * mResolutionParamsDefault[0] * (static_cast<float>(track.tpcNClsFound()) > 0 ? std::sqrt(1. + mResolutionParamsDefault[1] / static_cast<float>(track.tpcNClsFound())) : 1.f);
     reso >= 0.f ? resolution = reso : resolution = -999.f;
   } else {
 
@@ -133,7 +146,7 @@ inline float Response::GetExpectedSigma(const CollisionType& collision, const Tr
     const double dEdx = o2::tpc::BetheBlochAleph(static_cast<float>(bg), mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]) * std::pow(static_cast<float>(o2::track::pid_constants::sCharges[id]), mChargeFactor);
     const double relReso = GetRelativeResolutiondEdx(p, mass, o2::track::pid_constants::sCharges[id], mResolutionParams[3]);
 
-    const std::vector<double> values{1.f / dEdx, track.tgl(), std::sqrt(ncl), relReso, track.signed1Pt(), collision.multTPC() / mMultNormalization};
+    const std::array<double, 6> values{1.f / dEdx, track.tgl(), std::sqrt(ncl), relReso, track.signed1Pt(), collision.multTPC() / mMultNormalization};
 
     const float reso = sqrt(pow(mResolutionParams[0], 2) * values[0] + pow(mResolutionParams[1], 2) * (values[2] * mResolutionParams[5]) * pow(values[0] / sqrt(1 + pow(values[1], 2)), mResolutionParams[2]) + values[2] * pow(values[3], 2) + pow(mResolutionParams[4] * values[4], 2) + pow(values[5] * mResolutionParams[6], 2) + pow(values[5] * (values[0] / sqrt(1 + pow(values[1], 2))) * mResolutionParams[7], 2)) * dEdx * mMIP;
     reso >= 0.f ? resolution = reso : resolution = -999.f;
@@ -145,44 +158,44 @@ inline float Response::GetExpectedSigma(const CollisionType& collision, const Tr
 template <typename CollisionType, typename TrackType>
 inline float Response::GetNumberOfSigma(const CollisionType& collision, const TrackType& trk, const o2::track::PID::ID id) const
 {
-  if (GetExpectedSigma(collision, trk, id) < 0.) {
-    return -999.f;
-  }
-  if (GetExpectedSignal(trk, id) < 0.) {
+  if (!trk.hasTPC()) {
     return -999.f;
   }
-  if (!trk.hasTPC()) {
+  // the expected signal and resolution are evaluated once
+  const float expSignal = GetExpectedSignal(trk, id);
+  const float expSigma = GetExpectedSigma(collision, trk, id, expSignal);
+  if (expSigma < 0. || expSignal < 0.) {
     return -999.f;
   }
-  return ((trk.tpcSignal() - GetExpectedSignal(trk, id)) / GetExpectedSigma(collision, trk, id));
+  return ((trk.tpcSignal() - expSignal) / expSigma);
 }
 
 template <typename CollisionType, typename TrackType>
 inline float Response::GetNumberOfSigmaMCTuned(const CollisionType& collision, const TrackType& trk, const o2::track::PID::ID id, float mcTunedTPCSignal) const
 {
-  if (GetExpectedSigma(collision, trk, id) < 0.) {
-    return -999.f;
-  }
-  if (GetExpectedSignal(trk, id) < 0.) {
+  if (!trk.hasTPC()) {
     return -999.f;
   }
-  if (!trk.hasTPC()) {
+  const float expSignal = GetExpectedSignal(trk, id);
+  const float expSigma = GetExpectedSigma(collision, trk, id, expSignal);
+  if (expSigma < 0. || expSignal < 0.) {
     return -999.f;
   }
-  return ((mcTunedTPCSignal - GetExpectedSignal(trk, id)) / GetExpectedSigma(collision, trk, id));
+  return ((mcTunedTPCSignal - expSignal) / expSigma);
 }
 
 /// Gets the deviation between the actual signal and the expected signal
 template <typename TrackType>
 inline float Response::GetSignalDelta(const TrackType& trk, const o2::track::PID::ID id) const
 {
-  if (GetExpectedSignal(trk, id) < 0.) {
+  if (!trk.hasTPC()) {
     return -999.f;
   }
-  if (!trk.hasTPC()) {
+  const float expSignal = GetExpectedSignal(trk, id);
+  if (expSignal < 0.) {
     return -999.f;
   }
-  return (trk.tpcSignal() - GetExpectedSignal(trk, id));
+  return (trk.tpcSignal() - expSignal);
 }
 
 //// Gets relative dEdx resolution contribution due relative pt resolution
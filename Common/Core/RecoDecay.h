@@ -42,6 +42,96 @@ struct RecoDecay {
 
   static constexpr int8_t PdgStatusCodeAfterFlavourOscillation = 92; // decay products after B0(s) flavour oscillation
 
+  /// MC ancestry of a table of MC particles, to be filled once per dataframe and used by the MC matching overloads below.
+  /// Stores, per particle: PDG code, generator status code, production process, mother and daughter index ranges,
+  /// and the flattened list of ancestors (with their level in the mother tree) up to a maximum depth.
+  struct McAncestry {
+    /// Fills the ancestry from the table of MC particles.
+    /// \param particlesMC  table with MC particles
+    /// \param depthMax  number of mother tree levels stored in the flattened ancestor lists
+    template <typename T>
+    void fill(const T& particlesMC, int8_t depthMax = 5)
+    {
+      offset = particlesMC.offset();
+      maxDepth = depthMax;
+      const auto nParticles = particlesMC.size();
+      pdg.resize(nParticles);
+      statusCode.resize(nParticles);
+      process.resize(nParticles);
+      motherFirst.resize(nParticles);
+      motherLast.resize(nParticles);
+      daughterFirst.resize(nParticles);
+      daughterLast.resize(nParticles);
+      for (const auto& particle : particlesMC) {
+        const auto iRow = particle.globalIndex() - offset;
+        pdg[iRow] = particle.pdgCode();
+        statusCode[iRow] = particle.getGenStatusCode();
+        process[iRow] = particle.getProcess();
+        motherFirst[iRow] = particle.has_mothers() ? particle.mothersIds().front() : -1;
+        motherLast[iRow] = particle.has_mothers() ? particle.mothersIds().back() : -2;
+        daughterFirst[iRow] = particle.has_daughters() ? particle.daughtersIds().front() : -1;
+        daughterLast[iRow] = particle.has_daughters() ? particle.daughtersIds().back() : -2;
+      }
+
+      // flattened ancestor lists, built stage by stage as in getMother
+      ancestorsOffsets.assign(nParticles + 1, 0);
+      ancestors.clear();
+      ancestorsChild.clear();
+      ancestorsLevel.clear();
+      isComplete.assign(nParticles, false);
+      std::vector<int64_t> idsStage{}, idsNextStage{};
+      for (int64_t iRow = 0; iRow < static_cast<int64_t>(nParticles); ++iRow) {
+        idsStage.assign(1, iRow + offset);
+        for (int level = 1; level <= maxDepth; ++level) {
+          idsNextStage.clear();
+          for (const auto iPart : idsStage) {
+            if (!hasMothers(iPart)) {
+              continue;
+            }
+            for (auto iMother = motherFirst[iPart - offset]; iMother <= motherLast[iPart - offset]; ++iMother) {
+              if (!isInTable(iMother)) {
+                continue;
+              }
+              // all the mothers are stored, only the ones not yet found at this level are followed further
+              ancestors.push_back(iMother);
+              ancestorsChild.push_back(iPart);
+              ancestorsLevel.push_back(level);
+              if (std::find(idsNextStage.begin(), idsNextStage.end(), iMother) == idsNextStage.end()) {
+                idsNextStage.push_back(iMother);
+              }
+            }
+          }
+          if (idsNextStage.empty()) {
+            isComplete[iRow] = true;
+            break;
+          }
+          std::swap(idsStage, idsNextStage);
+        }
+        ancestorsOffsets[iRow + 1] = ancestors.size();
+      }
+    }
+
+    bool isInTable(int64_t index) const { return index >= offset && index - offset < static_cast<int64_t>(pdg.size()); }
+    bool hasMothers(int64_t index) const { return motherFirst[index - offset] >= 0; }
+    bool hasDaughters(int64_t index) const { return daughterFirst[index - offset] >= 0; }
+    int getPdgCode(int64_t index) const { return pdg[index - offset]; }
+
+    int64_t offset{0};                           // global index of the first MC particle of the table
+    int8_t maxDepth{0};                          // number of mother tree levels stored in the ancestor lists
+    std::vector<int> pdg{};                      // PDG codes
+    std::vector<int> statusCode{};               // generator status codes
+    std::vector<int> process{};                  // production processes
+    std::vector<int64_t> motherFirst{};          // first mother index, -1 if none
+    std::vector<int64_t> motherLast{};           // last mother index
+    std::vector<int64_t> daughterFirst{};        // first daughter index, -1 if none
+    std::vector<int64_t> daughterLast{};         // last daughter index
+    std::vector<std::size_t> ancestorsOffsets{}; // position of the ancestors of each particle in the flattened lists
+    std::vector<int64_t> ancestors{};            // ancestor indices, ordered by level
+    std::vector<int64_t> ancestorsChild{};       // index of the particle at the previous level from which the ancestor was reached
+    std::vector<int8_t> ancestorsLevel{};        // level of the ancestor in the mother tree (1 for direct mothers)
+    std::vector<bool> isComplete{};              // true if all the ancestors of the particle are stored
+  };
+
   // Auxiliary functions
 
   /// Sums numbers.
@@ -509,6 +599,177 @@ struct RecoDecay {
     return maxNormDeltaIP;
   }
 
+  // Batch calculations
+  // Same quantities as above for n candidates stored as arrays of components (px[i], py[i], pz[i], ...).
+  // The loops have no branches nor function calls other than std::sqrt and std::atanh, so that they can be vectorised.
+  // As in the single-candidate functions, the calculations are done in double precision.
+
+  /// Calculates transverse momenta.
+  /// \param px,py  arrays of {x, y} momentum components
+  /// \param out  array of transverse momenta
+  /// \param n  number of candidates
+  template <typename T, typename U>
+  static void ptBatch(const T* px, const T* py, U* out, std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = std::sqrt(sq(px[i]) + sq(py[i]));
+    }
+  }
+
+  /// Calculates pseudorapidities.
+  /// \param px,py,pz  arrays of {x, y, z} momentum components
+  /// \param out  array of pseudorapidities
+  /// \param n  number of candidates
+  /// \note Candidates with very small px and py get ±VeryBig as in eta.
+  template <typename T, typename U>
+  static void etaBatch(const T* px, const T* py, const T* pz, U* out, std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      const double pMag = std::sqrt(sq(px[i]) + sq(py[i]) + sq(pz[i]));
+      const bool isLongitudinal = std::abs(px[i]) < o2::constants::math::Almost0 && std::abs(py[i]) < o2::constants::math::Almost0;
+      const double etaLong = pz[i] > 0 ? o2::constants::math::VeryBig : -o2::constants::math::VeryBig;
+      out[i] = isLongitudinal ? etaLong : std::atanh(pz[i] / (isLongitudinal ? 1. : pMag));
+    }
+  }
+
+  /// Calculates rapidities.
+  /// \param px,py,pz  arrays of {x, y, z} momentum components
+  /// \param mass  mass hypothesis
+  /// \param out  array of rapidities
+  /// \param n  number of candidates
+  template <typename T, typename U, typename V>
+  static void yBatch(const T* px, const T* py, const T* pz, V mass, U* out, std::size_t n)
+  {
+    const double mass2 = sq(mass);
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = std::atanh(pz[i] / std::sqrt(sq(px[i]) + sq(py[i]) + sq(pz[i]) + mass2));
+    }
+  }
+
+  /// Calculates invariant masses of n candidates with N prongs, for H mass hypotheses at once.
+  /// The total momentum and the prong momenta are computed once per candidate for all the hypotheses.
+  /// \param px,py,pz  arrays (one per prong) of arrays (one element per candidate) of prong momentum components
+  /// \param arrMasses  array of H mass hypotheses, each being an array of N prong masses (in the same order as the prongs)
+  /// \param out  array of H arrays of invariant masses
+  /// \param n  number of candidates
+  template <std::size_t N, std::size_t H, typename T, typename U, typename V>
+  static void mBatch(const std::array<const T*, N>& px, const std::array<const T*, N>& py, const std::array<const T*, N>& pz,
+                     const std::array<std::array<V, N>, H>& arrMasses, const std::array<U*, H>& out, std::size_t n)
+  {
+    std::array<std::array<double, N>, H> arrMasses2;
+    for (std::size_t iHyp = 0; iHyp < H; ++iHyp) {
+      for (std::size_t iProng = 0; iProng < N; ++iProng) {
+        arrMasses2[iHyp][iProng] = sq(arrMasses[iHyp][iProng]);
+      }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      double pxTot{0.}, pyTot{0.}, pzTot{0.};
+      std::array<double, N> arrP2;
+      for (std::size_t iProng = 0; iProng < N; ++iProng) {
+        pxTot += px[iProng][i];
+        pyTot += py[iProng][i];
+        pzTot += pz[iProng][i];
+        arrP2[iProng] = sq(px[iProng][i]) + sq(py[iProng][i]) + sq(pz[iProng][i]);
+      }
+      const double p2Tot = sq(pxTot) + sq(pyTot) + sq(pzTot);
+      for (std::size_t iHyp = 0; iHyp < H; ++iHyp) {
+        double energyTot{0.};
+        for (std::size_t iProng = 0; iProng < N; ++iProng) {
+          energyTot += std::sqrt(arrP2[iProng] + arrMasses2[iHyp][iProng]);
+        }
+        out[iHyp][i] = std::sqrt(energyTot * energyTot - p2Tot);
+      }
+    }
+  }
+
+  /// Calculates invariant masses of n candidates with N prongs.
+  /// \param px,py,pz  arrays (one per prong) of arrays (one element per candidate) of prong momentum components
+  /// \param arrMass  array of N prong masses (in the same order as the prongs)
+  /// \param out  array of invariant masses
+  /// \param n  number of candidates
+  template <std::size_t N, typename T, typename U, typename V>
+  static void mBatch(const std::array<const T*, N>& px, const std::array<const T*, N>& py, const std::array<const T*, N>& pz,
+                     const std::array<V, N>& arrMass, U* out, std::size_t n)
+  {
+    mBatch(px, py, pz, std::array<std::array<V, N>, 1>{arrMass}, std::array<U*, 1>{out}, n);
+  }
+
+  /// Calculates cosines of pointing angle.
+  /// \param xPV,yPV,zPV  arrays of {x, y, z} positions of the primary vertices
+  /// \param xSV,ySV,zSV  arrays of {x, y, z} positions of the secondary vertices
+  /// \param px,py,pz  arrays of {x, y, z} momentum components
+  /// \param out  array of cosines of pointing angle
+  /// \param n  number of candidates
+  template <typename T, typename U, typename V>
+  static void cpaBatch(const T* xPV, const T* yPV, const T* zPV, const T* xSV, const T* ySV, const T* zSV,
+                       const U* px, const U* py, const U* pz, V* out, std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      const double dx = static_cast<double>(xSV[i]) - xPV[i];
+      const double dy = static_cast<double>(ySV[i]) - yPV[i];
+      const double dz = static_cast<double>(zSV[i]) - zPV[i];
+      const double cos = (dx * px[i] + dy * py[i] + dz * pz[i]) / std::sqrt((sq(dx) + sq(dy) + sq(dz)) * (sq(px[i]) + sq(py[i]) + sq(pz[i])));
+      out[i] = std::min(1., std::max(-1., cos));
+    }
+  }
+
+  /// Calculates cosines of pointing angle in the {x, y} plane.
+  /// \param xPV,yPV  arrays of {x, y} positions of the primary vertices
+  /// \param xSV,ySV  arrays of {x, y} positions of the secondary vertices
+  /// \param px,py  arrays of {x, y} momentum components
+  /// \param out  array of cosines of pointing angle in {x, y}
+  /// \param n  number of candidates
+  template <typename T, typename U, typename V>
+  static void cpaXYBatch(const T* xPV, const T* yPV, const T* xSV, const T* ySV, const U* px, const U* py, V* out, std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      const double dx = static_cast<double>(xSV[i]) - xPV[i];
+      const double dy = static_cast<double>(ySV[i]) - yPV[i];
+      const double cos = (dx * px[i] + dy * py[i]) / std::sqrt((sq(dx) + sq(dy)) * (sq(px[i]) + sq(py[i])));
+      out[i] = std::min(1., std::max(-1., cos));
+    }
+  }
+
+  /// Calculates 3D distances between two sets of points (e.g. decay lengths).
+  /// \param x1,y1,z1  arrays of {x, y, z} coordinates of the first points
+  /// \param x2,y2,z2  arrays of {x, y, z} coordinates of the second points
+  /// \param out  array of distances
+  /// \param n  number of points
+  template <typename T, typename U>
+  static void distanceBatch(const T* x1, const T* y1, const T* z1, const T* x2, const T* y2, const T* z2, U* out, std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = std::sqrt(sq(static_cast<double>(x1[i]) - x2[i]) + sq(static_cast<double>(y1[i]) - y2[i]) + sq(static_cast<double>(z1[i]) - z2[i]));
+    }
+  }
+
+  /// Calculates 2D {x, y} distances between two sets of points (e.g. decay lengths in the {x, y} plane).
+  /// \param x1,y1  arrays of {x, y} coordinates of the first points
+  /// \param x2,y2  arrays of {x, y} coordinates of the second points
+  /// \param out  array of distances
+  /// \param n  number of points
+  template <typename T, typename U>
+  static void distanceXYBatch(const T* x1, const T* y1, const T* x2, const T* y2, U* out, std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = std::sqrt(sq(static_cast<double>(x1[i]) - x2[i]) + sq(static_cast<double>(y1[i]) - y2[i]));
+    }
+  }
+
+  /// Calculates proper lifetimes times c.
+  /// \param px,py,pz  arrays of {x, y, z} momentum components
+  /// \param length  array of decay lengths
+  /// \param mass  mass hypothesis
+  /// \param out  array of proper lifetimes times c
+  /// \param n  number of candidates
+  template <typename T, typename U, typename V, typename W>
+  static void ctBatch(const T* px, const T* py, const T* pz, const U* length, W mass, V* out, std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = static_cast<double>(length[i]) * static_cast<double>(mass) / std::sqrt(sq(px[i]) + sq(py[i]) + sq(pz[i]));
+    }
+  }
+
   /// Finds the mother of an MC particle by looking for the expected PDG code in the mother chain.
   /// \param particlesMC  table with MC particles
   /// \param particle  MC particle
@@ -782,6 +1043,234 @@ struct RecoDecay {
     return indexMother;
   }
 
+  /// Finds the mother of an MC particle by looking for the expected PDG code in the mother chain, using the MC ancestry.
+  /// Same as getMother with the table of MC particles. Ancestor lists stored in the ancestry are used if deep enough,
+  /// the mother tree is walked through the ancestry arrays otherwise.
+  /// \param ancestry  MC ancestry of the table with MC particles
+  /// \param indexParticle  global index of the MC particle
+  /// \param PDGMother  expected mother PDG code
+  /// \param acceptAntiParticles  switch to accept the antiparticle of the expected mother
+  /// \param sign  antiparticle indicator of the found mother w.r.t. PDGMother; 1 if particle, -1 if antiparticle, 0 if mother not found
+  /// \param depthMax  maximum decay tree level to check; Mothers up to this level will be considered. If -1, all levels are considered.
+  /// \return index of the mother particle if found, -1 otherwise
+  template <bool acceptFlavourOscillation = false>
+  static int getMother(const McAncestry& ancestry,
+                       int64_t indexParticle,
+                       int PDGMother,
+                       bool acceptAntiParticles = false,
+                       int8_t* sign = nullptr,
+                       int8_t depthMax = -1)
+  {
+    int8_t sgn = 0;       // 1 if the expected mother is particle, -1 if antiparticle (w.r.t. PDGMother)
+    int indexMother = -1; // index of the final matched mother, if found
+    if (sign) {
+      *sign = sgn;
+    }
+    if (!ancestry.isInTable(indexParticle)) {
+      return indexMother;
+    }
+    const auto iRow = indexParticle - ancestry.offset;
+    // As in getMother, within the first level with a match, the match of the last particle of the previous level wins.
+    auto checkMother = [&](int64_t iMother, int64_t iChild, int64_t& lastChild) {
+      if (iChild == lastChild) { // only the first match per particle of the previous level
+        return;
+      }
+      const auto PDGParticleIMother = ancestry.getPdgCode(iMother);
+      if (PDGParticleIMother == PDGMother) {
+        sgn = 1;
+      } else if (acceptAntiParticles && PDGParticleIMother == -PDGMother) {
+        sgn = -1;
+      } else {
+        return;
+      }
+      indexMother = iMother;
+      lastChild = iChild;
+    };
+    if (ancestry.isComplete[iRow] || (depthMax >= 0 && depthMax <= ancestry.maxDepth)) {
+      int64_t lastChild = -1;
+      int8_t levelFound = -1;
+      for (auto iAnc = ancestry.ancestorsOffsets[iRow]; iAnc < ancestry.ancestorsOffsets[iRow + 1]; ++iAnc) {
+        const auto level = ancestry.ancestorsLevel[iAnc];
+        if ((depthMax >= 0 && level > depthMax) || (levelFound >= 0 && level > levelFound)) {
+          break;
+        }
+        checkMother(ancestry.ancestors[iAnc], ancestry.ancestorsChild[iAnc], lastChild);
+        if (indexMother >= 0) {
+          levelFound = level;
+        }
+      }
+    } else {
+      // the stored ancestors are not enough, walk the mother tree stage by stage
+      std::vector<int64_t> idsStage{indexParticle}, idsNextStage{};
+      for (int level = 1; indexMother < 0 && !idsStage.empty() && (depthMax < 0 || level <= depthMax); ++level) {
+        idsNextStage.clear();
+        int64_t lastChild = -1;
+        for (const auto iPart : idsStage) {
+          if (!ancestry.hasMothers(iPart)) {
+            continue;
+          }
+          for (auto iMother = ancestry.motherFirst[iPart - ancestry.offset]; iMother <= ancestry.motherLast[iPart - ancestry.offset] && lastChild != iPart; ++iMother) {
+            if (!ancestry.isInTable(iMother) || std::find(idsNextStage.begin(), idsNextStage.end(), iMother) != idsNextStage.end()) {
+              continue;
+            }
+            checkMother(iMother, iPart, lastChild);
+            if (lastChild != iPart) {
+              idsNextStage.push_back(iMother);
+            }
+          }
+        }
+        std::swap(idsStage, idsNextStage);
+      }
+    }
+    if constexpr (acceptFlavourOscillation) {
+      if (std::abs(ancestry.statusCode[iRow]) == PdgStatusCodeAfterFlavourOscillation) { // take possible flavour oscillation of B0(s) mother into account
+        sgn *= -1;                                                                       // select the sign of the mother after oscillation (and not before)
+      }
+    }
+    if (sign) {
+      *sign = sgn;
+    }
+    return indexMother;
+  }
+
+  /// Gets the complete list of indices of final-state daughters of an MC particle, using the MC ancestry.
+  /// Same as getDaughters with the MC particle.
+  /// \param ancestry  MC ancestry of the table with MC particles
+  /// \param indexParticle  global index of the MC particle
+  /// \param list  vector where the indices of final-state daughters will be added
+  /// \param arrPDGFinal  array of PDG codes of particles to be considered final if found
+  /// \param depthMax  maximum decay tree level; Daughters at this level (or beyond) will be considered final. If -1, all levels are considered.
+  /// \param stage  decay tree level; If different from 0, the particle itself will be added in the list in case it has no daughters.
+  template <bool checkProcess = false, std::size_t N>
+  static void getDaughters(const McAncestry& ancestry,
+                           int64_t indexParticle,
+                           std::vector<int>* list,
+                           const std::array<int, N>& arrPDGFinal,
+                           int8_t depthMax = -1,
+                           int8_t stage = 0)
+  {
+    if (!list || !ancestry.isInTable(indexParticle)) {
+      return;
+    }
+    const auto iRow = indexParticle - ancestry.offset;
+    if constexpr (checkProcess) {
+      if (stage != 0 && ancestry.process[iRow] != TMCProcess::kPDecay && ancestry.process[iRow] != TMCProcess::kPPrimary) { // decay products of HF hadrons are labeled as kPPrimary
+        return;
+      }
+    }
+    bool isFinal = (depthMax > -1 && stage >= depthMax); // Maximum depth has been reached (or exceeded).
+    if (!isFinal && !ancestry.hasDaughters(indexParticle)) {
+      if (stage == 0) {
+        return;
+      }
+      isFinal = true;
+    }
+    if (!isFinal && stage > 0) {
+      const auto PDGParticle = std::abs(ancestry.pdg[iRow]);
+      for (auto PDGi : arrPDGFinal) {
+        if (PDGParticle == std::abs(PDGi)) { // Accept antiparticles.
+          isFinal = true;
+          break;
+        }
+      }
+    }
+    if (isFinal) {
+      list->push_back(indexParticle);
+      return;
+    }
+    stage++;
+    for (auto iDau = ancestry.daughterFirst[iRow]; iDau <= ancestry.daughterLast[iRow]; ++iDau) {
+      getDaughters<checkProcess>(ancestry, iDau, list, arrPDGFinal, depthMax, stage);
+    }
+  }
+
+  /// Checks whether the reconstructed decay candidate is the expected decay, using the MC ancestry.
+  /// Same as getMatchedMCRec with the table of MC particles.
+  /// \param ancestry  MC ancestry of the table with MC particles
+  /// \param arrDaughters  array of candidate daughters
+  /// \param PDGMother  expected mother PDG code
+  /// \param arrPDGDaughters  array of expected daughter PDG codes
+  /// \param acceptAntiParticles  switch to accept the antiparticle version of the expected decay
+  /// \param sign  antiparticle indicator of the found mother w.r.t. PDGMother; 1 if particle, -1 if antiparticle, 0 if mother not found
+  /// \param depthMax  maximum decay tree level to check; Daughters up to this level will be considered. If -1, all levels are considered.
+  /// \return index of the mother particle if the mother and daughters are correct, -1 otherwise
+  template <bool acceptFlavourOscillation = false, bool checkProcess = false, std::size_t N, typename U>
+  static int getMatchedMCRec(const McAncestry& ancestry,
+                             const std::array<U, N>& arrDaughters,
+                             int PDGMother,
+                             std::array<int, N> arrPDGDaughters,
+                             bool acceptAntiParticles = false,
+                             int8_t* sign = nullptr,
+                             int depthMax = 1)
+  {
+    int8_t coefFlavourOscillation = 1;        // 1 if no B0(s) flavour oscillation occured, -1 else
+    int8_t sgn = 0;                           // 1 if the expected mother is particle, -1 if antiparticle (w.r.t. PDGMother)
+    int indexMother = -1;                     // index of the mother particle
+    std::vector<int> arrAllDaughtersIndex;    // vector of indices of all daughters of the mother of the first provided daughter
+    std::array<int64_t, N> arrDaughtersIndex; // array of indices of provided daughters
+    if (sign) {
+      *sign = sgn;
+    }
+    for (std::size_t iProng = 0; iProng < N; ++iProng) {
+      if (!arrDaughters[iProng].has_mcParticle() || !ancestry.isInTable(arrDaughters[iProng].mcParticleId())) {
+        return -1;
+      }
+      arrDaughtersIndex[iProng] = arrDaughters[iProng].mcParticleId();
+      if constexpr (acceptFlavourOscillation) {
+        if (std::abs(ancestry.statusCode[arrDaughtersIndex[iProng] - ancestry.offset]) == PdgStatusCodeAfterFlavourOscillation) { // oscillation decay product spotted
+          coefFlavourOscillation = -1;                                                                                            // select the sign of the mother after oscillation (and not before)
+        }
+      }
+    }
+    // Get the mother index and its sign from the first prong.
+    indexMother = getMother(ancestry, arrDaughtersIndex[0], PDGMother, acceptAntiParticles, &sgn, depthMax);
+    if (indexMother <= -1 || !ancestry.hasDaughters(indexMother)) {
+      return -1;
+    }
+    // Check that the number of direct daughters is not larger than the number of expected final daughters.
+    if constexpr (!checkProcess) {
+      if (ancestry.daughterLast[indexMother - ancestry.offset] - ancestry.daughterFirst[indexMother - ancestry.offset] + 1 > static_cast<int>(N)) {
+        return -1;
+      }
+    }
+    // Get the list of actual final daughters and check that their number is the number of provided prongs.
+    getDaughters<checkProcess>(ancestry, indexMother, &arrAllDaughtersIndex, arrPDGDaughters, depthMax);
+    if (arrAllDaughtersIndex.size() != N) {
+      return -1;
+    }
+    for (std::size_t iProng = 0; iProng < N; ++iProng) {
+      // Check that the daughter is in the list of final daughters (rejects stepdaughters and twin daughters).
+      bool isDaughterFound = false;
+      for (std::size_t iD = 0; iD < arrAllDaughtersIndex.size(); ++iD) {
+        if (arrDaughtersIndex[iProng] == arrAllDaughtersIndex[iD]) {
+          arrAllDaughtersIndex[iD] = -1;
+          isDaughterFound = true;
+          break;
+        }
+      }
+      if (!isDaughterFound) {
+        return -1;
+      }
+      // Check daughter's PDG code.
+      const auto PDGParticleI = ancestry.getPdgCode(arrDaughtersIndex[iProng]);
+      bool isPDGFound = false;
+      for (std::size_t iProngCp = 0; iProngCp < N; ++iProngCp) {
+        if (PDGParticleI == coefFlavourOscillation * sgn * arrPDGDaughters[iProngCp]) {
+          arrPDGDaughters[iProngCp] = 0;
+          isPDGFound = true;
+          break;
+        }
+      }
+      if (!isPDGFound) {
+        return -1;
+      }
+    }
+    if (sign) {
+      *sign = sgn;
+    }
+    return indexMother;
+  }
+
   /// Checks whether the MC particle is the expected one.
   /// \param checkProcess  switch to accept only decay daughters by checking the production process of MC particles
   /// \param particlesMC  table with MC particles
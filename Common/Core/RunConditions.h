@@ -0,0 +1,201 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RunConditions.h
+/// \brief  Run-scoped conditions (magnetic field, mean vertex, material LUT) shared by the producers
+///         The objects are loaded from CCDB once per run and the propagator is initialised on run change.
+///         The material LUT is loaded and rectified once per process and shared by all the tasks.
+///         Optionally, in jobs over a known list of runs, the objects of the next run of the list are prefetched in a
+///         background thread (see CcdbPrefetcher.h) while the current run is processed.
+///
+
+#ifndef COMMON_CORE_RUNCONDITIONS_H_
+#define COMMON_CORE_RUNCONDITIONS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CCDB/BasicCCDBManager.h"
+#include "Common/Core/CcdbPrefetcher.h"
+#include "DataFormatsCalibration/MeanVertexObject.h"
+#include "DataFormatsParameters/GRPMagField.h"
+#include "DataFormatsParameters/GRPObject.h"
+#include "DetectorsBase/MatLayerCylSet.h"
+#include "DetectorsBase/Propagator.h"
+#include "Framework/Logger.h"
+
+class RunConditions
+{
+ public:
+  using RunChangeCallback = std::function<void(const RunConditions&)>;
+
+  RunConditions() = default;
+  ~RunConditions() = default;
+
+  /// CCDB paths of the objects, an empty path disables the corresponding object
+  void setGrpMagPath(const std::string& path) { mGrpMagPath = path; }
+  void setGrpPath(const std::string& path) { mGrpPath = path; }
+  void setMeanVertexPath(const std::string& path) { mMeanVertexPath = path; }
+  void setLutPath(const std::string& path) { mLutPath = path; }
+
+  /// Use the Run 2 GRP object (o2::parameters::GRPObject) instead of the Run 3 GRPMagField
+  void setRun2(bool isRun2) { mIsRun2 = isRun2; }
+
+  /// Set the propagator magnetic field and material LUT on run change (default true)
+  void setInitPropagator(bool initPropagator) { mInitPropagator = initPropagator; }
+
+  /// Runs of the job, in processing order: at each run change, the objects of the next run of the list are prefetched
+  void setPrefetchRuns(const std::vector<int>& runs) { mPrefetchRuns = runs; }
+
+  /// Register a function called after the objects of a new run are loaded
+  void onRunChange(RunChangeCallback callback) { mCallbacks.push_back(std::move(callback)); }
+
+  /// Loads the objects of a run if the run number changed
+  /// \param runNumber run number
+  /// \param timestamp timestamp used for the CCDB queries
+  /// \return true if the run changed
+  bool update(int runNumber, uint64_t timestamp)
+  {
+    if (runNumber == mRunNumber) {
+      return false;
+    }
+    auto& ccdb = o2::ccdb::BasicCCDBManager::instance();
+    if (!mPrefetchRuns.empty() && !mPrefetcherConfigured) {
+      mPrefetcher.setURL(ccdb.getURL());
+      mPrefetcher.setCreatedNotAfter(ccdb.getCreatedNotAfter());
+      if (mIsRun2) {
+        mPrefetcher.addObject<o2::parameters::GRPObject>(mGrpPath);
+      } else {
+        mPrefetcher.addObject<o2::parameters::GRPMagField>(mGrpMagPath);
+      }
+      mPrefetcher.addObject<o2::dataformats::MeanVertexObject>(mMeanVertexPath);
+      mPrefetcherConfigured = true;
+    }
+    if (!mLutPath.empty() && mLut == nullptr) {
+      mLut = getSharedMatLut(mLutPath);
+    }
+    if (mIsRun2) {
+      if (!mGrpPath.empty()) {
+        mGrpo = getObject<o2::parameters::GRPObject>(mGrpPath, runNumber, timestamp);
+        if (mGrpo == nullptr) {
+          LOGF(fatal, "Run 2 GRP object (type o2::parameters::GRPObject) is not available in CCDB for run=%d at timestamp=%llu", runNumber, timestamp);
+        }
+        mBz = mGrpo->getNominalL3Field();
+        if (mInitPropagator) {
+          o2::base::Propagator::initFieldFromGRP(mGrpo);
+        }
+        LOGF(info, "Setting magnetic field to %d kG for run %d from its GRP CCDB object (type o2::parameters::GRPObject)", mGrpo->getNominalL3Field(), runNumber);
+      }
+    } else if (!mGrpMagPath.empty()) {
+      mGrpMag = getObject<o2::parameters::GRPMagField>(mGrpMagPath, runNumber, timestamp);
+      if (mGrpMag == nullptr) {
+        LOGF(fatal, "Run 3 GRP object (type o2::parameters::GRPMagField) is not available in CCDB for run=%d at timestamp=%llu", runNumber, timestamp);
+      }
+      if (mInitPropagator) {
+        o2::base::Propagator::initFieldFromGRP(mGrpMag);
+      }
+      LOGF(info, "Setting magnetic field to current %f A for run %d from its GRP CCDB object (type o2::parameters::GRPMagField)", mGrpMag->getL3Current(), runNumber);
+    }
+    if (mInitPropagator) {
+      mBz = o2::base::Propagator::Instance()->getNominalBz();
+      if (mLut) {
+        o2::base::Propagator::Instance()->setMatLUT(mLut);
+      }
+    }
+    if (!mMeanVertexPath.empty()) {
+      mMeanVertex = getObject<o2::dataformats::MeanVertexObject>(mMeanVertexPath, runNumber, timestamp);
+    }
+    mRunNumber = runNumber;
+    prefetchNextRun();
+    mGeneration++;
+    for (const auto& callback : mCallbacks) {
+      callback(*this);
+    }
+    return true;
+  }
+
+  /// Loads the objects of the run of a bunch crossing if the run number changed
+  template <typename TBC>
+  bool update(TBC const& bc)
+  {
+    return update(bc.runNumber(), bc.timestamp());
+  }
+
+  int getRunNumber() const { return mRunNumber; }
+  /// Counter incremented at each run change, to be compared with a cached value to detect changes cheaply
+  uint64_t getGeneration() const { return mGeneration; }
+  o2::parameters::GRPMagField* getGrpMag() const { return mGrpMag; }
+  o2::parameters::GRPObject* getGrpo() const { return mGrpo; }
+  const o2::dataformats::MeanVertexObject* getMeanVertex() const { return mMeanVertex; }
+  o2::base::MatLayerCylSet* getMatLut() const { return mLut; }
+  /// Nominal magnetic field in kG (requires the propagator initialisation for Run 3)
+  float getBz() const { return mBz; }
+
+  /// Returns the material LUT of a CCDB path, loaded and rectified once per process
+  static o2::base::MatLayerCylSet* getSharedMatLut(const std::string& path)
+  {
+    static std::map<std::string, o2::base::MatLayerCylSet*> luts;
+    auto& lut = luts[path];
+    if (lut == nullptr) {
+      LOGF(info, "Loading material LUT from %s", path.data());
+      lut = o2::base::MatLayerCylSet::rectifyPtrFromFile(o2::ccdb::BasicCCDBManager::instance().get<o2::base::MatLayerCylSet>(path));
+    }
+    return lut;
+  }
+
+ private:
+  /// Object of a run, prefetched or from the CCDB manager
+  template <typename T>
+  T* getObject(const std::string& path, int runNumber, uint64_t timestamp)
+  {
+    T* object = mPrefetchRuns.empty() ? nullptr : mPrefetcher.take<T>(path, runNumber, timestamp);
+    if (object == nullptr) {
+      object = o2::ccdb::BasicCCDBManager::instance().getForTimeStamp<T>(path, timestamp);
+    }
+    return object;
+  }
+
+  /// Starts the prefetching of the run following the current one in the list of runs
+  void prefetchNextRun()
+  {
+    auto run = std::find(mPrefetchRuns.begin(), mPrefetchRuns.end(), mRunNumber);
+    if (run != mPrefetchRuns.end() && ++run != mPrefetchRuns.end()) {
+      mPrefetcher.prefetch(*run);
+    }
+  }
+
+  std::string mGrpMagPath = "GLO/Config/GRPMagField"; ///< CCDB path of the Run 3 GRPMagField object
+  std::string mGrpPath = "GLO/GRP/GRP";               ///< CCDB path of the Run 2 GRP object
+  std::string mMeanVertexPath = "";                   ///< CCDB path of the mean vertex object
+  std::string mLutPath = "";                          ///< CCDB path of the material LUT
+  bool mIsRun2 = false;                               ///< use the Run 2 GRP object
+  bool mInitPropagator = true;                        ///< initialise the propagator on run change
+
+  int mRunNumber = -1;                                            ///< run number of the loaded objects
+  uint64_t mGeneration = 0;                                       ///< number of run changes
+  float mBz = 0.f;                                                ///< nominal magnetic field in kG
+  o2::parameters::GRPMagField* mGrpMag = nullptr;                 ///< Run 3 magnetic field object
+  o2::parameters::GRPObject* mGrpo = nullptr;                     ///< Run 2 GRP object
+  const o2::dataformats::MeanVertexObject* mMeanVertex = nullptr; ///< mean vertex
+  o2::base::MatLayerCylSet* mLut = nullptr;                       ///< shared material LUT
+  std::vector<RunChangeCallback> mCallbacks;                      ///< functions called on run change
+  std::vector<int> mPrefetchRuns;                                 ///< runs of the job, for the prefetching of the next run
+  CcdbPrefetcher mPrefetcher;                                     ///< prefetching of the objects of the next run
+  bool mPrefetcherConfigured = false;                             ///< objects registered in the prefetcher
+};
+
+#endif // COMMON_CORE_RUNCONDITIONS_H_
@@ -0,0 +1,286 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   SparseHistogram.h
+/// \brief  Buffer of the fills of a THnSparse (e.g. owned by a HistogramRegistry)
+///         The bin coordinates of an entry are packed into a 64-bit key, the contents and the sums of the squared weights
+///         are accumulated per key in an open-addressing hash map, together with the statistics of THnBase::Fill, and are
+///         added to the THnSparse by flush(), e.g. at the end of each process call, so that the coordinates of a bin are
+///         hashed by the THnSparse once per flush instead of once per entry and the output is unchanged.
+///         If the coordinates do not fit in 64 bits, the entries are filled directly in the THnSparse.
+///         Axes with labels are not supported.
+///
+///         Usage:
+///           SparseHistogram hSparse;
+///           registry.add("hSparse", "hSparse", HistType::kTHnSparseF, {axisMass, axisPt, axisCosThetaStar});
+///           hSparse.bind(registry.get<THnSparse>(HIST("hSparse")));  // in init
+///           hSparse.fill(mass, pt, cosThetaStar);                     // in process
+///           hSparse.flush();                                          // at the end of process
+///
+
+#ifndef COMMON_CORE_SPARSEHISTOGRAM_H_
+#define COMMON_CORE_SPARSEHISTOGRAM_H_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <TArrayD.h>
+#include <TAxis.h>
+#include <THnBase.h>
+#include <THnSparse.h>
+
+#include "Framework/Logger.h"
+
+class SparseHistogram
+{
+ public:
+  /// Binds the buffer to a THnSparse, its binning is copied and the buffer is reset
+  void bind(std::shared_ptr<THnSparse> hist)
+  {
+    if (!hist) {
+      LOG(fatal) << "SparseHistogram: nullptr histogram";
+    }
+    mHist = hist;
+    const int nDims = hist->GetNdimensions();
+    mAxes.assign(nDims, Axis{});
+    int nBits = 0;
+    double nBins = 1.;
+    for (int i = 0; i < nDims; i++) {
+      const TAxis* hAxis = hist->GetAxis(i);
+      Axis& axis = mAxes[i];
+      axis.nBins = hAxis->GetNbins();
+      axis.min = hAxis->GetXmin();
+      axis.max = hAxis->GetXmax();
+      if (hAxis->GetXbins()->GetSize() > 0) {
+        const double* edges = hAxis->GetXbins()->GetArray();
+        axis.edges.assign(edges, edges + axis.nBins + 1);
+      }
+      axis.shift = nBits;
+      nBits += std::bit_width(static_cast<uint64_t>(axis.nBins + 1)); // with under- and overflow, as the THnSparse
+      nBins *= axis.nBins + 2;
+    }
+    mSumwx.assign(nDims, 0.);
+    mSumwx2.assign(nDims, 0.);
+    // the key with all the bits set marks the empty slots
+    mBuffered = nBits < 64;
+    if (mBuffered) {
+      allocate(kInitialSlots);
+      LOG(info) << "SparseHistogram " << hist->GetName() << ": " << nDims << " axes, " << nBins << " bins, keys of " << nBits << " bits, "
+                << bytesPerFilledBin() << " B per filled bin in the buffer (" << expectedBytes(100000) / (1 << 20) << " MB for 1e5 filled bins)";
+    } else {
+      LOG(warning) << "SparseHistogram " << hist->GetName() << ": the bin coordinates need " << nBits << " bits, the entries are filled directly";
+    }
+    reset();
+  }
+
+  /// Adds an entry, with the values of all the axes and an optional weight
+  template <typename... T>
+  void fill(T... values)
+  {
+    const std::array<double, sizeof...(T)> args{static_cast<double>(values)...};
+    const std::size_t nDims = mAxes.size();
+    if (args.size() != nDims && args.size() != nDims + 1) {
+      LOG(fatal) << "SparseHistogram::fill: " << args.size() << " values for the " << nDims << " axes of " << mHist->GetName();
+    }
+    const double weight = args.size() == nDims + 1 ? args[nDims] : 1.;
+    if (!mBuffered) {
+      mHist->Fill(args.data(), weight);
+      return;
+    }
+    uint64_t key = 0;
+    for (std::size_t i = 0; i < nDims; i++) {
+      key |= static_cast<uint64_t>(findBin(mAxes[i], args[i])) << mAxes[i].shift;
+    }
+    const std::size_t slot = findSlot(key);
+    mContent[slot] += weight;
+    mSumw2[slot] += weight * weight;
+    mEntries++;
+    // as THnBase::Fill, the statistics include the under- and overflows
+    mSumw += weight;
+    mSumw2Total += weight * weight;
+    for (std::size_t i = 0; i < nDims; i++) {
+      mSumwx[i] += weight * args[i];
+      mSumwx2[i] += weight * args[i] * args[i];
+    }
+  }
+
+  /// Adds the buffered entries to the THnSparse and resets the buffer
+  void flush()
+  {
+    if (mEntries == 0) {
+      return;
+    }
+    const bool calculateErrors = mHist->GetCalculateErrors();
+    const double entries = mHist->GetEntries();
+    std::vector<int> coordinates(mAxes.size());
+    for (std::size_t slot = 0; slot < mKeys.size(); slot++) {
+      if (mKeys[slot] == kEmpty) {
+        continue;
+      }
+      for (std::size_t i = 0; i < mAxes.size(); i++) {
+        coordinates[i] = static_cast<int>((mKeys[slot] >> mAxes[i].shift) & mAxes[i].mask());
+      }
+      const Long64_t bin = mHist->GetBin(coordinates.data(), true);
+      // the sum of the squared weights is set explicitly, since the content setters of THnSparse do not update it
+      const double error2 = calculateErrors ? mHist->GetBinError2(bin) : 0.;
+      mHist->SetBinContent(bin, mHist->GetBinContent(bin) + mContent[slot]);
+      if (calculateErrors) {
+        mHist->SetBinError2(bin, error2 + mSumw2[slot]);
+      }
+    }
+    if (calculateErrors) {
+      // THnBase::Fill accumulates the statistics only when the errors are calculated
+      StatsAccess::add(*mHist, mSumw, mSumw2Total, mSumwx, mSumwx2);
+    }
+    mHist->SetEntries(entries + mEntries);
+    reset();
+  }
+
+  std::shared_ptr<THnSparse> histogram() const { return mHist; }
+  /// Number of entries buffered since the last flush
+  std::size_t entries() const { return mEntries; }
+  /// Number of bins filled since the last flush
+  std::size_t filledBins() const { return mFilledSlots; }
+  /// Memory of the buffer per filled bin, for the largest load factor of the hash map
+  static constexpr std::size_t bytesPerFilledBin() { return (sizeof(uint64_t) + 2 * sizeof(double)) * kMaxLoadDenominator / kMaxLoadNumerator; }
+  /// Expected memory of the buffer for a number of bins filled between two flushes
+  static std::size_t expectedBytes(std::size_t nFilledBins) { return nFilledBins * bytesPerFilledBin(); }
+
+ private:
+  static constexpr uint64_t kEmpty = ~uint64_t{0};
+  static constexpr std::size_t kInitialSlots = 1 << 10;
+  // the hash map is grown when more than 1/2 of the slots are used
+  static constexpr std::size_t kMaxLoadNumerator = 1;
+  static constexpr std::size_t kMaxLoadDenominator = 2;
+
+  struct Axis {
+    int nBins = 0;
+    double min = 0.;
+    double max = 0.;
+    std::vector<double> edges; // only for axes with variable bin width
+    int shift = 0;             // position of the bin of the axis in the key
+    uint64_t mask() const { return (uint64_t{1} << std::bit_width(static_cast<uint64_t>(nBins + 1))) - 1; }
+  };
+
+  /// Access to the statistics of THnBase, which have no setters
+  struct StatsAccess : public THnBase {
+    static void add(THnBase& hist, double sumw, double sumw2, const std::vector<double>& sumwx, const std::vector<double>& sumwx2)
+    {
+      hist.*(&StatsAccess::fTsumw) += sumw;
+      hist.*(&StatsAccess::fTsumw2) += sumw2;
+      TArrayD& histSumwx = hist.*(&StatsAccess::fTsumwx);
+      TArrayD& histSumwx2 = hist.*(&StatsAccess::fTsumwx2);
+      for (std::size_t i = 0; i < sumwx.size(); i++) {
+        histSumwx[i] += sumwx[i];
+        histSumwx2[i] += sumwx2[i];
+      }
+    }
+  };
+
+  // bin of a value as TAxis::FindBin, 0 for the underflow and nBins + 1 for the overflow
+  static int findBin(const Axis& axis, double value)
+  {
+    if (value < axis.min) {
+      return 0;
+    }
+    if (!(value < axis.max)) {
+      return axis.nBins + 1;
+    }
+    if (axis.edges.empty()) {
+      // same arithmetic as TAxis::FindBin, so that the entries close to the edges end up in the same bins
+      return 1 + static_cast<int>(axis.nBins * (value - axis.min) / (axis.max - axis.min));
+    }
+    return std::upper_bound(axis.edges.begin(), axis.edges.end(), value) - axis.edges.begin();
+  }
+
+  void allocate(std::size_t nSlots)
+  {
+    mKeys.assign(nSlots, kEmpty);
+    mContent.assign(nSlots, 0.);
+    mSumw2.assign(nSlots, 0.);
+    mSlotShift = 64 - std::bit_width(nSlots - 1);
+    mFilledSlots = 0;
+  }
+
+  // slot of a key, inserted if not present yet (linear probing)
+  std::size_t findSlot(uint64_t key)
+  {
+    if ((mFilledSlots + 1) * kMaxLoadDenominator > mKeys.size() * kMaxLoadNumerator) {
+      grow();
+    }
+    const std::size_t mask = mKeys.size() - 1;
+    std::size_t slot = (key * 0x9E3779B97F4A7C15ull) >> mSlotShift; // Fibonacci hashing
+    while (mKeys[slot] != key) {
+      if (mKeys[slot] == kEmpty) {
+        mKeys[slot] = key;
+        mFilledSlots++;
+        break;
+      }
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  void grow()
+  {
+    std::vector<uint64_t> keys;
+    std::vector<double> content, sumw2;
+    keys.swap(mKeys);
+    content.swap(mContent);
+    sumw2.swap(mSumw2);
+    allocate(2 * keys.size());
+    for (std::size_t slot = 0; slot < keys.size(); slot++) {
+      if (keys[slot] == kEmpty) {
+        continue;
+      }
+      const std::size_t newSlot = findSlot(keys[slot]);
+      mContent[newSlot] = content[slot];
+      mSumw2[newSlot] = sumw2[slot];
+    }
+  }
+
+  void reset()
+  {
+    if (mFilledSlots > 0) {
+      std::fill(mKeys.begin(), mKeys.end(), kEmpty);
+      std::fill(mContent.begin(), mContent.end(), 0.);
+      std::fill(mSumw2.begin(), mSumw2.end(), 0.);
+      mFilledSlots = 0;
+    }
+    mEntries = 0;
+    mSumw = 0.;
+    mSumw2Total = 0.;
+    std::fill(mSumwx.begin(), mSumwx.end(), 0.);
+    std::fill(mSumwx2.begin(), mSumwx2.end(), 0.);
+  }
+
+  std::shared_ptr<THnSparse> mHist;
+  std::vector<Axis> mAxes;
+  bool mBuffered = false;
+  std::vector<uint64_t> mKeys;  // packed bin coordinates per slot
+  std::vector<double> mContent; // content per slot
+  std::vector<double> mSumw2;   // sum of the squared weights per slot
+  std::size_t mFilledSlots = 0;
+  int mSlotShift = 54;
+  std::size_t mEntries = 0;
+  double mSumw = 0.;
+  double mSumw2Total = 0.;
+  std::vector<double> mSumwx;
+  std::vector<double> mSumwx2;
+};
+
+#endif // COMMON_CORE_SPARSEHISTOGRAM_H_
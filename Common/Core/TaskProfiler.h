@@ -0,0 +1,186 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TaskProfiler.h
+/// \brief  Scoped timers and counters for the stages of an analysis task (process functions, fits, ML inference, table filling)
+///         The counters are only collected when O2PHYSICS_TASK_PROFILER is defined at compile time,
+///         otherwise the scoped stages are empty and are removed by the compiler.
+///
+///         Usage:
+///           TaskProfiler profiler;
+///           const int stageFit = profiler.addStage("fit");                    // in init
+///           profiler.addSummary(registry, "profiler/hStages");                 // in init, after the stages
+///           {
+///             TaskProfiler::ScopedStage stage{profiler, stageFit, candidates.size()};
+///             ...
+///             stage.addRowsOut(nAccepted);
+///           }
+///           profiler.fillSummary();                                            // e.g. at the end of each process call
+///           profiler.publish(monitoring);                                      // optional, with Service<o2::monitoring::Monitoring>
+///
+
+#ifndef COMMON_CORE_TASKPROFILER_H_
+#define COMMON_CORE_TASKPROFILER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TH2.h>
+
+#include "Framework/HistogramRegistry.h"
+#include "Monitoring/Monitoring.h"
+
+class TaskProfiler
+{
+ public:
+#ifdef O2PHYSICS_TASK_PROFILER
+  static constexpr bool enabled = true;
+#else
+  static constexpr bool enabled = false;
+#endif
+
+  /// Quantities counted per stage
+  enum Quantity { kCalls = 0,
+                  kRowsIn,
+                  kRowsOut,
+                  kTimeNs,
+                  kBytes,
+                  kNQuantities };
+
+  struct Counters {
+    uint64_t calls = 0;
+    uint64_t rowsIn = 0;
+    uint64_t rowsOut = 0;
+    uint64_t timeNs = 0;
+    uint64_t bytes = 0; // reported by the stage, e.g. size of the buffers it allocated
+  };
+
+  /// Times a stage from its construction to its destruction, and counts one call
+  class ScopedStage
+  {
+   public:
+    ScopedStage(TaskProfiler& profiler, int stage, uint64_t rowsIn = 0)
+    {
+      if constexpr (enabled) {
+        mCounters = &profiler.mCounters[stage];
+        mCounters->calls++;
+        mCounters->rowsIn += rowsIn;
+        mStart = std::chrono::steady_clock::now();
+      }
+    }
+    ~ScopedStage()
+    {
+      if constexpr (enabled) {
+        mCounters->timeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStart).count();
+      }
+    }
+    ScopedStage(const ScopedStage&) = delete;
+    ScopedStage& operator=(const ScopedStage&) = delete;
+
+    void addRowsIn(uint64_t n)
+    {
+      if constexpr (enabled) {
+        mCounters->rowsIn += n;
+      }
+    }
+    void addRowsOut(uint64_t n)
+    {
+      if constexpr (enabled) {
+        mCounters->rowsOut += n;
+      }
+    }
+    void addBytes(uint64_t n)
+    {
+      if constexpr (enabled) {
+        mCounters->bytes += n;
+      }
+    }
+
+   private:
+    Counters* mCounters = nullptr;
+    std::chrono::steady_clock::time_point mStart;
+  };
+
+  /// Adds a stage, to be called before any ScopedStage on it (e.g. in init)
+  /// \return index of the stage
+  int addStage(const std::string& name)
+  {
+    mNames.push_back(name);
+    mCounters.emplace_back();
+    return mNames.size() - 1;
+  }
+
+  int nStages() const { return mNames.size(); }
+  const std::string& stageName(int stage) const { return mNames[stage]; }
+  const Counters& counters(int stage) const { return mCounters[stage]; }
+
+  /// Creates the summary histogram (stages vs quantities) in a registry, to be called after the last addStage
+  void addSummary(o2::framework::HistogramRegistry& registry, const char* name)
+  {
+    if constexpr (!enabled) {
+      return;
+    }
+    mSummary = registry.add<TH2>(name, "task profiler;stage;", o2::framework::HistType::kTH2D, {{nStages(), -0.5, nStages() - 0.5}, {kNQuantities, -0.5, kNQuantities - 0.5}});
+    for (int stage = 0; stage < nStages(); stage++) {
+      mSummary->GetXaxis()->SetBinLabel(stage + 1, mNames[stage].c_str());
+    }
+    const char* quantityNames[kNQuantities] = {"calls", "rows in", "rows out", "time (ns)", "bytes"};
+    for (int quantity = 0; quantity < kNQuantities; quantity++) {
+      mSummary->GetYaxis()->SetBinLabel(quantity + 1, quantityNames[quantity]);
+    }
+  }
+
+  /// Sets the content of the summary histogram to the counters accumulated so far
+  void fillSummary()
+  {
+    if constexpr (!enabled) {
+      return;
+    }
+    if (!mSummary) {
+      return;
+    }
+    for (int stage = 0; stage < nStages(); stage++) {
+      const Counters& c = mCounters[stage];
+      const uint64_t values[kNQuantities] = {c.calls, c.rowsIn, c.rowsOut, c.timeNs, c.bytes};
+      for (int quantity = 0; quantity < kNQuantities; quantity++) {
+        mSummary->SetBinContent(stage + 1, quantity + 1, values[quantity]);
+      }
+    }
+  }
+
+  /// Sends the counters accumulated so far as metrics <prefix><stage>_<quantity>
+  void publish(o2::monitoring::Monitoring& monitoring, const std::string& prefix = "profiler_")
+  {
+    if constexpr (!enabled) {
+      return;
+    }
+    for (int stage = 0; stage < nStages(); stage++) {
+      const Counters& c = mCounters[stage];
+      const std::string name = prefix + mNames[stage];
+      monitoring.send(o2::monitoring::Metric{c.calls, name + "_calls"});
+      monitoring.send(o2::monitoring::Metric{c.rowsIn, name + "_rows_in"});
+      monitoring.send(o2::monitoring::Metric{c.rowsOut, name + "_rows_out"});
+      monitoring.send(o2::monitoring::Metric{c.timeNs, name + "_time_ns"});
+      monitoring.send(o2::monitoring::Metric{c.bytes, name + "_bytes"});
+    }
+  }
+
+ private:
+  std::vector<std::string> mNames;
+  std::vector<Counters> mCounters;
+  std::shared_ptr<TH2> mSummary;
+};
+
+#endif // COMMON_CORE_TASKPROFILER_H_
@@ -0,0 +1,99 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TimeOrderedPrefixSum.h
+/// \brief  Time-sorted prefix sums of per-BC quantities (track counts, amplitudes, ...)
+///         The sum of the entries within a time window is obtained with two binary searches
+///         instead of a loop over all the entries.
+///
+
+#ifndef COMMON_CORE_TIMEORDEREDPREFIXSUM_H_
+#define COMMON_CORE_TIMEORDEREDPREFIXSUM_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class TimeOrderedPrefixSum
+{
+ public:
+  TimeOrderedPrefixSum() = default;
+  ~TimeOrderedPrefixSum() = default;
+
+  /// Removes all the entries, the allocated memory is kept for the next time frame
+  void clear()
+  {
+    mEntries.clear();
+    mTimes.clear();
+    mPrefixSums.clear();
+  }
+
+  void reserve(size_t n)
+  {
+    mEntries.reserve(n);
+    mTimes.reserve(n);
+    mPrefixSums.reserve(n + 1);
+  }
+
+  /// Adds an entry, entries can be added in any order
+  /// \param time time of the entry (e.g. global BC)
+  /// \param value value of the entry
+  void add(int64_t time, T value) { mEntries.emplace_back(time, value); }
+
+  /// Sorts the entries by time and computes the prefix sums, to be called after the last add() and before the queries
+  void build()
+  {
+    std::stable_sort(mEntries.begin(), mEntries.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    mTimes.resize(mEntries.size());
+    mPrefixSums.resize(mEntries.size() + 1);
+    mPrefixSums[0] = T{0};
+    for (size_t i = 0; i < mEntries.size(); i++) {
+      mTimes[i] = mEntries[i].first;
+      mPrefixSums[i + 1] = mPrefixSums[i] + mEntries[i].second;
+    }
+  }
+
+  /// Sum of the values of the entries with tMin <= time <= tMax
+  T sum(int64_t tMin, int64_t tMax) const
+  {
+    const auto range = findRange(tMin, tMax);
+    return mPrefixSums[range.second] - mPrefixSums[range.first];
+  }
+
+  /// Number of entries with tMin <= time <= tMax
+  size_t count(int64_t tMin, int64_t tMax) const
+  {
+    const auto range = findRange(tMin, tMax);
+    return range.second - range.first;
+  }
+
+  size_t size() const { return mTimes.size(); }
+
+ private:
+  std::pair<size_t, size_t> findRange(int64_t tMin, int64_t tMax) const
+  {
+    if (tMax < tMin) {
+      return {0, 0};
+    }
+    const size_t first = std::lower_bound(mTimes.begin(), mTimes.end(), tMin) - mTimes.begin();
+    const size_t last = std::upper_bound(mTimes.begin() + first, mTimes.end(), tMax) - mTimes.begin();
+    return {first, last};
+  }
+
+  std::vector<std::pair<int64_t, T>> mEntries; ///< entries as added
+  std::vector<int64_t> mTimes;                 ///< sorted times of the entries
+  std::vector<T> mPrefixSums;                  ///< sum of the values of the first i sorted entries
+};
+
+#endif // COMMON_CORE_TIMEORDEREDPREFIXSUM_H_
@@ -0,0 +1,88 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TrackParCovCache.h
+/// \brief  Cache of the track parametrisations with covariance of the tracks of a dataframe
+///         The TrackParCov of a track is built by getTrackParCov at the first request and is returned by reference
+///         afterwards, so that the tracks used in many combinations are only unpacked once per dataframe.
+///         The entries are indexed by the global index of the tracks and are invalidated by reset(), which takes the size
+///         of the track table.
+///
+///         Usage:
+///           TrackParCovCache trackParCovCache;                     // task member
+///           trackParCovCache.reset(tracks.size());                 // at the beginning of process
+///           auto trackParCov = trackParCovCache.get(track);        // copy, e.g. to be propagated
+///           const auto& trackParCov = trackParCovCache.get(track); // reference, valid until the next reset
+///
+
+#ifndef COMMON_CORE_TRACKPARCOVCACHE_H_
+#define COMMON_CORE_TRACKPARCOVCACHE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Framework/Logger.h"
+#include "ReconstructionDataFormats/Track.h"
+#include "Common/Core/trackUtilities.h"
+
+template <typename TrackPrecision = float>
+class TrackParCovCacheT
+{
+ public:
+  using TrackParCov = o2::track::TrackParametrizationWithError<TrackPrecision>;
+
+  /// Invalidates the cached entries and prepares the cache for nTracks tracks
+  void reset(std::size_t nTracks)
+  {
+    // the entries are invalidated by changing the generation, so that they do not need to be cleared
+    if (++mGeneration == 0) {
+      std::fill(mGenerations.begin(), mGenerations.end(), 0);
+      mGeneration = 1;
+    }
+    if (mTrackParCovs.size() < nTracks) {
+      mTrackParCovs.resize(nTracks);
+      mGenerations.resize(nTracks, 0);
+    }
+    mNBuilt = 0;
+  }
+
+  /// Returns the TrackParCov of a track, built at the first request since the last reset
+  template <typename T>
+  const TrackParCov& get(const T& track)
+  {
+    const std::size_t index = track.globalIndex();
+    if (index >= mTrackParCovs.size()) {
+      LOG(fatal) << "TrackParCovCache: track " << index << " beyond the " << mTrackParCovs.size() << " tracks of the reset";
+    }
+    if (mGenerations[index] != mGeneration) {
+      mTrackParCovs[index] = getTrackParCov<TrackPrecision>(track);
+      mGenerations[index] = mGeneration;
+      mNBuilt++;
+    }
+    return mTrackParCovs[index];
+  }
+
+  /// Number of TrackParCov built since the last reset
+  std::size_t nBuilt() const { return mNBuilt; }
+
+ private:
+  std::vector<TrackParCov> mTrackParCovs;
+  std::vector<uint32_t> mGenerations; // generation of the cached entry of each track
+  uint32_t mGeneration = 0;
+  std::size_t mNBuilt = 0;
+};
+
+using TrackParCovCache = TrackParCovCacheT<float>;
+
+#endif // COMMON_CORE_TRACKPARCOVCACHE_H_
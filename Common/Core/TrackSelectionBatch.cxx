@@ -0,0 +1,127 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+//
+// Evaluation of several track selections over a table of tracks
+//
+
+#include <cmath>
+#include "Common/Core/TrackSelectionBatch.h"
+
+int TrackSelectionBatch::AddSelection(TrackSelection const& selection)
+{
+  CompiledSelection sel;
+  sel.trackType = selection.mTrackType;
+  sel.minPt = selection.mMinPt;
+  sel.maxPt = selection.mMaxPt;
+  sel.minEta = selection.mMinEta;
+  sel.maxEta = selection.mMaxEta;
+  sel.minNClustersTPC = selection.mMinNClustersTPC;
+  sel.minNCrossedRowsTPC = selection.mMinNCrossedRowsTPC;
+  sel.minNCrossedRowsOverFindableClustersTPC = selection.mMinNCrossedRowsOverFindableClustersTPC;
+  sel.maxChi2PerClusterTPC = selection.mMaxChi2PerClusterTPC;
+  sel.minNClustersITS = selection.mMinNClustersITS;
+  sel.maxChi2PerClusterITS = selection.mMaxChi2PerClusterITS;
+  sel.requireTPCRefit = selection.mRequireTPCRefit;
+  sel.requireITSRefit = selection.mRequireITSRefit;
+  sel.requireGoldenChi2 = selection.mRequireGoldenChi2;
+  sel.maxDcaXY = selection.mMaxDcaXY;
+  sel.maxDcaZ = selection.mMaxDcaZ;
+  sel.maxDcaXYPtDep = selection.mMaxDcaXYPtDep;
+  for (const auto& itsRequirement : selection.mRequiredITSHits) {
+    uint8_t layers = 0;
+    for (const auto& layer : itsRequirement.second) {
+      layers |= (1 << layer);
+    }
+    sel.requiredITSHits.emplace_back(itsRequirement.first, layers);
+  }
+  mSelections.push_back(sel);
+  return mSelections.size() - 1;
+}
+
+void TrackSelectionBatch::Reset(int64_t nTracks)
+{
+  mPt.resize(nTracks);
+  mEta.resize(nTracks);
+  mTrackType.resize(nTracks);
+  mTPCNCls.resize(nTracks);
+  mTPCCrossedRows.resize(nTracks);
+  mTPCCrossedRowsOverFindableCls.resize(nTracks);
+  mTPCChi2NCl.resize(nTracks);
+  mITSNCls.resize(nTracks);
+  mITSChi2NCl.resize(nTracks);
+  mITSClusterMap.resize(nTracks);
+  mIsRun2.resize(nTracks);
+  mHasTPC.resize(nTracks);
+  mHasITS.resize(nTracks);
+  mFlags.resize(nTracks);
+  mDcaXY.resize(nTracks);
+  mDcaZ.resize(nTracks);
+}
+
+void TrackSelectionBatch::EvaluateSelections()
+{
+  mMasks.resize(mSelections.size());
+  for (std::size_t iSel = 0; iSel < mSelections.size(); iSel++) {
+    EvaluateSelection(mSelections[iSel], mMasks[iSel]);
+  }
+}
+
+void TrackSelectionBatch::EvaluateSelection(CompiledSelection const& sel, std::vector<uint16_t>& masks)
+{
+  using Cuts = TrackSelection::TrackCuts;
+  const std::size_t nTracks = mPt.size();
+  masks.resize(nTracks);
+
+  // pT-dependent DCAxy limit, the only cut which cannot be written as a comparison with a constant
+  mMaxDcaXY.assign(nTracks, sel.maxDcaXY);
+  if (sel.maxDcaXYPtDep) {
+    for (std::size_t i = 0; i < nTracks; i++) {
+      mMaxDcaXY[i] = sel.maxDcaXYPtDep(mPt[i]);
+    }
+  }
+
+  const uint32_t tpcRefitFlag = o2::aod::track::TPCrefit;
+  const uint32_t itsRefitFlag = o2::aod::track::ITSrefit;
+  const uint32_t goldenChi2Flag = o2::aod::track::GoldenChi2;
+  for (std::size_t i = 0; i < nTracks; i++) {
+    const bool isRun2 = mIsRun2[i];
+    const bool hasTPCRefit = isRun2 ? (mFlags[i] & tpcRefitFlag) != 0 : mHasTPC[i] != 0;
+    const bool hasITSRefit = isRun2 ? (mFlags[i] & itsRefitFlag) != 0 : mHasITS[i] != 0;
+    uint16_t mask = 0;
+    mask |= static_cast<uint16_t>(mTrackType[i] == sel.trackType) << static_cast<int>(Cuts::kTrackType);
+    mask |= static_cast<uint16_t>(mPt[i] >= sel.minPt && mPt[i] <= sel.maxPt) << static_cast<int>(Cuts::kPtRange);
+    mask |= static_cast<uint16_t>(mEta[i] >= sel.minEta && mEta[i] <= sel.maxEta) << static_cast<int>(Cuts::kEtaRange);
+    mask |= static_cast<uint16_t>(mTPCNCls[i] >= sel.minNClustersTPC) << static_cast<int>(Cuts::kTPCNCls);
+    mask |= static_cast<uint16_t>(mTPCCrossedRows[i] >= sel.minNCrossedRowsTPC) << static_cast<int>(Cuts::kTPCCrossedRows);
+    mask |= static_cast<uint16_t>(mTPCCrossedRowsOverFindableCls[i] >= sel.minNCrossedRowsOverFindableClustersTPC) << static_cast<int>(Cuts::kTPCCrossedRowsOverNCls);
+    mask |= static_cast<uint16_t>(mTPCChi2NCl[i] <= sel.maxChi2PerClusterTPC) << static_cast<int>(Cuts::kTPCChi2NDF);
+    mask |= static_cast<uint16_t>(!sel.requireTPCRefit || hasTPCRefit) << static_cast<int>(Cuts::kTPCRefit);
+    mask |= static_cast<uint16_t>(mITSNCls[i] >= sel.minNClustersITS) << static_cast<int>(Cuts::kITSNCls);
+    mask |= static_cast<uint16_t>(mITSChi2NCl[i] <= sel.maxChi2PerClusterITS) << static_cast<int>(Cuts::kITSChi2NDF);
+    mask |= static_cast<uint16_t>(!sel.requireITSRefit || hasITSRefit) << static_cast<int>(Cuts::kITSRefit);
+    mask |= static_cast<uint16_t>(!(isRun2 && sel.requireGoldenChi2) || (mFlags[i] & goldenChi2Flag) != 0) << static_cast<int>(Cuts::kGoldenChi2);
+    mask |= static_cast<uint16_t>(std::abs(mDcaXY[i]) <= mMaxDcaXY[i]) << static_cast<int>(Cuts::kDCAxy);
+    mask |= static_cast<uint16_t>(std::abs(mDcaZ[i]) <= sel.maxDcaZ) << static_cast<int>(Cuts::kDCAz);
+    masks[i] = mask;
+  }
+
+  // ITS hit requirements, as in TrackSelection::FulfillsITSHitRequirements
+  const uint16_t itsHitsBit = 1 << static_cast<int>(Cuts::kITSHits);
+  for (std::size_t i = 0; i < nTracks; i++) {
+    bool fulfills = true;
+    for (const auto& [minHits, layers] : sel.requiredITSHits) {
+      const int hits = __builtin_popcount(mITSClusterMap[i] & layers);
+      fulfills &= (minHits == -1) ? (hits == 0) : (hits >= minHits);
+    }
+    masks[i] |= fulfills ? itsHitsBit : 0;
+  }
+}
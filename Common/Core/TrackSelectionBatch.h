@@ -0,0 +1,132 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+//
+// Evaluation of several track selections over a table of tracks
+// The track columns needed by the cuts are loaded once per table, then each selection is compiled
+// into flat thresholds and evaluated over the columns with branch-free comparisons, giving the
+// same TrackCuts bitmask per track as TrackSelection::IsSelectedMask
+//
+
+#ifndef COMMON_CORE_TRACKSELECTIONBATCH_H_
+#define COMMON_CORE_TRACKSELECTIONBATCH_H_
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "Framework/DataTypes.h"
+#include "Common/Core/TrackSelection.h"
+
+class TrackSelectionBatch
+{
+ public:
+  TrackSelectionBatch() = default;
+
+  /// Add a selection, to be evaluated for all the tracks of each table
+  /// \return index of the selection
+  int AddSelection(TrackSelection const& selection);
+  int GetNSelections() const { return mSelections.size(); }
+
+  /// Load the columns of a table of tracks, evaluate all the selections and keep the masks
+  template <typename T>
+  void Evaluate(T const& tracks);
+
+  /// Alternatively, load the tracks one by one while they are produced and evaluate the selections at the end:
+  /// Reset(nTracks), SetTrack(row, ...) for each row, EvaluateSelections()
+  void Reset(int64_t nTracks);
+  /// Set the columns of a track, with the track type, the kinematics and the DCA given explicitly
+  /// (e.g. after the propagation, before they are stored in a table) and the other quantities from the TracksExtra of the track
+  template <typename T>
+  void SetTrack(int64_t row, T const& track, int trackType, float pt, float eta, float dcaXY, float dcaZ);
+  void EvaluateSelections();
+
+  /// \return TrackCuts bitmask of a track for a selection (row of the track in the evaluated table)
+  uint16_t GetMask(int selection, int64_t row) const { return mMasks[selection][row]; }
+  /// \return true if the track passes all the cuts of a selection
+  bool IsSelected(int selection, int64_t row) const { return mMasks[selection][row] == kAllCuts; }
+
+  static constexpr uint16_t kAllCuts = (1 << static_cast<int>(TrackSelection::TrackCuts::kNCuts)) - 1;
+
+ private:
+  // thresholds of a selection, as flat values
+  struct CompiledSelection {
+    int trackType;
+    float minPt, maxPt;
+    float minEta, maxEta;
+    int minNClustersTPC;
+    int minNCrossedRowsTPC;
+    float minNCrossedRowsOverFindableClustersTPC;
+    float maxChi2PerClusterTPC;
+    int minNClustersITS;
+    float maxChi2PerClusterITS;
+    bool requireTPCRefit;
+    bool requireITSRefit;
+    bool requireGoldenChi2;
+    float maxDcaXY;
+    float maxDcaZ;
+    std::function<float(float)> maxDcaXYPtDep;
+    std::vector<std::pair<int8_t, uint8_t>> requiredITSHits; // (min number of hits, mask of layers)
+  };
+
+  void EvaluateSelection(CompiledSelection const& sel, std::vector<uint16_t>& masks);
+
+  std::vector<CompiledSelection> mSelections;
+  std::vector<std::vector<uint16_t>> mMasks; // TrackCuts bitmask per selection and per track
+
+  // track columns
+  std::vector<float> mPt, mEta;
+  std::vector<int> mTrackType;
+  std::vector<int> mTPCNCls, mTPCCrossedRows;
+  std::vector<float> mTPCCrossedRowsOverFindableCls, mTPCChi2NCl;
+  std::vector<int> mITSNCls;
+  std::vector<float> mITSChi2NCl;
+  std::vector<uint8_t> mITSClusterMap;
+  std::vector<uint8_t> mIsRun2, mHasTPC, mHasITS;
+  std::vector<uint32_t> mFlags;
+  std::vector<float> mDcaXY, mDcaZ;
+  std::vector<float> mMaxDcaXY; // pT-dependent DCAxy limit of the selection being evaluated
+};
+
+template <typename T>
+void TrackSelectionBatch::Evaluate(T const& tracks)
+{
+  Reset(tracks.size());
+  int64_t row = 0;
+  for (const auto& track : tracks) {
+    SetTrack(row, track, track.trackType(), track.pt(), track.eta(), track.dcaXY(), track.dcaZ());
+    row++;
+  }
+  EvaluateSelections();
+}
+
+template <typename T>
+void TrackSelectionBatch::SetTrack(int64_t row, T const& track, int trackType, float pt, float eta, float dcaXY, float dcaZ)
+{
+  mPt[row] = pt;
+  mEta[row] = eta;
+  mTrackType[row] = trackType;
+  mTPCNCls[row] = track.tpcNClsFound();
+  mTPCCrossedRows[row] = track.tpcNClsCrossedRows();
+  mTPCCrossedRowsOverFindableCls[row] = track.tpcCrossedRowsOverFindableCls();
+  mTPCChi2NCl[row] = track.tpcChi2NCl();
+  mITSNCls[row] = track.itsNCls();
+  mITSChi2NCl[row] = track.itsChi2NCl();
+  mITSClusterMap[row] = track.itsClusterMap();
+  mIsRun2[row] = trackType == o2::aod::track::Run2Track || trackType == o2::aod::track::Run2Tracklet;
+  mHasTPC[row] = track.hasTPC();
+  mHasITS[row] = track.hasITS();
+  mFlags[row] = track.flags();
+  mDcaXY[row] = dcaXY;
+  mDcaZ[row] = dcaZ;
+}
+
+#endif // COMMON_CORE_TRACKSELECTIONBATCH_H_
@@ -19,6 +19,12 @@
 
 #include <TPDGCode.h>
 
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "Framework/Logger.h"
 #include "ReconstructionDataFormats/PID.h"
 
@@ -32,6 +38,48 @@ struct TrackSelectorPID {
     Conditional,
     Accepted
   };
+
+  /// Combines TPC and TOF selection statuses with the TPC-or-TOF logic.
+  /// \param pidTpc  TPC selection status
+  /// \param pidTof  TOF selection status
+  /// \return status of combined PID (TPC or TOF)
+  static Status combineTpcOrTof(int pidTpc, int pidTof)
+  {
+    if (pidTpc == Accepted || pidTof == Accepted) {
+      return Accepted;
+    }
+    if (pidTpc == Conditional && pidTof == Conditional) {
+      return Accepted;
+    }
+    if (pidTpc == Rejected || pidTof == Rejected) {
+      return Rejected;
+    }
+    return NotApplicable; // (NotApplicable for one detector) and (NotApplicable or Conditional for the other)
+  }
+
+  /// Combines TPC and TOF selection statuses with the TPC-and-TOF logic.
+  /// \param pidTpc  TPC selection status
+  /// \param pidTof  TOF selection status
+  /// \return status of combined PID (TPC and TOF)
+  static Status combineTpcAndTof(int pidTpc, int pidTof)
+  {
+    if (pidTpc == Accepted && pidTof == Accepted) {
+      return Accepted;
+    }
+    if (pidTpc == Accepted && (pidTof == NotApplicable || pidTof == Conditional)) {
+      return Accepted;
+    }
+    if ((pidTpc == NotApplicable || pidTpc == Conditional) && pidTof == Accepted) {
+      return Accepted;
+    }
+    if (pidTpc == Conditional && pidTof == Conditional) {
+      return Accepted;
+    }
+    if (pidTpc == Rejected || pidTof == Rejected) {
+      return Rejected;
+    }
+    return NotApplicable; // (NotApplicable for one detector) and (NotApplicable or Conditional for the other)
+  }
 };
 
 template <uint64_t pdg = kPiPlus>
@@ -111,8 +159,15 @@ class TrackSelectorPidBase
     if (mNSigmaTpcMin < -999. && mNSigmaTpcMax > 999.) {
       return true;
     }
+    return isSelectedByTpc(getNSigmaTpc(track), conditionalTof);
+  }
 
-    // Get nσ for a given particle hypothesis.
+  /// Returns TPC nσ of a track for the given particle species hypothesis.
+  /// \param track  track
+  /// \return TPC nσ
+  template <typename T>
+  double getNSigmaTpc(const T& track)
+  {
     double nSigma = 100.;
     if constexpr (pdg == kElectron) {
       nSigma = track.tpcNSigmaEl();
@@ -127,6 +182,19 @@ class TrackSelectorPidBase
     } else {
       errorPdg();
     }
+    return nSigma;
+  }
+
+  /// Checks if a TPC nσ value is within the given TPC nσ range.
+  /// \param nSigma  TPC nσ
+  /// \param conditionalTof  variable to store the result of selection with looser cuts for conditional accepting of track if combined with TOF
+  /// \return true if nσ is within the TPC nσ range
+  bool isSelectedByTpc(double nSigma, bool& conditionalTof)
+  {
+    // Accept if selection is disabled via large values.
+    if (mNSigmaTpcMin < -999. && mNSigmaTpcMax > 999.) {
+      return true;
+    }
 
     if (mNSigmaTpcMinCondTof < -999. && mNSigmaTpcMaxCondTof > 999.) {
       conditionalTof = true;
@@ -155,6 +223,25 @@ class TrackSelectorPidBase
     }
   }
 
+  /// Returns status of TPC PID selection for given track pT and TPC nσ values.
+  /// \param pt  track pT
+  /// \param nSigma  TPC nσ
+  /// \return TPC selection status (see TrackSelectorPID::Status)
+  TrackSelectorPID::Status statusTpc(float pt, double nSigma)
+  {
+    if (!(mPtTpcMin <= pt && pt <= mPtTpcMax)) {
+      return TrackSelectorPID::NotApplicable;
+    }
+    bool condTof = false;
+    if (isSelectedByTpc(nSigma, condTof)) {
+      return TrackSelectorPID::Accepted;
+    } else if (condTof) {
+      return TrackSelectorPID::Conditional; // potential to be accepted if combined with TOF
+    } else {
+      return TrackSelectorPID::Rejected;
+    }
+  }
+
   // TOF
 
   /// Set pT range where TOF PID is applicable.
@@ -199,8 +286,15 @@ class TrackSelectorPidBase
     if (mNSigmaTofMin < -999. && mNSigmaTofMax > 999.) {
       return true;
     }
+    return isSelectedByTof(getNSigmaTof(track), conditionalTpc);
+  }
 
-    // Get nσ for a given particle hypothesis.
+  /// Returns TOF nσ of a track for the given particle species hypothesis.
+  /// \param track  track
+  /// \return TOF nσ
+  template <typename T>
+  double getNSigmaTof(const T& track)
+  {
     double nSigma = 100.;
     if constexpr (pdg == kElectron) {
       nSigma = track.tofNSigmaEl();
@@ -215,6 +309,19 @@ class TrackSelectorPidBase
     } else {
       errorPdg();
     }
+    return nSigma;
+  }
+
+  /// Checks if a TOF nσ value is within the given TOF nσ range.
+  /// \param nSigma  TOF nσ
+  /// \param conditionalTpc  variable to store the result of selection with looser cuts for conditional accepting of track if combined with TPC
+  /// \return true if nσ is within the TOF nσ range
+  bool isSelectedByTof(double nSigma, bool& conditionalTpc)
+  {
+    // Accept if selection is disabled via large values.
+    if (mNSigmaTofMin < -999. && mNSigmaTofMax > 999.) {
+      return true;
+    }
 
     if (mNSigmaTofMinCondTpc < -999. && mNSigmaTofMaxCondTpc > 999.) {
       conditionalTpc = true;
@@ -243,6 +350,25 @@ class TrackSelectorPidBase
     }
   }
 
+  /// Returns status of TOF PID selection for given track pT and TOF nσ values.
+  /// \param pt  track pT
+  /// \param nSigma  TOF nσ
+  /// \return TOF selection status (see TrackSelectorPID::Status)
+  TrackSelectorPID::Status statusTof(float pt, double nSigma)
+  {
+    if (!(mPtTofMin <= pt && pt <= mPtTofMax)) {
+      return TrackSelectorPID::NotApplicable;
+    }
+    bool condTpc = false;
+    if (isSelectedByTof(nSigma, condTpc)) {
+      return TrackSelectorPID::Accepted;
+    } else if (condTpc) {
+      return TrackSelectorPID::Conditional; // potential to be accepted if combined with TPC
+    } else {
+      return TrackSelectorPID::Rejected;
+    }
+  }
+
   // RICH
 
   /// Set pT range where RICH PID is applicable.
@@ -395,17 +521,7 @@ class TrackSelectorPidBase
   {
     int pidTpc = statusTpc(track);
     int pidTof = statusTof(track);
-
-    if (pidTpc == TrackSelectorPID::Accepted || pidTof == TrackSelectorPID::Accepted) {
-      return TrackSelectorPID::Accepted;
-    }
-    if (pidTpc == TrackSelectorPID::Conditional && pidTof == TrackSelectorPID::Conditional) {
-      return TrackSelectorPID::Accepted;
-    }
-    if (pidTpc == TrackSelectorPID::Rejected || pidTof == TrackSelectorPID::Rejected) {
-      return TrackSelectorPID::Rejected;
-    }
-    return TrackSelectorPID::NotApplicable; // (NotApplicable for one detector) and (NotApplicable or Conditional for the other)
+    return TrackSelectorPID::combineTpcOrTof(pidTpc, pidTof);
   }
 
   /// Returns status of combined PID (TPC and TOF) selection for a given track when both detectors are applicable. Returns status of single PID otherwise.
@@ -422,23 +538,7 @@ class TrackSelectorPidBase
     if (track.hasTOF()) {
       pidTof = statusTof(track);
     }
-
-    if (pidTpc == TrackSelectorPID::Accepted && pidTof == TrackSelectorPID::Accepted) {
-      return TrackSelectorPID::Accepted;
-    }
-    if (pidTpc == TrackSelectorPID::Accepted && (pidTof == TrackSelectorPID::NotApplicable || pidTof == TrackSelectorPID::Conditional)) {
-      return TrackSelectorPID::Accepted;
-    }
-    if ((pidTpc == TrackSelectorPID::NotApplicable || pidTpc == TrackSelectorPID::Conditional) && pidTof == TrackSelectorPID::Accepted) {
-      return TrackSelectorPID::Accepted;
-    }
-    if (pidTpc == TrackSelectorPID::Conditional && pidTof == TrackSelectorPID::Conditional) {
-      return TrackSelectorPID::Accepted;
-    }
-    if (pidTpc == TrackSelectorPID::Rejected || pidTof == TrackSelectorPID::Rejected) {
-      return TrackSelectorPID::Rejected;
-    }
-    return TrackSelectorPID::NotApplicable; // (NotApplicable for one detector) and (NotApplicable or Conditional for the other)
+    return TrackSelectorPID::combineTpcAndTof(pidTpc, pidTof);
   }
 
   /// Checks whether a track is identified as electron and rejected as pion by TOF or RICH.
@@ -648,4 +748,167 @@ using TrackSelectorPi = TrackSelectorPidBase<kPiPlus>;    // Pi
 using TrackSelectorKa = TrackSelectorPidBase<kKPlus>;     // Ka
 using TrackSelectorPr = TrackSelectorPidBase<kProton>;    // Pr
 
+/// Class for track selection of several particle species at once
+/// The statuses of all species are returned in one word with NBitsStatus bits per species, in the order of the template arguments.
+/// Track pT and detector flags are read once per track and shared by all species.
+
+template <uint64_t... pdgs>
+class TrackSelectorPidMulti
+{
+ public:
+  using StatusWord = uint32_t;
+  static constexpr int NSpecies = sizeof...(pdgs);
+  static constexpr int NBitsStatus = 2;
+  static constexpr StatusWord MaskStatus = (1u << NBitsStatus) - 1;
+  static_assert(NSpecies > 0 && NSpecies * NBitsStatus <= 32, "Unsupported number of species");
+
+  /// Default constructor
+  TrackSelectorPidMulti() = default;
+
+  /// Default destructor
+  ~TrackSelectorPidMulti() = default;
+
+  /// Returns the index of a species in the status word.
+  template <uint64_t pdg>
+  static constexpr int indexOf()
+  {
+    constexpr std::array<uint64_t, NSpecies> arrPdg{pdgs...};
+    for (int i = 0; i < NSpecies; ++i) {
+      if (arrPdg[i] == pdg) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  /// Returns the selector of a species, e.g. to configure it.
+  template <uint64_t pdg>
+  TrackSelectorPidBase<pdg>& get()
+  {
+    static_assert(indexOf<pdg>() >= 0, "Species not handled by the selector");
+    return std::get<indexOf<pdg>()>(mSelectors);
+  }
+
+  /// Sets the same configuration for all species.
+  /// \param selector  selector to copy the configuration from
+  template <uint64_t pdgRef>
+  void setSelector(const TrackSelectorPidBase<pdgRef>& selector)
+  {
+    std::apply([&selector](auto&... sel) { ((sel = selector), ...); }, mSelectors);
+  }
+
+  /// Extracts the status of a species from a status word.
+  /// \param word  status word
+  /// \param index  index of the species (see indexOf)
+  /// \return selection status (see TrackSelectorPID::Status)
+  static TrackSelectorPID::Status getStatus(StatusWord word, int index)
+  {
+    return static_cast<TrackSelectorPID::Status>((word >> (index * NBitsStatus)) & MaskStatus);
+  }
+
+  /// Extracts the status of a species from a status word.
+  template <uint64_t pdg>
+  static TrackSelectorPID::Status getStatus(StatusWord word)
+  {
+    static_assert(indexOf<pdg>() >= 0, "Species not handled by the selector");
+    return getStatus(word, indexOf<pdg>());
+  }
+
+  /// Returns statuses of TPC PID selection for a given track.
+  template <typename T>
+  StatusWord statusTpc(const T& track)
+  {
+    const float pt = track.pt();
+    return combine([&](auto& sel) { return sel.statusTpc(pt, sel.getNSigmaTpc(track)); });
+  }
+
+  /// Returns statuses of TOF PID selection for a given track.
+  template <typename T>
+  StatusWord statusTof(const T& track)
+  {
+    const float pt = track.pt();
+    return combine([&](auto& sel) { return sel.statusTof(pt, sel.getNSigmaTof(track)); });
+  }
+
+  /// Returns statuses of combined PID (TPC or TOF) selection for a given track.
+  template <typename T>
+  StatusWord statusTpcOrTof(const T& track)
+  {
+    const float pt = track.pt();
+    return combine([&](auto& sel) {
+      return TrackSelectorPID::combineTpcOrTof(sel.statusTpc(pt, sel.getNSigmaTpc(track)), sel.statusTof(pt, sel.getNSigmaTof(track)));
+    });
+  }
+
+  /// Returns statuses of combined PID (TPC and TOF) selection for a given track (see TrackSelectorPidBase::statusTpcAndTof).
+  template <typename T>
+  StatusWord statusTpcAndTof(const T& track)
+  {
+    const float pt = track.pt();
+    const bool hasTpc = track.hasTPC();
+    const bool hasTof = track.hasTOF();
+    return combine([&](auto& sel) {
+      int pidTpc = hasTpc ? sel.statusTpc(pt, sel.getNSigmaTpc(track)) : TrackSelectorPID::NotApplicable;
+      int pidTof = hasTof ? sel.statusTof(pt, sel.getNSigmaTof(track)) : TrackSelectorPID::NotApplicable;
+      return TrackSelectorPID::combineTpcAndTof(pidTpc, pidTof);
+    });
+  }
+
+  /// Returns statuses of Bayesian PID selection for a given track, based on the most probable particle species.
+  template <typename T>
+  StatusWord statusBayes(const T& track)
+  {
+    return combine([&](auto& sel) { return sel.statusBayes(track); });
+  }
+
+  /// Returns statuses of Bayesian PID selection for a given track, based on the probability of each particle species.
+  template <typename T>
+  StatusWord statusBayesProb(const T& track)
+  {
+    return combine([&](auto& sel) { return sel.statusBayesProb(track); });
+  }
+
+  /// Returns statuses of combined PID (TPC or TOF) selection for all tracks of a table.
+  /// \param tracks  track table
+  /// \param words  status words, in the order of the tracks in the table
+  template <typename TTracks>
+  void statusTpcOrTof(const TTracks& tracks, std::vector<StatusWord>& words)
+  {
+    words.resize(tracks.size());
+    std::size_t iTrack = 0;
+    for (const auto& track : tracks) {
+      words[iTrack++] = statusTpcOrTof(track);
+    }
+  }
+
+  /// Returns statuses of combined PID (TPC and TOF) selection for all tracks of a table.
+  /// \param tracks  track table
+  /// \param words  status words, in the order of the tracks in the table
+  template <typename TTracks>
+  void statusTpcAndTof(const TTracks& tracks, std::vector<StatusWord>& words)
+  {
+    words.resize(tracks.size());
+    std::size_t iTrack = 0;
+    for (const auto& track : tracks) {
+      words[iTrack++] = statusTpcAndTof(track);
+    }
+  }
+
+ private:
+  std::tuple<TrackSelectorPidBase<pdgs>...> mSelectors; ///< selectors of the individual species
+
+  /// Packs the statuses returned by a function of the species selector into a status word.
+  template <typename F>
+  StatusWord combine(F&& getStatusSpecies)
+  {
+    return combineImpl(getStatusSpecies, std::make_index_sequence<NSpecies>{});
+  }
+
+  template <typename F, std::size_t... I>
+  StatusWord combineImpl(F& getStatusSpecies, std::index_sequence<I...>)
+  {
+    return ((static_cast<StatusWord>(getStatusSpecies(std::get<I>(mSelectors))) << (I * NBitsStatus)) | ...);
+  }
+};
+
 #endif // COMMON_CORE_TRACKSELECTORPID_H_
@@ -0,0 +1,217 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file     benchmarkCoreHelpers.cxx
+///
+/// \brief    Standalone benchmark of the Common/Core helpers (RecoDecay kinematics, TrackSelection) on synthetic samples
+///           generated with a fixed seed, the results can be written to JSON to compare tags
+///
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "Framework/DataTypes.h"
+#include "Framework/Logger.h"
+
+#include "Common/Core/MicroBenchmark.h"
+#include "Common/Core/RecoDecay.h"
+#include "Common/Core/TrackSelection.h"
+#include "Common/Core/TrackSelectionDefaults.h"
+
+namespace bpo = boost::program_options;
+using namespace o2::analysis::benchmark;
+
+namespace
+{
+/// Track with the getters used by TrackSelection::IsSelected
+struct SyntheticTrack {
+  uint8_t mTrackType;
+  float mPt;
+  float mEta;
+  int16_t mTPCNClsFound;
+  int16_t mTPCNClsCrossedRows;
+  float mTPCCrossedRowsOverFindableCls;
+  float mTPCChi2NCl;
+  uint32_t mFlags;
+  bool mHasTPC;
+  bool mHasITS;
+  uint8_t mITSNCls;
+  float mITSChi2NCl;
+  uint8_t mITSClusterMap;
+  float mDcaXY;
+  float mDcaZ;
+
+  uint8_t trackType() const { return mTrackType; }
+  float pt() const { return mPt; }
+  float eta() const { return mEta; }
+  int16_t tpcNClsFound() const { return mTPCNClsFound; }
+  int16_t tpcNClsCrossedRows() const { return mTPCNClsCrossedRows; }
+  float tpcCrossedRowsOverFindableCls() const { return mTPCCrossedRowsOverFindableCls; }
+  float tpcChi2NCl() const { return mTPCChi2NCl; }
+  uint32_t flags() const { return mFlags; }
+  bool hasTPC() const { return mHasTPC; }
+  bool hasITS() const { return mHasITS; }
+  uint8_t itsNCls() const { return mITSNCls; }
+  float itsChi2NCl() const { return mITSChi2NCl; }
+  uint8_t itsClusterMap() const { return mITSClusterMap; }
+  float dcaXY() const { return mDcaXY; }
+  float dcaZ() const { return mDcaZ; }
+};
+
+std::vector<SyntheticTrack> generateTracks(std::size_t n, std::mt19937& generator)
+{
+  std::exponential_distribution<float> ptDistribution(1.f / 0.6f);
+  std::uniform_real_distribution<float> etaDistribution(-1.2f, 1.2f);
+  std::uniform_int_distribution<int> tpcClsDistribution(40, 159);
+  std::uniform_int_distribution<int> itsMapDistribution(0, 127);
+  std::exponential_distribution<float> chi2Distribution(1.f);
+  std::normal_distribution<float> dcaDistribution(0.f, 0.05f);
+  std::bernoulli_distribution detectorDistribution(0.9);
+
+  std::vector<SyntheticTrack> tracks(n);
+  for (auto& track : tracks) {
+    track.mTrackType = o2::aod::track::TrackTypeEnum::Track;
+    track.mPt = ptDistribution(generator);
+    track.mEta = etaDistribution(generator);
+    track.mTPCNClsFound = tpcClsDistribution(generator);
+    track.mTPCNClsCrossedRows = std::max<int16_t>(track.mTPCNClsFound, tpcClsDistribution(generator));
+    track.mTPCCrossedRowsOverFindableCls = track.mTPCNClsCrossedRows / 159.f;
+    track.mTPCChi2NCl = chi2Distribution(generator);
+    track.mFlags = 0;
+    track.mHasTPC = detectorDistribution(generator);
+    track.mHasITS = detectorDistribution(generator);
+    track.mITSClusterMap = itsMapDistribution(generator);
+    track.mITSNCls = __builtin_popcount(track.mITSClusterMap);
+    track.mITSChi2NCl = chi2Distribution(generator);
+    track.mDcaXY = dcaDistribution(generator);
+    track.mDcaZ = dcaDistribution(generator);
+  }
+  return tracks;
+}
+
+/// Three-prong candidate with primary and secondary vertices
+struct SyntheticCandidate {
+  std::array<std::array<float, 3>, 3> momenta;
+  std::array<float, 3> primaryVertex;
+  std::array<float, 3> secondaryVertex;
+};
+
+std::vector<SyntheticCandidate> generateCandidates(std::size_t n, std::mt19937& generator)
+{
+  std::normal_distribution<float> momentumDistribution(0.f, 1.f);
+  std::normal_distribution<float> primaryDistribution(0.f, 0.01f);
+  std::exponential_distribution<float> decayLengthDistribution(1.f / 0.03f);
+
+  std::vector<SyntheticCandidate> candidates(n);
+  for (auto& candidate : candidates) {
+    for (auto& momentum : candidate.momenta) {
+      for (auto& component : momentum) {
+        component = momentumDistribution(generator);
+      }
+    }
+    const auto pSum = RecoDecay::pVec(candidate.momenta[0], candidate.momenta[1], candidate.momenta[2]);
+    const double length = decayLengthDistribution(generator);
+    const double p = RecoDecay::sqrtSumOfSquares(pSum[0], pSum[1], pSum[2]);
+    for (int i = 0; i < 3; i++) {
+      candidate.primaryVertex[i] = primaryDistribution(generator);
+      candidate.secondaryVertex[i] = candidate.primaryVertex[i] + length * pSum[i] / p;
+    }
+  }
+  return candidates;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  bpo::options_description options("Allowed options");
+  options.add_options()(
+    "n-items,n", bpo::value<int>()->default_value(10000), "Number of generated tracks and candidates")(
+    "n-calls,c", bpo::value<int>()->default_value(100), "Number of calls (over all the items) per repetition")(
+    "repetitions,r", bpo::value<int>()->default_value(10), "Number of timed repetitions")(
+    "seed,s", bpo::value<unsigned int>()->default_value(0), "Seed of the generated samples")(
+    "output,o", bpo::value<std::string>()->default_value(""), "JSON file for the results, not written if empty")(
+    "help,h", "Produce help message.");
+
+  bpo::variables_map arguments;
+  try {
+    bpo::store(bpo::parse_command_line(argc, argv, options), arguments);
+    if (arguments.count("help")) {
+      LOG(info) << options;
+      return 0;
+    }
+    bpo::notify(arguments);
+  } catch (const bpo::error& e) {
+    LOG(error) << e.what() << "\n";
+    LOG(error) << "Error parsing command line arguments; Available options:";
+    LOG(error) << options;
+    return 1;
+  }
+
+  const std::size_t nItems = arguments["n-items"].as<int>();
+  std::mt19937 generator(arguments["seed"].as<unsigned int>());
+  const auto candidates = generateCandidates(nItems, generator);
+  const auto tracks = generateTracks(nItems, generator);
+  const std::array<double, 3> masses{0.13957, 0.49368, 0.13957};
+
+  Suite suite(arguments["repetitions"].as<int>(), arguments["n-calls"].as<int>());
+
+  suite.run("RecoDecay::m (3 prongs)", nItems, [&]() {
+    double sum = 0.;
+    for (const auto& candidate : candidates) {
+      sum += RecoDecay::m(candidate.momenta, masses);
+    }
+    doNotOptimize(sum);
+  });
+  suite.run("RecoDecay::pt, y, eta, phi", nItems, [&]() {
+    double sum = 0.;
+    for (const auto& candidate : candidates) {
+      const auto pSum = RecoDecay::pVec(candidate.momenta[0], candidate.momenta[1], candidate.momenta[2]);
+      sum += RecoDecay::pt(pSum) + RecoDecay::y(pSum, 1.86966) + RecoDecay::eta(pSum) + RecoDecay::phi(pSum);
+    }
+    doNotOptimize(sum);
+  });
+  suite.run("RecoDecay::cpa, ct, impParXY", nItems, [&]() {
+    double sum = 0.;
+    for (const auto& candidate : candidates) {
+      const auto pSum = RecoDecay::pVec(candidate.momenta[0], candidate.momenta[1], candidate.momenta[2]);
+      const double length = RecoDecay::distance(candidate.primaryVertex, candidate.secondaryVertex);
+      sum += RecoDecay::cpa(candidate.primaryVertex, candidate.secondaryVertex, pSum) + RecoDecay::ct(pSum, length, 1.86966) + RecoDecay::impParXY(candidate.primaryVertex, candidate.secondaryVertex, candidate.momenta[0]);
+    }
+    doNotOptimize(sum);
+  });
+
+  const TrackSelection trackSelection = getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibAny);
+  suite.run("TrackSelection::IsSelected (global)", nItems, [&]() {
+    int nSelected = 0;
+    for (const auto& track : tracks) {
+      nSelected += trackSelection.IsSelected(track);
+    }
+    doNotOptimize(nSelected);
+  });
+  suite.run("TrackSelection::IsSelectedMask (global)", nItems, [&]() {
+    uint32_t mask = 0;
+    for (const auto& track : tracks) {
+      mask ^= trackSelection.IsSelectedMask(track);
+    }
+    doNotOptimize(mask);
+  });
+
+  suite.writeJson(arguments["output"].as<std::string>());
+  return 0;
+}
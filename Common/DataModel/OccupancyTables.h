@@ -0,0 +1,34 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef COMMON_DATAMODEL_OCCUPANCYTABLES_H_
+#define COMMON_DATAMODEL_OCCUPANCYTABLES_H_
+
+#include "Framework/AnalysisDataModel.h"
+
+namespace o2::aod
+{
+namespace occp
+{
+DECLARE_SOA_COLUMN(IsFullWindow, isFullWindow, bool);            //! The time window is fully contained in the time frame of the collision
+DECLARE_SOA_COLUMN(NTracksITSInWindow, nTracksITSInWindow, int); //! Number of PV contributors with at least 5 ITS clusters of the other collisions in the time window
+DECLARE_SOA_COLUMN(NTracksTPCInWindow, nTracksTPCInWindow, int); //! Number of PV contributors with TPC of the other collisions in the time window
+DECLARE_SOA_COLUMN(NCollsInWindow, nCollsInWindow, int);         //! Number of other collisions in the time window
+DECLARE_SOA_COLUMN(FT0AInWindow, ft0AInWindow, float);           //! Sum of the FT0-A amplitudes of the other BCs in the time window
+DECLARE_SOA_COLUMN(FT0CInWindow, ft0CInWindow, float);           //! Sum of the FT0-C amplitudes of the other BCs in the time window
+} // namespace occp
+
+// collision-joinable occupancy in a time window around the collision
+DECLARE_SOA_TABLE(OccsInTimeWin, "AOD", "OCCSINTIMEWIN", //!
+                  occp::IsFullWindow, occp::NTracksITSInWindow, occp::NTracksTPCInWindow, occp::NCollsInWindow, occp::FT0AInWindow, occp::FT0CInWindow);
+using OccInTimeWin = OccsInTimeWin::iterator;
+} // namespace o2::aod
+
+#endif // COMMON_DATAMODEL_OCCUPANCYTABLES_H_
@@ -19,6 +19,8 @@
 #ifndef COMMON_DATAMODEL_PIDRESPONSE_H_
 #define COMMON_DATAMODEL_PIDRESPONSE_H_
 
+#include <cmath>
+#include <cstddef>
 #include <experimental/type_traits>
 
 // O2 includes
@@ -31,26 +33,103 @@ namespace o2::aod
 {
 namespace pidutils
 {
-// Function to pack a float into a binned value in table
-template <typename binningType, typename T>
-void packInTable(const float& valueToBin, T& table)
+// Binning policies for the packed columns
+// A binning defines binned_t, nbins, overflowBin, underflowBin, binned_min and binned_max. Values are
+// binned linearly with bin_width, unless the binning defines static pack(float) and unpack(binned_t)
+// functions for a custom mapping. A derived table selects its binning by defining
+// `binning` in the namespace of its columns (see DEFINE_UNWRAP_NSIGMA_COLUMN).
+
+// Linear binning in [-maxValueX100/100, maxValueX100/100] with all the values of binnedType
+template <typename binnedType, int maxValueX100>
+struct linearBinning {
+  typedef binnedType binned_t;
+  static constexpr int nbins = (1 << 8 * sizeof(binned_t)) - 2;
+  static constexpr binned_t overflowBin = nbins >> 1;
+  static constexpr binned_t underflowBin = -(nbins >> 1);
+  static constexpr float binned_max = maxValueX100 / 100.f;
+  static constexpr float binned_min = -binned_max;
+  static constexpr float bin_width = (binned_max - binned_min) / nbins;
+};
+
+// Non-linear binning in [-maxValueX100/100, maxValueX100/100]: bins are narrow around 0 and widen
+// for |value| above softnessX100/100, where the mapping goes from linear to logarithmic
+template <typename binnedType, int maxValueX100, int softnessX100>
+struct asinhBinning {
+  typedef binnedType binned_t;
+  static constexpr int nbins = (1 << 8 * sizeof(binned_t)) - 2;
+  static constexpr binned_t overflowBin = nbins >> 1;
+  static constexpr binned_t underflowBin = -(nbins >> 1);
+  static constexpr float binned_max = maxValueX100 / 100.f;
+  static constexpr float binned_min = -binned_max;
+  static constexpr float softness = softnessX100 / 100.f;
+  static float scale() { return std::asinh(binned_max / softness); }
+  static binned_t pack(float value)
+  {
+    const float bin = std::asinh(value / softness) / scale() * (nbins >> 1);
+    return static_cast<binned_t>(bin >= 0 ? bin + 0.5f : bin - 0.5f);
+  }
+  static float unpack(binned_t value) { return softness * std::sinh(static_cast<float>(value) / (nbins >> 1) * scale()); }
+};
+
+// Standard binnings
+using binningInt8 = linearBinning<int8_t, 635>;          // bin width 0.05, same as the tiny tables
+using binningInt16 = linearBinning<int16_t, 1000>;       // bin width 3.1e-4
+using binningInt8Fine = asinhBinning<int8_t, 1000, 100>; // bin width 0.024 at 0, 0.075 at 3
+
+template <class T>
+using hasCustomPacking = decltype(T::pack(0.f));
+
+// Function to pack a float into a binned value
+template <typename binningType>
+typename binningType::binned_t packValue(const float& valueToBin)
 {
   if (valueToBin <= binningType::binned_min) {
-    table(binningType::underflowBin);
+    return binningType::underflowBin;
   } else if (valueToBin >= binningType::binned_max) {
-    table(binningType::overflowBin);
+    return binningType::overflowBin;
+  }
+  if constexpr (std::experimental::is_detected<hasCustomPacking, binningType>::value) {
+    return binningType::pack(valueToBin);
   } else if (valueToBin >= 0) {
-    table(static_cast<typename binningType::binned_t>((valueToBin / binningType::bin_width) + 0.5f));
+    return static_cast<typename binningType::binned_t>((valueToBin / binningType::bin_width) + 0.5f);
   } else {
-    table(static_cast<typename binningType::binned_t>((valueToBin / binningType::bin_width) - 0.5f));
+    return static_cast<typename binningType::binned_t>((valueToBin / binningType::bin_width) - 0.5f);
   }
 }
 
+// Function to pack a float into a binned value in table
+template <typename binningType, typename T>
+void packInTable(const float& valueToBin, T& table)
+{
+  table(packValue<binningType>(valueToBin));
+}
+
 // Function to unpack a binned value into a float
 template <typename binningType>
 float unPackInTable(const typename binningType::binned_t& valueToUnpack)
 {
-  return binningType::bin_width * static_cast<float>(valueToUnpack);
+  if constexpr (std::experimental::is_detected<hasCustomPacking, binningType>::value) {
+    return binningType::unpack(valueToUnpack);
+  } else {
+    return binningType::bin_width * static_cast<float>(valueToUnpack);
+  }
+}
+
+// Functions to pack and unpack full columns
+template <typename binningType>
+void packColumn(const float* values, typename binningType::binned_t* packed, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; i++) {
+    packed[i] = packValue<binningType>(values[i]);
+  }
+}
+
+template <typename binningType>
+void unPackColumn(const typename binningType::binned_t* packed, float* values, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; i++) {
+    values[i] = unPackInTable<binningType>(packed[i]);
+  }
 }
 
 // Checkers for TOF PID hypothesis availability (runtime)
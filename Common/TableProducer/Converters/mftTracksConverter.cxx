@@ -19,6 +19,10 @@
 
 /// \author L.Micheletti <luca.micheletti@cern.ch>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -28,17 +32,24 @@ using namespace o2::framework;
 
 struct MftTracksConverter {
   Produces<aod::StoredMFTTracks_001> mftTracks_001;
+
+  // dummy cluster sizes (1 in each of the first nClusters layers) for 0 to 10 clusters
+  static constexpr std::array<uint64_t, 11> clusterSizesOfNClusters = [] {
+    std::array<uint64_t, 11> clusterSizes{};
+    for (int nClusters = 0; nClusters < 11; nClusters++) {
+      for (int layer = 0; layer < nClusters; ++layer) {
+        clusterSizes[nClusters] |= (1ULL << (layer * 6));
+      }
+    }
+    return clusterSizes;
+  }();
+
   void process(aod::MFTTracks_000 const& mftTracks_000)
   {
-
+    mftTracks_001.reserve(mftTracks_000.size());
     for (const auto& track0 : mftTracks_000) {
-      uint64_t mftClusterSizesAndTrackFlags = 0;
       int8_t nClusters = track0.nClusters();
-
-      for (int layer = 0; layer < 10; ++layer) {
-        mftClusterSizesAndTrackFlags &= ~(0x3fULL << (layer * 6));
-        mftClusterSizesAndTrackFlags |= (layer < nClusters) ? (1ULL << (layer * 6)) : 0;
-      }
+      const uint64_t mftClusterSizesAndTrackFlags = clusterSizesOfNClusters[std::clamp<int>(nClusters, 0, 10)];
 
       mftTracks_001(track0.collisionId(),
                     track0.x(),
@@ -19,6 +19,9 @@
 
 /// \author F.Mazzaschi <fmazzasc@cern.ch>
 
+#include <array>
+#include <cstdint>
+
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -28,17 +31,26 @@ using namespace o2::framework;
 
 struct TracksExtraConverter {
   Produces<aod::StoredTracksExtra_001> tracksExtra_001;
-  void process(aod::TracksExtra_000 const& tracksExtra_000)
-  {
 
-    for (const auto& track0 : tracksExtra_000) {
-
-      uint32_t itsClusterSizes = 0;
+  // dummy ITSClusterSizes for each of the 128 ITSClusterMap values
+  static constexpr std::array<uint32_t, 128> itsClusterSizesOfMap = [] {
+    std::array<uint32_t, 128> clusterSizes{};
+    for (uint32_t map = 0; map < clusterSizes.size(); map++) {
       for (int layer = 0; layer < 7; layer++) {
-        if (track0.itsClusterMap() & (1 << layer)) {
-          itsClusterSizes |= (0xf << (layer * 4));
+        if (map & (1 << layer)) {
+          clusterSizes[map] |= (0xf << (layer * 4));
         }
       }
+    }
+    return clusterSizes;
+  }();
+
+  void process(aod::TracksExtra_000 const& tracksExtra_000)
+  {
+    tracksExtra_001.reserve(tracksExtra_000.size());
+    for (const auto& track0 : tracksExtra_000) {
+
+      const uint32_t itsClusterSizes = itsClusterSizesOfMap[track0.itsClusterMap() & 0x7f];
 
       tracksExtra_001(track0.tpcInnerParam(),
                       track0.flags(),
@@ -108,27 +108,22 @@ struct bayesPid {
 
   std::array<std::array<float, PID::NIDs>, kNProb> Probability; /// Probabilities for all the cases defined in ProbType
   std::vector<PID::ID> enabledSpecies;                          /// Enabled species
+  std::array<bool, PID::NIDs> isEnabledSpecies{false};          /// Enabled species, indexed by PID::ID
+  float flatProbability = 1.f;                                  /// Flat distribution over the enabled species (no decision yet)
 
-  /// Checker of the species that are enabled and initializer of the probabilities
+  /// The probabilities are computed for chunks of tracks and combined for all the tracks of a chunk at once
+  static constexpr int kChunkSize = 256;
+  std::array<std::array<std::array<float, kChunkSize>, PID::NIDs>, kNDet> chunkProbability; /// Detector probabilities of the tracks of a chunk
+  std::array<std::array<float, kChunkSize>, PID::NIDs> chunkMergedPrior;                    /// Merged probabilities times the prior probabilities of the tracks of a chunk
+  std::array<float, kChunkSize> chunkSum;                                                   /// Normalisation of the Bayesian probabilities of the tracks of a chunk
+
+  /// Checker of the species that are enabled for a detector
   template <ProbType detIndex, o2::track::PID::ID pid>
-  bool checkEnabled()
+  bool checkEnabled() const
   {
     static_assert(detIndex < kNDet && detIndex >= 0);
-    if (!enabledDet[detIndex]) {
-      LOG(debug) << "Detector " << detectorName[detIndex] << " disabled";
-      return false; // Setting the probability to 1 if the detector is disabled
-    }
-    LOG(debug) << "Detector " << detectorName[detIndex] << " enabled with " << enabledSpecies.size() << " species";
-
-    for (const auto enabledPid : enabledSpecies) { // Checking that the species is enabled
-      LOG(debug) << "Testing " << PID::getName(enabledPid) << " " << static_cast<int>(enabledPid) << " vs " << static_cast<int>(pid);
-      if (enabledPid == pid) {
-        LOG(debug) << "Particle " << PID::getName(enabledPid) << " enabled";
-        Probability[detIndex][pid] = 1.f / enabledSpecies.size(); // set flat distribution (no decision yet)
-        return true;
-      }
-    }
-    return false;
+    // the probabilities of the disabled detectors stay at 1
+    return enabledDet[detIndex] && isEnabledSpecies[pid];
   }
 
   float fRange = 5.f;
@@ -217,6 +212,15 @@ struct bayesPid {
     } else { // All ok
       LOG(info) << enabledSpecies.size() << " species enabled for the Bayesian PID computation";
     }
+    for (const auto enabledPid : enabledSpecies) {
+      isEnabledSpecies[enabledPid] = true;
+    }
+    flatProbability = 1.f / enabledSpecies.size();
+    for (auto& detectorProbability : chunkProbability) {
+      for (auto& speciesProbability : detectorProbability) {
+        speciesProbability.fill(1.f);
+      }
+    }
     // Getting the parametrization parameters
     ccdb->setURL(url.value);
     ccdb->setTimestamp(timestamp.value);
@@ -257,12 +261,13 @@ struct bayesPid {
 
   /// Computes PID probabilities for the TPC
   template <o2::track::PID::ID pid>
-  void ComputeTPCProbability(const Coll::iterator& collision, const Trks::iterator& track)
+  void ComputeTPCProbability(const Coll::iterator& collision, const Trks::iterator& track, int iTrack)
   {
 
     if (!checkEnabled<kTPC, pid>()) {
       return;
     }
+    float& probability = chunkProbability[kTPC][pid][iTrack];
 
     const float dedx = track.tpcSignal();
     bool mismatch = true;
@@ -277,18 +282,18 @@ struct bayesPid {
     //  sigma = fTPCResponse.GetExpectedSigma(track, type, AliTPCPIDResponse::kdEdxDefault, fUseTPCEtaCorrection, fUseTPCMultiplicityCorrection, fUseTPCPileupCorrection);
 
     if (abs(dedx - bethe) > fRange * sigma) {
-      // Probability[kTPC][pid] = exp(-0.5 * fRange * fRange) / sigma; // BUG fix
-      Probability[kTPC][pid] = exp(-0.5 * fRange * fRange);
+      // probability = exp(-0.5 * fRange * fRange) / sigma; // BUG fix
+      probability = exp(-0.5 * fRange * fRange);
     } else {
-      // Probability[kTPC][pid] = exp(-0.5 * (dedx - bethe) * (dedx - bethe) / (sigma * sigma)) / sigma; //BUG fix
-      Probability[kTPC][pid] = exp(-0.5 * (dedx - bethe) * (dedx - bethe) / (sigma * sigma));
+      // probability = exp(-0.5 * (dedx - bethe) * (dedx - bethe) / (sigma * sigma)) / sigma; //BUG fix
+      probability = exp(-0.5 * (dedx - bethe) * (dedx - bethe) / (sigma * sigma));
       mismatch = false;
     }
-    if (Probability[kTPC][pid] <= 0.f) {
-      Probability[kTPC][pid] = 0.f;
+    if (probability <= 0.f) {
+      probability = 0.f;
     }
     if (mismatch) {
-      Probability[kTPC][pid] = 1.f / Probability[kTPC].size();
+      probability = 1.f / PID::NIDs;
     }
   }
 
@@ -298,23 +303,20 @@ struct bayesPid {
   bool fNoTOFmism = true;
   float fTOFtail = 0.9;
 
-  /// Response of the TOF detector
-  template <o2::track::PID::ID pid>
-  using respTOF = o2::pid::tof::ExpTimes<Trks::iterator, pid>;
-
   /// Compute PID probabilities for TOF
   template <o2::track::PID::ID pid>
-  void ComputeTOFProbability(const Trks::iterator& track)
+  void ComputeTOFProbability(const Trks::iterator& track, int iTrack)
   {
 
     if (!checkEnabled<kTOF, pid>()) {
       return;
     }
+    float& probability = chunkProbability[kTOF][pid][iTrack];
 
     if (!track.hasTOF()) {
+      probability = flatProbability;
       return;
     }
-    constexpr respTOF<pid> responseTOFPID;
 
     // const float pt = track.pt();
     float mismPropagationFactor[10] = {1., 1., 1., 1., 1., 1., 1., 1., 1., 1.};
@@ -364,59 +366,38 @@ struct bayesPid {
 
     const float nsigmas = /*responseTOFPID.GetSeparation(Response[kTOF], track) +*/ meanCorrFactor;
 
-    const float expTime = responseTOFPID.GetExpectedSignal(track);
     const float sig = /*responseTOFPID.GetExpectedSigma(Response[kTOF], track)*/ +0.f;
 
     if (nsigmas < fTOFtail) {
-      Probability[kTOF][pid] = exp(-0.5 * nsigmas * nsigmas) / sig;
+      probability = exp(-0.5 * nsigmas * nsigmas) / sig;
     } else {
-      Probability[kTOF][pid] = exp(-(nsigmas - fTOFtail * 0.5) * fTOFtail) / sig;
+      probability = exp(-(nsigmas - fTOFtail * 0.5) * fTOFtail) / sig;
     }
 
-    Probability[kTOF][pid] += fgTOFmismatchProb * mismPropagationFactor[pid];
-    LOG(debug) << "For " << pid_constants::sNames[pid] << " with signal " << track.tofSignal() << " computing exp time " << expTime << " and sigma " << sig << " and nsigma " << nsigmas << " probability " << Probability[kTOF][pid];
+    probability += fgTOFmismatchProb * mismPropagationFactor[pid];
   }
 
-  /// Calculate probabilities from all enabled detectors and species
-  void MergeProbabilities()
+  /// Merges the probabilities of all enabled detectors and applies the prior probabilities, for the first nTracks tracks of the chunk
+  void MergeProbabilities(int nTracks)
   {
-    LOG(debug) << "Merging probabilities";
-
-    float probSum[kNDet + 1] = {0.f}; /// Summed probabilities for all detectors + 1 for the sum of all detectors
-
+    std::fill(chunkSum.begin(), chunkSum.begin() + nTracks, 0.f);
     for (const auto enabledPid : enabledSpecies) {
-      Probability[kMerged][enabledPid] = 1.f;
-      for (int det = 0; det < kNDet; det++) {
-        probSum[det] += Probability[det][enabledPid];
-        Probability[kMerged][enabledPid] *= Probability[det][enabledPid];
-      }
-      probSum[kNDet] += Probability[kMerged][enabledPid];
-      LOG(debug) << "For " << PID::getName(enabledPid);
-      for (int det = 0; det < kNDet; det++) {
-        if (enabledDet[det]) {
-          LOG(debug) << "\t" << detectorName[det] << " Probability " << Probability[det][enabledPid];
+      const float prior = Probability[kPrior][enabledPid];
+      for (int iTrack = 0; iTrack < nTracks; iTrack++) {
+        float merged = 1.f;
+        for (int det = 0; det < kNDet; det++) {
+          merged *= chunkProbability[det][enabledPid][iTrack];
         }
+        chunkMergedPrior[enabledPid][iTrack] = merged * prior;
+        chunkSum[iTrack] += chunkMergedPrior[enabledPid][iTrack];
       }
-      LOG(debug) << "\tCombined: " << Probability[kMerged][enabledPid];
     }
-    for (int det = 0; det < kNDet; det++) {
-      if (enabledDet[det]) {
-        LOG(debug) << "\tSum " << detectorName[det] << " Probability " << probSum[det];
-      }
-    }
-    LOG(debug) << "\tSum combined: " << probSum[kNDet];
   }
 
-  /// Calculate Bayesian probabilities
-  void ComputeBayesProbabilities()
+  /// Calculate Bayesian probabilities of a track of the chunk
+  void ComputeBayesProbabilities(int iTrack)
   {
-    LOG(debug) << "Computing bayes probabilities";
-
-    float sum = 0.;
-    for (const auto enabledPid : enabledSpecies) {
-      LOG(debug) << "Adding " << Probability[kMerged][enabledPid] << " with prior " << Probability[kPrior][enabledPid];
-      sum += Probability[kMerged][enabledPid] * Probability[kPrior][enabledPid];
-    }
+    const float sum = chunkSum[iTrack];
     if (sum <= 0) {
       // LOG(warning) << "Invalid probability densities or prior probabilities";
       for (uint64_t i = 0; i < Probability[kBayesian].size(); i++) {
@@ -425,62 +406,19 @@ struct bayesPid {
       return;
     }
     for (const auto enabledPid : enabledSpecies) {
-      Probability[kBayesian][enabledPid] = Probability[kMerged][enabledPid] * Probability[kPrior][enabledPid] / sum;
+      Probability[kBayesian][enabledPid] = chunkMergedPrior[enabledPid][iTrack] / sum;
       // if (probDensityMism) {
       //   probDensityMism[enabledPid] *= Probability[kPrior][enabledPid] / sum;
       // }
-      LOG(debug) << "For " << PID::getName(enabledPid) << " merged prob. " << Probability[kMerged][enabledPid] << " prior " << Probability[kPrior][enabledPid] << " sum " << sum << " bayesian Probability: " << Probability[kBayesian][enabledPid];
     }
   }
 
-  void process(Coll const& collisions, Trks const& tracks)
+  /// Fills the tables for the first nTracks tracks of the chunk
+  void fillTables(int nTracks)
   {
-
-    // Check and fill enabled tables
-    auto makeTable = [&tracks](const Configurable<int>& flag, auto& table) {
-      if (flag.value == 1) {
-        // Prepare memory for enabled tables
-        table.reserve(tracks.size());
-      }
-    };
-
-    tableBayes.reserve(tracks.size());
-    makeTable(pidEl, tablePIDEl);
-    makeTable(pidMu, tablePIDMu);
-    makeTable(pidPi, tablePIDPi);
-    makeTable(pidKa, tablePIDKa);
-    makeTable(pidPr, tablePIDPr);
-    makeTable(pidDe, tablePIDDe);
-    makeTable(pidTr, tablePIDTr);
-    makeTable(pidHe, tablePIDHe);
-    makeTable(pidAl, tablePIDAl);
-
-    for (auto const& trk : tracks) { // Loop on Tracks
-
-      auto collision = collisions.iteratorAt(trk.collisionId());
-      ComputeTPCProbability<PID::Electron>(collision, trk);
-      ComputeTPCProbability<PID::Muon>(collision, trk);
-      ComputeTPCProbability<PID::Pion>(collision, trk);
-      ComputeTPCProbability<PID::Kaon>(collision, trk);
-      ComputeTPCProbability<PID::Proton>(collision, trk);
-      ComputeTPCProbability<PID::Deuteron>(collision, trk);
-      ComputeTPCProbability<PID::Triton>(collision, trk);
-      ComputeTPCProbability<PID::Helium3>(collision, trk);
-      ComputeTPCProbability<PID::Alpha>(collision, trk);
-
-      ComputeTOFProbability<PID::Electron>(trk);
-      ComputeTOFProbability<PID::Muon>(trk);
-      ComputeTOFProbability<PID::Pion>(trk);
-      ComputeTOFProbability<PID::Kaon>(trk);
-      ComputeTOFProbability<PID::Proton>(trk);
-      ComputeTOFProbability<PID::Deuteron>(trk);
-      ComputeTOFProbability<PID::Triton>(trk);
-      ComputeTOFProbability<PID::Helium3>(trk);
-      ComputeTOFProbability<PID::Alpha>(trk);
-
-      MergeProbabilities();
-
-      ComputeBayesProbabilities();
+    MergeProbabilities(nTracks);
+    for (int iTrack = 0; iTrack < nTracks; iTrack++) {
+      ComputeBayesProbabilities(iTrack);
 
       if (pidEl == 1) {
         tablePIDEl(Probability[kBayesian][PID::Electron] * 100.f);
@@ -513,6 +451,60 @@ struct bayesPid {
       tableBayes((*mostProbable) * 100.f, std::distance(Probability[kBayesian].begin(), mostProbable));
     }
   }
+
+  void process(Coll const& collisions, Trks const& tracks)
+  {
+
+    // Check and fill enabled tables
+    auto makeTable = [&tracks](const Configurable<int>& flag, auto& table) {
+      if (flag.value == 1) {
+        // Prepare memory for enabled tables
+        table.reserve(tracks.size());
+      }
+    };
+
+    tableBayes.reserve(tracks.size());
+    makeTable(pidEl, tablePIDEl);
+    makeTable(pidMu, tablePIDMu);
+    makeTable(pidPi, tablePIDPi);
+    makeTable(pidKa, tablePIDKa);
+    makeTable(pidPr, tablePIDPr);
+    makeTable(pidDe, tablePIDDe);
+    makeTable(pidTr, tablePIDTr);
+    makeTable(pidHe, tablePIDHe);
+    makeTable(pidAl, tablePIDAl);
+
+    int iTrack = 0;
+    for (auto const& trk : tracks) { // Loop on Tracks
+
+      auto collision = collisions.iteratorAt(trk.collisionId());
+      ComputeTPCProbability<PID::Electron>(collision, trk, iTrack);
+      ComputeTPCProbability<PID::Muon>(collision, trk, iTrack);
+      ComputeTPCProbability<PID::Pion>(collision, trk, iTrack);
+      ComputeTPCProbability<PID::Kaon>(collision, trk, iTrack);
+      ComputeTPCProbability<PID::Proton>(collision, trk, iTrack);
+      ComputeTPCProbability<PID::Deuteron>(collision, trk, iTrack);
+      ComputeTPCProbability<PID::Triton>(collision, trk, iTrack);
+      ComputeTPCProbability<PID::Helium3>(collision, trk, iTrack);
+      ComputeTPCProbability<PID::Alpha>(collision, trk, iTrack);
+
+      ComputeTOFProbability<PID::Electron>(trk, iTrack);
+      ComputeTOFProbability<PID::Muon>(trk, iTrack);
+      ComputeTOFProbability<PID::Pion>(trk, iTrack);
+      ComputeTOFProbability<PID::Kaon>(trk, iTrack);
+      ComputeTOFProbability<PID::Proton>(trk, iTrack);
+      ComputeTOFProbability<PID::Deuteron>(trk, iTrack);
+      ComputeTOFProbability<PID::Triton>(trk, iTrack);
+      ComputeTOFProbability<PID::Helium3>(trk, iTrack);
+      ComputeTOFProbability<PID::Alpha>(trk, iTrack);
+
+      if (++iTrack == kChunkSize) {
+        fillTables(iTrack);
+        iTrack = 0;
+      }
+    }
+    fillTables(iTrack);
+  }
 };
 
 struct bayesPidQa {
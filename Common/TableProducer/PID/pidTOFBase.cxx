@@ -449,6 +449,20 @@ struct tofEventTime {
       float t0AC[2] = {.0f, 999.f};                                                                                   // Value and error of T0A or T0C or T0AC
       float t0TOF[2] = {static_cast<float_t>(evTimeTOF.mEventTime), static_cast<float_t>(evTimeTOF.mEventTimeError)}; // Value and error of TOF
 
+      // The FT0 contribution is the same for all the tracks of the collision, only the TOF one depends on the track
+      uint8_t flagsT0AC = 0;
+      float weightT0AC = 0.f;
+      float eventTimeT0AC = 0.f;
+      if (collision.has_foundFT0()) { // T0 measurement is available
+        if (collision.t0ACValid()) {
+          t0AC[0] = collision.t0AC() * 1000.f;
+          t0AC[1] = collision.t0resolution() * 1000.f;
+          flagsT0AC = o2::aod::pidflags::enums::PIDFlags::EvTimeT0AC;
+        }
+        weightT0AC = 1.f / (t0AC[1] * t0AC[1]);
+        eventTimeT0AC = t0AC[0] * weightT0AC;
+      }
+
       uint8_t flags = 0;
       int nGoodTracksForTOF = 0;
       float eventTime = 0.f;
@@ -475,16 +489,9 @@ struct tofEventTime {
         }
 
         if (collision.has_foundFT0()) { // T0 measurement is available
-          // const auto& ft0 = collision.foundFT0();
-          if (collision.t0ACValid()) {
-            t0AC[0] = collision.t0AC() * 1000.f;
-            t0AC[1] = collision.t0resolution() * 1000.f;
-            flags |= o2::aod::pidflags::enums::PIDFlags::EvTimeT0AC;
-          }
-
-          weight = 1.f / (t0AC[1] * t0AC[1]);
-          eventTime += t0AC[0] * weight;
-          sumOfWeights += weight;
+          flags |= flagsT0AC;
+          eventTime += eventTimeT0AC;
+          sumOfWeights += weightT0AC;
         }
 
         if (sumOfWeights < weightDiamond) { // avoiding sumOfWeights = 0 or worse that diamond
@@ -488,6 +488,20 @@ struct tofEventTime {
       float t0AC[2] = {.0f, 999.f};                                                                                   // Value and error of T0A or T0C or T0AC
       float t0TOF[2] = {static_cast<float_t>(evTimeTOF.mEventTime), static_cast<float_t>(evTimeTOF.mEventTimeError)}; // Value and error of TOF
 
+      // The FT0 contribution is the same for all the tracks of the collision, only the TOF one depends on the track
+      uint8_t flagsT0AC = 0;
+      float weightT0AC = 0.f;
+      float eventTimeT0AC = 0.f;
+      if (collision.has_foundFT0()) { // T0 measurement is available
+        if (collision.t0ACValid()) {
+          t0AC[0] = collision.t0AC() * 1000.f;
+          t0AC[1] = collision.t0resolution() * 1000.f;
+          flagsT0AC = o2::aod::pidflags::enums::PIDFlags::EvTimeT0AC;
+        }
+        weightT0AC = 1.f / (t0AC[1] * t0AC[1]);
+        eventTimeT0AC = t0AC[0] * weightT0AC;
+      }
+
       uint8_t flags = 0;
       int nGoodTracksForTOF = 0;
       float eventTime = 0.f;
@@ -514,16 +528,9 @@ struct tofEventTime {
         }
 
         if (collision.has_foundFT0()) { // T0 measurement is available
-          // const auto& ft0 = collision.foundFT0();
-          if (collision.t0ACValid()) {
-            t0AC[0] = collision.t0AC() * 1000.f;
-            t0AC[1] = collision.t0resolution() * 1000.f;
-            flags |= o2::aod::pidflags::enums::PIDFlags::EvTimeT0AC;
-          }
-
-          weight = 1.f / (t0AC[1] * t0AC[1]);
-          eventTime += t0AC[0] * weight;
-          sumOfWeights += weight;
+          flags |= flagsT0AC;
+          eventTime += eventTimeT0AC;
+          sumOfWeights += weightT0AC;
         }
 
         if (sumOfWeights < weightDiamond) { // avoiding sumOfWeights = 0 or worse that diamond
@@ -965,19 +972,9 @@ struct tofPidMerge {
   void process(aod::BCs const&) {}
 
   using Trks = soa::Join<aod::TracksIU, aod::TracksExtra, aod::TOFSignal, aod::TOFEvTime, aod::pidEvTimeFlags>;
-  template <o2::track::PID::ID pid>
-  using ResponseImplementation = o2::pid::tof::ExpTimes<Trks::iterator, pid>;
   void processData(Trks const& tracks, aod::Collisions const&, aod::BCsWithTimestamps const&)
   {
-    constexpr auto responseEl = ResponseImplementation<PID::Electron>();
-    constexpr auto responseMu = ResponseImplementation<PID::Muon>();
-    constexpr auto responsePi = ResponseImplementation<PID::Pion>();
-    constexpr auto responseKa = ResponseImplementation<PID::Kaon>();
-    constexpr auto responsePr = ResponseImplementation<PID::Proton>();
-    constexpr auto responseDe = ResponseImplementation<PID::Deuteron>();
-    constexpr auto responseTr = ResponseImplementation<PID::Triton>();
-    constexpr auto responseHe = ResponseImplementation<PID::Helium3>();
-    constexpr auto responseAl = ResponseImplementation<PID::Alpha>();
+    o2::pid::tof::ExpTimesAllSpecies<Trks::iterator> response; // Hypothesis-independent quantities of the current track
 
     for (auto const& track : tracks) { // Loop on all tracks
       if (!track.has_collision()) {    // Skipping tracks without collisions
@@ -1017,51 +1014,52 @@ struct tofPidMerge {
         }
         continue;
       }
+      response.setTrack(mRespParamsV3, trk);
 
       for (auto const& pidId : mEnabledParticles) { // Loop on enabled particle hypotheses
         switch (pidId) {
           case idxEl: {
-            nsigma = responseEl.GetSeparation(mRespParamsV3, trk);
+            nsigma = response.GetSeparation<PID::Electron>(mRespParamsV3);
             aod::pidutils::packInTable<aod::pidtof_tiny::binning>(nsigma, tablePIDEl);
             break;
           }
           case idxMu: {
-            nsigma = responseMu.GetSeparation(mRespParamsV3, trk);
+            nsigma = response.GetSeparation<PID::Muon>(mRespParamsV3);
             aod::pidutils::packInTable<aod::pidtof_tiny::binning>(nsigma, tablePIDMu);
             break;
           }
           case idxPi: {
-            nsigma = responsePi.GetSeparation(mRespParamsV3, trk);
+            nsigma = response.GetSeparation<PID::Pion>(mRespParamsV3);
             aod::pidutils::packInTable<aod::pidtof_tiny::binning>(nsigma, tablePIDPi);
             break;
           }
           case idxKa: {
-            nsigma = responseKa.GetSeparation(mRespParamsV3, trk);
+            nsigma = response.GetSeparation<PID::Kaon>(mRespParamsV3);
             aod::pidutils::packInTable<aod::pidtof_tiny::binning>(nsigma, tablePIDKa);
             break;
           }
           case idxPr: {
-            nsigma = responsePr.GetSeparation(mRespParamsV3, trk);
+            nsigma = response.GetSeparation<PID::Proton>(mRespParamsV3);
             aod::pidutils::packInTable<aod::pidtof_tiny::binning>(nsigma, tablePIDPr);
             break;
           }
           case idxDe: {
-            nsigma = responseDe.GetSeparation(mRespParamsV3, trk);
+            nsigma = response.GetSeparation<PID::Deuteron>(mRespParamsV3);
             aod::pidutils::packInTable<aod::pidtof_tiny::binning>(nsigma, tablePIDDe);
             break;
           }
           case idxTr: {
-            nsigma = responseTr.GetSeparation(mRespParamsV3, trk);
+            nsigma = response.GetSeparation<PID::Triton>(mRespParamsV3);
             aod::pidutils::packInTable<aod::pidtof_tiny::binning>(nsigma, tablePIDTr);
             break;
           }
           case idxHe: {
-            nsigma = responseHe.GetSeparation(mRespParamsV3, trk);
+            nsigma = response.GetSeparation<PID::Helium3>(mRespParamsV3);
             aod::pidutils::packInTable<aod::pidtof_tiny::binning>(nsigma, tablePIDHe);
             break;
           }
           case idxAl: {
-            nsigma = responseAl.GetSeparation(mRespParamsV3, trk);
+            nsigma = response.GetSeparation<PID::Alpha>(mRespParamsV3);
             aod::pidutils::packInTable<aod::pidtof_tiny::binning>(nsigma, tablePIDAl);
             break;
           }
@@ -1076,56 +1074,56 @@ struct tofPidMerge {
       for (auto const& pidId : mEnabledParticlesFull) { // Loop on enabled particle hypotheses with full tables
         switch (pidId) {
           case idxEl: {
-            resolution = responseEl.GetExpectedSigma(mRespParamsV3, trk);
-            nsigma = responseEl.GetSeparation(mRespParamsV3, trk, resolution);
+            resolution = response.GetExpectedSigma<PID::Electron>(mRespParamsV3);
+            nsigma = response.GetSeparation<PID::Electron>(resolution);
             tablePIDFullEl(resolution, nsigma);
             break;
           }
           case idxMu: {
-            resolution = responseMu.GetExpectedSigma(mRespParamsV3, trk);
-            nsigma = responseMu.GetSeparation(mRespParamsV3, trk, resolution);
+            resolution = response.GetExpectedSigma<PID::Muon>(mRespParamsV3);
+            nsigma = response.GetSeparation<PID::Muon>(resolution);
             tablePIDFullMu(resolution, nsigma);
             break;
           }
           case idxPi: {
-            resolution = responsePi.GetExpectedSigma(mRespParamsV3, trk);
-            nsigma = responsePi.GetSeparation(mRespParamsV3, trk);
+            resolution = response.GetExpectedSigma<PID::Pion>(mRespParamsV3);
+            nsigma = response.GetSeparation<PID::Pion>(mRespParamsV3);
             tablePIDFullPi(resolution, nsigma);
             break;
           }
           case idxKa: {
-            resolution = responseKa.GetExpectedSigma(mRespParamsV3, trk);
-            nsigma = responseKa.GetSeparation(mRespParamsV3, trk, resolution);
+            resolution = response.GetExpectedSigma<PID::Kaon>(mRespParamsV3);
+            nsigma = response.GetSeparation<PID::Kaon>(resolution);
             tablePIDFullKa(resolution, nsigma);
             break;
           }
           case idxPr: {
-            resolution = responsePr.GetExpectedSigma(mRespParamsV3, trk);
-            nsigma = responsePr.GetSeparation(mRespParamsV3, trk, resolution);
+            resolution = response.GetExpectedSigma<PID::Proton>(mRespParamsV3);
+            nsigma = response.GetSeparation<PID::Proton>(resolution);
             tablePIDFullPr(resolution, nsigma);
             break;
           }
           case idxDe: {
-            resolution = responseDe.GetExpectedSigma(mRespParamsV3, trk);
-            nsigma = responseDe.GetSeparation(mRespParamsV3, trk, resolution);
+            resolution = response.GetExpectedSigma<PID::Deuteron>(mRespParamsV3);
+            nsigma = response.GetSeparation<PID::Deuteron>(resolution);
             tablePIDFullDe(resolution, nsigma);
             break;
           }
           case idxTr: {
-            resolution = responseTr.GetExpectedSigma(mRespParamsV3, trk);
-            nsigma = responseTr.GetSeparation(mRespParamsV3, trk, resolution);
+            resolution = response.GetExpectedSigma<PID::Triton>(mRespParamsV3);
+            nsigma = response.GetSeparation<PID::Triton>(resolution);
             tablePIDFullTr(resolution, nsigma);
             break;
           }
           case idxHe: {
-            resolution = responseHe.GetExpectedSigma(mRespParamsV3, trk);
-            nsigma = responseHe.GetSeparation(mRespParamsV3, trk, resolution);
+            resolution = response.GetExpectedSigma<PID::Helium3>(mRespParamsV3);
+            nsigma = response.GetSeparation<PID::Helium3>(resolution);
             tablePIDFullHe(resolution, nsigma);
             break;
           }
           case idxAl: {
-            resolution = responseAl.GetExpectedSigma(mRespParamsV3, trk);
-            nsigma = responseAl.GetSeparation(mRespParamsV3, trk, resolution);
+            resolution = response.GetExpectedSigma<PID::Alpha>(mRespParamsV3);
+            nsigma = response.GetSeparation<PID::Alpha>(resolution);
             tablePIDFullAl(resolution, nsigma);
             break;
           }
@@ -27,6 +27,7 @@
 // O2 includes
 #include <CCDB/BasicCCDBManager.h>
 #include "Framework/AnalysisTask.h"
+#include "Framework/HistogramRegistry.h"
 #include "ReconstructionDataFormats/Track.h"
 #include "CCDB/CcdbApi.h"
 #include "Common/DataModel/PIDResponse.h"
@@ -78,9 +79,9 @@ struct tpcPid {
 
   // Network correction for TPC PID response
   OnnxModel network;
+  HistogramRegistry histos{"histos", {}, OutputObjHandlingPolicy::AnalysisObject};
   o2::ccdb::CcdbApi ccdbApi;
   std::map<std::string, std::string> metadata;
-  std::map<std::string, std::string> headers;
   std::vector<int> speciesNetworkFlags = std::vector<int>(9);
 
   // Input parameters
@@ -98,6 +99,12 @@ struct tpcPid {
   Configurable<std::string> networkPathCCDB{"networkPathCCDB", "Analysis/PID/TPC/ML", "Path on CCDB"};
   Configurable<bool> enableNetworkOptimizations{"enableNetworkOptimizations", 1, "(bool) If the neural network correction is used, this enables GraphOptimizationLevel::ORT_ENABLE_EXTENDED in the ONNX session"};
   Configurable<int> networkSetNumThreads{"networkSetNumThreads", 0, "Especially important for running on a SLURM cluster. Sets the number of threads used for execution."};
+  Configurable<std::string> networkExecutionProvider{"networkExecutionProvider", "cpu", "(std::string) Execution provider of the ONNX session: cpu, cuda, rocm or openvino. Falls back to cpu if not available"};
+  Configurable<int> networkDeviceId{"networkDeviceId", 0, "Device used by the GPU execution providers"};
+  Configurable<int> networkWarmUpIterations{"networkWarmUpIterations", 1, "Number of dummy inferences run after loading the network"};
+  Configurable<int> networkBatchSize{"networkBatchSize", 65536, "Number of tracks evaluated in one call of the network (0: whole data frame)"};
+  Configurable<bool> enableNetworkMonitoring{"enableNetworkMonitoring", false, "(bool) Fill histograms with the network throughput (tracks per second) for each data frame"};
+  Configurable<bool> networkEnableProfiling{"networkEnableProfiling", false, "(bool) Enables the ONNX session profiling (written when the session is destroyed)"};
   // Configuration flags to include and exclude particle hypotheses
   Configurable<int> pidEl{"pid-el", -1, {"Produce PID information for the Electron mass hypothesis, overrides the automatic setup: the corresponding table can be set off (0) or on (1)"}};
   Configurable<int> pidMu{"pid-mu", -1, {"Produce PID information for the Muon mass hypothesis, overrides the automatic setup: the corresponding table can be set off (0) or on (1)"}};
@@ -157,6 +164,11 @@ struct tpcPid {
     speciesNetworkFlags[7] = useNetworkHe;
     speciesNetworkFlags[8] = useNetworkAl;
 
+    if (useNetworkCorrection && enableNetworkMonitoring) {
+      histos.add("hNetworkTracksPerSecond", "TPC PID network throughput (input creation + evaluation);tracks / s;data frames", kTH1F, {{1000, 0., 1.e7}});
+      histos.add("hNetworkEvalTracksPerSecond", "TPC PID network throughput (evaluation only);tracks / s;data frames", kTH1F, {{1000, 0., 1.e7}});
+    }
+
     // Initialise metadata object for CCDB calls
     if (recoPass.value == "") {
       LOGP(info, "Reco pass not specified; CCDB will take latest available object");
@@ -205,18 +217,19 @@ struct tpcPid {
     if (!useNetworkCorrection) {
       return;
     } else {
+      network.setExecutionProvider(networkExecutionProvider.value, networkDeviceId.value);
+      network.setProfiling(networkEnableProfiling.value, "pid-tpc-network");
       /// CCDB and auto-fetching
       ccdbApi.init(url);
       if (!autofetchNetworks) {
         if (ccdbTimestamp > 0) {
           /// Fetching network for specific timestamp
           LOG(info) << "Fetching network for timestamp: " << ccdbTimestamp.value;
-          bool retrieveSuccess = ccdbApi.retrieveBlob(networkPathCCDB.value, ".", metadata, ccdbTimestamp.value, false, networkPathLocally.value);
-          headers = ccdbApi.retrieveHeaders(networkPathCCDB.value, metadata, ccdbTimestamp.value);
+          o2::ml::OnnxModelFile networkFile;
+          bool retrieveSuccess = o2::ml::OnnxSessionRegistry::instance().retrieveModel(ccdbApi, networkPathCCDB.value, metadata, ccdbTimestamp.value, networkPathLocally.value, networkFile);
           if (retrieveSuccess) {
-            network.initModel(networkPathLocally.value, enableNetworkOptimizations.value, networkSetNumThreads.value, strtoul(headers["Valid-From"].c_str(), NULL, 0), strtoul(headers["Valid-Until"].c_str(), NULL, 0));
-            std::vector<float> dummyInput(network.getNumInputNodes(), 1.);
-            network.evalModel(dummyInput); /// Init the model evaluations
+            network.initModel(networkFile.localPath, enableNetworkOptimizations.value, networkSetNumThreads.value, networkFile.validFrom, networkFile.validUntil);
+            network.warmUp(1, networkWarmUpIterations.value); // This is an initialisation and might reduce the overhead of the model
           } else {
             LOG(fatal) << "Error encountered while fetching/loading the network from CCDB! Maybe the network doesn't exist yet for this runnumber/timestamp?";
           }
@@ -227,8 +240,7 @@ struct tpcPid {
           }
           LOG(info) << "Using local file [" << networkPathLocally.value << "] for the TPC PID response correction.";
           network.initModel(networkPathLocally.value, enableNetworkOptimizations.value, networkSetNumThreads.value);
-          std::vector<float> dummyInput(network.getNumInputNodes(), 1.);
-          network.evalModel(dummyInput); // This is an initialisation and might reduce the overhead of the model
+          network.warmUp(1, networkWarmUpIterations.value); // This is an initialisation and might reduce the overhead of the model
         }
       } else {
         return;
@@ -268,12 +280,11 @@ struct tpcPid {
 
       if (bc.timestamp() < network.getValidityFrom() || bc.timestamp() > network.getValidityUntil()) { // fetches network only if the runnumbers change
         LOG(info) << "Fetching network for timestamp: " << bc.timestamp();
-        bool retrieveSuccess = ccdbApi.retrieveBlob(networkPathCCDB.value, ".", metadata, bc.timestamp(), false, networkPathLocally.value);
-        headers = ccdbApi.retrieveHeaders(networkPathCCDB.value, metadata, bc.timestamp());
+        o2::ml::OnnxModelFile networkFile;
+        bool retrieveSuccess = o2::ml::OnnxSessionRegistry::instance().retrieveModel(ccdbApi, networkPathCCDB.value, metadata, bc.timestamp(), networkPathLocally.value, networkFile);
         if (retrieveSuccess) {
-          network.initModel(networkPathLocally.value, enableNetworkOptimizations.value, networkSetNumThreads.value, strtoul(headers["Valid-From"].c_str(), NULL, 0), strtoul(headers["Valid-Until"].c_str(), NULL, 0));
-          std::vector<float> dummyInput(network.getNumInputNodes(), 1.);
-          network.evalModel(dummyInput);
+          network.initModel(networkFile.localPath, enableNetworkOptimizations.value, networkSetNumThreads.value, networkFile.validFrom, networkFile.validUntil);
+          network.warmUp(1, networkWarmUpIterations.value); // This is an initialisation and might reduce the overhead of the model
         } else {
           LOG(fatal) << "Error encountered while fetching/loading the network from CCDB! Maybe the network doesn't exist yet for this runnumber/timestamp?";
         }
@@ -283,56 +294,80 @@ struct tpcPid {
     // Defining some network parameters
     int input_dimensions = network.getNumInputNodes();
     int output_dimensions = network.getNumOutputNodes();
-    const uint64_t track_prop_size = input_dimensions * size;
     const uint64_t prediction_size = output_dimensions * size;
 
     network_prediction = std::vector<float>(prediction_size * 9); // For each mass hypotheses
     const float nNclNormalization = response->GetNClNormalization();
     float duration_network = 0;
 
-    std::vector<float> track_properties(track_prop_size);
-    uint64_t counter_track_props = 0;
-    int loop_counter = 0;
-
-    // Filling a std::vector<float> to be evaluated by the network
-    // Evaluation on single tracks brings huge overhead: Thus evaluation is done on one large vector
-    for (int i = 0; i < 9; i++) { // Loop over particle number for which network correction is used
-      for (auto const& trk : tracks) {
-        if (!trk.hasTPC()) {
+    // Hypothesis-independent inputs are computed once per track and stored column-wise
+    std::vector<float> trackInnerParam, trackTgl, trackSigned1Pt, trackMultTPC, trackNCl;
+    trackInnerParam.reserve(size);
+    trackTgl.reserve(size);
+    trackSigned1Pt.reserve(size);
+    trackMultTPC.reserve(size);
+    trackNCl.reserve(size);
+    for (auto const& trk : tracks) {
+      if (!trk.hasTPC()) {
+        continue;
+      }
+      if (skipTPCOnly) {
+        if (!trk.hasITS() && !trk.hasTRD() && !trk.hasTOF()) {
           continue;
         }
-        if (skipTPCOnly) {
-          if (!trk.hasITS() && !trk.hasTRD() && !trk.hasTOF()) {
-            continue;
-          }
-        }
-        track_properties[counter_track_props] = trk.tpcInnerParam();
-        track_properties[counter_track_props + 1] = trk.tgl();
-        track_properties[counter_track_props + 2] = trk.signed1Pt();
-        track_properties[counter_track_props + 3] = o2::track::pid_constants::sMasses[i];
-        track_properties[counter_track_props + 4] = trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).multTPC() / 11000. : 1.;
-        track_properties[counter_track_props + 5] = std::sqrt(nNclNormalization / trk.tpcNClsFound());
-        counter_track_props += input_dimensions;
       }
+      trackInnerParam.push_back(trk.tpcInnerParam());
+      trackTgl.push_back(trk.tgl());
+      trackSigned1Pt.push_back(trk.signed1Pt());
+      trackMultTPC.push_back(trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).multTPC() / 11000. : 1.);
+      trackNCl.push_back(std::sqrt(nNclNormalization / trk.tpcNClsFound()));
+    }
+    const uint64_t nTracks = trackInnerParam.size();
+    if (nTracks > size) {
+      LOG(fatal) << "Number of tracks for the network (" << nTracks << ") larger than the expected size (" << size << ")!";
+    }
 
-      auto start_network_eval = std::chrono::high_resolution_clock::now();
-      float* output_network = network.evalModel(track_properties);
-      auto stop_network_eval = std::chrono::high_resolution_clock::now();
-      duration_network += std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_eval - start_network_eval).count();
-      for (uint64_t i = 0; i < prediction_size; i += output_dimensions) {
-        for (int j = 0; j < output_dimensions; j++) {
-          network_prediction[i + j + prediction_size * loop_counter] = output_network[i + j];
-        }
+    // Filling the network input in fixed-size chunks, evaluated in batch directly into the prediction vector
+    // Evaluation on single tracks brings huge overhead: Thus evaluation is done on large chunks
+    const uint64_t chunkSize = networkBatchSize.value > 0 ? static_cast<uint64_t>(networkBatchSize.value) : nTracks;
+    std::vector<float> track_properties(std::min(chunkSize, nTracks) * input_dimensions);
+    uint64_t nEvaluatedTracks = 0;
+    for (int i = 0; i < 9; i++) { // Loop over particle number for which network correction is used
+      if (!speciesNetworkFlags[i]) {
+        continue; // predictions of species without network correction are not used
       }
+      for (uint64_t firstTrack = 0; firstTrack < nTracks; firstTrack += chunkSize) {
+        const uint64_t nChunk = std::min(chunkSize, nTracks - firstTrack);
+        uint64_t counter_track_props = 0;
+        for (uint64_t iTrack = firstTrack; iTrack < firstTrack + nChunk; iTrack++) {
+          track_properties[counter_track_props] = trackInnerParam[iTrack];
+          track_properties[counter_track_props + 1] = trackTgl[iTrack];
+          track_properties[counter_track_props + 2] = trackSigned1Pt[iTrack];
+          track_properties[counter_track_props + 3] = o2::track::pid_constants::sMasses[i];
+          track_properties[counter_track_props + 4] = trackMultTPC[iTrack];
+          track_properties[counter_track_props + 5] = trackNCl[iTrack];
+          counter_track_props += input_dimensions;
+        }
 
-      counter_track_props = 0;
-      loop_counter += 1;
+        auto start_network_eval = std::chrono::high_resolution_clock::now();
+        if (!network.evalModelBatch(track_properties.data(), nChunk, network_prediction.data() + prediction_size * i + firstTrack * output_dimensions)) {
+          LOG(fatal) << "Error during the evaluation of the TPC PID network!";
+        }
+        auto stop_network_eval = std::chrono::high_resolution_clock::now();
+        duration_network += std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_eval - start_network_eval).count();
+        nEvaluatedTracks += nChunk;
+      }
     }
     track_properties.clear();
 
     auto stop_network_total = std::chrono::high_resolution_clock::now();
     LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval ONNX): " << duration_network / (size * 9) << "ns ; Total time (eval ONNX): " << duration_network / 1000000000 << " s";
     LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / (size * 9) << "ns ; Total time (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / 1000000000 << " s";
+    if (enableNetworkMonitoring && nEvaluatedTracks > 0) {
+      const float durationTotal = std::chrono::duration<float>(stop_network_total - start_network_total).count();
+      histos.fill(HIST("hNetworkTracksPerSecond"), nEvaluatedTracks / durationTotal);
+      histos.fill(HIST("hNetworkEvalTracksPerSecond"), nEvaluatedTracks / (duration_network / 1000000000));
+    }
 
     return network_prediction;
   }
@@ -430,7 +465,9 @@ struct tpcPid {
               LOGF(fatal, "Network output-dimensions incompatible!");
             }
           } else {
-            aod::pidutils::packInTable<aod::pidtpc_tiny::binning>(response->GetNumberOfSigma(collisions.iteratorAt(trk.collisionId()), trk, pid), table);
+            // with a collision, the expected signal and resolution are the ones of GetNumberOfSigma
+            const float nSigma = trk.has_collision() ? (trk.tpcSignal() - expSignal) / static_cast<float>(expSigma) : response->GetNumberOfSigma(collisions.iteratorAt(trk.collisionId()), trk, pid);
+            aod::pidutils::packInTable<aod::pidtpc_tiny::binning>(nSigma, table);
           }
         }
       };
@@ -434,8 +434,9 @@ struct tpcPidFull {
               LOGF(fatal, "Network output-dimensions incompatible!");
             }
           } else {
+            // with a collision, the expected signal and resolution are the ones of GetNumberOfSigma
             table(expSigma,
-                  response->GetNumberOfSigma(collisions.iteratorAt(trk.collisionId()), trk, pid));
+                  trk.has_collision() ? (trk.tpcSignal() - expSignal) / static_cast<float>(expSigma) : response->GetNumberOfSigma(collisions.iteratorAt(trk.collisionId()), trk, pid));
           }
         }
       };
@@ -9,6 +9,12 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <array>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
 #include "Framework/ConfigParamSpec.h"
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
@@ -99,6 +105,15 @@ struct caloClusterProducerTask {
     int mEnd[kCpvCells];   // Z (theta) track coordinate in PHOS plane
   };
 
+  // CPV clusters and track impact points on the matching grid, kept between TFs to reuse the memory
+  std::vector<std::pair<float, float>> cpvMatchPoints[kCpvCells];
+  std::vector<trackTrigRec> cpvNMatchPoints;
+  std::vector<trackMatch> trackMatchPoints[kCpvCells]; // tracks hit in grid/cell in PHOS
+  std::vector<trackTrigRec> trackNMatchPoints;
+  std::map<int64_t, int> cpvTRMap;   // BC -> entry in cpvNMatchPoints
+  std::map<int64_t, int> trackTRMap; // BC -> entry in trackNMatchPoints
+  std::set<int64_t> phosTRBCs;       // BCs with PHOS clusters
+
   void init(o2::framework::InitContext&)
   {
     ccdb->setURL(o2::base::NameConf::getCCDBServer());
@@ -214,9 +229,11 @@ struct caloClusterProducerTask {
                                   outputPHOSClusters, outputCluElements, outputPHOSClusterTrigRecs, dummyMC);
 
     // Find  CPV clusters corresponding to PHOS trigger records
-    std::vector<std::pair<float, float>> cpvMatchPoints[kCpvCells];
+    for (auto& points : cpvMatchPoints) {
+      points.clear();
+    }
     // Number of entries in each cell per TrigRecord
-    std::vector<trackTrigRec> cpvNMatchPoints;
+    cpvNMatchPoints.clear();
     cpvNMatchPoints.reserve(outputPHOSClusterTrigRecs.size());
     int64_t curBC = -1;
     if (cpvs.begin() != cpvs.end()) {
@@ -242,7 +259,7 @@ struct caloClusterProducerTask {
         }
       }
       // anyway add coordinates
-      if (cpvclu.amplitude() < static_cast<std::vector<double>>(cpvMinE)[static_cast<int>(cpvclu.moduleNumber()) - 2]) {
+      if (cpvclu.amplitude() < cpvMinE.value[static_cast<int>(cpvclu.moduleNumber()) - 2]) {
         continue;
       }
       int index = CpvMatchIndex(cpvclu.moduleNumber(), cpvclu.posX(), cpvclu.posZ());
@@ -253,6 +270,7 @@ struct caloClusterProducerTask {
         cpvNMatchPoints.back().mEnd[i] = cpvMatchPoints[i].size();
       }
     }
+    indexTrigRecs(cpvNMatchPoints, cpvTRMap);
 
     // Fill output
     for (auto& cluTR : outputPHOSClusterTrigRecs) {
@@ -270,16 +288,9 @@ struct caloClusterProducerTask {
         colId = coliter->second;
       }
 
-      bool cpvExist = false;
       // find cpvTR for this BC
-      auto cpvPoints = cpvNMatchPoints.begin();
-      while (cpvPoints != cpvNMatchPoints.end()) {
-        if (cpvPoints->mTR == cluTR.getBCData().toLong()) {
-          cpvExist = true;
-          break;
-        }
-        cpvPoints++;
-      }
+      auto cpvPoints = findTrigRec(cpvNMatchPoints, cpvTRMap, cluTR.getBCData().toLong());
+      bool cpvExist = cpvPoints != cpvNMatchPoints.end();
 
       for (int i = firstClusterInEvent; i < lastClusterInEvent; i++) {
         o2::phos::Cluster& clu = outputPHOSClusters[i];
@@ -311,42 +322,17 @@ struct caloClusterProducerTask {
         mom.SetMag(e);
 
         float cpvdist = 99.;
-        const float cellSizeX = 2 * cpvMaxX / kCpvX;
-        const float cellSizeZ = 2 * cpvMaxZ / kCpvZ;
         // look 9 CPV regions around PHOS cluster
 
         if (mod >= 2 && cpvExist) { // CPV exist in mods 2,3,4
           int phosIndex = CpvMatchIndex(mod, posX, posZ);
-          std::vector<int> regions;
-          regions.push_back(phosIndex);
-          if (posX > -cpvMaxX + cellSizeX) {
-            if (posZ > -cpvMaxZ + cellSizeZ) { // bottom left
-              regions.push_back(phosIndex - kCpvZ - 1);
-            }
-            regions.push_back(phosIndex - kCpvZ);
-            if (posZ < cpvMaxZ - cellSizeZ) { // top left
-              regions.push_back(phosIndex - kCpvZ + 1);
-            }
-          }
-          if (posZ > -cpvMaxZ + cellSizeZ) { // bottom
-            regions.push_back(phosIndex - 1);
-          }
-          if (posZ < cpvMaxZ - cellSizeZ) { // top
-            regions.push_back(phosIndex + 1);
-          }
-          if (posX < cpvMaxX - cellSizeX) {
-            if (posZ > -cpvMaxZ + cellSizeZ) { // bottom right
-              regions.push_back(phosIndex + kCpvZ - 1);
-            }
-            regions.push_back(phosIndex + kCpvZ);
-            if (posZ < cpvMaxZ - cellSizeZ) { // top right
-              regions.push_back(phosIndex + kCpvZ + 1);
-            }
-          }
+          std::array<int, 9> regions;
+          const int nRegions = CpvMatchRegions(phosIndex, posX, posZ, regions);
           float sigmaX = 1. / TMath::Min(5.2, 1.111 + 0.56 * TMath::Exp(-0.031 * e * e) + 4.8 / TMath::Power(e + 0.61, 3)); // inverse sigma X
           float sigmaZ = 1. / TMath::Min(3.3, 1.12 + 0.35 * TMath::Exp(-0.032 * e * e) + 0.75 / TMath::Power(e + 0.24, 3)); // inverse sigma Z
 
-          for (int indx : regions) {
+          for (int iRegion = 0; iRegion < nRegions; iRegion++) {
+            const int indx = regions[iRegion];
             if (indx >= 0 && indx < kCpvCells) {
               for (int ii = cpvPoints->mStart[indx]; ii < cpvPoints->mEnd[indx]; ii++) {
                 auto p = cpvMatchPoints[indx][ii];
@@ -530,9 +516,11 @@ struct caloClusterProducerTask {
                                   outputPHOSClusters, outputCluElements, outputPHOSClusterTrigRecs, outputTruthCont);
 
     // Find  CPV clusters corresponding to PHOS trigger records
-    std::vector<std::pair<float, float>> cpvMatchPoints[kCpvCells];
+    for (auto& points : cpvMatchPoints) {
+      points.clear();
+    }
     // Number of entries in each cell per TrigRecord
-    std::vector<trackTrigRec> cpvNMatchPoints;
+    cpvNMatchPoints.clear();
     cpvNMatchPoints.reserve(outputPHOSClusterTrigRecs.size());
     int64_t curBC = -1;
     if (cpvs.begin() != cpvs.end()) {
@@ -558,7 +546,7 @@ struct caloClusterProducerTask {
         }
       }
       // anyway add coordinates
-      if (cpvclu.amplitude() < static_cast<std::vector<double>>(cpvMinE)[static_cast<int>(cpvclu.moduleNumber()) - 2]) {
+      if (cpvclu.amplitude() < cpvMinE.value[static_cast<int>(cpvclu.moduleNumber()) - 2]) {
         continue;
       }
       int index = CpvMatchIndex(cpvclu.moduleNumber(), cpvclu.posX(), cpvclu.posZ());
@@ -569,6 +557,7 @@ struct caloClusterProducerTask {
         cpvNMatchPoints.back().mEnd[i] = cpvMatchPoints[i].size();
       }
     }
+    indexTrigRecs(cpvNMatchPoints, cpvTRMap);
 
     // Fill output
     for (auto& cluTR : outputPHOSClusterTrigRecs) {
@@ -586,16 +575,9 @@ struct caloClusterProducerTask {
         colId = coliter->second;
       }
 
-      bool cpvExist = false;
       // find cpvTR for this BC
-      auto cpvPoints = cpvNMatchPoints.begin();
-      while (cpvPoints != cpvNMatchPoints.end()) {
-        if (cpvPoints->mTR == cluTR.getBCData().toLong()) {
-          cpvExist = true;
-          break;
-        }
-        cpvPoints++;
-      }
+      auto cpvPoints = findTrigRec(cpvNMatchPoints, cpvTRMap, cluTR.getBCData().toLong());
+      bool cpvExist = cpvPoints != cpvNMatchPoints.end();
 
       for (int i = firstClusterInEvent; i < lastClusterInEvent; i++) {
         o2::phos::Cluster& clu = outputPHOSClusters[i];
@@ -627,42 +609,17 @@ struct caloClusterProducerTask {
         mom.SetMag(e);
 
         float cpvdist = 99.;
-        const float cellSizeX = 2 * cpvMaxX / kCpvX;
-        const float cellSizeZ = 2 * cpvMaxZ / kCpvZ;
         // look 9 CPV regions around PHOS cluster
 
         if (mod >= 2 && cpvExist) { // CPV exist in mods 2,3,4
           int phosIndex = CpvMatchIndex(mod, posX, posZ);
-          std::vector<int> regions;
-          regions.push_back(phosIndex);
-          if (posX > -cpvMaxX + cellSizeX) {
-            if (posZ > -cpvMaxZ + cellSizeZ) { // bottom left
-              regions.push_back(phosIndex - kCpvZ - 1);
-            }
-            regions.push_back(phosIndex - kCpvZ);
-            if (posZ < cpvMaxZ - cellSizeZ) { // top left
-              regions.push_back(phosIndex - kCpvZ + 1);
-            }
-          }
-          if (posZ > -cpvMaxZ + cellSizeZ) { // bottom
-            regions.push_back(phosIndex - 1);
-          }
-          if (posZ < cpvMaxZ - cellSizeZ) { // top
-            regions.push_back(phosIndex + 1);
-          }
-          if (posX < cpvMaxX - cellSizeX) {
-            if (posZ > -cpvMaxZ + cellSizeZ) { // bottom right
-              regions.push_back(phosIndex + kCpvZ - 1);
-            }
-            regions.push_back(phosIndex + kCpvZ);
-            if (posZ < cpvMaxZ - cellSizeZ) { // top right
-              regions.push_back(phosIndex + kCpvZ + 1);
-            }
-          }
+          std::array<int, 9> regions;
+          const int nRegions = CpvMatchRegions(phosIndex, posX, posZ, regions);
           float sigmaX = 1. / TMath::Min(5.2, 1.111 + 0.56 * TMath::Exp(-0.031 * e * e) + 4.8 / TMath::Power(e + 0.61, 3)); // inverse sigma X
           float sigmaZ = 1. / TMath::Min(3.3, 1.12 + 0.35 * TMath::Exp(-0.032 * e * e) + 0.75 / TMath::Power(e + 0.24, 3)); // inverse sigma Z
 
-          for (int indx : regions) {
+          for (int iRegion = 0; iRegion < nRegions; iRegion++) {
+            const int indx = regions[iRegion];
             if (indx >= 0 && indx < kCpvCells) {
               for (int ii = cpvPoints->mStart[indx]; ii < cpvPoints->mEnd[indx]; ii++) {
                 auto p = cpvMatchPoints[indx][ii];
@@ -850,9 +807,11 @@ struct caloClusterProducerTask {
                                   outputPHOSClusters, outputCluElements, outputPHOSClusterTrigRecs, dummyMC);
 
     // Find  CPV clusters corresponding to PHOS trigger records
-    std::vector<std::pair<float, float>> cpvMatchPoints[kCpvCells];
+    for (auto& points : cpvMatchPoints) {
+      points.clear();
+    }
     // Number of entries in each cell per TrigRecord
-    std::vector<trackTrigRec> cpvNMatchPoints;
+    cpvNMatchPoints.clear();
     cpvNMatchPoints.reserve(outputPHOSClusterTrigRecs.size());
 
     int64_t curBC = -1;
@@ -878,7 +837,7 @@ struct caloClusterProducerTask {
           cpvNMatchPoints.back().mStart[i] = cpvMatchPoints[i].size();
         }
       }
-      if (cpvclu.amplitude() < static_cast<std::vector<double>>(cpvMinE)[static_cast<int>(cpvclu.moduleNumber()) - 2]) {
+      if (cpvclu.amplitude() < cpvMinE.value[static_cast<int>(cpvclu.moduleNumber()) - 2]) {
         continue;
       }
       int index = CpvMatchIndex(cpvclu.moduleNumber(), cpvclu.posX(), cpvclu.posZ());
@@ -889,10 +848,17 @@ struct caloClusterProducerTask {
         cpvNMatchPoints.back().mEnd[i] = cpvMatchPoints[i].size();
       }
     }
+    indexTrigRecs(cpvNMatchPoints, cpvTRMap);
     // same for tracks
-    std::vector<trackMatch> trackMatchPoints[kCpvCells]; // tracks hit in grid/cell in PHOS
+    for (auto& points : trackMatchPoints) {
+      points.clear();
+    }
     // Number of entries in each cell per TrigRecord
-    std::vector<trackTrigRec> trackNMatchPoints;
+    trackNMatchPoints.clear();
+    phosTRBCs.clear();
+    for (const auto& cluTR : outputPHOSClusterTrigRecs) {
+      phosTRBCs.insert(cluTR.getBCData().toLong());
+    }
     trackNMatchPoints.reserve(outputPHOSClusterTrigRecs.size());
 
     curBC = 0;
@@ -902,13 +868,7 @@ struct caloClusterProducerTask {
         break;
       }
     }
-    bool keepBC = false;
-    for (auto& cluTR : outputPHOSClusterTrigRecs) {
-      if (cluTR.getBCData().toLong() == curBC) {
-        keepBC = true;
-        break;
-      }
-    }
+    bool keepBC = phosTRBCs.count(curBC) > 0;
     if (keepBC) {
       trackNMatchPoints.emplace_back();
       trackNMatchPoints.back().mTR = curBC;
@@ -929,13 +889,7 @@ struct caloClusterProducerTask {
           }
           curBC = track.collision().bc_as<aod::BCsWithTimestamps>().globalBC();
         }
-        keepBC = false;
-        for (auto& cluTR : outputPHOSClusterTrigRecs) {
-          if (cluTR.getBCData().toLong() == curBC) {
-            keepBC = true;
-            break;
-          }
-        }
+        keepBC = phosTRBCs.count(curBC) > 0;
         if (!keepBC) {
           continue;
         }
@@ -963,6 +917,7 @@ struct caloClusterProducerTask {
         trackNMatchPoints.back().mEnd[i] = trackMatchPoints[i].size();
       }
     }
+    indexTrigRecs(trackNMatchPoints, trackTRMap);
 
     // Fill output tables
     for (auto& cluTR : outputPHOSClusterTrigRecs) {
@@ -980,25 +935,12 @@ struct caloClusterProducerTask {
         colId = coliter->second;
       }
 
-      bool cpvExist = false;
       // find cpvTR for this BC
-      auto cpvPoints = cpvNMatchPoints.begin();
-      while (cpvPoints != cpvNMatchPoints.end()) {
-        if (cpvPoints->mTR == cluTR.getBCData().toLong()) {
-          cpvExist = true;
-          break;
-        }
-        cpvPoints++;
-      }
+      auto cpvPoints = findTrigRec(cpvNMatchPoints, cpvTRMap, cluTR.getBCData().toLong());
+      bool cpvExist = cpvPoints != cpvNMatchPoints.end();
 
-      // find cpvTR for this BC
-      auto trackPoints = trackNMatchPoints.begin();
-      while (trackPoints != trackNMatchPoints.end()) {
-        if (trackPoints->mTR == cluTR.getBCData().toLong()) {
-          break;
-        }
-        trackPoints++;
-      }
+      // find trackTR for this BC
+      auto trackPoints = findTrigRec(trackNMatchPoints, trackTRMap, cluTR.getBCData().toLong());
 
       for (int i = firstClusterInEvent; i < lastClusterInEvent; i++) {
         o2::phos::Cluster& clu = outputPHOSClusters[i];
@@ -1030,43 +972,18 @@ struct caloClusterProducerTask {
         mom.SetMag(e);
 
         // CPV and track match
-        const float cellSizeX = 2 * cpvMaxX / kCpvX;
-        const float cellSizeZ = 2 * cpvMaxZ / kCpvZ;
         // look 9 CPV regions around PHOS cluster
         int phosIndex = CpvMatchIndex(mod, posX, posZ);
-        std::vector<int> regions;
-        regions.push_back(phosIndex);
-        if (posX > -cpvMaxX + cellSizeX) {
-          if (posZ > -cpvMaxZ + cellSizeZ) { // bottom left
-            regions.push_back(phosIndex - kCpvZ - 1);
-          }
-          regions.push_back(phosIndex - kCpvZ);
-          if (posZ < cpvMaxZ - cellSizeZ) { // top left
-            regions.push_back(phosIndex - kCpvZ + 1);
-          }
-        }
-        if (posZ > -cpvMaxZ + cellSizeZ) { // bottom
-          regions.push_back(phosIndex - 1);
-        }
-        if (posZ < cpvMaxZ - cellSizeZ) { // top
-          regions.push_back(phosIndex + 1);
-        }
-        if (posX < cpvMaxX - cellSizeX) {
-          if (posZ > -cpvMaxZ + cellSizeZ) { // bottom right
-            regions.push_back(phosIndex + kCpvZ - 1);
-          }
-          regions.push_back(phosIndex + kCpvZ);
-          if (posZ < cpvMaxZ - cellSizeZ) { // top right
-            regions.push_back(phosIndex + kCpvZ + 1);
-          }
-        }
+        std::array<int, 9> regions;
+        const int nRegions = CpvMatchRegions(phosIndex, posX, posZ, regions);
         float sigmaX = 1. / TMath::Min(5.2, 1.111 + 0.56 * TMath::Exp(-0.031 * e * e) + 4.8 / TMath::Power(e + 0.61, 3)); // inverse sigma X
         float sigmaZ = 1. / TMath::Min(3.3, 1.12 + 0.35 * TMath::Exp(-0.032 * e * e) + 0.75 / TMath::Power(e + 0.24, 3)); // inverse sigma Z
         float cpvdist = 99., trackdist = 99.;
         // float cpvDx = 0., cpvDz = 0.;
         float trackDx = 9999., trackDz = 9999.;
         int trackindex = -1;
-        for (int indx : regions) {
+        for (int iRegion = 0; iRegion < nRegions; iRegion++) {
+          const int indx = regions[iRegion];
           if (cpvPoints != cpvNMatchPoints.end()) {
             if (indx >= 0 && indx < kCpvCells) {
               for (int ii = cpvPoints->mStart[indx]; ii < cpvPoints->mEnd[indx]; ii++) {
@@ -1281,9 +1198,11 @@ struct caloClusterProducerTask {
                                   outputPHOSClusters, outputCluElements, outputPHOSClusterTrigRecs, outputTruthCont);
 
     // Find  CPV clusters corresponding to PHOS trigger records
-    std::vector<std::pair<float, float>> cpvMatchPoints[kCpvCells];
+    for (auto& points : cpvMatchPoints) {
+      points.clear();
+    }
     // Number of entries in each cell per TrigRecord
-    std::vector<trackTrigRec> cpvNMatchPoints;
+    cpvNMatchPoints.clear();
     cpvNMatchPoints.reserve(outputPHOSClusterTrigRecs.size());
 
     int64_t curBC = -1;
@@ -1309,7 +1228,7 @@ struct caloClusterProducerTask {
           cpvNMatchPoints.back().mStart[i] = cpvMatchPoints[i].size();
         }
       }
-      if (cpvclu.amplitude() < static_cast<std::vector<double>>(cpvMinE)[static_cast<int>(cpvclu.moduleNumber()) - 2]) {
+      if (cpvclu.amplitude() < cpvMinE.value[static_cast<int>(cpvclu.moduleNumber()) - 2]) {
         continue;
       }
       int index = CpvMatchIndex(cpvclu.moduleNumber(), cpvclu.posX(), cpvclu.posZ());
@@ -1320,10 +1239,17 @@ struct caloClusterProducerTask {
         cpvNMatchPoints.back().mEnd[i] = cpvMatchPoints[i].size();
       }
     }
+    indexTrigRecs(cpvNMatchPoints, cpvTRMap);
     // same for tracks
-    std::vector<trackMatch> trackMatchPoints[kCpvCells]; // tracks hit in grid/cell in PHOS
+    for (auto& points : trackMatchPoints) {
+      points.clear();
+    }
     // Number of entries in each cell per TrigRecord
-    std::vector<trackTrigRec> trackNMatchPoints;
+    trackNMatchPoints.clear();
+    phosTRBCs.clear();
+    for (const auto& cluTR : outputPHOSClusterTrigRecs) {
+      phosTRBCs.insert(cluTR.getBCData().toLong());
+    }
     trackNMatchPoints.reserve(outputPHOSClusterTrigRecs.size());
 
     curBC = -1;
@@ -1333,13 +1259,7 @@ struct caloClusterProducerTask {
         break;
       }
     }
-    bool keepBC = false;
-    for (auto& cluTR : outputPHOSClusterTrigRecs) {
-      if (cluTR.getBCData().toLong() == curBC) {
-        keepBC = true;
-        break;
-      }
-    }
+    bool keepBC = phosTRBCs.count(curBC) > 0;
     if (keepBC) {
       trackNMatchPoints.emplace_back();
       trackNMatchPoints.back().mTR = curBC;
@@ -1360,13 +1280,7 @@ struct caloClusterProducerTask {
           }
           curBC = track.collision().bc_as<aod::BCsWithTimestamps>().globalBC();
         }
-        keepBC = false;
-        for (auto& cluTR : outputPHOSClusterTrigRecs) {
-          if (cluTR.getBCData().toLong() == curBC) {
-            keepBC = true;
-            break;
-          }
-        }
+        keepBC = phosTRBCs.count(curBC) > 0;
         if (!keepBC) {
           continue;
         }
@@ -1394,6 +1308,7 @@ struct caloClusterProducerTask {
         trackNMatchPoints.back().mEnd[i] = trackMatchPoints[i].size();
       }
     }
+    indexTrigRecs(trackNMatchPoints, trackTRMap);
 
     // Fill output tables
     for (auto& cluTR : outputPHOSClusterTrigRecs) {
@@ -1411,24 +1326,11 @@ struct caloClusterProducerTask {
         colId = coliter->second;
       }
 
-      bool cpvExist = false;
-      // find cpvTR for this BC
-      auto cpvPoints = cpvNMatchPoints.begin();
-      while (cpvPoints != cpvNMatchPoints.end()) {
-        if (cpvPoints->mTR == cluTR.getBCData().toLong()) {
-          cpvExist = true;
-          break;
-        }
-        cpvPoints++;
-      }
       // find cpvTR for this BC
-      auto trackPoints = trackNMatchPoints.begin();
-      while (trackPoints != trackNMatchPoints.end()) {
-        if (trackPoints->mTR == cluTR.getBCData().toLong()) {
-          break;
-        }
-        trackPoints++;
-      }
+      auto cpvPoints = findTrigRec(cpvNMatchPoints, cpvTRMap, cluTR.getBCData().toLong());
+      bool cpvExist = cpvPoints != cpvNMatchPoints.end();
+      // find trackTR for this BC
+      auto trackPoints = findTrigRec(trackNMatchPoints, trackTRMap, cluTR.getBCData().toLong());
 
       for (int i = firstClusterInEvent; i < lastClusterInEvent; i++) {
         o2::phos::Cluster& clu = outputPHOSClusters[i];
@@ -1459,43 +1361,18 @@ struct caloClusterProducerTask {
 
         mom.SetMag(e);
         // CPV and track match
-        const float cellSizeX = 2 * cpvMaxX / kCpvX;
-        const float cellSizeZ = 2 * cpvMaxZ / kCpvZ;
         // look 9 CPV regions around PHOS cluster
         int phosIndex = CpvMatchIndex(mod, posX, posZ);
-        std::vector<int> regions;
-        regions.push_back(phosIndex);
-        if (posX > -cpvMaxX + cellSizeX) {
-          if (posZ > -cpvMaxZ + cellSizeZ) { // bottom left
-            regions.push_back(phosIndex - kCpvZ - 1);
-          }
-          regions.push_back(phosIndex - kCpvZ);
-          if (posZ < cpvMaxZ - cellSizeZ) { // top left
-            regions.push_back(phosIndex - kCpvZ + 1);
-          }
-        }
-        if (posZ > -cpvMaxZ + cellSizeZ) { // bottom
-          regions.push_back(phosIndex - 1);
-        }
-        if (posZ < cpvMaxZ - cellSizeZ) { // top
-          regions.push_back(phosIndex + 1);
-        }
-        if (posX < cpvMaxX - cellSizeX) {
-          if (posZ > -cpvMaxZ + cellSizeZ) { // bottom right
-            regions.push_back(phosIndex + kCpvZ - 1);
-          }
-          regions.push_back(phosIndex + kCpvZ);
-          if (posZ < cpvMaxZ - cellSizeZ) { // top right
-            regions.push_back(phosIndex + kCpvZ + 1);
-          }
-        }
+        std::array<int, 9> regions;
+        const int nRegions = CpvMatchRegions(phosIndex, posX, posZ, regions);
         float sigmaX = 1. / TMath::Min(5.2, 1.111 + 0.56 * TMath::Exp(-0.031 * e * e) + 4.8 / TMath::Power(e + 0.61, 3)); // inverse sigma X
         float sigmaZ = 1. / TMath::Min(3.3, 1.12 + 0.35 * TMath::Exp(-0.032 * e * e) + 0.75 / TMath::Power(e + 0.24, 3)); // inverse sigma Z
         float cpvdist = 99., trackdist = 99.;
         // float cpvDx = 0., cpvDz = 0.;
         float trackDx = 9999., trackDz = 9999.;
         int trackindex = -1;
-        for (int indx : regions) {
+        for (int iRegion = 0; iRegion < nRegions; iRegion++) {
+          const int indx = regions[iRegion];
           if (cpvPoints != cpvNMatchPoints.end()) {
             if (indx >= 0 && indx < kCpvCells) {
               for (int ii = cpvPoints->mStart[indx]; ii < cpvPoints->mEnd[indx]; ii++) {
@@ -1583,6 +1460,58 @@ struct caloClusterProducerTask {
 
   PROCESS_SWITCH(caloClusterProducerTask, processFullMC, "Process MC with track matching", false);
 
+  // grid cells around a PHOS cluster in which CPV clusters and tracks are looked for, returns the number of cells
+  int CpvMatchRegions(int phosIndex, float posX, float posZ, std::array<int, 9>& regions)
+  {
+    const float cellSizeX = 2 * cpvMaxX / kCpvX;
+    const float cellSizeZ = 2 * cpvMaxZ / kCpvZ;
+    int nRegions = 0;
+    regions[nRegions++] = phosIndex;
+    if (posX > -cpvMaxX + cellSizeX) {
+      if (posZ > -cpvMaxZ + cellSizeZ) { // bottom left
+        regions[nRegions++] = phosIndex - kCpvZ - 1;
+      }
+      regions[nRegions++] = phosIndex - kCpvZ;
+      if (posZ < cpvMaxZ - cellSizeZ) { // top left
+        regions[nRegions++] = phosIndex - kCpvZ + 1;
+      }
+    }
+    if (posZ > -cpvMaxZ + cellSizeZ) { // bottom
+      regions[nRegions++] = phosIndex - 1;
+    }
+    if (posZ < cpvMaxZ - cellSizeZ) { // top
+      regions[nRegions++] = phosIndex + 1;
+    }
+    if (posX < cpvMaxX - cellSizeX) {
+      if (posZ > -cpvMaxZ + cellSizeZ) { // bottom right
+        regions[nRegions++] = phosIndex + kCpvZ - 1;
+      }
+      regions[nRegions++] = phosIndex + kCpvZ;
+      if (posZ < cpvMaxZ - cellSizeZ) { // top right
+        regions[nRegions++] = phosIndex + kCpvZ + 1;
+      }
+    }
+    return nRegions;
+  }
+
+  // fills the BC -> entry map of the trigger records, the first entry is kept if a BC appears twice
+  void indexTrigRecs(const std::vector<trackTrigRec>& trigRecs, std::map<int64_t, int>& trMap)
+  {
+    trMap.clear();
+    for (size_t i = 0; i < trigRecs.size(); i++) {
+      trMap.emplace(trigRecs[i].mTR, i);
+    }
+  }
+
+  std::vector<trackTrigRec>::iterator findTrigRec(std::vector<trackTrigRec>& trigRecs, const std::map<int64_t, int>& trMap, int64_t bc)
+  {
+    auto tr = trMap.find(bc);
+    if (tr == trMap.end()) {
+      return trigRecs.end();
+    }
+    return trigRecs.begin() + tr->second;
+  }
+
   int CpvMatchIndex(int16_t module, float x, float z)
   {
     // calculate cell index in grid over PHOS detector
@@ -12,6 +12,9 @@
 /// \file centrality.cxx
 /// \brief Task to produce the centrality tables associated to each of the required centrality estimators
 
+#include <algorithm>
+#include <string>
+#include <vector>
 #include <CCDB/BasicCCDBManager.h>
 #include <TH1F.h>
 #include <TFormula.h>
@@ -120,10 +123,48 @@ struct CentralityTable {
     TH1* mhVtxAmpCorr = nullptr;
     TH1* mhMultSelCalib = nullptr;
   } Run2CL1Info;
+  /// Flat copy of a percentile calibration histogram, the lookup gives the same bin as TAxis::FindFixBin
+  struct percentileLookup {
+    int mNbins = 0;
+    double mXmin = 0.;
+    double mXmax = 0.;
+    std::vector<double> mEdges;    // Bin edges, empty for fixed width bins
+    std::vector<double> mContents; // Bin contents including underflow and overflow
+    void build(const TH1* h)
+    {
+      const TAxis* axis = h->GetXaxis();
+      mNbins = axis->GetNbins();
+      mXmin = axis->GetXmin();
+      mXmax = axis->GetXmax();
+      mEdges.clear();
+      if (axis->GetXbins()->GetSize() > 0) {
+        mEdges.assign(axis->GetXbins()->GetArray(), axis->GetXbins()->GetArray() + axis->GetXbins()->GetSize());
+      }
+      mContents.resize(mNbins + 2);
+      for (int i = 0; i < mNbins + 2; i++) {
+        mContents[i] = h->GetBinContent(i);
+      }
+    }
+    double eval(double x) const
+    {
+      int bin = 0;
+      if (x < mXmin) {
+        bin = 0;
+      } else if (!(x < mXmax)) {
+        bin = mNbins + 1;
+      } else if (mEdges.empty()) {
+        bin = 1 + static_cast<int>(mNbins * (x - mXmin) / (mXmax - mXmin));
+      } else {
+        bin = std::upper_bound(mEdges.begin(), mEdges.end(), x) - mEdges.begin();
+      }
+      return mContents[bin];
+    }
+  };
   struct calibrationInfo {
     std::string name = "";
     bool mCalibrationStored = false;
     TH1* mhMultSelCalib = nullptr;
+    percentileLookup mPercentileLookup; // Copy of mhMultSelCalib used in the collision loop
     float mMCScalePars[6] = {0.0};
     TFormula* mMCScale = nullptr;
     explicit calibrationInfo(std::string name)
@@ -486,6 +527,7 @@ struct CentralityTable {
               }
               estimator.mCalibrationStored = true;
               estimator.isSane();
+              estimator.mPercentileLookup.build(estimator.mhMultSelCalib);
             } else {
               LOGF(error, "Calibration information from %s for run %d not available", estimator.name.c_str(), bc.runNumber());
             }
@@ -548,7 +590,7 @@ struct CentralityTable {
             scaledMultiplicity = scaleMC(multiplicity, estimator.mMCScalePars);
             LOGF(debug, "Unscaled %s multiplicity: %f, scaled %s multiplicity: %f", estimator.name.c_str(), multiplicity, estimator.name.c_str(), scaledMultiplicity);
           }
-          percentile = estimator.mhMultSelCalib->GetBinContent(estimator.mhMultSelCalib->FindFixBin(scaledMultiplicity));
+          percentile = estimator.mPercentileLookup.eval(scaledMultiplicity);
           if (assignOutOfRange)
             percentile = 100.5f;
         }
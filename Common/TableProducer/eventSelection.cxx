@@ -9,6 +9,14 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
 #include "Framework/ConfigParamSpec.h"
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
@@ -36,6 +44,79 @@ using BCsWithBcSelsRun2 = soa::Join<aod::BCs, aod::Timestamps, aod::BcSels, aod:
 using BCsWithBcSelsRun3 = soa::Join<aod::BCs, aod::Timestamps, aod::BcSels>;
 using FullTracksIU = soa::Join<aod::TracksIU, aod::TracksExtra>;
 
+// BCs of a time frame sorted by global BC, for the searches of a given BC or of the closest BC with a binary search
+// Lookups give the same BCs as a std::map filled with the same entries (for duplicated global BCs, the last entry is kept)
+class SortedGlobalBCs
+{
+ public:
+  void clear()
+  {
+    mGlobalBCs.clear();
+    mBcIds.clear();
+  }
+  void reserve(std::size_t n)
+  {
+    mGlobalBCs.reserve(n);
+    mBcIds.reserve(n);
+  }
+  void add(int64_t globalBC, int32_t bcId)
+  {
+    mGlobalBCs.push_back(globalBC);
+    mBcIds.push_back(bcId);
+  }
+  /// To be called after the last add, sorts the entries if they were not added in increasing order of global BC
+  void sort()
+  {
+    if (std::adjacent_find(mGlobalBCs.begin(), mGlobalBCs.end(), std::greater_equal<int64_t>()) == mGlobalBCs.end()) {
+      return; // already strictly increasing, as the BC table
+    }
+    std::vector<std::size_t> order(mGlobalBCs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) { return mGlobalBCs[a] < mGlobalBCs[b]; });
+    std::vector<int64_t> globalBCs;
+    std::vector<int32_t> bcIds;
+    globalBCs.reserve(order.size());
+    bcIds.reserve(order.size());
+    for (const auto i : order) {
+      if (!globalBCs.empty() && globalBCs.back() == mGlobalBCs[i]) {
+        bcIds.back() = mBcIds[i];
+        continue;
+      }
+      globalBCs.push_back(mGlobalBCs[i]);
+      bcIds.push_back(mBcIds[i]);
+    }
+    mGlobalBCs.swap(globalBCs);
+    mBcIds.swap(bcIds);
+  }
+
+  bool empty() const { return mGlobalBCs.empty(); }
+  std::size_t size() const { return mGlobalBCs.size(); }
+
+  /// \return index of the BC with a given global BC, 0 if not found
+  int32_t find(int64_t globalBC) const
+  {
+    auto it = std::lower_bound(mGlobalBCs.begin(), mGlobalBCs.end(), globalBC);
+    return (it != mGlobalBCs.end() && *it == globalBC) ? mBcIds[it - mGlobalBCs.begin()] : 0;
+  }
+
+  /// \return index of the BC closest to a given global BC, the earlier one for two BCs at the same distance
+  int32_t findClosest(int64_t globalBC) const
+  {
+    const std::size_t i = std::lower_bound(mGlobalBCs.begin(), mGlobalBCs.end(), globalBC) - mGlobalBCs.begin();
+    if (i == mGlobalBCs.size()) {
+      return mBcIds.back();
+    }
+    if (i == 0) {
+      return mBcIds.front();
+    }
+    return (mGlobalBCs[i] - globalBC <= globalBC - mGlobalBCs[i - 1]) ? mBcIds[i] : mBcIds[i - 1];
+  }
+
+ private:
+  std::vector<int64_t> mGlobalBCs;
+  std::vector<int32_t> mBcIds;
+};
+
 struct BcSelectionTask {
   Produces<aod::BcSels> bcsel;
   Service<o2::ccdb::BasicCCDBManager> ccdb;
@@ -54,6 +135,17 @@ struct BcSelectionTask {
   int mTimeFrameStartBorderMargin = 300; // default value
   int mTimeFrameEndBorderMargin = 4000;  // default value
 
+  // run-scoped calibration context, refreshed only when the run number changes
+  int mContextRunNumber = -1;                                       // run number of the objects below
+  EventSelectionParams* mPar = nullptr;                             // event selection parameters
+  o2::itsmft::DPLAlpideParam<0> const* mAlpidePar = nullptr;        // ITS parameters (Run 3 only)
+  std::array<uint32_t, 64> mAliasMaskPerClass{};                    // fired aliases for each bit of the trigger mask
+  std::array<uint32_t, 64> mAliasMaskPerClassNext50{};              // fired aliases for each bit of the next-50 trigger mask (Run 2 only)
+  int mTriggerBcShift = 0;                                          // trigger bc shift (Run 3 only)
+  std::string mRunString;                                           // run number label for the counter histograms
+  float mCsTVX = -1.f, mCsTCE = -1.f, mCsZEM = -1.f, mCsZNC = -1.f; // visible cross sections in ub (Run 3 only)
+  SortedGlobalBCs mSortedBCs;                                       // all the BCs of the time frame, to find the trigger bcs (Run 3 only)
+
   void init(InitContext&)
   {
     // ccdb->setURL("http://ccdb-test.cern.ch:8080");
@@ -79,6 +171,71 @@ struct BcSelectionTask {
     histos.add("hLumiZNCafterBCcuts", ";;Luminosity, 1/#mub", kTH1D, {{1, 0., 1.}});
   }
 
+  /// Builds a table of the aliases fired by each bit of a trigger mask
+  static void fillAliasMaskPerClass(const std::map<uint32_t, ULong64_t>& aliasToTriggerMask, std::array<uint32_t, 64>& aliasMaskPerClass)
+  {
+    aliasMaskPerClass.fill(0);
+    for (const auto& al : aliasToTriggerMask) {
+      for (int iClass = 0; iClass < 64; iClass++) {
+        if (al.second & (1ull << iClass)) {
+          aliasMaskPerClass[iClass] |= BIT(al.first);
+        }
+      }
+    }
+  }
+
+  /// Returns the aliases fired by a trigger mask, an alias is fired if any of its trigger classes is fired
+  static uint32_t getAliases(uint64_t triggerMask, const std::array<uint32_t, 64>& aliasMaskPerClass)
+  {
+    uint32_t alias{0};
+    while (triggerMask) {
+      alias |= aliasMaskPerClass[__builtin_ctzll(triggerMask)];
+      triggerMask &= triggerMask - 1;
+    }
+    return alias;
+  }
+
+  /// Fetches the CCDB objects of a run and precomputes the run-level quantities used in the bc loop
+  void setRunContext(int run, int64_t ts, bool isRun3)
+  {
+    if (run == mContextRunNumber) {
+      return;
+    }
+    mContextRunNumber = run;
+    mRunString = Form("%d", run);
+    mPar = ccdb->getForTimeStamp<EventSelectionParams>("EventSelection/EventSelectionParams", ts);
+    TriggerAliases* aliases = ccdb->getForTimeStamp<TriggerAliases>("EventSelection/TriggerAliases", ts);
+    fillAliasMaskPerClass(aliases->GetAliasToTriggerMaskMap(), mAliasMaskPerClass);
+    fillAliasMaskPerClass(aliases->GetAliasToTriggerMaskNext50Map(), mAliasMaskPerClassNext50);
+    if (!isRun3) {
+      return;
+    }
+
+    mAlpidePar = ccdb->getForTimeStamp<o2::itsmft::DPLAlpideParam<0>>("ITS/Config/AlpideParam", ts);
+    mTriggerBcShift = confTriggerBcShift;
+    if (confTriggerBcShift == 999) {
+      mTriggerBcShift = (run <= 526766 || (run >= 526886 && run <= 527237) || (run >= 527259 && run <= 527518) || run == 527523 || run == 527734 || run >= 534091) ? 0 : 294;
+    }
+
+    // Temporary workaround to get visible cross section. TODO: store run-by-run visible cross sections in CCDB
+    auto grplhcif = ccdb->getForTimeStamp<o2::parameters::GRPLHCIFData>("GLO/Config/GRPLHCIF", ts);
+    int beamZ1 = grplhcif->getBeamZ(o2::constants::lhc::BeamA);
+    int beamZ2 = grplhcif->getBeamZ(o2::constants::lhc::BeamC);
+    bool isPP = beamZ1 == 1 && beamZ2 == 1;
+    bool injectionEnergy = (run >= 500000 && run <= 520099) || (run >= 534133 && run <= 534468);
+    // Cross sections in ub. Using dummy -1 if lumi estimator is not reliable
+    mCsTVX = isPP ? (injectionEnergy ? 0.0355e6 : 0.0594e6) : -1.;
+    mCsTCE = isPP ? -1. : 10.36e6;
+    mCsZEM = isPP ? -1. : 415.2e6; // see AN: https://alice-notes.web.cern.ch/node/1515
+    mCsZNC = isPP ? -1. : 214.5e6; // see AN: https://alice-notes.web.cern.ch/node/1515
+    if (run > 543437 && run < 543514) {
+      mCsTCE = 8.3e6;
+    }
+    if (run >= 543514) {
+      mCsTCE = 4.10e6; // see AN: https://alice-notes.web.cern.ch/node/1515
+    }
+  }
+
   void processRun2(
     BCsWithRun2InfosTimestampsAndMatches const& bcs,
     aod::Zdcs const&,
@@ -90,22 +247,10 @@ struct BcSelectionTask {
     bcsel.reserve(bcs.size());
 
     for (auto& bc : bcs) {
-      EventSelectionParams* par = ccdb->getForTimeStamp<EventSelectionParams>("EventSelection/EventSelectionParams", bc.timestamp());
-      TriggerAliases* aliases = ccdb->getForTimeStamp<TriggerAliases>("EventSelection/TriggerAliases", bc.timestamp());
+      setRunContext(bc.runNumber(), bc.timestamp(), false);
+      const EventSelectionParams* par = mPar;
       // fill fired aliases
-      uint32_t alias{0};
-      uint64_t triggerMask = bc.triggerMask();
-      for (auto& al : aliases->GetAliasToTriggerMaskMap()) {
-        if (triggerMask & al.second) {
-          alias |= BIT(al.first);
-        }
-      }
-      uint64_t triggerMaskNext50 = bc.triggerMaskNext50();
-      for (auto& al : aliases->GetAliasToTriggerMaskNext50Map()) {
-        if (triggerMaskNext50 & al.second) {
-          alias |= BIT(al.first);
-        }
-      }
+      uint32_t alias = getAliases(bc.triggerMask(), mAliasMaskPerClass) | getAliases(bc.triggerMaskNext50(), mAliasMaskPerClassNext50);
       alias |= BIT(kALL);
 
       // get timing info from ZDC, FV0, FT0 and FDD
@@ -196,7 +341,7 @@ struct BcSelectionTask {
 
       // Fill TVX (T0 vertex) counters
       if (TESTBIT(selection, kIsTriggerTVX)) {
-        histos.get<TH1>(HIST("hCounterTVX"))->Fill(Form("%d", bc.runNumber()), 1);
+        histos.get<TH1>(HIST("hCounterTVX"))->Fill(mRunString.c_str(), 1);
       }
 
       // Fill bc selection columns
@@ -215,30 +360,28 @@ struct BcSelectionTask {
       return;
 
     bcsel.reserve(bcs.size());
-    // extract ITS time frame parameters
 
+    // extract run number and prefetch the calibration objects of the run
+    int run = bcs.iteratorAt(0).runNumber();
     int64_t ts = bcs.iteratorAt(0).timestamp();
-    auto alppar = ccdb->getForTimeStamp<o2::itsmft::DPLAlpideParam<0>>("ITS/Config/AlpideParam", ts);
-
-    // map from GlobalBC to BcId needed to find triggerBc
-    std::map<uint64_t, int32_t> mapGlobalBCtoBcId;
-    for (auto& bc : bcs) {
-      mapGlobalBCtoBcId[bc.globalBC()] = bc.globalIndex();
-    }
-    int triggerBcShift = confTriggerBcShift;
-    if (confTriggerBcShift == 999) {
-      int run = bcs.iteratorAt(0).runNumber();
-      triggerBcShift = (run <= 526766 || (run >= 526886 && run <= 527237) || (run >= 527259 && run <= 527518) || run == 527523 || run == 527734 || run >= 534091) ? 0 : 294;
+    setRunContext(run, ts, true);
+    const EventSelectionParams* par = mPar;
+    // extract ITS time frame parameters
+    auto alppar = mAlpidePar;
+    int triggerBcShift = mTriggerBcShift;
+
+    // sorted GlobalBC to BcId needed to find triggerBc
+    mSortedBCs.clear();
+    mSortedBCs.reserve(bcs.size());
+    for (const auto& bc : bcs) {
+      mSortedBCs.add(bc.globalBC(), bc.globalIndex());
     }
+    mSortedBCs.sort();
 
-    // extract run number and related information
-    int run = bcs.iteratorAt(0).runNumber();
     if (run != lastRunNumber) {
       lastRunNumber = run; // do it only once
       if (run >= 500000) { // access CCDB for data or anchored MC only
-        int64_t ts = bcs.iteratorAt(0).timestamp();
         // access orbitShift, ITSROF and TF border margins
-        EventSelectionParams* par = ccdb->getForTimeStamp<EventSelectionParams>("EventSelection/EventSelectionParams", ts);
         mITSROFrameStartBorderMargin = confITSROFrameStartBorderMargin < 0 ? par->fITSROFrameStartBorderMargin : confITSROFrameStartBorderMargin;
         mITSROFrameEndBorderMargin = confITSROFrameEndBorderMargin < 0 ? par->fITSROFrameEndBorderMargin : confITSROFrameEndBorderMargin;
         mTimeFrameStartBorderMargin = confTimeFrameStartBorderMargin < 0 ? par->fTimeFrameStartBorderMargin : confTimeFrameStartBorderMargin;
@@ -266,19 +409,12 @@ struct BcSelectionTask {
 
     // bc loop
     for (auto bc : bcs) {
-      EventSelectionParams* par = ccdb->getForTimeStamp<EventSelectionParams>("EventSelection/EventSelectionParams", bc.timestamp());
-      TriggerAliases* aliases = ccdb->getForTimeStamp<TriggerAliases>("EventSelection/TriggerAliases", bc.timestamp());
       uint32_t alias{0};
       // workaround for pp2022 (trigger info is shifted by -294 bcs)
-      int32_t triggerBcId = mapGlobalBCtoBcId[bc.globalBC() + triggerBcShift];
+      int32_t triggerBcId = mSortedBCs.find(bc.globalBC() + triggerBcShift);
       if (triggerBcId) {
         auto triggerBc = bcs.iteratorAt(triggerBcId);
-        uint64_t triggerMask = triggerBc.triggerMask();
-        for (auto& al : aliases->GetAliasToTriggerMaskMap()) {
-          if (triggerMask & al.second) {
-            alias |= BIT(al.first);
-          }
-        }
+        alias = getAliases(triggerBc.triggerMask(), mAliasMaskPerClass);
       }
       alias |= BIT(kALL);
 
@@ -355,24 +491,12 @@ struct BcSelectionTask {
       int32_t foundZDC = bc.has_zdc() ? bc.zdc().globalIndex() : -1;
       LOGP(debug, "foundFT0={}", foundFT0);
 
-      // Temporary workaround to get visible cross section. TODO: store run-by-run visible cross sections in CCDB
-      const char* srun = Form("%d", run);
-      auto grplhcif = ccdb->getForTimeStamp<o2::parameters::GRPLHCIFData>("GLO/Config/GRPLHCIF", bc.timestamp());
-      int beamZ1 = grplhcif->getBeamZ(o2::constants::lhc::BeamA);
-      int beamZ2 = grplhcif->getBeamZ(o2::constants::lhc::BeamC);
-      bool isPP = beamZ1 == 1 && beamZ2 == 1;
-      bool injectionEnergy = (run >= 500000 && run <= 520099) || (run >= 534133 && run <= 534468);
-      // Cross sections in ub. Using dummy -1 if lumi estimator is not reliable
-      float csTVX = isPP ? (injectionEnergy ? 0.0355e6 : 0.0594e6) : -1.;
-      float csTCE = isPP ? -1. : 10.36e6;
-      float csZEM = isPP ? -1. : 415.2e6; // see AN: https://alice-notes.web.cern.ch/node/1515
-      float csZNC = isPP ? -1. : 214.5e6; // see AN: https://alice-notes.web.cern.ch/node/1515
-      if (run > 543437 && run < 543514) {
-        csTCE = 8.3e6;
-      }
-      if (run >= 543514) {
-        csTCE = 4.10e6; // see AN: https://alice-notes.web.cern.ch/node/1515
-      }
+      // visible cross sections of the run
+      const char* srun = mRunString.c_str();
+      float csTVX = mCsTVX;
+      float csTCE = mCsTCE;
+      float csZEM = mCsZEM;
+      float csZNC = mCsZNC;
 
       // Fill TVX (T0 vertex) counters
       if (TESTBIT(selection, kIsTriggerTVX)) {
@@ -444,19 +568,9 @@ struct EventSelectionTask {
   int64_t bcSOR = -1;     // global bc of the start of the first orbit
   int64_t nBCsPerTF = -1; // duration of TF in bcs, should be 128*3564 or 32*3564
 
-  int32_t findClosest(int64_t globalBC, std::map<int64_t, int32_t>& bcs)
-  {
-    auto it = bcs.lower_bound(globalBC);
-    int64_t bc1 = it->first;
-    int32_t index1 = it->second;
-    if (it != bcs.begin())
-      --it;
-    int64_t bc2 = it->first;
-    int32_t index2 = it->second;
-    int64_t dbc1 = std::abs(bc1 - globalBC);
-    int64_t dbc2 = std::abs(bc2 - globalBC);
-    return (dbc1 <= dbc2) ? index1 : index2;
-  }
+  // colliding bcs with TVX or FT0-OR (T0A | T0C), sorted by global BC for the closest TVX (FT0-OR) searches
+  SortedGlobalBCs mSortedBCsWithTVX;
+  SortedGlobalBCs mSortedBCsWithTOR;
 
   void init(InitContext&)
   {
@@ -580,26 +694,28 @@ struct EventSelectionTask {
       nBCsPerTF = nOrbitsPerTF * o2::constants::lhc::LHCMaxBunches;
     }
 
-    // create maps from globalBC to bc index for TVX or FT0-OR fired bcs
+    // create sorted arrays of globalBC and bc index for TVX or FT0-OR fired bcs
     // to be used for closest TVX (FT0-OR) searches
-    std::map<int64_t, int32_t> mapGlobalBcWithTVX;
-    std::map<int64_t, int32_t> mapGlobalBcWithTOR;
-    for (auto& bc : bcs) {
+    mSortedBCsWithTVX.clear();
+    mSortedBCsWithTOR.clear();
+    for (const auto& bc : bcs) {
       int64_t globalBC = bc.globalBC();
       // skip non-colliding bcs for data and anchored runs
       if (run >= 500000 && bcPatternB[globalBC % o2::constants::lhc::LHCMaxBunches] == 0) {
         continue;
       }
       if (bc.selection_bit(kIsBBT0A) || bc.selection_bit(kIsBBT0C)) {
-        mapGlobalBcWithTOR[globalBC] = bc.globalIndex();
+        mSortedBCsWithTOR.add(globalBC, bc.globalIndex());
       }
       if (bc.selection_bit(kIsTriggerTVX)) {
-        mapGlobalBcWithTVX[globalBC] = bc.globalIndex();
+        mSortedBCsWithTVX.add(globalBC, bc.globalIndex());
       }
     }
+    mSortedBCsWithTOR.sort();
+    mSortedBCsWithTVX.sort();
 
     // protection against empty FT0 maps
-    if (mapGlobalBcWithTOR.size() == 0 || mapGlobalBcWithTVX.size() == 0) {
+    if (mSortedBCsWithTOR.empty() || mSortedBCsWithTVX.empty()) {
       LOGP(error, "FT0 table is empty or corrupted. Filling evsel table with dummy values");
       for (auto& col : cols) {
         auto bc = col.bc_as<BCsWithBcSelsRun3>();
@@ -676,12 +792,12 @@ struct EventSelectionTask {
       int64_t minBC = meanBC - deltaBC;
       int64_t maxBC = meanBC + deltaBC;
 
-      int32_t indexClosestTVX = findClosest(meanBC, mapGlobalBcWithTVX);
+      int32_t indexClosestTVX = mSortedBCsWithTVX.findClosest(meanBC);
       int64_t tvxBC = bcs.iteratorAt(indexClosestTVX).globalBC();
       if (tvxBC >= minBC && tvxBC <= maxBC) { // closest TVX within search region
         bc.setCursor(indexClosestTVX);
       } else { // no TVX within search region, searching for TOR = T0A | T0C
-        int32_t indexClosestTOR = findClosest(meanBC, mapGlobalBcWithTOR);
+        int32_t indexClosestTOR = mSortedBCsWithTOR.findClosest(meanBC);
         int64_t torBC = bcs.iteratorAt(indexClosestTOR).globalBC();
         if (torBC >= minBC && torBC <= maxBC) {
           bc.setCursor(indexClosestTOR);
@@ -777,8 +893,8 @@ struct EventSelectionTask {
         vNumTracksITS567inFullTimeWin[colIndex] = -1; // occupancy in undefined (too close to TF borders)
         continue;
       }
-      std::vector<int> vAssocToThisCol = vCollsInTimeWin[colIndex];
-      std::vector<float> vCollsTimeDeltaWrtGivenColl = vTimeDeltaForColls[colIndex];
+      const std::vector<int>& vAssocToThisCol = vCollsInTimeWin[colIndex];
+      const std::vector<float>& vCollsTimeDeltaWrtGivenColl = vTimeDeltaForColls[colIndex];
       int nITS567tracksInFullTimeWindow = 0;
       int nITS567tracksInTimeBins[nTimeIntervals] = {};
       int nITS567tracksForVetoStandard = 0; // to veto events with nearby collisions
@@ -12,9 +12,12 @@
 // Quick and dirty task to correlate MC <-> data
 //
 
+#include <algorithm>
 #include <cmath>
 #include <array>
 #include <cstdlib>
+#include <numeric>
+#include <vector>
 
 #include "Math/Vector4D.h"
 #include <TFile.h>
@@ -64,9 +67,6 @@ struct mcCollisionExtra {
   Configurable<bool> pdgCodeAbsolute{"pdgCodeAbsolute", true, "if true, accept +/- pdgCodeOfInterest"};
   Configurable<float> poiEtaWindow{"poiEtaWindow", 0.8, "PDG code requirement within this eta window"};
 
-  // For manual sliceBy
-  Preslice<aod::McParticle> perMcCollision = aod::mcparticle::mcCollisionId;
-
   template <typename T>
   std::vector<std::size_t> sort_indices(const std::vector<T>& v)
   {
@@ -105,48 +105,45 @@ struct mcCollisionExtra {
   }
   void processMcContexts(aod::McCollisions const& mcCollisions, aod::McParticles const& mcParticlesUngrouped, FullCollisions const& collisions)
   {
+    // PoI presence per MC collision, in one pass over the MC particles
+    std::vector<bool> mcCollisionHasPoI(mcCollisions.size(), false);
+    for (auto& mcParticle : mcParticlesUngrouped) {
+      if (mcParticle.mcCollisionId() < 0 || std::abs(mcParticle.eta()) >= poiEtaWindow) {
+        continue;
+      }
+      if (mcParticle.pdgCode() == pdgCodeOfInterest || (mcParticle.pdgCode() == -pdgCodeOfInterest && pdgCodeAbsolute)) {
+        mcCollisionHasPoI[mcParticle.mcCollisionId()] = true;
+      }
+    }
     std::vector<float> mcCollisionTimes;
-    std::vector<bool> mcCollisionHasPoI;
+    mcCollisionTimes.reserve(mcCollisions.size());
     for (auto& mcCollision : mcCollisions) {
-      bool PoIpresent = false;
-      auto mcParticles = mcParticlesUngrouped.sliceBy(perMcCollision, mcCollision.globalIndex());
-      for (auto& mcParticle : mcParticles) {
-        if (std::abs(mcParticle.eta()) < poiEtaWindow) {
-          if (mcParticle.pdgCode() == pdgCodeOfInterest) {
-            PoIpresent = true;
-          }
-          if (mcParticle.pdgCode() == -pdgCodeOfInterest && pdgCodeAbsolute) {
-            PoIpresent = true;
-          }
-        }
-      }
       mcCollisionTimes.emplace_back(mcCollision.t());
-      mcCollisionHasPoI.emplace_back(PoIpresent);
     }
     // sort mcCollisions according to time
     auto sortedIndices = sort_indices(mcCollisionTimes);
+
+    // PoI presence in the 16 neighbours in time of each MC collision, bit i for the (i + 1)-th neighbour, obtained by
+    // shifting the history of the previous (next) collision in time instead of scanning the neighbours
+    const std::size_t nMcCollisions = sortedIndices.size();
+    std::vector<std::size_t> timeRanks(nMcCollisions);
+    std::vector<uint16_t> forwardHistories(nMcCollisions, 0), backwardHistories(nMcCollisions, 0);
+    for (std::size_t iRank = 0; iRank < nMcCollisions; iRank++) {
+      timeRanks[sortedIndices[iRank]] = iRank;
+      if (iRank > 0) {
+        backwardHistories[iRank] = static_cast<uint16_t>((backwardHistories[iRank - 1] << 1) | mcCollisionHasPoI[sortedIndices[iRank - 1]]);
+      }
+    }
+    for (std::size_t iRank = nMcCollisions; iRank > 1; iRank--) {
+      forwardHistories[iRank - 2] = static_cast<uint16_t>((forwardHistories[iRank - 1] << 1) | mcCollisionHasPoI[sortedIndices[iRank - 1]]);
+    }
+
     for (auto& collision : collisions) {
       uint16_t forwardHistory = 0, backwardHistory = 0;
-      if (!collision.has_mcCollision()) {
-        mcCollContexts(forwardHistory, backwardHistory);
-        continue;
-      }
-      auto mcCollision = collision.mcCollision();
-      auto iter = std::find(sortedIndices.begin(), sortedIndices.end(), mcCollision.index());
-      if (iter != sortedIndices.end()) {
-        auto index = std::distance(iter, sortedIndices.begin());
-        for (size_t iMcColl = index + 1; iMcColl < index + 17; iMcColl++) {
-          if (iMcColl >= sortedIndices.size())
-            continue;
-          if (mcCollisionHasPoI[sortedIndices[iMcColl]])
-            bitset(forwardHistory, iMcColl - index - 1);
-        }
-        for (int iMcColl = index - 1; iMcColl > index - 17; iMcColl--) {
-          if (iMcColl <= 0)
-            continue;
-          if (mcCollisionHasPoI[sortedIndices[iMcColl]])
-            bitset(backwardHistory, index + 1 - iMcColl);
-        }
+      if (collision.has_mcCollision()) {
+        const std::size_t iRank = timeRanks[collision.mcCollisionId()];
+        forwardHistory = forwardHistories[iRank];
+        backwardHistory = backwardHistories[iRank];
       }
       mcCollContexts(forwardHistory, backwardHistory);
     }
@@ -15,8 +15,11 @@
 #else
 #include <onnxruntime_cxx_api.h>
 #endif
+#include <algorithm>
 #include <string>
 #include <regex>
+#include <utility>
+#include <vector>
 #include <TLorentzVector.h>
 #include "Common/DataModel/MftmchMatchingML.h"
 #include "Framework/AnalysisDataModel.h"
@@ -77,147 +80,71 @@ struct mftmchMatchingML {
 
   Ort::Env env{ORT_LOGGING_LEVEL_WARNING, "model-explorer"};
   Ort::SessionOptions session_options;
-#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-  std::shared_ptr<Ort::Experimental::Session> onnx_session = nullptr;
-#else
-  std::shared_ptr<Ort::Session> onnx_session = nullptr;
-#endif
   OnnxModel model;
 
-  template <typename F, typename M>
-  std::vector<float> getVariables(F const& fwdtrack, M const& mfttrack)
-  {
-
-    static constexpr Double_t MatchingPlaneZ = -77.5;
-
-    // propagate muontrack to matching position
-    double muonchi2 = fwdtrack.chi2();
-    SMatrix5 muonpars(fwdtrack.x(), fwdtrack.y(), fwdtrack.phi(), fwdtrack.tgl(), fwdtrack.signed1Pt());
-    std::vector<double> muonv1;
-    SMatrix55 muoncovs(muonv1.begin(), muonv1.end());
-    o2::track::TrackParCovFwd muonpars1{fwdtrack.z(), muonpars, muoncovs, muonchi2};
-    muonpars1.propagateToZlinear(MatchingPlaneZ);
-
-    // propagate mfttrack to matching position
-    double mftchi2 = mfttrack.chi2();
-    SMatrix5 mftpars(mfttrack.x(), mfttrack.y(), mfttrack.phi(), mfttrack.tgl(), mfttrack.signed1Pt());
-    std::vector<double> mftv1;
-    SMatrix55 mftcovs(mftv1.begin(), mftv1.end());
-    o2::track::TrackParCovFwd mftpars1{mfttrack.z(), mftpars, mftcovs, mftchi2};
-    mftpars1.propagateToZlinear(MatchingPlaneZ);
+  static constexpr Double_t MatchingPlaneZ = -77.5;
 
-    Float_t MFT_X = mftpars1.getX();
-    Float_t MFT_Y = mftpars1.getY();
-    Float_t MFT_Phi = mftpars1.getPhi();
-    Float_t MFT_Tanl = mftpars1.getTanl();
-
-    Float_t MCH_X = muonpars1.getX();
-    Float_t MCH_Y = muonpars1.getY();
-    Float_t MCH_Phi = muonpars1.getPhi();
-    Float_t MCH_Tanl = muonpars1.getTanl();
-
-    Float_t Ratio_X = MFT_X / MCH_X;
-    Float_t Ratio_Y = MFT_Y / MCH_Y;
-    Float_t Ratio_Phi = MFT_Phi / MCH_Phi;
-    Float_t Ratio_Tanl = MFT_Tanl / MCH_Tanl;
-
-    Float_t Delta_X = MFT_X - MCH_X;
-    Float_t Delta_Y = MFT_Y - MCH_Y;
-    Float_t Delta_Phi = MFT_Phi - MCH_Phi;
-    Float_t Delta_Tanl = MFT_Tanl - MCH_Tanl;
-
-    Float_t Delta_XY = sqrt(Delta_X * Delta_X + Delta_Y * Delta_Y);
+  // parameters of a track propagated linearly to the matching plane
+  struct PlaneParams {
+    Float_t x;
+    Float_t y;
+    Float_t phi;
+    Float_t tanl;
+  };
 
-    std::vector<float> input_tensor_values{
-      MFT_X,
-      MFT_Y,
-      MFT_Phi,
-      MFT_Tanl,
-      MCH_X,
-      MCH_Y,
-      MCH_Phi,
-      MCH_Tanl,
-      Delta_XY,
-      Delta_X,
-      Delta_Y,
-      Delta_Phi,
-      Delta_Tanl,
-      Ratio_X,
-      Ratio_Y,
-      Ratio_Phi,
-      Ratio_Tanl,
-    };
-    return input_tensor_values;
+  // per dataframe: MFT tracks at the matching plane, and (collision ID, MFT track) pairs sorted by collision ID
+  std::vector<PlaneParams> mftPlaneParams;
+  std::vector<std::pair<int, int64_t>> mftTracksByCollision;
+  // per muon: MFT candidates, their features and their scores
+  std::vector<int64_t> candidates;
+  std::vector<float> inputValues;
+  std::vector<float> outputValues;
+  std::vector<float> scores;
+
+  template <typename T>
+  PlaneParams propagateToMatchingPlane(T const& track)
+  {
+    double chi2 = track.chi2();
+    SMatrix5 pars(track.x(), track.y(), track.phi(), track.tgl(), track.signed1Pt());
+    std::vector<double> v1;
+    SMatrix55 covs(v1.begin(), v1.end());
+    o2::track::TrackParCovFwd pars1{track.z(), pars, covs, chi2};
+    pars1.propagateToZlinear(MatchingPlaneZ);
+    return {static_cast<Float_t>(pars1.getX()), static_cast<Float_t>(pars1.getY()), static_cast<Float_t>(pars1.getPhi()), static_cast<Float_t>(pars1.getTanl())};
   }
 
-  template <typename F, typename M>
-  double matchONNX(F const& fwdtrack, M const& mfttrack)
+  /// Distance in the transverse plane of an MFT and an MCH track at the matching plane
+  static Float_t getDeltaXY(const PlaneParams& mft, const PlaneParams& mch)
   {
-    std::vector<std::string> input_names;
-    std::vector<std::vector<int64_t>> input_shapes;
-    std::vector<std::string> output_names;
-    std::vector<std::vector<int64_t>> output_shapes;
-
-#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-    input_names = onnx_session->GetInputNames();
-    input_shapes = onnx_session->GetInputShapes();
-    output_names = onnx_session->GetOutputNames();
-    output_shapes = onnx_session->GetOutputShapes();
-#else
-    Ort::AllocatorWithDefaultOptions tmpAllocator;
-    for (size_t i = 0; i < onnx_session->GetInputCount(); ++i) {
-      input_names.push_back(onnx_session->GetInputNameAllocated(i, tmpAllocator).get());
-    }
-    for (size_t i = 0; i < onnx_session->GetInputCount(); ++i) {
-      input_shapes.emplace_back(onnx_session->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
-    }
-    for (size_t i = 0; i < onnx_session->GetOutputCount(); ++i) {
-      output_names.push_back(onnx_session->GetOutputNameAllocated(i, tmpAllocator).get());
-    }
-    for (size_t i = 0; i < onnx_session->GetOutputCount(); ++i) {
-      output_shapes.emplace_back(onnx_session->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
-    }
-#endif
-
-    auto input_shape = input_shapes[0];
-    input_shape[0] = 1;
-
-    std::vector<float> input_tensor_values;
-    input_tensor_values = getVariables(fwdtrack, mfttrack);
-
-    if (input_tensor_values[8] < cfgXYWindow) {
-      std::vector<Ort::Value> input_tensors;
-#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-      input_tensors.push_back(Ort::Experimental::Value::CreateTensor<float>(input_tensor_values.data(), input_tensor_values.size(), input_shape));
-
-      std::vector<Ort::Value> output_tensors = onnx_session->Run(input_names, input_tensors, output_names);
-#else
-      Ort::MemoryInfo mem_info =
-        Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-      input_tensors.push_back(Ort::Value::CreateTensor<float>(mem_info, input_tensor_values.data(), input_tensor_values.size(), input_shape.data(), input_shape.size()));
-
-      Ort::RunOptions runOptions;
-      std::vector<const char*> inputNamesChar(input_names.size(), nullptr);
-      std::transform(std::begin(input_names), std::end(input_names), std::begin(inputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
-
-      std::vector<const char*> outputNamesChar(output_names.size(), nullptr);
-      std::transform(std::begin(output_names), std::end(output_names), std::begin(outputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
-
-      std::vector<Ort::Value> output_tensors = onnx_session->Run(runOptions, inputNamesChar.data(), input_tensors.data(), input_tensors.size(), outputNamesChar.data(), outputNamesChar.size());
-#endif
-
-      const float* output_value = output_tensors[0].GetTensorData<float>();
-
-      auto score = output_value[0];
+    Float_t Delta_X = mft.x - mch.x;
+    Float_t Delta_Y = mft.y - mch.y;
+    return sqrt(Delta_X * Delta_X + Delta_Y * Delta_Y);
+  }
 
-      return score;
-    } else {
-      auto score = 0;
-      return score;
-    }
-  };
+  /// Appends the features of a pair to the input of the model
+  static void addVariables(const PlaneParams& mft, const PlaneParams& mch, std::vector<float>& input_tensor_values)
+  {
+    const float variables[] = {
+      mft.x,
+      mft.y,
+      mft.phi,
+      mft.tanl,
+      mch.x,
+      mch.y,
+      mch.phi,
+      mch.tanl,
+      getDeltaXY(mft, mch),
+      mft.x - mch.x,
+      mft.y - mch.y,
+      mft.phi - mch.phi,
+      mft.tanl - mch.tanl,
+      mft.x / mch.x,
+      mft.y / mch.y,
+      mft.phi / mch.phi,
+      mft.tanl / mch.tanl,
+    };
+    input_tensor_values.insert(input_tensor_values.end(), std::begin(variables), std::end(variables));
+  }
 
   void init(o2::framework::InitContext&)
   {
@@ -236,7 +163,6 @@ struct mftmchMatchingML {
                 << "."
                 << "/" << cfgModelName.value;
       model.initModel(cfgModelName, false, 1, strtoul(headers["Valid-From"].c_str(), NULL, 0), strtoul(headers["Valid-Until"].c_str(), NULL, 0));
-      onnx_session = model.getSession();
     } else {
       LOG(info) << "Failed to retrieve Network file";
     }
@@ -244,41 +170,81 @@ struct mftmchMatchingML {
 
   void process(aod::Collisions const&, soa::Filtered<aod::FwdTracks> const& fwdtracks, aod::MFTTracks const& mfttracks)
   {
+    mftPlaneParams.clear();
+    mftTracksByCollision.clear();
+    mftPlaneParams.reserve(mfttracks.size());
+    for (auto& mfttrack : mfttracks) {
+      mftPlaneParams.push_back(propagateToMatchingPlane(mfttrack));
+      if (mfttrack.has_collision()) {
+        mftTracksByCollision.emplace_back(mfttrack.collisionId(), mfttrack.globalIndex());
+      }
+    }
+    std::sort(mftTracksByCollision.begin(), mftTracksByCollision.end());
+    const int64_t nOutputs = model.getNumOutputNodesLast();
+
     for (auto& fwdtrack : fwdtracks) {
-      if (fwdtrack.trackType() == aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack) {
-        double bestscore = 0;
-        int bestmfttrackid = -1;
-        for (auto& mfttrack : mfttracks) {
-          if (fwdtrack.has_collision() && mfttrack.has_collision()) {
-            if (0 <= fwdtrack.collisionId() - mfttrack.collisionId() && fwdtrack.collisionId() - mfttrack.collisionId() < cfgColWindow) {
-              double result = matchONNX(fwdtrack, mfttrack);
-              if (result > cfgThrScore) {
-                bestscore = result;
-                bestmfttrackid = mfttrack.globalIndex();
-              }
-            }
+      if (fwdtrack.trackType() != aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack || !fwdtrack.has_collision()) {
+        continue;
+      }
+      // MFT tracks of the collisions (fwdtrack.collisionId() - cfgColWindow, fwdtrack.collisionId()], in the order of the table
+      auto first = std::lower_bound(mftTracksByCollision.begin(), mftTracksByCollision.end(), std::make_pair(fwdtrack.collisionId() - cfgColWindow + 1, int64_t{-1}));
+      auto last = std::lower_bound(first, mftTracksByCollision.end(), std::make_pair(fwdtrack.collisionId() + 1, int64_t{-1}));
+      candidates.clear();
+      for (auto it = first; it != last; ++it) {
+        candidates.push_back(it->second);
+      }
+      std::sort(candidates.begin(), candidates.end());
+
+      // pairs outside of the XY window have score 0, the others are scored in one inference
+      const PlaneParams muonPlaneParams = propagateToMatchingPlane(fwdtrack);
+      scores.assign(candidates.size(), 0.f);
+      inputValues.clear();
+      for (const auto& mftIndex : candidates) {
+        if (getDeltaXY(mftPlaneParams[mftIndex], muonPlaneParams) < cfgXYWindow) {
+          addVariables(mftPlaneParams[mftIndex], muonPlaneParams, inputValues);
+        }
+      }
+      if (!inputValues.empty()) {
+        if (!model.evalModelBatch(inputValues, outputValues)) {
+          continue;
+        }
+        int64_t iRow = 0;
+        for (std::size_t iCandidate = 0; iCandidate < candidates.size(); iCandidate++) {
+          if (getDeltaXY(mftPlaneParams[candidates[iCandidate]], muonPlaneParams) < cfgXYWindow) {
+            scores[iCandidate] = outputValues[iRow * nOutputs];
+            iRow++;
           }
         }
-        if (bestmfttrackid != -1) {
-          for (auto& mfttrack : mfttracks) {
-            if (mfttrack.globalIndex() == bestmfttrackid) {
-              double mftchi2 = mfttrack.chi2();
-              SMatrix5 mftpars(mfttrack.x(), mfttrack.y(), mfttrack.phi(), mfttrack.tgl(), mfttrack.signed1Pt());
-              std::vector<double> mftv1;
-              SMatrix55 mftcovs(mftv1.begin(), mftv1.end());
-              o2::track::TrackParCovFwd mftpars1{mfttrack.z(), mftpars, mftcovs, mftchi2};
-              mftpars1.propagateToZlinear(mfttrack.collision().posZ());
+      }
 
-              float dcaX = (mftpars1.getX() - mfttrack.collision().posX());
-              float dcaY = (mftpars1.getY() - mfttrack.collision().posY());
-              double px = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * cos(mfttrack.phi());
-              double py = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * sin(mfttrack.phi());
-              double pz = fwdtrack.p() * cos(M_PI / 2 - atan(mfttrack.tgl()));
-              fwdtrackml(fwdtrack.collisionId(), 0, mfttrack.x(), mfttrack.y(), mfttrack.z(), mfttrack.phi(), mfttrack.tgl(), fwdtrack.sign() / std::sqrt(std::pow(px, 2) + std::pow(py, 2)), fwdtrack.nClusters(), fwdtrack.pDca(), fwdtrack.rAtAbsorberEnd(), 0, 0, 0, bestscore, mfttrack.globalIndex(), fwdtrack.globalIndex(), fwdtrack.mchBitMap(), fwdtrack.midBitMap(), fwdtrack.midBoards(), mfttrack.trackTime(), mfttrack.trackTimeRes(), mfttrack.eta(), std::sqrt(std::pow(px, 2) + std::pow(py, 2)), std::sqrt(std::pow(px, 2) + std::pow(py, 2) + std::pow(pz, 2)), dcaX, dcaY);
-            }
-          }
+      // the last candidate above threshold is kept
+      double bestscore = 0;
+      int64_t bestmfttrackid = -1;
+      for (std::size_t iCandidate = 0; iCandidate < candidates.size(); iCandidate++) {
+        double result = scores[iCandidate];
+        if (result > cfgThrScore) {
+          bestscore = result;
+          bestmfttrackid = candidates[iCandidate];
         }
       }
+      if (bestmfttrackid == -1) {
+        continue;
+      }
+
+      auto mfttrack = mfttracks.iteratorAt(bestmfttrackid);
+      double mftchi2 = mfttrack.chi2();
+      SMatrix5 mftpars(mfttrack.x(), mfttrack.y(), mfttrack.phi(), mfttrack.tgl(), mfttrack.signed1Pt());
+      std::vector<double> mftv1;
+      SMatrix55 mftcovs(mftv1.begin(), mftv1.end());
+      o2::track::TrackParCovFwd mftpars1{mfttrack.z(), mftpars, mftcovs, mftchi2};
+      mftpars1.propagateToZlinear(mfttrack.collision().posZ());
+
+      float dcaX = (mftpars1.getX() - mfttrack.collision().posX());
+      float dcaY = (mftpars1.getY() - mfttrack.collision().posY());
+      double px = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * cos(mfttrack.phi());
+      double py = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * sin(mfttrack.phi());
+      double pz = fwdtrack.p() * cos(M_PI / 2 - atan(mfttrack.tgl()));
+      fwdtrackml(fwdtrack.collisionId(), 0, mfttrack.x(), mfttrack.y(), mfttrack.z(), mfttrack.phi(), mfttrack.tgl(), fwdtrack.sign() / std::sqrt(std::pow(px, 2) + std::pow(py, 2)), fwdtrack.nClusters(), fwdtrack.pDca(), fwdtrack.rAtAbsorberEnd(), 0, 0, 0, bestscore, mfttrack.globalIndex(), fwdtrack.globalIndex(), fwdtrack.mchBitMap(), fwdtrack.midBitMap(), fwdtrack.midBoards(), mfttrack.trackTime(), mfttrack.trackTimeRes(), mfttrack.eta(), std::sqrt(std::pow(px, 2) + std::pow(py, 2)), std::sqrt(std::pow(px, 2) + std::pow(py, 2) + std::pow(pz, 2)), dcaX, dcaY);
     }
   }
 };
@@ -120,6 +120,13 @@ struct MultiplicityTable {
   TProfile* hVtxZFDDA;
   TProfile* hVtxZFDDC;
   TProfile* hVtxZNTracks;
+  // Values of the equalization profiles at zero, evaluated once per run
+  double mVtxZRefFV0A = 1.;
+  double mVtxZRefFT0A = 1.;
+  double mVtxZRefFT0C = 1.;
+  double mVtxZRefFDDA = 1.;
+  double mVtxZRefFDDC = 1.;
+  double mVtxZRefNTracks = 1.;
   std::vector<int> mEnabledTables; // Vector of enabled tables
 
   // Debug output
@@ -370,6 +377,13 @@ struct MultiplicityTable {
             if (!hVtxZFV0A || !hVtxZFT0A || !hVtxZFT0C || !hVtxZFDDA || !hVtxZFDDC || !hVtxZNTracks) {
               LOGF(error, "Problem loading CCDB objects! Please check");
               lCalibLoaded = false;
+            } else {
+              mVtxZRefFV0A = hVtxZFV0A->Interpolate(0.0);
+              mVtxZRefFT0A = hVtxZFT0A->Interpolate(0.0);
+              mVtxZRefFT0C = hVtxZFT0C->Interpolate(0.0);
+              mVtxZRefFDDA = hVtxZFDDA->Interpolate(0.0);
+              mVtxZRefFDDC = hVtxZFDDC->Interpolate(0.0);
+              mVtxZRefNTracks = hVtxZNTracks->Interpolate(0.0);
             }
           } else {
             LOGF(error, "Problem loading CCDB object! Please check");
@@ -538,15 +552,15 @@ struct MultiplicityTable {
           case kFV0MultZeqs: // Z equalized FV0
           {
             if (fabs(collision.posZ()) < 15.0f && lCalibLoaded) {
-              multZeqFV0A = hVtxZFV0A->Interpolate(0.0) * multFV0A / hVtxZFV0A->Interpolate(collision.posZ());
+              multZeqFV0A = mVtxZRefFV0A * multFV0A / hVtxZFV0A->Interpolate(collision.posZ());
             }
             tableFV0Zeqs(multZeqFV0A);
           } break;
           case kFT0MultZeqs: // Z equalized FT0
           {
             if (fabs(collision.posZ()) < 15.0f && lCalibLoaded) {
-              multZeqFT0A = hVtxZFT0A->Interpolate(0.0) * multFT0A / hVtxZFT0A->Interpolate(collision.posZ());
-              multZeqFT0C = hVtxZFT0C->Interpolate(0.0) * multFT0C / hVtxZFT0C->Interpolate(collision.posZ());
+              multZeqFT0A = mVtxZRefFT0A * multFT0A / hVtxZFT0A->Interpolate(collision.posZ());
+              multZeqFT0C = mVtxZRefFT0C * multFT0C / hVtxZFT0C->Interpolate(collision.posZ());
             }
             if (produceHistograms.value) {
               histos.fill(HIST("FT0A"), multFT0A, multZeqFT0A);
@@ -559,15 +573,15 @@ struct MultiplicityTable {
           case kFDDMultZeqs: // Z equalized FDD
           {
             if (fabs(collision.posZ()) < 15.0f && lCalibLoaded) {
-              multZeqFDDA = hVtxZFDDA->Interpolate(0.0) * multFDDA / hVtxZFDDA->Interpolate(collision.posZ());
-              multZeqFDDC = hVtxZFDDC->Interpolate(0.0) * multFDDC / hVtxZFDDC->Interpolate(collision.posZ());
+              multZeqFDDA = mVtxZRefFDDA * multFDDA / hVtxZFDDA->Interpolate(collision.posZ());
+              multZeqFDDC = mVtxZRefFDDC * multFDDC / hVtxZFDDC->Interpolate(collision.posZ());
             }
             tableFDDZeqs(multZeqFDDA, multZeqFDDC);
           } break;
           case kPVMultZeqs: // Z equalized PV
           {
             if (fabs(collision.posZ()) < 15.0f && lCalibLoaded) {
-              multZeqNContribs = hVtxZNTracks->Interpolate(0.0) * multNContribs / hVtxZNTracks->Interpolate(collision.posZ());
+              multZeqNContribs = mVtxZRefNTracks * multNContribs / hVtxZNTracks->Interpolate(collision.posZ());
             }
             tablePVZeqs(multZeqNContribs);
           } break;
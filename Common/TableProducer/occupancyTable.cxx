@@ -0,0 +1,202 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file occupancyTable.cxx
+/// \brief Task to produce the occupancy (tracks and FT0 signals of the other collisions and BCs) in a time window around each collision
+///        The per-BC quantities of the time frame are indexed once with time-sorted prefix sums, each collision is then a pair of binary searches
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Framework/runDataProcessing.h"
+#include "Framework/AnalysisTask.h"
+#include "Framework/AnalysisDataModel.h"
+#include "Common/Core/TimeOrderedPrefixSum.h"
+#include "Common/DataModel/EventSelection.h"
+#include "Common/DataModel/OccupancyTables.h"
+#include "Common/CCDB/EventSelectionParams.h"
+#include "CCDB/BasicCCDBManager.h"
+#include "CommonConstants/LHCConstants.h"
+#include "DataFormatsParameters/GRPECSObject.h"
+
+using namespace o2;
+using namespace o2::framework;
+
+using BCsWithTimestamps = soa::Join<aod::BCs, aod::Timestamps>;
+using ColsWithEvSels = soa::Join<aod::Collisions, aod::EvSels>;
+using FullTracksIU = soa::Join<aod::TracksIU, aod::TracksExtra>;
+
+struct OccupancyTable {
+  Produces<aod::OccsInTimeWin> occsInTimeWin;
+  Service<o2::ccdb::BasicCCDBManager> ccdb;
+
+  Configurable<std::string> ccdbUrl{"ccdburl", "http://alice-ccdb.cern.ch", "The CCDB endpoint url address"};
+  Configurable<float> timeWindowMin{"timeWindowMin", -40.f, "Lower edge of the time window with respect to the collision (us)"};
+  Configurable<float> timeWindowMax{"timeWindowMax", 100.f, "Upper edge of the time window with respect to the collision (us)"};
+  Configurable<int> minITSClusters{"minITSClusters", 5, "Minimum number of ITS clusters of the PV contributors counted as ITS tracks"};
+
+  Preslice<FullTracksIU> perCollision = aod::track::collisionId;
+
+  int lastRun = -1;
+  int64_t bcSOR = -1;     // global bc of the start of the first orbit
+  int64_t nBCsPerTF = -1; // duration of TF in bcs, -1 if the TF borders are not known (e.g. MC not anchored)
+
+  // Per-BC quantities of the current data frame, the memory is reused
+  TimeOrderedPrefixSum<int> indexTracksITS;
+  TimeOrderedPrefixSum<int> indexTracksTPC;
+  TimeOrderedPrefixSum<int> indexColls;
+  TimeOrderedPrefixSum<double> indexFT0A;
+  TimeOrderedPrefixSum<double> indexFT0C;
+  std::vector<int64_t> vCollGlobalBC;
+  std::vector<int> vCollTracksITS;
+  std::vector<int> vCollTracksTPC;
+
+  void init(InitContext&)
+  {
+    ccdb->setURL(ccdbUrl);
+    ccdb->setCaching(true);
+    ccdb->setLocalObjectValidityChecking();
+  }
+
+  void setupRun(int run, uint64_t ts)
+  {
+    if (run == lastRun) {
+      return;
+    }
+    lastRun = run;
+    if (run < 500000) { // no TF information for non-anchored MC
+      bcSOR = 0;
+      nBCsPerTF = -1;
+      return;
+    }
+    EventSelectionParams* par = ccdb->getForTimeStamp<EventSelectionParams>("EventSelection/EventSelectionParams", ts);
+    // access orbit-reset timestamp
+    auto ctpx = ccdb->getForTimeStamp<std::vector<Long64_t>>("CTP/Calib/OrbitReset", ts);
+    int64_t tsOrbitReset = (*ctpx)[0]; // us
+    // access TF duration, start-of-run timestamp from ECS GRP
+    std::map<std::string, std::string> metadata;
+    metadata["runNumber"] = Form("%d", run);
+    auto grpecs = ccdb->getSpecific<o2::parameters::GRPECSObject>("GLO/Config/GRPECS", ts, metadata);
+    uint32_t nOrbitsPerTF = grpecs->getNHBFPerTF(); // assuming 1 orbit = 1 HBF
+    int64_t tsSOR = grpecs->getTimeStart();         // ms
+    // calculate SOR orbit and adjust it to the nearest TF edge, as in the event selection
+    int64_t orbitSOR = (tsSOR * 1000 - tsOrbitReset) / o2::constants::lhc::LHCOrbitMUS;
+    orbitSOR = orbitSOR / nOrbitsPerTF * nOrbitsPerTF + par->fTimeFrameOrbitShift;
+    bcSOR = orbitSOR * o2::constants::lhc::LHCMaxBunches;
+    nBCsPerTF = nOrbitsPerTF * o2::constants::lhc::LHCMaxBunches;
+    LOGP(info, "Occupancy for run {}: bcSOR = {}, nBCsPerTF = {}", run, bcSOR, nBCsPerTF);
+  }
+
+  void process(ColsWithEvSels const& cols, BCsWithTimestamps const& bcs, FullTracksIU const& tracks, aod::FT0s const& ft0s)
+  {
+    occsInTimeWin.reserve(cols.size());
+    if (cols.size() == 0) {
+      return;
+    }
+    setupRun(bcs.iteratorAt(0).runNumber(), bcs.iteratorAt(0).timestamp());
+
+    for (auto* index : {&indexTracksITS, &indexTracksTPC, &indexColls}) {
+      index->clear();
+      index->reserve(cols.size());
+    }
+    indexFT0A.clear();
+    indexFT0C.clear();
+    indexFT0A.reserve(ft0s.size());
+    indexFT0C.reserve(ft0s.size());
+    vCollGlobalBC.assign(cols.size(), 0);
+    vCollTracksITS.assign(cols.size(), 0);
+    vCollTracksTPC.assign(cols.size(), 0);
+
+    // index the collisions at their found BC with their PV contributors
+    for (auto const& col : cols) {
+      const int64_t globalBC = col.foundBCId() >= 0 ? bcs.iteratorAt(col.foundBCId()).globalBC() : bcs.iteratorAt(col.bcId()).globalBC();
+      int nTracksITS = 0;
+      int nTracksTPC = 0;
+      for (auto const& track : tracks.sliceBy(perCollision, col.globalIndex())) {
+        if (!track.isPVContributor()) {
+          continue;
+        }
+        nTracksITS += track.itsNCls() >= minITSClusters;
+        nTracksTPC += track.hasTPC();
+      }
+      const int64_t colIndex = col.globalIndex();
+      vCollGlobalBC[colIndex] = globalBC;
+      vCollTracksITS[colIndex] = nTracksITS;
+      vCollTracksTPC[colIndex] = nTracksTPC;
+      indexTracksITS.add(globalBC, nTracksITS);
+      indexTracksTPC.add(globalBC, nTracksTPC);
+      indexColls.add(globalBC, 1);
+    }
+
+    // index the FT0 amplitudes at their BC
+    for (auto const& ft0 : ft0s) {
+      const int64_t globalBC = bcs.iteratorAt(ft0.bcId()).globalBC();
+      float ampA = 0.f;
+      float ampC = 0.f;
+      for (auto const& amplitude : ft0.amplitudeA()) {
+        ampA += amplitude;
+      }
+      for (auto const& amplitude : ft0.amplitudeC()) {
+        ampC += amplitude;
+      }
+      indexFT0A.add(globalBC, ampA);
+      indexFT0C.add(globalBC, ampC);
+    }
+
+    indexTracksITS.build();
+    indexTracksTPC.build();
+    indexColls.build();
+    indexFT0A.build();
+    indexFT0C.build();
+
+    const double bcNS = o2::constants::lhc::LHCBunchSpacingNS;
+    const int64_t deltaBCMin = std::floor(timeWindowMin * 1e3 / bcNS);
+    const int64_t deltaBCMax = std::ceil(timeWindowMax * 1e3 / bcNS);
+    for (auto const& col : cols) {
+      const int64_t colIndex = col.globalIndex();
+      const int64_t globalBC = vCollGlobalBC[colIndex];
+      int64_t bcMin = globalBC + deltaBCMin;
+      int64_t bcMax = globalBC + deltaBCMax;
+      // the window is restricted to the time frame of the collision
+      bool isFullWindow = true;
+      if (nBCsPerTF > 0) {
+        const int64_t bcStartTF = bcSOR + (globalBC - bcSOR) / nBCsPerTF * nBCsPerTF;
+        const int64_t bcEndTF = bcStartTF + nBCsPerTF - 1;
+        isFullWindow = bcMin >= bcStartTF && bcMax <= bcEndTF;
+        bcMin = std::max(bcMin, bcStartTF);
+        bcMax = std::min(bcMax, bcEndTF);
+      }
+
+      // the collision itself and the signals of its BC are not counted
+      int nTracksITS = indexTracksITS.sum(bcMin, bcMax);
+      int nTracksTPC = indexTracksTPC.sum(bcMin, bcMax);
+      int nColls = indexColls.sum(bcMin, bcMax);
+      double ft0A = indexFT0A.sum(bcMin, bcMax);
+      double ft0C = indexFT0C.sum(bcMin, bcMax);
+      if (bcMin <= globalBC && globalBC <= bcMax) {
+        nTracksITS -= vCollTracksITS[colIndex];
+        nTracksTPC -= vCollTracksTPC[colIndex];
+        nColls -= 1;
+        ft0A -= indexFT0A.sum(globalBC, globalBC);
+        ft0C -= indexFT0C.sum(globalBC, globalBC);
+      }
+      occsInTimeWin(isFullWindow, nTracksITS, nTracksTPC, nColls, ft0A, ft0C);
+    }
+  }
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  return WorkflowSpec{adaptAnalysisTask<OccupancyTable>(cfgc)};
+}
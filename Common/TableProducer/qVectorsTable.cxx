@@ -111,6 +111,8 @@ struct qVectorsTable {
   // geometry instances for V0 and T0
   o2::fv0::Geometry* fv0geom;
   o2::ft0::Geometry ft0geom;
+  std::vector<int> chIdsDet{};  // Channels of the detector being processed.
+  std::vector<float> amplDet{}; // Gain-corrected amplitudes of these channels.
 
   // Variables for other classes.
   EventPlaneHelper helperEP;
@@ -121,6 +123,14 @@ struct qVectorsTable {
 
   TH3F* objQvec = nullptr;
 
+  // Correction constants of the current run, cached from objQvec as
+  // [(centBin * nDetectors + iDet) * kNCorrConsts + iConst], with the detectors in the
+  // iteration order of useDetector.
+  static constexpr int kNCentBinsCorr = 80;
+  static constexpr int kNCorrConsts = 6;
+  std::vector<float> corrConsts{};
+  std::vector<bool> corrUseDetector{}; // useDetector values, in the iteration order of useDetector.
+
   std::unordered_map<string, bool> useDetector = {
     {"QvectorBNegs", cfgUseBNeg},
     {"QvectorBPoss", cfgUseBPos},
@@ -153,6 +163,9 @@ struct qVectorsTable {
 
   // Exit point in case all detectors are being used.
   allDetectorsInUse:
+    for (auto const& det : useDetector) {
+      corrUseDetector.push_back(det.second);
+    }
     // Setup the access to the CCDB objects of interest.
     ccdb->setURL(cfgCcdbParam.cfgURL);
     ccdb->setCaching(true);
@@ -204,11 +217,27 @@ struct qVectorsTable {
     } else {
       LOGF(fatal, "Could not get the alignment parameters for FV0.");
     }
+    // The channel azimuthal angles depend on the offsets, so the tables are rebuilt here.
+    helperEP.BuildChannelTables(ft0geom, fv0geom, harmonics);
 
     fullPath = cfgQvecCalibPath;
     fullPath += "/v";
     fullPath += std::to_string(harmonics);
     objQvec = ccdb->getForTimeStamp<TH3F>(fullPath, timestamp);
+    // Cache the correction constants for the run, to avoid the histogram lookups per event.
+    const int nDetectors = corrUseDetector.size();
+    corrConsts.assign(kNCentBinsCorr * nDetectors * kNCorrConsts, 0.);
+    if (objQvec != nullptr) {
+      for (int iCent = 0; iCent < kNCentBinsCorr; iCent++) {
+        for (int iDet = 0; iDet < nDetectors; iDet++) {
+          for (int iConst = 0; iConst < kNCorrConsts; iConst++) {
+            corrConsts[(iCent * nDetectors + iDet) * kNCorrConsts + iConst] = objQvec->GetBinContent(iCent + 1, iConst + 1, iDet + 1);
+          }
+        }
+      }
+    } else {
+      LOGF(warning, "Could not get the Q-vector corrections from %s, no correction applied.", fullPath.data());
+    }
 
     fullPath = cfgGainEqPath;
     fullPath += "/FT0";
@@ -313,6 +342,8 @@ struct qVectorsTable {
       if (useDetector["QvectorFT0As"]) {
         // Iterate over the non-dead channels for FT0-A to get the total Q-vector
         // and sum of amplitudes.
+        chIdsDet.clear();
+        amplDet.clear();
         for (std::size_t iChA = 0; iChA < ft0.channelA().size(); iChA++) {
           // Get first the corresponding amplitude.
           float ampl = ft0.amplitudeA()[iChA];
@@ -320,11 +351,13 @@ struct qVectorsTable {
 
           histosQA.fill(HIST("FT0Amp"), ampl, FT0AchId);
           histosQA.fill(HIST("FT0AmpCor"), ampl / FT0RelGainConst[FT0AchId], FT0AchId);
-          // Update the Q-vector and sum of amplitudes using the helper function.
-          // LOKI: Note this assumes nHarmo = 2!! Likely generalise in the future.
-          helperEP.SumQvectors(0, FT0AchId, ampl / FT0RelGainConst[FT0AchId], cfgnMod, QvecDet, sumAmplFT0A, ft0geom, fv0geom);
-          helperEP.SumQvectors(0, FT0AchId, ampl / FT0RelGainConst[FT0AchId], cfgnMod, QvecFT0M, sumAmplFT0M, ft0geom, fv0geom);
+          chIdsDet.push_back(FT0AchId);
+          amplDet.push_back(ampl / FT0RelGainConst[FT0AchId]);
         } // Go to the next channel iChA.
+        // Update the Q-vector and sum of amplitudes using the helper function.
+        // LOKI: Note this assumes nHarmo = 2!! Likely generalise in the future.
+        helperEP.SumQvectors(0, chIdsDet, amplDet, cfgnMod, QvecDet, sumAmplFT0A);
+        helperEP.SumQvectors(0, chIdsDet, amplDet, cfgnMod, QvecFT0M, sumAmplFT0M);
 
         // Set the Qvectors for FT0A with the normalised Q-vector values if the sum of
         // amplitudes is non-zero. Otherwise, set it to a dummy 999.
@@ -346,6 +379,8 @@ struct qVectorsTable {
         // Repeat the procedure with FT0-C for the found FT0.
         // Start by resetting to zero the intermediate quantities.
         QvecDet = TComplex(0., 0.);
+        chIdsDet.clear();
+        amplDet.clear();
         for (std::size_t iChC = 0; iChC < ft0.channelC().size(); iChC++) {
           // iChC ranging from 0 to max 112. We need to add 96 (= max channels in FT0-A)
           // to ensure a proper channel number in FT0 as a whole.
@@ -354,10 +389,11 @@ struct qVectorsTable {
 
           histosQA.fill(HIST("FT0Amp"), ampl, FT0CchId);
           histosQA.fill(HIST("FT0AmpCor"), ampl / FT0RelGainConst[FT0CchId], FT0CchId);
-
-          helperEP.SumQvectors(0, FT0CchId, ampl / FT0RelGainConst[FT0CchId], cfgnMod, QvecDet, sumAmplFT0C, ft0geom, fv0geom);
-          helperEP.SumQvectors(0, FT0CchId, ampl / FT0RelGainConst[FT0CchId], cfgnMod, QvecFT0M, sumAmplFT0M, ft0geom, fv0geom);
+          chIdsDet.push_back(FT0CchId);
+          amplDet.push_back(ampl / FT0RelGainConst[FT0CchId]);
         }
+        helperEP.SumQvectors(0, chIdsDet, amplDet, cfgnMod, QvecDet, sumAmplFT0C);
+        helperEP.SumQvectors(0, chIdsDet, amplDet, cfgnMod, QvecFT0M, sumAmplFT0M);
 
         if (sumAmplFT0C > 1e-8) {
           QvecDet /= sumAmplFT0C;
@@ -395,14 +431,17 @@ struct qVectorsTable {
     if (coll.has_foundFV0() && useDetector["QvectorFV0As"]) {
       auto fv0 = coll.foundFV0();
 
+      chIdsDet.clear();
+      amplDet.clear();
       for (std::size_t iCh = 0; iCh < fv0.channel().size(); iCh++) {
         float ampl = fv0.amplitude()[iCh];
         int FV0AchId = fv0.channel()[iCh];
         histosQA.fill(HIST("FV0Amp"), ampl, FV0AchId);
         histosQA.fill(HIST("FV0AmpCor"), ampl / FV0RelGainConst[FV0AchId], FV0AchId);
-
-        helperEP.SumQvectors(1, FV0AchId, ampl / FV0RelGainConst[FV0AchId], cfgnMod, QvecDet, sumAmplFV0A, ft0geom, fv0geom);
+        chIdsDet.push_back(FV0AchId);
+        amplDet.push_back(ampl / FV0RelGainConst[FV0AchId]);
       }
+      helperEP.SumQvectors(1, chIdsDet, amplDet, cfgnMod, QvecDet, sumAmplFV0A);
 
       if (sumAmplFV0A > 1e-8) {
         QvecDet /= sumAmplFV0A;
@@ -420,6 +459,9 @@ struct qVectorsTable {
 
     int nTrkBPos = 0;
     int nTrkBNeg = 0;
+    const int nMod = cfgnMod;
+    const bool useBPos = useDetector["QvectorBPoss"];
+    const bool useBNeg = useDetector["QvectorBNegs"];
 
     for (auto& trk : tracks) {
       if (!SelTrack(trk)) {
@@ -429,14 +471,14 @@ struct qVectorsTable {
       if (std::abs(trk.eta()) < 0.1 || std::abs(trk.eta()) > 0.8) {
         continue;
       }
-      if (trk.eta() > 0 && useDetector["QvectorBPoss"]) {
-        qVectBPos[0] += trk.pt() * std::cos(trk.phi() * cfgnMod);
-        qVectBPos[1] += trk.pt() * std::sin(trk.phi() * cfgnMod);
+      if (trk.eta() > 0 && useBPos) {
+        qVectBPos[0] += trk.pt() * std::cos(trk.phi() * nMod);
+        qVectBPos[1] += trk.pt() * std::sin(trk.phi() * nMod);
         TrkBPosLabel.push_back(trk.globalIndex());
         nTrkBPos++;
-      } else if (trk.eta() < 0 && useDetector["QvectorBNegs"]) {
-        qVectBNeg[0] += trk.pt() * std::cos(trk.phi() * cfgnMod);
-        qVectBNeg[1] += trk.pt() * std::sin(trk.phi() * cfgnMod);
+      } else if (trk.eta() < 0 && useBNeg) {
+        qVectBNeg[0] += trk.pt() * std::cos(trk.phi() * nMod);
+        qVectBNeg[1] += trk.pt() * std::sin(trk.phi() * nMod);
         TrkBNegLabel.push_back(trk.globalIndex());
         nTrkBNeg++;
       }
@@ -491,29 +533,24 @@ struct qVectorsTable {
     qvecAmp.push_back(static_cast<float>(nTrkBNeg));
 
     if (cent < 80) {
-      int i = 0;
-      for (auto det : useDetector) {
+      // Apply the cached corrections of the run: recentering for the level 1,
+      // recentering and twist for the level 2, and all of them for the level 3.
+      const int nDetectors = corrUseDetector.size();
+      for (int i = 0; i < nDetectors; i++) {
         // Check whether Q-vectors are found for a detector
-        if (!useDetector[det.first.data()]) {
-          i++;
+        if (!corrUseDetector[i]) {
           continue;
         }
-
-        helperEP.DoRecenter(qvecRe[i * 4 + 1], qvecIm[i * 4 + 1],
-                            objQvec->GetBinContent(static_cast<int>(cent) + 1, 1, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 2, i + 1));
-
-        helperEP.DoRecenter(qvecRe[i * 4 + 2], qvecIm[i * 4 + 2],
-                            objQvec->GetBinContent(static_cast<int>(cent) + 1, 1, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 2, i + 1));
-        helperEP.DoTwist(qvecRe[i * 4 + 2], qvecIm[i * 4 + 2],
-                         objQvec->GetBinContent(static_cast<int>(cent) + 1, 3, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 4, i + 1));
-
-        helperEP.DoRecenter(qvecRe[i * 4 + 3], qvecIm[i * 4 + 3],
-                            objQvec->GetBinContent(static_cast<int>(cent) + 1, 1, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 2, i + 1));
-        helperEP.DoTwist(qvecRe[i * 4 + 3], qvecIm[i * 4 + 3],
-                         objQvec->GetBinContent(static_cast<int>(cent) + 1, 3, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 4, i + 1));
-        helperEP.DoRescale(qvecRe[i * 4 + 3], qvecIm[i * 4 + 3],
-                           objQvec->GetBinContent(static_cast<int>(cent) + 1, 5, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 6, i + 1));
-        i++;
+        const float* corr = &corrConsts[(static_cast<int>(cent) * nDetectors + i) * kNCorrConsts];
+        for (int level = 1; level <= 3; level++) {
+          helperEP.DoRecenter(qvecRe[i * 4 + level], qvecIm[i * 4 + level], corr[0], corr[1]);
+          if (level >= 2) {
+            helperEP.DoTwist(qvecRe[i * 4 + level], qvecIm[i * 4 + level], corr[2], corr[3]);
+          }
+          if (level >= 3) {
+            helperEP.DoRescale(qvecRe[i * 4 + level], qvecIm[i * 4 + level], corr[4], corr[5]);
+          }
+        }
       }
     }
 
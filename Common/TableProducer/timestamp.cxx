@@ -16,8 +16,10 @@
 /// \brief  A task to fill the timestamp table from run number.
 ///         Uses headers from CCDB
 ///
-#include <vector>
+#include <fstream>
 #include <map>
+#include <string>
+#include <vector>
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
 #include "CCDB/BasicCCDBManager.h"
@@ -29,10 +31,18 @@ using namespace o2::header;
 using namespace o2;
 
 struct TimestampTask {
+  /// Run information cached per run number
+  struct RunInfo {
+    int64_t sorTimestamp = 0;            /// Start-of-run timestamp in ms
+    int64_t eorTimestamp = 0;            /// End-of-run timestamp in ms
+    int64_t ctpOrbitResetTimestamp = -1; /// Orbit-reset timestamp from the CTP object in us, -1 if not yet queried
+  };
+
   Produces<aod::Timestamps> timestampTable;  /// Table with SOR timestamps produced by the task
   Service<o2::ccdb::BasicCCDBManager> ccdb;  /// CCDB manager to access orbit-reset timestamp
   o2::ccdb::CcdbApi ccdb_api;                /// API to access CCDB headers
   std::map<int, int64_t> mapRunToOrbitReset; /// Cache of orbit reset timestamps
+  std::map<int, RunInfo> mapRunToInfo;       /// Cache of the run information, also stored on disk if enabled
   int lastRunNumber = 0;                     /// Last run number processed
   int64_t orbitResetTimestamp = 0;           /// Orbit-reset timestamp in us
 
@@ -42,6 +52,7 @@ struct TimestampTask {
   Configurable<std::string> orbit_reset_path{"orbit-reset-path", "CTP/Calib/OrbitReset", "path to the ccdb orbit-reset objects"};
   Configurable<std::string> url{"ccdb-url", "http://alice-ccdb.cern.ch", "URL of the CCDB database"};
   Configurable<bool> isRun2MC{"isRun2MC", false, "Running mode: enable only for Run 2 MC. Timestamps are set to SOR timestamp"};
+  Configurable<std::string> cacheFile{"cache-file", "", "file to cache SOR, EOR and orbit-reset timestamps across jobs of the same node, disabled if empty"};
 
   void init(o2::framework::InitContext&)
   {
@@ -51,20 +62,63 @@ struct TimestampTask {
     if (!ccdb_api.isHostReachable()) {
       LOGF(fatal, "CCDB host %s is not reacheable, cannot go forward", url.value.data());
     }
+    readCacheFile();
+  }
+
+  /// Reads the run information stored on disk by previous jobs
+  /// Each line of the file contains: run number, SOR (ms), EOR (ms), CTP orbit reset (us)
+  void readCacheFile()
+  {
+    if (cacheFile.value.empty()) {
+      return;
+    }
+    std::ifstream file(cacheFile.value);
+    if (!file.is_open()) {
+      LOGF(info, "Timestamp cache file %s not found, it will be created", cacheFile.value.data());
+      return;
+    }
+    int runNumber = 0;
+    RunInfo info;
+    while (file >> runNumber >> info.sorTimestamp >> info.eorTimestamp >> info.ctpOrbitResetTimestamp) {
+      mapRunToInfo[runNumber] = info;
+    }
+    LOGF(info, "Read %zu runs from timestamp cache file %s", mapRunToInfo.size(), cacheFile.value.data());
+  }
+
+  /// Appends the run information to the file on disk
+  void writeCacheFile(int runNumber, const RunInfo& info)
+  {
+    if (cacheFile.value.empty()) {
+      return;
+    }
+    // one line per write, so that concurrent jobs appending to the same file do not interleave entries
+    std::ofstream file(cacheFile.value, std::ios::app);
+    if (!file.is_open()) {
+      LOGF(warning, "Cannot write timestamp cache file %s", cacheFile.value.data());
+      return;
+    }
+    file << (std::to_string(runNumber) + " " + std::to_string(info.sorTimestamp) + " " + std::to_string(info.eorTimestamp) + " " + std::to_string(info.ctpOrbitResetTimestamp) + "\n") << std::flush;
   }
 
-  void process(aod::BC const& bc)
+  /// Sets the orbit-reset timestamp for a run number
+  /// This is done with caching if the run number was already processed before.
+  /// If not the SOR/EOR are taken from the disk cache or queried from CCDB and the orbit-reset timestamp is computed and added to the cache
+  void setOrbitResetTimestamp(int runNumber)
   {
-    int runNumber = bc.runNumber();
-    // We need to set the orbit-reset timestamp for the run number.
-    // This is done with caching if the run number was already processed before.
-    // If not the orbit-reset timestamp for the run number is queried from CCDB and added to the cache
     if (runNumber == lastRunNumber) { // The run number coincides to the last run processed
       LOGF(debug, "Using orbit-reset timestamp from last call");
-    } else if (mapRunToOrbitReset.count(runNumber)) { // The run number was already requested before: getting it from cache!
+      return;
+    }
+    lastRunNumber = runNumber;
+    if (mapRunToOrbitReset.count(runNumber)) { // The run number was already requested before: getting it from cache!
       LOGF(debug, "Getting orbit-reset timestamp from cache");
       orbitResetTimestamp = mapRunToOrbitReset[runNumber];
-    } else { // The run was not requested before: need to acccess CCDB!
+      return;
+    }
+
+    bool updateCacheFile = false;
+    auto infoIt = mapRunToInfo.find(runNumber);
+    if (infoIt == mapRunToInfo.end()) { // The run was not requested before: need to acccess CCDB!
       LOGF(debug, "Getting start-of-run and end-of-run timestamps from CCDB");
       std::map<std::string, std::string> metadata, headers;
       const std::string run_path = Form("%s/%i", rct_path.value.data(), runNumber);
@@ -75,41 +129,68 @@ struct TimestampTask {
       if (headers.count("EOR") == 0) {
         LOGF(fatal, "Cannot find end-of-run timestamp for run number in path '%s'.", run_path.data());
       }
+      RunInfo info;
+      info.sorTimestamp = atol(headers["SOR"].c_str()); // timestamp of the SOR in ms
+      info.eorTimestamp = atol(headers["EOR"].c_str()); // timestamp of the EOR in ms
+      infoIt = mapRunToInfo.emplace(runNumber, info).first;
+      updateCacheFile = true;
+    } else {
+      LOGF(debug, "Getting start-of-run and end-of-run timestamps from cache file");
+    }
+    RunInfo& info = infoIt->second;
 
-      int64_t sorTimestamp = atol(headers["SOR"].c_str()); // timestamp of the SOR in ms
-      int64_t eorTimestamp = atol(headers["EOR"].c_str()); // timestamp of the EOR in ms
-
-      bool isUnanchoredRun3MC = runNumber >= 300000 && runNumber < 500000;
-      if (isRun2MC || isUnanchoredRun3MC) {
-        // isRun2MC: bc/orbit distributions are not simulated in Run2 MC. All bcs are set to 0.
-        // isUnanchoredRun3MC: assuming orbit-reset is done in the beginning of each run
-        // Setting orbit-reset timestamp to start-of-run timestamp
-        orbitResetTimestamp = sorTimestamp * 1000; // from ms to us
-      } else if (runNumber < 300000) {             // Run 2
-        LOGF(debug, "Getting orbit-reset timestamp using start-of-run timestamp from CCDB");
-        auto ctp = ccdb->getForTimeStamp<std::vector<Long64_t>>(orbit_reset_path.value.data(), sorTimestamp);
-        orbitResetTimestamp = (*ctp)[0];
-      } else {
-        // sometimes orbit is reset after SOR. Using EOR timestamps for orbitReset query is more reliable
-        LOGF(debug, "Getting orbit-reset timestamp using end-of-run timestamp from CCDB");
-        auto ctp = ccdb->getForTimeStamp<std::vector<Long64_t>>(orbit_reset_path.value.data(), eorTimestamp);
-        orbitResetTimestamp = (*ctp)[0];
-      }
-
-      // Adding the timestamp to the cache map
-      std::pair<std::map<int, int64_t>::iterator, bool> check;
-      check = mapRunToOrbitReset.insert(std::pair<int, int64_t>(runNumber, orbitResetTimestamp));
-      if (!check.second) {
-        LOGF(fatal, "Run number %i already existed with a orbit-reset timestamp of %llu", runNumber, check.first->second);
+    bool isUnanchoredRun3MC = runNumber >= 300000 && runNumber < 500000;
+    if (isRun2MC || isUnanchoredRun3MC) {
+      // isRun2MC: bc/orbit distributions are not simulated in Run2 MC. All bcs are set to 0.
+      // isUnanchoredRun3MC: assuming orbit-reset is done in the beginning of each run
+      // Setting orbit-reset timestamp to start-of-run timestamp
+      orbitResetTimestamp = info.sorTimestamp * 1000; // from ms to us
+    } else {
+      if (info.ctpOrbitResetTimestamp < 0) {
+        if (runNumber < 300000) { // Run 2
+          LOGF(debug, "Getting orbit-reset timestamp using start-of-run timestamp from CCDB");
+          auto ctp = ccdb->getForTimeStamp<std::vector<Long64_t>>(orbit_reset_path.value.data(), info.sorTimestamp);
+          info.ctpOrbitResetTimestamp = (*ctp)[0];
+        } else {
+          // sometimes orbit is reset after SOR. Using EOR timestamps for orbitReset query is more reliable
+          LOGF(debug, "Getting orbit-reset timestamp using end-of-run timestamp from CCDB");
+          auto ctp = ccdb->getForTimeStamp<std::vector<Long64_t>>(orbit_reset_path.value.data(), info.eorTimestamp);
+          info.ctpOrbitResetTimestamp = (*ctp)[0];
+        }
+        updateCacheFile = true;
       }
-      LOGF(info, "Add new run number %i with orbit-reset timestamp %llu to cache", runNumber, orbitResetTimestamp);
+      orbitResetTimestamp = info.ctpOrbitResetTimestamp;
+    }
+    if (updateCacheFile) {
+      writeCacheFile(runNumber, info);
     }
 
-    if (verbose.value) {
-      LOGF(info, "Orbit-reset timestamp for run number %i found: %llu us", runNumber, orbitResetTimestamp);
+    // Adding the timestamp to the cache map
+    std::pair<std::map<int, int64_t>::iterator, bool> check;
+    check = mapRunToOrbitReset.insert(std::pair<int, int64_t>(runNumber, orbitResetTimestamp));
+    if (!check.second) {
+      LOGF(fatal, "Run number %i already existed with a orbit-reset timestamp of %llu", runNumber, check.first->second);
     }
+    LOGF(info, "Add new run number %i with orbit-reset timestamp %llu to cache", runNumber, orbitResetTimestamp);
+  }
 
-    timestampTable((orbitResetTimestamp + int64_t(bc.globalBC() * o2::constants::lhc::LHCBunchSpacingNS * 1e-3)) / 1000); // us -> ms
+  void process(aod::BCs const& bcs)
+  {
+    timestampTable.reserve(bcs.size());
+    // BCs come in blocks of the same run number: the orbit-reset timestamp is resolved once per block
+    bool firstBC = true;
+    int runNumber = 0;
+    for (const auto& bc : bcs) {
+      if (firstBC || bc.runNumber() != runNumber) {
+        firstBC = false;
+        runNumber = bc.runNumber();
+        setOrbitResetTimestamp(runNumber);
+        if (verbose.value) {
+          LOGF(info, "Orbit-reset timestamp for run number %i found: %llu us", runNumber, orbitResetTimestamp);
+        }
+      }
+      timestampTable((orbitResetTimestamp + int64_t(bc.globalBC() * o2::constants::lhc::LHCBunchSpacingNS * 1e-3)) / 1000); // us -> ms
+    }
   }
 };
 
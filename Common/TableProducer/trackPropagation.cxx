@@ -13,8 +13,20 @@
 // Task to add a table of track parameters propagated to the primary vertex
 //
 
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 #include "TableHelper.h"
+#include "Common/Core/RunConditions.h"
+#include "Common/Core/TrackSelection.h"
+#include "Common/Core/TrackSelectionBatch.h"
+#include "Common/Core/TrackSelectionDefaults.h"
+#include "Common/DataModel/TrackSelectionTables.h"
 #include "Common/Tools/TrackTuner.h"
+#include "CommonConstants/MathConstants.h"
 
 // The Run 3 AO2D stores the tracks at the point of innermost update. For a track with ITS this is the innermost (or second innermost)
 // ITS layer. For a track without ITS, this is the TPC inner wall or for loopers in the TPC even a radius beyond that.
@@ -23,6 +35,8 @@
 //
 // This task is not needed for Run 2 converted data.
 // There are two versions of the task (see process flags), one producing also the covariance matrix and the other only the tracks table.
+// The processes "WithTrackSelection" also produce the TrackSelection and TrackSelectionExtension tables of the trackselection task
+// (Run 3 selections) from the propagated tracks, in the same loop, so that the trackselection task is not needed in the workflow.
 
 using namespace o2;
 using namespace o2::framework;
@@ -40,17 +54,20 @@ struct TrackPropagation {
 
   Produces<aod::TrackTunerTable> tunertable;
 
+  Produces<aod::TrackSelection> filterTable;
+  Produces<aod::TrackSelectionExtension> filterTableDetail;
+
   Service<o2::ccdb::BasicCCDBManager> ccdb;
 
   bool fillTracksDCA = false;
   bool fillTracksDCACov = false;
-  int runNumber = -1;
+  bool fillTrackSelection = false;
+  bool fillTrackSelectionExtension = false;
 
   o2::base::Propagator::MatCorrType matCorr = o2::base::Propagator::MatCorrType::USEMatCorrLUT;
 
   const o2::dataformats::MeanVertexObject* mMeanVtx = nullptr;
-  o2::parameters::GRPMagField* grpmag = nullptr;
-  o2::base::MatLayerCylSet* lut = nullptr;
+  RunConditions runConditions; // magnetic field, mean vertex and shared material LUT of the current run
   TrackTuner trackTunerObj;
 
   Configurable<std::string> ccdburl{"ccdb-url", "http://alice-ccdb.cern.ch", "url of the ccdb repository"};
@@ -58,11 +75,30 @@ struct TrackPropagation {
   Configurable<std::string> geoPath{"geoPath", "GLO/Config/GeometryAligned", "Path of the geometry file"};
   Configurable<std::string> grpmagPath{"grpmagPath", "GLO/Config/GRPMagField", "CCDB path of the GRPMagField object"};
   Configurable<std::string> mVtxPath{"mVtxPath", "GLO/Calib/MeanVertex", "Path of the mean vertex file"};
+  Configurable<std::vector<int>> ccdbPrefetchRuns{"ccdbPrefetchRuns", {}, "Runs of the job in processing order, the CCDB objects of the next run are prefetched in the background (empty: no prefetching)"};
+  Configurable<bool> useBatchPropagation{"useBatchPropagation", false, "Propagate all tracks of the time frame in one batch before filling the tables (data only)"};
+  Configurable<int> nThreadsPropagation{"nThreadsPropagation", 1, "Number of threads for the batch propagation, use >1 only with a thread-safe field map"};
+  // fast path: material budget from a precomputed eta-r table and propagation without material integration
+  Configurable<bool> useFastPropagation{"useFastPropagation", false, "Use the tabulated material budget and no material integration for tracks starting below fastPathMaxRadius"};
+  Configurable<float> fastPathMaxRadius{"fastPathMaxRadius", 3.f, "Maximum starting radius (cm) of the tracks using the fast propagation path"};
+  Configurable<int> fastPathNBinsEta{"fastPathNBinsEta", 40, "Number of eta bins of the fast-path material table in |eta| < fastPathMaxEta"};
+  Configurable<float> fastPathMaxEta{"fastPathMaxEta", 2.f, "Maximum |eta| of the fast-path material table, tracks above use the full path"};
+  Configurable<int> fastPathNBinsR{"fastPathNBinsR", 30, "Number of radial bins of the fast-path material table"};
+  Configurable<bool> fastPathQA{"fastPathQA", false, "Also run the full propagation for fast-path tracks and fill the DCA difference histograms (sequential mode only)"};
   Configurable<float> minPropagationRadius{"minPropagationDistance", o2::constants::geom::XTPCInnerRef + 0.1, "Only tracks which are at a smaller radius will be propagated, defaults to TPC inner wall"};
   // for TrackTuner only (MC smearing)
   Configurable<bool> useTrackTuner{"useTrackTuner", false, "Apply track tuner corrections to MC"};
   Configurable<bool> fillTrackTunerTable{"fillTrackTunerTable", false, "flag to fill track tuner table"};
   Configurable<std::string> trackTunerParams{"trackTunerParams", "debugInfo=0|updateTrackDCAs=1|updateTrackCovMat=1|updateCurvature=0|updateCurvatureIU=0|updatePulls=0|isInputFileFromCCDB=1|pathInputFile=Users/m/mfaggin/test/inputsTrackTuner/PbPb2022|nameInputFile=trackTuner_DataLHC22sPass5_McLHC22l1b2_run529397.root|pathFileQoverPt=Users/h/hsharma/qOverPtGraphs|nameFileQoverPt=D0sigma_Data_removal_itstps_MC_LHC22b1b.root|usePvRefitCorrections=0|qOverPtMC=-1.|qOverPtData=-1.", "TrackTuner parameter initialization (format: <name>=<value>|<name>=<value>)"};
+  // for the processes with the track selection only, same cuts as the trackselection task with isRun3
+  struct : ConfigurableGroup {
+    Configurable<int> itsMatching{"trackSelItsMatching", 1, "condition for ITS matching (1: Run3ITSibAny, 2: Run3ITSallAny, 3: Run3ITSall7Layers, 4: Run3ITSibFirst)"};
+    Configurable<int> dcaSetup{"trackSelDcaSetup", 0, "dca setup: (0: default, 1: ppPass3)"};
+    Configurable<float> ptMin{"trackSelPtMin", 0.1f, "Lower cut on pt for the track selected"};
+    Configurable<float> ptMax{"trackSelPtMax", 1e10f, "Upper cut on pt for the track selected"};
+    Configurable<float> etaMin{"trackSelEtaMin", -0.8, "Lower cut on eta for the track selected"};
+    Configurable<float> etaMax{"trackSelEtaMax", 0.8, "Upper cut on eta for the track selected"};
+  } cfgTrackSel;
   ConfigurableAxis axisPtQA{"axisPtQA", {VARIABLE_WIDTH, 0.0f, 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f, 0.9f, 1.0f, 1.1f, 1.2f, 1.3f, 1.4f, 1.5f, 1.6f, 1.7f, 1.8f, 1.9f, 2.0f, 2.2f, 2.4f, 2.6f, 2.8f, 3.0f, 3.2f, 3.4f, 3.6f, 3.8f, 4.0f, 4.4f, 4.8f, 5.2f, 5.6f, 6.0f, 6.5f, 7.0f, 7.5f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 17.0f, 19.0f, 21.0f, 23.0f, 25.0f, 30.0f, 35.0f, 40.0f, 50.0f}, "pt axis for QA histograms"};
   OutputObj<TH1D> trackTunedTracks{TH1D("trackTunedTracks", "", 1, 0.5, 1.5), OutputObjHandlingPolicy::AnalysisObject};
 
@@ -98,18 +134,36 @@ struct TrackPropagation {
       LOG(info) << "Enabling processCovarianceWithPID";
       nEnabledProcesses++;
     }
+    if (doprocessStandardWithTrackSelection) {
+      LOG(info) << "Enabling processStandardWithTrackSelection";
+      nEnabledProcesses++;
+    }
+    if (doprocessCovarianceWithTrackSelection) {
+      LOG(info) << "Enabling processCovarianceWithTrackSelection";
+      nEnabledProcesses++;
+    }
     if (nEnabledProcesses != 1) {
       LOG(fatal) << "Exactly one process flag must be set to true. Please choose one.";
     }
     // Checking if the tables are requested in the workflow and enabling them
     fillTracksDCA = isTableRequiredInWorkflow(initContext, "TracksDCA");
     fillTracksDCACov = isTableRequiredInWorkflow(initContext, "TracksDCACov");
+    if (doprocessStandardWithTrackSelection || doprocessCovarianceWithTrackSelection) {
+      fillTrackSelection = isTableRequiredInWorkflow(initContext, "TrackSelection");
+      fillTrackSelectionExtension = isTableRequiredInWorkflow(initContext, "TrackSelectionExtension");
+      initTrackSelections();
+    }
 
     ccdb->setURL(ccdburl);
     ccdb->setCaching(true);
     ccdb->setLocalObjectValidityChecking();
 
-    lut = o2::base::MatLayerCylSet::rectifyPtrFromFile(ccdb->get<o2::base::MatLayerCylSet>(lutPath));
+    runConditions.setGrpMagPath(grpmagPath);
+    runConditions.setMeanVertexPath(mVtxPath);
+    runConditions.setLutPath(lutPath);
+    if (!ccdbPrefetchRuns.value.empty()) {
+      runConditions.setPrefetchRuns(ccdbPrefetchRuns.value);
+    }
     // Histograms for track tuner
     AxisSpec axisBinsDCA = {600, -0.15f, 0.15f, "#it{dca}_{xy} (cm)"};
     registry.add("hDCAxyVsPtRec", "hDCAxyVsPtRec", kTH2F, {axisBinsDCA, axisPtQA});
@@ -117,6 +171,22 @@ struct TrackPropagation {
     registry.add("hDCAzVsPtRec", "hDCAzVsPtRec", kTH2F, {axisBinsDCA, axisPtQA});
     registry.add("hDCAzVsPtMC", "hDCAzVsPtMC", kTH2F, {axisBinsDCA, axisPtQA});
 
+    // Histograms for the fast propagation path
+    if (useFastPropagation) {
+      auto hPath = registry.add<TH1>("hPropagationPath", "hPropagationPath", kTH1D, {{3, 0.5, 3.5}});
+      hPath->GetXaxis()->SetBinLabel(1, "not propagated");
+      hPath->GetXaxis()->SetBinLabel(2, "full path");
+      hPath->GetXaxis()->SetBinLabel(3, "fast path");
+      if (fastPathQA) {
+        AxisSpec axisDeltaDCA = {400, -0.01f, 0.01f, "#it{dca}_{fast} - #it{dca}_{full} (cm)"};
+        AxisSpec axisPullDCA = {400, -1.f, 1.f, "(#it{dca}_{fast} - #it{dca}_{full}) / #sigma_{full}"};
+        registry.add("hFastPathDeltaDCAxyVsPt", "hFastPathDeltaDCAxyVsPt", kTH2F, {axisDeltaDCA, axisPtQA});
+        registry.add("hFastPathDeltaDCAzVsPt", "hFastPathDeltaDCAzVsPt", kTH2F, {axisDeltaDCA, axisPtQA});
+        registry.add("hFastPathPullDCAxyVsPt", "hFastPathPullDCAxyVsPt", kTH2F, {axisPullDCA, axisPtQA});
+        registry.add("hFastPathPullDCAzVsPt", "hFastPathPullDCAzVsPt", kTH2F, {axisPullDCA, axisPtQA});
+      }
+    }
+
     /// TrackTuner initialization
     if (useTrackTuner) {
       std::string outputStringParams = trackTunerObj.configParams(trackTunerParams);
@@ -129,17 +199,104 @@ struct TrackPropagation {
     }
   }
 
+  // track selections of the trackselection task for Run 3, evaluated on the propagated tracks
+  TrackSelectionBatch selections;
+  enum SelectionIndex { kGlobalTracks = 0,
+                        kFiltBit1,
+                        kFiltBit2,
+                        kFiltBit3,
+                        kFiltBit4,
+                        kFiltBit5 };
+
+  void initTrackSelections()
+  {
+    TrackSelection globalTracks;
+    switch (cfgTrackSel.itsMatching) {
+      case 0: // Run 2 SPD kAny, replaced by Run3ITSibAny for Run 3 as in the trackselection task
+      case 1:
+        globalTracks = getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibAny, cfgTrackSel.dcaSetup);
+        break;
+      case 2:
+        globalTracks = getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSallAny, cfgTrackSel.dcaSetup);
+        break;
+      case 3:
+        globalTracks = getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSall7Layers, cfgTrackSel.dcaSetup);
+        break;
+      case 4:
+        globalTracks = getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibFirst, cfgTrackSel.dcaSetup);
+        break;
+      default:
+        LOG(fatal) << "Track selection with undefined cuts. Fix it!";
+        break;
+    }
+    globalTracks.SetPtRange(cfgTrackSel.ptMin, cfgTrackSel.ptMax);
+    globalTracks.SetEtaRange(cfgTrackSel.etaMin, cfgTrackSel.etaMax);
+    globalTracks.SetTrackType(o2::aod::track::TrackTypeEnum::Track); // Requiring that this is a Run 3 track
+    globalTracks.print();
+
+    // same order as SelectionIndex
+    selections.AddSelection(globalTracks);
+    selections.AddSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibAny));
+    selections.AddSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibTwo));
+    selections.AddSelection(getGlobalTrackSelectionRun3HF());
+    selections.AddSelection(getGlobalTrackSelectionRun3Nuclei());
+    selections.AddSelection(getJEGlobalTrackSelectionRun2());
+  }
+
+  /// Evaluates the selections of the tracks set in the batch and fills the track selection tables, as the trackselection task for Run 3
+  void fillTrackSelectionTables(int64_t nTracks)
+  {
+    selections.EvaluateSelections();
+    if (fillTrackSelection) {
+      filterTable.reserve(nTracks);
+    }
+    if (fillTrackSelectionExtension) {
+      filterTableDetail.reserve(nTracks);
+    }
+    using o2::aod::track::TrackSelectionFlags;
+    for (int64_t row = 0; row < nTracks; row++) {
+      if (fillTrackSelection) {
+        filterTable((uint8_t)0,
+                    selections.GetMask(kGlobalTracks, row),
+                    selections.IsSelected(kFiltBit1, row),
+                    selections.IsSelected(kFiltBit2, row),
+                    selections.IsSelected(kFiltBit3, row),
+                    selections.IsSelected(kFiltBit4, row),
+                    selections.IsSelected(kFiltBit5, row));
+      }
+      if (fillTrackSelectionExtension) {
+        TrackSelectionFlags::flagtype trackflagGlob = selections.GetMask(kGlobalTracks, row);
+        TrackSelectionFlags::flagtype trackflagFB1 = selections.GetMask(kFiltBit1, row);
+        TrackSelectionFlags::flagtype trackflagFB2 = selections.GetMask(kFiltBit2, row);
+        filterTableDetail(TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kTrackType),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kPtRange),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kEtaRange),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kTPCNCls),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kTPCCrossedRows),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kTPCCrossedRowsOverNCls),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kTPCChi2NDF),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kTPCRefit),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kITSNCls),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kITSChi2NDF),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kITSRefit),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kITSHits),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kGoldenChi2),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kDCAxy),
+                          TrackSelectionFlags::checkFlag(trackflagGlob, TrackSelectionFlags::kDCAz),
+                          TrackSelectionFlags::checkFlag(trackflagFB1, TrackSelectionFlags::kITSHits),
+                          TrackSelectionFlags::checkFlag(trackflagFB2, TrackSelectionFlags::kITSHits));
+      }
+    }
+  }
+
   void initCCDB(aod::BCsWithTimestamps::iterator const& bc)
   {
-    if (runNumber == bc.runNumber()) {
-      return;
+    if (runConditions.update(bc)) {
+      mMeanVtx = runConditions.getMeanVertex();
+      if (useFastPropagation && mFastPathX2X0.empty()) {
+        fillFastPathMaterialTable();
+      }
     }
-    grpmag = ccdb->getForTimeStamp<o2::parameters::GRPMagField>(grpmagPath, bc.timestamp());
-    LOG(info) << "Setting magnetic field to current " << grpmag->getL3Current() << " A for run " << bc.runNumber() << " from its GRPMagField CCDB object";
-    o2::base::Propagator::initFieldFromGRP(grpmag);
-    o2::base::Propagator::Instance()->setMatLUT(lut);
-    mMeanVtx = ccdb->getForTimeStamp<o2::dataformats::MeanVertexObject>(mVtxPath, bc.timestamp());
-    runNumber = bc.runNumber();
   }
 
   // Running variables
@@ -149,10 +306,237 @@ struct TrackPropagation {
   o2::track::TrackParametrization<float> mTrackPar;
   o2::track::TrackParametrizationWithError<float> mTrackParCov;
 
-  template <typename TTrack, typename TParticle, bool isMc, bool fillCovMat = false, bool useTrkPid = false>
+  // Fast-path material table: budget between the beam line and radius r along a straight line of given eta, averaged over phi
+  std::vector<float> mFastPathX2X0; // [iEta * nBinsR + iR]
+  std::vector<float> mFastPathXRho; // [iEta * nBinsR + iR]
+
+  void fillFastPathMaterialTable()
+  {
+    const auto* lut = runConditions.getMatLut();
+    if (lut == nullptr) {
+      LOG(fatal) << "The fast propagation path needs the material LUT";
+    }
+    const int nPhi = 8;
+    mFastPathX2X0.assign(fastPathNBinsEta * fastPathNBinsR, 0.f);
+    mFastPathXRho.assign(fastPathNBinsEta * fastPathNBinsR, 0.f);
+    for (int iEta = 0; iEta < fastPathNBinsEta; iEta++) {
+      const float eta = -fastPathMaxEta + (iEta + 0.5f) * 2.f * fastPathMaxEta / fastPathNBinsEta;
+      for (int iR = 0; iR < fastPathNBinsR; iR++) {
+        const float r = (iR + 0.5f) * fastPathMaxRadius / fastPathNBinsR;
+        for (int iPhi = 0; iPhi < nPhi; iPhi++) {
+          const float phi = iPhi * o2::constants::math::TwoPI / nPhi;
+          auto budget = lut->getMatBudget(0.f, 0.f, 0.f, r * std::cos(phi), r * std::sin(phi), r * std::sinh(eta));
+          mFastPathX2X0[iEta * fastPathNBinsR + iR] += budget.meanX2X0 / nPhi;
+          mFastPathXRho[iEta * fastPathNBinsR + iR] += budget.getXRho() / nPhi;
+        }
+      }
+    }
+    LOG(info) << "Filled fast-path material table with " << fastPathNBinsEta.value << " x " << fastPathNBinsR.value << " bins";
+  }
+
+  /// Checks whether a track can use the fast propagation path
+  template <typename TTrackPar>
+  bool isFastPath(const TTrackPar& trackPar)
+  {
+    return useFastPropagation && trackPar.getX() < fastPathMaxRadius && std::abs(trackPar.getEta()) < fastPathMaxEta;
+  }
+
+  /// Propagates a track to the DCA of a vertex, on the fast path if allowed
+  /// On the fast path the tabulated material between the track and the beam line is applied at the starting point,
+  /// then the track is propagated without material corrections
+  template <typename TVertex, typename TTrackPar, typename TDca>
+  bool propagateToDCA(const TVertex& vtx, TTrackPar& trackPar, TDca* dcaInfo)
+  {
+    auto* propagator = o2::base::Propagator::Instance();
+    if (!isFastPath(trackPar)) {
+      return propagator->propagateToDCABxByBz(vtx, trackPar, 2.f, matCorr, dcaInfo);
+    }
+    const int iEta = static_cast<int>((trackPar.getEta() + fastPathMaxEta) / (2.f * fastPathMaxEta) * fastPathNBinsEta);
+    const int iR = std::min(static_cast<int>(trackPar.getX() / fastPathMaxRadius * fastPathNBinsR), fastPathNBinsR - 1);
+    const int iBin = std::clamp(iEta, 0, fastPathNBinsEta - 1) * fastPathNBinsR + std::max(iR, 0);
+    // propagating towards the beam line: positive xrho, the energy lost in the material is added back
+    if constexpr (std::is_same_v<TTrackPar, o2::track::TrackParametrizationWithError<float>>) {
+      if (!trackPar.correctForMaterial(mFastPathX2X0[iBin], mFastPathXRho[iBin])) {
+        return false;
+      }
+    } else {
+      if (!trackPar.correctForELoss(mFastPathXRho[iBin])) {
+        return false;
+      }
+    }
+    return propagator->propagateToDCABxByBz(vtx, trackPar, 2.f, o2::base::Propagator::MatCorrType::USEMatCorrNONE, dcaInfo);
+  }
+
+  /// Propagates a track as propagateToDCA and fills the fast-path monitoring histograms
+  template <typename TVertex, typename TTrackPar, typename TDca>
+  bool propagateToDCAWithQA(const TVertex& vtx, TTrackPar& trackPar, TDca* dcaInfo)
+  {
+    if (!useFastPropagation) {
+      return propagateToDCA(vtx, trackPar, dcaInfo);
+    }
+    const bool fastPath = isFastPath(trackPar);
+    registry.fill(HIST("hPropagationPath"), fastPath ? 3 : 2);
+    if (!fastPath || !fastPathQA) {
+      return propagateToDCA(vtx, trackPar, dcaInfo);
+    }
+    auto trackParFull = trackPar;
+    TDca dcaInfoFull = *dcaInfo;
+    bool isFullOK = o2::base::Propagator::Instance()->propagateToDCABxByBz(vtx, trackParFull, 2.f, matCorr, &dcaInfoFull);
+    bool isFastOK = propagateToDCA(vtx, trackPar, dcaInfo);
+    if (isFullOK && isFastOK) {
+      if constexpr (std::is_same_v<TDca, o2::dataformats::DCA>) {
+        registry.fill(HIST("hFastPathDeltaDCAxyVsPt"), dcaInfo->getY() - dcaInfoFull.getY(), trackParFull.getPt());
+        registry.fill(HIST("hFastPathDeltaDCAzVsPt"), dcaInfo->getZ() - dcaInfoFull.getZ(), trackParFull.getPt());
+        registry.fill(HIST("hFastPathPullDCAxyVsPt"), (dcaInfo->getY() - dcaInfoFull.getY()) / std::sqrt(dcaInfoFull.getSigmaY2()), trackParFull.getPt());
+        registry.fill(HIST("hFastPathPullDCAzVsPt"), (dcaInfo->getZ() - dcaInfoFull.getZ()) / std::sqrt(dcaInfoFull.getSigmaZ2()), trackParFull.getPt());
+      } else {
+        registry.fill(HIST("hFastPathDeltaDCAxyVsPt"), (*dcaInfo)[0] - dcaInfoFull[0], trackParFull.getPt());
+        registry.fill(HIST("hFastPathDeltaDCAzVsPt"), (*dcaInfo)[1] - dcaInfoFull[1], trackParFull.getPt());
+      }
+    }
+    return isFastOK;
+  }
+
+  // Batch propagation buffers, indexed by track row
+  std::vector<o2::track::TrackParametrization<float>> mBatchTrackPar;
+  std::vector<o2::track::TrackParametrizationWithError<float>> mBatchTrackParCov;
+  std::vector<gpu::gpustd::array<float, 2>> mBatchDcaInfo;
+  std::vector<o2::dataformats::DCA> mBatchDcaInfoCov;
+  std::vector<int> mBatchVtxIndex;                    // index of the vertex to propagate to, -1 if the track is not propagated
+  std::vector<uint8_t> mBatchTrackType;               // track type after propagation
+  std::vector<o2::dataformats::VertexBase> mBatchVtx; // collision vertices followed by the mean vertex
+
+  /// Propagates all the tracks of a time frame and fills the tables afterwards.
+  /// The tracks are independent, so the results do not depend on the number of threads
+  template <bool fillCovMat, bool useTrkPid, bool fillSelection, typename TTrack>
+  void fillTrackTablesBatch(TTrack const& tracks, aod::Collisions const& collisions)
+  {
+    const int nTracks = tracks.size();
+    const int meanVtxIndex = collisions.size();
+
+    // vertices to propagate to
+    mBatchVtx.resize(meanVtxIndex + 1);
+    for (const auto& collision : collisions) {
+      auto& vtx = mBatchVtx[collision.globalIndex()];
+      vtx.setPos({collision.posX(), collision.posY(), collision.posZ()});
+      vtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
+    }
+    mBatchVtx[meanVtxIndex].setPos({mMeanVtx->getX(), mMeanVtx->getY(), mMeanVtx->getZ()});
+    mBatchVtx[meanVtxIndex].setCov(mMeanVtx->getSigmaX() * mMeanVtx->getSigmaX(), 0.0f, mMeanVtx->getSigmaY() * mMeanVtx->getSigmaY(), 0.0f, 0.0f, mMeanVtx->getSigmaZ() * mMeanVtx->getSigmaZ());
+
+    // gather the track parameters
+    mBatchVtxIndex.resize(nTracks);
+    mBatchTrackType.resize(nTracks);
+    if constexpr (fillCovMat) {
+      mBatchTrackParCov.resize(nTracks);
+      mBatchDcaInfoCov.resize(nTracks);
+    } else {
+      mBatchTrackPar.resize(nTracks);
+      mBatchDcaInfo.resize(nTracks);
+    }
+    int iTrack = 0;
+    for (const auto& track : tracks) {
+      if constexpr (fillCovMat) {
+        mBatchDcaInfoCov[iTrack].set(999, 999, 999, 999, 999);
+        setTrackParCov(track, mBatchTrackParCov[iTrack]);
+        if constexpr (useTrkPid) {
+          mBatchTrackParCov[iTrack].setPID(track.pidForTracking());
+        }
+      } else {
+        mBatchDcaInfo[iTrack][0] = 999;
+        mBatchDcaInfo[iTrack][1] = 999;
+        setTrackPar(track, mBatchTrackPar[iTrack]);
+        if constexpr (useTrkPid) {
+          mBatchTrackPar[iTrack].setPID(track.pidForTracking());
+        }
+      }
+      mBatchTrackType[iTrack] = track.trackType();
+      // Only propagate tracks which have passed the innermost wall of the TPC (e.g. skipping loopers etc). Others fill unpropagated.
+      if (track.trackType() == aod::track::TrackIU && track.x() < minPropagationRadius) {
+        mBatchVtxIndex[iTrack] = track.has_collision() ? track.collisionId() : meanVtxIndex;
+      } else {
+        mBatchVtxIndex[iTrack] = -1;
+      }
+      iTrack++;
+    }
+
+    // propagate, in chunks of consecutive tracks
+    auto propagateRange = [this](int first, int last) {
+      for (int i = first; i < last; i++) {
+        if (mBatchVtxIndex[i] < 0) {
+          continue;
+        }
+        const auto& vtx = mBatchVtx[mBatchVtxIndex[i]];
+        bool isPropagationOK = false;
+        if constexpr (fillCovMat) {
+          isPropagationOK = propagateToDCA(vtx, mBatchTrackParCov[i], &mBatchDcaInfoCov[i]);
+        } else {
+          isPropagationOK = propagateToDCA(o2::math_utils::Point3D<float>{vtx.getX(), vtx.getY(), vtx.getZ()}, mBatchTrackPar[i], &mBatchDcaInfo[i]);
+        }
+        if (isPropagationOK) {
+          mBatchTrackType[i] = aod::track::Track;
+        }
+      }
+    };
+    const int nThreads = std::max(1, std::min<int>(nThreadsPropagation, nTracks / 1000 + 1));
+    if (nThreads == 1) {
+      propagateRange(0, nTracks);
+    } else {
+      std::vector<std::thread> threads;
+      const int chunkSize = (nTracks + nThreads - 1) / nThreads;
+      for (int first = 0; first < nTracks; first += chunkSize) {
+        threads.emplace_back(propagateRange, first, std::min(first + chunkSize, nTracks));
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+
+    // fill the tables
+    iTrack = 0;
+    for (const auto& track : tracks) {
+      if (useTrackTuner && fillTrackTunerTable) {
+        tunertable(-9999.);
+      }
+      if constexpr (fillCovMat) {
+        const auto& trackParCov = mBatchTrackParCov[iTrack];
+        const auto& dcaInfoCov = mBatchDcaInfoCov[iTrack];
+        tracksParPropagated(track.collisionId(), mBatchTrackType[iTrack], trackParCov.getX(), trackParCov.getAlpha(), trackParCov.getY(), trackParCov.getZ(), trackParCov.getSnp(), trackParCov.getTgl(), trackParCov.getQ2Pt());
+        tracksParExtensionPropagated(trackParCov.getPt(), trackParCov.getP(), trackParCov.getEta(), trackParCov.getPhi());
+        tracksParCovPropagated(std::sqrt(trackParCov.getSigmaY2()), std::sqrt(trackParCov.getSigmaZ2()), std::sqrt(trackParCov.getSigmaSnp2()),
+                               std::sqrt(trackParCov.getSigmaTgl2()), std::sqrt(trackParCov.getSigma1Pt2()), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        tracksParCovExtensionPropagated(trackParCov.getSigmaY2(), trackParCov.getSigmaZY(), trackParCov.getSigmaZ2(), trackParCov.getSigmaSnpY(),
+                                        trackParCov.getSigmaSnpZ(), trackParCov.getSigmaSnp2(), trackParCov.getSigmaTglY(), trackParCov.getSigmaTglZ(), trackParCov.getSigmaTglSnp(),
+                                        trackParCov.getSigmaTgl2(), trackParCov.getSigma1PtY(), trackParCov.getSigma1PtZ(), trackParCov.getSigma1PtSnp(), trackParCov.getSigma1PtTgl(),
+                                        trackParCov.getSigma1Pt2());
+        if (fillTracksDCA) {
+          tracksDCA(dcaInfoCov.getY(), dcaInfoCov.getZ());
+        }
+        if (fillTracksDCACov) {
+          tracksDCACov(dcaInfoCov.getSigmaY2(), dcaInfoCov.getSigmaZ2());
+        }
+        if constexpr (fillSelection) {
+          selections.SetTrack(iTrack, track, mBatchTrackType[iTrack], trackParCov.getPt(), trackParCov.getEta(), dcaInfoCov.getY(), dcaInfoCov.getZ());
+        }
+      } else {
+        const auto& trackPar = mBatchTrackPar[iTrack];
+        tracksParPropagated(track.collisionId(), mBatchTrackType[iTrack], trackPar.getX(), trackPar.getAlpha(), trackPar.getY(), trackPar.getZ(), trackPar.getSnp(), trackPar.getTgl(), trackPar.getQ2Pt());
+        tracksParExtensionPropagated(trackPar.getPt(), trackPar.getP(), trackPar.getEta(), trackPar.getPhi());
+        if (fillTracksDCA) {
+          tracksDCA(mBatchDcaInfo[iTrack][0], mBatchDcaInfo[iTrack][1]);
+        }
+        if constexpr (fillSelection) {
+          selections.SetTrack(iTrack, track, mBatchTrackType[iTrack], trackPar.getPt(), trackPar.getEta(), mBatchDcaInfo[iTrack][0], mBatchDcaInfo[iTrack][1]);
+        }
+      }
+      iTrack++;
+    }
+  }
+
+  template <typename TTrack, typename TParticle, bool isMc, bool fillCovMat = false, bool useTrkPid = false, bool fillSelection = false>
   void fillTrackTables(TTrack const& tracks,
                        TParticle const&,
-                       aod::Collisions const&,
+                       aod::Collisions const& collisions,
                        aod::BCsWithTimestamps const& bcs)
   {
     if (bcs.size() == 0) {
@@ -174,9 +558,26 @@ struct TrackPropagation {
       }
     }
 
+    // the DCA are needed for the selections also when the TracksDCA are not produced
+    const bool resetDca = fillSelection || fillTracksDCA;
+    if constexpr (fillSelection) {
+      selections.Reset(tracks.size());
+    }
+
+    if constexpr (!isMc) {
+      if (useBatchPropagation) {
+        fillTrackTablesBatch<fillCovMat, useTrkPid, fillSelection>(tracks, collisions);
+        if constexpr (fillSelection) {
+          fillTrackSelectionTables(tracks.size());
+        }
+        return;
+      }
+    }
+
+    int64_t iTrack = 0;
     for (auto& track : tracks) {
       if constexpr (fillCovMat) {
-        if (fillTracksDCA || fillTracksDCACov) {
+        if (resetDca || fillTracksDCACov) {
           mDcaInfoCov.set(999, 999, 999, 999, 999);
         }
         setTrackParCov(track, mTrackParCov);
@@ -184,7 +585,7 @@ struct TrackPropagation {
           mTrackParCov.setPID(track.pidForTracking());
         }
       } else {
-        if (fillTracksDCA) {
+        if (resetDca) {
           mDcaInfo[0] = 999;
           mDcaInfo[1] = 999;
         }
@@ -219,17 +620,17 @@ struct TrackPropagation {
           if constexpr (fillCovMat) {
             mVtx.setPos({collision.posX(), collision.posY(), collision.posZ()});
             mVtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
-            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz(mVtx, mTrackParCov, 2.f, matCorr, &mDcaInfoCov);
+            isPropagationOK = propagateToDCAWithQA(mVtx, mTrackParCov, &mDcaInfoCov);
           } else {
-            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, mTrackPar, 2.f, matCorr, &mDcaInfo);
+            isPropagationOK = propagateToDCAWithQA(o2::math_utils::Point3D<float>{collision.posX(), collision.posY(), collision.posZ()}, mTrackPar, &mDcaInfo);
           }
         } else {
           if constexpr (fillCovMat) {
             mVtx.setPos({mMeanVtx->getX(), mMeanVtx->getY(), mMeanVtx->getZ()});
             mVtx.setCov(mMeanVtx->getSigmaX() * mMeanVtx->getSigmaX(), 0.0f, mMeanVtx->getSigmaY() * mMeanVtx->getSigmaY(), 0.0f, 0.0f, mMeanVtx->getSigmaZ() * mMeanVtx->getSigmaZ());
-            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz(mVtx, mTrackParCov, 2.f, matCorr, &mDcaInfoCov);
+            isPropagationOK = propagateToDCAWithQA(mVtx, mTrackParCov, &mDcaInfoCov);
           } else {
-            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz({mMeanVtx->getX(), mMeanVtx->getY(), mMeanVtx->getZ()}, mTrackPar, 2.f, matCorr, &mDcaInfo);
+            isPropagationOK = propagateToDCAWithQA(o2::math_utils::Point3D<float>{mMeanVtx->getX(), mMeanVtx->getY(), mMeanVtx->getZ()}, mTrackPar, &mDcaInfo);
           }
         }
         if (isPropagationOK) {
@@ -248,6 +649,8 @@ struct TrackPropagation {
             }
           }
         } // MC and fillCovMat block ends
+      } else if (useFastPropagation) {
+        registry.fill(HIST("hPropagationPath"), 1);
       }
       // Filling modified Q/Pt values at IU/production point by track tuner in track tuner table
       if (useTrackTuner && fillTrackTunerTable) {
@@ -270,13 +673,23 @@ struct TrackPropagation {
         if (fillTracksDCACov) {
           tracksDCACov(mDcaInfoCov.getSigmaY2(), mDcaInfoCov.getSigmaZ2());
         }
+        if constexpr (fillSelection) {
+          selections.SetTrack(iTrack, track, trackType, mTrackParCov.getPt(), mTrackParCov.getEta(), mDcaInfoCov.getY(), mDcaInfoCov.getZ());
+        }
       } else {
         tracksParPropagated(track.collisionId(), trackType, mTrackPar.getX(), mTrackPar.getAlpha(), mTrackPar.getY(), mTrackPar.getZ(), mTrackPar.getSnp(), mTrackPar.getTgl(), mTrackPar.getQ2Pt());
         tracksParExtensionPropagated(mTrackPar.getPt(), mTrackPar.getP(), mTrackPar.getEta(), mTrackPar.getPhi());
         if (fillTracksDCA) {
           tracksDCA(mDcaInfo[0], mDcaInfo[1]);
         }
+        if constexpr (fillSelection) {
+          selections.SetTrack(iTrack, track, trackType, mTrackPar.getPt(), mTrackPar.getEta(), mDcaInfo[0], mDcaInfo[1]);
+        }
       }
+      iTrack++;
+    }
+    if constexpr (fillSelection) {
+      fillTrackSelectionTables(tracks.size());
     }
   }
 
@@ -312,6 +725,18 @@ struct TrackPropagation {
     fillTrackTables</*TTrack*/ soa::Join<aod::StoredTracksIU, aod::TracksCovIU, aod::TracksExtra>, /*Particle*/ soa::Join<aod::StoredTracksIU, aod::TracksCovIU, aod::TracksExtra>, /*isMc = */ false, /*fillCovMat =*/true, /*useTrkPid =*/false>(tracks, tracks, collisions, bcs);
   }
   PROCESS_SWITCH(TrackPropagation, processCovarianceWithPID, "Process with covariance and with PID in tracking", false);
+
+  void processStandardWithTrackSelection(soa::Join<aod::StoredTracksIU, aod::TracksExtra> const& tracks, aod::Collisions const& collisions, aod::BCsWithTimestamps const& bcs)
+  {
+    fillTrackTables</*TTrack*/ soa::Join<aod::StoredTracksIU, aod::TracksExtra>, /*Particle*/ soa::Join<aod::StoredTracksIU, aod::TracksExtra>, /*isMc = */ false, /*fillCovMat =*/false, /*useTrkPid =*/false, /*fillSelection =*/true>(tracks, tracks, collisions, bcs);
+  }
+  PROCESS_SWITCH(TrackPropagation, processStandardWithTrackSelection, "Process without covariance, producing also the track selection tables (replaces trackselection)", false);
+
+  void processCovarianceWithTrackSelection(soa::Join<aod::StoredTracksIU, aod::TracksCovIU, aod::TracksExtra> const& tracks, aod::Collisions const& collisions, aod::BCsWithTimestamps const& bcs)
+  {
+    fillTrackTables</*TTrack*/ soa::Join<aod::StoredTracksIU, aod::TracksCovIU, aod::TracksExtra>, /*Particle*/ soa::Join<aod::StoredTracksIU, aod::TracksCovIU, aod::TracksExtra>, /*isMc = */ false, /*fillCovMat =*/true, /*useTrkPid =*/false, /*fillSelection =*/true>(tracks, tracks, collisions, bcs);
+  }
+  PROCESS_SWITCH(TrackPropagation, processCovarianceWithTrackSelection, "Process with covariance, producing also the track selection tables (replaces trackselection)", false);
 };
 
 //****************************************************************************************
@@ -21,6 +21,7 @@
 #include "Framework/AnalysisTask.h"
 #include "Framework/runDataProcessing.h"
 #include "Common/Core/TrackSelection.h"
+#include "Common/Core/TrackSelectionBatch.h"
 #include "Common/Core/TrackSelectionDefaults.h"
 #include "Common/DataModel/TrackSelectionTables.h"
 #include "Common/Core/trackUtilities.h"
@@ -57,6 +58,15 @@ struct TrackSelectionTask {
   TrackSelection filtBit3;
   TrackSelection filtBit4;
   TrackSelection filtBit5;
+  // all the selections above, evaluated together over the track table
+  TrackSelectionBatch selections;
+  enum SelectionIndex { kGlobalTracks = 0,
+                        kGlobalTracksSDD,
+                        kFiltBit1,
+                        kFiltBit2,
+                        kFiltBit3,
+                        kFiltBit4,
+                        kFiltBit5 };
 
   void init(InitContext& initContext)
   {
@@ -135,6 +145,15 @@ struct TrackSelectionTask {
 
     LOG(info) << "setting up filtBit5 = getJEGlobalTrackSelectionRun2();";
     filtBit5 = getJEGlobalTrackSelectionRun2(); // Jet validation requires reduced set of cuts
+
+    // same order as SelectionIndex
+    selections.AddSelection(globalTracks);
+    selections.AddSelection(globalTracksSDD);
+    selections.AddSelection(filtBit1);
+    selections.AddSelection(filtBit2);
+    selections.AddSelection(filtBit3);
+    selections.AddSelection(filtBit4);
+    selections.AddSelection(filtBit5);
   }
 
   void process(soa::Join<aod::FullTracks, aod::TracksDCA> const& tracks)
@@ -148,25 +167,27 @@ struct TrackSelectionTask {
     if (produceTable == 0 && produceFBextendedTable == 0) {
       return;
     }
+    selections.Evaluate(tracks);
+    const int64_t nTracks = tracks.size();
     if (isRun3) {
-      for (auto& track : tracks) {
+      for (int64_t row = 0; row < nTracks; row++) {
 
         if (produceTable == 1) {
           filterTable((uint8_t)0,
-                      globalTracks.IsSelectedMask(track),
-                      filtBit1.IsSelected(track),
-                      filtBit2.IsSelected(track),
-                      filtBit3.IsSelected(track),
-                      filtBit4.IsSelected(track),
-                      filtBit5.IsSelected(track));
+                      selections.GetMask(kGlobalTracks, row),
+                      selections.IsSelected(kFiltBit1, row),
+                      selections.IsSelected(kFiltBit2, row),
+                      selections.IsSelected(kFiltBit3, row),
+                      selections.IsSelected(kFiltBit4, row),
+                      selections.IsSelected(kFiltBit5, row));
         }
         if (produceFBextendedTable == 1) {
-          o2::aod::track::TrackSelectionFlags::flagtype trackflagGlob = globalTracks.IsSelectedMask(track);
-          o2::aod::track::TrackSelectionFlags::flagtype trackflagFB1 = filtBit1.IsSelectedMask(track);
-          o2::aod::track::TrackSelectionFlags::flagtype trackflagFB2 = filtBit2.IsSelectedMask(track);
-          // o2::aod::track::TrackSelectionFlags::flagtype trackflagFB3 = filtBit3.IsSelectedMask(track); // only temporarily commented, will be used
-          // o2::aod::track::TrackSelectionFlags::flagtype trackflagFB4 = filtBit4.IsSelectedMask(track);
-          // o2::aod::track::TrackSelectionFlags::flagtype trackflagFB5 = filtBit5.IsSelectedMask(track);
+          o2::aod::track::TrackSelectionFlags::flagtype trackflagGlob = selections.GetMask(kGlobalTracks, row);
+          o2::aod::track::TrackSelectionFlags::flagtype trackflagFB1 = selections.GetMask(kFiltBit1, row);
+          o2::aod::track::TrackSelectionFlags::flagtype trackflagFB2 = selections.GetMask(kFiltBit2, row);
+          // o2::aod::track::TrackSelectionFlags::flagtype trackflagFB3 = selections.GetMask(kFiltBit3, row); // only temporarily commented, will be used
+          // o2::aod::track::TrackSelectionFlags::flagtype trackflagFB4 = selections.GetMask(kFiltBit4, row);
+          // o2::aod::track::TrackSelectionFlags::flagtype trackflagFB5 = selections.GetMask(kFiltBit5, row);
 
           filterTableDetail(o2::aod::track::TrackSelectionFlags::checkFlag(trackflagGlob, o2::aod::track::TrackSelectionFlags::kTrackType),
                             o2::aod::track::TrackSelectionFlags::checkFlag(trackflagGlob, o2::aod::track::TrackSelectionFlags::kPtRange),
@@ -190,16 +211,16 @@ struct TrackSelectionTask {
       return;
     }
 
-    for (auto& track : tracks) {
-      o2::aod::track::TrackSelectionFlags::flagtype trackflagGlob = globalTracks.IsSelectedMask(track);
+    for (int64_t row = 0; row < nTracks; row++) {
+      o2::aod::track::TrackSelectionFlags::flagtype trackflagGlob = selections.GetMask(kGlobalTracks, row);
       if (produceTable == 1) {
-        filterTable((uint8_t)globalTracksSDD.IsSelected(track),
-                    globalTracks.IsSelectedMask(track),
-                    filtBit1.IsSelected(track),
-                    filtBit2.IsSelected(track),
-                    filtBit3.IsSelected(track),
-                    filtBit4.IsSelected(track),
-                    filtBit5.IsSelected(track));
+        filterTable((uint8_t)selections.IsSelected(kGlobalTracksSDD, row),
+                    selections.GetMask(kGlobalTracks, row),
+                    selections.IsSelected(kFiltBit1, row),
+                    selections.IsSelected(kFiltBit2, row),
+                    selections.IsSelected(kFiltBit3, row),
+                    selections.IsSelected(kFiltBit4, row),
+                    selections.IsSelected(kFiltBit5, row));
       }
       if (produceFBextendedTable == 1) {
         filterTableDetail(o2::aod::track::TrackSelectionFlags::checkFlag(trackflagGlob, o2::aod::track::TrackSelectionFlags::kTrackType),
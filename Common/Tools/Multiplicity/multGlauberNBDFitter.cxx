@@ -172,6 +172,8 @@ Double_t multGlauberNBDFitter::ProbDistrib(Double_t* x, Double_t* par)
   if (ffChanged) {
     fCurrentf = par[2];
     fhNanc->Reset();
+    fAncestorValues.clear();
+    fAncestorCounts.clear();
 
     for (int ibin = 0; ibin < fNNpNcPairs; ibin++) {
       Double_t lOption0 = (Int_t)(fNpart[ibin] * par[2] + fNcoll[ibin] * (1.0 - par[2]));
@@ -190,14 +192,27 @@ Double_t multGlauberNBDFitter::ProbDistrib(Double_t* x, Double_t* par)
       return 0;
     }
     fhNanc->Scale(1. / fhNanc->Integral());
+
+    //Keep the populated ancestor bins only: empty bins do not contribute
+    Int_t lStartBin = fhNanc->FindBin(0.0) + 1;
+    for (Long_t iNanc = lStartBin; iNanc < fhNanc->GetNbinsX() + 1; iNanc++) {
+      if (fhNanc->GetBinContent(iNanc) != 0) {
+        fAncestorValues.push_back(fhNanc->GetBinCenter(iNanc));
+        fAncestorCounts.push_back(fhNanc->GetBinContent(iNanc));
+      }
+    }
   }
   //______________________________________________________
   //Actually evaluate function
-  Int_t lStartBin = fhNanc->FindBin(0.0) + 1;
-  for (Long_t iNanc = lStartBin; iNanc < fhNanc->GetNbinsX() + 1; iNanc++) {
-    Double_t lNancestors = fhNanc->GetBinCenter(iNanc);
-    Double_t lNancestorCount = fhNanc->GetBinContent(iNanc);
-    //if(lNancestorCount<1e-12&&lNancestors>10) break;
+  //Gamma functions of the multiplicity only, common to all ancestor bins
+  Double_t lLnGammaMult = 0.0, lGammaMult = 0.0;
+  if (fAncestorMode == 2 && lMultValue > 1e-6) {
+    lLnGammaMult = TMath::LnGamma(lMultValue + 1.);
+    lGammaMult = TMath::Gamma(lMultValue + 1.);
+  }
+  for (size_t iNanc = 0; iNanc < fAncestorValues.size(); iNanc++) {
+    Double_t lNancestors = fAncestorValues[iNanc];
+    Double_t lNancestorCount = fAncestorCounts[iNanc];
 
     // allow for variable mu in case requested
     Double_t lThisMu = (((Double_t)lNancestors)) * (par[0] + par[4] * lNancestors);
@@ -207,7 +222,7 @@ Double_t multGlauberNBDFitter::ProbDistrib(Double_t* x, Double_t* par)
     fNBD->SetParameter(0, lpval);
     Double_t lMult = 0.0;
     if (lMultValue > 1e-6)
-      lMult = fAncestorMode != 2 ? fNBD->Eval(lMultValue) : ContinuousNBD(lMultValue, lThisMu, lThisk);
+      lMult = fAncestorMode != 2 ? fNBD->Eval(lMultValue) : ContinuousNBD(lMultValue, lThisMu, lThisk, lLnGammaMult, lGammaMult);
     lProbability += lNancestorCount * lMult;
   }
   //______________________________________________________
@@ -351,17 +366,24 @@ Double_t multGlauberNBDFitter::ContinuousNBD(Double_t n, Double_t mu, Double_t k
   //in fact it is equivalent to that if 'n' is typecast as
   //an integer prior to use
 
+  return ContinuousNBD(n, mu, k, TMath::LnGamma(n + 1.), TMath::Gamma(n + 1.));
+}
+
+//________________________________________________________________
+Double_t multGlauberNBDFitter::ContinuousNBD(Double_t n, Double_t mu, Double_t k, Double_t lnGammaN1, Double_t gammaN1)
+{
+  //Same as above, with LnGamma(n + 1) and Gamma(n + 1) given by the caller
   Double_t F;
   Double_t f;
 
   if (n + k > 100.0) {
     // log method for handling large numbers
-    F = TMath::LnGamma(n + k) - TMath::LnGamma(n + 1.) - TMath::LnGamma(k);
+    F = TMath::LnGamma(n + k) - lnGammaN1 - TMath::LnGamma(k);
     f = n * TMath::Log(mu / k) - (n + k) * TMath::Log(1.0 + mu / k);
     F = F + f;
     F = TMath::Exp(F);
   } else {
-    F = TMath::Gamma(n + k) / (TMath::Gamma(n + 1.) * TMath::Gamma(k));
+    F = TMath::Gamma(n + k) / (gammaN1 * TMath::Gamma(k));
     f = n * TMath::Log(mu / k) - (n + k) * TMath::Log(1.0 + mu / k);
     f = TMath::Exp(f);
     F *= f;
@@ -13,6 +13,7 @@
 #define MULTGLAUBERNBDFITTER_H
 
 #include <iostream>
+#include <vector>
 #include "TNamed.h"
 #include "TF1.h"
 #include "TH1.h"
@@ -73,6 +74,7 @@ class multGlauberNBDFitter : public TNamed
 
   //For ancestor mode 2
   Double_t ContinuousNBD(Double_t n, Double_t mu, Double_t k);
+  Double_t ContinuousNBD(Double_t n, Double_t mu, Double_t k, Double_t lnGammaN1, Double_t gammaN1);
 
   //For estimating Npart, Ncoll in multiplicity bins
   void CalculateAvNpNc(TProfile* lNPartProf, TProfile* lNCollProf, TH2F* lNPart2DPlot, TH2F* lNColl2DPlot, TH1F* hPercentileMap);
@@ -91,6 +93,10 @@ class multGlauberNBDFitter : public TNamed
   TH2* fhNpNc;  //correlation between Npart and Ncoll
   TH1* fhV0M;   //basic ancestor distribution
 
+  //Populated bins of fhNanc (centre, normalised content), rebuilt when f changes
+  std::vector<Double_t> fAncestorValues; //!
+  std::vector<Double_t> fAncestorCounts; //!
+
   //Fitting utilities
   Bool_t ffChanged;
   Double_t fCurrentf;
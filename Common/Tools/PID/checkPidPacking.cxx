@@ -21,6 +21,11 @@
 #include "TCanvas.h"
 #include "TRandom.h"
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
 using namespace o2;
 
 template <typename T>
@@ -30,8 +35,8 @@ bool process(std::string outputName, int nevents = 100000)
   {
    public:
     NsigmaContainer() {}
-    void operator()(const int8_t& packed) { mPacked = packed; }
-    int8_t mPacked = 0;
+    void operator()(const typename T::binned_t& packed) { mPacked = packed; }
+    typename T::binned_t mPacked = 0;
     float unpack() { return aod::pidutils::unPackInTable<T>(mPacked); }
   } container;
 
@@ -80,9 +85,42 @@ bool process(std::string outputName, int nevents = 100000)
   return gausOk && uniformOk;
 }
 
+template <typename T>
+void report(const std::string& name, int nevents = 100000)
+{
+  std::vector<float> values(nevents);
+  std::vector<typename T::binned_t> packed(nevents);
+  std::vector<float> unpacked(nevents);
+  for (int i = 0; i < nevents; i++) {
+    values[i] = gRandom->Uniform(-5, 5);
+  }
+  aod::pidutils::packColumn<T>(values.data(), packed.data(), nevents);
+  aod::pidutils::unPackColumn<T>(packed.data(), unpacked.data(), nevents);
+  double maxError = 0., sumError2 = 0.;
+  for (int i = 0; i < nevents; i++) {
+    const double error = std::abs(unpacked[i] - values[i]);
+    maxError = std::max(maxError, error);
+    sumError2 += error * error;
+  }
+  // Resolution as the distance between neighbouring bins
+  auto resolutionAt = [](float x) {
+    const auto bin = aod::pidutils::packValue<T>(x);
+    return aod::pidutils::unPackInTable<T>(bin + 1) - aod::pidutils::unPackInTable<T>(bin);
+  };
+  LOG(info) << name << ": " << sizeof(typename T::binned_t) << " byte(s) per value, range [" << T::binned_min << ", " << T::binned_max << "]"
+            << ", resolution " << resolutionAt(0.f) << " at 0 and " << resolutionAt(3.f) << " at 3"
+            << ", max error " << maxError << ", RMS error " << std::sqrt(sumError2 / nevents) << " in [-5, 5]";
+}
+
 int main(int /*argc*/, char* /*argv*/[])
 {
 
+  LOG(info) << "Size and precision of the available binnings";
+  report<aod::pidtpc_tiny::binning>("Tiny tables");
+  report<aod::pidutils::binningInt8>("Linear int8");
+  report<aod::pidutils::binningInt8Fine>("Asinh int8");
+  report<aod::pidutils::binningInt16>("Linear int16");
+
   LOG(info) << "Checking the packing and unpacking of PID signals (nsigmas) in the TPC PID response.";
   if (process<aod::pidtpc_tiny::binning>("TPC", 100000)) {
     LOG(info) << "Packing and unpacking of PID signals (nsigmas) in the TPC PID response is correct.";
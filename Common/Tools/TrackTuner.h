@@ -56,6 +56,64 @@ DECLARE_SOA_TABLE(TrackTunerTable, "AOD", "TRACKTUNERTABLE", //!
 } // namespace o2::aod
 
 struct TrackTuner {
+  /// Points of a correction graph, evaluated as TGraph::Eval (linear interpolation) with a binary search
+  /// instead of the scan of all the points, and clamped to the first and last point as it was done in evalGraph
+  struct GraphLookup {
+    std::vector<double> x;
+    std::vector<double> y;
+    double xFirst = 0.;
+    double xLast = 0.;
+
+    void set(const TGraphErrors* graph)
+    {
+      x.clear();
+      y.clear();
+      if (!graph || graph->GetN() == 0) {
+        return;
+      }
+      const int nPoints = graph->GetN();
+      xFirst = graph->GetX()[0];
+      xLast = graph->GetX()[nPoints - 1];
+      std::vector<int> order(nPoints);
+      for (int i = 0; i < nPoints; i++) {
+        order[i] = i;
+      }
+      std::stable_sort(order.begin(), order.end(), [graph](int a, int b) { return graph->GetX()[a] < graph->GetX()[b]; });
+      for (const auto& i : order) {
+        x.push_back(graph->GetX()[i]);
+        y.push_back(graph->GetY()[i]);
+      }
+    }
+
+    double eval(double xEval) const
+    {
+      if (x.empty()) {
+        printf("\tevalGraph fails !\n");
+        return 0.;
+      }
+      if (xEval > xLast) {
+        xEval = xLast;
+      } else if (xEval < xFirst) {
+        xEval = xFirst;
+      }
+      if (x.size() == 1) {
+        return y[0];
+      }
+      // the value of a point is returned as it is
+      int64_t up = std::lower_bound(x.begin(), x.end(), xEval) - x.begin();
+      if (up < static_cast<int64_t>(x.size()) && x[up] == xEval) {
+        return y[up];
+      }
+      // outside of the points the first or the last two points are extrapolated
+      up = std::clamp<int64_t>(up, 1, x.size() - 1);
+      const int64_t low = up - 1;
+      if (x[low] == x[up]) {
+        return 0.5 * (y[low] + y[up]);
+      }
+      return y[low] + (xEval - x[low]) * (y[up] - y[low]) / (x[up] - x[low]);
+    }
+  };
+
   ///////////////////////////////
   /// parameters to be configured
   bool debugInfo = false;
@@ -98,6 +156,12 @@ struct TrackTuner {
   std::unique_ptr<TGraphErrors> grDcaZPullVsPtPionMC;
   std::unique_ptr<TGraphErrors> grDcaZPullVsPtPionData;
 
+  // points of the graphs evaluated in tuneTrackParams
+  GraphLookup lutDcaXYResVsPtPionMC, lutDcaXYResVsPtPionData, lutDcaZResVsPtPionMC, lutDcaZResVsPtPionData;
+  GraphLookup lutDcaXYMeanVsPtPionMC, lutDcaXYMeanVsPtPionData;
+  GraphLookup lutOneOverPtPionMC, lutOneOverPtPionData;
+  GraphLookup lutDcaXYPullVsPtPionMC, lutDcaXYPullVsPtPionData, lutDcaZPullVsPtPionMC, lutDcaZPullVsPtPionData;
+
   /// @brief Function to configure the TrackTuner parameters
   /// @param inputString Input string with all parameter configuration. Format: <name>=<value>|<name>=<value>
   /// @return String with the values of all parameters after configurations are listed, to cross check that everything worked well
@@ -391,6 +455,19 @@ struct TrackTuner {
       grOneOverPtPionMC.reset(dynamic_cast<TGraphErrors*>(inputFileQoverPt->Get(grOneOverPtPionNameMC.c_str())));
       grOneOverPtPionData.reset(dynamic_cast<TGraphErrors*>(inputFileQoverPt->Get(grOneOverPtPionNameData.c_str())));
     }
+
+    lutDcaXYResVsPtPionMC.set(grDcaXYResVsPtPionMC.get());
+    lutDcaXYResVsPtPionData.set(grDcaXYResVsPtPionData.get());
+    lutDcaZResVsPtPionMC.set(grDcaZResVsPtPionMC.get());
+    lutDcaZResVsPtPionData.set(grDcaZResVsPtPionData.get());
+    lutDcaXYMeanVsPtPionMC.set(grDcaXYMeanVsPtPionMC.get());
+    lutDcaXYMeanVsPtPionData.set(grDcaXYMeanVsPtPionData.get());
+    lutOneOverPtPionMC.set(grOneOverPtPionMC.get());
+    lutOneOverPtPionData.set(grOneOverPtPionData.get());
+    lutDcaXYPullVsPtPionMC.set(grDcaXYPullVsPtPionMC.get());
+    lutDcaXYPullVsPtPionData.set(grDcaXYPullVsPtPionData.get());
+    lutDcaZPullVsPtPionMC.set(grDcaZPullVsPtPionMC.get());
+    lutDcaZPullVsPtPionData.set(grDcaZPullVsPtPionData.get());
   } // getDcaGraphs() ends here
 
   template <typename T1, typename T2, typename T3, typename T4, typename H>
@@ -412,11 +489,11 @@ struct TrackTuner {
     double dcaZPullMC = 1.0;
     double dcaZPullData = 1.0;
 
-    dcaXYResMC = evalGraph(ptMC, grDcaXYResVsPtPionMC.get());
-    dcaXYResData = evalGraph(ptMC, grDcaXYResVsPtPionData.get());
+    dcaXYResMC = lutDcaXYResVsPtPionMC.eval(ptMC);
+    dcaXYResData = lutDcaXYResVsPtPionData.eval(ptMC);
 
-    dcaZResMC = evalGraph(ptMC, grDcaZResVsPtPionMC.get());
-    dcaZResData = evalGraph(ptMC, grDcaZResVsPtPionData.get());
+    dcaZResMC = lutDcaZResVsPtPionMC.eval(ptMC);
+    dcaZResData = lutDcaZResVsPtPionData.eval(ptMC);
 
     // For Q/Pt corrections, files on CCDB will be used if both qOverPtMC and qOverPtData are null
     if (updateCurvature || updateCurvatureIU) {
@@ -428,20 +505,20 @@ struct TrackTuner {
         if (!grOneOverPtPionData.get() || !grOneOverPtPionMC.get()) {
           LOG(fatal) << "### q/pt smearing: input graphs not correctly retrieved. Aborting.";
         }
-        qOverPtMC = std::max(0.0, evalGraph(ptMC, grOneOverPtPionMC.get()));
-        qOverPtData = std::max(0.0, evalGraph(ptMC, grOneOverPtPionData.get()));
+        qOverPtMC = std::max(0.0, lutOneOverPtPionMC.eval(ptMC));
+        qOverPtData = std::max(0.0, lutOneOverPtPionData.eval(ptMC));
       } // qOverPtMC, qOverPtData block ends here
     }   // updateCurvature, updateCurvatureIU block ends here
 
     if (updateTrackDCAs) {
-      dcaXYMeanMC = evalGraph(ptMC, grDcaXYMeanVsPtPionMC.get());
-      dcaXYMeanData = evalGraph(ptMC, grDcaXYMeanVsPtPionData.get());
+      dcaXYMeanMC = lutDcaXYMeanVsPtPionMC.eval(ptMC);
+      dcaXYMeanData = lutDcaXYMeanVsPtPionData.eval(ptMC);
 
-      dcaXYPullMC = evalGraph(ptMC, grDcaXYPullVsPtPionMC.get());
-      dcaXYPullData = evalGraph(ptMC, grDcaXYPullVsPtPionData.get());
+      dcaXYPullMC = lutDcaXYPullVsPtPionMC.eval(ptMC);
+      dcaXYPullData = lutDcaXYPullVsPtPionData.eval(ptMC);
 
-      dcaZPullMC = evalGraph(ptMC, grDcaZPullVsPtPionMC.get());
-      dcaZPullData = evalGraph(ptMC, grDcaZPullVsPtPionData.get());
+      dcaZPullMC = lutDcaZPullVsPtPionMC.eval(ptMC);
+      dcaZPullData = lutDcaZPullVsPtPionData.eval(ptMC);
     }
     //  Unit conversion, is it required ??
     dcaXYResMC *= 1.e-4;
@@ -823,23 +900,6 @@ struct TrackTuner {
   //
   //   return -1;
   // }
-
-  double evalGraph(double x, const TGraphErrors* graph) const
-  {
-
-    if (!graph) {
-      printf("\tevalGraph fails !\n");
-      return 0.;
-    }
-    int nPoints = graph->GetN();
-    double xMin = graph->GetX()[0];
-    double xMax = graph->GetX()[nPoints - 1];
-    if (x > xMax)
-      return graph->Eval(xMax);
-    if (x < xMin)
-      return graph->Eval(xMin);
-    return graph->Eval(x);
-  }
 };
 
 #endif // COMMON_TOOLS_TRACKTUNER_H_
@@ -16,6 +16,9 @@
 ///         In MC the efficiency for particles is computed according to the PDG code (sign included and not charge).
 ///
 
+#include <algorithm>
+#include <vector>
+
 // O2 includes
 #include "Framework/AnalysisTask.h"
 #include "Framework/runDataProcessing.h"
@@ -29,6 +32,7 @@
 #include "Common/DataModel/TrackSelectionTables.h"
 #include "PWGLF/DataModel/LFParticleIdentification.h"
 #include "Common/Core/RecoDecay.h"
+#include "DPG/Tasks/qaPrescale.h"
 
 // ROOT includes
 #include "TPDGCode.h"
@@ -451,6 +455,11 @@ struct QaEfficiency {
   Configurable<bool> makeEff{"make-eff", false, "Flag to produce the efficiency with TEfficiency"};
   Configurable<bool> doPtEta{"doPtEta", false, "Flag to produce the efficiency vs pT and Eta"};
   Configurable<int> applyEvSel{"applyEvSel", 0, "Flag to apply event selection: 0 -> no event selection, 1 -> Run 2 event selection, 2 -> Run 3 event selection"};
+  // deterministic prescale of the collisions of the data processes, and further prescale of the TEfficiency filling
+  QaPrescaleConfigurables qaPrescaleCfg;
+  Configurable<int> prescaleEff{"prescaleEff", 1, "Fill the TEfficiency objects for one accepted collision every prescaleEff"};
+  QaPrescale qaPrescale;
+  enum PrescaleGroup { kPrescaleEff = 0 };
   // Custom track cuts for debug purposes
   TrackSelection customTrackCuts;
   struct : ConfigurableGroup {
@@ -1121,6 +1130,7 @@ struct QaEfficiency {
     const AxisSpec axisSel{40, 0.5, 40.5, "Selection"};
     initData(axisSel);
     initMC(axisSel);
+    qaPrescale.init(histos, qaPrescaleCfg, {{"Eff", prescaleEff}});
 
     // Custom track cuts
     if (globalTrackSelection.value == 6) {
@@ -1168,8 +1178,23 @@ struct QaEfficiency {
     return mcParticle.isPhysicalPrimary();
   }
 
+  /// Checks if any of the mothers of a particle is in mothersPDGs, always true without the selection on mothers
+  bool isMotherAccepted(const o2::aod::McParticles::iterator& mcParticle)
+  {
+    if (!checkForMothers.value || mothersPDGs.value.empty() || !mcParticle.has_mothers()) {
+      return true;
+    }
+    for (const auto& mother : mcParticle.mothers_as<o2::aod::McParticles>()) {
+      if (std::find(mothersPDGs.value.begin(), mothersPDGs.value.end(), mother.pdgCode()) != mothersPDGs.value.end()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// \param mcParticle particle of the track, read once by the caller for all the species
   template <int pdgSign, o2::track::PID::ID id, typename trackType>
-  void fillMCTrackHistograms(const trackType& track, const bool doMakeHistograms)
+  void fillMCTrackHistograms(const trackType& track, const o2::aod::McParticles::iterator& mcParticle, const bool doMakeHistograms)
   {
     static_assert(pdgSign == 0 || pdgSign == 1);
     if (!doMakeHistograms) {
@@ -1193,7 +1218,6 @@ struct QaEfficiency {
 
     constexpr int histogramIndex = id + pdgSign * nSpecies;
     LOG(debug) << "fillMCTrackHistograms for pdgSign '" << pdgSign << "' and id '" << static_cast<int>(id) << "' " << particleName(pdgSign, id) << " with index " << histogramIndex;
-    const o2::aod::McParticles::iterator& mcParticle = track.mcParticle();
 
     if (!isPdgSelected<pdgSign, id>(mcParticle)) { // Selecting PDG code
       return;
@@ -1266,23 +1290,7 @@ struct QaEfficiency {
       }
     } else if (mcParticle.getProcess() == 4) { // Particle decay
       // Checking mothers
-      bool motherIsAccepted = true;
-      if (checkForMothers.value && mothersPDGs.value.size() > 0 && mcParticle.has_mothers()) {
-        motherIsAccepted = false;
-        auto mothers = mcParticle.mothers_as<o2::aod::McParticles>();
-        for (const auto& mother : mothers) {
-          for (const auto& pdgToCheck : mothersPDGs.value) {
-            if (mother.pdgCode() == pdgToCheck) {
-              motherIsAccepted = true;
-              break;
-            }
-            if (motherIsAccepted) {
-              break;
-            }
-          }
-        }
-      }
-      if (passedITS && passedTPC && motherIsAccepted) {
+      if (passedITS && passedTPC && isMotherAccepted(mcParticle)) {
         h->fill(HIST(hPtItsTpcStr[histogramIndex]), mcParticle.pt());
         h->fill(HIST(hPtTrkItsTpcStr[histogramIndex]), track.pt());
         if (passedTOF) {
@@ -1347,23 +1355,7 @@ struct QaEfficiency {
     } else {
       if (mcParticle.getProcess() == 4) { // Particle decay
         // Checking mothers
-        bool motherIsAccepted = true;
-        if (checkForMothers.value && mothersPDGs.value.size() > 0 && mcParticle.has_mothers()) {
-          motherIsAccepted = false;
-          auto mothers = mcParticle.mothers_as<o2::aod::McParticles>();
-          for (const auto& mother : mothers) {
-            for (const auto& pdgToCheck : mothersPDGs.value) {
-              if (mother.pdgCode() == pdgToCheck) {
-                motherIsAccepted = true;
-                break;
-              }
-              if (motherIsAccepted) {
-                break;
-              }
-            }
-          }
-        }
-        if (motherIsAccepted) {
+        if (isMotherAccepted(mcParticle)) {
           h->fill(HIST(hPtGeneratedStr[histogramIndex]), mcParticle.pt());
         }
       } else { // Material
@@ -1827,15 +1819,15 @@ struct QaEfficiency {
           // Filling variable histograms
           histos.fill(HIST("MC/trackLength"), track.length());
           static_for<0, 1>([&](auto pdgSign) {
-            fillMCTrackHistograms<pdgSign, o2::track::PID::Electron>(track, doEl);
-            fillMCTrackHistograms<pdgSign, o2::track::PID::Muon>(track, doMu);
-            fillMCTrackHistograms<pdgSign, o2::track::PID::Pion>(track, doPi);
-            fillMCTrackHistograms<pdgSign, o2::track::PID::Kaon>(track, doKa);
-            fillMCTrackHistograms<pdgSign, o2::track::PID::Proton>(track, doPr);
-            fillMCTrackHistograms<pdgSign, o2::track::PID::Deuteron>(track, doDe);
-            fillMCTrackHistograms<pdgSign, o2::track::PID::Triton>(track, doTr);
-            fillMCTrackHistograms<pdgSign, o2::track::PID::Helium3>(track, doHe);
-            fillMCTrackHistograms<pdgSign, o2::track::PID::Alpha>(track, doAl);
+            fillMCTrackHistograms<pdgSign, o2::track::PID::Electron>(track, particle, doEl);
+            fillMCTrackHistograms<pdgSign, o2::track::PID::Muon>(track, particle, doMu);
+            fillMCTrackHistograms<pdgSign, o2::track::PID::Pion>(track, particle, doPi);
+            fillMCTrackHistograms<pdgSign, o2::track::PID::Kaon>(track, particle, doKa);
+            fillMCTrackHistograms<pdgSign, o2::track::PID::Proton>(track, particle, doPr);
+            fillMCTrackHistograms<pdgSign, o2::track::PID::Deuteron>(track, particle, doDe);
+            fillMCTrackHistograms<pdgSign, o2::track::PID::Triton>(track, particle, doTr);
+            fillMCTrackHistograms<pdgSign, o2::track::PID::Helium3>(track, particle, doHe);
+            fillMCTrackHistograms<pdgSign, o2::track::PID::Alpha>(track, particle, doAl);
           });
         }
 
@@ -1968,15 +1960,15 @@ struct QaEfficiency {
       // Filling variable histograms
       histos.fill(HIST("MC/trackLength"), track.length());
       static_for<0, 1>([&](auto pdgSign) {
-        fillMCTrackHistograms<pdgSign, o2::track::PID::Electron>(track, doEl);
-        fillMCTrackHistograms<pdgSign, o2::track::PID::Muon>(track, doMu);
-        fillMCTrackHistograms<pdgSign, o2::track::PID::Pion>(track, doPi);
-        fillMCTrackHistograms<pdgSign, o2::track::PID::Kaon>(track, doKa);
-        fillMCTrackHistograms<pdgSign, o2::track::PID::Proton>(track, doPr);
-        fillMCTrackHistograms<pdgSign, o2::track::PID::Deuteron>(track, doDe);
-        fillMCTrackHistograms<pdgSign, o2::track::PID::Triton>(track, doTr);
-        fillMCTrackHistograms<pdgSign, o2::track::PID::Helium3>(track, doHe);
-        fillMCTrackHistograms<pdgSign, o2::track::PID::Alpha>(track, doAl);
+        fillMCTrackHistograms<pdgSign, o2::track::PID::Electron>(track, particle, doEl);
+        fillMCTrackHistograms<pdgSign, o2::track::PID::Muon>(track, particle, doMu);
+        fillMCTrackHistograms<pdgSign, o2::track::PID::Pion>(track, particle, doPi);
+        fillMCTrackHistograms<pdgSign, o2::track::PID::Kaon>(track, particle, doKa);
+        fillMCTrackHistograms<pdgSign, o2::track::PID::Proton>(track, particle, doPr);
+        fillMCTrackHistograms<pdgSign, o2::track::PID::Deuteron>(track, particle, doDe);
+        fillMCTrackHistograms<pdgSign, o2::track::PID::Triton>(track, particle, doTr);
+        fillMCTrackHistograms<pdgSign, o2::track::PID::Helium3>(track, particle, doHe);
+        fillMCTrackHistograms<pdgSign, o2::track::PID::Alpha>(track, particle, doAl);
       });
     }
 
@@ -2028,12 +2020,17 @@ struct QaEfficiency {
   PROCESS_SWITCH(QaEfficiency, processMCWithoutCollisions, "process MC without the collision association", false);
 
   void processData(o2::soa::Join<o2::aod::Collisions, o2::aod::EvSels>::iterator const& collision,
-                   TrackCandidates const& tracks)
+                   TrackCandidates const& tracks,
+                   o2::aod::BCs const&)
   {
 
     if (!isCollisionSelected<false>(collision)) {
       return;
     }
+    if (!qaPrescale.acceptCollision(collision.bc().globalBC())) {
+      return;
+    }
+    const bool fillEff = makeEff && qaPrescale.acceptGroup(kPrescaleEff, collision.bc().globalBC());
 
     for (const auto& track : tracks) {
       if (!isTrackSelected<false>(track, HIST("Data/trackSelection"))) {
@@ -2098,7 +2095,7 @@ struct QaEfficiency {
         }
       }
 
-      if (makeEff) {
+      if (fillEff) {
         if (passedITS) {
           effITSTPCMatchingVsPt->Fill(passedTPC, track.pt());
         }
@@ -2119,12 +2116,17 @@ struct QaEfficiency {
   PROCESS_SWITCH(QaEfficiency, processData, "process data", true);
 
   void processDataWithPID(o2::soa::Join<o2::aod::Collisions, o2::aod::EvSels>::iterator const& collision,
-                          o2::soa::Join<TrackCandidates, o2::aod::pidTPCLfFullDe> const& tracks)
+                          o2::soa::Join<TrackCandidates, o2::aod::pidTPCLfFullDe> const& tracks,
+                          o2::aod::BCs const&)
   {
 
     if (!isCollisionSelected<false>(collision)) {
       return;
     }
+    if (!qaPrescale.acceptCollision(collision.bc().globalBC())) {
+      return;
+    }
+    const bool fillEff = makeEff && qaPrescale.acceptGroup(kPrescaleEff, collision.bc().globalBC());
 
     for (const auto& track : tracks) {
       if (!isTrackSelected<false>(track, HIST("Data/trackSelection"))) {
@@ -2191,7 +2193,7 @@ struct QaEfficiency {
         }
       }
 
-      if (makeEff) {
+      if (fillEff) {
         if (passedITS) {
           effITSTPCMatchingVsPt->Fill(passedTPC, track.pt());
         }
@@ -2213,12 +2215,16 @@ struct QaEfficiency {
 
   void processHmpid(o2::soa::Join<o2::aod::Collisions, o2::aod::EvSels>::iterator const& collision,
                     TrackCandidates const&,
-                    o2::aod::HMPIDs const& hmpids)
+                    o2::aod::HMPIDs const& hmpids,
+                    o2::aod::BCs const&)
   {
 
     if (!isCollisionSelected<false>(collision)) {
       return;
     }
+    if (!qaPrescale.acceptCollision(collision.bc().globalBC())) {
+      return;
+    }
 
     for (const auto& hmpid : hmpids) {
       const auto& track = hmpid.track_as<TrackCandidates>();
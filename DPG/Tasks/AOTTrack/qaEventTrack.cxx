@@ -22,6 +22,7 @@
 ///
 
 #include "qaEventTrack.h"
+#include "DPG/Tasks/qaPrescale.h"
 
 #include "Framework/AnalysisTask.h"
 #include "Framework/HistogramRegistry.h"
@@ -93,6 +94,12 @@ struct qaEventTrack {
   // options to check the track variables only for PV contributors
   Configurable<bool> checkOnlyPVContributor{"checkOnlyPVContributor", false, "check the track variables only for primary vertex contributors"};
 
+  // deterministic prescale of the collisions of the data processes, and further prescale of the IU vs DCA comparison
+  QaPrescaleConfigurables qaPrescaleCfg;
+  Configurable<int> prescaleDataIU{"prescaleDataIU", 1, "Fill the IU vs DCA comparison for one accepted collision every prescaleDataIU"};
+  QaPrescale qaPrescale;
+  enum PrescaleGroup { kPrescaleDataIU = 0 };
+
   // configurable binning of histograms
   ConfigurableAxis binsPt{"binsPt", {VARIABLE_WIDTH, 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0, 1.1, 1.2, 1.3, 1.4, 1.5, 2.0, 5.0, 10.0, 20.0, 50.0}, ""};
   ConfigurableAxis binsInvPt{"binsInvPt", {VARIABLE_WIDTH, 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0, 1.1, 1.2, 1.3, 1.4, 1.5, 2.0, 5.0, 10.0, 20.0, 50.0}, ""};
@@ -151,6 +158,7 @@ struct qaEventTrack {
       LOGF(info, "Mixing process functions for Run 2 and Run 3 data, returning...");
       return;
     }
+    qaPrescale.init(histos, qaPrescaleCfg, {{"DataIU", prescaleDataIU}});
 
     //
     // Next section setups overwrite of configurableAxis if overwriteAxisRangeForPbPb is used.
@@ -707,8 +715,11 @@ struct qaEventTrack {
   // Process function for data
   using CollisionTableData = soa::Join<aod::Collisions, aod::EvSels>;
   // using TrackTableData = soa::Join<aod::FullTracks, aod::TracksCov, aod::TracksDCA, aod::TrackSelection>;
-  void processData(CollisionTableData::iterator const& collision, soa::Filtered<TrackTableData> const& tracks, aod::FullTracks const& tracksUnfiltered)
+  void processData(CollisionTableData::iterator const& collision, soa::Filtered<TrackTableData> const& tracks, aod::FullTracks const& tracksUnfiltered, aod::BCs const&)
   {
+    if (!qaPrescale.acceptCollision(collision.bc().globalBC())) {
+      return;
+    }
     /// work with collision grouping
     fillRecoHistogramsGroupedTracks<false>(collision, tracks, tracksUnfiltered);
   }
@@ -751,10 +762,13 @@ struct qaEventTrack {
   PROCESS_SWITCH(qaEventTrack, processTrackMatch, "process for track-to-collision matching studies", false);
 
   // Process function for Run2 converted data
-  void processRun2ConvertedData(CollisionTableData const& collisions, soa::Filtered<TrackTableData> const& tracks, aod::FullTracks const& tracksUnfiltered)
+  void processRun2ConvertedData(CollisionTableData const& collisions, soa::Filtered<TrackTableData> const& tracks, aod::FullTracks const& tracksUnfiltered, aod::BCs const&)
   {
     /// work with collision grouping
     for (auto const& collision : collisions) {
+      if (!qaPrescale.acceptCollision(collision.bc().globalBC())) {
+        continue;
+      }
       const auto& tracksColl = tracks.sliceBy(perRecoCollision, collision.globalIndex());
       const auto& tracksUnfilteredColl = tracksUnfiltered.sliceBy(perRecoCollision, collision.globalIndex());
       fillRecoHistogramsGroupedTracks<false>(collision, tracksColl, tracksUnfilteredColl);
@@ -766,8 +780,12 @@ struct qaEventTrack {
   using FullTracksIU = soa::Join<aod::TracksIU, aod::TracksExtra, aod::TracksCovIU>;
   void processDataIU(CollisionTableData::iterator const& collision,
                      soa::Join<aod::FullTracks, aod::TracksDCA> const& tracksUnfiltered,
-                     FullTracksIU const& tracksIU)
+                     FullTracksIU const& tracksIU,
+                     aod::BCs const&)
   {
+    if (!qaPrescale.acceptGroup(kPrescaleDataIU, collision.bc().globalBC())) {
+      return;
+    }
     if (!isSelectedCollision<false>(collision)) {
       return;
     }
@@ -27,6 +27,7 @@
 #include "Common/DataModel/PIDResponse.h"
 #include "CommonConstants/MathConstants.h"
 #include "CCDB/BasicCCDBManager.h"
+#include "DPG/Tasks/qaPrescale.h"
 //
 #include "Framework/AnalysisTask.h"
 #include "Framework/RunningWorkflowInfo.h"
@@ -91,6 +92,9 @@ struct qaMatchEff {
     Configurable<float> centralityMinCut{"centralityMinCut", 0.0f, "Minimum centrality"};
     Configurable<float> centralityMaxCut{"centralityMaxCut", 100.0f, "Maximum centrality"};
   } centralityCuts;
+  // deterministic prescale of the collisions of the data processes with collision grouping
+  QaPrescaleConfigurables qaPrescaleCfg;
+  QaPrescale qaPrescale;
   //
   // Track selections
   Configurable<bool> isUseTPCinnerWallPt{"isUseTPCinnerWallPt", false, "Boolean to switch the usage of pt calculated at the inner wall of TPC on/off."};
@@ -231,6 +235,7 @@ struct qaMatchEff {
       initMC();
     else
       initData();
+    qaPrescale.init(histos, qaPrescaleCfg);
 
     if ((!isitMC && (doprocessMC || doprocessMCNoColl || doprocessTrkIUMC)) || (isitMC && (doprocessData || doprocessDataNoColl || doprocessTrkIUMC)))
       LOGF(fatal, "Initialization set for MC and processData function flagged  (or viceversa)! Fix the configuration.");
@@ -3280,6 +3285,9 @@ struct qaMatchEff {
         LOGF(info, "Event selection not passed, skipping...");
       return;
     }
+    if (!qaPrescale.acceptCollision(collision.bc_as<BCsWithTimeStamp>().globalBC())) {
+      return;
+    }
     fillHistograms<false>(tracks, tracks, bcs); // 2nd argument not used in this case
     fillGeneralHistos<false>(collision);
   }
@@ -3311,6 +3319,9 @@ struct qaMatchEff {
         return;
       }
     }
+    if (!qaPrescale.acceptCollision(collision.bc_as<BCsWithTimeStamp>().globalBC())) {
+      return;
+    }
     fillHistograms<false>(tracks, tracks, bcs); // 2nd argument not used in this case
     fillGeneralHistos<false>(collision);
   }
@@ -3319,13 +3330,16 @@ struct qaMatchEff {
   /////////////////////////////////////////////////////////////
   ///   Process data with collision grouping and IU tracks  ///
   /////////////////////////////////////////////////////////////
-  void processTrkIUData(CollisionsEvSel::iterator const& collision, TracksIUPID const& tracks)
+  void processTrkIUData(CollisionsEvSel::iterator const& collision, TracksIUPID const& tracks, aod::BCs const&)
   {
     if (isEnableEventSelection && !collision.sel8()) {
       if (doDebug)
         LOGF(info, "Event selection not passed, skipping...");
       return;
     }
+    if (!qaPrescale.acceptCollision(collision.bc().globalBC())) {
+      return;
+    }
     fillHistograms<false>(tracks, tracks, tracks); // 2nd and 3rd arguments not used in this case
     fillGeneralHistos<false>(collision);
   }
@@ -0,0 +1,138 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   qaPrescale.h
+/// \brief  Deterministic prescale of the collisions processed by the DPG QA tasks
+///
+///         A collision is accepted or rejected from a hash of its global BC, independently of its content, so that the
+///         accepted collisions are an unbiased sample and the same collisions are accepted in every pass and by every task
+///         using the same prescale and seed. The heavy groups of histograms can be prescaled further, among the accepted
+///         collisions, with the prescale of their group. Each decision is counted in the bins of the collisions or of its
+///         group, so each process function should take each decision once per collision.
+///         The numbers of collisions seen and accepted by each group, and the configured prescales, are stored in the
+///         histograms "QaPrescale/hCounters" and "QaPrescale/hPrescales", to normalise the prescaled histograms.
+///
+///         Usage:
+///           QaPrescaleConfigurables qaPrescaleCfg;                                                 // task member
+///           QaPrescale qaPrescale;                                                                 // task member
+///           Configurable<int> prescaleHeavy{"prescaleHeavy", 1, "..."};                           // task member
+///           qaPrescale.init(histos, qaPrescaleCfg, {{"heavy", prescaleHeavy}});                    // in init
+///           if (!qaPrescale.acceptCollision(collision.bc_as<aod::BCs>().globalBC())) { return; } // in process
+///           if (!qaPrescale.acceptGroup(0, collision.bc_as<aod::BCs>().globalBC())) { return; }  // in the heavy process
+///
+
+#ifndef DPG_TASKS_QAPRESCALE_H_
+#define DPG_TASKS_QAPRESCALE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <TH1.h>
+
+#include "Framework/Configurable.h"
+#include "Framework/HistogramRegistry.h"
+#include "Framework/Logger.h"
+
+struct QaPrescaleConfigurables : o2::framework::ConfigurableGroup {
+  std::string prefix = "qaPrescale";
+  o2::framework::Configurable<int> prescaleCollisions{"prescaleCollisions", 1, "Process one collision every prescaleCollisions, chosen from a hash of its global BC (1: all collisions)"};
+  o2::framework::Configurable<int> seed{"seed", 0, "Seed of the hash of the global BC, the same seed selects the same collisions"};
+};
+
+class QaPrescale
+{
+ public:
+  /// Books the counters and stores the prescales
+  /// \param groups name and prescale of each group of histograms, relative to the accepted collisions
+  void init(o2::framework::HistogramRegistry& registry, const QaPrescaleConfigurables& cfg, const std::vector<std::pair<std::string, int>>& groups = {})
+  {
+    if (cfg.prescaleCollisions < 1) {
+      LOG(fatal) << "QaPrescale: prescale of the collisions " << cfg.prescaleCollisions.value << " < 1";
+    }
+    mPrescaleCollisions = cfg.prescaleCollisions;
+    mSeed = static_cast<uint64_t>(cfg.seed.value);
+    mPrescaleGroups.clear();
+    for (const auto& group : groups) {
+      if (group.second < 1) {
+        LOG(fatal) << "QaPrescale: prescale of the group " << group.first << " " << group.second << " < 1";
+      }
+      mPrescaleGroups.push_back(group.second);
+    }
+
+    // for the collisions and for each group: collisions seen and accepted
+    const int nBins = 2 * (1 + groups.size());
+    mCounters = registry.add<TH1>("QaPrescale/hCounters", "Collisions seen and accepted;;collisions", o2::framework::kTH1D, {{nBins, 0.5, nBins + 0.5}});
+    auto hPrescales = registry.add<TH1>("QaPrescale/hPrescales", "Prescales;;prescale", o2::framework::kTH1D, {{nBins / 2, 0.5, nBins / 2 + 0.5}});
+    mCounters->GetXaxis()->SetBinLabel(1, "collisions: all");
+    mCounters->GetXaxis()->SetBinLabel(2, "collisions: accepted");
+    hPrescales->GetXaxis()->SetBinLabel(1, "collisions");
+    hPrescales->SetBinContent(1, mPrescaleCollisions);
+    for (std::size_t i = 0; i < groups.size(); i++) {
+      mCounters->GetXaxis()->SetBinLabel(3 + 2 * i, (groups[i].first + ": all").c_str());
+      mCounters->GetXaxis()->SetBinLabel(4 + 2 * i, (groups[i].first + ": accepted").c_str());
+      hPrescales->GetXaxis()->SetBinLabel(2 + i, groups[i].first.c_str());
+      // total prescale of the group
+      hPrescales->SetBinContent(2 + i, mPrescaleCollisions * mPrescaleGroups[i]);
+    }
+    LOG(info) << "QaPrescale: 1 collision out of " << mPrescaleCollisions << " processed, seed " << mSeed;
+  }
+
+  /// Decides if a collision is processed and counts it
+  /// \return true if the collision is accepted, in 1 case out of prescaleCollisions
+  bool acceptCollision(uint64_t globalBC)
+  {
+    const bool accepted = (hash(globalBC ^ mSeed) % mPrescaleCollisions) == 0;
+    count(0, accepted);
+    return accepted;
+  }
+
+  /// Decides if a group of histograms is filled for a collision and counts it
+  /// The group is filled only for accepted collisions, with the bits of the hash not used for the collisions,
+  /// so the accepted fraction is 1/(prescaleCollisions * prescaleGroup)
+  bool acceptGroup(int group, uint64_t globalBC)
+  {
+    const uint64_t h = hash(globalBC ^ mSeed);
+    const bool accepted = (h % mPrescaleCollisions) == 0 && ((h / mPrescaleCollisions) % mPrescaleGroups[group]) == 0;
+    count(1 + group, accepted);
+    return accepted;
+  }
+
+  bool isEnabled() const { return mPrescaleCollisions > 1; }
+
+ private:
+  // splitmix64 finalizer, a deterministic and well mixed hash of the global BC
+  static uint64_t hash(uint64_t x)
+  {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+  }
+
+  void count(int counter, bool accepted)
+  {
+    mCounters->Fill(1 + 2 * counter);
+    if (accepted) {
+      mCounters->Fill(2 + 2 * counter);
+    }
+  }
+
+  uint64_t mPrescaleCollisions = 1;
+  uint64_t mSeed = 0;
+  std::vector<uint64_t> mPrescaleGroups;
+  std::shared_ptr<TH1> mCounters;
+};
+
+#endif // DPG_TASKS_QAPRESCALE_H_
@@ -154,6 +154,25 @@ struct HfFilter { // Main struct for HF triggers
   // helper object
   HfFilterHelper helper;
 
+  // V0 and photon selections of the current collision, evaluated once at the first charm candidate which needs them
+  std::vector<int8_t> selV0sThisColl{};
+  std::vector<bool> selPhotonsThisColl{};
+  bool areV0sSelected{false};
+  bool arePhotonsSelected{false};
+
+  // bachelor tracks of the current collision, propagated to its primary vertex once instead of once per charm candidate
+  struct BachelorTrack {
+    o2::track::TrackPar trackPar;
+    o2::gpu::gpustd::array<float, 2> dca;
+    std::array<float, 3> pVec;
+    int8_t selBeauty3P;    // isSelectedTrackForSoftPionOrBeauty for kBeauty3P
+    int8_t selBeauty4P;    // isSelectedTrackForSoftPionOrBeauty for kBeauty4P
+    int8_t selSoftPiSc;    // isSelectedTrackForSoftPionOrBeauty for kSigmaCPPK and kSigmaC0K0
+    int8_t selSoftPiDstar; // isSelectedTrackForSoftPionOrBeauty without trigger
+  };
+  std::vector<BachelorTrack> bachelorsThisColl{};
+  bool areBachelorsPropagated{false};
+
   void init(InitContext&)
   {
     helper.setHighPtTriggerThresholds(ptThresholds->get(0u, 0u), ptThresholds->get(0u, 1u));
@@ -274,6 +293,62 @@ struct HfFilter { // Main struct for HF triggers
   Preslice<aod::CascDatas> cascPerCollision = aod::cascdata::collisionId;
   Preslice<aod::V0PhotonsKF> photonsPerCollision = aod::v0photonkf::collisionId;
 
+  /// Selects the V0s of a collision, if not already done for this collision
+  template <typename V0s, typename Coll>
+  void selectV0s(V0s const& v0sThisColl, Coll const& collision)
+  {
+    if (areV0sSelected) {
+      return;
+    }
+    selV0sThisColl.clear();
+    for (const auto& v0 : v0sThisColl) {
+      auto posTrack = v0.template posTrack_as<BigTracksPID>();
+      auto negTrack = v0.template negTrack_as<BigTracksPID>();
+      selV0sThisColl.push_back(helper.isSelectedV0(v0, std::array{posTrack, negTrack}, collision, activateQA, hV0Selected, hArmPod));
+    }
+    areV0sSelected = true;
+  }
+
+  /// Selects the photons of a collision, if not already done for this collision
+  template <typename Photons>
+  void selectPhotons(Photons const& photonsThisColl)
+  {
+    if (arePhotonsSelected) {
+      return;
+    }
+    selPhotonsThisColl.clear();
+    for (const auto& photon : photonsThisColl) {
+      auto posTrack = photon.template posTrack_as<aod::V0Legs>();
+      auto negTrack = photon.template negTrack_as<aod::V0Legs>();
+      selPhotonsThisColl.push_back(helper.isSelectedPhoton(photon, std::array{posTrack, negTrack}, activateQA, hV0Selected, hArmPod));
+    }
+    arePhotonsSelected = true;
+  }
+
+  /// Propagates the tracks of a collision to its primary vertex and selects them as bachelors, if not already done for this collision
+  template <typename TrackIds, typename Coll>
+  void propagateBachelors(TrackIds const& trackIdsThisColl, Coll const& collision)
+  {
+    if (areBachelorsPropagated) {
+      return;
+    }
+    bachelorsThisColl.clear();
+    for (const auto& trackId : trackIdsThisColl) {
+      auto track = trackId.template track_as<BigTracksPID>();
+      auto& bachelor = bachelorsThisColl.emplace_back(BachelorTrack{getTrackPar(track), {track.dcaXY(), track.dcaZ()}, track.pVector(), 0, 0, 0, 0});
+      if (track.collisionId() != collision.globalIndex()) {
+        // this is a track reassociated to this PV by the track-to-collision-associator
+        o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, bachelor.trackPar, 2.f, noMatCorr, &bachelor.dca);
+        getPxPyPz(bachelor.trackPar, bachelor.pVec);
+      }
+      bachelor.selBeauty3P = helper.isSelectedTrackForSoftPionOrBeauty(track, bachelor.trackPar, bachelor.dca, kBeauty3P);
+      bachelor.selBeauty4P = helper.isSelectedTrackForSoftPionOrBeauty(track, bachelor.trackPar, bachelor.dca, kBeauty4P);
+      bachelor.selSoftPiSc = helper.isSelectedTrackForSoftPionOrBeauty(track, bachelor.trackPar, bachelor.dca, kSigmaCPPK);
+      bachelor.selSoftPiDstar = helper.isSelectedTrackForSoftPionOrBeauty(track, bachelor.trackPar, bachelor.dca, -1);
+    }
+    areBachelorsPropagated = true;
+  }
+
   void process(CollsWithEvSel const& collisions,
                aod::BCsWithTimestamps const&,
                aod::V0Datas const& v0s,
@@ -295,6 +370,9 @@ struct HfFilter { // Main struct for HF triggers
       }
 
       auto thisCollId = collision.globalIndex();
+      areV0sSelected = false;
+      arePhotonsSelected = false;
+      areBachelorsPropagated = false;
 
       if (applyOptimisation) {
         optimisationTreeCollisions(thisCollId);
@@ -401,23 +479,22 @@ struct HfFilter { // Main struct for HF triggers
         auto massD0BarCand = RecoDecay::m(std::array{pVecPos, pVecNeg}, std::array{massKa, massPi});
 
         auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
+        propagateBachelors(trackIdsThisCollision, collision);
+        int iTrack{-1};
         for (const auto& trackId : trackIdsThisCollision) { // start loop over tracks
           auto track = trackId.track_as<BigTracksPID>();
+          const auto& bachelorThird = bachelorsThisColl[++iTrack];
 
           if (track.globalIndex() == trackPos.globalIndex() || track.globalIndex() == trackNeg.globalIndex()) {
             continue;
           }
 
-          auto trackParThird = getTrackPar(track);
-          o2::gpu::gpustd::array<float, 2> dcaThird{track.dcaXY(), track.dcaZ()};
-          std::array<float, 3> pVecThird = track.pVector();
-          if (track.collisionId() != thisCollId) {
-            o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParThird, 2.f, noMatCorr, &dcaThird);
-            getPxPyPz(trackParThird, pVecThird);
-          }
+          const auto& trackParThird = bachelorThird.trackPar;
+          const auto& dcaThird = bachelorThird.dca;
+          const auto& pVecThird = bachelorThird.pVec;
 
           if (!keepEvent[kBeauty3P] && isBeautyTagged) {
-            auto isTrackSelected = helper.isSelectedTrackForSoftPionOrBeauty(track, trackParThird, dcaThird, kBeauty3P);
+            auto isTrackSelected = bachelorThird.selBeauty3P;
             if (isTrackSelected && ((TESTBIT(selD0, 0) && track.sign() > 0) || (TESTBIT(selD0, 1) && track.sign() < 0))) {
               auto massCand = RecoDecay::m(std::array{pVec2Prong, pVecThird}, std::array{massD0, massPi});
               auto pVecBeauty3Prong = RecoDecay::pVec(pVec2Prong, pVecThird);
@@ -445,20 +522,17 @@ struct HfFilter { // Main struct for HF triggers
                   if (activateQA) {
                     hMassVsPtC[kNCharmParticles]->Fill(ptCand, massDiffDstar);
                   }
+                  int iTrackB{-1};
                   for (const auto& trackIdB : trackIdsThisCollision) { // start loop over tracks
                     auto trackB = trackIdB.track_as<BigTracksPID>();
+                    const auto& bachelorFourth = bachelorsThisColl[++iTrackB];
                     if (track.globalIndex() == trackB.globalIndex()) {
                       continue;
                     }
-                    auto trackParFourth = getTrackPar(trackB);
-                    o2::gpu::gpustd::array<float, 2> dcaFourth{trackB.dcaXY(), trackB.dcaZ()};
-                    std::array<float, 3> pVecFourth = trackB.pVector();
-                    if (trackB.collisionId() != thisCollId) {
-                      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParFourth, 2.f, noMatCorr, &dcaFourth);
-                      getPxPyPz(trackParFourth, pVecFourth);
-                    }
+                    const auto& dcaFourth = bachelorFourth.dca;
+                    const auto& pVecFourth = bachelorFourth.pVec;
 
-                    auto isTrackFourthSelected = helper.isSelectedTrackForSoftPionOrBeauty(trackB, trackParFourth, dcaFourth, kBeauty3P);
+                    auto isTrackFourthSelected = bachelorFourth.selBeauty3P;
                     if (track.sign() * trackB.sign() < 0 && TESTBIT(isTrackFourthSelected, kForBeauty)) {
                       auto massCandB0 = RecoDecay::m(std::array{pVecBeauty3Prong, pVecFourth}, std::array{massDStar, massPi});
                       if (std::fabs(massCandB0 - massB0) <= deltaMassBeauty->get(0u, 2u)) {
@@ -502,10 +576,10 @@ struct HfFilter { // Main struct for HF triggers
         // 2-prong with Gamma (conversion photon)
         if (!keepEvent[kPhotonCharm2P] && isSignalTagged && (TESTBIT(selD0, 0) || TESTBIT(selD0, 1))) {
           auto photonsThisCollision = photons.sliceBy(photonsPerCollision, thisCollId);
+          selectPhotons(photonsThisCollision);
+          int iPhoton{-1};
           for (const auto& photon : photonsThisCollision) {
-            auto posTrack = photon.posTrack_as<aod::V0Legs>();
-            auto negTrack = photon.negTrack_as<aod::V0Legs>();
-            if (!helper.isSelectedPhoton(photon, std::array{posTrack, negTrack}, activateQA, hV0Selected, hArmPod)) {
+            if (!selPhotonsThisColl[++iPhoton]) {
               continue;
             }
             gpu::gpustd::array<float, 2> dcaInfo;
@@ -551,10 +625,10 @@ struct HfFilter { // Main struct for HF triggers
         // 2-prong with K0S or Lambda
         if (!keepEvent[kV0Charm2P] && isSignalTagged && (TESTBIT(selD0, 0) || TESTBIT(selD0, 1))) {
           auto v0sThisCollision = v0s.sliceBy(v0sPerCollision, thisCollId);
+          selectV0s(v0sThisCollision, collision);
+          int iV0{-1};
           for (const auto& v0 : v0sThisCollision) {
-            auto posTrack = v0.posTrack_as<BigTracksPID>();
-            auto negTrack = v0.negTrack_as<BigTracksPID>();
-            auto selV0 = helper.isSelectedV0(v0, std::array{posTrack, negTrack}, collision, activateQA, hV0Selected, hArmPod);
+            auto selV0 = selV0sThisColl[++iV0];
             if (!selV0) {
               continue;
             }
@@ -573,21 +647,16 @@ struct HfFilter { // Main struct for HF triggers
               getPxPyPz(trackParK0, pVecV0);
 
               // we first look for a D*+
+              int iBachelor{-1};
               for (const auto& trackBachelorId : trackIdsThisCollision) { // start loop over tracks
                 auto trackBachelor = trackBachelorId.track_as<BigTracksPID>();
+                const auto& bachelor = bachelorsThisColl[++iBachelor];
                 if (trackBachelor.globalIndex() == trackPos.globalIndex() || trackBachelor.globalIndex() == trackNeg.globalIndex()) {
                   continue;
                 }
 
-                auto trackParBachelor = getTrackPar(trackBachelor);
-                o2::gpu::gpustd::array<float, 2> dcaBachelor{trackBachelor.dcaXY(), trackBachelor.dcaZ()};
-                std::array<float, 3> pVecBachelor = trackBachelor.pVector();
-                if (trackBachelor.collisionId() != thisCollId) {
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParBachelor, 2.f, noMatCorr, &dcaBachelor);
-                  getPxPyPz(trackParBachelor, pVecBachelor);
-                }
-
-                int isTrackSelected = helper.isSelectedTrackForSoftPionOrBeauty(trackBachelor, trackParBachelor, dcaBachelor, -1);
+                const auto& pVecBachelor = bachelor.pVec;
+                int isTrackSelected = bachelor.selSoftPiDstar;
                 if (TESTBIT(isTrackSelected, kSoftPion) && ((TESTBIT(selD0, 0) && trackBachelor.sign() > 0) || (TESTBIT(selD0, 1) && trackBachelor.sign() < 0))) {
                   std::array<float, 2> massDausD0{massPi, massKa};
                   auto massD0dau = massD0Cand;
@@ -814,27 +883,26 @@ struct HfFilter { // Main struct for HF triggers
         } // end high-pT selection
 
         auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
+        propagateBachelors(trackIdsThisCollision, collision);
 
+        int iTrack{-1};
         for (const auto& trackId : trackIdsThisCollision) { // start loop over track indices as associated to this collision in HF code
           auto track = trackId.track_as<BigTracksPID>();
+          const auto& bachelorFourth = bachelorsThisColl[++iTrack];
           if (track.globalIndex() == trackFirst.globalIndex() || track.globalIndex() == trackSecond.globalIndex() || track.globalIndex() == trackThird.globalIndex()) {
             continue;
           }
 
-          auto trackParFourth = getTrackPar(track);
-          o2::gpu::gpustd::array<float, 2> dcaFourth{track.dcaXY(), track.dcaZ()};
-          std::array<float, 3> pVecFourth = track.pVector();
-          if (track.collisionId() != thisCollId) {
-            o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParFourth, 2.f, noMatCorr, &dcaFourth);
-            getPxPyPz(trackParFourth, pVecFourth);
-          }
+          const auto& trackParFourth = bachelorFourth.trackPar;
+          const auto& dcaFourth = bachelorFourth.dca;
+          const auto& pVecFourth = bachelorFourth.pVec;
 
           int charmParticleID[kNBeautyParticles - 2] = {o2::constants::physics::Pdg::kDPlus, o2::constants::physics::Pdg::kDS, o2::constants::physics::Pdg::kLambdaCPlus, o2::constants::physics::Pdg::kXiCPlus};
 
           float massCharmHypos[kNBeautyParticles - 2] = {massDPlus, massDs, massLc, massXic};
           float massBeautyHypos[kNBeautyParticles - 2] = {massB0, massBs, massLb, massXib};
           float deltaMassHypos[kNBeautyParticles - 2] = {deltaMassBeauty->get(0u, 1u), deltaMassBeauty->get(0u, 3u), deltaMassBeauty->get(0u, 4u), deltaMassBeauty->get(0u, 5u)};
-          auto isTrackSelected = helper.isSelectedTrackForSoftPionOrBeauty(track, trackParFourth, dcaFourth, kBeauty4P);
+          auto isTrackSelected = bachelorFourth.selBeauty4P;
           if (track.sign() * sign3Prong < 0 && TESTBIT(isTrackSelected, kForBeauty)) {
             for (int iHypo{0}; iHypo < kNBeautyParticles - 2 && !keepEvent[kBeauty4P]; ++iHypo) {
               if (isBeautyTagged[iHypo] && (TESTBIT(is3ProngInMass[iHypo], 0) || TESTBIT(is3ProngInMass[iHypo], 1))) {
@@ -878,10 +946,12 @@ struct HfFilter { // Main struct for HF triggers
             // we need a candidate Lc->pKpi and a candidate soft kaon
 
             // look for SigmaC++ candidates
+            int iSoftPi{-1};
             for (const auto& trackSoftPiId : trackIdsThisCollision) { // start loop over tracks (soft pi)
 
               // soft pion candidates
               auto trackSoftPi = trackSoftPiId.track_as<BigTracksPID>();
+              const auto& softPi = bachelorsThisColl[++iSoftPi];
               auto globalIndexSoftPi = trackSoftPi.globalIndex();
 
               // exclude tracks already used to build the 3-prong candidate
@@ -902,17 +972,9 @@ struct HfFilter { // Main struct for HF triggers
                 continue;
               }
 
-              // select soft pion candidates
-              auto trackParSoftPi = getTrackPar(trackSoftPi);
-              o2::gpu::gpustd::array<float, 2> dcaSoftPi{trackSoftPi.dcaXY(), trackSoftPi.dcaZ()};
-              std::array<float, 3> pVecSoftPi = trackSoftPi.pVector();
-              if (trackSoftPi.collisionId() != thisCollId) {
-                // This is a track reassociated to this PV by the track-to-collision-associator
-                // Let's propagate this track to it, and calculate dcaXY, dcaZ
-                o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParSoftPi, 2.f, noMatCorr, &dcaSoftPi);
-                getPxPyPz(trackParSoftPi, pVecSoftPi);
-              }
-              int8_t isSoftPionSelected = helper.isSelectedTrackForSoftPionOrBeauty(trackSoftPi, trackParSoftPi, dcaSoftPi, kSigmaCPPK);
+              // select soft pion candidates (kSigmaCPPK and kSigmaC0K0 share the same selection)
+              const auto& pVecSoftPi = softPi.pVec;
+              int8_t isSoftPionSelected = softPi.selSoftPiSc;
               if (TESTBIT(isSoftPionSelected, kSoftPionForSigmaC) /*&& (TESTBIT(is3Prong[2], 0) || TESTBIT(is3Prong[2], 1))*/) {
 
                 // check the mass of the SigmaC++ candidate
@@ -983,10 +1045,10 @@ struct HfFilter { // Main struct for HF triggers
           auto massDsKKPi = RecoDecay::m(std::array{pVecFirst, pVecSecond, pVecThird}, std::array{massKa, massKa, massPi});
           auto massDsPiKK = RecoDecay::m(std::array{pVecFirst, pVecSecond, pVecThird}, std::array{massPi, massKa, massKa});
           auto photonsThisCollision = photons.sliceBy(photonsPerCollision, thisCollId);
+          selectPhotons(photonsThisCollision);
+          int iPhoton{-1};
           for (const auto& photon : photonsThisCollision) {
-            auto posTrack = photon.posTrack_as<aod::V0Legs>();
-            auto negTrack = photon.negTrack_as<aod::V0Legs>();
-            if (!helper.isSelectedPhoton(photon, std::array{posTrack, negTrack}, activateQA, hV0Selected, hArmPod)) {
+            if (!selPhotonsThisColl[++iPhoton]) {
               continue;
             }
             gpu::gpustd::array<float, 2> dcaInfo;
@@ -1037,10 +1099,10 @@ struct HfFilter { // Main struct for HF triggers
         auto massDPlusCand = RecoDecay::m(std::array{pVecFirst, pVecSecond, pVecThird}, std::array{massPi, massKa, massPi});
 
         if ((!keepEvent[kV0Charm3P] && isGoodDPlus) || (!keepEvent[kSigmaC0K0] && (isGoodLcToPKPi || isGoodLcToPiKP))) {
+          selectV0s(v0sThisCollision, collision);
+          int iV0{-1};
           for (const auto& v0 : v0sThisCollision) {
-            auto posTrack = v0.posTrack_as<BigTracksPID>();
-            auto negTrack = v0.negTrack_as<BigTracksPID>();
-            auto selV0 = helper.isSelectedV0(v0, std::array{posTrack, negTrack}, collision, activateQA, hV0Selected, hArmPod);
+            auto selV0 = selV0sThisColl[++iV0];
             if (!selV0) {
               continue;
             }
@@ -1101,10 +1163,12 @@ struct HfFilter { // Main struct for HF triggers
             // we pair SigmaC0 with V0
             if (!keepEvent[kSigmaC0K0] && (isGoodLcToPKPi || isGoodLcToPiKP) && TESTBIT(selV0, kK0S)) {
               // look for SigmaC0 candidates
+              int iSoftPi{-1};
               for (const auto& trackSoftPiId : trackIdsThisCollision) { // start loop over tracks (soft pi)
 
                 // soft pion candidates
                 auto trackSoftPi = trackSoftPiId.track_as<BigTracksPID>();
+                const auto& softPi = bachelorsThisColl[++iSoftPi];
                 auto globalIndexSoftPi = trackSoftPi.globalIndex();
 
                 // exclude tracks already used to build the 3-prong candidate
@@ -1120,17 +1184,9 @@ struct HfFilter { // Main struct for HF triggers
                   continue;
                 }
 
-                // select soft pion candidates
-                auto trackParSoftPi = getTrackPar(trackSoftPi);
-                o2::gpu::gpustd::array<float, 2> dcaSoftPi{trackSoftPi.dcaXY(), trackSoftPi.dcaZ()};
-                std::array<float, 3> pVecSoftPi = trackSoftPi.pVector();
-                if (trackSoftPi.collisionId() != thisCollId) {
-                  // This is a track reassociated to this PV by the track-to-collision-associator
-                  // Let's propagate this track to it, and calculate dcaXY, dcaZ
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParSoftPi, 2.f, noMatCorr, &dcaSoftPi);
-                  getPxPyPz(trackParSoftPi, pVecSoftPi);
-                }
-                int8_t isSoftPionSelected = helper.isSelectedTrackForSoftPionOrBeauty(trackSoftPi, trackParSoftPi, dcaSoftPi, kSigmaC0K0);
+                // select soft pion candidates (kSigmaCPPK and kSigmaC0K0 share the same selection)
+                const auto& pVecSoftPi = softPi.pVec;
+                int8_t isSoftPionSelected = softPi.selSoftPiSc;
                 if (TESTBIT(isSoftPionSelected, kSoftPionForSigmaC) /*&& (TESTBIT(is3Prong[2], 0) || TESTBIT(is3Prong[2], 1))*/) {
 
                   // check the mass of the SigmaC0 candidate
@@ -1142,8 +1198,8 @@ struct HfFilter { // Main struct for HF triggers
                     /// and keep it only if it is in the correct mass range
 
                     float massSigmaCPKPi{-999.}, massSigmaCPiKP{-999.}, deltaMassXicResoPKPi{-999.}, deltaMassXicResoPiKP{-999.};
-                    std::array<float, 3> pVecPiPosK0s = posTrack.pVector();
-                    std::array<float, 3> pVecPiNegK0s = negTrack.pVector();
+                    std::array<float, 3> pVecPiPosK0s = v0.posTrack_as<BigTracksPID>().pVector();
+                    std::array<float, 3> pVecPiNegK0s = v0.negTrack_as<BigTracksPID>().pVector();
                     float ptSigmaCKaon = RecoDecay::pt(pVecSigmaC, pVecPiPosK0s, pVecPiNegK0s);
                     if (ptSigmaCKaon > cutsPtDeltaMassCharmReso->get(2u, 10u)) {
                       if (TESTBIT(whichSigmaC, 0)) {
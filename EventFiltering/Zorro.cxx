@@ -12,7 +12,13 @@
 
 #include "Zorro.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <map>
+#include <numeric>
+
+#include <unistd.h>
 
 #include "TH1D.h"
 
@@ -34,17 +40,34 @@ std::vector<int> Zorro::initCCDB(o2::ccdb::BasicCCDBManager* ccdb, int runNumber
   mScalers = mCCDB->getSpecific<TH1D>(mBaseCCDBPath + "FilterCounters", timestamp, metadata);
   mSelections = mCCDB->getSpecific<TH1D>(mBaseCCDBPath + "SelectionCounters", timestamp, metadata);
   mInspectedTVX = mCCDB->getSpecific<TH1D>(mBaseCCDBPath + "InspectedTVX", timestamp, metadata);
-  auto selectedBCs = mCCDB->getSpecific<std::vector<std::array<uint64_t, 2>>>(mBaseCCDBPath + "SelectedBCs", timestamp, metadata);
-  mBCranges.clear();
-  for (auto bc : *selectedBCs) {
-    mBCranges.emplace_back(InteractionRecord::long2IR(std::min(bc[0], bc[1])), InteractionRecord::long2IR(std::max(bc[0], bc[1])));
-  }
-  std::sort(mBCranges.begin(), mBCranges.end(), [](const auto& a, const auto& b) { return a.getMin() < b.getMin(); });
+  if (mLocalCachePath.empty() || !readLocalCache()) {
+    auto selectedBCs = mCCDB->getSpecific<std::vector<std::array<uint64_t, 2>>>(mBaseCCDBPath + "SelectedBCs", timestamp, metadata);
+    mSelectionBitMask = mCCDB->getSpecific<std::vector<std::array<uint64_t, 2>>>(mBaseCCDBPath + "SelectionBitMask", timestamp, metadata);
+    mFilterBitMask = mCCDB->getSpecific<std::vector<std::array<uint64_t, 2>>>(mBaseCCDBPath + "FilterBitMask", timestamp, metadata);
 
-  mSelectionBitMask = mCCDB->getSpecific<std::vector<std::array<uint64_t, 2>>>(mBaseCCDBPath + "SelectionBitMask", timestamp, metadata);
-  mFilterBitMask = mCCDB->getSpecific<std::vector<std::array<uint64_t, 2>>>(mBaseCCDBPath + "FilterBitMask", timestamp, metadata);
+    /// The BC ranges are sorted by their start, the filter bit masks are kept aligned with them
+    std::vector<size_t> order(selectedBCs->size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return std::min((*selectedBCs)[a][0], (*selectedBCs)[a][1]) < std::min((*selectedBCs)[b][0], (*selectedBCs)[b][1]); });
+    mBCranges.clear();
+    mFilterBits.clear();
+    mBCranges.reserve(order.size());
+    mFilterBits.reserve(order.size());
+    for (auto i : order) {
+      const auto& bc = (*selectedBCs)[i];
+      mBCranges.emplace_back(InteractionRecord::long2IR(std::min(bc[0], bc[1])), InteractionRecord::long2IR(std::max(bc[0], bc[1])));
+      mFilterBits.push_back(mFilterBitMask->at(i));
+    }
+    if (!mLocalCachePath.empty()) {
+      writeLocalCache();
+    }
+  }
+  mBCrangesMaxEnd.clear();
+  mBCrangesMaxEnd.reserve(mBCranges.size());
+  for (const auto& range : mBCranges) {
+    mBCrangesMaxEnd.push_back(mBCrangesMaxEnd.empty() ? range.getMax() : std::max(mBCrangesMaxEnd.back(), range.getMax()));
+  }
 
-  mLastBCglobalId = 0;
   mLastSelectedIdx = 0;
   mTOIs.clear();
   mTOIidx.clear();
@@ -63,38 +86,101 @@ std::vector<int> Zorro::initCCDB(o2::ccdb::BasicCCDBManager* ccdb, int runNumber
   return mTOIidx;
 }
 
-std::bitset<128> Zorro::fetch(uint64_t bcGlobalId, uint64_t tolerance)
+std::string Zorro::localCacheFileName() const
 {
-  std::bitset<128> result;
-  o2::dataformats::IRFrame bcFrame{InteractionRecord::long2IR(bcGlobalId) - tolerance, InteractionRecord::long2IR(bcGlobalId) + tolerance};
-  if (bcGlobalId < mLastBCglobalId) {
-    mLastSelectedIdx = 0;
+  std::string name = mBaseCCDBPath;
+  std::replace(name.begin(), name.end(), '/', '_');
+  return mLocalCachePath + "/zorro_" + name + std::to_string(mRunNumber) + ".bin";
+}
+
+bool Zorro::readLocalCache()
+{
+  std::ifstream file(localCacheFileName(), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  uint32_t version{0};
+  uint64_t nRanges{0};
+  file.read(reinterpret_cast<char*>(&version), sizeof(version));
+  file.read(reinterpret_cast<char*>(&nRanges), sizeof(nRanges));
+  if (!file || version != kLocalCacheVersion) {
+    return false;
+  }
+  /// One record per range: first BC, last BC and the two words of the filter bit mask
+  std::vector<std::array<uint64_t, 4>> records(nRanges);
+  file.read(reinterpret_cast<char*>(records.data()), nRanges * sizeof(records[0]));
+  if (!file) {
+    return false;
+  }
+  mBCranges.clear();
+  mFilterBits.clear();
+  mBCranges.reserve(nRanges);
+  mFilterBits.reserve(nRanges);
+  for (const auto& record : records) {
+    mBCranges.emplace_back(InteractionRecord::long2IR(record[0]), InteractionRecord::long2IR(record[1]));
+    mFilterBits.push_back({record[2], record[3]});
   }
-  for (size_t i = mLastSelectedIdx; i < mBCranges.size(); i++) {
+  mSelectionBitMask = nullptr;
+  mFilterBitMask = nullptr;
+  return true;
+}
+
+void Zorro::writeLocalCache() const
+{
+  std::vector<std::array<uint64_t, 4>> records;
+  records.reserve(mBCranges.size());
+  for (size_t i{0}; i < mBCranges.size(); ++i) {
+    records.push_back({static_cast<uint64_t>(mBCranges[i].getMin().toLong()), static_cast<uint64_t>(mBCranges[i].getMax().toLong()), mFilterBits[i][0], mFilterBits[i][1]});
+  }
+  /// Written to a temporary file and renamed, so that a concurrent job never reads a partial file
+  const std::string fileName = localCacheFileName();
+  const std::string tmpName = fileName + "." + std::to_string(getpid()) + ".tmp";
+  std::ofstream file(tmpName, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return;
+  }
+  const uint32_t version{kLocalCacheVersion};
+  const uint64_t nRanges{records.size()};
+  file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  file.write(reinterpret_cast<const char*>(&nRanges), sizeof(nRanges));
+  file.write(reinterpret_cast<const char*>(records.data()), nRanges * sizeof(records[0]));
+  file.close();
+  if (!file || std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    std::remove(tmpName.c_str());
+  }
+}
+
+std::array<uint64_t, 2> Zorro::fetchMask(uint64_t bcGlobalId, uint64_t tolerance)
+{
+  o2::dataformats::IRFrame bcFrame{InteractionRecord::long2IR(bcGlobalId) - tolerance, InteractionRecord::long2IR(bcGlobalId) + tolerance};
+  /// First range which can overlap with the frame, all the ranges before it end before the frame starts
+  auto first = std::lower_bound(mBCrangesMaxEnd.begin(), mBCrangesMaxEnd.end(), bcFrame.getMin());
+  for (size_t i = first - mBCrangesMaxEnd.begin(); i < mBCranges.size() && !(bcFrame.getMax() < mBCranges[i].getMin()); i++) {
     if (!bcFrame.getOverlap(mBCranges[i]).isZeroLength()) {
-      for (int iMask{0}; iMask < 2; ++iMask) {
-        for (int iTOI{0}; iTOI < 64; ++iTOI) {
-          result.set(iMask * 64 + iTOI, mFilterBitMask->at(i)[iMask] & (1ull << iTOI));
-        }
-      }
       mLastSelectedIdx = i;
-      return result;
+      return mFilterBits[i];
     }
   }
-  return result;
+  return {0ull, 0ull};
+}
+
+std::bitset<128> Zorro::fetch(uint64_t bcGlobalId, uint64_t tolerance)
+{
+  auto mask = fetchMask(bcGlobalId, tolerance);
+  return (std::bitset<128>(mask[1]) << 64) | std::bitset<128>(mask[0]);
 }
 
 bool Zorro::isSelected(uint64_t bcGlobalId, uint64_t tolerance)
 {
-  int lastSelectedIdx = mLastSelectedIdx;
-  std::bitset<128> result = fetch(bcGlobalId, tolerance);
+  uint64_t lastSelectedIdx = mLastSelectedIdx;
+  auto mask = fetchMask(bcGlobalId, tolerance);
   for (size_t i{0}; i < mTOIidx.size(); ++i) {
     if (mTOIidx[i] < 0) {
       continue;
-    } else if (result.test(mTOIidx[i])) {
+    } else if ((mask[mTOIidx[i] / 64] >> (mTOIidx[i] % 64)) & 1ull) {
       mTOIcounts[i] += (lastSelectedIdx != mLastSelectedIdx); /// Avoid double counting
       return true;
     }
   }
   return false;
-}
\ No newline at end of file
+}
@@ -14,6 +14,7 @@
 #ifndef EVENTFILTERING_ZORRO_H_
 #define EVENTFILTERING_ZORRO_H_
 
+#include <array>
 #include <bitset>
 #include <string>
 #include <vector>
@@ -35,6 +36,7 @@ class Zorro
   Zorro() = default;
   std::vector<int> initCCDB(o2::ccdb::BasicCCDBManager* ccdb, int runNumber, uint64_t timestamp, std::string tois, int bcTolerance = 500);
   std::bitset<128> fetch(uint64_t bcGlobalId, uint64_t tolerance = 100);
+  std::array<uint64_t, 2> fetchMask(uint64_t bcGlobalId, uint64_t tolerance = 100);
   bool isSelected(uint64_t bcGlobalId, uint64_t tolerance = 100);
 
   std::vector<int> getTOIcounters() const { return mTOIcounts; }
@@ -42,17 +44,26 @@ class Zorro
   void setCCDBpath(std::string path) { mBaseCCDBPath = path; }
   void setBaseCCDBPath(std::string path) { mBaseCCDBPath = path; }
   void setBCtolerance(int tolerance) { mBCtolerance = tolerance; }
+  /// Directory of an optional node-local cache of the BC ranges and filter bit masks, shared by the jobs running on the node
+  void setLocalCachePath(std::string path) { mLocalCachePath = path; }
 
  private:
+  static constexpr uint32_t kLocalCacheVersion = 1; /// to be increased when the format of the local cache changes
+  std::string localCacheFileName() const;
+  bool readLocalCache();
+  void writeLocalCache() const;
+
   std::string mBaseCCDBPath = "Users/m/mpuccio/EventFiltering/OTS/";
   int mRunNumber = 0;
   int mBCtolerance = 100;
-  uint64_t mLastBCglobalId = 0;
+  std::string mLocalCachePath;
   uint64_t mLastSelectedIdx = 0;
   TH1D* mScalers = nullptr;
   TH1D* mSelections = nullptr;
   TH1D* mInspectedTVX = nullptr;
   std::vector<o2::dataformats::IRFrame> mBCranges;
+  std::vector<o2::InteractionRecord> mBCrangesMaxEnd; /// running maximum of the range ends, for the binary search
+  std::vector<std::array<uint64_t, 2>> mFilterBits;   /// filter bit mask of each range in mBCranges
   std::vector<std::array<uint64_t, 2>>* mFilterBitMask = nullptr;
   std::vector<std::array<uint64_t, 2>>* mSelectionBitMask = nullptr;
   std::vector<std::string> mTOIs;
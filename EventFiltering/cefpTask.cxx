@@ -15,6 +15,7 @@
 #include <rapidjson/filereadstream.h>
 
 #include <iostream>
+#include <array>
 #include <cstdio>
 #include <random>
 #include <string>
@@ -330,50 +331,59 @@ struct centralEventFilterTask {
         double downscaling{colName.second};
         if (column) {
           int entry = 0;
+          uint64_t nTriggered{0}, nSelected{0};
+          const bool downscaled{downscaling < 1.}; /// the uniform numbers are in [0, 1), no need to draw them otherwise
           for (int64_t iC{0}; iC < column->num_chunks(); ++iC) {
             auto chunk{column->chunk(iC)};
             auto boolArray = std::static_pointer_cast<arrow::BooleanArray>(chunk);
             for (int64_t iS{startCollision}; iS < chunk->length(); ++iS) {
               if (boolArray->Value(iS)) {
-                mScalers->Fill(binCenter);
+                nTriggered++;
                 outTrigger[entry][decisionBin] |= triggerBit;
-                if (mUniformGenerator(mGeneratorEngine) < downscaling) {
-                  mFiltered->Fill(binCenter);
+                if (!downscaled || mUniformGenerator(mGeneratorEngine) < downscaling) {
+                  nSelected++;
                   outDecision[entry][decisionBin] |= triggerBit;
                 }
               }
               entry++;
             }
           }
+          addCounts(mScalers.get(), mScalers->FindBin(binCenter), nTriggered);
+          addCounts(mFiltered.get(), mFiltered->FindBin(binCenter), nSelected);
         }
       }
     }
     mScalers->SetBinContent(1, mScalers->GetBinContent(1) + nEvents - startCollision);
     mFiltered->SetBinContent(1, mFiltered->GetBinContent(1) + nEvents - startCollision);
 
+    /// The covariance is accumulated in a dense matrix and added to the histogram once per dataframe
+    mCovarianceCounts.fill(0ull);
+    uint64_t nTriggeredEvents{0}, nSelectedEvents{0};
     for (uint64_t iE{0}; iE < outTrigger.size(); ++iE) {
       bool triggered{false}, selected{false};
       for (uint64_t iD{0}; iD < outTrigger[0].size(); ++iD) {
-        for (int iB{0}; iB < 64; ++iB) {
-          if (!(outTrigger[iE][iD] & BIT(iB))) {
-            continue;
-          }
-          for (int jD{0}; jD < outTrigger[0].size(); ++jD) {
-            for (int iC{iB}; iC < 64; ++iC) {
-              if (outTrigger[iE][iD] & BIT(iC)) {
-                mCovariance->Fill(iD * 64 + iB, jD * 64 + iC);
-              }
+        const uint64_t word{outTrigger[iE][iD]};
+        for (uint64_t bits{word}; bits; bits &= bits - 1) {
+          const int iB{__builtin_ctzll(bits)};
+          for (uint64_t jD{0}; jD < outTrigger[0].size(); ++jD) {
+            for (uint64_t others{word & (~0ull << iB)}; others; others &= others - 1) {
+              mCovarianceCounts[(iD * 64 + iB) * 128 + jD * 64 + __builtin_ctzll(others)]++;
             }
           }
         }
         triggered = triggered || outTrigger[iE][iD];
         selected = selected || outDecision[iE][iD];
       }
-      if (triggered) {
-        mScalers->Fill(mScalers->GetNbinsX() - 1);
-      }
-      if (selected) {
-        mFiltered->Fill(mFiltered->GetNbinsX() - 1);
+      nTriggeredEvents += triggered;
+      nSelectedEvents += selected;
+    }
+    addCounts(mScalers.get(), mScalers->FindBin(mScalers->GetNbinsX() - 1), nTriggeredEvents);
+    addCounts(mFiltered.get(), mFiltered->FindBin(mFiltered->GetNbinsX() - 1), nSelectedEvents);
+    for (int iX{0}; iX < 128; ++iX) {
+      for (int iY{0}; iY < 128; ++iY) {
+        if (mCovarianceCounts[iX * 128 + iY]) {
+          addCounts(mCovariance.get(), mCovariance->FindBin(iX, iY), mCovarianceCounts[iX * 128 + iY]);
+        }
       }
     }
 
@@ -397,8 +407,22 @@ struct centralEventFilterTask {
   {
   }
 
+  /// Adds nEntries unit weight entries to a bin, as many Fill calls would do for the content and the number of entries
+  static void addCounts(TH1* histo, int bin, uint64_t nEntries)
+  {
+    if (nEntries == 0) {
+      return;
+    }
+    histo->AddBinContent(bin, nEntries);
+    if (histo->GetSumw2N()) {
+      histo->GetSumw2()->AddAt(histo->GetSumw2()->At(bin) + nEntries, bin); /// unit weights
+    }
+    histo->SetEntries(histo->GetEntries() + nEntries);
+  }
+
   std::mt19937_64 mGeneratorEngine;
   std::uniform_real_distribution<double> mUniformGenerator = std::uniform_real_distribution<double>(0., 1.);
+  std::array<uint64_t, 128 * 128> mCovarianceCounts; /// pairs of fired triggers in the current dataframe
 };
 
 WorkflowSpec defineDataProcessing(ConfigContext const& cfg)
@@ -47,6 +47,29 @@ struct BCRangeSelector {
     return bcRange;
   }
 
+  /// Adds a BC range to a list of sorted and disjoint ranges, merging it with the ranges it overlaps or is adjacent to
+  /// The collisions are sorted in time, hence the new range is almost always appended to or merged with the last ones:
+  /// the min BCs are not sorted only because the collision time resolution is not constant
+  static void addBCRange(std::vector<IRFrame>& ranges, IRFrame range)
+  {
+    auto first = ranges.end();
+    while (first != ranges.begin() && std::prev(first)->getMax().toLong() + 1 >= range.getMin().toLong()) {
+      --first;
+    }
+    auto last = first;
+    while (last != ranges.end() && last->getMin().toLong() <= range.getMax().toLong() + 1) {
+      range.getMin() = std::min(range.getMin(), last->getMin());
+      range.getMax() = std::max(range.getMax(), last->getMax());
+      ++last;
+    }
+    if (first == last) {
+      ranges.insert(first, range);
+    } else {
+      *first = range;
+      ranges.erase(first + 1, last);
+    }
+  }
+
   void run(ProcessingContext& pc)
   {
     auto bcConsumer = pc.inputs().get<TableConsumer>(aod::MetadataTrait<std::decay_t<aod::BCs>>::metadata::tableLabel());
@@ -73,14 +96,17 @@ struct BCRangeSelector {
 
     auto filt = decisions.begin();
     int firstSelectedCollision{-1};
+    IRFrame firstSelectedFrame;
     std::vector<IRFrame> bcRanges;
     int nColl{0}, nSelected{0};
     for (auto collision : cols) {
       if (filt.cefpSelected0() || filt.cefpSelected1()) {
+        IRFrame frame{getIRFrame(collision)};
         if (firstSelectedCollision < 0) {
           firstSelectedCollision = nColl;
+          firstSelectedFrame = frame;
         }
-        bcRanges.push_back(getIRFrame(collision));
+        addBCRange(bcRanges, frame);
         nSelected++;
       }
       nColl++;
@@ -99,28 +125,17 @@ struct BCRangeSelector {
     int minCollisionId = (maxCollisionId == nMB) ? 0 : firstSelectedCollision - nMB;
     auto minCollision = cols.begin() + minCollisionId;
     IRFrame minFrame{getIRFrame(minCollision)};
-    bcRanges[0].getMin() = std::min(bcRanges[0].getMin(), minFrame.getMin());
+    /// the MB events extend the range of the first selected collision, which is contained in the merged ranges already
+    IRFrame mbFrame{firstSelectedFrame};
+    mbFrame.getMin() = std::min(mbFrame.getMin(), minFrame.getMin());
     if (maxCollisionId == nMB) {
       auto maxCollision = cols.begin() + nMB;
       IRFrame maxFrame{getIRFrame(maxCollision)};
-      bcRanges[0].getMax() = std::max(bcRanges[0].getMax(), maxFrame.getMax());
-    }
-
-    /// We cannot merge the ranges in the previous loop because while collisions are sorted by time, the corresponding minBCs can be unsorted as the collision time resolution is not constant
-    std::sort(bcRanges.begin(), bcRanges.end(), [](const IRFrame& a, const IRFrame& b) {
-      return a.getMin() < b.getMin();
-    });
-
-    std::vector<IRFrame> bcRangesMerged(1, bcRanges[0]);
-    for (uint64_t iR{1}; iR < bcRanges.size(); ++iR) {
-      if (bcRangesMerged.back().getMax() >= bcRanges[iR].getMin()) {
-        bcRangesMerged.back().getMax() = std::max(bcRangesMerged.back().getMax(), bcRanges[iR].getMax());
-      } else {
-        bcRangesMerged.push_back(bcRanges[iR]);
-      }
+      mbFrame.getMax() = std::max(mbFrame.getMax(), maxFrame.getMax());
     }
-    bcRanges.swap(bcRangesMerged);
+    addBCRange(bcRanges, mbFrame);
 
+    tags.reserve(bcRanges.size());
     for (auto& range : bcRanges) {
       tags(range.getMin().toLong(), range.getMax().toLong());
     }
@@ -0,0 +1,174 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_ANALYSIS_CORRELATIONFILLBUFFER_H
+#define O2_ANALYSIS_CORRELATIONFILLBUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <TArrayD.h>
+#include <TArrayF.h>
+
+#include "Framework/HistogramSpec.h"
+#include "Framework/StepTHn.h"
+
+// Buffered filling of a StepTHn (e.g. the pair histogram of the CorrelationContainer)
+//
+// The caller computes the global bin of an entry from the bins of the single axes, which allows to compute
+// the bins of the quantities depending only on one of the particles once per particle instead of once per pair.
+// The entries are accumulated as (global bin, weight) and added to the StepTHn arrays in one go, in the order in
+// which they were added, so the content is identical to filling the StepTHn directly.
+
+class CorrelationFillBuffer
+{
+ public:
+  /// Sets the binning, the axes have to be the ones of the StepTHn, in the same order
+  /// \param axes axes of the StepTHn
+  /// \param capacity number of entries after which the buffer is flushed
+  void init(const std::vector<o2::framework::AxisSpec>& axes, std::size_t capacity = 65536)
+  {
+    mAxes.clear();
+    for (const auto& spec : axes) {
+      Axis axis;
+      if (spec.nBins.has_value()) {
+        axis.nBins = spec.nBins.value();
+        axis.min = spec.binEdges[0];
+        axis.max = spec.binEdges[1];
+      } else {
+        axis.nBins = spec.binEdges.size() - 1;
+        axis.min = spec.binEdges.front();
+        axis.max = spec.binEdges.back();
+        axis.edges = spec.binEdges;
+      }
+      mAxes.push_back(axis);
+    }
+    mStrides.assign(mAxes.size(), 1);
+    for (int i = static_cast<int>(mAxes.size()) - 2; i >= 0; i--) {
+      mStrides[i] = mStrides[i + 1] * mAxes[i + 1].nBins;
+    }
+    mCapacity = capacity;
+    mEntries.clear();
+    mEntries.reserve(mCapacity);
+  }
+
+  /// Bin of a value on an axis, counted from 0 as in the StepTHn arrays, -1 for under- and overflows (not stored in a StepTHn)
+  int findBin(int axis, double value) const
+  {
+    const Axis& a = mAxes[axis];
+    if (value < a.min || !(value < a.max)) {
+      return -1;
+    }
+    if (a.edges.empty()) {
+      // same arithmetic as TAxis::FindBin
+      return static_cast<int>(a.nBins * (value - a.min) / (a.max - a.min));
+    }
+    return std::upper_bound(a.edges.begin(), a.edges.end(), value) - a.edges.begin() - 1;
+  }
+
+  /// Offset in the global bin of a bin of an axis
+  Long64_t offset(int axis, int bin) const { return bin * mStrides[axis]; }
+
+  /// Adds an entry, the buffer is flushed when it is full or when the histogram or the step change
+  void add(StepTHn* hist, int step, Long64_t bin, double weight)
+  {
+    if (hist != mHist || step != mStep) {
+      flush();
+      mHist = hist;
+      mStep = step;
+    }
+    // the StepTHn creates its arrays on the first fill (and sumw2 on the first fill with weight != 1), this entry is therefore filled directly
+    if (hist->getValues(step) == nullptr || (weight != 1. && hist->getSumw2(step) == nullptr)) {
+      flush();
+      fillDirect(bin, weight);
+      return;
+    }
+    mEntries.push_back({bin, weight});
+    if (mEntries.size() >= mCapacity) {
+      flush();
+    }
+  }
+
+  /// Adds the buffered entries to the StepTHn
+  void flush()
+  {
+    if (mEntries.empty()) {
+      return;
+    }
+    TArray* values = mHist->getValues(mStep);
+    TArray* sumw2 = mHist->getSumw2(mStep);
+    if (auto* array = dynamic_cast<TArrayF*>(values)) {
+      addEntries(array->GetArray(), sumw2 ? dynamic_cast<TArrayF*>(sumw2)->GetArray() : nullptr);
+    } else if (auto* array = dynamic_cast<TArrayD*>(values)) {
+      addEntries(array->GetArray(), sumw2 ? dynamic_cast<TArrayD*>(sumw2)->GetArray() : nullptr);
+    } else {
+      for (const auto& entry : mEntries) {
+        values->SetAt(values->GetAt(entry.bin) + entry.weight, entry.bin);
+        if (sumw2) {
+          sumw2->SetAt(sumw2->GetAt(entry.bin) + entry.weight * entry.weight, entry.bin);
+        }
+      }
+    }
+    mEntries.clear();
+  }
+
+ private:
+  struct Axis {
+    int nBins = 0;
+    double min = 0;
+    double max = 0;
+    std::vector<double> edges; // only for axes with variable bin width
+  };
+  struct Entry {
+    Long64_t bin;
+    double weight;
+  };
+
+  template <typename T>
+  void addEntries(T* values, T* sumw2)
+  {
+    for (const auto& entry : mEntries) {
+      values[entry.bin] += entry.weight;
+    }
+    if (sumw2) {
+      for (const auto& entry : mEntries) {
+        sumw2[entry.bin] += entry.weight * entry.weight;
+      }
+    }
+  }
+
+  // fills an entry through StepTHn::Fill, at the centre of its bin
+  void fillDirect(Long64_t bin, double weight)
+  {
+    std::vector<double> positionAndWeight(mAxes.size() + 1);
+    for (std::size_t i = 0; i < mAxes.size(); i++) {
+      const Axis& a = mAxes[i];
+      const int axisBin = (bin / mStrides[i]) % a.nBins;
+      if (a.edges.empty()) {
+        positionAndWeight[i] = a.min + (axisBin + 0.5) * (a.max - a.min) / a.nBins;
+      } else {
+        positionAndWeight[i] = 0.5 * (a.edges[axisBin] + a.edges[axisBin + 1]);
+      }
+    }
+    positionAndWeight[mAxes.size()] = weight;
+    mHist->Fill(mStep, positionAndWeight.size(), positionAndWeight.data());
+  }
+
+  std::vector<Axis> mAxes;
+  std::vector<Long64_t> mStrides; // stride of each axis in the global bin, the last axis runs fastest as in StepTHn
+  std::vector<Entry> mEntries;
+  std::size_t mCapacity = 0;
+  StepTHn* mHist = nullptr;
+  int mStep = -1;
+};
+
+#endif
@@ -0,0 +1,161 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_ANALYSIS_FEMTOPAIRENGINE_H
+#define O2_ANALYSIS_FEMTOPAIRENGINE_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Particle store and close-pair rejection shared by the femtoscopic pair tasks
+//
+// The selected particles of a collision are stored as structure of arrays (p, pT, eta, phi, charge, PID bits)
+// together with their phi* at a configurable set of TPC radii. phi* is therefore computed once per particle
+// and radius instead of once per pair, and the close-pair rejection only reads the cached values.
+// The selections stay in the tasks, which add to the store the particles they accepted.
+
+namespace o2::analysis::femto
+{
+
+class FemtoParticleSoA
+{
+ public:
+  /// Sets the TPC radii (in m) at which phi* is cached, the store is emptied
+  void setRadii(const std::vector<float>& radii)
+  {
+    mRadii = radii;
+    clear();
+  }
+
+  void clear()
+  {
+    mP.clear();
+    mPt.clear();
+    mEta.clear();
+    mPhi.clear();
+    mSign.clear();
+    mPIDBits.clear();
+    mMagField.clear();
+    mPhiStar.clear();
+  }
+
+  void reserve(std::size_t n)
+  {
+    mP.reserve(n);
+    mPt.reserve(n);
+    mEta.reserve(n);
+    mPhi.reserve(n);
+    mSign.reserve(n);
+    mPIDBits.reserve(n);
+    mMagField.reserve(n);
+    mPhiStar.reserve(n * mRadii.size());
+  }
+
+  /// Adds a particle and computes its phi* at the configured radii
+  /// \param magField magnetic field (in T) of the collision of the particle, phi* is not defined for 0
+  /// \return index of the particle in the store
+  std::size_t add(float p, float pt, float eta, float phi, float sign, float magField, uint32_t pidBits = 0)
+  {
+    mP.push_back(p);
+    mPt.push_back(pt);
+    mEta.push_back(eta);
+    mPhi.push_back(phi);
+    mSign.push_back(static_cast<int8_t>(sign));
+    mPIDBits.push_back(pidBits);
+    mMagField.push_back(magField);
+    for (const auto& radius : mRadii) {
+      mPhiStar.push_back(phiStar(p, eta, sign, phi, magField, radius));
+    }
+    return mP.size() - 1;
+  }
+
+  /// Adds a track providing p(), pt(), eta(), phi() and sign()
+  template <typename T>
+  std::size_t addTrack(const T& track, float magField, uint32_t pidBits = 0)
+  {
+    return add(track.p(), track.pt(), track.eta(), track.phi(), track.sign(), magField, pidBits);
+  }
+
+  /// phi* of a track at a radius, -1000 if the magnetic field is 0
+  static float phiStar(float p, float eta, float sign, float phi, float magField, float radius)
+  {
+    if (magField == 0.0) {
+      return -1000.0;
+    }
+    return phi + std::asin(-0.3 * magField * sign * radius / (2.0 * p / std::cosh(eta)));
+  }
+
+  std::size_t size() const { return mP.size(); }
+  std::size_t nRadii() const { return mRadii.size(); }
+  float radius(std::size_t iRadius) const { return mRadii[iRadius]; }
+
+  float p(std::size_t i) const { return mP[i]; }
+  float pt(std::size_t i) const { return mPt[i]; }
+  float eta(std::size_t i) const { return mEta[i]; }
+  float phi(std::size_t i) const { return mPhi[i]; }
+  int sign(std::size_t i) const { return mSign[i]; }
+  uint32_t pidBits(std::size_t i) const { return mPIDBits[i]; }
+  float magField(std::size_t i) const { return mMagField[i]; }
+  float phiStar(std::size_t i, std::size_t iRadius) const { return mPhiStar[i * mRadii.size() + iRadius]; }
+
+ private:
+  std::vector<float> mRadii;      // TPC radii at which phi* is cached
+  std::vector<float> mP;          // momentum
+  std::vector<float> mPt;         // transverse momentum
+  std::vector<float> mEta;        // pseudorapidity
+  std::vector<float> mPhi;        // azimuthal angle
+  std::vector<int8_t> mSign;      // charge
+  std::vector<uint32_t> mPIDBits; // PID bits set by the task
+  std::vector<float> mMagField;   // magnetic field of the collision of the particle
+  std::vector<float> mPhiStar;    // phi* per particle and radius, the radius runs fastest
+};
+
+/// Difference in eta of two particles
+inline float etaDiff(const FemtoParticleSoA& first, std::size_t i, const FemtoParticleSoA& second, std::size_t j)
+{
+  return first.eta(i) - second.eta(j);
+}
+
+/// Difference in phi* of two particles at a cached radius
+inline float phiStarDiff(const FemtoParticleSoA& first, std::size_t i, const FemtoParticleSoA& second, std::size_t j, std::size_t iRadius)
+{
+  return first.phiStar(i, iRadius) - second.phiStar(j, iRadius);
+}
+
+/// Elliptic close-pair cut in (delta eta, delta phi*) at a cached radius, pairs without magnetic field are close by definition
+inline bool isClosePair(const FemtoParticleSoA& first, std::size_t i, const FemtoParticleSoA& second, std::size_t j, std::size_t iRadius, float deta, float dphi)
+{
+  if (first.magField(i) * second.magField(j) == 0) {
+    return true;
+  }
+  return std::pow(std::abs(etaDiff(first, i, second, j)) / deta, 2) + std::pow(std::abs(phiStarDiff(first, i, second, j, iRadius)) / dphi, 2) < 1.0f;
+}
+
+/// Average separation (in cm) of two particles over the cached radii [firstRadius, firstRadius + nRadii), -100 without magnetic field
+inline float averageSeparation(const FemtoParticleSoA& first, std::size_t i, const FemtoParticleSoA& second, std::size_t j, std::size_t firstRadius, std::size_t nRadii)
+{
+  if (first.magField(i) * second.magField(j) == 0) {
+    return -100.f;
+  }
+  const float dtheta = 2.0 * std::atan(std::exp(-first.eta(i))) - 2.0 * std::atan(std::exp(-second.eta(j)));
+  float res = 0.0;
+  for (std::size_t iRadius = firstRadius; iRadius < firstRadius + nRadii; iRadius++) {
+    const float radius = first.radius(iRadius);
+    res += std::sqrt(std::pow(2.0 * radius * std::sin(0.5 * phiStarDiff(first, i, second, j, iRadius)), 2) + std::pow(2.0 * radius * std::sin(0.5 * dtheta), 2));
+  }
+  return 100.0 * res / nRadii;
+}
+
+} // namespace o2::analysis::femto
+
+#endif
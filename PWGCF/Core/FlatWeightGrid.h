@@ -0,0 +1,140 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_ANALYSIS_FLATWEIGHTGRID_H
+#define O2_ANALYSIS_FLATWEIGHTGRID_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <TAxis.h>
+#include <TH1.h>
+#include <THnBase.h>
+
+// Flat copy of the contents of a weights histogram (a TH1/TH2/TH3 or a THn/THnSparse), looked up without TAxis::FindBin
+//
+// The contents of all the bins, under- and overflows included, are copied once (e.g. per run) into a dense array with
+// the first axis running fastest, as the global bins of TH1. A lookup then finds the bin of each coordinate with the
+// same arithmetic as TAxis::FindBin, so the weights are the ones of GetBinContent(FindBin(...)).
+// Optionally the inverse of the contents is stored (1 for the empty bins), for the tables of the weights 1/w.
+// Used for the NUA/NUE weights of the GFW and of the JCorran tasks.
+
+template <typename T = double>
+class FlatWeightGrid
+{
+ public:
+  /// Copies the contents of a 1D, 2D or 3D histogram
+  /// \param inverse store 1/content, 1 for the empty bins
+  void build(const TH1* hist, bool inverse = false)
+  {
+    const TAxis* axes[3] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+    setAxes(axes, hist->GetDimension());
+    // same global bin numbering as TH1::GetBin, so the contents can be copied in order
+    for (std::size_t i = 0; i < mValues.size(); i++) {
+      mValues[i] = value(hist->GetBinContent(static_cast<int>(i)), inverse);
+    }
+  }
+
+  /// Copies the contents of a multi-dimensional histogram
+  /// \param inverse store 1/content, 1 for the empty bins
+  void build(const THnBase* hist, bool inverse = false)
+  {
+    const int nDims = hist->GetNdimensions();
+    std::vector<const TAxis*> axes(nDims);
+    for (int i = 0; i < nDims; i++) {
+      axes[i] = hist->GetAxis(i);
+    }
+    setAxes(axes.data(), nDims);
+    std::vector<int> coordinates(nDims, 0);
+    for (std::size_t i = 0; i < mValues.size(); i++) {
+      // the bins of a THnSparse which are not filled are not found and are empty
+      const Long64_t bin = hist->GetBin(coordinates.data());
+      mValues[i] = value(bin < 0 ? 0. : hist->GetBinContent(bin), inverse);
+      for (int d = 0; d < nDims && ++coordinates[d] == mAxes[d].nBins + 2; d++) {
+        coordinates[d] = 0;
+      }
+    }
+  }
+
+  void clear() { mValues.clear(); }
+  bool isBuilt() const { return !mValues.empty(); }
+  int getNdimensions() const { return mAxes.size(); }
+
+  /// Content of the bin of the coordinates, one per axis
+  T get(const double* coordinates) const
+  {
+    std::size_t index = 0;
+    for (std::size_t i = 0; i < mAxes.size(); i++) {
+      index += findBin(mAxes[i], coordinates[i]) * mAxes[i].stride;
+    }
+    return mValues[index];
+  }
+  T get(double x) const { return mValues[findBin(mAxes[0], x)]; }
+  T get(double x, double y) const { return mValues[findBin(mAxes[0], x) + findBin(mAxes[1], y) * mAxes[1].stride]; }
+  T get(double x, double y, double z) const { return mValues[findBin(mAxes[0], x) + findBin(mAxes[1], y) * mAxes[1].stride + findBin(mAxes[2], z) * mAxes[2].stride]; }
+
+ private:
+  struct Axis {
+    int nBins = 0;
+    double min = 0.;
+    double max = 0.;
+    std::vector<double> edges; // only for axes with variable bin width
+    std::size_t stride = 1;    // stride of the axis in the flat array
+  };
+
+  static T value(double content, bool inverse)
+  {
+    if (!inverse) {
+      return content;
+    }
+    return (content != 0) ? 1. / content : 1.;
+  }
+
+  void setAxes(const TAxis* const* axes, int nDims)
+  {
+    mAxes.assign(nDims, Axis{});
+    std::size_t nCells = 1;
+    for (int i = 0; i < nDims; i++) {
+      Axis& axis = mAxes[i];
+      axis.nBins = axes[i]->GetNbins();
+      axis.min = axes[i]->GetXmin();
+      axis.max = axes[i]->GetXmax();
+      if (axes[i]->IsVariableBinSize()) {
+        axis.edges.assign(axes[i]->GetXbins()->GetArray(), axes[i]->GetXbins()->GetArray() + axis.nBins + 1);
+      }
+      axis.stride = nCells;
+      nCells *= axis.nBins + 2;
+    }
+    mValues.assign(nCells, 0);
+  }
+
+  // bin of a value as TAxis::FindBin (for an axis which cannot be extended), 0 for the underflow and nBins + 1 for the overflow
+  static int findBin(const Axis& axis, double value)
+  {
+    if (value < axis.min) {
+      return 0;
+    }
+    if (!(value < axis.max)) {
+      return axis.nBins + 1;
+    }
+    if (axis.edges.empty()) {
+      // same arithmetic as TAxis::FindBin, so that the values close to the edges end up in the same bins
+      return 1 + static_cast<int>(axis.nBins * (value - axis.min) / (axis.max - axis.min));
+    }
+    return std::upper_bound(axis.edges.begin(), axis.edges.end(), value) - axis.edges.begin();
+  }
+
+  std::vector<Axis> mAxes;
+  std::vector<T> mValues;
+};
+
+#endif
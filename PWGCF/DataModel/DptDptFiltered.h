@@ -87,6 +87,16 @@ DECLARE_SOA_DYNAMIC_COLUMN(TrkID,
 DECLARE_SOA_DYNAMIC_COLUMN(PartID,
                            partid, //! The generated particle id
                            [](int8_t trackacceptedid) -> int8_t { return trackacceptedid; });
+DECLARE_SOA_COLUMN(TrackVariantsMask,
+                   trackvariantsmask,
+                   uint32_t); //! Mask of the track type variants which accepted the track, bit i for variant i
+namespace variants
+{
+/* same name as the track id of the default track type so that the consumers of the default one can consume any variant */
+DECLARE_SOA_COLUMN(TrackacceptedId,
+                   trackacceptedid,
+                   int8_t); //! Id of the track accepted by any of the track type variants, criteria: even (+) odd (-)
+} // namespace variants
 } // namespace dptdptfilter
 DECLARE_SOA_TABLE(ScannedTracks, "AOD", "SCANNEDTRACKS", //! The reconstructed tracks filtered table
                   dptdptfilter::DptDptCFAcceptedCollisionId,
@@ -105,6 +115,10 @@ DECLARE_SOA_TABLE(ScannedTrueTracks, "AOD", "SCANTRUETRACKS", //! The generated
 DECLARE_SOA_TABLE(DptDptCFTracksInfo, "AOD", "SCANDTRCKINF", //! The additional information Tracks joinable table
                   dptdptfilter::TrackacceptedId,
                   dptdptfilter::TrkID<dptdptfilter::TrackacceptedId>);
+DECLARE_SOA_TABLE(DptDptCFTracksVariantsInfo, "AOD", "SCANDTRCKVARINF", //! The track type variants information Tracks joinable table
+                  dptdptfilter::variants::TrackacceptedId,
+                  dptdptfilter::TrackVariantsMask,
+                  dptdptfilter::TrkID<dptdptfilter::variants::TrackacceptedId>);
 DECLARE_SOA_TABLE(DptDptCFGenTracksInfo, "AOD", "SCANDGENTRCKINF", //! The additional information mcParticle joinable table
                   dptdptfilter::TrackacceptedId,
                   dptdptfilter::Sign<dptdptfilter::TrackacceptedId>,
@@ -72,11 +72,6 @@ using namespace o2::framework::expressions;
     pHistPtStudy1D.push_back(histosDetailedPt.add<TH1>(TString::Format("%s", fullName.c_str()).Data(), hTitle, kTH1D, {axisX})); \
   }
 
-#define FILL_PT_HIST_1D(cutName, x, w...)                           \
-  if (!mPtStudyCuts.count(cutName))                                 \
-    LOGF(fatal, "AHTUNG! no key %s in mPtStudyCuts map!", cutName); \
-  pHistPtStudy1D[mPtStudyCuts[cutName]]->Fill(x, w);
-
 // main class
 struct RobustFluctuationObservables {
   // for vertex vs time:
@@ -185,6 +180,35 @@ struct RobustFluctuationObservables {
   map<string, int> mPtStudyCuts;
   vector<std::shared_ptr<TH1>> pHistPtStudy1D;
 
+  // pt QA histograms resolved once in init, filled per track without name lookups
+  enum PtTrackType { kPtAll = 0,
+                     kPtGlobal,
+                     kPtITS7hits,
+                     kPtITS7hitsTPC80cl,
+                     kPtITS4567,
+                     kPtITS4567TPC80cl,
+                     kPtITS567,
+                     kPtITS567TPC80cl,
+                     kPtITS67,
+                     kPtITS67TPC80cl,
+                     kNPtTrackTypes };
+  enum PtSelFolder { kPtAllBC = 0,
+                     kPtTFborder,
+                     kPtNoTFborder,
+                     kPtROFborder,
+                     kPtNoROFborder,
+                     kPtNoTFandROFborder,
+                     kNPtSelFolders };
+  enum PtSel { kPt = 0,
+               kPtWnTPCcls,
+               kPosPt,
+               kPosPtWnTPCcls,
+               kNegPt,
+               kNegPtWnTPCcls,
+               kNPtSels };
+  static constexpr const char* strPtTrackTypes[kNPtTrackTypes] = {"All", "Global", "ITS7hits", "ITS7hits_TPC80cl", "ITS4567", "ITS4567_TPC80cl", "ITS567", "ITS567_TPC80cl", "ITS67", "ITS67_TPC80cl"};
+  std::shared_ptr<TH1> pPtStudyHists[kNPtTrackTypes][kNPtSelFolders][kNPtSels];
+
   //
   TF1* funcCutEventsByMultPVvsV0A;
   TF1* funcCutEventsByMultPVvsT0C;
@@ -696,20 +720,19 @@ struct RobustFluctuationObservables {
         string cutName = (strPtSelFolderNames[i] + "/" + strPtSelNames[j]).c_str();
 
         // now add 1D histograms:
-        ADD_PT_HIST_1D("All", cutName, "", axisLogPt);
-        ADD_PT_HIST_1D("Global", cutName, "", axisLogPt);
-
-        ADD_PT_HIST_1D("ITS7hits", cutName, "", axisLogPt);
-        ADD_PT_HIST_1D("ITS7hits_TPC80cl", cutName, "", axisLogPt);
-
-        ADD_PT_HIST_1D("ITS4567", cutName, "", axisLogPt);
-        ADD_PT_HIST_1D("ITS4567_TPC80cl", cutName, "", axisLogPt);
-
-        ADD_PT_HIST_1D("ITS567", cutName, "", axisLogPt);
-        ADD_PT_HIST_1D("ITS567_TPC80cl", cutName, "", axisLogPt);
-
-        ADD_PT_HIST_1D("ITS67", cutName, "", axisLogPt);
-        ADD_PT_HIST_1D("ITS67_TPC80cl", cutName, "", axisLogPt);
+        for (const auto& strTrackType : strPtTrackTypes) {
+          ADD_PT_HIST_1D(strTrackType, cutName, "", axisLogPt);
+        }
+      }
+    }
+    if (nFolderPt != kNPtSelFolders || nCutsPtQA != kNPtSels) {
+      LOGF(fatal, "AHTUNG! pt QA folders and histograms do not match the PtSelFolder and PtSel enums!");
+    }
+    for (int k = 0; k < kNPtTrackTypes; k++) {
+      for (int i = 0; i < nFolderPt; i++) {
+        for (int j = 0; j < nCutsPtQA; j++) {
+          pPtStudyHists[k][i][j] = pHistPtStudy1D[mPtStudyCuts[string(strPtTrackTypes[k]) + "/" + strPtSelFolderNames[i] + "/" + strPtSelNames[j]]];
+        }
       }
     }
     // ### end of detailed pt study
@@ -1955,29 +1978,29 @@ struct RobustFluctuationObservables {
         bool noTF = collision.selection_bit(o2::aod::evsel::kNoTimeFrameBorder);
         bool noROF = collision.selection_bit(o2::aod::evsel::kNoITSROFrameBorder);
 
-        fillPtHistos("All", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+        fillPtHistos(kPtAll, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
         if (track.isGlobalTrack())
-          fillPtHistos("Global", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtGlobal, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
 
         if (track.itsNCls() == 7)
-          fillPtHistos("ITS7hits", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS7hits, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
         if (track.itsNCls() == 7 && track.tpcNClsFound() >= 80)
-          fillPtHistos("ITS7hits_TPC80cl", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS7hitsTPC80cl, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
 
         if (track.itsNCls() >= 4)
-          fillPtHistos("ITS4567", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS4567, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
         if (track.itsNCls() >= 4 && track.tpcNClsFound() >= 80)
-          fillPtHistos("ITS4567_TPC80cl", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS4567TPC80cl, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
 
         if (track.itsNCls() >= 5)
-          fillPtHistos("ITS567", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS567, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
         if (track.itsNCls() >= 5 && track.tpcNClsFound() >= 80)
-          fillPtHistos("ITS567_TPC80cl", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS567TPC80cl, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
 
         if (track.itsNCls() >= 6)
-          fillPtHistos("ITS67", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS67, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
         if (track.itsNCls() >= 6 && track.tpcNClsFound() >= 80)
-          fillPtHistos("ITS67_TPC80cl", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS67TPC80cl, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
 
       } // #### end of detailed pt study:
 
@@ -2333,40 +2356,40 @@ struct RobustFluctuationObservables {
     // }
   }
 
-  void fillPtHistos(string strTrackType, float pt, int charge, float w, bool noTF, bool noROF)
+  void fillPtHistos(int trackType, float pt, int charge, float w, bool noTF, bool noROF)
   {
-    fillPtHistosThisCut(strTrackType, "allBC", pt, charge, w);
+    fillPtHistosThisCut(trackType, kPtAllBC, pt, charge, w);
 
     // TF
     if (noTF)
-      fillPtHistosThisCut(strTrackType, "noTFborder", pt, charge, w);
+      fillPtHistosThisCut(trackType, kPtNoTFborder, pt, charge, w);
     else
-      fillPtHistosThisCut(strTrackType, "TFborder", pt, charge, w);
+      fillPtHistosThisCut(trackType, kPtTFborder, pt, charge, w);
 
     // ROF
     if (noROF)
-      fillPtHistosThisCut(strTrackType, "noROFborder", pt, charge, w);
+      fillPtHistosThisCut(trackType, kPtNoROFborder, pt, charge, w);
     else
-      fillPtHistosThisCut(strTrackType, "ROFborder", pt, charge, w);
+      fillPtHistosThisCut(trackType, kPtROFborder, pt, charge, w);
 
     // TF, ROF
     if (noTF && noROF)
-      fillPtHistosThisCut(strTrackType, "noTFandROFborder", pt, charge, w);
+      fillPtHistosThisCut(trackType, kPtNoTFandROFborder, pt, charge, w);
   }
 
-  void fillPtHistosThisCut(string strTrackType, string strEvSelType, float pt, int charge, float w)
+  void fillPtHistosThisCut(int trackType, int evSelType, float pt, int charge, float w)
   {
-    string strPre = strTrackType + "/" + strEvSelType;
+    const auto& hists = pPtStudyHists[trackType][evSelType];
 
-    FILL_PT_HIST_1D(strPre + "/pt", pt, 1);
-    FILL_PT_HIST_1D(strPre + "/pt_w_nTPCcls", pt, w);
+    hists[kPt]->Fill(pt, 1);
+    hists[kPtWnTPCcls]->Fill(pt, w);
 
     if (charge > 0) {
-      FILL_PT_HIST_1D(strPre + "/pos_pt", pt, 1);
-      FILL_PT_HIST_1D(strPre + "/pos_pt_w_nTPCcls", pt, w);
+      hists[kPosPt]->Fill(pt, 1);
+      hists[kPosPtWnTPCcls]->Fill(pt, w);
     } else {
-      FILL_PT_HIST_1D(strPre + "/neg_pt", pt, 1);
-      FILL_PT_HIST_1D(strPre + "/neg_pt_w_nTPCcls", pt, w);
+      hists[kNegPt]->Fill(pt, 1);
+      hists[kNegPtWnTPCcls]->Fill(pt, w);
     }
   }
 
@@ -25,11 +25,15 @@
 // #include "Framework/Logger.h"
 // #include "Common/DataModel/Multiplicity.h"
 
+#include <algorithm>
+#include <cmath>
+#include <string>
 #include <vector>
 #include <memory>
 #include "TLorentzVector.h"
 #include "TVector3.h"
 #include "TDatabasePDG.h"
+#include "Framework/Logger.h"
 
 double particle_mass(int PDGcode)
 {
@@ -103,6 +107,66 @@ Type getBinIndex(float const& value, std::vector<float> const& binning, int cons
   return res;
 }
 
+// same result as getBinIndex, the edges are searched with a binary search and the sub-bin delimeter is computed once
+class BinIndexFinder
+{
+ public:
+  BinIndexFinder() = default;
+  explicit BinIndexFinder(std::vector<float> const& binning, int const& NsubBins = 1) : _binning(binning), _NsubBins(NsubBins), _delimeter(std::pow(10, std::to_string(NsubBins).size())) {}
+
+  bool IsInRange(float const& value) const { return _binning.size() > 1 && value >= _binning.front() && value < _binning.back(); }
+
+  template <typename Type>
+  Type get(float const& value) const
+  {
+    if (!IsInRange(value))
+      return 10e6;
+
+    unsigned int i = std::upper_bound(_binning.begin(), _binning.end(), value) - _binning.begin() - 1;
+    if (_NsubBins < 2)
+      return (Type)i;
+
+    float subBinWidth = (_binning[i + 1] - _binning[i]) / _NsubBins;
+    int subBin = std::floor((value - _binning[i]) / subBinWidth);
+    return (Type)i + (Type)subBin / _delimeter;
+  }
+
+ private:
+  std::vector<float> _binning;
+  int _NsubBins = 1;
+  int _delimeter = 10;
+};
+
+// histograms per (mult. bin, kT bin) stored in one vector, filled with (row, column) without a second indirection
+template <typename HistType>
+class HistosTable
+{
+ public:
+  void push_back(std::vector<std::shared_ptr<HistType>>&& row)
+  {
+    if (_nRows == 0)
+      _nColumns = row.size();
+    else if (row.size() != _nColumns)
+      LOGF(fatal, "All the rows of a HistosTable must have the same number of histograms");
+
+    for (auto& histo : row) {
+      _raw.push_back(histo.get());
+      _histos.push_back(std::move(histo));
+    }
+    _nRows++;
+  }
+
+  unsigned int size() const { return _nRows; }
+  unsigned int columns() const { return _nColumns; }
+  HistType* operator()(unsigned int const& row, unsigned int const& column) const { return _raw[row * _nColumns + column]; }
+
+ private:
+  unsigned int _nRows = 0;
+  unsigned int _nColumns = 0;
+  std::vector<HistType*> _raw;                     // for the filling
+  std::vector<std::shared_ptr<HistType>> _histos; // ownership shared with the registry
+};
+
 //====================================================================================
 
 float GetKstarFrom4vectors(TLorentzVector& first4momentum, TLorentzVector& second4momentum, bool isIdentical)
@@ -192,6 +256,7 @@ class FemtoPair
   TrackType* GetFirstParticle() const { return _first; }
   TrackType* GetSecondParticle() const { return _second; }
   bool IsIdentical() { return _isidentical; }
+  const std::array<float, 9>& GetTPCradii() const { return TPCradii; }
 
   bool IsClosePair(const float& deta, const float& dphi, const float& radius) const;
   bool IsClosePair(const float& avgSep) const { return static_cast<bool>(GetAvgSep() < avgSep); }
@@ -21,6 +21,7 @@
 #include <TParameter.h>
 #include <TH1F.h>
 
+#include "PWGCF/Core/FemtoPairEngine.h"
 #include "PWGCF/Femto3D/Core/femto3dPairTask.h"
 #include "PWGCF/Femto3D/DataModel/singletrackselector.h"
 #include "TLorentzVector.h"
@@ -90,6 +91,7 @@ struct FemtoCorrelations {
   Configurable<int> _vertexNbinsToMix{"vertexNbinsToMix", 10, "Number of vertexZ bins for the mixing"};
   Configurable<std::vector<float>> _centBins{"multBins", std::vector<float>{0.0f, 100.0f}, "multiplicity percentile/centrality binning (min:0, max:100)"};
   Configurable<int> _multNsubBins{"multSubBins", 1, "number of sub-bins to perform the mixing within"};
+  Configurable<int> _mixingDepth{"mixingDepth", 0, "number of the following collisions of the same vertex&mult bin each collision is mixed with (0 -- all the collisions of the bin in the DF)"};
   Configurable<std::vector<float>> _kTbins{"kTbins", std::vector<float>{0.0f, 100.0f}, "pair transverse momentum kT binning"};
   ConfigurableAxis CFkStarBinning{"CFkStarBinning", {500, 0.005, 5.005}, "k* binning of the CF (Nbins, lowlimit, uplimit)"};
 
@@ -107,6 +109,9 @@ struct FemtoCorrelations {
 
   bool IsIdentical;
 
+  o2::aod::singletrackselector::BinIndexFinder kTbinFinder;
+  o2::aod::singletrackselector::BinIndexFinder centBinToMixFinder;
+
   std::pair<int, std::vector<float>> TPCcuts_1;
   std::pair<int, std::vector<float>> TOFcuts_1;
 
@@ -123,6 +128,12 @@ struct FemtoCorrelations {
   std::map<int64_t, std::vector<trkType>> selectedtracks_2;
   std::map<std::pair<int, float>, std::vector<colType>> mixbins;
 
+  // selected tracks per collision in the same order as selectedtracks_1(2), with phi* cached at the TPC radii of the avg. sep. and at radiusTPC (last)
+  std::map<int64_t, o2::analysis::femto::FemtoParticleSoA> selectedparticles_1;
+  std::map<int64_t, o2::analysis::femto::FemtoParticleSoA> selectedparticles_2;
+  std::vector<float> cachedRadii;
+  std::size_t radiusTPCindex = 0;
+
   std::unique_ptr<o2::aod::singletrackselector::FemtoPair<trkType>> Pair = std::make_unique<o2::aod::singletrackselector::FemtoPair<trkType>>();
 
   Filter pFilter = o2::aod::singletrackselector::p > _min_P&& o2::aod::singletrackselector::p < _max_P;
@@ -137,20 +148,20 @@ struct FemtoCorrelations {
   Filter vertexFilter = nabs(o2::aod::singletrackselector::posZ) < _vertexZ;
 
   std::vector<std::shared_ptr<TH1>> MultHistos;
-  std::vector<std::vector<std::shared_ptr<TH1>>> kThistos;
-  std::vector<std::vector<std::shared_ptr<TH1>>> mThistos; // test
-  std::vector<std::vector<std::shared_ptr<TH1>>> SEhistos_1D;
-  std::vector<std::vector<std::shared_ptr<TH1>>> MEhistos_1D;
+  o2::aod::singletrackselector::HistosTable<TH1> kThistos;
+  o2::aod::singletrackselector::HistosTable<TH1> mThistos; // test
+  o2::aod::singletrackselector::HistosTable<TH1> SEhistos_1D;
+  o2::aod::singletrackselector::HistosTable<TH1> MEhistos_1D;
 
-  std::vector<std::vector<std::shared_ptr<TH3>>> SEhistos_3D;
-  std::vector<std::vector<std::shared_ptr<TH3>>> MEhistos_3D;
-  std::vector<std::vector<std::shared_ptr<TH3>>> qLCMSvskStar;
+  o2::aod::singletrackselector::HistosTable<TH3> SEhistos_3D;
+  o2::aod::singletrackselector::HistosTable<TH3> MEhistos_3D;
+  o2::aod::singletrackselector::HistosTable<TH3> qLCMSvskStar;
 
-  std::vector<std::vector<std::shared_ptr<TH2>>> DoubleTrack_SE_histos_BC; // BC -- before cutting
-  std::vector<std::vector<std::shared_ptr<TH2>>> DoubleTrack_ME_histos_BC; // BC -- before cutting
+  o2::aod::singletrackselector::HistosTable<TH2> DoubleTrack_SE_histos_BC; // BC -- before cutting
+  o2::aod::singletrackselector::HistosTable<TH2> DoubleTrack_ME_histos_BC; // BC -- before cutting
 
-  std::vector<std::vector<std::shared_ptr<TH2>>> DoubleTrack_SE_histos_AC; // AC -- after cutting
-  std::vector<std::vector<std::shared_ptr<TH2>>> DoubleTrack_ME_histos_AC; // AC -- after cutting
+  o2::aod::singletrackselector::HistosTable<TH2> DoubleTrack_SE_histos_AC; // AC -- after cutting
+  o2::aod::singletrackselector::HistosTable<TH2> DoubleTrack_ME_histos_AC; // AC -- after cutting
 
   void init(o2::framework::InitContext&)
   {
@@ -168,6 +179,13 @@ struct FemtoCorrelations {
     Pair->SetPDG1(_particlePDG_1);
     Pair->SetPDG2(_particlePDG_2);
 
+    kTbinFinder = o2::aod::singletrackselector::BinIndexFinder(_kTbins);
+    centBinToMixFinder = o2::aod::singletrackselector::BinIndexFinder(_centBins, _multNsubBins);
+
+    cachedRadii.assign(Pair->GetTPCradii().begin(), Pair->GetTPCradii().end());
+    radiusTPCindex = cachedRadii.size();
+    cachedRadii.push_back(_radiusTPC);
+
     TPCcuts_1 = std::make_pair(_particlePDG_1, _tpcNSigma_1);
     TOFcuts_1 = std::make_pair(_particlePDG_1, _tofNSigma_1);
     TPCcuts_2 = std::make_pair(_particlePDG_2, _tpcNSigma_2);
@@ -256,8 +274,18 @@ struct FemtoCorrelations {
     }
   }
 
+  o2::analysis::femto::FemtoParticleSoA& particlesOf(std::map<int64_t, o2::analysis::femto::FemtoParticleSoA>& particles, int64_t collisionId)
+  {
+    auto it = particles.find(collisionId);
+    if (it == particles.end()) {
+      it = particles.emplace(collisionId, o2::analysis::femto::FemtoParticleSoA()).first;
+      it->second.setRadii(cachedRadii);
+    }
+    return it->second;
+  }
+
   template <typename Type>
-  void mixTracks(Type const& tracks, unsigned int multBin)
+  void mixTracks(Type const& tracks, o2::analysis::femto::FemtoParticleSoA const& particles, unsigned int multBin)
   { // template for identical particles from the same collision
     if (multBin > SEhistos_1D.size())
       LOGF(fatal, "multBin value passed to the mixTracks function exceeds the configured number of Cent. bins (1D)");
@@ -270,34 +298,34 @@ struct FemtoCorrelations {
         Pair->SetPair(tracks[ii], tracks[iii]);
         float pair_kT = Pair->GetKt();
 
-        if (pair_kT < *_kTbins.value.begin() || pair_kT >= *(_kTbins.value.end() - 1))
+        if (!kTbinFinder.IsInRange(pair_kT))
           continue;
 
-        unsigned int kTbin = o2::aod::singletrackselector::getBinIndex<unsigned int>(pair_kT, _kTbins);
-        if (kTbin > SEhistos_1D[multBin].size())
+        unsigned int kTbin = kTbinFinder.get<unsigned int>(pair_kT);
+        if (kTbin > SEhistos_1D.columns())
           LOGF(fatal, "kTbin value obtained for a pair exceeds the configured number of kT bins (1D)");
-        if (_fill3dCF && kTbin > SEhistos_3D[multBin].size())
+        if (_fill3dCF && kTbin > SEhistos_3D.columns())
           LOGF(fatal, "kTbin value obtained for a pair exceeds the configured number of kT bins (3D)");
 
         if (_fillDetaDphi % 2 == 0)
-          DoubleTrack_SE_histos_BC[multBin][kTbin]->Fill(Pair->GetPhiStarDiff(_radiusTPC), Pair->GetEtaDiff());
+          DoubleTrack_SE_histos_BC(multBin, kTbin)->Fill(o2::analysis::femto::phiStarDiff(particles, ii, particles, iii, radiusTPCindex), Pair->GetEtaDiff());
 
-        if (_deta > 0 && _dphi > 0 && Pair->IsClosePair(_deta, _dphi, _radiusTPC))
+        if (_deta > 0 && _dphi > 0 && o2::analysis::femto::isClosePair(particles, ii, particles, iii, radiusTPCindex, _deta, _dphi))
           continue;
-        if (_avgSepTPC > 0 && Pair->IsClosePair(_avgSepTPC))
+        if (_avgSepTPC > 0 && o2::analysis::femto::averageSeparation(particles, ii, particles, iii, 0, radiusTPCindex) < _avgSepTPC)
           continue;
 
         if (_fillDetaDphi > 0)
-          DoubleTrack_SE_histos_AC[multBin][kTbin]->Fill(Pair->GetPhiStarDiff(_radiusTPC), Pair->GetEtaDiff());
+          DoubleTrack_SE_histos_AC(multBin, kTbin)->Fill(o2::analysis::femto::phiStarDiff(particles, ii, particles, iii, radiusTPCindex), Pair->GetEtaDiff());
 
-        kThistos[multBin][kTbin]->Fill(pair_kT);
-        mThistos[multBin][kTbin]->Fill(Pair->GetMt());       // test
-        SEhistos_1D[multBin][kTbin]->Fill(Pair->GetKstar()); // close pair rejection and fillig the SE histo
+        kThistos(multBin, kTbin)->Fill(pair_kT);
+        mThistos(multBin, kTbin)->Fill(Pair->GetMt());       // test
+        SEhistos_1D(multBin, kTbin)->Fill(Pair->GetKstar()); // close pair rejection and fillig the SE histo
 
         if (_fill3dCF) {
           std::mt19937 mt(std::chrono::steady_clock::now().time_since_epoch().count());
           TVector3 qLCMS = std::pow(-1, (mt() % 2)) * Pair->GetQLCMS(); // introducing randomness to the pair order ([first, second]); important only for 3D because if there are any sudden order/correlation in the tables, it could couse unwanted asymmetries in the final 3d rel. momentum distributions; irrelevant in 1D case because the absolute value of the rel.momentum is taken
-          SEhistos_3D[multBin][kTbin]->Fill(qLCMS.X(), qLCMS.Y(), qLCMS.Z());
+          SEhistos_3D(multBin, kTbin)->Fill(qLCMS.X(), qLCMS.Y(), qLCMS.Z());
         }
         Pair->ResetPair();
       }
@@ -305,65 +333,65 @@ struct FemtoCorrelations {
   }
 
   template <int SE_or_ME, typename Type>
-  void mixTracks(Type const& tracks1, Type const& tracks2, unsigned int multBin)
+  void mixTracks(Type const& tracks1, o2::analysis::femto::FemtoParticleSoA const& particles1, Type const& tracks2, o2::analysis::femto::FemtoParticleSoA const& particles2, unsigned int multBin)
   { // last value: 0 -- SE; 1 -- ME
     if (multBin > SEhistos_1D.size())
       LOGF(fatal, "multBin value passed to the mixTracks function exceeds the configured number of Cent. bins (1D)");
     if (_fill3dCF && multBin > SEhistos_3D.size())
       LOGF(fatal, "multBin value passed to the mixTracks function exceeds the configured number of Cent. bins (3D)");
 
-    for (auto ii : tracks1) {
-      for (auto iii : tracks2) {
+    for (unsigned int ii = 0; ii < tracks1.size(); ii++) {
+      for (unsigned int iii = 0; iii < tracks2.size(); iii++) {
 
-        Pair->SetPair(ii, iii);
+        Pair->SetPair(tracks1[ii], tracks2[iii]);
         float pair_kT = Pair->GetKt();
 
-        if (pair_kT < *_kTbins.value.begin() || pair_kT >= *(_kTbins.value.end() - 1))
+        if (!kTbinFinder.IsInRange(pair_kT))
           continue;
 
-        unsigned int kTbin = o2::aod::singletrackselector::getBinIndex<unsigned int>(pair_kT, _kTbins);
-        if (kTbin > SEhistos_1D[multBin].size())
+        unsigned int kTbin = kTbinFinder.get<unsigned int>(pair_kT);
+        if (kTbin > SEhistos_1D.columns())
           LOGF(fatal, "kTbin value obtained for a pair exceeds the configured number of kT bins (1D)");
-        if (_fill3dCF && kTbin > SEhistos_3D[multBin].size())
+        if (_fill3dCF && kTbin > SEhistos_3D.columns())
           LOGF(fatal, "kTbin value obtained for a pair exceeds the configured number of kT bins (3D)");
 
         if (_fillDetaDphi % 2 == 0) {
           if (!SE_or_ME)
-            DoubleTrack_SE_histos_BC[multBin][kTbin]->Fill(Pair->GetPhiStarDiff(_radiusTPC), Pair->GetEtaDiff());
+            DoubleTrack_SE_histos_BC(multBin, kTbin)->Fill(o2::analysis::femto::phiStarDiff(particles1, ii, particles2, iii, radiusTPCindex), Pair->GetEtaDiff());
           else
-            DoubleTrack_ME_histos_BC[multBin][kTbin]->Fill(Pair->GetPhiStarDiff(_radiusTPC), Pair->GetEtaDiff());
+            DoubleTrack_ME_histos_BC(multBin, kTbin)->Fill(o2::analysis::femto::phiStarDiff(particles1, ii, particles2, iii, radiusTPCindex), Pair->GetEtaDiff());
         }
 
-        if (_deta > 0 && _dphi > 0 && Pair->IsClosePair(_deta, _dphi, _radiusTPC))
+        if (_deta > 0 && _dphi > 0 && o2::analysis::femto::isClosePair(particles1, ii, particles2, iii, radiusTPCindex, _deta, _dphi))
           continue;
-        if (_avgSepTPC > 0 && Pair->IsClosePair(_avgSepTPC))
+        if (_avgSepTPC > 0 && o2::analysis::femto::averageSeparation(particles1, ii, particles2, iii, 0, radiusTPCindex) < _avgSepTPC)
           continue;
 
         if (_fillDetaDphi > 0) {
           if (!SE_or_ME)
-            DoubleTrack_SE_histos_AC[multBin][kTbin]->Fill(Pair->GetPhiStarDiff(_radiusTPC), Pair->GetEtaDiff());
+            DoubleTrack_SE_histos_AC(multBin, kTbin)->Fill(o2::analysis::femto::phiStarDiff(particles1, ii, particles2, iii, radiusTPCindex), Pair->GetEtaDiff());
           else
-            DoubleTrack_ME_histos_AC[multBin][kTbin]->Fill(Pair->GetPhiStarDiff(_radiusTPC), Pair->GetEtaDiff());
+            DoubleTrack_ME_histos_AC(multBin, kTbin)->Fill(o2::analysis::femto::phiStarDiff(particles1, ii, particles2, iii, radiusTPCindex), Pair->GetEtaDiff());
         }
 
         if (!SE_or_ME) {
-          SEhistos_1D[multBin][kTbin]->Fill(Pair->GetKstar());
-          kThistos[multBin][kTbin]->Fill(pair_kT);
-          mThistos[multBin][kTbin]->Fill(Pair->GetMt()); // test
+          SEhistos_1D(multBin, kTbin)->Fill(Pair->GetKstar());
+          kThistos(multBin, kTbin)->Fill(pair_kT);
+          mThistos(multBin, kTbin)->Fill(Pair->GetMt()); // test
 
           if (_fill3dCF) {
             std::mt19937 mt(std::chrono::steady_clock::now().time_since_epoch().count());
             TVector3 qLCMS = std::pow(-1, (mt() % 2)) * Pair->GetQLCMS(); // introducing randomness to the pair order ([first, second]); important only for 3D because if there are any sudden order/correlation in the tables, it could couse unwanted asymmetries in the final 3d rel. momentum distributions; irrelevant in 1D case because the absolute value of the rel.momentum is taken
-            SEhistos_3D[multBin][kTbin]->Fill(qLCMS.X(), qLCMS.Y(), qLCMS.Z());
+            SEhistos_3D(multBin, kTbin)->Fill(qLCMS.X(), qLCMS.Y(), qLCMS.Z());
           }
         } else {
-          MEhistos_1D[multBin][kTbin]->Fill(Pair->GetKstar());
+          MEhistos_1D(multBin, kTbin)->Fill(Pair->GetKstar());
 
           if (_fill3dCF) {
             std::mt19937 mt(std::chrono::steady_clock::now().time_since_epoch().count());
             TVector3 qLCMS = std::pow(-1, (mt() % 2)) * Pair->GetQLCMS(); // introducing randomness to the pair order ([first, second]); important only for 3D because if there are any sudden order/correlation in the tables, it could couse unwanted asymmetries in the final 3d rel. momentum distributions; irrelevant in 1D case because the absolute value of the rel.momentum is taken
-            MEhistos_3D[multBin][kTbin]->Fill(qLCMS.X(), qLCMS.Y(), qLCMS.Z());
-            qLCMSvskStar[multBin][kTbin]->Fill(qLCMS.X(), qLCMS.Y(), qLCMS.Z(), Pair->GetKstar());
+            MEhistos_3D(multBin, kTbin)->Fill(qLCMS.X(), qLCMS.Y(), qLCMS.Z());
+            qLCMSvskStar(multBin, kTbin)->Fill(qLCMS.X(), qLCMS.Y(), qLCMS.Z(), Pair->GetKstar());
           }
         }
         Pair->ResetPair();
@@ -396,6 +424,7 @@ struct FemtoCorrelations {
 
       if (track.sign() == _sign_1 && (track.p() < _PIDtrshld_1 ? o2::aod::singletrackselector::TPCselection(track, TPCcuts_1) : o2::aod::singletrackselector::TOFselection(track, TOFcuts_1, _tpcNSigmaResidual_1.value))) { // filling the map: eventID <-> selected particles1
         selectedtracks_1[track.singleCollSelId()].push_back(std::make_shared<decltype(track)>(track));
+        particlesOf(selectedparticles_1, track.singleCollSelId()).addTrack(track, track.template singleCollSel_as<soa::Filtered<FilteredCollisions>>().magField());
 
         registry.fill(HIST("p_first"), track.p());
         if (_particlePDG_1 == 211) {
@@ -420,6 +449,7 @@ struct FemtoCorrelations {
         continue;
       } else if (track.sign() != _sign_2 && !TOFselection(track, std::make_pair(_particlePDGtoReject, _rejectWithinNsigmaTOF)) && (track.p() < _PIDtrshld_2 ? o2::aod::singletrackselector::TPCselection(track, TPCcuts_2) : o2::aod::singletrackselector::TOFselection(track, TOFcuts_2, _tpcNSigmaResidual_2.value))) { // filling the map: eventID <-> selected particles2 if (see condition above ^)
         selectedtracks_2[track.singleCollSelId()].push_back(std::make_shared<decltype(track)>(track));
+        particlesOf(selectedparticles_2, track.singleCollSelId()).addTrack(track, track.template singleCollSel_as<soa::Filtered<FilteredCollisions>>().magField());
 
         registry.fill(HIST("p_second"), track.p());
         if (_particlePDG_2 == 211) {
@@ -461,7 +491,7 @@ struct FemtoCorrelations {
           continue;
       }
       int vertexBinToMix = std::floor((collision.posZ() + _vertexZ) / (2 * _vertexZ / _vertexNbinsToMix));
-      float centBinToMix = o2::aod::singletrackselector::getBinIndex<float>(collision.multPerc(), _centBins, _multNsubBins);
+      float centBinToMix = centBinToMixFinder.get<float>(collision.multPerc());
 
       mixbins[std::pair<int, float>{vertexBinToMix, centBinToMix}].push_back(std::make_shared<decltype(collision)>(collision));
     }
@@ -483,9 +513,10 @@ struct FemtoCorrelations {
           unsigned int centBin = std::floor((i->first).second);
           MultHistos[centBin]->Fill(col1->mult());
 
-          mixTracks(selectedtracks_1[col1->index()], centBin); // mixing SE identical
+          mixTracks(selectedtracks_1[col1->index()], particlesOf(selectedparticles_1, col1->index()), centBin); // mixing SE identical
 
-          for (unsigned int indx2 = indx1 + 1; indx2 < EvPerBin; indx2++) { // nested loop for all the combinations of collisions in a chosen mult/vertex bin
+          const unsigned int lastIndx2 = _mixingDepth > 0 ? std::min(EvPerBin, indx1 + 1 + static_cast<unsigned int>(_mixingDepth.value)) : EvPerBin;
+          for (unsigned int indx2 = indx1 + 1; indx2 < lastIndx2; indx2++) { // nested loop for all the combinations of collisions in a chosen mult/vertex bin
             if (_MEreductionFactor.value > 1) {
               std::mt19937 mt(std::chrono::steady_clock::now().time_since_epoch().count());
               if ((mt() % (_MEreductionFactor.value + 1)) < _MEreductionFactor.value)
@@ -495,7 +526,7 @@ struct FemtoCorrelations {
             auto col2 = (i->second)[indx2];
 
             Pair->SetMagField2(col2->magField());
-            mixTracks<1>(selectedtracks_1[col1->index()], selectedtracks_1[col2->index()], centBin); // mixing ME identical, in <> brackets: 0 -- SE; 1 -- ME
+            mixTracks<1>(selectedtracks_1[col1->index()], particlesOf(selectedparticles_1, col1->index()), selectedtracks_1[col2->index()], particlesOf(selectedparticles_1, col2->index()), centBin); // mixing ME identical, in <> brackets: 0 -- SE; 1 -- ME
           }
         }
       }
@@ -515,9 +546,10 @@ struct FemtoCorrelations {
           unsigned int centBin = std::floor((i->first).second);
           MultHistos[centBin]->Fill(col1->mult());
 
-          mixTracks<0>(selectedtracks_1[col1->index()], selectedtracks_2[col1->index()], centBin); // mixing SE non-identical, in <> brackets: 0 -- SE; 1 -- ME
+          mixTracks<0>(selectedtracks_1[col1->index()], particlesOf(selectedparticles_1, col1->index()), selectedtracks_2[col1->index()], particlesOf(selectedparticles_2, col1->index()), centBin); // mixing SE non-identical, in <> brackets: 0 -- SE; 1 -- ME
 
-          for (unsigned int indx2 = indx1 + 1; indx2 < EvPerBin; indx2++) { // nested loop for all the combinations of collisions in a chosen mult/vertex bin
+          const unsigned int lastIndx2 = _mixingDepth > 0 ? std::min(EvPerBin, indx1 + 1 + static_cast<unsigned int>(_mixingDepth.value)) : EvPerBin;
+          for (unsigned int indx2 = indx1 + 1; indx2 < lastIndx2; indx2++) { // nested loop for all the combinations of collisions in a chosen mult/vertex bin
             if (_MEreductionFactor.value > 1) {
               std::mt19937 mt(std::chrono::steady_clock::now().time_since_epoch().count());
               if (mt() % (_MEreductionFactor.value + 1) < _MEreductionFactor.value)
@@ -527,7 +559,7 @@ struct FemtoCorrelations {
             auto col2 = (i->second)[indx2];
 
             Pair->SetMagField2(col2->magField());
-            mixTracks<1>(selectedtracks_1[col1->index()], selectedtracks_2[col2->index()], centBin); // mixing ME non-identical, in <> brackets: 0 -- SE; 1 -- ME
+            mixTracks<1>(selectedtracks_1[col1->index()], particlesOf(selectedparticles_1, col1->index()), selectedtracks_2[col2->index()], particlesOf(selectedparticles_2, col2->index()), centBin); // mixing ME non-identical, in <> brackets: 0 -- SE; 1 -- ME
           }
         }
       }
@@ -538,11 +570,13 @@ struct FemtoCorrelations {
     for (auto i = selectedtracks_1.begin(); i != selectedtracks_1.end(); i++)
       (i->second).clear();
     selectedtracks_1.clear();
+    selectedparticles_1.clear();
 
     if (!IsIdentical) {
       for (auto i = selectedtracks_2.begin(); i != selectedtracks_2.end(); i++)
         (i->second).clear();
       selectedtracks_2.clear();
+      selectedparticles_2.clear();
     }
 
     for (auto i = mixbins.begin(); i != mixbins.end(); i++)
@@ -89,6 +89,8 @@ struct FemtoCorrelationsMC {
 
   bool IsIdentical;
 
+  o2::aod::singletrackselector::BinIndexFinder kTbinFinder;
+
   std::pair<int, std::vector<float>> TPCcuts_1;
   std::pair<int, std::vector<float>> TOFcuts_1;
 
@@ -140,6 +142,8 @@ struct FemtoCorrelationsMC {
     Pair->SetPDG1(_particlePDG_1);
     Pair->SetPDG2(_particlePDG_2);
 
+    kTbinFinder = o2::aod::singletrackselector::BinIndexFinder(_kTbins);
+
     TPCcuts_1 = std::make_pair(_particlePDG_1, _tpcNSigma_1);
     TOFcuts_1 = std::make_pair(_particlePDG_1, _tofNSigma_1);
     TPCcuts_2 = std::make_pair(_particlePDG_2, _tpcNSigma_2);
@@ -237,10 +241,10 @@ struct FemtoCorrelationsMC {
         Pair->SetPair(tracks[ii], tracks[iii]);
         float pair_kT = Pair->GetKt();
 
-        if (pair_kT < *_kTbins.value.begin() || pair_kT >= *(_kTbins.value.end() - 1))
+        if (!kTbinFinder.IsInRange(pair_kT))
           continue;
 
-        unsigned int kTbin = o2::aod::singletrackselector::getBinIndex<unsigned int>(pair_kT, _kTbins);
+        unsigned int kTbin = kTbinFinder.get<unsigned int>(pair_kT);
         if (kTbin > DoubleTrack_SE_histos[centBin].size())
           LOGF(fatal, "kTbin value obtained for a pair exceeds the configured number of kT bins");
 
@@ -261,10 +265,10 @@ struct FemtoCorrelationsMC {
         Pair->SetPair(ii, iii);
         float pair_kT = Pair->GetKt();
 
-        if (pair_kT < *_kTbins.value.begin() || pair_kT >= *(_kTbins.value.end() - 1))
+        if (!kTbinFinder.IsInRange(pair_kT))
           continue;
 
-        unsigned int kTbin = o2::aod::singletrackselector::getBinIndex<unsigned int>(pair_kT, _kTbins);
+        unsigned int kTbin = kTbinFinder.get<unsigned int>(pair_kT);
         if (kTbin > DoubleTrack_SE_histos[centBin].size())
           LOGF(fatal, "kTbin value obtained for a pair exceeds the configured number of kT bins");
 
@@ -287,10 +291,10 @@ struct FemtoCorrelationsMC {
         Pair->SetPair(ii, iii);
         float pair_kT = Pair->GetKt();
 
-        if (pair_kT < *_kTbins.value.begin() || pair_kT >= *(_kTbins.value.end() - 1))
+        if (!kTbinFinder.IsInRange(pair_kT))
           continue;
 
-        unsigned int kTbin = o2::aod::singletrackselector::getBinIndex<unsigned int>(pair_kT, _kTbins);
+        unsigned int kTbin = kTbinFinder.get<unsigned int>(pair_kT);
         if (kTbin > Resolution_histos[centBin].size() || kTbin > DoubleTrack_ME_histos[centBin].size())
           LOGF(fatal, "kTbin value obtained for a pair exceeds the configured number of kT bins");
 
@@ -16,6 +16,8 @@
 #ifndef PWGCF_FEMTODREAM_CORE_FEMTODREAMDETADPHISTAR_H_
 #define PWGCF_FEMTODREAM_CORE_FEMTODREAMDETADPHISTAR_H_
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -63,6 +65,7 @@ class FemtoDreamDetaDphiStar
     atWhichRadiiToSelect = atWhichRadiiToCut;
     radiiTPC = radiiTPCtoCut;
     fillQA = fillTHSparse;
+    mPhiStarCache.clear();
 
     if constexpr (mPartOneType == o2::aod::femtodreamparticle::ParticleType::kTrack && mPartTwoType == o2::aod::femtodreamparticle::ParticleType::kTrack) {
       std::string dirName = static_cast<std::string>(dirNames[0]);
@@ -430,15 +433,23 @@ class FemtoDreamDetaDphiStar
   std::array<std::shared_ptr<THnSparse>, 3> histdetadpi_eta{};
   std::array<std::shared_ptr<THnSparse>, 3> histdetadpi_phi{};
 
-  ///  Calculate phi at all required radii stored in tmpRadiiTPC
-  /// Magnetic field to be provided in Tesla
+  /// phi* of a track at the radii in tmpRadiiTPC and at radiiTPC, with the inputs it was computed from
+  struct PhiStarCacheEntry {
+    bool filled = false;
+    int charge = 0;
+    float phi0 = 0.f;
+    float pt = 0.f;
+    float magfield = 0.f;
+    std::array<float, 9> phiAtRadii{};
+    float phiAtSpecificRadii = 0.f;
+  };
+  std::vector<PhiStarCacheEntry> mPhiStarCache; ///< indexed by the global index of the track, an entry is used only if its inputs agree with the track
+
+  /// Get the charge from cutcontainer using masks
   template <typename T>
-  int PhiAtRadiiTPC(const T& part, std::vector<float>& tmpVec)
+  int ChargeFromCut(const T& part)
   {
-
-    float phi0 = part.phi();
-    // Start: Get the charge from cutcontainer using masks
-    int charge = 0.;
+    int charge = 0;
     if ((part.cut() & kSignMinusMask) == kValue0 && (part.cut() & kSignPlusMask) == kValue0) {
       charge = 0;
     } else if ((part.cut() & kSignPlusMask) == kSignPlusMask) {
@@ -448,23 +459,48 @@ class FemtoDreamDetaDphiStar
     } else {
       LOG(fatal) << "FemtoDreamDetaDphiStar: Charge bits are set wrong!";
     }
-    // End: Get the charge from cutcontainer using masks
-    float pt = part.pt();
+    return charge;
+  }
+
+  /// phi of a track of given charge and pt at a radius
+  float PhiAtRadius(float phi0, float pt, int charge, float radius) const
+  {
+    if (runOldVersion) {
+      return phi0 - std::asin(0.3 * charge * 0.1 * magfield * radius * 0.01 / (2. * pt));
+    }
+    auto arg = 0.3 * charge * magfield * radius * 0.01 / (2. * pt);
+    // for very low pT particles, this value goes outside of range -1 to 1 at at large tpc radius; asin fails
+    if (abs(arg) < 1) {
+      return phi0 - std::asin(0.3 * charge * magfield * radius * 0.01 / (2. * pt));
+    }
+    return 999.;
+  }
+
+  /// phi* of a track, computed once per track and magnetic field since a track enters many pairs (same and mixed event)
+  template <typename T>
+  const PhiStarCacheEntry& CachedPhiStar(const T& part)
+  {
+    const int charge = ChargeFromCut(part);
+    const float phi0 = part.phi();
+    const float pt = part.pt();
+    const auto index = static_cast<size_t>(part.globalIndex());
+    if (index >= mPhiStarCache.size()) {
+      mPhiStarCache.resize(std::max(index + 1, 2 * mPhiStarCache.size()));
+    }
+    auto& entry = mPhiStarCache[index];
+    if (entry.filled && entry.charge == charge && entry.phi0 == phi0 && entry.pt == pt && entry.magfield == magfield) {
+      return entry;
+    }
+    entry.filled = true;
+    entry.charge = charge;
+    entry.phi0 = phi0;
+    entry.pt = pt;
+    entry.magfield = magfield;
     for (size_t i = 0; i < 9; i++) {
-      if (runOldVersion) {
-        tmpVec.push_back(phi0 - std::asin(0.3 * charge * 0.1 * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt)));
-      }
-      if (!runOldVersion) {
-        auto arg = 0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt);
-        // for very low pT particles, this value goes outside of range -1 to 1 at at large tpc radius; asin fails
-        if (abs(arg) < 1) {
-          tmpVec.push_back(phi0 - std::asin(0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt)));
-        } else {
-          tmpVec.push_back(999);
-        }
-      }
+      entry.phiAtRadii[i] = PhiAtRadius(phi0, pt, charge, tmpRadiiTPC[i]);
     }
-    return charge;
+    entry.phiAtSpecificRadii = PhiAtRadius(phi0, pt, charge, radiiTPC);
+    return entry;
   }
 
   ///  Calculate phi at specific radii
@@ -496,39 +532,18 @@ class FemtoDreamDetaDphiStar
           break;
       }
     } else {
-      phi0 = part.phi();
-      // Start: Get the charge from cutcontainer using masks
-      if ((part.cut() & kSignMinusMask) == kValue0 && (part.cut() & kSignPlusMask) == kValue0) {
-        charge = 0;
-      } else if ((part.cut() & kSignPlusMask) == kSignPlusMask) {
-        charge = 1;
-      } else if ((part.cut() & kSignMinusMask) == kSignMinusMask) {
-        charge = -1;
-      } else {
-        LOG(fatal) << "FemtoDreamDetaDphiStar: Charge bits are set wrong!";
+      if (radii == radiiTPC) {
+        return CachedPhiStar(part).phiAtSpecificRadii;
       }
+      phi0 = part.phi();
+      charge = ChargeFromCut(part);
       pt = part.pt();
     }
-    // End: Get the charge from cutcontainer using masks
-    float phiAtRadii = 0;
-    if (runOldVersion) {
-      phiAtRadii = phi0 - std::asin(0.3 * charge * 0.1 * magfield * radii * 0.01 / (2. * pt));
-    }
-    if (!runOldVersion) {
-      auto arg = 0.3 * charge * magfield * radii * 0.01 / (2. * pt);
-      // for very low pT particles, this value goes outside of range -1 to 1 at at large tpc radius; asin fails
-      if (abs(arg) < 1) {
-        phiAtRadii = phi0 - std::asin(0.3 * charge * magfield * radii * 0.01 / (2. * pt));
-      } else {
-        phiAtRadii = 999.;
-      }
-    }
-
-    return phiAtRadii;
+    return PhiAtRadius(phi0, pt, charge, radii);
   }
 
   template <typename T>
-  int PhiAtRadiiTPCForHF(const T& part, std::vector<float>& tmpVec, int prong)
+  int PhiAtRadiiTPCForHF(const T& part, std::array<float, 9>& tmpVec, int prong)
   {
     int charge = 0;
     float pt = -999.;
@@ -554,18 +569,7 @@ class FemtoDreamDetaDphiStar
         break;
     }
     for (size_t i = 0; i < 9; i++) {
-      if (runOldVersion) {
-        tmpVec.push_back(phi0 - std::asin(0.3 * charge * 0.1 * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt)));
-      }
-      if (!runOldVersion) {
-        auto arg = 0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt);
-        // for very low pT particles, this value goes outside of range -1 to 1 at at large tpc radius; asin fails
-        if (abs(arg) < 1) {
-          tmpVec.push_back(phi0 - std::asin(0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt)));
-        } else {
-          tmpVec.push_back(999);
-        }
-      }
+      tmpVec[i] = PhiAtRadius(phi0, pt, charge, tmpRadiiTPC[i]);
     }
     return charge;
   }
@@ -574,12 +578,14 @@ class FemtoDreamDetaDphiStar
   template <bool isHF = false, typename T1, typename T2>
   float AveragePhiStar(const T1& part1, const T2& part2, int iHist, bool* sameCharge)
   {
-    std::vector<float> tmpVec1;
-    std::vector<float> tmpVec2;
-    auto charge1 = PhiAtRadiiTPC(part1, tmpVec1);
+    // copied, the cache may be resized when looking up the second track
+    const auto cached1 = CachedPhiStar(part1);
+    const auto& tmpVec1 = cached1.phiAtRadii;
+    std::array<float, 9> tmpVec2;
     if constexpr (!isHF) {
-      auto charge2 = PhiAtRadiiTPC(part2, tmpVec2);
-      if (charge1 == charge2) {
+      const auto& cached2 = CachedPhiStar(part2);
+      tmpVec2 = cached2.phiAtRadii;
+      if (cached1.charge == cached2.charge) {
         *sameCharge = true;
       }
     } else {
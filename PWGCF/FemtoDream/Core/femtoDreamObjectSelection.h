@@ -172,6 +172,82 @@ class FemtoDreamObjectSelection
     return selValVec;
   }
 
+  /// Block of consecutive selections of the same variable and type, as added by setSelection
+  struct SelectionBlock {
+    size_t first;     ///< Index of the first selection of the block
+    size_t n;         ///< Number of selections of the block
+    bool isMonotonic; ///< Whether the selections go from the most open to the tightest, then the fulfilled ones are the first ones of the block
+  };
+
+  /// Obtain the blocks of the selections, rebuilt when selections have been added
+  /// \return std::vector with the blocks covering all the selections in order
+  const std::vector<SelectionBlock>& getSelectionBlocks()
+  {
+    if (mNSelectionsInBlocks != mSelections.size()) {
+      mSelectionBlocks.clear();
+      for (size_t i = 0; i < mSelections.size(); ++i) {
+        auto& sel = mSelections[i];
+        if (!mSelectionBlocks.empty()) {
+          auto& block = mSelectionBlocks.back();
+          auto& last = mSelections[block.first + block.n - 1];
+          if (sel.getSelectionVariable() == last.getSelectionVariable() && sel.getSelectionType() == last.getSelectionType()) {
+            switch (sel.getSelectionType()) {
+              case (femtoDreamSelection::SelectionType::kUpperLimit):
+              case (femtoDreamSelection::SelectionType::kAbsUpperLimit):
+                block.isMonotonic = block.isMonotonic && sel.getSelectionValue() <= last.getSelectionValue();
+                break;
+              case (femtoDreamSelection::SelectionType::kLowerLimit):
+              case (femtoDreamSelection::SelectionType::kAbsLowerLimit):
+                block.isMonotonic = block.isMonotonic && sel.getSelectionValue() >= last.getSelectionValue();
+                break;
+              case (femtoDreamSelection::SelectionType::kEqual):
+                break;
+            }
+            ++block.n;
+            continue;
+          }
+        }
+        mSelectionBlocks.push_back({i, 1, sel.getSelectionType() != femtoDreamSelection::SelectionType::kEqual});
+      }
+      mNSelectionsInBlocks = mSelections.size();
+    }
+    return mSelectionBlocks;
+  }
+
+  /// Check the selections of a block for one value of their variable and put together the bit-wise container for the systematic variations
+  /// For monotonic blocks the fulfilled selections are found with a single binary search
+  /// \tparam T Data type of the bit-wise container for the systematic variations
+  /// \param block Block of the selections
+  /// \param observable Value of the variable to be checked
+  /// \param cutContainer Bit-wise container for the systematic variations
+  /// \param counter Position in the bit-wise container of the first selection of the block, updated past the block
+  template <typename T>
+  void checkSelectionsSetBits(const SelectionBlock& block, selValDataType observable, T& cutContainer, size_t& counter, HistogramRegistry* registry)
+  {
+    auto begin = mSelections.begin() + block.first;
+    auto end = begin + block.n;
+    if (!block.isMonotonic) {
+      for (auto sel = begin; sel != end; ++sel) {
+        sel->checkSelectionSetBit(observable, cutContainer, counter, registry);
+      }
+      return;
+    }
+    const size_t nFulfilled = std::partition_point(begin, end, [observable](FemtoDreamSelection<selValDataType, selVariable>& sel) { return sel.isSelected(observable); }) - begin;
+    for (size_t i = 0; i < block.n; ++i) {
+      if (i < nFulfilled) {
+        cutContainer |= 1UL << counter;
+        if (registry) {
+          registry->fill(HIST("AnalysisQA/CutCounter"), 8 * sizeof(o2::aod::femtodreamparticle::cutContainerType));
+        }
+      } else {
+        if (registry) {
+          registry->fill(HIST("AnalysisQA/CutCounter"), counter);
+        }
+      }
+      ++counter;
+    }
+  }
+
   /// Retrieve all the different selection variables
   /// \return std::vector containing all the different selection variables
   std::vector<selVariable> getSelectionVariables()
@@ -190,6 +266,8 @@ class FemtoDreamObjectSelection
   HistogramRegistry* mHistogramRegistry;                                     ///< For Analysis QA output
   HistogramRegistry* mQAHistogramRegistry;                                   ///< For QA output
   std::vector<FemtoDreamSelection<selValDataType, selVariable>> mSelections; ///< Vector containing all selections
+  std::vector<SelectionBlock> mSelectionBlocks;                              ///< Blocks of consecutive selections of the same variable and type
+  size_t mNSelectionsInBlocks = 0;                                           ///< Number of selections covered by the blocks
 };
 
 } // namespace femtoDream
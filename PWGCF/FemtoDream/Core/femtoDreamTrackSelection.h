@@ -486,16 +486,20 @@ std::array<cutContainerType, 2> FemtoDreamTrackSelection::getCutContainer(T cons
   }
 
   float observable = 0.;
-  for (auto& sel : mSelections) {
-    const auto selVariable = sel.getSelectionVariable();
+  /// the selections of one variable are checked together, the observable is computed once per block
+  for (const auto& block : getSelectionBlocks()) {
+    const auto selVariable = mSelections[block.first].getSelectionVariable();
     if (selVariable == femtoDreamTrackSelection::kPIDnSigmaMax) {
       /// PID needs to be handled a bit differently since we may need more than one species
-      for (size_t i = 0; i < mPIDspecies.size(); ++i) {
-        auto pidTPCVal = pidTPC.at(i) - nSigmaPIDOffsetTPC;
-        auto pidTOFVal = pidTOF.at(i) - nSigmaPIDOffsetTOF;
-        auto pidComb = std::sqrt(pidTPCVal * pidTPCVal + pidTOFVal * pidTOFVal);
-        sel.checkSelectionSetBitPID(pidTPCVal, outputPID);
-        sel.checkSelectionSetBitPID(pidComb, outputPID);
+      for (size_t isel = block.first; isel < block.first + block.n; ++isel) {
+        auto& sel = mSelections[isel];
+        for (size_t i = 0; i < mPIDspecies.size(); ++i) {
+          auto pidTPCVal = pidTPC.at(i) - nSigmaPIDOffsetTPC;
+          auto pidTOFVal = pidTOF.at(i) - nSigmaPIDOffsetTOF;
+          auto pidComb = std::sqrt(pidTPCVal * pidTPCVal + pidTOFVal * pidTOFVal);
+          sel.checkSelectionSetBitPID(pidTPCVal, outputPID);
+          sel.checkSelectionSetBitPID(pidComb, outputPID);
+        }
       }
     } else {
       /// for the rest it's all the same
@@ -540,7 +544,7 @@ std::array<cutContainerType, 2> FemtoDreamTrackSelection::getCutContainer(T cons
         case (femtoDreamTrackSelection::kPIDnSigmaMax):
           break;
       }
-      sel.checkSelectionSetBit(observable, output, counter, mHistogramRegistry);
+      checkSelectionsSetBits(block, observable, output, counter, mHistogramRegistry);
     }
   }
   return {output, outputPID};
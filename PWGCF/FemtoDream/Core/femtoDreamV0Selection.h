@@ -589,12 +589,15 @@ std::array<cutContainerType, 5>
   const std::vector<float> decVtx = {v0.x(), v0.y(), v0.z()};
 
   float observable = 0.;
-  for (auto& sel : mSelections) {
-    const auto selVariable = sel.getSelectionVariable();
+  /// the selections of one variable are checked together, the observable is computed once per block
+  for (const auto& block : getSelectionBlocks()) {
+    const auto selVariable = mSelections[block.first].getSelectionVariable();
     if (selVariable == femtoDreamV0Selection::kV0DecVtxMax) {
-      for (size_t i = 0; i < decVtx.size(); ++i) {
-        auto decVtxValue = decVtx.at(i);
-        sel.checkSelectionSetBit(decVtxValue, output, counter, nullptr);
+      for (size_t isel = block.first; isel < block.first + block.n; ++isel) {
+        for (size_t i = 0; i < decVtx.size(); ++i) {
+          auto decVtxValue = decVtx.at(i);
+          mSelections[isel].checkSelectionSetBit(decVtxValue, output, counter, nullptr);
+        }
       }
     } else {
       switch (selVariable) {
@@ -625,7 +628,7 @@ std::array<cutContainerType, 5>
         case (femtoDreamV0Selection::kV0DecVtxMax):
           break;
       }
-      sel.checkSelectionSetBit(observable, output, counter, nullptr);
+      checkSelectionsSetBits(block, observable, output, counter, nullptr);
     }
   }
   return {
@@ -45,6 +45,7 @@ void BootstrapProfile::InitializeSubsamples(Int_t nSub)
     delete fListOfEntries;
   fListOfEntries = new TList();
   fListOfEntries->SetOwner(kTRUE);
+  fSubProfiles.clear();
   TProfile* dummyPF = reinterpret_cast<TProfile*>(this);
   for (Int_t i = 0; i < nSub; i++) {
     fListOfEntries->Add(reinterpret_cast<TProfile*>(dummyPF->Clone(Form("%s_Subpf%i", dummyPF->GetName(), i))));
@@ -52,19 +53,58 @@ void BootstrapProfile::InitializeSubsamples(Int_t nSub)
   }
   fNSubs = nSub;
 }
+namespace
+{
+// Same bookkeeping as TProfile::Fill(x, y, w), for a bin already known: the bin sums are updated directly,
+// so that the subsample does not repeat the axis look-up of the main profile
+void AddToProfile(TProfile* pf, Int_t bin, Double_t x, Double_t y, Double_t w)
+{
+  // Statistics first, GetStats recomputes them from the bin contents if they are not filled yet.
+  // Under/overflows are not included in the statistics, as in TProfile::Fill
+  if (bin > 0 && bin <= pf->GetNbinsX()) {
+    Double_t stats[TH1::kNstat];
+    pf->GetStats(stats);
+    stats[0] += w;
+    stats[1] += w * w;
+    stats[2] += w * x;
+    stats[3] += w * x * x;
+    stats[4] += w * y;
+    stats[5] += w * y * y;
+    pf->PutStats(stats);
+  }
+  pf->GetArray()[bin] += w * y;
+  pf->GetSumw2()->GetArray()[bin] += w * y * y;
+  if (!pf->GetBinSumw2()->fN && w != 1.0 && !pf->TestBit(TH1::kIsNotW))
+    pf->Sumw2();
+  if (pf->GetBinSumw2()->fN)
+    pf->GetBinSumw2()->GetArray()[bin] += w * w;
+  pf->SetBinEntries(bin, pf->GetBinEntries(bin) + w);
+  pf->SetEntries(pf->GetEntries() + 1);
+}
+} // namespace
+TProfile* BootstrapProfile::GetSubProfileForFill(Int_t ind)
+{
+  if (static_cast<Int_t>(fSubProfiles.size()) != fListOfEntries->GetEntries()) {
+    fSubProfiles.clear();
+    for (TObject* obj : *fListOfEntries)
+      fSubProfiles.push_back(reinterpret_cast<TProfile*>(obj));
+  }
+  return fSubProfiles[ind];
+}
 void BootstrapProfile::FillProfile(const Double_t& xv, const Double_t& yv, const Double_t& w, const Double_t& rn)
 {
-  TProfile::Fill(xv, yv, w);
+  const Int_t bin = fXaxis.FindFixBin(xv);
+  AddToProfile(this, bin, xv, yv, w);
   if (!fNSubs)
     return;
   Int_t targetInd = rn * fNSubs;
   if (targetInd >= fNSubs)
     targetInd = 0;
-  reinterpret_cast<TProfile*>(fListOfEntries->At(targetInd))->Fill(xv, yv, w);
+  AddToProfile(GetSubProfileForFill(targetInd), bin, xv, yv, w);
 }
 void BootstrapProfile::FillProfile(const Double_t& xv, const Double_t& yv, const Double_t& w)
 {
-  TProfile::Fill(xv, yv, w);
+  AddToProfile(this, fXaxis.FindFixBin(xv), xv, yv, w);
 }
 void BootstrapProfile::RebinMulti(Int_t nbins)
 {
@@ -122,6 +162,7 @@ Long64_t BootstrapProfile::Merge(TCollection* collist)
     if (!tarL)
       continue;
     if (!fListOfEntries) {
+      fSubProfiles.clear();
       fListOfEntries = reinterpret_cast<TList*>(tarL->Clone());
       for (Int_t i = 0; i < fListOfEntries->GetEntries(); i++)
         reinterpret_cast<TProfile*>(fListOfEntries->At(i))->Reset();
@@ -199,6 +240,7 @@ void BootstrapProfile::MergeBS(BootstrapProfile* target)
   if (!fListOfEntries) {
     if (!target->fListOfEntries)
       return;
+    fSubProfiles.clear();
     fListOfEntries = reinterpret_cast<TList*>(tarL->Clone());
     for (Int_t i = 0; i < fListOfEntries->GetEntries(); i++)
       reinterpret_cast<TProfile*>(fListOfEntries->At(i))->Reset();
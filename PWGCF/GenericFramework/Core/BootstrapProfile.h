@@ -12,6 +12,8 @@
 #ifndef PWGCF_GENERICFRAMEWORK_CORE_BOOTSTRAPPROFILE_H_
 #define PWGCF_GENERICFRAMEWORK_CORE_BOOTSTRAPPROFILE_H_
 
+#include <vector>
+
 #include "TProfile.h"
 #include "TList.h"
 #include "TString.h"
@@ -52,9 +54,11 @@ class BootstrapProfile : public TProfile
   TH1* getWeightBasedRebin(Int_t ind = -1);
   Bool_t fProfInitialized;
   Int_t fNSubs;
-  Int_t fMultiRebin;                //! externaly set runtime, no need to store
-  Double_t* fMultiRebinEdges;       //! externaly set runtime, no need to store
-  BootstrapProfile* fPresetWeights; //! BootstrapProfile whose weights we should copy
+  Int_t fMultiRebin;                   //! externaly set runtime, no need to store
+  Double_t* fMultiRebinEdges;          //! externaly set runtime, no need to store
+  BootstrapProfile* fPresetWeights;    //! BootstrapProfile whose weights we should copy
+  std::vector<TProfile*> fSubProfiles; //! subprofiles of fListOfEntries, for a direct access when filling
+  TProfile* GetSubProfileForFill(Int_t ind);
   void ResetBin(TProfile* tpf, Int_t nbin)
   {
     tpf->SetBinEntries(nbin, 0);
@@ -133,7 +133,7 @@ void FlowContainer::SetXAxis()
     delete tempax;
   }
 }
-int FlowContainer::FillProfile(const char* hname, double multi, double corr, double w, double rn)
+int FlowContainer::GetProfileBin(const char* hname)
 {
   if (!fProf)
     return -1;
@@ -142,10 +142,60 @@ int FlowContainer::FillProfile(const char* hname, double multi, double corr, dou
     printf("Could not find bin %s\n", hname);
     return -1;
   }
-  fProf->Fill(multi, yin, corr, w);
+  return yin;
+};
+int FlowContainer::FillProfile(const char* hname, double multi, double corr, double w, double rn)
+{
+  int yin = GetProfileBin(hname);
+  if (yin < 0)
+    return -1;
+  return FillProfile(yin, multi, corr, w, rn);
+};
+namespace
+{
+// Same bookkeeping as TProfile2D::Fill(x, y, z, w), for bins already known: the bin sums are updated directly,
+// so that the subsample does not repeat the axis look-ups of the main profile
+void AddToProfile(TProfile2D* pf, int binx, int biny, double x, double y, double z, double w)
+{
+  const int bin = pf->GetBin(binx, biny);
+  // Statistics first, GetStats recomputes them from the bin contents if they are not filled yet.
+  // Under/overflows are not included in the statistics, as in TProfile2D::Fill
+  if (binx > 0 && binx <= pf->GetNbinsX() && biny > 0 && biny <= pf->GetNbinsY()) {
+    double stats[TH1::kNstat];
+    pf->GetStats(stats);
+    stats[0] += w;
+    stats[1] += w * w;
+    stats[2] += w * x;
+    stats[3] += w * x * x;
+    stats[4] += w * y;
+    stats[5] += w * y * y;
+    stats[6] += w * x * y;
+    stats[7] += w * z;
+    stats[8] += w * z * z;
+    pf->PutStats(stats);
+  }
+  pf->GetArray()[bin] += w * z;
+  pf->GetSumw2()->GetArray()[bin] += w * z * z;
+  if (!pf->GetBinSumw2()->fN && w != 1.0 && !pf->TestBit(TH1::kIsNotW))
+    pf->Sumw2();
+  if (pf->GetBinSumw2()->fN)
+    pf->GetBinSumw2()->GetArray()[bin] += w * w;
+  pf->SetBinEntries(bin, pf->GetBinEntries(bin) + w);
+  pf->SetEntries(pf->GetEntries() + 1);
+}
+} // namespace
+int FlowContainer::FillProfile(int yin, double multi, double corr, double w, double rn)
+{
+  if (!fProf || yin < 1 || yin > fProf->GetNbinsY())
+    return -1;
+  const int xin = fProf->GetXaxis()->FindFixBin(multi);
+  const double ycenter = fProf->GetYaxis()->GetBinCenter(yin);
+  AddToProfile(fProf, xin, yin, multi, ycenter, corr, w);
   if (fNRandom) {
-    double rnind = rn * fNRandom;
-    dynamic_cast<TProfile2D*>(fProfRand->At(static_cast<int>(rnind)))->Fill(multi, yin, corr, w);
+    int rnind = static_cast<int>(rn * fNRandom);
+    if (rnind >= fNRandom)
+      rnind = 0;
+    AddToProfile(static_cast<TProfile2D*>(fProfRand->UncheckedAt(rnind)), xin, yin, multi, ycenter, corr, w);
   }
   return 0;
 };
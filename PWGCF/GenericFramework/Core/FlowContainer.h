@@ -50,7 +50,9 @@ class FlowContainer : public TNamed
   };
   int GetNMultiBins() { return fProf->GetNbinsX(); }
   double GetMultiAtBin(int bin) { return fProf->GetXaxis()->GetBinCenter(bin); }
+  int GetProfileBin(const char* hname); // y bin of a correlator, to be cached and used with the FillProfile(int, ...) below
   int FillProfile(const char* hname, double multi, double y, double w, double rn);
+  int FillProfile(int yin, double multi, double y, double w, double rn);
   TProfile2D* GetProfile() { return fProf; }
   void OverrideProfileErrors(TProfile2D* inpf);
   void ReadAndMerge(const char* infile);
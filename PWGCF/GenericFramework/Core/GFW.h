@@ -26,6 +26,8 @@ If used, modified, or distributed, please aknowledge the author of this code.
 #include <utility>
 #include <algorithm>
 #include <complex>
+#include <cstddef>
+#include <unordered_map>
 
 class GFW
 {
@@ -71,6 +73,21 @@ class GFW
  protected:
   bool fInitialized;
   std::vector<CorrConfig> fListOfCFGs;
+  // Correlators of three or more particles already calculated in the current event, shared by all the configurations and pt bins.
+  // Key: POI, reference and overlap regions, pt bin, harmonics and powers
+  struct CorrKeyHash {
+    std::size_t operator()(const std::vector<int>& key) const
+    {
+      std::size_t h = key.size();
+      for (int k : key)
+        h ^= std::hash<int>{}(k) + 0x9e3779b9 + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+  std::unordered_map<std::vector<int>, std::complex<double>, CorrKeyHash> fCorrCache; //!
+  std::vector<int> fCorrKey;                                                          //! buffer for the key of the current correlator
+  bool fCorrCacheValid = false;                                                       //! false after a Fill, the cache is then cleared before the next use
+  int RegionIndex(const GFWCumulant* q) const { return q ? static_cast<int>(q - fCumulants.data()) : -1; }
   std::complex<double> TwoRec(int n1, int n2, int p1, int p2, int ptbin, GFWCumulant*, GFWCumulant*, GFWCumulant*);
   std::complex<double> RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, std::vector<int>& hars, std::vector<int>& pows); // POI, Ref. flow, overlapping region
   std::complex<double> RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, std::vector<int>& hars);                         // POI, Ref. flow, overlapping region
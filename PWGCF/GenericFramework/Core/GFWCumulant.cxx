@@ -19,19 +19,47 @@ If used, modified, or distributed, please aknowledge the author of this code.
 
 #include "GFWCumulant.h"
 
+#include <algorithm>
+
 using std::complex;
 using std::vector;
 
-GFWCumulant::GFWCumulant() : fQvector(0),
+GFWCumulant::GFWCumulant() : fQvector(),
+                             fPowOffsets(),
+                             fStride(0),
                              fUsed(kBlank),
                              fNEntries(-1),
                              fN(1),
                              fPow(1),
                              fPt(1),
-                             fFilledPts(0),
+                             fFilledPts(),
                              fInitialized(false) {}
 
 GFWCumulant::~GFWCumulant() {}
+void GFWCumulant::FillHarmonics(int ptin, double lCos, double lSin, double weight, double SecondWeight)
+{
+  // Powers of the weight are built incrementally; multiplication is cheaper than power
+  // Also, if second weight is specified, then keep the first weight with power no more than 1, and us the other weight otherwise
+  // this is important when POIs are a subset of REFs and have different weights than REFs
+  double* lWeightPows = fWeightPows.data();
+  const int lPowMax = static_cast<int>(fWeightPows.size());
+  if (lPowMax > 1)
+    lWeightPows[1] = weight;
+  const double lPowFactor = SecondWeight > 0 ? SecondWeight : weight;
+  for (int lPow = 2; lPow < lPowMax; lPow++)
+    lWeightPows[lPow] = lWeightPows[lPow - 1] * lPowFactor;
+  // e^{i n phi} from e^{i (n-1) phi} * e^{i phi}, instead of sin and cos for every harmonic
+  complex<double>* lQ = fQvector.data() + QIndex(ptin, 0, 0);
+  const complex<double> lStep(lCos, lSin);
+  complex<double> lHar(1., 0.);
+  for (int lN = 0; lN < fN; lN++) {
+    complex<double>* lQn = lQ + fPowOffsets[lN];
+    const int lNPow = PW(lN);
+    for (int lPow = 0; lPow < lNPow; lPow++)
+      lQn[lPow] += lWeightPows[lPow] * lHar;
+    lHar *= lStep;
+  }
+}
 void GFWCumulant::FillArray(int ptin, double phi, double weight, double SecondWeight)
 {
   if (!fInitialized)
@@ -41,53 +69,47 @@ void GFWCumulant::FillArray(int ptin, double phi, double weight, double SecondWe
   else if (ptin < 0 || ptin >= fPt)
     return;
   fFilledPts[ptin] = true;
-  for (int lN = 0; lN < fN; lN++) {
-    double lSin = sin(lN * phi); // No need to recalculate for each power
-    double lCos = cos(lN * phi); // No need to recalculate for each power
-    for (int lPow = 0; lPow < PW(lN); lPow++) {
-      double lPrefactor = 0;
-      // Dont calculate it twice; multiplication is cheaper that power
-      // Also, if second weight is specified, then keep the first weight with power no more than 1, and us the other weight otherwise
-      // this is important when POIs are a subset of REFs and have different weights than REFs
-      if (SecondWeight > 0 && lPow > 1)
-        lPrefactor = pow(SecondWeight, lPow - 1) * weight;
-      else
-        lPrefactor = pow(weight, lPow);
-      double qsin = lPrefactor * lSin;
-      double qcos = lPrefactor * lCos;
-      fQvector[ptin][lN][lPow] += complex<double>(qcos, qsin);
-    }
-  }
+  FillHarmonics(ptin, cos(phi), sin(phi), weight, SecondWeight);
   Inc();
 };
+void GFWCumulant::FillArray(int nParticles, const int* ptin, const double* phi, const double* weight, const double* SecondWeight)
+{
+  if (!fInitialized)
+    CreateComplexVectorArray(1, 1, 1);
+  // sin and cos of all the particles first, this loop has no dependencies and can be vectorised
+  fCosBuffer.resize(nParticles);
+  fSinBuffer.resize(nParticles);
+  for (int i = 0; i < nParticles; i++) {
+    fCosBuffer[i] = cos(phi[i]);
+    fSinBuffer[i] = sin(phi[i]);
+  }
+  for (int i = 0; i < nParticles; i++) {
+    int lPt = 0;
+    if (fPt > 1) {
+      lPt = ptin[i];
+      if (lPt < 0 || lPt >= fPt)
+        continue;
+    }
+    fFilledPts[lPt] = true;
+    FillHarmonics(lPt, fCosBuffer[i], fSinBuffer[i], weight[i], SecondWeight ? SecondWeight[i] : -1);
+    Inc();
+  }
+}
 void GFWCumulant::ResetQs()
 {
   if (!fNEntries)
     return; // If 0 entries, then no need to reset. Otherwise, if -1, then just initialized and need to set to 0.
-  for (int i = 0; i < fPt; i++) {
-    fFilledPts[i] = false;
-    for (int lN = 0; lN < fN; lN++) {
-      for (int lPow = 0; lPow < PW(lN); lPow++) {
-        fQvector[i][lN][lPow] = fNullQ;
-      }
-    }
-  }
+  std::fill(fFilledPts.begin(), fFilledPts.end(), false);
+  std::fill(fQvector.begin(), fQvector.end(), fNullQ);
   fNEntries = 0;
 };
 void GFWCumulant::DestroyComplexVectorArray()
 {
   if (!fInitialized)
     return;
-  for (int l_n = 0; l_n < fN; l_n++) {
-    for (int i = 0; i < fPt; i++) {
-      delete[] fQvector[i][l_n];
-    }
-  }
-  for (int i = 0; i < fPt; i++) {
-    delete[] fQvector[i];
-  }
-  delete[] fQvector;
-  delete[] fFilledPts;
+  fQvector.clear();
+  fQvector.shrink_to_fit();
+  fFilledPts.clear();
   fInitialized = false;
   fNEntries = -1;
 };
@@ -106,18 +128,19 @@ void GFWCumulant::CreateComplexVectorArrayVarPower(int N, vector<int> PowVec, in
   fN = N;
   fPow = 0;
   fPt = Pt;
-  fFilledPts = new bool[Pt];
   fPowVec = PowVec;
-  fQvector = new complex<double>**[fPt];
-  for (int i = 0; i < fPt; i++) {
-    fQvector[i] = new complex<double>*[fN];
-  }
+  fPowOffsets.resize(fN);
+  fStride = 0;
+  int lPowMax = 0;
   for (int l_n = 0; l_n < fN; l_n++) {
-    for (int i = 0; i < fPt; i++) {
-      fQvector[i][l_n] = new complex<double>[PW(l_n)];
-    }
+    fPowOffsets[l_n] = fStride;
+    fStride += PW(l_n);
+    lPowMax = std::max(lPowMax, PW(l_n));
   }
-  ResetQs();
+  fWeightPows.assign(std::max(lPowMax, 1), 1.);
+  fFilledPts.assign(fPt, false);
+  fQvector.assign(fPt * fStride, fNullQ);
+  fNEntries = 0;
   fInitialized = true;
 };
 complex<double> GFWCumulant::Vec(int n, int p, int ptbin)
@@ -127,12 +150,12 @@ complex<double> GFWCumulant::Vec(int n, int p, int ptbin)
   if (ptbin >= fPt || ptbin < 0)
     ptbin = 0;
   if (n >= 0)
-    return fQvector[ptbin][n][p];
-  return conj(fQvector[ptbin][-n][p]);
+    return fQvector[QIndex(ptbin, n, p)];
+  return conj(fQvector[QIndex(ptbin, -n, p)]);
 };
 bool GFWCumulant::IsPtBinFilled(int ptb)
 {
-  if (!fFilledPts)
+  if (fFilledPts.empty())
     return false;
   if (ptb > 0) {
     if (fPt == 1)
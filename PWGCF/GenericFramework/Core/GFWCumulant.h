@@ -30,6 +30,7 @@ class GFWCumulant
   ~GFWCumulant();
   void ResetQs();
   void FillArray(int ptin, double phi, double weight = 1, double SecondWeight = -1);
+  void FillArray(int nParticles, const int* ptin, const double* phi, const double* weight, const double* SecondWeight = nullptr); // Fills nParticles at once
   enum UsedFlags_t { kBlank = 0,
                      kFull = 1,
                      kPt = 2 };
@@ -47,7 +48,14 @@ class GFWCumulant
   void DestroyComplexVectorArray();
   std::complex<double> Vec(int, int, int ptbin = 0); // envelope class to summarize pt-dif. Q-vec getter
  protected:
-  std::complex<double>*** fQvector;
+  void FillHarmonics(int ptin, double lCos, double lSin, double weight, double SecondWeight);
+  int QIndex(int ptin, int n, int p) const { return ptin * fStride + fPowOffsets[n] + p; }
+  std::vector<std::complex<double>> fQvector; //! Q-vectors, contiguous in [pt][harmonic][power]
+  std::vector<int> fPowOffsets;               //! Position of the first power of each harmonic within a pt bin
+  int fStride;                                //! Number of Q-vectors per pt bin
+  std::vector<double> fWeightPows;            //! Powers of the weight of the current particle
+  std::vector<double> fCosBuffer;             //! cos(phi) of the particles of a batch
+  std::vector<double> fSinBuffer;             //! sin(phi) of the particles of a batch
   uint fUsed;
   int fNEntries;
   // Q-vectors. Could be done recursively, but maybe defining each one of them explicitly is easier to read
@@ -55,7 +63,7 @@ class GFWCumulant
   int fPow;                 //! Power
   std::vector<int> fPowVec; //! Powers array
   int fPt;                  //! fPt bins
-  bool* fFilledPts;
+  std::vector<bool> fFilledPts;
   bool fInitialized; // Arrays are initialized
   std::complex<double> fNullQ = 0;
 };
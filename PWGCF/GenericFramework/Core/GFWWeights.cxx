@@ -141,29 +141,43 @@ double GFWWeights::GetWeight(double phi, double eta, double vz, double pt, doubl
     return 1. / weight;
   return 1;
 };
-double GFWWeights::GetNUA(double phi, double eta, double vz)
+void GFWWeights::BuildNUAGrid()
 {
   if (!fAccInt)
     CreateNUA();
-  int xind = fAccInt->GetXaxis()->FindBin(phi);
-  int etaind = fAccInt->GetYaxis()->FindBin(eta);
-  int vzind = fAccInt->GetZaxis()->FindBin(vz);
-  double weight = fAccInt->GetBinContent(xind, etaind, vzind);
-  if (weight != 0)
-    return 1. / weight;
-  return 1;
+  fNUAGrid.build(fAccInt, true);
 }
-double GFWWeights::GetNUE(double pt, double eta, double vz)
+void GFWWeights::BuildNUEGrid()
 {
   if (!fEffInt)
     CreateNUE();
-  int xind = fEffInt->GetXaxis()->FindBin(pt);
-  int etaind = fEffInt->GetYaxis()->FindBin(eta);
-  int vzind = fEffInt->GetZaxis()->FindBin(vz);
-  double weight = fEffInt->GetBinContent(xind, etaind, vzind);
-  if (weight != 0)
-    return 1. / weight;
-  return 1;
+  fNUEGrid.build(fEffInt, true);
+}
+double GFWWeights::GetNUA(double phi, double eta, double vz)
+{
+  if (!fNUAGrid.isBuilt())
+    BuildNUAGrid();
+  return fNUAGrid.get(phi, eta, vz);
+}
+double GFWWeights::GetNUE(double pt, double eta, double vz)
+{
+  if (!fNUEGrid.isBuilt())
+    BuildNUEGrid();
+  return fNUEGrid.get(pt, eta, vz);
+}
+void GFWWeights::GetNUA(int n, const double* phi, const double* eta, const double* vz, double* weights)
+{
+  if (!fNUAGrid.isBuilt())
+    BuildNUAGrid();
+  for (int i = 0; i < n; i++)
+    weights[i] = fNUAGrid.get(phi[i], eta[i], vz[i]);
+}
+void GFWWeights::GetNUE(int n, const double* pt, const double* eta, const double* vz, double* weights)
+{
+  if (!fNUEGrid.isBuilt())
+    BuildNUEGrid();
+  for (int i = 0; i < n; i++)
+    weights[i] = fNUEGrid.get(pt[i], eta[i], vz[i]);
 }
 double GFWWeights::FindMax(TH3D* inh, int& ix, int& iy, int& iz)
 {
@@ -216,6 +230,7 @@ void GFWWeights::CreateNUA(bool IntegrateOverCentAndPt)
   if (IntegrateOverCentAndPt) {
     if (fAccInt)
       delete fAccInt;
+    fNUAGrid.clear();
     fAccInt = reinterpret_cast<TH3D*>(fW_data->At(0)->Clone("IntegratedAcceptance"));
     fAccInt->Sumw2();
     for (int etai = 1; etai <= fAccInt->GetNbinsY(); etai++) {
@@ -276,6 +291,9 @@ void GFWWeights::CreateNUE(bool IntegrateOverCentrality)
     den->RebinY(2);
     num->RebinZ(5);
     den->RebinZ(5);
+    if (fEffInt)
+      delete fEffInt;
+    fNUEGrid.clear();
     fEffInt = reinterpret_cast<TH3D*>(num->Clone("Efficiency_Integrated"));
     fEffInt->Divide(den);
     return;
@@ -362,6 +380,8 @@ void GFWWeights::OverwriteNUA()
   delete trash;
   fW_data->Add(reinterpret_cast<TH3D*>(fAccInt->Clone(ts.Data())));
   delete fAccInt;
+  fAccInt = 0;
+  fNUAGrid.clear();
 }
 Long64_t GFWWeights::Merge(TCollection* collist)
 {
@@ -19,6 +19,8 @@
 #include "TFile.h"
 #include "TCollection.h"
 #include "TString.h"
+#include <vector>
+#include "PWGCF/Core/FlatWeightGrid.h"
 
 class GFWWeights : public TNamed
 {
@@ -31,6 +33,8 @@ class GFWWeights : public TNamed
   double GetWeight(double phi, double eta, double vz, double pt, double cent, int htype);             // htype: 0 for data, 1 for mc rec, 2 for mc gen
   double GetNUA(double phi, double eta, double vz);                                                   // This just fetches correction from integrated NUA, should speed up
   double GetNUE(double pt, double eta, double vz);                                                    // fetches weight from fEffInt
+  void GetNUA(int n, const double* phi, const double* eta, const double* vz, double* weights);        // NUA weights of n particles at once
+  void GetNUE(int n, const double* pt, const double* eta, const double* vz, double* weights);         // NUE weights of n particles at once
   bool IsDataFilled() { return fDataFilled; }
   bool IsMCFilled() { return fMCFilled; }
   double FindMax(TH3D* inh, int& ix, int& iy, int& iz);
@@ -64,6 +68,10 @@ class GFWWeights : public TNamed
   TH3D* fAccInt;   //!
   int fNbinsPt;    //! do not store
   double* fbinsPt; //! do not store
+  FlatWeightGrid<double> fNUAGrid; //! lookup grid of the inverse of fAccInt
+  FlatWeightGrid<double> fNUEGrid; //! lookup grid of the inverse of fEffInt
+  void BuildNUAGrid();
+  void BuildNUEGrid();
   void AddArray(TObjArray* targ, TObjArray* sour);
   const char* GetBinName(double /*ptv*/, double /*v0mv*/, const char* pf = "")
   {
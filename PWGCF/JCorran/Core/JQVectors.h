@@ -58,27 +58,38 @@ class JQVectors : public std::conditional_t<gap, JQVectorsGapBase<Q, nh, nk>, JQ
         }
       }
     }
+    using JInputClassIter = typename JInputClass::iterator;
     for (auto& track : inputInst) {
       if (track.eta() < -etamax || track.eta() > etamax)
         continue;
 
       UInt_t isub = (UInt_t)(track.eta() > 0.0);
+      const bool inGap = TMath::Abs(track.eta()) > etamin;
+      const auto phi = track.phi();
+      // the weights are read once per track, the powers are still obtained dividing by them in turn
+      Double_t weightNUA = 1.0, weightEff = 1.0;
+      if constexpr (std::experimental::is_detected<hasWeightNUA, const JInputClassIter>::value)
+        weightNUA = track.weightNUA();
+      if constexpr (std::experimental::is_detected<hasWeightEff, const JInputClassIter>::value)
+        weightEff = track.weightEff();
       for (UInt_t ih = 0; ih < nh; ++ih) {
+        // the harmonic does not depend on the power
+        const Double_t cosPhi = TMath::Cos(ih * phi);
+        const Double_t sinPhi = TMath::Sin(ih * phi);
         Double_t tf = 1.0;
         for (UInt_t ik = 0; ik < nk; ++ik) {
-          Q q(tf * TMath::Cos(ih * track.phi()), tf * TMath::Sin(ih * track.phi()));
+          Q q(tf * cosPhi, tf * sinPhi);
           QvectorQC[ih][ik] += q;
 
           if constexpr (gap) {
-            if (TMath::Abs(track.eta()) > etamin)
+            if (inGap)
               this->QvectorQCgap[isub][ih][ik] += q;
           }
 
-          using JInputClassIter = typename JInputClass::iterator;
           if constexpr (std::experimental::is_detected<hasWeightNUA, const JInputClassIter>::value)
-            tf /= track.weightNUA();
+            tf /= weightNUA;
           if constexpr (std::experimental::is_detected<hasWeightEff, const JInputClassIter>::value)
-            tf /= track.weightEff();
+            tf /= weightEff;
         }
       }
     }
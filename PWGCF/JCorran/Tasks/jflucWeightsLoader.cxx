@@ -30,6 +30,7 @@
 
 #include "PWGCF/JCorran/DataModel/JCatalyst.h"
 #include "PWGCF/DataModel/CorrelationsDerived.h"
+#include "PWGCF/Core/FlatWeightGrid.h"
 #include "Framework/runDataProcessing.h"
 
 using namespace o2;
@@ -44,6 +45,7 @@ struct jflucWeightsLoader {
   O2_DEFINE_CONFIGURABLE(pathPhiWeights, std::string, "", "Local (local://) or CCDB path for the phi acceptance correction histogram");
 
   THnF* ph = 0;
+  FlatWeightGrid<float> phiWeightGrid; // contents of ph, looked up per track
   TFile* pf = 0;
   int runNumber = 0;
 
@@ -84,10 +86,13 @@ struct jflucWeightsLoader {
     if (collision.runNumber() != runNumber) {
       if (ph)
         delete ph;
-      if (!(ph = static_cast<THnF*>(pf->Get(Form("NUAWeights_%d", collision.runNumber())))))
+      if (!(ph = static_cast<THnF*>(pf->Get(Form("NUAWeights_%d", collision.runNumber()))))) {
         LOGF(warning, "NUA correction histogram not found for run %d.", collision.runNumber());
-      else
+        phiWeightGrid.clear();
+      } else {
         LOGF(info, "Loaded NUA correction histogram for run %d.", collision.runNumber());
+        phiWeightGrid.build(ph);
+      }
       runNumber = collision.runNumber();
     }
     for (auto& track : tracks) {
@@ -105,7 +110,7 @@ struct jflucWeightsLoader {
           }
         }
         const Double_t coords[] = {collision.multiplicity(), static_cast<Double_t>(partType), track.phi(), track.eta(), collision.posZ()};
-        phiWeight = ph->GetBinContent(ph->GetBin(coords));
+        phiWeight = phiWeightGrid.get(coords);
       } else {
         phiWeight = 1.0f;
       }
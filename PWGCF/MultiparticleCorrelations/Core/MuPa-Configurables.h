@@ -155,6 +155,7 @@ struct : ConfigurableGroup {
   Configurable<bool> cfCalculateCustomNestedLoops{"cfCalculateCustomNestedLoops", false, "cross-check e-b-e all correlations with custom nested loops"};
   Configurable<bool> cfCalculateKineCustomNestedLoops{"cfCalculateKineCustomNestedLoops", false, "cross-check e-b-e all differential (vs. pt, eta, etc.) correlations with custom nested loops"};
   Configurable<int> cfMaxNestedLoop{"cfMaxNestedLoop", -1, "if set to e.g. 4, all nested loops beyond that, e.g. 6-p and 8-p, are NOT calculated"};
+  Configurable<float> cfFractionOfEventsForNestedLoops{"cfFractionOfEventsForNestedLoops", 1., "fraction of randomly selected events for which all nested loops are calculated (1. = all events)"};
 } cf_nl;
 
 // *) Toy NUA:
@@ -156,7 +156,8 @@ struct Qvector {
   TList* fQvectorList = NULL;                                                                                                          // list to hold all Q-vector objects
   TProfile* fQvectorFlagsPro = NULL;                                                                                                   // profile to hold all flags for Q-vector
   Bool_t fCalculateQvectors = kTRUE;                                                                                                   // to calculate or not to calculate Q-vectors, that's a Boolean...
-  TComplex fQ[gMaxHarmonic * gMaxCorrelator + 1][gMaxCorrelator + 1] = {{TComplex(0., 0.)}};                                           //! generic Q-vector
+  std::complex<double> fQ[gMaxHarmonic * gMaxCorrelator + 1][gMaxCorrelator + 1] = {{std::complex<double>(0., 0.)}};                   //! generic Q-vector
+  std::unordered_map<std::string, std::complex<double>> fRecursionCache;                                                               //! terms of Recursion(...) for the current generic Q-vector
   TComplex fQvector[gMaxHarmonic * gMaxCorrelator + 1][gMaxCorrelator + 1] = {{TComplex(0., 0.)}};                                     //! "integrated" Q-vector
   TComplex fqvector[eqvectorKine_N][gMaxNoBinsKine][gMaxHarmonic * gMaxCorrelator + 1][gMaxCorrelator + 1] = {{{{TComplex(0., 0.)}}}}; //! "differenttial" q-vector [kine var.][binNo][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*12+1][12+1]
   Int_t fqVectorEntries[eqvectorKine_N][gMaxNoBinsKine] = {{0}};                                                                       // count number of entries in each differential q-vector
@@ -192,6 +193,8 @@ struct NestedLoops {
   Bool_t fCalculateCustomNestedLoops = kFALSE;                                 // validate e-b-e all correlations with custom nested loop
   Bool_t fCalculateKineCustomNestedLoops = kFALSE;                             // validate e-b-e all differential (vs pt, eta, etc.) correlations with custom nested loop
   Int_t fMaxNestedLoop = -1;                                                   // if set to e.g. 4, all nested loops beyond that, e.g. 6-p and 8-p, are NOT calculated
+  Float_t fFractionOfEventsForNestedLoops = 1.;                               // fraction of randomly selected events for which all nested loops are calculated
+  Bool_t fNestedLoopsInThisEvent = kTRUE;                                      // whether nested loops are calculated for the current event
   TProfile* fNestedLoopsPro[4][gMaxHarmonic][eAsFunctionOf_N] = {{{NULL}}};    //! multiparticle correlations from nested loops
                                                                                //! [2p=0,4p=1,6p=2,8p=3][n=1,n=2,...,n=gMaxHarmonic][0=integrated,1=vs.
                                                                                //! multiplicity,2=vs. centrality,3=pT,4=eta]
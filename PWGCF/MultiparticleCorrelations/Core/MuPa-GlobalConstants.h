@@ -17,5 +17,6 @@ const Int_t gMaxHarmonic = 9;
 const Int_t gMaxIndex = 300;           // per order, used only in Test0
 const Int_t gMaxNoBinsKine = 1000;     // max number of bins for differential q-vector
 const Int_t fMaxBinsDiffWeights = 100; // max number of bins for differential weights, see MakeWeights.C
+const Int_t gMinMemoisedRecursion = 5; // terms of Recursion(...) with fewer harmonics are not cached
 
 #endif // PWGCF_MULTIPARTICLECORRELATIONS_CORE_MUPA_GLOBALCONSTANTS_H_
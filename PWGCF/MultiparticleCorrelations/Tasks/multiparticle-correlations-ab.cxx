@@ -62,6 +62,9 @@ using CollisionRecSim_Run1 = soa::Join<aod::Collisions, aod::McCollisionLabels,
 #include <TExMap.h>
 #include <TF1.h>
 #include <TF3.h>
+#include <complex>
+#include <string>
+#include <unordered_map>
 using namespace std;
 
 // *) Enums:
@@ -503,6 +503,7 @@ struct DptDptFilterTracks {
 
   Produces<aod::ScannedTracks> scannedtracks;
   Produces<aod::DptDptCFTracksInfo> tracksinfo;
+  Produces<aod::DptDptCFTracksVariantsInfo> tracksvariantsinfo;
   Produces<aod::ScannedTrueTracks> scannedgentracks;
   Produces<aod::DptDptCFGenTracksInfo> gentracksinfo;
 
@@ -516,6 +517,7 @@ struct DptDptFilterTracks {
 
   Configurable<bool> cfgOutDebugInfo{"outdebuginfo", false, "Out detailed debug information per track into a text file. Default false"};
   Configurable<bool> cfgFullDerivedData{"fullderiveddata", false, "Produce the full derived data for external storage. Default false"};
+  Configurable<std::string> cfgTrackTypeVariants{"trktypevariants", "", "Track types of the variants, separated by commas, selected in the same pass and stored in the variants mask. See trktype. Default \"\": no variants"};
   Configurable<int> cfgTrackType{"trktype", 4, "Type of selected tracks: 0 = no selection;1 = Run2 global tracks FB96;3 = Run3 tracks;4 = Run3 tracks MM sel;5 = Run2 TPC only tracks;7 = Run 3 TPC only tracks;30-33 = any/two on 3 ITS,any/all in 7 ITS;40-43 same as 30-33 w tighter DCAxy;50-53 w tighter pT DCAz. Default 4"};
   Configurable<o2::analysis::CheckRangeCfg> cfgTraceDCAOutliers{"trackdcaoutliers", {false, 0.0, 0.0}, "Track the generator level DCAxy outliers: false/true, low dcaxy, up dcaxy. Default {false,0.0,0.0}"};
   Configurable<float> cfgTraceOutOfSpeciesParticles{"trackoutparticles", false, "Track the particles which are not e,mu,pi,K,p: false/true. Default false"};
@@ -540,6 +542,8 @@ struct DptDptFilterTracks {
   OutputObj<TList> fOutput{"DptDptFilterTracksInfo", OutputObjHandlingPolicy::AnalysisObject};
   PIDSpeciesSelection pidselector;
   bool checkAmbiguousTracks = false;
+  uint32_t trackVariantsMask = 0; // the track type variants which accepted the last selected track
+  int8_t trackVariantId = -1;     // the id of the last selected track for the track type variants
 
   void init(InitContext& initContext)
   {
@@ -569,6 +573,10 @@ struct DptDptFilterTracks {
     /* the track types and combinations */
     tracktype = cfgTrackType.value;
     initializeTrackSelection(cfgTuneTrackSelection);
+    initializeTrackVariantSelections(cfgTrackTypeVariants.value, cfgTuneTrackSelection);
+    for (uint ivar = 0; ivar < trackVariantSelections.size(); ++ivar) {
+      LOGF(info, "Track type variant %d: track type %d", ivar, trackVariantSelections[ivar].tracktype);
+    }
     traceDCAOutliers = cfgTraceDCAOutliers;
     traceOutOfSpeciesParticles = cfgTraceOutOfSpeciesParticles;
     recoIdMethod = cfgRecoIdMethod;
@@ -878,9 +886,13 @@ struct DptDptFilterTracks {
 
     int naccepted = 0;
     int ncollaccepted = 0;
+    bool storeVariants = !fullDerivedData && !trackVariantSelections.empty();
     if (!fullDerivedData) {
       tracksinfo.reserve(tracks.size());
     }
+    if (storeVariants) {
+      tracksvariantsinfo.reserve(tracks.size());
+    }
     for (auto collision : collisions) {
       if (collision.collisionaccepted()) {
         ncollaccepted++;
@@ -888,6 +900,8 @@ struct DptDptFilterTracks {
     }
     for (auto track : tracks) {
       int8_t pid = -1;
+      trackVariantsMask = 0;
+      trackVariantId = -1;
       if (track.has_collision() && (track.template collision_as<soa::Join<aod::Collisions, aod::DptDptCFCollisionsInfo>>()).collisionaccepted()) {
         pid = selectTrackAmbiguousCheck<outdebug>(collisions, track);
         if (!(pid < 0)) {
@@ -910,6 +924,9 @@ struct DptDptFilterTracks {
           tracksinfo(pid);
         }
       }
+      if (storeVariants) {
+        tracksvariantsinfo(trackVariantId, trackVariantsMask);
+      }
     }
     LOGF(DPTDPTFILTERLOGCOLLISIONS,
          "Processed %d accepted collisions out of a total of %d with  %d accepted tracks out of a "
@@ -1111,22 +1128,32 @@ int8_t DptDptFilterTracks::selectTrack(TrackObject const& track)
 
   /* track selection */
   int8_t sp = -127;
-  if (AcceptTrack(track)) {
-    /* the track has been accepted */
-    /* let's identify it */
-    sp = trackIdentification<outdebug>(track);
-    if (!(sp < 0)) {
-      /* fill the species histograms */
-      fillTrackHistosAfterSelection(track, sp);
-      /* update species multiplicities */
-      if (track.sign() > 0) {
-        trkMultPos[sp]++;
-        /* positive tracks even pid */
-        sp = sp * 2;
-      } else if (track.sign() < 0) {
-        trkMultNeg[sp]++;
-        /* negative tracks odd pid */
-        sp = sp * 2 + 1;
+  bool intheacceptance = InTheAcceptance(track);
+  bool accepted = intheacceptance && matchTrackType(track);
+  /* all the track type variants are selected in the same pass */
+  trackVariantsMask = (intheacceptance && !trackVariantSelections.empty()) ? matchTrackVariants(track) : 0;
+  if (accepted || trackVariantsMask != 0) {
+    /* the track has been accepted by the track type or by any of its variants */
+    /* let's identify it, the species does not depend on the track type */
+    int8_t id = trackIdentification<outdebug>(track);
+    if (!(id < 0) && trackVariantsMask != 0) {
+      trackVariantId = (track.sign() > 0) ? id * 2 : ((track.sign() < 0) ? id * 2 + 1 : id);
+    }
+    if (accepted) {
+      sp = id;
+      if (!(sp < 0)) {
+        /* fill the species histograms */
+        fillTrackHistosAfterSelection(track, sp);
+        /* update species multiplicities */
+        if (track.sign() > 0) {
+          trkMultPos[sp]++;
+          /* positive tracks even pid */
+          sp = sp * 2;
+        } else if (track.sign() < 0) {
+          trkMultNeg[sp]++;
+          /* negative tracks odd pid */
+          sp = sp * 2 + 1;
+        }
       }
     }
   }
@@ -149,12 +149,20 @@ static constexpr o2::aod::track::TrackSelectionFlags::flagtype trackSelectionDCA
   o2::aod::track::TrackSelectionFlags::kDCAz | o2::aod::track::TrackSelectionFlags::kDCAxy;
 
 int tracktype = 1;
-std::function<float(float)> maxDcaZPtDep{}; // max dca in z axis as function of pT
 
-std::vector<TrackSelection*> trackFilters = {};
-bool dca2Dcut = false;
-float maxDCAz = 1e6f;
-float maxDCAxy = 1e6f;
+/// \struct TrackTypeSelection
+/// \brief The track selection criteria associated to a track type
+struct TrackTypeSelection {
+  int tracktype = 1;
+  std::vector<TrackSelection*> trackFilters = {};
+  std::function<float(float)> maxDcaZPtDep{}; // max dca in z axis as function of pT
+  bool dca2Dcut = false;
+  float maxDCAz = 1e6f;
+  float maxDCAxy = 1e6f;
+};
+
+TrackTypeSelection trackSelection;                    // the selection of the configured track type
+std::vector<TrackTypeSelection> trackVariantSelections; // the selections of the track type variants
 
 inline TList* getCCDBInput(auto& ccdb, const char* ccdbpath, const char* ccdbdate, const char* period = "")
 {
@@ -179,9 +187,9 @@ inline TList* getCCDBInput(auto& ccdb, const char* ccdbpath, const char* ccdbdat
   return lst;
 }
 
-inline void initializeTrackSelection(const TrackSelectionTuneCfg& tune)
+inline void initializeTrackSelection(TrackTypeSelection& selection, const TrackSelectionTuneCfg& tune)
 {
-  switch (tracktype) {
+  switch (selection.tracktype) {
     case 1: { /* Run2 global track */
       TrackSelection* globalRun2 = new TrackSelection(getGlobalTrackSelection());
       globalRun2->SetTrackType(o2::aod::track::Run2Track); // Run 2 track asked by default
@@ -189,8 +197,8 @@ inline void initializeTrackSelection(const TrackSelectionTuneCfg& tune)
       TrackSelection* globalSDDRun2 = new TrackSelection(getGlobalTrackSelectionSDD());
       globalSDDRun2->SetTrackType(o2::aod::track::Run2Track); // Run 2 track asked by default
       globalSDDRun2->SetMaxChi2PerClusterTPC(2.5f);
-      trackFilters.push_back(globalRun2);
-      trackFilters.push_back(globalSDDRun2);
+      selection.trackFilters.push_back(globalRun2);
+      selection.trackFilters.push_back(globalSDDRun2);
     } break;
     case 3: { /* Run3 track */
       TrackSelection* globalRun3 = new TrackSelection(getGlobalTrackSelection());
@@ -202,8 +210,8 @@ inline void initializeTrackSelection(const TrackSelectionTuneCfg& tune)
       globalSDDRun3->ResetITSRequirements();
       globalSDDRun3->SetRequireNoHitsInITSLayers({0, 1, 2});
       globalSDDRun3->SetRequireHitsInITSLayers(1, {3});
-      trackFilters.push_back(globalRun3);
-      trackFilters.push_back(globalSDDRun3);
+      selection.trackFilters.push_back(globalRun3);
+      selection.trackFilters.push_back(globalSDDRun3);
     } break;
     case 5: { /* Run2 TPC only track */
       TrackSelection* tpcOnly = new TrackSelection;
@@ -211,11 +219,11 @@ inline void initializeTrackSelection(const TrackSelectionTuneCfg& tune)
       tpcOnly->SetMinNClustersTPC(50);
       tpcOnly->SetMaxChi2PerClusterTPC(4);
       tpcOnly->SetMaxDcaZ(3.2f);
-      maxDCAz = 3.2;
+      selection.maxDCAz = 3.2;
       tpcOnly->SetMaxDcaXY(2.4f);
-      maxDCAxy = 2.4;
-      dca2Dcut = true;
-      trackFilters.push_back(tpcOnly);
+      selection.maxDCAxy = 2.4;
+      selection.dca2Dcut = true;
+      selection.trackFilters.push_back(tpcOnly);
     } break;
     case 7: { /* Run3 TPC only track */
       TrackSelection* tpcOnly = new TrackSelection;
@@ -223,57 +231,57 @@ inline void initializeTrackSelection(const TrackSelectionTuneCfg& tune)
       tpcOnly->SetMinNClustersTPC(50);
       tpcOnly->SetMaxChi2PerClusterTPC(4);
       tpcOnly->SetMaxDcaZ(3.2f);
-      maxDCAz = 3.2;
+      selection.maxDCAz = 3.2;
       tpcOnly->SetMaxDcaXY(2.4f);
-      maxDCAxy = 2.4;
-      dca2Dcut = true;
-      trackFilters.push_back(tpcOnly);
+      selection.maxDCAxy = 2.4;
+      selection.dca2Dcut = true;
+      selection.trackFilters.push_back(tpcOnly);
     } break;
     case 30: { /* Run 3 default global track: kAny on 3 IB layers of ITS */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibAny, TrackSelection::GlobalTrackRun3DCAxyCut::Default)));
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibAny, TrackSelection::GlobalTrackRun3DCAxyCut::Default)));
     } break;
     case 31: { /* Run 3 global track: kTwo on 3 IB layers of ITS */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibTwo, TrackSelection::GlobalTrackRun3DCAxyCut::Default)));
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibTwo, TrackSelection::GlobalTrackRun3DCAxyCut::Default)));
     } break;
     case 32: { /* Run 3 global track: kAny on all 7 layers of ITS */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSallAny, TrackSelection::GlobalTrackRun3DCAxyCut::Default)));
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSallAny, TrackSelection::GlobalTrackRun3DCAxyCut::Default)));
     } break;
     case 33: { /* Run 3 global track: kAll on all 7 layers of ITS */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSall7Layers, TrackSelection::GlobalTrackRun3DCAxyCut::Default)));
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSall7Layers, TrackSelection::GlobalTrackRun3DCAxyCut::Default)));
     } break;
     case 40: { /* Run 3 global track: kAny on 3 IB layers of ITS, tighter DCAxy */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibAny, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibAny, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
     } break;
     case 41: { /* Run 3 global track: kTwo on 3 IB layers of ITS, tighter DCAxy */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibTwo, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibTwo, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
     } break;
     case 42: { /* Run 3 global track: kAny on all 7 layers of ITS, tighter DCAxy */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSallAny, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSallAny, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
     } break;
     case 43: { /* Run 3 global track: kAll on all 7 layers of ITS, tighter DCAxy */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSall7Layers, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSall7Layers, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
     } break;
     case 50: { /* Run 3 global track: kAny on 3 IB layers of ITS, tighter DCAxy, tighter pT dep DCAz */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibAny, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
-      maxDcaZPtDep = [](float pt) { return 0.004f + 0.013f / pt; };
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibAny, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
+      selection.maxDcaZPtDep = [](float pt) { return 0.004f + 0.013f / pt; };
     } break;
     case 51: { /* Run 3 global track: kTwo on 3 IB layers of ITS, tighter DCAxy, tighter pT dep DCAz */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibTwo, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
-      maxDcaZPtDep = [](float pt) { return 0.004f + 0.013f / pt; };
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibTwo, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
+      selection.maxDcaZPtDep = [](float pt) { return 0.004f + 0.013f / pt; };
     } break;
     case 52: { /* Run 3 global track: kAny on all 7 layers of ITS, tighter DCAxy, tighter pT dep DCAz */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSallAny, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
-      maxDcaZPtDep = [](float pt) { return 0.004f + 0.013f / pt; };
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSallAny, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
+      selection.maxDcaZPtDep = [](float pt) { return 0.004f + 0.013f / pt; };
     } break;
     case 53: { /* Run 3 global track: kAll on all 7 layers of ITS, tighter DCAxy, tighter pT dep DCAz */
-      trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSall7Layers, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
-      maxDcaZPtDep = [](float pt) { return 0.004f + 0.013f / pt; };
+      selection.trackFilters.push_back(new TrackSelection(getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSall7Layers, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3)));
+      selection.maxDcaZPtDep = [](float pt) { return 0.004f + 0.013f / pt; };
     } break;
     default:
       break;
   }
   if (tune.mUseIt) {
-    for (auto filter : trackFilters) {
+    for (auto filter : selection.trackFilters) {
       if (tune.mUseTPCclusters) {
         filter->SetMinNClustersTPC(tune.mTPCclusters);
       }
@@ -293,6 +301,32 @@ inline void initializeTrackSelection(const TrackSelectionTuneCfg& tune)
   }
 }
 
+/// \brief Initializes the selection of the configured track type
+inline void initializeTrackSelection(const TrackSelectionTuneCfg& tune)
+{
+  trackSelection.tracktype = tracktype;
+  initializeTrackSelection(trackSelection, tune);
+}
+
+/// \brief Initializes the selections of the track type variants
+/// \param variants the track types of the variants separated by commas
+inline void initializeTrackVariantSelections(const std::string& variants, const TrackSelectionTuneCfg& tune)
+{
+  std::stringstream ss(variants);
+  std::string type;
+  while (std::getline(ss, type, ',')) {
+    if (type.find_first_not_of(" ") == std::string::npos) {
+      continue;
+    }
+    trackVariantSelections.emplace_back();
+    trackVariantSelections.back().tracktype = std::stoi(type);
+    initializeTrackSelection(trackVariantSelections.back(), tune);
+  }
+  if (trackVariantSelections.size() > 32) {
+    LOGF(fatal, "Too many track type variants: %d. At most 32 fit in the variants mask", trackVariantSelections.size());
+  }
+}
+
 SystemType fSystem = kNoSystem;
 DataType fDataType = kData;
 CentMultEstimatorType fCentMultEstimator = kV0M;
@@ -790,11 +824,11 @@ inline bool IsEvtSelected(CollisionObject const& collision, float& centormult)
 //////////////////////////////////////////////////////////////////////////////////
 
 template <typename TrackObject>
-inline bool matchTrackType(TrackObject const& track)
+inline bool matchTrackType(TrackObject const& track, TrackTypeSelection const& selection)
 {
   using namespace o2::aod::track;
 
-  if (tracktype == 4) {
+  if (selection.tracktype == 4) {
     // under tests MM track selection
     // see: https://indico.cern.ch/event/1383788/contributions/5816953/attachments/2805905/4896281/TrackSel_GlobalTracks_vs_MMTrackSel.pdf
     // it should be equivalent to this
@@ -805,12 +839,12 @@ inline bool matchTrackType(TrackObject const& track)
            (!track.hasTPC() || ((track.trackCutFlag() & trackSelectionTPC) == trackSelectionTPC)) &&
            ((track.trackCutFlag() & trackSelectionDCA) == trackSelectionDCA);
   } else {
-    for (auto filter : trackFilters) {
+    for (auto filter : selection.trackFilters) {
       if (filter->IsSelected(track)) {
         /* additional track cuts if needed */
         auto checkDca2Dcut = [&](auto const& track) {
-          if (dca2Dcut) {
-            if (track.dcaXY() * track.dcaXY() / maxDCAxy / maxDCAxy + track.dcaZ() * track.dcaZ() / maxDCAz / maxDCAz > 1) {
+          if (selection.dca2Dcut) {
+            if (track.dcaXY() * track.dcaXY() / selection.maxDCAxy / selection.maxDCAxy + track.dcaZ() * track.dcaZ() / selection.maxDCAz / selection.maxDCAz > 1) {
               return false;
             } else {
               return true;
@@ -820,7 +854,7 @@ inline bool matchTrackType(TrackObject const& track)
           }
         };
         auto checkDcaZcut = [&](auto const& track) {
-          return ((maxDcaZPtDep) ? abs(track.dcaZ()) <= maxDcaZPtDep(track.pt()) : true);
+          return ((selection.maxDcaZPtDep) ? abs(track.dcaZ()) <= selection.maxDcaZPtDep(track.pt()) : true);
         };
 
         /* tight pT dependent DCAz cut */
@@ -838,6 +872,12 @@ inline bool matchTrackType(TrackObject const& track)
   }
 }
 
+template <typename TrackObject>
+inline bool matchTrackType(TrackObject const& track)
+{
+  return matchTrackType(track, trackSelection);
+}
+
 /// \brief Checks if the passed track is within the acceptance conditions of the analysis
 /// \param track the track of interest
 /// \return true if the track is in the acceptance, otherwise false
@@ -875,6 +915,21 @@ inline bool AcceptTrack(TrackObject const& track)
   return false;
 }
 
+/// \brief Gets the track type variants matched by the passed track
+/// \param track the track of interest
+/// \return the mask with the bits of the matched variants set
+template <typename TrackObject>
+inline uint32_t matchTrackVariants(TrackObject const& track)
+{
+  uint32_t mask = 0;
+  for (uint ivar = 0; ivar < trackVariantSelections.size(); ++ivar) {
+    if (matchTrackType(track, trackVariantSelections[ivar])) {
+      mask |= (1u << ivar);
+    }
+  }
+  return mask;
+}
+
 template <typename ParticleObject, typename MCCollisionObject>
 void exploreMothers(ParticleObject& particle, MCCollisionObject& collision)
 {
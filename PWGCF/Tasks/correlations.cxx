@@ -31,6 +31,7 @@
 #include "Common/DataModel/Centrality.h"
 #include "PWGCF/DataModel/CorrelationsDerived.h"
 #include "PWGCF/Core/CorrelationContainer.h"
+#include "PWGCF/Core/CorrelationFillBuffer.h"
 #include "PWGCF/Core/PairCuts.h"
 #include "DataFormatsParameters/GRPObject.h"
 #include "DataFormatsParameters/GRPMagField.h"
@@ -121,6 +122,8 @@ struct CorrelationTask {
   OutputObj<CorrelationContainer> mixed{"mixedEvent"};
 
   std::vector<float> efficiencyAssociatedCache;
+  std::vector<Long64_t> binAssociatedCache;
+  CorrelationFillBuffer pairBuffer;
 
   struct Config {
     bool mPairCuts = false;
@@ -189,7 +192,12 @@ struct CorrelationTask {
     same->setTrackEtaCut(cfgCutEta);
     mixed->setTrackEtaCut(cfgCutEta);
 
+    std::vector<AxisSpec> pairAxis(corrAxis);
+    pairAxis.insert(pairAxis.end(), userAxis.begin(), userAxis.end());
+    pairBuffer.init(pairAxis);
+
     efficiencyAssociatedCache.reserve(512);
+    binAssociatedCache.reserve(512);
 
     // o2-ccdb-upload -p Users/jgrosseo/correlations/LHC15o -f /tmp/correction_2011_global.root -k correction
 
@@ -298,6 +306,16 @@ struct CorrelationTask {
       }
     }
 
+    // Bins of the pair histogram axes which depend only on one particle are computed once per particle (axes: delta eta, pT assoc, pT trig, multiplicity, delta phi, vertex, [mass])
+    binAssociatedCache.clear();
+    binAssociatedCache.reserve(tracks2.size());
+    for (auto& track : tracks2) {
+      const int bin = pairBuffer.findBin(1, track.pt());
+      binAssociatedCache.push_back(bin < 0 ? -1 : pairBuffer.offset(1, bin));
+    }
+    const int binMultiplicity = pairBuffer.findBin(3, multiplicity);
+    const int binPosZ = pairBuffer.findBin(5, posZ);
+
     for (auto& track1 : tracks1) {
       // LOGF(info, "Track %f | %f | %f  %d %d", track1.eta(), track1.phi(), track1.pt(), track1.isGlobalTrack(), track1.isGlobalTrackSDD());
 
@@ -334,7 +352,21 @@ struct CorrelationTask {
         target->getTriggerHist()->Fill(step, track1.pt(), multiplicity, posZ, triggerWeight);
       }
 
+      Long64_t binTrigger = -1;
+      const int binPtTrigger = pairBuffer.findBin(2, track1.pt());
+      if (binPtTrigger >= 0 && binMultiplicity >= 0 && binPosZ >= 0) {
+        binTrigger = pairBuffer.offset(2, binPtTrigger) + pairBuffer.offset(3, binMultiplicity) + pairBuffer.offset(5, binPosZ);
+      }
+      if (cfgMassAxis) {
+        if constexpr (std::experimental::is_detected<hasInvMass, typename TTracks1::iterator>::value) {
+          const int binMass = pairBuffer.findBin(6, track1.invMass());
+          binTrigger = (binTrigger < 0 || binMass < 0) ? -1 : binTrigger + pairBuffer.offset(6, binMass);
+        }
+      }
+
+      int iTrack2 = -1;
       for (auto& track2 : tracks2) {
+        ++iTrack2;
         if constexpr (std::is_same<TTracks1, TTracks2>::value) {
           if (track1.globalIndex() == track2.globalIndex()) {
             // LOGF(info, "Track identical: %f | %f | %f || %f | %f | %f", track1.eta(), track1.phi(), track1.pt(),  track2.eta(), track2.phi(), track2.pt());
@@ -397,17 +429,18 @@ struct CorrelationTask {
           deltaPhi += TwoPI;
         }
 
-        // last param is the weight
-        if (cfgMassAxis) {
-          if constexpr (std::experimental::is_detected<hasInvMass, typename TTracks1::iterator>::value)
-            target->getPairHist()->Fill(step, track1.eta() - track2.eta(), track2.pt(), track1.pt(), multiplicity, deltaPhi, posZ, track1.invMass(), associatedWeight);
-          else
-            LOGF(fatal, "Can not fill mass axis without invMass column. Disable cfgMassAxis.");
-        } else {
-          target->getPairHist()->Fill(step, track1.eta() - track2.eta(), track2.pt(), track1.pt(), multiplicity, deltaPhi, posZ, associatedWeight);
+        if (binTrigger < 0 || binAssociatedCache[iTrack2] < 0) {
+          continue;
+        }
+        const int binDeltaEta = pairBuffer.findBin(0, track1.eta() - track2.eta());
+        const int binDeltaPhi = pairBuffer.findBin(4, deltaPhi);
+        if (binDeltaEta < 0 || binDeltaPhi < 0) {
+          continue;
         }
+        pairBuffer.add(target->getPairHist(), step, binTrigger + binAssociatedCache[iTrack2] + pairBuffer.offset(0, binDeltaEta) + pairBuffer.offset(4, binDeltaPhi), associatedWeight);
       }
     }
+    pairBuffer.flush();
   }
 
   void loadEfficiency(uint64_t timestamp)
@@ -769,6 +769,24 @@ std::vector<bool> CutBrickSelectorMultipleRanges<TValueToFilter>::Filter(const T
   return std::vector<bool>(mActive);
 }
 
+/// \brief Filter the passed value to update the brick status accordingly
+/// \param value The value to filter
+/// \param mask The mask where the bits of the ranges containing the value are set
+/// \param bit The bit of the first range, updated to the bit after the last one
+/// \return true if the value is inside any of the ranges
+template <typename TValueToFilter>
+bool CutBrickSelectorMultipleRanges<TValueToFilter>::FilterMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  Filter(value);
+  for (unsigned int i = 0; i < mActive.size(); ++i) {
+    if (mActive[i]) {
+      SETBIT(mask, bit);
+    }
+    bit++;
+  }
+  return this->mState == this->kACTIVE;
+}
+
 templateClassImp(CutBrickSelectorMultipleRanges);
 template class o2::analysis::PWGCF::CutBrickSelectorMultipleRanges<int>;
 template class o2::analysis::PWGCF::CutBrickSelectorMultipleRanges<float>;
@@ -987,6 +1005,26 @@ std::vector<bool> CutWithVariations<TValueToFilter>::Filter(const TValueToFilter
   return res;
 }
 
+/// Filters the passed value coding the result directly in the passed mask
+/// The bricks on the default values list and in the variation
+/// values list will change to active or passive accordingly to the passed value
+/// \param value The value to filter
+/// \param mask The mask where the bits of the bricks activated by the value are set
+/// \param bit The bit of the first brick, updated to the bit after the last one
+/// \returns true if the value activated any of the bricks
+template <typename TValueToFilter>
+bool CutWithVariations<TValueToFilter>::FilterMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  bool atleastone = false;
+  for (int i = 0; i < mDefaultBricks.GetEntries(); ++i) {
+    atleastone = ((CutBrick<TValueToFilter>*)mDefaultBricks.At(i))->FilterMask(value, mask, bit) || atleastone;
+  }
+  for (int i = 0; i < mVariationBricks.GetEntries(); ++i) {
+    atleastone = ((CutBrick<TValueToFilter>*)mVariationBricks.At(i))->FilterMask(value, mask, bit) || atleastone;
+  }
+  return atleastone;
+}
+
 /// Return the length needed to code the cut
 /// The length is in brick units. The actual length is implementation dependent
 /// \returns Cut length in units of bricks
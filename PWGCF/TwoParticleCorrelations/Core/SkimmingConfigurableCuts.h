@@ -57,6 +57,24 @@ class CutBrick : public TNamed
   /// fits within the brick or brick components scope
   /// \returns a vector of booleans with true on the component for which the value activated the component brick
   virtual std::vector<bool> Filter(const TValueToFilter&) = 0;
+  /// Virtual function. Filters the passed value as Filter() but codes the result
+  /// directly in the passed mask, without building the vector of booleans
+  /// \param value the value to filter
+  /// \param mask the mask where the bits of the components activated by the value are set
+  /// \param bit the bit of the first component, updated to the bit after the last one
+  /// \returns true if the value activated any of the brick components
+  virtual bool FilterMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+  {
+    bool atleastone = false;
+    for (auto b : Filter(value)) {
+      if (b) {
+        atleastone = true;
+        SETBIT(mask, bit);
+      }
+      bit++;
+    }
+    return atleastone;
+  }
   /// Pure virtual function. Return the length needed to code the brick status
   /// The length is in brick units. The actual length is implementation dependent
   /// \returns Brick length in units of bricks
@@ -113,6 +131,7 @@ class CutBrickLimit : public CutBrick<TValueToFilter>
 
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterMask(const TValueToFilter&, uint64_t&, int&) override;
   virtual int Length() override { return 1; }
 
  private:
@@ -141,6 +160,26 @@ inline std::vector<bool> CutBrickLimit<TValueToFilter>::Filter(const TValueToFil
   return res;
 }
 
+/// \brief Filter the passed value to update the brick status accordingly
+/// \param value The value to filter
+/// \param mask The mask where the brick bit is set if the value passed the cut
+/// \param bit The brick bit, updated to the next one
+/// \return true if the value passed the cut false otherwise
+template <typename TValueToFilter>
+inline bool CutBrickLimit<TValueToFilter>::FilterMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  bool res = false;
+  if (value < mLimit) {
+    this->mState = this->kACTIVE;
+    SETBIT(mask, bit);
+    res = true;
+  } else {
+    this->mState = this->kPASSIVE;
+  }
+  bit++;
+  return res;
+}
+
 /// \class CutBrickFnLimit
 /// \brief Class which implements a function based limiting cut brick.
 /// The brick will be active if the filtered value is below the limit
@@ -184,6 +223,7 @@ class CutBrickThreshold : public CutBrick<TValueToFilter>
 
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterMask(const TValueToFilter&, uint64_t&, int&) override;
   virtual int Length() override { return 1; }
 
  private:
@@ -212,6 +252,26 @@ inline std::vector<bool> CutBrickThreshold<TValueToFilter>::Filter(const TValueT
   return res;
 }
 
+/// \brief Filter the passed value to update the brick status accordingly
+/// \param value The value to filter
+/// \param mask The mask where the brick bit is set if the value passed the cut
+/// \param bit The brick bit, updated to the next one
+/// \return true if the value passed the cut false otherwise
+template <typename TValueToFilter>
+inline bool CutBrickThreshold<TValueToFilter>::FilterMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  bool res = false;
+  if (mThreshold < value) {
+    this->mState = this->kACTIVE;
+    SETBIT(mask, bit);
+    res = true;
+  } else {
+    this->mState = this->kPASSIVE;
+  }
+  bit++;
+  return res;
+}
+
 /// \class CutBrickFnThreshold
 /// \brief Class which implements a function based threshold cut brick.
 /// The brick will be active if the filtered value is above the threshold
@@ -255,6 +315,7 @@ class CutBrickRange : public CutBrick<TValueToFilter>
 
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterMask(const TValueToFilter&, uint64_t&, int&) override;
   virtual int Length() override { return 1; }
 
  private:
@@ -284,6 +345,26 @@ std::vector<bool> CutBrickRange<TValueToFilter>::Filter(const TValueToFilter& va
   return res;
 }
 
+/// \brief Filter the passed value to update the brick status accordingly
+/// \param value The value to filter
+/// \param mask The mask where the brick bit is set if the value passed the cut
+/// \param bit The brick bit, updated to the next one
+/// \return true if the value passed the cut false otherwise
+template <typename TValueToFilter>
+inline bool CutBrickRange<TValueToFilter>::FilterMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  bool res = false;
+  if ((mLow < value) and (value < mUp)) {
+    this->mState = this->kACTIVE;
+    SETBIT(mask, bit);
+    res = true;
+  } else {
+    this->mState = this->kPASSIVE;
+  }
+  bit++;
+  return res;
+}
+
 /// \class CutBrickFnRange
 /// \brief Class which implements a function based range cut brick.
 /// The brick will be active if the filtered value is within the range
@@ -329,6 +410,7 @@ class CutBrickExtToRange : public CutBrick<TValueToFilter>
 
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterMask(const TValueToFilter&, uint64_t&, int&) override;
   virtual int Length() override { return 1; }
 
  private:
@@ -358,6 +440,26 @@ std::vector<bool> CutBrickExtToRange<TValueToFilter>::Filter(const TValueToFilte
   return res;
 }
 
+/// \brief Filter the passed value to update the brick status accordingly
+/// \param value The value to filter
+/// \param mask The mask where the brick bit is set if the value passed the cut
+/// \param bit The brick bit, updated to the next one
+/// \return true if the value passed the cut false otherwise
+template <typename TValueToFilter>
+inline bool CutBrickExtToRange<TValueToFilter>::FilterMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  bool res = false;
+  if ((value < mLow) or (mUp < value)) {
+    this->mState = this->kACTIVE;
+    SETBIT(mask, bit);
+    res = true;
+  } else {
+    this->mState = this->kPASSIVE;
+  }
+  bit++;
+  return res;
+}
+
 /// \class CutBrickExtToRange
 /// \brief Class which implements an external to function base range cut brick.
 /// The brick will be active if the filtered value is outside the range
@@ -405,6 +507,7 @@ class CutBrickSelectorMultipleRanges : public CutBrick<TValueToFilter>
 
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterMask(const TValueToFilter&, uint64_t&, int&) override;
   /// Return the length needed to code the brick status
   /// The length is in brick units. The actual length is implementation dependent
   /// \returns Brick length in units of bricks
@@ -439,6 +542,7 @@ class CutWithVariations : public CutBrick<TValueToFilter>
   TList& getVariantBricks() { return mVariationBricks; }
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterMask(const TValueToFilter&, uint64_t&, int&) override;
   virtual int Length() override;
   virtual int getArmedIndex() override;
 
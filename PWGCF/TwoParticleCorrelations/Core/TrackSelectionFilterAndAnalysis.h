@@ -139,23 +139,13 @@ uint64_t TrackSelectionFilterAndAnalysis::Filter(TrackToFilter const& track)
   };
 
   auto filterBrickValue = [&](auto brick, auto value) {
-    std::vector<bool> res = brick->Filter(value);
-    for (auto b : res) {
-      if (b) {
-        SETBIT(selectedMask, bit);
-      }
-      bit++;
-    }
+    brick->FilterMask(value, selectedMask, bit);
   };
 
   auto filterBrickValueNoMask = [](auto brick, auto value) {
-    std::vector<bool> res = brick->Filter(value);
-    for (auto b : res) {
-      if (b) {
-        return true;
-      }
-    }
-    return false;
+    uint64_t mask = 0UL;
+    int nobit = 0;
+    return brick->FilterMask(value, mask, nobit);
   };
 
   for (int i = 0; i < mTrackSign.GetEntries(); ++i) {
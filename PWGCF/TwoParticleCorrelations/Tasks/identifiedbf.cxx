@@ -200,6 +200,42 @@ struct IdentifiedBfCorrelationsTask {
       return fhN2_vsDEtaDPhi[0][0]->GetBin(deltaeta_ix + 1, deltaphi_ix + 1);
     }
 
+    /// \brief The track quantities used in the pair loop, stored once per track instead of being recomputed per pair
+    struct PairTrackQuantities {
+      std::vector<float> pt;
+      std::vector<float> eta;
+      std::vector<float> phi;
+      std::vector<int> etaix; ///< zero based eta index
+      std::vector<int> phiix; ///< zero based, potentially origin shifted, phi index
+      std::vector<int> id;    ///< the track accepted id
+    };
+    PairTrackQuantities fPairTracks1; ///< the track one quantities for the current pair loop
+    PairTrackQuantities fPairTracks2; ///< the track two quantities for the current pair loop
+
+    /// \brief Stores the quantities of a list of tracks used in the pair loop
+    /// Same index computation as GetDEtaDPhiGlobalIndex
+    template <typename TrackListObject>
+    void storePairTrackQuantities(TrackListObject const& trks, PairTrackQuantities& q)
+    {
+      using namespace correlationstask;
+      using namespace o2::analysis::identifiedbffilter;
+
+      q.pt.clear();
+      q.eta.clear();
+      q.phi.clear();
+      q.etaix.clear();
+      q.phiix.clear();
+      q.id.clear();
+      for (auto& track : trks) {
+        q.pt.push_back(track.pt());
+        q.eta.push_back(track.eta());
+        q.phi.push_back(track.phi());
+        q.etaix.push_back(static_cast<int>((track.eta() - etalow) / etabinwidth));
+        q.phiix.push_back(static_cast<int>((GetShiftedPhi(track.phi()) - philow) / phibinwidth));
+        q.id.push_back(track.trackacceptedid());
+      }
+    }
+
     void storeTrackCorrections(std::vector<TH3*> corrs)
     {
       LOGF(info, "Stored NUA&NUE corrections for %d track ids", corrs.size());
@@ -326,43 +362,61 @@ struct IdentifiedBfCorrelationsTask {
     {
       using namespace correlationstask;
 
-      /* process pair magnitudes */
-      std::vector<std::vector<double>> n2(nch, std::vector<double>(nch, 0.0));           ///< weighted number of track 1 track 2 pairs for current collision
-      std::vector<std::vector<double>> n2sup(nch, std::vector<double>(nch, 0.0));        ///< weighted number of track 1 track 2 suppressed pairs for current collision
-      std::vector<std::vector<double>> sum2PtPt(nch, std::vector<double>(nch, 0.0));     ///< accumulated sum of weighted track 1 track 2 \f${p_T}_1 {p_T}_2\f$ for current collision
-      std::vector<std::vector<double>> sum2DptDpt(nch, std::vector<double>(nch, 0.0));   ///< accumulated sum of weighted number of track 1 tracks times weighted track 2 \f$p_T\f$ for current collision
-      std::vector<std::vector<double>> n2nw(nch, std::vector<double>(nch, 0.0));         ///< not weighted number of track1 track 2 pairs for current collision
-      std::vector<std::vector<double>> sum2PtPtnw(nch, std::vector<double>(nch, 0.0));   ///< accumulated sum of not weighted track 1 track 2 \f${p_T}_1 {p_T}_2\f$ for current collision
-      std::vector<std::vector<double>> sum2DptDptnw(nch, std::vector<double>(nch, 0.0)); ///< accumulated sum of not weighted number of track 1 tracks times not weighted track 2 \f$p_T\f$ for current collision
+      /* the per track quantities */
+      storePairTrackQuantities(trks1, fPairTracks1);
+      storePairTrackQuantities(trks2, fPairTracks2);
+      /* the TH2 global bin stride of the differential histograms */
+      const int dEtaDPhiStride = fhN2_vsDEtaDPhi[0][0]->GetNbinsX() + 2;
+
+      /* process pair magnitudes, indexed by pid1 * nch + pid2 */
+      std::vector<double> n2(nch * nch, 0.0);           ///< weighted number of track 1 track 2 pairs for current collision
+      std::vector<double> n2sup(nch * nch, 0.0);        ///< weighted number of track 1 track 2 suppressed pairs for current collision
+      std::vector<double> sum2PtPt(nch * nch, 0.0);     ///< accumulated sum of weighted track 1 track 2 \f${p_T}_1 {p_T}_2\f$ for current collision
+      std::vector<double> sum2DptDpt(nch * nch, 0.0);   ///< accumulated sum of weighted number of track 1 tracks times weighted track 2 \f$p_T\f$ for current collision
+      std::vector<double> n2nw(nch * nch, 0.0);         ///< not weighted number of track1 track 2 pairs for current collision
+      std::vector<double> sum2PtPtnw(nch * nch, 0.0);   ///< accumulated sum of not weighted track 1 track 2 \f${p_T}_1 {p_T}_2\f$ for current collision
+      std::vector<double> sum2DptDptnw(nch * nch, 0.0); ///< accumulated sum of not weighted number of track 1 tracks times not weighted track 2 \f$p_T\f$ for current collision
       int index1 = 0;
 
       for (auto& track1 : trks1) {
         double ptavg_1 = (*ptavgs1)[index1];
         double corr1 = (*corrs1)[index1];
+        const float pt1 = fPairTracks1.pt[index1];
+        const int id1 = fPairTracks1.id[index1];
         int index2 = 0;
+        int pos2 = -1;
         for (auto& track2 : trks2) {
+          pos2++;
           /* checking the same track id condition */
           if (track1 == track2) {
             /* exclude autocorrelations */
             continue;
           }
 
+          const float pt2 = fPairTracks2.pt[pos2];
           if constexpr (doptorder) {
-            if (track2.pt() >= track1.pt()) {
+            if (pt2 >= pt1) {
               continue;
             }
           }
+          const int id2 = fPairTracks2.id[pos2];
+          const int pids = id1 * nch + id2;
           /* process pair magnitudes */
           double ptavg_2 = (*ptavgs2)[index2];
           double corr2 = (*corrs2)[index2];
           double corr = corr1 * corr2;
-          double dptdptnw = (track1.pt() - ptavg_1) * (track2.pt() - ptavg_2);
-          double dptdptw = (corr1 * track1.pt() - ptavg_1) * (corr2 * track2.pt() - ptavg_2);
+          double dptdptnw = (pt1 - ptavg_1) * (pt2 - ptavg_2);
+          double dptdptw = (corr1 * pt1 - ptavg_1) * (corr2 * pt2 - ptavg_2);
 
           /* get the global bin for filling the differential histograms */
-          int globalbin = GetDEtaDPhiGlobalIndex(track1, track2);
-          float deltaeta = track1.eta() - track2.eta();
-          float deltaphi = track1.phi() - track2.phi();
+          int deltaeta_ix = fPairTracks1.etaix[index1] - fPairTracks2.etaix[pos2] + etabins - 1;
+          int deltaphi_ix = fPairTracks1.phiix[index1] - fPairTracks2.phiix[pos2];
+          if (deltaphi_ix < 0) {
+            deltaphi_ix += phibins;
+          }
+          int globalbin = (deltaeta_ix + 1) + dEtaDPhiStride * (deltaphi_ix + 1);
+          float deltaeta = fPairTracks1.eta[index1] - fPairTracks2.eta[pos2];
+          float deltaphi = fPairTracks1.phi[index1] - fPairTracks2.phi[pos2];
           while (deltaphi >= deltaphiup) {
             deltaphi -= constants::math::TwoPI;
           }
@@ -371,42 +425,43 @@ struct IdentifiedBfCorrelationsTask {
           }
           if ((fUseConversionCuts && fPairCuts.conversionCuts(track1, track2)) || (fUseTwoTrackCut && fPairCuts.twoTrackCut(track1, track2, bfield))) {
             /* suppress the pair */
-            fhSupN1N1_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->AddBinContent(globalbin, corr);
-            fhSupPt1Pt1_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->AddBinContent(globalbin, track1.pt() * track2.pt() * corr);
-            n2sup[track1.trackacceptedid()][track2.trackacceptedid()] += corr;
+            fhSupN1N1_vsDEtaDPhi[id1][id2]->AddBinContent(globalbin, corr);
+            fhSupPt1Pt1_vsDEtaDPhi[id1][id2]->AddBinContent(globalbin, pt1 * pt2 * corr);
+            n2sup[pids] += corr;
           } else {
             /* count the pair */
-            n2[track1.trackacceptedid()][track2.trackacceptedid()] += corr;
-            sum2PtPt[track1.trackacceptedid()][track2.trackacceptedid()] += track1.pt() * track2.pt() * corr;
-            sum2DptDpt[track1.trackacceptedid()][track2.trackacceptedid()] += dptdptw;
-            n2nw[track1.trackacceptedid()][track2.trackacceptedid()] += 1;
-            sum2PtPtnw[track1.trackacceptedid()][track2.trackacceptedid()] += track1.pt() * track2.pt();
-            sum2DptDptnw[track1.trackacceptedid()][track2.trackacceptedid()] += dptdptnw;
-
-            fhN2_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->AddBinContent(globalbin, corr);
-            fhN2cont_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->Fill(deltaeta, deltaphi, corr);
-            fhSum2DptDpt_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->AddBinContent(globalbin, dptdptw);
-            fhSum2PtPt_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->AddBinContent(globalbin, track1.pt() * track2.pt() * corr);
+            n2[pids] += corr;
+            sum2PtPt[pids] += pt1 * pt2 * corr;
+            sum2DptDpt[pids] += dptdptw;
+            n2nw[pids] += 1;
+            sum2PtPtnw[pids] += pt1 * pt2;
+            sum2DptDptnw[pids] += dptdptnw;
+
+            fhN2_vsDEtaDPhi[id1][id2]->AddBinContent(globalbin, corr);
+            fhN2cont_vsDEtaDPhi[id1][id2]->Fill(deltaeta, deltaphi, corr);
+            fhSum2DptDpt_vsDEtaDPhi[id1][id2]->AddBinContent(globalbin, dptdptw);
+            fhSum2PtPt_vsDEtaDPhi[id1][id2]->AddBinContent(globalbin, pt1 * pt2 * corr);
           }
-          fhN2_vsPtPt[track1.trackacceptedid()][track2.trackacceptedid()]->Fill(track1.pt(), track2.pt(), corr);
+          fhN2_vsPtPt[id1][id2]->Fill(pt1, pt2, corr);
           index2++;
         }
         index1++;
       }
       for (uint pid1 = 0; pid1 < nch; ++pid1) {
         for (uint pid2 = 0; pid2 < nch; ++pid2) {
-          fhN2_vsC[pid1][pid2]->Fill(cmul, n2[pid1][pid2]);
-          fhSum2PtPt_vsC[pid1][pid2]->Fill(cmul, sum2PtPt[pid1][pid2]);
-          fhSum2DptDpt_vsC[pid1][pid2]->Fill(cmul, sum2DptDpt[pid1][pid2]);
-          fhN2nw_vsC[pid1][pid2]->Fill(cmul, n2nw[pid1][pid2]);
-          fhSum2PtPtnw_vsC[pid1][pid2]->Fill(cmul, sum2PtPtnw[pid1][pid2]);
-          fhSum2DptDptnw_vsC[pid1][pid2]->Fill(cmul, sum2DptDptnw[pid1][pid2]);
+          const uint pids = pid1 * nch + pid2;
+          fhN2_vsC[pid1][pid2]->Fill(cmul, n2[pids]);
+          fhSum2PtPt_vsC[pid1][pid2]->Fill(cmul, sum2PtPt[pids]);
+          fhSum2DptDpt_vsC[pid1][pid2]->Fill(cmul, sum2DptDpt[pids]);
+          fhN2nw_vsC[pid1][pid2]->Fill(cmul, n2nw[pids]);
+          fhSum2PtPtnw_vsC[pid1][pid2]->Fill(cmul, sum2PtPtnw[pids]);
+          fhSum2DptDptnw_vsC[pid1][pid2]->Fill(cmul, sum2DptDptnw[pids]);
           /* let's also update the number of entries in the differential histograms */
-          fhN2_vsDEtaDPhi[pid1][pid2]->SetEntries(fhN2_vsDEtaDPhi[pid1][pid2]->GetEntries() + n2[pid1][pid2]);
-          fhSum2DptDpt_vsDEtaDPhi[pid1][pid2]->SetEntries(fhSum2DptDpt_vsDEtaDPhi[pid1][pid2]->GetEntries() + n2[pid1][pid2]);
-          fhSum2PtPt_vsDEtaDPhi[pid1][pid2]->SetEntries(fhSum2PtPt_vsDEtaDPhi[pid1][pid2]->GetEntries() + n2[pid1][pid2]);
-          fhSupN1N1_vsDEtaDPhi[pid1][pid2]->SetEntries(fhSupN1N1_vsDEtaDPhi[pid1][pid2]->GetEntries() + n2sup[pid1][pid2]);
-          fhSupPt1Pt1_vsDEtaDPhi[pid1][pid2]->SetEntries(fhSupPt1Pt1_vsDEtaDPhi[pid1][pid2]->GetEntries() + n2sup[pid1][pid2]);
+          fhN2_vsDEtaDPhi[pid1][pid2]->SetEntries(fhN2_vsDEtaDPhi[pid1][pid2]->GetEntries() + n2[pids]);
+          fhSum2DptDpt_vsDEtaDPhi[pid1][pid2]->SetEntries(fhSum2DptDpt_vsDEtaDPhi[pid1][pid2]->GetEntries() + n2[pids]);
+          fhSum2PtPt_vsDEtaDPhi[pid1][pid2]->SetEntries(fhSum2PtPt_vsDEtaDPhi[pid1][pid2]->GetEntries() + n2[pids]);
+          fhSupN1N1_vsDEtaDPhi[pid1][pid2]->SetEntries(fhSupN1N1_vsDEtaDPhi[pid1][pid2]->GetEntries() + n2sup[pids]);
+          fhSupPt1Pt1_vsDEtaDPhi[pid1][pid2]->SetEntries(fhSupPt1Pt1_vsDEtaDPhi[pid1][pid2]->GetEntries() + n2sup[pids]);
         }
       }
     }
@@ -0,0 +1,233 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "PWGDQ/Core/AnalysisCutProgram.h"
+#include "PWGDQ/Core/AnalysisCut.h"
+#include "PWGDQ/Core/AnalysisCompositeCut.h"
+#include "Framework/Logger.h"
+
+#include <algorithm>
+
+//____________________________________________________________________________
+void AnalysisCutProgram::Compile(const std::vector<AnalysisCut*>& cuts, int batchSize)
+{
+  //
+  // flatten the cut trees into instructions and allocate the batch
+  //
+  if (cuts.size() > 64) {
+    LOG(fatal) << "AnalysisCutProgram::Compile(): at most 64 cuts can be compiled in one program, " << cuts.size() << " requested";
+  }
+  fInstructions.clear();
+  fNodes.clear();
+  fRoots.clear();
+  fUsedVars.clear();
+  fColumnOfVar.clear();
+  for (const auto* cut : cuts) {
+    fRoots.push_back(AddNode(*cut));
+  }
+
+  fBatchSize = std::max(batchSize, 1);
+  fNStaged = 0;
+  fColumns.assign(fUsedVars.size() * fBatchSize, 0.0f);
+  fScratch.assign(fNodes.size(), std::vector<uint8_t>());
+  for (std::size_t iNode = 0; iNode < fNodes.size(); ++iNode) {
+    if (fNodes[iNode].fIsComposite) {
+      fScratch[iNode].assign(fBatchSize, 0);
+    }
+  }
+  fSkip.assign(fBatchSize, 0);
+  fPass.assign(fBatchSize, 0);
+}
+
+//____________________________________________________________________________
+int AnalysisCutProgram::GetColumn(int var)
+{
+  //
+  // column of a variable in the batch, added if not yet used
+  //
+  if (var < 0) {
+    return -1;
+  }
+  if (var >= static_cast<int>(fColumnOfVar.size())) {
+    fColumnOfVar.resize(var + 1, -1);
+  }
+  if (fColumnOfVar[var] < 0) {
+    fColumnOfVar[var] = fUsedVars.size();
+    fUsedVars.push_back(var);
+  }
+  return fColumnOfVar[var];
+}
+
+//____________________________________________________________________________
+int AnalysisCutProgram::AddNode(const AnalysisCut& cut)
+{
+  //
+  // add a cut and, for composite cuts, all its sub-cuts
+  //
+  int iNode = fNodes.size();
+  fNodes.emplace_back();
+
+  if (cut.IsA() == AnalysisCompositeCut::Class()) {
+    const auto& composite = static_cast<const AnalysisCompositeCut&>(cut);
+    std::vector<int> children;
+    // same order as in AnalysisCompositeCut::IsSelected()
+    for (const auto& subCut : composite.GetCutList()) {
+      children.push_back(AddNode(subCut));
+    }
+    for (const auto& subCut : composite.GetCompositeCutList()) {
+      children.push_back(AddNode(subCut));
+    }
+    auto& node = fNodes[iNode];
+    node.fIsComposite = true;
+    node.fUseAND = composite.GetUseAND();
+    node.fFirstInstruction = 0;
+    node.fNInstructions = 0;
+    node.fChildren = std::move(children);
+    return iNode;
+  }
+
+  auto& node = fNodes[iNode];
+  node.fIsComposite = false;
+  node.fUseAND = true;
+  node.fFirstInstruction = fInstructions.size();
+  node.fNInstructions = cut.GetCuts().size();
+  for (const auto& container : cut.GetCuts()) {
+    Instruction instruction;
+    instruction.fColumn = GetColumn(container.fVar);
+    instruction.fLow = container.fLow;
+    instruction.fHigh = container.fHigh;
+    instruction.fExclude = container.fExclude;
+    instruction.fDepColumn = GetColumn(container.fDepVar);
+    instruction.fDepLow = container.fDepLow;
+    instruction.fDepHigh = container.fDepHigh;
+    instruction.fDepExclude = container.fDepExclude;
+    instruction.fDep2Column = GetColumn(container.fDepVar2);
+    instruction.fDep2Low = container.fDep2Low;
+    instruction.fDep2High = container.fDep2High;
+    instruction.fDep2Exclude = container.fDep2Exclude;
+    instruction.fFuncLow = container.fFuncLow;
+    instruction.fFuncHigh = container.fFuncHigh;
+    fInstructions.push_back(instruction);
+  }
+  return iNode;
+}
+
+//____________________________________________________________________________
+bool AnalysisCutProgram::Stage(const float* values)
+{
+  //
+  // gather the used variables of one candidate
+  //
+  if (fNStaged >= fBatchSize) {
+    return false;
+  }
+  const int nColumns = fUsedVars.size();
+  for (int iColumn = 0; iColumn < nColumns; ++iColumn) {
+    fColumns[iColumn * fBatchSize + fNStaged] = values[fUsedVars[iColumn]];
+  }
+  ++fNStaged;
+  return true;
+}
+
+//____________________________________________________________________________
+void AnalysisCutProgram::EvaluateInstruction(const Instruction& instruction, int n, uint8_t* pass)
+{
+  //
+  // AND the decision of one range instruction into pass, with the same logic as AnalysisCut::IsSelected()
+  //
+  uint8_t* skip = fSkip.data();
+  std::fill(skip, skip + n, 0);
+  if (instruction.fDepColumn >= 0) {
+    const float* dep = &fColumns[instruction.fDepColumn * fBatchSize];
+    const float low = instruction.fDepLow, high = instruction.fDepHigh;
+    const uint8_t exclude = instruction.fDepExclude;
+    for (int i = 0; i < n; ++i) {
+      skip[i] |= (((dep[i] > low) & (dep[i] <= high)) == exclude);
+    }
+  }
+  if (instruction.fDep2Column >= 0) {
+    const float* dep = &fColumns[instruction.fDep2Column * fBatchSize];
+    const float low = instruction.fDep2Low, high = instruction.fDep2High;
+    const uint8_t exclude = instruction.fDep2Exclude;
+    for (int i = 0; i < n; ++i) {
+      skip[i] |= (((dep[i] > low) & (dep[i] <= high)) == exclude);
+    }
+  }
+
+  const float* x = &fColumns[instruction.fColumn * fBatchSize];
+  const uint8_t exclude = instruction.fExclude;
+  if (!instruction.fFuncLow && !instruction.fFuncHigh) {
+    const float low = instruction.fLow, high = instruction.fHigh;
+    for (int i = 0; i < n; ++i) {
+      pass[i] &= ((((x[i] >= low) & (x[i] <= high)) != exclude) | skip[i]);
+    }
+    return;
+  }
+
+  // the limits are functions of the first dependent variable, evaluated per candidate
+  const float* dep = &fColumns[instruction.fDepColumn * fBatchSize];
+  for (int i = 0; i < n; ++i) {
+    if (skip[i] || !pass[i]) {
+      continue;
+    }
+    float low = instruction.fFuncLow ? instruction.fFuncLow->Eval(dep[i]) : instruction.fLow;
+    float high = instruction.fFuncHigh ? instruction.fFuncHigh->Eval(dep[i]) : instruction.fHigh;
+    pass[i] = (((x[i] >= low) & (x[i] <= high)) != exclude);
+  }
+}
+
+//____________________________________________________________________________
+void AnalysisCutProgram::EvaluateNode(int iNode, int n, uint8_t* pass)
+{
+  //
+  // decisions of one cut for the n staged candidates
+  //
+  const auto& node = fNodes[iNode];
+  if (!node.fIsComposite) {
+    std::fill(pass, pass + n, 1);
+    for (int iInstruction = node.fFirstInstruction; iInstruction < node.fFirstInstruction + node.fNInstructions; ++iInstruction) {
+      EvaluateInstruction(fInstructions[iInstruction], n, pass);
+    }
+    return;
+  }
+
+  std::fill(pass, pass + n, node.fUseAND ? 1 : 0);
+  uint8_t* childPass = fScratch[iNode].data();
+  for (auto child : node.fChildren) {
+    EvaluateNode(child, n, childPass);
+    if (node.fUseAND) {
+      for (int i = 0; i < n; ++i) {
+        pass[i] &= childPass[i];
+      }
+    } else {
+      for (int i = 0; i < n; ++i) {
+        pass[i] |= childPass[i];
+      }
+    }
+  }
+}
+
+//____________________________________________________________________________
+void AnalysisCutProgram::Evaluate(uint64_t* masks)
+{
+  //
+  // evaluate all the compiled cuts over the staged candidates
+  //
+  const int n = fNStaged;
+  std::fill(masks, masks + n, 0);
+  for (std::size_t iCut = 0; iCut < fRoots.size(); ++iCut) {
+    EvaluateNode(fRoots[iCut], n, fPass.data());
+    for (int i = 0; i < n; ++i) {
+      masks[i] |= (static_cast<uint64_t>(fPass[i]) << iCut);
+    }
+  }
+  fNStaged = 0;
+}
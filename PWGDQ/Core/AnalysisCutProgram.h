@@ -0,0 +1,96 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+// Contact: iarsene@cern.ch, i.c.arsene@fys.uio.no
+//
+// Compiled form of a list of AnalysisCut / AnalysisCompositeCut objects, evaluated over batches of candidates
+// The cut trees are flattened into range instructions on the used variables only, and each instruction is applied
+// with branch-free loops over a column of the batch. The result is a bit mask per candidate, one bit per cut
+//
+
+#ifndef PWGDQ_CORE_ANALYSISCUTPROGRAM_H_
+#define PWGDQ_CORE_ANALYSISCUTPROGRAM_H_
+
+#include <TF1.h>
+#include <cstdint>
+#include <vector>
+
+class AnalysisCut;
+
+//_________________________________________________________________________
+class AnalysisCutProgram
+{
+ public:
+  AnalysisCutProgram() = default;
+  ~AnalysisCutProgram() = default;
+
+  // Compile the cuts; bit i of the output masks holds the decision of cuts[i] (at most 64 cuts)
+  // NOTE: the cut objects are not kept, but the TF1 limits they might use must outlive the program
+  void Compile(const std::vector<AnalysisCut*>& cuts, int batchSize = 1024);
+
+  // Copy the variables used by the cuts for one candidate (e.g. VarManager::fgValues) into the batch
+  // Returns false if the batch is full, in which case Evaluate() has to be called first
+  bool Stage(const float* values);
+  // Evaluate the staged candidates; masks must have room for GetNStaged() entries, in the order of staging
+  // The batch is emptied afterwards
+  void Evaluate(uint64_t* masks);
+  void Clear() { fNStaged = 0; }
+
+  int GetNCuts() const { return fRoots.size(); }
+  int GetBatchSize() const { return fBatchSize; }
+  int GetNStaged() const { return fNStaged; }
+  bool IsFull() const { return fNStaged >= fBatchSize; }
+  const std::vector<int>& GetUsedVariables() const { return fUsedVars; }
+
+ private:
+  struct Instruction {
+    int fColumn;       // column of the variable to be cut upon
+    float fLow;        // lower limit
+    float fHigh;       // upper limit
+    bool fExclude;     // if true, the range is used for exclusion
+    int fDepColumn;    // column of the first dependent variable, -1 if not used
+    float fDepLow;     // lower limit for the first dependent variable
+    float fDepHigh;    // upper limit for the first dependent variable
+    bool fDepExclude;  // if true, the dependent variable range is used for exclusion
+    int fDep2Column;   // column of the second dependent variable, -1 if not used
+    float fDep2Low;    // lower limit for the second dependent variable
+    float fDep2High;   // upper limit for the second dependent variable
+    bool fDep2Exclude; // if true, the dependent variable range is used for exclusion
+    TF1* fFuncLow;     // function of the first dependent variable for the lower limit
+    TF1* fFuncHigh;    // function of the first dependent variable for the upper limit
+  };
+  struct Node {
+    bool fIsComposite;          // composite cuts combine their children, simple cuts their instructions
+    bool fUseAND;               // combine the children with AND (default) or OR
+    int fFirstInstruction;      // first instruction of a simple cut
+    int fNInstructions;         // number of instructions of a simple cut
+    std::vector<int> fChildren; // nodes of the cuts combined by a composite cut
+  };
+
+  int AddNode(const AnalysisCut& cut);
+  int GetColumn(int var);
+  void EvaluateInstruction(const Instruction& instruction, int n, uint8_t* pass);
+  void EvaluateNode(int node, int n, uint8_t* pass);
+
+  std::vector<Instruction> fInstructions;     // range instructions of all the cuts
+  std::vector<Node> fNodes;                   // cut tree nodes
+  std::vector<int> fRoots;                    // node of each compiled cut
+  std::vector<int> fUsedVars;                 // VarManager variable of each column
+  std::vector<int> fColumnOfVar;              // column of each VarManager variable, -1 if not used
+  std::vector<float> fColumns;                // staged values, column-major (column x batch)
+  std::vector<std::vector<uint8_t>> fScratch; // per-node decisions of the children
+  std::vector<uint8_t> fSkip;                 // candidates for which the current instruction does not apply
+  std::vector<uint8_t> fPass;                 // decisions of the current cut
+  int fBatchSize = 0;                         // maximum number of staged candidates
+  int fNStaged = 0;                           // number of staged candidates
+};
+
+#endif // PWGDQ_CORE_ANALYSISCUTPROGRAM_H_
@@ -17,6 +17,63 @@
 #include "AnalysisCompositeCut.h"
 #include "VarManager.h"
 
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+// function-local statics, so that registrations done at static initialization in other libraries are safe
+std::unordered_map<std::string, o2::aod::dqcuts::AnalysisCutFactory>& analysisCutRegistry()
+{
+  static std::unordered_map<std::string, o2::aod::dqcuts::AnalysisCutFactory> registry;
+  return registry;
+}
+std::unordered_map<std::string, o2::aod::dqcuts::CompositeCutFactory>& compositeCutRegistry()
+{
+  static std::unordered_map<std::string, o2::aod::dqcuts::CompositeCutFactory> registry;
+  return registry;
+}
+template <typename T>
+std::vector<std::string> registeredNames(const T& registry)
+{
+  std::vector<std::string> names;
+  names.reserve(registry.size());
+  for (const auto& entry : registry) {
+    names.push_back(entry.first);
+  }
+  std::sort(names.begin(), names.end());
+  return names;
+}
+} // namespace
+
+bool o2::aod::dqcuts::RegisterAnalysisCut(const char* cutName, AnalysisCutFactory factory)
+{
+  auto inserted = analysisCutRegistry().emplace(cutName, std::move(factory)).second;
+  if (!inserted) {
+    LOGF(warn, "Analysis cut %s is already registered, keeping the first definition", cutName);
+  }
+  return inserted;
+}
+
+bool o2::aod::dqcuts::RegisterCompositeCut(const char* cutName, CompositeCutFactory factory)
+{
+  auto inserted = compositeCutRegistry().emplace(cutName, std::move(factory)).second;
+  if (!inserted) {
+    LOGF(warn, "Composite cut %s is already registered, keeping the first definition", cutName);
+  }
+  return inserted;
+}
+
+std::vector<std::string> o2::aod::dqcuts::GetRegisteredAnalysisCuts()
+{
+  return registeredNames(analysisCutRegistry());
+}
+
+std::vector<std::string> o2::aod::dqcuts::GetRegisteredCompositeCuts()
+{
+  return registeredNames(compositeCutRegistry());
+}
+
 AnalysisCompositeCut* o2::aod::dqcuts::GetCompositeCut(const char* cutName)
 {
   //
@@ -25,6 +82,12 @@ AnalysisCompositeCut* o2::aod::dqcuts::GetCompositeCut(const char* cutName)
   // TODO: Agree on some conventions for the naming
   //       Think of possible customization of the predefined cuts via names
 
+  // registered cuts first
+  const auto& registry = compositeCutRegistry();
+  if (auto entry = registry.find(cutName); entry != registry.end()) {
+    return entry->second(cutName);
+  }
+
   AnalysisCompositeCut* cut = new AnalysisCompositeCut(cutName, cutName);
   std::string nameStr = cutName;
 
@@ -3033,6 +3096,12 @@ AnalysisCut* o2::aod::dqcuts::GetAnalysisCut(const char* cutName)
   //
   // define here cuts which are likely to be used often
   //
+  // registered cuts first
+  const auto& registry = analysisCutRegistry();
+  if (auto entry = registry.find(cutName); entry != registry.end()) {
+    return entry->second(cutName);
+  }
+
   AnalysisCut* cut = new AnalysisCut(cutName, cutName);
   std::string nameStr = cutName;
   // ---------------------------------------------------------------
@@ -15,6 +15,7 @@
 #ifndef PWGDQ_CORE_CUTSLIBRARY_H_
 #define PWGDQ_CORE_CUTSLIBRARY_H_
 
+#include <functional>
 #include <string>
 #include <vector>
 #include "PWGDQ/Core/AnalysisCut.h"
@@ -27,6 +28,16 @@ namespace dqcuts
 {
 AnalysisCompositeCut* GetCompositeCut(const char* cutName);
 AnalysisCut* GetAnalysisCut(const char* cutName);
+
+// Cuts registered by name are looked up in a hash map before the predefined cuts of GetAnalysisCut() and GetCompositeCut()
+// The factory is called on each lookup and the caller takes ownership of the returned cut
+// Registration can be done at static initialization, e.g. static bool registered = RegisterAnalysisCut("myCut", ...);
+using AnalysisCutFactory = std::function<AnalysisCut*(const char* cutName)>;
+using CompositeCutFactory = std::function<AnalysisCompositeCut*(const char* cutName)>;
+bool RegisterAnalysisCut(const char* cutName, AnalysisCutFactory factory);
+bool RegisterCompositeCut(const char* cutName, CompositeCutFactory factory);
+std::vector<std::string> GetRegisteredAnalysisCuts();
+std::vector<std::string> GetRegisteredCompositeCuts();
 } // namespace dqcuts
 } // namespace o2::aod
 
@@ -42,7 +42,15 @@ HistogramManager::HistogramManager() : TNamed("", ""),
                                        fUseDefaultVariableNames(false),
                                        fBinsAllocated(0),
                                        fVariableNames(nullptr),
-                                       fVariableUnits(nullptr)
+                                       fVariableUnits(nullptr),
+                                       fFillPlans(),
+                                       fHistClassHandles(),
+                                       fFillPlansValid(false),
+                                       fLazyAllocation(false),
+                                       fPendingHistograms(),
+                                       fPendingBins(),
+                                       fHistClassNames(),
+                                       fHistClassPending()
 {
   //
   // Constructor
@@ -58,7 +66,15 @@ HistogramManager::HistogramManager(const char* name, const char* title, const in
                                                                                               fUseDefaultVariableNames(kFALSE),
                                                                                               fBinsAllocated(0),
                                                                                               fVariableNames(),
-                                                                                              fVariableUnits()
+                                                                                              fVariableUnits(),
+                                                                                              fFillPlans(),
+                                                                                              fHistClassHandles(),
+                                                                                              fFillPlansValid(false),
+                                                                                              fLazyAllocation(false),
+                                                                                              fPendingHistograms(),
+                                                                                              fPendingBins(),
+                                                                                              fHistClassNames(),
+                                                                                              fHistClassPending()
 {
   //
   // Constructor
@@ -113,6 +129,7 @@ void HistogramManager::AddHistClass(const char* histClass)
   fMainList->Add(hList);
   std::list<std::vector<int>> varList;
   fVariablesMap[histClass] = varList;
+  fFillPlansValid = false;
 }
 
 //_________________________________________________________________
@@ -141,6 +158,23 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
     return;
   }
 
+  // in lazy mode, only register the histogram; it is created at the first fill of its class
+  if (fLazyAllocation) {
+    for (int var : {varX, varY, varZ, varT, varW}) {
+      if (var > kNothing) {
+        fUsedVars[var] = kTRUE;
+      }
+    }
+    int nAxes = (varZ > kNothing ? 3 : (varY > kNothing ? 2 : 1)) - ((isProfile && varT <= kNothing) ? 1 : 0);
+    uint64_t nBins = (nXbins + 2) * (nAxes > 1 ? nYbins + 2 : 1) * (nAxes > 2 ? nZbins + 2 : 1);
+    std::string className = histClass, name = hname, titleCopy = title, xLab = xLabels, yLab = yLabels, zLab = zLabels;
+    DeferHistogram(histClass, nBins, [=](HistogramManager* hm) {
+      hm->AddHistogram(className.c_str(), name.c_str(), titleCopy.c_str(), isProfile, nXbins, xmin, xmax, varX, nYbins, ymin, ymax, varY,
+                       nZbins, zmin, zmax, varZ, xLab.c_str(), yLab.c_str(), zLab.c_str(), varT, varW, isdouble);
+    });
+    return;
+  }
+
   // deduce the dimension of the histogram from parameters
   // NOTE: in case of profile histograms, one extra variable is needed
   int dimension = 1;
@@ -183,6 +217,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
   std::list varList = fVariablesMap[histClass];
   varList.push_back(varVector);
   fVariablesMap[histClass] = varList;
+  fFillPlansValid = false;
 
   // create and configure histograms according to required options
   TH1* h = nullptr;
@@ -349,6 +384,32 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
     return;
   }
 
+  // in lazy mode, only register the histogram; it is created at the first fill of its class
+  if (fLazyAllocation) {
+    for (int var : {varX, varY, varZ, varT, varW}) {
+      if (var > kNothing) {
+        fUsedVars[var] = kTRUE;
+      }
+    }
+    int nAxes = (varZ > kNothing ? 3 : (varY > kNothing ? 2 : 1)) - ((isProfile && varT <= kNothing) ? 1 : 0);
+    uint64_t nBins = (nXbins + 2) * (nAxes > 1 ? nYbins + 2 : 1) * (nAxes > 2 ? nZbins + 2 : 1);
+    std::string className = histClass, name = hname, titleCopy = title, xLab = xLabels, yLab = yLabels, zLab = zLabels;
+    std::vector<double> xBinsCopy(xbins, xbins + nXbins + 1);
+    std::vector<double> yBinsCopy, zBinsCopy;
+    if (ybins) {
+      yBinsCopy.assign(ybins, ybins + nYbins + 1);
+    }
+    if (zbins) {
+      zBinsCopy.assign(zbins, zbins + nZbins + 1);
+    }
+    DeferHistogram(histClass, nBins, [=](HistogramManager* hm) {
+      std::vector<double> xb = xBinsCopy, yb = yBinsCopy, zb = zBinsCopy;
+      hm->AddHistogram(className.c_str(), name.c_str(), titleCopy.c_str(), isProfile, nXbins, xb.data(), varX, nYbins, (yb.empty() ? nullptr : yb.data()), varY,
+                       nZbins, (zb.empty() ? nullptr : zb.data()), varZ, xLab.c_str(), yLab.c_str(), zLab.c_str(), varT, varW, isdouble);
+    });
+    return;
+  }
+
   // deduce the dimension of the histogram from parameters
   // NOTE: in case of profile histograms, one extra variable is needed
   int dimension = 1;
@@ -392,6 +453,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
   std::list varList = fVariablesMap[histClass];
   varList.push_back(varVector);
   fVariablesMap[histClass] = varList;
+  fFillPlansValid = false;
 
   TH1* h = nullptr;
   switch (dimension) {
@@ -551,6 +613,33 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
     return;
   }
 
+  // in lazy mode, only register the histogram; it is created at the first fill of its class
+  if (fLazyAllocation) {
+    uint64_t nBinsTotal = (useSparse ? 0 : 1);
+    for (int idim = 0; idim < nDimensions; ++idim) {
+      fUsedVars[vars[idim]] = kTRUE;
+      nBinsTotal *= (nBins[idim] + 2);
+    }
+    if (varW > kNothing) {
+      fUsedVars[varW] = kTRUE;
+    }
+    std::string className = histClass, name = hname, titleCopy = title;
+    std::vector<int> varsCopy(vars, vars + nDimensions), nBinsCopy(nBins, nBins + nDimensions);
+    std::vector<double> xminCopy(xmin, xmin + nDimensions), xmaxCopy(xmax, xmax + nDimensions);
+    std::vector<TString> labelsCopy;
+    if (axLabels) {
+      labelsCopy.assign(axLabels, axLabels + nDimensions);
+    }
+    DeferHistogram(histClass, nBinsTotal, [=](HistogramManager* hm) {
+      std::vector<int> v = varsCopy, nb = nBinsCopy;
+      std::vector<double> lo = xminCopy, hi = xmaxCopy;
+      std::vector<TString> labels = labelsCopy;
+      hm->AddHistogram(className.c_str(), name.c_str(), titleCopy.c_str(), nDimensions, v.data(), nb.data(), lo.data(), hi.data(),
+                       (labels.empty() ? nullptr : labels.data()), varW, useSparse, isdouble);
+    });
+    return;
+  }
+
   // tokenize the title string; the user may include in it axis titles which will overwrite the defaults
   TString titleStr(title);
   std::unique_ptr<TObjArray> arr(titleStr.Tokenize(";"));
@@ -570,6 +659,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
   std::list varList = fVariablesMap[histClass];
   varList.push_back(varVector);
   fVariablesMap[histClass] = varList;
+  fFillPlansValid = false;
 
   uint32_t nbins = 1;
   THnBase* h = nullptr;
@@ -644,6 +734,33 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
     return;
   }
 
+  // in lazy mode, only register the histogram; it is created at the first fill of its class
+  if (fLazyAllocation) {
+    uint64_t nBinsTotal = (useSparse ? 0 : 1);
+    for (int idim = 0; idim < nDimensions; ++idim) {
+      fUsedVars[vars[idim]] = kTRUE;
+      nBinsTotal *= (binLimits[idim].GetSize() + 1);
+    }
+    if (varW > kNothing) {
+      fUsedVars[varW] = kTRUE;
+    }
+    std::string className = histClass, name = hname, titleCopy = title;
+    std::vector<int> varsCopy(vars, vars + nDimensions);
+    std::vector<TArrayD> limitsCopy(binLimits, binLimits + nDimensions);
+    std::vector<TString> labelsCopy;
+    if (axLabels) {
+      labelsCopy.assign(axLabels, axLabels + nDimensions);
+    }
+    DeferHistogram(histClass, nBinsTotal, [=](HistogramManager* hm) {
+      std::vector<int> v = varsCopy;
+      std::vector<TArrayD> limits = limitsCopy;
+      std::vector<TString> labels = labelsCopy;
+      hm->AddHistogram(className.c_str(), name.c_str(), titleCopy.c_str(), nDimensions, v.data(), limits.data(),
+                       (labels.empty() ? nullptr : labels.data()), varW, useSparse, isdouble);
+    });
+    return;
+  }
+
   // tokenize the title string; the user may include in it axis titles which will overwrite the defaults
   TString titleStr(title);
   std::unique_ptr<TObjArray> arr(titleStr.Tokenize(";"));
@@ -663,6 +780,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
   std::list varList = fVariablesMap[histClass];
   varList.push_back(varVector);
   fVariablesMap[histClass] = varList;
+  fFillPlansValid = false;
 
   // get the min and max for each axis
   auto* xmin = new double[nDimensions];
@@ -729,129 +847,276 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
 }
 
 //__________________________________________________________________
-void HistogramManager::FillHistClass(const char* className, Float_t* values)
+void HistogramManager::DeferHistogram(const char* histClass, uint64_t nBins, std::function<void(HistogramManager*)> addHistogram)
 {
   //
-  //  fill a class of histograms
+  // register a histogram to be created at the first fill of its class (lazy allocation)
   //
+  if (!fMainList->FindObject(histClass)) {
+    LOG(warn) << "HistogramManager::AddHistogram(): Histogram list " << histClass << " not found!";
+    LOG(warn) << "         Histogram not created";
+    return;
+  }
+  fPendingHistograms[histClass].push_back(std::move(addHistogram));
+  fPendingBins[histClass] += nBins;
+  fFillPlansValid = false;
+}
 
-  // get the needed histogram list
-  auto* hList = reinterpret_cast<TList*>(fMainList->FindObject(className));
-  if (!hList) {
-    // TODO: add some meaningfull error message
-    /*LOG(warn) << "HistogramManager::FillHistClass(): Histogram list " << className << " not found!";
-    LOG(warn) << "         Histogram list not filled" << endl; */
+//__________________________________________________________________
+void HistogramManager::MaterializeHistClass(const std::string& histClass)
+{
+  //
+  // create the registered histograms of a class
+  //
+  auto it = fPendingHistograms.find(histClass);
+  if (it == fPendingHistograms.end()) {
     return;
   }
+  std::vector<std::function<void(HistogramManager*)>> pending = std::move(it->second);
+  fPendingHistograms.erase(it);
+  fPendingBins.erase(histClass);
+  bool lazy = fLazyAllocation;
+  fLazyAllocation = false;
+  for (auto& addHistogram : pending) {
+    addHistogram(this);
+  }
+  fLazyAllocation = lazy;
+  fFillPlansValid = false;
+}
+
+//__________________________________________________________________
+void HistogramManager::MaterializeHistograms()
+{
+  //
+  // create all the registered histograms which were not created yet, e.g. to get them in the output even if never filled
+  //
+  std::vector<std::string> classes;
+  for (const auto& [histClass, pending] : fPendingHistograms) {
+    classes.push_back(histClass);
+  }
+  for (const auto& histClass : classes) {
+    MaterializeHistClass(histClass);
+  }
+}
+
+//__________________________________________________________________
+void HistogramManager::PrintMemoryUsage() const
+{
+  //
+  // log, for each histogram class, the number of allocated bins and the number of bins registered for lazy allocation
+  // For THnSparse, only the filled bins are counted
+  //
+  uint64_t totalAllocated = 0;
+  uint64_t totalPending = 0;
+  TIter nextList(fMainList);
+  TList* hList = nullptr;
+  while ((hList = reinterpret_cast<TList*>(nextList()))) {
+    uint64_t allocated = 0;
+    TIter next(hList);
+    TObject* obj = nullptr;
+    while ((obj = next())) {
+      if (obj->InheritsFrom(TH1::Class())) {
+        allocated += (reinterpret_cast<TH1*>(obj))->GetNcells();
+      } else if (obj->InheritsFrom(THnBase::Class())) {
+        allocated += (reinterpret_cast<THnBase*>(obj))->GetNbins();
+      }
+    }
+    uint64_t pending = 0;
+    int nPending = 0;
+    auto binsIt = fPendingBins.find(hList->GetName());
+    if (binsIt != fPendingBins.end()) {
+      pending = binsIt->second;
+      nPending = fPendingHistograms.at(hList->GetName()).size();
+    }
+    totalAllocated += allocated;
+    totalPending += pending;
+    LOGF(info, "HistogramManager %s: class %s, %d histograms with %llu bins allocated, %d histograms with %llu bins pending",
+         GetName(), hList->GetName(), hList->GetEntries(), allocated, nPending, pending);
+  }
+  LOGF(info, "HistogramManager %s: %llu bins allocated, %llu bins pending in total", GetName(), totalAllocated, totalPending);
+}
 
-  // get the corresponding std::list containng identifiers to the needed variables to be filled
-  list varList = fVariablesMap[className];
-
-  TIter next(hList);
-
-  TObject* h = nullptr;
-  bool isProfile;
-  bool isTHn;
-  int dimension = 0;
-  bool isSparse = kFALSE;
-  // TODO: At the moment, maximum 20 dimensions are foreseen for the THn histograms. We should make this more dynamic
-  //       But maybe its better to have it like to avoid dynamically allocating this array in the histogram loop
-  double fillValues[20] = {0.0};
-  int varX = -1, varY = -1, varZ = -1, varT = -1, varW = -1;
-
-  // loop over the histogram and std::list
-  // NOTE: these two should contain the same number of elements and be synchronized, otherwise its a mess
-  for (auto varIter = varList.begin(); varIter != varList.end(); varIter++) {
-    h = next(); // get the histogram
-    // decode information from the vector of indices
-    isProfile = (varIter->at(0) == 1 ? true : false);
-    isTHn = (varIter->at(1) > 0 ? true : false);
-    if (isTHn) {
-      dimension = varIter->at(1);
+//__________________________________________________________________
+void HistogramManager::BuildFillPlans()
+{
+  //
+  // resolve, for each histogram class, the histogram pointers and the needed variable indices into a flat fill plan
+  // Handles of already known classes are kept, new classes are appended
+  //
+  TIter nextList(fMainList);
+  TList* hList = nullptr;
+  while ((hList = reinterpret_cast<TList*>(nextList()))) {
+    std::string className = hList->GetName();
+    int handle = kNothing;
+    auto handleIt = fHistClassHandles.find(className);
+    if (handleIt == fHistClassHandles.end()) {
+      handle = fFillPlans.size();
+      fHistClassHandles[className] = handle;
+      fFillPlans.emplace_back();
+      fHistClassNames.push_back(className);
+      fHistClassPending.push_back(false);
     } else {
-      dimension = (reinterpret_cast<TH1*>(h))->GetDimension();
+      handle = handleIt->second;
     }
+    fHistClassPending[handle] = (fPendingHistograms.find(className) != fPendingHistograms.end());
+    auto& plan = fFillPlans[handle];
+    plan.clear();
 
-    // get the various variable indices
-    varW = varIter->at(2);
-    if (isTHn) {
-      for (int i = 0; i < dimension; i++) {
-        fillValues[i] = values[varIter->at(3 + i)];
+    // NOTE: the histogram list and the std::list of variables are synchronized, see AddHistogram()
+    const auto& varList = fVariablesMap[className];
+    plan.reserve(varList.size());
+    TIter next(hList);
+    for (const auto& varVector : varList) {
+      FillPlanEntry entry;
+      entry.fHist = next();
+      entry.fVarW = varVector[2];
+      for (int i = 0; i < kMaxTHnDimensions; ++i) {
+        entry.fVars[i] = kNothing;
       }
-    } else {
-      varX = varIter->at(3);
-      varY = varIter->at(4);
-      varZ = varIter->at(5);
-      varT = varIter->at(6);
+      bool isProfile = (varVector[0] == 1);
+      if (varVector[1] > 0) { // THn
+        entry.fType = kFillTHn;
+        entry.fDimension = varVector[1];
+        if (entry.fDimension > kMaxTHnDimensions) {
+          LOG(fatal) << "HistogramManager::BuildFillPlans(): THn histogram " << entry.fHist->GetName() << " has more than " << kMaxTHnDimensions << " dimensions";
+        }
+        for (int i = 0; i < entry.fDimension; ++i) {
+          entry.fVars[i] = varVector[3 + i];
+        }
+      } else {
+        entry.fDimension = (reinterpret_cast<TH1*>(entry.fHist))->GetDimension();
+        for (int i = 0; i < 4; ++i) {
+          entry.fVars[i] = varVector[3 + i];
+        }
+        switch (entry.fDimension) {
+          case 1:
+            entry.fType = (isProfile ? kFillTProfile : kFillTH1);
+            break;
+          case 2:
+            entry.fType = (isProfile ? kFillTProfile2D : kFillTH2);
+            break;
+          case 3:
+            entry.fType = (isProfile ? kFillTProfile3D : kFillTH3);
+            break;
+          default:
+            continue;
+        }
+      }
+      plan.push_back(entry);
     }
+  }
+  fFillPlansValid = true;
+}
 
-    if (!isTHn) {
-      switch (dimension) {
-        case 1:
-          if (isProfile) {
-            if (varW > kNothing) {
-              (reinterpret_cast<TProfile*>(h))->Fill(values[varX], values[varY], values[varW]);
-            } else {
-              (reinterpret_cast<TProfile*>(h))->Fill(values[varX], values[varY]);
-            }
-          } else {
-            if (varW > kNothing) {
-              (reinterpret_cast<TH1*>(h))->Fill(values[varX], values[varW]);
-            } else {
-              (reinterpret_cast<TH1*>(h))->Fill(values[varX]);
-            }
-          }
-          break;
-        case 2:
-          if (isProfile) {
-            if (varW > kNothing) {
-              (reinterpret_cast<TProfile2D*>(h))->Fill(values[varX], values[varY], values[varZ], values[varW]);
-            } else {
-              (reinterpret_cast<TProfile2D*>(h))->Fill(values[varX], values[varY], values[varZ]);
-            }
-          } else {
-            if (varW > kNothing) {
-              (reinterpret_cast<TH2*>(h))->Fill(values[varX], values[varY], values[varW]);
-            } else {
-              (reinterpret_cast<TH2*>(h))->Fill(values[varX], values[varY]);
-            }
-          }
-          break;
-        case 3:
-          if (isProfile) {
-            if (varW > kNothing) {
-              (reinterpret_cast<TProfile3D*>(h))->Fill(values[varX], values[varY], values[varZ], values[varT], values[varW]);
-            } else {
-              (reinterpret_cast<TProfile3D*>(h))->Fill(values[varX], values[varY], values[varZ], values[varT]);
-            }
-          } else {
-            if (varW > kNothing) {
-              (reinterpret_cast<TH3*>(h))->Fill(values[varX], values[varY], values[varZ], values[varW]);
-            } else {
-              (reinterpret_cast<TH3*>(h))->Fill(values[varX], values[varY], values[varZ]);
-            }
-          }
-          break;
+//__________________________________________________________________
+int HistogramManager::GetHistClassHandle(const char* className)
+{
+  //
+  // get the handle of the fill plan of a histogram class
+  //
+  if (!fFillPlansValid) {
+    BuildFillPlans();
+  }
+  auto handleIt = fHistClassHandles.find(className);
+  if (handleIt == fHistClassHandles.end()) {
+    return kNothing;
+  }
+  return handleIt->second;
+}
 
-        default:
-          break;
-      } // end switch
-      // end if(!isTHn)
-    } else {
-      if (varW > kNothing) {
-        if (isSparse) {
-          (reinterpret_cast<THnSparse*>(h))->Fill(fillValues, values[varW]);
+//__________________________________________________________________
+void HistogramManager::FillHistClass(const char* className, Float_t* values)
+{
+  //
+  //  fill a class of histograms
+  //
+  int handle = GetHistClassHandle(className);
+  if (handle == kNothing) {
+    // TODO: add some meaningfull error message
+    /*LOG(warn) << "HistogramManager::FillHistClass(): Histogram list " << className << " not found!";
+    LOG(warn) << "         Histogram list not filled" << endl; */
+    return;
+  }
+  FillHistClass(handle, values);
+}
+
+//__________________________________________________________________
+void HistogramManager::FillHistClass(int handle, Float_t* values)
+{
+  //
+  //  fill a class of histograms using its pre-resolved fill plan
+  //
+  if (!fFillPlansValid) {
+    BuildFillPlans();
+  }
+  if (handle < 0 || handle >= static_cast<int>(fFillPlans.size())) {
+    return;
+  }
+  if (fHistClassPending[handle]) {
+    MaterializeHistClass(fHistClassNames[handle]);
+    BuildFillPlans();
+  }
+
+  double fillValues[kMaxTHnDimensions] = {0.0};
+  for (const auto& entry : fFillPlans[handle]) {
+    const int* vars = entry.fVars;
+    const bool hasWeight = (entry.fVarW > kNothing);
+    switch (entry.fType) {
+      case kFillTH1:
+        if (hasWeight) {
+          (reinterpret_cast<TH1*>(entry.fHist))->Fill(values[vars[0]], values[entry.fVarW]);
         } else {
-          (reinterpret_cast<THn*>(h))->Fill(fillValues, values[varW]);
+          (reinterpret_cast<TH1*>(entry.fHist))->Fill(values[vars[0]]);
         }
-      } else {
-        if (isSparse) {
-          (reinterpret_cast<THnSparse*>(h))->Fill(fillValues);
+        break;
+      case kFillTH2:
+        if (hasWeight) {
+          (reinterpret_cast<TH2*>(entry.fHist))->Fill(values[vars[0]], values[vars[1]], values[entry.fVarW]);
         } else {
-          (reinterpret_cast<THn*>(h))->Fill(fillValues);
+          (reinterpret_cast<TH2*>(entry.fHist))->Fill(values[vars[0]], values[vars[1]]);
         }
-      }
-    } // end else
+        break;
+      case kFillTH3:
+        if (hasWeight) {
+          (reinterpret_cast<TH3*>(entry.fHist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]], values[entry.fVarW]);
+        } else {
+          (reinterpret_cast<TH3*>(entry.fHist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]]);
+        }
+        break;
+      case kFillTProfile:
+        if (hasWeight) {
+          (reinterpret_cast<TProfile*>(entry.fHist))->Fill(values[vars[0]], values[vars[1]], values[entry.fVarW]);
+        } else {
+          (reinterpret_cast<TProfile*>(entry.fHist))->Fill(values[vars[0]], values[vars[1]]);
+        }
+        break;
+      case kFillTProfile2D:
+        if (hasWeight) {
+          (reinterpret_cast<TProfile2D*>(entry.fHist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]], values[entry.fVarW]);
+        } else {
+          (reinterpret_cast<TProfile2D*>(entry.fHist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]]);
+        }
+        break;
+      case kFillTProfile3D:
+        if (hasWeight) {
+          (reinterpret_cast<TProfile3D*>(entry.fHist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]], values[vars[3]], values[entry.fVarW]);
+        } else {
+          (reinterpret_cast<TProfile3D*>(entry.fHist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]], values[vars[3]]);
+        }
+        break;
+      case kFillTHn:
+        for (int i = 0; i < entry.fDimension; ++i) {
+          fillValues[i] = values[vars[i]];
+        }
+        if (hasWeight) {
+          (reinterpret_cast<THnBase*>(entry.fHist))->Fill(fillValues, values[entry.fVarW]);
+        } else {
+          (reinterpret_cast<THnBase*>(entry.fHist))->Fill(fillValues);
+        }
+        break;
+      default:
+        break;
+    } // end switch
   }   // end loop over histograms
 }
 
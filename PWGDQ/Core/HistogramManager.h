@@ -24,8 +24,10 @@
 #include <TAxis.h>
 #include <TArrayD.h>
 
+#include <functional>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <list>
 
@@ -38,7 +40,8 @@ class HistogramManager : public TNamed
   ~HistogramManager() override;
 
   enum Constants {
-    kNothing = -1
+    kNothing = -1,
+    kMaxTHnDimensions = 20
   };
 
   void SetMainHistogramList(THashList* list)
@@ -85,6 +88,21 @@ class HistogramManager : public TNamed
                     TString* axLabels = nullptr, int varW = -1, bool useSparse = kFALSE, bool isdouble = false);
 
   void FillHistClass(const char* className, float* values);
+  // Fill a class of histograms using a handle obtained from GetHistClassHandle()
+  // No string lookup and no decoding of the variable list is done, which makes it the preferred option in loops over pairs or tracks
+  void FillHistClass(int handle, float* values);
+  // Get a handle to the pre-resolved fill plan of the histogram class <className>, or kNothing if the class does not exist
+  // The handles stay valid when histograms or classes are added afterwards; the fill plans are then rebuilt on the next call
+  int GetHistClassHandle(const char* className);
+
+  // Lazy allocation: if enabled, AddHistogram() only registers the histograms, which are created at the first fill of their class
+  // Classes which are never filled are then empty in the output, unless MaterializeHistograms() is called
+  void SetLazyAllocation(bool flag) { fLazyAllocation = flag; }
+  bool GetLazyAllocation() const { return fLazyAllocation; }
+  // Create all the registered histograms which were not created yet
+  void MaterializeHistograms();
+  // Log, per histogram class, the allocated bins and the bins still pending lazy allocation
+  void PrintMemoryUsage() const;
 
   void SetUseDefaultVariableNames(bool flag) { fUseDefaultVariableNames = flag; }
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -108,6 +126,39 @@ class HistogramManager : public TNamed
   TString* fVariableNames;          //! variable names
   TString* fVariableUnits;          //! variable units
 
+  // histogram types resolved in the fill plans
+  enum FillType {
+    kFillTH1 = 0,
+    kFillTH2,
+    kFillTH3,
+    kFillTProfile,
+    kFillTProfile2D,
+    kFillTProfile3D,
+    kFillTHn
+  };
+  // one histogram of a fill plan, with the indices of all the variables needed to fill it
+  struct FillPlanEntry {
+    TObject* fHist;               // histogram to be filled
+    int fType;                    // histogram type, see FillType
+    int fDimension;               // histogram dimension
+    int fVarW;                    // variable used for weighting, kNothing if not used
+    int fVars[kMaxTHnDimensions]; // variables on each axis (and the averaged variable for profiles)
+  };
+  std::vector<std::vector<FillPlanEntry>> fFillPlans;     //! fill plans, indexed by the histogram class handle
+  std::unordered_map<std::string, int> fHistClassHandles; //! map between histogram class names and handles
+  bool fFillPlansValid;                                   //! false if histograms were added since the fill plans were built
+
+  // lazy allocation
+  bool fLazyAllocation;                                                                          //! register histograms and create them at the first fill
+  std::map<std::string, std::vector<std::function<void(HistogramManager*)>>> fPendingHistograms; //! deferred histogram definitions, per class
+  std::map<std::string, uint64_t> fPendingBins;                                                  //! number of bins of the deferred histograms, per class
+  std::vector<std::string> fHistClassNames;                                                      //! histogram class names, indexed by handle
+  std::vector<bool> fHistClassPending;                                                           //! whether a class has deferred histograms, indexed by handle
+
+  void BuildFillPlans();
+  void DeferHistogram(const char* histClass, uint64_t nBins, std::function<void(HistogramManager*)> addHistogram);
+  void MaterializeHistClass(const std::string& histClass);
+
   void MakeAxisLabels(TAxis* ax, const char* labels);
 
   HistogramManager& operator=(const HistogramManager& c);
@@ -14,6 +14,40 @@
 #include "PWGDQ/Core/HistogramsLibrary.h"
 #include "VarManager.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include "Framework/Logger.h"
+
+namespace
+{
+std::unordered_map<std::string, o2::aod::dqhistograms::HistogramGroupFactory>& histogramGroupRegistry()
+{
+  static std::unordered_map<std::string, o2::aod::dqhistograms::HistogramGroupFactory> registry;
+  return registry;
+}
+} // namespace
+
+bool o2::aod::dqhistograms::RegisterHistogramGroup(const char* groupName, HistogramGroupFactory factory)
+{
+  TString groupStr = groupName;
+  groupStr.ToLower();
+  auto inserted = histogramGroupRegistry().emplace(groupStr.Data(), std::move(factory)).second;
+  if (!inserted) {
+    LOGF(warn, "Histogram group %s is already registered, keeping the first definition", groupName);
+  }
+  return inserted;
+}
+
+std::vector<std::string> o2::aod::dqhistograms::GetRegisteredHistogramGroups()
+{
+  std::vector<std::string> names;
+  for (const auto& entry : histogramGroupRegistry()) {
+    names.push_back(entry.first);
+  }
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
 void o2::aod::dqhistograms::DefineHistograms(HistogramManager* hm, const char* histClass, const char* groupName, const char* subGroupName)
 {
   //
@@ -27,6 +61,11 @@ void o2::aod::dqhistograms::DefineHistograms(HistogramManager* hm, const char* h
   groupStr.ToLower();
   TString subGroupStr = subGroupName;
   subGroupStr.ToLower();
+  const auto& registry = histogramGroupRegistry();
+  if (auto entry = registry.find(groupStr.Data()); entry != registry.end()) {
+    entry->second(hm, histClass, subGroupName);
+    return;
+  }
   if (!groupStr.CompareTo("event")) {
     if (!subGroupStr.Contains("generator")) {
       hm->AddHistogram(histClass, "VtxZ", "Vtx Z", false, 60, -15.0, 15.0, VarManager::kVtxZ);
@@ -16,6 +16,9 @@
 #define PWGDQ_CORE_HISTOGRAMSLIBRARY_H_
 
 #include <TString.h>
+#include <functional>
+#include <string>
+#include <vector>
 #include "PWGDQ/Core/HistogramManager.h"
 #include "PWGDQ/Core/VarManager.h"
 
@@ -24,7 +27,13 @@ namespace o2::aod
 namespace dqhistograms
 {
 void DefineHistograms(HistogramManager* hm, const char* histClass, const char* groupName, const char* subGroupName = "");
-}
+
+// Histogram groups registered by name are looked up in a hash map before the predefined groups of DefineHistograms()
+// The group name is matched case-insensitively, as for the predefined groups
+using HistogramGroupFactory = std::function<void(HistogramManager* hm, const char* histClass, const char* subGroupName)>;
+bool RegisterHistogramGroup(const char* groupName, HistogramGroupFactory factory);
+std::vector<std::string> GetRegisteredHistogramGroups();
+} // namespace dqhistograms
 } // namespace o2::aod
 
 #endif // PWGDQ_CORE_HISTOGRAMSLIBRARY_H_
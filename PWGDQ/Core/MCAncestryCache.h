@@ -0,0 +1,111 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+// Contact: iarsene@cern.ch, i.c.arsene@fys.uio.no
+//
+// Cache of the mother chains of MC particles, used to evaluate many MCSignal objects without walking the MC stack
+// again for every signal. For each particle, the PDG codes, global indices and source flags of the particle itself
+// (generation 0) and of its first mothers are stored in compact arrays, up to a configurable number of generations.
+// The ancestries are computed on demand; the cache must be reset whenever a new table of MC particles is processed
+// (e.g. for every dataframe), since the particles are identified by their global index.
+//
+
+#ifndef PWGDQ_CORE_MCANCESTRYCACHE_H_
+#define PWGDQ_CORE_MCANCESTRYCACHE_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class MCAncestryCache
+{
+ public:
+  enum SourceFlags {
+    kPhysicalPrimary = 0x1,
+    kProducedByGenerator = 0x2,
+    kFromBackgroundEvent = 0x4
+  };
+
+  explicit MCAncestryCache(int depth = 12) : fDepth(depth) {}
+
+  // Number of generations stored per particle, including the particle itself
+  void SetDepth(int depth)
+  {
+    fDepth = depth;
+    Reset();
+  }
+  int GetDepth() const { return fDepth; }
+  void Reset()
+  {
+    fSlots.clear();
+    fNGenerations.clear();
+    fPDG.clear();
+    fIndex.clear();
+    fFlags.clear();
+  }
+
+  // Compute, if not done yet, the ancestry of an MC particle and return its slot in the cache
+  template <typename T>
+  int Fill(const T& particle);
+
+  int GetNGenerations(int slot) const { return fNGenerations[slot]; } // number of valid generations, at least 1
+  int GetPDG(int slot, int generation) const { return fPDG[slot * fDepth + generation]; }
+  int64_t GetIndex(int slot, int generation) const { return fIndex[slot * fDepth + generation]; }
+  bool TestFlag(int slot, int generation, SourceFlags flag) const { return fFlags[slot * fDepth + generation] & flag; }
+  int GetNParticles() const { return fNGenerations.size(); }
+
+ private:
+  int fDepth;
+  std::unordered_map<int64_t, int> fSlots; // slot in the cache of each particle, by global index
+  std::vector<int> fNGenerations;          // number of valid generations of each slot
+  std::vector<int> fPDG;                   // PDG codes, slot x depth
+  std::vector<int64_t> fIndex;             // global indices, slot x depth
+  std::vector<uint8_t> fFlags;             // source flags, slot x depth
+};
+
+//________________________________________________________________________________________________
+template <typename T>
+int MCAncestryCache::Fill(const T& particle)
+{
+  using P = typename T::parent_t;
+  auto found = fSlots.find(particle.globalIndex());
+  if (found != fSlots.end()) {
+    return found->second;
+  }
+
+  int slot = fNGenerations.size();
+  fSlots[particle.globalIndex()] = slot;
+  fPDG.resize((slot + 1) * fDepth, 0);
+  fIndex.resize((slot + 1) * fDepth, -1);
+  fFlags.resize((slot + 1) * fDepth, 0);
+
+  // walk the chain of first mothers, as done in MCSignal::CheckProng()
+  int nGenerations = 0;
+  auto current = particle;
+  for (int j = 0; j < fDepth; j++) {
+    fPDG[slot * fDepth + j] = current.pdgCode();
+    fIndex[slot * fDepth + j] = current.globalIndex();
+    fFlags[slot * fDepth + j] = (current.isPhysicalPrimary() ? kPhysicalPrimary : 0) |
+                                (current.producedByGenerator() ? kProducedByGenerator : 0) |
+                                (current.fromBackgroundEvent() ? kFromBackgroundEvent : 0);
+    nGenerations++;
+    if (!current.has_mothers()) {
+      break;
+    }
+    if (j < fDepth - 1) {
+      current = current.template mothers_first_as<P>();
+    }
+  }
+  fNGenerations.push_back(nGenerations);
+  return slot;
+}
+
+#endif // PWGDQ_CORE_MCANCESTRYCACHE_H_
@@ -11,6 +11,8 @@
 
 #include "PWGDQ/Core/MCSignal.h"
 
+#include <algorithm>
+
 using std::cout;
 using std::endl;
 
@@ -63,6 +65,128 @@ void MCSignal::AddProng(MCProng prong, short commonAncestor)
   }
 }
 
+//________________________________________________________________________________________________
+bool MCSignal::IsCacheable() const
+{
+  for (auto& pr : fProngs) {
+    if (pr.fCheckGenerationsInTime) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//________________________________________________________________________________________________
+int MCSignal::GetAncestryDepth() const
+{
+  // the PDG in history check looks at up to 11 mothers, see CheckProng()
+  int depth = 0;
+  for (auto& pr : fProngs) {
+    depth = std::max(depth, pr.fNGenerations);
+    if (pr.fPDGInHistory.size() > 0) {
+      depth = std::max(depth, 12);
+    }
+  }
+  return depth;
+}
+
+//________________________________________________________________________________________________
+bool MCSignal::CheckProngCached(int i, bool checkSources, const MCAncestryCache& cache, int slot)
+{
+  //
+  // same logic as CheckProng() for prongs checked back in time, with the mother chain taken from the cache
+  //
+  const auto& prong = fProngs[i];
+  const int nAvailable = cache.GetNGenerations(slot);
+  if (prong.fNGenerations > nAvailable) {
+    // the mother chain is shorter than the number of generations required by the prong
+    return false;
+  }
+
+  // loop over the generations specified for this prong
+  for (int j = 0; j < prong.fNGenerations; j++) {
+    // check the PDG code
+    if (!prong.TestPDG(j, cache.GetPDG(slot, j))) {
+      return false;
+    }
+    // check the common ancestor (if specified)
+    if (fNProngs > 1 && fCommonAncestorIdxs[i] == j) {
+      if (i == 0) {
+        fTempAncestorLabel = static_cast<int>(cache.GetIndex(slot, j));
+      } else {
+        if (cache.GetIndex(slot, j) != fTempAncestorLabel) {
+          return false;
+        }
+      }
+    }
+  }
+
+  // check the various specified sources
+  if (checkSources) {
+    for (int j = 0; j < prong.fNGenerations; j++) {
+      // check whether sources are required for this generation
+      if (!prong.fSourceBits[j]) {
+        continue;
+      }
+      const bool isPhysicalPrimary = cache.TestFlag(slot, j, MCAncestryCache::kPhysicalPrimary);
+      const bool producedByGenerator = cache.TestFlag(slot, j, MCAncestryCache::kProducedByGenerator);
+      const bool fromBackgroundEvent = cache.TestFlag(slot, j, MCAncestryCache::kFromBackgroundEvent);
+      uint64_t sourcesDecision = 0;
+      if (prong.fSourceBits[j] & (uint64_t(1) << MCProng::kPhysicalPrimary)) {
+        if ((prong.fExcludeSource[j] & (uint64_t(1) << MCProng::kPhysicalPrimary)) != isPhysicalPrimary) {
+          sourcesDecision |= (uint64_t(1) << MCProng::kPhysicalPrimary);
+        }
+      }
+      if (prong.fSourceBits[j] & (uint64_t(1) << MCProng::kProducedInTransport)) {
+        if ((prong.fExcludeSource[j] & (uint64_t(1) << MCProng::kProducedInTransport)) != (!producedByGenerator)) {
+          sourcesDecision |= (uint64_t(1) << MCProng::kProducedInTransport);
+        }
+      }
+      if (prong.fSourceBits[j] & (uint64_t(1) << MCProng::kProducedByGenerator)) {
+        if ((prong.fExcludeSource[j] & (uint64_t(1) << MCProng::kProducedByGenerator)) != producedByGenerator) {
+          sourcesDecision |= (uint64_t(1) << MCProng::kProducedByGenerator);
+        }
+      }
+      if (prong.fSourceBits[j] & (uint64_t(1) << MCProng::kFromBackgroundEvent)) {
+        if ((prong.fExcludeSource[j] & (uint64_t(1) << MCProng::kFromBackgroundEvent)) != fromBackgroundEvent) {
+          sourcesDecision |= (uint64_t(1) << MCProng::kFromBackgroundEvent);
+        }
+      }
+      // no source bit is fulfilled
+      if (!sourcesDecision) {
+        return false;
+      }
+      // if fUseANDonSourceBitMap is on, request all bits
+      if (prong.fUseANDonSourceBitMap[j] && (sourcesDecision != prong.fSourceBits[j])) {
+        return false;
+      }
+    }
+  }
+
+  // check if the requested PDG codes are included in (or excluded from) the first 11 mothers
+  if (prong.fPDGInHistory.size() == 0) {
+    return true;
+  }
+  unsigned int nIncludedPDG = 0;
+  unsigned int nFoundPDG = 0;
+  for (unsigned int k = 0; k < prong.fPDGInHistory.size(); k++) {
+    if (!prong.fExcludePDGInHistory[k]) {
+      nIncludedPDG++;
+    }
+    for (int j = 1; j < nAvailable && j <= 11; j++) {
+      int motherPDG = cache.GetPDG(slot, j);
+      if (!prong.fExcludePDGInHistory[k] && prong.ComparePDG(motherPDG, prong.fPDGInHistory[k], true, prong.fExcludePDGInHistory[k])) {
+        nFoundPDG++;
+        break;
+      }
+      if (prong.fExcludePDGInHistory[k] && !prong.ComparePDG(motherPDG, prong.fPDGInHistory[k], true, prong.fExcludePDGInHistory[k])) {
+        return false;
+      }
+    }
+  }
+  return (nFoundPDG == nIncludedPDG);
+}
+
 //________________________________________________________________________________________________
 void MCSignal::PrintConfig()
 {
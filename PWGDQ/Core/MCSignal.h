@@ -57,6 +57,7 @@ process(aod::McParticles const& mcTracks) {
 #define PWGDQ_CORE_MCSIGNAL_H_
 
 #include "MCProng.h"
+#include "MCAncestryCache.h"
 #include "TNamed.h"
 
 #include <vector>
@@ -94,6 +95,28 @@ class MCSignal : public TNamed
     return CheckMC(0, checkSources, args...);
   };
 
+  // Signals with all the prongs checked back in time (towards mothers) can be evaluated from an MCAncestryCache
+  bool IsCacheable() const;
+  // Number of generations needed in an MCAncestryCache to evaluate this signal
+  int GetAncestryDepth() const;
+
+  // Same as CheckSignal(), using (and filling) the ancestry cache; falls back to CheckSignal() if the signal is not cacheable
+  template <typename... T>
+  bool CheckSignalCached(bool checkSources, MCAncestryCache& cache, const T&... args)
+  {
+    if (sizeof...(args) != fNProngs) {
+      return false;
+    }
+    if (!IsCacheable() || cache.GetDepth() < GetAncestryDepth()) {
+      return CheckMC(0, checkSources, args...);
+    }
+    return CheckMCCached(0, checkSources, cache, args...);
+  };
+
+  // Decisions of all the single-prong signals for one MC particle, bit i being set if signals[i] is matched
+  template <typename T>
+  static uint64_t GetSignalMask(std::vector<MCSignal>& signals, bool checkSources, MCAncestryCache& cache, const T& particle);
+
   void PrintConfig();
 
  private:
@@ -104,6 +127,7 @@ class MCSignal : public TNamed
 
   template <typename T>
   bool CheckProng(int i, bool checkSources, const T& track);
+  bool CheckProngCached(int i, bool checkSources, const MCAncestryCache& cache, int slot);
 
   bool CheckMC(int, bool)
   {
@@ -120,8 +144,47 @@ class MCSignal : public TNamed
       return CheckMC(i + 1, checkSources, args...);
     }
   };
+
+  bool CheckMCCached(int, bool, MCAncestryCache&)
+  {
+    return true;
+  };
+
+  template <typename T, typename... Ts>
+  bool CheckMCCached(int i, bool checkSources, MCAncestryCache& cache, const T& track, const Ts&... args)
+  {
+    // recursive call of CheckMCCached for all args
+    if (!CheckProngCached(i, checkSources, cache, cache.Fill(track))) {
+      return false;
+    } else {
+      return CheckMCCached(i + 1, checkSources, cache, args...);
+    }
+  };
 };
 
+template <typename T>
+uint64_t MCSignal::GetSignalMask(std::vector<MCSignal>& signals, bool checkSources, MCAncestryCache& cache, const T& particle)
+{
+  uint64_t mask = 0;
+  int slot = cache.Fill(particle);
+  for (std::size_t isig = 0; isig < signals.size() && isig < 64; isig++) {
+    auto& sig = signals[isig];
+    if (sig.GetNProngs() != 1) {
+      continue;
+    }
+    bool decision = false;
+    if (sig.IsCacheable() && cache.GetDepth() >= sig.GetAncestryDepth()) {
+      decision = sig.CheckProngCached(0, checkSources, cache, slot);
+    } else {
+      decision = sig.CheckSignal(checkSources, particle);
+    }
+    if (decision) {
+      mask |= (uint64_t(1) << isig);
+    }
+  }
+  return mask;
+}
+
 template <typename T>
 bool MCSignal::CheckProng(int i, bool checkSources, const T& track)
 {
@@ -104,6 +104,22 @@ std::vector<float> MixingHandler::GetMixingVariableLimits(VarManager::Variables
   return binLimits;
 }
 
+//_________________________________________________________________________
+int MixingHandler::GetNCategories() const
+{
+  //
+  // number of event categories, 0 if no mixing variable was added
+  //
+  if (fVariables.size() == 0) {
+    return 0;
+  }
+  int size = 1;
+  for (auto& v : fVariableLimits) {
+    size *= (v.GetSize() - 1);
+  }
+  return size;
+}
+
 //_________________________________________________________________________
 void MixingHandler::Init()
 {
@@ -42,6 +42,7 @@ class MixingHandler : public TNamed
   // getters
   int GetNMixingVariables() const { return fVariables.size(); }
   int GetMixingVariable(VarManager::Variables var); // returns the position in the internal varible list of the handler. Useful for checks, mostly
+  int GetNCategories() const;                       // number of event categories returned by FindEventCategory()
   std::vector<float> GetMixingVariableLimits(VarManager::Variables var);
 
   void Init();
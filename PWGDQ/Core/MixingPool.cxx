@@ -0,0 +1,174 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "PWGDQ/Core/MixingPool.h"
+#include "Framework/Logger.h"
+
+#include <algorithm>
+
+//_________________________________________________________________________
+MixingPool::MixingPool(int nCategories, int depth, int maxTracksPerEvent)
+{
+  //
+  // constructor
+  //
+  Init(nCategories, depth, maxTracksPerEvent);
+}
+
+//_________________________________________________________________________
+void MixingPool::Init(int nCategories, int depth, int maxTracksPerEvent)
+{
+  //
+  // set the pool dimensions; the per-category buffers are allocated when the category is first used
+  //
+  if (nCategories <= 0 || depth <= 0 || maxTracksPerEvent <= 0) {
+    LOG(fatal) << "MixingPool::Init(): invalid pool dimensions, categories " << nCategories << ", depth " << depth << ", max tracks " << maxTracksPerEvent;
+  }
+  fPools.clear();
+  fPools.resize(nCategories);
+  fDepth = depth;
+  fMaxTracks = maxTracksPerEvent;
+  fCurrentCategory = -1;
+  fCurrentSlot = -1;
+  fNDroppedTracks = 0;
+}
+
+//_________________________________________________________________________
+void MixingPool::Clear()
+{
+  //
+  // remove all the stored events, keeping the allocated buffers
+  //
+  for (auto& pool : fPools) {
+    pool.fNext = 0;
+    pool.fNEvents = 0;
+  }
+  fCurrentCategory = -1;
+  fCurrentSlot = -1;
+}
+
+//_________________________________________________________________________
+void MixingPool::Allocate(CategoryPool& pool)
+{
+  //
+  // allocate the ring buffer of a category: the pool depth plus one slot for the current event
+  //
+  const std::size_t nSlots = fDepth + 1;
+  const std::size_t nTracks = nSlots * fMaxTracks;
+  pool.fEventIndex.assign(nSlots, 0);
+  pool.fNTracks.assign(nSlots, 0);
+  pool.fEventValues.assign(nSlots * fEventVars.size(), 0.0f);
+  pool.fPt.assign(nTracks, 0.0f);
+  pool.fEta.assign(nTracks, 0.0f);
+  pool.fPhi.assign(nTracks, 0.0f);
+  pool.fSign.assign(nTracks, 0);
+  pool.fFilterMap.assign(nTracks, 0);
+  pool.fFwdDcaX.assign(nTracks, 0.0f);
+  pool.fFwdDcaY.assign(nTracks, 0.0f);
+}
+
+//_________________________________________________________________________
+void MixingPool::StartEvent(int category, uint64_t globalIndex, const float* values)
+{
+  //
+  // start filling a new current event; a current event which was not finished is discarded
+  //
+  if (category < 0 || category >= static_cast<int>(fPools.size())) {
+    fCurrentCategory = -1;
+    fCurrentSlot = -1;
+    return;
+  }
+  auto& pool = fPools[category];
+  if (pool.fNTracks.empty()) {
+    Allocate(pool);
+  }
+  fCurrentCategory = category;
+  fCurrentSlot = pool.fNext;
+  pool.fEventIndex[fCurrentSlot] = globalIndex;
+  pool.fNTracks[fCurrentSlot] = 0;
+  const int nEventVars = fEventVars.size();
+  for (int i = 0; i < nEventVars; ++i) {
+    pool.fEventValues[fCurrentSlot * nEventVars + i] = (values ? values[fEventVars[i]] : 0.0f);
+  }
+}
+
+//_________________________________________________________________________
+bool MixingPool::AddTrack(float pt, float eta, float phi, int sign, uint32_t filterMap, float fwdDcaX, float fwdDcaY)
+{
+  //
+  // add a track to the current event; returns false if there is no current event or it is full
+  //
+  if (fCurrentCategory < 0) {
+    return false;
+  }
+  auto& pool = fPools[fCurrentCategory];
+  int& nTracks = pool.fNTracks[fCurrentSlot];
+  if (nTracks >= fMaxTracks) {
+    ++fNDroppedTracks;
+    return false;
+  }
+  const int index = fCurrentSlot * fMaxTracks + nTracks;
+  pool.fPt[index] = pt;
+  pool.fEta[index] = eta;
+  pool.fPhi[index] = phi;
+  pool.fSign[index] = sign;
+  pool.fFilterMap[index] = filterMap;
+  pool.fFwdDcaX[index] = fwdDcaX;
+  pool.fFwdDcaY[index] = fwdDcaY;
+  ++nTracks;
+  return true;
+}
+
+//_________________________________________________________________________
+void MixingPool::FinishEvent()
+{
+  //
+  // move the current event into the pool of its category; the slot of the oldest event becomes the next free one
+  //
+  if (fCurrentCategory < 0) {
+    return;
+  }
+  auto& pool = fPools[fCurrentCategory];
+  pool.fNext = (pool.fNext + 1) % (fDepth + 1);
+  pool.fNEvents = std::min(pool.fNEvents + 1, fDepth);
+  fCurrentCategory = -1;
+  fCurrentSlot = -1;
+}
+
+//_________________________________________________________________________
+MixingPool::Event MixingPool::GetEvent(int category, int i) const
+{
+  //
+  // the stored events precede the next free slot in the ring buffer
+  //
+  const auto& pool = fPools[category];
+  const int nSlots = fDepth + 1;
+  const int slot = ((pool.fNext - 1 - i) % nSlots + nSlots) % nSlots;
+  return Event(&pool, slot, fMaxTracks, fEventVars.size());
+}
+
+//_________________________________________________________________________
+MixingPool::Event MixingPool::GetCurrentEvent() const
+{
+  return Event(&fPools[std::max(fCurrentCategory, 0)], std::max(fCurrentSlot, 0), fMaxTracks, fEventVars.size());
+}
+
+//_________________________________________________________________________
+std::size_t MixingPool::GetMemorySize() const
+{
+  std::size_t size = 0;
+  for (const auto& pool : fPools) {
+    size += pool.fEventIndex.capacity() * sizeof(uint64_t) + pool.fNTracks.capacity() * sizeof(int) + pool.fEventValues.capacity() * sizeof(float);
+    size += (pool.fPt.capacity() + pool.fEta.capacity() + pool.fPhi.capacity() + pool.fFwdDcaX.capacity() + pool.fFwdDcaY.capacity()) * sizeof(float);
+    size += pool.fSign.capacity() * sizeof(int8_t) + pool.fFilterMap.capacity() * sizeof(uint32_t);
+  }
+  return size;
+}
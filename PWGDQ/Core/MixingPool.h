@@ -0,0 +1,156 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+// Contact: iarsene@cern.ch, i.c.arsene@fys.uio.no
+//
+// Event mixing pool keyed on the MixingHandler event category
+// Each category holds a ring buffer of the last N events, with compact column (SoA) copies of the track / muon
+// quantities needed for pairing. The memory is fixed by the number of categories, the pool depth and the maximum
+// number of tracks per event, independently of the dataframe size. Since the pool is not tied to a dataframe, events
+// from previous dataframes are mixed as well.
+//
+// Typical usage, per event:
+//   pool.StartEvent(category, event.globalIndex(), VarManager::fgValues);
+//   for (auto& track : tracks) { pool.AddTrack(track.pt(), track.eta(), track.phi(), track.sign(), filterMap); }
+//   pool.ForEachMixedPair([&](const MixingPool::Track& t1, const MixingPool::Track& t2, const MixingPool::Event& ev2) {
+//     VarManager::FillPairME<VarManager::kDecayToEE>(t1, t2);
+//   });
+//   pool.FinishEvent();
+//
+
+#ifndef PWGDQ_CORE_MIXINGPOOL_H_
+#define PWGDQ_CORE_MIXINGPOOL_H_
+
+#include <cstdint>
+#include <vector>
+
+class MixingPool
+{
+ private:
+  struct CategoryPool {
+    int fNext = 0;    // slot to be filled by the next event
+    int fNEvents = 0; // number of events available for mixing
+    std::vector<uint64_t> fEventIndex;
+    std::vector<int> fNTracks;
+    std::vector<float> fEventValues; // slot x event variables
+    std::vector<float> fPt;          // slot x max tracks, same for all the track columns
+    std::vector<float> fEta;
+    std::vector<float> fPhi;
+    std::vector<int8_t> fSign;
+    std::vector<uint32_t> fFilterMap;
+    std::vector<float> fFwdDcaX;
+    std::vector<float> fFwdDcaY;
+  };
+
+ public:
+  // Track proxy with the accessors used by the VarManager::FillPairME() functions
+  class Track
+  {
+   public:
+    Track(const CategoryPool* pool, int index) : fPool(pool), fIndex(index) {}
+    float pt() const { return fPool->fPt[fIndex]; }
+    float eta() const { return fPool->fEta[fIndex]; }
+    float phi() const { return fPool->fPhi[fIndex]; }
+    int sign() const { return fPool->fSign[fIndex]; }
+    uint32_t filterMap() const { return fPool->fFilterMap[fIndex]; }
+    float fwdDcaX() const { return fPool->fFwdDcaX[fIndex]; }
+    float fwdDcaY() const { return fPool->fFwdDcaY[fIndex]; }
+
+   private:
+    const CategoryPool* fPool;
+    int fIndex;
+  };
+
+  // One stored (or the current) event
+  class Event
+  {
+   public:
+    Event(const CategoryPool* pool, int slot, int maxTracks, int nEventVars) : fPool(pool), fSlot(slot), fMaxTracks(maxTracks), fNEventVars(nEventVars) {}
+    uint64_t GetGlobalIndex() const { return fPool->fEventIndex[fSlot]; }
+    int GetNTracks() const { return fPool->fNTracks[fSlot]; }
+    Track GetTrack(int i) const { return Track(fPool, fSlot * fMaxTracks + i); }
+    // value of the i-th event variable given in SetEventVariables()
+    float GetValue(int i) const { return fPool->fEventValues[fSlot * fNEventVars + i]; }
+
+   private:
+    const CategoryPool* fPool;
+    int fSlot;
+    int fMaxTracks;
+    int fNEventVars;
+  };
+
+  MixingPool() = default;
+  MixingPool(int nCategories, int depth, int maxTracksPerEvent);
+  ~MixingPool() = default;
+
+  // setters
+  void Init(int nCategories, int depth, int maxTracksPerEvent);
+  // VarManager variables stored for each event, e.g. the Q-vector components used in FillPairME()
+  void SetEventVariables(const std::vector<int>& vars) { fEventVars = vars; }
+  void Clear();
+
+  // filling
+  // The current event is kept apart from the events it is mixed with. FinishEvent() moves it into the pool of its
+  // category, replacing the oldest event once the pool depth is reached
+  void StartEvent(int category, uint64_t globalIndex, const float* values = nullptr);
+  bool AddTrack(float pt, float eta, float phi, int sign, uint32_t filterMap, float fwdDcaX = 0.0f, float fwdDcaY = 0.0f);
+  void FinishEvent();
+
+  // getters
+  int GetNCategories() const { return fPools.size(); }
+  int GetDepth() const { return fDepth; }
+  int GetMaxTracksPerEvent() const { return fMaxTracks; }
+  int GetNEvents(int category) const { return (category < 0 || category >= static_cast<int>(fPools.size())) ? 0 : fPools[category].fNEvents; }
+  // i-th stored event of a category, 0 being the most recent one
+  Event GetEvent(int category, int i) const;
+  Event GetCurrentEvent() const;
+  uint64_t GetNDroppedTracks() const { return fNDroppedTracks; }
+  std::size_t GetMemorySize() const; // bytes allocated by the pools
+
+  // Call f(track1, track2, event2) for each pair of a track in the current event with a track of the stored events of
+  // its category; track2 belongs to the stored event2
+  template <typename F>
+  void ForEachMixedPair(F&& f) const;
+
+ private:
+  void Allocate(CategoryPool& pool);
+
+  std::vector<CategoryPool> fPools; // pools of all categories, allocated when first used
+  std::vector<int> fEventVars;      // VarManager variables stored per event
+  int fDepth = 0;                   // number of events mixed with the current one
+  int fMaxTracks = 0;               // maximum number of tracks stored per event
+  int fCurrentCategory = -1;        // category of the current event, -1 if none
+  int fCurrentSlot = -1;            // slot of the current event in its category pool
+  uint64_t fNDroppedTracks = 0;     // tracks not stored since above the maximum number of tracks per event
+};
+
+//_________________________________________________________________________
+template <typename F>
+void MixingPool::ForEachMixedPair(F&& f) const
+{
+  if (fCurrentCategory < 0) {
+    return;
+  }
+  const auto& pool = fPools[fCurrentCategory];
+  const int nTracks1 = pool.fNTracks[fCurrentSlot];
+  for (int iEvent = 0; iEvent < pool.fNEvents; ++iEvent) {
+    Event event2 = GetEvent(fCurrentCategory, iEvent);
+    const int nTracks2 = event2.GetNTracks();
+    for (int i1 = 0; i1 < nTracks1; ++i1) {
+      Track t1(&pool, fCurrentSlot * fMaxTracks + i1);
+      for (int i2 = 0; i2 < nTracks2; ++i2) {
+        f(t1, event2.GetTrack(i2), event2);
+      }
+    }
+  }
+}
+
+#endif // PWGDQ_CORE_MIXINGPOOL_H_
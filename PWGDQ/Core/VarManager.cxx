@@ -21,9 +21,10 @@ ClassImp(VarManager);
 TString VarManager::fgVariableNames[VarManager::kNVars] = {""};
 TString VarManager::fgVariableUnits[VarManager::kNVars] = {""};
 bool VarManager::fgUsedVars[VarManager::kNVars] = {false};
-bool VarManager::fgUsedKF = false;
-float VarManager::fgMagField = 0.5;
+uint32_t VarManager::fgUsedVarGroups = ~uint32_t(0); // all groups are evaluated until the used variables are provided
+uint32_t VarManager::fgRequestedVarGroups = 0;
 float VarManager::fgValues[VarManager::kNVars] = {0.0f};
+VarManager::VarContext VarManager::fgDefaultContext{VarManager::fgValues};
 std::map<int, int> VarManager::fgRunMap;
 TString VarManager::fgRunStr = "";
 std::vector<int> VarManager::fgRunList = {0};
@@ -34,10 +35,6 @@ int VarManager::fgITSROFbias = 0;
 int VarManager::fgITSROFlength = 100;
 int VarManager::fgITSROFBorderMarginLow = 0;
 int VarManager::fgITSROFBorderMarginHigh = 0;
-o2::vertexing::DCAFitterN<2> VarManager::fgFitterTwoProngBarrel;
-o2::vertexing::DCAFitterN<3> VarManager::fgFitterThreeProngBarrel;
-o2::vertexing::FwdDCAFitterN<2> VarManager::fgFitterTwoProngFwd;
-o2::vertexing::FwdDCAFitterN<3> VarManager::fgFitterThreeProngFwd;
 o2::globaltracking::MatchGlobalFwd VarManager::mMatching;
 std::map<VarManager::CalibObjects, TObject*> VarManager::fgCalibs;
 bool VarManager::fgRunTPCPostCalibration[4] = {false, false, false, false};
@@ -88,6 +85,26 @@ void VarManager::SetVariableDependencies()
   if (fgUsedVars[kTrackIsInsideTPCModule]) {
     fgUsedVars[kPhiTPCOuter] = true;
   }
+
+  // Variable groups to be evaluated, i.e. those with at least one used variable
+  fgUsedVarGroups = fgRequestedVarGroups;
+  if (fgUsedVars[kCosThetaHE] || fgUsedVars[kPhiHE] || fgUsedVars[kCosThetaCS] || fgUsedVars[kPhiCS]) {
+    fgUsedVarGroups |= (uint32_t(1) << kVarGroupPairPolarization);
+  }
+  std::vector<int> vertexingVars = {kUsedKF, kKFMass, kKFMassGeoTop, kCosPointingAngle,
+                                    kPt1, kEta1, kPhi1, kPt2, kEta2, kPhi2}; // the daughter kinematics are refitted for the muon pairs
+  for (int var = kVertexingLxy; var <= kVertexingChi2PCA; ++var) {
+    vertexingVars.push_back(var);
+  }
+  for (int var = kVertexingLxyOverErr; var <= kKFPairDeviationxyFromPV; ++var) {
+    vertexingVars.push_back(var);
+  }
+  for (auto& var : vertexingVars) {
+    if (fgUsedVars[var]) {
+      fgUsedVarGroups |= (uint32_t(1) << kVarGroupPairVertexing);
+      break;
+    }
+  }
 }
 
 //__________________________________________________________________
@@ -97,7 +114,7 @@ void VarManager::ResetValues(int startValue, int endValue, float* values)
   // reset all variables to an "innocent" value
   // NOTE: here we use -9999.0 as a neutral value, but depending on situation, this may not be the case
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
   for (Int_t i = startValue; i < endValue; ++i) {
     values[i] = -9999.;
@@ -25,10 +25,12 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <cmath>
 #include <iostream>
 #include <utility>
 #include <complex>
+#include <memory>
 
 #include <TObject.h>
 #include <TString.h>
@@ -703,6 +705,67 @@ class VarManager : public TObject
     kToRabs
   };
 
+  // Groups of variables computed together in the Fill* functions
+  // A group is evaluated only if at least one of its variables is used, or if it was requested explicitly with SetUseVarGroup()
+  enum VarGroups {
+    kVarGroupPairPolarization = 0, // helicity and Collins-Soper frame angles, computed in FillPair()
+    kVarGroupPairVertexing,        // secondary vertex quantities from the DCA fitter or KFParticle, computed in FillPairVertexing()
+    kNVarGroups
+  };
+
+  // Instance-scoped state of the Fill* functions: values array, vertexing fitters and run-dependent settings
+  // The static API works on the context attached to the calling thread (see SetContext()), by default the global one filling fgValues
+  // Muons of one collision propagated once to the vertex, DCA and absorber end reference planes, see PropagateMuons()
+  struct PropagatedMuons {
+    int64_t fCollision = -1;                                // global index of the collision used for the propagation
+    std::unordered_map<int64_t, int> fSlots;                // slot of each propagated muon, by global index
+    std::vector<o2::dataformats::GlobalFwdTrack> fAtVertex; // muons propagated to the primary vertex
+    std::vector<float> fDCAx;                               // DCA in x from the propagation to the DCA plane
+    std::vector<float> fDCAy;                               // DCA in y from the propagation to the DCA plane
+    std::vector<float> fRAtAbsorberEnd;                     // radius at the absorber end, only for tracks with MCH
+    void Clear()
+    {
+      fCollision = -1;
+      fSlots.clear();
+      fAtVertex.clear();
+      fDCAx.clear();
+      fDCAy.clear();
+      fRAtAbsorberEnd.clear();
+    }
+  };
+
+  struct VarContext {
+    VarContext() : fOwnedValues(new float[kNVars]())
+    {
+      fValues = fOwnedValues.get();
+    }
+    explicit VarContext(float* values) : fValues(values) {}
+
+    float* fValues = nullptr;                             // values filled when no array is passed to the Fill* functions
+    float fMagField = 0.5;                                // magnetic field
+    bool fUsedKF = false;                                 // use KFParticle instead of the DCA fitters for the secondary vertexing
+    o2::vertexing::DCAFitterN<2> fFitterTwoProngBarrel;   // 2-prong DCA fitter for the barrel tracks
+    o2::vertexing::DCAFitterN<3> fFitterThreeProngBarrel; // 3-prong DCA fitter for the barrel tracks
+    o2::vertexing::FwdDCAFitterN<2> fFitterTwoProngFwd;   // 2-prong DCA fitter for the forward tracks
+    o2::vertexing::FwdDCAFitterN<3> fFitterThreeProngFwd; // 3-prong DCA fitter for the forward tracks
+    PropagatedMuons fPropagatedMuons;                     // muon propagation results of the current collision
+
+   private:
+    std::unique_ptr<float[]> fOwnedValues; // values array owned by the context, if not external
+  };
+
+  // Attach a context to the calling thread, e.g. one per pipelined task instance; nullptr restores the default context
+  // NOTE: KFParticle::SetField() is global to the KFParticle library and is not part of the context
+  static void SetContext(VarContext* context)
+  {
+    CurrentContext() = context;
+  }
+  static VarContext& Context()
+  {
+    VarContext* context = CurrentContext();
+    return context ? *context : fgDefaultContext;
+  }
+
   static TString fgVariableNames[kNVars]; // variable names
   static TString fgVariableUnits[kNVars]; // variable units
   static void SetDefaultVarNames();
@@ -728,6 +791,19 @@ class VarManager : public TObject
     for (auto& var : usedVars) {
       fgUsedVars[var] = true;
     }
+    SetVariableDependencies();
+  }
+  // Request the evaluation of a group of variables independently of the used variables, e.g. when they are written to tables
+  static void SetUseVarGroup(int group)
+  {
+    if (group >= 0 && group < kNVarGroups) {
+      fgRequestedVarGroups |= (uint32_t(1) << group);
+      fgUsedVarGroups |= (uint32_t(1) << group);
+    }
+  }
+  static bool IsVarGroupUsed(int group)
+  {
+    return (fgUsedVarGroups & (uint32_t(1) << group)) > 0;
   }
   static bool GetUsedVar(int var)
   {
@@ -765,14 +841,14 @@ class VarManager : public TObject
 
   static void SetMagneticField(float magField)
   {
-    fgMagField = magField;
+    Context().fMagField = magField;
   }
 
   // Setup the 2 prong KFParticle
   static void SetupTwoProngKFParticle(float magField)
   {
     KFParticle::SetField(magField);
-    fgUsedKF = true;
+    Context().fUsedKF = true;
   }
   // Setup magnetic field for muon propagation
   static void SetupMuonMagField()
@@ -783,61 +859,61 @@ class VarManager : public TObject
   // Setup the 2 prong DCAFitterN
   static void SetupTwoProngDCAFitter(float magField, bool propagateToPCA, float maxR, float maxDZIni, float minParamChange, float minRelChi2Change, bool useAbsDCA)
   {
-    fgFitterTwoProngBarrel.setBz(magField);
-    fgFitterTwoProngBarrel.setPropagateToPCA(propagateToPCA);
-    fgFitterTwoProngBarrel.setMaxR(maxR);
-    fgFitterTwoProngBarrel.setMaxDZIni(maxDZIni);
-    fgFitterTwoProngBarrel.setMinParamChange(minParamChange);
-    fgFitterTwoProngBarrel.setMinRelChi2Change(minRelChi2Change);
-    fgFitterTwoProngBarrel.setUseAbsDCA(useAbsDCA);
-    fgUsedKF = false;
+    Context().fFitterTwoProngBarrel.setBz(magField);
+    Context().fFitterTwoProngBarrel.setPropagateToPCA(propagateToPCA);
+    Context().fFitterTwoProngBarrel.setMaxR(maxR);
+    Context().fFitterTwoProngBarrel.setMaxDZIni(maxDZIni);
+    Context().fFitterTwoProngBarrel.setMinParamChange(minParamChange);
+    Context().fFitterTwoProngBarrel.setMinRelChi2Change(minRelChi2Change);
+    Context().fFitterTwoProngBarrel.setUseAbsDCA(useAbsDCA);
+    Context().fUsedKF = false;
   }
 
   // Setup the 2 prong FwdDCAFitterN
   static void SetupTwoProngFwdDCAFitter(float magField, bool propagateToPCA, float maxR, float minParamChange, float minRelChi2Change, bool useAbsDCA)
   {
-    fgFitterTwoProngFwd.setBz(magField);
-    fgFitterTwoProngFwd.setPropagateToPCA(propagateToPCA);
-    fgFitterTwoProngFwd.setMaxR(maxR);
-    fgFitterTwoProngFwd.setMinParamChange(minParamChange);
-    fgFitterTwoProngFwd.setMinRelChi2Change(minRelChi2Change);
-    fgFitterTwoProngFwd.setUseAbsDCA(useAbsDCA);
-    fgUsedKF = false;
+    Context().fFitterTwoProngFwd.setBz(magField);
+    Context().fFitterTwoProngFwd.setPropagateToPCA(propagateToPCA);
+    Context().fFitterTwoProngFwd.setMaxR(maxR);
+    Context().fFitterTwoProngFwd.setMinParamChange(minParamChange);
+    Context().fFitterTwoProngFwd.setMinRelChi2Change(minRelChi2Change);
+    Context().fFitterTwoProngFwd.setUseAbsDCA(useAbsDCA);
+    Context().fUsedKF = false;
   }
   // Use MatLayerCylSet to correct MCS in fwdtrack propagation
   static void SetupMatLUTFwdDCAFitter(o2::base::MatLayerCylSet* m)
   {
-    fgFitterTwoProngFwd.setTGeoMat(false);
-    fgFitterTwoProngFwd.setMatLUT(m);
+    Context().fFitterTwoProngFwd.setTGeoMat(false);
+    Context().fFitterTwoProngFwd.setMatLUT(m);
   }
   // Use GeometryManager to correct MCS in fwdtrack propagation
   static void SetupTGeoFwdDCAFitter()
   {
-    fgFitterTwoProngFwd.setTGeoMat(true);
+    Context().fFitterTwoProngFwd.setTGeoMat(true);
   }
   // No material budget in fwdtrack propagation
   static void SetupFwdDCAFitterNoCorr()
   {
-    fgFitterTwoProngFwd.setTGeoMat(false);
+    Context().fFitterTwoProngFwd.setTGeoMat(false);
   }
   // Setup the 3 prong KFParticle
   static void SetupThreeProngKFParticle(float magField)
   {
     KFParticle::SetField(magField);
-    fgUsedKF = true;
+    Context().fUsedKF = true;
   }
 
   // Setup the 3 prong DCAFitterN
   static void SetupThreeProngDCAFitter(float magField, bool propagateToPCA, float maxR, float /*maxDZIni*/, float minParamChange, float minRelChi2Change, bool useAbsDCA)
   {
-    fgFitterThreeProngBarrel.setBz(magField);
-    fgFitterThreeProngBarrel.setPropagateToPCA(propagateToPCA);
-    fgFitterThreeProngBarrel.setMaxR(maxR);
-    fgFitterThreeProngBarrel.setMinParamChange(minParamChange);
-    fgFitterThreeProngBarrel.setMinRelChi2Change(minRelChi2Change);
-    fgFitterThreeProngBarrel.setUseAbsDCA(useAbsDCA);
-    cout << "!!! fgFitterThreeProngBarrel bz = " << fgFitterThreeProngBarrel.getBz() << endl;
-    fgUsedKF = false;
+    Context().fFitterThreeProngBarrel.setBz(magField);
+    Context().fFitterThreeProngBarrel.setPropagateToPCA(propagateToPCA);
+    Context().fFitterThreeProngBarrel.setMaxR(maxR);
+    Context().fFitterThreeProngBarrel.setMinParamChange(minParamChange);
+    Context().fFitterThreeProngBarrel.setMinRelChi2Change(minRelChi2Change);
+    Context().fFitterThreeProngBarrel.setUseAbsDCA(useAbsDCA);
+    cout << "!!! fFitterThreeProngBarrel bz = " << Context().fFitterThreeProngBarrel.getBz() << endl;
+    Context().fUsedKF = false;
   }
 
   static auto getEventPlane(int harm, float qnxa, float qnya)
@@ -861,6 +937,26 @@ class VarManager : public TObject
 
   template <typename T, typename C>
   static o2::dataformats::GlobalFwdTrack PropagateMuon(const T& muon, const C& collision, int endPoint = kToVertex);
+  // Propagate all the muons of a collision once and keep the results in the context; FillPropagateMuon(), FillMuonPDca(),
+  // FillTrackCollision() and FillPairPropagateMuon() then use them instead of propagating again
+  // PropagateMuons() replaces previous results, while AddPropagatedMuon() adds one muon to the results of the same collision
+  // NOTE: the muons are identified by global index, so the results must be cleared before moving to another dataframe
+  template <typename TMuons, typename C>
+  static void PropagateMuons(const TMuons& muons, const C& collision);
+  template <typename T, typename C>
+  static void AddPropagatedMuon(const T& muon, const C& collision);
+  static void ClearPropagatedMuons() { Context().fPropagatedMuons.Clear(); }
+  // Slot of a muon in the propagation results, -1 if it was not propagated for this collision
+  template <typename T, typename C>
+  static int FindPropagatedMuon(const T& muon, const C& collision)
+  {
+    const auto& propagated = Context().fPropagatedMuons;
+    if (propagated.fCollision != static_cast<int64_t>(collision.globalIndex())) {
+      return -1;
+    }
+    auto slot = propagated.fSlots.find(muon.globalIndex());
+    return (slot == propagated.fSlots.end() ? -1 : slot->second);
+  }
   template <uint32_t fillMap, typename T, typename C>
   static void FillMuonPDca(const T& muon, const C& collision, float* values = nullptr);
   template <uint32_t fillMap, typename T, typename C>
@@ -891,6 +987,8 @@ class VarManager : public TObject
   static void FillTriple(T1 const& t1, T2 const& t2, T3 const& t3, float* values = nullptr, PairCandidateType pairType = kTripleCandidateToEEPhoton);
   template <int pairType, typename T1, typename T2>
   static void FillPairME(T1 const& t1, T2 const& t2, float* values = nullptr);
+  template <int pairType, typename T1, typename T2>
+  static void ComputePairMassPt(T1 const& t1, T2 const& t2, float& mass, float& pt);
   template <typename T1, typename T2>
   static void FillPairMC(T1 const& t1, T2 const& t2, float* values = nullptr, PairCandidateType pairType = kDecayToEE);
   template <typename T1, typename T2, typename T3>
@@ -971,10 +1069,17 @@ class VarManager : public TObject
 
  private:
   static bool fgUsedVars[kNVars]; // holds flags for when the corresponding variable is needed (e.g., in the histogram manager, in cuts, mixing handler, etc.)
-  static bool fgUsedKF;
-  static void SetVariableDependencies(); // toggle those variables on which other used variables might depend
+  static uint32_t fgUsedVarGroups;       // bit map of the variable groups to be evaluated, see VarGroups
+  static uint32_t fgRequestedVarGroups;  // bit map of the variable groups requested explicitly with SetUseVarGroup()
+  static void SetVariableDependencies(); // toggle those variables on which other used variables might depend, and the variable groups to be evaluated
+
+  static VarContext fgDefaultContext; // default context, filling fgValues
+  static VarContext*& CurrentContext()
+  {
+    thread_local VarContext* context = nullptr;
+    return context;
+  }
 
-  static float fgMagField;
   static std::map<int, int> fgRunMap;     // map of runs to be used in histogram axes
   static TString fgRunStr;                // semi-colon separated list of runs, to be used for histogram axis labels
   static std::vector<int> fgRunList;      // vector of runs, to be used for histogram axis
@@ -1000,10 +1105,6 @@ class VarManager : public TObject
   template <int pairType, typename T1, typename T2>
   static float calculatePhiV(const T1& t1, const T2& t2);
 
-  static o2::vertexing::DCAFitterN<2> fgFitterTwoProngBarrel;
-  static o2::vertexing::DCAFitterN<3> fgFitterThreeProngBarrel;
-  static o2::vertexing::FwdDCAFitterN<2> fgFitterTwoProngFwd;
-  static o2::vertexing::FwdDCAFitterN<3> fgFitterThreeProngFwd;
   static o2::globaltracking::MatchGlobalFwd mMatching;
 
   static std::map<CalibObjects, TObject*> fgCalibs; // map of calibration histograms
@@ -1147,20 +1248,63 @@ o2::dataformats::GlobalFwdTrack VarManager::PropagateMuon(const T& muon, const C
   return propmuon;
 }
 
+template <typename TMuons, typename C>
+void VarManager::PropagateMuons(const TMuons& muons, const C& collision)
+{
+  ClearPropagatedMuons();
+  for (const auto& muon : muons) {
+    AddPropagatedMuon(muon, collision);
+  }
+}
+
+template <typename T, typename C>
+void VarManager::AddPropagatedMuon(const T& muon, const C& collision)
+{
+  auto& propagated = Context().fPropagatedMuons;
+  if (propagated.fCollision != static_cast<int64_t>(collision.globalIndex())) {
+    propagated.Clear();
+    propagated.fCollision = collision.globalIndex();
+  }
+  if (propagated.fSlots.find(muon.globalIndex()) != propagated.fSlots.end()) {
+    return;
+  }
+  propagated.fSlots[muon.globalIndex()] = propagated.fAtVertex.size();
+  propagated.fAtVertex.push_back(PropagateMuon(muon, collision));
+  // only tracks with MCH are extrapolated differently to the DCA plane, see PropagateMuon()
+  if (static_cast<int>(muon.trackType()) > 2) {
+    o2::dataformats::GlobalFwdTrack propmuonAtDCA = PropagateMuon(muon, collision, kToDCA);
+    o2::dataformats::GlobalFwdTrack propmuonAtRabs = PropagateMuon(muon, collision, kToRabs);
+    propagated.fDCAx.push_back(propmuonAtDCA.getX() - collision.posX());
+    propagated.fDCAy.push_back(propmuonAtDCA.getY() - collision.posY());
+    double xAbs = propmuonAtRabs.getX();
+    double yAbs = propmuonAtRabs.getY();
+    propagated.fRAtAbsorberEnd.push_back(std::sqrt(xAbs * xAbs + yAbs * yAbs));
+  } else {
+    propagated.fDCAx.push_back(propagated.fAtVertex.back().getX() - collision.posX());
+    propagated.fDCAy.push_back(propagated.fAtVertex.back().getY() - collision.posY());
+    propagated.fRAtAbsorberEnd.push_back(0.0f);
+  }
+}
+
 template <uint32_t fillMap, typename T, typename C>
 void VarManager::FillMuonPDca(const T& muon, const C& collision, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   if constexpr ((fillMap & MuonCov) > 0 || (fillMap & ReducedMuonCov) > 0) {
-
-    o2::dataformats::GlobalFwdTrack propmuon = PropagateMuon(muon, collision);
-    o2::dataformats::GlobalFwdTrack propmuonAtDCA = PropagateMuon(muon, collision, kToDCA);
-
-    float dcaX = (propmuonAtDCA.getX() - collision.posX());
-    float dcaY = (propmuonAtDCA.getY() - collision.posY());
+    float dcaX = 0.0f;
+    float dcaY = 0.0f;
+    int slot = FindPropagatedMuon(muon, collision);
+    if (slot >= 0) {
+      dcaX = Context().fPropagatedMuons.fDCAx[slot];
+      dcaY = Context().fPropagatedMuons.fDCAy[slot];
+    } else {
+      o2::dataformats::GlobalFwdTrack propmuonAtDCA = PropagateMuon(muon, collision, kToDCA);
+      dcaX = (propmuonAtDCA.getX() - collision.posX());
+      dcaY = (propmuonAtDCA.getY() - collision.posY());
+    }
     float dcaXY = std::sqrt(dcaX * dcaX + dcaY * dcaY);
     values[kMuonPDca] = muon.p() * dcaXY;
   }
@@ -1170,7 +1314,7 @@ template <uint32_t fillMap, typename T, typename C>
 void VarManager::FillPropagateMuon(const T& muon, const C& collision, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   if constexpr ((fillMap & ReducedMuonCov) > 0) {
@@ -1180,7 +1324,8 @@ void VarManager::FillPropagateMuon(const T& muon, const C& collision, float* val
   }
 
   if constexpr ((fillMap & MuonCov) > 0 || (fillMap & ReducedMuonCov) > 0) {
-    o2::dataformats::GlobalFwdTrack propmuon = PropagateMuon(muon, collision);
+    int slot = FindPropagatedMuon(muon, collision);
+    o2::dataformats::GlobalFwdTrack propmuon = (slot >= 0 ? Context().fPropagatedMuons.fAtVertex[slot] : PropagateMuon(muon, collision));
     values[kPt] = propmuon.getPt();
     values[kX] = propmuon.getX();
     values[kY] = propmuon.getY();
@@ -1192,15 +1337,21 @@ void VarManager::FillPropagateMuon(const T& muon, const C& collision, float* val
     // Redo propagation only for muon tracks
     // propagation of MFT tracks alredy done in fwdtrack-extention task
     if (static_cast<int>(muon.trackType()) > 2) {
-      o2::dataformats::GlobalFwdTrack propmuonAtDCA = PropagateMuon(muon, collision, kToDCA);
-      o2::dataformats::GlobalFwdTrack propmuonAtRabs = PropagateMuon(muon, collision, kToRabs);
-      float dcaX = (propmuonAtDCA.getX() - collision.posX());
-      float dcaY = (propmuonAtDCA.getY() - collision.posY());
-      values[kMuonDCAx] = dcaX;
-      values[kMuonDCAy] = dcaY;
-      double xAbs = propmuonAtRabs.getX();
-      double yAbs = propmuonAtRabs.getY();
-      values[kMuonRAtAbsorberEnd] = std::sqrt(xAbs * xAbs + yAbs * yAbs);
+      if (slot >= 0) {
+        values[kMuonDCAx] = Context().fPropagatedMuons.fDCAx[slot];
+        values[kMuonDCAy] = Context().fPropagatedMuons.fDCAy[slot];
+        values[kMuonRAtAbsorberEnd] = Context().fPropagatedMuons.fRAtAbsorberEnd[slot];
+      } else {
+        o2::dataformats::GlobalFwdTrack propmuonAtDCA = PropagateMuon(muon, collision, kToDCA);
+        o2::dataformats::GlobalFwdTrack propmuonAtRabs = PropagateMuon(muon, collision, kToRabs);
+        float dcaX = (propmuonAtDCA.getX() - collision.posX());
+        float dcaY = (propmuonAtDCA.getY() - collision.posY());
+        values[kMuonDCAx] = dcaX;
+        values[kMuonDCAy] = dcaY;
+        double xAbs = propmuonAtRabs.getX();
+        double yAbs = propmuonAtRabs.getY();
+        values[kMuonRAtAbsorberEnd] = std::sqrt(xAbs * xAbs + yAbs * yAbs);
+      }
     }
 
     SMatrix55 cov = propmuon.getCovariances();
@@ -1226,7 +1377,7 @@ template <typename T>
 void VarManager::FillBC(T const& bc, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
   values[VarManager::kRunNo] = bc.runNumber();
   values[VarManager::kBC] = bc.globalBC();
@@ -1239,7 +1390,7 @@ template <uint32_t fillMap, typename T>
 void VarManager::FillEvent(T const& event, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   if constexpr ((fillMap & CollisionTimestamp) > 0) {
@@ -1603,7 +1754,7 @@ template <typename T>
 void VarManager::FillTwoEvents(T const& ev1, T const& ev2, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   values[kTwoEvPosZ1] = ev1.posZ();
@@ -1631,7 +1782,7 @@ template <uint32_t fillMap, typename T1, typename T2>
 void VarManager::FillTwoMixEvents(T1 const& ev1, T1 const& ev2, T2 const& /*tracks1*/, T2 const& /*tracks2*/, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
   values[kTwoEvPosZ1] = ev1.posZ();
   values[kTwoEvPosZ2] = ev2.posZ();
@@ -1663,7 +1814,7 @@ void VarManager::FillTwoMixEvents(T1 const& ev1, T1 const& ev2, T2 const& /*trac
     values[kQ2Y0A2] = ev2.q2y0a();
   }
 
-  if (isnan(VarManager::fgValues[VarManager::kTwoR2SP1]) == true || isnan(VarManager::fgValues[VarManager::kTwoR2EP1]) == true) {
+  if (isnan(values[VarManager::kTwoR2SP1]) == true || isnan(values[VarManager::kTwoR2EP1]) == true) {
     values[kTwoR2SP1] = -999.;
     values[kTwoR2SP2] = -999.;
     values[kTwoR2EP1] = -999.;
@@ -1675,7 +1826,7 @@ template <uint32_t fillMap, typename T>
 void VarManager::FillTrack(T const& track, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   if constexpr ((fillMap & TrackMFT) > 0) {
@@ -1720,7 +1871,7 @@ void VarManager::FillTrack(T const& track, float* values)
     values[kPhi] = track.phi();
     values[kCharge] = track.sign();
     if (fgUsedVars[kPhiTPCOuter]) {
-      values[kPhiTPCOuter] = track.phi() - (track.sign() > 0 ? 1.0 : -1.0) * (TMath::PiOver2() - TMath::ACos(0.22 * fgMagField / track.pt()));
+      values[kPhiTPCOuter] = track.phi() - (track.sign() > 0 ? 1.0 : -1.0) * (TMath::PiOver2() - TMath::ACos(0.22 * Context().fMagField / track.pt()));
       if (values[kPhiTPCOuter] > TMath::TwoPi()) {
         values[kPhiTPCOuter] -= TMath::TwoPi();
       }
@@ -1731,7 +1882,7 @@ void VarManager::FillTrack(T const& track, float* values)
     if (fgUsedVars[kTrackIsInsideTPCModule]) {
       float localSectorPhi = values[kPhiTPCOuter] - TMath::Floor(18.0 * values[kPhiTPCOuter] / TMath::TwoPi()) * (TMath::TwoPi() / 18.0);
       float edge = fgTPCInterSectorBoundary / 2.0 / 246.6; // minimal inter-sector boundary as angle
-      float curvature = 3.0 * 3.33 * track.pt() / fgMagField * (1.0 - TMath::Sin(TMath::ACos(0.22 * fgMagField / track.pt())));
+      float curvature = 3.0 * 3.33 * track.pt() / Context().fMagField * (1.0 - TMath::Sin(TMath::ACos(0.22 * Context().fMagField / track.pt())));
       if (curvature / 2.466 > edge) {
         edge = curvature / 2.466;
       }
@@ -2118,12 +2269,12 @@ void VarManager::FillTrackCollision(T const& track, C const& collision, float* v
 {
 
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
   if constexpr ((fillMap & ReducedTrackBarrel) > 0 || (fillMap & TrackDCA) > 0) {
     auto trackPar = getTrackPar(track);
     std::array<float, 2> dca{1e10f, 1e10f};
-    trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgMagField, &dca);
+    trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, Context().fMagField, &dca);
 
     values[kTrackDCAxy] = dca[0];
     values[kTrackDCAz] = dca[1];
@@ -2138,12 +2289,17 @@ void VarManager::FillTrackCollision(T const& track, C const& collision, float* v
     }
   }
   if constexpr ((fillMap & MuonCov) > 0 || (fillMap & ReducedMuonCov) > 0) {
-
-    o2::dataformats::GlobalFwdTrack propmuon = PropagateMuon(track, collision);
-    o2::dataformats::GlobalFwdTrack propmuonAtDCA = PropagateMuon(track, collision, kToDCA);
-
-    float dcaX = (propmuonAtDCA.getX() - collision.posX());
-    float dcaY = (propmuonAtDCA.getY() - collision.posY());
+    float dcaX = 0.0f;
+    float dcaY = 0.0f;
+    int slot = FindPropagatedMuon(track, collision);
+    if (slot >= 0) {
+      dcaX = Context().fPropagatedMuons.fDCAx[slot];
+      dcaY = Context().fPropagatedMuons.fDCAy[slot];
+    } else {
+      o2::dataformats::GlobalFwdTrack propmuonAtDCA = PropagateMuon(track, collision, kToDCA);
+      dcaX = (propmuonAtDCA.getX() - collision.posX());
+      dcaY = (propmuonAtDCA.getY() - collision.posY());
+    }
     float dcaXY = std::sqrt(dcaX * dcaX + dcaY * dcaY);
     values[kMuonPDca] = track.p() * dcaXY;
     values[kMuonDCAx] = dcaX;
@@ -2155,13 +2311,13 @@ template <uint32_t fillMap, typename T, typename C, typename M, typename P>
 void VarManager::FillTrackCollisionMatCorr(T const& track, C const& collision, M const& materialCorr, P const& propagator, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
   if constexpr ((fillMap & ReducedTrackBarrel) > 0 || (fillMap & TrackDCA) > 0) {
     auto trackPar = getTrackPar(track);
     std::array<float, 2> dca{1e10f, 1e10f};
     std::array<float, 3> pVec = {track.px(), track.py(), track.pz()};
-    // trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgMagField, &dca);
+    // trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, Context().fMagField, &dca);
     propagator->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackPar, 2.f, materialCorr, &dca);
     getPxPyPz(trackPar, pVec);
 
@@ -2183,7 +2339,7 @@ template <uint32_t fillMap, typename T>
 void VarManager::FillPhoton(T const& track, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   // Quantities based on the basic table (contains just kine information and filter bits)
@@ -2215,7 +2371,7 @@ template <typename U, typename T>
 void VarManager::FillTrackMC(const U& mcStack, T const& track, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   // Quantities based on the mc particle table
@@ -2248,10 +2404,12 @@ template <uint32_t fillMap, typename T1, typename T2, typename C>
 void VarManager::FillPairPropagateMuon(T1 const& muon1, T2 const& muon2, const C& collision, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
-  o2::dataformats::GlobalFwdTrack propmuon1 = PropagateMuon(muon1, collision);
-  o2::dataformats::GlobalFwdTrack propmuon2 = PropagateMuon(muon2, collision);
+  int slot1 = FindPropagatedMuon(muon1, collision);
+  int slot2 = FindPropagatedMuon(muon2, collision);
+  o2::dataformats::GlobalFwdTrack propmuon1 = (slot1 >= 0 ? Context().fPropagatedMuons.fAtVertex[slot1] : PropagateMuon(muon1, collision));
+  o2::dataformats::GlobalFwdTrack propmuon2 = (slot2 >= 0 ? Context().fPropagatedMuons.fAtVertex[slot2] : PropagateMuon(muon2, collision));
 
   float m = o2::constants::physics::MassMuon;
 
@@ -2273,7 +2431,7 @@ template <int pairType, uint32_t fillMap, typename T1, typename T2>
 void VarManager::FillPair(T1 const& t1, T2 const& t2, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   float m1 = o2::constants::physics::MassElectron;
@@ -2310,9 +2468,9 @@ void VarManager::FillPair(T1 const& t1, T2 const& t2, float* values)
   values[kDeltaPtotTracks] = Ptot1 - Ptot2;
 
   if (fgUsedVars[kPsiPair]) {
-    values[kDeltaPhiPair] = (t1.sign() * fgMagField > 0.) ? (v1.Phi() - v2.Phi()) : (v2.Phi() - v1.Phi());
+    values[kDeltaPhiPair] = (t1.sign() * Context().fMagField > 0.) ? (v1.Phi() - v2.Phi()) : (v2.Phi() - v1.Phi());
     double xipair = TMath::ACos((v1.Px() * v2.Px() + v1.Py() * v2.Py() + v1.Pz() * v2.Pz()) / v1.P() / v2.P());
-    values[kPsiPair] = (t1.sign() * fgMagField > 0.) ? TMath::ASin((v1.Theta() - v2.Theta()) / xipair) : TMath::ASin((v2.Theta() - v1.Theta()) / xipair);
+    values[kPsiPair] = (t1.sign() * Context().fMagField > 0.) ? TMath::ASin((v1.Theta() - v2.Theta()) / xipair) : TMath::ASin((v2.Theta() - v1.Theta()) / xipair);
   }
 
   if (fgUsedVars[kOpeningAngle]) {
@@ -2330,42 +2488,44 @@ void VarManager::FillPair(T1 const& t1, T2 const& t2, float* values)
     }
   }
 
-  // TO DO: get the correct values from CCDB
-  double BeamMomentum = TMath::Sqrt(fgCenterOfMassEnergy * fgCenterOfMassEnergy / 4 - fgMassofCollidingParticle * fgMassofCollidingParticle); // GeV
-  ROOT::Math::PxPyPzEVector Beam1(0., 0., -BeamMomentum, fgCenterOfMassEnergy / 2);
-  ROOT::Math::PxPyPzEVector Beam2(0., 0., BeamMomentum, fgCenterOfMassEnergy / 2);
+  if (IsVarGroupUsed(kVarGroupPairPolarization)) {
+    // TO DO: get the correct values from CCDB
+    double BeamMomentum = TMath::Sqrt(fgCenterOfMassEnergy * fgCenterOfMassEnergy / 4 - fgMassofCollidingParticle * fgMassofCollidingParticle); // GeV
+    ROOT::Math::PxPyPzEVector Beam1(0., 0., -BeamMomentum, fgCenterOfMassEnergy / 2);
+    ROOT::Math::PxPyPzEVector Beam2(0., 0., BeamMomentum, fgCenterOfMassEnergy / 2);
 
-  // Boost to center of mass frame
-  ROOT::Math::Boost boostv12{v12.BoostToCM()};
-  ROOT::Math::XYZVectorF v1_CM{(boostv12(v1).Vect()).Unit()};
-  ROOT::Math::XYZVectorF v2_CM{(boostv12(v2).Vect()).Unit()};
-  ROOT::Math::XYZVectorF Beam1_CM{(boostv12(Beam1).Vect()).Unit()};
-  ROOT::Math::XYZVectorF Beam2_CM{(boostv12(Beam2).Vect()).Unit()};
+    // Boost to center of mass frame
+    ROOT::Math::Boost boostv12{v12.BoostToCM()};
+    ROOT::Math::XYZVectorF v1_CM{(boostv12(v1).Vect()).Unit()};
+    ROOT::Math::XYZVectorF v2_CM{(boostv12(v2).Vect()).Unit()};
+    ROOT::Math::XYZVectorF Beam1_CM{(boostv12(Beam1).Vect()).Unit()};
+    ROOT::Math::XYZVectorF Beam2_CM{(boostv12(Beam2).Vect()).Unit()};
 
-  // Helicity frame
-  ROOT::Math::XYZVectorF zaxis_HE{(v12.Vect()).Unit()};
-  ROOT::Math::XYZVectorF yaxis_HE{(Beam1_CM.Cross(Beam2_CM)).Unit()};
-  ROOT::Math::XYZVectorF xaxis_HE{(yaxis_HE.Cross(zaxis_HE)).Unit()};
+    // Helicity frame
+    ROOT::Math::XYZVectorF zaxis_HE{(v12.Vect()).Unit()};
+    ROOT::Math::XYZVectorF yaxis_HE{(Beam1_CM.Cross(Beam2_CM)).Unit()};
+    ROOT::Math::XYZVectorF xaxis_HE{(yaxis_HE.Cross(zaxis_HE)).Unit()};
 
-  // Collins-Soper frame
-  ROOT::Math::XYZVectorF zaxis_CS{((Beam1_CM.Unit() - Beam2_CM.Unit()).Unit())};
-  ROOT::Math::XYZVectorF yaxis_CS{(Beam1_CM.Cross(Beam2_CM)).Unit()};
-  ROOT::Math::XYZVectorF xaxis_CS{(yaxis_CS.Cross(zaxis_CS)).Unit()};
+    // Collins-Soper frame
+    ROOT::Math::XYZVectorF zaxis_CS{((Beam1_CM.Unit() - Beam2_CM.Unit()).Unit())};
+    ROOT::Math::XYZVectorF yaxis_CS{(Beam1_CM.Cross(Beam2_CM)).Unit()};
+    ROOT::Math::XYZVectorF xaxis_CS{(yaxis_CS.Cross(zaxis_CS)).Unit()};
 
-  if (fgUsedVars[kCosThetaHE]) {
-    values[kCosThetaHE] = (t1.sign() > 0 ? zaxis_HE.Dot(v1_CM) : zaxis_HE.Dot(v2_CM));
-  }
+    if (fgUsedVars[kCosThetaHE]) {
+      values[kCosThetaHE] = (t1.sign() > 0 ? zaxis_HE.Dot(v1_CM) : zaxis_HE.Dot(v2_CM));
+    }
 
-  if (fgUsedVars[kPhiHE]) {
-    values[kPhiHE] = (t1.sign() > 0 ? TMath::ATan2(yaxis_HE.Dot(v1_CM), xaxis_HE.Dot(v1_CM)) : TMath::ATan2(yaxis_HE.Dot(v2_CM), xaxis_HE.Dot(v2_CM)));
-  }
+    if (fgUsedVars[kPhiHE]) {
+      values[kPhiHE] = (t1.sign() > 0 ? TMath::ATan2(yaxis_HE.Dot(v1_CM), xaxis_HE.Dot(v1_CM)) : TMath::ATan2(yaxis_HE.Dot(v2_CM), xaxis_HE.Dot(v2_CM)));
+    }
 
-  if (fgUsedVars[kCosThetaCS]) {
-    values[kCosThetaCS] = (t1.sign() > 0 ? zaxis_CS.Dot(v1_CM) : zaxis_CS.Dot(v2_CM));
-  }
+    if (fgUsedVars[kCosThetaCS]) {
+      values[kCosThetaCS] = (t1.sign() > 0 ? zaxis_CS.Dot(v1_CM) : zaxis_CS.Dot(v2_CM));
+    }
 
-  if (fgUsedVars[kPhiCS]) {
-    values[kPhiCS] = (t1.sign() > 0 ? TMath::ATan2(yaxis_CS.Dot(v1_CM), xaxis_CS.Dot(v1_CM)) : TMath::ATan2(yaxis_CS.Dot(v2_CM), xaxis_CS.Dot(v2_CM)));
+    if (fgUsedVars[kPhiCS]) {
+      values[kPhiCS] = (t1.sign() > 0 ? TMath::ATan2(yaxis_CS.Dot(v1_CM), xaxis_CS.Dot(v1_CM)) : TMath::ATan2(yaxis_CS.Dot(v2_CM), xaxis_CS.Dot(v2_CM)));
+    }
   }
 
   if constexpr ((pairType == kDecayToEE) && ((fillMap & TrackCov) > 0 || (fillMap & ReducedTrackBarrelCov) > 0)) {
@@ -2423,7 +2583,7 @@ void VarManager::FillTriple(T1 const& t1, T2 const& t2, T3 const& t3, float* val
 {
 
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
   if (pairType == kTripleCandidateToEEPhoton) {
     float m1 = o2::constants::physics::MassElectron;
@@ -2486,6 +2646,46 @@ void VarManager::FillTriple(T1 const& t1, T2 const& t2, T3 const& t3, float* val
   }
 }
 
+template <int pairType, typename T1, typename T2>
+void VarManager::ComputePairMassPt(T1 const& t1, T2 const& t2, float& mass, float& pt)
+{
+  //
+  // Pair invariant mass and pT with plain arithmetic on the track 4-momenta, without filling any variable.
+  // Meant as a cheap pre-selection of the pairs before calling the full FillPair() and FillPairVertexing()
+  //
+  float m1 = o2::constants::physics::MassElectron;
+  float m2 = o2::constants::physics::MassElectron;
+  if constexpr (pairType == kDecayToMuMu) {
+    m1 = o2::constants::physics::MassMuon;
+    m2 = o2::constants::physics::MassMuon;
+  }
+  if constexpr (pairType == kDecayToPiPi) {
+    m1 = o2::constants::physics::MassPionCharged;
+    m2 = o2::constants::physics::MassPionCharged;
+  }
+  if constexpr (pairType == kElectronMuon) {
+    m2 = o2::constants::physics::MassMuon;
+  }
+
+  const float px1 = t1.pt() * std::cos(t1.phi());
+  const float py1 = t1.pt() * std::sin(t1.phi());
+  const float pz1 = t1.pt() * std::sinh(t1.eta());
+  const float px2 = t2.pt() * std::cos(t2.phi());
+  const float py2 = t2.pt() * std::sin(t2.phi());
+  const float pz2 = t2.pt() * std::sinh(t2.eta());
+  const float e1 = std::sqrt(px1 * px1 + py1 * py1 + pz1 * pz1 + m1 * m1);
+  const float e2 = std::sqrt(px2 * px2 + py2 * py2 + pz2 * pz2 + m2 * m2);
+
+  const float px = px1 + px2;
+  const float py = py1 + py2;
+  const float pz = pz1 + pz2;
+  const float e = e1 + e2;
+  const float pt2 = px * px + py * py;
+  const float m2Pair = e * e - pt2 - pz * pz;
+  pt = std::sqrt(pt2);
+  mass = (m2Pair > 0.0f ? std::sqrt(m2Pair) : 0.0f);
+}
+
 template <int pairType, typename T1, typename T2>
 void VarManager::FillPairME(T1 const& t1, T2 const& t2, float* values)
 {
@@ -2493,7 +2693,7 @@ void VarManager::FillPairME(T1 const& t1, T2 const& t2, float* values)
   // Lightweight fill function called from the innermost event mixing loop
   //
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   float m1 = o2::constants::physics::MassElectron;
@@ -2548,7 +2748,7 @@ template <typename T1, typename T2>
 void VarManager::FillPairMC(T1 const& t1, T2 const& t2, float* values, PairCandidateType pairType)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   float m1 = o2::constants::physics::MassElectron;
@@ -2582,7 +2782,7 @@ template <typename T1, typename T2, typename T3>
 void VarManager::FillTripleMC(T1 const& t1, T2 const& t2, T3 const& t3, float* values, PairCandidateType pairType)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   if (pairType == kTripleCandidateToEEPhoton) {
@@ -2624,7 +2824,7 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
   constexpr bool muonHasCov = ((fillMap & MuonCov) > 0 || (fillMap & ReducedMuonCov) > 0);
 
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
   float m1 = o2::constants::physics::MassElectron;
   float m2 = o2::constants::physics::MassElectron;
@@ -2640,8 +2840,12 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
   ROOT::Math::PtEtaPhiMVector v2(t2.pt(), t2.eta(), t2.phi(), m2);
   ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
 
-  values[kUsedKF] = fgUsedKF;
-  if (!fgUsedKF) {
+  values[kUsedKF] = Context().fUsedKF;
+  // skip the secondary vertex fit if none of its outputs is needed
+  if (!propToSV && !IsVarGroupUsed(kVarGroupPairVertexing)) {
+    return;
+  }
+  if (!Context().fUsedKF) {
     int procCode = 0;
 
     // TODO: use trackUtilities functions to initialize the various matrices to avoid code duplication
@@ -2659,7 +2863,7 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
                                       t2.cSnpSnp(), t2.cTglY(), t2.cTglZ(), t2.cTglSnp(), t2.cTglTgl(),
                                       t2.c1PtY(), t2.c1PtZ(), t2.c1PtSnp(), t2.c1PtTgl(), t2.c1Pt21Pt2()};
       o2::track::TrackParCov pars2{t2.x(), t2.alpha(), t2pars, t2covs};
-      procCode = fgFitterTwoProngBarrel.process(pars1, pars2);
+      procCode = Context().fFitterTwoProngBarrel.process(pars1, pars2);
     } else if constexpr ((pairType == kDecayToMuMu) && muonHasCov) {
       // Initialize track parameters for forward
       double chi21 = t1.chi2();
@@ -2676,7 +2880,7 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
                              t2.c1PtX(), t2.c1PtY(), t2.c1PtPhi(), t2.c1PtTgl(), t2.c1Pt21Pt2()};
       SMatrix55 t2covs(v2.begin(), v2.end());
       o2::track::TrackParCovFwd pars2{t2.z(), t2pars, t2covs, chi22};
-      procCode = fgFitterTwoProngFwd.process(pars1, pars2);
+      procCode = Context().fFitterTwoProngFwd.process(pars1, pars2);
     } else {
       return;
     }
@@ -2715,11 +2919,11 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
       auto covMatrixPV = primaryVertex.getCov();
 
       if constexpr ((pairType == kDecayToEE || pairType == kDecayToKPi) && trackHasCov) {
-        secondaryVertex = fgFitterTwoProngBarrel.getPCACandidate();
-        covMatrixPCA = fgFitterTwoProngBarrel.calcPCACovMatrixFlat();
-        auto chi2PCA = fgFitterTwoProngBarrel.getChi2AtPCACandidate();
-        auto trackParVar0 = fgFitterTwoProngBarrel.getTrack(0);
-        auto trackParVar1 = fgFitterTwoProngBarrel.getTrack(1);
+        secondaryVertex = Context().fFitterTwoProngBarrel.getPCACandidate();
+        covMatrixPCA = Context().fFitterTwoProngBarrel.calcPCACovMatrixFlat();
+        auto chi2PCA = Context().fFitterTwoProngBarrel.getChi2AtPCACandidate();
+        auto trackParVar0 = Context().fFitterTwoProngBarrel.getTrack(0);
+        auto trackParVar1 = Context().fFitterTwoProngBarrel.getTrack(1);
         values[kVertexingChi2PCA] = chi2PCA;
         v1 = {trackParVar0.getPt(), trackParVar0.getEta(), trackParVar0.getPhi(), m1};
         v2 = {trackParVar1.getPt(), trackParVar1.getEta(), trackParVar1.getPhi(), m2};
@@ -2727,11 +2931,11 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
 
       } else if constexpr (pairType == kDecayToMuMu && muonHasCov) {
         // Get pca candidate from forward DCA fitter
-        secondaryVertex = fgFitterTwoProngFwd.getPCACandidate();
-        covMatrixPCA = fgFitterTwoProngFwd.calcPCACovMatrixFlat();
-        auto chi2PCA = fgFitterTwoProngFwd.getChi2AtPCACandidate();
-        auto trackParVar0 = fgFitterTwoProngFwd.getTrack(0);
-        auto trackParVar1 = fgFitterTwoProngFwd.getTrack(1);
+        secondaryVertex = Context().fFitterTwoProngFwd.getPCACandidate();
+        covMatrixPCA = Context().fFitterTwoProngFwd.calcPCACovMatrixFlat();
+        auto chi2PCA = Context().fFitterTwoProngFwd.getChi2AtPCACandidate();
+        auto trackParVar0 = Context().fFitterTwoProngFwd.getTrack(0);
+        auto trackParVar1 = Context().fFitterTwoProngFwd.getTrack(1);
         values[kVertexingChi2PCA] = chi2PCA;
         v1 = {trackParVar0.getPt(), trackParVar0.getEta(), trackParVar0.getPhi(), m1};
         v2 = {trackParVar1.getPt(), trackParVar1.getEta(), trackParVar1.getPhi(), m2};
@@ -3018,7 +3222,7 @@ void VarManager::FillTripletVertexing(C const& collision, T const& t1, T const&
   bool trackHasCov = ((fillMap & ReducedTrackBarrelCov) > 0);
 
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   float m1, m2, m3;
@@ -3038,8 +3242,8 @@ void VarManager::FillTripletVertexing(C const& collision, T const& t1, T const&
   ROOT::Math::PtEtaPhiMVector v3(t3.pt(), t3.eta(), t3.phi(), m3);
   ROOT::Math::PtEtaPhiMVector v123 = v1 + v2 + v3;
 
-  values[kUsedKF] = fgUsedKF;
-  if (!fgUsedKF) {
+  values[kUsedKF] = Context().fUsedKF;
+  if (!Context().fUsedKF) {
     int procCode = 0;
 
     if (trackHasCov) {
@@ -3058,7 +3262,7 @@ void VarManager::FillTripletVertexing(C const& collision, T const& t1, T const&
                                       t3.cSnpSnp(), t3.cTglY(), t3.cTglZ(), t3.cTglSnp(), t3.cTglTgl(),
                                       t3.c1PtY(), t3.c1PtZ(), t3.c1PtSnp(), t3.c1PtTgl(), t3.c1Pt21Pt2()};
       o2::track::TrackParCov pars3{t3.x(), t3.alpha(), t3pars, t3covs};
-      procCode = VarManager::fgFitterThreeProngBarrel.process(pars1, pars2, pars3);
+      procCode = VarManager::Context().fFitterThreeProngBarrel.process(pars1, pars2, pars3);
     } else {
       return;
     }
@@ -3091,9 +3295,9 @@ void VarManager::FillTripletVertexing(C const& collision, T const& t1, T const&
     Vec3D secondaryVertex;
 
     if constexpr (eventHasVtxCov) {
-      secondaryVertex = fgFitterThreeProngBarrel.getPCACandidate();
+      secondaryVertex = Context().fFitterThreeProngBarrel.getPCACandidate();
 
-      std::array<float, 6> covMatrixPCA = fgFitterThreeProngBarrel.calcPCACovMatrixFlat();
+      std::array<float, 6> covMatrixPCA = Context().fFitterThreeProngBarrel.calcPCACovMatrixFlat();
 
       o2::math_utils::Point3D<float> vtxXYZ(collision.posX(), collision.posY(), collision.posZ());
       std::array<float, 6> vtxCov{collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ()};
@@ -3230,7 +3434,7 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
   constexpr bool trackHasCov = ((fillMap & TrackCov) > 0 || (fillMap & ReducedTrackBarrelCov) > 0);
   constexpr bool muonHasCov = ((fillMap & MuonCov) > 0 || (fillMap & ReducedMuonCov) > 0);
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   float mtrack;
@@ -3239,8 +3443,8 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
   int procCode = 0;
   int procCodeJpsi = 0;
 
-  values[kUsedKF] = fgUsedKF;
-  if (!fgUsedKF) {
+  values[kUsedKF] = Context().fUsedKF;
+  if (!Context().fUsedKF) {
     if constexpr ((candidateType == kBcToThreeMuons) && muonHasCov) {
       mlepton1 = o2::constants::physics::MassMuon;
       mlepton2 = o2::constants::physics::MassMuon;
@@ -3269,8 +3473,8 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
                              track.c1PtX(), track.c1PtY(), track.c1PtPhi(), track.c1PtTgl(), track.c1Pt21Pt2()};
       SMatrix55 t3covs(v3.begin(), v3.end());
       o2::track::TrackParCovFwd pars3{track.z(), t3pars, t3covs, chi23};
-      procCode = VarManager::fgFitterThreeProngFwd.process(pars1, pars2, pars3);
-      procCodeJpsi = VarManager::fgFitterTwoProngFwd.process(pars1, pars2);
+      procCode = VarManager::Context().fFitterThreeProngFwd.process(pars1, pars2, pars3);
+      procCodeJpsi = VarManager::Context().fFitterTwoProngFwd.process(pars1, pars2);
     } else if constexpr ((candidateType == kBtoJpsiEEK || candidateType == kDstarToD0KPiPi) && trackHasCov) {
       if constexpr ((candidateType == kBtoJpsiEEK) && trackHasCov) {
         mlepton1 = o2::constants::physics::MassElectron;
@@ -3296,8 +3500,8 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
                                            track.cSnpSnp(), track.cTglY(), track.cTglZ(), track.cTglSnp(), track.cTglTgl(),
                                            track.c1PtY(), track.c1PtZ(), track.c1PtSnp(), track.c1PtTgl(), track.c1Pt21Pt2()};
       o2::track::TrackParCov pars3{track.x(), track.alpha(), lepton3pars, lepton3covs};
-      procCode = VarManager::fgFitterThreeProngBarrel.process(pars1, pars2, pars3);
-      procCodeJpsi = VarManager::fgFitterTwoProngBarrel.process(pars1, pars2);
+      procCode = VarManager::Context().fFitterThreeProngBarrel.process(pars1, pars2, pars3);
+      procCodeJpsi = VarManager::Context().fFitterTwoProngBarrel.process(pars1, pars2);
     } else {
       return;
     }
@@ -3352,14 +3556,14 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
       auto covMatrixPV = primaryVertex.getCov();
 
       if constexpr ((candidateType == kBtoJpsiEEK || candidateType == kDstarToD0KPiPi) && trackHasCov) {
-        secondaryVertex = fgFitterThreeProngBarrel.getPCACandidate();
-        covMatrixPCA = fgFitterThreeProngBarrel.calcPCACovMatrixFlat();
+        secondaryVertex = Context().fFitterThreeProngBarrel.getPCACandidate();
+        covMatrixPCA = Context().fFitterThreeProngBarrel.calcPCACovMatrixFlat();
       } else if constexpr (candidateType == kBcToThreeMuons && muonHasCov) {
-        secondaryVertex = fgFitterThreeProngFwd.getPCACandidate();
-        covMatrixPCA = fgFitterThreeProngFwd.calcPCACovMatrixFlat();
+        secondaryVertex = Context().fFitterThreeProngFwd.getPCACandidate();
+        covMatrixPCA = Context().fFitterThreeProngFwd.calcPCACovMatrixFlat();
       }
 
-      auto chi2PCA = fgFitterThreeProngBarrel.getChi2AtPCACandidate();
+      auto chi2PCA = Context().fFitterThreeProngBarrel.getChi2AtPCACandidate();
       if (fgUsedVars[kVertexingChi2PCA])
         values[VarManager::kVertexingChi2PCA] = chi2PCA;
 
@@ -3502,7 +3706,7 @@ template <typename C, typename A>
 void VarManager::FillQVectorFromGFW(C const& /*collision*/, A const& compA11, A const& compB11, A const& compC11, A const& compA21, A const& compB21, A const& compC21, A const& compA31, A const& compB31, A const& compC31, A const& compA41, A const& compB41, A const& compC41, A const& compA23, A const& compA42, float S10A, float S10B, float S10C, float S11A, float S11B, float S11C, float S12A, float S13A, float S14A, float S21A, float S22A, float S31A, float S41A, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   // Fill Qn vectors from generic flow framework for different eta gap A, B, C (n=1,2,3,4) with proper normalisation
@@ -3592,7 +3796,7 @@ template <typename C>
 void VarManager::FillQVectorFromCentralFW(C const& collision, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   float xQVecFT0a = collision.qvecFT0ARe(); // already normalised
@@ -3688,7 +3892,7 @@ template <typename C>
 void VarManager::FillSpectatorPlane(C const& collision, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   auto zncEnergy = collision.energySectorZNC();
@@ -3776,7 +3980,7 @@ void VarManager::FillPairVn(T1 const& t1, T2 const& t2, float* values)
 {
 
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   float m1 = o2::constants::physics::MassElectron;
@@ -3826,23 +4030,23 @@ void VarManager::FillPairVn(T1 const& t1, T2 const& t2, float* values)
   values[kCos2DeltaPhiMu1] = std::cos(2 * (v1.Phi() - v12.Phi()));
   values[kCos2DeltaPhiMu2] = std::cos(2 * (v2.Phi() - v12.Phi()));
 
-  if (isnan(VarManager::fgValues[VarManager::kU2Q2]) == true) {
+  if (isnan(values[VarManager::kU2Q2]) == true) {
     values[kU2Q2] = -999.;
     values[kR2SP_AB] = -999.;
     values[kR2SP_AC] = -999.;
     values[kR2SP_BC] = -999.;
   }
-  if (isnan(VarManager::fgValues[VarManager::kU3Q3]) == true) {
+  if (isnan(values[VarManager::kU3Q3]) == true) {
     values[kU3Q3] = -999.;
     values[kR3SP] = -999.;
   }
-  if (isnan(VarManager::fgValues[VarManager::kCos2DeltaPhi]) == true) {
+  if (isnan(values[VarManager::kCos2DeltaPhi]) == true) {
     values[kCos2DeltaPhi] = -999.;
     values[kR2EP_AB] = -999.;
     values[kR2EP_AC] = -999.;
     values[kR2EP_BC] = -999.;
   }
-  if (isnan(VarManager::fgValues[VarManager::kCos3DeltaPhi]) == true) {
+  if (isnan(values[VarManager::kCos3DeltaPhi]) == true) {
     values[kCos3DeltaPhi] = -999.;
     values[kR3EP] = -999.;
   }
@@ -3864,7 +4068,7 @@ template <typename T>
 void VarManager::FillZDC(T const& zdc, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   values[kEnergyCommonZNA] = (zdc.energyCommonZNA() > 0) ? zdc.energyCommonZNA() : -1.;
@@ -3881,7 +4085,7 @@ template <typename T1, typename T2>
 void VarManager::FillDileptonHadron(T1 const& dilepton, T2 const& hadron, float* values, float hadronMass)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   if (fgUsedVars[kPairMass] || fgUsedVars[kPairPt] || fgUsedVars[kPairEta] || fgUsedVars[kPairPhi] || fgUsedVars[kPairMassDau] || fgUsedVars[kPairPtDau]) {
@@ -3923,7 +4127,7 @@ template <typename T1, typename T2>
 void VarManager::FillDileptonPhoton(T1 const& dilepton, T2 const& photon, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
   if (fgUsedVars[kPairMass] || fgUsedVars[kPairPt] || fgUsedVars[kPairEta] || fgUsedVars[kPairPhi]) {
     ROOT::Math::PtEtaPhiMVector v1(dilepton.pt(), dilepton.eta(), dilepton.phi(), dilepton.mass());
@@ -3950,7 +4154,7 @@ template <typename T>
 void VarManager::FillHadron(T const& hadron, float* values, float hadronMass)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   ROOT::Math::PtEtaPhiMVector vhadron(hadron.pt(), hadron.eta(), hadron.phi(), hadronMass);
@@ -3965,7 +4169,7 @@ template <int partType, typename Cand, typename H, typename T>
 void VarManager::FillSingleDileptonCharmHadron(Cand const& candidate, H hfHelper, T& bdtScoreCharmHad, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   if constexpr (partType == kJPsi) {
@@ -4001,7 +4205,7 @@ template <int candidateType, typename T1, typename T2, typename T3>
 void VarManager::FillDileptonTrackTrack(T1 const& dilepton, T2 const& hadron1, T3 const& hadron2, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = Context().fValues;
   }
 
   double DefaultdileptonMass = 3.096;
@@ -4068,7 +4272,7 @@ float VarManager::calculatePhiV(T1 const& t1, T2 const& t2)
   ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
 
   float pairPhiV = -999;
-  float bz = fgMagField;
+  float bz = Context().fMagField;
 
   bool swapTracks = false;
   if (v1.Pt() < v2.Pt()) { // ordering of track, pt1 > pt2
@@ -17,6 +17,9 @@
 // The skimming can optionally produce just the barrel, muon, or both barrel and muon tracks
 // The event filtering, centrality, and V0Bits (from v0-selector) can be switched on/off by selecting one
 //  of the process functions
+#include <cstdint>
+#include <vector>
+
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/ASoAHelpers.h"
@@ -206,13 +209,20 @@ struct TableMaker {
   bool fDoDetailedQA = false; // Bool to set detailed QA true, if QA is set true
   int fCurrentRun;            // needed to detect if the run changed and trigger update of calibrations etc.
 
-  // maps used to store index info; NOTE: std::map are sorted in ascending order by default (needed for track to collision indices)
-  std::map<uint32_t, uint32_t> fCollIndexMap;             // key: old collision index, value: skimmed collision index
-  std::map<uint32_t, uint32_t> fTrackIndexMap;            // key: old track global index, value: new track global index
-  std::map<uint32_t, uint32_t> fFwdTrackIndexMap;         // key: fwd-track global index, value: new fwd-track global index
-  std::map<uint32_t, uint32_t> fFwdTrackIndexMapReversed; // key: new fwd-track global index, value: fwd-track global index
-  std::map<uint32_t, uint8_t> fFwdTrackFilterMap;         // key: fwd-track global index, value: fwd-track filter map
-  std::map<uint32_t, uint32_t> fMftIndexMap;              // key: MFT tracklet global index, value: new MFT tracklet global index
+  // index maps of the current dataframe, indexed by the original global index (the global indices are dense), -1 for objects not skimmed
+  std::vector<int32_t> fCollIndexMap;              // index: old collision index, value: skimmed collision index
+  std::vector<uint32_t> fSkimmedCollisions;        // old indices of the skimmed collisions, in ascending order (needed for track to collision indices)
+  std::vector<int32_t> fTrackIndexMap;             // index: old track global index, value: new track global index
+  std::vector<int32_t> fFwdTrackIndexMap;          // index: fwd-track global index, value: new fwd-track global index
+  std::vector<uint32_t> fFwdTrackIndexMapReversed; // fwd-track global indices of the fwd-tracks skimmed for the current collision, in the order of their new global index
+  std::vector<uint8_t> fFwdTrackFilterMap;         // index: fwd-track global index, value: fwd-track filter map
+  std::vector<int32_t> fMftIndexMap;               // index: MFT tracklet global index, value: new MFT tracklet global index
+
+  // skimmed index of an object in one of the index maps, -1 if it is not skimmed or if the index is not valid (e.g. no matched track)
+  static int32_t skimmedIndex(std::vector<int32_t> const& indexMap, int64_t origIdx)
+  {
+    return (origIdx >= 0 && origIdx < static_cast<int64_t>(indexMap.size())) ? indexMap[origIdx] : -1;
+  }
 
   // FIXME: For now, the skimming is done using the Common track-collision association task, which does not allow to use
   //       our own Filtered tracks. If the filter is very selective, then it may be worth to run the association in this workflow
@@ -428,7 +438,8 @@ struct TableMaker {
     // NOTE: So far, collisions are filtered based on the user specified analysis cuts and the filterPP event filter.
     //      The collision-track associations which point to an event that is not selected for writing are discarded!
 
-    fCollIndexMap.clear();
+    fCollIndexMap.assign(collisions.size(), -1);
+    fSkimmedCollisions.clear();
     int multTPC = -1.0;
     float multFV0A = -1.0;
     float multFV0C = -1.0;
@@ -568,6 +579,7 @@ struct TableMaker {
       }
 
       fCollIndexMap[collision.globalIndex()] = event.lastIndex();
+      fSkimmedCollisions.push_back(collision.globalIndex());
     }
   }
 
@@ -649,7 +661,7 @@ struct TableMaker {
       }
 
       // write the track global index in the map for skimming (to make sure we have it just once)
-      if (fTrackIndexMap.find(track.globalIndex()) == fTrackIndexMap.end()) {
+      if (fTrackIndexMap[track.globalIndex()] < 0) {
         // NOTE: The collision ID that is written in the table is the one found in the first association for this track.
         //       However, in data analysis one should loop over associations, so this one should not be used.
         //      In the case of Run2-like analysis, there will be no associations, so this ID will be the one originally assigned in the AO2Ds (updated for the skims)
@@ -703,7 +715,7 @@ struct TableMaker {
       }
 
       // write the MFT track global index in the map for skimming (to make sure we have it just once)
-      if (fMftIndexMap.find(track.globalIndex()) == fMftIndexMap.end()) {
+      if (fMftIndexMap[track.globalIndex()] < 0) {
         uint32_t reducedEventIdx = fCollIndexMap[collision.globalIndex()];
         mftTrack(reducedEventIdx, uint64_t(0), track.pt(), track.eta(), track.phi());
         // TODO: We are not writing the DCA at the moment, because this depend on the collision association
@@ -761,15 +773,15 @@ struct TableMaker {
       trackFilteringTag = trackTempFilterMap; // BIT0-7:  user selection cuts
 
       // update the index map if this is a new muon (it can already exist in the map from a different collision association)
-      if (fFwdTrackIndexMap.find(muon.globalIndex()) == fFwdTrackIndexMap.end()) {
+      if (fFwdTrackIndexMap[muon.globalIndex()] < 0) {
         counter++;
         fFwdTrackIndexMap[muon.globalIndex()] = offset + counter;
-        fFwdTrackIndexMapReversed[offset + counter] = muon.globalIndex();
+        fFwdTrackIndexMapReversed.push_back(muon.globalIndex());
         fFwdTrackFilterMap[muon.globalIndex()] = trackFilteringTag;                                                    // store here the filtering tag so we don't repeat the cuts in the second iteration
-        if (muon.has_matchMCHTrack() && (fFwdTrackIndexMap.find(muon.matchMCHTrackId()) == fFwdTrackIndexMap.end())) { // write also the matched MCH track
+        if (muon.has_matchMCHTrack() && (fFwdTrackIndexMap[muon.matchMCHTrackId()] < 0)) { // write also the matched MCH track
           counter++;
           fFwdTrackIndexMap[muon.matchMCHTrackId()] = offset + counter;
-          fFwdTrackIndexMapReversed[offset + counter] = muon.matchMCHTrackId();
+          fFwdTrackIndexMapReversed.push_back(muon.matchMCHTrackId());
           fFwdTrackFilterMap[muon.matchMCHTrackId()] = trackFilteringTag; // store here the filtering tag so we don't repeat the cuts in the second iteration
         }
       } else {
@@ -781,7 +793,7 @@ struct TableMaker {
 
     // Now we have the full index map of selected muons so we can proceed with writing the muon tables
     // Special care needed for the MCH and MFT indices
-    for (const auto& [skimIdx, origIdx] : fFwdTrackIndexMapReversed) {
+    for (const auto& origIdx : fFwdTrackIndexMapReversed) {
       // get the muon
       auto muon = muons.rawIteratorAt(origIdx);
       uint32_t reducedEventIdx = fCollIndexMap[collision.globalIndex()];
@@ -792,12 +804,8 @@ struct TableMaker {
       uint32_t mchIdx = -1;
       uint32_t mftIdx = -1;
       if (muon.trackType() == uint8_t(0) || muon.trackType() == uint8_t(2)) { // MCH-MID (2) or global (0)
-        if (fFwdTrackIndexMap.find(muon.matchMCHTrackId()) != fFwdTrackIndexMap.end()) {
-          mchIdx = fFwdTrackIndexMap[muon.matchMCHTrackId()];
-        }
-        if (fMftIndexMap.find(muon.matchMFTTrackId()) != fMftIndexMap.end()) {
-          mftIdx = fMftIndexMap[muon.matchMFTTrackId()];
-        }
+        mchIdx = skimmedIndex(fFwdTrackIndexMap, muon.matchMCHTrackId());
+        mftIdx = skimmedIndex(fMftIndexMap, muon.matchMFTTrackId());
       }
       muonBasic(reducedEventIdx, mchIdx, mftIdx, fFwdTrackFilterMap[muon.globalIndex()], muon.pt(), muon.eta(), muon.phi(), muon.sign(), 0);
       muonExtra(muon.nClusters(), muon.pDca(), muon.rAtAbsorberEnd(),
@@ -855,12 +863,12 @@ struct TableMaker {
 
     // skim collisions
     skimCollisions<TEventFillMap>(collisions, bcs, zdcs);
-    if (fCollIndexMap.size() == 0) {
+    if (fSkimmedCollisions.size() == 0) {
       return;
     }
 
     if constexpr (static_cast<bool>(TTrackFillMap)) {
-      fTrackIndexMap.clear();
+      fTrackIndexMap.assign(tracksBarrel.size(), -1);
       trackBasic.reserve(tracksBarrel.size());
       trackBarrel.reserve(tracksBarrel.size());
       trackBarrelInfo.reserve(tracksBarrel.size());
@@ -870,15 +878,15 @@ struct TableMaker {
     }
 
     if constexpr (static_cast<bool>(TMFTFillMap)) {
-      fMftIndexMap.clear();
+      fMftIndexMap.assign(mftTracks.size(), -1);
       mftTrack.reserve(mftTracks.size());
       mftTrackExtra.reserve(mftTracks.size());
       mftAssoc.reserve(mftTracks.size());
     }
 
     if constexpr (static_cast<bool>(TMuonFillMap)) {
-      fFwdTrackIndexMap.clear();
-      fFwdTrackFilterMap.clear();
+      fFwdTrackIndexMap.assign(muons.size(), -1);
+      fFwdTrackFilterMap.assign(muons.size(), 0);
       muonBasic.reserve(muons.size());
       muonExtra.reserve(muons.size());
       muonInfo.reserve(muons.size());
@@ -887,7 +895,7 @@ struct TableMaker {
     }
 
     // loop over selected collisions and select the tracks and fwd tracks to be skimmed
-    for (auto const& [origIdx, skimIdx] : fCollIndexMap) {
+    for (auto const& origIdx : fSkimmedCollisions) {
       auto collision = collisions.rawIteratorAt(origIdx);
       // group the tracks and muons for this collision
       if constexpr (static_cast<bool>(TTrackFillMap)) {
@@ -1302,6 +1302,7 @@ struct AnalysisSameEventPairing {
 
     DefineHistograms(fHistMan, histNames.Data(), fConfigAddSEPHistogram.value.data()); // define all histograms
     VarManager::SetUseVars(fHistMan->GetUsedVars());                                   // provide the list of required variables so that VarManager knows what to fill
+    VarManager::SetUseVarGroup(VarManager::kVarGroupPairVertexing); // the vertexing quantities are written to the extra pair tables
     fOutputList.setObject(fHistMan->GetMainHistogramList());
   }
 
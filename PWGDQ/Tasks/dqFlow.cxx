@@ -41,6 +41,7 @@
 #include "PWGCF/GenericFramework/Core/FlowContainer.h"
 #include "PWGCF/GenericFramework/Core/GFWWeights.h"
 #include "PWGCF/GenericFramework/Core/GFWConfig.h"
+#include "PWGCF/Core/FlatWeightGrid.h"
 #include "Common/DataModel/EventSelection.h"
 #include "Common/Core/TrackSelection.h"
 #include "Common/DataModel/TrackSelectionTables.h"
@@ -132,6 +133,7 @@ struct DQEventQvector {
   // Histograms used for optionnal efficiency and non-uniform acceptance corrections
   struct Config {
     TH1D* mEfficiency = nullptr;
+    FlatWeightGrid<double> mEfficiencyGrid; // contents of mEfficiency, looked up per track
     GFWWeights* mAcceptance = nullptr;
     bool correctionsLoaded = false;
   } cfg;
@@ -233,6 +235,7 @@ struct DQEventQvector {
         LOGF(fatal, "Could not load efficiency histogram for trigger particles from %s", fConfigAcceptance.value.c_str());
       }
       LOGF(info, "Loaded efficiency histogram from %s (%p)", fConfigAcceptance.value.c_str(), (void*)cfg.mEfficiency);
+      cfg.mEfficiencyGrid.build(cfg.mEfficiency);
     }
     cfg.correctionsLoaded = true;
   }
@@ -337,7 +340,7 @@ struct DQEventQvector {
       }
 
       if (cfg.mEfficiency) {
-        weff = cfg.mEfficiency->GetBinContent(cfg.mEfficiency->FindBin(track.pt()));
+        weff = cfg.mEfficiencyGrid.get(track.pt());
       } else {
         weff = 1.0;
       }
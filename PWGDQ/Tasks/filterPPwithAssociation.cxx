@@ -764,6 +764,15 @@ struct DQFilterPPTask {
     // run pairing if there is at least one selection that requires it
     pairFilter = 0;
     if (pairingMask > 0) {
+      // propagate each muon considered for pairing once, instead of once per pair
+      if (fPropMuon) {
+        VarManager::ClearPropagatedMuons();
+        for (auto& a : muonAssocs) {
+          if (pairingMask & a.isDQMuonSelected()) {
+            VarManager::AddPropagatedMuon(a.template fwdtrack_as<TMuons>(), collision);
+          }
+        }
+      }
       // pairing is done using the collision grouped muon associations
       for (auto& [a1, a2] : combinations(muonAssocs, muonAssocs)) {
 
@@ -898,6 +898,10 @@ struct AnalysisSameEventPairing {
   Configurable<bool> fConfigFlatTables{"cfgFlatTables", false, "Produce a single flat tables with all relevant information of the pairs and single tracks"};
   Configurable<bool> fConfigAmbiguousHist{"cfgAmbiHist", false, "Enable Ambiguous histograms for time association studies"};
   Configurable<bool> fConfigMultDimuons{"cfgMultDimuons", false, "Multiplicity for Unlike Dimuons"};
+  Configurable<float> fConfigPairPrefilterMassMin{"cfgPairPrefilterMassMin", 0.0f, "Pair pre-selection before the full pair computation: minimum invariant mass"};
+  Configurable<float> fConfigPairPrefilterMassMax{"cfgPairPrefilterMassMax", -1.0f, "Pair pre-selection: maximum invariant mass, the mass window is not applied if max <= min"};
+  Configurable<float> fConfigPairPrefilterPtMin{"cfgPairPrefilterPtMin", 0.0f, "Pair pre-selection: minimum pair pT"};
+  Configurable<bool> fConfigPairPrefilterOppositeSign{"cfgPairPrefilterOppositeSign", false, "Pair pre-selection: keep only opposite-sign pairs"};
   Configurable<bool> fConfigUseKFVertexing{"cfgUseKFVertexing", false, "Use KF Particle for secondary vertex reconstruction (DCAFitter is used by default)"};
   Configurable<bool> fUseRemoteField{"cfgUseRemoteField", false, "Chose whether to fetch the magnetic field from ccdb or set it manually"};
   Configurable<float> fConfigMagField{"cfgMagField", 5.0f, "Manually set magnetic field"};
@@ -930,10 +934,12 @@ struct AnalysisSameEventPairing {
   std::vector<std::vector<TString>> fMuonHistNames;
   std::vector<std::vector<TString>> fTrackMuonHistNames;
   std::vector<AnalysisCompositeCut> fPairCuts;
+  bool fApplyPairPrefilter = false; // true if any of the pair pre-selection configurables is enabled
 
   void init(o2::framework::InitContext& context)
   {
     fCurrentRun = 0;
+    fApplyPairPrefilter = fConfigPairPrefilterOppositeSign.value || (fConfigPairPrefilterPtMin.value > 0.0f) || (fConfigPairPrefilterMassMax.value > fConfigPairPrefilterMassMin.value);
 
     ccdb->setURL(ccdburl.value);
     ccdb->setCaching(true);
@@ -1079,10 +1085,32 @@ struct AnalysisSameEventPairing {
 
     DefineHistograms(fHistMan, histNames.Data(), fConfigAddSEPHistogram); // define all histograms
     VarManager::SetUseVars(fHistMan->GetUsedVars());                      // provide the list of required variables so that VarManager knows what to fill
+    VarManager::SetUseVarGroup(VarManager::kVarGroupPairVertexing); // the vertexing quantities are written to the extra pair tables
     fOutputList.setObject(fHistMan->GetMainHistogramList());
   }
 
   // Template function to run same event pairing (barrel-barrel, muon-muon, barrel-muon)
+  template <int TPairType, typename T1, typename T2>
+  bool passPairPrefilter(T1 const& t1, T2 const& t2)
+  {
+    // cheap selection on the pair charge and kinematics, applied before the full FillPair() / FillPairVertexing()
+    if (fConfigPairPrefilterOppositeSign.value && t1.sign() * t2.sign() > 0) {
+      return false;
+    }
+    if (fConfigPairPrefilterPtMin.value <= 0.0f && fConfigPairPrefilterMassMax.value <= fConfigPairPrefilterMassMin.value) {
+      return true;
+    }
+    float mass = 0.0f, pt = 0.0f;
+    VarManager::ComputePairMassPt<TPairType>(t1, t2, mass, pt);
+    if (pt < fConfigPairPrefilterPtMin.value) {
+      return false;
+    }
+    if (fConfigPairPrefilterMassMax.value > fConfigPairPrefilterMassMin.value && (mass < fConfigPairPrefilterMassMin.value || mass > fConfigPairPrefilterMassMax.value)) {
+      return false;
+    }
+    return true;
+  }
+
   template <bool TTwoProngFitter, int TPairType, uint32_t TEventFillMap, uint32_t TTrackFillMap, typename TEvent, typename TTracks1, typename TTracks2>
   void runSameEventPairing(TEvent const& event, TTracks1 const& tracks1, TTracks2 const& tracks2)
   {
@@ -1174,6 +1202,9 @@ struct AnalysisSameEventPairing {
       if (!twoTrackFilter) { // the tracks must have at least one filter bit in common to continue
         continue;
       }
+      if (fApplyPairPrefilter && !passPairPrefilter<TPairType>(t1, t2)) {
+        continue;
+      }
       constexpr bool eventHasQvector = ((TEventFillMap & VarManager::ObjTypes::ReducedEventQvector) > 0);
       constexpr bool eventHasQvectorCentr = ((TEventFillMap & VarManager::ObjTypes::CollisionQvect) > 0);
 
@@ -848,6 +848,10 @@ struct AnalysisSameEventPairing {
   Configurable<std::string> fConfigGeoPath{"geoPath", "GLO/Config/GeometryAligned", "Path of the geometry file"};
   Configurable<std::string> fConfigCollisionSystem{"syst", "pp", "Collision system, pp or PbPb"};
   Configurable<float> fConfigCenterMassEnergy{"energy", 13600, "Center of mass energy in GeV"};
+  Configurable<float> fConfigPairPrefilterMassMin{"cfgPairPrefilterMassMin", 0.0f, "Pair pre-selection before the full pair computation: minimum invariant mass"};
+  Configurable<float> fConfigPairPrefilterMassMax{"cfgPairPrefilterMassMax", -1.0f, "Pair pre-selection: maximum invariant mass, the mass window is not applied if max <= min"};
+  Configurable<float> fConfigPairPrefilterPtMin{"cfgPairPrefilterPtMin", 0.0f, "Pair pre-selection: minimum pair pT"};
+  Configurable<bool> fConfigPairPrefilterOppositeSign{"cfgPairPrefilterOppositeSign", false, "Pair pre-selection: keep only opposite-sign pairs"};
 
   Service<o2::ccdb::BasicCCDBManager> fCCDB;
 
@@ -871,6 +875,7 @@ struct AnalysisSameEventPairing {
   bool fEnableBarrelHistos;
   bool fEnableMuonHistos;
   bool fEnableMuonMixingHistos;
+  bool fApplyPairPrefilter; // true if any of the pair pre-selection configurables is enabled
 
   NoBinningPolicy<aod::dqanalysisflags::MixingHash> hashBin;
 
@@ -1014,6 +1019,7 @@ struct AnalysisSameEventPairing {
     }
 
     fCurrentRun = 0;
+    fApplyPairPrefilter = fConfigPairPrefilterOppositeSign.value || (fConfigPairPrefilterPtMin.value > 0.0f) || (fConfigPairPrefilterMassMax.value > fConfigPairPrefilterMassMin.value);
 
     fCCDB->setURL(fConfigCcdbUrl.value);
     fCCDB->setCaching(true);
@@ -1072,6 +1078,7 @@ struct AnalysisSameEventPairing {
 
     DefineHistograms(fHistMan, histNames.Data(), fConfigAddSEPHistogram.value.data()); // define all histograms
     VarManager::SetUseVars(fHistMan->GetUsedVars());                                   // provide the list of required variables so that VarManager knows what to fill
+    VarManager::SetUseVarGroup(VarManager::kVarGroupPairVertexing); // the vertexing quantities are written to the extra pair tables
     fOutputList.setObject(fHistMan->GetMainHistogramList());
   }
 
@@ -1111,6 +1118,27 @@ struct AnalysisSameEventPairing {
   }
 
   // Template function to run same event pairing (barrel-barrel, muon-muon, barrel-muon)
+  template <int TPairType, typename T1, typename T2>
+  bool passPairPrefilter(T1 const& t1, T2 const& t2)
+  {
+    // cheap selection on the pair charge and kinematics, applied before the full FillPair() / FillPairVertexing()
+    if (fConfigPairPrefilterOppositeSign.value && t1.sign() * t2.sign() > 0) {
+      return false;
+    }
+    if (fConfigPairPrefilterPtMin.value <= 0.0f && fConfigPairPrefilterMassMax.value <= fConfigPairPrefilterMassMin.value) {
+      return true;
+    }
+    float mass = 0.0f, pt = 0.0f;
+    VarManager::ComputePairMassPt<TPairType>(t1, t2, mass, pt);
+    if (pt < fConfigPairPrefilterPtMin.value) {
+      return false;
+    }
+    if (fConfigPairPrefilterMassMax.value > fConfigPairPrefilterMassMin.value && (mass < fConfigPairPrefilterMassMin.value || mass > fConfigPairPrefilterMassMax.value)) {
+      return false;
+    }
+    return true;
+  }
+
   template <bool TTwoProngFitter, int TPairType, uint32_t TEventFillMap, uint32_t TTrackFillMap, typename TEvents, typename TTrackAssocs, typename TTracks>
   void runSameEventPairing(TEvents const& events, Preslice<TTrackAssocs>& preslice, TTrackAssocs const& assocs, TTracks const& /*tracks*/)
   {
@@ -1183,6 +1211,9 @@ struct AnalysisSameEventPairing {
 
           auto t1 = a1.template reducedtrack_as<TTracks>();
           auto t2 = a2.template reducedtrack_as<TTracks>();
+          if (fApplyPairPrefilter && !passPairPrefilter<TPairType>(t1, t2)) {
+            continue;
+          }
           sign1 = t1.sign();
           sign2 = t2.sign();
           // store the ambiguity number of the two dilepton legs in the last 4 digits of the two-track filter
@@ -1239,6 +1270,9 @@ struct AnalysisSameEventPairing {
 
           auto t1 = a1.template reducedmuon_as<TTracks>();
           auto t2 = a2.template reducedmuon_as<TTracks>();
+          if (fApplyPairPrefilter && !passPairPrefilter<TPairType>(t1, t2)) {
+            continue;
+          }
           sign1 = t1.sign();
           sign2 = t2.sign();
 
@@ -1739,6 +1773,7 @@ struct AnalysisAsymmetricPairing {
 
     DefineHistograms(fHistMan, histNames.Data(), fConfigHistogramSubgroups.value.data()); // define all histograms
     VarManager::SetUseVars(fHistMan->GetUsedVars());                                   // provide the list of required variables so that VarManager knows what to fill
+    VarManager::SetUseVarGroup(VarManager::kVarGroupPairVertexing); // the vertexing quantities are written to the extra pair tables
     fOutputList.setObject(fHistMan->GetMainHistogramList());
   }
 
@@ -278,6 +278,7 @@ struct DielectronMlPair {
   Configurable<bool> loadModelsFromCCDB{"loadModelsFromCCDB", false, "Flag to enable or disable the loading of models from CCDB"};
   // table output
   Configurable<bool> fillScoreTable{"fillScoreTable", false, "fill table with scores from ML model"};
+  Configurable<int> batchSize{"batchSize", 1024, "Number of pairs evaluated in one batched model inference"};
 
   o2::analysis::MlResponseDielectronPair<float> mlResponse;
   o2::ccdb::CcdbApi ccdbApi;
@@ -309,34 +310,58 @@ struct DielectronMlPair {
     }
   }
 
-  void processPair(DielectronsExtra const& dielectrons, MySkimmedTracks const&)
+  std::vector<o2::analysis::DielectronPairTrackFeatures> trackFeatures; // single-track quantities of the pair features, indexed by track
+  std::vector<float> pairFeatures;                                      // input features of one pair
+  std::vector<double> pairMasses;                                       // masses of the queued pairs
+
+  // score the queued pairs and fill the outputs in the order of the pairs
+  void flushPairs()
+  {
+    std::size_t nPairs = mlResponse.flush();
+    const auto& scores = mlResponse.getFlushedScores();
+    const auto& selections = mlResponse.getFlushedSelections();
+    for (std::size_t iPair = 0; iPair < nPairs; iPair++) {
+      const float* outputMl = scores.data() + iPair * nClassesMl;
+      for (int classMl = 0; classMl < nClassesMl; classMl++) {
+        hModelScore[classMl]->Fill(outputMl[classMl]);
+        hModelScoreVsM[classMl]->Fill(outputMl[classMl], pairMasses[iPair]);
+      }
+      pairSelection(selections[iPair]);
+      if (fillScoreTable) {
+        pairScore(std::vector<float>{outputMl, outputMl + nClassesMl});
+      }
+    }
+    pairMasses.clear();
+  }
+
+  void processPair(DielectronsExtra const& dielectrons, MySkimmedTracks const& tracks)
   {
     // dummy value for magentic field. ToDo: take it from ccdb!
     float d_bz = 1.;
     mlResponse.setBz(d_bz);
+
+    // the single-track quantities are computed once per track, not once per pair
+    trackFeatures.clear();
+    trackFeatures.reserve(tracks.size());
+    for (const auto& track : tracks) {
+      trackFeatures.emplace_back(mlResponse.getTrackFeatures(track));
+    }
+
     for (const auto& dielectron : dielectrons) {
-      const auto& track1 = dielectron.index0_as<MySkimmedTracks>();
-      const auto& track2 = dielectron.index1_as<MySkimmedTracks>();
-      if (track1.sign() == track2.sign()) {
+      const auto& track1 = trackFeatures[dielectron.index0Id()];
+      const auto& track2 = trackFeatures[dielectron.index1Id()];
+      if (track1.sign == track2.sign) {
         continue;
       }
-      ROOT::Math::PtEtaPhiMVector v1(track1.pt(), track1.eta(), track1.phi(), o2::constants::physics::MassElectron);
-      ROOT::Math::PtEtaPhiMVector v2(track2.pt(), track2.eta(), track2.phi(), o2::constants::physics::MassElectron);
-      ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
-      auto m = v12.M();
-      std::vector<float> inputFeatures = mlResponse.getInputFeatures(track1, track2);
-      std::vector<float> outputMl = {};
-
-      bool isSelected = mlResponse.isSelectedMl(inputFeatures, m, outputMl);
-      for (int classMl = 0; classMl < nClassesMl; classMl++) {
-        hModelScore[classMl]->Fill(outputMl[classMl]);
-        hModelScoreVsM[classMl]->Fill(outputMl[classMl], m);
-      }
-      pairSelection(isSelected);
-      if (fillScoreTable) {
-        pairScore(outputMl);
+      pairFeatures.clear();
+      double m = mlResponse.fillInputFeatures(track1, track2, pairFeatures);
+      mlResponse.enqueue(pairFeatures, mlResponse.getBinIndex(m), dielectron.globalIndex());
+      pairMasses.push_back(m);
+      if (static_cast<int>(pairMasses.size()) >= batchSize) {
+        flushPairs();
       }
     }
+    flushPairs();
   }
   PROCESS_SWITCH(DielectronMlPair, processPair, "Apply ML selection at pair level", false);
 
@@ -1007,6 +1007,15 @@ struct AnalysisSameEventPairing {
   std::vector<std::shared_ptr<TH2>> fHistRecPair;
   std::vector<std::shared_ptr<TH2>> fHistRecPairMC;
 
+  // generated electron legs of the current MC collision
+  struct GenLeg {
+    TLorentzVector vec;
+    TLorentzVector vecSmeared;
+    bool fiducial = false;
+    bool fiducialSmeared = true;
+  };
+  std::vector<GenLeg> fGenLegs;
+
   // QA
   HistogramManager* fHistManQA; // histo manager
 
@@ -1213,95 +1222,100 @@ struct AnalysisSameEventPairing {
     //
     Double_t masse = 0.00051099895; // 0.5 MeV/c2 -> 0.0005 GeV/c2
 
-    for (auto& [t1, t2] : combinations(soa::CombinationsStrictlyUpperIndexPolicy(groupedMCTracks, groupedMCTracks))) {
-      // for (auto& [t1, t2] : combinations(groupedMCTracks, groupedMCTracks)) {
-
-      if ((abs(t1.pdgCode()) != 11) || (abs(t2.pdgCode()) != 11))
+    // The electron legs are selected and their kinematics computed once per MC particle,
+    // the pairs are then formed only among them, in the same order as the combinations of all MC particles
+    std::vector<std::decay_t<decltype(groupedMCTracks.begin())>> legs;
+    fGenLegs.clear();
+    for (auto& mctrack : groupedMCTracks) {
+      if (abs(mctrack.pdgCode()) != 11)
         continue;
-      // if (!t1.producedByGenerator() || !t2.producedByGenerator())
+      // if (!mctrack.producedByGenerator())
       //   continue;
-      if (fConfigIsPrimary) {
-        if (!t1.isPhysicalPrimary() || !t2.isPhysicalPrimary())
-          continue;
-      }
-      if (!fConfigFillLS && (t1.pdgCode() * t2.pdgCode() > 0))
-        continue; // ULS only
-
+      if (fConfigIsPrimary && !mctrack.isPhysicalPrimary())
+        continue;
+      legs.push_back(mctrack);
+      GenLeg leg;
       // True MC values
-      TLorentzVector Lvec1;
-      TLorentzVector Lvec2;
-      Lvec1.SetPtEtaPhiM(t1.pt(), t1.eta(), t1.phi(), masse);
-      Lvec2.SetPtEtaPhiM(t2.pt(), t2.eta(), t2.phi(), masse);
-      TLorentzVector LvecM = Lvec1 + Lvec2;
-      double mass = LvecM.M();
-      double pairpt = LvecM.Pt();
-      // Smeared MC values
-      double masssmeared = -1.;
-      double pairptsmeared = -1.;
+      leg.vec.SetPtEtaPhiM(mctrack.pt(), mctrack.eta(), mctrack.phi(), masse);
+      // Fiducial cut MC value
+      leg.fiducial = !((mctrack.eta() > fConfigMaxEta) || (mctrack.eta() < fConfigMinEta) || (mctrack.pt() > fConfigMaxPt) || (mctrack.pt() < fConfigMinPt));
       if constexpr (smeared) {
-        TLorentzVector Lvec1smeared;
-        TLorentzVector Lvec2smeared;
-        Lvec1smeared.SetPtEtaPhiM(t1.ptSmeared(), t1.etaSmeared(), t1.phiSmeared(), masse);
-        Lvec2smeared.SetPtEtaPhiM(t2.ptSmeared(), t2.etaSmeared(), t2.phiSmeared(), masse);
-        TLorentzVector LvecMsmeared = Lvec1smeared + Lvec2smeared;
-        masssmeared = LvecMsmeared.M();
-        pairptsmeared = LvecMsmeared.Pt();
+        // Smeared MC values
+        leg.vecSmeared.SetPtEtaPhiM(mctrack.ptSmeared(), mctrack.etaSmeared(), mctrack.phiSmeared(), masse);
+        // Fiducial cut Smeared values
+        leg.fiducialSmeared = !((mctrack.etaSmeared() > fConfigMaxEta) || (mctrack.etaSmeared() < fConfigMinEta) || (mctrack.ptSmeared() > fConfigMaxPt) || (mctrack.ptSmeared() < fConfigMinPt));
       }
+      fGenLegs.push_back(leg);
+    }
 
-      // Fiducial cut MC value
-      Bool_t genfidcut = kTRUE;
-      if ((t1.eta() > fConfigMaxEta) || (t2.eta() > fConfigMaxEta) || (t1.eta() < fConfigMinEta) || (t2.eta() < fConfigMinEta) || (t1.pt() > fConfigMaxPt) || (t2.pt() > fConfigMaxPt) || (t1.pt() < fConfigMinPt) || (t2.pt() < fConfigMinPt))
-        genfidcut = kFALSE;
+    for (size_t i1 = 0; i1 < legs.size(); i1++) {
+      for (size_t i2 = i1 + 1; i2 < legs.size(); i2++) {
+        fillMCGenPair<smeared>(groupedMCTracks, legs[i1], legs[i2], fGenLegs[i1], fGenLegs[i2]);
+      }
+    } // end of true pairing loop
+  }   // end runMCGen
 
-      // Fiducial cut Smeared values
-      Bool_t genfidcutsmeared = kTRUE;
-      if constexpr (smeared) {
-        if ((t1.etaSmeared() > fConfigMaxEta) || (t2.etaSmeared() > fConfigMaxEta) || (t1.etaSmeared() < fConfigMinEta) || (t2.etaSmeared() < fConfigMinEta) || (t1.ptSmeared() > fConfigMaxPt) || (t2.ptSmeared() > fConfigMaxPt) || (t1.ptSmeared() < fConfigMinPt) || (t2.ptSmeared() < fConfigMinPt))
-          genfidcutsmeared = kFALSE;
+  template <bool smeared, typename TTracksMC, typename TTrackMC>
+  void fillMCGenPair(TTracksMC const& groupedMCTracks, TTrackMC const& t1, TTrackMC const& t2, GenLeg const& leg1, GenLeg const& leg2)
+  {
+    if (!fConfigFillLS && (t1.pdgCode() * t2.pdgCode() > 0))
+      return; // ULS only
+
+    TLorentzVector LvecM = leg1.vec + leg2.vec;
+    double mass = LvecM.M();
+    double pairpt = LvecM.Pt();
+    double masssmeared = -1.;
+    double pairptsmeared = -1.;
+    if constexpr (smeared) {
+      TLorentzVector LvecMsmeared = leg1.vecSmeared + leg2.vecSmeared;
+      masssmeared = LvecMsmeared.M();
+      pairptsmeared = LvecMsmeared.Pt();
+    }
+
+    Bool_t genfidcut = leg1.fiducial && leg2.fiducial;
+    Bool_t genfidcutsmeared = leg1.fiducialSmeared && leg2.fiducialSmeared;
+
+    int isig = 0;
+    for (auto sig = fMCSignals.begin(); sig != fMCSignals.end(); sig++, isig++) {
+      bool checked = false;
+      if constexpr (soa::is_soa_filtered_v<TTracksMC>) {
+        auto t1_raw = groupedMCTracks.rawIteratorAt(t1.globalIndex());
+        auto t2_raw = groupedMCTracks.rawIteratorAt(t2.globalIndex());
+        checked = (*sig).CheckSignal(true, t1_raw, t2_raw);
+      } else {
+        checked = (*sig).CheckSignal(true, t1, t2);
       }
+      if (checked) {
 
-      int isig = 0;
-      for (auto sig = fMCSignals.begin(); sig != fMCSignals.end(); sig++, isig++) {
-        bool checked = false;
-        if constexpr (soa::is_soa_filtered_v<TTracksMC>) {
-          auto t1_raw = groupedMCTracks.rawIteratorAt(t1.globalIndex());
-          auto t2_raw = groupedMCTracks.rawIteratorAt(t2.globalIndex());
-          checked = (*sig).CheckSignal(true, t1_raw, t2_raw);
-        } else {
-          checked = (*sig).CheckSignal(true, t1, t2);
+        // not smeared after fiducial cuts
+        if (genfidcut) {
+          if (!fConfigFillLS) {
+            fHistGenPair[isig]->Fill(mass, pairpt);
+          } else {
+            if (t1.pdgCode() * t2.pdgCode() < 0) {
+              fHistGenPair[isig * 2]->Fill(mass, pairpt);
+            } else {
+              fHistGenPair[isig * 2 + 1]->Fill(mass, pairpt);
+            }
+          }
         }
-        if (checked) {
-
-          // not smeared after fiducial cuts
-          if (genfidcut) {
+        // Smeared
+        if constexpr (smeared) {
+          if (genfidcutsmeared) {
             if (!fConfigFillLS) {
-              fHistGenPair[isig]->Fill(mass, pairpt);
+              fHistGenSmearedPair[isig]->Fill(masssmeared, pairptsmeared);
             } else {
               if (t1.pdgCode() * t2.pdgCode() < 0) {
-                fHistGenPair[isig * 2]->Fill(mass, pairpt);
+                fHistGenSmearedPair[isig * 2]->Fill(masssmeared, pairptsmeared);
               } else {
-                fHistGenPair[isig * 2 + 1]->Fill(mass, pairpt);
-              }
-            }
-          }
-          // Smeared
-          if constexpr (smeared) {
-            if (genfidcutsmeared) {
-              if (!fConfigFillLS) {
-                fHistGenSmearedPair[isig]->Fill(masssmeared, pairptsmeared);
-              } else {
-                if (t1.pdgCode() * t2.pdgCode() < 0) {
-                  fHistGenSmearedPair[isig * 2]->Fill(masssmeared, pairptsmeared);
-                } else {
-                  fHistGenSmearedPair[isig * 2 + 1]->Fill(masssmeared, pairptsmeared);
-                }
+                fHistGenSmearedPair[isig * 2 + 1]->Fill(masssmeared, pairptsmeared);
               }
             }
           }
         }
       }
-    } // end of true pairing loop
-  }   // end runMCGen
+    }
+  }
 
   template <uint32_t TTrackFillMap, typename TTracks, typename TTracksMC>
   void runRecPair(TTracks const& tracks, TTracksMC const& /*tracksMC*/)
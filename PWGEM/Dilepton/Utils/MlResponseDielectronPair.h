@@ -65,6 +65,16 @@ enum class InputFeaturesDielectronPair : uint8_t {
   pairDcaZ
 };
 
+/// Single-track quantities entering the pair features, computed once per track and shared by all its pairs
+struct DielectronPairTrackFeatures {
+  float pt = 0.f;
+  float eta = 0.f;
+  float phi = 0.f;
+  int sign = 0;
+  double dcaXYSig2 = 0.; // (DCAxy / sigma)^2
+  double dcaZSig2 = 0.;  // (DCAz / sigma)^2
+};
+
 template <typename TypeOutputScore = float>
 class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
 {
@@ -74,20 +84,53 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
   /// Default destructor
   virtual ~MlResponseDielectronPair() = default;
 
+  /// Method to get the single-track quantities entering the pair features
+  /// \param t is the track
+  template <typename T>
+  DielectronPairTrackFeatures getTrackFeatures(T const& t)
+  {
+    DielectronPairTrackFeatures features;
+    features.pt = t.pt();
+    features.eta = t.eta();
+    features.phi = t.phi();
+    features.sign = t.sign();
+    features.dcaXYSig2 = pow(t.dcaXY() / sqrt(t.cYY()), 2);
+    features.dcaZSig2 = pow(t.dcaZ() / sqrt(t.cZZ()), 2);
+    return features;
+  }
+
   template <typename T>
   float pair_dca_xy(T const& t1, T const& t2)
   {
-    return sqrt((pow(t1.dcaXY() / sqrt(t1.cYY()), 2) + pow(t2.dcaXY() / sqrt(t2.cYY()), 2)) / 2.);
+    return pair_dca_xy(getTrackFeatures(t1), getTrackFeatures(t2));
+  }
+
+  float pair_dca_xy(DielectronPairTrackFeatures const& t1, DielectronPairTrackFeatures const& t2)
+  {
+    return sqrt((t1.dcaXYSig2 + t2.dcaXYSig2) / 2.);
   }
 
   template <typename T>
   float pair_dca_z(T const& t1, T const& t2)
   {
-    return sqrt((pow(t1.dcaZ() / sqrt(t1.cZZ()), 2) + pow(t2.dcaZ() / sqrt(t2.cZZ()), 2)) / 2.);
+    return pair_dca_z(getTrackFeatures(t1), getTrackFeatures(t2));
+  }
+
+  float pair_dca_z(DielectronPairTrackFeatures const& t1, DielectronPairTrackFeatures const& t2)
+  {
+    return sqrt((t1.dcaZSig2 + t2.dcaZSig2) / 2.);
   }
 
   template <typename T>
   float get_phiv(T const& t1, T const& t2)
+  {
+    ROOT::Math::PtEtaPhiMVector v1(t1.pt(), t1.eta(), t1.phi(), o2::constants::physics::MassElectron);
+    ROOT::Math::PtEtaPhiMVector v2(t2.pt(), t2.eta(), t2.phi(), o2::constants::physics::MassElectron);
+    return get_phiv(v1, v2, v1 + v2, t1.sign(), t2.sign());
+  }
+
+  /// phiv from the four-momenta of the legs and of the pair
+  float get_phiv(ROOT::Math::PtEtaPhiMVector v1, ROOT::Math::PtEtaPhiMVector v2, ROOT::Math::PtEtaPhiMVector const& v12, const int sign1, const int sign2)
   {
     // cos(phiv) = w*a /|w||a|
     // with w = u x v
@@ -95,10 +138,6 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
     // u = v12 / |v12|            , the unit vector of v12
     // v = v1 x v2 / |v1 x v2|    , unit vector perpendicular to v1 and v2
 
-    ROOT::Math::PtEtaPhiMVector v1(t1.pt(), t1.eta(), t1.phi(), o2::constants::physics::MassElectron);
-    ROOT::Math::PtEtaPhiMVector v2(t2.pt(), t2.eta(), t2.phi(), o2::constants::physics::MassElectron);
-    ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
-
     bool swapTracks = false;
     if (v1.Pt() < v2.Pt()) { // ordering of track, pt1 > pt2
       ROOT::Math::PtEtaPhiMVector v3 = v1;
@@ -110,9 +149,9 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
     // momentum of e+ and e- in (ax,ay,az) axis. Note that az=0 by definition.
     // vector product of pep X pem
     float vpx = 0, vpy = 0, vpz = 0;
-    if (t1.sign() * t2.sign() > 0) { // Like Sign
+    if (sign1 * sign2 > 0) { // Like Sign
       if (!swapTracks) {
-        if (d_bz * t1.sign() < 0) {
+        if (d_bz * sign1 < 0) {
           vpx = v1.Py() * v2.Pz() - v1.Pz() * v2.Py();
           vpy = v1.Pz() * v2.Px() - v1.Px() * v2.Pz();
           vpz = v1.Px() * v2.Py() - v1.Py() * v2.Px();
@@ -122,7 +161,7 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
           vpz = v2.Px() * v1.Py() - v2.Py() * v1.Px();
         }
       } else { // swaped tracks
-        if (d_bz * t2.sign() < 0) {
+        if (d_bz * sign2 < 0) {
           vpx = v1.Py() * v2.Pz() - v1.Pz() * v2.Py();
           vpy = v1.Pz() * v2.Px() - v1.Px() * v2.Pz();
           vpz = v1.Px() * v2.Py() - v1.Py() * v2.Px();
@@ -134,7 +173,7 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
       }
     } else { // Unlike Sign
       if (!swapTracks) {
-        if (d_bz * t1.sign() > 0) {
+        if (d_bz * sign1 > 0) {
           vpx = v1.Py() * v2.Pz() - v1.Pz() * v2.Py();
           vpy = v1.Pz() * v2.Px() - v1.Px() * v2.Pz();
           vpz = v1.Px() * v2.Py() - v1.Py() * v2.Px();
@@ -144,7 +183,7 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
           vpz = v2.Px() * v1.Py() - v2.Py() * v1.Px();
         }
       } else { // swaped tracks
-        if (d_bz * t2.sign() > 0) {
+        if (d_bz * sign2 > 0) {
           vpx = v1.Py() * v2.Pz() - v1.Pz() * v2.Py();
           vpy = v1.Pz() * v2.Px() - v1.Px() * v2.Pz();
           vpz = v1.Px() * v2.Py() - v1.Py() * v2.Px();
@@ -188,8 +227,19 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
   std::vector<float> getInputFeatures(T const& t1, T const& t2)
   {
     std::vector<float> inputFeatures;
-    ROOT::Math::PtEtaPhiMVector v1(t1.pt(), t1.eta(), t1.phi(), o2::constants::physics::MassElectron);
-    ROOT::Math::PtEtaPhiMVector v2(t2.pt(), t2.eta(), t2.phi(), o2::constants::physics::MassElectron);
+    fillInputFeatures(getTrackFeatures(t1), getTrackFeatures(t2), inputFeatures);
+    return inputFeatures;
+  }
+
+  /// Method to append the input features of a pair to a buffer (e.g. a batch of pairs to be passed to MlResponse::enqueue)
+  /// \param t1 are the single-track quantities of the first track
+  /// \param t2 are the single-track quantities of the second track
+  /// \param inputFeatures is the buffer
+  /// \return invariant mass of the pair
+  double fillInputFeatures(DielectronPairTrackFeatures const& t1, DielectronPairTrackFeatures const& t2, std::vector<float>& inputFeatures)
+  {
+    ROOT::Math::PtEtaPhiMVector v1(t1.pt, t1.eta, t1.phi, o2::constants::physics::MassElectron);
+    ROOT::Math::PtEtaPhiMVector v2(t2.pt, t2.eta, t2.phi, o2::constants::physics::MassElectron);
     ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
 
     for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
@@ -198,13 +248,16 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
         CHECK_AND_FILL_VEC_DIELECTRON_PAIR(pt, Pt);
         CHECK_AND_FILL_VEC_DIELECTRON_PAIR(eta, Eta);
         CHECK_AND_FILL_VEC_DIELECTRON_PAIR(phi, Phi);
-        CHECK_AND_FILL_VEC_DIELECTRON_PAIR_FUNC(phiv, get_phiv);
+        case static_cast<uint8_t>(InputFeaturesDielectronPair::phiv): {
+          inputFeatures.emplace_back(get_phiv(v1, v2, v12, t1.sign, t2.sign));
+          break;
+        }
         CHECK_AND_FILL_VEC_DIELECTRON_PAIR_FUNC(pairDcaXY, pair_dca_xy);
         CHECK_AND_FILL_VEC_DIELECTRON_PAIR_FUNC(pairDcaZ, pair_dca_z);
       }
     }
 
-    return inputFeatures;
+    return v12.M();
   }
 
   void setBz(float bz)
@@ -15,7 +15,13 @@
 #ifndef PWGEM_DILEPTON_UTILS_MOMENTUMSMEARER_H_
 #define PWGEM_DILEPTON_UTILS_MOMENTUMSMEARER_H_
 
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <TAxis.h>
 #include <TH1D.h>
+#include <TMath.h>
+#include <TRandom.h>
 #include <TString.h>
 #include <TGrid.h>
 #include <TObjArray.h>
@@ -85,6 +91,7 @@ class MomentumSmearer
     if (!fArrResoPhi_Neg) {
       LOGP(fatal, "Could not open {} from file {}", fResPhiNegHistName.Data(), fResFileName.Data());
     }
+    buildResolutionTables();
   }
 
   /*template <typename T>
@@ -153,6 +160,7 @@ class MomentumSmearer
       if (!fArrResoPhi_Neg) {
         LOGP(fatal, "Could not open {} from file {}", fResPhiNegHistName.Data(), fResFileName.Data());
       }
+      buildResolutionTables();
     }
     delete listRes;
 
@@ -206,6 +214,7 @@ class MomentumSmearer
       } else {
         LOGP(fatal, "Could not identify type of histogram {}", fEffHistName.Data());
       }
+      fEffTable.build(reinterpret_cast<TH1*>(fArrEff), fEffType);
     }
     delete listEff;
 
@@ -221,51 +230,19 @@ class MomentumSmearer
       return;
     }
     // smear pt
-    int ptbin = reinterpret_cast<TH2D*>(fArrResoPt->At(0))->GetXaxis()->FindBin(ptgen);
-    if (ptbin < 1) {
-      ptbin = 1;
-    }
-    if (ptbin > fArrResoPt->GetLast()) {
-      ptbin = fArrResoPt->GetLast();
-    }
-    float smearing = 0.;
-    TH1D* thisHist = reinterpret_cast<TH1D*>(fArrResoPt->At(ptbin));
-    if (thisHist->GetEntries() > 0) {
-      smearing = thisHist->GetRandom() * ptgen;
-    }
+    float smearing = fResoPtTable.sample(ptgen) * ptgen;
     ptsmeared = ptgen - smearing;
 
     // smear eta
-    ptbin = reinterpret_cast<TH2D*>(fArrResoEta->At(0))->GetXaxis()->FindBin(ptgen);
-    if (ptbin < 1) {
-      ptbin = 1;
-    }
-    if (ptbin > fArrResoEta->GetLast()) {
-      ptbin = fArrResoEta->GetLast();
-    }
-    smearing = 0.;
-    thisHist = reinterpret_cast<TH1D*>(fArrResoEta->At(ptbin));
-    if (thisHist->GetEntries() > 0) {
-      smearing = thisHist->GetRandom();
-    }
+    smearing = fResoEtaTable.sample(ptgen);
     etasmeared = etagen - smearing;
 
-    // smear phi
-    ptbin = reinterpret_cast<TH2D*>(fArrResoPhi_Pos->At(0))->GetXaxis()->FindBin(ptgen);
-    if (ptbin < 1) {
-      ptbin = 1;
-    }
-    if (ptbin > fArrResoPhi_Pos->GetLast()) {
-      ptbin = fArrResoPhi_Pos->GetLast();
-    }
-    smearing = 0.;
+    // smear phi, the pt bin is found with the binning of the positive map
+    int ptbin = fResoPhiPosTable.findPtBin(ptgen);
     if (ch < 0) {
-      thisHist = reinterpret_cast<TH1D*>(fArrResoPhi_Neg->At(ptbin));
+      smearing = fResoPhiNegTable.sampleBin(ptbin);
     } else {
-      thisHist = reinterpret_cast<TH1D*>(fArrResoPhi_Pos->At(ptbin));
-    }
-    if (thisHist->GetEntries() > 0) {
-      smearing = thisHist->GetRandom();
+      smearing = fResoPhiPosTable.sampleBin(ptbin);
     }
     phismeared = phigen - smearing;
   }
@@ -277,61 +254,7 @@ class MomentumSmearer
       return 1.;
     }
 
-    if (fEffType == 1) {
-      TH1F* hist = reinterpret_cast<TH1F*>(fArrEff);
-      int ptbin = hist->GetXaxis()->FindBin(pt);
-      int ptbin_max = hist->GetXaxis()->GetNbins();
-      // make sure that no underflow or overflow bins are used
-      if (ptbin < 1)
-        ptbin = 1;
-      else if (ptbin > ptbin_max)
-        ptbin = ptbin_max;
-      return hist->GetBinContent(ptbin);
-    }
-
-    if (fEffType == 2) {
-      TH2F* hist = reinterpret_cast<TH2F*>(fArrEff);
-      int ptbin = hist->GetXaxis()->FindBin(pt);
-      int ptbin_max = hist->GetXaxis()->GetNbins();
-      int etabin = hist->GetYaxis()->FindBin(eta);
-      int etabin_max = hist->GetYaxis()->GetNbins();
-      // make sure that no underflow or overflow bins are used
-      if (ptbin < 1)
-        ptbin = 1;
-      else if (ptbin > ptbin_max)
-        ptbin = ptbin_max;
-      if (etabin < 1)
-        etabin = 1;
-      else if (etabin > etabin_max)
-        etabin = etabin_max;
-      return hist->GetBinContent(ptbin, etabin);
-    }
-
-    if (fEffType == 3) {
-      TH3F* hist = reinterpret_cast<TH3F*>(fArrEff);
-      int ptbin = hist->GetXaxis()->FindBin(pt);
-      int ptbin_max = hist->GetXaxis()->GetNbins();
-      int etabin = hist->GetYaxis()->FindBin(eta);
-      int etabin_max = hist->GetYaxis()->GetNbins();
-      int phibin = hist->GetZaxis()->FindBin(phi);
-      int phibin_max = hist->GetZaxis()->GetNbins();
-      // make sure that no underflow or overflow bins are used
-      if (ptbin < 1)
-        ptbin = 1;
-      else if (ptbin > ptbin_max)
-        ptbin = ptbin_max;
-      if (etabin < 1)
-        etabin = 1;
-      else if (etabin > etabin_max)
-        etabin = etabin_max;
-      if (phibin < 1)
-        phibin = 1;
-      else if (phibin > phibin_max)
-        phibin = phibin_max;
-      return hist->GetBinContent(ptbin, etabin, phibin);
-    }
-
-    return 1.;
+    return fEffTable.get(pt, eta, phi);
   }
 
   // setters
@@ -368,6 +291,145 @@ class MomentumSmearer
   TString getCcdbPathEff() { return fCcdbPathEff; }
 
  private:
+  /// Resolution map converted to flat arrays: for each pt bin the normalised cumulative integral and the bins of the
+  /// resolution histogram. Sampling follows TH1::GetRandom (same random number and interpolation) without the
+  /// TObjArray lookup and the integral check of every call.
+  struct ResolutionTable {
+    TAxis ptAxis;              // pt binning of the resolution map (x axis of the first element)
+    int lastBin = 0;           // last pt bin with a resolution histogram
+    std::vector<int> nBins;    // number of bins of the resolution histogram per pt bin, 0 without smearing
+    std::vector<int> offsets;  // first element of a pt bin in cdf and lowEdges
+    std::vector<double> cdf;   // normalised cumulative integral, nBins + 1 values per pt bin
+    std::vector<double> lowEdges;
+    std::vector<double> widths;
+    std::vector<bool> isNaN;   // integral not defined (negative content), GetRandom returns NaN
+
+    void build(TObjArray* arr)
+    {
+      ptAxis = *(reinterpret_cast<TH2D*>(arr->At(0))->GetXaxis());
+      lastBin = arr->GetLast();
+      nBins.assign(lastBin + 1, 0);
+      offsets.assign(lastBin + 1, 0);
+      isNaN.assign(lastBin + 1, false);
+      cdf.clear();
+      lowEdges.clear();
+      widths.clear();
+      for (int ptbin = 1; ptbin <= lastBin; ptbin++) {
+        TH1D* hist = reinterpret_cast<TH1D*>(arr->At(ptbin));
+        offsets[ptbin] = cdf.size();
+        if (!(hist->GetEntries() > 0)) {
+          continue;
+        }
+        double integral = hist->ComputeIntegral(true);
+        if (std::isnan(integral)) {
+          isNaN[ptbin] = true;
+          continue;
+        }
+        if (integral == 0) {
+          continue;
+        }
+        int n = hist->GetNbinsX();
+        nBins[ptbin] = n;
+        cdf.insert(cdf.end(), hist->GetIntegral(), hist->GetIntegral() + n + 1);
+        for (int i = 1; i <= n; i++) {
+          lowEdges.push_back(hist->GetBinLowEdge(i));
+          widths.push_back(hist->GetBinWidth(i));
+        }
+        lowEdges.resize(cdf.size(), 0.);
+        widths.resize(cdf.size(), 0.);
+      }
+    }
+
+    int findPtBin(float pt) const
+    {
+      int ptbin = ptAxis.FindFixBin(pt);
+      if (ptbin < 1) {
+        ptbin = 1;
+      }
+      if (ptbin > lastBin) {
+        ptbin = lastBin;
+      }
+      return ptbin;
+    }
+
+    double sampleBin(int ptbin) const
+    {
+      if (isNaN[ptbin]) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      int n = nBins[ptbin];
+      if (n == 0) {
+        return 0.;
+      }
+      const double* integral = cdf.data() + offsets[ptbin];
+      double r1 = gRandom->Rndm();
+      int ibin = TMath::BinarySearch(n, integral, r1);
+      double x = lowEdges[offsets[ptbin] + ibin];
+      if (r1 > integral[ibin]) {
+        x += widths[offsets[ptbin] + ibin] * (r1 - integral[ibin]) / (integral[ibin + 1] - integral[ibin]);
+      }
+      return x;
+    }
+
+    double sample(float pt) const { return sampleBin(findPtBin(pt)); }
+  };
+
+  /// Efficiency map (1d, 2d or 3d) copied to a flat array, the bins are clamped to the histogram range
+  struct EfficiencyTable {
+    int dim = 0;
+    TAxis axes[3];
+    int nBins[3] = {1, 1, 1};
+    std::vector<float> values;
+
+    void build(TH1* hist, int effDim)
+    {
+      dim = effDim;
+      TAxis* histAxes[3] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+      for (int i = 0; i < 3; i++) {
+        nBins[i] = i < dim ? histAxes[i]->GetNbins() : 1;
+        if (i < dim) {
+          axes[i] = *histAxes[i];
+        }
+      }
+      values.resize(nBins[0] * nBins[1] * nBins[2]);
+      for (int iz = 1; iz <= nBins[2]; iz++) {
+        for (int iy = 1; iy <= nBins[1]; iy++) {
+          for (int ix = 1; ix <= nBins[0]; ix++) {
+            values[(ix - 1) + nBins[0] * ((iy - 1) + nBins[1] * (iz - 1))] = hist->GetBinContent(hist->GetBin(ix, iy, iz));
+          }
+        }
+      }
+    }
+
+    // make sure that no underflow or overflow bins are used
+    int findBin(int i, float value) const
+    {
+      int bin = axes[i].FindFixBin(value);
+      if (bin < 1) {
+        bin = 1;
+      } else if (bin > nBins[i]) {
+        bin = nBins[i];
+      }
+      return bin - 1;
+    }
+
+    float get(float pt, float eta, float phi) const
+    {
+      int ix = findBin(0, pt);
+      int iy = dim > 1 ? findBin(1, eta) : 0;
+      int iz = dim > 2 ? findBin(2, phi) : 0;
+      return values[ix + nBins[0] * (iy + nBins[1] * iz)];
+    }
+  };
+
+  void buildResolutionTables()
+  {
+    fResoPtTable.build(fArrResoPt);
+    fResoEtaTable.build(fArrResoEta);
+    fResoPhiPosTable.build(fArrResoPhi_Pos);
+    fResoPhiNegTable.build(fArrResoPhi_Neg);
+  }
+
   bool fInitialized = false;
   TString fResFileName;
   TString fResPtHistName;
@@ -385,6 +447,11 @@ class MomentumSmearer
   TObjArray* fArrResoPhi_Pos;
   TObjArray* fArrResoPhi_Neg;
   TObject* fArrEff;
+  ResolutionTable fResoPtTable;
+  ResolutionTable fResoEtaTable;
+  ResolutionTable fResoPhiPosTable;
+  ResolutionTable fResoPhiNegTable;
+  EfficiencyTable fEffTable;
   int64_t fTimestamp;
   bool fFromCcdb = false;
   Service<ccdb::BasicCCDBManager> fCcdb;
@@ -413,8 +413,8 @@ struct Pi0EtaToGammaGamma {
   }
 
   /// \brief Calculate background (using rotation background method only for EMCal!)
-  template <typename TPhotons>
-  void RotationBackground(const ROOT::Math::PtEtaPhiMVector& meson, ROOT::Math::PtEtaPhiMVector photon1, ROOT::Math::PtEtaPhiMVector photon2, TPhotons const& photons_coll, unsigned int ig1, unsigned int ig2, EMCPhotonCut const& cut, aod::SkimEMCMTs const&)
+  template <typename TPhotons, typename TSelection>
+  void RotationBackground(const ROOT::Math::PtEtaPhiMVector& meson, ROOT::Math::PtEtaPhiMVector photon1, ROOT::Math::PtEtaPhiMVector photon2, TPhotons const& photons_coll, unsigned int ig1, unsigned int ig2, TSelection const& selection, aod::SkimEMCMTs const&)
   {
     // if less than 3 clusters are present skip event since we need at least 3 clusters
     if (photons_coll.size() < 3) {
@@ -431,7 +431,7 @@ struct Pi0EtaToGammaGamma {
         // only combine rotated photons with other photons
         continue;
       }
-      if (!cut.template IsSelected<aod::SkimEMCMTs>(photon)) {
+      if (!selection.isSelected(photon.globalIndex())) {
         continue;
       }
 
@@ -469,6 +469,33 @@ struct Pi0EtaToGammaGamma {
   std::vector<std::pair<int, int>> used_photonIds;              // <ndf, trackId>
   std::vector<std::tuple<int, int, int, int>> used_dileptonIds; // <ndf, trackId>
 
+  /// \brief Selection of the candidates (photons or leptons) of a collision, evaluated once per candidate before the pairing
+  /// The candidates of a slice (also of a partition) lie in a contiguous range of global indices, the flags are indexed by the offset in this range.
+  struct CandidateSelection {
+    int64_t firstIndex = 0;
+    std::vector<bool> flags;
+
+    template <typename TCandidates, typename TSelector>
+    void evaluate(TCandidates const& candidates, TSelector const& selector)
+    {
+      flags.clear();
+      for (auto& candidate : candidates) {
+        if (flags.empty()) {
+          firstIndex = candidate.globalIndex();
+        }
+        flags.resize(candidate.globalIndex() - firstIndex, false);
+        flags.push_back(selector(candidate));
+      }
+    }
+
+    bool isSelected(int64_t globalIndex) const
+    {
+      int64_t i = globalIndex - firstIndex;
+      return 0 <= i && i < static_cast<int64_t>(flags.size()) && flags[i];
+    }
+  };
+  CandidateSelection selection1, selection2, selection_pos, selection_neg;
+
   template <typename TCollisions, typename TPhotons1, typename TPhotons2, typename TSubInfos1, typename TSubInfos2, typename TPreslice1, typename TPreslice2, typename TCut1, typename TCut2, typename TTracksMatchedWithEMC, typename TTracksMatchedWithPHOS>
   void runPairing(TCollisions const& collisions,
                   TPhotons1 const& photons1, TPhotons2 const& photons2,
@@ -528,9 +555,11 @@ struct Pi0EtaToGammaGamma {
       if constexpr (pairtype == PairType::kPCMPCM || pairtype == PairType::kPHOSPHOS || pairtype == PairType::kEMCEMC) { // same kinds pairing
         auto photons1_per_collision = photons1.sliceBy(perCollision1, collision.globalIndex());
         auto photons2_per_collision = photons2.sliceBy(perCollision2, collision.globalIndex());
+        selection1.evaluate(photons1_per_collision, [&cut1](auto const& g) { return cut1.template IsSelected<TSubInfos1>(g); });
+        selection2.evaluate(photons2_per_collision, [&cut2](auto const& g) { return cut2.template IsSelected<TSubInfos2>(g); });
 
         for (auto& [g1, g2] : combinations(CombinationsStrictlyUpperIndexPolicy(photons1_per_collision, photons2_per_collision))) {
-          if (!cut1.template IsSelected<TSubInfos1>(g1) || !cut2.template IsSelected<TSubInfos2>(g2)) {
+          if (!selection1.isSelected(g1.globalIndex()) || !selection2.isSelected(g2.globalIndex())) {
             continue;
           }
 
@@ -543,7 +572,7 @@ struct Pi0EtaToGammaGamma {
           o2::aod::pwgem::photonmeson::utils::nmhistogram::fillPairInfo<0, pairtype>(&fRegistry, collision, v12, cfgDoFlow);
 
           if constexpr (pairtype == PairType::kEMCEMC) {
-            RotationBackground<MyEMCClusters>(v12, v1, v2, photons2_per_collision, g1.globalIndex(), g2.globalIndex(), cut1, tracks_emc);
+            RotationBackground<MyEMCClusters>(v12, v1, v2, photons2_per_collision, g1.globalIndex(), g2.globalIndex(), selection2, tracks_emc);
           }
 
           std::pair<int, int> pair_tmp_id1 = std::make_pair(ndf, g1.globalIndex());
@@ -563,9 +592,17 @@ struct Pi0EtaToGammaGamma {
         auto photons1_per_collision = photons1.sliceBy(perCollision1, collision.globalIndex());
         auto positrons_per_collision = positrons->sliceByCached(o2::aod::emprimaryelectron::emeventId, collision.globalIndex(), cache);
         auto electrons_per_collision = electrons->sliceByCached(o2::aod::emprimaryelectron::emeventId, collision.globalIndex(), cache);
+        selection1.evaluate(photons1_per_collision, [&cut1](auto const& g) { return cut1.template IsSelected<TSubInfos1>(g); });
+        if (dileptoncuts.cfg_pid_scheme == static_cast<int>(DalitzEECut::PIDSchemes::kPIDML)) {
+          selection_pos.evaluate(positrons_per_collision, [&cut2, &collision](auto const& t) { return cut2.template IsSelectedTrack<true>(t, collision); });
+          selection_neg.evaluate(electrons_per_collision, [&cut2, &collision](auto const& t) { return cut2.template IsSelectedTrack<true>(t, collision); });
+        } else { // cut-based
+          selection_pos.evaluate(positrons_per_collision, [&cut2, &collision](auto const& t) { return cut2.template IsSelectedTrack<false>(t, collision); });
+          selection_neg.evaluate(electrons_per_collision, [&cut2, &collision](auto const& t) { return cut2.template IsSelectedTrack<false>(t, collision); });
+        }
 
         for (auto& g1 : photons1_per_collision) {
-          if (!cut1.template IsSelected<TSubInfos1>(g1)) {
+          if (!selection1.isSelected(g1.globalIndex())) {
             continue;
           }
           auto pos1 = g1.template posTrack_as<TSubInfos1>();
@@ -581,14 +618,8 @@ struct Pi0EtaToGammaGamma {
               continue;
             }
 
-            if (dileptoncuts.cfg_pid_scheme == static_cast<int>(DalitzEECut::PIDSchemes::kPIDML)) {
-              if (!cut2.template IsSelectedTrack<true>(pos2, collision) || !cut2.template IsSelectedTrack<true>(ele2, collision)) {
-                continue;
-              }
-            } else { // cut-based
-              if (!cut2.template IsSelectedTrack<false>(pos2, collision) || !cut2.template IsSelectedTrack<false>(ele2, collision)) {
-                continue;
-              }
+            if (!selection_pos.isSelected(pos2.globalIndex()) || !selection_neg.isSelected(ele2.globalIndex())) {
+              continue;
             }
 
             if (!cut2.IsSelectedPair(pos2, ele2, collision.bz())) {
@@ -624,9 +655,17 @@ struct Pi0EtaToGammaGamma {
         auto photons1_per_collision = photons1.sliceBy(perCollision1, collision.globalIndex());
         auto muons_pos_per_collision = muons_pos->sliceByCached(o2::aod::emprimarymuon::emeventId, collision.globalIndex(), cache);
         auto muons_neg_per_collision = muons_neg->sliceByCached(o2::aod::emprimarymuon::emeventId, collision.globalIndex(), cache);
+        selection1.evaluate(photons1_per_collision, [&cut1](auto const& g) { return cut1.template IsSelected<TSubInfos1>(g); });
+        if (dileptoncuts.cfg_pid_scheme == static_cast<int>(DalitzEECut::PIDSchemes::kPIDML)) {
+          selection_pos.evaluate(muons_pos_per_collision, [&cut2, &collision](auto const& t) { return cut2.template IsSelectedTrack<true>(t, collision); });
+          selection_neg.evaluate(muons_neg_per_collision, [&cut2, &collision](auto const& t) { return cut2.template IsSelectedTrack<true>(t, collision); });
+        } else { // cut-based
+          selection_pos.evaluate(muons_pos_per_collision, [&cut2, &collision](auto const& t) { return cut2.template IsSelectedTrack<false>(t, collision); });
+          selection_neg.evaluate(muons_neg_per_collision, [&cut2, &collision](auto const& t) { return cut2.template IsSelectedTrack<false>(t, collision); });
+        }
 
         for (auto& g1 : photons1_per_collision) {
-          if (!cut1.template IsSelected<TSubInfos1>(g1)) {
+          if (!selection1.isSelected(g1.globalIndex())) {
             continue;
           }
           auto pos1 = g1.template posTrack_as<TSubInfos1>();
@@ -642,14 +681,8 @@ struct Pi0EtaToGammaGamma {
               continue;
             }
 
-            if (dileptoncuts.cfg_pid_scheme == static_cast<int>(DalitzEECut::PIDSchemes::kPIDML)) {
-              if (!cut2.template IsSelectedTrack<true>(muplus, collision) || !cut2.template IsSelectedTrack<true>(muminus, collision)) {
-                continue;
-              }
-            } else { // cut-based
-              if (!cut2.template IsSelectedTrack<false>(muplus, collision) || !cut2.template IsSelectedTrack<false>(muminus, collision)) {
-                continue;
-              }
+            if (!selection_pos.isSelected(muplus.globalIndex()) || !selection_neg.isSelected(muminus.globalIndex())) {
+              continue;
             }
 
             if (!cut2.IsSelectedPair(muplus, muminus, collision.bz())) {
@@ -685,9 +718,11 @@ struct Pi0EtaToGammaGamma {
       } else { // PCM-EMC, PCM-PHOS. Nightmare. don't run these pairs.
         auto photons1_per_collision = photons1.sliceBy(perCollision1, collision.globalIndex());
         auto photons2_per_collision = photons2.sliceBy(perCollision2, collision.globalIndex());
+        selection1.evaluate(photons1_per_collision, [&cut1](auto const& g) { return cut1.template IsSelected<TSubInfos1>(g); });
+        selection2.evaluate(photons2_per_collision, [&cut2](auto const& g) { return cut2.template IsSelected<TSubInfos2>(g); });
 
         for (auto& [g1, g2] : combinations(CombinationsFullIndexPolicy(photons1_per_collision, photons2_per_collision))) {
-          if (!cut1.template IsSelected<TSubInfos1>(g1) || !cut2.template IsSelected<TSubInfos2>(g2)) {
+          if (!selection1.isSelected(g1.globalIndex()) || !selection2.isSelected(g2.globalIndex())) {
             continue;
           }
           ROOT::Math::PtEtaPhiMVector v1(g1.pt(), g1.eta(), g1.phi(), 0.);
@@ -714,15 +749,17 @@ struct Pi0EtaToGammaGamma {
 
       // event mixing
       if (!cfgDoMix || !(ndiphoton > 0)) {
+        emh1->RemoveCollision(key_df_collision);
+        emh2->RemoveCollision(key_df_collision);
         continue;
       }
 
       // make a vector of selected photons in this collision.
-      auto selected_photons1_in_this_event = emh1->GetTracksPerCollision(key_df_collision);
-      auto selected_photons2_in_this_event = emh2->GetTracksPerCollision(key_df_collision);
+      const auto& selected_photons1_in_this_event = emh1->GetTracksPerCollision(key_df_collision);
+      const auto& selected_photons2_in_this_event = emh2->GetTracksPerCollision(key_df_collision);
 
-      auto collisionIds1_in_mixing_pool = emh1->GetCollisionIdsFromEventPool(key_bin);
-      auto collisionIds2_in_mixing_pool = emh2->GetCollisionIdsFromEventPool(key_bin);
+      const auto& collisionIds1_in_mixing_pool = emh1->GetCollisionIdsFromEventPool(key_bin);
+      const auto& collisionIds2_in_mixing_pool = emh2->GetCollisionIdsFromEventPool(key_bin);
 
       if constexpr (pairtype == PairType::kPCMPCM || pairtype == PairType::kPHOSPHOS || pairtype == PairType::kEMCEMC) { // same kinds pairing
         for (auto& mix_dfId_collisionId : collisionIds1_in_mixing_pool) {
@@ -733,7 +770,7 @@ struct Pi0EtaToGammaGamma {
             continue;
           }
 
-          auto photons1_from_event_pool = emh1->GetTracksPerCollision(mix_dfId_collisionId);
+          const auto& photons1_from_event_pool = emh1->GetTracksPerCollision(mix_dfId_collisionId);
           // LOGF(info, "Do event mixing: current event (%d, %d), ngamma = %d | event pool (%d, %d), ngamma = %d", ndf, collision.globalIndex(), selected_photons1_in_this_event.size(), mix_dfId, mix_collisionId, photons1_from_event_pool.size());
 
           for (auto& g1 : selected_photons1_in_this_event) {
@@ -758,7 +795,7 @@ struct Pi0EtaToGammaGamma {
             continue;
           }
 
-          auto photons2_from_event_pool = emh2->GetTracksPerCollision(mix_dfId_collisionId);
+          const auto& photons2_from_event_pool = emh2->GetTracksPerCollision(mix_dfId_collisionId);
           // LOGF(info, "Do event mixing: current event (%d, %d), ngamma = %d | event pool (%d, %d), nll = %d", ndf, collision.globalIndex(), selected_photons1_in_this_event.size(), mix_dfId, mix_collisionId, photons2_from_event_pool.size());
 
           for (auto& g1 : selected_photons1_in_this_event) {
@@ -784,7 +821,7 @@ struct Pi0EtaToGammaGamma {
             continue;
           }
 
-          auto photons1_from_event_pool = emh1->GetTracksPerCollision(mix_dfId_collisionId);
+          const auto& photons1_from_event_pool = emh1->GetTracksPerCollision(mix_dfId_collisionId);
           // LOGF(info, "Do event mixing: current event (%d, %d), nll = %d | event pool (%d, %d), ngamma = %d", ndf, collision.globalIndex(), selected_photons2_in_this_event.size(), mix_dfId, mix_collisionId, photons1_from_event_pool.size());
 
           for (auto& g1 : selected_photons2_in_this_event) {
@@ -21,6 +21,7 @@
 #include "ReconstructionDataFormats/Track.h"
 #include "PWGEM/PhotonMeson/DataModel/gammaTables.h"
 #include "PWGEM/PhotonMeson/Utils/MCUtilities.h"
+#include "Common/Core/DenseIndexMap.h"
 
 using namespace o2;
 using namespace o2::framework;
@@ -59,6 +60,11 @@ struct AssociateMCInfo {
 
   HistogramRegistry registry{"EMMCEvent"};
 
+  // indexing of the skimmed MC stack, reset per dataframe
+  DenseIndexMap fNewLabels;   // new label per McParticles global index
+  DenseIndexMap fEventLabels; // new label per McCollisions global index
+  std::vector<int> fEventIdx; // new label of the MC event per new particle label
+
   void init(o2::framework::InitContext&)
   {
     auto hEventCounter = registry.add<TH1>("hEventCounter", "hEventCounter", kTH1I, {{6, 0.5f, 6.5f}});
@@ -178,15 +184,12 @@ struct AssociateMCInfo {
   std::vector<uint16_t> genLambda;        // primary, pt, y
 
   template <uint8_t system, typename TTracks, typename TPCMs, typename TPCMLegs, typename TPHOSs, typename TEMCs, typename TEMPrimaryElectrons, typename TEMPrimaryMuons>
-  void skimmingMC(MyCollisionsMC const& collisions, aod::BCs const&, aod::McCollisions const&, aod::McParticles const& mcTracks, TTracks const& o2tracks, TPCMs const& v0photons, TPCMLegs const& /*v0legs*/, TPHOSs const& /*phosclusters*/, TEMCs const& emcclusters, TEMPrimaryElectrons const& emprimaryelectrons, TEMPrimaryMuons const& emprimarymuons)
+  void skimmingMC(MyCollisionsMC const& collisions, aod::BCs const&, aod::McCollisions const& mcCollisions, aod::McParticles const& mcTracks, TTracks const& o2tracks, TPCMs const& v0photons, TPCMLegs const& /*v0legs*/, TPHOSs const& /*phosclusters*/, TEMCs const& emcclusters, TEMPrimaryElectrons const& emprimaryelectrons, TEMPrimaryMuons const& emprimarymuons)
   {
-    // temporary variables used for the indexing of the skimmed MC stack
-    std::map<uint64_t, int> fNewLabels;
-    std::map<uint64_t, int> fNewLabelsReversed;
-    // std::map<uint64_t, uint16_t> fMCFlags;
-    std::map<uint64_t, int> fEventIdx;
-    std::map<uint64_t, int> fEventLabels;
-    int fCounters[2] = {0, 0}; //! [0] - particle counter, [1] - event counter
+    // reset the indexing of the skimmed MC stack for this dataframe
+    fNewLabels.reset(mcTracks.size());
+    fEventLabels.reset(mcCollisions.size());
+    fEventIdx.clear();
     auto hBinFinder = registry.get<TH2>(HIST("Generated/h2PtY_Gamma"));
 
     for (auto& collision : collisions) {
@@ -316,10 +319,8 @@ struct AssociateMCInfo {
       } // end of mc track loop
 
       // make an entry for this MC event only if it was not already added to the table
-      if (!(fEventLabels.find(mcCollision.globalIndex()) != fEventLabels.end())) {
+      if (fEventLabels.insert(mcCollision.globalIndex())) {
         mcevents(mcCollision.globalIndex(), mcCollision.generatorsID(), mcCollision.posX(), mcCollision.posY(), mcCollision.posZ(), mcCollision.t(), mcCollision.impactParameter());
-        fEventLabels[mcCollision.globalIndex()] = fCounters[1];
-        fCounters[1]++;
         binned_gen_pt(genGamma, genPi0, genEta, genOmega, genPhi, genChargedPion, genChargedKaon, genK0S, genLambda);
         // binned_gen_pt_acc(
         //   genPi0_acc_gg, genPi0_acc_eeg,
@@ -328,7 +329,7 @@ struct AssociateMCInfo {
         //   genPhi_acc_ee);
       }
 
-      mceventlabels(fEventLabels.find(mcCollision.globalIndex())->second, collision.mcMask());
+      mceventlabels(fEventLabels[mcCollision.globalIndex()], collision.mcMask());
 
       for (auto& mctrack : groupedMcTracks) { // store necessary information for denominator of efficiency
         if (mctrack.pt() < 1e-3 || abs(mctrack.vz()) > 250 || sqrt(pow(mctrack.vx(), 2) + pow(mctrack.vy(), 2)) > max_rxy_gen) {
@@ -355,12 +356,8 @@ struct AssociateMCInfo {
 
         if (mctrack.isPhysicalPrimary() || mctrack.producedByGenerator()) { // primary leptons
           if (abs(mctrack.y()) < max_Y_gen_primary) {                       // primary leptons
-            if (!(fNewLabels.find(mctrack.globalIndex()) != fNewLabels.end())) {
-              fNewLabels[mctrack.globalIndex()] = fCounters[0];
-              fNewLabelsReversed[fCounters[0]] = mctrack.globalIndex();
-              // fMCFlags[mctrack.globalIndex()] = mcflags;
-              fEventIdx[mctrack.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-              fCounters[0]++;
+            if (fNewLabels.insert(mctrack.globalIndex())) {
+              fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
             }
 
             int motherid = -999; // first mother index
@@ -372,12 +369,8 @@ struct AssociateMCInfo {
                 auto mp = mcTracks.iteratorAt(motherid);
 
                 // if the MC truth particle corresponding to this reconstructed track which is not already written, add it to the skimmed MC stack
-                if (!(fNewLabels.find(mp.globalIndex()) != fNewLabels.end())) {
-                  fNewLabels[mp.globalIndex()] = fCounters[0];
-                  fNewLabelsReversed[fCounters[0]] = mp.globalIndex();
-                  // fMCFlags[mp.globalIndex()] = mcflags;
-                  fEventIdx[mp.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-                  fCounters[0]++;
+                if (fNewLabels.insert(mp.globalIndex())) {
+                  fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
                 }
 
                 if (mp.has_mothers()) {
@@ -400,21 +393,13 @@ struct AssociateMCInfo {
 
           if (mp.pdgCode() == 22 && (mp.isPhysicalPrimary() || mp.producedByGenerator()) && abs(mp.y()) < max_Y_gen_secondary) {
             // if the MC truth particle corresponding to this reconstructed track which is not already written, add it to the skimmed MC stack
-            if (!(fNewLabels.find(mctrack.globalIndex()) != fNewLabels.end())) { // store electron information. !!Not photon!!
-              fNewLabels[mctrack.globalIndex()] = fCounters[0];
-              fNewLabelsReversed[fCounters[0]] = mctrack.globalIndex();
-              // fMCFlags[mctrack.globalIndex()] = mcflags;
-              fEventIdx[mctrack.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-              fCounters[0]++;
+            if (fNewLabels.insert(mctrack.globalIndex())) { // store electron information. !!Not photon!!
+              fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
             }
 
             // if the MC truth particle corresponding to this reconstructed track which is not already written, add it to the skimmed MC stack
-            if (!(fNewLabels.find(mp.globalIndex()) != fNewLabels.end())) { // store conversion photon
-              fNewLabels[mp.globalIndex()] = fCounters[0];
-              fNewLabelsReversed[fCounters[0]] = mp.globalIndex();
-              // fMCFlags[mp.globalIndex()] = mcflags;
-              fEventIdx[mp.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-              fCounters[0]++;
+            if (fNewLabels.insert(mp.globalIndex())) { // store conversion photon
+              fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
             }
           }
         }
@@ -440,14 +425,10 @@ struct AssociateMCInfo {
             // LOGF(info, "mctrack.globalIndex() = %d, mctrack.index() = %d", mctrack.globalIndex(), mctrack.index()); // these are exactly the same.
 
             // if the MC truth particle corresponding to this reconstructed track which is not already written, add it to the skimmed MC stack
-            if (!(fNewLabels.find(mctrack.globalIndex()) != fNewLabels.end())) {
-              fNewLabels[mctrack.globalIndex()] = fCounters[0];
-              fNewLabelsReversed[fCounters[0]] = mctrack.globalIndex();
-              // fMCFlags[mctrack.globalIndex()] = mcflags;
-              fEventIdx[mctrack.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-              fCounters[0]++;
+            if (fNewLabels.insert(mctrack.globalIndex())) {
+              fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
             }
-            v0legmclabels(fNewLabels.find(mctrack.index())->second, o2track.mcMask());
+            v0legmclabels(fNewLabels[mctrack.index()], o2track.mcMask());
 
             // Next, store mother-chain of this reconstructed track.
             int motherid = -999; // first mother index
@@ -459,12 +440,8 @@ struct AssociateMCInfo {
                 auto mp = mcTracks.iteratorAt(motherid);
 
                 // if the MC truth particle corresponding to this reconstructed track which is not already written, add it to the skimmed MC stack
-                if (!(fNewLabels.find(mp.globalIndex()) != fNewLabels.end())) {
-                  fNewLabels[mp.globalIndex()] = fCounters[0];
-                  fNewLabelsReversed[fCounters[0]] = mp.globalIndex();
-                  // fMCFlags[mp.globalIndex()] = mcflags;
-                  fEventIdx[mp.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-                  fCounters[0]++;
+                if (fNewLabels.insert(mp.globalIndex())) {
+                  fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
                 }
 
                 if (mp.has_mothers()) {
@@ -490,14 +467,10 @@ struct AssociateMCInfo {
           auto mctrack = o2track.template mcParticle_as<aod::McParticles>();
 
           // if the MC truth particle corresponding to this reconstructed track which is not already written, add it to the skimmed MC stack
-          if (!(fNewLabels.find(mctrack.globalIndex()) != fNewLabels.end())) {
-            fNewLabels[mctrack.globalIndex()] = fCounters[0];
-            fNewLabelsReversed[fCounters[0]] = mctrack.globalIndex();
-            // fMCFlags[mctrack.globalIndex()] = mcflags;
-            fEventIdx[mctrack.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-            fCounters[0]++;
+          if (fNewLabels.insert(mctrack.globalIndex())) {
+            fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
           }
-          emprimaryelectronmclabels(fNewLabels.find(mctrack.index())->second, o2track.mcMask());
+          emprimaryelectronmclabels(fNewLabels[mctrack.index()], o2track.mcMask());
 
           // Next, store mother-chain of this reconstructed track.
           int motherid = -999; // first mother index
@@ -509,12 +482,8 @@ struct AssociateMCInfo {
               auto mp = mcTracks.iteratorAt(motherid);
 
               // if the MC truth particle corresponding to this reconstructed track which is not already written, add it to the skimmed MC stack
-              if (!(fNewLabels.find(mp.globalIndex()) != fNewLabels.end())) {
-                fNewLabels[mp.globalIndex()] = fCounters[0];
-                fNewLabelsReversed[fCounters[0]] = mp.globalIndex();
-                // fMCFlags[mp.globalIndex()] = mcflags;
-                fEventIdx[mp.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-                fCounters[0]++;
+              if (fNewLabels.insert(mp.globalIndex())) {
+                fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
               }
 
               if (mp.has_mothers()) {
@@ -540,14 +509,10 @@ struct AssociateMCInfo {
           auto mctrack = o2track.template mcParticle_as<aod::McParticles>();
 
           // if the MC truth particle corresponding to this reconstructed track which is not already written, add it to the skimmed MC stack
-          if (!(fNewLabels.find(mctrack.globalIndex()) != fNewLabels.end())) {
-            fNewLabels[mctrack.globalIndex()] = fCounters[0];
-            fNewLabelsReversed[fCounters[0]] = mctrack.globalIndex();
-            // fMCFlags[mctrack.globalIndex()] = mcflags;
-            fEventIdx[mctrack.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-            fCounters[0]++;
+          if (fNewLabels.insert(mctrack.globalIndex())) {
+            fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
           }
-          emprimarymuonmclabels(fNewLabels.find(mctrack.index())->second, o2track.mcMask());
+          emprimarymuonmclabels(fNewLabels[mctrack.index()], o2track.mcMask());
 
           // Next, store mother-chain of this reconstructed track.
           int motherid = -999; // first mother index
@@ -559,12 +524,8 @@ struct AssociateMCInfo {
               auto mp = mcTracks.iteratorAt(motherid);
 
               // if the MC truth particle corresponding to this reconstructed track which is not already written, add it to the skimmed MC stack
-              if (!(fNewLabels.find(mp.globalIndex()) != fNewLabels.end())) {
-                fNewLabels[mp.globalIndex()] = fCounters[0];
-                fNewLabelsReversed[fCounters[0]] = mp.globalIndex();
-                // fMCFlags[mp.globalIndex()] = mcflags;
-                fEventIdx[mp.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-                fCounters[0]++;
+              if (fNewLabels.insert(mp.globalIndex())) {
+                fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
               }
 
               if (mp.has_mothers()) {
@@ -586,13 +547,10 @@ struct AssociateMCInfo {
           auto mcphoton = mcTracks.iteratorAt(ememccluster.emmcparticleIds()[0]);
 
           // if the MC truth particle corresponding to this reconstructed track which is not already written, add it to the skimmed MC stack
-          if (!(fNewLabels.find(mcphoton.globalIndex()) != fNewLabels.end())) {
-            fNewLabels[mcphoton.globalIndex()] = fCounters[0];
-            fNewLabelsReversed[fCounters[0]] = mcphoton.globalIndex();
-            fEventIdx[mcphoton.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-            fCounters[0]++;
+          if (fNewLabels.insert(mcphoton.globalIndex())) {
+            fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
           }
-          ememcclustermclabels(fNewLabels.find(mcphoton.index())->second);
+          ememcclustermclabels(fNewLabels[mcphoton.index()]);
 
           // Next, store mother-chain of this reconstructed track.
           int motherid = -999; // first mother index
@@ -604,11 +562,8 @@ struct AssociateMCInfo {
               auto mp = mcTracks.iteratorAt(motherid);
 
               // if the MC truth particle corresponding to this reconstructed track which is not already written, add it to the skimmed MC stack
-              if (!(fNewLabels.find(mp.globalIndex()) != fNewLabels.end())) {
-                fNewLabels[mp.globalIndex()] = fCounters[0];
-                fNewLabelsReversed[fCounters[0]] = mp.globalIndex();
-                fEventIdx[mp.globalIndex()] = fEventLabels.find(mcCollision.globalIndex())->second;
-                fCounters[0]++;
+              if (fNewLabels.insert(mp.globalIndex())) {
+                fEventIdx.push_back(fEventLabels[mcCollision.globalIndex()]);
               }
 
               if (mp.has_mothers()) {
@@ -626,16 +581,15 @@ struct AssociateMCInfo {
     } // end of collision loop
 
     //  Loop over the label map, create the mother/daughter relationships if these exist and write the skimmed MC stack
-    for (const auto& [newLabel, oldLabel] : fNewLabelsReversed) {
-      auto mctrack = mcTracks.iteratorAt(oldLabel);
-      // uint16_t mcflags = fMCFlags.find(oldLabel)->second;
+    for (std::size_t newLabel = 0; newLabel < fNewLabels.size(); newLabel++) {
+      auto mctrack = mcTracks.iteratorAt(fNewLabels.original(newLabel));
 
       std::vector<int> mothers;
       if (mctrack.has_mothers()) {
         for (auto& m : mctrack.mothersIds()) {
           if (m < mcTracks.size()) { // protect against bad mother indices
-            if (fNewLabels.find(m) != fNewLabels.end()) {
-              mothers.push_back(fNewLabels.find(m)->second);
+            if (fNewLabels.contains(m)) {
+              mothers.push_back(fNewLabels[m]);
             }
           } else {
             std::cout << "Mother label (" << m << ") exceeds the McParticles size (" << mcTracks.size() << ")" << std::endl;
@@ -653,8 +607,8 @@ struct AssociateMCInfo {
           if (d < mcTracks.size()) { // protect against bad daughter indices
             // auto dau_tmp = mcTracks.iteratorAt(d);
             // LOGF(info, "daughter pdg = %d", dau_tmp.pdgCode());
-            if (fNewLabels.find(d) != fNewLabels.end()) {
-              daughters.push_back(fNewLabels.find(d)->second);
+            if (fNewLabels.contains(d)) {
+              daughters.push_back(fNewLabels[d]);
             }
           } else {
             std::cout << "Daughter label (" << d << ") exceeds the McParticles size (" << mcTracks.size() << ")" << std::endl;
@@ -663,19 +617,12 @@ struct AssociateMCInfo {
         }
       }
 
-      emmcparticles(fEventIdx.find(oldLabel)->second, mctrack.pdgCode(), mctrack.flags(),
+      emmcparticles(fEventIdx[newLabel], mctrack.pdgCode(), mctrack.flags(),
                     mothers, daughters,
                     mctrack.px(), mctrack.py(), mctrack.pz(), mctrack.e(),
                     mctrack.vx(), mctrack.vy(), mctrack.vz(), mctrack.vt());
     } // end loop over labels
 
-    fNewLabels.clear();
-    fNewLabelsReversed.clear();
-    // fMCFlags.clear();
-    fEventIdx.clear();
-    fEventLabels.clear();
-    fCounters[0] = 0;
-    fCounters[1] = 0;
   } //  end of skimmingMC
 
   void processMC_PCM(MyCollisionsMC const& collisions, aod::BCs const& bcs, aod::McCollisions const& mccollisions, aod::McParticles const& mcTracks, TracksMC const& o2tracks, aod::V0PhotonsKF const& v0photons, aod::V0Legs const& v0legs)
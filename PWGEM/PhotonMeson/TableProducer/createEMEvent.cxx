@@ -14,6 +14,8 @@
 // This code produces reduced events for photon analyses.
 //    Please write to: daiki.sekihata@cern.ch
 
+#include <vector>
+
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -231,11 +233,7 @@ struct AssociatePhotonToEMEvent {
   Produces<o2::aod::EMEventsNgPHOS> event_ng_phos;
   Produces<o2::aod::EMEventsNgEMC> event_ng_emc;
 
-  Preslice<aod::V0PhotonsKF> perCollision_pcm = aod::v0photonkf::collisionId;
-  PresliceUnsorted<aod::EMPrimaryElectrons> perCollision_el = aod::emprimaryelectron::collisionId;
-  PresliceUnsorted<aod::EMPrimaryMuons> perCollision_mu = aod::emprimarymuon::collisionId;
-  Preslice<aod::PHOSClusters> perCollision_phos = aod::skimmedcluster::collisionId;
-  Preslice<aod::SkimEMCClusters> perCollision_emc = aod::skimmedcluster::collisionId;
+  std::vector<int> map_collision_to_emevent; // collisionId -> globalIndex of the EM event, -1 for collisions without EM event
 
   bool doPCM = false, doDalitzEE = false, doDalitzMuMu = false, doPHOS = false, doEMC = false;
   void init(o2::framework::InitContext& context)
@@ -266,29 +264,57 @@ struct AssociatePhotonToEMEvent {
     } // end of collision loop
   }
 
-  template <typename TCollisions, typename TPhotons, typename TEventIds, typename TEventNg, typename TPreslice>
-  void fillEventId_Ng(TCollisions const& collisions, TPhotons const& photons, TEventIds& eventIds, TEventNg& event_ng, TPreslice const& perCollision)
+  // The EM event index of the objects is resolved with a lookup table built from the EM events,
+  // the objects are read once in their row order instead of being sliced per EM event.
+  template <typename TCollisions>
+  void mapCollisionsToEMEvents(TCollisions const& collisions)
   {
+    map_collision_to_emevent.clear();
     for (auto& collision : collisions) {
-      auto photons_coll = photons.sliceBy(perCollision, collision.collisionId());
-      int ng = photons_coll.size();
-      for (int ig = 0; ig < ng; ig++) {
-        eventIds(collision.globalIndex());
-      } // end of photon loop
-      event_ng(ng);
+      if (collision.collisionId() < 0) {
+        continue;
+      }
+      if (static_cast<int>(map_collision_to_emevent.size()) <= collision.collisionId()) {
+        map_collision_to_emevent.resize(collision.collisionId() + 1, -1);
+      }
+      map_collision_to_emevent[collision.collisionId()] = collision.globalIndex();
     } // end of collision loop
   }
 
-  template <typename TCollisions, typename TPhotons, typename TEventIds, typename TPreslice>
-  void fillEventId(TCollisions const& collisions, TPhotons const& photons, TEventIds& eventIds, TPreslice const& perCollision)
+  int emeventIndex(int collisionId) const
   {
-    for (auto& collision : collisions) {
-      auto photons_coll = photons.sliceBy(perCollision, collision.collisionId());
-      int ng = photons_coll.size();
-      for (int ig = 0; ig < ng; ig++) {
-        eventIds(collision.globalIndex());
-      } // end of photon loop
-    }   // end of collision loop
+    if (collisionId < 0 || static_cast<int>(map_collision_to_emevent.size()) <= collisionId) {
+      return -1;
+    }
+    return map_collision_to_emevent[collisionId];
+  }
+
+  template <typename TCollisions, typename TPhotons, typename TEventIds, typename TEventNg>
+  void fillEventId_Ng(TCollisions const& collisions, TPhotons const& photons, TEventIds& eventIds, TEventNg& event_ng)
+  {
+    mapCollisionsToEMEvents(collisions);
+    std::vector<int> ng_per_event(collisions.size(), 0);
+    eventIds.reserve(photons.size());
+    for (auto& photon : photons) {
+      int eventId = emeventIndex(photon.collisionId());
+      eventIds(eventId);
+      if (eventId >= 0) {
+        ng_per_event[eventId]++;
+      }
+    } // end of photon loop
+    for (auto& ng : ng_per_event) {
+      event_ng(ng);
+    }
+  }
+
+  template <typename TCollisions, typename TPhotons, typename TEventIds>
+  void fillEventId(TCollisions const& collisions, TPhotons const& photons, TEventIds& eventIds)
+  {
+    mapCollisionsToEMEvents(collisions);
+    eventIds.reserve(photons.size());
+    for (auto& photon : photons) {
+      eventIds(emeventIndex(photon.collisionId()));
+    } // end of photon loop
   }
 
   // This struct is for both data and MC.
@@ -296,27 +322,27 @@ struct AssociatePhotonToEMEvent {
 
   void processPCM(aod::EMEvents const& collisions, aod::V0PhotonsKF const& photons)
   {
-    fillEventId_Ng(collisions, photons, v0kfeventid, event_ng_pcm, perCollision_pcm);
+    fillEventId_Ng(collisions, photons, v0kfeventid, event_ng_pcm);
   }
 
   void processDalitzEE(aod::EMEvents const& collisions, aod::EMPrimaryElectrons const& tracks)
   {
-    fillEventId(collisions, tracks, prmeleventid, perCollision_el);
+    fillEventId(collisions, tracks, prmeleventid);
   }
 
   void processDalitzMuMu(aod::EMEvents const& collisions, aod::EMPrimaryMuons const& tracks)
   {
-    fillEventId(collisions, tracks, prmmueventid, perCollision_mu);
+    fillEventId(collisions, tracks, prmmueventid);
   }
 
   void processPHOS(aod::EMEvents const& collisions, aod::PHOSClusters const& photons)
   {
-    fillEventId_Ng(collisions, photons, phoseventid, event_ng_phos, perCollision_phos);
+    fillEventId_Ng(collisions, photons, phoseventid, event_ng_phos);
   }
 
   void processEMC(aod::EMEvents const& collisions, aod::SkimEMCClusters const& photons)
   {
-    fillEventId_Ng(collisions, photons, emceventid, event_ng_emc, perCollision_emc);
+    fillEventId_Ng(collisions, photons, emceventid, event_ng_emc);
   }
 
   void processZeroPadding(aod::EMEvents const& collisions)
@@ -103,6 +103,7 @@ struct PhotonConversionBuilder {
   Configurable<float> margin_z{"margin_z", 7.0, "margin for z cut in cm"};
   Configurable<float> max_alpha_ap{"max_alpha_ap", 0.95, "max alpha for AP cut"};
   Configurable<float> max_qt_ap{"max_qt_ap", 0.01, "max qT for AP cut"};
+  Configurable<float> max_qt_ap_prefilter{"max_qt_ap_prefilter", -1.f, "max qT of the legs at IU before the KF fit, loose prefilter, disabled if negative"};
   Configurable<float> min_pt_v0{"min_pt_v0", 0.05, "min pT for v0 photons at PV"};
   Configurable<float> max_pt_v0_itsonly{"max_pt_v0_itsonly", 0.3, "max pT for v0 photons wth 2 ITSonly tracks at PV"};
   Configurable<float> max_eta_v0{"max_eta_v0", 0.9, "max eta for v0 photons at PV"};
@@ -298,7 +299,7 @@ struct PhotonConversionBuilder {
     return true;
   }
 
-  float cospaXY_KF(KFParticle kfp, KFParticle PV)
+  float cospaXY_KF(const KFParticle& kfp, const KFParticle& PV)
   {
     float lx = kfp.GetX() - PV.GetX(); // flight length X
     float ly = kfp.GetY() - PV.GetY(); // flight length Y
@@ -314,7 +315,7 @@ struct PhotonConversionBuilder {
     return cospaXY;
   }
 
-  float cospaRZ_KF(KFParticle kfp, KFParticle PV)
+  float cospaRZ_KF(const KFParticle& kfp, const KFParticle& PV)
   {
     float lx = kfp.GetX() - PV.GetX();              // flight length X
     float ly = kfp.GetY() - PV.GetY();              // flight length Y
@@ -400,6 +401,10 @@ struct PhotonConversionBuilder {
       return; // RZ line cut
     }
 
+    if (max_qt_ap_prefilter > 0.f && v0_qt(pos.px(), pos.py(), pos.pz(), ele.px(), ele.py(), ele.pz()) > max_qt_ap_prefilter) {
+      return; // legs at IU far from a photon conversion, not sent to the KF fit
+    }
+
     KFPTrack kfp_track_pos = createKFPTrackFromTrack(pos);
     KFPTrack kfp_track_ele = createKFPTrackFromTrack(ele);
     KFParticle kfp_pos(kfp_track_pos, -11);
@@ -483,28 +488,6 @@ struct PhotonConversionBuilder {
       return;
     }
 
-    // Apply a topological constraint of the gamma to the PV. Parameters will be given at the primary vertex.
-    KFParticle gammaKF_PV = gammaKF;
-    gammaKF_PV.SetProductionVertex(KFPV);
-    float v0pt = RecoDecay::sqrtSumOfSquares(gammaKF_PV.GetPx(), gammaKF_PV.GetPy());
-    float v0eta = RecoDecay::eta(std::array{gammaKF_PV.GetPx(), gammaKF_PV.GetPy(), gammaKF_PV.GetPz()});
-    float v0phi = RecoDecay::phi(gammaKF_PV.GetPx(), gammaKF_PV.GetPy()) > 0.f ? RecoDecay::phi(gammaKF_PV.GetPx(), gammaKF_PV.GetPy()) : RecoDecay::phi(gammaKF_PV.GetPx(), gammaKF_PV.GetPy()) + TMath::TwoPi();
-
-    // KFParticle gammaKF_DecayVtx2 = gammaKF;
-    // gammaKF_DecayVtx2.SetProductionVertex(KFPV);
-    // gammaKF_DecayVtx2.TransportToPoint(xyz);
-    // LOGF(info, "gammaKF_PV.GetPx() = %f, gammaKF_DecayVtx.GetPx() = %f, gammaKF_DecayVtx2.GetPx() = %f", gammaKF_PV.GetPx(), gammaKF_DecayVtx.GetPx(), gammaKF_DecayVtx2.GetPx());
-    // LOGF(info, "gammaKF_PV.GetPy() = %f, gammaKF_DecayVtx.GetPy() = %f, gammaKF_DecayVtx2.GetPy() = %f", gammaKF_PV.GetPy(), gammaKF_DecayVtx.GetPy(), gammaKF_DecayVtx2.GetPy());
-    // LOGF(info, "gammaKF_PV.GetPz() = %f, gammaKF_DecayVtx.GetPz() = %f, gammaKF_DecayVtx2.GetPz() = %f", gammaKF_PV.GetPz(), gammaKF_DecayVtx.GetPz(), gammaKF_DecayVtx2.GetPz());
-
-    if (fabs(v0eta) > max_eta_v0 || v0pt < min_pt_v0) {
-      return;
-    }
-
-    if (isITSonlyTrack(ele) && isITSonlyTrack(pos) && v0pt > max_pt_v0_itsonly) {
-      return;
-    }
-
     KFParticle kfp_pos_DecayVtx = kfp_pos;  // Don't set Primary Vertex
     KFParticle kfp_ele_DecayVtx = kfp_ele;  // Don't set Primary Vertex
     kfp_pos_DecayVtx.TransportToPoint(xyz); // Don't set Primary Vertex
@@ -564,6 +547,29 @@ struct PhotonConversionBuilder {
     if (!checkAP(alpha, qt, max_alpha_ap, max_qt_ap)) { // store only photon conversions
       return;
     }
+
+    // Apply a topological constraint of the gamma to the PV. Parameters will be given at the primary vertex.
+    KFParticle gammaKF_PV = gammaKF;
+    gammaKF_PV.SetProductionVertex(KFPV);
+    float v0pt = RecoDecay::sqrtSumOfSquares(gammaKF_PV.GetPx(), gammaKF_PV.GetPy());
+    float v0eta = RecoDecay::eta(std::array{gammaKF_PV.GetPx(), gammaKF_PV.GetPy(), gammaKF_PV.GetPz()});
+    float v0phi = RecoDecay::phi(gammaKF_PV.GetPx(), gammaKF_PV.GetPy()) > 0.f ? RecoDecay::phi(gammaKF_PV.GetPx(), gammaKF_PV.GetPy()) : RecoDecay::phi(gammaKF_PV.GetPx(), gammaKF_PV.GetPy()) + TMath::TwoPi();
+
+    // KFParticle gammaKF_DecayVtx2 = gammaKF;
+    // gammaKF_DecayVtx2.SetProductionVertex(KFPV);
+    // gammaKF_DecayVtx2.TransportToPoint(xyz);
+    // LOGF(info, "gammaKF_PV.GetPx() = %f, gammaKF_DecayVtx.GetPx() = %f, gammaKF_DecayVtx2.GetPx() = %f", gammaKF_PV.GetPx(), gammaKF_DecayVtx.GetPx(), gammaKF_DecayVtx2.GetPx());
+    // LOGF(info, "gammaKF_PV.GetPy() = %f, gammaKF_DecayVtx.GetPy() = %f, gammaKF_DecayVtx2.GetPy() = %f", gammaKF_PV.GetPy(), gammaKF_DecayVtx.GetPy(), gammaKF_DecayVtx2.GetPy());
+    // LOGF(info, "gammaKF_PV.GetPz() = %f, gammaKF_DecayVtx.GetPz() = %f, gammaKF_DecayVtx2.GetPz() = %f", gammaKF_PV.GetPz(), gammaKF_DecayVtx.GetPz(), gammaKF_DecayVtx2.GetPz());
+
+    if (fabs(v0eta) > max_eta_v0 || v0pt < min_pt_v0) {
+      return;
+    }
+
+    if (isITSonlyTrack(ele) && isITSonlyTrack(pos) && v0pt > max_pt_v0_itsonly) {
+      return;
+    }
+
     pca_map[std::make_tuple(v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex())] = pca_kf;
     cospa_map[std::make_tuple(v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex())] = cospa_kf;
 
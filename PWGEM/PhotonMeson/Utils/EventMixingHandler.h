@@ -15,6 +15,7 @@
 #ifndef PWGEM_PHOTONMESON_UTILS_EVENTMIXINGHANDLER_H_
 #define PWGEM_PHOTONMESON_UTILS_EVENTMIXINGHANDLER_H_
 
+#include <deque>
 #include <map>
 #include <utility>
 #include <vector>
@@ -49,29 +50,38 @@ class EventMixingHandler
 
   void AddTrackToEventPool(U key_df_collision, V obj)
   {
-    fMap_Tracks_per_collision[key_df_collision].emplace_back(obj);
+    fMap_Tracks_per_collision[key_df_collision].emplace_back(std::move(obj));
   }
 
-  std::vector<U> GetCollisionIdsFromEventPool(T key_bin) { return fMapMixBins[key_bin]; }
-  std::vector<V> GetTracksPerCollision(T key_bin, int index) { return fMap_Tracks_per_collision[fMapMixBins[key_bin][index]]; }
-  std::vector<V> GetTracksPerCollision(U key_df_collision) { return fMap_Tracks_per_collision[key_df_collision]; }
+  // the returned references stay valid until the collision is evicted from the pool (see AddCollisionIdAtLast) or removed
+  const std::deque<U>& GetCollisionIdsFromEventPool(T key_bin) { return fMapMixBins[key_bin]; }
+  const std::vector<V>& GetTracksPerCollision(T key_bin, int index) { return GetTracksPerCollision(fMapMixBins[key_bin][index]); }
+  const std::vector<V>& GetTracksPerCollision(U key_df_collision) const
+  {
+    auto it = fMap_Tracks_per_collision.find(key_df_collision);
+    return it == fMap_Tracks_per_collision.end() ? fEmptyTracks : it->second;
+  }
 
   // call this function at the end of collision loop
   void AddCollisionIdAtLast(T key_bin, U key_df_collision)
   {
     // LOGF(info, "fMapMixBins[key_bin].size() = %d", fMapMixBins[key_bin].size());
-    if (static_cast<int>(fMapMixBins[key_bin].size()) >= fNdepth) {
-      fMap_Tracks_per_collision[fMapMixBins[key_bin][0]].clear();
-      fMap_Tracks_per_collision[fMapMixBins[key_bin][0]].shrink_to_fit();
-      fMapMixBins[key_bin].erase(fMapMixBins[key_bin].begin());
+    auto& pool = fMapMixBins[key_bin];
+    if (!pool.empty() && static_cast<int>(pool.size()) >= fNdepth) {
+      fMap_Tracks_per_collision.erase(pool.front()); // the oldest collision of the bin is dropped together with its tracks
+      pool.pop_front();
     }
-    fMapMixBins[key_bin].emplace_back(key_df_collision);
+    pool.emplace_back(key_df_collision);
   }
 
+  // call this function instead of AddCollisionIdAtLast for a collision which is not kept in the event pool, its tracks are released
+  void RemoveCollision(U key_df_collision) { fMap_Tracks_per_collision.erase(key_df_collision); }
+
  private:
   int fNdepth;                                           // depth of event mixing
-  std::map<T, std::vector<U>> fMapMixBins;               // map : e.g. <zbin, centbin, epbin> -> pair<df index, global collision index>
+  std::map<T, std::deque<U>> fMapMixBins;                // map : e.g. <zbin, centbin, epbin> -> pair<df index, global collision index>
   std::map<U, std::vector<V>> fMap_Tracks_per_collision; // map : e.g. pair<df index, global collision index> -> track array
+  const std::vector<V> fEmptyTracks{};                   // returned for a collision without tracks in the pool
 };
 } // namespace o2::aod::pwgem::photonmeson::utils
 #endif // PWGEM_PHOTONMESON_UTILS_EVENTMIXINGHANDLER_H_
@@ -48,7 +48,7 @@ inline float v0_qt(float pxpos, float pypos, float pzpos, float pxneg, float pyn
 }
 //_______________________________________________________________________
 template <typename TrackPrecision = float, typename T1, typename T2>
-inline void Vtx_recalculation(o2::base::Propagator* prop, T1 lTrackPos, T2 lTrackNeg, float xyz[3], o2::base::Propagator::MatCorrType matCorr = o2::base::Propagator::MatCorrType::USEMatCorrNONE)
+inline void Vtx_recalculation(o2::base::Propagator* prop, T1 const& lTrackPos, T2 const& lTrackNeg, float xyz[3], o2::base::Propagator::MatCorrType matCorr = o2::base::Propagator::MatCorrType::USEMatCorrNONE)
 {
   float bz = prop->getNominalBz();
 
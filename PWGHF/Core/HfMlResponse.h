@@ -17,10 +17,37 @@
 #ifndef PWGHF_CORE_HFMLRESPONSE_H_
 #define PWGHF_CORE_HFMLRESPONSE_H_
 
+#include <array>
+#include <cstdint>
+#include <vector>
+
 #include "Tools/ML/MlResponse.h"
 
 namespace o2::analysis
 {
+namespace hf_ml_features
+{
+/// Compile-time list of input features
+/// Each feature is a type with
+/// - a static constexpr uint8_t index, the value of the feature in the EnumInputFeatures of the ML response
+/// - a static get(args...) method returning the value of the feature
+/// The list is filled with a fold expression, without any runtime dispatch on the feature index
+template <typename... Features>
+struct FeatureList {
+  static constexpr std::size_t nFeatures = sizeof...(Features);
+  static constexpr std::array<uint8_t, nFeatures> indices{Features::index...};
+
+  /// Fill the feature values in a buffer
+  /// \param output pointer to the first of nFeatures values to be filled
+  /// \param args objects forwarded to the get methods of the features (e.g. candidate and prongs)
+  template <typename TypeOutput, typename... Args>
+  static void fill(TypeOutput* output, Args&&... args)
+  {
+    std::size_t iFeature{0};
+    ((output[iFeature++] = static_cast<TypeOutput>(Features::get(args...))), ...);
+  }
+};
+} // namespace hf_ml_features
 
 template <typename TypeOutputScore = float>
 class HfMlResponse : public MlResponse<TypeOutputScore>
@@ -30,6 +57,56 @@ class HfMlResponse : public MlResponse<TypeOutputScore>
   HfMlResponse() = default;
   /// Default destructor
   virtual ~HfMlResponse() = default;
+
+  /// Check whether a compile-time feature list matches the configured input features
+  /// \return true if TFeatureList can be used instead of the string-based feature selection
+  template <typename TFeatureList>
+  bool isFeatureListConfigured() const
+  {
+    const auto& cachedIndices = MlResponse<TypeOutputScore>::mCachedIndices;
+    if (cachedIndices.size() != TFeatureList::nFeatures) {
+      return false;
+    }
+    for (std::size_t iFeature{0}; iFeature < TFeatureList::nFeatures; ++iFeature) {
+      if (cachedIndices[iFeature] != TFeatureList::indices[iFeature]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Check whether the scores produced at skim level (Hf2ProngMlProbs, Hf3ProngMlProbs) come from the same model and can be reused
+  /// \param skimModels is the HfMlSkimModels table
+  /// \param nProngs is the number of prongs of the candidates
+  /// \param decayType is the decay type of the candidates
+  /// \param nModel is the model index
+  /// \return true if the model hashes match, in that case the skim scores can be passed to isSelectedMlScores
+  /// \note The input features of the model must also be the same as the ones used at skim level
+  template <typename TSkimModels>
+  bool areSkimScoresReusable(TSkimModels const& skimModels, const uint8_t nProngs, const uint8_t decayType, const int nModel = 0) const
+  {
+    const uint64_t modelHash = MlResponse<TypeOutputScore>::getModelHash(nModel);
+    if (modelHash == 0) {
+      return false;
+    }
+    for (const auto& skimModel : skimModels) {
+      if (skimModel.nProngsMlSkim() == nProngs && skimModel.decayTypeMlSkim() == decayType) {
+        return skimModel.mlModelHashSkim() == modelHash;
+      }
+    }
+    return false;
+  }
+
+  /// Append the input features of one candidate to a batch buffer, using a compile-time feature list
+  /// \param buffer is the batch buffer, e.g. to be passed to MlResponse::enqueue or OnnxModel::evalModelBatch
+  /// \param args objects forwarded to the get methods of the features
+  template <typename TFeatureList, typename... Args>
+  void fillInputFeatures(std::vector<TypeOutputScore>& buffer, Args&&... args)
+  {
+    const std::size_t offset = buffer.size();
+    buffer.resize(offset + TFeatureList::nFeatures);
+    TFeatureList::fill(buffer.data() + offset, args...);
+  }
 };
 
 } // namespace o2::analysis
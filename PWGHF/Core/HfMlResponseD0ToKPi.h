@@ -73,6 +73,23 @@
     break;                                                                       \
   }
 
+// Declare a compile-time input feature, to be used in hf_ml_features::FeatureList,
+// returning the FEATURE's value by calling the corresponding GETTER from OBJECT
+#define DECLARE_FEATURE_D0_FULL(OBJECT, FEATURE, GETTER)                                                                \
+  struct FEATURE {                                                                                                      \
+    static constexpr uint8_t index = static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE);                               \
+    template <typename T1, typename T2>                                                                                 \
+    static float get(HfHelper&, int const&, [[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& prong0, \
+                     [[maybe_unused]] T2 const& prong1)                                                                 \
+    {                                                                                                                   \
+      return OBJECT.GETTER();                                                                                           \
+    }                                                                                                                   \
+  };
+
+// Specific case of DECLARE_FEATURE_D0_FULL(OBJECT, FEATURE, GETTER)
+// where OBJECT is named candidate and FEATURE = GETTER
+#define DECLARE_FEATURE_D0(GETTER) DECLARE_FEATURE_D0_FULL(candidate, GETTER, GETTER)
+
 namespace o2::analysis
 {
 enum class InputFeaturesD0ToKPi : uint8_t {
@@ -108,6 +125,61 @@ enum class InputFeaturesD0ToKPi : uint8_t {
   ct
 };
 
+namespace hf_ml_features_d0
+{
+// Compile-time input features of the D0 candidates
+// The arguments of the get methods are (hfHelper, pdgCode, candidate, prong0, prong1)
+DECLARE_FEATURE_D0(chi2PCA)
+DECLARE_FEATURE_D0(decayLength)
+DECLARE_FEATURE_D0(decayLengthXY)
+DECLARE_FEATURE_D0(decayLengthNormalised)
+DECLARE_FEATURE_D0(decayLengthXYNormalised)
+DECLARE_FEATURE_D0(ptProng0)
+DECLARE_FEATURE_D0(ptProng1)
+DECLARE_FEATURE_D0_FULL(candidate, impactParameterXY0, impactParameter0)
+DECLARE_FEATURE_D0_FULL(candidate, impactParameterXY1, impactParameter1)
+DECLARE_FEATURE_D0(impactParameterZ0)
+DECLARE_FEATURE_D0(impactParameterZ1)
+// TPC PID variables
+DECLARE_FEATURE_D0_FULL(prong0, nSigTpcPi0, tpcNSigmaPi)
+DECLARE_FEATURE_D0_FULL(prong0, nSigTpcKa0, tpcNSigmaKa)
+DECLARE_FEATURE_D0_FULL(prong1, nSigTpcPi1, tpcNSigmaPi)
+DECLARE_FEATURE_D0_FULL(prong1, nSigTpcKa1, tpcNSigmaKa)
+// TOF PID variables
+DECLARE_FEATURE_D0_FULL(prong0, nSigTofPi0, tofNSigmaPi)
+DECLARE_FEATURE_D0_FULL(prong0, nSigTofKa0, tofNSigmaKa)
+DECLARE_FEATURE_D0_FULL(prong1, nSigTofPi1, tofNSigmaPi)
+DECLARE_FEATURE_D0_FULL(prong1, nSigTofKa1, tofNSigmaKa)
+// Combined PID variables
+DECLARE_FEATURE_D0_FULL(prong0, nSigTpcTofPi0, tpcTofNSigmaPi)
+DECLARE_FEATURE_D0_FULL(prong0, nSigTpcTofKa0, tpcTofNSigmaKa)
+DECLARE_FEATURE_D0_FULL(prong1, nSigTpcTofPi1, tpcTofNSigmaPi)
+DECLARE_FEATURE_D0_FULL(prong1, nSigTpcTofKa1, tpcTofNSigmaKa)
+
+DECLARE_FEATURE_D0(maxNormalisedDeltaIP)
+DECLARE_FEATURE_D0_FULL(candidate, impactParameterProduct, impactParameterProduct)
+DECLARE_FEATURE_D0(cpa)
+DECLARE_FEATURE_D0(cpaXY)
+
+struct cosThetaStar {
+  static constexpr uint8_t index = static_cast<uint8_t>(InputFeaturesD0ToKPi::cosThetaStar);
+  template <typename T1, typename T2>
+  static float get(HfHelper& hfHelper, int const& pdgCode, T1 const& candidate, T2 const&, T2 const&)
+  {
+    return pdgCode == o2::constants::physics::kD0 ? hfHelper.cosThetaStarD0(candidate) : hfHelper.cosThetaStarD0bar(candidate);
+  }
+};
+
+struct ct {
+  static constexpr uint8_t index = static_cast<uint8_t>(InputFeaturesD0ToKPi::ct);
+  template <typename T1, typename T2>
+  static float get(HfHelper& hfHelper, int const&, T1 const& candidate, T2 const&, T2 const&)
+  {
+    return hfHelper.ctD0(candidate);
+  }
+};
+} // namespace hf_ml_features_d0
+
 template <typename TypeOutputScore = float>
 class HfMlResponseD0ToKPi : public HfMlResponse<TypeOutputScore>
 {
@@ -171,6 +243,19 @@ class HfMlResponseD0ToKPi : public HfMlResponse<TypeOutputScore>
     return inputFeatures;
   }
 
+  /// Method to append the input features of one candidate to a batch buffer, using a compile-time feature list
+  /// \param buffer is the batch buffer
+  /// \param candidate is the D0 candidate
+  /// \param prong0 is the candidate's prong0
+  /// \param prong1 is the candidate's prong1
+  /// \note TFeatureList is a hf_ml_features::FeatureList of types from hf_ml_features_d0; use getInputFeatures if isFeatureListConfigured<TFeatureList>() is false
+  template <typename TFeatureList, typename T1, typename T2>
+  void fillInputFeatures(std::vector<TypeOutputScore>& buffer, T1 const& candidate,
+                         T2 const& prong0, T2 const& prong1, int const& pdgCode)
+  {
+    HfMlResponse<TypeOutputScore>::template fillInputFeatures<TFeatureList>(buffer, hfHelper, pdgCode, candidate, prong0, prong1);
+  }
+
  protected:
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
@@ -219,5 +304,7 @@ class HfMlResponseD0ToKPi : public HfMlResponse<TypeOutputScore>
 #undef CHECK_AND_FILL_VEC_D0
 #undef CHECK_AND_FILL_VEC_D0_HFHELPER
 #undef CHECK_AND_FILL_VEC_D0_HFHELPER_SIGNED
+#undef DECLARE_FEATURE_D0_FULL
+#undef DECLARE_FEATURE_D0
 
 #endif // PWGHF_CORE_HFMLRESPONSED0TOKPI_H_
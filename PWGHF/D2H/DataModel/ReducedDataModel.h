@@ -262,6 +262,45 @@ DECLARE_SOA_TABLE(HfRedBplusD0Mls, "AOD", "HFREDBPLUSD0ML", //! Table with ML sc
                   hf_cand_bplus_reduced::Prong0MlScoreNonprompt,
                   o2::soa::Marker<1>);
 
+// Beauty candidates from mixed events (D meson of a collision paired with a bachelor of a previous collision)
+namespace hf_cand_mixed_reduced
+{
+DECLARE_SOA_COLUMN(InvMass, invMass, float);                               //! Invariant mass of the candidate (GeV/c2)
+DECLARE_SOA_COLUMN(Pt, pt, float);                                         //! Transverse momentum of the candidate (GeV/c)
+DECLARE_SOA_COLUMN(PtProng0, ptProng0, float);                             //! Transverse momentum of the D daughter (GeV/c)
+DECLARE_SOA_COLUMN(PtProng1, ptProng1, float);                             //! Transverse momentum of the bachelor (GeV/c)
+DECLARE_SOA_COLUMN(SignProng1, signProng1, int8_t);                        //! Charge sign of the bachelor
+DECLARE_SOA_COLUMN(Chi2PCA, chi2PCA, float);                               //! Sum of (non-weighted) distances of the secondary vertex to its prongs
+DECLARE_SOA_COLUMN(DecayLength, decayLength, float);                       //! Decay length of the candidate (cm)
+DECLARE_SOA_COLUMN(DecayLengthXY, decayLengthXY, float);                   //! Transverse decay length of the candidate (cm)
+DECLARE_SOA_COLUMN(Cpa, cpa, float);                                       //! Cosine of the pointing angle of the candidate
+DECLARE_SOA_COLUMN(ImpactParameterProduct, impactParameterProduct, float); //! Product of the impact parameters of the daughters (cm2)
+DECLARE_SOA_COLUMN(DeltaPosZ, deltaPosZ, float);                           //! Difference of the z positions of the primary vertices of the mixed collisions (cm)
+} // namespace hf_cand_mixed_reduced
+
+#define HFCANDMIXEDREDUCED_COLUMNS                 \
+  hf_cand_mixed_reduced::InvMass,                  \
+    hf_cand_mixed_reduced::Pt,                     \
+    hf_cand_mixed_reduced::PtProng0,               \
+    hf_cand_mixed_reduced::PtProng1,               \
+    hf_cand_mixed_reduced::SignProng1,             \
+    hf_cand_mixed_reduced::Chi2PCA,                \
+    hf_cand_mixed_reduced::DecayLength,            \
+    hf_cand_mixed_reduced::DecayLengthXY,          \
+    hf_cand_mixed_reduced::Cpa,                    \
+    hf_cand_mixed_reduced::ImpactParameterProduct, \
+    hf_cand_mixed_reduced::DeltaPosZ
+
+DECLARE_SOA_TABLE(HfRedB0Mixeds, "AOD", "HFREDB0MIXED", //! Table with B0 candidates from mixed events
+                  hf_track_index_reduced::HfRedCollisionId,
+                  hf_cand_b0_reduced::Prong0Id,
+                  HFCANDMIXEDREDUCED_COLUMNS);
+
+DECLARE_SOA_TABLE(HfRedBplusMixeds, "AOD", "HFREDBPMIXED", //! Table with B+ candidates from mixed events
+                  hf_track_index_reduced::HfRedCollisionId,
+                  hf_cand_bplus_reduced::Prong0Id,
+                  HFCANDMIXEDREDUCED_COLUMNS);
+
 using HfRedCandBplus = soa::Join<HfCandBplusExt, HfRedBplusProngs>;
 
 namespace hf_b0_mc
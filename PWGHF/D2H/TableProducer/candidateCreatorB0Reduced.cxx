@@ -27,6 +27,7 @@
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
 #include "PWGHF/D2H/DataModel/ReducedDataModel.h"
+#include "PWGHF/D2H/Utils/utilsRedMixing.h"
 #include "PWGHF/Utils/utilsTrkCandHf.h"
 
 using namespace o2;
@@ -40,6 +41,7 @@ struct HfCandidateCreatorB0Reduced {
   Produces<aod::HfCandB0Base> rowCandidateBase;         // table defined in CandidateReconstructionTables.h
   Produces<aod::HfRedB0Prongs> rowCandidateProngs;      // table defined in ReducedDataModel.h
   Produces<aod::HfRedB0DpMls> rowCandidateDmesMlScores; // table defined in ReducedDataModel.h
+  Produces<aod::HfRedB0Mixeds> rowCandidateMixed;       // table defined in ReducedDataModel.h
 
   // vertexing
   Configurable<bool> propagateToPCA{"propagateToPCA", true, "create tracks version propagated to PCA"};
@@ -51,6 +53,10 @@ struct HfCandidateCreatorB0Reduced {
   Configurable<float> minRelChi2Change{"minRelChi2Change", 0.9, "stop iterations is chi2/chi2old > this"};
   // selection
   Configurable<float> invMassWindowDPiTolerance{"invMassWindowDPiTolerance", 0.01, "invariant-mass window tolerance for DPi pair preselections (GeV/c2)"};
+  // event mixing
+  Configurable<std::vector<double>> binsPosZMixing{"binsPosZMixing", std::vector<double>{-10., -5., -2.5, 0., 2.5, 5., 10.}, "Bin limits of the z position of the primary vertex for the event mixing (cm)"};
+  Configurable<std::vector<double>> binsMultMixing{"binsMultMixing", std::vector<double>{0., 5., 10., 20., 50., 10000.}, "Bin limits of the number of pion tracks of the reduced collision for the event mixing"};
+  Configurable<int> poolDepthMixing{"poolDepthMixing", 5, "Number of previous collisions of the same bin mixed with each collision"};
 
   float myInvMassWindowDPi{1.}; // variable that will store the value of invMassWindowDPi (defined in dataCreatorDplusPiReduced.cxx)
   float massPi{0.};
@@ -58,7 +64,8 @@ struct HfCandidateCreatorB0Reduced {
   float massB0{0.};
   float bz{0.};
 
-  o2::vertexing::DCAFitterN<2> df2; // fitter for B vertex (2-prong vertex fitter)
+  o2::vertexing::DCAFitterN<2> df2;                                     // fitter for B vertex (2-prong vertex fitter)
+  o2::hf_red_mixing::HfRedMixingPool<o2::track::TrackParCov> poolPions; // pions of the previous collisions, kept across dataframes
 
   using HfRedCollisionsWithExtras = soa::Join<aod::HfRedCollisions, aod::HfRedCollExtras>;
 
@@ -90,6 +97,11 @@ struct HfCandidateCreatorB0Reduced {
     df2.setUseAbsDCA(useAbsDCA);
     df2.setWeightedFinalPCA(useWeightedFinalPCA);
 
+    if (doprocessDataMixedEvent) {
+      poolPions.configure(binsPosZMixing, binsMultMixing, poolDepthMixing);
+      registry.add("hMassB0ToDPiMixedEvent", "2-prong candidates from mixed events;inv. mass (B^{0} #rightarrow D^{#minus}#pi^{#plus} #rightarrow #pi^{#minus}K^{#plus}#pi^{#minus}#pi^{#plus}) (GeV/#it{c}^{2});entries", {HistType::kTH1F, {{500, 3., 8.}}});
+    }
+
     // histograms
     registry.add("hMassB0ToDPi", "2-prong candidates;inv. mass (B^{0} #rightarrow D^{#minus}#pi^{#plus} #rightarrow #pi^{#minus}K^{#plus}#pi^{#minus}#pi^{#plus}) (GeV/#it{c}^{2});entries", {HistType::kTH1F, {{500, 3., 8.}}});
     registry.add("hCovPVXX", "2-prong candidates;XX element of cov. matrix of prim. vtx. position (cm^{2});entries", {HistType::kTH1F, {{100, 0., 1.e-4}}});
@@ -271,6 +283,113 @@ struct HfCandidateCreatorB0Reduced {
   } // processDataWithDmesMl
 
   PROCESS_SWITCH(HfCandidateCreatorB0Reduced, processDataWithDmesMl, "Process data with ML scores of D mesons", false);
+
+  /// B0 candidate creation with the pions of previous collisions of the same pool
+  /// \param collision the collision
+  /// \param candsDThisColl D candidates in this collision
+  /// \param pool pions of the previous collisions
+  /// \param invMass2DPiMin minimum B0 invariant-mass
+  /// \param invMass2DPiMax maximum B0 invariant-mass
+  template <typename Cands, typename Coll, typename Pool>
+  void runMixedCandidateCreation(Coll const& collision,
+                                 Cands const& candsDThisColl,
+                                 Pool const& pool,
+                                 const float& invMass2DPiMin,
+                                 const float& invMass2DPiMax)
+  {
+    auto primaryVertex = getPrimaryVertex(collision);
+    const std::array<float, 3> posPrimaryVertex{collision.posX(), collision.posY(), collision.posZ()};
+
+    bz = collision.bz();
+    df2.setBz(bz);
+
+    for (const auto& candD : candsDThisColl) {
+      const auto trackParCovD = getTrackParCov(candD);
+      const std::array<float, 3> pVecDAtPV = candD.pVector();
+      o2::dataformats::DCA dcaD;
+      auto trackParCovDAtPV = trackParCovD;
+      trackParCovDAtPV.propagateToDCA(primaryVertex, bz, &dcaD);
+
+      for (const auto& entry : pool) {
+        // the pions are moved along z to the primary vertex of this collision
+        const float deltaPosZ = collision.posZ() - entry.posZ;
+        for (const auto& trackParCovPiPool : entry.objects) {
+          auto trackParCovPi = trackParCovPiPool;
+          trackParCovPi.setZ(trackParCovPi.getZ() + deltaPosZ);
+          std::array<float, 3> pVecPion{};
+          trackParCovPi.getPxPyPzGlo(pVecPion);
+
+          auto invMass2DPi = RecoDecay::m2(std::array{pVecDAtPV, pVecPion}, std::array{massD, massPi});
+          if ((invMass2DPi < invMass2DPiMin) || (invMass2DPi > invMass2DPiMax)) {
+            continue;
+          }
+          try {
+            if (df2.process(trackParCovD, trackParCovPi) == 0) {
+              continue;
+            }
+          } catch (const std::runtime_error& error) {
+            LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
+            continue;
+          }
+          const auto& secondaryVertexB0 = df2.getPCACandidate();
+          auto chi2PCA = df2.getChi2AtPCACandidate();
+          df2.propagateTracksToVertex();
+          std::array<float, 3> pVecD{};
+          df2.getTrack(0).getPxPyPzGlo(pVecD);    // momentum of D at the B0 vertex
+          df2.getTrack(1).getPxPyPzGlo(pVecPion); // momentum of Pi at the B0 vertex
+          auto pVecB0 = RecoDecay::pVec(pVecD, pVecPion);
+          auto invMassB0 = RecoDecay::m(std::array{pVecD, pVecPion}, std::array{massD, massPi});
+          registry.fill(HIST("hMassB0ToDPiMixedEvent"), invMassB0);
+
+          o2::dataformats::DCA dcaPion;
+          trackParCovPi.propagateToDCA(primaryVertex, bz, &dcaPion);
+
+          rowCandidateMixed(collision.globalIndex(), candD.globalIndex(),
+                            invMassB0, RecoDecay::pt(pVecB0), RecoDecay::pt(pVecD), RecoDecay::pt(pVecPion), trackParCovPi.getSign(),
+                            chi2PCA,
+                            RecoDecay::distance(posPrimaryVertex, secondaryVertexB0), RecoDecay::distanceXY(posPrimaryVertex, secondaryVertexB0),
+                            RecoDecay::cpa(posPrimaryVertex, secondaryVertexB0, pVecB0),
+                            dcaD.getY() * dcaPion.getY(),
+                            deltaPosZ);
+        } // pi loop
+      }   // pool loop
+    }     // D loop
+  }
+
+  void processDataMixedEvent(HfRedCollisionsWithExtras const& collisions,
+                             soa::Join<aod::HfRed3Prongs, aod::HfRed3ProngsCov> const& candsD,
+                             soa::Join<aod::HfRedTrackBases, aod::HfRedTracksCov> const& tracksPion,
+                             aod::HfCandB0Configs const& configs)
+  {
+    // DPi invariant-mass window cut
+    for (const auto& config : configs) {
+      myInvMassWindowDPi = config.myInvMassWindowDPi();
+    }
+    float invMass2DPiMin = (massB0 - myInvMassWindowDPi + invMassWindowDPiTolerance) * (massB0 - myInvMassWindowDPi + invMassWindowDPiTolerance);
+    float invMass2DPiMax = (massB0 + myInvMassWindowDPi - invMassWindowDPiTolerance) * (massB0 + myInvMassWindowDPi - invMassWindowDPiTolerance);
+
+    for (const auto& collision : collisions) {
+      auto thisCollId = collision.globalIndex();
+      auto candsDThisColl = candsD.sliceBy(candsDPerCollision, thisCollId);
+      auto tracksPionThisCollision = tracksPion.sliceBy(tracksPionPerCollision, thisCollId);
+      const int binPool = poolPions.getBin(collision.posZ(), tracksPionThisCollision.size());
+      if (binPool < 0) {
+        continue;
+      }
+      // the pions of this collision are added to the pool after the mixing, to pair only different collisions
+      if (candsDThisColl.size() > 0) {
+        runMixedCandidateCreation(collision, candsDThisColl, poolPions.getPool(binPool), invMass2DPiMin, invMass2DPiMax);
+      }
+      std::vector<o2::track::TrackParCov> pionsThisCollision;
+      pionsThisCollision.reserve(tracksPionThisCollision.size());
+      for (const auto& trackPion : tracksPionThisCollision) {
+        pionsThisCollision.push_back(getTrackParCov(trackPion));
+      }
+      poolPions.add(binPool, collision.posZ(), std::move(pionsThisCollision));
+    }
+  } // processDataMixedEvent
+
+  PROCESS_SWITCH(HfCandidateCreatorB0Reduced, processDataMixedEvent, "Process data with event mixing of the D mesons and the pions of previous collisions", false);
 }; // struct
 
 /// Extends the table base with expression columns and performs MC matching.
@@ -27,6 +27,7 @@
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
 #include "PWGHF/D2H/DataModel/ReducedDataModel.h"
+#include "PWGHF/D2H/Utils/utilsRedMixing.h"
 #include "PWGHF/Utils/utilsTrkCandHf.h"
 
 using namespace o2;
@@ -40,6 +41,7 @@ struct HfCandidateCreatorBplusReduced {
   Produces<aod::HfCandBplusBase> rowCandidateBase;         // table defined in CandidateReconstructionTables.h
   Produces<aod::HfRedBplusProngs> rowCandidateProngs;      // table defined in ReducedDataModel.h
   Produces<aod::HfRedBplusD0Mls> rowCandidateDmesMlScores; // table defined in ReducedDataModel.h
+  Produces<aod::HfRedBplusMixeds> rowCandidateMixed;       // table defined in ReducedDataModel.h
 
   // vertexing
   Configurable<bool> propagateToPCA{"propagateToPCA", true, "create tracks version propagated to PCA"};
@@ -51,13 +53,18 @@ struct HfCandidateCreatorBplusReduced {
   Configurable<double> minRelChi2Change{"minRelChi2Change", 0.9, "stop iterations is chi2/chi2old > this"};
   // selection
   Configurable<double> invMassWindowD0PiTolerance{"invMassWindowD0PiTolerance", 0.01, "invariant-mass window tolerance for D0Pi pair preselections (GeV/c2)"};
+  // event mixing
+  Configurable<std::vector<double>> binsPosZMixing{"binsPosZMixing", std::vector<double>{-10., -5., -2.5, 0., 2.5, 5., 10.}, "Bin limits of the z position of the primary vertex for the event mixing (cm)"};
+  Configurable<std::vector<double>> binsMultMixing{"binsMultMixing", std::vector<double>{0., 5., 10., 20., 50., 10000.}, "Bin limits of the number of pion tracks of the reduced collision for the event mixing"};
+  Configurable<int> poolDepthMixing{"poolDepthMixing", 5, "Number of previous collisions of the same bin mixed with each collision"};
 
   float myInvMassWindowD0Pi{1.}; // variable that will store the value of invMassWindowD0Pi (defined in dataCreatorD0PiReduced.cxx)
   double massPi{0.};
   double massD0{0.};
   double massBplus{0.};
   double bz{0.};
-  o2::vertexing::DCAFitterN<2> df2; // fitter for B vertex (2-prong vertex fitter)
+  o2::vertexing::DCAFitterN<2> df2;                                     // fitter for B vertex (2-prong vertex fitter)
+  o2::hf_red_mixing::HfRedMixingPool<o2::track::TrackParCov> poolPions; // pions of the previous collisions, kept across dataframes
 
   using HfRedCollisionsWithExtras = soa::Join<aod::HfRedCollisions, aod::HfRedCollExtras>;
 
@@ -89,6 +96,11 @@ struct HfCandidateCreatorBplusReduced {
     df2.setUseAbsDCA(useAbsDCA);
     df2.setWeightedFinalPCA(useWeightedFinalPCA);
 
+    if (doprocessDataMixedEvent) {
+      poolPions.configure(binsPosZMixing, binsMultMixing, poolDepthMixing);
+      registry.add("hMassBplusToD0PiMixedEvent", "2-prong candidates from mixed events;inv. mass (B^{+} #rightarrow #overline{D^{0}}#pi^{#plus} #rightarrow #pi^{#minus}K^{#plus}#pi^{#plus}) (GeV/#it{c}^{2});entries", {HistType::kTH1F, {{500, 3., 8.}}});
+    }
+
     // histograms
     registry.add("hMassBplusToD0Pi", "2-prong candidates;inv. mass (B^{+} #rightarrow #overline{D^{0}}#pi^{#plus} #rightarrow #pi^{#minus}K^{#plus}#pi^{#plus}) (GeV/#it{c}^{2});entries", {HistType::kTH1F, {{500, 3., 8.}}});
     registry.add("hCovPVXX", "2-prong candidates;XX element of cov. matrix of prim. vtx. position (cm^{2});entries", {HistType::kTH1F, {{100, 0., 1.e-4}}});
@@ -269,6 +281,113 @@ struct HfCandidateCreatorBplusReduced {
   } // processDataWithDmesMl
 
   PROCESS_SWITCH(HfCandidateCreatorBplusReduced, processDataWithDmesMl, "Process data with ML scores of D mesons", false);
+
+  /// B+ candidate creation with the pions of previous collisions of the same pool
+  /// \param collision the collision
+  /// \param candsDThisColl D0 candidates in this collision
+  /// \param pool pions of the previous collisions
+  /// \param invMass2D0PiMin minimum B+ invariant-mass
+  /// \param invMass2D0PiMax maximum B+ invariant-mass
+  template <typename Cands, typename Coll, typename Pool>
+  void runMixedCandidateCreation(Coll const& collision,
+                                 Cands const& candsDThisColl,
+                                 Pool const& pool,
+                                 const float& invMass2D0PiMin,
+                                 const float& invMass2D0PiMax)
+  {
+    auto primaryVertex = getPrimaryVertex(collision);
+    const std::array<float, 3> posPrimaryVertex{collision.posX(), collision.posY(), collision.posZ()};
+
+    bz = collision.bz();
+    df2.setBz(bz);
+
+    for (const auto& candD0 : candsDThisColl) {
+      const auto trackParCovD = getTrackParCov(candD0);
+      const std::array<float, 3> pVecD0AtPV = candD0.pVector();
+      o2::dataformats::DCA dcaD0;
+      auto trackParCovDAtPV = trackParCovD;
+      trackParCovDAtPV.propagateToDCA(primaryVertex, bz, &dcaD0);
+
+      for (const auto& entry : pool) {
+        // the pions are moved along z to the primary vertex of this collision
+        const float deltaPosZ = collision.posZ() - entry.posZ;
+        for (const auto& trackParCovPiPool : entry.objects) {
+          auto trackParCovPi = trackParCovPiPool;
+          trackParCovPi.setZ(trackParCovPi.getZ() + deltaPosZ);
+          std::array<float, 3> pVecPion{};
+          trackParCovPi.getPxPyPzGlo(pVecPion);
+
+          auto invMass2D0Pi = RecoDecay::m2(std::array{pVecD0AtPV, pVecPion}, std::array{massD0, massPi});
+          if ((invMass2D0Pi < invMass2D0PiMin) || (invMass2D0Pi > invMass2D0PiMax)) {
+            continue;
+          }
+          try {
+            if (df2.process(trackParCovD, trackParCovPi) == 0) {
+              continue;
+            }
+          } catch (const std::runtime_error& error) {
+            LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
+            continue;
+          }
+          const auto& secondaryVertexBplus = df2.getPCACandidate();
+          auto chi2PCA = df2.getChi2AtPCACandidate();
+          df2.propagateTracksToVertex();
+          std::array<float, 3> pVecD0{};
+          df2.getTrack(0).getPxPyPzGlo(pVecD0);   // momentum of D0 at the B+ vertex
+          df2.getTrack(1).getPxPyPzGlo(pVecPion); // momentum of Pi at the B+ vertex
+          auto pVecBplus = RecoDecay::pVec(pVecD0, pVecPion);
+          auto invMassBplus = RecoDecay::m(std::array{pVecD0, pVecPion}, std::array{massD0, massPi});
+          registry.fill(HIST("hMassBplusToD0PiMixedEvent"), invMassBplus);
+
+          o2::dataformats::DCA dcaPion;
+          trackParCovPi.propagateToDCA(primaryVertex, bz, &dcaPion);
+
+          rowCandidateMixed(collision.globalIndex(), candD0.globalIndex(),
+                            invMassBplus, RecoDecay::pt(pVecBplus), RecoDecay::pt(pVecD0), RecoDecay::pt(pVecPion), trackParCovPi.getSign(),
+                            chi2PCA,
+                            RecoDecay::distance(posPrimaryVertex, secondaryVertexBplus), RecoDecay::distanceXY(posPrimaryVertex, secondaryVertexBplus),
+                            RecoDecay::cpa(posPrimaryVertex, secondaryVertexBplus, pVecBplus),
+                            dcaD0.getY() * dcaPion.getY(),
+                            deltaPosZ);
+        } // pi loop
+      }   // pool loop
+    }     // D0 loop
+  }
+
+  void processDataMixedEvent(HfRedCollisionsWithExtras const& collisions,
+                             soa::Join<aod::HfRed2Prongs, aod::HfRed2ProngsCov> const& candsD,
+                             soa::Join<aod::HfRedTrackBases, aod::HfRedTracksCov> const& tracksPion,
+                             aod::HfCandBpConfigs const& configs)
+  {
+    // D0Pi invariant-mass window cut
+    for (const auto& config : configs) {
+      myInvMassWindowD0Pi = config.myInvMassWindowD0Pi();
+    }
+    double invMass2D0PiMin = (massBplus - myInvMassWindowD0Pi + invMassWindowD0PiTolerance) * (massBplus - myInvMassWindowD0Pi + invMassWindowD0PiTolerance);
+    double invMass2D0PiMax = (massBplus + myInvMassWindowD0Pi - invMassWindowD0PiTolerance) * (massBplus + myInvMassWindowD0Pi - invMassWindowD0PiTolerance);
+
+    for (const auto& collision : collisions) {
+      auto thisCollId = collision.globalIndex();
+      auto candsDThisColl = candsD.sliceBy(candsDPerCollision, thisCollId);
+      auto tracksPionThisCollision = tracksPion.sliceBy(tracksPionPerCollision, thisCollId);
+      const int binPool = poolPions.getBin(collision.posZ(), tracksPionThisCollision.size());
+      if (binPool < 0) {
+        continue;
+      }
+      // the pions of this collision are added to the pool after the mixing, to pair only different collisions
+      if (candsDThisColl.size() > 0) {
+        runMixedCandidateCreation(collision, candsDThisColl, poolPions.getPool(binPool), invMass2D0PiMin, invMass2D0PiMax);
+      }
+      std::vector<o2::track::TrackParCov> pionsThisCollision;
+      pionsThisCollision.reserve(tracksPionThisCollision.size());
+      for (const auto& trackPion : tracksPionThisCollision) {
+        pionsThisCollision.push_back(getTrackParCov(trackPion));
+      }
+      poolPions.add(binPool, collision.posZ(), std::move(pionsThisCollision));
+    }
+  } // processDataMixedEvent
+
+  PROCESS_SWITCH(HfCandidateCreatorBplusReduced, processDataMixedEvent, "Process data with event mixing of the D0 mesons and the pions of previous collisions", false);
 }; // struct
 
 /// Extends the table base with expression columns and performs MC matching.
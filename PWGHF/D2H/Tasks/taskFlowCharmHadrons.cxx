@@ -306,10 +306,16 @@ struct HfTaskFlowCharmHadrons {
     float evtPl = epHelper.GetEventPlane(xQVec, yQVec, harmonic);
     float cent = getCentrality(collision);
     int nProngs = 3;
+    // buffers reused for all the candidates of the event
+    std::vector<float> outputMl;
+    std::vector<float> tracksQx;
+    std::vector<float> tracksQy;
+    tracksQx.reserve(3);
+    tracksQy.reserve(3);
 
     for (const auto& candidate : candidates) {
       float massCand = 0.;
-      std::vector<float> outputMl = {-999., -999.};
+      outputMl.assign(2, -999.);
 
       if constexpr (std::is_same_v<T1, CandDsData> || std::is_same_v<T1, CandDsDataWMl>) {
         switch (channel) {
@@ -383,8 +389,8 @@ struct HfTaskFlowCharmHadrons {
       // If TPC is used for the SP estimation, the tracks of the hadron candidate must be removed from the TPC Q vector to avoid double counting
       if (qvecDetector == QvecEstimator::TPCNeg || qvecDetector == QvecEstimator::TPCPos) {
         float ampl = amplQVec - static_cast<float>(nProngs);
-        std::vector<float> tracksQx = {};
-        std::vector<float> tracksQy = {};
+        tracksQx.clear();
+        tracksQy.clear();
 
         getQvecDtracks<channel>(candidate, tracksQx, tracksQy, ampl);
         for (auto iTrack{0u}; iTrack < tracksQx.size(); ++iTrack) {
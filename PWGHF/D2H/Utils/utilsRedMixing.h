@@ -0,0 +1,101 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file utilsRedMixing.h
+/// \brief Event-mixing pools for reduced data format analyses
+
+#ifndef PWGHF_D2H_UTILS_UTILSREDMIXING_H_
+#define PWGHF_D2H_UTILS_UTILSREDMIXING_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace o2::hf_red_mixing
+{
+/// \brief Bounded pools of objects (e.g. bachelor tracks) of the previous collisions, per bin of z vertex and multiplicity
+/// The pools are kept across dataframes, each of them contains at most the objects of the last poolDepth collisions of the bin.
+template <typename T>
+class HfRedMixingPool
+{
+ public:
+  /// Objects of a collision in a pool
+  struct Entry {
+    float posZ;             ///< z position of the primary vertex of the collision
+    std::vector<T> objects; ///< objects of the collision
+  };
+
+  /// Sets the binning and the depth of the pools, the pools are emptied
+  /// \param binsPosZ bin limits of the z position of the primary vertex
+  /// \param binsMult bin limits of the multiplicity
+  /// \param poolDepth maximum number of collisions per pool
+  void configure(const std::vector<double>& binsPosZ, const std::vector<double>& binsMult, std::size_t poolDepth)
+  {
+    mBinsPosZ = binsPosZ;
+    mBinsMult = binsMult;
+    mPoolDepth = poolDepth;
+    const std::size_t nBins = mBinsPosZ.size() > 1 && mBinsMult.size() > 1 ? (mBinsPosZ.size() - 1) * (mBinsMult.size() - 1) : 0;
+    mPools.assign(nBins, {});
+  }
+
+  /// Finds the pool of a collision
+  /// \param posZ z position of the primary vertex
+  /// \param mult multiplicity
+  /// \return index of the pool, -1 if the collision is outside the binning
+  int getBin(float posZ, float mult) const
+  {
+    const int binPosZ = findBin(mBinsPosZ, posZ);
+    const int binMult = findBin(mBinsMult, mult);
+    if (binPosZ < 0 || binMult < 0) {
+      return -1;
+    }
+    return binPosZ * (static_cast<int>(mBinsMult.size()) - 1) + binMult;
+  }
+
+  /// Collisions of a pool, from the oldest to the most recent
+  const std::deque<Entry>& getPool(int bin) const { return mPools[bin]; }
+
+  /// Adds the objects of a collision to a pool, the oldest collision is dropped if the pool is full
+  /// \param bin index of the pool (see getBin)
+  /// \param posZ z position of the primary vertex
+  /// \param objects objects of the collision
+  void add(int bin, float posZ, std::vector<T>&& objects)
+  {
+    if (bin < 0 || objects.empty() || mPoolDepth == 0) {
+      return;
+    }
+    auto& pool = mPools[bin];
+    if (pool.size() >= mPoolDepth) {
+      pool.pop_front();
+    }
+    pool.push_back(Entry{posZ, std::move(objects)});
+  }
+
+ private:
+  static int findBin(const std::vector<double>& bins, double value)
+  {
+    if (bins.size() < 2 || value < bins.front() || value >= bins.back()) {
+      return -1;
+    }
+    return std::distance(bins.begin(), std::upper_bound(bins.begin(), bins.end(), value)) - 1;
+  }
+
+  std::vector<double> mBinsPosZ;         ///< bin limits of the z position of the primary vertex
+  std::vector<double> mBinsMult;         ///< bin limits of the multiplicity
+  std::size_t mPoolDepth{0};             ///< maximum number of collisions per pool
+  std::vector<std::deque<Entry>> mPools; ///< pools, indexed by (z bin, multiplicity bin)
+};
+} // namespace o2::hf_red_mixing
+
+#endif // PWGHF_D2H_UTILS_UTILSREDMIXING_H_
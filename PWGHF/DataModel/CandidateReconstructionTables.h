@@ -188,6 +188,43 @@ DECLARE_SOA_TABLE(PidTpcTofTinyKa, "AOD", "PIDTPCTOFTINYKA", //! Table of the TP
 DECLARE_SOA_TABLE(PidTpcTofTinyPr, "AOD", "PIDTPCTOFTINYPR", //! Table of the TPC & TOF Combined NSigma for proton
                   pid_tpc_tof_static_tiny::TpcTofNSigmaPr);
 
+namespace hf_pid_status
+{
+/// PID selections in the status word
+enum PidMode : int {
+  Tpc = 0,
+  Tof,
+  TpcOrTof,
+  TpcAndTof,
+  Bayes,
+  NPidModes
+};
+/// Particle species in the status word
+enum PidSpecies : int {
+  Pion = 0,
+  Kaon,
+  Proton,
+  NPidSpecies
+};
+static constexpr int NBitsStatus = 2; // bits per status (TrackSelectorPID::Status)
+static constexpr int NBitsMode = NBitsStatus * NPidSpecies;
+
+/// Builds the status word from the words of the PID selections (TrackSelectorPidMulti<kPiPlus, kKPlus, kProton>)
+inline uint32_t packPidStatus(uint32_t wordTpc, uint32_t wordTof, uint32_t wordTpcOrTof, uint32_t wordTpcAndTof, uint32_t wordBayes)
+{
+  return wordTpc << (Tpc * NBitsMode) | wordTof << (Tof * NBitsMode) | wordTpcOrTof << (TpcOrTof * NBitsMode) | wordTpcAndTof << (TpcAndTof * NBitsMode) | wordBayes << (Bayes * NBitsMode);
+}
+
+DECLARE_SOA_COLUMN(PidStatusWord, pidStatusWord, uint32_t); //! Packed PID selection statuses of pion, kaon and proton for all the PID selections
+DECLARE_SOA_DYNAMIC_COLUMN(PidStatus, pidStatus,            //! PID selection status (TrackSelectorPID::Status) of a species for a PID selection
+                           [](uint32_t word, int mode, int species) -> int { return (word >> (mode * NBitsMode + species * NBitsStatus)) & ((1u << NBitsStatus) - 1); });
+} // namespace hf_pid_status
+
+// Track-joinable PID selection statuses, computed once per track for all the selectors
+DECLARE_SOA_TABLE(HfPidStatuses, "AOD", "HFPIDSTATUS", //!
+                  hf_pid_status::PidStatusWord,
+                  hf_pid_status::PidStatus<hf_pid_status::PidStatusWord>);
+
 namespace hf_sel_collision
 {
 DECLARE_SOA_COLUMN(WhyRejectColl, whyRejectColl, uint16_t); //!
@@ -262,6 +299,10 @@ DECLARE_SOA_COLUMN(MlProbSkimDplusToPiKPi, mlProbSkimDplusToPiKPi, std::vector<f
 DECLARE_SOA_COLUMN(MlProbSkimDsToKKPi, mlProbSkimDsToKKPi, std::vector<float>);         //! ML probabilities (background, prompt, non-prompt) for Ds->KKpi
 DECLARE_SOA_COLUMN(MlProbSkimLcToPKPi, mlProbSkimLcToPKPi, std::vector<float>);         //! ML probabilities (background, prompt, non-prompt) for Lc->pKpi
 DECLARE_SOA_COLUMN(MlProbSkimXicToPKPi, mlProbSkimXicToPKPi, std::vector<float>);       //! ML probabilities (background, prompt, non-prompt) for Xic->pKpi
+
+DECLARE_SOA_COLUMN(NProngsMlSkim, nProngsMlSkim, uint8_t);      //! number of prongs of the candidates scored by the skim ML model
+DECLARE_SOA_COLUMN(DecayTypeMlSkim, decayTypeMlSkim, uint8_t);  //! decay type (hf_cand_2prong::DecayType or hf_cand_3prong::DecayType) scored by the skim ML model
+DECLARE_SOA_COLUMN(MlModelHashSkim, mlModelHashSkim, uint64_t); //! hash of the skim ML model file (see MlResponse::getModelHash)
 } // namespace hf_track_index
 
 DECLARE_SOA_TABLE(Hf2Prongs_000, "AOD", "HF2PRONG", //! Table for HF 2 prong candidates (Run 2 converted format)
@@ -370,6 +411,11 @@ DECLARE_SOA_TABLE(Hf3ProngMlProbs, "AOD", "HF3PRONGMLPROB", //! Table for ML sco
                   hf_track_index::MlProbSkimDsToKKPi,
                   hf_track_index::MlProbSkimXicToPKPi);
 
+DECLARE_SOA_TABLE(HfMlSkimModels, "AOD", "HFMLSKIMMODEL", //! Table with the hashes of the ML models used for the scores of Hf2ProngMlProbs and Hf3ProngMlProbs (one row per decay type and data frame)
+                  hf_track_index::NProngsMlSkim,
+                  hf_track_index::DecayTypeMlSkim,
+                  hf_track_index::MlModelHashSkim);
+
 namespace hf_pv_refit
 {
 DECLARE_SOA_COLUMN(PvRefitX, pvRefitX, float);             //!
@@ -418,6 +464,48 @@ DECLARE_SOA_TABLE(HfPvRefitDstar, "AOD", "HFPVREFITDSTAR", //!
                   hf_pv_refit::PvRefitSigmaZ2,
                   o2::soa::Marker<2>);
 
+namespace hf_sec_vtx
+{
+DECLARE_SOA_COLUMN(FitterSettings, fitterSettings, uint32_t); //! fingerprint of the DCAFitterN settings used in the fit, 0 if the vertex cannot be reused
+DECLARE_SOA_COLUMN(SvX, svX, float);                          //!
+DECLARE_SOA_COLUMN(SvY, svY, float);                          //!
+DECLARE_SOA_COLUMN(SvZ, svZ, float);                          //!
+DECLARE_SOA_COLUMN(SvSigmaX2, svSigmaX2, float);              //!
+DECLARE_SOA_COLUMN(SvSigmaXY, svSigmaXY, float);              //!
+DECLARE_SOA_COLUMN(SvSigmaY2, svSigmaY2, float);              //!
+DECLARE_SOA_COLUMN(SvSigmaXZ, svSigmaXZ, float);              //!
+DECLARE_SOA_COLUMN(SvSigmaYZ, svSigmaYZ, float);              //!
+DECLARE_SOA_COLUMN(SvSigmaZ2, svSigmaZ2, float);              //!
+DECLARE_SOA_COLUMN(SvChi2PCA, svChi2PCA, float);              //! sum of (non-weighted) distances of the secondary vertex to its prongs
+DECLARE_SOA_COLUMN(SvPxProng0, svPxProng0, float);            //! momentum of the first prong at the secondary vertex
+DECLARE_SOA_COLUMN(SvPyProng0, svPyProng0, float);            //!
+DECLARE_SOA_COLUMN(SvPzProng0, svPzProng0, float);            //!
+DECLARE_SOA_COLUMN(SvPxProng1, svPxProng1, float);            //! momentum of the second prong at the secondary vertex
+DECLARE_SOA_COLUMN(SvPyProng1, svPyProng1, float);            //!
+DECLARE_SOA_COLUMN(SvPzProng1, svPzProng1, float);            //!
+DECLARE_SOA_COLUMN(SvPxProng2, svPxProng2, float);            //! momentum of the third prong at the secondary vertex
+DECLARE_SOA_COLUMN(SvPyProng2, svPyProng2, float);            //!
+DECLARE_SOA_COLUMN(SvPzProng2, svPzProng2, float);            //!
+} // namespace hf_sec_vtx
+
+// secondary vertices fitted in the skim, joinable with Hf2Prongs and Hf3Prongs to be reused by the candidate creators
+DECLARE_SOA_TABLE(HfSecVtx2Prong, "AOD", "HFSECVTX2PRONG", //!
+                  hf_sec_vtx::FitterSettings,
+                  hf_sec_vtx::SvX, hf_sec_vtx::SvY, hf_sec_vtx::SvZ,
+                  hf_sec_vtx::SvSigmaX2, hf_sec_vtx::SvSigmaXY, hf_sec_vtx::SvSigmaY2, hf_sec_vtx::SvSigmaXZ, hf_sec_vtx::SvSigmaYZ, hf_sec_vtx::SvSigmaZ2,
+                  hf_sec_vtx::SvChi2PCA,
+                  hf_sec_vtx::SvPxProng0, hf_sec_vtx::SvPyProng0, hf_sec_vtx::SvPzProng0,
+                  hf_sec_vtx::SvPxProng1, hf_sec_vtx::SvPyProng1, hf_sec_vtx::SvPzProng1);
+
+DECLARE_SOA_TABLE(HfSecVtx3Prong, "AOD", "HFSECVTX3PRONG", //!
+                  hf_sec_vtx::FitterSettings,
+                  hf_sec_vtx::SvX, hf_sec_vtx::SvY, hf_sec_vtx::SvZ,
+                  hf_sec_vtx::SvSigmaX2, hf_sec_vtx::SvSigmaXY, hf_sec_vtx::SvSigmaY2, hf_sec_vtx::SvSigmaXZ, hf_sec_vtx::SvSigmaYZ, hf_sec_vtx::SvSigmaZ2,
+                  hf_sec_vtx::SvChi2PCA,
+                  hf_sec_vtx::SvPxProng0, hf_sec_vtx::SvPyProng0, hf_sec_vtx::SvPzProng0,
+                  hf_sec_vtx::SvPxProng1, hf_sec_vtx::SvPyProng1, hf_sec_vtx::SvPzProng1,
+                  hf_sec_vtx::SvPxProng2, hf_sec_vtx::SvPyProng2, hf_sec_vtx::SvPzProng2);
+
 // general decay properties
 namespace hf_cand
 {
@@ -29,6 +29,7 @@
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
 #include "PWGHF/HFC/DataModel/CorrelationTables.h"
+#include "PWGHF/Utils/utilsCorrelations.h"
 
 using namespace o2;
 using namespace o2::analysis;
@@ -194,6 +195,7 @@ struct HfCorrelatorD0Hadrons {
   double massPi{0.};
   double massK{0.};
   double softPiMass = 0.14543; // pion mass + Q-value of the D*->D0pi decay
+  hf_correlations::HfCorrelationTracks assocTracks;
 
   Preslice<aod::HfCand2Prong> perCol = aod::hf_cand::collisionId;
 
@@ -319,6 +321,8 @@ struct HfCorrelatorD0Hadrons {
     registry.fill(HIST("hMultiplicity"), nTracks);
 
     auto selectedD0CandidatesGrouped = selectedD0Candidates->sliceByCached(aod::hf_cand::collisionId, collision.globalIndex(), cache);
+    // quantities of the associated tracks read once per collision instead of once per candidate
+    assocTracks.fill(tracks, massPi);
 
     for (const auto& candidate1 : selectedD0CandidatesGrouped) {
       if (yCandMax >= 0. && std::abs(hfHelper.yD0(candidate1)) > yCandMax) {
@@ -365,17 +369,19 @@ struct HfCorrelatorD0Hadrons {
       // ============ D-h correlation dedicated section ==================================
 
       // ========================== track loop starts here ================================
-      for (const auto& track : tracks) {
+      assocTracks.computeDeltas(candidate1.phi(), candidate1.eta());
+      for (std::size_t iTrack = 0; iTrack < assocTracks.size(); iTrack++) {
+        const auto trackIndex = assocTracks.globalIndex(iTrack);
         registry.fill(HIST("hTrackCounter"), 1); // fill total no. of tracks
         // Remove D0 daughters by checking track indices
         bool correlationStatus = false;
-        if ((candidate1.prong0Id() == track.globalIndex()) || (candidate1.prong1Id() == track.globalIndex())) {
+        if ((candidate1.prong0Id() == trackIndex) || (candidate1.prong1Id() == trackIndex)) {
           if (!storeAutoCorrelationFlag) {
             continue;
           }
           correlationStatus = true;
         }
-        if (std::abs(track.dcaXY()) >= 1. || std::abs(track.dcaZ()) >= 1.)
+        if (std::abs(assocTracks.dcaXY(iTrack)) >= 1. || std::abs(assocTracks.dcaZ(iTrack)) >= 1.)
           continue; // Remove secondary tracks
 
         registry.fill(HIST("hTrackCounter"), 2); // fill no. of tracks before soft pion removal
@@ -383,8 +389,8 @@ struct HfCorrelatorD0Hadrons {
         // ========== soft pion removal ===================================================
         double invMassDstar1 = 0., invMassDstar2 = 0.;
         bool isSoftPiD0 = false, isSoftPiD0bar = false;
-        auto pSum2 = RecoDecay::p2(candidate1.pVector(), track.pVector());
-        auto ePion = track.energy(massPi);
+        auto pSum2 = RecoDecay::p2(candidate1.pVector(), assocTracks.pVector(iTrack));
+        auto ePion = assocTracks.energy(iTrack);
         invMassDstar1 = std::sqrt((ePiK + ePion) * (ePiK + ePion) - pSum2);
         invMassDstar2 = std::sqrt((eKPi + ePion) * (eKPi + ePion) - pSum2);
 
@@ -412,15 +418,15 @@ struct HfCorrelatorD0Hadrons {
         }
 
         if (correlateD0WithLeadingParticle) {
-          if (track.globalIndex() != leadingIndex) {
+          if (trackIndex != leadingIndex) {
             continue;
           }
           registry.fill(HIST("hTrackCounter"), 4); // fill no. of tracks  have leading particle
         }
-        entryD0HadronPair(getDeltaPhi(track.phi(), candidate1.phi()),
-                          track.eta() - candidate1.eta(),
+        entryD0HadronPair(assocTracks.deltaPhi(iTrack),
+                          assocTracks.deltaEta(iTrack),
                           candidate1.pt(),
-                          track.pt(),
+                          assocTracks.pt(iTrack),
                           poolBin,
                           correlationStatus);
         entryD0HadronRecoInfo(hfHelper.invMassD0ToPiK(candidate1), hfHelper.invMassD0barToKPi(candidate1), signalStatus);
@@ -20,6 +20,9 @@
 #define HomogeneousField
 #endif
 
+#include <array>
+#include <unordered_map>
+
 #include <KFParticleBase.h>
 #include <KFParticle.h>
 #include <KFPTrack.h>
@@ -36,6 +39,7 @@
 #include "Framework/RunningWorkflowInfo.h"
 #include "ReconstructionDataFormats/DCA.h"
 
+#include "Common/Core/RunConditions.h"
 #include "Common/Core/trackUtilities.h"
 #include "Tools/KFparticle/KFUtilities.h"
 
@@ -89,15 +93,19 @@ struct HfCandidateCreator2Prong {
   double massPiK{0.};
   double massKPi{0.};
   double bz{0.};
+  uint32_t fitterSettingsHash{0}; // fingerprint of the DCAFitterN settings, compared with the one of the secondary vertices fitted in the skim
+  // KF particles of the prongs of the current collision (pion and kaon hypotheses), shared by all the candidates of the collision
+  std::unordered_map<int64_t, std::array<KFParticle, 2>> kfProngsCache;
 
   std::shared_ptr<TH1> hCandidates;
   HistogramRegistry registry{"registry"};
 
   void init(InitContext const&)
   {
-    std::array<bool, 6> doprocessDF{doprocessPvRefitWithDCAFitterN, doprocessNoPvRefitWithDCAFitterN,
+    std::array<bool, 8> doprocessDF{doprocessPvRefitWithDCAFitterN, doprocessNoPvRefitWithDCAFitterN,
                                     doprocessPvRefitWithDCAFitterNCentFT0C, doprocessNoPvRefitWithDCAFitterNCentFT0C,
-                                    doprocessPvRefitWithDCAFitterNCentFT0M, doprocessNoPvRefitWithDCAFitterNCentFT0M};
+                                    doprocessPvRefitWithDCAFitterNCentFT0M, doprocessNoPvRefitWithDCAFitterNCentFT0M,
+                                    doprocessPvRefitWithDCAFitterNSecVtx, doprocessNoPvRefitWithDCAFitterNSecVtx};
     std::array<bool, 6> doprocessKF{doprocessPvRefitWithKFParticle, doprocessNoPvRefitWithKFParticle,
                                     doprocessPvRefitWithKFParticleCentFT0C, doprocessNoPvRefitWithKFParticleCentFT0C,
                                     doprocessPvRefitWithKFParticleCentFT0M, doprocessNoPvRefitWithKFParticleCentFT0M};
@@ -111,7 +119,7 @@ struct HfCandidateCreator2Prong {
       LOGP(fatal, "At most one process function for collision monitoring can be enabled at a time.");
     }
     if (nProcessesCollisions == 1) {
-      if ((doprocessPvRefitWithDCAFitterN || doprocessNoPvRefitWithDCAFitterN || doprocessPvRefitWithKFParticle || doprocessNoPvRefitWithKFParticle) && !doprocessCollisions) {
+      if ((doprocessPvRefitWithDCAFitterN || doprocessNoPvRefitWithDCAFitterN || doprocessPvRefitWithDCAFitterNSecVtx || doprocessNoPvRefitWithDCAFitterNSecVtx || doprocessPvRefitWithKFParticle || doprocessNoPvRefitWithKFParticle) && !doprocessCollisions) {
         LOGP(fatal, "Process function for collision monitoring not correctly enabled. Did you enable \"processCollisions\"?");
       }
       if ((doprocessPvRefitWithDCAFitterNCentFT0C || doprocessNoPvRefitWithDCAFitterNCentFT0C || doprocessPvRefitWithKFParticleCentFT0C || doprocessNoPvRefitWithKFParticleCentFT0C) && !doprocessCollisionsCentFT0C) {
@@ -152,6 +160,7 @@ struct HfCandidateCreator2Prong {
       df.setMinRelChi2Change(minRelChi2Change);
       df.setUseAbsDCA(useAbsDCA);
       df.setWeightedFinalPCA(useWeightedFinalPCA);
+      fitterSettingsHash = getDcaFitterSettingsHash(propagateToPCA, useAbsDCA, useWeightedFinalPCA, maxR, maxDZIni, minParamChange, minRelChi2Change);
     }
     if (std::accumulate(doprocessKF.begin(), doprocessKF.end(), 0) == 1) {
       registry.fill(HIST("hVertexerType"), aod::hf_cand::VertexerType::KfParticle);
@@ -160,14 +169,14 @@ struct HfCandidateCreator2Prong {
     ccdb->setURL(ccdbUrl);
     ccdb->setCaching(true);
     ccdb->setLocalObjectValidityChecking();
-    lut = o2::base::MatLayerCylSet::rectifyPtrFromFile(ccdb->get<o2::base::MatLayerCylSet>(ccdbPathLut));
+    lut = RunConditions::getSharedMatLut(ccdbPathLut);
     runNumber = 0;
 
     /// candidate monitoring
     setLabelHistoCands(hCandidates);
   }
 
-  template <bool doPvRefit, o2::hf_centrality::CentralityEstimator centEstimator, typename Coll, typename CandType, typename TTracks>
+  template <bool doPvRefit, o2::hf_centrality::CentralityEstimator centEstimator, bool reuseSecVtx = false, typename Coll, typename CandType, typename TTracks>
   void runCreator2ProngWithDCAFitterN(Coll const&,
                                       CandType const& rowsTrackIndexProng2,
                                       TTracks const&,
@@ -204,34 +213,57 @@ struct HfCandidateCreator2Prong {
       }
       df.setBz(bz);
 
-      // reconstruct the 2-prong secondary vertex
+      std::array<double, 3> secondaryVertex;
+      std::array<float, 6> covMatrixPCA;
+      float chi2PCA{0.f};
+      o2::track::TrackParCov trackParVar0;
+      o2::track::TrackParCov trackParVar1;
+      std::array<float, 3> pvec0;
+      std::array<float, 3> pvec1;
+      bool isSecVtxReused{false};
+      if constexpr (reuseSecVtx) {
+        isSecVtxReused = rowTrackIndexProng2.fitterSettings() == fitterSettingsHash;
+      }
       hCandidates->Fill(SVFitting::BeforeFit);
-      try {
-        if (df.process(trackParVarPos1, trackParVarNeg1) == 0) {
+      if (isSecVtxReused) {
+        // secondary vertex already reconstructed in the skim with the same fitter settings,
+        // the impact parameters are computed propagating the input tracks to the primary vertex
+        hCandidates->Fill(SVFitting::FitOk);
+        secondaryVertex = {rowTrackIndexProng2.svX(), rowTrackIndexProng2.svY(), rowTrackIndexProng2.svZ()};
+        covMatrixPCA = {rowTrackIndexProng2.svSigmaX2(), rowTrackIndexProng2.svSigmaXY(), rowTrackIndexProng2.svSigmaY2(), rowTrackIndexProng2.svSigmaXZ(), rowTrackIndexProng2.svSigmaYZ(), rowTrackIndexProng2.svSigmaZ2()};
+        chi2PCA = rowTrackIndexProng2.svChi2PCA();
+        trackParVar0 = trackParVarPos1;
+        trackParVar1 = trackParVarNeg1;
+        pvec0 = {rowTrackIndexProng2.svPxProng0(), rowTrackIndexProng2.svPyProng0(), rowTrackIndexProng2.svPzProng0()};
+        pvec1 = {rowTrackIndexProng2.svPxProng1(), rowTrackIndexProng2.svPyProng1(), rowTrackIndexProng2.svPzProng1()};
+      } else {
+        // reconstruct the 2-prong secondary vertex
+        try {
+          if (df.process(trackParVarPos1, trackParVarNeg1) == 0) {
+            continue;
+          }
+        } catch (const std::runtime_error& error) {
+          LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
+          hCandidates->Fill(SVFitting::Fail);
           continue;
         }
-      } catch (const std::runtime_error& error) {
-        LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
-        hCandidates->Fill(SVFitting::Fail);
-        continue;
+        hCandidates->Fill(SVFitting::FitOk);
+
+        const auto& vertexPCA = df.getPCACandidate();
+        secondaryVertex = {vertexPCA[0], vertexPCA[1], vertexPCA[2]};
+        chi2PCA = df.getChi2AtPCACandidate();
+        covMatrixPCA = df.calcPCACovMatrixFlat();
+        trackParVar0 = df.getTrack(0);
+        trackParVar1 = df.getTrack(1);
+
+        // get track momenta
+        trackParVar0.getPxPyPzGlo(pvec0);
+        trackParVar1.getPxPyPzGlo(pvec1);
       }
-      hCandidates->Fill(SVFitting::FitOk);
-
-      const auto& secondaryVertex = df.getPCACandidate();
-      auto chi2PCA = df.getChi2AtPCACandidate();
-      auto covMatrixPCA = df.calcPCACovMatrixFlat();
       registry.fill(HIST("hCovSVXX"), covMatrixPCA[0]); // FIXME: Calculation of errorDecayLength(XY) gives wrong values without this line.
       registry.fill(HIST("hCovSVYY"), covMatrixPCA[2]);
       registry.fill(HIST("hCovSVXZ"), covMatrixPCA[3]);
       registry.fill(HIST("hCovSVZZ"), covMatrixPCA[5]);
-      auto trackParVar0 = df.getTrack(0);
-      auto trackParVar1 = df.getTrack(1);
-
-      // get track momenta
-      std::array<float, 3> pvec0;
-      std::array<float, 3> pvec1;
-      trackParVar0.getPxPyPzGlo(pvec0);
-      trackParVar1.getPxPyPzGlo(pvec1);
 
       // get track impact parameters
       // This modifies track momenta!
@@ -308,12 +340,31 @@ struct HfCandidateCreator2Prong {
     }
   }
 
+  /// Returns the KF particles of a prong under the pion and kaon hypotheses, built once per collision
+  /// \param track is the prong track
+  /// \return array with the pion and kaon KF particles
+  template <typename TTrack>
+  const std::array<KFParticle, 2>& getKfProng(TTrack const& track)
+  {
+    auto [itProng, isNew] = kfProngsCache.try_emplace(track.globalIndex());
+    if (isNew) {
+      KFPTrack kfpTrack = createKFPTrackFromTrack(track);
+      itProng->second = {KFParticle(kfpTrack, kPiPlus), KFParticle(kfpTrack, kKPlus)};
+    }
+    return itProng->second;
+  }
+
   template <bool doPvRefit, o2::hf_centrality::CentralityEstimator centEstimator, typename Coll, typename CandType, typename TTracks>
   void runCreator2ProngWithKFParticle(Coll const&,
                                       CandType const& rowsTrackIndexProng2,
                                       TTracks const&,
                                       aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
+    // the candidates are grouped by collision: the primary vertex (if not refitted) and the prongs are built once per collision
+    int64_t lastCollisionId{-1};
+    float covMatrixPV[6];
+    KFParticle KFPV;
+    kfProngsCache.clear();
 
     for (const auto& rowTrackIndexProng2 : rowsTrackIndexProng2) {
 
@@ -341,33 +392,40 @@ struct HfCandidateCreator2Prong {
         // df.setBz(bz); /// put it outside the 'if'! Otherwise we have a difference wrt bz Configurable (< 1 permille) in Run2 conv. data
         // df.print();
       }
-      float covMatrixPV[6];
 
       KFParticle::SetField(bz);
-      KFPVertex kfpVertex = createKFPVertexFromCollision(collision);
-
-      if constexpr (doPvRefit) {
-        /// use PV refit
-        /// Using it in the rowCandidateBase all dynamic columns shall take it into account
-        // coordinates
-        kfpVertex.SetXYZ(rowTrackIndexProng2.pvRefitX(), rowTrackIndexProng2.pvRefitY(), rowTrackIndexProng2.pvRefitZ());
-        // covariance matrix
-        kfpVertex.SetCovarianceMatrix(rowTrackIndexProng2.pvRefitSigmaX2(), rowTrackIndexProng2.pvRefitSigmaXY(), rowTrackIndexProng2.pvRefitSigmaY2(), rowTrackIndexProng2.pvRefitSigmaXZ(), rowTrackIndexProng2.pvRefitSigmaYZ(), rowTrackIndexProng2.pvRefitSigmaZ2());
+      auto indexCollision = collision.globalIndex();
+      const bool isNewCollision = indexCollision != lastCollisionId;
+      if (isNewCollision) {
+        kfProngsCache.clear();
+        lastCollisionId = indexCollision;
+      }
+      if (doPvRefit || isNewCollision) {
+        KFPVertex kfpVertex = createKFPVertexFromCollision(collision);
+
+        if constexpr (doPvRefit) {
+          /// use PV refit
+          /// Using it in the rowCandidateBase all dynamic columns shall take it into account
+          // coordinates
+          kfpVertex.SetXYZ(rowTrackIndexProng2.pvRefitX(), rowTrackIndexProng2.pvRefitY(), rowTrackIndexProng2.pvRefitZ());
+          // covariance matrix
+          kfpVertex.SetCovarianceMatrix(rowTrackIndexProng2.pvRefitSigmaX2(), rowTrackIndexProng2.pvRefitSigmaXY(), rowTrackIndexProng2.pvRefitSigmaY2(), rowTrackIndexProng2.pvRefitSigmaXZ(), rowTrackIndexProng2.pvRefitSigmaYZ(), rowTrackIndexProng2.pvRefitSigmaZ2());
+        }
+        kfpVertex.GetCovarianceMatrix(covMatrixPV);
+        KFPV = KFParticle(kfpVertex);
       }
-      kfpVertex.GetCovarianceMatrix(covMatrixPV);
-      KFParticle KFPV(kfpVertex);
       registry.fill(HIST("hCovPVXX"), covMatrixPV[0]);
       registry.fill(HIST("hCovPVYY"), covMatrixPV[2]);
       registry.fill(HIST("hCovPVXZ"), covMatrixPV[3]);
       registry.fill(HIST("hCovPVZZ"), covMatrixPV[5]);
 
-      KFPTrack kfpTrack0 = createKFPTrackFromTrack(track0);
-      KFPTrack kfpTrack1 = createKFPTrackFromTrack(track1);
+      const auto& kfProng0 = getKfProng(track0);
+      const auto& kfProng1 = getKfProng(track1);
 
-      KFParticle kfPosPion(kfpTrack0, kPiPlus);
-      KFParticle kfNegPion(kfpTrack1, kPiPlus);
-      KFParticle kfPosKaon(kfpTrack0, kKPlus);
-      KFParticle kfNegKaon(kfpTrack1, kKPlus);
+      KFParticle kfPosPion = kfProng0[0];
+      KFParticle kfNegPion = kfProng1[0];
+      KFParticle kfPosKaon = kfProng0[1];
+      KFParticle kfNegKaon = kfProng1[1];
 
       float impactParameter0XY = 0., errImpactParameter0XY = 0., impactParameter1XY = 0., errImpactParameter1XY = 0.;
       if (!kfPosPion.GetDistanceFromVertexXY(KFPV, impactParameter0XY, errImpactParameter0XY)) {
@@ -417,7 +475,6 @@ struct HfCandidateCreator2Prong {
         topolChi2PerNdfD0 = kfCandD0Topol2PV.GetChi2() / kfCandD0Topol2PV.GetNDF();
       }
 
-      auto indexCollision = collision.globalIndex();
       uint8_t nProngsContributorsPV = 0;
       if (indexCollision == track0.collisionId() && track0.isPVContributor()) {
         nProngsContributorsPV += 1;
@@ -477,6 +534,26 @@ struct HfCandidateCreator2Prong {
   }
   PROCESS_SWITCH(HfCandidateCreator2Prong, processNoPvRefitWithDCAFitterN, "Run candidate creator using DCA fitter w/o PV refit and w/o centrality selections", true);
 
+  /// @brief process function using DCA fitter w/ PV refit and w/o centrality selections, reusing the secondary vertices of the skim
+  void processPvRefitWithDCAFitterNSecVtx(soa::Join<aod::Collisions, aod::EvSels> const& collisions,
+                                          soa::Join<aod::Hf2Prongs, aod::HfPvRefit2Prong, aod::HfSecVtx2Prong> const& rowsTrackIndexProng2,
+                                          aod::TracksWCovExtra const& tracks,
+                                          aod::BCsWithTimestamps const& bcWithTimeStamps)
+  {
+    runCreator2ProngWithDCAFitterN</*doPvRefit*/ true, CentralityEstimator::None, /*reuseSecVtx*/ true>(collisions, rowsTrackIndexProng2, tracks, bcWithTimeStamps);
+  }
+  PROCESS_SWITCH(HfCandidateCreator2Prong, processPvRefitWithDCAFitterNSecVtx, "Run candidate creator using DCA fitter w/ PV refit and w/o centrality selections, reusing the secondary vertices of the skim", false);
+
+  /// @brief process function using DCA fitter w/o PV refit and w/o centrality selections, reusing the secondary vertices of the skim
+  void processNoPvRefitWithDCAFitterNSecVtx(soa::Join<aod::Collisions, aod::EvSels> const& collisions,
+                                            soa::Join<aod::Hf2Prongs, aod::HfSecVtx2Prong> const& rowsTrackIndexProng2,
+                                            aod::TracksWCovExtra const& tracks,
+                                            aod::BCsWithTimestamps const& bcWithTimeStamps)
+  {
+    runCreator2ProngWithDCAFitterN</*doPvRefit*/ false, CentralityEstimator::None, /*reuseSecVtx*/ true>(collisions, rowsTrackIndexProng2, tracks, bcWithTimeStamps);
+  }
+  PROCESS_SWITCH(HfCandidateCreator2Prong, processNoPvRefitWithDCAFitterNSecVtx, "Run candidate creator using DCA fitter w/o PV refit and w/o centrality selections, reusing the secondary vertices of the skim", false);
+
   /// @brief process function using KFParticle package w/ PV refit and w/o centrality selections
   void processPvRefitWithKFParticle(soa::Join<aod::Collisions, aod::EvSels> const& collisions,
                                     soa::Join<aod::Hf2Prongs, aod::HfPvRefit2Prong> const& rowsTrackIndexProng2,
@@ -25,6 +25,7 @@
 #include "Framework/RunningWorkflowInfo.h"
 #include "ReconstructionDataFormats/DCA.h"
 
+#include "Common/Core/RunConditions.h"
 #include "Common/Core/trackUtilities.h"
 
 #include "PWGHF/Core/CentralityEstimation.h"
@@ -80,9 +81,12 @@ struct HfCandidateCreator3Prong {
   double massK{0.};
   double massPiKPi{0.};
   double bz{0.};
+  uint32_t fitterSettingsHash{0}; // fingerprint of the DCAFitterN settings, compared with the one of the secondary vertices fitted in the skim
 
   using FilteredHf3Prongs = soa::Filtered<aod::Hf3Prongs>;
   using FilteredPvRefitHf3Prongs = soa::Filtered<soa::Join<aod::Hf3Prongs, aod::HfPvRefit3Prong>>;
+  using FilteredSecVtxHf3Prongs = soa::Filtered<soa::Join<aod::Hf3Prongs, aod::HfSecVtx3Prong>>;
+  using FilteredPvRefitSecVtxHf3Prongs = soa::Filtered<soa::Join<aod::Hf3Prongs, aod::HfPvRefit3Prong, aod::HfSecVtx3Prong>>;
 
   // filter candidates
   Filter filterSelected3Prongs = (createDplus && (o2::aod::hf_track_index::hfflag & static_cast<uint8_t>(BIT(aod::hf_cand_3prong::DecayType::DplusToPiKPi))) != static_cast<uint8_t>(0)) || (createDs && (o2::aod::hf_track_index::hfflag & static_cast<uint8_t>(BIT(aod::hf_cand_3prong::DecayType::DsToKKPi))) != static_cast<uint8_t>(0)) || (createLc && (o2::aod::hf_track_index::hfflag & static_cast<uint8_t>(BIT(aod::hf_cand_3prong::DecayType::LcToPKPi))) != static_cast<uint8_t>(0)) || (createXic && (o2::aod::hf_track_index::hfflag & static_cast<uint8_t>(BIT(aod::hf_cand_3prong::DecayType::XicToPKPi))) != static_cast<uint8_t>(0));
@@ -92,9 +96,10 @@ struct HfCandidateCreator3Prong {
 
   void init(InitContext const&)
   {
-    std::array<bool, 6> processes = {doprocessPvRefit, doprocessNoPvRefit,
+    std::array<bool, 8> processes = {doprocessPvRefit, doprocessNoPvRefit,
                                      doprocessPvRefitCentFT0C, doprocessNoPvRefitCentFT0C,
-                                     doprocessPvRefitCentFT0M, doprocessNoPvRefitCentFT0M};
+                                     doprocessPvRefitCentFT0M, doprocessNoPvRefitCentFT0M,
+                                     doprocessPvRefitSecVtx, doprocessNoPvRefitSecVtx};
     if (std::accumulate(processes.begin(), processes.end(), 0) != 1) {
       LOGP(fatal, "One and only one process function must be enabled at a time.");
     }
@@ -105,7 +110,7 @@ struct HfCandidateCreator3Prong {
       LOGP(fatal, "At most one process function for collision monitoring can be enabled at a time.");
     }
     if (nProcessesCollisions == 1) {
-      if ((doprocessPvRefit || doprocessNoPvRefit) && !doprocessCollisions) {
+      if ((doprocessPvRefit || doprocessNoPvRefit || doprocessPvRefitSecVtx || doprocessNoPvRefitSecVtx) && !doprocessCollisions) {
         LOGP(fatal, "Process function for collision monitoring not correctly enabled. Did you enable \"processCollisions\"?");
       }
       if ((doprocessPvRefitCentFT0C || doprocessNoPvRefitCentFT0C) && !doprocessCollisionsCentFT0C) {
@@ -148,18 +153,19 @@ struct HfCandidateCreator3Prong {
     df.setMinRelChi2Change(minRelChi2Change);
     df.setUseAbsDCA(useAbsDCA);
     df.setWeightedFinalPCA(useWeightedFinalPCA);
+    fitterSettingsHash = getDcaFitterSettingsHash(propagateToPCA, useAbsDCA, useWeightedFinalPCA, maxR, maxDZIni, minParamChange, minRelChi2Change);
 
     ccdb->setURL(ccdbUrl);
     ccdb->setCaching(true);
     ccdb->setLocalObjectValidityChecking();
-    lut = o2::base::MatLayerCylSet::rectifyPtrFromFile(ccdb->get<o2::base::MatLayerCylSet>(ccdbPathLut));
+    lut = RunConditions::getSharedMatLut(ccdbPathLut);
     runNumber = 0;
 
     /// candidate monitoring
     setLabelHistoCands(hCandidates);
   }
 
-  template <bool doPvRefit = false, o2::hf_centrality::CentralityEstimator centEstimator, typename Coll, typename Cand>
+  template <bool doPvRefit = false, o2::hf_centrality::CentralityEstimator centEstimator, bool reuseSecVtx = false, typename Coll, typename Cand>
   void runCreator3Prong(Coll const&,
                         Cand const& rowsTrackIndexProng3,
                         aod::TracksWCovExtra const&,
@@ -198,37 +204,57 @@ struct HfCandidateCreator3Prong {
       }
       df.setBz(bz);
 
-      // reconstruct the 3-prong secondary vertex
+      std::array<double, 3> secondaryVertex;
+      std::array<float, 6> covMatrixPCA;
+      float chi2PCA{0.f};
+      std::array<float, 3> pvec0;
+      std::array<float, 3> pvec1;
+      std::array<float, 3> pvec2;
+      bool isSecVtxReused{false};
+      if constexpr (reuseSecVtx) {
+        isSecVtxReused = rowTrackIndexProng3.fitterSettings() == fitterSettingsHash;
+      }
       hCandidates->Fill(SVFitting::BeforeFit);
-      try {
-        if (df.process(trackParVar0, trackParVar1, trackParVar2) == 0) {
+      if (isSecVtxReused) {
+        // secondary vertex already reconstructed in the skim with the same fitter settings,
+        // the impact parameters are computed propagating the input tracks to the primary vertex
+        hCandidates->Fill(SVFitting::FitOk);
+        secondaryVertex = {rowTrackIndexProng3.svX(), rowTrackIndexProng3.svY(), rowTrackIndexProng3.svZ()};
+        covMatrixPCA = {rowTrackIndexProng3.svSigmaX2(), rowTrackIndexProng3.svSigmaXY(), rowTrackIndexProng3.svSigmaY2(), rowTrackIndexProng3.svSigmaXZ(), rowTrackIndexProng3.svSigmaYZ(), rowTrackIndexProng3.svSigmaZ2()};
+        chi2PCA = rowTrackIndexProng3.svChi2PCA();
+        pvec0 = {rowTrackIndexProng3.svPxProng0(), rowTrackIndexProng3.svPyProng0(), rowTrackIndexProng3.svPzProng0()};
+        pvec1 = {rowTrackIndexProng3.svPxProng1(), rowTrackIndexProng3.svPyProng1(), rowTrackIndexProng3.svPzProng1()};
+        pvec2 = {rowTrackIndexProng3.svPxProng2(), rowTrackIndexProng3.svPyProng2(), rowTrackIndexProng3.svPzProng2()};
+      } else {
+        // reconstruct the 3-prong secondary vertex
+        try {
+          if (df.process(trackParVar0, trackParVar1, trackParVar2) == 0) {
+            continue;
+          }
+        } catch (const std::runtime_error& error) {
+          LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
+          hCandidates->Fill(SVFitting::Fail);
           continue;
         }
-      } catch (const std::runtime_error& error) {
-        LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
-        hCandidates->Fill(SVFitting::Fail);
-        continue;
+        hCandidates->Fill(SVFitting::FitOk);
+
+        const auto& vertexPCA = df.getPCACandidate();
+        secondaryVertex = {vertexPCA[0], vertexPCA[1], vertexPCA[2]};
+        chi2PCA = df.getChi2AtPCACandidate();
+        covMatrixPCA = df.calcPCACovMatrixFlat();
+        trackParVar0 = df.getTrack(0);
+        trackParVar1 = df.getTrack(1);
+        trackParVar2 = df.getTrack(2);
+
+        // get track momenta
+        trackParVar0.getPxPyPzGlo(pvec0);
+        trackParVar1.getPxPyPzGlo(pvec1);
+        trackParVar2.getPxPyPzGlo(pvec2);
       }
-      hCandidates->Fill(SVFitting::FitOk);
-
-      const auto& secondaryVertex = df.getPCACandidate();
-      auto chi2PCA = df.getChi2AtPCACandidate();
-      auto covMatrixPCA = df.calcPCACovMatrixFlat();
       registry.fill(HIST("hCovSVXX"), covMatrixPCA[0]); // FIXME: Calculation of errorDecayLength(XY) gives wrong values without this line.
       registry.fill(HIST("hCovSVYY"), covMatrixPCA[2]);
       registry.fill(HIST("hCovSVXZ"), covMatrixPCA[3]);
       registry.fill(HIST("hCovSVZZ"), covMatrixPCA[5]);
-      trackParVar0 = df.getTrack(0);
-      trackParVar1 = df.getTrack(1);
-      trackParVar2 = df.getTrack(2);
-
-      // get track momenta
-      std::array<float, 3> pvec0;
-      std::array<float, 3> pvec1;
-      std::array<float, 3> pvec2;
-      trackParVar0.getPxPyPzGlo(pvec0);
-      trackParVar1.getPxPyPzGlo(pvec1);
-      trackParVar2.getPxPyPzGlo(pvec2);
 
       // get track impact parameters
       // This modifies track momenta!
@@ -337,6 +363,26 @@ struct HfCandidateCreator3Prong {
   }
   PROCESS_SWITCH(HfCandidateCreator3Prong, processNoPvRefit, "Run candidate creator without PV refit and w/o centrality selections", true);
 
+  /// @brief process function w/ PV refit and w/o centrality selections, reusing the secondary vertices of the skim
+  void processPvRefitSecVtx(soa::Join<aod::Collisions, aod::EvSels> const& collisions,
+                            FilteredPvRefitSecVtxHf3Prongs const& rowsTrackIndexProng3,
+                            aod::TracksWCovExtra const& tracks,
+                            aod::BCsWithTimestamps const& bcWithTimeStamps)
+  {
+    runCreator3Prong</*doPvRefit*/ true, CentralityEstimator::None, /*reuseSecVtx*/ true>(collisions, rowsTrackIndexProng3, tracks, bcWithTimeStamps);
+  }
+  PROCESS_SWITCH(HfCandidateCreator3Prong, processPvRefitSecVtx, "Run candidate creator with PV refit and w/o centrality selections, reusing the secondary vertices of the skim", false);
+
+  /// @brief process function w/o PV refit and w/o centrality selections, reusing the secondary vertices of the skim
+  void processNoPvRefitSecVtx(soa::Join<aod::Collisions, aod::EvSels> const& collisions,
+                              FilteredSecVtxHf3Prongs const& rowsTrackIndexProng3,
+                              aod::TracksWCovExtra const& tracks,
+                              aod::BCsWithTimestamps const& bcWithTimeStamps)
+  {
+    runCreator3Prong</*doPvRefit*/ false, CentralityEstimator::None, /*reuseSecVtx*/ true>(collisions, rowsTrackIndexProng3, tracks, bcWithTimeStamps);
+  }
+  PROCESS_SWITCH(HfCandidateCreator3Prong, processNoPvRefitSecVtx, "Run candidate creator without PV refit and w/o centrality selections, reusing the secondary vertices of the skim", false);
+
   /////////////////////////////////////////////
   ///                                       ///
   ///   with centrality selection on FT0C   ///
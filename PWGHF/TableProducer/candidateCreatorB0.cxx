@@ -22,6 +22,7 @@
 #include "ReconstructionDataFormats/DCA.h"
 #include "ReconstructionDataFormats/V0.h"
 
+#include "Common/Core/RunConditions.h"
 #include "Common/Core/trackUtilities.h"
 #include "Common/DataModel/CollisionAssociationTables.h"
 
@@ -135,7 +136,7 @@ struct HfCandidateCreatorB0 {
     ccdb->setURL(ccdbUrl);
     ccdb->setCaching(true);
     ccdb->setLocalObjectValidityChecking();
-    lut = o2::base::MatLayerCylSet::rectifyPtrFromFile(ccdb->get<o2::base::MatLayerCylSet>(ccdbPathLut));
+    lut = RunConditions::getSharedMatLut(ccdbPathLut);
     runNumber = 0;
 
     /// candidate monitoring
@@ -176,13 +176,30 @@ struct HfCandidateCreatorDstar {
   {
     // LOG(info) << "runCreatorDstar function called";
     // LOG(info) << "candidate loop starts";
+    // the D* candidates of the skim are grouped by collision and by D0, so the event selection is evaluated once per
+    // collision and the D0 vertex is fitted once for all the soft pions combined with it
+    int64_t lastCollisionId{-1};
+    uint16_t rejectionMask{0};
+    int64_t lastD0Id{-1};
+    int nVerticesD0{0};
+    bool hasFitErrorD0{false};
+    o2::vertexing::DCAFitterN<2>::Vec3D secondaryVertex;
+    decltype(df.getChi2AtPCACandidate()) chi2PCA{};
+    decltype(df.calcPCACovMatrixFlat()) covMatrixPCA{};
+    o2::track::TrackParCov trackD0ProngAtSv0;
+    o2::track::TrackParCov trackD0ProngAtSv1;
+
     // loop over suspected Dstar Candidate
     for (const auto& rowTrackIndexDstar : rowsTrackIndexDstar) {
 
       /// reject candidates in collisions not satisfying the event selections
       auto collision = rowTrackIndexDstar.template collision_as<Coll>();
-      float centrality{-1.f};
-      const auto rejectionMask = hfEvSel.getHfCollisionRejectionMask<true, centEstimator, aod::BCsWithTimestamps>(collision, centrality, ccdb);
+      if (collision.globalIndex() != lastCollisionId) {
+        lastCollisionId = collision.globalIndex();
+        lastD0Id = -1;
+        float centrality{-1.f};
+        rejectionMask = hfEvSel.getHfCollisionRejectionMask<true, centEstimator, aod::BCsWithTimestamps>(collision, centrality, ccdb);
+      }
       if (rejectionMask != 0) {
         /// at least one event selection not satisfied --> reject the candidate
         continue;
@@ -199,9 +216,6 @@ struct HfCandidateCreatorDstar {
 
       // Extracts track parameters and covariance matrix from a track
       auto trackPiParVar = getTrackParCov(trackPi);
-      // These will be used in DCA Fitter to reconstruct secondary vertex
-      auto trackD0Prong0ParVarPos1 = getTrackParCov(trackD0Prong0); // from trackUtilities.h
-      auto trackD0Prong1ParVarNeg1 = getTrackParCov(trackD0Prong1);
 
       // auto collisionPiId = trackPi.collisionId();
       // auto collisionD0Id = trackD0Prong0.collisionId();
@@ -221,34 +235,49 @@ struct HfCandidateCreatorDstar {
         // LOG(info) << ">>>>>>>>>>>> Magnetic field: " << bz;
         runNumber = bc.runNumber();
       }
-      df.setBz(bz);
 
-      // reconstruct the 2-prong secondary vertex
+      // reconstruct the 2-prong secondary vertex, once per D0
       hCandidates->Fill(SVFitting::BeforeFit);
-      try {
-        if (df.process(trackD0Prong0ParVarPos1, trackD0Prong1ParVarNeg1) == 0) {
-          continue;
+      if (prongD0.globalIndex() != lastD0Id) {
+        lastD0Id = prongD0.globalIndex();
+        df.setBz(bz);
+        // These will be used in DCA Fitter to reconstruct secondary vertex
+        auto trackD0Prong0ParVarPos1 = getTrackParCov(trackD0Prong0); // from trackUtilities.h
+        auto trackD0Prong1ParVarNeg1 = getTrackParCov(trackD0Prong1);
+        hasFitErrorD0 = false;
+        nVerticesD0 = 0;
+        try {
+          nVerticesD0 = df.process(trackD0Prong0ParVarPos1, trackD0Prong1ParVarNeg1);
+        } catch (const std::runtime_error& error) {
+          LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
+          hasFitErrorD0 = true;
+        }
+        if (!hasFitErrorD0 && nVerticesD0 != 0) {
+          secondaryVertex = df.getPCACandidate();
+          chi2PCA = df.getChi2AtPCACandidate();
+          covMatrixPCA = df.calcPCACovMatrixFlat();
+          // Doubt:................Below, track object are at secondary vertex!
+          // < track param propagated to V0 candidate (no check for the candidate validity). propagateTracksToVertex must be called in advance
+          trackD0ProngAtSv0 = df.getTrack(0);
+          trackD0ProngAtSv1 = df.getTrack(1);
         }
-      } catch (const std::runtime_error& error) {
-        LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
+      }
+      if (hasFitErrorD0) {
         hCandidates->Fill(SVFitting::Fail);
         continue;
       }
+      if (nVerticesD0 == 0) {
+        continue;
+      }
       hCandidates->Fill(SVFitting::FitOk);
 
-      const auto& secondaryVertex = df.getPCACandidate();
-      auto chi2PCA = df.getChi2AtPCACandidate();
-      auto covMatrixPCA = df.calcPCACovMatrixFlat();
-
       registry.fill(HIST("Refit/hCovSVXX"), covMatrixPCA[0]);
       registry.fill(HIST("Refit/hCovSVYY"), covMatrixPCA[2]);
       registry.fill(HIST("Refit/hCovSVXZ"), covMatrixPCA[3]);
       registry.fill(HIST("Refit/hCovSVZZ"), covMatrixPCA[5]);
 
-      // Doubt:................Below, track object are at secondary vertex!
-      // < track param propagated to V0 candidate (no check for the candidate validity). propagateTracksToVertex must be called in advance
-      auto trackD0ProngParVar0 = df.getTrack(0);
-      auto trackD0ProngParVar1 = df.getTrack(1);
+      auto trackD0ProngParVar0 = trackD0ProngAtSv0;
+      auto trackD0ProngParVar1 = trackD0ProngAtSv1;
 
       std::array<float, 3> pVecD0Prong0;
       std::array<float, 3> pVecD0Prong1;
@@ -29,6 +29,7 @@
 #include "ReconstructionDataFormats/V0.h"
 
 #include "Common/Core/RecoDecay.h"
+#include "Common/Core/RunConditions.h"
 #include "Common/Core/trackUtilities.h"
 #include "Common/DataModel/CollisionAssociationTables.h"
 #include "Common/DataModel/EventSelection.h"
@@ -162,7 +163,7 @@ struct HfCandidateCreatorXic0Omegac0 {
     ccdb->setURL(ccdbUrl);
     ccdb->setCaching(true);
     ccdb->setLocalObjectValidityChecking();
-    lut = o2::base::MatLayerCylSet::rectifyPtrFromFile(ccdb->get<o2::base::MatLayerCylSet>(ccdbPathLut));
+    lut = RunConditions::getSharedMatLut(ccdbPathLut);
     runNumber = 0;
   }
 
@@ -182,6 +183,17 @@ struct HfCandidateCreatorXic0Omegac0 {
       LOGP(fatal, "Decay channel not recognized!");
     }
 
+    // the candidates of the skim are grouped by collision and by cascade, so the event selection, the primary vertex and
+    // the cascade track with its impact parameter are computed once for all the charm bachelors of a cascade
+    int64_t lastCollisionId{-1};
+    uint16_t rejectionMask{0};
+    o2::dataformats::VertexBase primaryVertex;
+    int64_t lastCascadeId{-1};
+    bool isValidTrackCasc{false};
+    bool hasImpactParameterCasc{false};
+    o2::track::TrackParCov trackCasc;
+    o2::dataformats::DCA impactParameterCasc;
+
     for (const auto& cand : candidates) {
 
       hCandidateCounter->Fill(0);
@@ -203,24 +215,30 @@ struct HfCandidateCreatorXic0Omegac0 {
       hCandidateCounter->Fill(1);
 
       auto collision = cand.collision_as<Coll>();
-      float centrality{-1.f};
-      const auto rejectionMask = hfEvSel.getHfCollisionRejectionMask<true, centEstimator, aod::BCsWithTimestamps>(collision, centrality, ccdb);
+      if (collision.globalIndex() != lastCollisionId) {
+        lastCollisionId = collision.globalIndex();
+        lastCascadeId = -1;
+        float centrality{-1.f};
+        rejectionMask = hfEvSel.getHfCollisionRejectionMask<true, centEstimator, aod::BCsWithTimestamps>(collision, centrality, ccdb);
+        if (rejectionMask == 0) {
+          // set the magnetic field from CCDB
+          auto bc = collision.template bc_as<aod::BCsWithTimestamps>();
+          if (runNumber != bc.runNumber()) {
+            LOG(info) << ">>>>>>>>>>>> Current run number: " << runNumber;
+            initCCDB(bc, runNumber, ccdb, isRun2 ? ccdbPathGrp : ccdbPathGrpMag, lut, isRun2);
+            magneticField = o2::base::Propagator::Instance()->getNominalBz();
+            LOG(info) << ">>>>>>>>>>>> Magnetic field: " << magneticField;
+            runNumber = bc.runNumber();
+          }
+          df.setBz(magneticField);
+          primaryVertex = getPrimaryVertex(collision); // get the associated covariance matrix with auto covMatrixPV = primaryVertex.getCov();
+        }
+      }
       if (rejectionMask != 0) {
         /// at least one event selection not satisfied --> reject the candidate
         continue;
       }
 
-      // set the magnetic field from CCDB
-      auto bc = collision.template bc_as<aod::BCsWithTimestamps>();
-      if (runNumber != bc.runNumber()) {
-        LOG(info) << ">>>>>>>>>>>> Current run number: " << runNumber;
-        initCCDB(bc, runNumber, ccdb, isRun2 ? ccdbPathGrp : ccdbPathGrpMag, lut, isRun2);
-        magneticField = o2::base::Propagator::Instance()->getNominalBz();
-        LOG(info) << ">>>>>>>>>>>> Magnetic field: " << magneticField;
-        runNumber = bc.runNumber();
-      }
-      df.setBz(magneticField);
-
       auto trackCharmBachelor = cand.prong0_as<TracksWCovDca>();
 
       auto cascAodElement = cand.cascade_as<aod::CascadesLinked>();
@@ -253,27 +271,30 @@ struct HfCandidateCreatorXic0Omegac0 {
       // info from LF table
       std::array<float, 3> vertexCasc = {casc.x(), casc.y(), casc.z()};
       std::array<float, 3> pVecCasc = {casc.px(), casc.py(), casc.pz()};
-      std::array<float, 21> covCasc = {0.};
-      constexpr int MomInd[6] = {9, 13, 14, 18, 19, 20}; // cov matrix elements for momentum component
-      for (int i = 0; i < 6; i++) {
-        covCasc[MomInd[i]] = casc.momentumCovMat()[i];
-        covCasc[i] = casc.positionCovMat()[i];
+      if (casc.globalIndex() != lastCascadeId) {
+        lastCascadeId = casc.globalIndex();
+        hasImpactParameterCasc = false;
+        std::array<float, 21> covCasc = {0.};
+        constexpr int MomInd[6] = {9, 13, 14, 18, 19, 20}; // cov matrix elements for momentum component
+        for (int i = 0; i < 6; i++) {
+          covCasc[MomInd[i]] = casc.momentumCovMat()[i];
+          covCasc[i] = casc.positionCovMat()[i];
+        }
+        // create cascade track
+        isValidTrackCasc = trackCascDauCharged.sign() != 0;
+        if (isValidTrackCasc) {
+          trackCasc = o2::track::TrackParCov(vertexCasc, pVecCasc, covCasc, trackCascDauCharged.sign() > 0 ? 1 : -1, true);
+          trackCasc.setAbsCharge(1);
+          if constexpr (decayChannel == hf_cand_casc_lf::DecayType2Prong::XiczeroOmegaczeroToXiPi) {
+            trackCasc.setPID(o2::track::PID::XiMinus);
+          } else {
+            trackCasc.setPID(o2::track::PID::OmegaMinus);
+          }
+        }
       }
-      // create cascade track
-      o2::track::TrackParCov trackCasc;
-      if (trackCascDauCharged.sign() > 0) {
-        trackCasc = o2::track::TrackParCov(vertexCasc, pVecCasc, covCasc, 1, true);
-      } else if (trackCascDauCharged.sign() < 0) {
-        trackCasc = o2::track::TrackParCov(vertexCasc, pVecCasc, covCasc, -1, true);
-      } else {
+      if (!isValidTrackCasc) {
         continue;
       }
-      trackCasc.setAbsCharge(1);
-      if constexpr (decayChannel == hf_cand_casc_lf::DecayType2Prong::XiczeroOmegaczeroToXiPi) {
-        trackCasc.setPID(o2::track::PID::XiMinus);
-      } else {
-        trackCasc.setPID(o2::track::PID::OmegaMinus);
-      }
 
       std::array<float, 3> pVecCascBachelor = {casc.pxbach(), casc.pybach(), casc.pzbach()};
 
@@ -323,13 +344,16 @@ struct HfCandidateCreatorXic0Omegac0 {
       float dcazCascBachelor = trackCascDauCharged.dcaZ();
 
       // primary vertex of the collision
-      auto primaryVertex = getPrimaryVertex(collision); // get the associated covariance matrix with auto covMatrixPV = primaryVertex.getCov();
       std::array<float, 3> pvCoord = {collision.posX(), collision.posY(), collision.posZ()};
 
-      // impact parameters
-      o2::dataformats::DCA impactParameterCasc;
+      // impact parameters, the one of the cascade at the first candidate with a vertex
+      if (!hasImpactParameterCasc) {
+        auto trackCascAtPv = trackCasc;
+        impactParameterCasc = o2::dataformats::DCA{};
+        o2::base::Propagator::Instance()->propagateToDCABxByBz(primaryVertex, trackCascAtPv, 2.f, matCorr, &impactParameterCasc);
+        hasImpactParameterCasc = true;
+      }
       o2::dataformats::DCA impactParameterCharmBachelor;
-      o2::base::Propagator::Instance()->propagateToDCABxByBz(primaryVertex, trackCasc, 2.f, matCorr, &impactParameterCasc);
       o2::base::Propagator::Instance()->propagateToDCABxByBz(primaryVertex, trackParVarCharmBachelor, 2.f, matCorr, &impactParameterCharmBachelor);
       float impactParBachFromCharmBaryonXY = impactParameterCharmBachelor.getY();
       float impactParBachFromCharmBaryonZ = impactParameterCharmBachelor.getZ();
@@ -80,8 +80,25 @@ struct HfCandidateSelectorD0 {
   TrackSelectorPi selectorPion;
   TrackSelectorKa selectorKaon;
   HfHelper hfHelper;
+  HfBinnedCuts binnedCuts;
+  // indices of the cut variables in the cut configuration
+  int idxCutD0D0{-1};
+  int idxCutCosPointingAngle{-1};
+  int idxCutCosPointingAngleXy{-1};
+  int idxCutMinNormDecayLengthXy{-1};
+  int idxCutNormDauImpParXy{-1};
+  int idxCutMinDecayLength{-1};
+  int idxCutMaxDecayLength{-1};
+  int idxCutMaxDecayLengthXy{-1};
+  int idxCutMass{-1};
+  int idxCutPtPi{-1};
+  int idxCutPtKa{-1};
+  int idxCutD0Pi{-1};
+  int idxCutD0Ka{-1};
+  int idxCutCosThetaStar{-1};
 
   using TracksSel = soa::Join<aod::TracksWDcaExtra, aod::TracksPidPi, aod::PidTpcTofFullPi, aod::TracksPidKa, aod::PidTpcTofFullKa>;
+  using TracksSelPidStatus = soa::Join<TracksSel, aod::HfPidStatuses>;
 
   // Define histograms
   AxisSpec axisMassDmeson{200, 1.7f, 2.1f};
@@ -91,7 +108,7 @@ struct HfCandidateSelectorD0 {
 
   void init(InitContext&)
   {
-    std::array<bool, 2> doprocess{doprocessWithDCAFitterN, doprocessWithKFParticle};
+    std::array<bool, 4> doprocess{doprocessWithDCAFitterN, doprocessWithKFParticle, doprocessWithDCAFitterNPidStatus, doprocessWithKFParticlePidStatus};
     if ((std::accumulate(doprocess.begin(), doprocess.end(), 0)) != 1) {
       LOGP(fatal, "Only one process function can be enabled at a time.");
     }
@@ -111,6 +128,22 @@ struct HfCandidateSelectorD0 {
     selectorPion.setRangeNSigmaTofCondTpc(-nSigmaTofCombinedMax, nSigmaTofCombinedMax);
     selectorKaon = selectorPion;
 
+    binnedCuts.configure(binsPt.value, cuts.value);
+    idxCutD0D0 = binnedCuts.getCutIndex("d0d0");
+    idxCutCosPointingAngle = binnedCuts.getCutIndex("cos pointing angle");
+    idxCutCosPointingAngleXy = binnedCuts.getCutIndex("cos pointing angle xy");
+    idxCutMinNormDecayLengthXy = binnedCuts.getCutIndex("min norm decay length XY");
+    idxCutNormDauImpParXy = binnedCuts.getCutIndex("norm dauImpPar XY");
+    idxCutMinDecayLength = binnedCuts.getCutIndex("min decay length");
+    idxCutMaxDecayLength = binnedCuts.getCutIndex("max decay length");
+    idxCutMaxDecayLengthXy = binnedCuts.getCutIndex("max decay length XY");
+    idxCutMass = binnedCuts.getCutIndex("m");
+    idxCutPtPi = binnedCuts.getCutIndex("pT Pi");
+    idxCutPtKa = binnedCuts.getCutIndex("pT K");
+    idxCutD0Pi = binnedCuts.getCutIndex("d0pi");
+    idxCutD0Ka = binnedCuts.getCutIndex("d0K");
+    idxCutCosThetaStar = binnedCuts.getCutIndex("cos theta*");
+
     if (applyMl) {
       hfMlResponse.configure(binsPtMl, cutsMl, cutDirMl, nClassesMl);
       if (loadModelsFromCCDB) {
@@ -132,7 +165,7 @@ struct HfCandidateSelectorD0 {
   bool selectionTopol(const T& candidate)
   {
     auto candpT = candidate.pt();
-    auto pTBin = findBin(binsPt, candpT);
+    auto pTBin = binnedCuts.findBin(candpT);
     if (pTBin == -1) {
       return false;
     }
@@ -142,19 +175,19 @@ struct HfCandidateSelectorD0 {
       return false;
     }
     // product of daughter impact parameters
-    if (candidate.impactParameterProduct() > cuts->get(pTBin, "d0d0")) {
+    if (candidate.impactParameterProduct() > binnedCuts.get(pTBin, idxCutD0D0)) {
       return false;
     }
     // cosine of pointing angle
-    if (candidate.cpa() < cuts->get(pTBin, "cos pointing angle")) {
+    if (candidate.cpa() < binnedCuts.get(pTBin, idxCutCosPointingAngle)) {
       return false;
     }
     // cosine of pointing angle XY
-    if (candidate.cpaXY() < cuts->get(pTBin, "cos pointing angle xy")) {
+    if (candidate.cpaXY() < binnedCuts.get(pTBin, idxCutCosPointingAngleXy)) {
       return false;
     }
     // normalised decay length in XY plane
-    if (candidate.decayLengthXYNormalised() < cuts->get(pTBin, "min norm decay length XY")) {
+    if (candidate.decayLengthXYNormalised() < binnedCuts.get(pTBin, idxCutMinNormDecayLengthXy)) {
       return false;
     }
     // candidate DCA
@@ -164,16 +197,16 @@ struct HfCandidateSelectorD0 {
     // if constexpr (reconstructionType == aod::hf_cand::VertexerType::KfParticle) {
     //   if (candidate.kfTopolChi2OverNdf() > cuts->get(pTBin, "topological chi2overndf as D0")) return false;
     // }
-    if (std::abs(candidate.impactParameterNormalised0()) < cuts->get(pTBin, "norm dauImpPar XY") || std::abs(candidate.impactParameterNormalised1()) < cuts->get(pTBin, "norm dauImpPar XY")) {
+    if (std::abs(candidate.impactParameterNormalised0()) < binnedCuts.get(pTBin, idxCutNormDauImpParXy) || std::abs(candidate.impactParameterNormalised1()) < binnedCuts.get(pTBin, idxCutNormDauImpParXy)) {
       return false;
     }
-    if (candidate.decayLength() < cuts->get(pTBin, "min decay length")) {
+    if (candidate.decayLength() < binnedCuts.get(pTBin, idxCutMinDecayLength)) {
       return false;
     }
-    if (candidate.decayLength() > cuts->get(pTBin, "max decay length")) {
+    if (candidate.decayLength() > binnedCuts.get(pTBin, idxCutMaxDecayLength)) {
       return false;
     }
-    if (candidate.decayLengthXY() > cuts->get(pTBin, "max decay length XY")) {
+    if (candidate.decayLengthXY() > binnedCuts.get(pTBin, idxCutMaxDecayLengthXy)) {
       return false;
     }
 
@@ -191,7 +224,7 @@ struct HfCandidateSelectorD0 {
   bool selectionTopolConjugate(const T1& candidate, const T2& trackPion, const T2& trackKaon)
   {
     auto candpT = candidate.pt();
-    auto pTBin = findBin(binsPt, candpT);
+    auto pTBin = binnedCuts.findBin(candpT);
     if (pTBin == -1) {
       return false;
     }
@@ -206,32 +239,32 @@ struct HfCandidateSelectorD0 {
       massD0bar = hfHelper.invMassD0barToKPi(candidate);
     }
     if (trackPion.sign() > 0) {
-      if (std::abs(massD0 - o2::constants::physics::MassD0) > cuts->get(pTBin, "m")) {
+      if (std::abs(massD0 - o2::constants::physics::MassD0) > binnedCuts.get(pTBin, idxCutMass)) {
         return false;
       }
     } else {
-      if (std::abs(massD0bar - o2::constants::physics::MassD0) > cuts->get(pTBin, "m")) {
+      if (std::abs(massD0bar - o2::constants::physics::MassD0) > binnedCuts.get(pTBin, idxCutMass)) {
         return false;
       }
     }
 
     // cut on daughter pT
-    if (trackPion.pt() < cuts->get(pTBin, "pT Pi") || trackKaon.pt() < cuts->get(pTBin, "pT K")) {
+    if (trackPion.pt() < binnedCuts.get(pTBin, idxCutPtPi) || trackKaon.pt() < binnedCuts.get(pTBin, idxCutPtKa)) {
       return false;
     }
 
     // cut on daughter DCA - need to add secondary vertex constraint here
-    if (std::abs(trackPion.dcaXY()) > cuts->get(pTBin, "d0pi") || std::abs(trackKaon.dcaXY()) > cuts->get(pTBin, "d0K")) {
+    if (std::abs(trackPion.dcaXY()) > binnedCuts.get(pTBin, idxCutD0Pi) || std::abs(trackKaon.dcaXY()) > binnedCuts.get(pTBin, idxCutD0Ka)) {
       return false;
     }
 
     // cut on cos(theta*)
     if (trackPion.sign() > 0) {
-      if (std::abs(hfHelper.cosThetaStarD0(candidate)) > cuts->get(pTBin, "cos theta*")) {
+      if (std::abs(hfHelper.cosThetaStarD0(candidate)) > binnedCuts.get(pTBin, idxCutCosThetaStar)) {
         return false;
       }
     } else {
-      if (std::abs(hfHelper.cosThetaStarD0bar(candidate)) > cuts->get(pTBin, "cos theta*")) {
+      if (std::abs(hfHelper.cosThetaStarD0bar(candidate)) > binnedCuts.get(pTBin, idxCutCosThetaStar)) {
         return false;
       }
     }
@@ -251,9 +284,37 @@ struct HfCandidateSelectorD0 {
 
     return true;
   }
-  template <int reconstructionType, typename CandType>
+  /// Selection status of the track PID for the D0 selection
+  /// \param track is the track
+  /// \param selector is the selector of the species
+  /// \param species is the species in the PID status table
+  /// \return PID selection status (TrackSelectorPID::Status)
+  template <bool usePidStatus, typename TTrack, typename TSelector>
+  int getStatusPid(const TTrack& track, TSelector& selector, int species)
+  {
+    if constexpr (usePidStatus) {
+      if (usePidTpcOnly) {
+        return track.pidStatus(aod::hf_pid_status::Tpc, species);
+      }
+      if (usePidTpcAndTof) {
+        return track.pidStatus(aod::hf_pid_status::TpcAndTof, species);
+      }
+      return track.pidStatus(aod::hf_pid_status::TpcOrTof, species);
+    } else {
+      if (usePidTpcOnly) {
+        return selector.statusTpc(track);
+      }
+      if (usePidTpcAndTof) {
+        return selector.statusTpcAndTof(track);
+      }
+      return selector.statusTpcOrTof(track);
+    }
+  }
+
+  /// \tparam usePidStatus reads the track PID from the PID status table (HfPidStatuses) instead of applying the PID configuration of this task
+  template <int reconstructionType, bool usePidStatus, typename CandType, typename TTracks>
   void processSel(CandType const& candidates,
-                  TracksSel const&)
+                  TTracks const&)
   {
     // looping over 2-prong candidates
     for (const auto& candidate : candidates) {
@@ -279,8 +340,8 @@ struct HfCandidateSelectorD0 {
       statusHFFlag = 1;
 
       auto ptCand = candidate.pt();
-      auto trackPos = candidate.template prong0_as<TracksSel>(); // positive daughter
-      auto trackNeg = candidate.template prong1_as<TracksSel>(); // negative daughter
+      auto trackPos = candidate.template prong0_as<TTracks>(); // positive daughter
+      auto trackNeg = candidate.template prong1_as<TTracks>(); // negative daughter
 
       // conjugate-independent topological selection
       if (!selectionTopol<reconstructionType>(candidate)) {
@@ -311,27 +372,10 @@ struct HfCandidateSelectorD0 {
 
       if (usePid) {
         // track-level PID selection
-        int pidTrackPosKaon = -1;
-        int pidTrackPosPion = -1;
-        int pidTrackNegKaon = -1;
-        int pidTrackNegPion = -1;
-
-        if (usePidTpcOnly) {
-          pidTrackPosKaon = selectorKaon.statusTpc(trackPos);
-          pidTrackPosPion = selectorPion.statusTpc(trackPos);
-          pidTrackNegKaon = selectorKaon.statusTpc(trackNeg);
-          pidTrackNegPion = selectorPion.statusTpc(trackNeg);
-        } else if (usePidTpcAndTof) {
-          pidTrackPosKaon = selectorKaon.statusTpcAndTof(trackPos);
-          pidTrackPosPion = selectorPion.statusTpcAndTof(trackPos);
-          pidTrackNegKaon = selectorKaon.statusTpcAndTof(trackNeg);
-          pidTrackNegPion = selectorPion.statusTpcAndTof(trackNeg);
-        } else {
-          pidTrackPosKaon = selectorKaon.statusTpcOrTof(trackPos);
-          pidTrackPosPion = selectorPion.statusTpcOrTof(trackPos);
-          pidTrackNegKaon = selectorKaon.statusTpcOrTof(trackNeg);
-          pidTrackNegPion = selectorPion.statusTpcOrTof(trackNeg);
-        }
+        int pidTrackPosKaon = getStatusPid<usePidStatus>(trackPos, selectorKaon, aod::hf_pid_status::Kaon);
+        int pidTrackPosPion = getStatusPid<usePidStatus>(trackPos, selectorPion, aod::hf_pid_status::Pion);
+        int pidTrackNegKaon = getStatusPid<usePidStatus>(trackNeg, selectorKaon, aod::hf_pid_status::Kaon);
+        int pidTrackNegPion = getStatusPid<usePidStatus>(trackNeg, selectorPion, aod::hf_pid_status::Pion);
 
         // int pidBayesTrackPos1Pion = selectorPion.statusBayes(trackPos);
 
@@ -422,15 +466,27 @@ struct HfCandidateSelectorD0 {
 
   void processWithDCAFitterN(aod::HfCand2Prong const& candidates, TracksSel const& tracks)
   {
-    processSel<aod::hf_cand::VertexerType::DCAFitter>(candidates, tracks);
+    processSel<aod::hf_cand::VertexerType::DCAFitter, false>(candidates, tracks);
   }
   PROCESS_SWITCH(HfCandidateSelectorD0, processWithDCAFitterN, "process candidates selection with DCAFitterN", true);
 
   void processWithKFParticle(soa::Join<aod::HfCand2Prong, aod::HfCand2ProngKF> const& candidates, TracksSel const& tracks)
   {
-    processSel<aod::hf_cand::VertexerType::KfParticle>(candidates, tracks);
+    processSel<aod::hf_cand::VertexerType::KfParticle, false>(candidates, tracks);
   }
   PROCESS_SWITCH(HfCandidateSelectorD0, processWithKFParticle, "process candidates selection with KFParticle", false);
+
+  void processWithDCAFitterNPidStatus(aod::HfCand2Prong const& candidates, TracksSelPidStatus const& tracks)
+  {
+    processSel<aod::hf_cand::VertexerType::DCAFitter, true>(candidates, tracks);
+  }
+  PROCESS_SWITCH(HfCandidateSelectorD0, processWithDCAFitterNPidStatus, "process candidates selection with DCAFitterN and the track PID statuses of the PID creator", false);
+
+  void processWithKFParticlePidStatus(soa::Join<aod::HfCand2Prong, aod::HfCand2ProngKF> const& candidates, TracksSelPidStatus const& tracks)
+  {
+    processSel<aod::hf_cand::VertexerType::KfParticle, true>(candidates, tracks);
+  }
+  PROCESS_SWITCH(HfCandidateSelectorD0, processWithKFParticlePidStatus, "process candidates selection with KFParticle and the track PID statuses of the PID creator", false);
 };
 
 WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
@@ -80,6 +80,16 @@ struct HfCandidateSelectorDplusToPiKPi {
   TrackSelectorPi selectorPion;
   TrackSelectorKa selectorKaon;
   HfHelper hfHelper;
+  HfBinnedCuts binnedCuts;
+  // indices of the cut variables in the cut configuration
+  int idxCutPtPi{-1};
+  int idxCutPtKa{-1};
+  int idxCutDeltaMass{-1};
+  int idxCutDecayLength{-1};
+  int idxCutNormalizedDecayLengthXy{-1};
+  int idxCutCosPointingAngle{-1};
+  int idxCutCosPointingAngleXy{-1};
+  int idxCutMaxNormalizedDeltaIp{-1};
 
   using TracksSel = soa::Join<aod::TracksWExtra, aod::TracksPidPi, aod::PidTpcTofFullPi, aod::TracksPidKa, aod::PidTpcTofFullKa>;
 
@@ -95,6 +105,16 @@ struct HfCandidateSelectorDplusToPiKPi {
     selectorPion.setRangeNSigmaTofCondTpc(-nSigmaTofCombinedMax, nSigmaTofCombinedMax);
     selectorKaon = selectorPion;
 
+    binnedCuts.configure(binsPt.value, cuts.value);
+    idxCutPtPi = binnedCuts.getCutIndex("pT Pi");
+    idxCutPtKa = binnedCuts.getCutIndex("pT K");
+    idxCutDeltaMass = binnedCuts.getCutIndex("deltaM");
+    idxCutDecayLength = binnedCuts.getCutIndex("decay length");
+    idxCutNormalizedDecayLengthXy = binnedCuts.getCutIndex("normalized decay length XY");
+    idxCutCosPointingAngle = binnedCuts.getCutIndex("cos pointing angle");
+    idxCutCosPointingAngleXy = binnedCuts.getCutIndex("cos pointing angle XY");
+    idxCutMaxNormalizedDeltaIp = binnedCuts.getCutIndex("max normalized deltaIP");
+
     if (activateQA) {
       constexpr int kNBinsSelections = 1 + aod::SelectionStep::NSelectionSteps;
       std::string labels[kNBinsSelections];
@@ -133,7 +153,7 @@ struct HfCandidateSelectorDplusToPiKPi {
   bool selection(const T1& candidate, const T2& trackPion1, const T2& trackKaon, const T2& trackPion2)
   {
     auto candpT = candidate.pt();
-    int pTBin = findBin(binsPt, candpT);
+    int pTBin = binnedCuts.findBin(candpT);
     if (pTBin == -1) {
       return false;
     }
@@ -142,26 +162,26 @@ struct HfCandidateSelectorDplusToPiKPi {
       return false;
     }
     // cut on daughter pT
-    if (trackPion1.pt() < cuts->get(pTBin, "pT Pi") || trackKaon.pt() < cuts->get(pTBin, "pT K") || trackPion2.pt() < cuts->get(pTBin, "pT Pi")) {
+    if (trackPion1.pt() < binnedCuts.get(pTBin, idxCutPtPi) || trackKaon.pt() < binnedCuts.get(pTBin, idxCutPtKa) || trackPion2.pt() < binnedCuts.get(pTBin, idxCutPtPi)) {
       return false;
     }
     // invariant-mass cut
-    if (std::abs(hfHelper.invMassDplusToPiKPi(candidate) - o2::constants::physics::MassDPlus) > cuts->get(pTBin, "deltaM")) {
+    if (std::abs(hfHelper.invMassDplusToPiKPi(candidate) - o2::constants::physics::MassDPlus) > binnedCuts.get(pTBin, idxCutDeltaMass)) {
       return false;
     }
-    if (candidate.decayLength() < cuts->get(pTBin, "decay length")) {
+    if (candidate.decayLength() < binnedCuts.get(pTBin, idxCutDecayLength)) {
       return false;
     }
-    if (candidate.decayLengthXYNormalised() < cuts->get(pTBin, "normalized decay length XY")) {
+    if (candidate.decayLengthXYNormalised() < binnedCuts.get(pTBin, idxCutNormalizedDecayLengthXy)) {
       return false;
     }
-    if (candidate.cpa() < cuts->get(pTBin, "cos pointing angle")) {
+    if (candidate.cpa() < binnedCuts.get(pTBin, idxCutCosPointingAngle)) {
       return false;
     }
-    if (candidate.cpaXY() < cuts->get(pTBin, "cos pointing angle XY")) {
+    if (candidate.cpaXY() < binnedCuts.get(pTBin, idxCutCosPointingAngleXy)) {
       return false;
     }
-    if (std::abs(candidate.maxNormalisedDeltaIP()) > cuts->get(pTBin, "max normalized deltaIP")) {
+    if (std::abs(candidate.maxNormalisedDeltaIP()) > binnedCuts.get(pTBin, idxCutMaxNormalizedDeltaIp)) {
       return false;
     }
     if (!isSelectedCandidateProngDca(candidate)) {
@@ -91,9 +91,7 @@ struct HfCandidateSelectorLc {
   std::vector<float> outputMlLcToPKPi = {};
   std::vector<float> outputMlLcToPiKP = {};
   o2::ccdb::CcdbApi ccdbApi;
-  TrackSelectorPi selectorPion;
-  TrackSelectorKa selectorKaon;
-  TrackSelectorPr selectorProton;
+  TrackSelectorPidMulti<kProton, kKPlus, kPiPlus> selectorPid;
 
   using TracksSel = soa::Join<aod::TracksWExtra,
                               aod::TracksPidPi, aod::PidTpcTofFullPi, aod::TracksPidKa, aod::PidTpcTofFullKa, aod::TracksPidPr, aod::PidTpcTofFullPr>;
@@ -108,6 +106,7 @@ struct HfCandidateSelectorLc {
       LOGP(fatal, "One and only one process function must be enabled at a time.");
     }
 
+    TrackSelectorPi selectorPion;
     selectorPion.setRangePtTpc(ptPidTpcMin, ptPidTpcMax);
     selectorPion.setRangeNSigmaTpc(-nSigmaTpcMax, nSigmaTpcMax);
     selectorPion.setRangeNSigmaTpcCondTof(-nSigmaTpcCombinedMax, nSigmaTpcCombinedMax);
@@ -115,8 +114,7 @@ struct HfCandidateSelectorLc {
     selectorPion.setRangeNSigmaTof(-nSigmaTofMax, nSigmaTofMax);
     selectorPion.setRangeNSigmaTofCondTpc(-nSigmaTofCombinedMax, nSigmaTofCombinedMax);
     selectorPion.setRangePtBayes(ptPidBayesMin, ptPidBayesMax);
-    selectorKaon = selectorPion;
-    selectorProton = selectorPion;
+    selectorPid.setSelector(selectorPion);
 
     if (activateQA) {
       constexpr int kNBinsSelections = 1 + aod::SelectionStep::NSelectionSteps;
@@ -345,25 +343,22 @@ struct HfCandidateSelectorLc {
       auto pidBayesLcToPiKP = 1;
 
       if (usePid) {
-        // track-level PID selection
-        TrackSelectorPID::Status pidTrackPos1Proton = TrackSelectorPID::Accepted;
-        TrackSelectorPID::Status pidTrackPos2Proton = TrackSelectorPID::Accepted;
-        TrackSelectorPID::Status pidTrackPos1Pion = TrackSelectorPID::Accepted;
-        TrackSelectorPID::Status pidTrackPos2Pion = TrackSelectorPID::Accepted;
-        TrackSelectorPID::Status pidTrackNegKaon = TrackSelectorPID::Accepted;
+        // track-level PID selection, all species of a prong at once
+        uint32_t pidTrackPos1 = 0, pidTrackNeg = 0, pidTrackPos2 = 0;
         if (usePidTpcAndTof) {
-          pidTrackPos1Proton = selectorProton.statusTpcAndTof(trackPos1);
-          pidTrackPos2Proton = selectorProton.statusTpcAndTof(trackPos2);
-          pidTrackPos1Pion = selectorPion.statusTpcAndTof(trackPos1);
-          pidTrackPos2Pion = selectorPion.statusTpcAndTof(trackPos2);
-          pidTrackNegKaon = selectorKaon.statusTpcAndTof(trackNeg);
+          pidTrackPos1 = selectorPid.statusTpcAndTof(trackPos1);
+          pidTrackNeg = selectorPid.statusTpcAndTof(trackNeg);
+          pidTrackPos2 = selectorPid.statusTpcAndTof(trackPos2);
         } else {
-          pidTrackPos1Proton = selectorProton.statusTpcOrTof(trackPos1);
-          pidTrackPos2Proton = selectorProton.statusTpcOrTof(trackPos2);
-          pidTrackPos1Pion = selectorPion.statusTpcOrTof(trackPos1);
-          pidTrackPos2Pion = selectorPion.statusTpcOrTof(trackPos2);
-          pidTrackNegKaon = selectorKaon.statusTpcOrTof(trackNeg);
+          pidTrackPos1 = selectorPid.statusTpcOrTof(trackPos1);
+          pidTrackNeg = selectorPid.statusTpcOrTof(trackNeg);
+          pidTrackPos2 = selectorPid.statusTpcOrTof(trackPos2);
         }
+        TrackSelectorPID::Status pidTrackPos1Proton = selectorPid.getStatus<kProton>(pidTrackPos1);
+        TrackSelectorPID::Status pidTrackPos2Proton = selectorPid.getStatus<kProton>(pidTrackPos2);
+        TrackSelectorPID::Status pidTrackPos1Pion = selectorPid.getStatus<kPiPlus>(pidTrackPos1);
+        TrackSelectorPID::Status pidTrackPos2Pion = selectorPid.getStatus<kPiPlus>(pidTrackPos2);
+        TrackSelectorPID::Status pidTrackNegKaon = selectorPid.getStatus<kKPlus>(pidTrackNeg);
 
         if (!isSelectedPID(pidTrackPos1Proton, pidTrackNegKaon, pidTrackPos2Pion)) {
           pidLcToPKPi = 0; // reject LcToPKPi
@@ -374,11 +369,14 @@ struct HfCandidateSelectorLc {
       }
 
       if constexpr (useBayesPid) {
-        TrackSelectorPID::Status pidBayesTrackPos1Proton = selectorProton.statusBayes(trackPos1);
-        TrackSelectorPID::Status pidBayesTrackPos2Proton = selectorProton.statusBayes(trackPos2);
-        TrackSelectorPID::Status pidBayesTrackPos1Pion = selectorPion.statusBayes(trackPos1);
-        TrackSelectorPID::Status pidBayesTrackPos2Pion = selectorPion.statusBayes(trackPos2);
-        TrackSelectorPID::Status pidBayesTrackNegKaon = selectorKaon.statusBayes(trackNeg);
+        uint32_t pidBayesTrackPos1 = selectorPid.statusBayes(trackPos1);
+        uint32_t pidBayesTrackNeg = selectorPid.statusBayes(trackNeg);
+        uint32_t pidBayesTrackPos2 = selectorPid.statusBayes(trackPos2);
+        TrackSelectorPID::Status pidBayesTrackPos1Proton = selectorPid.getStatus<kProton>(pidBayesTrackPos1);
+        TrackSelectorPID::Status pidBayesTrackPos2Proton = selectorPid.getStatus<kProton>(pidBayesTrackPos2);
+        TrackSelectorPID::Status pidBayesTrackPos1Pion = selectorPid.getStatus<kPiPlus>(pidBayesTrackPos1);
+        TrackSelectorPID::Status pidBayesTrackPos2Pion = selectorPid.getStatus<kPiPlus>(pidBayesTrackPos2);
+        TrackSelectorPID::Status pidBayesTrackNegKaon = selectorPid.getStatus<kKPlus>(pidBayesTrackNeg);
 
         if (!isSelectedPID(pidBayesTrackPos1Proton, pidBayesTrackNegKaon, pidBayesTrackPos2Pion)) {
           pidBayesLcToPKPi = 0; // reject LcToPKPi
@@ -27,8 +27,10 @@
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
 #include "PWGHF/DataModel/DerivedTables.h"
+#include "PWGHF/Utils/utilsDerivedData.h"
 
 using namespace o2;
+using namespace o2::analysis::hf_derived;
 using namespace o2::framework;
 using namespace o2::framework::expressions;
 
@@ -74,8 +76,7 @@ struct HfDerivedDataCreatorLcToPKPi {
 
   HfHelper hfHelper;
   SliceCache cache;
-  std::map<int, std::vector<int>> matchedCollisions; // indices of derived reconstructed collisions matched to the global indices of MC collisions
-  std::map<int, bool> hasMcParticles;                // flags for MC collisions with HF particles
+  McCollisionMatcher mcCollisionMatcher; // derived reconstructed collisions matched to MC collisions, MC collisions with HF particles
 
   using CollisionsWCentMult = soa::Join<aod::Collisions, aod::CentFV0As, aod::CentFT0Ms, aod::CentFT0As, aod::CentFT0Cs, aod::PVMultZeqs>;
   using CollisionsWMcCentMult = soa::Join<aod::Collisions, aod::McCollisionLabels, aod::CentFV0As, aod::CentFT0Ms, aod::CentFT0As, aod::CentFT0Cs, aod::PVMultZeqs>;
@@ -115,14 +116,6 @@ struct HfDerivedDataCreatorLcToPKPi {
     }
   }
 
-  template <typename T>
-  void reserveTable(T& table, const Configurable<bool>& enabled, const uint64_t size)
-  {
-    if (enabled.value) {
-      table.reserve(size);
-    }
-  };
-
   template <bool isMC, typename T>
   // void fillTablesCollision(const T& collision, int isEventReject, int runNumber)
   void fillTablesCollision(const T& collision)
@@ -149,7 +142,7 @@ struct HfDerivedDataCreatorLcToPKPi {
       if (fillMcRCollId && collision.has_mcCollision()) {
         // Save rowCollBase.lastIndex() at key collision.mcCollisionId()
         LOGF(debug, "Rec. collision %d: Filling derived-collision index %d for MC collision %d", collision.globalIndex(), rowCollBase.lastIndex(), collision.mcCollisionId());
-        matchedCollisions[collision.mcCollisionId()].push_back(rowCollBase.lastIndex()); // [] inserts an empty element if it does not exist
+        mcCollisionMatcher.addMatchedCollision(collision.mcCollisionId(), rowCollBase.lastIndex());
       }
     }
   }
@@ -170,7 +163,7 @@ struct HfDerivedDataCreatorLcToPKPi {
     if (fillMcRCollId) {
       // Fill the table with the vector of indices of derived reconstructed collisions matched to mcCollision.globalIndex()
       rowMcRCollId(
-        matchedCollisions[mcCollision.globalIndex()]);
+        mcCollisionMatcher.getMatchedCollisions(mcCollision.globalIndex()));
     }
   }
 
@@ -297,14 +290,19 @@ struct HfDerivedDataCreatorLcToPKPi {
                          aod::BCs const&)
   {
     // Fill collision properties
-    if constexpr (isMc) {
-      if (fillMcRCollId) {
-        matchedCollisions.clear();
-      }
-    }
     auto sizeTableColl = collisions.size();
     reserveTable(rowCollBase, fillCollBase, sizeTableColl);
     reserveTable(rowCollId, fillCollId, sizeTableColl);
+    // Reserve the candidate rows of the whole dataframe at once (at least one row per candidate)
+    auto sizeTableCandAll = candidates->size();
+    reserveTable(rowCandidateBase, fillCandidateBase, sizeTableCandAll);
+    reserveTable(rowCandidatePar, fillCandidatePar, sizeTableCandAll);
+    reserveTable(rowCandidateParE, fillCandidateParE, sizeTableCandAll);
+    reserveTable(rowCandidateSel, fillCandidateSel, sizeTableCandAll);
+    reserveTable(rowCandidateId, fillCandidateId, sizeTableCandAll);
+    if constexpr (isMc) {
+      reserveTable(rowCandidateMc, fillCandidateMc, sizeTableCandAll);
+    }
     for (const auto& collision : collisions) {
       auto thisCollId = collision.globalIndex();
       auto candidatesThisColl = candidates->sliceByCached(aod::hf_cand::collisionId, thisCollId, cache); // FIXME
@@ -313,7 +311,7 @@ struct HfDerivedDataCreatorLcToPKPi {
       // Skip collisions without HF candidates (and without HF particles in matched MC collisions if saving indices of reconstructed collisions matched to MC collisions)
       bool mcCollisionHasMcParticles{false};
       if constexpr (isMc) {
-        mcCollisionHasMcParticles = fillMcRCollId && collision.has_mcCollision() && hasMcParticles[collision.mcCollisionId()];
+        mcCollisionHasMcParticles = fillMcRCollId && collision.has_mcCollision() && mcCollisionMatcher.hasMcParticles(collision.mcCollisionId());
         LOGF(debug, "Rec. collision %d has MC collision %d with MC particles? %s", thisCollId, collision.mcCollisionId(), mcCollisionHasMcParticles ? "yes" : "no");
       }
       if (sizeTableCand == 0 && (!fillMcRCollId || !mcCollisionHasMcParticles)) {
@@ -325,14 +323,6 @@ struct HfDerivedDataCreatorLcToPKPi {
       fillTablesCollision<isMc>(collision);
 
       // Fill candidate properties
-      reserveTable(rowCandidateBase, fillCandidateBase, sizeTableCand);
-      reserveTable(rowCandidatePar, fillCandidatePar, sizeTableCand);
-      reserveTable(rowCandidateParE, fillCandidateParE, sizeTableCand);
-      reserveTable(rowCandidateSel, fillCandidateSel, sizeTableCand);
-      reserveTable(rowCandidateId, fillCandidateId, sizeTableCand);
-      if constexpr (isMc) {
-        reserveTable(rowCandidateMc, fillCandidateMc, sizeTableCand);
-      }
       int8_t flagMcRec = 0, origin = 0, swapping = 0;
       for (const auto& candidate : candidatesThisColl) {
         if constexpr (isMc) {
@@ -343,11 +333,8 @@ struct HfDerivedDataCreatorLcToPKPi {
             if (TESTBIT(std::abs(flagMcRec), aod::hf_cand_3prong::DecayType::LcToPKPi)) {
               continue;
             }
-            if (downSampleBkgFactor < 1.) {
-              float pseudoRndm = candidate.ptProng0() * 1000. - (int64_t)(candidate.ptProng0() * 1000);
-              if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
-                continue;
-              }
+            if (isDownSampled(candidate.ptProng0(), candidate.pt(), downSampleBkgFactor, ptMaxForDownSample)) {
+              continue;
             }
           }
           if constexpr (onlySig) {
@@ -382,16 +369,16 @@ struct HfDerivedDataCreatorLcToPKPi {
   void preProcessMcCollisions(CollisionType const& mcCollisions,
                               ParticleType const& mcParticles)
   {
+    mcCollisionMatcher.reset(mcCollisions.size());
     if (!fillMcRCollId) {
       return;
     }
-    hasMcParticles.clear();
     // Fill MC collision flags
     for (const auto& mcCollision : mcCollisions) {
       auto thisMcCollId = mcCollision.globalIndex();
       auto particlesThisMcColl = mcParticles.sliceBy(mcParticlesPerMcCollision, thisMcCollId);
       LOGF(debug, "MC collision %d has %d MC particles (preprocess)", thisMcCollId, particlesThisMcColl.size());
-      hasMcParticles[thisMcCollId] = (particlesThisMcColl.size() > 0);
+      mcCollisionMatcher.setHasMcParticles(thisMcCollId, particlesThisMcColl.size() > 0);
     }
   }
 
@@ -403,14 +390,16 @@ struct HfDerivedDataCreatorLcToPKPi {
     auto sizeTableMcColl = mcCollisions.size();
     reserveTable(rowMcCollBase, fillMcCollBase, sizeTableMcColl);
     reserveTable(rowMcRCollId, fillMcRCollId, sizeTableMcColl);
+    reserveTable(rowParticleBase, fillParticleBase, mcParticles.size());
+    reserveTable(rowParticleId, fillParticleId, mcParticles.size());
     for (const auto& mcCollision : mcCollisions) {
       auto thisMcCollId = mcCollision.globalIndex();
       auto particlesThisMcColl = mcParticles.sliceBy(mcParticlesPerMcCollision, thisMcCollId);
       auto sizeTablePart = particlesThisMcColl.size();
       LOGF(debug, "MC collision %d has %d MC particles", thisMcCollId, sizeTablePart);
       // Skip MC collisions without HF particles (and without HF candidates in matched reconstructed collisions if saving indices of reconstructed collisions matched to MC collisions)
-      LOGF(debug, "MC collision %d has %d saved derived rec. collisions", thisMcCollId, matchedCollisions[thisMcCollId].size());
-      if (sizeTablePart == 0 && (!fillMcRCollId || matchedCollisions[thisMcCollId].empty())) {
+      LOGF(debug, "MC collision %d has %d saved derived rec. collisions", thisMcCollId, mcCollisionMatcher.getMatchedCollisions(thisMcCollId).size());
+      if (sizeTablePart == 0 && (!fillMcRCollId || mcCollisionMatcher.getMatchedCollisions(thisMcCollId).empty())) {
         LOGF(debug, "Skipping MC collision %d", thisMcCollId);
         continue;
       }
@@ -418,8 +407,6 @@ struct HfDerivedDataCreatorLcToPKPi {
       fillTablesMcCollision(mcCollision);
 
       // Fill MC particle properties
-      reserveTable(rowParticleBase, fillParticleBase, sizeTablePart);
-      reserveTable(rowParticleId, fillParticleId, sizeTablePart);
       for (const auto& particle : particlesThisMcColl) {
         fillTablesParticle(particle, o2::constants::physics::MassLambdaCPlus);
       }
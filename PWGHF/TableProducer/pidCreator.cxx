@@ -10,7 +10,7 @@
 // or submit itself to any jurisdiction.
 
 /// \file pidCreator.cxx
-/// \brief Workflow to produce tables with TPC+TOF combined n sigma
+/// \brief Workflow to produce tables with TPC+TOF combined n sigma and with the PID selection statuses of the tracks
 ///
 /// \author Vít Kučera <vit.kucera@cern.ch>, Inha University
 
@@ -18,6 +18,7 @@
 #include "Framework/runDataProcessing.h"
 
 #include "Common/Core/TableHelper.h"
+#include "Common/Core/TrackSelectorPID.h"
 #include "Common/DataModel/PIDResponse.h"
 
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
@@ -36,6 +37,24 @@ struct HfPidCreator {
   Produces<aod::PidTpcTofTinyKa> trackPidTinyKa;
   Produces<aod::PidTpcTofFullPr> trackPidFullPr;
   Produces<aod::PidTpcTofTinyPr> trackPidTinyPr;
+  Produces<aod::HfPidStatuses> trackPidStatuses;
+
+  // PID selections of the status table
+  Configurable<float> ptPidTpcMin{"ptPidTpcMin", 0.15, "Lower bound of track pT for TPC PID"};
+  Configurable<float> ptPidTpcMax{"ptPidTpcMax", 5., "Upper bound of track pT for TPC PID"};
+  Configurable<float> nSigmaTpcMax{"nSigmaTpcMax", 3., "Nsigma cut on TPC only"};
+  Configurable<float> nSigmaTpcCombinedMax{"nSigmaTpcCombinedMax", 5., "Nsigma cut on TPC combined with TOF"};
+  Configurable<float> ptPidTofMin{"ptPidTofMin", 0.15, "Lower bound of track pT for TOF PID"};
+  Configurable<float> ptPidTofMax{"ptPidTofMax", 5., "Upper bound of track pT for TOF PID"};
+  Configurable<float> nSigmaTofMax{"nSigmaTofMax", 3., "Nsigma cut on TOF only"};
+  Configurable<float> nSigmaTofCombinedMax{"nSigmaTofCombinedMax", 5., "Nsigma cut on TOF combined with TPC"};
+  Configurable<float> ptPidBayesMin{"ptPidBayesMin", 0., "Lower bound of track pT for Bayesian PID"};
+  Configurable<float> ptPidBayesMax{"ptPidBayesMax", 100., "Upper bound of track pT for Bayesian PID"};
+
+  TrackSelectorPidMulti<kPiPlus, kKPlus, kProton> selectorPid;
+
+  using TracksPidStatus = soa::Join<aod::Tracks, aod::TracksExtra, aod::TracksPidPi, aod::TracksPidKa, aod::TracksPidPr>;
+  using TracksPidStatusBayes = soa::Join<TracksPidStatus, aod::pidBayesPi, aod::pidBayesKa, aod::pidBayesPr, aod::pidBayes>;
 
   static constexpr float defaultNSigmaTolerance = .1f;
   static constexpr float defaultNSigma = -999.f + defaultNSigmaTolerance; // -999.f is the default value set in TPCPIDResponse.h and PIDTOF.h
@@ -71,6 +90,24 @@ struct HfPidCreator {
     checkTableSwitch(initContext, "PidTpcTofTinyKa", doprocessTinyKa);
     checkTableSwitch(initContext, "PidTpcTofFullPr", doprocessFullPr);
     checkTableSwitch(initContext, "PidTpcTofTinyPr", doprocessTinyPr);
+    if (doprocessPidStatus && doprocessPidStatusBayes) {
+      LOGP(fatal, "Only one process function for the PID statuses can be enabled at a time.");
+    }
+    if (doprocessPidStatusBayes) {
+      checkTableSwitch(initContext, "HfPidStatuses", doprocessPidStatusBayes);
+    } else {
+      checkTableSwitch(initContext, "HfPidStatuses", doprocessPidStatus);
+    }
+
+    TrackSelectorPi selector;
+    selector.setRangePtTpc(ptPidTpcMin, ptPidTpcMax);
+    selector.setRangeNSigmaTpc(-nSigmaTpcMax, nSigmaTpcMax);
+    selector.setRangeNSigmaTpcCondTof(-nSigmaTpcCombinedMax, nSigmaTpcCombinedMax);
+    selector.setRangePtTof(ptPidTofMin, ptPidTofMax);
+    selector.setRangeNSigmaTof(-nSigmaTofMax, nSigmaTofMax);
+    selector.setRangeNSigmaTofCondTpc(-nSigmaTofCombinedMax, nSigmaTofCombinedMax);
+    selector.setRangePtBayes(ptPidBayesMin, ptPidBayesMax);
+    selectorPid.setSelector(selector);
   }
 
   /// Function to combine TPC and TOF NSigma
@@ -126,6 +163,33 @@ struct HfPidCreator {
   PROCESS_PID(Pr)
 
 #undef PROCESS_PID
+
+  /// Fills the PID selection statuses of pion, kaon and proton
+  /// \param tracks are the tracks with their PID information
+  template <bool withBayes, typename TTracks>
+  void fillPidStatuses(TTracks const& tracks)
+  {
+    trackPidStatuses.reserve(tracks.size());
+    for (const auto& track : tracks) {
+      uint32_t wordBayes = 0; // NotApplicable for all species
+      if constexpr (withBayes) {
+        wordBayes = selectorPid.statusBayes(track);
+      }
+      trackPidStatuses(aod::hf_pid_status::packPidStatus(selectorPid.statusTpc(track), selectorPid.statusTof(track), selectorPid.statusTpcOrTof(track), selectorPid.statusTpcAndTof(track), wordBayes));
+    }
+  }
+
+  void processPidStatus(TracksPidStatus const& tracks)
+  {
+    fillPidStatuses<false>(tracks);
+  }
+  PROCESS_SWITCH(HfPidCreator, processPidStatus, "Process PID statuses", false);
+
+  void processPidStatusBayes(TracksPidStatusBayes const& tracks)
+  {
+    fillPidStatuses<true>(tracks);
+  }
+  PROCESS_SWITCH(HfPidCreator, processPidStatusBayes, "Process PID statuses including the Bayesian PID", false);
 };
 
 WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
@@ -22,6 +22,7 @@
 
 #include <algorithm> // std::find
 #include <iterator>  // std::distance
+#include <optional>  // std::optional
 #include <string>    // std::string
 #include <vector>    // std::vector
 
@@ -38,6 +39,8 @@
 #include "ReconstructionDataFormats/V0.h"
 #include "ReconstructionDataFormats/Vertex.h" // for PV refit
 
+#include "Common/Core/RunConditions.h"
+#include "Common/Core/TrackParCovCache.h"
 #include "Common/Core/TrackSelectorPID.h"
 #include "Common/Core/trackUtilities.h"
 #include "Common/DataModel/Centrality.h"
@@ -53,6 +56,7 @@
 #include "PWGHF/Utils/utilsAnalysis.h"
 #include "PWGHF/Utils/utilsBfieldCCDB.h"
 #include "PWGHF/Utils/utilsEvSelHf.h"
+#include "PWGHF/Utils/utilsTrkCandHf.h"
 
 using namespace o2;
 using namespace o2::analysis;
@@ -380,7 +384,7 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
       ccdb->setCaching(true);
       ccdb->setLocalObjectValidityChecking();
 
-      lut = o2::base::MatLayerCylSet::rectifyPtrFromFile(ccdb->get<o2::base::MatLayerCylSet>(ccdbPathLut));
+      lut = RunConditions::getSharedMatLut(ccdbPathLut);
       runNumber = 0;
     }
 
@@ -679,8 +683,8 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
   template <typename TTrack>
   void performPvRefitTrack(aod::Collision const& collision,
                            aod::BCsWithTimestamps const&,
-                           std::vector<int64_t> vecPvContributorGlobId,
-                           std::vector<o2::track::TrackParCov> vecPvContributorTrackParCov,
+                           std::vector<int64_t> const& vecPvContributorGlobId,
+                           std::vector<o2::track::TrackParCov> const& vecPvContributorTrackParCov,
                            TTrack const& trackToRemove,
                            std::array<float, 3>& pvCoord,
                            std::array<float, 6>& pvCovMatrix,
@@ -872,6 +876,10 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
                        std::vector<std::array<float, 6>>& pvRefitPvCovMatrixPerTrack)
   {
     auto thisCollId = collision.globalIndex();
+    // PV contributors of the current collision, retrieved at the first track needing the PV refit
+    std::vector<int64_t> vecPvContributorGlobId = {};
+    std::vector<o2::track::TrackParCov> vecPvContributorTrackParCov = {};
+    bool arePvContributorsRetrieved = false;
     for (const auto& trackId : trackIndicesCollision) {
       int statusProng = BIT(CandidateType::NCandidateTypes) - 1; // all bits on
       auto track = trackId.template track_as<TTracks>();
@@ -889,12 +897,14 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
         pvRefitPvCovMatrix = {collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ()};
 
         /// retrieve PV contributors for the current collision
-        std::vector<int64_t> vecPvContributorGlobId = {};
-        std::vector<o2::track::TrackParCov> vecPvContributorTrackParCov = {};
-
-        for (const auto& contributor : pvContrCollision) {
-          vecPvContributorGlobId.push_back(contributor.globalIndex());
-          vecPvContributorTrackParCov.push_back(getTrackParCov(contributor));
+        if (!arePvContributorsRetrieved) {
+          vecPvContributorGlobId.reserve(pvContrCollision.size());
+          vecPvContributorTrackParCov.reserve(pvContrCollision.size());
+          for (const auto& contributor : pvContrCollision) {
+            vecPvContributorGlobId.push_back(contributor.globalIndex());
+            vecPvContributorTrackParCov.push_back(getTrackParCov(contributor));
+          }
+          arePvContributorsRetrieved = true;
         }
         if (debugPvRefit) {
           LOG(info) << "### vecPvContributorGlobId.size()=" << vecPvContributorGlobId.size() << ", vecPvContributorTrackParCov.size()=" << vecPvContributorTrackParCov.size() << ", N. original contributors=" << collision.numContrib();
@@ -1119,12 +1129,15 @@ struct HfTrackIndexSkimCreator {
   Produces<aod::Hf3Prongs> rowTrackIndexProng3;
   Produces<aod::HfCutStatus3Prong> rowProng3CutStatus;
   Produces<aod::HfPvRefit3Prong> rowProng3PVrefit;
+  Produces<aod::HfSecVtx2Prong> rowProng2SecVtx;
+  Produces<aod::HfSecVtx3Prong> rowProng3SecVtx;
   Produces<aod::HfDstars> rowTrackIndexDstar;
   Produces<aod::HfCutStatusDstar> rowDstarCutStatus;
   Produces<aod::HfPvRefitDstar> rowDstarPVrefit;
   // Tables with ML scores for HF Filters
   Produces<aod::Hf2ProngMlProbs> rowTrackIndexMlScoreProng2;
   Produces<aod::Hf3ProngMlProbs> rowTrackIndexMlScoreProng3;
+  Produces<aod::HfMlSkimModels> rowMlSkimModels;
 
   Configurable<bool> isRun2{"isRun2", false, "enable Run 2 or Run 3 GRP objects for magnetic field"};
   Configurable<bool> do3Prong{"do3Prong", 0, "do 3 prong"};
@@ -1147,6 +1160,7 @@ struct HfTrackIndexSkimCreator {
   Configurable<double> maxDZIni{"maxDZIni", 4., "reject (if>0) PCA candidate if tracks DZ exceeds threshold"};
   Configurable<double> minParamChange{"minParamChange", 1.e-3, "stop iterations if largest change of any X is smaller than this"};
   Configurable<double> minRelChi2Change{"minRelChi2Change", 0.9, "stop iterations if chi2/chi2old > this"};
+  Configurable<bool> fillSecVtx{"fillSecVtx", false, "Store the secondary vertices of the 2- and 3-prong candidates to be reused by the candidate creators"};
   // CCDB
   Configurable<std::string> ccdbUrl{"ccdbUrl", "http://alice-ccdb.cern.ch", "url of the ccdb repository"};
   Configurable<std::string> ccdbPathLut{"ccdbPathLut", "GLO/Param/MatLUT", "Path for LUT parametrization"};
@@ -1188,6 +1202,7 @@ struct HfTrackIndexSkimCreator {
   Configurable<std::string> mlModelPathCCDB{"mlModelPathCCDB", "EventFiltering/PWGHF/BDTSmeared", "Path on CCDB of ML models for HF Filters"};
   Configurable<int64_t> timestampCcdbForHfFilters{"timestampCcdbForHfFilters", 1657032422771, "timestamp of the ONNX file for ML model used to query in CCDB"};
   Configurable<bool> loadMlModelsFromCCDB{"loadMlModelsFromCCDB", true, "Flag to enable or disable the loading of ML models from CCDB"};
+  Configurable<bool> fillMlModelHashes{"fillMlModelHashes", false, "Flag to fill the table with the hashes of the ML models, to reuse the ML scores in downstream tasks using the same models"};
 
   Configurable<LabeledArray<std::string>> onnxFileNames{"onnxFileNames", {hf_cuts_bdt_multiclass::onnxFileNameSpecies[0], 5, 1, hf_cuts_bdt_multiclass::labelsSpecies, hf_cuts_bdt_multiclass::labelsModels}, "ONNX file names for ML models"};
 
@@ -1200,6 +1215,7 @@ struct HfTrackIndexSkimCreator {
   SliceCache cache;
   o2::vertexing::DCAFitterN<2> df2; // 2-prong vertex fitter
   o2::vertexing::DCAFitterN<3> df3; // 3-prong vertex fitter
+  TrackParCovCache trackParCovCache; // tracks unpacked once per dataframe, shared by the combinations
   // Needed for PV refitting
   Service<o2::ccdb::BasicCCDBManager> ccdb;
   o2::base::MatLayerCylSet* lut;
@@ -1228,6 +1244,22 @@ struct HfTrackIndexSkimCreator {
   std::array<std::vector<double>, kN2ProngDecays> pTBins2Prong;
   std::array<LabeledArray<double>, kN3ProngDecays> cut3Prong;
   std::array<std::vector<double>, kN3ProngDecays> pTBins3Prong;
+  // PV contributors of the current collision used for the PV refit
+  // the vertexer is prepared once per collision and refitted for each candidate with the daughters masked out
+  struct {
+    std::vector<int64_t> contributorGlobId;
+    std::vector<o2::track::TrackParCov> contributorTrackParCov;
+    std::vector<bool> contributorUsed;
+    std::optional<o2::vertexing::PVertexer> vertexer;
+    bool isPrepared{false};
+    bool isRefitDoable{false};
+  } pvRefitWorkspace;
+  // cut status of the candidates (filled only in case of debug), the buffers are reused from one collision to the next
+  std::array<std::vector<bool>, kN2ProngDecays> cutStatus2Prong;
+  std::array<std::vector<bool>, kN3ProngDecays> cutStatus3Prong;
+  uint32_t fitterSettingsHash{0};                              // fingerprint of the DCAFitterN settings, stored with the secondary vertices
+  std::array<bool, kN3ProngDecays> hasMassCut3Prong{false};    // the invariant-mass preselection is applied in all the pT bins
+  std::array<double, kN3ProngDecays> maxMass3ProngAllBins{0.}; // largest upper edge of the invariant-mass windows over the pT bins
 
   // ML response
   o2::analysis::MlResponse<float> hfMlResponse2Prongs;                             // only D0
@@ -1303,6 +1335,18 @@ struct HfTrackIndexSkimCreator {
     // cuts for 3-prong decays retrieved by json. the order must be then one in hf_cand_3prong::DecayType
     cut3Prong = {cutsDplusToPiKPi, cutsLcToPKPi, cutsDsToKKPi, cutsXicToPKPi};
     pTBins3Prong = {binsPtDplusToPiKPi, binsPtLcToPKPi, binsPtDsToKKPi, binsPtXicToPKPi};
+    for (int iDecay3P = 0; iDecay3P < kN3ProngDecays; iDecay3P++) {
+      hasMassCut3Prong[iDecay3P] = true;
+      maxMass3ProngAllBins[iDecay3P] = 0.;
+      for (size_t iBin = 0; iBin + 1 < pTBins3Prong[iDecay3P].size(); iBin++) {
+        double minMass = cut3Prong[iDecay3P].get(iBin, 0u);
+        double maxMass = cut3Prong[iDecay3P].get(iBin, 1u);
+        if (minMass < 0. || maxMass <= 0.) {
+          hasMassCut3Prong[iDecay3P] = false;
+        }
+        maxMass3ProngAllBins[iDecay3P] = std::max(maxMass3ProngAllBins[iDecay3P], maxMass);
+      }
+    }
 
     df2.setPropagateToPCA(propagateToPCA);
     df2.setMaxR(maxR);
@@ -1319,11 +1363,12 @@ struct HfTrackIndexSkimCreator {
     df3.setMinRelChi2Change(minRelChi2Change);
     df3.setUseAbsDCA(useAbsDCA);
     df3.setWeightedFinalPCA(useWeightedFinalPCA);
+    fitterSettingsHash = o2::hf_trkcandsel::getDcaFitterSettingsHash(propagateToPCA, useAbsDCA, useWeightedFinalPCA, maxR, maxDZIni, minParamChange, minRelChi2Change);
 
     ccdb->setURL(ccdbUrl);
     ccdb->setCaching(true);
     ccdb->setLocalObjectValidityChecking();
-    lut = o2::base::MatLayerCylSet::rectifyPtrFromFile(ccdb->get<o2::base::MatLayerCylSet>(ccdbPathLut));
+    lut = RunConditions::getSharedMatLut(ccdbPathLut);
     runNumber = 0;
 
     if (fillHistograms) {
@@ -1556,6 +1601,29 @@ struct HfTrackIndexSkimCreator {
     }
   }
 
+  /// Method to check whether a third track can make the 3-prong candidate pass the invariant-mass preselection of at least one decay channel
+  /// The 3-prong mass is at least the mass of the first two tracks plus the mass of the third one, whatever the third track momentum
+  /// \param pVecTrack0 is the momentum array of the first daughter track
+  /// \param pVecTrack1 is the momentum array of the second daughter track
+  /// \return false if all the 3-prong candidates built with these two tracks are rejected by the mass preselection
+  template <typename T1>
+  bool isThirdProngMassReachable(T1 const& pVecTrack0, T1 const& pVecTrack1)
+  {
+    for (int iDecay3P = 0; iDecay3P < kN3ProngDecays; iDecay3P++) {
+      if (!hasMassCut3Prong[iDecay3P]) {
+        return true;
+      }
+      for (int iHypo = 0; iHypo < 2; iHypo++) {
+        const auto& masses = arrMass3Prong[iDecay3P][iHypo];
+        double minMass3Prong = RecoDecay::m(std::array{pVecTrack0, pVecTrack1}, std::array{masses[0], masses[1]}) + masses[2];
+        if (minMass3Prong < maxMass3ProngAllBins[iDecay3P] * (1. + 1.e-6)) { // small margin for the rounding of the full mass computation
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
   /// Method to perform selections for 3-prong candidates before vertex reconstruction
   /// \param pVecTrack0 is the momentum array of the first daughter track
   /// \param pVecTrack1 is the momentum array of the second daughter track
@@ -1872,13 +1940,13 @@ struct HfTrackIndexSkimCreator {
   /// \param pvCovMatrix is a vector where to store the covariance matrix values of refitted PV
   void performPvRefitCandProngs(SelectedCollisions::iterator const& collision,
                                 aod::BCsWithTimestamps const&,
-                                std::vector<int64_t> vecPvContributorGlobId,
-                                std::vector<o2::track::TrackParCov> vecPvContributorTrackParCov,
-                                std::vector<int64_t> vecCandPvContributorGlobId,
+                                std::vector<int64_t> const& vecPvContributorGlobId,
+                                std::vector<o2::track::TrackParCov> const& vecPvContributorTrackParCov,
+                                std::vector<int64_t> const& vecCandPvContributorGlobId,
                                 std::array<float, 3>& pvCoord,
                                 std::array<float, 6>& pvCovMatrix)
   {
-    std::vector<bool> vecPvRefitContributorUsed(vecPvContributorGlobId.size(), true);
+    auto& vecPvRefitContributorUsed = pvRefitWorkspace.contributorUsed;
 
     /// Prepare the vertex refitting
     // set the magnetic field from CCDB
@@ -1891,11 +1959,16 @@ struct HfTrackIndexSkimCreator {
     primVtx.setY(collision.posY());
     primVtx.setZ(collision.posZ());
     primVtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
-    // configure PVertexer
-    o2::vertexing::PVertexer vertexer;
-    o2::conf::ConfigurableParam::updateFromString("pvertexer.useMeanVertexConstraint=false"); /// remove diamond constraint (let's keep it at the moment...)
-    vertexer.init();
-    bool pvRefitDoable = vertexer.prepareVertexRefit(vecPvContributorTrackParCov, primVtx);
+    // configure PVertexer, only for the first candidate of the collision
+    if (!pvRefitWorkspace.isPrepared) {
+      auto& newVertexer = pvRefitWorkspace.vertexer.emplace();
+      o2::conf::ConfigurableParam::updateFromString("pvertexer.useMeanVertexConstraint=false"); /// remove diamond constraint (let's keep it at the moment...)
+      newVertexer.init();
+      pvRefitWorkspace.isRefitDoable = newVertexer.prepareVertexRefit(vecPvContributorTrackParCov, primVtx);
+      pvRefitWorkspace.isPrepared = true;
+    }
+    auto& vertexer = *pvRefitWorkspace.vertexer;
+    bool pvRefitDoable = pvRefitWorkspace.isRefitDoable;
     if (!pvRefitDoable) {
       LOG(info) << "Not enough tracks accepted for the refit";
       if (doprocess2And3ProngsWithPvRefit && fillHistograms) {
@@ -1952,7 +2025,7 @@ struct HfTrackIndexSkimCreator {
       }
 
       for (size_t i = 0; i < vecPvContributorGlobId.size(); i++) {
-        vecPvRefitContributorUsed[i] = true; /// restore the tracks for the next PV refitting (probably not necessary here)
+        vecPvRefitContributorUsed[i] = true; /// restore the tracks for the refit of the next candidate of the collision
       }
 
       if (recalcPvRefit) {
@@ -2004,6 +2077,17 @@ struct HfTrackIndexSkimCreator {
                       FilteredTrackAssocSel const&,
                       TTracks const& tracks)
   {
+    trackParCovCache.reset(tracks.size());
+
+    // hashes of the ML models, to let downstream tasks with the same models reuse the scores
+    if (applyMlForHfFilters && fillMlModelHashes) {
+      rowMlSkimModels(2u, static_cast<uint8_t>(hf_cand_2prong::DecayType::D0ToPiK), hfMlResponse2Prongs.getModelHash(0));
+      for (int iDecay3P{0}; iDecay3P < kN3ProngDecays; ++iDecay3P) {
+        if (hasMlModel3Prong[iDecay3P]) {
+          rowMlSkimModels(3u, static_cast<uint8_t>(iDecay3P), hfMlResponse3Prongs[iDecay3P].getModelHash(0));
+        }
+      }
+    }
 
     // can be added to run over limited collisions per file - for tesing purposes
     /*
@@ -2018,10 +2102,14 @@ struct HfTrackIndexSkimCreator {
 
     for (const auto& collision : collisions) {
 
-      /// retrieve PV contributors for the current collision
-      std::vector<int64_t> vecPvContributorGlobId{};
-      std::vector<o2::track::TrackParCov> vecPvContributorTrackParCov{};
-      std::vector<bool> vecPvRefitContributorUsed{};
+      /// retrieve PV contributors for the current collision, the buffers are reused from one collision to the next
+      auto& vecPvContributorGlobId = pvRefitWorkspace.contributorGlobId;
+      auto& vecPvContributorTrackParCov = pvRefitWorkspace.contributorTrackParCov;
+      auto& vecPvRefitContributorUsed = pvRefitWorkspace.contributorUsed;
+      vecPvContributorGlobId.clear();
+      vecPvContributorTrackParCov.clear();
+      vecPvRefitContributorUsed.clear();
+      pvRefitWorkspace.isPrepared = false;
       if constexpr (doPvRefit) {
         auto groupedTracksUnfiltered = tracks.sliceBy(tracksPerCollision, collision.globalIndex());
         const int nTrk = groupedTracksUnfiltered.size();
@@ -2034,7 +2122,7 @@ struct HfTrackIndexSkimCreator {
             continue;
           } else {
             vecPvContributorGlobId.push_back(trackUnfiltered.globalIndex());
-            vecPvContributorTrackParCov.push_back(getTrackParCov(trackUnfiltered));
+            vecPvContributorTrackParCov.push_back(trackParCovCache.get(trackUnfiltered));
             nContrib++;
             if (debugPvRefit) {
               LOG(info) << "---> a contributor! stuff saved";
@@ -2048,7 +2136,7 @@ struct HfTrackIndexSkimCreator {
             LOG(info) << "!!! Some problem here !!! vecPvContributorTrackParCov.size()= " << vecPvContributorTrackParCov.size() << ", nContrib=" << nContrib << ", collision.numContrib()" << collision.numContrib();
           }
         }
-        vecPvRefitContributorUsed = std::vector<bool>(vecPvContributorGlobId.size(), true);
+        vecPvRefitContributorUsed.assign(vecPvContributorGlobId.size(), true);
       }
 
       // auto centrality = collision.centV0M(); //FIXME add centrality when option for variations to the process function appears
@@ -2056,18 +2144,16 @@ struct HfTrackIndexSkimCreator {
       int n2ProngBit = BIT(kN2ProngDecays) - 1; // bit value for 2-prong candidates where each candidate is one bit and they are all set to 1
       int n3ProngBit = BIT(kN3ProngDecays) - 1; // bit value for 3-prong candidates where each candidate is one bit and they are all set to 1
 
-      std::array<std::vector<bool>, kN2ProngDecays> cutStatus2Prong;
-      std::array<std::vector<bool>, kN3ProngDecays> cutStatus3Prong;
       bool nCutStatus2ProngBit[kN2ProngDecays]; // bit value for selection status for each 2-prong candidate where each selection is one bit and they are all set to 1
       bool nCutStatus3ProngBit[kN3ProngDecays]; // bit value for selection status for each 3-prong candidate where each selection is one bit and they are all set to 1
 
       for (int iDecay2P = 0; iDecay2P < kN2ProngDecays; iDecay2P++) {
         nCutStatus2ProngBit[iDecay2P] = BIT(kNCuts2Prong[iDecay2P]) - 1;
-        cutStatus2Prong[iDecay2P] = std::vector<bool>(kNCuts2Prong[iDecay2P], true);
+        cutStatus2Prong[iDecay2P].assign(kNCuts2Prong[iDecay2P], true);
       }
       for (int iDecay3P = 0; iDecay3P < kN3ProngDecays; iDecay3P++) {
         nCutStatus3ProngBit[iDecay3P] = BIT(kNCuts3Prong[iDecay3P]) - 1;
-        cutStatus3Prong[iDecay3P] = std::vector<bool>(kNCuts3Prong[iDecay3P], true);
+        cutStatus3Prong[iDecay3P].assign(kNCuts3Prong[iDecay3P], true);
       }
 
       int whichHypo2Prong[kN2ProngDecays + 1]; // we also put D0 for D* in the last slot
@@ -2101,7 +2187,7 @@ struct HfTrackIndexSkimCreator {
         bool sel2ProngStatusPos = TESTBIT(isSelProngPos1, CandidateType::Cand2Prong);
         bool sel3ProngStatusPos1 = TESTBIT(isSelProngPos1, CandidateType::Cand3Prong);
 
-        auto trackParVarPos1 = getTrackParCov(trackPos1);
+        auto trackParVarPos1 = trackParCovCache.get(trackPos1);
         std::array<float, 3> pVecTrackPos1{trackPos1.pVector()};
         o2::gpu::gpustd::array<float, 2> dcaInfoPos1{trackPos1.dcaXY(), trackPos1.dcaZ()};
         if (thisCollId != trackPos1.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
@@ -2119,7 +2205,7 @@ struct HfTrackIndexSkimCreator {
           bool sel2ProngStatusNeg = TESTBIT(isSelProngNeg1, CandidateType::Cand2Prong);
           bool sel3ProngStatusNeg1 = TESTBIT(isSelProngNeg1, CandidateType::Cand3Prong);
 
-          auto trackParVarNeg1 = getTrackParCov(trackNeg1);
+          auto trackParVarNeg1 = trackParCovCache.get(trackNeg1);
           std::array<float, 3> pVecTrackNeg1{trackNeg1.pVector()};
           o2::gpu::gpustd::array<float, 2> dcaInfoNeg1{trackNeg1.dcaXY(), trackNeg1.dcaZ()};
           if (thisCollId != trackNeg1.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
@@ -2263,6 +2349,17 @@ struct HfTrackIndexSkimCreator {
                     rowProng2PVrefit(pvRefitCoord2Prong[0], pvRefitCoord2Prong[1], pvRefitCoord2Prong[2],
                                      pvRefitCovMatrix2Prong[0], pvRefitCovMatrix2Prong[1], pvRefitCovMatrix2Prong[2], pvRefitCovMatrix2Prong[3], pvRefitCovMatrix2Prong[4], pvRefitCovMatrix2Prong[5]);
                   }
+                  if (fillSecVtx) {
+                    // the vertex can be reused only if it was fitted with the tracks as stored in the AO2D
+                    const bool isSecVtxReusable = thisCollId == trackPos1.collisionId() && thisCollId == trackNeg1.collisionId();
+                    const auto covMatrixPca2 = df2.calcPCACovMatrixFlat();
+                    rowProng2SecVtx(isSecVtxReusable ? fitterSettingsHash : 0u,
+                                    secondaryVertex2[0], secondaryVertex2[1], secondaryVertex2[2],
+                                    covMatrixPca2[0], covMatrixPca2[1], covMatrixPca2[2], covMatrixPca2[3], covMatrixPca2[4], covMatrixPca2[5],
+                                    df2.getChi2AtPCACandidate(),
+                                    pvec0[0], pvec0[1], pvec0[2],
+                                    pvec1[0], pvec1[1], pvec1[2]);
+                  }
 
                   if (debug) {
                     int Prong2CutStatus[kN2ProngDecays];
@@ -2333,8 +2430,9 @@ struct HfTrackIndexSkimCreator {
           }
 
           if (do3Prong == 1 && is2ProngCandidateGoodFor3Prong) { // if 3 prongs are enabled and the first 2 tracks are selected for the 3-prong channels
-            // second loop over positive tracks
-            for (auto trackIndexPos2 = trackIndexPos1 + 1; trackIndexPos2 != groupedTrackIndicesPos1.end(); ++trackIndexPos2) {
+            // second loop over positive tracks, skipped if no 3-prong channel can reach its mass window with this pair
+            const bool isThirdPosReachable = debug || isThirdProngMassReachable(pVecTrackPos1, pVecTrackNeg1);
+            for (auto trackIndexPos2 = trackIndexPos1 + 1; isThirdPosReachable && trackIndexPos2 != groupedTrackIndicesPos1.end(); ++trackIndexPos2) {
 
               int isSelected3ProngCand = n3ProngBit;
               if (!TESTBIT(trackIndexPos2.isSelProng(), CandidateType::Cand3Prong)) { // continue immediately
@@ -2354,7 +2452,7 @@ struct HfTrackIndexSkimCreator {
               }
 
               auto trackPos2 = trackIndexPos2.template track_as<TTracks>();
-              auto trackParVarPos2 = getTrackParCov(trackPos2);
+              auto trackParVarPos2 = trackParCovCache.get(trackPos2);
               o2::gpu::gpustd::array<float, 2> dcaInfoPos2{trackPos2.dcaXY(), trackPos2.dcaZ()};
 
               // preselection of 3-prong candidates
@@ -2519,6 +2617,18 @@ struct HfTrackIndexSkimCreator {
                 rowProng3PVrefit(pvRefitCoord3Prong2Pos1Neg[0], pvRefitCoord3Prong2Pos1Neg[1], pvRefitCoord3Prong2Pos1Neg[2],
                                  pvRefitCovMatrix3Prong2Pos1Neg[0], pvRefitCovMatrix3Prong2Pos1Neg[1], pvRefitCovMatrix3Prong2Pos1Neg[2], pvRefitCovMatrix3Prong2Pos1Neg[3], pvRefitCovMatrix3Prong2Pos1Neg[4], pvRefitCovMatrix3Prong2Pos1Neg[5]);
               }
+              if (fillSecVtx) {
+                // the vertex can be reused only if it was fitted with the tracks as stored in the AO2D
+                const bool isSecVtxReusable = thisCollId == trackPos1.collisionId() && thisCollId == trackNeg1.collisionId() && thisCollId == trackPos2.collisionId();
+                const auto covMatrixPca3 = df3.calcPCACovMatrixFlat();
+                rowProng3SecVtx(isSecVtxReusable ? fitterSettingsHash : 0u,
+                                secondaryVertex3[0], secondaryVertex3[1], secondaryVertex3[2],
+                                covMatrixPca3[0], covMatrixPca3[1], covMatrixPca3[2], covMatrixPca3[3], covMatrixPca3[4], covMatrixPca3[5],
+                                df3.getChi2AtPCACandidate(),
+                                pvec0[0], pvec0[1], pvec0[2],
+                                pvec1[0], pvec1[1], pvec1[2],
+                                pvec2[0], pvec2[1], pvec2[2]);
+              }
 
               if (debug) {
                 int Prong3CutStatus[kN3ProngDecays];
@@ -2577,8 +2687,9 @@ struct HfTrackIndexSkimCreator {
               }
             }
 
-            // second loop over negative tracks
-            for (auto trackIndexNeg2 = trackIndexNeg1 + 1; trackIndexNeg2 != groupedTrackIndicesNeg1.end(); ++trackIndexNeg2) {
+            // second loop over negative tracks, skipped if no 3-prong channel can reach its mass window with this pair
+            const bool isThirdNegReachable = debug || isThirdProngMassReachable(pVecTrackNeg1, pVecTrackPos1);
+            for (auto trackIndexNeg2 = trackIndexNeg1 + 1; isThirdNegReachable && trackIndexNeg2 != groupedTrackIndicesNeg1.end(); ++trackIndexNeg2) {
 
               int isSelected3ProngCand = n3ProngBit;
               if (!TESTBIT(trackIndexNeg2.isSelProng(), CandidateType::Cand3Prong)) { // continue immediately
@@ -2598,7 +2709,7 @@ struct HfTrackIndexSkimCreator {
               }
 
               auto trackNeg2 = trackIndexNeg2.template track_as<TTracks>();
-              auto trackParVarNeg2 = getTrackParCov(trackNeg2);
+              auto trackParVarNeg2 = trackParCovCache.get(trackNeg2);
               o2::gpu::gpustd::array<float, 2> dcaInfoNeg2{trackNeg2.dcaXY(), trackNeg2.dcaZ()};
 
               // preselection of 3-prong candidates
@@ -2764,6 +2875,18 @@ struct HfTrackIndexSkimCreator {
                 rowProng3PVrefit(pvRefitCoord3Prong1Pos2Neg[0], pvRefitCoord3Prong1Pos2Neg[1], pvRefitCoord3Prong1Pos2Neg[2],
                                  pvRefitCovMatrix3Prong1Pos2Neg[0], pvRefitCovMatrix3Prong1Pos2Neg[1], pvRefitCovMatrix3Prong1Pos2Neg[2], pvRefitCovMatrix3Prong1Pos2Neg[3], pvRefitCovMatrix3Prong1Pos2Neg[4], pvRefitCovMatrix3Prong1Pos2Neg[5]);
               }
+              if (fillSecVtx) {
+                // the vertex can be reused only if it was fitted with the tracks as stored in the AO2D
+                const bool isSecVtxReusable = thisCollId == trackNeg1.collisionId() && thisCollId == trackPos1.collisionId() && thisCollId == trackNeg2.collisionId();
+                const auto covMatrixPca3 = df3.calcPCACovMatrixFlat();
+                rowProng3SecVtx(isSecVtxReusable ? fitterSettingsHash : 0u,
+                                secondaryVertex3[0], secondaryVertex3[1], secondaryVertex3[2],
+                                covMatrixPca3[0], covMatrixPca3[1], covMatrixPca3[2], covMatrixPca3[3], covMatrixPca3[4], covMatrixPca3[5],
+                                df3.getChi2AtPCACandidate(),
+                                pvec0[0], pvec0[1], pvec0[2],
+                                pvec1[0], pvec1[1], pvec1[2],
+                                pvec2[0], pvec2[1], pvec2[2]);
+              }
 
               if (debug) {
                 int Prong3CutStatus[kN3ProngDecays];
@@ -2834,7 +2957,7 @@ struct HfTrackIndexSkimCreator {
                 auto trackPos2 = trackIndexPos2.template track_as<TTracks>();
                 std::array<float, 3> pVecTrackPos2{trackPos2.pVector()};
                 if (thisCollId != trackPos2.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
-                  auto trackParVarPos2 = getTrackParCov(trackPos2);
+                  auto trackParVarPos2 = trackParCovCache.get(trackPos2);
                   o2::gpu::gpustd::array<float, 2> dcaInfoPos2{trackPos2.dcaXY(), trackPos2.dcaZ()};
                   o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarPos2, 2.f, noMatCorr, &dcaInfoPos2);
                   getPxPyPz(trackParVarPos2, pVecTrackPos2);
@@ -2871,7 +2994,7 @@ struct HfTrackIndexSkimCreator {
                 auto trackNeg2 = trackIndexNeg2.template track_as<TTracks>();
                 std::array<float, 3> pVecTrackNeg2{trackNeg2.pVector()};
                 if (thisCollId != trackNeg2.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
-                  auto trackParVarNeg2 = getTrackParCov(trackNeg2);
+                  auto trackParVarNeg2 = trackParCovCache.get(trackNeg2);
                   o2::gpu::gpustd::array<float, 2> dcaInfoNeg2{trackNeg2.dcaXY(), trackNeg2.dcaZ()};
                   o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarNeg2, 2.f, noMatCorr, &dcaInfoNeg2);
                   getPxPyPz(trackParVarNeg2, pVecTrackNeg2);
@@ -3051,7 +3174,7 @@ struct HfTrackIndexSkimCreatorCascades {
     ccdb->setURL(ccdbUrl);
     ccdb->setCaching(true);
     ccdb->setLocalObjectValidityChecking();
-    lut = o2::base::MatLayerCylSet::rectifyPtrFromFile(ccdb->get<o2::base::MatLayerCylSet>(ccdbPathLut));
+    lut = RunConditions::getSharedMatLut(ccdbPathLut);
     runNumber = 0;
 
     if (fillHistograms) {
@@ -3346,7 +3469,7 @@ struct HfTrackIndexSkimCreatorLfCascades {
     ccdb->setURL(ccdbUrl);
     ccdb->setCaching(true);
     ccdb->setLocalObjectValidityChecking();
-    lut = o2::base::MatLayerCylSet::rectifyPtrFromFile(ccdb->get<o2::base::MatLayerCylSet>(ccdbPathLut));
+    lut = RunConditions::getSharedMatLut(ccdbPathLut);
     runNumber = 0;
 
     if (fillHistograms) {
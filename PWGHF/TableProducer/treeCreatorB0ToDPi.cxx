@@ -23,10 +23,12 @@
 #include "PWGHF/Core/HfHelper.h"
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
+#include "PWGHF/Utils/utilsDerivedData.h"
 
 using namespace o2;
 using namespace o2::framework;
 using namespace o2::framework::expressions;
+using namespace o2::analysis::hf_derived;
 
 namespace o2::aod
 {
@@ -169,6 +171,8 @@ struct HfTreeCreatorB0ToDPi {
   Configurable<bool> fillOnlyBackground{"fillOnlyBackground", false, "Flag to fill derived tables with background for ML trainings"};
   Configurable<float> downSampleBkgFactor{"downSampleBkgFactor", 1., "Fraction of background candidates to keep for ML trainings"};
   Configurable<float> ptMaxForDownSample{"ptMaxForDownSample", 10., "Maximum pt for the application of the downsampling factor"};
+  Configurable<std::vector<float>> binsPtDownSampleBkg{"binsPtDownSampleBkg", std::vector<float>{}, "pT bin limits for the pT-dependent downsampling of background candidates (empty: downSampleBkgFactor in the full pT range)"};
+  Configurable<std::vector<float>> downSampleBkgFactorsPt{"downSampleBkgFactorsPt", std::vector<float>{}, "Fraction of background candidates to keep in each pT bin of binsPtDownSampleBkg"};
 
   HfHelper hfHelper;
 
@@ -300,8 +304,7 @@ struct HfTreeCreatorB0ToDPi {
     }
     for (const auto& candidate : candidates) {
       if (fillOnlyBackground) {
-        float pseudoRndm = candidate.ptProng1() * 1000. - (int64_t)(candidate.ptProng1() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
+        if (isDownSampled(candidate.ptProng1(), candidate.pt(), getDownSampleFactor(candidate.pt(), downSampleBkgFactor, binsPtDownSampleBkg.value, downSampleBkgFactorsPt.value), ptMaxForDownSample)) {
           continue;
         }
       }
@@ -340,8 +343,7 @@ struct HfTreeCreatorB0ToDPi {
         rowCandidateLite.reserve(recBg.size());
       }
       for (const auto& candidate : recBg) {
-        float pseudoRndm = candidate.ptProng1() * 1000. - (int64_t)(candidate.ptProng1() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
+        if (isDownSampled(candidate.ptProng1(), candidate.pt(), getDownSampleFactor(candidate.pt(), downSampleBkgFactor, binsPtDownSampleBkg.value, downSampleBkgFactorsPt.value), ptMaxForDownSample)) {
           continue;
         }
         auto prong1 = candidate.prong1_as<TracksWPid>();
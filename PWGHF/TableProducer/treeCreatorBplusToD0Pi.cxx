@@ -24,10 +24,12 @@
 #include "PWGHF/Core/HfHelper.h"
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
+#include "PWGHF/Utils/utilsDerivedData.h"
 
 using namespace o2;
 using namespace o2::framework;
 using namespace o2::framework::expressions;
+using namespace o2::analysis::hf_derived;
 
 namespace o2::aod
 {
@@ -224,6 +226,8 @@ struct HfTreeCreatorBplusToD0Pi {
   Configurable<bool> fillOnlyBackground{"fillOnlyBackground", false, "Flag to fill derived tables with background for ML trainings"};
   Configurable<float> downSampleBkgFactor{"downSampleBkgFactor", 1., "Fraction of background candidates to keep for ML trainings"};
   Configurable<float> ptMaxForDownSample{"ptMaxForDownSample", 10., "Maximum pt for the application of the downsampling factor"};
+  Configurable<std::vector<float>> binsPtDownSampleBkg{"binsPtDownSampleBkg", std::vector<float>{}, "pT bin limits for the pT-dependent downsampling of background candidates (empty: downSampleBkgFactor in the full pT range)"};
+  Configurable<std::vector<float>> downSampleBkgFactorsPt{"downSampleBkgFactorsPt", std::vector<float>{}, "Fraction of background candidates to keep in each pT bin of binsPtDownSampleBkg"};
 
   HfHelper hfHelper;
 
@@ -389,8 +393,7 @@ struct HfTreeCreatorBplusToD0Pi {
     }
     for (const auto& candidate : candidates) {
       if (fillOnlyBackground) {
-        float pseudoRndm = candidate.ptProng1() * 1000. - (int64_t)(candidate.ptProng1() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
+        if (isDownSampled(candidate.ptProng1(), candidate.pt(), getDownSampleFactor(candidate.pt(), downSampleBkgFactor, binsPtDownSampleBkg.value, downSampleBkgFactorsPt.value), ptMaxForDownSample)) {
           continue;
         }
       }
@@ -429,8 +432,7 @@ struct HfTreeCreatorBplusToD0Pi {
         rowCandidateLite.reserve(recBg.size());
       }
       for (const auto& candidate : recBg) {
-        float pseudoRndm = candidate.ptProng1() * 1000. - (int64_t)(candidate.ptProng1() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
+        if (isDownSampled(candidate.ptProng1(), candidate.pt(), getDownSampleFactor(candidate.pt(), downSampleBkgFactor, binsPtDownSampleBkg.value, downSampleBkgFactorsPt.value), ptMaxForDownSample)) {
           continue;
         }
         auto prong1 = candidate.prong1_as<TracksWPid>();
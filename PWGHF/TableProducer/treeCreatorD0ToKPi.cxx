@@ -24,10 +24,12 @@
 #include "PWGHF/Core/HfHelper.h"
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
+#include "PWGHF/Utils/utilsDerivedData.h"
 
 using namespace o2;
 using namespace o2::framework;
 using namespace o2::framework::expressions;
+using namespace o2::analysis::hf_derived;
 
 namespace o2::aod
 {
@@ -214,6 +216,8 @@ struct HfTreeCreatorD0ToKPi {
   // parameters for production of training samples
   Configurable<float> downSampleBkgFactor{"downSampleBkgFactor", 1., "Fraction of background candidates to keep for ML trainings"};
   Configurable<float> ptMaxForDownSample{"ptMaxForDownSample", 10., "Maximum pt for the application of the downsampling factor"};
+  Configurable<std::vector<float>> binsPtDownSampleBkg{"binsPtDownSampleBkg", std::vector<float>{}, "pT bin limits for the pT-dependent downsampling of background candidates (empty: downSampleBkgFactor in the full pT range)"};
+  Configurable<std::vector<float>> downSampleBkgFactorsPt{"downSampleBkgFactorsPt", std::vector<float>{}, "Fraction of background candidates to keep in each pT bin of binsPtDownSampleBkg"};
 
   HfHelper hfHelper;
 
@@ -376,11 +380,8 @@ struct HfTreeCreatorD0ToKPi {
       rowCandidateFull.reserve(candidates.size());
     }
     for (const auto& candidate : candidates) {
-      if (downSampleBkgFactor < 1.) {
-        float pseudoRndm = candidate.ptProng0() * 1000. - (int64_t)(candidate.ptProng0() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
-          continue;
-        }
+      if (isDownSampled(candidate.ptProng0(), candidate.pt(), getDownSampleFactor(candidate.pt(), downSampleBkgFactor, binsPtDownSampleBkg.value, downSampleBkgFactorsPt.value), ptMaxForDownSample)) {
+        continue;
       }
       auto prong0 = candidate.template prong0_as<TracksWPid>();
       auto prong1 = candidate.template prong1_as<TracksWPid>();
@@ -449,11 +450,8 @@ struct HfTreeCreatorD0ToKPi {
         if (TESTBIT(std::abs(candidate.flagMcMatchRec()), aod::hf_cand_2prong::DecayType::D0ToPiK)) {
           continue;
         }
-        if (downSampleBkgFactor < 1.) {
-          float pseudoRndm = candidate.ptProng0() * 1000. - (int64_t)(candidate.ptProng0() * 1000);
-          if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
-            continue;
-          }
+        if (isDownSampled(candidate.ptProng0(), candidate.pt(), getDownSampleFactor(candidate.pt(), downSampleBkgFactor, binsPtDownSampleBkg.value, downSampleBkgFactorsPt.value), ptMaxForDownSample)) {
+          continue;
         }
       }
       if constexpr (onlySig) {
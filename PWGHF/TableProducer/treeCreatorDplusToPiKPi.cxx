@@ -23,10 +23,12 @@
 #include "PWGHF/Core/HfHelper.h"
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
+#include "PWGHF/Utils/utilsDerivedData.h"
 
 using namespace o2;
 using namespace o2::framework;
 using namespace o2::framework::expressions;
+using namespace o2::analysis::hf_derived;
 
 namespace o2::aod
 {
@@ -239,6 +241,8 @@ struct HfTreeCreatorDplusToPiKPi {
   Configurable<bool> fillOnlyBackground{"fillOnlyBackground", false, "Flag to fill derived tables with background for ML trainings"};
   Configurable<float> downSampleBkgFactor{"downSampleBkgFactor", 1., "Fraction of background candidates to keep for ML trainings"};
   Configurable<float> ptMaxForDownSample{"ptMaxForDownSample", 10., "Maximum pt for the application of the downsampling factor"};
+  Configurable<std::vector<float>> binsPtDownSampleBkg{"binsPtDownSampleBkg", std::vector<float>{}, "pT bin limits for the pT-dependent downsampling of background candidates (empty: downSampleBkgFactor in the full pT range)"};
+  Configurable<std::vector<float>> downSampleBkgFactorsPt{"downSampleBkgFactorsPt", std::vector<float>{}, "Fraction of background candidates to keep in each pT bin of binsPtDownSampleBkg"};
 
   HfHelper hfHelper;
 
@@ -428,11 +432,8 @@ struct HfTreeCreatorDplusToPiKPi {
       rowCandidateFull.reserve(candidates.size());
     }
     for (const auto& candidate : candidates) {
-      if (downSampleBkgFactor < 1.) {
-        float pseudoRndm = candidate.ptProng0() * 1000. - (int64_t)(candidate.ptProng0() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
-          continue;
-        }
+      if (isDownSampled(candidate.ptProng0(), candidate.pt(), getDownSampleFactor(candidate.pt(), downSampleBkgFactor, binsPtDownSampleBkg.value, downSampleBkgFactorsPt.value), ptMaxForDownSample)) {
+        continue;
       }
       fillCandidateTable(candidate);
     }
@@ -469,11 +470,8 @@ struct HfTreeCreatorDplusToPiKPi {
         rowCandidateFull.reserve(reconstructedCandBkg.size());
       }
       for (const auto& candidate : reconstructedCandBkg) {
-        if (downSampleBkgFactor < 1.) {
-          float pseudoRndm = candidate.ptProng0() * 1000. - (int64_t)(candidate.ptProng0() * 1000);
-          if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
-            continue;
-          }
+        if (isDownSampled(candidate.ptProng0(), candidate.pt(), getDownSampleFactor(candidate.pt(), downSampleBkgFactor, binsPtDownSampleBkg.value, downSampleBkgFactorsPt.value), ptMaxForDownSample)) {
+          continue;
         }
         fillCandidateTable<true>(candidate);
       }
@@ -16,7 +16,12 @@
 #define PWGHF_UTILS_UTILSANALYSIS_H_
 
 #include <algorithm> // std::upper_bound
+#include <cmath>     // std::abs, std::floor
 #include <iterator>  // std::distance
+#include <string>
+#include <vector>
+
+#include "Framework/Logger.h"
 
 namespace o2::analysis
 {
@@ -37,6 +42,87 @@ int findBin(T1 const& binsPt, T2 value)
   return std::distance(binsPt->begin(), std::upper_bound(binsPt->begin(), binsPt->end(), value)) - 1;
 }
 
+/// \brief Cuts per pT bin prepared once from the configurables, for the selection of many candidates
+/// The pT bin is found with a direct computation for uniform bins and with a binary search otherwise,
+/// the cut values are read by column index, resolved once from the labels, instead of by label.
+class HfBinnedCuts
+{
+ public:
+  /// Copies the pT bins and the cut values
+  /// \param binsPt pT bin limits
+  /// \param cuts cut values per pT bin (LabeledArray with one row per pT bin)
+  template <typename TBins, typename TCuts>
+  void configure(TBins const& binsPt, TCuts const& cuts)
+  {
+    mBinsPt.assign(binsPt.begin(), binsPt.end());
+    mLabels = cuts.getLabelsCols();
+    mNCuts = mLabels.size();
+    const int nBins = static_cast<int>(mBinsPt.size()) - 1;
+    if (nBins < 1 || static_cast<int>(cuts.rows()) < nBins) {
+      LOGP(fatal, "Inconsistent configuration of {} pT bins and {} rows of cuts", nBins, cuts.rows());
+    }
+    mCuts.resize(nBins * mNCuts);
+    for (int iBin = 0; iBin < nBins; iBin++) {
+      for (std::size_t iCut = 0; iCut < mNCuts; iCut++) {
+        mCuts[iBin * mNCuts + iCut] = cuts.get(iBin, iCut);
+      }
+    }
+    // uniform binning if all the bin widths agree within the floating-point precision
+    mWidth = (mBinsPt.back() - mBinsPt.front()) / nBins;
+    mIsUniform = true;
+    for (int iBin = 0; iBin < nBins; iBin++) {
+      if (std::abs(mBinsPt[iBin + 1] - mBinsPt[iBin] - mWidth) > 1.e-6 * mWidth) {
+        mIsUniform = false;
+        break;
+      }
+    }
+  }
+
+  /// Index of a cut variable, to be retrieved once at initialisation
+  /// \param label label of the cut variable
+  int getCutIndex(const std::string& label) const
+  {
+    const auto it = std::find(mLabels.begin(), mLabels.end(), label);
+    if (it == mLabels.end()) {
+      LOGP(fatal, "Cut variable \"{}\" not found in the cut configuration", label);
+    }
+    return std::distance(mLabels.begin(), it);
+  }
+
+  /// Finds the pT bin, with the same convention as findBin
+  /// \return index of the pT bin, -1 if out of range
+  int findBin(double pt) const
+  {
+    if (pt < mBinsPt.front() || pt >= mBinsPt.back()) {
+      return -1;
+    }
+    if (!mIsUniform) {
+      return std::distance(mBinsPt.begin(), std::upper_bound(mBinsPt.begin(), mBinsPt.end(), pt)) - 1;
+    }
+    int iBin = std::min(static_cast<int>((pt - mBinsPt.front()) / mWidth), static_cast<int>(mBinsPt.size()) - 2);
+    // correct the rounding at the bin limits to match the binary search
+    if (pt < mBinsPt[iBin]) {
+      iBin--;
+    } else if (pt >= mBinsPt[iBin + 1]) {
+      iBin++;
+    }
+    return iBin;
+  }
+
+  /// Cut value in a pT bin
+  /// \param iBin index of the pT bin
+  /// \param iCut index of the cut variable (see getCutIndex)
+  double get(int iBin, int iCut) const { return mCuts[iBin * mNCuts + iCut]; }
+
+ private:
+  std::vector<double> mBinsPt;      ///< pT bin limits
+  std::vector<double> mCuts;        ///< cut values, grouped by pT bin
+  std::vector<std::string> mLabels; ///< labels of the cut variables
+  std::size_t mNCuts{0};            ///< number of cut variables
+  double mWidth{0.};                ///< bin width for uniform bins
+  bool mIsUniform{false};           ///< whether the pT bins are uniform
+};
+
 /// Single-track cut on DCAxy and DCAz
 /// \param binsPt pT bins
 /// \param cuts cut configuration
@@ -0,0 +1,121 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file utilsCorrelations.h
+/// \brief Utilities for the HF-hadron correlators
+
+#ifndef PWGHF_UTILS_UTILSCORRELATIONS_H_
+#define PWGHF_UTILS_UTILSCORRELATIONS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CommonConstants/MathConstants.h"
+
+namespace o2::analysis::hf_correlations
+{
+/// Returns deltaPhi value in range [-pi/2., 3.*pi/2], as RecoDecay::constrainAngle(phiAssoc - phiTrig, -pi/2) for angles in [0, 2pi)
+inline double getDeltaPhi(double phiAssoc, double phiTrig)
+{
+  double deltaPhi = phiAssoc - phiTrig;
+  deltaPhi = deltaPhi < -o2::constants::math::PIHalf ? deltaPhi + o2::constants::math::TwoPI : deltaPhi;
+  deltaPhi = deltaPhi >= -o2::constants::math::PIHalf + o2::constants::math::TwoPI ? deltaPhi - o2::constants::math::TwoPI : deltaPhi;
+  return deltaPhi;
+}
+
+/// \brief Associated tracks of a collision stored as structure of arrays
+/// The quantities needed per pair are read once per track instead of once per trigger candidate and track,
+/// and the angular differences to a trigger are computed for all tracks in one loop.
+class HfCorrelationTracks
+{
+ public:
+  /// Stores the tracks of a collision
+  /// \param tracks tracks with DCA
+  /// \param mass mass hypothesis for the energy of the tracks
+  template <typename TTracks>
+  void fill(TTracks const& tracks, float mass)
+  {
+    clear();
+    const std::size_t n = tracks.size();
+    mGlobalIndex.reserve(n);
+    mPt.reserve(n);
+    mEta.reserve(n);
+    mPhi.reserve(n);
+    mPVector.reserve(n);
+    mEnergy.reserve(n);
+    mDcaXY.reserve(n);
+    mDcaZ.reserve(n);
+    for (const auto& track : tracks) {
+      mGlobalIndex.push_back(track.globalIndex());
+      mPt.push_back(track.pt());
+      mEta.push_back(track.eta());
+      mPhi.push_back(track.phi());
+      mPVector.push_back(track.pVector());
+      mEnergy.push_back(track.energy(mass));
+      mDcaXY.push_back(track.dcaXY());
+      mDcaZ.push_back(track.dcaZ());
+    }
+  }
+
+  void clear()
+  {
+    mGlobalIndex.clear();
+    mPt.clear();
+    mEta.clear();
+    mPhi.clear();
+    mPVector.clear();
+    mEnergy.clear();
+    mDcaXY.clear();
+    mDcaZ.clear();
+  }
+
+  /// Computes the differences in phi (in [-pi/2, 3pi/2)) and eta of all the tracks to a trigger
+  void computeDeltas(float phiTrig, float etaTrig)
+  {
+    const std::size_t n = mPhi.size();
+    mDeltaPhi.resize(n);
+    mDeltaEta.resize(n);
+    for (std::size_t i = 0; i < n; i++) {
+      mDeltaPhi[i] = getDeltaPhi(mPhi[i], phiTrig);
+      mDeltaEta[i] = mEta[i] - etaTrig;
+    }
+  }
+
+  std::size_t size() const { return mGlobalIndex.size(); }
+  int64_t globalIndex(std::size_t i) const { return mGlobalIndex[i]; }
+  float pt(std::size_t i) const { return mPt[i]; }
+  float eta(std::size_t i) const { return mEta[i]; }
+  float phi(std::size_t i) const { return mPhi[i]; }
+  const std::array<float, 3>& pVector(std::size_t i) const { return mPVector[i]; }
+  float energy(std::size_t i) const { return mEnergy[i]; }
+  float dcaXY(std::size_t i) const { return mDcaXY[i]; }
+  float dcaZ(std::size_t i) const { return mDcaZ[i]; }
+  /// Differences to the trigger of the last computeDeltas
+  float deltaPhi(std::size_t i) const { return mDeltaPhi[i]; }
+  float deltaEta(std::size_t i) const { return mDeltaEta[i]; }
+
+ private:
+  std::vector<int64_t> mGlobalIndex;
+  std::vector<float> mPt;
+  std::vector<float> mEta;
+  std::vector<float> mPhi;
+  std::vector<std::array<float, 3>> mPVector;
+  std::vector<float> mEnergy; // energy with the mass hypothesis of fill
+  std::vector<float> mDcaXY;
+  std::vector<float> mDcaZ;
+  std::vector<float> mDeltaPhi;
+  std::vector<float> mDeltaEta;
+};
+} // namespace o2::analysis::hf_correlations
+
+#endif // PWGHF_UTILS_UTILSCORRELATIONS_H_
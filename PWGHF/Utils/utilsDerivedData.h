@@ -0,0 +1,102 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file utilsDerivedData.h
+/// \brief Utilities shared by the producers of HF derived data (derivedDataCreator*)
+
+#ifndef PWGHF_UTILS_UTILSDERIVEDDATA_H_
+#define PWGHF_UTILS_UTILSDERIVEDDATA_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Framework/Configurable.h"
+
+namespace o2::analysis::hf_derived
+{
+/// \brief Reserves rows of a derived table if the table is enabled
+/// \param table is the Produces object of the table
+/// \param enabled is the switch for filling the table
+/// \param size is the number of rows to reserve
+template <typename T>
+void reserveTable(T& table, const o2::framework::Configurable<bool>& enabled, const uint64_t size)
+{
+  if (enabled.value) {
+    table.reserve(size);
+  }
+}
+
+/// \brief Pseudo-random downsampling of background candidates, based on the decimals of the pT of the first prong
+/// \param ptProng0 is the pT of the first prong
+/// \param pt is the pT of the candidate
+/// \param downSampleFactor is the fraction of candidates to keep
+/// \param ptMaxForDownSample is the pT above which all the candidates are kept
+/// \return true if the candidate is rejected by the downsampling
+inline bool isDownSampled(float ptProng0, float pt, float downSampleFactor, float ptMaxForDownSample)
+{
+  if (downSampleFactor >= 1.) {
+    return false;
+  }
+  float pseudoRndm = ptProng0 * 1000. - (int64_t)(ptProng0 * 1000);
+  return pt < ptMaxForDownSample && pseudoRndm >= downSampleFactor;
+}
+
+/// \brief Fraction of background candidates to keep in the pT bin of a candidate
+/// \param pt is the pT of the candidate
+/// \param downSampleFactor is the fraction of candidates to keep outside the pT bins
+/// \param binsPt are the limits of the pT bins (an empty vector disables the pT dependence)
+/// \param downSampleFactorsPt are the fractions of candidates to keep in the pT bins
+/// \return fraction of candidates to keep
+inline float getDownSampleFactor(float pt, float downSampleFactor, const std::vector<float>& binsPt, const std::vector<float>& downSampleFactorsPt)
+{
+  if (binsPt.size() < 2 || downSampleFactorsPt.size() + 1 < binsPt.size() || pt < binsPt.front() || pt >= binsPt.back()) {
+    return downSampleFactor;
+  }
+  const auto iBin = std::upper_bound(binsPt.begin(), binsPt.end(), pt) - binsPt.begin() - 1;
+  return downSampleFactorsPt[iBin];
+}
+
+/// \brief Matching of the derived reconstructed collisions to the MC collisions of a dataframe
+/// The information is stored in dense vectors indexed by the global index of the MC collision,
+/// the memory is kept from one dataframe to the next.
+class McCollisionMatcher
+{
+ public:
+  /// Clears the matching for a dataframe with a given number of MC collisions
+  void reset(int64_t nMcCollisions)
+  {
+    const auto size = static_cast<std::size_t>(nMcCollisions);
+    for (std::size_t iMcColl = 0; iMcColl < std::min(size, mMatchedCollisions.size()); iMcColl++) {
+      mMatchedCollisions[iMcColl].clear();
+    }
+    mMatchedCollisions.resize(size);
+    mHasMcParticles.assign(size, false);
+  }
+
+  /// Adds the index of a derived reconstructed collision matched to an MC collision
+  void addMatchedCollision(int64_t mcCollisionId, int derivedCollisionIndex) { mMatchedCollisions[mcCollisionId].push_back(derivedCollisionIndex); }
+
+  /// Indices of the derived reconstructed collisions matched to an MC collision
+  const std::vector<int>& getMatchedCollisions(int64_t mcCollisionId) const { return mMatchedCollisions[mcCollisionId]; }
+
+  void setHasMcParticles(int64_t mcCollisionId, bool hasMcParticles) { mHasMcParticles[mcCollisionId] = hasMcParticles; }
+  /// Whether an MC collision has HF particles
+  bool hasMcParticles(int64_t mcCollisionId) const { return mcCollisionId >= 0 && static_cast<std::size_t>(mcCollisionId) < mHasMcParticles.size() && mHasMcParticles[mcCollisionId]; }
+
+ private:
+  std::vector<std::vector<int>> mMatchedCollisions; ///< indices of derived reconstructed collisions matched to each MC collision
+  std::vector<bool> mHasMcParticles;                ///< flags for MC collisions with HF particles
+};
+} // namespace o2::analysis::hf_derived
+
+#endif // PWGHF_UTILS_UTILSDERIVEDDATA_H_
@@ -16,6 +16,9 @@
 #ifndef PWGHF_UTILS_UTILSTRKCANDHF_H_
 #define PWGHF_UTILS_UTILSTRKCANDHF_H_
 
+#include <cstddef>
+#include <cstdint>
+
 #include "Framework/HistogramSpec.h"
 
 namespace o2::hf_trkcandsel
@@ -41,6 +44,27 @@ void setLabelHistoCands(Histo& hCandidates)
   hCandidates->GetXaxis()->SetBinLabel(SVFitting::Fail + 1, "Run-time error in secondary vertexing");
 }
 
+/// @brief Fingerprint of the DCAFitterN settings, to check whether a secondary vertex fitted in another task can be reused
+/// \return a non-zero value, identical for identical settings
+inline uint32_t getDcaFitterSettingsHash(bool propagateToPCA, bool useAbsDCA, bool useWeightedFinalPCA, double maxR, double maxDZIni, double minParamChange, double minRelChi2Change)
+{
+  uint32_t hash = 2166136261u; // FNV-1a
+  auto addToHash = [&hash](const auto& value) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+    for (std::size_t iByte = 0; iByte < sizeof(value); iByte++) {
+      hash = (hash ^ bytes[iByte]) * 16777619u;
+    }
+  };
+  addToHash(propagateToPCA);
+  addToHash(useAbsDCA);
+  addToHash(useWeightedFinalPCA);
+  addToHash(maxR);
+  addToHash(maxDZIni);
+  addToHash(minParamChange);
+  addToHash(minRelChi2Change);
+  return hash == 0 ? 1 : hash;
+}
+
 } // namespace o2::hf_trkcandsel
 
 #endif // PWGHF_UTILS_UTILSTRKCANDHF_H_
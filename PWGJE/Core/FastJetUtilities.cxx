@@ -11,10 +11,47 @@
 
 #include "FastJetUtilities.h"
 
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+// Pool of the user infos of the constituents, kept for the lifetime of the worker
+// An entry is reused once the pool holds the only reference to it, i.e. once the constituents of the previous collisions are gone,
+// so that no allocation is needed in steady state
+class FastJetUserInfoPool
+{
+ public:
+  const fastjet::SharedPtr<fastjet::PseudoJet::UserInfoBase>& get(int status, int index)
+  {
+    if (mNext < mEntries.size() && mEntries[mNext].sharedPtr.use_count() == 1) {
+      auto& entry = mEntries[mNext];
+      entry.userInfo->setStatus(status);
+      entry.userInfo->setIndex(index);
+      mNext = (mNext + 1) % mEntries.size();
+      return entry.sharedPtr;
+    }
+    // the pool is empty or its next entry is still in use: a new entry is added
+    auto* userInfo = new fastjetutilities::fastjet_user_info(status, index);
+    mEntries.push_back({userInfo, fastjet::SharedPtr<fastjet::PseudoJet::UserInfoBase>(userInfo)});
+    return mEntries.back().sharedPtr;
+  }
+
+ private:
+  struct Entry {
+    fastjetutilities::fastjet_user_info* userInfo;                  // owned by sharedPtr
+    fastjet::SharedPtr<fastjet::PseudoJet::UserInfoBase> sharedPtr; // reference held by the pool
+  };
+  std::vector<Entry> mEntries;
+  std::size_t mNext = 0;
+};
+
+FastJetUserInfoPool userInfoPool;
+} // namespace
+
 void fastjetutilities::setFastJetUserInfo(std::vector<fastjet::PseudoJet>& constituents, int index, int status)
 {
-  fastjet_user_info* user_info = new fastjet_user_info(status, index); // FIXME: can setting this as a pointer be avoided?
-  constituents.back().set_user_info(user_info);
+  constituents.back().set_user_info_shared_ptr(userInfoPool.get(status, index));
   if (index != -99999999) { // FIXME: in principle needed for constituent subtraction, particularly when clusters are added to the subtraction. However since the HF particle is not subtracted then we dont need to check for it in this manner
     int i = index;
     if (status == static_cast<int>(JetConstituentStatus::track)) {
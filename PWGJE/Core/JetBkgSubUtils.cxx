@@ -12,7 +12,10 @@
 // jet finder task
 //
 // Author: Hadi Hassan, Universiy of Jväskylä, hadi.hassan@cern.ch
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <numeric>
 #include <tuple>
 #include "Framework/Logger.h"
 #include "Common/Core/RecoDecay.h"
@@ -52,8 +55,45 @@ std::tuple<double, double> JetBkgSubUtils::estimateRhoAreaMedian(const std::vect
   // cluster the kT jets
   fastjet::ClusterSequenceArea clusterSeq(inputParticles, jetDefBkg, areaDefBkg);
 
+  auto [rho, rhoM, occupancyFactor] = getRhoAreaMedian(clusterSeq, clusterSeq.inclusive_jets());
+  if (doSparseSub) {
+    rho *= occupancyFactor;
+    rhoM *= occupancyFactor;
+  }
+
+  return std::make_tuple(rho, rhoM);
+}
+
+std::tuple<double, double, double, double, double, double> JetBkgSubUtils::estimateRhos(const std::vector<fastjet::PseudoJet>& inputParticles)
+{
+  JetBkgSubUtils::initialise();
+
+  if (inputParticles.size() == 0) {
+    return std::make_tuple(0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+  }
+
+  // cluster the kT jets once for all the estimators
+  fastjet::ClusterSequenceArea clusterSeq(inputParticles, jetDefBkg, areaDefBkg);
+  std::vector<fastjet::PseudoJet> jets = clusterSeq.inclusive_jets();
+
+  auto [rho, rhoM, occupancyFactor] = getRhoAreaMedian(clusterSeq, jets);
+
+  // the perpendicular cones are built around the leading physical kT jet
+  std::vector<fastjet::PseudoJet> physicalJets;
+  for (const auto& jet : jets) {
+    if (!clusterSeq.is_pure_ghost(jet)) {
+      physicalJets.push_back(jet);
+    }
+  }
+  auto [rhoPerpCone, rhoMPerpCone] = estimateRhoPerpCone(inputParticles, physicalJets);
+
+  return std::make_tuple(rho, rhoM, rho * occupancyFactor, rhoM * occupancyFactor, rhoPerpCone, rhoMPerpCone);
+}
+
+std::tuple<double, double, double> JetBkgSubUtils::getRhoAreaMedian(const fastjet::ClusterSequenceArea& clusterSeq, const std::vector<fastjet::PseudoJet>& jets) const
+{
   // select jets in detector acceptance
-  std::vector<fastjet::PseudoJet> alljets = selRho(clusterSeq.inclusive_jets());
+  std::vector<fastjet::PseudoJet> alljets = selRho(jets);
 
   double totaljetAreaPhys(0), totalAreaCovered(0);
   std::vector<double> rhovector;
@@ -81,14 +121,10 @@ std::tuple<double, double> JetBkgSubUtils::estimateRhoAreaMedian(const std::vect
     rhoM = TMath::Median<double>(rhoMdvector.size(), rhoMdvector.data());
   }
 
-  if (doSparseSub) {
-    // calculate The ocupancy factor, which the ratio of covered area / total area
-    double occupancyFactor = totalAreaCovered > 0 ? totaljetAreaPhys / totalAreaCovered : 1.;
-    rho *= occupancyFactor;
-    rhoM *= occupancyFactor;
-  }
+  // calculate The ocupancy factor, which the ratio of covered area / total area
+  double occupancyFactor = totalAreaCovered > 0 ? totaljetAreaPhys / totalAreaCovered : 1.;
 
-  return std::make_tuple(rho, rhoM);
+  return std::make_tuple(rho, rhoM, occupancyFactor);
 }
 
 std::tuple<double, double> JetBkgSubUtils::estimateRhoPerpCone(const std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<fastjet::PseudoJet>& jets)
@@ -176,6 +212,124 @@ std::vector<fastjet::PseudoJet> JetBkgSubUtils::doEventConstSub(std::vector<fast
   return constituentSub.subtract_event(inputParticles, maxEtaEvent);
 }
 
+std::vector<fastjet::PseudoJet> JetBkgSubUtils::doEventConstSubNative(const std::vector<fastjet::PseudoJet>& inputParticles, double rhoParam, double rhoMParam)
+{
+  JetBkgSubUtils::initialise();
+
+  // ghosts at the centres of a regular rapidity-phi grid covering |y| < maxEtaEvent, each one carrying the background of its cell
+  const double ghostSize = std::sqrt(ghostAreaSpec.ghost_area());
+  const int nGhostsRap = std::max(1, static_cast<int>(2. * maxEtaEvent / ghostSize + 0.5));
+  const int nGhostsPhi = std::max(1, static_cast<int>(2. * M_PI / ghostSize + 0.5));
+  const double ghostStepRap = 2. * maxEtaEvent / nGhostsRap;
+  const double ghostStepPhi = 2. * M_PI / nGhostsPhi;
+  const double ghostCellArea = ghostStepRap * ghostStepPhi;
+  std::vector<double> ghostPt(nGhostsRap * nGhostsPhi, rhoParam * ghostCellArea);
+  std::vector<double> ghostMd(doRhoMassSub ? ghostPt.size() : 0, rhoMParam * ghostCellArea);
+
+  // particles to be subtracted, stored per component
+  std::vector<double> particlePt, particleRap, particlePhi, particleMd;
+  for (const auto& particle : inputParticles) {
+    if (std::abs(particle.eta()) >= maxEtaEvent) {
+      continue;
+    }
+    particlePt.push_back(particle.pt());
+    particleRap.push_back(particle.rap());
+    particlePhi.push_back(particle.phi());
+    if (doRhoMassSub) {
+      particleMd.push_back(std::sqrt(particle.m2() + particle.pt2()) - particle.m());
+    }
+  }
+  const int nParticles = particlePt.size();
+
+  // particle-ghost pairs within the maximum distance, only the ghosts of the neighbouring cells are tested
+  const double maxDistance2 = constSubRMax * constSubRMax;
+  const int nCellsRap = static_cast<int>(std::ceil(constSubRMax / ghostStepRap));
+  const int nCellsPhi = std::min(static_cast<int>(std::ceil(constSubRMax / ghostStepPhi)), (nGhostsPhi - 1) / 2);
+  std::vector<double> pairDistance;
+  std::vector<int> pairParticle, pairGhost;
+  for (int iParticle = 0; iParticle < nParticles; iParticle++) {
+    const double ptFactor = std::abs(constSubAlpha) > 1e-5 ? std::pow(particlePt[iParticle], 2. * constSubAlpha) : 1.;
+    const int cellRap = static_cast<int>(std::floor((particleRap[iParticle] + maxEtaEvent) / ghostStepRap));
+    const int cellPhi = static_cast<int>(std::floor(particlePhi[iParticle] / ghostStepPhi));
+    for (int iRap = std::max(0, cellRap - nCellsRap); iRap <= std::min(nGhostsRap - 1, cellRap + nCellsRap); iRap++) {
+      const double dRap = particleRap[iParticle] - (-maxEtaEvent + (iRap + 0.5) * ghostStepRap);
+      for (int iPhiUnwrapped = cellPhi - nCellsPhi; iPhiUnwrapped <= cellPhi + nCellsPhi; iPhiUnwrapped++) {
+        const int iPhi = ((iPhiUnwrapped % nGhostsPhi) + nGhostsPhi) % nGhostsPhi;
+        const double dPhi = RecoDecay::constrainAngle<double, double>(particlePhi[iParticle] - (iPhi + 0.5) * ghostStepPhi, -M_PI);
+        const double distance2 = dRap * dRap + dPhi * dPhi;
+        if (distance2 <= maxDistance2) {
+          pairDistance.push_back(distance2 * ptFactor);
+          pairParticle.push_back(iParticle);
+          pairGhost.push_back(iRap * nGhostsPhi + iPhi);
+        }
+      }
+    }
+  }
+
+  // bucketed sort of the pairs by distance: a bucket is only sorted when it is reached,
+  // within a bucket the pairs keep the order in which they were found for equal distances
+  const std::size_t nPairs = pairDistance.size();
+  const double maxPairDistance = nPairs ? *std::max_element(pairDistance.begin(), pairDistance.end()) : 0.;
+  const std::size_t nBuckets = std::max<std::size_t>(1, nPairs / 64);
+  std::vector<std::size_t> bucketStart(nBuckets + 1, 0);
+  std::vector<std::size_t> pairBucket(nPairs);
+  for (std::size_t iPair = 0; iPair < nPairs; iPair++) {
+    pairBucket[iPair] = maxPairDistance > 0. ? std::min(nBuckets - 1, static_cast<std::size_t>(pairDistance[iPair] / maxPairDistance * nBuckets)) : 0;
+    bucketStart[pairBucket[iPair] + 1]++;
+  }
+  std::partial_sum(bucketStart.begin(), bucketStart.end(), bucketStart.begin());
+  std::vector<std::size_t> pairsSorted(nPairs);
+  std::vector<std::size_t> bucketFill(bucketStart.begin(), bucketStart.end() - 1);
+  for (std::size_t iPair = 0; iPair < nPairs; iPair++) {
+    pairsSorted[bucketFill[pairBucket[iPair]]++] = iPair;
+  }
+
+  // subtraction, from the closest pairs to the farthest ones, the loop stops once the pT of the ghosts or of the particles is exhausted
+  std::size_t nGhostsLeft = rhoParam > 0. ? ghostPt.size() : 0;
+  int nParticlesLeft = nParticles;
+  for (std::size_t iBucket = 0; iBucket < nBuckets && ((nGhostsLeft > 0 && nParticlesLeft > 0) || doRhoMassSub); iBucket++) {
+    const auto first = pairsSorted.begin() + bucketStart[iBucket];
+    const auto last = pairsSorted.begin() + bucketStart[iBucket + 1];
+    std::sort(first, last, [&pairDistance](std::size_t a, std::size_t b) { return pairDistance[a] < pairDistance[b] || (pairDistance[a] == pairDistance[b] && a < b); });
+    for (auto iPairSorted = first; iPairSorted != last; ++iPairSorted) {
+      const int iParticle = pairParticle[*iPairSorted];
+      const int iGhost = pairGhost[*iPairSorted];
+      if (ghostPt[iGhost] > 0. && particlePt[iParticle] > 0.) {
+        if (particlePt[iParticle] > ghostPt[iGhost]) {
+          particlePt[iParticle] -= ghostPt[iGhost];
+          ghostPt[iGhost] = 0.;
+          nGhostsLeft--;
+        } else {
+          ghostPt[iGhost] -= particlePt[iParticle];
+          particlePt[iParticle] = 0.;
+          nParticlesLeft--;
+        }
+      }
+      if (doRhoMassSub && ghostMd[iGhost] > 0. && particleMd[iParticle] > 0.) {
+        const double subtractedMd = std::min(ghostMd[iGhost], particleMd[iParticle]);
+        ghostMd[iGhost] -= subtractedMd;
+        particleMd[iParticle] -= subtractedMd;
+      }
+    }
+  }
+
+  // subtracted particles, with the rapidity and phi of the input ones
+  std::vector<fastjet::PseudoJet> subtractedParticles;
+  for (int iParticle = 0; iParticle < nParticles; iParticle++) {
+    if (particlePt[iParticle] <= 0.) {
+      continue;
+    }
+    double mass = 0.;
+    if (doRhoMassSub && particleMd[iParticle] > 0.) { // mass for which mT - m is the subtracted value
+      mass = std::max(0., (particlePt[iParticle] * particlePt[iParticle] - particleMd[iParticle] * particleMd[iParticle]) / (2. * particleMd[iParticle]));
+    }
+    fastjet::PseudoJet subtractedParticle;
+    subtractedParticle.reset_PtYPhiM(particlePt[iParticle], particleRap[iParticle], particlePhi[iParticle], mass);
+    subtractedParticles.push_back(subtractedParticle);
+  }
+  return subtractedParticles;
+}
+
 std::vector<fastjet::PseudoJet> JetBkgSubUtils::doJetConstSub(std::vector<fastjet::PseudoJet>& jets, double rhoParam, double rhoMParam)
 {
   JetBkgSubUtils::initialise();
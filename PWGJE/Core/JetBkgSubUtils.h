@@ -75,6 +75,11 @@ class JetBkgSubUtils
   /// @return Rho, RhoM the underlying event density
   std::tuple<double, double> estimateRhoAreaMedian(const std::vector<fastjet::PseudoJet>& inputParticles, bool doSparseSub);
 
+  /// @brief Method for estimating the jet background density with several estimators from a single kT clustering
+  /// @param inputParticles (all particles in the event)
+  /// @return Rho, RhoM with the median method, with the sparse method and with the perpendicular cone method around the leading kT jet
+  std::tuple<double, double, double, double, double, double> estimateRhos(const std::vector<fastjet::PseudoJet>& inputParticles);
+
   /// @brief Background estimator using the perpendicular cone method
   /// @param inputParticles
   /// @param jets (all jets in the event)
@@ -95,6 +100,15 @@ class JetBkgSubUtils
   /// @return inputParticles, a vector of background subtracted input particles
   std::vector<fastjet::PseudoJet> doEventConstSub(std::vector<fastjet::PseudoJet>& inputParticles, double rhoParam, double rhoMParam);
 
+  /// @brief native implementation of the event-wise constituent subtraction, with the ghosts on a regular rapidity-phi grid
+  /// @note the particle-ghost pairs are restricted to the neighbouring grid cells within constSubRMax and are sorted by buckets of distance,
+  ///       the subtraction stops once the ghosts or the particles are exhausted
+  /// @param inputParticles (all the tracks/clusters/particles in the event)
+  /// @param rhoParam the underlying evvent density vs pT (to be set)
+  /// @param rhoParam the underlying evvent density vs jet mass (to be set)
+  /// @return inputParticles, a vector of background subtracted input particles
+  std::vector<fastjet::PseudoJet> doEventConstSubNative(const std::vector<fastjet::PseudoJet>& inputParticles, double rhoParam, double rhoMParam);
+
   /// @brief method that subtracts the background from jets using the jet-wise constituent subtractor
   /// @param jets (all jets in the event)
   /// @param rhoParam the underlying evvent density vs pT (to be set)
@@ -144,6 +158,10 @@ class JetBkgSubUtils
   // Calculate the jet mass
   double getMd(fastjet::PseudoJet jet) const;
 
+ private:
+  /// @brief Median of the pT and mass densities of the kT jets, and occupancy factor of the physical jets
+  std::tuple<double, double, double> getRhoAreaMedian(const fastjet::ClusterSequenceArea& clusterSeq, const std::vector<fastjet::PseudoJet>& jets) const;
+
  protected:
   float jetBkgR = 0.2;
   float bkgEtaMin = -0.9;
@@ -15,6 +15,9 @@
 /// \author Jochen Klein <jochen.klein@cern.ch>
 
 #include "PWGJE/Core/JetFinder.h"
+
+#include <algorithm>
+
 #include "Framework/Logger.h"
 
 /// Sets the jet finding parameters
@@ -36,9 +39,16 @@ void JetFinder::setParams()
 
   // selGhosts =fastjet::SelectorRapRange(ghostEtaMin,ghostEtaMax) && fastjet::SelectorPhiRange(phiMin,phiMax);
   // ghostAreaSpec=fastjet::GhostedAreaSpec(selGhosts,ghostRepeatN,ghostArea,gridScatter,ktScatter,ghostktMean);
-  ghostAreaSpec = fastjet::GhostedAreaSpec(ghostEtaMax, ghostRepeatN, ghostArea, gridScatter, ktScatter, ghostktMean); // the first argument is rapidity not pseudorapidity, to be checked
   jetDef = fastjet::JetDefinition(algorithm, jetR, recombScheme, strategy);
-  areaDef = fastjet::AreaDefinition(areaType, ghostAreaSpec);
+  if (areaType == fastjet::voronoi_area) { // the areas are computed from the Voronoi cells of the particles, no ghosts are needed
+    areaDef = fastjet::AreaDefinition(fastjet::VoronoiAreaSpec(voronoiEffectiveRFact));
+  } else {
+    ghostAreaSpec = fastjet::GhostedAreaSpec(ghostEtaMax, ghostRepeatN, ghostArea, gridScatter, ktScatter, ghostktMean); // the first argument is rapidity not pseudorapidity, to be checked
+    if (ghostSeed >= 0) { // the generator is reset before each clustering, so that all the events use the same ghosts
+      ghostAreaSpec.set_random_status(std::vector<int>{ghostSeed, ghostSeed + 1});
+    }
+    areaDef = fastjet::AreaDefinition(areaType, ghostAreaSpec);
+  }
   selJets = fastjet::SelectorPtRange(jetPtMin, jetPtMax) && fastjet::SelectorEtaRange(jetEtaMin, jetEtaMax) && fastjet::SelectorPhiRange(jetPhiMin, jetPhiMax);
 }
 
@@ -60,3 +70,30 @@ fastjet::ClusterSequenceArea JetFinder::findJets(std::vector<fastjet::PseudoJet>
   }
   return clusterSeq;
 }
+
+/// Performs jet finding for several jet radii with a single clustering at the largest radius
+/// \note only for the Cambridge/Aachen algorithm, whose clustering history does not depend on the radius:
+///       the jets of radius R are the exclusive jets of the clustering at Rmax with dcut = (R/Rmax)^2
+/// \param inputParticles vector of input particles/tracks
+/// \param jetRs jet radii
+/// \param jets vectors of jets to be filled, one per radius
+/// \return ClusterSequenceArea object needed to access constituents
+fastjet::ClusterSequenceArea JetFinder::findJetsMultiR(std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<double>& jetRs, std::vector<std::vector<fastjet::PseudoJet>>& jets)
+{
+  if (algorithm != fastjet::cambridge_algorithm || isReclustering) {
+    LOGF(fatal, "Jet finding for several radii with a single clustering is only possible with the Cambridge/Aachen algorithm");
+  }
+  const double jetRMax = *std::max_element(jetRs.begin(), jetRs.end());
+  jetR = jetRMax;
+  setParams();
+  fastjet::ClusterSequenceArea clusterSeq(inputParticles, jetDef, areaDef);
+  jets.resize(jetRs.size());
+  for (std::size_t iR = 0; iR < jetRs.size(); iR++) {
+    jetR = jetRs[iR];
+    setParams(); // jet selection of this radius
+    jets[iR] = clusterSeq.exclusive_jets(jetR * jetR / (jetRMax * jetRMax));
+    jets[iR] = selJets(jets[iR]);
+    jets[iR] = fastjet::sorted_by_pt(jets[iR]);
+  }
+  return clusterSeq;
+}
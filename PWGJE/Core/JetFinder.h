@@ -69,6 +69,9 @@ class JetFinder
   double ghostktMean = 1.e-100;
   float gridScatter = 1.;
   float ktScatter = .1;
+  int ghostSeed = -1;                 // seed of the ghost generation, the same ghosts are used for all the events if >= 0
+  double voronoiEffectiveRFact = 1.0; // effective radius factor of the Voronoi area
+
 
   bool isReclustering = false;
   bool isTriggering = false;
@@ -76,7 +79,7 @@ class JetFinder
   fastjet::JetAlgorithm algorithm = fastjet::antikt_algorithm;
   fastjet::RecombinationScheme recombScheme = fastjet::E_scheme;
   fastjet::Strategy strategy = fastjet::Best;
-  fastjet::AreaType areaType = fastjet::active_area;
+  fastjet::AreaType areaType = fastjet::active_area; // active_area_explicit_ghosts, passive_area or voronoi_area (no ghosts) also possible
   fastjet::GhostedAreaSpec ghostAreaSpec;
   fastjet::JetDefinition jetDef;
   fastjet::AreaDefinition areaDef;
@@ -93,6 +96,15 @@ class JetFinder
   /// \return ClusterSequenceArea object needed to access constituents
   fastjet::ClusterSequenceArea findJets(std::vector<fastjet::PseudoJet>& inputParticles, std::vector<fastjet::PseudoJet>& jets); // ideally find a way of passing the cluster sequence as a reeference
 
+  /// Performs jet finding for several jet radii with a single clustering at the largest radius
+  /// \note only for the Cambridge/Aachen algorithm, whose clustering history does not depend on the radius:
+  ///       the jets of radius R are the exclusive jets of the clustering at Rmax with dcut = (R/Rmax)^2
+  /// \param inputParticles vector of input particles/tracks
+  /// \param jetRs jet radii
+  /// \param jets vectors of jets to be filled, one per radius
+  /// \return ClusterSequenceArea object needed to access constituents
+  fastjet::ClusterSequenceArea findJetsMultiR(std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<double>& jetRs, std::vector<std::vector<fastjet::PseudoJet>>& jets);
+
  private:
   ClassDefNV(JetFinder, 1);
 };
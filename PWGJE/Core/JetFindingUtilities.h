@@ -23,6 +23,7 @@
 #include <optional>
 #include <cmath>
 #include <memory>
+#include <unordered_map>
 
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -231,8 +232,84 @@ bool analyseV0s(std::vector<fastjet::PseudoJet>& inputParticles, T const& v0s, f
   }
 }
 
+/**
+ * Fills the jet tables with the jets of a jet radius
+ *
+ * @param jets jets found with the radius R
+ * @param R jet radius
+ * @param jetAreaFractionMin minimum jet area as a fraction of the area of a cone of radius R
+ * @param collision the collision within which jets are being found
+ * @param jetsTable output table of jets
+ * @param constituentsTable output table of jet constituents
+ * @param doCandidateJetFinding set whether only jets containing a HF candidate are saved
+ */
+template <typename T, typename U, typename V>
+void fillJetTables(std::vector<fastjet::PseudoJet> const& jets, double R, float jetAreaFractionMin, T const& collision, U& jetsTable, V& constituentsTable, std::shared_ptr<THn> thnSparseJet, bool fillThnSparse, bool doCandidateJetFinding)
+{
+  // constituent indices, reused for all the jets
+  std::vector<int> tracks;
+  std::vector<int> cands;
+  std::vector<int> clusters;
+  for (const auto& jet : jets) {
+    if (jet.has_area() && jet.area() < jetAreaFractionMin * M_PI * R * R) {
+      continue;
+    }
+    if (fillThnSparse) {
+      thnSparseJet->Fill(R, jet.pt(), jet.eta(), jet.phi()); // important for normalisation in V0Jet analyses to store all jets, including those that aren't V0s
+    }
+    bool isCandidateJet = false;
+    if (doCandidateJetFinding) {
+      for (const auto& constituent : jet.constituents()) {
+        auto constituentStatus = constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus();
+        if (constituentStatus == static_cast<int>(JetConstituentStatus::candidateHF)) { // note currently we cannot run V0 and HF in the same jet. If we ever need to we can seperate the loops
+          isCandidateJet = true;
+          break;
+        }
+      }
+      if (!isCandidateJet) {
+        continue;
+      }
+    }
+    tracks.clear();
+    cands.clear();
+    clusters.clear();
+    jetsTable(collision.globalIndex(), jet.pt(), jet.eta(), jet.phi(),
+              jet.E(), jet.rapidity(), jet.m(), jet.has_area() ? jet.area() : 0., std::round(R * 100));
+    for (const auto& constituent : sorted_by_pt(jet.constituents())) {
+      if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::track)) {
+        tracks.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
+      }
+      if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::cluster)) {
+        clusters.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
+      }
+      if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::candidateHF)) {
+        cands.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
+      }
+    }
+    constituentsTable(jetsTable.lastIndex(), tracks, clusters, cands);
+  }
+}
+
+/**
+ * Returns the scalar sum of the pT of the input particles
+ * The pT of a jet, with any recombination scheme, is at most the scalar sum of the pT of its constituents, so this is an
+ * upper bound of the pT of all the jets of the event and can be used to skip the clustering of the events in which no
+ * jet can pass a trigger threshold.
+ *
+ * @param inputParticles fastjet container
+ */
+inline double getScalarPtSum(std::vector<fastjet::PseudoJet> const& inputParticles)
+{
+  double ptSum = 0.;
+  for (const auto& particle : inputParticles) {
+    ptSum += particle.pt();
+  }
+  return ptSum;
+}
+
 /**
  * Performs jet finding and fills jet tables
+ * For the Cambridge/Aachen algorithm, the jets of all the radii are obtained from a single clustering at the largest radius.
  *
  * @param jetFinder JetFinder object which carries jet finding parameters
  * @param inputParticles fastjet container
@@ -243,54 +320,69 @@ bool analyseV0s(std::vector<fastjet::PseudoJet>& inputParticles, T const& v0s, f
  * @param doHFJetFinding set whether only jets containing a HF candidate are saved
  */
 template <typename T, typename U, typename V>
-void findJets(JetFinder& jetFinder, std::vector<fastjet::PseudoJet>& inputParticles, float jetPtMin, float jetPtMax, std::vector<double> jetRadius, float jetAreaFractionMin, T const& collision, U& jetsTable, V& constituentsTable, std::shared_ptr<THn> thnSparseJet, bool fillThnSparse, bool doCandidateJetFinding = false)
+void findJets(JetFinder& jetFinder, std::vector<fastjet::PseudoJet>& inputParticles, float jetPtMin, float jetPtMax, std::vector<double> const& jetRadius, float jetAreaFractionMin, T const& collision, U& jetsTable, V& constituentsTable, std::shared_ptr<THn> thnSparseJet, bool fillThnSparse, bool doCandidateJetFinding = false)
 {
-  auto jetRValues = static_cast<std::vector<double>>(jetRadius);
   jetFinder.jetPtMin = jetPtMin;
   jetFinder.jetPtMax = jetPtMax;
-  for (auto R : jetRValues) {
+  if (jetRadius.size() > 1 && jetFinder.algorithm == fastjet::cambridge_algorithm && !jetFinder.isReclustering) {
+    std::vector<std::vector<fastjet::PseudoJet>> jetsPerR;
+    fastjet::ClusterSequenceArea clusterSeq(jetFinder.findJetsMultiR(inputParticles, jetRadius, jetsPerR));
+    for (std::size_t iR = 0; iR < jetRadius.size(); iR++) {
+      fillJetTables(jetsPerR[iR], jetRadius[iR], jetAreaFractionMin, collision, jetsTable, constituentsTable, thnSparseJet, fillThnSparse, doCandidateJetFinding);
+    }
+    return;
+  }
+  for (auto R : jetRadius) {
     jetFinder.jetR = R;
     std::vector<fastjet::PseudoJet> jets;
     fastjet::ClusterSequenceArea clusterSeq(jetFinder.findJets(inputParticles, jets));
-    for (const auto& jet : jets) {
-      if (jet.has_area() && jet.area() < jetAreaFractionMin * M_PI * R * R) {
-        continue;
-      }
-      if (fillThnSparse) {
-        thnSparseJet->Fill(R, jet.pt(), jet.eta(), jet.phi()); // important for normalisation in V0Jet analyses to store all jets, including those that aren't V0s
-      }
-      bool isCandidateJet = false;
-      if (doCandidateJetFinding) {
-        for (const auto& constituent : jet.constituents()) {
-          auto constituentStatus = constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus();
-          if (constituentStatus == static_cast<int>(JetConstituentStatus::candidateHF)) { // note currently we cannot run V0 and HF in the same jet. If we ever need to we can seperate the loops
-            isCandidateJet = true;
-            break;
-          }
-        }
-        if (!isCandidateJet) {
-          continue;
-        }
-      }
-      std::vector<int> tracks;
-      std::vector<int> cands;
-      std::vector<int> clusters;
-      jetsTable(collision.globalIndex(), jet.pt(), jet.eta(), jet.phi(),
-                jet.E(), jet.rapidity(), jet.m(), jet.has_area() ? jet.area() : 0., std::round(R * 100));
-      for (const auto& constituent : sorted_by_pt(jet.constituents())) {
-        if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::track)) {
-          tracks.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
-        }
-        if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::cluster)) {
-          clusters.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
-        }
-        if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::candidateHF)) {
-          cands.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
-        }
-      }
-      constituentsTable(jetsTable.lastIndex(), tracks, clusters, cands);
+    fillJetTables(jets, R, jetAreaFractionMin, collision, jetsTable, constituentsTable, thnSparseJet, fillThnSparse, doCandidateJetFinding);
+  }
+}
+
+/**
+ * Charge and mass of a particle species, as read from the pdg database
+ */
+struct PdgProperties {
+  bool isKnown = false; // the pdg code is in the database
+  double charge = -1.0; // charge in units of |e|/3
+  double mass = 0.0;    // mass in GeV/c^2
+};
+
+/**
+ * Returns the charge and mass of a particle species from a cache of the pdg database, filled lazily
+ * The cache is shared by all the jet finders of the process, the frequent pdg codes are stored in a dense array
+ *
+ * @param pdgCode pdg code of the particle
+ * @param pdgDatabase database of pdg codes
+ */
+inline const PdgProperties& getPdgProperties(int pdgCode, o2::framework::Service<o2::framework::O2DatabasePDG>& pdgDatabase)
+{
+  constexpr int pdgCodeMaxDense = 10000;
+  static std::vector<std::optional<PdgProperties>> cacheDense(2 * pdgCodeMaxDense + 1);
+  static std::unordered_map<int, PdgProperties> cacheSparse;
+  auto find = [&pdgDatabase, pdgCode]() {
+    PdgProperties properties;
+    auto pdgParticle = pdgDatabase->GetParticle(pdgCode);
+    if (pdgParticle) {
+      properties.isKnown = true;
+      properties.charge = std::abs(pdgParticle->Charge());
+      properties.mass = pdgParticle->Mass();
+    }
+    return properties;
+  };
+  if (std::abs(pdgCode) <= pdgCodeMaxDense) {
+    auto& entry = cacheDense[pdgCode + pdgCodeMaxDense];
+    if (!entry) {
+      entry = find();
     }
+    return *entry;
   }
+  auto entry = cacheSparse.find(pdgCode);
+  if (entry == cacheSparse.end()) {
+    entry = cacheSparse.emplace(pdgCode, find()).first;
+  }
+  return entry->second;
 }
 
 /**
@@ -319,8 +411,11 @@ void analyseParticles(std::vector<fastjet::PseudoJet>& inputParticles, std::stri
     if (isinf(particle.eta())) {
       continue;
     }
-    auto pdgParticle = pdgDatabase->GetParticle(particle.pdgCode());
-    auto pdgCharge = pdgParticle ? std::abs(pdgParticle->Charge()) : -1.0;
+    const auto& pdgProperties = getPdgProperties(particle.pdgCode(), pdgDatabase);
+    if (!pdgProperties.isKnown) { // the mass hypothesis is needed
+      continue;
+    }
+    auto pdgCharge = pdgProperties.charge;
     if (jetTypeParticleLevel == static_cast<int>(JetType::charged) && pdgCharge < 3.0) {
       continue;
     }
@@ -353,7 +448,7 @@ void analyseParticles(std::vector<fastjet::PseudoJet>& inputParticles, std::stri
         }
       }
     }
-    fastjetutilities::fillTracks(particle, inputParticles, particle.globalIndex(), static_cast<int>(JetConstituentStatus::track), pdgParticle->Mass());
+    fastjetutilities::fillTracks(particle, inputParticles, particle.globalIndex(), static_cast<int>(JetConstituentStatus::track), pdgProperties.mass);
   }
 }
 
@@ -26,6 +26,7 @@
 #include <optional>
 #include <tuple>
 #include <algorithm>
+#include <utility>
 
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -42,181 +43,78 @@
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
 
+#include "PWGJE/Core/JetUtilities.h"
 #include "PWGJE/DataModel/Jet.h"
 
 namespace jetmatchingutilities
 {
 
 /**
- * Duplicates jets around the phi boundary which are within the matching distance.
- *
- * NOTE: Assumes, but does not validate, that 0 <= phi < 2pi.
- *
- * @param jetsPhi Jets phi
- * @param jetsEta Jets eta
- * @param maxMatchingDistance Maximum matching distance. Only duplicate jets within this distance of the boundary.
- */
-template <typename T>
-std::tuple<std::vector<std::size_t>, std::vector<T>, std::vector<T>> DuplicateJetsAroundPhiBoundary(
-  std::vector<T>& jetsPhi,
-  std::vector<T>& jetsEta,
-  double maxMatchingDistance,
-  // TODO: Remove additional margin after additional testing.
-  double additionalMargin = 0.05)
-{
-  const std::size_t nJets = jetsPhi.size();
-  std::vector<std::size_t> jetsMapToJetIndex(nJets);
-  // We need to keep track of the map from the duplicated vector to the existing jets.
-  // To start, we fill this map (practically, it maps from vector index to an index, so we
-  // just use a standard vector) with the existing jet indices, which range from 0..nJets.
-  std::iota(jetsMapToJetIndex.begin(), jetsMapToJetIndex.end(), 0);
-
-  // The full duplicated jets will be stored in a new vector to avoid disturbing the input data.
-  std::vector<T> jetsPhiComparison(jetsPhi);
-  std::vector<T> jetsEtaComparison(jetsEta);
-
-  // Duplicate the jets
-  // When a jet is outside of the desired phi range, we make a copy of the jet, shifting it by 2pi
-  // as necessary. The eta value is copied directly, as is the index of the original jet, so we can
-  // map from index in duplicated data -> index in original collection.
-  // NOTE: Assumes, but does not validate, that 0 <= phi < 2pi.
-  for (std::size_t i = 0; i < nJets; i++) {
-    // Handle lower edge
-    if (jetsPhi[i] <= (maxMatchingDistance + additionalMargin)) {
-      jetsPhiComparison.emplace_back(jetsPhi[i] + 2 * M_PI);
-      jetsEtaComparison.emplace_back(jetsEta[i]);
-      jetsMapToJetIndex.emplace_back(jetsMapToJetIndex[i]);
-    }
-    // Handle upper edge
-    if (jetsPhi[i] >= (2 * M_PI - (maxMatchingDistance + additionalMargin))) {
-      jetsPhiComparison.emplace_back(jetsPhi[i] - 2 * M_PI);
-      jetsEtaComparison.emplace_back(jetsEta[i]);
-      jetsMapToJetIndex.emplace_back(jetsMapToJetIndex[i]);
-    }
-  }
-
-  return {jetsMapToJetIndex, jetsPhiComparison, jetsEtaComparison};
-}
-
-/**
- * Implementation of geometrical jet matching.
+ * Geometrical jet matching.
  *
- * Jets are required to match uniquely - namely: base <-> tag. Only one direction of matching isn't enough.
- * Unless special conditions are required, it's better to use `MatchJetsGeometrically`, which has an
- * easier to use interface.
+ * Match jets in the "base" collection with those in the "tag" collection. Jets are matched within
+ * the provided matching distance. Jets are required to match uniquely - namely: base <-> tag.
+ * Only one direction of matching isn't enough.
  *
- * NOTE: The vectors for matching could all be const, except that SetData() doesn't take a const.
+ * If no unique match was found for a jet, an index of -1 is stored.
  *
  * @param jetsBasePhi Base jet collection phi.
  * @param jetsBaseEta Base jet collection eta.
- * @param jetsBasePhiForMatching Base jet collection phi to use for matching.
- * @param jetsBaseEtaForMatching Base jet collection eta to use for matching.
- * @param jetMapBaseToJetIndex Base jet collection index map from duplicated jets to original jets.
  * @param jetsTagPhi Tag jet collection phi.
  * @param jetsTagEta Tag jet collection eta.
- * @param jetsTagPhiForMatching Tag jet collection phi to use for matching.
- * @param jetsTagEtaForMatching Tag jet collection eta to use for matching.
- * @param jetMapTagToJetIndex Tag jet collection index map from duplicated jets to original jets.
  * @param maxMatchingDistance Maximum matching distance.
  *
  * @returns (Base to tag index map, tag to base index map) for uniquely matched jets.
  */
 template <typename T>
-std::tuple<std::vector<int>, std::vector<int>> MatchJetsGeometricallyImpl(
+std::tuple<std::vector<int>, std::vector<int>> MatchJetsGeometrically(
   const std::vector<T>& jetsBasePhi,
   const std::vector<T>& jetsBaseEta,
-  std::vector<T> jetsBasePhiForMatching,
-  std::vector<T> jetsBaseEtaForMatching,
-  const std::vector<std::size_t> jetMapBaseToJetIndex,
   const std::vector<T>& jetsTagPhi,
   const std::vector<T>& jetsTagEta,
-  std::vector<T> jetsTagPhiForMatching,
-  std::vector<T> jetsTagEtaForMatching,
-  const std::vector<std::size_t> jetMapTagToJetIndex,
   double maxMatchingDistance)
 {
   // Validation
-  // If no jets in either collection, then return immediately.
   const std::size_t nJetsBase = jetsBaseEta.size();
   const std::size_t nJetsTag = jetsTagEta.size();
   if (!(nJetsBase && nJetsTag)) {
+    // There are no jets, so nothing to be done.
     return std::make_tuple(std::vector<int>(nJetsBase, -1), std::vector<int>(nJetsTag, -1));
   }
-  // Require that the comparison vectors are greater than or equal to the standard collections.
-  if (jetsBasePhiForMatching.size() < jetsBasePhi.size()) {
-    throw std::invalid_argument("Base collection phi for matching is smaller than the input base collection.");
-  }
-  if (jetsBaseEtaForMatching.size() < jetsBaseEta.size()) {
-    throw std::invalid_argument("Base collection eta for matching is smaller than the input base collection.");
-  }
-  if (jetsTagPhiForMatching.size() < jetsTagPhi.size()) {
-    throw std::invalid_argument("Tag collection phi for matching is smaller than the input tag collection.");
+  // Input sizes must match
+  if (jetsBasePhi.size() != jetsBaseEta.size()) {
+    throw std::invalid_argument("Base collection eta and phi sizes don't match. Check the inputs.");
   }
-  if (jetsTagEtaForMatching.size() < jetsTagEta.size()) {
-    throw std::invalid_argument("Tag collection eta for matching is smaller than the input tag collection.");
+  if (jetsTagPhi.size() != jetsTagEta.size()) {
+    throw std::invalid_argument("Tag collection eta and phi sizes don't match. Check the inputs.");
   }
 
-  // Build the KD-trees using vectors
-  // We build two trees:
-  // treeBase, which contains the base collection.
-  // treeTag, which contains the tag collection.
-  // The trees are built to match in two dimensions (eta, phi)
-  TKDTree<int, T> treeBase(jetsBaseEtaForMatching.size(), 2, 1), treeTag(jetsTagEtaForMatching.size(), 2, 1);
-  // By utilizing SetData, we can avoid having to copy the data again.
-  treeBase.SetData(0, jetsBaseEtaForMatching.data());
-  treeBase.SetData(1, jetsBasePhiForMatching.data());
-  treeBase.Build();
-  treeTag.SetData(0, jetsTagEtaForMatching.data());
-  treeTag.SetData(1, jetsTagPhiForMatching.data());
-  treeTag.Build();
+  // Build the eta-phi grids, which handle the periodicity of phi, one per collection, kept from one call to the next.
+  thread_local jetutilities::EtaPhiGrid<T> gridBase, gridTag;
+  gridBase.build(jetsBaseEta, jetsBasePhi, maxMatchingDistance);
+  gridTag.build(jetsTagEta, jetsTagPhi, maxMatchingDistance);
 
   // Storage for the jet matching indices.
   // matchIndexTag maps from the base index to the tag index.
   // matchBaseTag maps from the tag index to the base index.
   std::vector<int> matchIndexTag(nJetsBase, -1), matchIndexBase(nJetsTag, -1);
+  T distance;
 
   // Find the tag jet closest to each base jet.
   for (std::size_t iBase = 0; iBase < nJetsBase; iBase++) {
-    Double_t point[2] = {jetsBaseEta[iBase], jetsBasePhi[iBase]};
-    Int_t index(-1);
-    Double_t distance(-1);
-    treeTag.FindNearestNeighbors(point, 1, &index, &distance);
-    // test whether indices are matching:
-    if (index >= 0 && distance < maxMatchingDistance) {
-      LOG(debug) << "Found closest tag jet for " << iBase << " with match index " << index << " and distance " << distance << "\n";
-      matchIndexTag[iBase] = index;
+    if (gridTag.findNearestNeighbours(jetsBaseEta[iBase], jetsBasePhi[iBase], 1, &matchIndexTag[iBase], &distance) > 0) {
+      LOG(debug) << "Found closest tag jet for " << iBase << " with match index " << matchIndexTag[iBase] << " and distance " << distance << "\n";
     } else {
-      LOG(debug) << "Closest tag jet not found for " << iBase << ", distance to closest " << distance << "\n";
+      LOG(debug) << "Closest tag jet not found for " << iBase << "\n";
     }
   }
 
   // Find the base jet closest to each tag jet
   for (std::size_t iTag = 0; iTag < nJetsTag; iTag++) {
-    Double_t point[2] = {jetsTagEta[iTag], jetsTagPhi[iTag]};
-    Int_t index(-1);
-    Double_t distance(-1);
-    treeBase.FindNearestNeighbors(point, 1, &index, &distance);
-    if (index >= 0 && distance < maxMatchingDistance) {
-      LOG(debug) << "Found closest base jet for " << iTag << " with match index " << index << " and distance " << distance << std::endl;
-      matchIndexBase[iTag] = index;
+    if (gridBase.findNearestNeighbours(jetsTagEta[iTag], jetsTagPhi[iTag], 1, &matchIndexBase[iTag], &distance) > 0) {
+      LOG(debug) << "Found closest base jet for " << iTag << " with match index " << matchIndexBase[iTag] << " and distance " << distance << "\n";
     } else {
-      LOG(debug) << "Closest tag jet not found for " << iTag << ", distance to closest " << distance << "\n";
-    }
-  }
-
-  // Convert indices in the duplicated jet vectors into the original jet indices.
-  // First for the base -> tag map.
-  for (auto& v : matchIndexTag) {
-    // If it's -1, it means that it didn't find a matching jet.
-    // We have to explicitly check for it here because it would be an invalid index.
-    if (v != -1) {
-      v = jetMapTagToJetIndex[v];
-    }
-  }
-  // Then for the index -> base map.
-  for (auto& v : matchIndexBase) {
-    if (v != -1) {
-      v = jetMapBaseToJetIndex[v];
+      LOG(debug) << "Closest base jet not found for " << iTag << "\n";
     }
   }
 
@@ -227,10 +125,6 @@ std::tuple<std::vector<int>, std::vector<int>> MatchJetsGeometricallyImpl(
   std::vector<int> tagToBaseMap(nJetsTag, -1);
   LOG(debug) << "Starting true jet loop: nbase(" << nJetsBase << "), ntag(" << nJetsTag << ")\n";
   for (std::size_t iBase = 0; iBase < nJetsBase; iBase++) {
-    LOG(debug) << "base jet " << iBase << ": match index in tag jet container " << matchIndexTag[iBase] << "\n";
-    if (matchIndexTag[iBase] > -1) {
-      LOG(debug) << "tag jet " << matchIndexTag[iBase] << ": matched base jet " << matchIndexBase[matchIndexTag[iBase]] << "\n";
-    }
     if (matchIndexTag[iBase] > -1 && matchIndexBase[matchIndexTag[iBase]] == static_cast<int>(iBase)) {
       LOG(debug) << "True match! base index: " << iBase << ", tag index: " << matchIndexTag[iBase] << "\n";
       baseToTagMap[iBase] = matchIndexTag[iBase];
@@ -241,61 +135,6 @@ std::tuple<std::vector<int>, std::vector<int>> MatchJetsGeometricallyImpl(
   return std::make_tuple(baseToTagMap, tagToBaseMap);
 }
 
-/**
- * Geometrical jet matching.
- *
- * Match jets in the "base" collection with those in the "tag" collection. Jets are matched within
- * the provided matching distance. Jets are required to match uniquely - namely: base <-> tag.
- * Only one direction of matching isn't enough.
- *
- * If no unique match was found for a jet, an index of -1 is stored.
- *
- * @param jetsBasePhi Base jet collection phi.
- * @param jetsBaseEta Base jet collection eta.
- * @param jetsTagPhi Tag jet collection phi.
- * @param jetsTagEta Tag jet collection eta.
- * @param maxMatchingDistance Maximum matching distance.
- *
- * @returns (Base to tag index map, tag to base index map) for uniquely matched jets.
- */
-template <typename T>
-std::tuple<std::vector<int>, std::vector<int>> MatchJetsGeometrically(
-  std::vector<T> jetsBasePhi,
-  std::vector<T> jetsBaseEta,
-  std::vector<T> jetsTagPhi,
-  std::vector<T> jetsTagEta,
-  double maxMatchingDistance)
-{
-  // Validation
-  const std::size_t nJetsBase = jetsBaseEta.size();
-  const std::size_t nJetsTag = jetsTagEta.size();
-  if (!(nJetsBase && nJetsTag)) {
-    // There are no jets, so nothing to be done.
-    return std::make_tuple(std::vector<int>(nJetsBase, -1), std::vector<int>(nJetsTag, -1));
-  }
-  // Input sizes must match
-  if (jetsBasePhi.size() != jetsBaseEta.size()) {
-    throw std::invalid_argument("Base collection eta and phi sizes don't match. Check the inputs.");
-  }
-  if (jetsTagPhi.size() != jetsTagEta.size()) {
-    throw std::invalid_argument("Tag collection eta and phi sizes don't match. Check the inputs.");
-  }
-
-  // To perform matching with periodic boundary conditions (ie. phi) with a KDTree, we need
-  // to duplicate data up to maxMatchingDistance in phi because phi is periodic.
-  // NOTE: vectors are modified in place to avoid copies.
-  auto&& [jetMapBaseToJetIndex, jetsBasePhiComparison, jetsBaseEtaComparison] = DuplicateJetsAroundPhiBoundary(jetsBasePhi, jetsBaseEta, maxMatchingDistance);
-  auto&& [jetMapTagToJetIndex, jetsTagPhiComparison, jetsTagEtaComparison] = DuplicateJetsAroundPhiBoundary(jetsTagPhi, jetsTagEta, maxMatchingDistance);
-
-  // Finally, perform the actual matching.
-  auto&& [baseToTagMap, tagToBaseMap] = MatchJetsGeometricallyImpl(
-    jetsBasePhi, jetsBaseEta, jetsBasePhiComparison, jetsBaseEtaComparison, jetMapBaseToJetIndex,
-    jetsTagPhi, jetsTagEta, jetsTagPhiComparison, jetsTagEtaComparison, jetMapTagToJetIndex,
-    maxMatchingDistance);
-
-  return std::make_tuple(baseToTagMap, tagToBaseMap);
-}
-
 template <typename T, typename U>
 void MatchGeo(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingGeo, std::vector<std::vector<int>>& tagToBaseMatchingGeo, float maxMatchingDistance)
 {
@@ -409,61 +248,77 @@ auto constexpr getConstituentId(T const& track)
   }
 }
 
-template <bool isEMCAL, bool jetsBaseIsMc, bool jetsTagIsMc, typename T, typename U, typename V, typename O>
-float getPtSum(T const& tracksBase, U const& clustersBase, V const& tracksTag, O const& clustersTag)
+// Constituents of a jet for the pT matching, with the ids through which they are shared with the jets of the other collection
+struct JetPtMatchingConstituents {
+  std::vector<std::pair<int, int>> trackIds;   // (id, index in trackPts) of the tracks, sorted by id
+  std::vector<float> trackPts;                 // pT of the tracks
+  std::vector<std::pair<int, int>> clusterIds; // (MC particle id, index in clusterPts) of the clusters, sorted by id, a cluster appears once per particle
+  std::vector<float> clusterPts;               // pT of the clusters
+};
+
+// fills the constituents of a jet for the pT matching, the clusters are only used to match detector-level jets with MC-level jets
+template <bool isEMCAL, bool jetIsMc, bool otherJetIsMc, typename T, typename U>
+void fillPtMatchingConstituents(T const& tracks, U const& clusters, JetPtMatchingConstituents& constituents)
 {
-  std::vector<int> particleTracker;
-  float ptSum = 0.;
-  for (const auto& trackBase : tracksBase) {
-    auto trackBaseId = getConstituentId<jetsTagIsMc>(trackBase);
-    for (const auto& trackTag : tracksTag) {
-      auto trackTagId = getConstituentId<jetsBaseIsMc>(trackTag);
-      if (trackBaseId != -1 && trackBaseId == trackTagId) {
-        ptSum += trackBase.pt();
-        if constexpr (jetsBaseIsMc) {
-          particleTracker.push_back(trackBaseId);
-        }
-        break;
-      }
+  for (const auto& track : tracks) {
+    auto trackId = getConstituentId<otherJetIsMc>(track);
+    if (trackId != -1) {
+      constituents.trackIds.emplace_back(trackId, constituents.trackPts.size());
+      constituents.trackPts.push_back(track.pt());
     }
   }
-  if constexpr (isEMCAL) {
-    if constexpr (jetsTagIsMc) {
-      for (const auto& clusterBase : clustersBase) {
-        for (const auto& clusterBaseParticleId : clusterBase.mcParticleIds()) {
-          bool isClusterMatched = false;
-          for (const auto& trackTag : tracksTag) {
-            if (clusterBaseParticleId != -1 && clusterBaseParticleId == trackTag.globalIndex()) {
-              ptSum += clusterBase.energy() / std::cosh(clusterBase.eta());
-              isClusterMatched = true;
-              break;
-            }
-          }
-          if (isClusterMatched) {
-            break;
-          }
+  std::sort(constituents.trackIds.begin(), constituents.trackIds.end());
+  if constexpr (isEMCAL && !jetIsMc && otherJetIsMc) {
+    for (const auto& cluster : clusters) {
+      for (const auto& clusterParticleId : cluster.mcParticleIds()) {
+        if (clusterParticleId != -1) {
+          constituents.clusterIds.emplace_back(clusterParticleId, constituents.clusterPts.size());
         }
       }
+      constituents.clusterPts.push_back(cluster.energy() / std::cosh(cluster.eta()));
     }
-    if constexpr (jetsBaseIsMc) {
-      for (const auto& trackBase : tracksBase) {
-        if (std::find(particleTracker.begin(), particleTracker.end(), trackBase.globalIndex()) != particleTracker.end()) {
-          continue;
-        }
-        auto trackBaseId = trackBase.globalIndex();
-        for (const auto& clusterTag : clustersTag) {
-          bool isClusterMatched = false;
-          for (const auto& clusterTagParticleId : clusterTag.mcParticleIds()) {
-            if (trackBaseId != -1 && trackBaseId == clusterTagParticleId) {
-              ptSum += trackBase.pt();
-              isClusterMatched = true;
-              break;
-            }
-          }
-          if (isClusterMatched) {
-            break;
-          }
-        }
+    std::sort(constituents.clusterIds.begin(), constituents.clusterIds.end());
+  }
+}
+
+// flags the entries of a list of (id, index) sorted by id whose id is in another sorted list, with a single merge pass
+inline void flagSharedIds(const std::vector<std::pair<int, int>>& ids, const std::vector<std::pair<int, int>>& otherIds, std::vector<bool>& isShared)
+{
+  auto otherId = otherIds.begin();
+  for (const auto& [id, index] : ids) {
+    while (otherId != otherIds.end() && otherId->first < id) {
+      ++otherId;
+    }
+    if (otherId == otherIds.end()) {
+      break;
+    }
+    if (otherId->first == id) {
+      isShared[index] = true;
+    }
+  }
+}
+
+// pT of the base jet constituents shared with the tag jet
+template <bool isEMCAL, bool jetsBaseIsMc, bool jetsTagIsMc>
+float getPtSum(const JetPtMatchingConstituents& constituentsBase, const JetPtMatchingConstituents& constituentsTag, std::vector<bool>& isShared)
+{
+  float ptSum = 0.;
+  isShared.assign(constituentsBase.trackPts.size(), false);
+  flagSharedIds(constituentsBase.trackIds, constituentsTag.trackIds, isShared);
+  if constexpr (isEMCAL && jetsBaseIsMc) {
+    flagSharedIds(constituentsBase.trackIds, constituentsTag.clusterIds, isShared);
+  }
+  for (std::size_t iTrack = 0; iTrack < constituentsBase.trackPts.size(); iTrack++) {
+    if (isShared[iTrack]) {
+      ptSum += constituentsBase.trackPts[iTrack];
+    }
+  }
+  if constexpr (isEMCAL && jetsTagIsMc) {
+    isShared.assign(constituentsBase.clusterPts.size(), false);
+    flagSharedIds(constituentsBase.clusterIds, constituentsTag.trackIds, isShared);
+    for (std::size_t iCluster = 0; iCluster < constituentsBase.clusterPts.size(); iCluster++) {
+      if (isShared[iCluster]) {
+        ptSum += constituentsBase.clusterPts[iCluster];
       }
     }
   }
@@ -483,25 +338,58 @@ auto getConstituents(T const& jet, U const& /*constituents*/)
 template <bool jetsBaseIsMc, bool jetsTagIsMc, typename T, typename U, typename V, typename M, typename N, typename O>
 void MatchPt(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingPt, std::vector<std::vector<int>>& tagToBaseMatchingPt, V const& tracksBase, M const& clustersBase, N const& tracksTag, O const& clustersTag, float minPtFraction)
 {
-  float ptSumBase;
-  float ptSumTag;
+  constexpr bool isEMCAL = jetfindingutilities::isEMCALTable<M>() || jetfindingutilities::isEMCALTable<O>();
+
+  // constituents of the tag jets, and the tag jets of each constituent id, built once per collision
+  std::vector<JetPtMatchingConstituents> constituentsTag(jetsTagPerCollision.size());
+  std::vector<int> jetsTagGlobalIndex, jetsTagR;
+  std::vector<float> jetsTagPt;
+  std::vector<std::pair<int, int>> jetsTagOfIds; // (constituent id, index of the tag jet), sorted by id
+  int iTag = 0;
+  for (const auto& jetTag : jetsTagPerCollision) {
+    fillPtMatchingConstituents<isEMCAL, jetsTagIsMc, jetsBaseIsMc>(getConstituents(jetTag, tracksTag), getConstituents(jetTag, clustersTag), constituentsTag[iTag]);
+    for (const auto* ids : {&constituentsTag[iTag].trackIds, &constituentsTag[iTag].clusterIds}) {
+      for (const auto& id : *ids) {
+        jetsTagOfIds.emplace_back(id.first, iTag);
+      }
+    }
+    jetsTagGlobalIndex.push_back(jetTag.globalIndex());
+    jetsTagR.push_back(std::round(jetTag.r()));
+    jetsTagPt.push_back(jetTag.pt());
+    iTag++;
+  }
+  std::sort(jetsTagOfIds.begin(), jetsTagOfIds.end());
+
+  JetPtMatchingConstituents constituentsBase;
+  std::vector<int> jetsTagCandidates;
+  std::vector<bool> isShared;
   for (const auto& jetBase : jetsBasePerCollision) {
-    auto jetBaseTracks = getConstituents(jetBase, tracksBase);
-    auto jetBaseClusters = getConstituents(jetBase, clustersBase);
-    for (const auto& jetTag : jetsTagPerCollision) {
-      if (std::round(jetBase.r()) != std::round(jetTag.r())) {
-        continue;
+    constituentsBase = JetPtMatchingConstituents{};
+    fillPtMatchingConstituents<isEMCAL, jetsBaseIsMc, jetsTagIsMc>(getConstituents(jetBase, tracksBase), getConstituents(jetBase, clustersBase), constituentsBase);
+    // only the tag jets sharing at least one constituent id can pass the pT fraction
+    jetsTagCandidates.clear();
+    for (const auto* ids : {&constituentsBase.trackIds, &constituentsBase.clusterIds}) {
+      for (const auto& id : *ids) {
+        auto range = std::equal_range(jetsTagOfIds.begin(), jetsTagOfIds.end(), std::make_pair(id.first, 0), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto jetTagOfId = range.first; jetTagOfId != range.second; ++jetTagOfId) {
+          jetsTagCandidates.push_back(jetTagOfId->second);
+        }
       }
-      auto jetTagTracks = getConstituents(jetTag, tracksTag);
-      auto jetTagClusters = getConstituents(jetTag, clustersTag);
+    }
+    std::sort(jetsTagCandidates.begin(), jetsTagCandidates.end());
+    jetsTagCandidates.erase(std::unique(jetsTagCandidates.begin(), jetsTagCandidates.end()), jetsTagCandidates.end());
 
-      ptSumBase = getPtSum < jetfindingutilities::isEMCALTable<M>() || jetfindingutilities::isEMCALTable<O>(), jetsBaseIsMc, jetsTagIsMc > (jetBaseTracks, jetBaseClusters, jetTagTracks, jetTagClusters);
-      ptSumTag = getPtSum < jetfindingutilities::isEMCALTable<M>() || jetfindingutilities::isEMCALTable<O>(), jetsTagIsMc, jetsBaseIsMc > (jetTagTracks, jetTagClusters, jetBaseTracks, jetBaseClusters);
+    for (const auto& iTagCandidate : jetsTagCandidates) {
+      if (std::round(jetBase.r()) != jetsTagR[iTagCandidate]) {
+        continue;
+      }
+      float ptSumBase = getPtSum<isEMCAL, jetsBaseIsMc, jetsTagIsMc>(constituentsBase, constituentsTag[iTagCandidate], isShared);
+      float ptSumTag = getPtSum<isEMCAL, jetsTagIsMc, jetsBaseIsMc>(constituentsTag[iTagCandidate], constituentsBase, isShared);
       if (ptSumBase > jetBase.pt() * minPtFraction) {
-        baseToTagMatchingPt[jetBase.globalIndex()].push_back(jetTag.globalIndex());
+        baseToTagMatchingPt[jetBase.globalIndex()].push_back(jetsTagGlobalIndex[iTagCandidate]);
       }
-      if (ptSumTag > jetTag.pt() * minPtFraction) {
-        tagToBaseMatchingPt[jetTag.globalIndex()].push_back(jetBase.globalIndex());
+      if (ptSumTag > jetsTagPt[iTagCandidate] * minPtFraction) {
+        tagToBaseMatchingPt[jetsTagGlobalIndex[iTagCandidate]].push_back(jetBase.globalIndex());
       }
     }
   }
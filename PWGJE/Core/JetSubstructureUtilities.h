@@ -19,6 +19,7 @@
 
 #include <vector>
 #include <cmath>
+#include <utility>
 
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -35,6 +36,7 @@
 #include "PWGJE/Core/JetFinder.h"
 #include "PWGJE/Core/JetHFUtilities.h"
 #include "PWGJE/DataModel/Jet.h"
+#include "fastjet/ClusterSequence.hh"
 #include "fastjet/contrib/Nsubjettiness.hh"
 #include "fastjet/contrib/AxesDefinition.hh"
 #include "fastjet/contrib/MeasureDefinition.hh"
@@ -80,6 +82,63 @@ fastjet::ClusterSequenceArea jetToPseudoJet(T const& jet, U const& /*tracks*/, V
   return clusterSeq;
 }
 
+/**
+ * splitting of the primary declustering sequence of a jet
+ */
+struct JetSplitting {
+  double energyMother; // energy of the subjet which is declustered
+  double ptLeading;    // pT of the followed branch
+  double ptSubLeading; // pT of the other branch
+  double theta;        // distance between the two branches
+
+  double z() const { return ptSubLeading / (ptLeading + ptSubLeading); }
+  double kt() const { return ptSubLeading * theta; }
+};
+
+/**
+ * reclusters the constituents of a jet and fills its primary declustering sequence
+ * The reclustering is done without area: the ghosts would not change the clustering history, which is the only output used.
+ *
+ * @param jetReclusterer JetFinder with the reclustering parameters (isReclustering set)
+ * @param jetConstituents constituents of the jet
+ * @param splittings splittings from the largest to the smallest angle (for C/A), filled by the function
+ * @param isFollowed function of the two branches of a splitting, true if the first one is the one declustered further
+ * @return false if the reclustering did not give any jet
+ */
+template <typename F>
+bool findPrimaryDeclusterings(JetFinder& jetReclusterer, std::vector<fastjet::PseudoJet>& jetConstituents, std::vector<JetSplitting>& splittings, F&& isFollowed)
+{
+  splittings.clear();
+  jetReclusterer.setParams();
+  fastjet::ClusterSequence clusterSeq(jetConstituents, jetReclusterer.jetDef);
+  std::vector<fastjet::PseudoJet> jetReclustered = fastjet::sorted_by_pt(jetReclusterer.selJets(clusterSeq.inclusive_jets()));
+  if (jetReclusterer.isReclustering) {
+    jetReclusterer.jetR = jetReclusterer.jetR / 5.0; // as in JetFinder::findJets
+  }
+  if (jetReclustered.empty()) {
+    return false;
+  }
+  fastjet::PseudoJet daughterSubJet = jetReclustered[0];
+  fastjet::PseudoJet parentSubJet1;
+  fastjet::PseudoJet parentSubJet2;
+  while (daughterSubJet.has_parents(parentSubJet1, parentSubJet2)) {
+    if (!isFollowed(parentSubJet1, parentSubJet2)) {
+      std::swap(parentSubJet1, parentSubJet2);
+    }
+    splittings.push_back({daughterSubJet.e(), parentSubJet1.pt(), parentSubJet2.pt(), parentSubJet1.delta_R(parentSubJet2)});
+    daughterSubJet = parentSubJet1;
+  }
+  return true;
+}
+
+/**
+ * primary declustering sequence following the harder branch
+ */
+inline bool findPrimaryDeclusterings(JetFinder& jetReclusterer, std::vector<fastjet::PseudoJet>& jetConstituents, std::vector<JetSplitting>& splittings)
+{
+  return findPrimaryDeclusterings(jetReclusterer, jetConstituents, splittings, [](const fastjet::PseudoJet& subJet1, const fastjet::PseudoJet& subJet2) { return !(subJet1.perp() < subJet2.perp()); });
+}
+
 /**
  * returns a vector with Nsubjettiness variables
  *
@@ -18,13 +18,16 @@
 #ifndef PWGJE_CORE_JETUTILITIES_H_
 #define PWGJE_CORE_JETUTILITIES_H_
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <numeric>
+#include <stdexcept>
 #include <tuple>
+#include <utility>
 #include <vector>
 
-#include <TKDTree.h>
+#include <TMath.h>
 
 #include "Framework/Logger.h"
 #include "Common/Core/RecoDecay.h"
@@ -32,12 +35,135 @@
 namespace jetutilities
 {
 
+/**
+ * Uniform eta-phi grid for nearest-neighbour queries within a maximum distance, with the periodicity of phi.
+ *
+ * The cells are at least as large as the maximum distance, so that a query only visits the 3x3 cells around the point.
+ * The points are stored sorted by cell in flat arrays, whose memory is kept from one build to the next.
+ */
+template <typename T>
+class EtaPhiGrid
+{
+ public:
+  /**
+   * Fills the grid.
+   *
+   * @param eta points eta.
+   * @param phi points phi, any range.
+   * @param maxDistance maximum distance of the queries.
+   */
+  void build(const std::vector<T>& eta, const std::vector<T>& phi, double maxDistance)
+  {
+    if (eta.size() != phi.size()) {
+      throw std::invalid_argument("eta and phi sizes don't match. Check the inputs.");
+    }
+    const std::size_t nPoints = eta.size();
+    mMaxDistance = maxDistance;
+    mEta.assign(eta.begin(), eta.end());
+    mPhi.resize(nPoints);
+    for (std::size_t iPoint = 0; iPoint < nPoints; iPoint++) {
+      mPhi[iPoint] = RecoDecay::constrainAngle(phi[iPoint]);
+    }
+    // binning, the number of cells is limited by the number of points
+    mEtaMin = nPoints ? *std::min_element(mEta.begin(), mEta.end()) : 0.;
+    const double etaRange = nPoints ? *std::max_element(mEta.begin(), mEta.end()) - mEtaMin : 0.;
+    const int nCellsMax = std::max(1, static_cast<int>(2 * std::sqrt(static_cast<double>(nPoints))));
+    mNCellsEta = std::clamp(maxDistance > 0. ? static_cast<int>(etaRange / maxDistance) : 1, 1, nCellsMax);
+    mNCellsPhi = std::clamp(maxDistance > 0. ? static_cast<int>(2. * M_PI / maxDistance) : 1, 1, nCellsMax);
+    mCellWidthEta = etaRange > 0. ? etaRange / mNCellsEta : 1.;
+    mCellWidthPhi = 2. * M_PI / mNCellsPhi;
+    // counting sort of the points by cell
+    mCellOfPoint.resize(nPoints);
+    mCellStart.assign(mNCellsEta * mNCellsPhi + 1, 0);
+    for (std::size_t iPoint = 0; iPoint < nPoints; iPoint++) {
+      mCellOfPoint[iPoint] = getCellEta(mEta[iPoint]) * mNCellsPhi + getCellPhi(mPhi[iPoint]);
+      mCellStart[mCellOfPoint[iPoint] + 1]++;
+    }
+    std::partial_sum(mCellStart.begin(), mCellStart.end(), mCellStart.begin());
+    mPointsSorted.resize(nPoints);
+    mCellFill.assign(mCellStart.begin(), mCellStart.end() - 1);
+    for (std::size_t iPoint = 0; iPoint < nPoints; iPoint++) {
+      mPointsSorted[mCellFill[mCellOfPoint[iPoint]]++] = iPoint;
+    }
+  }
+
+  /**
+   * Finds the closest points within the maximum distance.
+   *
+   * @param eta query eta.
+   * @param phi query phi, any range.
+   * @param maxNumberMatches maximum number of points to find.
+   * @param indices output indices of the points, closest first, -1 beyond the number of found points.
+   * @param distances output distances of the points.
+   *
+   * @returns number of found points.
+   */
+  int findNearestNeighbours(T eta, T phi, int maxNumberMatches, int* indices, T* distances) const
+  {
+    std::fill_n(indices, maxNumberMatches, -1);
+    std::fill_n(distances, maxNumberMatches, std::numeric_limits<T>::max());
+    if (mPointsSorted.empty() || maxNumberMatches <= 0) {
+      return 0;
+    }
+    phi = RecoDecay::constrainAngle(phi);
+    const int cellEta = getCellEta(eta);
+    const int cellPhi = getCellPhi(phi);
+    // with less than 3 cells in phi, all of them are neighbours
+    const int cellPhiFirst = mNCellsPhi < 3 ? 0 : cellPhi - 1;
+    const int cellPhiLast = mNCellsPhi < 3 ? mNCellsPhi - 1 : cellPhi + 1;
+    int nFound = 0;
+    for (int iEta = std::max(0, cellEta - 1); iEta <= std::min(mNCellsEta - 1, cellEta + 1); iEta++) {
+      for (int iPhiUnwrapped = cellPhiFirst; iPhiUnwrapped <= cellPhiLast; iPhiUnwrapped++) {
+        const int iPhi = (iPhiUnwrapped + mNCellsPhi) % mNCellsPhi;
+        const int cell = iEta * mNCellsPhi + iPhi;
+        for (int iSorted = mCellStart[cell]; iSorted < mCellStart[cell + 1]; iSorted++) {
+          const int iPoint = mPointsSorted[iSorted];
+          const double dEta = mEta[iPoint] - eta;
+          double dPhi = std::abs(mPhi[iPoint] - phi);
+          dPhi = std::min(dPhi, 2. * M_PI - dPhi);
+          const T distance = std::sqrt(dEta * dEta + dPhi * dPhi);
+          if (distance >= mMaxDistance || (nFound == maxNumberMatches && distance >= distances[nFound - 1])) {
+            continue;
+          }
+          // insertion in the list of the closest points
+          int iInsert = nFound < maxNumberMatches ? nFound++ : maxNumberMatches - 1;
+          for (; iInsert > 0 && distances[iInsert - 1] > distance; iInsert--) {
+            indices[iInsert] = indices[iInsert - 1];
+            distances[iInsert] = distances[iInsert - 1];
+          }
+          indices[iInsert] = iPoint;
+          distances[iInsert] = distance;
+        }
+      }
+    }
+    return nFound;
+  }
+
+ private:
+  int getCellEta(T eta) const { return std::clamp(static_cast<int>(std::floor((eta - mEtaMin) / mCellWidthEta)), 0, mNCellsEta - 1); }
+  int getCellPhi(T phi) const { return std::clamp(static_cast<int>(phi / mCellWidthPhi), 0, mNCellsPhi - 1); }
+
+  double mMaxDistance = 0.;
+  double mEtaMin = 0.;
+  double mCellWidthEta = 1.;
+  double mCellWidthPhi = 2. * M_PI;
+  int mNCellsEta = 1;
+  int mNCellsPhi = 1;
+  std::vector<T> mEta;            // eta of the points
+  std::vector<T> mPhi;            // phi of the points, in [0, 2pi)
+  std::vector<int> mCellOfPoint;  // cell of each point
+  std::vector<int> mCellStart;    // index of the first point of each cell in mPointsSorted
+  std::vector<int> mCellFill;     // filling position of each cell, used when building
+  std::vector<int> mPointsSorted; // indices of the points, sorted by cell
+};
+
 /**
  * Match clusters and tracks.
  *
  * Match cluster with tracks, where maxNumberMatches are considered in dR=maxMatchingDistance.
  * If no unique match was found for a jet, an index of -1 is stored.
  * The same map is created for clusters matched to tracks e.g. for electron analyses.
+ * The maps are flat: the matches of the cluster (track) i are at the indices [i * maxNumberMatches, (i + 1) * maxNumberMatches).
  *
  * @param clusterPhi cluster collection phi.
  * @param clusterEta cluster collection eta.
@@ -49,7 +175,7 @@ namespace jetutilities
  * @returns (cluster to track index map, track to cluster index map)
  */
 template <typename T>
-std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>> MatchClustersAndTracks(
+std::tuple<std::vector<int>, std::vector<int>> MatchClustersAndTracks(
   std::vector<T>& clusterPhi,
   std::vector<T>& clusterEta,
   std::vector<T>& trackPhi,
@@ -57,13 +183,12 @@ std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>> MatchCl
   double maxMatchingDistance,
   int maxNumberMatches)
 {
-  // test
   // Validation
   const std::size_t nClusters = clusterEta.size();
   const std::size_t nTracks = trackEta.size();
   if (!(nClusters && nTracks)) {
     // There are no jets, so nothing to be done.
-    return std::make_tuple(std::vector<std::vector<int>>(nClusters, std::vector<int>(maxNumberMatches, -1)), std::vector<std::vector<int>>(nTracks, std::vector<int>(maxNumberMatches, -1)));
+    return std::make_tuple(std::vector<int>(nClusters * maxNumberMatches, -1), std::vector<int>(nTracks * maxNumberMatches, -1));
   }
   // Input sizes must match
   if (clusterPhi.size() != clusterEta.size()) {
@@ -73,69 +198,26 @@ std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>> MatchCl
     throw std::invalid_argument("track collection eta and phi sizes don't match. Check the inputs.");
   }
 
-  // for (std::size_t iTrack = 0; iTrack < nTracks; iTrack++) {
-  //   if (trackEta[iTrack] == 0)
-  //     LOG(warning) << "Track eta is 0!";
-  // }
-
-  // Build the KD-trees using vectors
-  // We build two trees:
-  // treeBase, which contains the base collection.
-  // treeTag, which contains the tag collection.
-  // The trees are built to match in two dimensions (eta, phi)
-  TKDTree<int, T> treeCluster(clusterEta.size(), 2, 1), treeTrack(trackEta.size(), 2, 1);
-  // By utilizing SetData, we can avoid having to copy the data again.
-  treeCluster.SetData(0, clusterEta.data());
-  treeCluster.SetData(1, clusterPhi.data());
-  treeCluster.Build();
-  treeTrack.SetData(0, trackEta.data());
-  treeTrack.SetData(1, trackPhi.data());
-  treeTrack.Build();
-
-  // Storage for the cluster matching indices.
-  std::vector<std::vector<int>> matchIndexTrack(nClusters, std::vector<int>(maxNumberMatches, -1));
-  std::vector<std::vector<int>> matchIndexCluster(nTracks, std::vector<int>(maxNumberMatches, -1));
-
-  // Find the track closest to each cluster.
+  // Build the eta-phi grids, one per collection, kept from one call to the next.
+  thread_local EtaPhiGrid<T> gridCluster, gridTrack;
+  gridCluster.build(clusterEta, clusterPhi, maxMatchingDistance);
+  gridTrack.build(trackEta, trackPhi, maxMatchingDistance);
+
+  // Storage for the matching indices.
+  std::vector<int> matchIndexTrack(nClusters * maxNumberMatches, -1);
+  std::vector<int> matchIndexCluster(nTracks * maxNumberMatches, -1);
+  std::vector<T> distance(maxNumberMatches);
+
+  // Find the tracks closest to each cluster.
   for (std::size_t iCluster = 0; iCluster < nClusters; iCluster++) {
-    T point[2] = {clusterEta[iCluster], clusterPhi[iCluster]};
-    int index[50];  // size 50 for safety
-    T distance[50]; // size 50 for safery
-    std::fill_n(index, 50, -1);
-    std::fill_n(distance, 50, std::numeric_limits<T>::max());
-    treeTrack.FindNearestNeighbors(point, maxNumberMatches, index, distance);
-    // test whether indices are matching:
-    matchIndexTrack[iCluster] = std::vector<int>(maxNumberMatches);
-    for (int m = 0; m < maxNumberMatches; m++) {
-      if (index[m] >= 0 && distance[m] < maxMatchingDistance) {
-        matchIndexTrack[iCluster][m] = index[m];
-      } else {
-        // no match or no more matches found, fill -1
-        matchIndexTrack[iCluster][m] = -1;
-      }
-    }
+    gridTrack.findNearestNeighbours(clusterEta[iCluster], clusterPhi[iCluster], maxNumberMatches, matchIndexTrack.data() + iCluster * maxNumberMatches, distance.data());
   }
 
-  // Find the base jet closest to each tag jet
+  // Find the clusters closest to each track.
   for (std::size_t iTrack = 0; iTrack < nTracks; iTrack++) {
-    T point[2] = {trackEta[iTrack], trackPhi[iTrack]};
-    int index[50];  // size 50 for safety
-    T distance[50]; // size 50 for safery
-    std::fill_n(index, 50, -1);
-    std::fill_n(distance, 50, std::numeric_limits<T>::max());
-    treeCluster.FindNearestNeighbors(point, maxNumberMatches, index, distance);
-    matchIndexCluster[iTrack] = std::vector<int>(maxNumberMatches);
-    // loop over maxNumberMatches closest matches
-    for (int m = 0; m < maxNumberMatches; m++) {
-      if (index[m] >= 0 && distance[m] < maxMatchingDistance) {
-        matchIndexCluster[iTrack][m] = index[m];
-      } else {
-        // no match jet or no more matches found, fill -1
-        matchIndexCluster[iTrack][m] = -1;
-      }
-    }
+    gridCluster.findNearestNeighbours(trackEta[iTrack], trackPhi[iTrack], maxNumberMatches, matchIndexCluster.data() + iTrack * maxNumberMatches, distance.data());
   }
-  return std::make_tuple(matchIndexTrack, matchIndexCluster);
+  return std::make_tuple(std::move(matchIndexTrack), std::move(matchIndexCluster));
 }
 
 template <typename T, typename U>
@@ -30,8 +30,12 @@ namespace o2::aod
 
 namespace bkgrho
 {
-DECLARE_SOA_COLUMN(Rho, rho, float);   //!
-DECLARE_SOA_COLUMN(RhoM, rhoM, float); //!
+DECLARE_SOA_COLUMN(Rho, rho, float);                   //!
+DECLARE_SOA_COLUMN(RhoM, rhoM, float);                 //!
+DECLARE_SOA_COLUMN(RhoSparse, rhoSparse, float);       //! pT density with the sparse method
+DECLARE_SOA_COLUMN(RhoMSparse, rhoMSparse, float);     //! mass density with the sparse method
+DECLARE_SOA_COLUMN(RhoPerpCone, rhoPerpCone, float);   //! pT density in the cones perpendicular to the leading kT jet
+DECLARE_SOA_COLUMN(RhoMPerpCone, rhoMPerpCone, float); //! mass density in the cones perpendicular to the leading kT jet
 } // namespace bkgrho
 
 namespace bkgcharged
@@ -60,6 +64,13 @@ DECLARE_SOA_TABLE(BkgChargedRhos, "AOD", "BkgCRho",
                   bkgrho::Rho,
                   bkgrho::RhoM);
 
+// alternative estimators of the charged background, joinable with BkgChargedRhos
+DECLARE_SOA_TABLE(BkgChargedRhoEstimators, "AOD", "BkgCRhoEst",
+                  bkgrho::RhoSparse,
+                  bkgrho::RhoMSparse,
+                  bkgrho::RhoPerpCone,
+                  bkgrho::RhoMPerpCone);
+
 DECLARE_SOA_TABLE(BkgD0Rhos, "AOD", "BkgD0Rho",
                   o2::soa::Index<>,
                   bkgd0::CandidateId,
@@ -68,6 +68,8 @@ struct JetFinderV0Task {
   Configurable<int> jetRecombScheme{"jetRecombScheme", 0, "jet recombination scheme. 0 = E-scheme, 1 = pT-scheme, 2 = pT2-scheme"};
   Configurable<float> jetGhostArea{"jetGhostArea", 0.005, "jet ghost area"};
   Configurable<int> ghostRepeat{"ghostRepeat", 1, "set to 0 to gain speed if you dont need area calculation"};
+  Configurable<int> jetAreaType{"jetAreaType", 0, "jet area type. 0 = active, 11 = passive, 20 = Voronoi (no ghosts)"};
+  Configurable<int> ghostSeed{"ghostSeed", -1, "seed of the ghosts, the same ghosts are used for all the events if >= 0"};
   Configurable<float> jetAreaFractionMin{"jetAreaFractionMin", -99.0, "used to make a cut on the jet areas"};
   Configurable<int> jetPtBinWidth{"jetPtBinWidth", 5, "used to define the width of the jetPt bins for the THnSparse"};
   Configurable<bool> fillTHnSparse{"fillTHnSparse", true, "switch to fill the THnSparse"};
@@ -101,6 +103,8 @@ struct JetFinderV0Task {
     jetFinder.recombScheme = static_cast<fastjet::RecombinationScheme>(static_cast<int>(jetRecombScheme));
     jetFinder.ghostArea = jetGhostArea;
     jetFinder.ghostRepeatN = ghostRepeat;
+    jetFinder.areaType = static_cast<fastjet::AreaType>(static_cast<int>(jetAreaType));
+    jetFinder.ghostSeed = ghostSeed;
 
     if (candPDGMass == 310) {
       candIndex = 0;
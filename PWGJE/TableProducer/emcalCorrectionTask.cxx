@@ -104,8 +104,21 @@ struct EmcalCorrectionTask {
   // Cells and clusters
   std::vector<o2::emcal::AnalysisCluster> mAnalysisClusters;
   std::vector<o2::emcal::ClusterLabel> mClusterLabels;
+  // Input of the clusterizers and of the track matching, reused for all BCs to avoid reallocations
+  std::vector<o2::emcal::Cell> mCellsBC;
+  std::vector<int64_t> mCellIndicesBC;
+  std::vector<o2::emcal::CellLabel> mCellLabels;
+  std::vector<double> mTrackPhi;
+  std::vector<double> mTrackEta;
+  std::vector<int64_t> mTrackGlobalIndex;
+  std::vector<double> mClusterPhi;
+  std::vector<double> mClusterEta;
+  // Absolute cell energy scale per cell ID, tabulated in init as it only depends on the geometry
+  std::vector<float> mCellAbsScale;
 
   std::vector<o2::aod::EMCALClusterDefinition> mClusterDefinitions;
+  // Maximum number of tracks matched to a cluster
+  static constexpr int maxNumberMatchedTracks = 20;
   // QA
   o2::framework::HistogramRegistry mHistManager{"EMCALCorrectionTaskQAHistograms"};
 
@@ -160,6 +173,12 @@ struct EmcalCorrectionTask {
     for (auto& clusterizer : mClusterizers) {
       clusterizer->setGeometry(geometry);
     }
+    if (applyCellAbsScale && geometry) {
+      mCellAbsScale.resize(geometry->GetNCells());
+      for (int cellID = 0; cellID < geometry->GetNCells(); cellID++) {
+        mCellAbsScale[cellID] = GetAbsCellScale(geometry, cellID);
+      }
+    }
 
     if (mClusterizers.size() == 0) {
       LOG(error) << "No cluster definitions specified!";
@@ -246,39 +265,49 @@ struct EmcalCorrectionTask {
       }
       // Counters for BCs with matched collisions
       countBC(collisionsInFoundBC.size(), true);
-      std::vector<o2::emcal::Cell> cellsBC;
-      std::vector<int64_t> cellIndicesBC;
+      mCellsBC.clear();
+      mCellIndicesBC.clear();
+      mCellsBC.reserve(cellsInBC.size());
+      mCellIndicesBC.reserve(cellsInBC.size());
       for (auto& cell : cellsInBC) {
         auto amplitude = cell.amplitude();
         if (static_cast<bool>(hasShaperCorrection)) {
           amplitude = o2::emcal::NonlinearityHandler::evaluateShaperCorrectionCellEnergy(amplitude);
         }
         if (applyCellAbsScale) {
-          amplitude *= GetAbsCellScale(cell.cellNumber());
+          amplitude *= mCellAbsScale[cell.cellNumber()];
         }
-        cellsBC.emplace_back(cell.cellNumber(),
-                             amplitude,
-                             cell.time(),
-                             o2::emcal::intToChannelType(cell.cellType()));
-        cellIndicesBC.emplace_back(cell.globalIndex());
+        mCellsBC.emplace_back(cell.cellNumber(),
+                              amplitude,
+                              cell.time(),
+                              o2::emcal::intToChannelType(cell.cellType()));
+        mCellIndicesBC.emplace_back(cell.globalIndex());
       }
-      LOG(detail) << "Number of cells for BC (CF): " << cellsBC.size();
-      nCellsProcessed += cellsBC.size();
+      LOG(detail) << "Number of cells for BC (CF): " << mCellsBC.size();
+      nCellsProcessed += mCellsBC.size();
 
-      fillQAHistogram(cellsBC);
+      fillQAHistogram(mCellsBC);
 
       // TODO: Helpful for now, but should be removed.
       LOG(debug) << "Converted EMCAL cells";
-      for (auto& cell : cellsBC) {
+      for (auto& cell : mCellsBC) {
         LOG(debug) << cell.getTower() << ": E: " << cell.getEnergy() << ", time: " << cell.getTimeStamp() << ", type: " << cell.getType();
       }
 
-      LOG(debug) << "Converted cells. Contains: " << cellsBC.size() << ". Originally " << cellsInBC.size() << ". About to run clusterizer.";
+      LOG(debug) << "Converted cells. Contains: " << mCellsBC.size() << ". Originally " << cellsInBC.size() << ". About to run clusterizer.";
       //  this is a test
       //  Run the clusterizers
       LOG(debug) << "Running clusterizers";
+      // the tracks of the collision are the same for all clusterizers, they are collected once per BC
+      if (collisionsInFoundBC.size() == 1) {
+        for (const auto& col : collisionsInFoundBC) {
+          if (col.foundBCId() == bc.globalIndex()) {
+            FillTrackInfo(tracks.sliceBy(perCollision, col.globalIndex()));
+          }
+        }
+      }
       for (size_t iClusterizer = 0; iClusterizer < mClusterizers.size(); iClusterizer++) {
-        cellsToCluster(iClusterizer, cellsBC);
+        cellsToCluster(iClusterizer, mCellsBC);
 
         if (collisionsInFoundBC.size() == 1) {
           // dummy loop to get the first collision
@@ -288,15 +317,12 @@ struct EmcalCorrectionTask {
               mHistManager.fill(HIST("hCollisionType"), 1);
               math_utils::Point3D<float> vertex_pos = {col.posX(), col.posY(), col.posZ()};
 
-              std::vector<std::vector<int>> clusterToTrackIndexMap;
-              std::vector<std::vector<int>> trackToClusterIndexMap;
-              std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>> IndexMapPair{clusterToTrackIndexMap, trackToClusterIndexMap};
-              std::vector<int64_t> trackGlobalIndex;
-              doTrackMatching<collEventSels::filtered_iterator>(col, tracks, IndexMapPair, vertex_pos, trackGlobalIndex);
+              std::tuple<std::vector<int>, std::vector<int>> IndexMapPair;
+              doTrackMatching(IndexMapPair, vertex_pos);
 
               // Store the clusters in the table where a matching collision could
               // be identified.
-              FillClusterTable<collEventSels::filtered_iterator>(col, vertex_pos, iClusterizer, cellIndicesBC, IndexMapPair, trackGlobalIndex);
+              FillClusterTable<collEventSels::filtered_iterator>(col, vertex_pos, iClusterizer, mCellIndicesBC, IndexMapPair, mTrackGlobalIndex);
             }
           }
         } else { // ambiguous
@@ -309,7 +335,7 @@ struct EmcalCorrectionTask {
             hasCollision = true;
             mHistManager.fill(HIST("hCollisionType"), 2);
           }
-          FillAmbigousClusterTable<bcEvSels::iterator>(bc, iClusterizer, cellIndicesBC, hasCollision);
+          FillAmbigousClusterTable<bcEvSels::iterator>(bc, iClusterizer, mCellIndicesBC, hasCollision);
         }
 
         LOG(debug) << "Cluster loop done for clusterizer " << iClusterizer;
@@ -361,9 +387,11 @@ struct EmcalCorrectionTask {
       }
       // Counters for BCs with matched collisions
       countBC(collisionsInFoundBC.size(), true);
-      std::vector<o2::emcal::Cell> cellsBC;
-      std::vector<int64_t> cellIndicesBC;
-      std::vector<o2::emcal::CellLabel> cellLabels;
+      mCellsBC.clear();
+      mCellIndicesBC.clear();
+      mCellLabels.clear();
+      mCellsBC.reserve(cellsInBC.size());
+      mCellIndicesBC.reserve(cellsInBC.size());
       for (auto& cell : cellsInBC) {
         mHistManager.fill(HIST("hContributors"), cell.mcParticle_as<aod::StoredMcParticles_001>().size());
         auto cellParticles = cell.mcParticle_as<aod::StoredMcParticles_001>();
@@ -374,30 +402,38 @@ struct EmcalCorrectionTask {
         if (static_cast<bool>(hasShaperCorrection)) {
           amplitude = o2::emcal::NonlinearityHandler::evaluateShaperCorrectionCellEnergy(amplitude);
         }
-        cellsBC.emplace_back(cell.cellNumber(),
-                             amplitude,
-                             cell.time(),
-                             o2::emcal::intToChannelType(cell.cellType()));
-        cellIndicesBC.emplace_back(cell.globalIndex());
-        cellLabels.emplace_back(cell.mcParticleIds(), cell.amplitudeA());
+        mCellsBC.emplace_back(cell.cellNumber(),
+                              amplitude,
+                              cell.time(),
+                              o2::emcal::intToChannelType(cell.cellType()));
+        mCellIndicesBC.emplace_back(cell.globalIndex());
+        mCellLabels.emplace_back(cell.mcParticleIds(), cell.amplitudeA());
       }
-      LOG(detail) << "Number of cells for BC (CF): " << cellsBC.size();
-      nCellsProcessed += cellsBC.size();
+      LOG(detail) << "Number of cells for BC (CF): " << mCellsBC.size();
+      nCellsProcessed += mCellsBC.size();
 
-      fillQAHistogram(cellsBC);
+      fillQAHistogram(mCellsBC);
 
       // TODO: Helpful for now, but should be removed.
       LOG(debug) << "Converted EMCAL cells";
-      for (auto& cell : cellsBC) {
+      for (auto& cell : mCellsBC) {
         LOG(debug) << cell.getTower() << ": E: " << cell.getEnergy() << ", time: " << cell.getTimeStamp() << ", type: " << cell.getType();
       }
 
-      LOG(debug) << "Converted cells. Contains: " << cellsBC.size() << ". Originally " << cellsInBC.size() << ". About to run clusterizer.";
+      LOG(debug) << "Converted cells. Contains: " << mCellsBC.size() << ". Originally " << cellsInBC.size() << ". About to run clusterizer.";
       //  this is a test
       //  Run the clusterizers
       LOG(debug) << "Running clusterizers";
+      // the tracks of the collision are the same for all clusterizers, they are collected once per BC
+      if (collisionsInFoundBC.size() == 1) {
+        for (const auto& col : collisionsInFoundBC) {
+          if (col.foundBCId() == bc.globalIndex()) {
+            FillTrackInfo(tracks.sliceBy(perCollision, col.globalIndex()));
+          }
+        }
+      }
       for (size_t iClusterizer = 0; iClusterizer < mClusterizers.size(); iClusterizer++) {
-        cellsToCluster(iClusterizer, cellsBC, cellLabels);
+        cellsToCluster(iClusterizer, mCellsBC, mCellLabels);
 
         if (collisionsInFoundBC.size() == 1) {
           // dummy loop to get the first collision
@@ -407,15 +443,12 @@ struct EmcalCorrectionTask {
               mHistManager.fill(HIST("hCollisionType"), 1);
               math_utils::Point3D<float> vertex_pos = {col.posX(), col.posY(), col.posZ()};
 
-              std::vector<std::vector<int>> clusterToTrackIndexMap;
-              std::vector<std::vector<int>> trackToClusterIndexMap;
-              std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>> IndexMapPair{clusterToTrackIndexMap, trackToClusterIndexMap};
-              std::vector<int64_t> trackGlobalIndex;
-              doTrackMatching<collEventSels::filtered_iterator>(col, tracks, IndexMapPair, vertex_pos, trackGlobalIndex);
+              std::tuple<std::vector<int>, std::vector<int>> IndexMapPair;
+              doTrackMatching(IndexMapPair, vertex_pos);
 
               // Store the clusters in the table where a matching collision could
               // be identified.
-              FillClusterTable<collEventSels::filtered_iterator>(col, vertex_pos, iClusterizer, cellIndicesBC, IndexMapPair, trackGlobalIndex);
+              FillClusterTable<collEventSels::filtered_iterator>(col, vertex_pos, iClusterizer, mCellIndicesBC, IndexMapPair, mTrackGlobalIndex);
             }
           }
         } else { // ambiguous
@@ -428,7 +461,7 @@ struct EmcalCorrectionTask {
             hasCollision = true;
             mHistManager.fill(HIST("hCollisionType"), 2);
           }
-          FillAmbigousClusterTable<bcEvSels::iterator>(bc, iClusterizer, cellIndicesBC, hasCollision);
+          FillAmbigousClusterTable<bcEvSels::iterator>(bc, iClusterizer, mCellIndicesBC, hasCollision);
         }
         LOG(debug) << "Cluster loop done for clusterizer " << iClusterizer;
       } // end of clusterizer loop
@@ -473,33 +506,35 @@ struct EmcalCorrectionTask {
       }
       // Counters for BCs with matched collisions
       countBC(collisionsInBC.size(), true);
-      std::vector<o2::emcal::Cell> cellsBC;
-      std::vector<int64_t> cellIndicesBC;
+      mCellsBC.clear();
+      mCellIndicesBC.clear();
+      mCellsBC.reserve(cellsInBC.size());
+      mCellIndicesBC.reserve(cellsInBC.size());
       for (auto& cell : cellsInBC) {
-        cellsBC.emplace_back(cell.cellNumber(),
-                             cell.amplitude(),
-                             cell.time(),
-                             o2::emcal::intToChannelType(cell.cellType()));
-        cellIndicesBC.emplace_back(cell.globalIndex());
+        mCellsBC.emplace_back(cell.cellNumber(),
+                              cell.amplitude(),
+                              cell.time(),
+                              o2::emcal::intToChannelType(cell.cellType()));
+        mCellIndicesBC.emplace_back(cell.globalIndex());
       }
-      LOG(detail) << "Number of cells for BC (CF): " << cellsBC.size();
-      nCellsProcessed += cellsBC.size();
+      LOG(detail) << "Number of cells for BC (CF): " << mCellsBC.size();
+      nCellsProcessed += mCellsBC.size();
 
-      fillQAHistogram(cellsBC);
+      fillQAHistogram(mCellsBC);
 
       // TODO: Helpful for now, but should be removed.
       LOG(debug) << "Converted EMCAL cells";
-      for (auto& cell : cellsBC) {
+      for (auto& cell : mCellsBC) {
         LOG(debug) << cell.getTower() << ": E: " << cell.getEnergy() << ", time: " << cell.getTimeStamp() << ", type: " << cell.getType();
       }
 
-      LOG(debug) << "Converted cells. Contains: " << cellsBC.size() << ". Originally " << cellsInBC.size() << ". About to run clusterizer.";
+      LOG(debug) << "Converted cells. Contains: " << mCellsBC.size() << ". Originally " << cellsInBC.size() << ". About to run clusterizer.";
 
       //  this is a test
       //  Run the clusterizers
       LOG(debug) << "Running clusterizers";
       for (size_t iClusterizer = 0; iClusterizer < mClusterizers.size(); iClusterizer++) {
-        cellsToCluster(iClusterizer, cellsBC);
+        cellsToCluster(iClusterizer, mCellsBC);
 
         if (collisionsInBC.size() == 1) {
           // dummy loop to get the first collision
@@ -510,7 +545,7 @@ struct EmcalCorrectionTask {
 
             // Store the clusters in the table where a matching collision could
             // be identified.
-            FillClusterTable<aod::Collision>(col, vertex_pos, iClusterizer, cellIndicesBC);
+            FillClusterTable<aod::Collision>(col, vertex_pos, iClusterizer, mCellIndicesBC);
           }
         } else { // ambiguous
           // LOG(warning) << "No vertex found for event. Assuming (0,0,0).";
@@ -522,7 +557,7 @@ struct EmcalCorrectionTask {
             hasCollision = true;
             mHistManager.fill(HIST("hCollisionType"), 2);
           }
-          FillAmbigousClusterTable<aod::BC>(bc, iClusterizer, cellIndicesBC, hasCollision);
+          FillAmbigousClusterTable<aod::BC>(bc, iClusterizer, mCellIndicesBC, hasCollision);
         }
 
         LOG(debug) << "Cluster loop done for clusterizer " << iClusterizer;
@@ -568,7 +603,7 @@ struct EmcalCorrectionTask {
   }
 
   template <typename Collision>
-  void FillClusterTable(Collision const& col, math_utils::Point3D<float> const& vertex_pos, size_t iClusterizer, const gsl::span<int64_t> cellIndicesBC, std::optional<std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>>> const& IndexMapPair = std::nullopt, std::optional<std::vector<int64_t>> const& trackGlobalIndex = std::nullopt)
+  void FillClusterTable(Collision const& col, math_utils::Point3D<float> const& vertex_pos, size_t iClusterizer, const gsl::span<int64_t> cellIndicesBC, std::optional<std::tuple<std::vector<int>, std::vector<int>>> const& IndexMapPair = std::nullopt, std::optional<std::vector<int64_t>> const& trackGlobalIndex = std::nullopt)
   {
     // we found a collision, put the clusters into the none ambiguous table
     clusters.reserve(mAnalysisClusters.size());
@@ -619,10 +654,12 @@ struct EmcalCorrectionTask {
       mHistManager.fill(HIST("hClusterE"), cluster.E());
       mHistManager.fill(HIST("hClusterEtaPhi"), pos.Eta(), TVector2::Phi_0_2pi(pos.Phi()));
       if (IndexMapPair && trackGlobalIndex) {
-        for (unsigned int iTrack = 0; iTrack < std::get<0>(*IndexMapPair)[iCluster].size(); iTrack++) {
-          if (std::get<0>(*IndexMapPair)[iCluster][iTrack] >= 0) {
-            LOG(debug) << "Found track " << (*trackGlobalIndex)[std::get<0>(*IndexMapPair)[iCluster][iTrack]] << " in cluster " << cluster.getID();
-            matchedTracks(clusters.lastIndex(), (*trackGlobalIndex)[std::get<0>(*IndexMapPair)[iCluster][iTrack]]);
+        const auto& clusterToTrackIndexMap = std::get<0>(*IndexMapPair);
+        for (int iTrack = 0; iTrack < maxNumberMatchedTracks && (iCluster + 1) * maxNumberMatchedTracks <= clusterToTrackIndexMap.size(); iTrack++) {
+          const int trackIndex = clusterToTrackIndexMap[iCluster * maxNumberMatchedTracks + iTrack];
+          if (trackIndex >= 0) {
+            LOG(debug) << "Found track " << (*trackGlobalIndex)[trackIndex] << " in cluster " << cluster.getID();
+            matchedTracks(clusters.lastIndex(), (*trackGlobalIndex)[trackIndex]);
           }
         }
       }
@@ -672,24 +709,14 @@ struct EmcalCorrectionTask {
     }   // end of cluster loop
   }
 
-  template <typename Collision>
-  void doTrackMatching(Collision const& col, myGlobTracks const& tracks, std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>>& IndexMapPair, math_utils::Point3D<float>& vertex_pos, std::vector<int64_t>& trackGlobalIndex)
+  void doTrackMatching(std::tuple<std::vector<int>, std::vector<int>>& IndexMapPair, math_utils::Point3D<float>& vertex_pos)
   {
-    auto groupedTracks = tracks.sliceBy(perCollision, col.globalIndex());
-    int NTracksInCol = groupedTracks.size();
-    std::vector<double> trackPhi;
-    std::vector<double> trackEta;
-    // reserve memory to reduce on the fly memory allocation
-    trackPhi.reserve(NTracksInCol);
-    trackEta.reserve(NTracksInCol);
-    trackGlobalIndex.reserve(NTracksInCol);
-    FillTrackInfo<decltype(groupedTracks)>(groupedTracks, trackPhi, trackEta, trackGlobalIndex);
-
-    int NClusterInCol = mAnalysisClusters.size();
-    std::vector<double> clusterPhi;
-    std::vector<double> clusterEta;
-    clusterPhi.reserve(NClusterInCol);
-    clusterEta.reserve(NClusterInCol);
+    FillTrackQA();
+
+    mClusterPhi.clear();
+    mClusterEta.clear();
+    mClusterPhi.reserve(mAnalysisClusters.size());
+    mClusterEta.reserve(mAnalysisClusters.size());
 
     // TODO one loop that could in principle be combined with the other
     // loop to improve performance
@@ -700,40 +727,49 @@ struct EmcalCorrectionTask {
       pos = pos - vertex_pos;
       // Normalize the vector and rescale by energy.
       pos *= (cluster.E() / std::sqrt(pos.Mag2()));
-      clusterPhi.emplace_back(TVector2::Phi_0_2pi(pos.Phi()));
-      clusterEta.emplace_back(pos.Eta());
+      mClusterPhi.emplace_back(TVector2::Phi_0_2pi(pos.Phi()));
+      mClusterEta.emplace_back(pos.Eta());
     }
     IndexMapPair =
-      jetutilities::MatchClustersAndTracks(clusterPhi, clusterEta,
-                                           trackPhi, trackEta,
-                                           maxMatchingDistance, 20);
+      jetutilities::MatchClustersAndTracks(mClusterPhi, mClusterEta,
+                                           mTrackPhi, mTrackEta,
+                                           maxMatchingDistance, maxNumberMatchedTracks);
   }
 
+  // Collects eta, phi and global index of the global tracks of a collision, used for the track matching of all clusterizers
   template <typename Tracks>
-  void FillTrackInfo(Tracks const& tracks, std::vector<double>& trackPhi, std::vector<double>& trackEta, std::vector<int64_t>& trackGlobalIndex)
+  void FillTrackInfo(Tracks const& tracks)
   {
-    int NTrack = 0;
+    mTrackPhi.clear();
+    mTrackEta.clear();
+    mTrackGlobalIndex.clear();
+    mTrackPhi.reserve(tracks.size());
+    mTrackEta.reserve(tracks.size());
+    mTrackGlobalIndex.reserve(tracks.size());
     for (auto& track : tracks) {
       // TODO only consider tracks in current emcal/dcal acceptanc
       if (!track.isGlobalTrack()) { // only global tracks
         continue;
       }
-      NTrack++;
       if (hasPropagatedTracks) { // only temporarily while not every data
                                  // has the tracks propagated to EMCal/PHOS
-        trackPhi.emplace_back(TVector2::Phi_0_2pi(track.trackPhiEmcal()));
-        trackEta.emplace_back(track.trackEtaEmcal());
-        mHistManager.fill(HIST("hGlobalTrackEtaPhi"), track.trackEtaEmcal(),
-                          TVector2::Phi_0_2pi(track.trackPhiEmcal()));
+        mTrackPhi.emplace_back(TVector2::Phi_0_2pi(track.trackPhiEmcal()));
+        mTrackEta.emplace_back(track.trackEtaEmcal());
       } else {
-        trackPhi.emplace_back(TVector2::Phi_0_2pi(track.phi()));
-        trackEta.emplace_back(track.eta());
-        mHistManager.fill(HIST("hGlobalTrackEtaPhi"), track.eta(),
-                          TVector2::Phi_0_2pi(track.phi()));
+        mTrackPhi.emplace_back(TVector2::Phi_0_2pi(track.phi()));
+        mTrackEta.emplace_back(track.eta());
       }
-      trackGlobalIndex.emplace_back(track.globalIndex());
+      mTrackGlobalIndex.emplace_back(track.globalIndex());
+    }
+  }
+
+  // Track QA, filled for each clusterizer as the matching is done per clusterizer
+  void FillTrackQA()
+  {
+    for (size_t iTrack = 0; iTrack < mTrackPhi.size(); iTrack++) {
+      mHistManager.fill(HIST("hGlobalTrackEtaPhi"), mTrackEta[iTrack], mTrackPhi[iTrack]);
     }
-    mHistManager.fill(HIST("hGlobalTrackMult"), NTrack);
+    mHistManager.fill(HIST("hGlobalTrackMult"), mTrackPhi.size());
   }
 
   void countBC(int numberOfCollisions, bool hasEMCcells)
@@ -773,17 +809,17 @@ struct EmcalCorrectionTask {
     }
   }
 
-  float GetAbsCellScale(const int cellID)
+  float GetAbsCellScale(o2::emcal::Geometry* geometry, const int cellID)
   {
     // Apply cell scale based on SM types (Full, Half (not used), EMC 1/3, DCal, DCal 1/3)
     // Same as in Run2 data
     if (applyCellAbsScale == 1) {
-      int iSM = mClusterizers.at(0)->getGeometry()->GetSuperModuleNumber(cellID);
-      return vCellAbsScaleFactor.value[mClusterizers.at(0)->getGeometry()->GetSMType(iSM)];
+      int iSM = geometry->GetSuperModuleNumber(cellID);
+      return vCellAbsScaleFactor.value[geometry->GetSMType(iSM)];
 
       // Apply cell scale based on columns to accoutn for material of TRD structures
     } else if (applyCellAbsScale == 2) {
-      auto res = mClusterizers.at(0)->getGeometry()->GlobalRowColFromIndex(cellID);
+      auto res = geometry->GlobalRowColFromIndex(cellID);
       return vCellAbsScaleFactor.value[std::get<1>(res)];
     } else {
       return 1.f;
@@ -13,10 +13,14 @@
 //
 /// \author Nima Zardoshti <nima.zardoshti@cern.ch>
 
+#include <chrono>
+#include <vector>
+
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/ASoA.h"
 #include "Framework/O2DatabasePDGPlugin.h"
+#include "Framework/HistogramRegistry.h"
 
 #include "PWGJE/Core/FastJetUtilities.h"
 #include "PWGJE/Core/JetFindingUtilities.h"
@@ -47,6 +51,10 @@ struct eventWiseConstituentSubtractorTask {
   Configurable<float> rMax{"rMax", 0.24, "maximum distance of subtraction"};
   Configurable<float> eventEtaMax{"eventEtaMax", 0.9, "maximum pseudorapidity of event"};
   Configurable<bool> doRhoMassSub{"doRhoMassSub", true, "perfom mass subtraction as well"};
+  Configurable<bool> useNativeSubtraction{"useNativeSubtraction", false, "use the native implementation of the subtraction instead of the fastjet contrib one"};
+  Configurable<bool> doSubtractionComparison{"doSubtractionComparison", false, "run both implementations of the subtraction and compare their time and output"};
+
+  HistogramRegistry registry;
 
   JetBkgSubUtils eventWiseConstituentSubtractor;
   float bkgPhiMax_;
@@ -61,6 +69,38 @@ struct eventWiseConstituentSubtractorTask {
     eventWiseConstituentSubtractor.setDoRhoMassSub(doRhoMassSub);
     eventWiseConstituentSubtractor.setConstSubAlphaRMax(alpha, rMax);
     eventWiseConstituentSubtractor.setMaxEtaEvent(eventEtaMax);
+
+    if (doSubtractionComparison) {
+      registry.add("hTimeContrib", "time of the fastjet contrib subtraction;#it{t} (ms);entries", {HistType::kTH1F, {{500, 0., 100.}}});
+      registry.add("hTimeNative", "time of the native subtraction;#it{t} (ms);entries", {HistType::kTH1F, {{500, 0., 100.}}});
+      registry.add("hDeltaNParticles", "number of subtracted particles native - contrib;#Delta#it{N};entries", {HistType::kTH1F, {{41, -20.5, 20.5}}});
+      registry.add("hDeltaPtSum", "sum of the subtracted particle #it{p}_{T} native - contrib;#Delta#it{p}_{T} (GeV/#it{c});entries", {HistType::kTH1F, {{400, -1., 1.}}});
+    }
+  }
+
+  // subtracts the input particles with the selected implementation, and compares the two implementations if requested
+  std::vector<fastjet::PseudoJet> subtract(double rho, double rhoM)
+  {
+    if (!doSubtractionComparison) {
+      return useNativeSubtraction ? eventWiseConstituentSubtractor.doEventConstSubNative(inputParticles, rho, rhoM) : eventWiseConstituentSubtractor.doEventConstSub(inputParticles, rho, rhoM);
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto subtractedContrib = eventWiseConstituentSubtractor.doEventConstSub(inputParticles, rho, rhoM);
+    auto middle = std::chrono::steady_clock::now();
+    auto subtractedNative = eventWiseConstituentSubtractor.doEventConstSubNative(inputParticles, rho, rhoM);
+    auto end = std::chrono::steady_clock::now();
+    registry.fill(HIST("hTimeContrib"), std::chrono::duration<double, std::milli>(middle - start).count());
+    registry.fill(HIST("hTimeNative"), std::chrono::duration<double, std::milli>(end - middle).count());
+    registry.fill(HIST("hDeltaNParticles"), static_cast<int>(subtractedNative.size()) - static_cast<int>(subtractedContrib.size()));
+    double deltaPtSum = 0.;
+    for (const auto& particle : subtractedNative) {
+      deltaPtSum += particle.pt();
+    }
+    for (const auto& particle : subtractedContrib) {
+      deltaPtSum -= particle.pt();
+    }
+    registry.fill(HIST("hDeltaPtSum"), deltaPtSum);
+    return useNativeSubtraction ? subtractedNative : subtractedContrib;
   }
 
   Filter trackCuts = (aod::jtrack::pt >= trackPtMin && aod::jtrack::pt < trackPtMax && aod::jtrack::eta > trackEtaMin && aod::jtrack::eta < trackEtaMax && aod::jtrack::phi >= trackPhiMin && aod::jtrack::phi <= trackPhiMax);
@@ -82,7 +122,7 @@ struct eventWiseConstituentSubtractorTask {
       tracksSubtracted.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, std::optional{candidate});
 
-      tracksSubtracted = eventWiseConstituentSubtractor.JetBkgSubUtils::doEventConstSub(inputParticles, bkgRho.rho(), bkgRho.rhoM());
+      tracksSubtracted = subtract(bkgRho.rho(), bkgRho.rhoM());
       for (auto const& trackSubtracted : tracksSubtracted) {
 
         trackSubtractedTable(candidate.globalIndex(), trackSubtracted.pt(), trackSubtracted.eta(), trackSubtracted.phi(), trackSubtracted.E(), jetderiveddatautilities::setSingleTrackSelectionBit(trackSelection));
@@ -97,7 +137,7 @@ struct eventWiseConstituentSubtractorTask {
     tracksSubtracted.clear();
     jetfindingutilities::analyseTracks<soa::Filtered<JetTracks>, soa::Filtered<JetTracks>::iterator>(inputParticles, tracks, trackSelection);
 
-    tracksSubtracted = eventWiseConstituentSubtractor.JetBkgSubUtils::doEventConstSub(inputParticles, collision.rho(), collision.rhoM());
+    tracksSubtracted = subtract(collision.rho(), collision.rhoM());
 
     for (auto const& trackSubtracted : tracksSubtracted) {
       trackSubtractedTable(collision.globalIndex(), trackSubtracted.pt(), trackSubtracted.eta(), trackSubtracted.phi(), trackSubtracted.E(), jetderiveddatautilities::setSingleTrackSelectionBit(trackSelection));
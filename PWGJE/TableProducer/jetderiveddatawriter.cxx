@@ -18,6 +18,8 @@
 
 #include <MathUtils/Utils.h>
 #include <algorithm>
+#include <cstdint>
+#include <vector>
 
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -32,6 +34,42 @@ using namespace o2;
 using namespace o2::framework;
 using namespace o2::framework::expressions;
 
+// dense map from the global indices of a contiguous range of input rows to the indices of the stored rows (-1 if the row is not stored)
+// the memory is kept from one use to the next
+struct StoredIndexMapping {
+  // clears the mapping of the rows firstIndex, ..., firstIndex + size - 1
+  void reset(int64_t firstIndex, int64_t size)
+  {
+    offset = firstIndex;
+    storedIndices.assign(size, -1);
+  }
+
+  // the mapping is extended if the row is beyond the current range
+  void set(int64_t globalIndex, int32_t storedIndex)
+  {
+    const int64_t index = globalIndex - offset;
+    if (index >= static_cast<int64_t>(storedIndices.size())) {
+      storedIndices.resize(index + 1, -1);
+    }
+    storedIndices[index] = storedIndex;
+  }
+
+  int32_t get(int64_t globalIndex) const
+  {
+    const int64_t index = globalIndex - offset;
+    if (index < 0 || index >= static_cast<int64_t>(storedIndices.size())) {
+      return -1;
+    }
+    return storedIndices[index];
+  }
+
+  bool isStored(int64_t globalIndex) const { return get(globalIndex) >= 0; }
+
+ private:
+  int64_t offset = 0;
+  std::vector<int32_t> storedIndices;
+};
+
 struct JetDerivedDataWriter {
 
   Configurable<float> chargedJetPtMin{"chargedJetPtMin", 0.0, "Minimum charged jet pt to accept event"};
@@ -119,7 +157,14 @@ struct JetDerivedDataWriter {
 
   std::vector<bool> collisionFlag;
   std::vector<bool> McCollisionFlag;
-  std::vector<int> bcIndicies;
+
+  // index mappings from the input to the stored tables
+  StoredIndexMapping bcMapping;          // BCs of the dataframe
+  StoredIndexMapping trackMapping;       // tracks of the current collision
+  StoredIndexMapping particleMapping;    // particles of the dataframe
+  StoredIndexMapping mcCollisionMapping; // MC collisions of the dataframe
+  StoredIndexMapping D0CollisionMapping; // D0 collisions of the dataframe
+  StoredIndexMapping LcCollisionMapping; // Lc collisions of the dataframe
 
   uint32_t precisionPositionMask;
   uint32_t precisionMomentumMask;
@@ -142,6 +187,7 @@ struct JetDerivedDataWriter {
     collisionFlag.clear();
     collisionFlag.resize(collisions.size());
     std::fill(collisionFlag.begin(), collisionFlag.end(), false);
+    bcMapping.reset(0, 0);
   }
 
   void processMcCollisions(aod::JMcCollisions const& Mccollisions)
@@ -249,34 +295,26 @@ struct JetDerivedDataWriter {
 
   void processData(soa::Join<aod::JCollisions, aod::JCollisionPIs, aod::JCollisionBCs, aod::JChTrigSels, aod::JFullTrigSels, aod::JChHFTrigSels>::iterator const& collision, soa::Join<aod::JBCs, aod::JBCPIs> const&, soa::Join<aod::JTracks, aod::JTrackExtras, aod::JTrackPIs> const& tracks, soa::Join<aod::JClusters, aod::JClusterPIs, aod::JClusterTracks> const& clusters, CollisionsD0 const& D0Collisions, CandidatesD0Data const& D0s, CollisionsLc const& LcCollisions, CandidatesLcData const& Lcs)
   {
-    std::map<int32_t, int32_t> bcMapping;
-    std::map<int32_t, int32_t> trackMapping;
-
     if (collisionFlag[collision.globalIndex()]) {
       if (saveBCsTable) {
         auto bc = collision.bc_as<soa::Join<aod::JBCs, aod::JBCPIs>>();
-        if (std::find(bcIndicies.begin(), bcIndicies.end(), bc.globalIndex()) == bcIndicies.end()) {
+        if (!bcMapping.isStored(bc.globalIndex())) {
           storedJBCsTable(bc.runNumber(), bc.globalBC(), bc.timestamp());
           storedJBCParentIndexTable(bc.bcId());
-          bcIndicies.push_back(bc.globalIndex());
-          bcMapping.insert(std::make_pair(bc.globalIndex(), storedJBCsTable.lastIndex()));
+          bcMapping.set(bc.globalIndex(), storedJBCsTable.lastIndex());
         }
       }
 
       storedJCollisionsTable(collision.posX(), collision.posY(), collision.posZ(), collision.multiplicity(), collision.centrality(), collision.eventSel(), collision.alias_raw());
       storedJCollisionsParentIndexTable(collision.collisionId());
       if (saveBCsTable) {
-        int32_t storedBCID = -1;
-        auto JBCIndex = bcMapping.find(collision.bcId());
-        if (JBCIndex != bcMapping.end()) {
-          storedBCID = JBCIndex->second;
-        }
-        storedJCollisionsBunchCrossingIndexTable(storedBCID);
+        storedJCollisionsBunchCrossingIndexTable(bcMapping.get(collision.bcId()));
       }
       storedJChargedTriggerSelsTable(collision.chargedTriggerSel());
       storedJFullTriggerSelsTable(collision.fullTriggerSel());
       storedJChargedHFTriggerSelsTable(collision.chargedHFTriggerSel());
 
+      trackMapping.reset(tracks.size() > 0 ? tracks.begin().globalIndex() : 0, tracks.size());
       for (const auto& track : tracks) {
         if (performTrackSelection && !(track.trackSel() & ~(1 << jetderiveddatautilities::JTrackSel::trackSign))) { // skips tracks that pass no selections. This might cause a problem with tracks matched with clusters. We should generate a track selection purely for cluster matched tracks so that they are kept
           continue;
@@ -284,7 +322,7 @@ struct JetDerivedDataWriter {
         storedJTracksTable(storedJCollisionsTable.lastIndex(), o2::math_utils::detail::truncateFloatFraction(track.pt(), precisionMomentumMask), o2::math_utils::detail::truncateFloatFraction(track.eta(), precisionPositionMask), o2::math_utils::detail::truncateFloatFraction(track.phi(), precisionPositionMask), track.trackSel());
         storedJTracksExtraTable(o2::math_utils::detail::truncateFloatFraction(track.dcaXY(), precisionPositionMask), o2::math_utils::detail::truncateFloatFraction(track.dcaZ(), precisionPositionMask), o2::math_utils::detail::truncateFloatFraction(track.sigma1Pt(), precisionMomentumMask));
         storedJTracksParentIndexTable(track.trackId());
-        trackMapping.insert(std::make_pair(track.globalIndex(), storedJTracksTable.lastIndex()));
+        trackMapping.set(track.globalIndex(), storedJTracksTable.lastIndex());
       }
       if (saveClustersTable) {
         for (const auto& cluster : clusters) {
@@ -295,9 +333,8 @@ struct JetDerivedDataWriter {
 
           std::vector<int> clusterStoredJTrackIDs;
           for (const auto& clusterTrack : cluster.matchedTracks_as<soa::Join<aod::JTracks, aod::JTrackExtras, aod::JTrackPIs>>()) {
-            auto JtrackIndex = trackMapping.find(clusterTrack.globalIndex());
-            if (JtrackIndex != trackMapping.end()) {
-              clusterStoredJTrackIDs.push_back(JtrackIndex->second);
+            if (trackMapping.isStored(clusterTrack.globalIndex())) {
+              clusterStoredJTrackIDs.push_back(trackMapping.get(clusterTrack.globalIndex()));
             }
           }
           storedJClustersMatchedTracksTable(clusterStoredJTrackIDs);
@@ -314,16 +351,8 @@ struct JetDerivedDataWriter {
           int32_t D0Index = -1;
           jethfutilities::fillD0CandidateTable<false>(D0, collisionD0Index, storedD0sTable, storedD0ParsTable, storedD0ParExtrasTable, storedD0SelsTable, storedD0MlsTable, storedD0McsTable, D0Index);
 
-          int32_t prong0Id = -1;
-          int32_t prong1Id = -1;
-          auto JtrackIndex = trackMapping.find(D0.prong0Id());
-          if (JtrackIndex != trackMapping.end()) {
-            prong0Id = JtrackIndex->second;
-          }
-          JtrackIndex = trackMapping.find(D0.prong1Id());
-          if (JtrackIndex != trackMapping.end()) {
-            prong1Id = JtrackIndex->second;
-          }
+          int32_t prong0Id = trackMapping.get(D0.prong0Id());
+          int32_t prong1Id = trackMapping.get(D0.prong1Id());
           storedD0IdsTable(storedJCollisionsTable.lastIndex(), prong0Id, prong1Id);
         }
       }
@@ -338,21 +367,9 @@ struct JetDerivedDataWriter {
           int32_t LcIndex = -1;
           jethfutilities::fillLcCandidateTable<false>(Lc, collisionLcIndex, storedLcsTable, storedLcParsTable, storedLcParExtrasTable, storedLcSelsTable, storedLcMlsTable, storedLcMcsTable, LcIndex);
 
-          int32_t prong0Id = -1;
-          int32_t prong1Id = -1;
-          int32_t prong2Id = -1;
-          auto JtrackIndex = trackMapping.find(Lc.prong0Id());
-          if (JtrackIndex != trackMapping.end()) {
-            prong0Id = JtrackIndex->second;
-          }
-          JtrackIndex = trackMapping.find(Lc.prong1Id());
-          if (JtrackIndex != trackMapping.end()) {
-            prong1Id = JtrackIndex->second;
-          }
-          JtrackIndex = trackMapping.find(Lc.prong2Id());
-          if (JtrackIndex != trackMapping.end()) {
-            prong2Id = JtrackIndex->second;
-          }
+          int32_t prong0Id = trackMapping.get(Lc.prong0Id());
+          int32_t prong1Id = trackMapping.get(Lc.prong1Id());
+          int32_t prong2Id = trackMapping.get(Lc.prong2Id());
           storedLcIdsTable(storedJCollisionsTable.lastIndex(), prong0Id, prong1Id, prong2Id);
         }
       }
@@ -364,11 +381,10 @@ struct JetDerivedDataWriter {
 
   void processMC(soa::Join<aod::JMcCollisions, aod::JMcCollisionPIs> const& mcCollisions, soa::Join<aod::JCollisions, aod::JCollisionPIs, aod::JCollisionBCs, aod::JChTrigSels, aod::JFullTrigSels, aod::JChHFTrigSels, aod::JMcCollisionLbs> const& collisions, soa::Join<aod::JBCs, aod::JBCPIs> const&, soa::Join<aod::JTracks, aod::JTrackExtras, aod::JTrackPIs, aod::JMcTrackLbs> const& tracks, soa::Join<aod::JClusters, aod::JClusterPIs, aod::JClusterTracks, aod::JMcClusterLbs> const& clusters, soa::Join<aod::JMcParticles, aod::JMcParticlePIs> const& particles, CollisionsD0 const& D0Collisions, CandidatesD0MCD const& D0s, soa::Join<McCollisionsD0, aod::HfD0McRCollIds> const& D0McCollisions, CandidatesD0MCP const& D0Particles, CollisionsLc const& LcCollisions, CandidatesLcMCD const& Lcs, soa::Join<McCollisionsLc, aod::Hf3PMcRCollIds> const& LcMcCollisions, CandidatesLcMCP const& LcParticles)
   {
-    std::map<int32_t, int32_t> bcMapping;
-    std::map<int32_t, int32_t> paticleMapping;
-    std::map<int32_t, int32_t> mcCollisionMapping;
-    std::map<int32_t, int32_t> D0CollisionMapping;
-    std::map<int32_t, int32_t> LcCollisionMapping;
+    particleMapping.reset(0, particles.size());
+    mcCollisionMapping.reset(0, mcCollisions.size());
+    D0CollisionMapping.reset(0, D0Collisions.size());
+    LcCollisionMapping.reset(0, LcCollisions.size());
     int particleTableIndex = 0;
     for (auto mcCollision : mcCollisions) {
       bool collisionSelected = false;
@@ -385,10 +401,10 @@ struct JetDerivedDataWriter {
 
         storedJMcCollisionsTable(mcCollision.posX(), mcCollision.posY(), mcCollision.posZ(), mcCollision.weight());
         storedJMcCollisionsParentIndexTable(mcCollision.mcCollisionId());
-        mcCollisionMapping.insert(std::make_pair(mcCollision.globalIndex(), storedJMcCollisionsTable.lastIndex()));
+        mcCollisionMapping.set(mcCollision.globalIndex(), storedJMcCollisionsTable.lastIndex());
 
         for (auto particle : particlesPerMcCollision) {
-          paticleMapping.insert(std::make_pair(particle.globalIndex(), particleTableIndex));
+          particleMapping.set(particle.globalIndex(), particleTableIndex);
           particleTableIndex++;
         }
         for (auto particle : particlesPerMcCollision) {
@@ -398,9 +414,8 @@ struct JetDerivedDataWriter {
             auto mothersIdTemps = particle.mothersIds();
             for (auto mothersIdTemp : mothersIdTemps) {
 
-              auto JMotherIndex = paticleMapping.find(mothersIdTemp);
-              if (JMotherIndex != paticleMapping.end()) {
-                mothersId.push_back(JMotherIndex->second);
+              if (particleMapping.isStored(mothersIdTemp)) {
+                mothersId.push_back(particleMapping.get(mothersIdTemp));
               }
             }
           }
@@ -411,9 +426,8 @@ struct JetDerivedDataWriter {
               if (i > 1) {
                 break;
               }
-              auto JDaughterIndex = paticleMapping.find(daughterId);
-              if (JDaughterIndex != paticleMapping.end()) {
-                daughtersId[i] = JDaughterIndex->second;
+              if (particleMapping.isStored(daughterId)) {
+                daughtersId[i] = particleMapping.get(daughterId);
               }
               i++;
             }
@@ -432,11 +446,7 @@ struct JetDerivedDataWriter {
           for (const auto& D0Particle : D0Particles) {
             int32_t D0ParticleIndex = -1;
             jethfutilities::fillD0CandidateMcTable(D0Particle, mcCollisionD0Index, storedD0ParticlesTable, D0ParticleIndex);
-            int32_t d0ParticleId = -1;
-            auto JParticleIndex = paticleMapping.find(D0Particle.mcParticleId());
-            if (JParticleIndex != paticleMapping.end()) {
-              d0ParticleId = JParticleIndex->second;
-            }
+            int32_t d0ParticleId = particleMapping.get(D0Particle.mcParticleId());
             storedD0ParticleIdsTable(storedJMcCollisionsTable.lastIndex(), d0ParticleId);
           }
         }
@@ -451,11 +461,7 @@ struct JetDerivedDataWriter {
           for (const auto& LcParticle : LcParticles) {
             int32_t LcParticleIndex = -1;
             jethfutilities::fillLcCandidateMcTable(LcParticle, mcCollisionLcIndex, storedLcParticlesTable, LcParticleIndex);
-            int32_t LcParticleId = -1;
-            auto JParticleIndex = paticleMapping.find(LcParticle.mcParticleId());
-            if (JParticleIndex != paticleMapping.end()) {
-              LcParticleId = JParticleIndex->second;
-            }
+            int32_t LcParticleId = particleMapping.get(LcParticle.mcParticleId());
             storedLcParticleIdsTable(storedJMcCollisionsTable.lastIndex(), LcParticleId);
           }
         }
@@ -474,37 +480,30 @@ struct JetDerivedDataWriter {
       if (McCollisionFlag[mcCollision.globalIndex()] || collisionSelected) {
 
         for (auto collision : collisionsPerMcCollision) {
-          std::map<int32_t, int32_t> trackMapping;
           if (saveBCsTable) {
             auto bc = collision.bc_as<soa::Join<aod::JBCs, aod::JBCPIs>>();
-            if (std::find(bcIndicies.begin(), bcIndicies.end(), bc.globalIndex()) == bcIndicies.end()) {
+            if (!bcMapping.isStored(bc.globalIndex())) {
               storedJBCsTable(bc.runNumber(), bc.globalBC(), bc.timestamp());
               storedJBCParentIndexTable(bc.bcId());
-              bcIndicies.push_back(bc.globalIndex());
-              bcMapping.insert(std::make_pair(bc.globalIndex(), storedJBCsTable.lastIndex()));
+              bcMapping.set(bc.globalIndex(), storedJBCsTable.lastIndex());
             }
           }
 
           storedJCollisionsTable(collision.posX(), collision.posY(), collision.posZ(), collision.multiplicity(), collision.centrality(), collision.eventSel(), collision.alias_raw());
           storedJCollisionsParentIndexTable(collision.collisionId());
 
-          auto JMcCollisionIndex = mcCollisionMapping.find(mcCollision.globalIndex());
-          if (JMcCollisionIndex != mcCollisionMapping.end()) {
-            storedJMcCollisionsLabelTable(JMcCollisionIndex->second);
+          if (mcCollisionMapping.isStored(mcCollision.globalIndex())) {
+            storedJMcCollisionsLabelTable(mcCollisionMapping.get(mcCollision.globalIndex()));
           }
           if (saveBCsTable) {
-            int32_t storedBCID = -1;
-            auto JBCIndex = bcMapping.find(collision.bcId());
-            if (JBCIndex != bcMapping.end()) {
-              storedBCID = JBCIndex->second;
-            }
-            storedJCollisionsBunchCrossingIndexTable(storedBCID);
+            storedJCollisionsBunchCrossingIndexTable(bcMapping.get(collision.bcId()));
           }
           storedJChargedTriggerSelsTable(collision.chargedTriggerSel());
           storedJFullTriggerSelsTable(collision.fullTriggerSel());
           storedJChargedHFTriggerSelsTable(collision.chargedHFTriggerSel());
 
           const auto tracksPerCollision = tracks.sliceBy(TracksPerCollision, collision.globalIndex());
+          trackMapping.reset(tracksPerCollision.size() > 0 ? tracksPerCollision.begin().globalIndex() : 0, tracksPerCollision.size());
           for (const auto& track : tracksPerCollision) {
             if (performTrackSelection && !(track.trackSel() & ~(1 << jetderiveddatautilities::JTrackSel::trackSign))) { // skips tracks that pass no selections. This might cause a problem with tracks matched with clusters. We should generate a track selection purely for cluster matched tracks so that they are kept
               continue;
@@ -514,16 +513,15 @@ struct JetDerivedDataWriter {
             storedJTracksParentIndexTable(track.trackId());
 
             if (track.has_mcParticle()) {
-              auto JParticleIndex = paticleMapping.find(track.mcParticleId());
-              if (JParticleIndex != paticleMapping.end()) {
-                storedJMcTracksLabelTable(JParticleIndex->second);
+              if (particleMapping.isStored(track.mcParticleId())) {
+                storedJMcTracksLabelTable(particleMapping.get(track.mcParticleId()));
               } else {
                 storedJMcTracksLabelTable(-1); // this can happen because there are some tracks that are reconstucted in a wrong collision, but their original McCollision did not pass the required cuts so that McParticle is not saved. These are very few but we should look into them further and see what to do about them
               }
             } else {
               storedJMcTracksLabelTable(-1);
             }
-            trackMapping.insert(std::make_pair(track.globalIndex(), storedJTracksTable.lastIndex()));
+            trackMapping.set(track.globalIndex(), storedJTracksTable.lastIndex());
           }
           if (saveClustersTable) {
             const auto clustersPerCollision = clusters.sliceBy(ClustersPerCollision, collision.globalIndex());
@@ -535,18 +533,16 @@ struct JetDerivedDataWriter {
 
               std::vector<int> clusterStoredJTrackIDs;
               for (const auto& clusterTrack : cluster.matchedTracks_as<soa::Join<aod::JTracks, aod::JTrackExtras, aod::JTrackPIs>>()) {
-                auto JtrackIndex = trackMapping.find(clusterTrack.globalIndex());
-                if (JtrackIndex != trackMapping.end()) {
-                  clusterStoredJTrackIDs.push_back(JtrackIndex->second);
+                if (trackMapping.isStored(clusterTrack.globalIndex())) {
+                  clusterStoredJTrackIDs.push_back(trackMapping.get(clusterTrack.globalIndex()));
                 }
               }
               storedJClustersMatchedTracksTable(clusterStoredJTrackIDs);
 
               std::vector<int> clusterStoredJParticleIDs;
               for (const auto& clusterParticleId : cluster.mcParticleIds()) {
-                auto JParticleIndex = paticleMapping.find(clusterParticleId);
-                if (JParticleIndex != paticleMapping.end()) {
-                  clusterStoredJParticleIDs.push_back(JParticleIndex->second);
+                if (particleMapping.isStored(clusterParticleId)) {
+                  clusterStoredJParticleIDs.push_back(particleMapping.get(clusterParticleId));
                 }
               }
               std::vector<float> amplitudeA;
@@ -562,23 +558,15 @@ struct JetDerivedDataWriter {
             for (const auto& d0CollisionPerCollision : d0CollisionsPerCollision) { // should only ever be one
               jethfutilities::fillD0CollisionTable(d0CollisionPerCollision, storedD0CollisionsTable, collisionD0Index);
               storedD0CollisionIdsTable(storedJCollisionsTable.lastIndex());
-              D0CollisionMapping.insert(std::make_pair(d0CollisionPerCollision.globalIndex(), storedD0CollisionsTable.lastIndex()));
+              D0CollisionMapping.set(d0CollisionPerCollision.globalIndex(), storedD0CollisionsTable.lastIndex());
             }
             const auto d0sPerCollision = D0s.sliceBy(D0sPerCollision, collision.globalIndex());
             for (const auto& D0 : d0sPerCollision) {
               int32_t D0Index = -1;
               jethfutilities::fillD0CandidateTable<true>(D0, collisionD0Index, storedD0sTable, storedD0ParsTable, storedD0ParExtrasTable, storedD0SelsTable, storedD0MlsTable, storedD0McsTable, D0Index);
 
-              int32_t prong0Id = -1;
-              int32_t prong1Id = -1;
-              auto JtrackIndex = trackMapping.find(D0.prong0Id());
-              if (JtrackIndex != trackMapping.end()) {
-                prong0Id = JtrackIndex->second;
-              }
-              JtrackIndex = trackMapping.find(D0.prong1Id());
-              if (JtrackIndex != trackMapping.end()) {
-                prong1Id = JtrackIndex->second;
-              }
+              int32_t prong0Id = trackMapping.get(D0.prong0Id());
+              int32_t prong1Id = trackMapping.get(D0.prong1Id());
               storedD0IdsTable(storedJCollisionsTable.lastIndex(), prong0Id, prong1Id);
             }
           }
@@ -590,28 +578,16 @@ struct JetDerivedDataWriter {
             for (const auto& lcCollisionPerCollision : lcCollisionsPerCollision) { // should only ever be one
               jethfutilities::fillLcCollisionTable(lcCollisionPerCollision, storedLcCollisionsTable, collisionLcIndex);
               storedLcCollisionIdsTable(storedJCollisionsTable.lastIndex());
-              LcCollisionMapping.insert(std::make_pair(lcCollisionPerCollision.globalIndex(), storedLcCollisionsTable.lastIndex()));
+              LcCollisionMapping.set(lcCollisionPerCollision.globalIndex(), storedLcCollisionsTable.lastIndex());
             }
             const auto lcsPerCollision = Lcs.sliceBy(LcsPerCollision, collision.globalIndex());
             for (const auto& Lc : lcsPerCollision) {
               int32_t LcIndex = -1;
               jethfutilities::fillLcCandidateTable<true>(Lc, collisionLcIndex, storedLcsTable, storedLcParsTable, storedLcParExtrasTable, storedLcSelsTable, storedLcMlsTable, storedLcMcsTable, LcIndex);
 
-              int32_t prong0Id = -1;
-              int32_t prong1Id = -1;
-              int32_t prong2Id = -1;
-              auto JtrackIndex = trackMapping.find(Lc.prong0Id());
-              if (JtrackIndex != trackMapping.end()) {
-                prong0Id = JtrackIndex->second;
-              }
-              JtrackIndex = trackMapping.find(Lc.prong1Id());
-              if (JtrackIndex != trackMapping.end()) {
-                prong1Id = JtrackIndex->second;
-              }
-              JtrackIndex = trackMapping.find(Lc.prong2Id());
-              if (JtrackIndex != trackMapping.end()) {
-                prong2Id = JtrackIndex->second;
-              }
+              int32_t prong0Id = trackMapping.get(Lc.prong0Id());
+              int32_t prong1Id = trackMapping.get(Lc.prong1Id());
+              int32_t prong2Id = trackMapping.get(Lc.prong2Id());
               storedLcIdsTable(storedJCollisionsTable.lastIndex(), prong0Id, prong1Id, prong2Id);
             }
           }
@@ -622,9 +598,8 @@ struct JetDerivedDataWriter {
           for (const auto& d0McCollisionPerMcCollision : d0McCollisionsPerMcCollision) { // should just be one
             std::vector<int32_t> d0CollisionIDs;
             for (auto const& d0CollisionPerMcCollision : d0McCollisionPerMcCollision.template hfCollBases_as<CollisionsD0>()) {
-              auto d0CollisionIndex = D0CollisionMapping.find(d0CollisionPerMcCollision.globalIndex());
-              if (d0CollisionIndex != D0CollisionMapping.end()) {
-                d0CollisionIDs.push_back(d0CollisionIndex->second);
+              if (D0CollisionMapping.isStored(d0CollisionPerMcCollision.globalIndex())) {
+                d0CollisionIDs.push_back(D0CollisionMapping.get(d0CollisionPerMcCollision.globalIndex()));
               }
             }
             storedD0McCollisionsMatchingTable(d0CollisionIDs);
@@ -636,9 +611,8 @@ struct JetDerivedDataWriter {
           for (const auto& lcMcCollisionPerMcCollision : lcMcCollisionsPerMcCollision) { // should just be one
             std::vector<int32_t> lcCollisionIDs;
             for (auto const& lcCollisionPerMcCollision : lcMcCollisionPerMcCollision.template hfCollBases_as<CollisionsLc>()) {
-              auto lcCollisionIndex = LcCollisionMapping.find(lcCollisionPerMcCollision.globalIndex());
-              if (lcCollisionIndex != LcCollisionMapping.end()) {
-                lcCollisionIDs.push_back(lcCollisionIndex->second);
+              if (LcCollisionMapping.isStored(lcCollisionPerMcCollision.globalIndex())) {
+                lcCollisionIDs.push_back(LcCollisionMapping.get(lcCollisionPerMcCollision.globalIndex()));
               }
             }
             storedLcMcCollisionsMatchingTable(lcCollisionIDs);
@@ -653,11 +627,10 @@ struct JetDerivedDataWriter {
 
   void processMCP(soa::Join<aod::JMcCollisions, aod::JMcCollisionPIs> const& mcCollisions, soa::Join<aod::JMcParticles, aod::JMcParticlePIs> const& particles, McCollisionsD0 const& D0McCollisions, CandidatesD0MCP const& D0Particles, McCollisionsLc const& LcMcCollisions, CandidatesLcMCP const& LcParticles)
   {
-
+    particleMapping.reset(0, particles.size());
     int particleTableIndex = 0;
     for (auto mcCollision : mcCollisions) {
       if (McCollisionFlag[mcCollision.globalIndex()]) { // you can also check if any of its detector level counterparts are correct
-        std::map<int32_t, int32_t> paticleMapping;
 
         storedJMcCollisionsTable(mcCollision.posX(), mcCollision.posY(), mcCollision.posZ(), mcCollision.weight());
         storedJMcCollisionsParentIndexTable(mcCollision.mcCollisionId());
@@ -665,19 +638,18 @@ struct JetDerivedDataWriter {
         const auto particlesPerMcCollision = particles.sliceBy(ParticlesPerMcCollision, mcCollision.globalIndex());
 
         for (auto particle : particlesPerMcCollision) {
-          paticleMapping.insert(std::make_pair(particle.globalIndex(), particleTableIndex));
+          particleMapping.set(particle.globalIndex(), particleTableIndex);
           particleTableIndex++;
         }
         for (auto particle : particlesPerMcCollision) {
 
           std::vector<int> mothersId;
-          int daughtersId[2];
+          int daughtersId[2] = {-1, -1};
           if (particle.has_mothers()) {
             for (auto const& mother : particle.template mothers_as<soa::Join<aod::JMcParticles, aod::JMcParticlePIs>>()) {
 
-              auto JMotherIndex = paticleMapping.find(mother.globalIndex());
-              if (JMotherIndex != paticleMapping.end()) {
-                mothersId.push_back(JMotherIndex->second);
+              if (particleMapping.isStored(mother.globalIndex())) {
+                mothersId.push_back(particleMapping.get(mother.globalIndex()));
               }
             }
           }
@@ -687,9 +659,8 @@ struct JetDerivedDataWriter {
               if (i > 1) {
                 break;
               }
-              auto JDaughterIndex = paticleMapping.find(daughter.globalIndex());
-              if (JDaughterIndex != paticleMapping.end()) {
-                daughtersId[i] = JDaughterIndex->second;
+              if (particleMapping.isStored(daughter.globalIndex())) {
+                daughtersId[i] = particleMapping.get(daughter.globalIndex());
               }
               i++;
             }
@@ -708,11 +679,7 @@ struct JetDerivedDataWriter {
           for (const auto& D0Particle : D0Particles) {
             int32_t D0ParticleIndex = -1;
             jethfutilities::fillD0CandidateMcTable(D0Particle, mcCollisionD0Index, storedD0ParticlesTable, D0ParticleIndex);
-            int32_t d0ParticleId = -1;
-            auto JParticleIndex = paticleMapping.find(D0Particle.mcParticleId());
-            if (JParticleIndex != paticleMapping.end()) {
-              d0ParticleId = JParticleIndex->second;
-            }
+            int32_t d0ParticleId = particleMapping.get(D0Particle.mcParticleId());
             storedD0ParticleIdsTable(storedJMcCollisionsTable.lastIndex(), d0ParticleId);
           }
         }
@@ -726,11 +693,7 @@ struct JetDerivedDataWriter {
           for (const auto& LcParticle : LcParticles) {
             int32_t LcParticleIndex = -1;
             jethfutilities::fillLcCandidateMcTable(LcParticle, mcCollisionLcIndex, storedLcParticlesTable, LcParticleIndex);
-            int32_t LcParticleId = -1;
-            auto JParticleIndex = paticleMapping.find(LcParticle.mcParticleId());
-            if (JParticleIndex != paticleMapping.end()) {
-              LcParticleId = JParticleIndex->second;
-            }
+            int32_t LcParticleId = particleMapping.get(LcParticle.mcParticleId());
             storedLcParticleIdsTable(storedJMcCollisionsTable.lastIndex(), LcParticleId);
           }
         }
@@ -31,6 +31,7 @@ using namespace o2::framework::expressions;
 
 struct RhoEstimatorTask {
   Produces<aod::BkgChargedRhos> rhoChargedTable;
+  Produces<aod::BkgChargedRhoEstimators> rhoChargedEstimatorsTable;
   Produces<aod::BkgD0Rhos> rhoD0Table;
   Produces<aod::BkgLcRhos> rhoLcTable;
   Produces<aod::BkgBplusRhos> rhoBplusTable;
@@ -78,6 +79,16 @@ struct RhoEstimatorTask {
   }
   PROCESS_SWITCH(RhoEstimatorTask, processChargedCollisions, "Fill rho tables for collisions using charged tracks", true);
 
+  void processChargedCollisionsAllEstimators(JetCollision const& collision, soa::Filtered<JetTracks> const& tracks)
+  {
+    inputParticles.clear();
+    jetfindingutilities::analyseTracks<soa::Filtered<JetTracks>, soa::Filtered<JetTracks>::iterator>(inputParticles, tracks, trackSelection);
+    auto [rho, rhoM, rhoSparse, rhoMSparse, rhoPerpCone, rhoMPerpCone] = bkgSub.estimateRhos(inputParticles);
+    rhoChargedTable(collision.globalIndex(), doSparse ? rhoSparse : rho, doSparse ? rhoMSparse : rhoM);
+    rhoChargedEstimatorsTable(rhoSparse, rhoMSparse, rhoPerpCone, rhoMPerpCone);
+  }
+  PROCESS_SWITCH(RhoEstimatorTask, processChargedCollisionsAllEstimators, "Fill rho tables for collisions using charged tracks, with all the estimators from a single clustering", false);
+
   void processD0Collisions(JetCollision const&, soa::Filtered<JetTracks> const& tracks, CandidatesD0Data const& candidates)
   {
     inputParticles.clear();
@@ -13,7 +13,12 @@
 //
 /// \author Hadi Hassan <hadi.hassan@cern.ch>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
 #include <type_traits>
+#include <vector>
 
 #include <TF1.h>
 #include <TH1.h>
@@ -66,6 +71,8 @@ struct SecondaryVertexReconstruction {
   Configurable<float> ptMinTrack{"ptMinTrack", -1., "min. track pT"};
   Configurable<float> etaMinTrack{"etaMinTrack", -99999., "min. pseudorapidity"};
   Configurable<float> etaMaxTrack{"etaMaxTrack", 4., "max. pseudorapidity"};
+  Configurable<float> prongIPxySigMin{"prongIPxySigMin", -1., "min. transverse impact parameter significance of the prongs (prefilter before the vertex fit, disabled if negative)"};
+  Configurable<float> pairDcaMax{"pairDcaMax", -1., "max. DCA of the straight-line extrapolations of each prong pair in cm (prefilter before the vertex fit, disabled if negative)"};
   Configurable<bool> fillHistograms{"fillHistograms", true, "do validation plots"};
 
   Configurable<std::string> ccdbUrl{"ccdbUrl", "http://alice-ccdb.cern.ch", "url of the ccdb repository"};
@@ -125,146 +132,273 @@ struct SecondaryVertexReconstruction {
   using JetTracksMCDwPIs = soa::Filtered<soa::Join<JetTracksMCD, aod::JTrackPIs>>;
   using OriginalTracks = soa::Join<aod::Tracks, aod::TracksCov, aod::TrackSelection, aod::TracksDCA, aod::TracksDCACov>;
 
-  template <unsigned int numProngs, typename AnyCollision, typename AnyJet, typename AnyParticles>
-  void runCreatorNProng(AnyCollision const& collision,
-                        AnyJet const& analysisJet,
-                        AnyParticles const& listoftracks,
-                        std::vector<int>& svIndices,
-                        o2::vertexing::DCAFitterN<numProngs>& df,
-                        size_t prongIndex = 0,
-                        std::vector<size_t> currentCombination = {})
+  // prong candidate of a jet, with the track position and momentum at its reference point for the pair DCA prefilter
+  struct SecondaryVertexProng {
+    int64_t trackId;
+    std::array<float, 3> position;
+    std::array<float, 3> momentum;
+  };
+
+  // jet-independent result of the vertex fit of a combination of prongs
+  template <unsigned int numProngs>
+  struct SecondaryVertexCandidate {
+    bool isValid = false;
+    std::array<float, 3> secondaryVertex;
+    std::array<float, 3> momentum;
+    double energySV;
+    double massSV;
+    float chi2PCA;
+    float errorDecayLength;
+    float errorDecayLengthXY;
+    float decayLengthNormalised;
+    float decayLengthXYNormalised;
+    std::array<float, numProngs> ptProngs;
+    std::array<float, numProngs> dcaXYProngs;
+    std::array<float, numProngs> dcaZProngs;
+  };
+
+  // the fits are done once per collision for each combination of tracks, so that jets sharing tracks (e.g. different R) reuse them
+  std::map<std::array<int64_t, 2>, SecondaryVertexCandidate<2>> sv2ProngCache;
+  std::map<std::array<int64_t, 3>, SecondaryVertexCandidate<3>> sv3ProngCache;
+  std::vector<SecondaryVertexProng> jetProngs;
+  std::vector<uint8_t> isPairAccepted;
+
+  template <unsigned int numProngs>
+  auto& getSecondaryVertexCache()
   {
+    if constexpr (numProngs == 2) {
+      return sv2ProngCache;
+    } else {
+      return sv3ProngCache;
+    }
+  }
 
-    const auto& particles = analysisJet.template tracks_as<AnyParticles>();
+  void clearSecondaryVertexCaches()
+  {
+    sv2ProngCache.clear();
+    sv3ProngCache.clear();
+  }
 
-    if (currentCombination.size() == numProngs) {
-      // Create an array of track parameters and covariance matrices for the current combination
-      std::array<o2::track::TrackParametrizationWithError<float>, numProngs> trackParVars;
-      double energySV = 0.;
-      for (unsigned int inum = 0; inum < numProngs; ++inum) {
-        const auto& prong = particles[currentCombination[inum]].template track_as<OriginalTracks>();
-        energySV += prong.energy(o2::constants::physics::MassPiPlus);
-        trackParVars[inum] = getTrackParCov(prong);
-      }
+  // distance of closest approach of the straight-line extrapolations of two prongs
+  static float getPairDCA(const SecondaryVertexProng& prong0, const SecondaryVertexProng& prong1)
+  {
+    const auto& d0 = prong0.momentum;
+    const auto& d1 = prong1.momentum;
+    std::array<float, 3> w = {prong0.position[0] - prong1.position[0], prong0.position[1] - prong1.position[1], prong0.position[2] - prong1.position[2]};
+    const float a = d0[0] * d0[0] + d0[1] * d0[1] + d0[2] * d0[2];
+    const float b = d0[0] * d1[0] + d0[1] * d1[1] + d0[2] * d1[2];
+    const float c = d1[0] * d1[0] + d1[1] * d1[1] + d1[2] * d1[2];
+    const float d = d0[0] * w[0] + d0[1] * w[1] + d0[2] * w[2];
+    const float e = d1[0] * w[0] + d1[1] * w[1] + d1[2] * w[2];
+    const float denominator = a * c - b * b;
+    float t0 = 0.f;
+    float t1 = e / c;
+    if (denominator > 1.e-6f * a * c) { // not parallel
+      t0 = (b * e - c * d) / denominator;
+      t1 = (a * e - b * d) / denominator;
+    }
+    for (int i = 0; i < 3; i++) {
+      w[i] += t0 * d0[i] - t1 * d1[i];
+    }
+    return std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+  }
 
-      auto bc = collision.template bc_as<aod::BCsWithTimestamps>();
-      if (runNumber != bc.runNumber()) {
-        initCCDB(bc, runNumber, ccdb, ccdbPathGrpMag, lut, false);
-        bz = o2::base::Propagator::Instance()->getNominalBz();
-      }
+  template <unsigned int numProngs, typename AnyCollision>
+  void fitSecondaryVertex(AnyCollision const& collision,
+                          std::array<int64_t, numProngs> const& trackIds,
+                          OriginalTracks const& tracks,
+                          o2::vertexing::DCAFitterN<numProngs>& df,
+                          SecondaryVertexCandidate<numProngs>& candidate)
+  {
+    // Create an array of track parameters and covariance matrices for the current combination
+    std::array<o2::track::TrackParametrizationWithError<float>, numProngs> trackParVars;
+    candidate.energySV = 0.;
+    for (unsigned int inum = 0; inum < numProngs; ++inum) {
+      const auto& prong = tracks.rawIteratorAt(trackIds[inum]);
+      candidate.energySV += prong.energy(o2::constants::physics::MassPiPlus);
+      candidate.ptProngs[inum] = prong.pt();
+      trackParVars[inum] = getTrackParCov(prong);
+    }
 
-      // Use a different fitter depending on the number of prongs
-      df.setBz(bz);
+    // Reconstruct the secondary vertex
+    int processResult = 0;
+    std::apply([&df, &processResult](const auto&... elems) { processResult = df.process(elems...); }, trackParVars);
+    if (processResult == 0) {
+      candidate.isValid = false;
+      return;
+    }
+    candidate.isValid = true;
 
-      // Reconstruct the secondary vertex
-      int processResult = 0;
-      std::apply([&df, &processResult](const auto&... elems) { processResult = df.process(elems...); }, trackParVars);
-      if (processResult == 0) {
-        return;
+    const auto& secondaryVertex = df.getPCACandidate();
+    candidate.chi2PCA = df.getChi2AtPCACandidate();
+    auto covMatrixPCA = df.calcPCACovMatrixFlat();
+    for (int i = 0; i < 3; i++) {
+      candidate.secondaryVertex[i] = secondaryVertex[i];
+    }
+
+    // get track impact parameters
+    // This modifies track momenta!
+    auto primaryVertex = getPrimaryVertex(collision);
+    auto covMatrixPV = primaryVertex.getCov();
+
+    // Get track momenta and impact parameters
+    std::array<std::array<float, 3>, numProngs> arrayMomenta;
+    std::array<o2::dataformats::DCA, numProngs> impactParameters;
+    candidate.momentum = {0.f, 0.f, 0.f};
+    for (unsigned int inum = 0; inum < numProngs; ++inum) {
+      trackParVars[inum].getPxPyPzGlo(arrayMomenta[inum]);
+      trackParVars[inum].propagateToDCA(primaryVertex, bz, &impactParameters[inum]);
+      candidate.dcaXYProngs[inum] = impactParameters[inum].getY();
+      candidate.dcaZProngs[inum] = impactParameters[inum].getZ();
+      for (int i = 0; i < 3; i++) {
+        candidate.momentum[i] += arrayMomenta[inum][i];
       }
+    }
 
-      const auto& secondaryVertex = df.getPCACandidate();
-      auto chi2PCA = df.getChi2AtPCACandidate();
-      auto covMatrixPCA = df.calcPCACovMatrixFlat();
+    // get uncertainty of the decay length
+    double phi, theta;
+    getPointDirection(std::array{primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, secondaryVertex, phi, theta);
+    candidate.errorDecayLength = std::sqrt(getRotatedCovMatrixXX(covMatrixPV, phi, theta) + getRotatedCovMatrixXX(covMatrixPCA, phi, theta));
+    candidate.errorDecayLengthXY = std::sqrt(getRotatedCovMatrixXX(covMatrixPV, phi, 0.) + getRotatedCovMatrixXX(covMatrixPCA, phi, 0.));
+    candidate.decayLengthNormalised = RecoDecay::distance(std::array{primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, std::array{secondaryVertex[0], secondaryVertex[1], secondaryVertex[2]}) / candidate.errorDecayLength;
+    candidate.decayLengthXYNormalised = RecoDecay::distanceXY(std::array{primaryVertex.getX(), primaryVertex.getY()}, std::array{secondaryVertex[0], secondaryVertex[1]}) / candidate.errorDecayLengthXY;
+
+    // calculate invariant mass
+    std::array<double, numProngs> massArray;
+    std::fill(massArray.begin(), massArray.end(), o2::constants::physics::MassPiPlus);
+    candidate.massSV = RecoDecay::m(std::move(arrayMomenta), massArray);
+  }
 
-      // get track impact parameters
-      // This modifies track momenta!
-      auto primaryVertex = getPrimaryVertex(collision);
-      auto covMatrixPV = primaryVertex.getCov();
+  template <unsigned int numProngs, typename AnyCollision, typename AnyJet>
+  void fillSecondaryVertex(AnyCollision const& collision, AnyJet const& analysisJet, SecondaryVertexCandidate<numProngs> const& candidate, std::vector<int>& svIndices)
+  {
+    const auto& secondaryVertex = candidate.secondaryVertex;
+    const auto& momentum = candidate.momentum;
+
+    // fill candidate table rows
+    if (doprocessData3Prongs && numProngs == 3) {
+      sv3prongTableData(analysisJet.globalIndex(),
+                        collision.posX(), collision.posY(), collision.posZ(),
+                        secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
+                        momentum[0], momentum[1], momentum[2],
+                        candidate.energySV, candidate.massSV, candidate.chi2PCA, candidate.errorDecayLength, candidate.errorDecayLengthXY);
+      svIndices.push_back(sv3prongTableData.lastIndex());
+    } else if (doprocessData2Prongs && numProngs == 2) {
+      sv2prongTableData(analysisJet.globalIndex(),
+                        collision.posX(), collision.posY(), collision.posZ(),
+                        secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
+                        momentum[0], momentum[1], momentum[2],
+                        candidate.energySV, candidate.massSV, candidate.chi2PCA, candidate.errorDecayLength, candidate.errorDecayLengthXY);
+      svIndices.push_back(sv2prongTableData.lastIndex());
+    } else if (doprocessMCD3Prongs && numProngs == 3) {
+      sv3prongTableMCD(analysisJet.globalIndex(),
+                       collision.posX(), collision.posY(), collision.posZ(),
+                       secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
+                       momentum[0], momentum[1], momentum[2],
+                       candidate.energySV, candidate.massSV, candidate.chi2PCA, candidate.errorDecayLength, candidate.errorDecayLengthXY);
+      svIndices.push_back(sv3prongTableMCD.lastIndex());
+    } else if (doprocessMCD2Prongs && numProngs == 2) {
+      sv2prongTableMCD(analysisJet.globalIndex(),
+                       collision.posX(), collision.posY(), collision.posZ(),
+                       secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
+                       momentum[0], momentum[1], momentum[2],
+                       candidate.energySV, candidate.massSV, candidate.chi2PCA, candidate.errorDecayLength, candidate.errorDecayLengthXY);
+      svIndices.push_back(sv2prongTableMCD.lastIndex());
+    } else {
+      LOG(error) << "No process specified\n";
+    }
 
-      // Get track momenta and impact parameters
-      std::array<std::array<float, 3>, numProngs> arrayMomenta;
-      std::array<o2::dataformats::DCA, numProngs> impactParameters;
+    // fill histograms
+    if (fillHistograms) {
       for (unsigned int inum = 0; inum < numProngs; ++inum) {
-        trackParVars[inum].getPxPyPzGlo(arrayMomenta[inum]);
-        trackParVars[inum].propagateToDCA(primaryVertex, bz, &impactParameters[inum]);
-
-        if (fillHistograms) {
-          const auto& prong = particles[currentCombination[inum]].template track_as<OriginalTracks>();
-          registry.fill(HIST("hDcaXYNProngs"), prong.pt(), impactParameters[inum].getY() * toMicrometers, numProngs);
-          registry.fill(HIST("hDcaZNProngs"), prong.pt(), impactParameters[inum].getZ() * toMicrometers, numProngs);
-        }
+        registry.fill(HIST("hDcaXYNProngs"), candidate.ptProngs[inum], candidate.dcaXYProngs[inum] * toMicrometers, numProngs);
+        registry.fill(HIST("hDcaZNProngs"), candidate.ptProngs[inum], candidate.dcaZProngs[inum] * toMicrometers, numProngs);
       }
+      registry.fill(HIST("hMassNProngs"), candidate.massSV, numProngs);
+      registry.fill(HIST("hLxySNProngs"), candidate.decayLengthXYNormalised, numProngs);
+      registry.fill(HIST("hLSNProngs"), candidate.decayLengthNormalised, numProngs);
+      registry.fill(HIST("hFeNProngs"), candidate.energySV / analysisJet.energy() > 1. ? 0.99 : candidate.energySV / analysisJet.energy(), numProngs);
+    }
+  }
 
-      // get uncertainty of the decay length
-      double phi, theta;
-      getPointDirection(std::array{primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, secondaryVertex, phi, theta);
-      auto errorDecayLength = std::sqrt(getRotatedCovMatrixXX(covMatrixPV, phi, theta) + getRotatedCovMatrixXX(covMatrixPCA, phi, theta));
-      auto errorDecayLengthXY = std::sqrt(getRotatedCovMatrixXX(covMatrixPV, phi, 0.) + getRotatedCovMatrixXX(covMatrixPCA, phi, 0.));
-
-      // calculate invariant mass
-      std::array<double, numProngs> massArray;
-      std::fill(massArray.begin(), massArray.end(), o2::constants::physics::MassPiPlus);
-      double massSV = RecoDecay::m(std::move(arrayMomenta), massArray);
-
-      // fill candidate table rows
-      if (doprocessData3Prongs && numProngs == 3) {
-        sv3prongTableData(analysisJet.globalIndex(),
-                          primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
-                          secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
-                          arrayMomenta[0][0] + arrayMomenta[1][0] + arrayMomenta[2][0],
-                          arrayMomenta[0][1] + arrayMomenta[1][1] + arrayMomenta[2][1],
-                          arrayMomenta[0][2] + arrayMomenta[1][2] + arrayMomenta[2][2],
-                          energySV, massSV, chi2PCA, errorDecayLength, errorDecayLengthXY);
-        svIndices.push_back(sv3prongTableData.lastIndex());
-      } else if (doprocessData2Prongs && numProngs == 2) {
-        sv2prongTableData(analysisJet.globalIndex(),
-                          primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
-                          secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
-                          arrayMomenta[0][0] + arrayMomenta[1][0],
-                          arrayMomenta[0][1] + arrayMomenta[1][1],
-                          arrayMomenta[0][2] + arrayMomenta[1][2],
-                          energySV, massSV, chi2PCA, errorDecayLength, errorDecayLengthXY);
-        svIndices.push_back(sv2prongTableData.lastIndex());
-      } else if (doprocessMCD3Prongs && numProngs == 3) {
-        sv3prongTableMCD(analysisJet.globalIndex(),
-                         primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
-                         secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
-                         arrayMomenta[0][0] + arrayMomenta[1][0] + arrayMomenta[2][0],
-                         arrayMomenta[0][1] + arrayMomenta[1][1] + arrayMomenta[2][1],
-                         arrayMomenta[0][2] + arrayMomenta[1][2] + arrayMomenta[2][2],
-                         energySV, massSV, chi2PCA, errorDecayLength, errorDecayLengthXY);
-        svIndices.push_back(sv3prongTableMCD.lastIndex());
-      } else if (doprocessMCD2Prongs && numProngs == 2) {
-        sv2prongTableMCD(analysisJet.globalIndex(),
-                         primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
-                         secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
-                         arrayMomenta[0][0] + arrayMomenta[1][0],
-                         arrayMomenta[0][1] + arrayMomenta[1][1],
-                         arrayMomenta[0][2] + arrayMomenta[1][2],
-                         energySV, massSV, chi2PCA, errorDecayLength, errorDecayLengthXY);
-        svIndices.push_back(sv2prongTableMCD.lastIndex());
-      } else {
-        LOG(error) << "No process specified\n";
+  template <unsigned int numProngs, typename AnyCollision, typename AnyJet, typename AnyParticles>
+  void runCreatorNProng(AnyCollision const& collision,
+                        AnyJet const& analysisJet,
+                        AnyParticles const& /*listoftracks*/,
+                        OriginalTracks const& tracks,
+                        std::vector<int>& svIndices,
+                        o2::vertexing::DCAFitterN<numProngs>& df)
+  {
+    // prong candidates passing the track selection and the impact parameter prefilter
+    jetProngs.clear();
+    for (const auto& particle : analysisJet.template tracks_as<AnyParticles>()) {
+      const auto& track = particle.template track_as<OriginalTracks>();
+      if (track.pt() < ptMinTrack || track.eta() < etaMinTrack || track.eta() > etaMaxTrack) {
+        continue;
       }
-
-      // fill histograms
-      if (fillHistograms) {
-        double DecayLengthNormalised = RecoDecay::distance(std::array{primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, std::array{secondaryVertex[0], secondaryVertex[1], secondaryVertex[2]}) / errorDecayLength;
-        double DecayLengthXYNormalised = RecoDecay::distanceXY(std::array{primaryVertex.getX(), primaryVertex.getY()}, std::array{secondaryVertex[0], secondaryVertex[1]}) / errorDecayLengthXY;
-
-        registry.fill(HIST("hMassNProngs"), massSV, numProngs);
-        registry.fill(HIST("hLxySNProngs"), DecayLengthXYNormalised, numProngs);
-        registry.fill(HIST("hLSNProngs"), DecayLengthNormalised, numProngs);
-        registry.fill(HIST("hFeNProngs"), energySV / analysisJet.energy() > 1. ? 0.99 : energySV / analysisJet.energy(), numProngs);
+      if (prongIPxySigMin > 0. && std::abs(track.dcaXY()) < prongIPxySigMin * std::sqrt(track.sigmaDcaXY2())) {
+        continue;
       }
-
+      auto& prong = jetProngs.emplace_back();
+      prong.trackId = track.globalIndex();
+      auto trackPar = getTrackPar(track);
+      trackPar.getXYZGlo(prong.position);
+      trackPar.getPxPyPzGlo(prong.momentum);
+    }
+    const size_t nProngs = jetProngs.size();
+    if (nProngs < numProngs) {
       return;
     }
-
-    // Recursive call to explore all combinations
-    for (size_t iprong = prongIndex; iprong < particles.size(); ++iprong) {
-
-      const auto& testTrack = particles[iprong].template track_as<OriginalTracks>();
-      if (testTrack.pt() < ptMinTrack || testTrack.eta() < etaMinTrack || testTrack.eta() > etaMaxTrack) {
-        continue;
+    // the combinations are ordered by track index, so that each of them is fitted once per collision
+    std::sort(jetProngs.begin(), jetProngs.end(), [](const auto& a, const auto& b) { return a.trackId < b.trackId; });
+
+    // analytical pair DCA of all the prong pairs of the jet
+    isPairAccepted.assign(nProngs * nProngs, 1);
+    if (pairDcaMax > 0.) {
+      for (size_t iprong = 0; iprong < nProngs; ++iprong) {
+        for (size_t jprong = iprong + 1; jprong < nProngs; ++jprong) {
+          isPairAccepted[iprong * nProngs + jprong] = getPairDCA(jetProngs[iprong], jetProngs[jprong]) < pairDcaMax;
+        }
       }
+    }
 
-      currentCombination.push_back(iprong);
-      runCreatorNProng<numProngs>(
-        collision, analysisJet, listoftracks, svIndices, df, iprong + 1, currentCombination);
-      currentCombination.pop_back();
+    auto bc = collision.template bc_as<aod::BCsWithTimestamps>();
+    if (runNumber != bc.runNumber()) {
+      initCCDB(bc, runNumber, ccdb, ccdbPathGrpMag, lut, false);
+      bz = o2::base::Propagator::Instance()->getNominalBz();
     }
+    // Use a different fitter depending on the number of prongs
+    df.setBz(bz);
+
+    auto& cache = getSecondaryVertexCache<numProngs>();
+    std::array<size_t, numProngs> combination;
+    std::array<int64_t, numProngs> trackIds;
+    // explore all combinations iprong0 < iprong1 < ... with all their pairs accepted
+    auto addProng = [&](auto& self, unsigned int depth, size_t firstProng) -> void {
+      for (size_t iprong = firstProng; iprong + numProngs - depth <= nProngs; ++iprong) {
+        bool isAccepted = true;
+        for (unsigned int iprevious = 0; iprevious < depth && isAccepted; ++iprevious) {
+          isAccepted = isPairAccepted[combination[iprevious] * nProngs + iprong];
+        }
+        if (!isAccepted) {
+          continue;
+        }
+        combination[depth] = iprong;
+        trackIds[depth] = jetProngs[iprong].trackId;
+        if (depth + 1 < numProngs) {
+          self(self, depth + 1, iprong + 1);
+          continue;
+        }
+        auto [candidateIt, isNew] = cache.try_emplace(trackIds);
+        if (isNew) {
+          fitSecondaryVertex<numProngs>(collision, trackIds, tracks, df, candidateIt->second);
+        }
+        if (candidateIt->second.isValid) {
+          fillSecondaryVertex<numProngs>(collision, analysisJet, candidateIt->second, svIndices);
+        }
+      }
+    };
+    addProng(addProng, 0, 0);
   }
 
   void processDummy(JetCollisionwPIs::iterator const& /*collision*/)
@@ -272,41 +406,45 @@ struct SecondaryVertexReconstruction {
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processDummy, "Dummy process", true);
 
-  void processData3Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& jtracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
+  void processData3Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& jtracks, OriginalTracks const& tracks, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
+    clearSecondaryVertexCaches();
     for (auto& jet : jets) {
       std::vector<int> svIndices;
-      runCreatorNProng<3>(collision.template collision_as<aod::Collisions>(), jet, jtracks, svIndices, df3);
+      runCreatorNProng<3>(collision.template collision_as<aod::Collisions>(), jet, jtracks, tracks, svIndices, df3);
       sv3prongIndicesTableData(svIndices);
     }
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processData3Prongs, "Reconstruct the data 3-prong secondary vertex", false);
 
-  void processData2Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& jtracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
+  void processData2Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& jtracks, OriginalTracks const& tracks, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
+    clearSecondaryVertexCaches();
     for (auto& jet : jets) {
       std::vector<int> svIndices;
-      runCreatorNProng<2>(collision.template collision_as<aod::Collisions>(), jet, jtracks, svIndices, df2);
+      runCreatorNProng<2>(collision.template collision_as<aod::Collisions>(), jet, jtracks, tracks, svIndices, df2);
       sv2prongIndicesTableData(svIndices);
     }
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processData2Prongs, "Reconstruct the data 2-prong secondary vertex", false);
 
-  void processMCD3Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& jtracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
+  void processMCD3Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& jtracks, OriginalTracks const& tracks, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
+    clearSecondaryVertexCaches();
     for (auto& jet : mcdjets) {
       std::vector<int> svIndices;
-      runCreatorNProng<3>(collision.template collision_as<aod::Collisions>(), jet, jtracks, svIndices, df3);
+      runCreatorNProng<3>(collision.template collision_as<aod::Collisions>(), jet, jtracks, tracks, svIndices, df3);
       sv3prongIndicesTableMCD(svIndices);
     }
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processMCD3Prongs, "Reconstruct the MCD 3-prong secondary vertex", false);
 
-  void processMCD2Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& jtracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
+  void processMCD2Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& jtracks, OriginalTracks const& tracks, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
+    clearSecondaryVertexCaches();
     for (auto& jet : mcdjets) {
       std::vector<int> svIndices;
-      runCreatorNProng<2>(collision.template collision_as<aod::Collisions>(), jet, jtracks, svIndices, df2);
+      runCreatorNProng<2>(collision.template collision_as<aod::Collisions>(), jet, jtracks, tracks, svIndices, df2);
       sv2prongIndicesTableMCD(svIndices);
     }
   }
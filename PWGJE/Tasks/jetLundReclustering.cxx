@@ -45,6 +45,7 @@
 #include "PWGJE/DataModel/JetSubstructure.h"
 #include "PWGJE/Core/FastJetUtilities.h"
 #include "PWGJE/Core/JetDerivedDataUtilities.h"
+#include "PWGJE/Core/JetSubstructureUtilities.h"
 
 using namespace o2;
 using namespace o2::track;
@@ -57,7 +58,7 @@ struct JetLundReclustering {
   HistogramRegistry registry;
 
   std::vector<fastjet::PseudoJet> jetConstituents;
-  std::vector<fastjet::PseudoJet> jetReclustered;
+  std::vector<jetsubstructureutilities::JetSplitting> splittings;
   JetFinder jetReclusterer;
 
   Configurable<std::string> eventSelections{"eventSelections", "sel8", "choose event selection"};
@@ -88,26 +89,14 @@ struct JetLundReclustering {
   template <typename T>
   void jetReclustering(T const& jet)
   {
-    jetReclustered.clear();
-    fastjet::ClusterSequenceArea clusterSeq(jetReclusterer.findJets(jetConstituents, jetReclustered));
-    jetReclustered = sorted_by_pt(jetReclustered);
-    fastjet::PseudoJet pair = jetReclustered[0];
-    fastjet::PseudoJet j1;
-    fastjet::PseudoJet j2;
-    while (pair.has_parents(j1, j2)) {
-      if (j1.pt() < j2.pt()) {
-        std::swap(j1, j2);
-      }
-      double deltaR = j1.delta_R(j2);
-      double kt = j2.pt() * deltaR;
-      double z = j2.pt() / (j1.pt() + j2.pt());
-      double jetRadius = static_cast<double>(jet.r()) / 100.0;
-      double coord1 = std::log(jetRadius / deltaR);
-      double coord2 = std::log(kt);
-      double coord3 = std::log(1 / z);
+    jetsubstructureutilities::findPrimaryDeclusterings(jetReclusterer, jetConstituents, splittings);
+    double jetRadius = static_cast<double>(jet.r()) / 100.0;
+    for (const auto& splitting : splittings) {
+      double coord1 = std::log(jetRadius / splitting.theta);
+      double coord2 = std::log(splitting.kt());
+      double coord3 = std::log(1 / splitting.z());
       registry.fill(HIST("PrimaryLundPlane_kT"), coord1, coord2, jet.pt());
       registry.fill(HIST("PrimaryLundPlane_z"), coord1, coord3, jet.pt());
-      pair = j1;
     }
   }
 
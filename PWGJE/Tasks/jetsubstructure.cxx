@@ -51,7 +51,7 @@ struct JetSubstructureTask {
 
   Service<o2::framework::O2DatabasePDG> pdg;
   std::vector<fastjet::PseudoJet> jetConstituents;
-  std::vector<fastjet::PseudoJet> jetReclustered;
+  std::vector<jetsubstructureutilities::JetSplitting> splittings;
   JetFinder jetReclusterer;
 
   std::vector<float> nSub;
@@ -79,12 +79,7 @@ struct JetSubstructureTask {
   template <bool isMCP, bool isSubtracted, typename T, typename U>
   void jetReclustering(T const& jet, U& outputTable)
   {
-    jetReclustered.clear();
-    fastjet::ClusterSequenceArea clusterSeq(jetReclusterer.findJets(jetConstituents, jetReclustered));
-    jetReclustered = sorted_by_pt(jetReclustered);
-    fastjet::PseudoJet daughterSubJet = jetReclustered[0];
-    fastjet::PseudoJet parentSubJet1;
-    fastjet::PseudoJet parentSubJet2;
+    jetsubstructureutilities::findPrimaryDeclusterings(jetReclusterer, jetConstituents, splittings);
     bool softDropped = false;
     auto nsd = 0.0;
     auto zg = -1.0;
@@ -93,16 +88,17 @@ struct JetSubstructureTask {
     std::vector<float> ptLeadingVec;
     std::vector<float> ptSubLeadingVec;
     std::vector<float> thetaVec;
-
-    while (daughterSubJet.has_parents(parentSubJet1, parentSubJet2)) {
-      if (parentSubJet1.perp() < parentSubJet2.perp()) {
-        std::swap(parentSubJet1, parentSubJet2);
-      }
-      auto z = parentSubJet2.perp() / (parentSubJet1.perp() + parentSubJet2.perp());
-      auto theta = parentSubJet1.delta_R(parentSubJet2);
-      energyMotherVec.push_back(daughterSubJet.e());
-      ptLeadingVec.push_back(parentSubJet1.pt());
-      ptSubLeadingVec.push_back(parentSubJet2.pt());
+    energyMotherVec.reserve(splittings.size());
+    ptLeadingVec.reserve(splittings.size());
+    ptSubLeadingVec.reserve(splittings.size());
+    thetaVec.reserve(splittings.size());
+
+    for (const auto& splitting : splittings) {
+      auto z = splitting.z();
+      auto theta = splitting.theta;
+      energyMotherVec.push_back(splitting.energyMother);
+      ptLeadingVec.push_back(splitting.ptLeading);
+      ptSubLeadingVec.push_back(splitting.ptSubLeading);
       thetaVec.push_back(theta);
 
       if (z >= zCut * TMath::Power(theta / (jet.r() / 100.f), beta)) {
@@ -125,7 +121,6 @@ struct JetSubstructureTask {
         }
         nsd++;
       }
-      daughterSubJet = parentSubJet1;
     }
     if constexpr (!isSubtracted && !isMCP) {
       registry.fill(HIST("h2_jet_pt_jet_nsd"), jet.pt(), nsd);
@@ -61,7 +61,7 @@ struct JetSubstructureHFTask {
   int candMass;
 
   std::vector<fastjet::PseudoJet> jetConstituents;
-  std::vector<fastjet::PseudoJet> jetReclustered;
+  std::vector<jetsubstructureutilities::JetSplitting> splittings;
   JetFinder jetReclusterer;
 
   std::vector<float> nSub;
@@ -90,12 +90,15 @@ struct JetSubstructureHFTask {
   template <bool isMCP, bool isSubtracted, typename T, typename U>
   void jetReclustering(T const& jet, U& outputTable)
   {
-    jetReclustered.clear();
-    fastjet::ClusterSequenceArea clusterSeq(jetReclusterer.findJets(jetConstituents, jetReclustered));
-    jetReclustered = sorted_by_pt(jetReclustered);
-    fastjet::PseudoJet daughterSubJet = jetReclustered[0];
-    fastjet::PseudoJet parentSubJet1;
-    fastjet::PseudoJet parentSubJet2;
+    // follow the branch containing the HF candidate
+    jetsubstructureutilities::findPrimaryDeclusterings(jetReclusterer, jetConstituents, splittings, [](const fastjet::PseudoJet& subJet1, const fastjet::PseudoJet&) {
+      for (const auto& subJet1Constituent : subJet1.constituents()) {
+        if (subJet1Constituent.user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::candidateHF)) {
+          return true;
+        }
+      }
+      return false;
+    });
     bool softDropped = false;
     auto nsd = 0.0;
     auto zg = -1.0;
@@ -104,24 +107,19 @@ struct JetSubstructureHFTask {
     std::vector<float> ptLeadingVec;
     std::vector<float> ptSubLeadingVec;
     std::vector<float> thetaVec;
-    while (daughterSubJet.has_parents(parentSubJet1, parentSubJet2)) {
-
-      bool isHFInSubjet1 = false;
-      for (auto& subjet1Constituent : parentSubJet1.constituents()) {
-        if (subjet1Constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::candidateHF)) {
-          isHFInSubjet1 = true;
-          break;
-        }
-      }
-      if (!isHFInSubjet1) {
-        std::swap(parentSubJet1, parentSubJet2);
-      }
-      auto z = parentSubJet2.perp() / (parentSubJet1.perp() + parentSubJet2.perp());
-      auto theta = parentSubJet1.delta_R(parentSubJet2);
-      energyMotherVec.push_back(daughterSubJet.e());
-      ptLeadingVec.push_back(parentSubJet1.pt());
-      ptSubLeadingVec.push_back(parentSubJet2.pt());
+    energyMotherVec.reserve(splittings.size());
+    ptLeadingVec.reserve(splittings.size());
+    ptSubLeadingVec.reserve(splittings.size());
+    thetaVec.reserve(splittings.size());
+
+    for (const auto& splitting : splittings) {
+      auto z = splitting.z();
+      auto theta = splitting.theta;
+      energyMotherVec.push_back(splitting.energyMother);
+      ptLeadingVec.push_back(splitting.ptLeading);
+      ptSubLeadingVec.push_back(splitting.ptSubLeading);
       thetaVec.push_back(theta);
+
       if (z >= zCut * TMath::Power(theta / (jet.r() / 100.f), beta)) {
         if (!softDropped) {
           zg = z;
@@ -142,7 +140,6 @@ struct JetSubstructureHFTask {
         }
         nsd++;
       }
-      daughterSubJet = parentSubJet1;
     }
     if constexpr (!isSubtracted && !isMCP) {
       registry.fill(HIST("h2_jet_pt_jet_nsd"), jet.pt(), nsd);
@@ -12,6 +12,8 @@
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/ASoAHelpers.h"
 
+#include <vector>
+
 #ifndef PWGLF_DATAMODEL_LFEBYETABLES_H_
 #define PWGLF_DATAMODEL_LFEBYETABLES_H_
 
@@ -120,6 +122,34 @@ DECLARE_SOA_TABLE(McLambdaEbyeTables, "AOD", "MCLAMBEBYETABLE",
                   LFEbyeTable::PdgCode,
                   LFEbyeTable::IsReco);
 using McLambdaEbyeTable = McLambdaEbyeTables::iterator;
+
+namespace LFEbyePowerSumTable
+{
+// species of the power sums, each with particle and antiparticle
+enum PowerSumSpecies { kProton = 0,
+                       kDeuteron,
+                       kLambda,
+                       kNPowerSumSpecies };
+
+/// Index of sum_i w_i^order in PowerSums, with w_i the inverse efficiency of candidate i
+/// \param species one of PowerSumSpecies
+/// \param isAnti 0 for particles, 1 for antiparticles
+/// \param order power of the weights, from 1 to maxOrder
+inline int powerSumIndex(int species, int isAnti, int order, int maxOrder) { return (species * 2 + isAnti) * maxOrder + order - 1; }
+
+DECLARE_SOA_INDEX_COLUMN(CollEbyeTable, collEbyeTable);
+DECLARE_SOA_COLUMN(Subsample, subsample, uint8_t);            //! Subsample of the event, for the bootstrap of the statistical uncertainties
+DECLARE_SOA_COLUMN(MaxOrder, maxOrder, uint8_t);              //! Highest power of the weights in PowerSums
+DECLARE_SOA_COLUMN(PowerSums, powerSums, std::vector<float>); //! Sums of the powers of the candidate weights, see powerSumIndex
+} // namespace LFEbyePowerSumTable
+
+DECLARE_SOA_TABLE(PowerSumEbyeTables, "AOD", "POWSUMEBYETABLE",
+                  o2::soa::Index<>,
+                  LFEbyePowerSumTable::CollEbyeTableId,
+                  LFEbyePowerSumTable::Subsample,
+                  LFEbyePowerSumTable::MaxOrder,
+                  LFEbyePowerSumTable::PowerSums);
+using PowerSumEbyeTable = PowerSumEbyeTables::iterator;
 } // namespace o2::aod
 
 #endif // PWGLF_DATAMODEL_LFEBYETABLES_H_
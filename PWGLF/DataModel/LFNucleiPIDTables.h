@@ -0,0 +1,68 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file LFNucleiPIDTables.h
+/// \brief Track-joinable table with the PID of light nuclei (d, t, 3He, 4He), computed once per track by nucleiPidTable.cxx
+///
+
+#ifndef PWGLF_DATAMODEL_LFNUCLEIPIDTABLES_H_
+#define PWGLF_DATAMODEL_LFNUCLEIPIDTABLES_H_
+
+#include <cstdint>
+
+#include "Framework/AnalysisDataModel.h"
+#include "Common/DataModel/PIDResponse.h"
+
+namespace o2::aod
+{
+namespace nucleipid
+{
+// nsigma in [-10, 10], narrow bins around 0 and wider bins in the tails
+using binning = o2::aod::pidutils::binningInt8Fine;
+
+enum PIDFlagBits : uint8_t {
+  kDeuteronTPC = 0, // |TPC nsigma| of the deuteron hypothesis below the selection of the producer
+  kTritonTPC,       // |TPC nsigma| of the triton hypothesis below the selection of the producer
+  kHe3TPC,          // |TPC nsigma| of the 3He hypothesis below the selection of the producer
+  kHe4TPC,          // |TPC nsigma| of the 4He hypothesis below the selection of the producer
+  kHasTOF,          // the track has a TOF measurement, TOFMass2 is valid
+  kHeliumPIDInTracking,
+  kNPIDFlagBits
+};
+
+DECLARE_SOA_COLUMN(NSigmaStoreTPCDe, nSigmaStoreTPCDe, binning::binned_t); //! Stored binned nsigma with the TPC detector for deuteron
+DECLARE_SOA_COLUMN(NSigmaStoreTPCTr, nSigmaStoreTPCTr, binning::binned_t); //! Stored binned nsigma with the TPC detector for triton
+DECLARE_SOA_COLUMN(NSigmaStoreTPCHe, nSigmaStoreTPCHe, binning::binned_t); //! Stored binned nsigma with the TPC detector for helium3
+DECLARE_SOA_COLUMN(NSigmaStoreTPCAl, nSigmaStoreTPCAl, binning::binned_t); //! Stored binned nsigma with the TPC detector for alpha
+DEFINE_UNWRAP_NSIGMA_COLUMN(NSigmaTPCDe, nSigmaTPCDe);                     //! Unwrapped (float) nsigma with the TPC detector for deuteron
+DEFINE_UNWRAP_NSIGMA_COLUMN(NSigmaTPCTr, nSigmaTPCTr);                     //! Unwrapped (float) nsigma with the TPC detector for triton
+DEFINE_UNWRAP_NSIGMA_COLUMN(NSigmaTPCHe, nSigmaTPCHe);                     //! Unwrapped (float) nsigma with the TPC detector for helium3
+DEFINE_UNWRAP_NSIGMA_COLUMN(NSigmaTPCAl, nSigmaTPCAl);                     //! Unwrapped (float) nsigma with the TPC detector for alpha
+DECLARE_SOA_COLUMN(Rigidity, rigidity, float);                             //! TPC inner param corrected for the PID in tracking (GeV/c per unit charge)
+DECLARE_SOA_COLUMN(TOFMass2OverZ2, tofMass2OverZ2, float);                 //! (m/z)^2 from the TOF beta and the rigidity, -1 without TOF
+DECLARE_SOA_COLUMN(PIDFlags, pidFlags, uint8_t);                           //! Bit map of PIDFlagBits
+DECLARE_SOA_DYNAMIC_COLUMN(TOFMass2, tofMass2,                             //! TOF mass squared for a nucleus of charge z
+                           [](float tofMass2OverZ2, float z) -> float { return tofMass2OverZ2 < 0.f ? -1.f : tofMass2OverZ2 * z * z; });
+DECLARE_SOA_DYNAMIC_COLUMN(HasPIDFlag, hasPIDFlag, //! Checks a bit of PIDFlagBits
+                           [](uint8_t pidFlags, int bit) -> bool { return (pidFlags >> bit) & 1; });
+} // namespace nucleipid
+
+DECLARE_SOA_TABLE(NucleiPIDs, "AOD", "NUCLEIPID", //! Track-joinable PID of light nuclei
+                  nucleipid::NSigmaStoreTPCDe, nucleipid::NSigmaStoreTPCTr, nucleipid::NSigmaStoreTPCHe, nucleipid::NSigmaStoreTPCAl,
+                  nucleipid::Rigidity, nucleipid::TOFMass2OverZ2, nucleipid::PIDFlags,
+                  nucleipid::NSigmaTPCDe<nucleipid::NSigmaStoreTPCDe>, nucleipid::NSigmaTPCTr<nucleipid::NSigmaStoreTPCTr>,
+                  nucleipid::NSigmaTPCHe<nucleipid::NSigmaStoreTPCHe>, nucleipid::NSigmaTPCAl<nucleipid::NSigmaStoreTPCAl>,
+                  nucleipid::TOFMass2<nucleipid::TOFMass2OverZ2>, nucleipid::HasPIDFlag<nucleipid::PIDFlags>);
+using NucleiPID = NucleiPIDs::iterator;
+} // namespace o2::aod
+
+#endif // PWGLF_DATAMODEL_LFNUCLEIPIDTABLES_H_
@@ -146,6 +146,13 @@ DECLARE_SOA_COLUMN(DaughterID2, daughterId2, int);   //! Id of the second Daught
 DECLARE_SOA_COLUMN(SiblingIds, siblingIds, int[2]);  //! Index of the particles with the same mother
 DECLARE_SOA_COLUMN(BachTrkID, bachtrkID, int);       //! Id of the bach track from cascade
 DECLARE_SOA_COLUMN(V0ID, v0ID, int);                 //! Id of the V0 from cascade
+DECLARE_SOA_COLUMN(PIDTag, pidTag, uint8_t);         //! Bit mask of the species compatible with the track PID, according to resodaughter::PIDTagBits
+enum PIDTagBits : uint8_t {
+  kPionCandidate = 0,
+  kKaonCandidate,
+  kProtonCandidate,
+  kNPIDTagBits
+};
 } // namespace resodaughter
 DECLARE_SOA_TABLE(ResoTracks, "AOD", "RESOTRACKS",
                   o2::soa::Index<>,
@@ -187,6 +194,11 @@ DECLARE_SOA_TABLE(ResoTracks, "AOD", "RESOTRACKS",
                   o2::aod::track::TPCChi2NCl);
 using ResoTrack = ResoTracks::iterator;
 
+// joinable with ResoTracks, optional
+DECLARE_SOA_TABLE(ResoTrackPIDTags, "AOD", "RESOTRACKPIDTAG",
+                  resodaughter::PIDTag);
+using ResoTrackPIDTag = ResoTrackPIDTags::iterator;
+
 DECLARE_SOA_TABLE(ResoV0s, "AOD", "RESOV0S",
                   o2::soa::Index<>,
                   resodaughter::ResoCollisionId,
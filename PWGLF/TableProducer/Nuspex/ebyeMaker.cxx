@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <algorithm>
 #include <vector>
 #include <utility>
 #include <random>
@@ -61,6 +62,9 @@ constexpr double partMass[kNpart]{o2::constants::physics::MassProton, o2::consta
 constexpr double partPdg[kNpart]{2212, o2::constants::physics::kDeuteron};
 static const std::vector<std::string> betheBlochParNames{"p0", "p1", "p2", "p3", "p4", "resolution"};
 static const std::vector<std::string> particleNamesBB{"p", "d"};
+constexpr double efficiencyDefault[2 * o2::aod::LFEbyePowerSumTable::kNPowerSumSpecies][1]{{1.}, {1.}, {1.}, {1.}, {1.}, {1.}};
+static const std::vector<std::string> powerSumSpeciesNames{"p", "antip", "d", "antid", "Lambda", "antiLambda"};
+static const std::vector<std::string> efficiencyBinNames{"pt bin 0"};
 std::array<std::shared_ptr<TH3>, kNpart> tofMass;
 void momTotXYZ(std::array<float, 3>& momA, std::array<float, 3> const& momB, std::array<float, 3> const& momC)
 {
@@ -153,6 +157,7 @@ struct ebyeMaker {
   Produces<aod::LambdaEbyeTable> lambdaEbyeTable;
   Produces<aod::McNucleiEbyeTable> mcNucleiEbyeTable;
   Produces<aod::McLambdaEbyeTable> mcLambdaEbyeTable;
+  Produces<aod::PowerSumEbyeTable> powerSumEbyeTable;
   std::mt19937 gen32;
   std::vector<CandidateV0> candidateV0s;
   std::array<std::vector<CandidateTrack>, 2> candidateTracks;
@@ -236,6 +241,16 @@ struct ebyeMaker {
   Configurable<float> antidItsClsSizeCut{"antidItsClsSizeCut", 1.e-10f, "cluster size cut for antideuterons"};
   Configurable<float> antidPtItsClsSizeCut{"antidPtItsClsSizeCut", 10.f, "pt for cluster size cut for antideuterons"};
 
+  Configurable<bool> fillCandidateTables{"fillCandidateTables", true, "store the (anti)deuteron and (anti)lambda candidates (data)"};
+  Configurable<bool> fillPowerSums{"fillPowerSums", false, "store per event the sums of the powers of the inverse efficiencies of the candidates (data)"};
+  Configurable<int> powerSumMaxOrder{"powerSumMaxOrder", 4, "highest power of the stored sums"};
+  Configurable<int> powerSumNSubsamples{"powerSumNSubsamples", 30, "number of subsamples for the bootstrap"};
+  Configurable<std::vector<float>> efficiencyPtBins{"efficiencyPtBins", {0.f, 10.f}, "pT bins of the efficiencies (GeV/c)"};
+  Configurable<LabeledArray<double>> cfgEfficiencies{"cfgEfficiencies", {efficiencyDefault[0], 2 * o2::aod::LFEbyePowerSumTable::kNPowerSumSpecies, 1, powerSumSpeciesNames, efficiencyBinNames}, "efficiencies per species and pT bin"};
+
+  std::vector<float> efficiencies; // [species * pT bins], resolved in init
+  std::vector<float> powerSums;
+
   std::array<float, kNpart> ptMin;
   std::array<float, kNpart> ptTof;
   std::array<float, kNpart> ptMax;
@@ -397,6 +412,57 @@ struct ebyeMaker {
     nSigmaTpcCutUp = std::array<float, kNpart>{antipNsigmaTpcCutUp, antidNsigmaTpcCutUp};
     tpcInnerParamMax = std::array<float, kNpart>{antipTpcInnerParamMax, antidTpcInnerParamMax};
     tofMassMax = std::array<float, kNpart>{antipTofMassMax, antidTofMassMax};
+
+    if (fillPowerSums) {
+      const int nPtBins = static_cast<int>(efficiencyPtBins->size()) - 1;
+      const int nEffBins = static_cast<int>(cfgEfficiencies->getData().cols);
+      if (nPtBins < 1 || nEffBins < nPtBins) {
+        LOG(fatal) << "The efficiencies must be given for each of the " << nPtBins << " pT bins";
+      }
+      efficiencies.resize(2 * aod::LFEbyePowerSumTable::kNPowerSumSpecies * nPtBins);
+      for (int iS{0}; iS < 2 * aod::LFEbyePowerSumTable::kNPowerSumSpecies; ++iS) {
+        for (int iB{0}; iB < nPtBins; ++iB) {
+          efficiencies[iS * nPtBins + iB] = cfgEfficiencies->get(iS, iB);
+        }
+      }
+      gen32.seed(std::random_device{}());
+    }
+  }
+
+  /// Inverse efficiency of a candidate, 0 if the efficiency is not positive
+  float getWeight(int iSpecies, float pt)
+  {
+    const auto& bins = efficiencyPtBins.value;
+    const int nPtBins = static_cast<int>(bins.size()) - 1;
+    const int iBin = std::clamp(static_cast<int>(std::upper_bound(bins.begin(), bins.end(), pt) - bins.begin()) - 1, 0, nPtBins - 1);
+    const float eff = efficiencies[iSpecies * nPtBins + iBin];
+    return eff > 0.f ? 1.f / eff : 0.f;
+  }
+
+  /// Stores sum_i w_i^k (k = 1, ..., powerSumMaxOrder) of the candidates of the last collision,
+  /// the cumulants of each subsample are then obtained from sums over the events
+  void fillPowerSumTable()
+  {
+    const int maxOrder = powerSumMaxOrder;
+    powerSums.assign(2 * aod::LFEbyePowerSumTable::kNPowerSumSpecies * maxOrder, 0.f);
+    auto addCandidate = [&](int species, float signedPt) {
+      const int isAnti = signedPt < 0;
+      const float weight = getWeight(species * 2 + isAnti, std::abs(signedPt));
+      float weightPow{1.f};
+      for (int order{1}; order <= maxOrder; ++order) {
+        weightPow *= weight;
+        powerSums[aod::LFEbyePowerSumTable::powerSumIndex(species, isAnti, order, maxOrder)] += weightPow;
+      }
+    };
+    for (int iP{0}; iP < kNpart; ++iP) {
+      for (const auto& candidateTrack : candidateTracks[iP]) {
+        addCandidate(iP == 0 ? aod::LFEbyePowerSumTable::kProton : aod::LFEbyePowerSumTable::kDeuteron, candidateTrack.pt);
+      }
+    }
+    for (const auto& candidateV0 : candidateV0s) {
+      addCandidate(aod::LFEbyePowerSumTable::kLambda, candidateV0.pt);
+    }
+    powerSumEbyeTable(collisionEbyeTable.lastIndex(), static_cast<uint8_t>(gen32() % powerSumNSubsamples), static_cast<uint8_t>(maxOrder), powerSums);
   }
 
   template <class C, class T>
@@ -772,6 +838,12 @@ struct ebyeMaker {
       histos.fill(HIST("QA/MultVsCent"), centrality, multiplicity);
 
       collisionEbyeTable(centrality, collision.posZ());
+      if (fillPowerSums) {
+        fillPowerSumTable();
+      }
+      if (!fillCandidateTables) {
+        continue;
+      }
 
       for (auto& candidateV0 : candidateV0s) {
         lambdaEbyeTable(
@@ -847,6 +919,12 @@ struct ebyeMaker {
       histos.fill(HIST("QA/trackletsVsV0M"), centrality, multTracklets);
 
       collisionEbyeTable(centrality, collision.posZ());
+      if (fillPowerSums) {
+        fillPowerSumTable();
+      }
+      if (!fillCandidateTables) {
+        continue;
+      }
 
       for (auto& candidateV0 : candidateV0s) {
         lambdaEbyeTable(
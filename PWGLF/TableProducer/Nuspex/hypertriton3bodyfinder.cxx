@@ -13,9 +13,12 @@
 // author: yuanzhe.wang@cern.ch
 
 #include <cmath>
+#include <algorithm>
 #include <array>
 #include <cstdlib>
 #include <iterator>
+#include <utility>
+#include <vector>
 
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
@@ -243,6 +246,9 @@ struct hypertriton3bodyFinder {
   Configurable<float> minPt3Body = {"minPt3Body", 0.01, ""};        // minimum pT of 3body Vertex
   Configurable<float> maxTgl3Body = {"maxTgl3Body", 2, ""};         // maximum tgLambda of 3body Vertex
   Configurable<float> minCosPA3body = {"minCosPA3body", 0.8, ""};   // min cos of PA to PV for 3body Vertex
+  // preselection of the triplets before the 3body fit
+  Configurable<float> maxMass3bodyLowerBound{"maxMass3bodyLowerBound", -1., "Max lower bound of the H3L mass from the daughter momentum magnitudes, checked before the 3body fit (GeV/c^{2}, < 0: disabled)"};
+  Configurable<float> maxDeltaPhiBachV0{"maxDeltaPhiBachV0", -1., "Max azimuthal difference between the bachelor and the V0 momentum, checked before the 3body fit (rad, < 0: disabled)"};
 
   // for DCA
   Configurable<float> dcavtxdau{"dcavtxdau", 2.0, "DCA Vtx Daughters"};
@@ -719,6 +725,27 @@ struct hypertriton3bodyFinder {
   template <class TTrackClass, typename TCollisionTable, typename TPosTrackTable, typename TNegTrackTable, typename TGoodTrackTable>
   void DecayFinder(TCollisionTable const& dCollision, TPosTrackTable const& dPtracks, TNegTrackTable const& dNtracks, TGoodTrackTable const& dGoodtracks)
   {
+    // bachelor pool of the collision: tracks above the bachelor pT threshold, sorted in azimuth if a window is used
+    using TTrack = decltype(dGoodtracks.begin().template goodTrack_as<TTrackClass>());
+    std::vector<TTrack> bachelors;
+    std::vector<int64_t> lowPtBachelorIds;
+    for (auto& t2id : dGoodtracks) {
+      auto t2 = t2id.template goodTrack_as<TTrackClass>();
+      if (t2.pt() < minbachPt) {
+        lowPtBachelorIds.push_back(t2.globalIndex());
+        continue;
+      }
+      bachelors.push_back(t2);
+    }
+    const bool usePhiWindow = maxDeltaPhiBachV0 >= 0. && maxDeltaPhiBachV0 < o2::constants::math::PI;
+    std::vector<float> bachelorPhis;
+    if (usePhiWindow) {
+      std::sort(bachelors.begin(), bachelors.end(), [](const auto& a, const auto& b) { return a.phi() < b.phi(); });
+      for (const auto& t2 : bachelors) {
+        bachelorPhis.push_back(t2.phi());
+      }
+    }
+
     for (auto& t0id : dPtracks) { // FIXME: turn into combination(...)
       auto t0 = t0id.template goodTrack_as<TTrackClass>();
 
@@ -728,10 +755,50 @@ struct hypertriton3bodyFinder {
         if (!DecayV0Finder<TTrackClass>(dCollision, t0, t1, rv0)) {
           continue;
         }
+        // low pT bachelors are rejected by the 3body finder right after its first counter
+        statisticsRegistry.vtxstats[kVtxAll] += lowPtBachelorIds.size() - std::count(lowPtBachelorIds.begin(), lowPtBachelorIds.end(), t0.globalIndex());
+
+        // momenta of the V0 daughters at the V0 vertex, the magnitudes are kept by the propagation up to the energy loss
+        std::array<float, 3> pP, pN;
+        fitter.getTrack(0).getPxPyPzGlo(pP);
+        fitter.getTrack(1).getPxPyPzGlo(pN);
+
+        std::array<std::pair<size_t, size_t>, 2> bachelorRanges{std::make_pair(size_t{0}, bachelors.size()), std::make_pair(size_t{0}, size_t{0})};
+        if (usePhiWindow) {
+          const float phiV0 = RecoDecay::phi(pP[0] + pN[0], pP[1] + pN[1]);
+          const float phiMin = RecoDecay::constrainAngle(phiV0 - maxDeltaPhiBachV0);
+          const float phiMax = RecoDecay::constrainAngle(phiV0 + maxDeltaPhiBachV0);
+          const size_t first = std::lower_bound(bachelorPhis.begin(), bachelorPhis.end(), phiMin) - bachelorPhis.begin();
+          const size_t last = std::upper_bound(bachelorPhis.begin(), bachelorPhis.end(), phiMax) - bachelorPhis.begin();
+          if (phiMin <= phiMax) {
+            bachelorRanges[0] = {first, last};
+          } else { // window across 0
+            bachelorRanges[0] = {first, bachelors.size()};
+            bachelorRanges[1] = {0, last};
+          }
+        }
 
-        for (auto& t2id : dGoodtracks) {
-          auto t2 = t2id.template goodTrack_as<TTrackClass>();
-          Decay3bodyFinder<TTrackClass>(dCollision, t0, t1, t2, rv0);
+        // energies of the V0 daughters for the H3L (p pi-, d+ bachelor) and anti-H3L (pi+ anti-p, d- bachelor) hypotheses
+        const float p2P = RecoDecay::p2(pP), p2N = RecoDecay::p2(pN);
+        const float pSumV0 = std::sqrt(p2P) + std::sqrt(p2N);
+        const float eV0H3L = std::sqrt(p2P + o2::constants::physics::MassProton * o2::constants::physics::MassProton) + std::sqrt(p2N + o2::constants::physics::MassPionCharged * o2::constants::physics::MassPionCharged);
+        const float eV0AntiH3L = std::sqrt(p2P + o2::constants::physics::MassPionCharged * o2::constants::physics::MassPionCharged) + std::sqrt(p2N + o2::constants::physics::MassProton * o2::constants::physics::MassProton);
+
+        for (const auto& range : bachelorRanges) {
+          for (size_t iBach = range.first; iBach < range.second; iBach++) {
+            const auto& t2 = bachelors[iBach];
+            if (maxMass3bodyLowerBound >= 0. && t2.globalIndex() != t0.globalIndex()) {
+              // the invariant mass is minimal for collinear daughters
+              const float pSum = pSumV0 + t2.p();
+              const float eSum = (t2.sign() > 0 ? eV0H3L : eV0AntiH3L) + std::sqrt(t2.p() * t2.p() + o2::constants::physics::MassDeuteron * o2::constants::physics::MassDeuteron);
+              if (eSum * eSum - pSum * pSum > maxMass3bodyLowerBound * maxMass3bodyLowerBound) {
+                FillVtxCounter(kVtxAll);
+                FillVtxCounter(kVtxbachPt);
+                continue;
+              }
+            }
+            Decay3bodyFinder<TTrackClass>(dCollision, t0, t1, t2, rv0);
+          }
         }
       }
     }
@@ -0,0 +1,135 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+// Light nuclei PID table producer
+// ========================
+//
+// Computes once per track the TPC nsigma of the d, t, 3He and 4He hypotheses (same Bethe-Bloch
+// parameterisation as nucleiSpectra), the rigidity corrected for the PID in tracking and the TOF (m/z)^2,
+// and stores them in the track-joinable NucleiPIDs table, to be read by the nuclei analyses.
+//
+// Executable + dependencies:
+//
+// o2-analysis-lf-nuclei-pid-table, o2-analysis-pid-tof-base
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "Common/Core/PID/PIDTOF.h"
+#include "Common/DataModel/PIDResponse.h"
+#include "DataFormatsTPC/BetheBlochAleph.h"
+#include "Framework/AnalysisDataModel.h"
+#include "Framework/AnalysisTask.h"
+#include "Framework/runDataProcessing.h"
+#include "ReconstructionDataFormats/PID.h"
+
+#include "PWGLF/DataModel/LFNucleiPIDTables.h"
+
+using namespace o2;
+using namespace o2::framework;
+using namespace o2::constants::physics;
+
+namespace
+{
+constexpr int nSpecies{4};
+constexpr float charges[nSpecies]{1.f, 1.f, 2.f, 2.f};
+constexpr float masses[nSpecies]{MassDeuteron, MassTriton, MassHelium3, MassAlpha};
+constexpr double bbMomScalingDefault[nSpecies][2]{
+  {1., 1.},
+  {1., 1.},
+  {1., 1.},
+  {1., 1.}};
+constexpr double betheBlochDefault[nSpecies][6]{
+  {-136.71, 0.441, 0.2269, 1.347, 0.8035, 0.09},
+  {-239.99, 1.155, 1.099, 1.137, 1.006, 0.09},
+  {-321.34, 0.6539, 1.591, 0.8225, 2.363, 0.09},
+  {-586.66, 1.859, 4.435, 0.282, 3.201, 0.09}};
+static const std::vector<std::string> speciesNames{"deuteron", "triton", "He3", "alpha"};
+static const std::vector<std::string> chargeLabelNames{"Positive", "Negative"};
+static const std::vector<std::string> betheBlochParNames{"p0", "p1", "p2", "p3", "p4", "resolution"};
+} // namespace
+
+struct nucleiPidTable {
+  Produces<aod::NucleiPIDs> nucleiPIDs;
+
+  Configurable<bool> cfgCompensatePIDinTracking{"cfgCompensatePIDinTracking", false, "If true, divide tpcInnerParam by the electric charge for the tracks with helium PID in tracking"};
+  Configurable<float> cfgNSigmaTPCFlag{"cfgNSigmaTPCFlag", 3.f, "Maximum |TPC nsigma| for the species bits of the PID flags"};
+  Configurable<LabeledArray<double>> cfgMomentumScalingBetheBloch{"cfgMomentumScalingBetheBloch", {bbMomScalingDefault[0], nSpecies, 2, speciesNames, chargeLabelNames}, "TPC Bethe-Bloch momentum scaling for light nuclei"};
+  Configurable<LabeledArray<double>> cfgBetheBlochParams{"cfgBetheBlochParams", {betheBlochDefault[0], nSpecies, 6, speciesNames, betheBlochParNames}, "TPC Bethe-Bloch parameterisation for light nuclei"};
+
+  using TracksWithPID = soa::Join<aod::TracksIU, aod::TracksExtra, aod::TOFSignal, aod::TOFEvTime>;
+
+  o2::pid::tof::Beta<TracksWithPID::iterator> responseBeta;
+
+  // configuration resolved once, not looked up per track
+  double bgScalings[nSpecies][2];
+  double bbParams[nSpecies][6];
+
+  void init(InitContext&)
+  {
+    for (int iS{0}; iS < nSpecies; ++iS) {
+      for (int iC{0}; iC < 2; ++iC) {
+        bgScalings[iS][iC] = charges[iS] * cfgMomentumScalingBetheBloch->get(iS, iC) / masses[iS];
+      }
+      for (int iPar{0}; iPar < 6; ++iPar) {
+        bbParams[iS][iPar] = cfgBetheBlochParams->get(iS, iPar);
+      }
+    }
+  }
+
+  void process(TracksWithPID const& tracks)
+  {
+    nucleiPIDs.reserve(tracks.size());
+    for (auto const& track : tracks) {
+      uint8_t flags{0};
+      std::array<float, nSpecies> nSigma;
+      nSigma.fill(-999.f);
+
+      const bool heliumPID = track.pidForTracking() == o2::track::PID::Helium3 || track.pidForTracking() == o2::track::PID::Alpha;
+      const float rigidity = (heliumPID && cfgCompensatePIDinTracking) ? track.tpcInnerParam() / 2 : track.tpcInnerParam();
+      if (heliumPID) {
+        flags |= BIT(aod::nucleipid::kHeliumPIDInTracking);
+      }
+
+      if (track.hasTPC() && track.tpcSignal() > 0.f) {
+        const int iC{track.sign() < 0};
+        for (int iS{0}; iS < nSpecies; ++iS) {
+          const double expBethe{tpc::BetheBlochAleph(static_cast<double>(rigidity * bgScalings[iS][iC]), bbParams[iS][0], bbParams[iS][1], bbParams[iS][2], bbParams[iS][3], bbParams[iS][4])};
+          const double expSigma{expBethe * bbParams[iS][5]};
+          nSigma[iS] = static_cast<float>((track.tpcSignal() - expBethe) / expSigma);
+          if (std::abs(nSigma[iS]) < cfgNSigmaTPCFlag) {
+            flags |= BIT(aod::nucleipid::kDeuteronTPC + iS);
+          }
+        }
+      }
+
+      float tofMass2OverZ2{-1.f};
+      if (track.hasTOF()) {
+        flags |= BIT(aod::nucleipid::kHasTOF);
+        const float beta = std::min(1.f - 1.e-6f, std::max(1.e-4f, responseBeta.GetBeta(track))); /// sometimes beta > 1 or < 0, as in nucleiSpectra
+        tofMass2OverZ2 = rigidity * rigidity * (1.f / (beta * beta) - 1.f);
+      }
+
+      using binning = aod::nucleipid::binning;
+      nucleiPIDs(aod::pidutils::packValue<binning>(nSigma[0]), aod::pidutils::packValue<binning>(nSigma[1]),
+                 aod::pidutils::packValue<binning>(nSigma[2]), aod::pidutils::packValue<binning>(nSigma[3]),
+                 rigidity, tofMass2OverZ2, flags);
+    }
+  }
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  return WorkflowSpec{adaptAnalysisTask<nucleiPidTable>(cfgc)};
+}
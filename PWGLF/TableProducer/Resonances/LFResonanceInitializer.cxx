@@ -15,6 +15,9 @@
 ///
 /// \author Bong-Hwi Lim <bong-hwi.lim@cern.ch>
 
+#include <array>
+#include <cmath>
+
 #include "Common/DataModel/PIDResponse.h"
 #include "Common/Core/TrackSelection.h"
 #include "Common/DataModel/Centrality.h"
@@ -57,6 +60,7 @@ struct reso2initializer {
   Produces<aod::ResoCollisions> resoCollisions;
   Produces<aod::ResoMCCollisions> resoMCCollisions;
   Produces<aod::ResoTracks> reso2trks;
+  Produces<aod::ResoTrackPIDTags> reso2trkPIDTags;
   Produces<aod::ResoV0s> reso2v0s;
   Produces<aod::ResoCascades> reso2cascades;
   Produces<aod::ResoMCTracks> reso2mctracks;
@@ -110,6 +114,11 @@ struct reso2initializer {
   Configurable<float> pidnSigmaPreSelectionCut{"pidnSigmaPreSelectionCut", 5.0f, "TPC and TOF PID cut (loose, improve performance)"};
   Configurable<int> mincrossedrows{"mincrossedrows", 70, "min crossed rows"};
 
+  // PID tags of the daughter tracks, shared by the resonance tasks
+  Configurable<bool> cfgFillPIDTags{"cfgFillPIDTags", false, "Fill the ResoTrackPIDTags table joinable with ResoTracks"};
+  Configurable<float> cfgPIDTagNSigmaTPC{"cfgPIDTagNSigmaTPC", 3.0f, "TPC n sigma cut of the PID tags"};
+  Configurable<float> cfgPIDTagNSigmaTOF{"cfgPIDTagNSigmaTOF", 3.0f, "TOF n sigma cut of the PID tags, applied only to tracks with TOF"};
+
   /// DCA Selections for V0
   // DCAr to PV
   Configurable<double> cMaxDCArToPVcut{"cMaxDCArToPVcut", 2.0, "Track DCAr cut to PV Maximum"};
@@ -442,6 +451,21 @@ struct reso2initializer {
     return returnValue;
   }
 
+  // Bit mask of the species compatible with the TPC (and TOF if available) PID of a track
+  template <typename TrackType>
+  uint8_t getPIDTag(TrackType const& track)
+  {
+    const std::array<float, aod::resodaughter::kNPIDTagBits> nSigmaTPC{track.tpcNSigmaPi(), track.tpcNSigmaKa(), track.tpcNSigmaPr()};
+    const std::array<float, aod::resodaughter::kNPIDTagBits> nSigmaTOF{track.tofNSigmaPi(), track.tofNSigmaKa(), track.tofNSigmaPr()};
+    uint8_t tag = 0;
+    for (int iSpecies = 0; iSpecies < aod::resodaughter::kNPIDTagBits; iSpecies++) {
+      if (std::abs(nSigmaTPC[iSpecies]) < cfgPIDTagNSigmaTPC && (!track.hasTOF() || std::abs(nSigmaTOF[iSpecies]) < cfgPIDTagNSigmaTOF)) {
+        SETBIT(tag, iSpecies);
+      }
+    }
+    return tag;
+  }
+
   // Filter for all tracks
   template <bool isMC, typename TrackType, typename CollisionType>
   void fillTracks(CollisionType const& collision, TrackType const& tracks)
@@ -486,6 +510,9 @@ struct reso2initializer {
                 track.tpcCrossedRowsOverFindableCls(),
                 track.itsChi2NCl(),
                 track.tpcChi2NCl());
+      if (cfgFillPIDTags) {
+        reso2trkPIDTags(getPIDTag(track));
+      }
       if constexpr (isMC) {
         fillMCTrack(track);
       }
@@ -51,6 +51,9 @@
 #include "DataFormatsParameters/GRPMagField.h"
 #include "CCDB/BasicCCDBManager.h"
 
+#include <cstddef>
+#include <vector>
+
 using namespace o2;
 using namespace o2::framework;
 using namespace o2::framework::expressions;
@@ -88,28 +91,32 @@ struct reso2dfmerged {
   Produces<aod::ResoTrackDFs> reso2trksdf;
   int df = 0;
 
-  std::vector<std::tuple<float, float, float, float, float, float>> vecOfTuples;
-  std::vector<std::vector<std::tuple<float, float, float, float,
-                                     float, float, signed char, unsigned char, unsigned char, unsigned char,
-                                     float, float, float, float,
-                                     bool, float, float, float,
-                                     float, float, float, float,
-                                     float, float, bool, bool,
-                                     bool, bool, bool, bool, float, float, float>>>
-    vecOfVecOfTuples;
+  // Collisions and tracks buffered until nDF collisions are merged, in flat arrays reused from one merge to the next
+  // so that the memory is bounded by the largest merge instead of growing with nested per-collision vectors
+  struct BufferedCollision {
+    float posX, posY, posZ, cent, spherocity, evtPl;
+    std::size_t firstTrack; // first track of the collision in bufferedTracks
+  };
+  struct BufferedTrack {
+    float pt, px, py, pz, eta, phi;
+    signed char sign;
+    uint8_t tpcNClsCrossedRows, tpcNClsFound, itsNCls;
+    float dcaXY, dcaZ, x, alpha;
+    bool hasTOF;
+    float tpcNSigmaPi, tpcNSigmaKa, tpcNSigmaPr, tpcNSigmaEl;
+    float tofNSigmaPi, tofNSigmaKa, tofNSigmaPr, tofNSigmaEl;
+    float tpcSignal;
+    bool passedITSRefit, passedTPCRefit, isGlobalTrackWoDCA, isGlobalTrack, isPrimaryTrack, isPVContributor;
+    float tpcCrossedRowsOverFindableCls, itsChi2NCl, tpcChi2NCl;
+  };
+  std::vector<BufferedCollision> bufferedCollisions;
+  std::vector<BufferedTrack> bufferedTracks;
+
   void processTrackDataDF(resoCols::iterator const& collision, resoTracks const& tracks)
   {
 
     int nCollisions = nDF;
-    vecOfTuples.push_back(std::make_tuple(collision.posX(), collision.posY(), collision.posZ(), collision.cent(), collision.spherocity(), collision.evtPl()));
-    std::vector<std::tuple<float, float, float, float,
-                           float, float, signed char, unsigned char, unsigned char, unsigned char,
-                           float, float, float, float,
-                           bool, float, float, float,
-                           float, float, float, float,
-                           float, float, bool, bool,
-                           bool, bool, bool, bool, float, float, float>>
-      innerVector;
+    bufferedCollisions.push_back({collision.posX(), collision.posY(), collision.posZ(), collision.cent(), collision.spherocity(), collision.evtPl(), bufferedTracks.size()});
     for (auto& track : tracks) {
       if (cpidCut) {
         if (!track.hasTOF()) {
@@ -133,97 +140,95 @@ struct reso2dfmerged {
           continue;
       }
 
-      innerVector.push_back(std::make_tuple(
-        track.pt(),
-        track.px(),
-        track.py(),
-        track.pz(),
-        track.eta(),
-        track.phi(),
-        track.sign(),
-        (uint8_t)track.tpcNClsCrossedRows(),
-        (uint8_t)track.tpcNClsFound(),
-        (uint8_t)track.itsNCls(),
-        track.dcaXY(),
-        track.dcaZ(),
-        track.x(),
-        track.alpha(),
-        track.hasTOF(),
-        track.tpcNSigmaPi(),
-        track.tpcNSigmaKa(),
-        track.tpcNSigmaPr(),
-        track.tpcNSigmaEl(),
-        track.tofNSigmaPi(),
-        track.tofNSigmaKa(),
-        track.tofNSigmaPr(),
-        track.tofNSigmaEl(),
-        track.tpcSignal(),
-        track.passedITSRefit(),
-        track.passedTPCRefit(),
-        track.isGlobalTrackWoDCA(),
-        track.isGlobalTrack(),
-        track.isPrimaryTrack(),
-        track.isPVContributor(),
-        track.tpcCrossedRowsOverFindableCls(),
-        track.itsChi2NCl(),
-        track.tpcChi2NCl()));
+      bufferedTracks.push_back({track.pt(),
+                                track.px(),
+                                track.py(),
+                                track.pz(),
+                                track.eta(),
+                                track.phi(),
+                                track.sign(),
+                                (uint8_t)track.tpcNClsCrossedRows(),
+                                (uint8_t)track.tpcNClsFound(),
+                                (uint8_t)track.itsNCls(),
+                                track.dcaXY(),
+                                track.dcaZ(),
+                                track.x(),
+                                track.alpha(),
+                                track.hasTOF(),
+                                track.tpcNSigmaPi(),
+                                track.tpcNSigmaKa(),
+                                track.tpcNSigmaPr(),
+                                track.tpcNSigmaEl(),
+                                track.tofNSigmaPi(),
+                                track.tofNSigmaKa(),
+                                track.tofNSigmaPr(),
+                                track.tofNSigmaEl(),
+                                track.tpcSignal(),
+                                track.passedITSRefit(),
+                                track.passedTPCRefit(),
+                                track.isGlobalTrackWoDCA(),
+                                track.isGlobalTrack(),
+                                track.isPrimaryTrack(),
+                                track.isPVContributor(),
+                                track.tpcCrossedRowsOverFindableCls(),
+                                track.itsChi2NCl(),
+                                track.tpcChi2NCl()});
     }
 
-    vecOfVecOfTuples.push_back(innerVector);
-    innerVector.clear();
     df++;
     if (df < nCollisions)
       return;
     df = 0;
 
-    for (size_t i = 0; i < vecOfTuples.size(); ++i) {
-      const auto& tuple = vecOfTuples[i];
-      const auto& innerVector = vecOfVecOfTuples[i];
+    for (size_t i = 0; i < bufferedCollisions.size(); ++i) {
+      const auto& coll = bufferedCollisions[i];
+      const std::size_t lastTrack = (i + 1 < bufferedCollisions.size()) ? bufferedCollisions[i + 1].firstTrack : bufferedTracks.size();
 
-      histos.fill(HIST("Event/h1d_ft0_mult_percentile"), std::get<3>(tuple));
-      resoCollisionsdf(std::get<0>(tuple), std::get<1>(tuple), std::get<2>(tuple), std::get<3>(tuple), std::get<4>(tuple), std::get<5>(tuple), 0., 0., 0., 0, 0);
-      //  LOGF(info, "collisions: Index = %d ) %f - %f - %f %f %d -- %d", std::get<0>(tuple).globalIndex(),std::get<1>(tuple),std::get<2>(tuple), std::get<3>(tuple), std::get<4>(tuple), std::get<5>(tuple).size(),resoCollisionsdf.lastIndex());
+      histos.fill(HIST("Event/h1d_ft0_mult_percentile"), coll.cent);
+      resoCollisionsdf(coll.posX, coll.posY, coll.posZ, coll.cent, coll.spherocity, coll.evtPl, 0., 0., 0., 0, 0);
 
-      for (const auto& tuple : innerVector) {
+      for (std::size_t iTrack = coll.firstTrack; iTrack < lastTrack; ++iTrack) {
+        const auto& trk = bufferedTracks[iTrack];
         reso2trksdf(resoCollisionsdf.lastIndex(),
-                    std::get<0>(tuple),
-                    std::get<1>(tuple),
-                    std::get<2>(tuple),
-                    std::get<3>(tuple),
-                    std::get<4>(tuple),
-                    std::get<5>(tuple),
-                    std::get<6>(tuple),
-                    std::get<7>(tuple),
-                    std::get<8>(tuple),
-                    std::get<9>(tuple),
-                    std::get<10>(tuple),
-                    std::get<11>(tuple),
-                    std::get<12>(tuple),
-                    std::get<13>(tuple),
-                    std::get<14>(tuple),
-                    std::get<15>(tuple),
-                    std::get<16>(tuple),
-                    std::get<17>(tuple),
-                    std::get<18>(tuple),
-                    std::get<19>(tuple),
-                    std::get<20>(tuple),
-                    std::get<21>(tuple),
-                    std::get<22>(tuple),
-                    std::get<23>(tuple),
-                    std::get<24>(tuple),
-                    std::get<25>(tuple),
-                    std::get<26>(tuple),
-                    std::get<27>(tuple),
-                    std::get<28>(tuple),
-                    std::get<29>(tuple),
-                    std::get<30>(tuple),
-                    std::get<31>(tuple),
-                    std::get<32>(tuple));
+                    trk.pt,
+                    trk.px,
+                    trk.py,
+                    trk.pz,
+                    trk.eta,
+                    trk.phi,
+                    trk.sign,
+                    trk.tpcNClsCrossedRows,
+                    trk.tpcNClsFound,
+                    trk.itsNCls,
+                    trk.dcaXY,
+                    trk.dcaZ,
+                    trk.x,
+                    trk.alpha,
+                    trk.hasTOF,
+                    trk.tpcNSigmaPi,
+                    trk.tpcNSigmaKa,
+                    trk.tpcNSigmaPr,
+                    trk.tpcNSigmaEl,
+                    trk.tofNSigmaPi,
+                    trk.tofNSigmaKa,
+                    trk.tofNSigmaPr,
+                    trk.tofNSigmaEl,
+                    trk.tpcSignal,
+                    trk.passedITSRefit,
+                    trk.passedTPCRefit,
+                    trk.isGlobalTrackWoDCA,
+                    trk.isGlobalTrack,
+                    trk.isPrimaryTrack,
+                    trk.isPVContributor,
+                    trk.tpcCrossedRowsOverFindableCls,
+                    trk.itsChi2NCl,
+                    trk.tpcChi2NCl);
       }
     }
 
-    vecOfTuples.clear();
-    vecOfVecOfTuples.clear(); //
+    // the capacity is kept for the next merge
+    bufferedCollisions.clear();
+    bufferedTracks.clear();
   }
 
   PROCESS_SWITCH(reso2dfmerged, processTrackDataDF, "Process for data merged DF", true);
@@ -42,6 +42,7 @@
 #include <map>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 #include "Framework/runDataProcessing.h"
 #include "Framework/RunningWorkflowInfo.h"
@@ -320,6 +321,16 @@ struct cascadeBuilder {
   o2::track::TrackParCov lV0Track;
   o2::track::TrackParCov lCascadeTrack;
 
+  // DCAxy to the PV of the bachelor tracks, cached per group of cascades (one build call):
+  // a bachelor shared by several cascades of the same collision is propagated only once
+  struct BachelorDCA {
+    int64_t group = -1;
+    int64_t collisionId = -1;
+    float dcaXY = 999.f;
+  };
+  std::vector<BachelorDCA> bachelorDCACache;
+  int64_t bachelorDCAGroup = 0;
+
   // Helper struct to do bookkeeping of building parameters
   struct {
     std::array<int32_t, kNCascSteps> cascstats;
@@ -924,6 +935,25 @@ struct cascadeBuilder {
     // to be added here as complementary information in the future
   }
 
+  // DCAxy of the bachelor to the PV of the cascade collision, propagated once per group of cascades
+  template <typename TCollision, typename TTrack>
+  float getBachelorDCAxy(TCollision const& collision, TTrack const& bachTrack)
+  {
+    const auto trackId = bachTrack.globalIndex();
+    if (trackId >= static_cast<int64_t>(bachelorDCACache.size())) {
+      bachelorDCACache.resize(trackId + 1);
+    }
+    auto& cached = bachelorDCACache[trackId];
+    if (cached.group == bachelorDCAGroup && cached.collisionId == collision.globalIndex()) {
+      return cached.dcaXY;
+    }
+    gpu::gpustd::array<float, 2> dcaInfo;
+    auto bachTrackPar = getTrackPar(bachTrack);
+    o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, bachTrackPar, 2.f, fitter.getMatCorrType(), &dcaInfo);
+    cached = {bachelorDCAGroup, collision.globalIndex(), dcaInfo[0]};
+    return dcaInfo[0];
+  }
+
   template <class TTrackTo, typename TCascObject, typename TV0Object>
   bool buildCascadeCandidate(TCascObject const& cascade, TV0Object const& v0)
   {
@@ -976,11 +1006,7 @@ struct cascadeBuilder {
 
     // bachelor DCA track to PV
     // Calculate DCA with respect to the collision associated to the V0, not individual tracks
-    gpu::gpustd::array<float, 2> dcaInfo;
-
-    auto bachTrackPar = getTrackPar(bachTrack);
-    o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, bachTrackPar, 2.f, fitter.getMatCorrType(), &dcaInfo);
-    cascadecandidate.bachDCAxy = dcaInfo[0];
+    cascadecandidate.bachDCAxy = getBachelorDCAxy(collision, bachTrack);
 
     if (TMath::Abs(cascadecandidate.bachDCAxy) < dcabachtopv)
       return false;
@@ -1254,10 +1280,7 @@ struct cascadeBuilder {
     // bachelor DCA track to PV
     // Calculate DCA with respect to the collision associated to the V0, not individual tracks
     gpu::gpustd::array<float, 2> dcaInfo;
-
-    auto bachTrackPar = getTrackPar(bachTrack);
-    o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, bachTrackPar, 2.f, fitter.getMatCorrType(), &dcaInfo);
-    cascadecandidate.bachDCAxy = dcaInfo[0];
+    cascadecandidate.bachDCAxy = getBachelorDCAxy(collision, bachTrack);
 
     o2::track::TrackParCov posTrackParCovForDCA = getTrackParCov(posTrack);
     o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, posTrackParCovForDCA, 2.f, fitter.getMatCorrType(), &dcaInfo);
@@ -1597,6 +1620,7 @@ struct cascadeBuilder {
   void buildStrangenessTables(TCascTable const& cascades)
   {
     statisticsRegistry.eventCounter++;
+    bachelorDCAGroup++;
     for (auto& cascade : cascades) {
       // de-reference from V0 pool, either specific for cascades or general
       // use templatizing to avoid code duplication
@@ -1613,6 +1637,7 @@ struct cascadeBuilder {
   void buildFindableStrangenessTables(TCascTable const& cascades)
   {
     statisticsRegistry.eventCounter++;
+    bachelorDCAGroup++;
     for (auto& cascade : cascades) {
       // de-reference from V0 pool, either specific for cascades or general
       // use templatizing to avoid code duplication
@@ -1629,6 +1654,7 @@ struct cascadeBuilder {
   void buildKFStrangenessTables(TCascTable const& cascades)
   {
     statisticsRegistry.eventCounter++;
+    bachelorDCAGroup++;
     for (auto& cascade : cascades) {
       bool validCascadeCandidateKF = buildCascadeCandidateWithKF<TTrackTo>(cascade);
       if (!validCascadeCandidateKF)
@@ -1682,6 +1708,7 @@ struct cascadeBuilder {
   void buildStrangenessTablesWithStrangenessTracking(TCascTable const& cascades, TStraTrack const& trackedCascades)
   {
     statisticsRegistry.eventCounter++;
+    bachelorDCAGroup++;
 
     for (auto& cascade : cascades) {
       // check if cascade is tracked - sliceBy is our friend!
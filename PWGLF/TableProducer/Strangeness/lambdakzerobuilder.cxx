@@ -36,12 +36,15 @@
 //    david.dobrigkeit.chinellato@cern.ch
 //
 
+#include <algorithm>
 #include <cmath>
 #include <array>
 #include <cstdlib>
 #include <map>
 #include <iterator>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "TRandom3.h"
 #include "Framework/runDataProcessing.h"
@@ -206,6 +209,17 @@ struct lambdakzeroBuilder {
     Configurable<int> rejDiffCollTracks{"dcaFitterConfigurations.rejDiffCollTracks", 0, "rejDiffCollTracks"};
   } dcaFitterConfigurations;
 
+  // the V0s are independent: their daughter propagation and vertex fit can be done in parallel, the tables are then filled in the original order
+  // optional analytic estimate of the V0 vertex from the daughter helices at the IU, to skip the fit of candidates far from the selections
+  struct : ConfigurableGroup {
+    Configurable<bool> usePrefilter{"prefilterConfigurations.usePrefilter", false, "reject candidates with the analytic vertex estimate before the fit"};
+    Configurable<float> radiusMargin{"prefilterConfigurations.radiusMargin", 1.0f, "relaxation of the V0 radius selection (cm)"};
+    Configurable<float> dcaV0DauFactor{"prefilterConfigurations.dcaV0DauFactor", 3.0f, "relaxation factor of the DCA between daughters selection"};
+    Configurable<float> cosPAMargin{"prefilterConfigurations.cosPAMargin", 0.05f, "relaxation of the CosPA selection"};
+  } prefilterConfigurations;
+
+  Configurable<int> nThreadsV0Building{"nThreadsV0Building", 1, "Number of threads for the V0 fits, use >1 only with a thread-safe field map and material LUT"};
+
   // CCDB options
   struct : ConfigurableGroup {
     Configurable<std::string> ccdburl{"ccdbConfigurations.ccdb-url", "http://alice-ccdb.cern.ch", "url of the ccdb repository"};
@@ -314,6 +328,11 @@ struct lambdakzeroBuilder {
                 kCountV0forCascade,
                 kNV0Steps };
 
+  enum v0PrefilterStep { kPrefilterRadius = 0,
+                         kPrefilterDCAV0Dau,
+                         kPrefilterCosPA,
+                         kNPrefilterSteps };
+
   // Helper struct to pass V0 information
   struct {
     float posTrackX;
@@ -340,6 +359,7 @@ struct lambdakzeroBuilder {
     std::array<int32_t, kNV0Steps> v0statsUnassociated;
     std::array<int32_t, 10> posITSclu;
     std::array<int32_t, 10> negITSclu;
+    std::array<int32_t, kNPrefilterSteps> prefilterRejections;
     int32_t exceptions;
     int32_t eventCounter;
   } statisticsRegistry;
@@ -417,6 +437,7 @@ struct lambdakzeroBuilder {
       statisticsRegistry.posITSclu[ii] = 0;
       statisticsRegistry.negITSclu[ii] = 0;
     }
+    statisticsRegistry.prefilterRejections.fill(0);
   }
 
   void fillHistos()
@@ -427,6 +448,11 @@ struct lambdakzeroBuilder {
       registry.fill(HIST("hV0Criteria"), ii, statisticsRegistry.v0stats[ii]);
       registry.fill(HIST("hV0CriteriaUnassociated"), ii, statisticsRegistry.v0statsUnassociated[ii]);
     }
+    if (prefilterConfigurations.usePrefilter) {
+      for (Int_t ii = 0; ii < kNPrefilterSteps; ii++) {
+        registry.fill(HIST("hV0PrefilterRejections"), ii, statisticsRegistry.prefilterRejections[ii]);
+      }
+    }
     if (qaConfigurations.d_doTrackQA) {
       for (Int_t ii = 0; ii < 10; ii++) {
         registry.fill(HIST("hPositiveITSClusters"), ii, statisticsRegistry.posITSclu[ii]);
@@ -440,6 +466,234 @@ struct lambdakzeroBuilder {
   o2::track::TrackParCov lPositiveTrackIU;
   o2::track::TrackParCov lNegativeTrackIU;
 
+  // Status of the daughter propagation and vertex fit of a V0
+  enum v0FitStatus : uint8_t { kFitNoTPCrefit = 0,
+                               kFitFailedDCAxy,
+                               kFitPrefilterRejected,
+                               kFitException,
+                               kFitNoCandidate,
+                               kFitOK };
+
+  // Helper struct with the inputs and results of the fit of a V0, which do not depend on the other V0s
+  struct V0Fit {
+    o2::dataformats::VertexBase primaryVertex;
+    bool hasTPCrefit;
+    bool isCollinear;
+    uint8_t status;
+    o2::track::TrackParCov posTrackIU;
+    o2::track::TrackParCov negTrackIU;
+    o2::track::TrackPar posTrackPar;      // at the DCA to the PV
+    o2::track::TrackPar negTrackPar;      // at the DCA to the PV
+    gpu::gpustd::array<float, 2> dcaInfo; // DCA of the negative track to the PV
+    float posDCAxy;
+    float negDCAxy;
+    int prefilterStep; // number of prefilter steps passed
+    o2::track::TrackParCov posTrack; // at the PCA
+    o2::track::TrackParCov negTrack; // at the PCA
+    std::array<float, 3> pca;
+    float chi2PCA;
+    std::array<float, 6> covPCA;
+  };
+
+  // fit buffers and per-thread fitters, the memory is kept from one time frame to the next
+  std::vector<V0Fit> v0Fits;
+  std::vector<o2::vertexing::DCAFitterN<2>> workerFitters;
+
+  // collects the inputs of the fit from the tables
+  template <class TTrackTo, typename TV0Object>
+  void prepareV0Fit(TV0Object const& V0, V0Fit& fit)
+  {
+    auto const& posTrack = V0.template posTrack_as<TTrackTo>();
+    auto const& negTrack = V0.template negTrack_as<TTrackTo>();
+
+    // for storing whatever is the relevant quantity for the PV
+    fit.primaryVertex = o2::dataformats::VertexBase();
+    if (V0.has_collision()) {
+      auto const& collision = V0.collision();
+      fit.primaryVertex.setPos({collision.posX(), collision.posY(), collision.posZ()});
+      fit.primaryVertex.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
+    } else {
+      fit.primaryVertex.setPos({mVtx->getX(), mVtx->getY(), mVtx->getZ()});
+    }
+
+    fit.hasTPCrefit = !tpcrefit || ((posTrack.trackType() & o2::aod::track::TPCrefit) && (negTrack.trackType() & o2::aod::track::TPCrefit));
+    fit.isCollinear = dcaFitterConfigurations.d_UseCollinearFit || V0.isCollinearV0();
+    fit.posTrackIU = getTrackParCov(posTrack);
+    fit.negTrackIU = getTrackParCov(negTrack);
+  }
+
+  // analytic estimate of the V0 vertex from the circles of the daughters at the IU in the transverse plane,
+  // with the z of each daughter extrapolated along its helix
+  // returns the number of prefilter steps passed by the best of the (up to two) vertex estimates
+  int getV0PrefilterStep(V0Fit const& fit, float bz)
+  {
+    const o2::track::TrackParCov* daughters[2] = {&fit.posTrackIU, &fit.negTrackIU};
+    o2::math_utils::CircleXYf_t circles[2];
+    std::array<float, 3> xyzIU[2];
+    std::array<float, 3> pIU[2];
+    float sna, csa;
+    for (int i = 0; i < 2; i++) {
+      daughters[i]->getCircleParams(bz, circles[i], sna, csa);
+      daughters[i]->getXYZGlo(xyzIU[i]);
+      daughters[i]->getPxPyPzGlo(pIU[i]);
+    }
+    const float dx = circles[1].xC - circles[0].xC;
+    const float dy = circles[1].yC - circles[0].yC;
+    const float d = std::hypot(dx, dy);
+    if (d < 1e-6f) {
+      return kNPrefilterSteps; // concentric circles, no estimate
+    }
+    const float ux = dx / d;
+    const float uy = dy / d;
+    const float r0 = circles[0].rC;
+    const float r1 = circles[1].rC;
+
+    // points of each daughter circle at the crossings, or closest to the other circle if they do not cross
+    int nEstimates = 1;
+    std::array<std::array<float, 2>, 2> points[2];
+    if (d > r0 + r1) {
+      points[0][0] = {circles[0].xC + ux * r0, circles[0].yC + uy * r0};
+      points[0][1] = {circles[1].xC - ux * r1, circles[1].yC - uy * r1};
+    } else if (d < std::fabs(r0 - r1)) {
+      const float side = r0 > r1 ? 1.f : -1.f;
+      points[0][0] = {circles[0].xC + side * ux * r0, circles[0].yC + side * uy * r0};
+      points[0][1] = {circles[1].xC + side * ux * r1, circles[1].yC + side * uy * r1};
+    } else {
+      nEstimates = 2;
+      const float a = (d * d + r0 * r0 - r1 * r1) / (2.f * d);
+      const float h = std::sqrt(std::max(0.f, r0 * r0 - a * a));
+      for (int iEstimate = 0; iEstimate < 2; iEstimate++) {
+        const float sign = iEstimate == 0 ? 1.f : -1.f;
+        points[iEstimate][0] = {circles[0].xC + a * ux - sign * h * uy, circles[0].yC + a * uy + sign * h * ux};
+        points[iEstimate][1] = points[iEstimate][0];
+      }
+    }
+
+    const auto& primaryVertex = fit.primaryVertex;
+    int bestStep = 0;
+    for (int iEstimate = 0; iEstimate < nEstimates; iEstimate++) {
+      std::array<float, 3> xyz[2];
+      std::array<float, 3> p[2];
+      for (int i = 0; i < 2; i++) {
+        const auto& circle = circles[i];
+        const float pt = std::hypot(pIU[i][0], pIU[i][1]);
+        // rotation sense of the daughter on its circle, from its position and momentum at the IU
+        const float vx = xyzIU[i][0] - circle.xC;
+        const float vy = xyzIU[i][1] - circle.yC;
+        const float sense = vx * pIU[i][1] - vy * pIU[i][0] > 0.f ? 1.f : -1.f;
+        // signed arc length from the IU to the point, negative if the point is before the IU
+        const float wx = points[iEstimate][i][0] - circle.xC;
+        const float wy = points[iEstimate][i][1] - circle.yC;
+        const float dphi = RecoDecay::constrainAngle(std::atan2(wy, wx) - std::atan2(vy, vx), -o2::constants::math::PI);
+        const float arc = sense * dphi * circle.rC;
+        xyz[i] = {points[iEstimate][i][0], points[iEstimate][i][1], xyzIU[i][2] + arc * pIU[i][2] / pt};
+        p[i] = {-sense * wy / circle.rC * pt, sense * wx / circle.rC * pt, pIU[i][2]};
+      }
+      int step = 0;
+      const std::array<float, 3> pos = {0.5f * (xyz[0][0] + xyz[1][0]), 0.5f * (xyz[0][1] + xyz[1][1]), 0.5f * (xyz[0][2] + xyz[1][2])};
+      if (RecoDecay::sqrtSumOfSquares(pos[0], pos[1]) > v0radius - prefilterConfigurations.radiusMargin) {
+        step++;
+        if (RecoDecay::sqrtSumOfSquares(xyz[0][0] - xyz[1][0], xyz[0][1] - xyz[1][1], xyz[0][2] - xyz[1][2]) < prefilterConfigurations.dcaV0DauFactor * dcav0dau) {
+          step++;
+          const float cosPA = RecoDecay::cpa(array{primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, pos, array{p[0][0] + p[1][0], p[0][1] + p[1][1], p[0][2] + p[1][2]});
+          if (cosPA > v0cospa - prefilterConfigurations.cosPAMargin) {
+            step++;
+          }
+        }
+      }
+      bestStep = std::max(bestStep, step);
+    }
+    return bestStep;
+  }
+
+  // propagates the daughters to the PV and fits the V0 vertex, without access to the tables nor to the shared members
+  void fitV0(V0Fit& fit, o2::vertexing::DCAFitterN<2>& df)
+  {
+    if (!fit.hasTPCrefit) {
+      fit.status = kFitNoTPCrefit;
+      return;
+    }
+
+    // Calculate DCA with respect to the collision associated to the V0, not individual tracks
+    const auto& primaryVertex = fit.primaryVertex;
+    fit.posTrackPar = fit.posTrackIU;
+    o2::base::Propagator::Instance()->propagateToDCABxByBz({primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, fit.posTrackPar, 2.f, df.getMatCorrType(), &fit.dcaInfo);
+    fit.posDCAxy = fit.dcaInfo[0];
+    fit.negTrackPar = fit.negTrackIU;
+    o2::base::Propagator::Instance()->propagateToDCABxByBz({primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, fit.negTrackPar, 2.f, df.getMatCorrType(), &fit.dcaInfo);
+    fit.negDCAxy = fit.dcaInfo[0];
+
+    if (std::fabs(fit.posDCAxy) < dcapostopv || std::fabs(fit.negDCAxy) < dcanegtopv) {
+      fit.status = kFitFailedDCAxy;
+      return;
+    }
+
+    if (prefilterConfigurations.usePrefilter) {
+      fit.prefilterStep = getV0PrefilterStep(fit, df.getBz());
+      if (fit.prefilterStep < kNPrefilterSteps) {
+        fit.status = kFitPrefilterRejected;
+        return;
+      }
+    }
+
+    // Move close to minima
+    fit.posTrack = fit.posTrackIU;
+    fit.negTrack = fit.negTrackIU;
+    int nCand = 0;
+    df.setCollinear(fit.isCollinear);
+    try {
+      nCand = df.process(fit.posTrack, fit.negTrack);
+    } catch (...) {
+      fit.status = kFitException;
+      return;
+    }
+    if (nCand == 0) {
+      fit.status = kFitNoCandidate;
+      return;
+    }
+
+    fit.posTrack = df.getTrack(0);
+    fit.negTrack = df.getTrack(1);
+    const auto& vtx = df.getPCACandidate();
+    for (int i = 0; i < 3; i++) {
+      fit.pca[i] = vtx[i];
+    }
+    fit.chi2PCA = df.getChi2AtPCACandidate();
+    if (createV0CovMats) {
+      auto covVtxV = df.calcPCACovMatrix(0);
+      fit.covPCA = {static_cast<float>(covVtxV(0, 0)), static_cast<float>(covVtxV(1, 0)), static_cast<float>(covVtxV(1, 1)),
+                    static_cast<float>(covVtxV(2, 0)), static_cast<float>(covVtxV(2, 1)), static_cast<float>(covVtxV(2, 2))};
+    }
+    fit.status = kFitOK;
+  }
+
+  // fits all the V0s of the time frame in chunks of consecutive V0s, one fitter per thread
+  template <class TTrackTo, typename TV0Table>
+  void fitV0sInParallel(TV0Table const& V0s, int nThreads)
+  {
+    const int nV0s = V0s.size();
+    v0Fits.resize(nV0s);
+    int iV0 = 0;
+    for (auto const& V0 : V0s) {
+      prepareV0Fit<TTrackTo>(V0, v0Fits[iV0++]);
+    }
+
+    workerFitters.assign(nThreads, fitter);
+    auto fitRange = [this](int iThread, int first, int last) {
+      for (int i = first; i < last; i++) {
+        fitV0(v0Fits[i], workerFitters[iThread]);
+      }
+    };
+    std::vector<std::thread> threads;
+    const int chunkSize = (nV0s + nThreads - 1) / nThreads;
+    for (int iThread = 0, first = 0; first < nV0s; iThread++, first += chunkSize) {
+      threads.emplace_back(fitRange, iThread, first, std::min(first + chunkSize, nV0s));
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
   void init(InitContext& context)
   {
     prng.SetSeed(0);
@@ -466,6 +720,13 @@ struct lambdakzeroBuilder {
     h2->GetXaxis()->SetBinLabel(8, "Count: Standard V0");
     h2->GetXaxis()->SetBinLabel(9, "Count: V0 exc. for casc");
 
+    if (prefilterConfigurations.usePrefilter) {
+      auto h3 = registry.add<TH1>("hV0PrefilterRejections", "hV0PrefilterRejections", kTH1D, {{kNPrefilterSteps, -0.5f, kNPrefilterSteps - 0.5f}});
+      h3->GetXaxis()->SetBinLabel(1, "Radius");
+      h3->GetXaxis()->SetBinLabel(2, "DCA V0 Dau");
+      h3->GetXaxis()->SetBinLabel(3, "CosPA");
+    }
+
     randomSeed = static_cast<unsigned int>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
 
     // Optionally, add extra QA histograms to processing chain
@@ -799,34 +1060,22 @@ struct lambdakzeroBuilder {
   }
 
   template <class TTrackTo, typename TV0Object>
-  bool buildV0Candidate(TV0Object const& V0)
+  bool buildV0Candidate(TV0Object const& V0, V0Fit const& fit)
   {
     // Get tracks
     auto const& posTrack = V0.template posTrack_as<TTrackTo>();
     auto const& negTrack = V0.template negTrack_as<TTrackTo>();
 
     // for storing whatever is the relevant quantity for the PV
-    o2::dataformats::VertexBase primaryVertex;
-    if (V0.has_collision()) {
-      auto const& collision = V0.collision();
-      primaryVertex.setPos({collision.posX(), collision.posY(), collision.posZ()});
-      primaryVertex.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
-    } else {
-      primaryVertex.setPos({mVtx->getX(), mVtx->getY(), mVtx->getZ()});
-    }
+    const auto& primaryVertex = fit.primaryVertex;
 
     // value 0.5: any considered V0
     statisticsRegistry.v0stats[kV0All]++;
     if (!V0.has_collision())
       statisticsRegistry.v0statsUnassociated[kV0All]++;
 
-    if (tpcrefit) {
-      if (!(posTrack.trackType() & o2::aod::track::TPCrefit)) {
-        return false;
-      }
-      if (!(negTrack.trackType() & o2::aod::track::TPCrefit)) {
-        return false;
-      }
+    if (fit.status == kFitNoTPCrefit) {
+      return false;
     }
 
     // Passes TPC refit
@@ -834,68 +1083,61 @@ struct lambdakzeroBuilder {
     if (!V0.has_collision())
       statisticsRegistry.v0statsUnassociated[kV0TPCrefit]++;
 
-    // Calculate DCA with respect to the collision associated to the V0, not individual tracks
-    gpu::gpustd::array<float, 2> dcaInfo;
-
-    auto posTrackPar = getTrackPar(posTrack);
-    o2::base::Propagator::Instance()->propagateToDCABxByBz({primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, posTrackPar, 2.f, fitter.getMatCorrType(), &dcaInfo);
-    auto posTrackdcaXY = dcaInfo[0];
-
-    auto negTrackPar = getTrackPar(negTrack);
-    o2::base::Propagator::Instance()->propagateToDCABxByBz({primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, negTrackPar, 2.f, fitter.getMatCorrType(), &dcaInfo);
-    auto negTrackdcaXY = dcaInfo[0];
+    // DCA with respect to the collision associated to the V0, not individual tracks
+    const auto& dcaInfo = fit.dcaInfo;
+    const auto& posTrackPar = fit.posTrackPar;
+    const auto& negTrackPar = fit.negTrackPar;
 
-    if (fabs(posTrackdcaXY) < dcapostopv || fabs(negTrackdcaXY) < dcanegtopv) {
+    if (fit.status == kFitFailedDCAxy) {
       return false;
     }
 
     // Initialize properly, please
-    v0candidate.posDCAxy = posTrackdcaXY;
-    v0candidate.negDCAxy = negTrackdcaXY;
+    v0candidate.posDCAxy = fit.posDCAxy;
+    v0candidate.negDCAxy = fit.negDCAxy;
 
     // passes DCAxy
     statisticsRegistry.v0stats[kV0DCAxy]++;
     if (!V0.has_collision())
       statisticsRegistry.v0statsUnassociated[kV0DCAxy]++;
 
+    // rejected by the analytic prefilter before the fit
+    if (fit.status == kFitPrefilterRejected) {
+      statisticsRegistry.prefilterRejections[fit.prefilterStep]++;
+      return false;
+    }
+
     // Change strangenessBuilder tracks
-    lPositiveTrack = getTrackParCov(posTrack);
-    lNegativeTrack = getTrackParCov(negTrack);
-    lPositiveTrackIU = getTrackParCov(posTrack);
-    lNegativeTrackIU = getTrackParCov(negTrack);
+    lPositiveTrackIU = fit.posTrackIU;
+    lNegativeTrackIU = fit.negTrackIU;
 
     //---/---/---/
     // Move close to minima
-    int nCand = 0;
-    fitter.setCollinear(dcaFitterConfigurations.d_UseCollinearFit || V0.isCollinearV0());
-    try {
-      nCand = fitter.process(lPositiveTrack, lNegativeTrack);
-    } catch (...) {
+    if (fit.status == kFitException) {
       statisticsRegistry.exceptions++;
       LOG(error) << "Exception caught in DCA fitter process call!";
       return false;
     }
-    if (nCand == 0) {
+    if (fit.status == kFitNoCandidate) {
       return false;
     }
 
-    v0candidate.posTrackX = fitter.getTrack(0).getX();
-    v0candidate.negTrackX = fitter.getTrack(1).getX();
+    v0candidate.posTrackX = fit.posTrack.getX();
+    v0candidate.negTrackX = fit.negTrack.getX();
 
-    lPositiveTrack = fitter.getTrack(0);
-    lNegativeTrack = fitter.getTrack(1);
+    lPositiveTrack = fit.posTrack;
+    lNegativeTrack = fit.negTrack;
     lPositiveTrack.getPxPyPzGlo(v0candidate.posP);
     lNegativeTrack.getPxPyPzGlo(v0candidate.negP);
     lPositiveTrack.getXYZGlo(v0candidate.posPosition);
     lNegativeTrack.getXYZGlo(v0candidate.negPosition);
 
     // get decay vertex coordinates
-    const auto& vtx = fitter.getPCACandidate();
     for (int i = 0; i < 3; i++) {
-      v0candidate.pos[i] = vtx[i];
+      v0candidate.pos[i] = fit.pca[i];
     }
 
-    v0candidate.dcaV0dau = TMath::Sqrt(fitter.getChi2AtPCACandidate());
+    v0candidate.dcaV0dau = TMath::Sqrt(fit.chi2PCA);
 
     // Apply selections so a skimmed table is created only
     if (v0candidate.dcaV0dau > dcav0dau) {
@@ -1095,14 +1337,14 @@ struct lambdakzeroBuilder {
       if (!posTrack.hasITS() && !posTrack.hasTRD() && !posTrack.hasTOF() && !negTrack.hasITS() && !negTrack.hasTRD() && !negTrack.hasTOF()) {
         if (V0.isTrueGamma()) {
           registry.fill(HIST("h2d_pcm_DCAXY_True"), lPt, std::hypot(dcaInfo[0], dcaInfo[1]));
-          registry.fill(HIST("h2d_pcm_DCACHI2_True"), lPt, fitter.getChi2AtPCACandidate());
+          registry.fill(HIST("h2d_pcm_DCACHI2_True"), lPt, fit.chi2PCA);
           registry.fill(HIST("h2d_pcm_DeltaDistanceRadii_True"), lPt, centerDistance - trcCircle1.rC - trcCircle2.rC);
           registry.fill(HIST("h2d_pcm_PositionGuess_True"), lPt, delta2);
           registry.fill(HIST("h2d_pcm_RadiallyOutgoingAtThisRadius1_True"), lPt, delta3_track1);
           registry.fill(HIST("h2d_pcm_RadiallyOutgoingAtThisRadius2_True"), lPt, delta3_track2);
         } else {
           registry.fill(HIST("h2d_pcm_DCAXY_Bg"), lPt, std::hypot(dcaInfo[0], dcaInfo[1]));
-          registry.fill(HIST("h2d_pcm_DCACHI2_Bg"), lPt, fitter.getChi2AtPCACandidate());
+          registry.fill(HIST("h2d_pcm_DCACHI2_Bg"), lPt, fit.chi2PCA);
           registry.fill(HIST("h2d_pcm_DeltaDistanceRadii_Bg"), lPt, centerDistance - trcCircle1.rC - trcCircle2.rC);
           registry.fill(HIST("h2d_pcm_PositionGuess_Bg"), lPt, delta2);
           registry.fill(HIST("h2d_pcm_RadiallyOutgoingAtThisRadius1_Bg"), lPt, delta3_track1);
@@ -1117,15 +1359,31 @@ struct lambdakzeroBuilder {
   template <class TTrackTo, typename TV0Table>
   void buildStrangenessTables(TV0Table const& V0s)
   {
+    // with several threads, all the V0s are fitted before the loop
+    const int nThreads = std::max(1, std::min<int>(nThreadsV0Building, V0s.size() / 100 + 1));
+    if (nThreads > 1) {
+      fitV0sInParallel<TTrackTo>(V0s, nThreads);
+    } else {
+      v0Fits.resize(1);
+    }
+
     // Loops over all V0s in the time frame
+    int iV0 = 0;
     for (auto& V0 : V0s) {
+      auto& fit = nThreads > 1 ? v0Fits[iV0++] : v0Fits[0];
+
       // downscale some V0s if requested to do so
       if (downscalingOptions.downscaleFactor < 1.f && (static_cast<float>(rand_r(&randomSeed)) / static_cast<float>(RAND_MAX)) > downscalingOptions.downscaleFactor) {
         return;
       }
 
+      if (nThreads == 1) {
+        prepareV0Fit<TTrackTo>(V0, fit);
+        fitV0(fit, fitter);
+      }
+
       // populates v0candidate struct declared inside strangenessbuilder
-      bool validCandidate = buildV0Candidate<TTrackTo>(V0);
+      bool validCandidate = buildV0Candidate<TTrackTo>(V0, fit);
 
       if (!validCandidate) {
         continue; // doesn't pass selections
@@ -1248,15 +1506,11 @@ struct lambdakzeroBuilder {
       // populate V0 covariance matrices if required by any other task
       if (createV0CovMats) {
         // Calculate position covariance matrix
-        auto covVtxV = fitter.calcPCACovMatrix(0);
         // std::array<float, 6> positionCovariance;
         float positionCovariance[6];
-        positionCovariance[0] = covVtxV(0, 0);
-        positionCovariance[1] = covVtxV(1, 0);
-        positionCovariance[2] = covVtxV(1, 1);
-        positionCovariance[3] = covVtxV(2, 0);
-        positionCovariance[4] = covVtxV(2, 1);
-        positionCovariance[5] = covVtxV(2, 2);
+        for (int i = 0; i < 6; i++) {
+          positionCovariance[i] = fit.covPCA[i];
+        }
         std::array<float, 21> covTpositive = {0.};
         std::array<float, 21> covTnegative = {0.};
         std::array<float, 21> covTpositiveIU = {0.};
@@ -24,6 +24,9 @@
 #include <cmath>
 #include <array>
 #include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <vector>
 
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
@@ -34,6 +37,7 @@
 #include "ReconstructionDataFormats/Track.h"
 #include "Common/Core/RecoDecay.h"
 #include "Common/Core/trackUtilities.h"
+#include "Common/Core/TableHelper.h"
 #include "PWGLF/DataModel/LFStrangenessTables.h"
 #include "PWGLF/DataModel/LFStrangenessPIDTables.h"
 #include "PWGLF/DataModel/LFStrangenessMLTables.h"
@@ -88,6 +92,8 @@ struct lambdakzeromlselection {
   Configurable<bool> PredictGamma{"PredictGamma", true, "Flag to enable or disable the loading of model"};
   Configurable<bool> PredictKZeroShort{"PredictKZeroShort", false, "Flag to enable or disable the loading of model"};
   Configurable<bool> fIsMC{"fIsMC", false, "If true, save additional MC info for analysis"};
+  Configurable<int> mlBatchSize{"mlBatchSize", 1024, "Number of V0s per model call, the features of all the V0s of a data frame are computed at once"};
+  Configurable<bool> skipUnrequiredSpecies{"skipUnrequiredSpecies", false, "Do not evaluate the models whose score table is not used in the workflow"};
 
   // Feature selection masks:
 
@@ -119,11 +125,28 @@ struct lambdakzeromlselection {
   ConfigurableAxis vertexZ{"vertexZ", {30, -15.0f, 15.0f}, ""};
 
   int nCandidates = 0;
-  void init(InitContext const&)
+  std::vector<float> inputFeatures; // row-major feature matrix of the V0s of the data frame
+  std::vector<float> modelOutput;   // output of a model for a batch of V0s
+  std::vector<float> scores;        // score of a species for the V0s of the data frame
+
+  void init(InitContext& context)
   {
     // Histograms
     histos.add("hEventVertexZ", "hEventVertexZ", kTH1F, {vertexZ});
 
+    if (skipUnrequiredSpecies) {
+      const std::array<std::pair<std::string, Configurable<bool>*>, 4> speciesTables{{{"V0LambdaMLScores", &PredictLambda},
+                                                                                       {"V0AntiLambdaMLScores", &PredictAntiLambda},
+                                                                                       {"V0GammaMLScores", &PredictGamma},
+                                                                                       {"V0K0ShortMLScores", &PredictKZeroShort}}};
+      for (const auto& [table, predict] : speciesTables) {
+        if (predict->value && !isTableRequiredInWorkflow(context, table)) {
+          LOG(info) << "Table " << table << " is not used in the workflow, the corresponding model is not evaluated";
+          predict->value = false;
+        }
+      }
+    }
+
     ccdb->setURL(ccdbUrl.value);
     // Retrieve the model from CCDB
     if (loadModelsFromCCDB) {
@@ -189,74 +212,91 @@ struct lambdakzeromlselection {
     LOG(info) << "Feature_SelMask size: " << Feature_SelMask.size();
   }
 
-  template <typename T, typename U>
-  std::vector<float> extractSelectedElements(const std::vector<T>& base_features, const std::vector<U>& Sel_mask)
+  // Append the selected features of a candidate to the feature matrix
+  template <typename TV0Object, typename T>
+  void fillCandidateFeatures(TV0Object const& cand, const std::vector<T>& Feature_SelMask)
   {
-    std::vector<float> selected_elements;
-    for (size_t i = 0; i < Sel_mask.size(); ++i) {
-      if (Sel_mask[i] >= 1) { // If the mask value is true, select the corresponding element
-        selected_elements.push_back(base_features[i]);
+    const std::array<float, 18> base_features{cand.mLambda(), cand.mAntiLambda(),
+                                              cand.mGamma(), cand.mK0Short(),
+                                              cand.pt(), static_cast<float>(cand.qtarm()), cand.alpha(),
+                                              cand.positiveeta(), cand.negativeeta(), cand.eta(),
+                                              cand.z(), cand.v0radius(), static_cast<float>(TMath::ACos(cand.v0cosPA())),
+                                              cand.dcapostopv(), cand.dcanegtopv(), cand.dcaV0daughters(),
+                                              cand.dcav0topv(), cand.psipair()};
+    for (size_t i = 0; i < std::min(Feature_SelMask.size(), base_features.size()); ++i) {
+      if (Feature_SelMask[i] >= 1) { // If the mask value is true, select the corresponding element
+        inputFeatures.push_back(base_features[i]);
       }
     }
-    return selected_elements;
   }
 
-  // Process candidate and store properties in object
-  template <typename TV0Object, typename T>
-  void processCandidate(TV0Object const& cand, const std::vector<T>& Feature_SelMask)
+  // Evaluate a model on the feature matrix in batches of mlBatchSize V0s and fill its score table
+  template <typename TScoreTable>
+  void fillScores(o2::ml::OnnxModel& model, size_t nV0s, TScoreTable& scoreTable)
   {
-    // Select features
-    std::vector<float> base_features{cand.mLambda(), cand.mAntiLambda(),
-                                     cand.mGamma(), cand.mK0Short(),
-                                     cand.pt(), static_cast<float>(cand.qtarm()), cand.alpha(),
-                                     cand.positiveeta(), cand.negativeeta(), cand.eta(),
-                                     cand.z(), cand.v0radius(), static_cast<float>(TMath::ACos(cand.v0cosPA())),
-                                     cand.dcapostopv(), cand.dcanegtopv(), cand.dcaV0daughters(),
-                                     cand.dcav0topv(), cand.psipair()};
-
-    // Apply mask to select features
-    std::vector<float> inputFeatures = extractSelectedElements(base_features, Feature_SelMask);
+    const size_t nFeatures = nV0s > 0 ? inputFeatures.size() / nV0s : 0;
+    const size_t nOutputs = model.getNumOutputNodesLast();
+    const size_t batchSize = std::max(1, mlBatchSize.value);
+    scores.assign(nV0s, -1.f); // -1: inference failed
+    modelOutput.resize(std::min(batchSize, nV0s) * nOutputs);
+    for (size_t first = 0; first < nV0s; first += batchSize) {
+      const size_t nRows = std::min(batchSize, nV0s - first);
+      if (!model.evalModelBatch(inputFeatures.data() + first * nFeatures, nRows, modelOutput.data())) {
+        continue;
+      }
+      for (size_t iRow = 0; iRow < nRows; iRow++) {
+        scores[first + iRow] = modelOutput[iRow * nOutputs + 1];
+      }
+    }
+    scoreTable.reserve(nV0s);
+    for (const auto& score : scores) {
+      scoreTable(score);
+    }
+  }
+
+  // Compute the features of all the candidates, then evaluate each enabled model on them
+  template <typename TV0Table, typename T>
+  void processCandidates(TV0Table const& v0s, const std::vector<T>& Feature_SelMask)
+  {
+    if (nCandidates / 50000 != (nCandidates + v0s.size()) / 50000) {
+      LOG(info) << "Candidates processed: " << nCandidates + v0s.size();
+    }
+    nCandidates += v0s.size();
+
+    inputFeatures.clear();
+    inputFeatures.reserve(v0s.size() * std::count_if(Feature_SelMask.begin(), Feature_SelMask.end(), [](const auto& mask) { return mask >= 1; }));
+    for (const auto& v0 : v0s) {
+      fillCandidateFeatures(v0, Feature_SelMask);
+    }
 
     // calculate classifier output
     if (PredictLambda) {
-      float* LambdaProbability = lambda_bdt.evalModel(inputFeatures);
-      lambdaMLSelections(LambdaProbability[1]);
+      fillScores(lambda_bdt, v0s.size(), lambdaMLSelections);
     }
     if (PredictGamma) {
-      float* GammaProbability = gamma_bdt.evalModel(inputFeatures);
-      gammaMLSelections(GammaProbability[1]);
+      fillScores(gamma_bdt, v0s.size(), gammaMLSelections);
     }
     if (PredictAntiLambda) {
-      float* AntiLambdaProbability = antilambda_bdt.evalModel(inputFeatures);
-      antiLambdaMLSelections(AntiLambdaProbability[1]);
+      fillScores(antilambda_bdt, v0s.size(), antiLambdaMLSelections);
     }
     if (PredictKZeroShort) {
-      float* KZeroShortProbability = kzeroshort_bdt.evalModel(inputFeatures);
-      kzeroShortMLSelections(KZeroShortProbability[1]);
+      fillScores(kzeroshort_bdt, v0s.size(), kzeroShortMLSelections);
     }
   }
 
-  void processDerivedData(aod::StraCollision const& coll, V0DerivedDatas const& v0s)
+  void processDerivedData(aod::StraCollisions const& colls, V0DerivedDatas const& v0s)
   {
-    histos.fill(HIST("hEventVertexZ"), coll.posZ());
-    for (auto& v0 : v0s) {
-      nCandidates++;
-      if (nCandidates % 50000 == 0) {
-        LOG(info) << "Candidates processed: " << nCandidates;
-      }
-      processCandidate(v0, Feature_SelMask);
+    for (const auto& coll : colls) {
+      histos.fill(HIST("hEventVertexZ"), coll.posZ());
     }
+    processCandidates(v0s, Feature_SelMask);
   }
-  void processStandardData(aod::Collision const& coll, V0OriginalDatas const& v0s)
+  void processStandardData(aod::Collisions const& colls, V0OriginalDatas const& v0s)
   {
-    histos.fill(HIST("hEventVertexZ"), coll.posZ());
-    for (auto& v0 : v0s) {
-      nCandidates++;
-      if (nCandidates % 50000 == 0) {
-        LOG(info) << "Candidates processed: " << nCandidates;
-      }
-      processCandidate(v0, Feature_SelMask);
+    for (const auto& coll : colls) {
+      histos.fill(HIST("hEventVertexZ"), coll.posZ());
     }
+    processCandidates(v0s, Feature_SelMask);
   }
 
   PROCESS_SWITCH(lambdakzeromlselection, processStandardData, "Process standard data", false);
@@ -23,6 +23,7 @@
 #include <Math/Vector4D.h>
 #include <cmath>
 #include <array>
+#include <vector>
 #include <cstdlib>
 
 #include "Framework/runDataProcessing.h"
@@ -123,34 +124,21 @@ struct sigma0builder {
     float Rapidity;
   } sigmaCandidate;
 
-  // Process sigma candidate and store properties in object
+  // V0s of the current collision passing the photon and the lambda selections
+  std::vector<int64_t> photonCandidates;
+  std::vector<int64_t> lambdaCandidates;
+
+  // Photon selection of a V0, independent of the lambda it is paired with
   template <typename TV0Object>
-  bool processSigmaCandidate(TV0Object const& lambda, TV0Object const& gamma)
+  bool isPhotonCandidate(TV0Object const& gamma)
   {
-    float GammaBDTScore = -1;
-    float LambdaBDTScore = -1;
-    float AntiLambdaBDTScore = -1;
-
-    if ((lambda.v0Type() == 0) || (gamma.v0Type() == 0))
+    if (gamma.v0Type() == 0)
       return false;
 
-    if constexpr (
-      requires { gamma.gammaBDTScore(); } &&
-      requires { lambda.lambdaBDTScore(); } &&
-      requires { lambda.antiLambdaBDTScore(); }) {
-
-      LOGF(info, "X-check: ML Selection is on!");
+    if constexpr (requires { gamma.gammaBDTScore(); }) {
       // Gamma selection:
       if (gamma.gammaBDTScore() <= Gamma_MLThreshold)
         return false;
-
-      // Lambda and AntiLambda selection
-      if ((lambda.lambdaBDTScore() <= Lambda_MLThreshold) && (lambda.antiLambdaBDTScore() <= AntiLambda_MLThreshold))
-        return false;
-
-      GammaBDTScore = gamma.gammaBDTScore();
-      LambdaBDTScore = lambda.lambdaBDTScore();
-      AntiLambdaBDTScore = lambda.antiLambdaBDTScore();
     } else {
       // Standard selection
       // Gamma basic selection criteria:
@@ -164,7 +152,24 @@ struct sigma0builder {
         return false;
       if ((gamma.v0radius() < PhotonMinRadius) || (gamma.v0radius() > PhotonMaxRadius))
         return false;
+    }
+    return true;
+  }
 
+  // Lambda selection of a V0, independent of the photon it is paired with
+  template <typename TV0Object>
+  bool isLambdaCandidate(TV0Object const& lambda)
+  {
+    if (lambda.v0Type() == 0)
+      return false;
+
+    if constexpr (
+      requires { lambda.lambdaBDTScore(); } &&
+      requires { lambda.antiLambdaBDTScore(); }) {
+      // Lambda and AntiLambda selection
+      if ((lambda.lambdaBDTScore() <= Lambda_MLThreshold) && (lambda.antiLambdaBDTScore() <= AntiLambda_MLThreshold))
+        return false;
+    } else {
       // Lambda basic selection criteria:
       if (TMath::Abs(lambda.mLambda() - 1.115683) > LambdaWindow)
         return false;
@@ -177,6 +182,41 @@ struct sigma0builder {
       if (lambda.dcaV0daughters() > Lambdadcav0dau)
         return false;
     }
+    return true;
+  }
+
+  // Splits the V0s of a collision into photon and lambda candidates, keeping the order of the table
+  // A V0 passing both selections is in both lists, as in the pairing of all the V0s with each other
+  template <typename TV0s>
+  void selectCandidates(TV0s const& V0Table_thisCollision)
+  {
+    photonCandidates.clear();
+    lambdaCandidates.clear();
+    for (auto& v0 : V0Table_thisCollision) {
+      if (isPhotonCandidate(v0))
+        photonCandidates.push_back(v0.globalIndex());
+      if (isLambdaCandidate(v0))
+        lambdaCandidates.push_back(v0.globalIndex());
+    }
+  }
+
+  // Process sigma candidate and store properties in object
+  // The photon and the lambda have passed isPhotonCandidate and isLambdaCandidate
+  template <typename TV0Object>
+  bool processSigmaCandidate(TV0Object const& lambda, TV0Object const& gamma)
+  {
+    float GammaBDTScore = -1;
+    float LambdaBDTScore = -1;
+    float AntiLambdaBDTScore = -1;
+
+    if constexpr (
+      requires { gamma.gammaBDTScore(); } &&
+      requires { lambda.lambdaBDTScore(); } &&
+      requires { lambda.antiLambdaBDTScore(); }) {
+      GammaBDTScore = gamma.gammaBDTScore();
+      LambdaBDTScore = lambda.lambdaBDTScore();
+      AntiLambdaBDTScore = lambda.antiLambdaBDTScore();
+    }
 
     // Sigma0 candidate properties
     std::array<float, 3> pVecPhotons{gamma.px(), gamma.py(), gamma.pz()};
@@ -294,8 +334,11 @@ struct sigma0builder {
       auto V0Table_thisCollision = V0s.sliceBy(perCollisionMCDerived, collIdx);
 
       // V0 table sliced
-      for (auto& gamma : V0Table_thisCollision) {    // selecting photons from Sigma0
-        for (auto& lambda : V0Table_thisCollision) { // selecting lambdas from Sigma0
+      selectCandidates(V0Table_thisCollision);
+      for (auto gammaIdx : photonCandidates) { // selecting photons from Sigma0
+        auto gamma = V0s.rawIteratorAt(gammaIdx);
+        for (auto lambdaIdx : lambdaCandidates) { // selecting lambdas from Sigma0
+          auto lambda = V0s.rawIteratorAt(lambdaIdx);
           if (!processSigmaCandidate(lambda, gamma))
             continue;
 
@@ -320,8 +363,11 @@ struct sigma0builder {
       v0sigma0Coll(coll.posX(), coll.posY(), coll.posZ(), coll.centFT0M(), coll.centFT0A(), coll.centFT0C(), coll.centFV0A());
 
       // V0 table sliced
-      for (auto& gamma : V0Table_thisCollision) {    // selecting photons from Sigma0
-        for (auto& lambda : V0Table_thisCollision) { // selecting lambdas from Sigma0
+      selectCandidates(V0Table_thisCollision);
+      for (auto gammaIdx : photonCandidates) { // selecting photons from Sigma0
+        auto gamma = V0s.rawIteratorAt(gammaIdx);
+        for (auto lambdaIdx : lambdaCandidates) { // selecting lambdas from Sigma0
+          auto lambda = V0s.rawIteratorAt(lambdaIdx);
           if (!processSigmaCandidate(lambda, gamma))
             continue;
 
@@ -346,8 +392,11 @@ struct sigma0builder {
       v0sigma0Coll(coll.posX(), coll.posY(), coll.posZ(), coll.centFT0M(), coll.centFT0A(), coll.centFT0C(), coll.centFV0A());
 
       // V0 table sliced
-      for (auto& gamma : V0Table_thisCollision) {    // selecting photons from Sigma0
-        for (auto& lambda : V0Table_thisCollision) { // selecting lambdas from Sigma0
+      selectCandidates(V0Table_thisCollision);
+      for (auto gammaIdx : photonCandidates) { // selecting photons from Sigma0
+        auto gamma = V0s.rawIteratorAt(gammaIdx);
+        for (auto lambdaIdx : lambdaCandidates) { // selecting lambdas from Sigma0
+          auto lambda = V0s.rawIteratorAt(lambdaIdx);
           if (!processSigmaCandidate(lambda, gamma))
             continue;
 
@@ -21,6 +21,7 @@
 #include <map>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 #include "Framework/runDataProcessing.h"
 #include "Framework/RunningWorkflowInfo.h"
@@ -177,12 +178,11 @@ struct strangederivedbuilder {
   Configurable<bool> qaCentrality{"qaCentrality", false, "qa centrality flag: check base raw values"};
 
   // For manual sliceBy
-  Preslice<aod::V0Datas> V0perCollision = o2::aod::v0data::collisionId;
-  Preslice<aod::CascDatas> CascperCollision = o2::aod::cascdata::collisionId;
-  Preslice<aod::KFCascDatas> KFCascperCollision = o2::aod::cascdata::collisionId;
-  Preslice<aod::TraCascDatas> TraCascperCollision = o2::aod::cascdata::collisionId;
   Preslice<aod::McParticles> mcParticlePerMcCollision = o2::aod::mcparticle::mcCollisionId;
 
+  // index of each collision of the data frame in the derived collision table, -1 if not kept
+  std::vector<int> collisionIndexMap;
+
   std::vector<uint32_t> genK0Short;
   std::vector<uint32_t> genLambda;
   std::vector<uint32_t> genAntiLambda;
@@ -252,14 +252,37 @@ struct strangederivedbuilder {
     }
   }
 
+  // marks the collisions with at least one strange candidate (or all of them if fillEmptyCollisions)
+  // and converts the flags into derived collision indices with a running sum
+  template <typename TCollisions, typename... TStraTables>
+  void buildCollisionIndexMap(TCollisions const& collisions, TStraTables const&... straTables)
+  {
+    collisionIndexMap.assign(collisions.size(), fillEmptyCollisions ? 1 : 0);
+    auto markCollisions = [&](auto const& straTable) {
+      for (const auto& candidate : straTable) {
+        if (candidate.collisionId() >= 0) {
+          collisionIndexMap[candidate.collisionId()] = 1;
+        }
+      }
+    };
+    (markCollisions(straTables), ...);
+    int nKept = 0;
+    for (auto& index : collisionIndexMap) {
+      index = index ? nKept++ : -1;
+    }
+  }
+
+  // derived collision index of a strange candidate, -1 if the candidate is not assigned to a collision
+  int getDerivedCollisionIndex(int collisionId) const
+  {
+    return collisionId >= 0 ? collisionIndexMap[collisionId] : -1;
+  }
+
   void processCollisionsV0sOnly(soa::Join<aod::Collisions, aod::FT0Mults, aod::FV0Mults, aod::PVMults, aod::ZDCMults, aod::CentFT0Ms, aod::CentFT0As, aod::CentFT0Cs, aod::CentFV0As, aod::EvSels, aod::MultsExtra, aod::MultsGlobal> const& collisions, aod::V0Datas const& V0s, aod::BCsWithTimestamps const&)
   {
+    buildCollisionIndexMap(collisions, V0s);
     for (const auto& collision : collisions) {
-      const uint64_t collIdx = collision.globalIndex();
-      auto V0Table_thisColl = V0s.sliceBy(V0perCollision, collIdx);
-      bool strange = V0Table_thisColl.size() > 0;
-      // casc table sliced
-      if (strange || fillEmptyCollisions) {
+      if (collisionIndexMap[collision.globalIndex()] >= 0) {
         strangeColl(collision.posX(), collision.posY(), collision.posZ());
         strangeCents(collision.centFT0M(), collision.centFT0A(),
                      collision.centFT0C(), collision.centFV0A());
@@ -286,18 +309,15 @@ struct strangederivedbuilder {
                           collision.trackOccupancyInTimeRange());
         }
       }
-      for (int i = 0; i < V0Table_thisColl.size(); i++)
-        v0collref(strangeColl.lastIndex());
     }
+    for (const auto& v0 : V0s)
+      v0collref(getDerivedCollisionIndex(v0.collisionId()));
   }
 
   void processCollisions(soa::Join<aod::Collisions, aod::FT0Mults, aod::FV0Mults, aod::PVMults, aod::ZDCMults, aod::CentFT0Ms, aod::CentFT0As, aod::CentFT0Cs, aod::CentFV0As, aod::EvSels, aod::MultsExtra, aod::MultsGlobal> const& collisions, aod::V0Datas const& V0s, aod::CascDatas const& Cascades, aod::KFCascDatas const& KFCascades, aod::TraCascDatas const& TraCascades, aod::BCsWithTimestamps const&)
   {
     // create collision indices beforehand
-    std::vector<int> V0CollIndices(V0s.size(), -1);                 // index -1: no collision
-    std::vector<int> CascadeCollIndices(Cascades.size(), -1);       // index -1: no collision
-    std::vector<int> KFCascadeCollIndices(KFCascades.size(), -1);   // index -1: no collision
-    std::vector<int> TraCascadeCollIndices(TraCascades.size(), -1); // index -1: no collision
+    buildCollisionIndexMap(collisions, V0s, Cascades, KFCascades, TraCascades);
 
     for (const auto& collision : collisions) {
       const uint64_t collIdx = collision.globalIndex();
@@ -308,16 +328,7 @@ struct strangederivedbuilder {
         centrality = hRawCentrality->GetBinContent(hRawCentrality->FindBin(collision.multFT0C()));
       }
 
-      auto V0Table_thisColl = V0s.sliceBy(V0perCollision, collIdx);
-      auto CascTable_thisColl = Cascades.sliceBy(CascperCollision, collIdx);
-      auto KFCascTable_thisColl = KFCascades.sliceBy(KFCascperCollision, collIdx);
-      auto TraCascTable_thisColl = TraCascades.sliceBy(TraCascperCollision, collIdx);
-      bool strange = V0Table_thisColl.size() > 0 ||
-                     CascTable_thisColl.size() > 0 ||
-                     KFCascTable_thisColl.size() > 0 ||
-                     TraCascTable_thisColl.size() > 0;
-      // casc table sliced
-      if (strange || fillEmptyCollisions) {
+      if (collisionIndexMap[collIdx] >= 0) {
         strangeColl(collision.posX(), collision.posY(), collision.posZ());
         strangeCents(collision.centFT0M(), collision.centFT0A(),
                      centrality, collision.centFV0A());
@@ -344,37 +355,23 @@ struct strangederivedbuilder {
                           collision.trackOccupancyInTimeRange());
         }
       }
-
-      for (const auto& v0 : V0Table_thisColl)
-        V0CollIndices[v0.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : CascTable_thisColl)
-        CascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : KFCascTable_thisColl)
-        KFCascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : TraCascTable_thisColl)
-        TraCascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
     }
 
     // populate references, including those that might not be assigned
     for (const auto& v0 : V0s)
-      v0collref(V0CollIndices[v0.globalIndex()]);
+      v0collref(getDerivedCollisionIndex(v0.collisionId()));
     for (const auto& casc : Cascades)
-      casccollref(CascadeCollIndices[casc.globalIndex()]);
+      casccollref(getDerivedCollisionIndex(casc.collisionId()));
     for (const auto& casc : KFCascades)
-      kfcasccollref(KFCascadeCollIndices[casc.globalIndex()]);
-    for (const auto& casc : KFCascades)
-      tracasccollref(TraCascadeCollIndices[casc.globalIndex()]);
+      kfcasccollref(getDerivedCollisionIndex(casc.collisionId()));
+    for (const auto& casc : TraCascades)
+      tracasccollref(getDerivedCollisionIndex(casc.collisionId()));
   }
 
   void processCollisionsMC(soa::Join<aod::Collisions, aod::FT0Mults, aod::FV0Mults, aod::PVMults, aod::ZDCMults, aod::CentFT0Ms, aod::CentFT0As, aod::CentFT0Cs, aod::CentFV0As, aod::EvSels, aod::McCollisionLabels, aod::MultsExtra, aod::MultsGlobal> const& collisions, soa::Join<aod::V0Datas, aod::McV0Labels> const& V0s, soa::Join<aod::CascDatas, aod::McCascLabels> const& Cascades, aod::KFCascDatas const& KFCascades, aod::TraCascDatas const& TraCascades, aod::BCsWithTimestamps const&, soa::Join<aod::McCollisions, aod::MultsExtraMC> const& mcCollisions, aod::McParticles const&)
   {
     // create collision indices beforehand
-    std::vector<int> V0CollIndices(V0s.size(), -1);                 // index -1: no collision
-    std::vector<int> V0MCCollIndices(V0s.size(), -1);               // index -1: no collision
-    std::vector<int> CascadeCollIndices(Cascades.size(), -1);       // index -1: no collision
-    std::vector<int> CascadeMCCollIndices(Cascades.size(), -1);     // index -1: no collision
-    std::vector<int> KFCascadeCollIndices(KFCascades.size(), -1);   // index -1: no collision
-    std::vector<int> TraCascadeCollIndices(TraCascades.size(), -1); // index -1: no collision
+    buildCollisionIndexMap(collisions, V0s, Cascades, KFCascades, TraCascades);
 
     // ______________________________________________
     // fill all MC collisions, correlate via index later on
@@ -396,16 +393,7 @@ struct strangederivedbuilder {
         centrality = hRawCentrality->GetBinContent(hRawCentrality->FindBin(collision.multFT0C()));
       }
 
-      auto V0Table_thisColl = V0s.sliceBy(V0perCollision, collIdx);
-      auto CascTable_thisColl = Cascades.sliceBy(CascperCollision, collIdx);
-      auto KFCascTable_thisColl = KFCascades.sliceBy(KFCascperCollision, collIdx);
-      auto TraCascTable_thisColl = TraCascades.sliceBy(TraCascperCollision, collIdx);
-      bool strange = V0Table_thisColl.size() > 0 ||
-                     CascTable_thisColl.size() > 0 ||
-                     KFCascTable_thisColl.size() > 0 ||
-                     TraCascTable_thisColl.size() > 0;
-      // casc table sliced
-      if (strange || fillEmptyCollisions) {
+      if (collisionIndexMap[collIdx] >= 0) {
         strangeColl(collision.posX(), collision.posY(), collision.posZ());
         strangeCollLabels(collision.mcCollisionId());
         strangeCents(collision.centFT0M(), collision.centFT0A(),
@@ -433,51 +421,35 @@ struct strangederivedbuilder {
                           collision.trackOccupancyInTimeRange());
         }
       }
-      for (const auto& v0 : V0Table_thisColl)
-        V0CollIndices[v0.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : CascTable_thisColl)
-        CascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : KFCascTable_thisColl)
-        KFCascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : TraCascTable_thisColl)
-        TraCascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
-
-      // populate MC collision references
-      for (const auto& v0 : V0Table_thisColl) {
-        uint32_t indMCColl = -1;
-        if (v0.has_mcParticle()) {
-          auto mcParticle = v0.mcParticle();
-          if (mcParticle.has_mcCollision()) {
-            indMCColl = mcParticle.mcCollisionId();
-          }
-        }
-        V0MCCollIndices[v0.globalIndex()] = indMCColl;
-      }
-      for (const auto& casc : CascTable_thisColl) {
-        uint32_t indMCColl = -1;
-        if (casc.has_mcParticle()) {
-          auto mcParticle = casc.mcParticle();
-          if (mcParticle.has_mcCollision()) {
-            indMCColl = mcParticle.mcCollisionId();
-          }
-        }
-        CascadeMCCollIndices[casc.globalIndex()] = indMCColl;
-      }
     }
 
     // populate references, including those that might not be assigned
     for (const auto& v0 : V0s) {
-      v0collref(V0CollIndices[v0.globalIndex()]);
-      v0mccollref(V0MCCollIndices[v0.globalIndex()]);
+      int indMCColl = -1;
+      if (v0.has_mcParticle()) {
+        auto mcParticle = v0.mcParticle();
+        if (mcParticle.has_mcCollision()) {
+          indMCColl = mcParticle.mcCollisionId();
+        }
+      }
+      v0collref(getDerivedCollisionIndex(v0.collisionId()));
+      v0mccollref(indMCColl);
     }
     for (const auto& casc : Cascades) {
-      casccollref(CascadeCollIndices[casc.globalIndex()]);
-      cascmccollref(CascadeMCCollIndices[casc.globalIndex()]);
+      int indMCColl = -1;
+      if (casc.has_mcParticle()) {
+        auto mcParticle = casc.mcParticle();
+        if (mcParticle.has_mcCollision()) {
+          indMCColl = mcParticle.mcCollisionId();
+        }
+      }
+      casccollref(getDerivedCollisionIndex(casc.collisionId()));
+      cascmccollref(indMCColl);
     }
     for (const auto& casc : KFCascades)
-      kfcasccollref(KFCascadeCollIndices[casc.globalIndex()]);
-    for (const auto& casc : KFCascades)
-      tracasccollref(TraCascadeCollIndices[casc.globalIndex()]);
+      kfcasccollref(getDerivedCollisionIndex(casc.collisionId()));
+    for (const auto& casc : TraCascades)
+      tracasccollref(getDerivedCollisionIndex(casc.collisionId()));
   }
 
   void processTrackExtrasV0sOnly(aod::V0Datas const& V0s, TracksWithExtra const& tracksExtra)
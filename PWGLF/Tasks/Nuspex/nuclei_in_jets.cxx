@@ -37,6 +37,7 @@
 #include "Common/DataModel/EventSelection.h"
 #include "Common/DataModel/Centrality.h"
 #include "Common/DataModel/PIDResponse.h"
+#include "PWGLF/Utils/inJetCones.h"
 
 using namespace std;
 using namespace o2;
@@ -350,24 +351,6 @@ struct nuclei_in_jets {
     return x_min;
   }
 
-  // Deltaphi
-  double GetDeltaPhi(double a1, double a2)
-  {
-
-    double delta_phi(0);
-
-    double phi1 = TVector2::Phi_0_2pi(a1);
-    double phi2 = TVector2::Phi_0_2pi(a2);
-    double diff = TMath::Abs(phi1 - phi2);
-
-    if (diff <= TMath::Pi())
-      delta_phi = diff;
-    if (diff > TMath::Pi())
-      delta_phi = TMath::TwoPi() - diff;
-
-    return delta_phi;
-  }
-
   float Weight(float pt, int event_region, int nucleus_of_interest)
   {
 
@@ -418,56 +401,6 @@ struct nuclei_in_jets {
     return dNdpt;
   }
 
-  void get_perpendicular_axis(TVector3 p, TVector3& u, double sign)
-  {
-
-    // Initialization
-    double ux(0), uy(0), uz(0);
-
-    // Components of Vector p
-    double px = p.X();
-    double py = p.Y();
-    double pz = p.Z();
-
-    // Protection 1
-    if (px == 0 && py != 0) {
-
-      uy = -(pz * pz) / py;
-      ux = sign * sqrt(py * py - (pz * pz * pz * pz) / (py * py));
-      uz = pz;
-      u.SetXYZ(ux, uy, uz);
-      return;
-    }
-
-    // Protection 2
-    if (py == 0 && px != 0) {
-
-      ux = -(pz * pz) / px;
-      uy = sign * sqrt(px * px - (pz * pz * pz * pz) / (px * px));
-      uz = pz;
-      u.SetXYZ(ux, uy, uz);
-      return;
-    }
-
-    // Equation Parameters
-    double a = px * px + py * py;
-    double b = 2.0 * px * pz * pz;
-    double c = pz * pz * pz * pz - py * py * py * py - px * px * py * py;
-    double delta = b * b - 4.0 * a * c;
-
-    // Protection agains delta<0
-    if (delta < 0) {
-      return;
-    }
-
-    // Solutions
-    ux = (-b + sign * sqrt(delta)) / (2.0 * a);
-    uy = (-pz * pz - px * ux) / py;
-    uz = pz;
-    u.SetXYZ(ux, uy, uz);
-    return;
-  }
-
   // Lorentz Transformation
   TLorentzVector LorentzTransform(TLorentzVector R, TVector3 beta_vect)
   {
@@ -618,7 +551,7 @@ struct nuclei_in_jets {
         float one_over_pt2_part = 1.0 / (p_particle.Pt() * p_particle.Pt());
         float one_over_pt2_lead = 1.0 / (p_leading.Pt() * p_leading.Pt());
         float deltaEta = p_particle.Eta() - p_leading.Eta();
-        float deltaPhi = GetDeltaPhi(p_particle.Phi(), p_leading.Phi());
+        float deltaPhi = o2::pwglf::getDeltaPhiAbs(p_particle.Phi(), p_leading.Phi());
         float min = Minimum(one_over_pt2_part, one_over_pt2_lead);
         float Delta2 = deltaEta * deltaEta + deltaPhi * deltaPhi;
 
@@ -678,7 +611,7 @@ struct nuclei_in_jets {
       TVector3 p_i(jet_track.px(), jet_track.py(), jet_track.pz());
 
       float deltaEta = p_i.Eta() - p_leading.Eta();
-      float deltaPhi = GetDeltaPhi(p_i.Phi(), p_leading.Phi());
+      float deltaPhi = o2::pwglf::getDeltaPhiAbs(p_i.Phi(), p_leading.Phi());
       float R = TMath::Sqrt(deltaEta * deltaEta + deltaPhi * deltaPhi);
       if (R < Rmax_jet_ue)
         nParticlesJetAndUE++;
@@ -699,15 +632,9 @@ struct nuclei_in_jets {
     registryQC.fill(HIST("jet_plus_ue_multiplicity"), nParticlesJetAndUE);
 
     // Perpendicular Cones for UE Estimate
-    TVector3 ue_axis1(0.0, 0.0, 0.0);
-    TVector3 ue_axis2(0.0, 0.0, 0.0);
-    get_perpendicular_axis(p_leading, ue_axis1, +1.0);
-    get_perpendicular_axis(p_leading, ue_axis2, -1.0);
-
+    TVector3 ue_axis1, ue_axis2;
     // Protection against delta<0
-    if (ue_axis1.X() == 0 && ue_axis1.Y() == 0 && ue_axis1.Z() == 0)
-      return;
-    if (ue_axis2.X() == 0 && ue_axis2.Y() == 0 && ue_axis2.Z() == 0)
+    if (!o2::pwglf::getPerpendicularConeAxes(p_leading, ue_axis1, ue_axis2))
       return;
 
     registryQC.fill(HIST("number_of_events_data"), 8.5);
@@ -726,10 +653,10 @@ struct nuclei_in_jets {
 
       // Variables
       float deltaEta1 = ue_track.eta() - ue_axis1.Eta();
-      float deltaPhi1 = GetDeltaPhi(ue_track.phi(), ue_axis1.Phi());
+      float deltaPhi1 = o2::pwglf::getDeltaPhiAbs(ue_track.phi(), ue_axis1.Phi());
       float dr1 = TMath::Sqrt(deltaEta1 * deltaEta1 + deltaPhi1 * deltaPhi1);
       float deltaEta2 = ue_track.eta() - ue_axis2.Eta();
-      float deltaPhi2 = GetDeltaPhi(ue_track.phi(), ue_axis2.Phi());
+      float deltaPhi2 = o2::pwglf::getDeltaPhiAbs(ue_track.phi(), ue_axis2.Phi());
       float dr2 = TMath::Sqrt(deltaEta2 * deltaEta2 + deltaPhi2 * deltaPhi2);
 
       // Store Particles in the UE
@@ -761,7 +688,7 @@ struct nuclei_in_jets {
       TVector3 p_i(jet_track.px(), jet_track.py(), jet_track.pz());
 
       float deltaEta = p_i.Eta() - p_leading.Eta();
-      float deltaPhi = GetDeltaPhi(p_i.Phi(), p_leading.Phi());
+      float deltaPhi = o2::pwglf::getDeltaPhiAbs(p_i.Phi(), p_leading.Phi());
       float R = TMath::Sqrt(deltaEta * deltaEta + deltaPhi * deltaPhi);
       if (R > Rmax_jet_ue)
         continue;
@@ -1142,7 +1069,7 @@ struct nuclei_in_jets {
           float one_over_pt2_part = 1.0 / (p_particle.Pt() * p_particle.Pt());
           float one_over_pt2_lead = 1.0 / (p_leading.Pt() * p_leading.Pt());
           float deltaEta = p_particle.Eta() - p_leading.Eta();
-          float deltaPhi = GetDeltaPhi(p_particle.Phi(), p_leading.Phi());
+          float deltaPhi = o2::pwglf::getDeltaPhiAbs(p_particle.Phi(), p_leading.Phi());
           float min = Minimum(one_over_pt2_part, one_over_pt2_lead);
           float Delta2 = deltaEta * deltaEta + deltaPhi * deltaPhi;
 
@@ -1195,15 +1122,9 @@ struct nuclei_in_jets {
       registryQC.fill(HIST("event_counter_mc"), 3.5);
 
       // Perpendicular Cones for UE Estimate
-      TVector3 ue_axis1(0.0, 0.0, 0.0);
-      TVector3 ue_axis2(0.0, 0.0, 0.0);
-      get_perpendicular_axis(p_leading, ue_axis1, +1.0);
-      get_perpendicular_axis(p_leading, ue_axis2, -1.0);
-
+      TVector3 ue_axis1, ue_axis2;
       // Protection against delta<0
-      if (ue_axis1.X() == 0 && ue_axis1.Y() == 0 && ue_axis1.Z() == 0)
-        continue;
-      if (ue_axis2.X() == 0 && ue_axis2.Y() == 0 && ue_axis2.Z() == 0)
+      if (!o2::pwglf::getPerpendicularConeAxes(p_leading, ue_axis1, ue_axis2))
         continue;
       registryQC.fill(HIST("event_counter_mc"), 4.5);
 
@@ -1221,10 +1142,10 @@ struct nuclei_in_jets {
 
         // Variables
         float deltaEta1 = ue_track.eta() - ue_axis1.Eta();
-        float deltaPhi1 = GetDeltaPhi(ue_track.phi(), ue_axis1.Phi());
+        float deltaPhi1 = o2::pwglf::getDeltaPhiAbs(ue_track.phi(), ue_axis1.Phi());
         float dr1 = TMath::Sqrt(deltaEta1 * deltaEta1 + deltaPhi1 * deltaPhi1);
         float deltaEta2 = ue_track.eta() - ue_axis2.Eta();
-        float deltaPhi2 = GetDeltaPhi(ue_track.phi(), ue_axis2.Phi());
+        float deltaPhi2 = o2::pwglf::getDeltaPhiAbs(ue_track.phi(), ue_axis2.Phi());
         float dr2 = TMath::Sqrt(deltaEta2 * deltaEta2 + deltaPhi2 * deltaPhi2);
 
         // Store Particles in the UE 1
@@ -1247,7 +1168,7 @@ struct nuclei_in_jets {
         const auto& jet_track = mcParticles_per_coll.iteratorAt(jet_particle_ID[i]);
 
         float deltaEta = jet_track.eta() - p_leading.Eta();
-        float deltaPhi = GetDeltaPhi(jet_track.phi(), p_leading.Phi());
+        float deltaPhi = o2::pwglf::getDeltaPhiAbs(jet_track.phi(), p_leading.Phi());
         float R = TMath::Sqrt(deltaEta * deltaEta + deltaPhi * deltaPhi);
         if (R > Rmax_jet_ue)
           continue;
@@ -1406,7 +1327,7 @@ struct nuclei_in_jets {
           float one_over_pt2_part = 1.0 / (p_particle.Pt() * p_particle.Pt());
           float one_over_pt2_lead = 1.0 / (p_leading.Pt() * p_leading.Pt());
           float deltaEta = p_particle.Eta() - p_leading.Eta();
-          float deltaPhi = GetDeltaPhi(p_particle.Phi(), p_leading.Phi());
+          float deltaPhi = o2::pwglf::getDeltaPhiAbs(p_particle.Phi(), p_leading.Phi());
           float min = Minimum(one_over_pt2_part, one_over_pt2_lead);
           float Delta2 = deltaEta * deltaEta + deltaPhi * deltaPhi;
 
@@ -1458,16 +1379,10 @@ struct nuclei_in_jets {
           continue;
 
       // Perpendicular Cones for UE Estimate
-      TVector3 ue_axis1(0.0, 0.0, 0.0);
-      TVector3 ue_axis2(0.0, 0.0, 0.0);
-      get_perpendicular_axis(p_leading, ue_axis1, +1.0);
-      get_perpendicular_axis(p_leading, ue_axis2, -1.0);
-
+      TVector3 ue_axis1, ue_axis2;
       // Protection against delta<0
-      if (ue_axis1.X() == 0 && ue_axis1.Y() == 0 && ue_axis1.Z() == 0)
-          continue;
-      if (ue_axis2.X() == 0 && ue_axis2.Y() == 0 && ue_axis2.Z() == 0)
-          continue;
+      if (!o2::pwglf::getPerpendicularConeAxes(p_leading, ue_axis1, ue_axis2))
+        continue;
 
       // Store UE
       std::vector<int> ue_particle_ID;
@@ -1483,10 +1398,10 @@ struct nuclei_in_jets {
 
         // Variables
         float deltaEta1 = ue_track.eta() - ue_axis1.Eta();
-        float deltaPhi1 = GetDeltaPhi(ue_track.phi(), ue_axis1.Phi());
+        float deltaPhi1 = o2::pwglf::getDeltaPhiAbs(ue_track.phi(), ue_axis1.Phi());
         float dr1 = TMath::Sqrt(deltaEta1 * deltaEta1 + deltaPhi1 * deltaPhi1);
         float deltaEta2 = ue_track.eta() - ue_axis2.Eta();
-        float deltaPhi2 = GetDeltaPhi(ue_track.phi(), ue_axis2.Phi());
+        float deltaPhi2 = o2::pwglf::getDeltaPhiAbs(ue_track.phi(), ue_axis2.Phi());
         float dr2 = TMath::Sqrt(deltaEta2 * deltaEta2 + deltaPhi2 * deltaPhi2);
 
         // Store Particles in the UE
@@ -1557,7 +1472,7 @@ struct nuclei_in_jets {
             Double_t y = p_deuteron.Rapidity();
 
             float deltaEta = p_deuteron.Eta() - p_leading.Eta();
-            float deltaPhi = GetDeltaPhi(p_deuteron.Phi(), p_leading.Phi());
+            float deltaPhi = o2::pwglf::getDeltaPhiAbs(p_deuteron.Phi(), p_leading.Phi());
             float R = TMath::Sqrt(deltaEta * deltaEta + deltaPhi * deltaPhi);
 
             if (R < Rmax_jet_ue && TMath::Abs(y) < 0.5) {
@@ -1624,7 +1539,7 @@ struct nuclei_in_jets {
             Double_t y = p_deuteron.Rapidity();
 
             float deltaEta = p_deuteron.Eta() - p_leading.Eta();
-            float deltaPhi = GetDeltaPhi(p_deuteron.Phi(), p_leading.Phi());
+            float deltaPhi = o2::pwglf::getDeltaPhiAbs(p_deuteron.Phi(), p_leading.Phi());
             float R = TMath::Sqrt(deltaEta * deltaEta + deltaPhi * deltaPhi);
 
             if (R < Rmax_jet_ue && TMath::Abs(y) < 0.5) {
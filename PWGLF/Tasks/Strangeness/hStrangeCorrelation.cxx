@@ -33,6 +33,10 @@
 #include "Framework/StaticFor.h"
 #include "CCDB/BasicCCDBManager.h"
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 using namespace o2;
 using namespace o2::constants::math;
 using namespace o2::framework;
@@ -148,104 +152,226 @@ struct correlateStrangeness {
     hEfficiencyOmegaMinus = static_cast<TH2F*>(listEfficiencies->FindObject("hEfficiencyOmegaMinus"));
     hEfficiencyOmegaPlus = static_cast<TH2F*>(listEfficiencies->FindObject("hEfficiencyOmegaPlus"));
     LOG(info) << "Efficiencies now loaded for " << mRunNumber;
+    // the weights stored in the mixing pools were computed with the previous efficiencies
+    resetMixingPools();
   }
 
-  void fillCorrelationsV0(aod::TriggerTracks const& triggers, aod::AssocV0s const& assocs, bool mixing, float pvz, float mult)
+  // Trigger tracks of a collision, read once per collision instead of once per pair
+  struct TriggerBlock {
+    int64_t collisionId = -1;
+    std::vector<int64_t> trackId;
+    std::vector<float> pt;
+    std::vector<float> eta;
+    std::vector<float> phi;
+    void clear()
+    {
+      trackId.clear();
+      pt.clear();
+      eta.clear();
+      phi.clear();
+    }
+  };
+
+  // Associated particles of a collision with the per-hypothesis weights and the invariant-mass regions to be filled,
+  // the track ids of the daughters (the track itself for pions) are kept for the autocorrelation rejection
+  struct AssocBlock {
+    static constexpr int kMaxHypotheses = 4;
+    int64_t collisionId = -1;
+    std::vector<std::array<int64_t, 3>> daughterIds;
+    std::vector<float> pt;
+    std::vector<float> eta;
+    std::vector<float> phi;
+    std::vector<std::array<float, kMaxHypotheses>> weight;
+    std::vector<std::array<uint8_t, kMaxHypotheses>> regions; // bit r - 1 for the invariant-mass region r (1: left bg, 2: signal, 3: right bg)
+    void clear()
+    {
+      daughterIds.clear();
+      pt.clear();
+      eta.clear();
+      phi.clear();
+      weight.clear();
+      regions.clear();
+    }
+  };
+
+  // blocks of the current same-event collision
+  TriggerBlock sameEventTriggers;
+  AssocBlock sameEventAssocs;
+  // bounded pools of the blocks of the mixed collisions, such that the blocks of a collision are built once for all its mixed pairs
+  std::vector<TriggerBlock> mixingTriggerPool;
+  std::vector<AssocBlock> mixingAssocPool;
+  std::size_t mixingTriggerNext = 0;
+  std::size_t mixingAssocNext = 0;
+
+  /// Invalidates the blocks of the mixing pools, e.g. at a new dataframe or when the efficiencies change
+  void resetMixingPools()
   {
+    for (auto& block : mixingTriggerPool) {
+      block.collisionId = -1;
+    }
+    for (auto& block : mixingAssocPool) {
+      block.collisionId = -1;
+    }
+  }
+
+  /// Block of a collision from a pool, the oldest block is replaced if the collision is not there
+  /// \param built whether the block of the collision was already in the pool
+  template <typename TBlock>
+  TBlock& getPoolBlock(std::vector<TBlock>& pool, std::size_t& next, int64_t collisionId, bool& built)
+  {
+    const std::size_t capacity = std::max(mixingParameter.value, 1) + 1;
+    if (pool.size() != capacity) {
+      pool.assign(capacity, TBlock{});
+      next = 0;
+    }
+    for (auto& block : pool) {
+      if (block.collisionId == collisionId) {
+        built = true;
+        return block;
+      }
+    }
+    built = false;
+    TBlock& block = pool[next];
+    next = (next + 1) % capacity;
+    block.clear();
+    block.collisionId = collisionId;
+    return block;
+  }
+
+  TriggerBlock& getTriggerBlock(aod::TriggerTracks const& triggers, bool mixing, int64_t collisionId)
+  {
+    bool built = false;
+    TriggerBlock& block = mixing ? getPoolBlock(mixingTriggerPool, mixingTriggerNext, collisionId, built) : sameEventTriggers;
+    if (built) {
+      return block;
+    }
+    block.clear();
     for (auto& triggerTrack : triggers) {
       auto trigg = triggerTrack.track_as<TracksComplete>();
-      if (!mixing)
-        histos.fill(HIST("sameEvent/TriggerParticlesV0"), trigg.pt(), mult);
-      for (auto& assocCandidate : assocs) {
-        auto assoc = assocCandidate.v0Core_as<V0DatasWithoutTrackX>();
+      block.trackId.push_back(trigg.globalIndex());
+      block.pt.push_back(trigg.pt());
+      block.eta.push_back(trigg.eta());
+      block.phi.push_back(trigg.phi());
+    }
+    return block;
+  }
 
-        //---] removing autocorrelations [---
-        auto postrack = assoc.posTrack_as<TracksComplete>();
-        auto negtrack = assoc.negTrack_as<TracksComplete>();
-        if (doAutocorrelationRejection) {
-          if (trigg.globalIndex() == postrack.globalIndex()) {
-            histos.fill(HIST("hNumberOfRejectedPairsV0"), 0.5);
-            continue;
-          }
-          if (trigg.globalIndex() == negtrack.globalIndex()) {
-            histos.fill(HIST("hNumberOfRejectedPairsV0"), 0.5);
-            continue;
-          }
+  /// Stores the weight and the regions to be filled for a hypothesis of an associated particle
+  /// \param efficiencyHist efficiency of the hypothesis, nullptr for no efficiency
+  template <typename TAssoc>
+  void fillAssocHypothesis(AssocBlock& block, TAssoc const& assocCandidate, int index, int correlationBit, TH2F* efficiencyHist, float pt, float eta)
+  {
+    float efficiency = efficiencyHist ? efficiencyHist->GetBinContent(efficiencyHist->GetXaxis()->FindBin(pt), efficiencyHist->GetYaxis()->FindBin(eta)) : 1.0f;
+    block.weight.back()[index] = applyEfficiencyCorrection ? 1. / efficiency : 1.0f;
+    if (bitcheck(doCorrelation, correlationBit) && (!applyEfficiencyCorrection || efficiency != 0)) {
+      if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index))) {
+        for (int region = 1; region <= 3; region++) {
+          if (assocCandidate.invMassRegionCheck(index, region))
+            bitset(block.regions.back()[index], region - 1);
         }
+      }
+    }
+  }
 
-        float deltaphi = ComputeDeltaPhi(trigg.phi(), assoc.phi());
-        float deltaeta = trigg.eta() - assoc.eta();
-        float ptassoc = assoc.pt();
-        float pttrigger = trigg.pt();
+  AssocBlock& getAssocBlockV0(aod::AssocV0s const& assocs, bool mixing, int64_t collisionId)
+  {
+    bool built = false;
+    AssocBlock& block = mixing ? getPoolBlock(mixingAssocPool, mixingAssocNext, collisionId, built) : sameEventAssocs;
+    if (built) {
+      return block;
+    }
+    block.clear();
+    TH2F* hEfficiencyV0[3] = {hEfficiencyK0Short, hEfficiencyLambda, hEfficiencyAntiLambda};
+    for (auto& assocCandidate : assocs) {
+      auto assoc = assocCandidate.v0Core_as<V0DatasWithoutTrackX>();
+      auto postrack = assoc.posTrack_as<TracksComplete>();
+      auto negtrack = assoc.negTrack_as<TracksComplete>();
+      block.daughterIds.push_back({postrack.globalIndex(), negtrack.globalIndex(), -1});
+      block.pt.push_back(assoc.pt());
+      block.eta.push_back(assoc.eta());
+      block.phi.push_back(assoc.phi());
+      block.weight.emplace_back();
+      block.regions.emplace_back();
+      for (int index = 0; index < 3; index++) {
+        fillAssocHypothesis(block, assocCandidate, index, index, hEfficiencyV0[index], block.pt.back(), block.eta.back());
+      }
+    }
+    return block;
+  }
 
-        // skip if basic ranges not met
-        if (deltaphi < axisRanges[0][0] || deltaphi > axisRanges[0][1])
-          continue;
-        if (deltaeta < axisRanges[1][0] || deltaeta > axisRanges[1][1])
-          continue;
-        if (ptassoc < axisRanges[2][0] || ptassoc > axisRanges[2][1])
-          continue;
-        if (pttrigger < axisRanges[3][0] || pttrigger > axisRanges[3][1])
-          continue;
-        TH2F* hEfficiencyV0[3];
-        hEfficiencyV0[0] = hEfficiencyK0Short;
-        hEfficiencyV0[1] = hEfficiencyLambda;
-        hEfficiencyV0[2] = hEfficiencyAntiLambda;
-        static_for<0, 2>([&](auto i) {
-          constexpr int index = i.value;
-          float efficiency = hEfficiencyV0[index]->GetBinContent(hEfficiencyV0[index]->GetXaxis()->FindBin(ptassoc), hEfficiencyV0[index]->GetYaxis()->FindBin(assoc.eta()));
-          float weight = applyEfficiencyCorrection ? 1. / efficiency : 1.0f;
-          if (bitcheck(doCorrelation, index) && (!applyEfficiencyCorrection || efficiency != 0)) {
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && !mixing && assocCandidate.invMassRegionCheck(index, 1))
-              histos.fill(HIST("sameEvent/LeftBg/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && !mixing && assocCandidate.invMassRegionCheck(index, 2))
-              histos.fill(HIST("sameEvent/Signal/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && !mixing && assocCandidate.invMassRegionCheck(index, 3))
-              histos.fill(HIST("sameEvent/RightBg/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && mixing && assocCandidate.invMassRegionCheck(index, 1))
-              histos.fill(HIST("mixedEvent/LeftBg/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && mixing && assocCandidate.invMassRegionCheck(index, 2))
-              histos.fill(HIST("mixedEvent/Signal/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && mixing && assocCandidate.invMassRegionCheck(index, 3))
-              histos.fill(HIST("mixedEvent/RightBg/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-          }
-        });
+  AssocBlock& getAssocBlockCascade(aod::AssocCascades const& assocs, bool mixing, int64_t collisionId)
+  {
+    bool built = false;
+    AssocBlock& block = mixing ? getPoolBlock(mixingAssocPool, mixingAssocNext, collisionId, built) : sameEventAssocs;
+    if (built) {
+      return block;
+    }
+    block.clear();
+    TH2F* hEfficiencyCascade[4] = {hEfficiencyXiMinus, hEfficiencyXiPlus, hEfficiencyOmegaMinus, hEfficiencyOmegaPlus};
+    for (auto& assocCandidate : assocs) {
+      auto assoc = assocCandidate.cascData();
+      auto postrack = assoc.posTrack_as<TracksComplete>();
+      auto negtrack = assoc.negTrack_as<TracksComplete>();
+      auto bachtrack = assoc.bachelor_as<TracksComplete>();
+      block.daughterIds.push_back({postrack.globalIndex(), negtrack.globalIndex(), bachtrack.globalIndex()});
+      block.pt.push_back(assoc.pt());
+      block.eta.push_back(assoc.eta());
+      block.phi.push_back(assoc.phi());
+      block.weight.emplace_back();
+      block.regions.emplace_back();
+      for (int index = 0; index < 4; index++) {
+        fillAssocHypothesis(block, assocCandidate, index, index + 3, hEfficiencyCascade[index], block.pt.back(), block.eta.back());
       }
     }
+    return block;
   }
 
-  void fillCorrelationsCascade(aod::TriggerTracks const& triggers, aod::AssocCascades const& assocs, bool mixing, float pvz, float mult)
+  AssocBlock& getAssocBlockPion(aod::AssocPions const& assocs, bool mixing, int64_t collisionId)
   {
-    for (auto& triggerTrack : triggers) {
-      auto trigg = triggerTrack.track_as<TracksComplete>();
-      if (!mixing)
-        histos.fill(HIST("sameEvent/TriggerParticlesCascade"), trigg.pt(), mult);
-      for (auto& assocCandidate : assocs) {
-        auto assoc = assocCandidate.cascData();
+    bool built = false;
+    AssocBlock& block = mixing ? getPoolBlock(mixingAssocPool, mixingAssocNext, collisionId, built) : sameEventAssocs;
+    if (built) {
+      return block;
+    }
+    block.clear();
+    for (auto& assocTrack : assocs) {
+      auto assoc = assocTrack.track_as<TracksComplete>();
+      block.daughterIds.push_back({assoc.globalIndex(), -1, -1});
+      block.pt.push_back(assoc.pt());
+      block.eta.push_back(assoc.eta());
+      block.phi.push_back(assoc.phi());
+    }
+    return block;
+  }
 
+  /// Loops over the trigger-associated pairs of two blocks, in the order of the tables
+  /// The pairs sharing a track (nDaughters daughters per associated particle) or outside of the axis ranges are skipped,
+  /// fillPair is called with the index of the associated particle, delta-phi, delta-eta, pT associated and pT trigger
+  template <typename TFillTrigger, typename TRejected, typename TFillPair>
+  void correlateBlocks(TriggerBlock const& triggers, AssocBlock const& assocs, int nDaughters, TFillTrigger&& fillTrigger, TRejected&& rejected, TFillPair&& fillPair)
+  {
+    for (std::size_t iTrigger = 0; iTrigger < triggers.pt.size(); iTrigger++) {
+      const int64_t triggerId = triggers.trackId[iTrigger];
+      const float pttrigger = triggers.pt[iTrigger];
+      const float etatrigger = triggers.eta[iTrigger];
+      const float phitrigger = triggers.phi[iTrigger];
+      fillTrigger(pttrigger);
+      for (std::size_t iAssoc = 0; iAssoc < assocs.pt.size(); iAssoc++) {
         //---] removing autocorrelations [---
-        auto postrack = assoc.posTrack_as<TracksComplete>();
-        auto negtrack = assoc.negTrack_as<TracksComplete>();
-        auto bachtrack = assoc.bachelor_as<TracksComplete>();
         if (doAutocorrelationRejection) {
-          if (trigg.globalIndex() == postrack.globalIndex()) {
-            histos.fill(HIST("hNumberOfRejectedPairsCascades"), 0.5);
-            continue;
-          }
-          if (trigg.globalIndex() == negtrack.globalIndex()) {
-            histos.fill(HIST("hNumberOfRejectedPairsCascades"), 0.5);
-            continue;
+          bool shared = false;
+          for (int iDaughter = 0; iDaughter < nDaughters; iDaughter++) {
+            shared = shared || triggerId == assocs.daughterIds[iAssoc][iDaughter];
           }
-          if (trigg.globalIndex() == bachtrack.globalIndex()) {
-            histos.fill(HIST("hNumberOfRejectedPairsCascades"), 0.5);
+          if (shared) {
+            rejected();
             continue;
           }
         }
 
-        float deltaphi = ComputeDeltaPhi(trigg.phi(), assoc.phi());
-        float deltaeta = trigg.eta() - assoc.eta();
-        float ptassoc = assoc.pt();
-        float pttrigger = trigg.pt();
+        float deltaphi = ComputeDeltaPhi(phitrigger, assocs.phi[iAssoc]);
+        float deltaeta = etatrigger - assocs.eta[iAssoc];
+        float ptassoc = assocs.pt[iAssoc];
 
         // skip if basic ranges not met
         if (deltaphi < axisRanges[0][0] || deltaphi > axisRanges[0][1])
@@ -256,74 +382,96 @@ struct correlateStrangeness {
           continue;
         if (pttrigger < axisRanges[3][0] || pttrigger > axisRanges[3][1])
           continue;
-        TH2F* hEfficiencyCascade[4];
-        hEfficiencyCascade[0] = hEfficiencyXiMinus;
-        hEfficiencyCascade[1] = hEfficiencyXiPlus;
-        hEfficiencyCascade[2] = hEfficiencyOmegaMinus;
-        hEfficiencyCascade[3] = hEfficiencyOmegaPlus;
-
-        static_for<0, 3>([&](auto i) {
-          constexpr int index = i.value;
-          float efficiency = hEfficiencyCascade[index]->GetBinContent(hEfficiencyCascade[index]->GetXaxis()->FindBin(ptassoc), hEfficiencyCascade[index]->GetYaxis()->FindBin(assoc.eta()));
-          float weight = applyEfficiencyCorrection ? 1. / efficiency : 1.0f;
-          if (bitcheck(doCorrelation, index + 3) && (!applyEfficiencyCorrection || efficiency != 0)) {
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && !mixing && assocCandidate.invMassRegionCheck(index, 1))
-              histos.fill(HIST("sameEvent/LeftBg/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && !mixing && assocCandidate.invMassRegionCheck(index, 2))
-              histos.fill(HIST("sameEvent/Signal/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && !mixing && assocCandidate.invMassRegionCheck(index, 3))
-              histos.fill(HIST("sameEvent/RightBg/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && mixing && assocCandidate.invMassRegionCheck(index, 1))
-              histos.fill(HIST("mixedEvent/LeftBg/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && mixing && assocCandidate.invMassRegionCheck(index, 2))
-              histos.fill(HIST("mixedEvent/Signal/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-            if (assocCandidate.compatible(index) && (!doMCassociation || assocCandidate.mcTrue(index)) && mixing && assocCandidate.invMassRegionCheck(index, 3))
-              histos.fill(HIST("mixedEvent/RightBg/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
-          }
-        });
+        fillPair(iAssoc, deltaphi, deltaeta, ptassoc, pttrigger);
       }
     }
   }
 
-  void fillCorrelationsPion(aod::TriggerTracks const& triggers, aod::AssocPions const& assocs, bool mixing, float pvz, float mult)
+  void fillCorrelationsV0(aod::TriggerTracks const& triggers, aod::AssocV0s const& assocs, bool mixing, float pvz, float mult, int64_t triggerCollisionId, int64_t assocCollisionId)
   {
+    auto& triggerBlock = getTriggerBlock(triggers, mixing, triggerCollisionId);
+    auto& assocBlock = getAssocBlockV0(assocs, mixing, assocCollisionId);
+    correlateBlocks(
+      triggerBlock, assocBlock, 2,
+      [&](float pttrigger) {
+        if (!mixing)
+          histos.fill(HIST("sameEvent/TriggerParticlesV0"), pttrigger, mult);
+      },
+      [&]() { histos.fill(HIST("hNumberOfRejectedPairsV0"), 0.5); },
+      [&](std::size_t iAssoc, float deltaphi, float deltaeta, float ptassoc, float pttrigger) {
+        static_for<0, 2>([&](auto i) {
+          constexpr int index = i.value;
+          const uint8_t regions = assocBlock.regions[iAssoc][index];
+          if (!regions)
+            return;
+          const float weight = assocBlock.weight[iAssoc][index];
+          if (!mixing && bitcheck(regions, 0))
+            histos.fill(HIST("sameEvent/LeftBg/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+          if (!mixing && bitcheck(regions, 1))
+            histos.fill(HIST("sameEvent/Signal/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+          if (!mixing && bitcheck(regions, 2))
+            histos.fill(HIST("sameEvent/RightBg/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+          if (mixing && bitcheck(regions, 0))
+            histos.fill(HIST("mixedEvent/LeftBg/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+          if (mixing && bitcheck(regions, 1))
+            histos.fill(HIST("mixedEvent/Signal/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+          if (mixing && bitcheck(regions, 2))
+            histos.fill(HIST("mixedEvent/RightBg/") + HIST(v0names[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+        });
+      });
+  }
 
-    for (auto& triggerTrack : triggers) {
-      auto trigg = triggerTrack.track_as<TracksComplete>();
-      if (!mixing)
-        histos.fill(HIST("sameEvent/TriggerParticlesPion"), trigg.pt(), mult);
-      for (auto& assocTrack : assocs) {
-        auto assoc = assocTrack.track_as<TracksComplete>();
-
-        //---] removing autocorrelations [---
-        if (doAutocorrelationRejection) {
-          if (trigg.globalIndex() == assoc.globalIndex()) {
-            histos.fill(HIST("hNumberOfRejectedPairsPions"), 0.5);
-            continue;
-          }
-        }
-
-        float deltaphi = ComputeDeltaPhi(trigg.phi(), assoc.phi());
-        float deltaeta = trigg.eta() - assoc.eta();
-        float ptassoc = assoc.pt();
-        float pttrigger = trigg.pt();
-
-        // skip if basic ranges not met
-        if (deltaphi < axisRanges[0][0] || deltaphi > axisRanges[0][1])
-          continue;
-        if (deltaeta < axisRanges[1][0] || deltaeta > axisRanges[1][1])
-          continue;
-        if (ptassoc < axisRanges[2][0] || ptassoc > axisRanges[2][1])
-          continue;
-        if (pttrigger < axisRanges[3][0] || pttrigger > axisRanges[3][1])
-          continue;
+  void fillCorrelationsCascade(aod::TriggerTracks const& triggers, aod::AssocCascades const& assocs, bool mixing, float pvz, float mult, int64_t triggerCollisionId, int64_t assocCollisionId)
+  {
+    auto& triggerBlock = getTriggerBlock(triggers, mixing, triggerCollisionId);
+    auto& assocBlock = getAssocBlockCascade(assocs, mixing, assocCollisionId);
+    correlateBlocks(
+      triggerBlock, assocBlock, 3,
+      [&](float pttrigger) {
+        if (!mixing)
+          histos.fill(HIST("sameEvent/TriggerParticlesCascade"), pttrigger, mult);
+      },
+      [&]() { histos.fill(HIST("hNumberOfRejectedPairsCascades"), 0.5); },
+      [&](std::size_t iAssoc, float deltaphi, float deltaeta, float ptassoc, float pttrigger) {
+        static_for<0, 3>([&](auto i) {
+          constexpr int index = i.value;
+          const uint8_t regions = assocBlock.regions[iAssoc][index];
+          if (!regions)
+            return;
+          const float weight = assocBlock.weight[iAssoc][index];
+          if (!mixing && bitcheck(regions, 0))
+            histos.fill(HIST("sameEvent/LeftBg/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+          if (!mixing && bitcheck(regions, 1))
+            histos.fill(HIST("sameEvent/Signal/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+          if (!mixing && bitcheck(regions, 2))
+            histos.fill(HIST("sameEvent/RightBg/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+          if (mixing && bitcheck(regions, 0))
+            histos.fill(HIST("mixedEvent/LeftBg/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+          if (mixing && bitcheck(regions, 1))
+            histos.fill(HIST("mixedEvent/Signal/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+          if (mixing && bitcheck(regions, 2))
+            histos.fill(HIST("mixedEvent/RightBg/") + HIST(cascadenames[index]), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult, weight);
+        });
+      });
+  }
 
+  void fillCorrelationsPion(aod::TriggerTracks const& triggers, aod::AssocPions const& assocs, bool mixing, float pvz, float mult, int64_t triggerCollisionId, int64_t assocCollisionId)
+  {
+    auto& triggerBlock = getTriggerBlock(triggers, mixing, triggerCollisionId);
+    auto& assocBlock = getAssocBlockPion(assocs, mixing, assocCollisionId);
+    correlateBlocks(
+      triggerBlock, assocBlock, 1,
+      [&](float pttrigger) {
+        if (!mixing)
+          histos.fill(HIST("sameEvent/TriggerParticlesPion"), pttrigger, mult);
+      },
+      [&]() { histos.fill(HIST("hNumberOfRejectedPairsPions"), 0.5); },
+      [&](std::size_t, float deltaphi, float deltaeta, float ptassoc, float pttrigger) {
         if (!mixing)
           histos.fill(HIST("sameEvent/Pion"), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult);
         else
           histos.fill(HIST("mixedEvent/Pion"), deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult);
-      }
-    }
+      });
   }
 
   void init(InitContext const&)
@@ -691,7 +839,7 @@ struct correlateStrangeness {
 
     // ________________________________________________
     // Do hadron - V0 correlations
-    fillCorrelationsV0(triggerTracks, associatedV0s, false, collision.posZ(), collision.centFT0M());
+    fillCorrelationsV0(triggerTracks, associatedV0s, false, collision.posZ(), collision.centFT0M(), collision.globalIndex(), collision.globalIndex());
   }
 
   void processSameEventHCascades(soa::Join<aod::Collisions, aod::EvSels, aod::CentFT0Ms>::iterator const& collision,
@@ -747,7 +895,7 @@ struct correlateStrangeness {
 
     // ________________________________________________
     // Do hadron - cascade correlations
-    fillCorrelationsCascade(triggerTracks, associatedCascades, false, collision.posZ(), collision.centFT0M());
+    fillCorrelationsCascade(triggerTracks, associatedCascades, false, collision.posZ(), collision.centFT0M(), collision.globalIndex(), collision.globalIndex());
   }
   void processSameEventHPions(soa::Join<aod::Collisions, aod::EvSels, aod::CentFT0Ms>::iterator const& collision,
                               aod::AssocPions const& associatedPions, aod::TriggerTracks const& triggerTracks,
@@ -784,12 +932,13 @@ struct correlateStrangeness {
 
     // ________________________________________________
     // Do hadron - Pion correlations
-    fillCorrelationsPion(triggerTracks, associatedPions, false, collision.posZ(), collision.centFT0M());
+    fillCorrelationsPion(triggerTracks, associatedPions, false, collision.posZ(), collision.centFT0M(), collision.globalIndex(), collision.globalIndex());
   }
   void processMixedEventHV0s(soa::Join<aod::Collisions, aod::EvSels, aod::CentFT0Ms> const& collisions,
                              aod::AssocV0s const& associatedV0s, aod::TriggerTracks const& triggerTracks,
                              V0DatasWithoutTrackX const&, aod::V0sLinked const&, TracksComplete const&, aod::BCsWithTimestamps const&)
   {
+    resetMixingPools();
     for (auto& [collision1, collision2] : soa::selfCombinations(colBinning, mixingParameter, -1, collisions, collisions)) {
       // ________________________________________________
       auto bc = collision1.bc_as<aod::BCsWithTimestamps>();
@@ -818,13 +967,14 @@ struct correlateStrangeness {
       auto slicedAssocV0s = associatedV0s.sliceBy(collisionSliceV0s, collision2.globalIndex());
       // ________________________________________________
       // Do hadron - V0 correlations
-      fillCorrelationsV0(slicedTriggerTracks, slicedAssocV0s, true, collision1.posZ(), collision1.centFT0M());
+      fillCorrelationsV0(slicedTriggerTracks, slicedAssocV0s, true, collision1.posZ(), collision1.centFT0M(), collision1.globalIndex(), collision2.globalIndex());
     }
   }
   void processMixedEventHCascades(soa::Join<aod::Collisions, aod::EvSels, aod::CentFT0Ms> const& collisions,
                                   aod::AssocV0s const&, aod::AssocCascades const& associatedCascades, aod::TriggerTracks const& triggerTracks,
                                   V0DatasWithoutTrackX const&, aod::V0sLinked const&, aod::CascDatas const&, TracksComplete const&, aod::BCsWithTimestamps const&)
   {
+    resetMixingPools();
     for (auto& [collision1, collision2] : soa::selfCombinations(colBinning, mixingParameter, -1, collisions, collisions)) {
       // ________________________________________________
       auto bc = collision1.bc_as<aod::BCsWithTimestamps>();
@@ -852,13 +1002,14 @@ struct correlateStrangeness {
       auto slicedAssocCascades = associatedCascades.sliceBy(collisionSliceCascades, collision2.globalIndex());
       // ________________________________________________
       // Do hadron - cascade correlations
-      fillCorrelationsCascade(slicedTriggerTracks, slicedAssocCascades, true, collision1.posZ(), collision1.centFT0M());
+      fillCorrelationsCascade(slicedTriggerTracks, slicedAssocCascades, true, collision1.posZ(), collision1.centFT0M(), collision1.globalIndex(), collision2.globalIndex());
     }
   }
   void processMixedEventHPions(soa::Join<aod::Collisions, aod::EvSels, aod::CentFT0Ms> const& collisions,
                                aod::AssocPions const& assocPions, aod::TriggerTracks const& triggerTracks,
                                TracksComplete const&)
   {
+    resetMixingPools();
     for (auto& [collision1, collision2] : soa::selfCombinations(colBinning, mixingParameter, -1, collisions, collisions)) {
       // ________________________________________________
       // Perform basic event selection on both collisions
@@ -884,7 +1035,7 @@ struct correlateStrangeness {
       auto slicedAssocPions = assocPions.sliceBy(collisionSlicePions, collision2.globalIndex());
       // ________________________________________________
       // Do hadron - cascade correlations
-      fillCorrelationsPion(slicedTriggerTracks, slicedAssocPions, true, collision1.posZ(), collision1.centFT0M());
+      fillCorrelationsPion(slicedTriggerTracks, slicedAssocPions, true, collision1.posZ(), collision1.centFT0M(), collision1.globalIndex(), collision2.globalIndex());
     }
   }
   void processMCGenerated(aod::McCollision const&, soa::SmallGroups<soa::Join<aod::McCollisionLabels, aod::Collisions, aod::EvSels, aod::CentFT0Ms>> const& collisions, aod::McParticles const& mcParticles)
@@ -33,6 +33,7 @@
 #include "Framework/AnalysisTask.h"
 #include "Framework/runDataProcessing.h"
 #include "PWGLF/DataModel/LFStrangenessTables.h"
+#include "PWGLF/Utils/inJetCones.h"
 #include "ReconstructionDataFormats/Track.h"
 
 using namespace std;
@@ -703,71 +704,6 @@ struct strangeness_in_jets {
     return x_min;
   }
 
-  double GetDeltaPhi(double a1, double a2)
-  {
-    double delta_phi(0);
-
-    double phi1 = TVector2::Phi_0_2pi(a1);
-    double phi2 = TVector2::Phi_0_2pi(a2);
-    double diff = TMath::Abs(phi1 - phi2);
-
-    if (diff <= TMath::Pi())
-      delta_phi = diff;
-    if (diff > TMath::Pi())
-      delta_phi = TMath::TwoPi() - diff;
-
-    return delta_phi;
-  }
-
-  void get_perpendicular_axis(TVector3 p, TVector3& u, double sign)
-  {
-    // Initialization
-    double ux(0), uy(0), uz(0);
-
-    // Components of Vector p
-    double px = p.X();
-    double py = p.Y();
-    double pz = p.Z();
-
-    // Protection 1
-    if (px == 0 && py != 0) {
-
-      uy = -(pz * pz) / py;
-      ux = sign * sqrt(py * py - (pz * pz * pz * pz) / (py * py));
-      uz = pz;
-      u.SetXYZ(ux, uy, uz);
-      return;
-    }
-
-    // Protection 2
-    if (py == 0 && px != 0) {
-
-      ux = -(pz * pz) / px;
-      uy = sign * sqrt(px * px - (pz * pz * pz * pz) / (px * px));
-      uz = pz;
-      u.SetXYZ(ux, uy, uz);
-      return;
-    }
-
-    // Equation Parameters
-    double a = px * px + py * py;
-    double b = 2.0 * px * pz * pz;
-    double c = pz * pz * pz * pz - py * py * py * py - px * px * py * py;
-    double delta = b * b - 4.0 * a * c;
-
-    // Protection agains delta<0
-    if (delta < 0) {
-      return;
-    }
-
-    // Solutions
-    ux = (-b + sign * sqrt(delta)) / (2.0 * a);
-    uy = (-pz * pz - px * ux) / py;
-    uz = pz;
-    u.SetXYZ(ux, uy, uz);
-    return;
-  }
-
   void processData(SelCollisions::iterator const& collision, aod::V0Datas const& fullV0s, aod::CascDataExt const& Cascades, aod::V0sLinked const& V0linked, FullTracks const& tracks)
   {
     registryData.fill(HIST("number_of_events_data"), 0.5);
@@ -832,7 +768,7 @@ struct strangeness_in_jets {
         float one_over_pt2_part = 1.0 / (p_particle.Pt() * p_particle.Pt());
         float one_over_pt2_lead = 1.0 / (p_leading.Pt() * p_leading.Pt());
         float deltaEta = p_particle.Eta() - p_leading.Eta();
-        float deltaPhi = GetDeltaPhi(p_particle.Phi(), p_leading.Phi());
+        float deltaPhi = o2::pwglf::getDeltaPhiAbs(p_particle.Phi(), p_leading.Phi());
         float min = Minimum(one_over_pt2_part, one_over_pt2_lead);
         float Delta2 = deltaEta * deltaEta + deltaPhi * deltaPhi;
 
@@ -884,15 +820,9 @@ struct strangeness_in_jets {
     registryData.fill(HIST("number_of_events_data"), 4.5);
 
     // Perpendicular Cones for UE
-    TVector3 ue_axis1(0.0, 0.0, 0.0);
-    TVector3 ue_axis2(0.0, 0.0, 0.0);
-    get_perpendicular_axis(jet_axis, ue_axis1, +1.0);
-    get_perpendicular_axis(jet_axis, ue_axis2, -1.0);
-
+    TVector3 ue_axis1, ue_axis2;
     // Protection against delta<0
-    if (ue_axis1.X() == 0 && ue_axis1.Y() == 0 && ue_axis1.Z() == 0)
-      return;
-    if (ue_axis2.X() == 0 && ue_axis2.Y() == 0 && ue_axis2.Z() == 0)
+    if (!o2::pwglf::getPerpendicularConeAxes(jet_axis, ue_axis1, ue_axis2))
       return;
     registryData.fill(HIST("number_of_events_data"), 5.5);
 
@@ -907,15 +837,15 @@ struct strangeness_in_jets {
       TVector3 v0dir(v0.px(), v0.py(), v0.pz());
 
       float deltaEta_jet = v0dir.Eta() - jet_axis.Eta();
-      float deltaPhi_jet = GetDeltaPhi(v0dir.Phi(), jet_axis.Phi());
+      float deltaPhi_jet = o2::pwglf::getDeltaPhiAbs(v0dir.Phi(), jet_axis.Phi());
       float deltaR_jet = sqrt(deltaEta_jet * deltaEta_jet + deltaPhi_jet * deltaPhi_jet);
 
       float deltaEta_ue1 = v0dir.Eta() - ue_axis1.Eta();
-      float deltaPhi_ue1 = GetDeltaPhi(v0dir.Phi(), ue_axis1.Phi());
+      float deltaPhi_ue1 = o2::pwglf::getDeltaPhiAbs(v0dir.Phi(), ue_axis1.Phi());
       float deltaR_ue1 = sqrt(deltaEta_ue1 * deltaEta_ue1 + deltaPhi_ue1 * deltaPhi_ue1);
 
       float deltaEta_ue2 = v0dir.Eta() - ue_axis2.Eta();
-      float deltaPhi_ue2 = GetDeltaPhi(v0dir.Phi(), ue_axis2.Phi());
+      float deltaPhi_ue2 = o2::pwglf::getDeltaPhiAbs(v0dir.Phi(), ue_axis2.Phi());
       float deltaR_ue2 = sqrt(deltaEta_ue2 * deltaEta_ue2 + deltaPhi_ue2 * deltaPhi_ue2);
 
       // K0s
@@ -959,13 +889,13 @@ struct strangeness_in_jets {
       TVector3 cascade_dir(casc.px(), casc.py(), casc.pz());
 
       float deltaEta_jet = cascade_dir.Eta() - jet_axis.Eta();
-      float deltaPhi_jet = GetDeltaPhi(cascade_dir.Phi(), jet_axis.Phi());
+      float deltaPhi_jet = o2::pwglf::getDeltaPhiAbs(cascade_dir.Phi(), jet_axis.Phi());
       float deltaR_jet = sqrt(deltaEta_jet * deltaEta_jet + deltaPhi_jet * deltaPhi_jet);
       float deltaEta_ue1 = cascade_dir.Eta() - ue_axis1.Eta();
-      float deltaPhi_ue1 = GetDeltaPhi(cascade_dir.Phi(), ue_axis1.Phi());
+      float deltaPhi_ue1 = o2::pwglf::getDeltaPhiAbs(cascade_dir.Phi(), ue_axis1.Phi());
       float deltaR_ue1 = sqrt(deltaEta_ue1 * deltaEta_ue1 + deltaPhi_ue1 * deltaPhi_ue1);
       float deltaEta_ue2 = cascade_dir.Eta() - ue_axis2.Eta();
-      float deltaPhi_ue2 = GetDeltaPhi(cascade_dir.Phi(), ue_axis2.Phi());
+      float deltaPhi_ue2 = o2::pwglf::getDeltaPhiAbs(cascade_dir.Phi(), ue_axis2.Phi());
       float deltaR_ue2 = sqrt(deltaEta_ue2 * deltaEta_ue2 + deltaPhi_ue2 * deltaPhi_ue2);
 
       // Xi+
@@ -1015,13 +945,13 @@ struct strangeness_in_jets {
 
       TVector3 track_dir(track.px(), track.py(), track.pz());
       float deltaEta_jet = track_dir.Eta() - jet_axis.Eta();
-      float deltaPhi_jet = GetDeltaPhi(track_dir.Phi(), jet_axis.Phi());
+      float deltaPhi_jet = o2::pwglf::getDeltaPhiAbs(track_dir.Phi(), jet_axis.Phi());
       float deltaR_jet = sqrt(deltaEta_jet * deltaEta_jet + deltaPhi_jet * deltaPhi_jet);
       float deltaEta_ue1 = track_dir.Eta() - ue_axis1.Eta();
-      float deltaPhi_ue1 = GetDeltaPhi(track_dir.Phi(), ue_axis1.Phi());
+      float deltaPhi_ue1 = o2::pwglf::getDeltaPhiAbs(track_dir.Phi(), ue_axis1.Phi());
       float deltaR_ue1 = sqrt(deltaEta_ue1 * deltaEta_ue1 + deltaPhi_ue1 * deltaPhi_ue1);
       float deltaEta_ue2 = track_dir.Eta() - ue_axis2.Eta();
-      float deltaPhi_ue2 = GetDeltaPhi(track_dir.Phi(), ue_axis2.Phi());
+      float deltaPhi_ue2 = o2::pwglf::getDeltaPhiAbs(track_dir.Phi(), ue_axis2.Phi());
       float deltaR_ue2 = sqrt(deltaEta_ue2 * deltaEta_ue2 + deltaPhi_ue2 * deltaPhi_ue2);
 
       bool isInJet = false;
@@ -1418,7 +1348,7 @@ struct strangeness_in_jets {
           float one_over_pt2_part = 1.0 / (p_particle.Pt() * p_particle.Pt());
           float one_over_pt2_lead = 1.0 / (p_leading.Pt() * p_leading.Pt());
           float deltaEta = p_particle.Eta() - p_leading.Eta();
-          float deltaPhi = GetDeltaPhi(p_particle.Phi(), p_leading.Phi());
+          float deltaPhi = o2::pwglf::getDeltaPhiAbs(p_particle.Phi(), p_leading.Phi());
           float min = Minimum(one_over_pt2_part, one_over_pt2_lead);
           float Delta2 = deltaEta * deltaEta + deltaPhi * deltaPhi;
 
@@ -1468,15 +1398,9 @@ struct strangeness_in_jets {
         return;
 
       // Perpendicular Cones for UE
-      TVector3 ue_axis1(0.0, 0.0, 0.0);
-      TVector3 ue_axis2(0.0, 0.0, 0.0);
-      get_perpendicular_axis(jet_axis, ue_axis1, +1.0);
-      get_perpendicular_axis(jet_axis, ue_axis2, -1.0);
-
+      TVector3 ue_axis1, ue_axis2;
       // Protection against delta<0
-      if (ue_axis1.X() == 0 && ue_axis1.Y() == 0 && ue_axis1.Z() == 0)
-        return;
-      if (ue_axis2.X() == 0 && ue_axis2.Y() == 0 && ue_axis2.Z() == 0)
+      if (!o2::pwglf::getPerpendicularConeAxes(jet_axis, ue_axis1, ue_axis2))
         return;
 
       // Generated Particles
@@ -1492,13 +1416,13 @@ struct strangeness_in_jets {
 
         TVector3 p_particle(particle.px(), particle.py(), particle.pz());
         float deltaEta_jet = p_particle.Eta() - jet_axis.Eta();
-        float deltaPhi_jet = GetDeltaPhi(p_particle.Phi(), jet_axis.Phi());
+        float deltaPhi_jet = o2::pwglf::getDeltaPhiAbs(p_particle.Phi(), jet_axis.Phi());
         float deltaR_jet = sqrt(deltaEta_jet * deltaEta_jet + deltaPhi_jet * deltaPhi_jet);
         float deltaEta_ue1 = p_particle.Eta() - ue_axis1.Eta();
-        float deltaPhi_ue1 = GetDeltaPhi(p_particle.Phi(), ue_axis1.Phi());
+        float deltaPhi_ue1 = o2::pwglf::getDeltaPhiAbs(p_particle.Phi(), ue_axis1.Phi());
         float deltaR_ue1 = sqrt(deltaEta_ue1 * deltaEta_ue1 + deltaPhi_ue1 * deltaPhi_ue1);
         float deltaEta_ue2 = p_particle.Eta() - ue_axis2.Eta();
-        float deltaPhi_ue2 = GetDeltaPhi(p_particle.Phi(), ue_axis2.Phi());
+        float deltaPhi_ue2 = o2::pwglf::getDeltaPhiAbs(p_particle.Phi(), ue_axis2.Phi());
         float deltaR_ue2 = sqrt(deltaEta_ue2 * deltaEta_ue2 + deltaPhi_ue2 * deltaPhi_ue2);
 
         // Fill K0s
@@ -0,0 +1,120 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file  inJetCones.h
+/// \brief Utilities for the selection of the particles in a jet cone and in the perpendicular (underlying event) cones
+///        around a jet axis, shared by the LF in-jet analyses
+///        Based on nuclei_in_jets.cxx and strangeness_in_jets.cxx
+///
+
+#ifndef PWGLF_UTILS_INJETCONES_H_
+#define PWGLF_UTILS_INJETCONES_H_
+
+#include <cmath>
+
+#include <TMath.h>
+#include <TVector2.h>
+#include <TVector3.h>
+
+namespace o2
+{
+namespace pwglf
+{
+
+/// Absolute difference in phi of two angles, in [0, pi]
+inline double getDeltaPhiAbs(double a1, double a2)
+{
+  double delta_phi(0);
+
+  double phi1 = TVector2::Phi_0_2pi(a1);
+  double phi2 = TVector2::Phi_0_2pi(a2);
+  double diff = TMath::Abs(phi1 - phi2);
+
+  if (diff <= TMath::Pi())
+    delta_phi = diff;
+  if (diff > TMath::Pi())
+    delta_phi = TMath::TwoPi() - diff;
+
+  return delta_phi;
+}
+
+/// Axis perpendicular to p with the same z component, on the side given by the sign
+/// u is left unchanged if there is no solution
+inline void getPerpendicularAxis(TVector3 p, TVector3& u, double sign)
+{
+  // Initialization
+  double ux(0), uy(0), uz(0);
+
+  // Components of Vector p
+  double px = p.X();
+  double py = p.Y();
+  double pz = p.Z();
+
+  // Protection 1
+  if (px == 0 && py != 0) {
+
+    uy = -(pz * pz) / py;
+    ux = sign * std::sqrt(py * py - (pz * pz * pz * pz) / (py * py));
+    uz = pz;
+    u.SetXYZ(ux, uy, uz);
+    return;
+  }
+
+  // Protection 2
+  if (py == 0 && px != 0) {
+
+    ux = -(pz * pz) / px;
+    uy = sign * std::sqrt(px * px - (pz * pz * pz * pz) / (px * px));
+    uz = pz;
+    u.SetXYZ(ux, uy, uz);
+    return;
+  }
+
+  // Equation Parameters
+  double a = px * px + py * py;
+  double b = 2.0 * px * pz * pz;
+  double c = pz * pz * pz * pz - py * py * py * py - px * px * py * py;
+  double delta = b * b - 4.0 * a * c;
+
+  // Protection agains delta<0
+  if (delta < 0) {
+    return;
+  }
+
+  // Solutions
+  ux = (-b + sign * std::sqrt(delta)) / (2.0 * a);
+  uy = (-pz * pz - px * ux) / py;
+  uz = pz;
+  u.SetXYZ(ux, uy, uz);
+  return;
+}
+
+/// Axes of the two perpendicular cones used for the underlying event, false if they cannot be computed
+inline bool getPerpendicularConeAxes(const TVector3& jetAxis, TVector3& ueAxis1, TVector3& ueAxis2)
+{
+  ueAxis1.SetXYZ(0.0, 0.0, 0.0);
+  ueAxis2.SetXYZ(0.0, 0.0, 0.0);
+  getPerpendicularAxis(jetAxis, ueAxis1, +1.0);
+  getPerpendicularAxis(jetAxis, ueAxis2, -1.0);
+
+  // Protection against delta<0
+  if (ueAxis1.X() == 0 && ueAxis1.Y() == 0 && ueAxis1.Z() == 0)
+    return false;
+  if (ueAxis2.X() == 0 && ueAxis2.Y() == 0 && ueAxis2.Z() == 0)
+    return false;
+  return true;
+}
+
+} // namespace pwglf
+} // namespace o2
+
+#endif // PWGLF_UTILS_INJETCONES_H_
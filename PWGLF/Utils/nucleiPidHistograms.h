@@ -0,0 +1,102 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file  nucleiPidHistograms.h
+/// \brief PID histograms of light nuclei filled from the NucleiPIDs table (nucleiPidTable.cxx)
+///        The histograms are created once and kept as handles, the fill does not look up the registry by name
+///
+
+#ifndef PWGLF_UTILS_NUCLEIPIDHISTOGRAMS_H_
+#define PWGLF_UTILS_NUCLEIPIDHISTOGRAMS_H_
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include <TH3.h>
+
+#include "Framework/HistogramRegistry.h"
+#include "PWGLF/DataModel/LFNucleiPIDTables.h"
+
+namespace o2
+{
+namespace pwglf
+{
+
+class NucleiPIDHistograms
+{
+ public:
+  enum Species { kDeuteron = 0,
+                 kTriton,
+                 kHe3,
+                 kHe4,
+                 kNSpecies };
+
+  static constexpr std::array<float, kNSpecies> charges{1.f, 1.f, 2.f, 2.f};
+  static constexpr std::array<const char*, kNSpecies> names{"deuteron", "triton", "He3", "alpha"};
+  static constexpr std::array<const char*, 2> matter{"M", "A"};
+
+  /// Creates the TPC nsigma and TOF mass^2 histograms of the enabled species, for matter and antimatter
+  /// \param registry registry owning the histograms
+  /// \param enabled species to be histogrammed
+  /// \param xAxis first axis (e.g. centrality)
+  /// \param ptAxis transverse momentum axis (for a nucleus of the given charge)
+  /// \param nSigmaAxis TPC nsigma axis
+  /// \param mass2Axis TOF mass^2 axis
+  void init(o2::framework::HistogramRegistry& registry, const std::array<bool, kNSpecies>& enabled, const o2::framework::AxisSpec& xAxis, const o2::framework::AxisSpec& ptAxis,
+            const o2::framework::AxisSpec& nSigmaAxis, const o2::framework::AxisSpec& mass2Axis)
+  {
+    for (int iS{0}; iS < kNSpecies; ++iS) {
+      for (int iC{0}; iC < 2; ++iC) {
+        if (!enabled[iS]) {
+          mNSigmaTPC[iS][iC].reset();
+          mTOFMass2[iS][iC].reset();
+          continue;
+        }
+        mNSigmaTPC[iS][iC] = registry.add<TH3>(Form("nucleiPID/hNSigmaTPC%s_%s", matter[iC], names[iS]), Form("TPC n#sigma %s %s", matter[iC], names[iS]), o2::framework::HistType::kTH3F, {xAxis, ptAxis, nSigmaAxis});
+        mTOFMass2[iS][iC] = registry.add<TH3>(Form("nucleiPID/hTOFMass2%s_%s", matter[iC], names[iS]), Form("TOF m^{2} %s %s", matter[iC], names[iS]), o2::framework::HistType::kTH3F, {xAxis, ptAxis, mass2Axis});
+      }
+    }
+  }
+
+  /// Fills the histograms of the species of a track
+  /// \param track track joined with NucleiPIDs
+  /// \param x value of the first axis
+  /// \param maxNSigmaTPCForTOF maximum |TPC nsigma| for the TOF mass^2 histograms
+  template <typename T>
+  void fill(const T& track, float x, float maxNSigmaTPCForTOF = 3.f) const
+  {
+    const int iC{track.sign() < 0};
+    const float nSigma[kNSpecies]{track.nSigmaTPCDe(), track.nSigmaTPCTr(), track.nSigmaTPCHe(), track.nSigmaTPCAl()};
+    const bool hasTOF = track.hasPIDFlag(o2::aod::nucleipid::kHasTOF);
+    for (int iS{0}; iS < kNSpecies; ++iS) {
+      if (!mNSigmaTPC[iS][iC]) {
+        continue;
+      }
+      const float pt = track.pt() * charges[iS];
+      mNSigmaTPC[iS][iC]->Fill(x, pt, nSigma[iS]);
+      if (hasTOF && std::abs(nSigma[iS]) < maxNSigmaTPCForTOF) {
+        mTOFMass2[iS][iC]->Fill(x, pt, track.tofMass2(charges[iS]));
+      }
+    }
+  }
+
+ private:
+  std::shared_ptr<TH3> mNSigmaTPC[kNSpecies][2]; ///< TPC nsigma vs x and pT, per species and matter/antimatter
+  std::shared_ptr<TH3> mTOFMass2[kNSpecies][2];  ///< TOF mass^2 vs x and pT, per species and matter/antimatter
+};
+
+} // namespace pwglf
+} // namespace o2
+
+#endif // PWGLF_UTILS_NUCLEIPIDHISTOGRAMS_H_
@@ -0,0 +1,171 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file  resoDaughterPools.h
+/// \brief Per-collision pools of resonance daughters split by PID tag and charge, with pair loops
+///        and a mixing buffer of the pools of the previous collisions in bins of z vertex and multiplicity
+///        The pools are filled from ResoTracks joined with ResoTrackPIDTags (LFResonanceInitializer)
+///
+
+#ifndef PWGLF_UTILS_RESODAUGHTERPOOLS_H_
+#define PWGLF_UTILS_RESODAUGHTERPOOLS_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "PWGLF/DataModel/LFResonanceTables.h"
+
+namespace o2
+{
+namespace pwglf
+{
+
+struct ResoDaughter {
+  int64_t index; // global index in ResoTracks
+  float px;
+  float py;
+  float pz;
+};
+
+class ResoDaughterPools
+{
+ public:
+  enum ChargeIndex { kPositive = 0,
+                     kNegative,
+                     kNCharges };
+
+  void clear()
+  {
+    for (auto& speciesPools : mPools) {
+      for (auto& pool : speciesPools) {
+        pool.clear();
+      }
+    }
+  }
+
+  /// Fills the pools with the tracks of a collision, a track is added to the pool of every species of its PID tag
+  template <typename TTracks>
+  void fill(TTracks const& tracks)
+  {
+    clear();
+    for (const auto& track : tracks) {
+      const int charge = track.sign() > 0 ? kPositive : kNegative;
+      for (int iSpecies = 0; iSpecies < o2::aod::resodaughter::kNPIDTagBits; iSpecies++) {
+        if (TESTBIT(track.pidTag(), iSpecies)) {
+          mPools[iSpecies][charge].push_back(ResoDaughter{track.globalIndex(), track.px(), track.py(), track.pz()});
+        }
+      }
+    }
+  }
+
+  const std::vector<ResoDaughter>& getPool(int species, int charge) const { return mPools[species][charge]; }
+
+  /// Calls func(daughter1, daughter2) for the pairs of the pools (species1, charge1) and (species2, charge2) of the collision
+  /// The pairs of a pool with itself are visited once and the pairs of a track with itself are skipped
+  template <typename TFunc>
+  void forEachPair(int species1, int charge1, int species2, int charge2, TFunc&& func) const
+  {
+    const auto& pool1 = getPool(species1, charge1);
+    const auto& pool2 = getPool(species2, charge2);
+    const bool isSamePool = &pool1 == &pool2;
+    for (std::size_t i1 = 0; i1 < pool1.size(); i1++) {
+      for (std::size_t i2 = isSamePool ? i1 + 1 : 0; i2 < pool2.size(); i2++) {
+        if (pool1[i1].index == pool2[i2].index) {
+          continue;
+        }
+        func(pool1[i1], pool2[i2]);
+      }
+    }
+  }
+
+  /// Calls func(daughter1, daughter2) for the pairs of the pool (species1, charge1) of the collision
+  /// with the pool (species2, charge2) of another collision
+  template <typename TFunc>
+  void forEachMixedPair(ResoDaughterPools const& other, int species1, int charge1, int species2, int charge2, TFunc&& func) const
+  {
+    for (const auto& daughter1 : getPool(species1, charge1)) {
+      for (const auto& daughter2 : other.getPool(species2, charge2)) {
+        func(daughter1, daughter2);
+      }
+    }
+  }
+
+ private:
+  std::array<std::array<std::vector<ResoDaughter>, kNCharges>, o2::aod::resodaughter::kNPIDTagBits> mPools;
+};
+
+/// Pools of the last collisions per bin of z vertex and multiplicity, kept across dataframes
+class ResoMixingBuffer
+{
+ public:
+  /// Sets the binning and the depth of the buffer, the buffer is emptied
+  void configure(const std::vector<double>& binsVz, const std::vector<double>& binsMult, std::size_t depth)
+  {
+    mBinsVz = binsVz;
+    mBinsMult = binsMult;
+    mDepth = depth;
+    const std::size_t nBins = mBinsVz.size() > 1 && mBinsMult.size() > 1 ? (mBinsVz.size() - 1) * (mBinsMult.size() - 1) : 0;
+    mBuffer.assign(nBins, {});
+  }
+
+  /// Bin of a collision, -1 if outside the binning
+  int getBin(float vz, float mult) const
+  {
+    const int binVz = findBin(mBinsVz, vz);
+    const int binMult = findBin(mBinsMult, mult);
+    if (binVz < 0 || binMult < 0) {
+      return -1;
+    }
+    return binVz * (static_cast<int>(mBinsMult.size()) - 1) + binMult;
+  }
+
+  /// Pools of the previous collisions of a bin, from the oldest to the most recent
+  const std::deque<ResoDaughterPools>& getPools(int bin) const { return mBuffer[bin]; }
+
+  /// Adds the pools of a collision to a bin, the oldest collision is dropped if the bin is full
+  void add(int bin, ResoDaughterPools pools)
+  {
+    if (bin < 0 || mDepth == 0) {
+      return;
+    }
+    auto& bufferBin = mBuffer[bin];
+    if (bufferBin.size() >= mDepth) {
+      bufferBin.pop_front();
+    }
+    bufferBin.push_back(std::move(pools));
+  }
+
+ private:
+  static int findBin(const std::vector<double>& bins, double value)
+  {
+    if (bins.size() < 2 || value < bins.front() || value >= bins.back()) {
+      return -1;
+    }
+    return std::distance(bins.begin(), std::upper_bound(bins.begin(), bins.end(), value)) - 1;
+  }
+
+  std::vector<double> mBinsVz;                        // bin limits of the z vertex
+  std::vector<double> mBinsMult;                      // bin limits of the multiplicity
+  std::size_t mDepth{0};                              // maximum number of collisions per bin
+  std::vector<std::deque<ResoDaughterPools>> mBuffer; // pools of the previous collisions, by (z vertex bin, multiplicity bin)
+};
+
+} // namespace pwglf
+} // namespace o2
+
+#endif // PWGLF_UTILS_RESODAUGHTERPOOLS_H_
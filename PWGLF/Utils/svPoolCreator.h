@@ -12,8 +12,9 @@
 #ifndef PWGLF_UTILS_SVPOOLCREATOR_H_
 #define PWGLF_UTILS_SVPOOLCREATOR_H_
 
+#include <algorithm>
 #include <array>
-#include <unordered_map>
+#include <numeric>
 #include <vector>
 #include <utility>
 #include "Framework/AnalysisTask.h"
@@ -52,9 +53,11 @@ class svPoolCreator
   void clearPools()
   {
     for (auto& pool : trackCandPool) {
+      for (const auto& trackCand : pool) {
+        trackCandIndex[trackCand.Idxtr] = {-1, -1};
+      }
       pool.clear();
     }
-    tmap.clear();
     svCandPool.clear();
   }
 
@@ -134,10 +137,14 @@ class svPoolCreator
         continue;
       }
 
-      const auto& tref = tmap.find(trackCand.globalIndex());
-      if (tref != tmap.end()) {
-        LOG(debug) << "Track: " << trackCand.globalIndex() << " already processed with other vertex";
-        trackCandPool[tref->second.second][tref->second.first].collBracket.setMax(static_cast<int>(collIdx)); // this track was already processed with other vertex, account the latter
+      const int trackIdx = trackCand.globalIndex();
+      if (trackIdx >= static_cast<int>(trackCandIndex.size())) {
+        trackCandIndex.resize(trackIdx + 1, {-1, -1});
+      }
+      const auto& tref = trackCandIndex[trackIdx];
+      if (tref.first >= 0) {
+        LOG(debug) << "Track: " << trackIdx << " already processed with other vertex";
+        trackCandPool[tref.second][tref.first].collBracket.setMax(static_cast<int>(collIdx)); // this track was already processed with other vertex, account the latter
         continue;
       }
 
@@ -146,65 +153,62 @@ class svPoolCreator
       trForpool.collBracket = {static_cast<int>(collIdx), static_cast<int>(collIdx)};
       // LOG(info) << "Adding track to pool: " << trForpool.Idxtr << " with bracket: " << trForpool.collBracket.getMin() << " " << trForpool.collBracket.getMax() << " and pool index: " << poolIndex;
       trackCandPool[poolIndex].emplace_back(trForpool);
-      tmap[trackCand.globalIndex()] = {trackCandPool[poolIndex].size() - 1, poolIndex};
+      trackCandIndex[trackIdx] = {static_cast<int>(trackCandPool[poolIndex].size()) - 1, poolIndex};
     }
 
     // is Sorting Needed ? TBD
   }
+  /// Pairs the track0 and track1 candidates with overlapping collision brackets
+  /// Both pools are swept in order of bracket start, each candidate is paired with the
+  /// still active (not yet ended) candidates of the other pool
   template <typename C>
-  std::vector<SVCand>& getSVCandPool(const C& collisions, bool combineLikeSign = false)
+  std::vector<SVCand>& getSVCandPool(const C& /*collisions*/, bool combineLikeSign = false)
   {
-    gsl::span<std::vector<TrackCand>> track0Pool{trackCandPool.data(), 2};
-    gsl::span<std::vector<TrackCand>> track1Pool{trackCandPool.data() + 2, 2};
-    std::array<std::vector<int>, 2> mVtxTrack0{}; // 1st pos. and neg. track of the kink pool for each vertex
-
-    for (int i = 0; i < 2; i++) {
-      mVtxTrack0[i].clear();
-      mVtxTrack0[i].resize(collisions.size(), -1);
+    for (int iPool = 0; iPool < 4; iPool++) {
+      const auto& pool = trackCandPool[iPool];
+      auto& order = sortedCandIdx[iPool];
+      order.resize(pool.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [&pool](int a, int b) {
+        return pool[a].collBracket.getMin() < pool[b].collBracket.getMin();
+      });
     }
 
     for (int pn = 0; pn < 2; pn++) {
-      auto& vtxFirstT = mVtxTrack0[pn];
-      const auto& signTrack0Pool = track0Pool[pn];
-      for (unsigned i = 0; i < signTrack0Pool.size(); i++) {
-        const auto& track0Seed = signTrack0Pool[i];
-        LOG(debug) << "Processsing track0 with index: " << track0Seed.Idxtr << " min bracket: " << track0Seed.collBracket.getMin() << " max bracket: " << track0Seed.collBracket.getMax();
-        for (int j{track0Seed.collBracket.getMin()}; j <= track0Seed.collBracket.getMax(); ++j) {
-          if (vtxFirstT[j] == -1) {
-            vtxFirstT[j] = i;
-          }
-        }
-      }
       int track1sign = combineLikeSign ? pn : 1 - pn;
-      auto& signTrack1 = track1Pool[track1sign];
-      for (unsigned itp = 0; itp < signTrack1.size(); itp++) {
-        auto& track1Seed = signTrack1[itp];
-        LOG(debug) << "Processing track1 with index: " << track1Seed.Idxtr << " min bracket: " << track1Seed.collBracket.getMin() << " max bracket: " << track1Seed.collBracket.getMax();
-        int firsOverlapIdx = -1;
-        for (int j{track1Seed.collBracket.getMin()}; j <= track1Seed.collBracket.getMax(); ++j) {
-          LOG(debug) << "Checking vtxFirstT at position " << j << " with value " << vtxFirstT[j];
-          if (vtxFirstT[j] != -1) {
-            firsOverlapIdx = vtxFirstT[j];
-            break;
+      const auto& track0Pool = trackCandPool[pn];
+      const auto& track1Pool = trackCandPool[2 + track1sign];
+      const auto& order0 = sortedCandIdx[pn];
+      const auto& order1 = sortedCandIdx[2 + track1sign];
+      auto& active0 = activeCandIdx[0];
+      auto& active1 = activeCandIdx[1];
+      active0.clear();
+      active1.clear();
+
+      // drops the candidates whose bracket ends before the given collision
+      auto removeEnded = [](std::vector<int>& active, const std::vector<TrackCand>& pool, int collIdx) {
+        active.erase(std::remove_if(active.begin(), active.end(), [&](int idx) { return pool[idx].collBracket.getMax() < collIdx; }), active.end());
+      };
+
+      size_t i0 = 0, i1 = 0;
+      while (i0 < order0.size() || i1 < order1.size()) {
+        const bool takeTrack0 = i1 == order1.size() || (i0 < order0.size() && track0Pool[order0[i0]].collBracket.getMin() <= track1Pool[order1[i1]].collBracket.getMin());
+        if (takeTrack0) {
+          const auto& track0Seed = track0Pool[order0[i0]];
+          removeEnded(active1, track1Pool, track0Seed.collBracket.getMin());
+          for (int idx1 : active1) {
+            const auto& track1Seed = track1Pool[idx1];
+            svCandPool.emplace_back(SVCand{track0Seed.Idxtr, track1Seed.Idxtr, track0Seed.collBracket.getOverlap(track1Seed.collBracket)});
           }
-        }
-        if (firsOverlapIdx < 0) {
-          continue;
-        }
-        for (unsigned itn = firsOverlapIdx; itn < signTrack0Pool.size(); itn++) {
-          auto& track0Seed = signTrack0Pool[itn];
-
-          if (track0Seed.collBracket.getMin() > track1Seed.collBracket.getMax()) {
-            break;
+          active0.push_back(order0[i0++]);
+        } else {
+          const auto& track1Seed = track1Pool[order1[i1]];
+          removeEnded(active0, track0Pool, track1Seed.collBracket.getMin());
+          for (int idx0 : active0) {
+            const auto& track0Seed = track0Pool[idx0];
+            svCandPool.emplace_back(SVCand{track0Seed.Idxtr, track1Seed.Idxtr, track0Seed.collBracket.getOverlap(track1Seed.collBracket)});
           }
-
-          if (track0Seed.collBracket.isOutside(track1Seed.collBracket)) {
-            LOG(debug) << "Brackets do not match";
-            continue;
-          }
-          auto overlapBracket = track0Seed.collBracket.getOverlap(track1Seed.collBracket);
-
-          svCandPool.emplace_back(SVCand{track0Seed.Idxtr, track1Seed.Idxtr, overlapBracket});
+          active1.push_back(order1[i1++]);
         }
       }
     }
@@ -219,10 +223,12 @@ class svPoolCreator
   int track0Pdg;
   int track1Pdg;
   float timeMarginNS = 600.;
-  std::unordered_map<int, std::pair<int, int>> tmap;
+  std::vector<std::pair<int, int>> trackCandIndex; // position (index in pool, pool) of each track in the candidate pools, by track global index
 
   std::array<std::vector<TrackCand>, 4> trackCandPool; // Sorting: dau0 pos, dau0 neg, dau1 pos, dau1 neg
   std::vector<SVCand> svCandPool;                      // index of the two tracks in the track table
+  std::array<std::vector<int>, 4> sortedCandIdx;       // candidates of each pool sorted by bracket start
+  std::array<std::vector<int>, 2> activeCandIdx;       // candidates of the track0 and track1 pools with an open bracket during the sweep
   TrackCand trForpool;
 };
 
@@ -344,15 +344,15 @@ struct LumiFDDFT0 {
 
       auto SideA = fdd.chargeA();
       auto SideC = fdd.chargeC();
-      std::vector<int> channelA;
-      std::vector<int> channelC;
+      uint8_t channelA = 0;
+      uint8_t channelC = 0;
       for (auto i = 0; i < 8; i++) {
         if (SideA[i] > 0) {
-          channelA.push_back(i);
+          channelA |= BIT(i);
         }
 
         if (SideC[i] > 0) {
-          channelC.push_back(i);
+          channelC |= BIT(i);
         }
 
         chargeaFDD += SideA[i];
@@ -387,16 +387,11 @@ struct LumiFDDFT0 {
   };
   PROCESS_SWITCH(LumiFDDFT0, processLite, "Process FDD and FT0 info", false);
 
-  bool checkAnyCoincidence(const std::vector<int>& channels)
+  /// \param channels bit map of the fired channels of a side
+  static bool checkAnyCoincidence(uint8_t channels)
   {
-    std::map<int, int> channelPairs = {{0, 4}, {1, 5}, {2, 6}, {3, 7}};
-    for (const auto& pair : channelPairs) {
-      if (std::find(channels.begin(), channels.end(), pair.first) != channels.end() &&
-          std::find(channels.begin(), channels.end(), pair.second) != channels.end()) {
-        return true;
-      }
-    }
-    return false;
+    // channel pairs {0, 4}, {1, 5}, {2, 6} and {3, 7}
+    return (channels & (channels >> 4) & 0xF) != 0;
   }
 };
 
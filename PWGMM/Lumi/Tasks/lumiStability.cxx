@@ -13,6 +13,14 @@
 ///        it is meant to be a blank page for further developments.
 /// \author everyone
 
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <TH1.h>
+
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -31,6 +39,40 @@ using BCsWithTimestamps = soa::Join<aod::BCs, aod::Timestamps>;
 
 int nBCsPerOrbit = 3564;
 
+// Unit weight entries of a 1D histogram, counted per bin as integers over a dataframe and added to the histogram at its end
+struct BinCounter {
+  std::shared_ptr<TH1> histo;
+  std::vector<uint64_t> counts; // per bin, counted from 0 (the axes are centred on the filled integer values)
+
+  void init(std::shared_ptr<TH1> h)
+  {
+    histo = h;
+    counts.assign(h->GetNbinsX(), 0);
+  }
+
+  void count(int bin) { counts[bin]++; }
+
+  /// Adds the counts to the histogram, the content and the number of entries are the ones of as many Fill calls
+  void flush()
+  {
+    uint64_t nEntries = 0;
+    for (std::size_t i = 0; i < counts.size(); i++) {
+      if (counts[i] == 0) {
+        continue;
+      }
+      histo->AddBinContent(i + 1, counts[i]);
+      if (histo->GetSumw2N()) {
+        histo->GetSumw2()->AddAt(histo->GetSumw2()->At(i + 1) + counts[i], i + 1); // unit weights
+      }
+      nEntries += counts[i];
+      counts[i] = 0;
+    }
+    if (nEntries > 0) {
+      histo->SetEntries(histo->GetEntries() + nEntries);
+    }
+  }
+};
+
 struct lumiStabilityTask {
   // Histogram registry: an object to hold your histograms
   HistogramRegistry histos{"histos", {}, OutputObjHandlingPolicy::AnalysisObject};
@@ -40,69 +82,148 @@ struct lumiStabilityTask {
   Configurable<int> myMaxDeltaBCFT0{"myMaxDeltaBCFT0", 5, {"My BC cut"}};
   Configurable<int> myMaxDeltaBCFV0{"myMaxDeltaBCFV0", 5, {"My BC cut"}};
 
+  // histograms filled per BC, counted in integers and added to the histograms once per dataframe
+  enum Counter { kFDDCounts,
+                 kFDDVertexTrigger,
+                 kFDDVertexTriggerCoincidence,
+                 kFDDVertexTriggerCoincidencePFP,
+                 kFDDVertexTriggerCoincidencePP,
+                 kFDDVertexTriggerBothSidesCoincidencePFP,
+                 kFDDVertexTriggerBothSidesCoincidencePP,
+                 kFDDSCentralTrigger,
+                 kFDDSCentralTriggerCoincidence,
+                 kFDDVSCTrigger,
+                 kFDDVSCTriggerCoincidence,
+                 kFDDCentralTrigger,
+                 kFDDCentralTriggerCoincidence,
+                 kFDDVCTrigger,
+                 kFDDVCTriggerCoincidence,
+                 kFT0Counts,
+                 kFT0VertexTrigger,
+                 kFT0VertexTriggerPFP,
+                 kFT0VertexTriggerPP,
+                 kFT0VertexTriggerBothSidesPFP,
+                 kFT0VertexTriggerBothSidesPP,
+                 kFT0SCentralTrigger,
+                 kFT0VSCTrigger,
+                 kFT0CentralTrigger,
+                 kFT0SCentralCentralTrigger,
+                 kFT0VCTrigger,
+                 kFV0Counts,
+                 kFV0OutTrigger,
+                 kFV0InTrigger,
+                 kFV0SCenTrigger,
+                 kFV0CenTrigger,
+                 kFV0CenTriggerPFPCentral,
+                 kFV0CenTriggerPPCentral,
+                 kFV0CenTriggerPFPOutIn,
+                 kFV0CenTriggerPPOutIn,
+                 kNCounters };
+  std::array<BinCounter, kNCounters> counters;
+
   void init(InitContext const&)
   {
     const AxisSpec axisCounts{5, -0.5, 4.5};
     const AxisSpec axisTriggger{nBCsPerOrbit, -0.5f, nBCsPerOrbit - 0.5f};
 
     // histo about triggers
-    histos.add("FDD/hCounts", "0 CountVertexFDD - 1 CountPFPVertexCoincidencesFDD - 2 CountPFPTriggerCoincidencesFDD - 3 CountPPVertexCoincidencesFDD - 4 CountPPTriggerCoincidencesFDD; Number; counts", kTH1F, {axisCounts});
-    histos.add("FDD/bcVertexTrigger", "vertex trigger per BC (FDD);BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcVertexTriggerCoincidence", "vertex trigger per BC (FDD) with coincidences;BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcVertexTriggerCoincidencePFP", "vertex trigger per BC (FDD) with coincidences and Past Future Protection;BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcVertexTriggerCoincidencePP", "vertex trigger per BC (FDD) with coincidences and Past Protection;BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcVertexTriggerBothSidesCoincidencePFP", "vertex per BC (FDD) with coincidences, at least one side trigger and Past Future Protection;BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcVertexTriggerBothSidesCoincidencePP", "vertex per BC (FDD) with coincidences, at least one side trigger and Past Protection;BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcSCentralTrigger", "scentral trigger per BC (FDD);BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcSCentralTriggerCoincidence", "scentral trigger per BC (FDD) with coincidences;BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcVSCTrigger", "vertex and scentral trigger per BC (FDD);BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcVSCTriggerCoincidence", "vertex and scentral trigger per BC (FDD) with coincidences;BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcCentralTrigger", "central trigger per BC (FDD);BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcCentralTriggerCoincidence", "central trigger per BC (FDD) with coincidences;BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcVCTrigger", "vertex and central trigger per BC (FDD);BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FDD/bcVCTriggerCoincidence", "vertex and central trigger per BC (FDD) with coincidences;BC in FDD; counts", kTH1F, {axisTriggger});
-
-    histos.add("FT0/hCounts", "0 CountVertexFT0 - 1 CountPFPVertexCoincidencesFT0 - 2 CountPFPTriggerCoincidencesFT0 - 3 CountPPVertexCoincidencesFT0 - 4 CountPPTriggerCoincidencesFT0; Number; counts", kTH1F, {axisCounts});
-    histos.add("FT0/bcVertexTrigger", "vertex trigger per BC (FT0);BC in FT0; counts", kTH1F, {axisTriggger});
-    histos.add("FT0/bcVertexTriggerPFP", "vertex trigger per BC (FT0) with Past Future Protection;BC in FT0; counts", kTH1F, {axisTriggger});
-    histos.add("FT0/bcVertexTriggerPP", "vertex trigger per BC (FT0) with Past Protection;BC in FT0; counts", kTH1F, {axisTriggger});
-    histos.add("FT0/bcVertexTriggerBothSidesPFP", "vertex per BC (FDD) with coincidences, at least one side trigger and Past Future Protection;BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FT0/bcVertexTriggerBothSidesPP", "vertex per BC (FDD) with coincidences, at least one side trigger and Past Protection;BC in FDD; counts", kTH1F, {axisTriggger});
-    histos.add("FT0/bcSCentralTrigger", "Scentral trigger per BC (FT0);BC in FT0; counts", kTH1F, {axisTriggger});
-    histos.add("FT0/bcVSCTrigger", "vertex and Scentral trigger per BC (FT0);BC in FT0; counts", kTH1F, {axisTriggger});
-    histos.add("FT0/bcCentralTrigger", "central trigger per BC (FT0);BC in FT0; counts", kTH1F, {axisTriggger});
-    histos.add("FT0/bcVCTrigger", "vertex and central trigger per BC (FT0);BC in FT0; counts", kTH1F, {axisTriggger});
-
-    histos.add("FV0/hCounts", "0 CountCentralFV0 - 1 CountPFPCentralFV0 - 2 CountPFPOutInFV0 - 3 CountPPCentralFV0 - 4 CountPPOutInFV0; Number; counts", kTH1F, {axisCounts});
-    histos.add("FV0/bcOutTrigger", "Out trigger per BC (FV0);BC in V0; counts", kTH1F, {axisTriggger});
-    histos.add("FV0/bcInTrigger", "In trigger per BC (FV0);BC in V0; counts", kTH1F, {axisTriggger});
-    histos.add("FV0/bcSCenTrigger", "SCen trigger per BC (FV0);BC in V0; counts", kTH1F, {axisTriggger});
-    histos.add("FV0/bcCenTrigger", "Central trigger per BC (FV0);BC in V0; counts", kTH1F, {axisTriggger});
-    histos.add("FV0/bcCenTriggerPFPCentral", "Central trigger per BC (FV0) with PFP in central trigger;BC in V0; counts", kTH1F, {axisTriggger});
-    histos.add("FV0/bcCenTriggerPPCentral", "Central trigger per BC (FV0) with PP in central trigger;BC in V0; counts", kTH1F, {axisTriggger});
-    histos.add("FV0/bcCenTriggerPFPOutIn", "Central trigger per BC (FV0) with PFP in Out and In trigger;BC in V0; counts", kTH1F, {axisTriggger});
-    histos.add("FV0/bcCenTriggerPPOutIn", "Central trigger per BC (FV0) with PP in Out and In trigger;BC in V0; counts", kTH1F, {axisTriggger});
+    counters[kFDDCounts].init(histos.add<TH1>("FDD/hCounts", "0 CountVertexFDD - 1 CountPFPVertexCoincidencesFDD - 2 CountPFPTriggerCoincidencesFDD - 3 CountPPVertexCoincidencesFDD - 4 CountPPTriggerCoincidencesFDD; Number; counts", kTH1F, {axisCounts}));
+    counters[kFDDVertexTrigger].init(histos.add<TH1>("FDD/bcVertexTrigger", "vertex trigger per BC (FDD);BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDVertexTriggerCoincidence].init(histos.add<TH1>("FDD/bcVertexTriggerCoincidence", "vertex trigger per BC (FDD) with coincidences;BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDVertexTriggerCoincidencePFP].init(histos.add<TH1>("FDD/bcVertexTriggerCoincidencePFP", "vertex trigger per BC (FDD) with coincidences and Past Future Protection;BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDVertexTriggerCoincidencePP].init(histos.add<TH1>("FDD/bcVertexTriggerCoincidencePP", "vertex trigger per BC (FDD) with coincidences and Past Protection;BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDVertexTriggerBothSidesCoincidencePFP].init(histos.add<TH1>("FDD/bcVertexTriggerBothSidesCoincidencePFP", "vertex per BC (FDD) with coincidences, at least one side trigger and Past Future Protection;BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDVertexTriggerBothSidesCoincidencePP].init(histos.add<TH1>("FDD/bcVertexTriggerBothSidesCoincidencePP", "vertex per BC (FDD) with coincidences, at least one side trigger and Past Protection;BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDSCentralTrigger].init(histos.add<TH1>("FDD/bcSCentralTrigger", "scentral trigger per BC (FDD);BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDSCentralTriggerCoincidence].init(histos.add<TH1>("FDD/bcSCentralTriggerCoincidence", "scentral trigger per BC (FDD) with coincidences;BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDVSCTrigger].init(histos.add<TH1>("FDD/bcVSCTrigger", "vertex and scentral trigger per BC (FDD);BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDVSCTriggerCoincidence].init(histos.add<TH1>("FDD/bcVSCTriggerCoincidence", "vertex and scentral trigger per BC (FDD) with coincidences;BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDCentralTrigger].init(histos.add<TH1>("FDD/bcCentralTrigger", "central trigger per BC (FDD);BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDCentralTriggerCoincidence].init(histos.add<TH1>("FDD/bcCentralTriggerCoincidence", "central trigger per BC (FDD) with coincidences;BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDVCTrigger].init(histos.add<TH1>("FDD/bcVCTrigger", "vertex and central trigger per BC (FDD);BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFDDVCTriggerCoincidence].init(histos.add<TH1>("FDD/bcVCTriggerCoincidence", "vertex and central trigger per BC (FDD) with coincidences;BC in FDD; counts", kTH1F, {axisTriggger}));
+
+    counters[kFT0Counts].init(histos.add<TH1>("FT0/hCounts", "0 CountVertexFT0 - 1 CountPFPVertexCoincidencesFT0 - 2 CountPFPTriggerCoincidencesFT0 - 3 CountPPVertexCoincidencesFT0 - 4 CountPPTriggerCoincidencesFT0; Number; counts", kTH1F, {axisCounts}));
+    counters[kFT0VertexTrigger].init(histos.add<TH1>("FT0/bcVertexTrigger", "vertex trigger per BC (FT0);BC in FT0; counts", kTH1F, {axisTriggger}));
+    counters[kFT0VertexTriggerPFP].init(histos.add<TH1>("FT0/bcVertexTriggerPFP", "vertex trigger per BC (FT0) with Past Future Protection;BC in FT0; counts", kTH1F, {axisTriggger}));
+    counters[kFT0VertexTriggerPP].init(histos.add<TH1>("FT0/bcVertexTriggerPP", "vertex trigger per BC (FT0) with Past Protection;BC in FT0; counts", kTH1F, {axisTriggger}));
+    counters[kFT0VertexTriggerBothSidesPFP].init(histos.add<TH1>("FT0/bcVertexTriggerBothSidesPFP", "vertex per BC (FDD) with coincidences, at least one side trigger and Past Future Protection;BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFT0VertexTriggerBothSidesPP].init(histos.add<TH1>("FT0/bcVertexTriggerBothSidesPP", "vertex per BC (FDD) with coincidences, at least one side trigger and Past Protection;BC in FDD; counts", kTH1F, {axisTriggger}));
+    counters[kFT0SCentralTrigger].init(histos.add<TH1>("FT0/bcSCentralTrigger", "Scentral trigger per BC (FT0);BC in FT0; counts", kTH1F, {axisTriggger}));
+    counters[kFT0VSCTrigger].init(histos.add<TH1>("FT0/bcVSCTrigger", "vertex and Scentral trigger per BC (FT0);BC in FT0; counts", kTH1F, {axisTriggger}));
+    counters[kFT0CentralTrigger].init(histos.add<TH1>("FT0/bcCentralTrigger", "central trigger per BC (FT0);BC in FT0; counts", kTH1F, {axisTriggger}));
+    counters[kFT0SCentralCentralTrigger].init(histos.add<TH1>("FT0/bcSCentralCentralTrigger", "Scentral and central trigger per BC (FT0);BC in FT0; counts", kTH1F, {axisTriggger}));
+    counters[kFT0VCTrigger].init(histos.add<TH1>("FT0/bcVCTrigger", "vertex and central trigger per BC (FT0);BC in FT0; counts", kTH1F, {axisTriggger}));
+
+    counters[kFV0Counts].init(histos.add<TH1>("FV0/hCounts", "0 CountCentralFV0 - 1 CountPFPCentralFV0 - 2 CountPFPOutInFV0 - 3 CountPPCentralFV0 - 4 CountPPOutInFV0; Number; counts", kTH1F, {axisCounts}));
+    counters[kFV0OutTrigger].init(histos.add<TH1>("FV0/bcOutTrigger", "Out trigger per BC (FV0);BC in V0; counts", kTH1F, {axisTriggger}));
+    counters[kFV0InTrigger].init(histos.add<TH1>("FV0/bcInTrigger", "In trigger per BC (FV0);BC in V0; counts", kTH1F, {axisTriggger}));
+    counters[kFV0SCenTrigger].init(histos.add<TH1>("FV0/bcSCenTrigger", "SCen trigger per BC (FV0);BC in V0; counts", kTH1F, {axisTriggger}));
+    counters[kFV0CenTrigger].init(histos.add<TH1>("FV0/bcCenTrigger", "Central trigger per BC (FV0);BC in V0; counts", kTH1F, {axisTriggger}));
+    counters[kFV0CenTriggerPFPCentral].init(histos.add<TH1>("FV0/bcCenTriggerPFPCentral", "Central trigger per BC (FV0) with PFP in central trigger;BC in V0; counts", kTH1F, {axisTriggger}));
+    counters[kFV0CenTriggerPPCentral].init(histos.add<TH1>("FV0/bcCenTriggerPPCentral", "Central trigger per BC (FV0) with PP in central trigger;BC in V0; counts", kTH1F, {axisTriggger}));
+    counters[kFV0CenTriggerPFPOutIn].init(histos.add<TH1>("FV0/bcCenTriggerPFPOutIn", "Central trigger per BC (FV0) with PFP in Out and In trigger;BC in V0; counts", kTH1F, {axisTriggger}));
+    counters[kFV0CenTriggerPPOutIn].init(histos.add<TH1>("FV0/bcCenTriggerPPOutIn", "Central trigger per BC (FV0) with PP in Out and In trigger;BC in V0; counts", kTH1F, {axisTriggger}));
   }
 
-  bool checkAnyCoincidence(const std::vector<int>& channels)
+  // per FDD entry, computed once per dataframe and read by the past-future protection of the neighbouring entries
+  enum FDDActivityBits : uint8_t {
+    kCoincidenceAC = 0,    // coincidence on both sides
+    kVertexCoincidenceAC,  // vertex trigger and coincidence on both sides
+    kTriggerACoincidenceA, // A-side trigger and coincidence on the A side
+    kTriggerCCoincidenceC  // C-side trigger and coincidence on the C side
+  };
+  std::vector<uint8_t> fddActivities;
+
+  /// \param channels bit map of the fired channels of a side
+  static bool checkAnyCoincidence(uint8_t channels)
   {
-    constexpr std::pair<int, int> pair0 = {0, 4};
-    constexpr std::pair<int, int> pair1 = {1, 5};
-    constexpr std::pair<int, int> pair2 = {2, 6};
-    constexpr std::pair<int, int> pair3 = {3, 7};
-    constexpr std::array<std::pair<int, int>, 4> channelPairs = {pair0, pair1, pair2, pair3};
-    // std::map<int, int> channelPairs = {{0, 4}, {1, 5}, {2, 6}, {3, 7}};
-    for (const auto& pair : channelPairs) {
-      if (std::find(channels.begin(), channels.end(), pair.first) != channels.end() &&
-          std::find(channels.begin(), channels.end(), pair.second) != channels.end()) {
-        return true;
+    // channel pairs {0, 4}, {1, 5}, {2, 6} and {3, 7}
+    return (channels & (channels >> 4) & 0xF) != 0;
+  }
+
+  template <typename T>
+  static uint8_t getFDDActivity(T const& fdd)
+  {
+    auto SideA = fdd.chargeA();
+    auto SideC = fdd.chargeC();
+    uint8_t channelA = 0;
+    uint8_t channelC = 0;
+    for (auto i = 0; i < 8; i++) {
+      if (SideA[i] > 0) {
+        channelA |= BIT(i);
+      }
+      if (SideC[i] > 0) {
+        channelC |= BIT(i);
       }
     }
-    return false;
+    const bool isCoinA = checkAnyCoincidence(channelA);
+    const bool isCoinC = checkAnyCoincidence(channelC);
+    std::bitset<8> fddTriggers = fdd.triggerMask();
+    uint8_t activity = 0;
+    if (isCoinA && isCoinC) {
+      activity |= BIT(kCoincidenceAC);
+      if (fddTriggers[o2::fdd::Triggers::bitVertex]) {
+        activity |= BIT(kVertexCoincidenceAC);
+      }
+    }
+    if (isCoinA && fddTriggers[o2::fdd::Triggers::bitA]) {
+      activity |= BIT(kTriggerACoincidenceA);
+    }
+    if (isCoinC && fddTriggers[o2::fdd::Triggers::bitC]) {
+      activity |= BIT(kTriggerCCoincidenceC);
+    }
+    return activity;
   }
 
   void processMain(aod::FDDs const& fdds, aod::FT0s const& ft0s, aod::FV0As const& fv0s, aod::BCsWithTimestamps const&)
   {
+    fddActivities.clear();
+    fddActivities.reserve(fdds.size());
+    for (auto const& fdd : fdds) {
+      fddActivities.push_back(getFDDActivity(fdd));
+    }
+
     for (auto const& fdd : fdds) {
       auto bc = fdd.bc_as<BCsWithTimestamps>();
       if (bc.timestamp() == 0) {
@@ -117,32 +238,16 @@ struct lumiStabilityTask {
       bool scentral = fddTriggers[o2::fdd::Triggers::bitSCen];
       bool central = fddTriggers[o2::fdd::Triggers::bitCen];
 
-      auto SideA = fdd.chargeA();
-      auto SideC = fdd.chargeC();
-      std::vector<int> channelA;
-      std::vector<int> channelC;
-      for (auto i = 0; i < 8; i++) {
-        if (SideA[i] > 0) {
-          channelA.push_back(i);
-        }
-        if (SideC[i] > 0) {
-          channelC.push_back(i);
-        }
-      }
-
-      bool isCoinA = checkAnyCoincidence(channelA);
-      bool isCoinC = checkAnyCoincidence(channelC);
+      const bool isCoinAC = fddActivities[fdd.globalIndex()] & BIT(kCoincidenceAC);
 
       if (vertex) {
-        histos.fill(HIST("FDD/bcVertexTrigger"), localBC);
-        if (isCoinA && isCoinC) {
-          histos.fill(HIST("FDD/bcVertexTriggerCoincidence"), localBC);
+        counters[kFDDVertexTrigger].count(localBC);
+        if (isCoinAC) {
+          counters[kFDDVertexTriggerCoincidence].count(localBC);
 
           int deltaIndex = 0; // backward move counts
           int deltaBC = 0;    // current difference wrt globalBC
-          bool pastActivityFDDVertexCoincidences = false;
-          bool pastActivityFDDTriggerACoincidenceA = false;
-          bool pastActivityFDDTriggerCCoincidenceC = false;
+          uint8_t pastActivity = 0;
           while (deltaBC < myMaxDeltaBCFDD) {
             deltaIndex++;
             if (fdd.globalIndex() - deltaIndex < 0) {
@@ -152,36 +257,13 @@ struct lumiStabilityTask {
             deltaBC = fdd.bcId() - fdd_past.bcId();
 
             if (deltaBC < myMaxDeltaBCFDD) {
-              std::bitset<8> fddTriggersPast = fdd_past.triggerMask();
-              bool vertexPast = fddTriggersPast[o2::fdd::Triggers::bitVertex];
-              bool triggerAPast = fddTriggersPast[o2::fdd::Triggers::bitA];
-              bool triggerCPast = fddTriggersPast[o2::fdd::Triggers::bitC];
-              auto SideAPast = fdd_past.chargeA();
-              auto SideCPast = fdd_past.chargeC();
-              std::vector<int> channelAPast;
-              std::vector<int> channelCPast;
-              for (auto i = 0; i < 8; i++) {
-                if (SideAPast[i] > 0) {
-                  channelAPast.push_back(i);
-                }
-                if (SideCPast[i] > 0) {
-                  channelCPast.push_back(i);
-                }
-              }
-
-              bool isCoinAPast = checkAnyCoincidence(channelAPast);
-              bool isCoinCPast = checkAnyCoincidence(channelCPast);
-              pastActivityFDDVertexCoincidences |= (vertexPast & isCoinAPast & isCoinCPast);
-              pastActivityFDDTriggerACoincidenceA |= (triggerAPast & isCoinAPast);
-              pastActivityFDDTriggerCCoincidenceC |= (triggerCPast & isCoinCPast);
+              pastActivity |= fddActivities[fdd_past.globalIndex()];
             }
           }
           deltaIndex = 0;
           deltaBC = 0;
 
-          bool futureActivityFDDVertexCoincidences = false;
-          bool futureActivityFDDTriggerACoincidenceA = false;
-          bool futureActivityFDDTriggerCCoincidenceC = false;
+          uint8_t futureActivity = 0;
           while (deltaBC < myMaxDeltaBCFDD) {
             deltaIndex++;
             if (fdd.globalIndex() + deltaIndex >= fdds.size()) {
@@ -191,80 +273,60 @@ struct lumiStabilityTask {
             deltaBC = fdd_future.bcId() - fdd.bcId();
 
             if (deltaBC < myMaxDeltaBCFDD) {
-              std::bitset<8> fddTriggersFuture = fdd_future.triggerMask();
-              bool vertexFuture = fddTriggersFuture[o2::fdd::Triggers::bitVertex];
-              bool triggerAFuture = fddTriggersFuture[o2::fdd::Triggers::bitA];
-              bool triggerCFuture = fddTriggersFuture[o2::fdd::Triggers::bitC];
-              auto SideAFuture = fdd_future.chargeA();
-              auto SideCFuture = fdd_future.chargeC();
-              std::vector<int> channelAFuture;
-              std::vector<int> channelCFuture;
-              for (auto i = 0; i < 8; i++) {
-                if (SideAFuture[i] > 0) {
-                  channelAFuture.push_back(i);
-                }
-                if (SideCFuture[i] > 0) {
-                  channelCFuture.push_back(i);
-                }
-              }
-
-              bool isCoinAFuture = checkAnyCoincidence(channelAFuture);
-              bool isCoinCFuture = checkAnyCoincidence(channelCFuture);
-              futureActivityFDDVertexCoincidences |= (vertexFuture & isCoinAFuture & isCoinCFuture);
-              futureActivityFDDTriggerACoincidenceA |= (triggerAFuture & isCoinAFuture);
-              futureActivityFDDTriggerCCoincidenceC |= (triggerCFuture & isCoinCFuture);
+              futureActivity |= fddActivities[fdd_future.globalIndex()];
             }
           }
 
-          histos.fill(HIST("FDD/hCounts"), 0);
-          if ((pastActivityFDDTriggerACoincidenceA || futureActivityFDDTriggerACoincidenceA) == true || (pastActivityFDDTriggerCCoincidenceC || futureActivityFDDTriggerCCoincidenceC) == true) {
-            histos.fill(HIST("FDD/hCounts"), 2);
+          constexpr uint8_t triggerCoincidences = BIT(kTriggerACoincidenceA) | BIT(kTriggerCCoincidenceC);
+          counters[kFDDCounts].count(0);
+          if ((pastActivity | futureActivity) & triggerCoincidences) {
+            counters[kFDDCounts].count(2);
           } else {
-            histos.fill(HIST("FDD/bcVertexTriggerBothSidesCoincidencePFP"), localBC);
+            counters[kFDDVertexTriggerBothSidesCoincidencePFP].count(localBC);
           }
-          if (pastActivityFDDTriggerACoincidenceA == true || pastActivityFDDTriggerCCoincidenceC == true) {
-            histos.fill(HIST("FDD/hCounts"), 4);
+          if (pastActivity & triggerCoincidences) {
+            counters[kFDDCounts].count(4);
           } else {
-            histos.fill(HIST("FDD/bcVertexTriggerBothSidesCoincidencePP"), localBC);
+            counters[kFDDVertexTriggerBothSidesCoincidencePP].count(localBC);
           }
-          if (pastActivityFDDVertexCoincidences == true || futureActivityFDDVertexCoincidences == true) {
-            histos.fill(HIST("FDD/hCounts"), 1);
+          if ((pastActivity | futureActivity) & BIT(kVertexCoincidenceAC)) {
+            counters[kFDDCounts].count(1);
           } else {
-            histos.fill(HIST("FDD/bcVertexTriggerCoincidencePFP"), localBC);
+            counters[kFDDVertexTriggerCoincidencePFP].count(localBC);
           }
-          if (pastActivityFDDVertexCoincidences == true) {
-            histos.fill(HIST("FDD/hCounts"), 3);
+          if (pastActivity & BIT(kVertexCoincidenceAC)) {
+            counters[kFDDCounts].count(3);
           } else {
-            histos.fill(HIST("FDD/bcVertexTriggerCoincidencePP"), localBC);
+            counters[kFDDVertexTriggerCoincidencePP].count(localBC);
           }
         }
       } // vertex true
 
       if (scentral) {
-        histos.fill(HIST("FDD/bcSCentralTrigger"), localBC);
-        if (isCoinA && isCoinC) {
-          histos.fill(HIST("FDD/bcSCentralTriggerCoincidence"), localBC);
+        counters[kFDDSCentralTrigger].count(localBC);
+        if (isCoinAC) {
+          counters[kFDDSCentralTriggerCoincidence].count(localBC);
         }
       } // central true
 
       if (vertex && scentral) {
-        histos.fill(HIST("FDD/bcVSCTrigger"), localBC);
-        if (isCoinA && isCoinC) {
-          histos.fill(HIST("FDD/bcVSCTriggerCoincidence"), localBC);
+        counters[kFDDVSCTrigger].count(localBC);
+        if (isCoinAC) {
+          counters[kFDDVSCTriggerCoincidence].count(localBC);
         }
       } // vertex and scentral true
 
       if (central) {
-        histos.fill(HIST("FDD/bcCentralTrigger"), localBC);
-        if (isCoinA && isCoinC) {
-          histos.fill(HIST("FDD/bcCentralTriggerCoincidence"), localBC);
+        counters[kFDDCentralTrigger].count(localBC);
+        if (isCoinAC) {
+          counters[kFDDCentralTriggerCoincidence].count(localBC);
         }
       }
 
       if (vertex && central) {
-        histos.fill(HIST("FDD/bcVCTrigger"), localBC);
-        if (isCoinA && isCoinC) {
-          histos.fill(HIST("FDD/bcVCTriggerCoincidence"), localBC);
+        counters[kFDDVCTrigger].count(localBC);
+        if (isCoinAC) {
+          counters[kFDDVCTriggerCoincidence].count(localBC);
         }
       } // vertex and scentral true
     }   // loop over FDD events
@@ -284,13 +346,11 @@ struct lumiStabilityTask {
       bool central = fT0Triggers[o2::ft0::Triggers::bitCen];
 
       if (vertex) {
-        histos.fill(HIST("FT0/bcVertexTrigger"), localBC);
+        counters[kFT0VertexTrigger].count(localBC);
 
         int deltaIndex = 0; // backward move counts
         int deltaBC = 0;    // current difference wrt globalBC
-        bool pastActivityFT0Vertex = false;
-        bool pastActivityFT0TriggerA = false;
-        bool pastActivityFT0TriggerC = false;
+        uint8_t pastTriggers = 0; // trigger bits of the past entries
         while (deltaBC < myMaxDeltaBCFT0) {
           deltaIndex++;
           if (ft0.globalIndex() - deltaIndex < 0) {
@@ -300,22 +360,13 @@ struct lumiStabilityTask {
           deltaBC = ft0.bcId() - ft0_past.bcId();
 
           if (deltaBC < myMaxDeltaBCFT0) {
-            std::bitset<8> fT0TriggersPast = ft0_past.triggerMask();
-            bool vertexPast = fT0TriggersPast[o2::ft0::Triggers::bitVertex];
-            bool triggerAPast = fT0TriggersPast[o2::ft0::Triggers::bitA];
-            bool triggerCPast = fT0TriggersPast[o2::ft0::Triggers::bitC];
-
-            pastActivityFT0Vertex |= vertexPast;
-            pastActivityFT0TriggerA |= triggerAPast;
-            pastActivityFT0TriggerC |= triggerCPast;
+            pastTriggers |= ft0_past.triggerMask();
           }
         }
         deltaIndex = 0;
         deltaBC = 0;
 
-        bool futureActivityFT0Vertex = false;
-        bool futureActivityFT0TriggerA = false;
-        bool futureActivityFT0TriggerC = false;
+        uint8_t futureTriggers = 0; // trigger bits of the future entries
         while (deltaBC < myMaxDeltaBCFT0) {
           deltaIndex++;
           if (ft0.globalIndex() + deltaIndex >= ft0s.size()) {
@@ -325,54 +376,48 @@ struct lumiStabilityTask {
           deltaBC = ft0_future.bcId() - ft0.bcId();
 
           if (deltaBC < myMaxDeltaBCFT0) {
-            std::bitset<8> fT0TriggersFuture = ft0_future.triggerMask();
-            bool vertexFuture = fT0TriggersFuture[o2::ft0::Triggers::bitVertex];
-            bool triggerAFuture = fT0TriggersFuture[o2::ft0::Triggers::bitA];
-            bool triggerCFuture = fT0TriggersFuture[o2::ft0::Triggers::bitC];
-
-            futureActivityFT0Vertex |= vertexFuture;
-            futureActivityFT0TriggerA |= triggerAFuture;
-            futureActivityFT0TriggerC |= triggerCFuture;
+            futureTriggers |= ft0_future.triggerMask();
           }
         }
 
-        histos.fill(HIST("FT0/hCounts"), 0);
-        if ((pastActivityFT0TriggerA || futureActivityFT0TriggerA) == true || (pastActivityFT0TriggerC || futureActivityFT0TriggerC) == true) {
-          histos.fill(HIST("FT0/hCounts"), 2);
+        constexpr uint8_t sideTriggers = BIT(o2::ft0::Triggers::bitA) | BIT(o2::ft0::Triggers::bitC);
+        counters[kFT0Counts].count(0);
+        if ((pastTriggers | futureTriggers) & sideTriggers) {
+          counters[kFT0Counts].count(2);
         } else {
-          histos.fill(HIST("FT0/bcVertexTriggerBothSidesPFP"), localBC);
+          counters[kFT0VertexTriggerBothSidesPFP].count(localBC);
         }
-        if (pastActivityFT0TriggerA == true || pastActivityFT0TriggerC == true) {
-          histos.fill(HIST("FT0/hCounts"), 4);
+        if (pastTriggers & sideTriggers) {
+          counters[kFT0Counts].count(4);
         } else {
-          histos.fill(HIST("FT0/bcVertexTriggerBothSidesPP"), localBC);
+          counters[kFT0VertexTriggerBothSidesPP].count(localBC);
         }
-        if (pastActivityFT0Vertex == true || futureActivityFT0Vertex == true) {
-          histos.fill(HIST("FT0/hCounts"), 1);
+        if ((pastTriggers | futureTriggers) & BIT(o2::ft0::Triggers::bitVertex)) {
+          counters[kFT0Counts].count(1);
         } else {
-          histos.fill(HIST("FT0/bcVertexTriggerPFP"), localBC);
+          counters[kFT0VertexTriggerPFP].count(localBC);
         }
-        if (pastActivityFT0Vertex == true) {
-          histos.fill(HIST("FT0/hCounts"), 3);
+        if (pastTriggers & BIT(o2::ft0::Triggers::bitVertex)) {
+          counters[kFT0Counts].count(3);
         } else {
-          histos.fill(HIST("FT0/bcVertexTriggerPP"), localBC);
+          counters[kFT0VertexTriggerPP].count(localBC);
         }
       } // vertex true
 
       if (sCentral) {
-        histos.fill(HIST("FT0/bcSCentralTrigger"), localBC);
+        counters[kFT0SCentralTrigger].count(localBC);
         if (vertex) {
-          histos.fill(HIST("FT0/bcVSCTrigger"), localBC);
+          counters[kFT0VSCTrigger].count(localBC);
         }
       } // scentral true
 
       if (central) {
-        histos.fill(HIST("FT0/bcCentralTrigger"), localBC);
+        counters[kFT0CentralTrigger].count(localBC);
         if (sCentral) {
-          histos.fill(HIST("FT0/bcSCentralCentralTrigger"), localBC);
+          counters[kFT0SCentralCentralTrigger].count(localBC);
         }
         if (vertex) {
-          histos.fill(HIST("FT0/bcVCTrigger"), localBC);
+          counters[kFT0VCTrigger].count(localBC);
         }
       }
     } // loop over FT0 events
@@ -393,25 +438,23 @@ struct lumiStabilityTask {
       bool aCen = fv0Triggers[o2::fv0::Triggers::bitTrgCharge];
 
       if (aOut) {
-        histos.fill(HIST("FV0/bcOutTrigger"), localBC);
+        counters[kFV0OutTrigger].count(localBC);
       }
 
       if (aIn) {
-        histos.fill(HIST("FV0/bcInTrigger"), localBC);
+        counters[kFV0InTrigger].count(localBC);
       }
 
       if (aSCen) {
-        histos.fill(HIST("FV0/bcSCenTrigger"), localBC);
+        counters[kFV0SCenTrigger].count(localBC);
       }
 
       if (aCen) {
-        histos.fill(HIST("FV0/bcCenTrigger"), localBC);
+        counters[kFV0CenTrigger].count(localBC);
 
         int deltaIndex = 0; // backward move counts
         int deltaBC = 0;    // current difference wrt globalBC
-        bool pastActivityFV0Cen = false;
-        bool pastActivityFV0TriggerOut = false;
-        bool pastActivityFV0TriggerIn = false;
+        uint8_t pastTriggers = 0; // trigger bits of the past entries
         while (deltaBC < myMaxDeltaBCFV0) {
           deltaIndex++;
           if (fv0.globalIndex() - deltaIndex < 0) {
@@ -421,22 +464,13 @@ struct lumiStabilityTask {
           deltaBC = fv0.bcId() - fv0_past.bcId();
 
           if (deltaBC < myMaxDeltaBCFV0) {
-            std::bitset<8> fv0Triggers = fv0_past.triggerMask();
-            bool centralPast = fv0Triggers[o2::fv0::Triggers::bitTrgCharge];
-            bool triggerOutPast = fv0Triggers[o2::fv0::Triggers::bitAOut];
-            bool triggerInPast = fv0Triggers[o2::fv0::Triggers::bitAIn];
-
-            pastActivityFV0Cen |= centralPast;
-            pastActivityFV0TriggerOut |= triggerOutPast;
-            pastActivityFV0TriggerIn |= triggerInPast;
+            pastTriggers |= fv0_past.triggerMask();
           }
         }
         deltaIndex = 0;
         deltaBC = 0;
 
-        bool futureActivityFV0Cen = false;
-        bool futureActivityFV0TriggerOut = false;
-        bool futureActivityFV0TriggerIn = false;
+        uint8_t futureTriggers = 0; // trigger bits of the future entries
         while (deltaBC < myMaxDeltaBCFV0) {
           deltaIndex++;
           if (fv0.globalIndex() + deltaIndex >= fv0s.size()) {
@@ -446,41 +480,39 @@ struct lumiStabilityTask {
           deltaBC = fv0_future.bcId() - fv0.bcId();
 
           if (deltaBC < myMaxDeltaBCFV0) {
-            std::bitset<8> fv0Triggers = fv0_future.triggerMask();
-            bool centralFuture = fv0Triggers[o2::fv0::Triggers::bitTrgCharge];
-            bool triggerOutFuture = fv0Triggers[o2::fv0::Triggers::bitAOut];
-            bool triggerInFuture = fv0Triggers[o2::fv0::Triggers::bitAIn];
-
-            futureActivityFV0Cen |= centralFuture;
-            futureActivityFV0TriggerOut |= triggerOutFuture;
-            futureActivityFV0TriggerIn |= triggerInFuture;
+            futureTriggers |= fv0_future.triggerMask();
           }
         }
 
-        histos.fill(HIST("FV0/hCounts"), 0);
-        if ((pastActivityFV0TriggerOut || futureActivityFV0TriggerOut) == true || (pastActivityFV0TriggerIn || futureActivityFV0TriggerIn) == true) {
-          histos.fill(HIST("FV0/hCounts"), 2);
+        constexpr uint8_t outInTriggers = BIT(o2::fv0::Triggers::bitAOut) | BIT(o2::fv0::Triggers::bitAIn);
+        counters[kFV0Counts].count(0);
+        if ((pastTriggers | futureTriggers) & outInTriggers) {
+          counters[kFV0Counts].count(2);
         } else {
-          histos.fill(HIST("FV0/bcCenTriggerPFPOutIn"), localBC);
+          counters[kFV0CenTriggerPFPOutIn].count(localBC);
         }
-        if (pastActivityFV0TriggerOut == true || pastActivityFV0TriggerIn == true) {
-          histos.fill(HIST("FV0/hCounts"), 4);
+        if (pastTriggers & outInTriggers) {
+          counters[kFV0Counts].count(4);
         } else {
-          histos.fill(HIST("FV0/bcCenTriggerPPOutIn"), localBC);
+          counters[kFV0CenTriggerPPOutIn].count(localBC);
         }
-        if (pastActivityFV0Cen == true || futureActivityFV0Cen == true) {
-          histos.fill(HIST("FV0/hCounts"), 1);
+        if ((pastTriggers | futureTriggers) & BIT(o2::fv0::Triggers::bitTrgCharge)) {
+          counters[kFV0Counts].count(1);
         } else {
-          histos.fill(HIST("FV0/bcCenTriggerPFPCentral"), localBC);
+          counters[kFV0CenTriggerPFPCentral].count(localBC);
         }
-        if (pastActivityFV0Cen == true) {
-          histos.fill(HIST("FV0/hCounts"), 3);
+        if (pastTriggers & BIT(o2::fv0::Triggers::bitTrgCharge)) {
+          counters[kFV0Counts].count(3);
         } else {
-          histos.fill(HIST("FV0/bcCenTriggerPPCentral"), localBC);
+          counters[kFV0CenTriggerPPCentral].count(localBC);
         }
       }
     } // loop over V0 events
-  }   // end processMain
+
+    for (auto& counter : counters) {
+      counter.flush();
+    }
+  } // end processMain
 
   PROCESS_SWITCH(lumiStabilityTask, processMain, "Process FDD and FT0 to lumi stability analysis", true);
 };
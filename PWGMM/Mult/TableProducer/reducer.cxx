@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <array>
 #include <random>
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/AnalysisTask.h"
@@ -65,6 +66,29 @@ struct Reducer {
 
   std::vector<int> binned;
 
+  // terms of the double NBD depending only on the parameters, computed once in init instead of per MC collision
+  float nbdZeroBin = 0;
+  float nbdNorm = 0;
+  double nbdAlpha = 0;
+  float nbdInvOneMinusAlpha = 0;
+  std::array<double, 2> nbdK = {0, 0};
+  std::array<double, 2> nbdRatio = {0, 0};
+  std::array<double, 2> nbdTerm = {0, 0};
+
+  void initNBD()
+  {
+    auto p = [&](int i) { return params->get((int)0, i); };
+    nbdZeroBin = p(0);
+    nbdNorm = p(6);
+    nbdAlpha = p(1) * p(1) / (1. + p(1) * p(1));
+    nbdInvOneMinusAlpha = 1 + p(1) * p(1);
+    for (auto i = 0; i < 2; ++i) {
+      nbdK[i] = 1. + p(3 + 2 * i) * p(3 + 2 * i);
+      nbdRatio[i] = (p(2 + 2 * i) * p(2 + 2 * i)) / (nbdK[i] + (p(2 + 2 * i) * p(2 + 2 * i)));
+      nbdTerm[i] = TMath::Power(nbdK[i] / (nbdK[i] + (p(2 + 2 * i) * p(2 + 2 * i))), nbdK[i]);
+    }
+  }
+
   double NormalizedDoubleNBD(double x)
   {
     // <n> = (p[2,4]^2)
@@ -72,13 +96,13 @@ struct Reducer {
     // p[6] - normalization
     // alpha = p[1]^2 / ( 1 + p[1]^2), relative weight, 0 < alpha < 1
 
-    return params->get((int)0, 6) *
-           (params->get((int)0, 1) * params->get((int)0, 1) / (1. + params->get((int)0, 1) * params->get((int)0, 1)) * // alpha
-                                                                                                                       // v1 +
-              1. / (x * TMath::Beta(x, (1. + params->get((int)0, 3) * params->get((int)0, 3)))) * TMath::Power((params->get((int)0, 2) * params->get((int)0, 2)) / ((1. + params->get((int)0, 3) * params->get((int)0, 3)) + (params->get((int)0, 2) * params->get((int)0, 2))), x) * TMath::Power((1. + params->get((int)0, 3) * params->get((int)0, 3)) / ((1. + params->get((int)0, 3) * params->get((int)0, 3)) + (params->get((int)0, 2) * params->get((int)0, 2))), (1. + params->get((int)0, 3) * params->get((int)0, 3))) +
-            1. / (1 + params->get((int)0, 1) * params->get((int)0, 1)) * // 1 - alpha
-                                                                         // v2 );
-              1. / (x * TMath::Beta(x, (1. + params->get((int)0, 5) * params->get((int)0, 5)))) * TMath::Power((params->get((int)0, 4) * params->get((int)0, 4)) / ((1. + params->get((int)0, 5) * params->get((int)0, 5)) + (params->get((int)0, 4) * params->get((int)0, 4))), x) * TMath::Power((1. + params->get((int)0, 5) * params->get((int)0, 5)) / ((1. + params->get((int)0, 5) * params->get((int)0, 5)) + (params->get((int)0, 4) * params->get((int)0, 4))), (1. + params->get((int)0, 5) * params->get((int)0, 5))));
+    return nbdNorm *
+           (nbdAlpha * // alpha
+                       // v1 +
+              1. / (x * TMath::Beta(x, nbdK[0])) * TMath::Power(nbdRatio[0], x) * nbdTerm[0] +
+            1. / nbdInvOneMinusAlpha * // 1 - alpha
+                                    // v2 );
+              1. / (x * TMath::Beta(x, nbdK[1])) * TMath::Power(nbdRatio[1], x) * nbdTerm[1]);
   }
 
   void init(InitContext const&)
@@ -89,6 +113,7 @@ struct Reducer {
     etabins = static_cast<std::vector<double>>(etaBins);
     phibins = static_cast<std::vector<double>>(phiBins);
     binned.resize((etabins.size() - 1) * (phibins.size() - 1));
+    initNBD();
   }
 
   int findBin(float eta, float phi)
@@ -114,7 +139,7 @@ struct Reducer {
     auto i = 0;
     LOGP(debug, ">>> {} MC collisions for BC", mccollisions.size());
     for (auto& mcc : mccollisions) {
-      auto value = (mcc.multMCNParticlesEta10() == 0) ? params->get((int)0, (int)0) : NormalizedDoubleNBD((double)mcc.multMCNParticlesEta10());
+      auto value = (mcc.multMCNParticlesEta10() == 0) ? nbdZeroBin : NormalizedDoubleNBD((double)mcc.multMCNParticlesEta10());
       LOGP(debug, ">>> {} value for reduction (threshold {})", value, (float)reductionFactor);
       if (value < reductionFactor) {
         // if the fraction of events at this multiplicity is less than reduction factor, keep the event as is
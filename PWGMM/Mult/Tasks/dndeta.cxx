@@ -21,6 +21,10 @@
 #include <TDatabasePDG.h>
 #include <TPDGCode.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "Index.h"
 #include "bestCollisionTable.h"
 
@@ -108,6 +112,7 @@ struct MultiplicityCounter {
   std::vector<int> usedTracksIdsDF;
   std::vector<int> usedTracksIdsDFMC;
   std::vector<int> usedTracksIdsDFMCEff;
+  std::vector<std::pair<int64_t, int64_t>> bcCollisions; // (BC index, collision row) sorted by BC
   void init(InitContext&)
   {
     AxisSpec MultAxis = {multBinning};
@@ -346,19 +351,25 @@ struct MultiplicityCounter {
   template <typename C>
   void processEventStatGeneral(FullBCs const& bcs, C const& collisions)
   {
+    // collisions of each BC, found once instead of looping over all the collisions for every BC
+    bcCollisions.clear();
+    int64_t row = 0;
+    for (auto& collision : collisions) {
+      bcCollisions.emplace_back(collision.has_foundBC() ? collision.foundBCId() : collision.bcId(), row++);
+    }
+    std::stable_sort(bcCollisions.begin(), bcCollisions.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+    auto bcCollision = bcCollisions.begin();
+
     std::vector<typename std::decay_t<decltype(collisions)>::iterator> cols;
     for (auto& bc : bcs) {
+      while (bcCollision != bcCollisions.end() && bcCollision->first < bc.globalIndex()) {
+        ++bcCollision;
+      }
       if (!useEvSel || isBCSelected(bc)) {
         commonRegistry.fill(HIST(BCSelection), 1.);
         cols.clear();
-        for (auto& collision : collisions) {
-          if (collision.has_foundBC()) {
-            if (collision.foundBCId() == bc.globalIndex()) {
-              cols.emplace_back(collision);
-            }
-          } else if (collision.bcId() == bc.globalIndex()) {
-            cols.emplace_back(collision);
-          }
+        for (auto it = bcCollision; it != bcCollisions.end() && it->first == bc.globalIndex(); ++it) {
+          cols.emplace_back(collisions.iteratorAt(it->second));
         }
         LOGP(debug, "BC {} has {} collisions", bc.globalBC(), cols.size());
         if (!cols.empty()) {
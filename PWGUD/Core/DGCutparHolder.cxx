@@ -133,5 +133,5 @@ bool DGCutparHolder::withTSC() const { return mTSC; }
 bool DGCutparHolder::withTCE() const { return mTCE; }
 bool DGCutparHolder::withTOR() const { return mTOR; }
 float DGCutparHolder::maxFITtime() const { return mMaxFITtime; }
-std::vector<float> DGCutparHolder::FITAmpLimits() const { return mFITAmpLimits; }
+const std::vector<float>& DGCutparHolder::FITAmpLimits() const { return mFITAmpLimits; }
 std::vector<int> DGCutparHolder::collisionSel() const { return mCollisionSel; }
@@ -93,7 +93,7 @@ class DGCutparHolder
   bool withTCE() const;
   bool withTOR() const;
   float maxFITtime() const;
-  std::vector<float> FITAmpLimits() const;
+  const std::vector<float>& FITAmpLimits() const;
   std::vector<int> collisionSel() const;
 
  private:
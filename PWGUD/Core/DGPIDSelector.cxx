@@ -283,6 +283,20 @@ DGParticle::DGParticle()
 {
 }
 
+DGParticle::DGParticle(std::vector<TLorentzVector> const& lvs, int nCombine, std::vector<int> comb)
+{
+  // loop over tracks and update mIVM, in the same order as the templated constructor
+  mIVM = TLorentzVector(0., 0., 0., 0.);
+  auto cnt = -1;
+  for (auto ind : comb) {
+    cnt++;
+    mIVM += lvs[ind * nCombine + cnt];
+  }
+
+  // set array of track indices
+  mtrkinds = comb;
+}
+
 DGParticle::~DGParticle()
 {
   mtrkinds.clear();
@@ -306,6 +320,7 @@ void DGParticle::Print()
 DGPIDSelector::DGPIDSelector()
 {
   fPDG = TDatabasePDG::Instance();
+  setAnaPars(mAnaPars);
 }
 
 DGPIDSelector::~DGPIDSelector()
@@ -323,11 +338,28 @@ void DGPIDSelector::Print()
 
 void DGPIDSelector::init(DGAnaparHolder anaPars)
 {
-  mAnaPars = anaPars;
+  setAnaPars(anaPars);
   mUnlikeIVMs.clear();
   mLikeIVMs.clear();
 }
 
+// -----------------------------------------------------------------------------
+void DGPIDSelector::setAnaPars(DGAnaparHolder anaPars)
+{
+  mAnaPars = anaPars;
+
+  // cache the parameters which are used per track and combination
+  mPIDs = mAnaPars.PIDs();
+  mMasses.clear();
+  for (auto pid : mPIDs) {
+    mMasses.push_back(particleMass(fPDG, pid));
+  }
+  mPIDCuts = mAnaPars.PIDCuts().Cuts();
+  mUnlikeCharges = mAnaPars.unlikeCharges();
+  mLikeCharges = mAnaPars.likeCharges();
+  mCombinations.clear();
+}
+
 // -----------------------------------------------------------------------------
 int DGPIDSelector::pid2ind(int pid)
 {
@@ -13,6 +13,7 @@
 #define PWGUD_CORE_DGPIDSELECTOR_H_
 
 #include <gandiva/projector.h>
+#include <map>
 #include <vector>
 #include <TVector3.h>
 #include "TDatabasePDG.h"
@@ -235,6 +236,8 @@ struct DGParticle {
     // set array of track indices
     mtrkinds = comb;
   }
+  // with the 4-vectors of the tracks for each particle of the combination, lvs[ind * nCombine + cnt]
+  DGParticle(std::vector<TLorentzVector> const& lvs, int nCombine, std::vector<int> comb);
   ~DGParticle();
 
   // getter
@@ -285,7 +288,7 @@ struct DGPIDSelector {
   bool isGoodTrack(TTrack track, int cnt)
   {
     // get pid of particle cnt
-    auto pid = mAnaPars.PIDs()[cnt];
+    auto pid = mPIDs[cnt];
 
     // unknown PID
     auto pidhypo = pid2ind(pid);
@@ -331,8 +334,7 @@ struct DGPIDSelector {
     }
 
     // loop over all PIDCuts and apply the ones which apply to this track
-    auto pidcuts = mAnaPars.PIDCuts().Cuts();
-    for (auto pidcut : pidcuts) {
+    for (auto& pidcut : mPIDCuts) {
 
       // skip cut if it does not apply to this track
       if (pidcut.nPart() != cnt || pidcut.cutApply() <= 0) {
@@ -404,17 +406,36 @@ struct DGPIDSelector {
     mUnlikeIVMs.clear();
     mLikeIVMs.clear();
 
-    // create combinations including permutations
-    auto combs = combinations(tracks.size());
+    // the PID requirements, charges and 4-vectors of each track and particle of the combination are computed once,
+    // instead of once per combination
+    const int nTracks = tracks.size();
+    const int nCombine = mAnaPars.nCombine();
+    mIsGoodTrack.assign(nTracks * nCombine, false);
+    mTrackSigns.resize(nTracks);
+    mTrackLVs.resize(nTracks * nCombine);
+    for (auto ind = 0; ind < nTracks; ind++) {
+      auto track = tracks.begin() + ind;
+      mTrackSigns[ind] = track.sign();
+      for (auto cnt = 0; cnt < nCombine; cnt++) {
+        mIsGoodTrack[ind * nCombine + cnt] = isGoodTrack(track, cnt);
+        mTrackLVs[ind * nCombine + cnt].SetXYZM(track.px(), track.py(), track.pz(), mMasses[cnt]);
+      }
+    }
+
+    // create combinations including permutations, once per number of tracks
+    auto combsIt = mCombinations.find(nTracks);
+    if (combsIt == mCombinations.end()) {
+      combsIt = mCombinations.emplace(nTracks, combinations(nTracks)).first;
+    }
 
     // loop over unique combinations
-    for (auto comb : combs) {
+    for (auto const& comb : combsIt->second) {
       // are tracks compatible with PID requirements?
       bool isGoodTracks = true;
       auto cnt = -1;
       for (auto ind : comb) {
         cnt++;
-        if (!isGoodTrack(tracks.begin() + ind, cnt)) {
+        if (!mIsGoodTrack[ind * nCombine + cnt]) {
           isGoodTracks = false;
           break;
         }
@@ -422,12 +443,21 @@ struct DGPIDSelector {
 
       // is combination compatible with netCharge requirements?
       if (isGoodTracks) {
-        DGParticle IVM(fPDG, mAnaPars, tracks, comb);
+        int netCharge = 0;
+        for (auto ind : comb) {
+          netCharge += mTrackSigns[ind];
+        }
+        bool isUnlike = std::find(mUnlikeCharges.begin(), mUnlikeCharges.end(), netCharge) != mUnlikeCharges.end();
+        bool isLike = std::find(mLikeCharges.begin(), mLikeCharges.end(), netCharge) != mLikeCharges.end();
+        if (!isUnlike && !isLike) {
+          continue;
+        }
+        DGParticle IVM(mTrackLVs, nCombine, comb);
         // unlike sign
-        if (isGoodCombination(comb, tracks, mAnaPars.unlikeCharges())) {
+        if (isUnlike) {
           mUnlikeIVMs.push_back(IVM);
         }
-        if (isGoodCombination(comb, tracks, mAnaPars.likeCharges())) {
+        if (isLike) {
           mLikeIVMs.push_back(IVM);
         }
       }
@@ -491,6 +521,23 @@ struct DGPIDSelector {
   // particle properties
   TDatabasePDG* fPDG;
 
+  // analysis parameters used per track, cached by setAnaPars
+  std::vector<int> mPIDs;
+  std::vector<float> mMasses;
+  std::vector<DGPIDCut> mPIDCuts;
+  std::vector<int> mUnlikeCharges;
+  std::vector<int> mLikeCharges;
+
+  // combinations including permutations per number of tracks
+  std::map<int, std::vector<std::vector<int>>> mCombinations;
+
+  // per track and particle of the combination, filled by computeIVMs
+  std::vector<bool> mIsGoodTrack;
+  std::vector<int> mTrackSigns;
+  std::vector<TLorentzVector> mTrackLVs;
+
+  void setAnaPars(DGAnaparHolder anaPars);
+
   // helper functions for computeIVMs
   void combinations(int n0, std::vector<int>& pool, int np, std::vector<int>& inds, int n,
                     std::vector<std::vector<int>>& combs);
@@ -87,4 +87,4 @@ float SGCutParHolder::maxPt() const { return mMaxPt; }
 float SGCutParHolder::minEta() const { return mMinEta; }
 float SGCutParHolder::maxEta() const { return mMaxEta; }
 float SGCutParHolder::maxFITtime() const { return mMaxFITtime; }
-std::vector<float> SGCutParHolder::FITAmpLimits() const { return mFITAmpLimits; }
+const std::vector<float>& SGCutParHolder::FITAmpLimits() const { return mFITAmpLimits; }
@@ -67,7 +67,7 @@ class SGCutParHolder
   float maxEta() const;
   float maxFITtime() const;
   float minRgtrwTOF() const;
-  std::vector<float> FITAmpLimits() const;
+  const std::vector<float>& FITAmpLimits() const;
 
  private:
   // number of collision time resolutions to consider
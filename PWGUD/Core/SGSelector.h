@@ -32,14 +32,14 @@ class SGSelector
   SGSelector() : fPDG(TDatabasePDG::Instance()) {}
 
   template <typename CC, typename BCs, typename TCs, typename FWs>
-  int Print(SGCutParHolder /*diffCuts*/, CC& collision, BCs& /*bcRange*/, TCs& /*tracks*/, FWs& /*fwdtracks*/)
+  int Print(SGCutParHolder const& /*diffCuts*/, CC& collision, BCs& /*bcRange*/, TCs& /*tracks*/, FWs& /*fwdtracks*/)
   {
     LOGF(info, "Size of array %i", collision.size());
     return 1;
   }
 
   template <typename CC, typename BCs, typename BC>
-  SelectionResult<BC> IsSelected(SGCutParHolder diffCuts, CC& collision, BCs& bcRange, BC& oldbc)
+  SelectionResult<BC> IsSelected(SGCutParHolder const& diffCuts, CC& collision, BCs& bcRange, BC& oldbc)
   {
     //        LOGF(info, "Collision %f", collision.collisionTime());
     //        LOGF(info, "Number of close BCs: %i", bcRange.size());
@@ -16,6 +16,7 @@
 #ifndef PWGUD_CORE_UDHELPERS_H_
 #define PWGUD_CORE_UDHELPERS_H_
 
+#include <algorithm>
 #include <vector>
 #include <bitset>
 #include "TLorentzVector.h"
@@ -103,6 +104,24 @@ float rPVtrwTOF(TCs tracks, int nPVTracks)
 template <typename T>
 T compatibleBCs(uint64_t meanBC, int deltaBC, T const& bcs);
 
+// Index of the first BC with globalBC >= bcnum, bcs.size() if there is none.
+// The BCs table is sorted in globalBC, hence a binary search is used.
+template <typename T>
+int64_t lowerBoundBC(uint64_t bcnum, T const& bcs)
+{
+  int64_t lo = 0;
+  int64_t hi = bcs.size();
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+    if (bcs.iteratorAt(mid).globalBC() < bcnum) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
 template <typename I, typename T>
 T compatibleBCs(I& bcIter, uint64_t meanBC, int deltaBC, T const& bcs);
 
@@ -203,7 +222,10 @@ template <typename T>
 T compatibleBCs(uint64_t meanBC, int deltaBC, T const& bcs)
 {
   // find BC with globalBC ~ meanBC
-  uint64_t ind = (uint64_t)(bcs.size() / 2);
+  if (bcs.size() == 0) {
+    return T{{bcs.asArrowTable()->Slice(0, 0)}, (uint64_t)0};
+  }
+  auto ind = std::min(lowerBoundBC(meanBC, bcs), static_cast<int64_t>(bcs.size()) - 1);
   auto bcIter = bcs.iteratorAt(ind);
 
   return compatibleBCs(bcIter, meanBC, deltaBC, bcs);
@@ -322,16 +344,16 @@ float FT0AmplitudeC(TFT0 ft0)
 template <typename TFDD>
 float FDDAmplitudeA(TFDD fdd)
 {
-  std::vector<int16_t> ampsA(fdd.chargeA(), fdd.chargeA() + 8);
-  return std::accumulate(ampsA.begin(), ampsA.end(), 0);
+  const auto* ampsA = fdd.chargeA();
+  return std::accumulate(ampsA, ampsA + 8, 0);
 }
 
 // -----------------------------------------------------------------------------
 template <typename TFDD>
 float FDDAmplitudeC(TFDD fdd)
 {
-  std::vector<int16_t> ampsC(fdd.chargeC(), fdd.chargeC() + 8);
-  return std::accumulate(ampsC.begin(), ampsC.end(), 0);
+  const auto* ampsC = fdd.chargeC();
+  return std::accumulate(ampsC, ampsC + 8, 0);
 }
 
 // -----------------------------------------------------------------------------
@@ -424,14 +446,14 @@ bool cleanFDD(T& bc, float maxFITtime, float limitA, float limitC)
 //  lims[4]: FDDC
 
 template <typename T>
-bool cleanFIT(T& bc, float maxFITtime, std::vector<float> lims)
+bool cleanFIT(T& bc, float maxFITtime, std::vector<float> const& lims)
 {
   return cleanFV0(bc, maxFITtime, lims[0]) &&
          cleanFT0(bc, maxFITtime, lims[1], lims[2]) &&
          cleanFDD(bc, maxFITtime, lims[3], lims[4]);
 }
 template <typename T>
-bool cleanFITCollision(T& col, float maxFITtime, std::vector<float> lims)
+bool cleanFITCollision(T& col, float maxFITtime, std::vector<float> const& lims)
 {
   bool isCleanFV0 = true;
   if (col.has_foundFV0()) {
@@ -452,7 +474,7 @@ bool cleanFITCollision(T& col, float maxFITtime, std::vector<float> lims)
 
 // -----------------------------------------------------------------------------
 template <typename T>
-bool cleanFITA(T& bc, float maxFITtime, std::vector<float> lims)
+bool cleanFITA(T& bc, float maxFITtime, std::vector<float> const& lims)
 {
   return cleanFV0(bc, maxFITtime, lims[0]) &&
          cleanFT0A(bc, maxFITtime, lims[1]) &&
@@ -461,7 +483,7 @@ bool cleanFITA(T& bc, float maxFITtime, std::vector<float> lims)
 
 // -----------------------------------------------------------------------------
 template <typename T>
-bool cleanFITC(T& bc, float maxFITtime, std::vector<float> lims)
+bool cleanFITC(T& bc, float maxFITtime, std::vector<float> const& lims)
 {
   return cleanFT0C(bc, maxFITtime, lims[2]) &&
          cleanFDDC(bc, maxFITtime, lims[4]);
@@ -505,7 +527,7 @@ bool TCE(T& bc)
 
 // -----------------------------------------------------------------------------
 template <typename T>
-bool TOR(T& bc, float maxFITtime, std::vector<float> lims)
+bool TOR(T& bc, float maxFITtime, std::vector<float> const& lims)
 {
   auto torA = !cleanFT0A(bc, maxFITtime, lims[1]);
   auto torC = !cleanFT0C(bc, maxFITtime, lims[2]);
@@ -680,12 +702,11 @@ template <typename B>
 void getFITinfo(upchelpers::FITInfo& info, uint64_t const& bcnum, B const& bcs, aod::FT0s const& ft0s, aod::FV0As const& fv0as, aod::FDDs const& fdds)
 {
   // find bc with globalBC = bcnum
-  Partition<B> selbc = aod::bc::globalBC == bcnum;
-  selbc.bindTable(bcs);
+  auto ind = lowerBoundBC(bcnum, bcs);
 
   // if BC exists then update FIT information for this BC
-  if (selbc.size() > 0) {
-    auto bc = selbc.begin();
+  if (ind < bcs.size() && bcs.iteratorAt(ind).globalBC() == bcnum) {
+    auto bc = bcs.iteratorAt(ind);
 
     // FV0A
     if (bc.has_foundFV0()) {
@@ -719,8 +740,13 @@ void getFITinfo(upchelpers::FITInfo& info, uint64_t const& bcnum, B const& bcs,
   // fill BG and BB flags
   auto minbc = bcnum - 16;
   auto maxbc = bcnum + 15;
-  Partition<B> bcrange = aod::bc::globalBC >= minbc && aod::bc::globalBC <= maxbc;
-  bcrange.bindTable(bcs);
+  auto minBCId = lowerBoundBC(minbc, bcs);
+  auto maxBCId = minBCId;
+  while (maxBCId < bcs.size() && bcs.iteratorAt(maxBCId).globalBC() <= maxbc) {
+    ++maxBCId;
+  }
+  B bcrange{{bcs.asArrowTable()->Slice(minBCId, maxBCId - minBCId)}, (uint64_t)minBCId};
+  bcs.copyIndexBindings(bcrange);
   fillBGBBFlags(info, minbc, bcrange);
 }
 
@@ -277,6 +277,23 @@ struct DGBCCandProducer {
   Preslice<TCs> TCperCollision = aod::track::collisionId;
   Preslice<aod::FwdTracks> FWperCollision = aod::fwdtrack::collisionId;
 
+  // FwdTracksWGTInBCs is filled in increasing bcnum, find the entry with a given bcnum with a binary search
+  // returns -1 if there is none
+  int64_t findFTIBC(uint64_t bcnum, FTIBCs const& ftibcs)
+  {
+    int64_t lo = 0;
+    int64_t hi = ftibcs.size();
+    while (lo < hi) {
+      auto mid = lo + (hi - lo) / 2;
+      if (ftibcs.iteratorAt(mid).bcnum() < bcnum) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return (lo < ftibcs.size() && ftibcs.iteratorAt(lo).bcnum() == bcnum) ? lo : -1;
+  }
+
   // update UDTables
   template <typename TTracks>
   void updateUDTables(bool onlyPV, int64_t colID, uint64_t bcnum, int rnum, float vx, float vy, float vz,
@@ -425,18 +442,10 @@ struct DGBCCandProducer {
         auto bcRange = udhelpers::compatibleBCs(bc, bc.globalBC(), diffCuts.minNBCs(), bcs);
 
         // does BC have fwdTracks?
-        if (ftibcs.size() > 0) {
-          Partition<FTIBCs> ftibcSlice = aod::dgbcandidate::bcId == bc.globalIndex();
-          ftibcSlice.bindTable(ftibcs);
-
-          if (ftibcSlice.size() > 0) {
-            ftibcSlice.bindExternalIndices(&fwdtracks);
-            auto fwdTracksArray = ftibcSlice.begin().fwdtrack_as<FTCs>();
-            isDG = dgSelector.IsSelected(diffCuts, bcRange, tracksArray, fwdTracksArray);
-          } else {
-            auto fwdTracksArray = FTCs{{fwdtracks.asArrowTable()->Slice(0, 0)}, (uint64_t)0};
-            isDG = dgSelector.IsSelected(diffCuts, bcRange, tracksArray, fwdTracksArray);
-          }
+        auto ftibcId = findFTIBC(bc.globalBC(), ftibcs);
+        if (ftibcId >= 0) {
+          auto fwdTracksArray = ftibcs.iteratorAt(ftibcId).fwdtrack_as<FTCs>();
+          isDG = dgSelector.IsSelected(diffCuts, bcRange, tracksArray, fwdTracksArray);
         } else {
           auto fwdTracksArray = FTCs{{fwdtracks.asArrowTable()->Slice(0, 0)}, (uint64_t)0};
           isDG = dgSelector.IsSelected(diffCuts, bcRange, tracksArray, fwdTracksArray);
@@ -471,18 +480,10 @@ struct DGBCCandProducer {
       auto bcRange = udhelpers::compatibleBCs(bcnum, diffCuts.minNBCs(), bcs);
 
       // does BC have fwdTracks?
-      if (ftibcs.size() > 0) {
-        Partition<FTIBCs> ftibcPart = aod::dgbcandidate::bcnum == bcnum;
-        ftibcPart.bindTable(ftibcs);
-
-        if (ftibcPart.size() > 0) {
-          ftibcPart.bindExternalIndices(&fwdtracks);
-          auto fwdTracksArray = ftibcPart.begin().fwdtrack_as<FTCs>();
-          isDG = dgSelector.IsSelected(diffCuts, bcRange, tracksArray, fwdTracksArray);
-        } else {
-          auto fwdTracksArray = FTCs{{fwdtracks.asArrowTable()->Slice(0, 0)}, (uint64_t)0};
-          isDG = dgSelector.IsSelected(diffCuts, bcRange, tracksArray, fwdTracksArray);
-        }
+      auto ftibcId = findFTIBC(bcnum, ftibcs);
+      if (ftibcId >= 0) {
+        auto fwdTracksArray = ftibcs.iteratorAt(ftibcId).fwdtrack_as<FTCs>();
+        isDG = dgSelector.IsSelected(diffCuts, bcRange, tracksArray, fwdTracksArray);
       } else {
         auto fwdTracksArray = FTCs{{fwdtracks.asArrowTable()->Slice(0, 0)}, (uint64_t)0};
         isDG = dgSelector.IsSelected(diffCuts, bcRange, tracksArray, fwdTracksArray);
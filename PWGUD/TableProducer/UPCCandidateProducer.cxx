@@ -98,6 +98,8 @@ struct UpcCandProducer {
                                      o2::aod::pidTOFFullEl, o2::aod::pidTOFFullMu, o2::aod::pidTOFFullPi, o2::aod::pidTOFFullKa, o2::aod::pidTOFFullPr>;
 
   typedef std::pair<uint64_t, std::vector<int64_t>> BCTracksPair;
+  // global BC and row index in a FIT/ZDC table, kept in vectors sorted by BC
+  typedef std::pair<uint64_t, int32_t> BCIndexPair;
 
   void init(InitContext&)
   {
@@ -215,17 +217,52 @@ struct UpcCandProducer {
     return true;
   }
 
-  auto findClosestBC(uint64_t globalBC, std::map<uint64_t, int32_t>& bcs)
+  // sorts the (BC, row) pairs filled in table order and keeps one row per BC, the last one as an assignment to a map would do
+  void sortBCIndices(std::vector<BCIndexPair>& bcs)
   {
-    auto it = bcs.lower_bound(globalBC);
-    auto bc1 = it->first;
+    auto lessBC = [](const BCIndexPair& left, const BCIndexPair& right) { return left.first < right.first; };
+    if (!std::is_sorted(bcs.begin(), bcs.end(), lessBC))
+      std::stable_sort(bcs.begin(), bcs.end(), lessBC);
+    auto out = bcs.begin();
+    for (auto it = bcs.begin(); it != bcs.end(); ++it) {
+      if (out != bcs.begin() && std::prev(out)->first == it->first)
+        *std::prev(out) = *it;
+      else
+        *out++ = *it;
+    }
+    bcs.erase(out, bcs.end());
+  }
+
+  auto lowerBoundBC(uint64_t globalBC, const std::vector<BCIndexPair>& bcs)
+  {
+    return std::lower_bound(bcs.begin(), bcs.end(), globalBC,
+                            [](const BCIndexPair& p, uint64_t bc) {
+                              return p.first < bc;
+                            });
+  }
+
+  // returns the pair with the given BC or end()
+  auto findBC(uint64_t globalBC, const std::vector<BCIndexPair>& bcs)
+  {
+    auto it = lowerBoundBC(globalBC, bcs);
+    return (it != bcs.end() && it->first == globalBC) ? it : bcs.end();
+  }
+
+  // returns the pair with the BC closest to globalBC, bcs must not be empty
+  auto findClosestBC(uint64_t globalBC, const std::vector<BCIndexPair>& bcs)
+  {
+    auto it = lowerBoundBC(globalBC, bcs);
+    if (it == bcs.end())
+      --it;
+    auto it1 = it;
     if (it != bcs.begin())
       --it;
-    auto bc2 = it->first;
+    auto it2 = it;
+    auto bc1 = it1->first;
+    auto bc2 = it2->first;
     auto dbc1 = bc1 >= globalBC ? bc1 - globalBC : globalBC - bc1;
     auto dbc2 = bc2 >= globalBC ? bc2 - globalBC : globalBC - bc2;
-    auto bc = (dbc1 <= dbc2) ? bc1 : bc2;
-    return bc;
+    return (dbc1 <= dbc2) ? it1 : it2;
   }
 
   auto findClosestTrackBCiter(uint64_t globalBC, std::vector<BCTracksPair>& bcs)
@@ -749,16 +786,16 @@ struct UpcCandProducer {
     std::sort(bcsMatchedTrIdsITSTPC.begin(), bcsMatchedTrIdsITSTPC.end(),
               [](const auto& left, const auto& right) { return left.first < right.first; });
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithTOR{};
-    std::map<uint64_t, int32_t> mapGlobalBcWithTVX{};
-    std::map<uint64_t, int32_t> mapGlobalBcWithTSC{};
+    std::vector<BCIndexPair> mapGlobalBcWithTOR{};
+    std::vector<BCIndexPair> mapGlobalBcWithTVX{};
+    std::vector<BCIndexPair> mapGlobalBcWithTSC{};
     for (const auto& ft0 : ft0s) {
       uint64_t globalBC = ft0.bc_as<o2::aod::BCs>().globalBC();
       int32_t globalIndex = ft0.globalIndex();
       if (!(std::abs(ft0.timeA()) > 2.f && std::abs(ft0.timeC()) > 2.f))
-        mapGlobalBcWithTOR[globalBC] = globalIndex;
+        mapGlobalBcWithTOR.emplace_back(globalBC, globalIndex);
       if (TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitVertex)) { // TVX
-        mapGlobalBcWithTVX[globalBC] = globalIndex;
+        mapGlobalBcWithTVX.emplace_back(globalBC, globalIndex);
       }
       if (TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitCen)) { // TVX & TCE
         histRegistry.get<TH1>(HIST("hCountersTrg"))->Fill("TCE", 1);
@@ -766,19 +803,19 @@ struct UpcCandProducer {
       if (TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitVertex) &&
           (TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitCen) ||
            TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitSCen))) { // TVX & (TSC | TCE)
-        mapGlobalBcWithTSC[globalBC] = globalIndex;
+        mapGlobalBcWithTSC.emplace_back(globalBC, globalIndex);
       }
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithV0A{};
+    std::vector<BCIndexPair> mapGlobalBcWithV0A{};
     for (const auto& fv0a : fv0as) {
       if (std::abs(fv0a.time()) > 15.f)
         continue;
       uint64_t globalBC = fv0a.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithV0A[globalBC] = fv0a.globalIndex();
+      mapGlobalBcWithV0A.emplace_back(globalBC, fv0a.globalIndex());
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithZdc{};
+    std::vector<BCIndexPair> mapGlobalBcWithZdc{};
     for (const auto& zdc : zdcs) {
       if (std::abs(zdc.timeZNA()) > 2.f && std::abs(zdc.timeZNC()) > 2.f)
         continue;
@@ -787,9 +824,15 @@ struct UpcCandProducer {
       if (!(std::abs(zdc.timeZNC()) > 2.f))
         histRegistry.get<TH1>(HIST("hCountersTrg"))->Fill("ZNC", 1);
       auto globalBC = zdc.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithZdc[globalBC] = zdc.globalIndex();
+      mapGlobalBcWithZdc.emplace_back(globalBC, zdc.globalIndex());
     }
 
+    sortBCIndices(mapGlobalBcWithTOR);
+    sortBCIndices(mapGlobalBcWithTVX);
+    sortBCIndices(mapGlobalBcWithTSC);
+    sortBCIndices(mapGlobalBcWithV0A);
+    sortBCIndices(mapGlobalBcWithZdc);
+
     auto nTORs = mapGlobalBcWithTOR.size();
     auto nTSCs = mapGlobalBcWithTSC.size();
     auto nTVXs = mapGlobalBcWithTVX.size();
@@ -818,11 +861,12 @@ struct UpcCandProducer {
       fitInfo.distClosestBcTVX = 999;
       fitInfo.distClosestBcV0A = 999;
       if (nTORs > 0) {
-        uint64_t closestBcTOR = findClosestBC(globalBC, mapGlobalBcWithTOR);
+        auto itClosestBcTOR = findClosestBC(globalBC, mapGlobalBcWithTOR);
+        uint64_t closestBcTOR = itClosestBcTOR->first;
         fitInfo.distClosestBcTOR = globalBC - static_cast<int64_t>(closestBcTOR);
         if (std::abs(fitInfo.distClosestBcTOR) <= fFilterFT0)
           return false;
-        auto ft0Id = mapGlobalBcWithTOR.at(closestBcTOR);
+        auto ft0Id = itClosestBcTOR->second;
         auto ft0 = ft0s.iteratorAt(ft0Id);
         fitInfo.timeFT0A = ft0.timeA();
         fitInfo.timeFT0C = ft0.timeC();
@@ -834,23 +878,26 @@ struct UpcCandProducer {
           fitInfo.ampFT0C += amp;
       }
       if (nTSCs > 0) {
-        uint64_t closestBcTSC = findClosestBC(globalBC, mapGlobalBcWithTSC);
+        auto itClosestBcTSC = findClosestBC(globalBC, mapGlobalBcWithTSC);
+        uint64_t closestBcTSC = itClosestBcTSC->first;
         fitInfo.distClosestBcTSC = globalBC - static_cast<int64_t>(closestBcTSC);
         if (std::abs(fitInfo.distClosestBcTSC) <= fFilterTSC)
           return false;
       }
       if (nTVXs > 0) {
-        uint64_t closestBcTVX = findClosestBC(globalBC, mapGlobalBcWithTVX);
+        auto itClosestBcTVX = findClosestBC(globalBC, mapGlobalBcWithTVX);
+        uint64_t closestBcTVX = itClosestBcTVX->first;
         fitInfo.distClosestBcTVX = globalBC - static_cast<int64_t>(closestBcTVX);
         if (std::abs(fitInfo.distClosestBcTVX) <= fFilterTVX)
           return false;
       }
       if (nFV0As > 0) {
-        uint64_t closestBcV0A = findClosestBC(globalBC, mapGlobalBcWithV0A);
+        auto itClosestBcV0A = findClosestBC(globalBC, mapGlobalBcWithV0A);
+        uint64_t closestBcV0A = itClosestBcV0A->first;
         fitInfo.distClosestBcV0A = globalBC - static_cast<int64_t>(closestBcV0A);
         if (std::abs(fitInfo.distClosestBcV0A) <= fFilterFV0)
           return false;
-        auto fv0aId = mapGlobalBcWithV0A.at(closestBcV0A);
+        auto fv0aId = itClosestBcV0A->second;
         auto fv0a = fv0as.iteratorAt(fv0aId);
         fitInfo.timeFV0A = fv0a.time();
         const auto& v0Amps = fv0a.amplitude();
@@ -889,7 +936,7 @@ struct UpcCandProducer {
       if (!updateFitInfo(globalBC, fitInfo))
         continue;
       if (nZdcs > 0) {
-        auto itZDC = mapGlobalBcWithZdc.find(globalBC);
+        auto itZDC = findBC(globalBC, mapGlobalBcWithZdc);
         if (itZDC != mapGlobalBcWithZdc.end()) {
           const auto& zdc = zdcs.iteratorAt(itZDC->second);
           float timeZNA = zdc.timeZNA();
@@ -954,7 +1001,7 @@ struct UpcCandProducer {
       if (!updateFitInfo(globalBC, fitInfo))
         continue;
       if (nZdcs > 0) {
-        auto itZDC = mapGlobalBcWithZdc.find(globalBC);
+        auto itZDC = findBC(globalBC, mapGlobalBcWithZdc);
         if (itZDC != mapGlobalBcWithZdc.end()) {
           const auto& zdc = zdcs.iteratorAt(itZDC->second);
           float timeZNA = zdc.timeZNA();
@@ -1173,15 +1220,15 @@ struct UpcCandProducer {
 
   template <typename T>
   void fillAmplitudes(const T& t,
-                      const std::map<uint64_t, int32_t>& mapBCs,
+                      const std::vector<BCIndexPair>& mapBCs,
                       std::vector<float>& amps,
                       std::vector<int8_t>& relBCs,
                       int64_t gbc)
   {
     auto s = gbc - fBCWindowFITAmps;
     auto e = gbc + (fBCWindowFITAmps - 1);
-    auto it = mapBCs.lower_bound(s);
-    while (it->first <= e && it != mapBCs.end()) {
+    auto it = lowerBoundBC(s, mapBCs);
+    while (it != mapBCs.end() && it->first <= static_cast<uint64_t>(e)) {
       int i = it->first - s;
       auto id = it->second;
       const auto& row = t.iteratorAt(id);
@@ -1237,7 +1284,7 @@ struct UpcCandProducer {
     std::sort(bcsMatchedTrIdsMCH.begin(), bcsMatchedTrIdsMCH.end(),
               [](const auto& left, const auto& right) { return left.first < right.first; });
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithT0A{};
+    std::vector<BCIndexPair> mapGlobalBcWithT0A{};
     for (const auto& ft0 : ft0s) {
       if (!TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitVertex))
         continue;
@@ -1247,20 +1294,20 @@ struct UpcCandProducer {
       if (std::abs(ft0.timeA()) > 2.f)
         continue;
       uint64_t globalBC = ft0.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithT0A[globalBC] = ft0.globalIndex();
+      mapGlobalBcWithT0A.emplace_back(globalBC, ft0.globalIndex());
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithV0A{};
+    std::vector<BCIndexPair> mapGlobalBcWithV0A{};
     for (const auto& fv0a : fv0as) {
       if (!TESTBIT(fv0a.triggerMask(), o2::fit::Triggers::bitA))
         continue;
       if (std::abs(fv0a.time()) > 15.f)
         continue;
       uint64_t globalBC = fv0a.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithV0A[globalBC] = fv0a.globalIndex();
+      mapGlobalBcWithV0A.emplace_back(globalBC, fv0a.globalIndex());
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithZdc{};
+    std::vector<BCIndexPair> mapGlobalBcWithZdc{};
     for (const auto& zdc : zdcs) {
       if (std::abs(zdc.timeZNA()) > 2.f && std::abs(zdc.timeZNC()) > 2.f)
         continue;
@@ -1269,9 +1316,13 @@ struct UpcCandProducer {
       if (!(std::abs(zdc.timeZNC()) > 2.f))
         histRegistry.get<TH1>(HIST("hCountersTrg"))->Fill("ZNC", 1);
       auto globalBC = zdc.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithZdc[globalBC] = zdc.globalIndex();
+      mapGlobalBcWithZdc.emplace_back(globalBC, zdc.globalIndex());
     }
 
+    sortBCIndices(mapGlobalBcWithT0A);
+    sortBCIndices(mapGlobalBcWithV0A);
+    sortBCIndices(mapGlobalBcWithZdc);
+
     auto nFT0s = mapGlobalBcWithT0A.size();
     auto nFV0As = mapGlobalBcWithV0A.size();
     auto nZdcs = mapGlobalBcWithZdc.size();
@@ -1325,12 +1376,13 @@ struct UpcCandProducer {
       std::vector<int8_t> relBCsT0A{};
       std::vector<int8_t> relBCsV0A{};
       if (nFT0s > 0) {
-        uint64_t closestBcT0A = findClosestBC(globalBC, mapGlobalBcWithT0A);
+        auto itClosestBcT0A = findClosestBC(globalBC, mapGlobalBcWithT0A);
+        uint64_t closestBcT0A = itClosestBcT0A->first;
         int64_t distClosestBcT0A = globalBC - static_cast<int64_t>(closestBcT0A);
         if (std::abs(distClosestBcT0A) <= fFilterFT0)
           continue;
         fitInfo.distClosestBcT0A = distClosestBcT0A;
-        auto ft0Id = mapGlobalBcWithT0A.at(closestBcT0A);
+        auto ft0Id = itClosestBcT0A->second;
         auto ft0 = ft0s.iteratorAt(ft0Id);
         fitInfo.timeFT0A = ft0.timeA();
         fitInfo.timeFT0C = ft0.timeC();
@@ -1341,12 +1393,13 @@ struct UpcCandProducer {
         fillAmplitudes(ft0s, mapGlobalBcWithT0A, amplitudesT0A, relBCsT0A, globalBC);
       }
       if (nFV0As > 0) {
-        uint64_t closestBcV0A = findClosestBC(globalBC, mapGlobalBcWithV0A);
+        auto itClosestBcV0A = findClosestBC(globalBC, mapGlobalBcWithV0A);
+        uint64_t closestBcV0A = itClosestBcV0A->first;
         int64_t distClosestBcV0A = globalBC - static_cast<int64_t>(closestBcV0A);
         if (std::abs(distClosestBcV0A) <= fFilterFV0)
           continue;
         fitInfo.distClosestBcV0A = distClosestBcV0A;
-        auto fv0aId = mapGlobalBcWithV0A.at(closestBcV0A);
+        auto fv0aId = itClosestBcV0A->second;
         auto fv0a = fv0as.iteratorAt(fv0aId);
         fitInfo.timeFV0A = fv0a.time();
         const auto& v0Amps = fv0a.amplitude();
@@ -1354,7 +1407,7 @@ struct UpcCandProducer {
         fillAmplitudes(fv0as, mapGlobalBcWithV0A, amplitudesV0A, relBCsV0A, globalBC);
       }
       if (nZdcs > 0) {
-        auto itZDC = mapGlobalBcWithZdc.find(globalBC);
+        auto itZDC = findBC(globalBC, mapGlobalBcWithZdc);
         if (itZDC != mapGlobalBcWithZdc.end()) {
           const auto& zdc = zdcs.iteratorAt(itZDC->second);
           float timeZNA = zdc.timeZNA();
@@ -1445,7 +1498,7 @@ struct UpcCandProducer {
     std::sort(bcsMatchedTrIdsGlobal.begin(), bcsMatchedTrIdsGlobal.end(),
               [](const auto& left, const auto& right) { return left.first < right.first; });
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithT0A{};
+    std::vector<BCIndexPair> mapGlobalBcWithT0A{};
     for (const auto& ft0 : ft0s) {
       if (!TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitVertex))
         continue;
@@ -1455,20 +1508,20 @@ struct UpcCandProducer {
       if (std::abs(ft0.timeA()) > 2.f)
         continue;
       uint64_t globalBC = ft0.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithT0A[globalBC] = ft0.globalIndex();
+      mapGlobalBcWithT0A.emplace_back(globalBC, ft0.globalIndex());
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithV0A{};
+    std::vector<BCIndexPair> mapGlobalBcWithV0A{};
     for (const auto& fv0a : fv0as) {
       if (!TESTBIT(fv0a.triggerMask(), o2::fit::Triggers::bitA))
         continue;
       if (std::abs(fv0a.time()) > 15.f)
         continue;
       uint64_t globalBC = fv0a.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithV0A[globalBC] = fv0a.globalIndex();
+      mapGlobalBcWithV0A.emplace_back(globalBC, fv0a.globalIndex());
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithZdc{};
+    std::vector<BCIndexPair> mapGlobalBcWithZdc{};
     for (const auto& zdc : zdcs) {
       if (std::abs(zdc.timeZNA()) > 2.f && std::abs(zdc.timeZNC()) > 2.f)
         continue;
@@ -1477,9 +1530,13 @@ struct UpcCandProducer {
       if (!(std::abs(zdc.timeZNC()) > 2.f))
         histRegistry.get<TH1>(HIST("hCountersTrg"))->Fill("ZNC", 1);
       auto globalBC = zdc.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithZdc[globalBC] = zdc.globalIndex();
+      mapGlobalBcWithZdc.emplace_back(globalBC, zdc.globalIndex());
     }
 
+    sortBCIndices(mapGlobalBcWithT0A);
+    sortBCIndices(mapGlobalBcWithV0A);
+    sortBCIndices(mapGlobalBcWithZdc);
+
     auto nFT0s = mapGlobalBcWithT0A.size();
     auto nFV0As = mapGlobalBcWithV0A.size();
     auto nZdcs = mapGlobalBcWithZdc.size();
@@ -1520,12 +1577,13 @@ struct UpcCandProducer {
       std::vector<int8_t> relBCsT0A{};
       std::vector<int8_t> relBCsV0A{};
       if (nFT0s > 0) {
-        uint64_t closestBcT0A = findClosestBC(globalBC, mapGlobalBcWithT0A);
+        auto itClosestBcT0A = findClosestBC(globalBC, mapGlobalBcWithT0A);
+        uint64_t closestBcT0A = itClosestBcT0A->first;
         int64_t distClosestBcT0A = globalBC - static_cast<int64_t>(closestBcT0A);
         if (std::abs(distClosestBcT0A) <= fFilterFT0)
           continue;
         fitInfo.distClosestBcT0A = distClosestBcT0A;
-        auto ft0Id = mapGlobalBcWithT0A.at(closestBcT0A);
+        auto ft0Id = itClosestBcT0A->second;
         auto ft0 = ft0s.iteratorAt(ft0Id);
         fitInfo.timeFT0A = ft0.timeA();
         fitInfo.timeFT0C = ft0.timeC();
@@ -1536,12 +1594,13 @@ struct UpcCandProducer {
         fillAmplitudes(ft0s, mapGlobalBcWithT0A, amplitudesT0A, relBCsT0A, globalBC);
       }
       if (nFV0As > 0) {
-        uint64_t closestBcV0A = findClosestBC(globalBC, mapGlobalBcWithV0A);
+        auto itClosestBcV0A = findClosestBC(globalBC, mapGlobalBcWithV0A);
+        uint64_t closestBcV0A = itClosestBcV0A->first;
         int64_t distClosestBcV0A = globalBC - static_cast<int64_t>(closestBcV0A);
         if (std::abs(distClosestBcV0A) <= fFilterFV0)
           continue;
         fitInfo.distClosestBcV0A = distClosestBcV0A;
-        auto fv0aId = mapGlobalBcWithV0A.at(closestBcV0A);
+        auto fv0aId = itClosestBcV0A->second;
         auto fv0a = fv0as.iteratorAt(fv0aId);
         fitInfo.timeFV0A = fv0a.time();
         const auto& v0Amps = fv0a.amplitude();
@@ -1549,7 +1608,7 @@ struct UpcCandProducer {
         fillAmplitudes(fv0as, mapGlobalBcWithV0A, amplitudesV0A, relBCsV0A, globalBC);
       }
       if (nZdcs > 0) {
-        auto itZDC = mapGlobalBcWithZdc.find(globalBC);
+        auto itZDC = findBC(globalBC, mapGlobalBcWithZdc);
         if (itZDC != mapGlobalBcWithZdc.end()) {
           const auto& zdc = zdcs.iteratorAt(itZDC->second);
           float timeZNA = zdc.timeZNA();
@@ -74,7 +74,7 @@ struct DGCandAnalyzer {
 
   // a function to fill 2Prong histograms
   template <typename TTrack>
-  void fillSignalHists(DGParticle ivm, TTrack const& dgtracks, DGPIDSelector pidsel)
+  void fillSignalHists(DGParticle ivm, TTrack const& dgtracks, DGPIDSelector& pidsel)
   {
     // process only events with 2 tracks
     if (ivm.trkinds().size() != 2) {
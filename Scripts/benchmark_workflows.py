@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+
+# Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+# See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+# All rights not expressly granted are reserved.
+#
+# This software is distributed under the terms of the GNU General Public
+# License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+#
+# In applying this license CERN does not waive the privileges and immunities
+# granted to it by virtue of its status as an Intergovernmental Organization
+# or submit itself to any jurisdiction.
+
+"""
+Script to measure the throughput of standard analysis chains on a reference AO2D file.
+Each chain (list of workflows and optional DPL configuration, see benchmark_chains.json)
+is run in its own directory with the same fixed DPL options, and the script reports:
+- the wall time and the number of collisions per second,
+- the CPU time and the peak RSS of the workflow processes,
+- the CPU time and the peak memory of each device, from the DPL resources monitoring.
+The results can be written to a JSON file, to compare releases.
+Example:
+    benchmark_workflows.py --aod AO2D.root --chains benchmark_chains.json --output results.json
+"""
+
+import argparse
+import json
+import os
+import resource
+import shlex
+import subprocess
+import sys
+import time
+
+DIR_THIS = os.path.dirname(os.path.realpath(__file__))
+
+# DPL options common to all the chains, so that the measurements are comparable
+DEFAULT_OPTIONS = (
+    "-b --aod-memory-rate-limit 2000000000 --shm-segment-size 16000000000 "
+    "--readers 1 --resources-monitoring 1 --min-failure-level error"
+)
+
+
+def count_collisions(aod):
+    """
+    Counts the collisions in an AO2D file (sum over the data frames), None if ROOT is not available
+    """
+    try:
+        import ROOT  # pylint: disable=import-outside-toplevel
+    except ImportError:
+        return None
+    file = ROOT.TFile.Open(aod)
+    if not file or file.IsZombie():
+        return None
+    n_collisions = 0
+    for key in file.GetListOfKeys():
+        if not key.GetName().startswith("DF_"):
+            continue
+        directory = key.ReadObj()
+        for tree_key in directory.GetListOfKeys():
+            name = tree_key.GetName()
+            if name.startswith("O2collision") and not name.startswith("O2collisionextra"):
+                n_collisions += tree_key.ReadObj().GetEntries()
+                break
+    file.Close()
+    return n_collisions
+
+
+def parse_resources(path):
+    """
+    Summarises the DPL resources monitoring (performanceMetrics.json) per device:
+    CPU time (sum of the absolute CPU usage samples) and peak memory (maximum of the memory samples)
+    """
+    if not os.path.isfile(path):
+        return {}
+    with open(path, encoding="utf-8") as file:
+        metrics = json.load(file)
+    devices = {}
+    for device, device_metrics in metrics.items():
+        if not isinstance(device_metrics, dict):
+            continue
+        cpu = 0.0
+        memory = 0.0
+        for name, samples in device_metrics.items():
+            if not isinstance(samples, list):
+                continue
+            values = [float(s["value"]) for s in samples if isinstance(s, dict) and "value" in s]
+            if not values:
+                continue
+            if name == "cpuUsageAbsolute":
+                cpu += sum(values)
+            elif name in ("proportionalSetSize", "residentSetSize") or "memory" in name.lower():
+                memory = max(memory, max(values))
+        devices[device] = {"cpu": cpu, "peak_memory": memory}
+    return devices
+
+
+def run_chain(chain, aod, options, work_dir, config=None):
+    """
+    Runs the workflows of a chain as one DPL topology and returns its measurements
+    """
+    os.makedirs(work_dir, exist_ok=True)
+    chain_options = f"{options} --aod-file {shlex.quote(os.path.realpath(aod))}"
+    config = config or chain.get("config")
+    if config:
+        if not os.path.isabs(config):
+            config = os.path.join(DIR_THIS, config)
+        chain_options += f" --configuration json://{shlex.quote(config)}"
+    command = " | ".join(f"{workflow} {chain_options}" for workflow in chain["workflows"])
+    usage_before = resource.getrusage(resource.RUSAGE_CHILDREN)
+    start = time.monotonic()
+    with open(os.path.join(work_dir, "stdout.log"), "w", encoding="utf-8") as log:
+        rc = subprocess.run(
+            command, shell=True, cwd=work_dir, stdout=log, stderr=subprocess.STDOUT, check=False
+        ).returncode
+    wall = time.monotonic() - start
+    usage_after = resource.getrusage(resource.RUSAGE_CHILDREN)
+    return {
+        "name": chain["name"],
+        "return_code": rc,
+        "wall_s": wall,
+        "cpu_s": (usage_after.ru_utime - usage_before.ru_utime) + (usage_after.ru_stime - usage_before.ru_stime),
+        # ru_maxrss (in kB) is the peak of the largest process run so far, i.e. an upper bound for later chains
+        "peak_rss_mb": usage_after.ru_maxrss / 1024.0,
+        "devices": parse_resources(os.path.join(work_dir, "performanceMetrics.json")),
+    }
+
+
+def print_result(result, n_collisions):
+    """
+    Prints the measurements of a chain
+    """
+    status = "OK" if result["return_code"] == 0 else f"FAILED (exit code {result['return_code']})"
+    print(f"{result['name']}: {status}")
+    print(f"  wall time   {result['wall_s']:10.1f} s")
+    if n_collisions:
+        print(f"  throughput  {n_collisions / result['wall_s']:10.1f} collisions/s")
+    print(f"  CPU time    {result['cpu_s']:10.1f} s")
+    print(f"  peak RSS    {result['peak_rss_mb']:10.1f} MB")
+    for device, values in sorted(result["devices"].items(), key=lambda item: -item[1]["cpu"]):
+        print(f"    {device:50s} CPU {values['cpu']:12.1f}  peak memory {values['peak_memory']:12.1f}")
+
+
+def main():
+    """
+    Main function
+    """
+    parser = argparse.ArgumentParser(
+        description="Measure the throughput of standard analysis chains on a reference AO2D file"
+    )
+    parser.add_argument("--aod", required=True, help="Reference AO2D file")
+    parser.add_argument(
+        "--chains", default=os.path.join(DIR_THIS, "benchmark_chains.json"), help="JSON file with the chains"
+    )
+    parser.add_argument("--chain", action="append", default=[], help="Chain to run (can be repeated), default: all")
+    parser.add_argument("--config", default=None, help="DPL configuration used instead of the one of the chain")
+    parser.add_argument("--options", default=DEFAULT_OPTIONS, help="DPL options common to all the workflows")
+    parser.add_argument(
+        "--n-collisions", type=int, default=None, help="Number of collisions in the AO2D, default: counted with ROOT"
+    )
+    parser.add_argument("--work-dir", default="benchmark_workflows", help="Directory where the chains are run")
+    parser.add_argument("--output", default=None, help="JSON file for the results")
+    args = parser.parse_args()
+
+    with open(args.chains, encoding="utf-8") as file:
+        chains = json.load(file)["chains"]
+    if args.chain:
+        unknown = set(args.chain) - {chain["name"] for chain in chains}
+        if unknown:
+            print(f"Error: unknown chains {sorted(unknown)}")
+            sys.exit(1)
+        chains = [chain for chain in chains if chain["name"] in args.chain]
+
+    n_collisions = args.n_collisions if args.n_collisions is not None else count_collisions(args.aod)
+    if not n_collisions:
+        print("Warning: number of collisions unknown, the throughput is not reported")
+
+    results = []
+    for chain in chains:
+        work_dir = os.path.join(args.work_dir, chain["name"])
+        result = run_chain(chain, args.aod, args.options, work_dir, args.config)
+        result["collisions"] = n_collisions
+        print_result(result, n_collisions)
+        results.append(result)
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as file:
+            json.dump({"aod": args.aod, "options": args.options, "chains": results}, file, indent=2)
+        print(f"Results written to {args.output}")
+    if any(result["return_code"] != 0 for result in results):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -21,6 +21,8 @@
 #define HomogeneousField
 #endif
 
+#include <vector>
+
 #include <TDatabasePDG.h> // FIXME
 
 #include "KFParticle.h"
@@ -93,6 +95,20 @@ KFPTrack createKFPTrackFromTrack(const T& track)
   return kfpTrack;
 }
 
+/// @brief Function to create the KFPTracks of all the tracks of a table, e.g. once per collision before the loop over the track pairs.
+/// @tparam T
+/// @param tracks Tracks from aod::Tracks, aod::TracksExtra, aod::TracksCov
+/// @param kfpTracks KFPTracks in the order of the table, i.e. indexed by filteredIndex() for a filtered table
+template <typename T>
+void createKFPTracksFromTracks(const T& tracks, std::vector<KFPTrack>& kfpTracks)
+{
+  kfpTracks.clear();
+  kfpTracks.reserve(tracks.size());
+  for (const auto& track : tracks) {
+    kfpTracks.push_back(createKFPTrackFromTrack(track));
+  }
+}
+
 /// @brief Function to create a KFPTrack from o2::track::TrackParametrizationWithError tracks. The Covariance matrix is needed.
 /// @param track Track from o2::track::TrackParametrizationWithError
 /// @return KFPTrack
@@ -109,7 +125,7 @@ KFPTrack createKFPTrackFromTrackParCov(const o2::track::TrackParametrizationWith
 /// @param kfp KFParticle
 /// @param PV KFParticle primary vertex
 /// @return cpa
-float cpaFromKF(KFParticle kfp, KFParticle PV)
+float cpaFromKF(const KFParticle& kfp, const KFParticle& PV)
 {
   float xVtxP, yVtxP, zVtxP, xVtxS, yVtxS, zVtxS, px, py, pz = 0.;
 
@@ -133,7 +149,7 @@ float cpaFromKF(KFParticle kfp, KFParticle PV)
 /// @param kfp KFParticle
 /// @param PV KFParticle primary vertex
 /// @return cpa in xy
-float cpaXYFromKF(KFParticle kfp, KFParticle PV)
+float cpaXYFromKF(const KFParticle& kfp, const KFParticle& PV)
 {
   float xVtxP, yVtxP, xVtxS, yVtxS, px, py = 0.;
 
@@ -159,7 +175,7 @@ float cpaXYFromKF(KFParticle kfp, KFParticle PV)
 /// @param kfpprong0 KFParticle Prong 0
 /// @param kfpprong1 KFParticele Prong 1
 /// @return cos theta star
-float cosThetaStarFromKF(int ip, int pdgvtx, int pdgprong0, int pdgprong1, KFParticle kfpprong0, KFParticle kfpprong1)
+float cosThetaStarFromKF(int ip, int pdgvtx, int pdgprong0, int pdgprong1, const KFParticle& kfpprong0, const KFParticle& kfpprong1)
 {
   float px0, py0, pz0, px1, py1, pz1 = 0.;
 
@@ -186,7 +202,7 @@ float cosThetaStarFromKF(int ip, int pdgvtx, int pdgprong0, int pdgprong1, KFPar
 /// @param kfpParticle KFParticle
 /// @param Vertex KFParticle vertex
 /// @return impact parameter
-float impParXYFromKF(KFParticle kfpParticle, KFParticle Vertex)
+float impParXYFromKF(const KFParticle& kfpParticle, const KFParticle& Vertex)
 {
   float xVtxP, yVtxP, zVtxP, xVtxS, yVtxS, zVtxS, px, py, pz = 0.;
 
@@ -210,7 +226,7 @@ float impParXYFromKF(KFParticle kfpParticle, KFParticle Vertex)
 /// @param kfpParticle KFParticle
 /// @param PV KFParticle primary vertex
 /// @return l/delta l
-float ldlFromKF(KFParticle kfpParticle, KFParticle PV)
+float ldlFromKF(const KFParticle& kfpParticle, const KFParticle& PV)
 {
   float dx_particle = PV.GetX() - kfpParticle.GetX();
   float dy_particle = PV.GetY() - kfpParticle.GetY();
@@ -229,7 +245,7 @@ float ldlFromKF(KFParticle kfpParticle, KFParticle PV)
 /// @param kfpParticle KFParticle
 /// @param PV KFParticle primary vertex
 /// @return l/delta l in xy plane
-float ldlXYFromKF(KFParticle kfpParticle, KFParticle PV)
+float ldlXYFromKF(const KFParticle& kfpParticle, const KFParticle& PV)
 {
   float dx_particle = PV.GetX() - kfpParticle.GetX();
   float dy_particle = PV.GetY() - kfpParticle.GetY();
@@ -23,6 +23,8 @@
 #include <onnxruntime_cxx_api.h>
 #endif
 
+#include <algorithm>
+#include <fstream>
 #include <map>
 #include <string>
 #include <vector>
@@ -31,6 +33,8 @@
 #include "Framework/Array2D.h"
 
 #include "Tools/ML/model.h"
+#include "Tools/ML/sessionRegistry.h"
+#include "Tools/ML/treeModel.h"
 
 namespace o2
 {
@@ -73,6 +77,9 @@ class MlResponse
     mNClasses = nClasses;
     mNModels = binsLimits.size() - 1;
     mModels = std::vector<o2::ml::OnnxModel>(mNModels);
+    mTreeModels = std::vector<o2::ml::TreeEnsembleModel>(mNModels);
+    mIsTreeModel = std::vector<bool>(mNModels, false);
+    mModelHashes = std::vector<uint64_t>(mNModels, 0);
     mPaths = std::vector<std::string>(mNModels);
   }
 
@@ -100,11 +107,17 @@ class MlResponse
       }
     }
 
+    mValidFrom.assign(mNModels, 0);
+    mValidUntil.assign(mNModels, 0);
     for (auto iFile{0}; iFile < mNModels; ++iFile) {
       std::map<std::string, std::string> metadata;
-      bool retrieveSuccess = ccdbApi.retrieveBlob(pathsCCDB[iFile], ".", metadata, timestampCCDB, false, onnxFiles[iFile]);
+      // models already downloaded in this process for the same CCDB path and validity are not downloaded again
+      o2::ml::OnnxModelFile modelFile;
+      bool retrieveSuccess = o2::ml::OnnxSessionRegistry::instance().retrieveModel(ccdbApi, pathsCCDB[iFile], metadata, timestampCCDB, onnxFiles[iFile], modelFile);
       if (retrieveSuccess) {
-        mPaths[iFile] = onnxFiles[iFile];
+        mPaths[iFile] = modelFile.localPath;
+        mValidFrom[iFile] = modelFile.validFrom;
+        mValidUntil[iFile] = modelFile.validUntil;
       } else {
         LOG(fatal) << "Error encountered while accessing the ML model from " << pathsCCDB[iFile] << "! Maybe the ML model doesn't exist yet for this run number or timestamp?";
       }
@@ -119,20 +132,59 @@ class MlResponse
       LOG(fatal) << "Number of expected models (" << mNModels << ") different from the one set (" << onnxFiles.size() << ")! Please check your configurables.";
     }
     mPaths = onnxFiles;
+    mValidFrom.clear();
+    mValidUntil.clear();
   }
 
   /// Initialize class instance (initialize OnnxModels)
   /// \param enableOptimizations is a switch to enable optimizations
   /// \param threads is the number of active threads
+  /// \note Models stored as XGBoost JSON files (.json) are evaluated with the native TreeEnsembleModel instead of the ONNX runtime
   void init(bool enableOptimizations = false, int threads = 0)
   {
     uint8_t counterModel{0};
     for (const auto& path : mPaths) {
-      mModels[counterModel].initModel(path, enableOptimizations, threads);
+      uint64_t validFrom{0}, validUntil{0};
+      if (counterModel < mValidFrom.size()) {
+        validFrom = mValidFrom[counterModel];
+        validUntil = mValidUntil[counterModel];
+      }
+      mModelHashes[counterModel] = computeFileHash(path);
+      mIsTreeModel[counterModel] = o2::ml::isTreeModelFile(path);
+      if (mIsTreeModel[counterModel]) {
+        mTreeModels[counterModel].initModel(path, enableOptimizations, threads, validFrom, validUntil);
+      } else {
+        mModels[counterModel].initModel(path, enableOptimizations, threads, validFrom, validUntil);
+      }
       ++counterModel;
     }
   }
 
+  /// Replace the ONNX models with reduced-precision (e.g. INT8 or FP16 quantised) variants, validated against them
+  /// \param variantFiles is a vector of local .onnx file names of the variants, one for each bin (empty string to keep the reference model)
+  /// \param validationSamples is a vector of row-major feature matrices of candidates, one for each bin
+  /// \param tolerance is the maximum absolute deviation of the scores for a variant to be accepted
+  /// \note To be called after init(); native tree-ensemble models are not affected
+  /// \return validation report of each bin
+  std::vector<o2::ml::ModelVariantReport> useModelVariants(const std::vector<std::string>& variantFiles, std::vector<std::vector<TypeOutputScore>>& validationSamples, float tolerance)
+  {
+    if (variantFiles.size() != mNModels || validationSamples.size() != mNModels) {
+      LOG(fatal) << "Number of expected model variants and validation samples (" << mNModels << ") different from the ones set (" << variantFiles.size() << ", " << validationSamples.size() << ")! Please check your configurables.";
+    }
+    std::vector<o2::ml::ModelVariantReport> reports(mNModels);
+    for (auto iModel{0}; iModel < mNModels; ++iModel) {
+      if (variantFiles[iModel].empty() || mIsTreeModel[iModel]) {
+        continue;
+      }
+      reports[iModel] = mModels[iModel].initModelVariant(variantFiles[iModel], validationSamples[iModel], tolerance);
+      if (reports[iModel].accepted) {
+        mPaths[iModel] = variantFiles[iModel];
+        mModelHashes[iModel] = computeFileHash(variantFiles[iModel]);
+      }
+    }
+    return reports;
+  }
+
   /// Method to translate configurable input-feature strings into integers
   /// \param cfgInputFeatures array of input features names
   void cacheInputFeaturesIndices(std::vector<std::string> const& cfgInputFeatures)
@@ -158,7 +210,7 @@ class MlResponse
       LOG(fatal) << "Model index " << nModel << " is out of range! The number of initialised models is " << mModels.size() << ". Please check your configurables.";
     }
 
-    TypeOutputScore* outputPtr = mModels[nModel].evalModel(input);
+    TypeOutputScore* outputPtr = mIsTreeModel[nModel] ? mTreeModels[nModel].evalModel(input) : mModels[nModel].evalModel(input);
     return std::vector<TypeOutputScore>{outputPtr, outputPtr + mNClasses};
   }
 
@@ -171,20 +223,7 @@ class MlResponse
   {
     int nModel = findBin(candVar);
     auto output = getModelOutput(input, nModel);
-    uint8_t iClass{0};
-    for (const auto& outputValue : output) {
-      uint8_t dir = mCutDir.at(iClass);
-      if (dir != o2::cuts_ml::CutDirection::CutNot) {
-        if (dir == o2::cuts_ml::CutDirection::CutGreater && outputValue > mCuts.get(nModel, iClass)) {
-          return false;
-        }
-        if (dir == o2::cuts_ml::CutDirection::CutSmaller && outputValue < mCuts.get(nModel, iClass)) {
-          return false;
-        }
-      }
-      ++iClass;
-    }
-    return true;
+    return passCuts(output.data(), nModel);
   }
 
   /// ML selections
@@ -197,28 +236,130 @@ class MlResponse
   {
     int nModel = findBin(candVar);
     output = getModelOutput(input, nModel);
-    uint8_t iClass{0};
-    for (const auto& outputValue : output) {
-      uint8_t dir = mCutDir.at(iClass);
-      if (dir != o2::cuts_ml::CutDirection::CutNot) {
-        if (dir == o2::cuts_ml::CutDirection::CutGreater && outputValue > mCuts.get(nModel, iClass)) {
-          return false;
-        }
-        if (dir == o2::cuts_ml::CutDirection::CutSmaller && outputValue < mCuts.get(nModel, iClass)) {
-          return false;
-        }
+    return passCuts(output.data(), nModel);
+  }
+
+  /// ML selections on already computed scores (e.g. produced by another device with the same model)
+  /// \param scores are the model predictions for each class
+  /// \param candVar is the variable value (e.g. pT) used to select which model to use
+  /// \return boolean telling if model predictions pass the cuts
+  template <typename T>
+  bool isSelectedMlScores(const std::vector<TypeOutputScore>& scores, const T& candVar)
+  {
+    int nModel = findBin(candVar);
+    if (nModel < 0 || scores.size() < mNClasses) {
+      return false;
+    }
+    return passCuts(scores.data(), nModel);
+  }
+
+  /// Get the hash of a model file, to check whether scores computed elsewhere come from the same model
+  /// \param nModel is the model index
+  /// \return 64-bit FNV-1a hash of the model file content, 0 if not initialised
+  uint64_t getModelHash(const int nModel) const
+  {
+    if (nModel < 0 || static_cast<std::size_t>(nModel) >= mModelHashes.size()) {
+      return 0;
+    }
+    return mModelHashes[nModel];
+  }
+
+  /// Find the model index to be used for a given variable value
+  /// \param candVar is the variable value (e.g. pT) used to select which model to use
+  /// \return model index, -1 if the value is outside the model bins
+  template <typename T>
+  int getBinIndex(const T& candVar)
+  {
+    return findBin(candVar);
+  }
+
+  /// Deferred ML selections: queue one candidate for scoring in the next flush()
+  /// \param input is the input features
+  /// \param nModel is the model index (e.g. from getBinIndex)
+  /// \param candidateId is an identifier of the candidate, returned in the same order by getFlushedCandidateIds
+  /// \return position of the candidate in the dense arrays filled by flush()
+  template <typename T1>
+  std::size_t enqueue(const T1& input, const int nModel, const int64_t candidateId)
+  {
+    if (nModel < 0 || static_cast<std::size_t>(nModel) >= mModels.size()) {
+      LOG(fatal) << "Model index " << nModel << " is out of range! The number of initialised models is " << mModels.size() << ". Please check your configurables.";
+    }
+    if (mQueuedFeatures.size() != mModels.size()) {
+      mQueuedFeatures.resize(mModels.size());
+      mQueuedSlots.resize(mModels.size());
+    }
+    const std::size_t slot = mQueuedCandidateIds.size();
+    mQueuedFeatures[nModel].insert(mQueuedFeatures[nModel].end(), std::begin(input), std::end(input));
+    mQueuedSlots[nModel].push_back(slot);
+    mQueuedCandidateIds.push_back(candidateId);
+    return slot;
+  }
+
+  /// Deferred ML selections: score all the queued candidates with one batched evaluation per model
+  /// \return number of scored candidates
+  /// \note Results are stored in enqueue order and can be read with getFlushedScores, getFlushedSelections and getFlushedCandidateIds until the next flush()
+  std::size_t flush()
+  {
+    const std::size_t nCandidates = mQueuedCandidateIds.size();
+    mFlushedCandidateIds.swap(mQueuedCandidateIds);
+    mQueuedCandidateIds.clear();
+    mFlushedScores.assign(nCandidates * mNClasses, TypeOutputScore{0});
+    mFlushedSelections.assign(nCandidates, 0);
+
+    for (std::size_t iModel{0}; iModel < mQueuedFeatures.size(); ++iModel) {
+      const auto& slots = mQueuedSlots[iModel];
+      if (slots.empty()) {
+        continue;
+      }
+      const std::size_t nOutputs = mIsTreeModel[iModel] ? mTreeModels[iModel].getNumOutputNodesLast() : mModels[iModel].getNumOutputNodesLast();
+      mBatchOutput.resize(slots.size() * nOutputs);
+      const bool success = mIsTreeModel[iModel] ? mTreeModels[iModel].evalModelBatch(mQueuedFeatures[iModel].data(), slots.size(), mBatchOutput.data())
+                                                : mModels[iModel].evalModelBatch(mQueuedFeatures[iModel].data(), slots.size(), mBatchOutput.data());
+      if (!success) {
+        LOG(fatal) << "Batched evaluation of model " << iModel << " failed!";
+      }
+      for (std::size_t iRow{0}; iRow < slots.size(); ++iRow) {
+        const TypeOutputScore* scores = mBatchOutput.data() + iRow * nOutputs;
+        std::copy(scores, scores + mNClasses, mFlushedScores.begin() + slots[iRow] * mNClasses);
+        mFlushedSelections[slots[iRow]] = passCuts(scores, iModel);
       }
-      ++iClass;
+      mQueuedFeatures[iModel].clear();
+      mQueuedSlots[iModel].clear();
     }
-    return true;
+    return nCandidates;
+  }
+
+  /// Deferred ML selections: get the scores of the last flush
+  /// \return dense array of nCandidates x nClasses scores, in enqueue order
+  const std::vector<TypeOutputScore>& getFlushedScores() const { return mFlushedScores; }
+
+  /// Deferred ML selections: get the selection decisions of the last flush
+  /// \return dense array of nCandidates selection flags, in enqueue order
+  const std::vector<uint8_t>& getFlushedSelections() const { return mFlushedSelections; }
+
+  /// Deferred ML selections: get the candidate identifiers of the last flush
+  /// \return dense array of nCandidates identifiers, in enqueue order
+  const std::vector<int64_t>& getFlushedCandidateIds() const { return mFlushedCandidateIds; }
+
+  /// Deferred ML selections: get the scores of a candidate of the last flush
+  /// \param slot is the position returned by enqueue
+  /// \return vector with the model prediction for each class
+  std::vector<TypeOutputScore> getFlushedScores(const std::size_t slot) const
+  {
+    return std::vector<TypeOutputScore>{mFlushedScores.begin() + slot * mNClasses, mFlushedScores.begin() + (slot + 1) * mNClasses};
   }
 
  protected:
   std::vector<o2::ml::OnnxModel> mModels;                 // OnnxModel objects, one for each bin
+  std::vector<o2::ml::TreeEnsembleModel> mTreeModels;     // native tree-ensemble models, used instead of mModels for the bins with a .json model
+  std::vector<bool> mIsTreeModel = {};                    // whether the model of each bin is a native tree-ensemble model
+  std::vector<uint64_t> mModelHashes = {};                // hash of the model files, one for each bin
   uint8_t mNModels = 1;                                   // number of bins
   uint8_t mNClasses = 3;                                  // number of model classes
   std::vector<double> mBinsLimits = {};                   // bin limits of the variable (e.g. pT) used to select which model to use
   std::vector<std::string> mPaths = {""};                 // paths to the models, one for each bin
+  std::vector<uint64_t> mValidFrom = {};                  // start of the CCDB validity of the models, one for each bin
+  std::vector<uint64_t> mValidUntil = {};                 // end of the CCDB validity of the models, one for each bin
   std::vector<int> mCutDir = {};                          // direction of the cuts on the model scores (no cut is also supported)
   o2::framework::LabeledArray<double> mCuts = {};         // array of cut values to apply on the model scores
   std::map<std::string, uint8_t> mAvailableInputFeatures; // map of available input features
@@ -227,6 +368,54 @@ class MlResponse
   virtual void setAvailableInputFeatures() { return; } // method to fill the map of available input features
 
  private:
+  std::vector<std::vector<TypeOutputScore>> mQueuedFeatures; // queued input features, flattened, one vector for each model
+  std::vector<std::vector<std::size_t>> mQueuedSlots;        // position in the flushed arrays of the queued candidates, one vector for each model
+  std::vector<int64_t> mQueuedCandidateIds;                  // identifiers of the queued candidates, in enqueue order
+  std::vector<TypeOutputScore> mBatchOutput;                 // buffer for the output of a batched evaluation
+  std::vector<TypeOutputScore> mFlushedScores;               // scores of the last flush, nCandidates x nClasses
+  std::vector<uint8_t> mFlushedSelections;                   // selection flags of the last flush
+  std::vector<int64_t> mFlushedCandidateIds;                 // identifiers of the candidates of the last flush
+
+  /// Computes the 64-bit FNV-1a hash of a file content
+  /// \param path is the file path
+  /// \return hash, 0 if the file cannot be read
+  static uint64_t computeFileHash(const std::string& path)
+  {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      return 0;
+    }
+    uint64_t hash{14695981039346656037ULL};
+    char buffer[65536];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+      for (std::streamsize iByte{0}; iByte < file.gcount(); ++iByte) {
+        hash ^= static_cast<uint8_t>(buffer[iByte]);
+        hash *= 1099511628211ULL;
+      }
+    }
+    return hash;
+  }
+
+  /// Applies the cuts on the model scores
+  /// \param scores pointer to the model prediction for each class
+  /// \param nModel is the model index
+  /// \return boolean telling if model predictions pass the cuts
+  bool passCuts(const TypeOutputScore* scores, const int nModel)
+  {
+    for (uint8_t iClass{0}; iClass < mNClasses; ++iClass) {
+      uint8_t dir = mCutDir.at(iClass);
+      if (dir != o2::cuts_ml::CutDirection::CutNot) {
+        if (dir == o2::cuts_ml::CutDirection::CutGreater && scores[iClass] > mCuts.get(nModel, iClass)) {
+          return false;
+        }
+        if (dir == o2::cuts_ml::CutDirection::CutSmaller && scores[iClass] < mCuts.get(nModel, iClass)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
   /// Finds matching bin in mBinsLimits
   /// \param value e.g. pT
   /// \return index of the matching bin, used to access mModels
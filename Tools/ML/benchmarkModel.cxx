@@ -0,0 +1,266 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file     benchmarkModel.cxx
+///
+/// \brief    Standalone benchmark of the ML inference paths (OnnxModel, TreeEnsembleModel, MlResponse)
+///           Reports latency percentiles and throughput for single-candidate and batched calls and different thread counts
+///
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "Framework/Logger.h"
+
+#include "Tools/ML/MlResponse.h"
+#include "Tools/ML/model.h"
+#include "Tools/ML/treeModel.h"
+
+namespace bpo = boost::program_options;
+
+namespace
+{
+struct LatencySummary {
+  double p50 = 0.;        // median latency per call (us)
+  double p90 = 0.;        // 90th percentile of the latency per call (us)
+  double p99 = 0.;        // 99th percentile of the latency per call (us)
+  double throughput = 0.; // candidates per second
+};
+
+LatencySummary summarise(std::vector<double>& latencies, std::size_t candidatesPerCall)
+{
+  LatencySummary summary;
+  if (latencies.empty()) {
+    return summary;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double fraction) {
+    return latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(fraction * latencies.size()))];
+  };
+  summary.p50 = percentile(0.5);
+  summary.p90 = percentile(0.9);
+  summary.p99 = percentile(0.99);
+  double total{0.};
+  for (const auto& latency : latencies) {
+    total += latency;
+  }
+  summary.throughput = candidatesPerCall * latencies.size() / (total * 1.e-6);
+  return summary;
+}
+
+void printSummary(const std::string& label, int threads, std::size_t batchSize, const LatencySummary& summary)
+{
+  LOGP(info, "{:<24} threads {:>2} batch {:>7} | p50 {:>10.2f} us | p90 {:>10.2f} us | p99 {:>10.2f} us | {:>12.0f} cand/s",
+       label, threads, batchSize, summary.p50, summary.p90, summary.p99, summary.throughput);
+}
+
+/// Read a feature matrix from a text file with one candidate per line (space- or comma-separated values)
+std::vector<float> readFeatures(const std::string& fileName, int nFeatures)
+{
+  std::vector<float> features;
+  std::ifstream file(fileName);
+  if (!file) {
+    LOG(fatal) << "Cannot open the feature file " << fileName;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::istringstream stream(line);
+    std::vector<float> row;
+    float value;
+    while (stream >> value) {
+      row.push_back(value);
+    }
+    if (row.empty()) {
+      continue;
+    }
+    if (static_cast<int>(row.size()) != nFeatures) {
+      LOG(fatal) << "Line with " << row.size() << " values in " << fileName << ", the model expects " << nFeatures << " input features";
+    }
+    features.insert(features.end(), row.begin(), row.end());
+  }
+  return features;
+}
+
+/// Take nRows candidates from the pool, cycling over it
+void fillBatch(const std::vector<float>& pool, int nFeatures, std::size_t firstRow, std::size_t nRows, std::vector<float>& batch)
+{
+  const std::size_t nPoolRows = pool.size() / nFeatures;
+  batch.resize(nRows * nFeatures);
+  for (std::size_t iRow{0}; iRow < nRows; ++iRow) {
+    const std::size_t poolRow = (firstRow + iRow) % nPoolRows;
+    std::copy(pool.begin() + poolRow * nFeatures, pool.begin() + (poolRow + 1) * nFeatures, batch.begin() + iRow * nFeatures);
+  }
+}
+
+template <typename TModel>
+void benchmarkModel(TModel& model, const std::string& label, int threads, const std::vector<float>& pool, const std::vector<std::size_t>& batchSizes, int nCalls)
+{
+  const int nFeatures = model.getNumInputNodes();
+  std::vector<float> batch, output;
+  std::vector<double> latencies;
+
+  // single-candidate calls, as done in the analysis tasks
+  latencies.reserve(nCalls);
+  for (int iCall{0}; iCall < nCalls; ++iCall) {
+    fillBatch(pool, nFeatures, iCall, 1, batch);
+    auto start = std::chrono::steady_clock::now();
+    model.evalModel(batch);
+    auto stop = std::chrono::steady_clock::now();
+    latencies.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+  }
+  auto summary = summarise(latencies, 1);
+  printSummary(label + " single", threads, 1, summary);
+
+  // batched calls
+  for (const auto& batchSize : batchSizes) {
+    latencies.clear();
+    const int nBatchCalls = std::max(1, static_cast<int>(nCalls / batchSize));
+    for (int iCall{0}; iCall < nBatchCalls; ++iCall) {
+      fillBatch(pool, nFeatures, iCall * batchSize, batchSize, batch);
+      auto start = std::chrono::steady_clock::now();
+      model.evalModelBatch(batch, output);
+      auto stop = std::chrono::steady_clock::now();
+      latencies.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+    }
+    summary = summarise(latencies, batchSize);
+    printSummary(label + " batched", threads, batchSize, summary);
+  }
+}
+
+void benchmarkMlResponse(const std::string& modelPath, int nClasses, int threads, const std::vector<float>& pool, int nFeatures, int nCalls)
+{
+  const std::vector<double> binsLimits = {0., 1.e10};
+  std::vector<double> cutValues(nClasses, 0.5);
+  const std::vector<std::string> labelsBins = {"bin0"};
+  std::vector<std::string> labelsScores;
+  for (int iClass{0}; iClass < nClasses; ++iClass) {
+    labelsScores.push_back("score class " + std::to_string(iClass));
+  }
+  const o2::framework::LabeledArray<double> cuts{cutValues.data(), 1, static_cast<unsigned int>(nClasses), labelsBins, labelsScores};
+  const std::vector<int> cutDir(nClasses, o2::cuts_ml::CutDirection::CutNot);
+
+  o2::analysis::MlResponse<float> mlResponse;
+  mlResponse.configure(binsLimits, cuts, cutDir, nClasses);
+  mlResponse.setModelPathsLocal({modelPath});
+  mlResponse.init(false, threads);
+
+  std::vector<float> features, output;
+  std::vector<double> latencies;
+  latencies.reserve(nCalls);
+  for (int iCall{0}; iCall < nCalls; ++iCall) {
+    fillBatch(pool, nFeatures, iCall, 1, features);
+    auto start = std::chrono::steady_clock::now();
+    mlResponse.isSelectedMl(features, 1., output);
+    auto stop = std::chrono::steady_clock::now();
+    latencies.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+  }
+  printSummary("isSelectedMl", threads, 1, summarise(latencies, 1));
+
+  latencies.clear();
+  const std::size_t batchSize = 1000;
+  const int nBatchCalls = std::max(1, static_cast<int>(nCalls / batchSize));
+  for (int iCall{0}; iCall < nBatchCalls; ++iCall) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t iCand{0}; iCand < batchSize; ++iCand) {
+      fillBatch(pool, nFeatures, iCall * batchSize + iCand, 1, features);
+      mlResponse.enqueue(features, 0, iCand);
+    }
+    mlResponse.flush();
+    auto stop = std::chrono::steady_clock::now();
+    latencies.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+  }
+  printSummary("enqueue + flush", threads, batchSize, summarise(latencies, batchSize));
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  bpo::options_description options("Allowed options");
+  options.add_options()(
+    "model,m", bpo::value<std::string>()->required(), "Path to the model (.onnx, or .json for the native tree-ensemble evaluator)")(
+    "features,f", bpo::value<std::string>()->default_value(""), "Text file with the features to replay (one candidate per line). If empty, random features are generated")(
+    "n-candidates,n", bpo::value<int>()->default_value(10000), "Number of generated candidates if no feature file is given")(
+    "n-calls,c", bpo::value<int>()->default_value(10000), "Number of candidates evaluated for each configuration")(
+    "batch-sizes,b", bpo::value<std::vector<std::size_t>>()->multitoken()->default_value(std::vector<std::size_t>{16, 256, 4096}, "16 256 4096"), "Batch sizes")(
+    "threads,t", bpo::value<std::vector<int>>()->multitoken()->default_value(std::vector<int>{1}, "1"), "Numbers of intra-op threads")(
+    "n-classes", bpo::value<int>()->default_value(3), "Number of model classes, for the MlResponse benchmark")(
+    "seed,s", bpo::value<unsigned int>()->default_value(0), "Seed of the generated features")(
+    "help,h", "Produce help message.");
+
+  bpo::variables_map arguments;
+  try {
+    bpo::store(bpo::parse_command_line(argc, argv, options), arguments);
+    if (arguments.count("help")) {
+      LOG(info) << options;
+      return 0;
+    }
+    bpo::notify(arguments);
+  } catch (const bpo::error& e) {
+    LOG(error) << e.what() << "\n";
+    LOG(error) << "Error parsing command line arguments; Available options:";
+    LOG(error) << options;
+    return 1;
+  }
+
+  const auto modelPath = arguments["model"].as<std::string>();
+  const auto featureFile = arguments["features"].as<std::string>();
+  const auto nCalls = arguments["n-calls"].as<int>();
+  const auto batchSizes = arguments["batch-sizes"].as<std::vector<std::size_t>>();
+  const auto threadCounts = arguments["threads"].as<std::vector<int>>();
+  const auto nClasses = arguments["n-classes"].as<int>();
+  const bool isTreeModel = o2::ml::isTreeModelFile(modelPath);
+
+  for (const auto& threads : threadCounts) {
+    std::vector<float> pool;
+    int nFeatures{0};
+    auto preparePool = [&](int nInputs) {
+      nFeatures = nInputs;
+      if (!featureFile.empty()) {
+        pool = readFeatures(featureFile, nFeatures);
+      } else {
+        std::mt19937 generator(arguments["seed"].as<unsigned int>());
+        std::normal_distribution<float> distribution(0.f, 1.f);
+        pool.resize(static_cast<std::size_t>(arguments["n-candidates"].as<int>()) * nFeatures);
+        for (auto& value : pool) {
+          value = distribution(generator);
+        }
+      }
+      if (pool.empty()) {
+        LOG(fatal) << "No candidates to benchmark";
+      }
+    };
+
+    if (isTreeModel) {
+      o2::ml::TreeEnsembleModel model;
+      model.initModel(modelPath);
+      preparePool(model.getNumInputNodes());
+      benchmarkModel(model, "TreeEnsembleModel", threads, pool, batchSizes, nCalls);
+    } else {
+      o2::ml::OnnxModel model;
+      model.initModel(modelPath, false, threads);
+      preparePool(model.getNumInputNodes());
+      model.warmUp();
+      benchmarkModel(model, "OnnxModel", threads, pool, batchSizes, nCalls);
+    }
+    benchmarkMlResponse(modelPath, nClasses, threads, pool, nFeatures, nCalls);
+  }
+
+  return 0;
+}
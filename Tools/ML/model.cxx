@@ -74,13 +74,16 @@ void OnnxModel::initModel(std::string localPath, bool enableOptimizations, int t
     sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
   }
 
-  mEnv = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "onnx-model");
-#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-  mSession = std::make_shared<Ort::Experimental::Session>(*mEnv, modelPath, sessionOptions);
-#else
-  mSession = std::make_shared<Ort::Session>(*mEnv, modelPath.c_str(), sessionOptions);
-#endif
-
+  /// Environment and session are shared with all the models of the process loaded with the same settings
+  mEnv = OnnxSessionRegistry::instance().getEnv();
+  mSessionSettings.enableOptimizations = enableOptimizations;
+  mSessionSettings.threads = activeThreads;
+  mSession = OnnxSessionRegistry::instance().getSession(modelPath, mSessionSettings, from, until);
+
+  mInputNames.clear();
+  mInputShapes.clear();
+  mOutputNames.clear();
+  mOutputShapes.clear();
 #if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
   mInputNames = mSession->GetInputNames();
   mInputShapes = mSession->GetInputShapes();
@@ -101,6 +104,26 @@ void OnnxModel::initModel(std::string localPath, bool enableOptimizations, int t
     mOutputShapes.emplace_back(mSession->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
   }
 #endif
+  mInputNamesChar.clear();
+  std::transform(std::begin(mInputNames), std::end(mInputNames), std::back_inserter(mInputNamesChar),
+                 [&](const std::string& str) { return str.c_str(); });
+  mOutputNamesChar.clear();
+  std::transform(std::begin(mOutputNames), std::end(mOutputNames), std::back_inserter(mOutputNamesChar),
+                 [&](const std::string& str) { return str.c_str(); });
+  mMemoryInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+  mRunOptions = Ort::RunOptions{};
+  mIoBinding.reset();
+  mPinnedInput = Ort::MemoryAllocation(nullptr, nullptr, 0);
+  mPinnedInputBytes = 0;
+  mPinnedAllocator.reset();
+  mPinnedMemoryInfo = Ort::MemoryInfo{nullptr};
+  if (mSessionSettings.executionProvider == "cuda") {
+    mPinnedMemoryInfo = Ort::MemoryInfo("CudaPinned", OrtDeviceAllocator, mSessionSettings.deviceId, OrtMemTypeCPUInput);
+  } else if (mSessionSettings.executionProvider == "rocm") {
+    mPinnedMemoryInfo = Ort::MemoryInfo("HipPinned", OrtDeviceAllocator, mSessionSettings.deviceId, OrtMemTypeCPUInput);
+  }
+  LOG(info) << "Execution provider: " << mSessionSettings.executionProvider;
+
   LOG(info) << "Input Nodes:";
   for (size_t i = 0; i < mInputNames.size(); i++) {
     LOG(info) << "\t" << mInputNames[i] << " : " << printShape(mInputShapes[i]);
@@ -119,6 +142,34 @@ void OnnxModel::initModel(std::string localPath, bool enableOptimizations, int t
   LOG(info) << "--- Model initialized! ---";
 }
 
+void OnnxModel::setExecutionProvider(const std::string& provider, int deviceId)
+{
+  mSessionSettings.executionProvider = provider;
+  mSessionSettings.deviceId = deviceId;
+}
+
+void OnnxModel::setProfiling(bool enable, const std::string& prefix)
+{
+  mSessionSettings.enableProfiling = enable;
+  mSessionSettings.profilingPrefix = prefix;
+  if (enable) {
+    sessionOptions.EnableProfiling(prefix.c_str());
+  } else {
+    sessionOptions.DisableProfiling();
+  }
+}
+
+std::string OnnxModel::endProfiling()
+{
+  if (!mSessionSettings.enableProfiling || !mSession) {
+    return "";
+  }
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::string profilingFile = mSession->EndProfilingAllocated(allocator).get();
+  LOG(info) << "ONNX profiling written to " << profilingFile;
+  return profilingFile;
+}
+
 void OnnxModel::setActiveThreads(int threads)
 {
   activeThreads = threads;
@@ -26,11 +26,14 @@
 #else
 #include <onnxruntime_cxx_api.h>
 #endif
+#include <array>
+#include <cmath>
 #include <vector>
 #include <string>
 #include <memory>
 #include <map>
 #include <algorithm>
+#include <iterator>
 
 // ROOT includes
 #include "TSystem.h"
@@ -38,12 +41,22 @@
 // O2 includes
 #include "Framework/Logger.h"
 
+#include "Tools/ML/sessionRegistry.h"
+
 namespace o2
 {
 
 namespace ml
 {
 
+/// Comparison of a reduced-precision model variant with the reference (FP32) model
+struct ModelVariantReport {
+  std::size_t nSamples = 0;  // number of validation rows
+  float maxDeviation = 0.f;  // maximum absolute deviation of the outputs
+  float meanDeviation = 0.f; // mean absolute deviation of the outputs
+  bool accepted = false;     // whether the variant replaced the reference model
+};
+
 class OnnxModel
 {
 
@@ -65,15 +78,7 @@ class OnnxModel
 #if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
       auto outputTensors = mSession->Run(mInputNames, input, mOutputNames);
 #else
-      Ort::RunOptions runOptions;
-      std::vector<const char*> inputNamesChar(mInputNames.size(), nullptr);
-      std::transform(std::begin(mInputNames), std::end(mInputNames), std::begin(inputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
-
-      std::vector<const char*> outputNamesChar(mOutputNames.size(), nullptr);
-      std::transform(std::begin(mOutputNames), std::end(mOutputNames), std::begin(outputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
-      auto outputTensors = mSession->Run(runOptions, inputNamesChar.data(), input.data(), input.size(), outputNamesChar.data(), outputNamesChar.size());
+      auto outputTensors = mSession->Run(mRunOptions, mInputNamesChar.data(), input.data(), input.size(), mOutputNamesChar.data(), mOutputNamesChar.size());
 #endif
       LOG(debug) << "Number of output tensors: " << outputTensors.size();
       if (outputTensors.size() != mOutputNames.size()) {
@@ -103,20 +108,165 @@ class OnnxModel
 #if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
     inputTensors.emplace_back(Ort::Experimental::Value::CreateTensor<T>(input.data(), size, inputShape));
 #else
-    Ort::MemoryInfo mem_info =
-      Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-    inputTensors.emplace_back(Ort::Value::CreateTensor<T>(mem_info, input.data(), size, inputShape.data(), inputShape.size()));
+    inputTensors.emplace_back(Ort::Value::CreateTensor<T>(mMemoryInfo, input.data(), size, inputShape.data(), inputShape.size()));
 #endif
     LOG(debug) << "Input shape calculated from vector: " << printShape(inputShape);
     return evalModel<T>(inputTensors);
   }
 
+  /// Batched inference on a contiguous, row-major feature matrix
+  /// \param input pointer to nRows x getNumInputNodes() feature values
+  /// \param nRows number of rows (e.g. candidates) in the batch
+  /// \param output pre-allocated buffer of nRows x getNumOutputNodesLast() values, filled with the last output node
+  /// \return true if the inference succeeded
+  /// \note Input and output tensors are bound directly on the caller buffers through a persistent IoBinding, no copy is done
+  template <typename T>
+  bool evalModelBatch(T* input, std::size_t nRows, T* output)
+  {
+    if (nRows == 0) {
+      return true;
+    }
+    const int64_t nFeatures = mInputShapes[0].back();
+    const int64_t nOutputs = getNumOutputNodesLast();
+    const int64_t batchSize = static_cast<int64_t>(nRows);
+    const std::array<int64_t, 2> inputShape{batchSize, nFeatures};
+    const std::array<int64_t, 2> outputShape{batchSize, nOutputs};
+
+    try {
+      if (!mIoBinding) {
+        mIoBinding = std::make_unique<Ort::IoBinding>(*mSession);
+      }
+      if (mPinnedMemoryInfo) {
+        // stage the input in page-locked host memory, for a faster transfer to the device
+        const std::size_t inputBytes = nRows * nFeatures * sizeof(T);
+        if (inputBytes > mPinnedInputBytes) {
+          mPinnedInput = Ort::MemoryAllocation(nullptr, nullptr, 0);
+          if (!mPinnedAllocator) {
+            mPinnedAllocator = std::make_unique<Ort::Allocator>(*mSession, mPinnedMemoryInfo);
+          }
+          mPinnedInput = mPinnedAllocator->GetAllocation(inputBytes);
+          mPinnedInputBytes = inputBytes;
+        }
+        std::copy(input, input + nRows * nFeatures, static_cast<T*>(mPinnedInput.get()));
+        input = static_cast<T*>(mPinnedInput.get());
+      }
+      Ort::Value inputTensor = Ort::Value::CreateTensor<T>(mPinnedMemoryInfo ? mPinnedMemoryInfo : mMemoryInfo, input, nRows * nFeatures, inputShape.data(), inputShape.size());
+      Ort::Value outputTensor = Ort::Value::CreateTensor<T>(mMemoryInfo, output, nRows * nOutputs, outputShape.data(), outputShape.size());
+      mIoBinding->ClearBoundInputs();
+      mIoBinding->ClearBoundOutputs();
+      mIoBinding->BindInput(mInputNamesChar[0], inputTensor);
+      mIoBinding->BindOutput(mOutputNamesChar.back(), outputTensor);
+      mSession->Run(mRunOptions, *mIoBinding);
+      return true;
+    } catch (const Ort::Exception& exception) {
+      LOG(error) << "Error running batched model inference: " << exception.what();
+    }
+    return false;
+  }
+
+  /// Batched inference on a feature matrix stored in a vector
+  /// \param input vector of nRows x getNumInputNodes() feature values, row-major
+  /// \param output vector resized to nRows x getNumOutputNodesLast() and filled with the last output node
+  /// \return true if the inference succeeded
+  template <typename T>
+  bool evalModelBatch(std::vector<T>& input, std::vector<T>& output)
+  {
+    const std::size_t nFeatures = mInputShapes[0].back();
+    assert(input.size() % nFeatures == 0);
+    const std::size_t nRows = input.size() / nFeatures;
+    output.resize(nRows * getNumOutputNodesLast());
+    return evalModelBatch<T>(input.data(), nRows, output.data());
+  }
+
+  /// Load a reduced-precision (e.g. INT8 or FP16 quantised) variant of the model, validated against the model loaded with initModel
+  /// \param variantPath path to the .onnx file of the variant, which must keep the FP32 input and output types
+  /// \param validationSample row-major feature matrix of candidates used for the validation
+  /// \param tolerance maximum absolute deviation of the outputs for the variant to be accepted
+  /// \return validation report; the variant replaces the reference session only if accepted
+  template <typename T>
+  ModelVariantReport initModelVariant(const std::string& variantPath, std::vector<T>& validationSample, float tolerance)
+  {
+    ModelVariantReport report;
+    std::vector<T> referenceOutput, variantOutput;
+    if (validationSample.empty() || !evalModelBatch<T>(validationSample, referenceOutput)) {
+      LOG(error) << "No valid validation sample for the model variant " << variantPath << ", the reference model is kept";
+      return report;
+    }
+
+    auto referenceSession = mSession;
+    const std::string referencePath = modelPath;
+    try {
+      mSession = OnnxSessionRegistry::instance().getSession(variantPath, mSessionSettings, validFrom, validUntil);
+    } catch (const Ort::Exception& exception) {
+      mSession = referenceSession;
+      LOG(error) << "Error loading the model variant " << variantPath << ": " << exception.what() << ", the reference model is kept";
+      return report;
+    }
+    mIoBinding.reset();
+    mPinnedAllocator.reset();
+    mPinnedInput = Ort::MemoryAllocation(nullptr, nullptr, 0);
+    mPinnedInputBytes = 0;
+    const bool success = evalModelBatch<T>(validationSample, variantOutput);
+
+    if (success && variantOutput.size() == referenceOutput.size()) {
+      double sumDeviation{0.};
+      for (std::size_t iValue{0}; iValue < referenceOutput.size(); ++iValue) {
+        const float deviation = std::abs(static_cast<float>(variantOutput[iValue] - referenceOutput[iValue]));
+        report.maxDeviation = std::max(report.maxDeviation, deviation);
+        sumDeviation += deviation;
+      }
+      report.nSamples = validationSample.size() / mInputShapes[0].back();
+      report.meanDeviation = referenceOutput.empty() ? 0.f : sumDeviation / referenceOutput.size();
+      report.accepted = report.maxDeviation <= tolerance;
+    }
+
+    LOG(info) << "--- ONNX-ML model variant validation ---";
+    LOG(info) << "Reference: " << referencePath << ", variant: " << variantPath;
+    LOG(info) << "Validation rows: " << report.nSamples << ", max deviation: " << report.maxDeviation << ", mean deviation: " << report.meanDeviation << ", tolerance: " << tolerance;
+    if (report.accepted) {
+      modelPath = variantPath;
+      LOG(info) << "Model variant accepted";
+    } else {
+      mSession = referenceSession;
+      mIoBinding.reset();
+      mPinnedAllocator.reset();
+      mPinnedInput = Ort::MemoryAllocation(nullptr, nullptr, 0);
+      mPinnedInputBytes = 0;
+      LOG(warning) << "Model variant " << variantPath << " rejected, the reference model is kept";
+    }
+    return report;
+  }
+
+  /// Run a few inferences on dummy input, to initialise the session (and the device memory if any) before the first event
+  /// \param nRows number of rows of the dummy batch
+  /// \param nIterations number of inferences
+  template <typename T = float>
+  void warmUp(std::size_t nRows = 1, int nIterations = 1)
+  {
+    std::vector<T> dummyInput(nRows * getNumInputNodes(), 1.);
+    std::vector<T> dummyOutput;
+    for (int iIteration{0}; iIteration < nIterations; ++iIteration) {
+      evalModelBatch<T>(dummyInput, dummyOutput);
+    }
+  }
+
   // Reset session
 #if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-  void resetSession() { mSession.reset(new Ort::Experimental::Session{*mEnv, modelPath, sessionOptions}); }
+  void resetSession()
+  {
+    mIoBinding.reset();
+    mPinnedInput = Ort::MemoryAllocation(nullptr, nullptr, 0);
+    mPinnedInputBytes = 0;
+    mPinnedAllocator.reset();
+    mSession.reset(new Ort::Experimental::Session{*mEnv, modelPath, sessionOptions});
+  }
 #else
   void resetSession()
   {
+    mIoBinding.reset();
+    mPinnedInput = Ort::MemoryAllocation(nullptr, nullptr, 0);
+    mPinnedInputBytes = 0;
+    mPinnedAllocator.reset();
     mSession.reset(new Ort::Session{*mEnv, modelPath.c_str(), sessionOptions});
   }
 #endif
@@ -133,9 +283,19 @@ class OnnxModel
 #endif
   int getNumInputNodes() const { return mInputShapes[0][1]; }
   int getNumOutputNodes() const { return mOutputShapes[0][1]; }
+  int getNumOutputNodesLast() const { return mOutputShapes.back().size() > 1 ? mOutputShapes.back()[1] : 1; }
   uint64_t getValidityFrom() const { return validFrom; }
   uint64_t getValidityUntil() const { return validUntil; }
   void setActiveThreads(int);
+  /// Set the execution provider (cpu, cuda, rocm or openvino), to be called before initModel
+  /// \note The session falls back to CPU if the provider is not available
+  void setExecutionProvider(const std::string& provider, int deviceId = 0);
+  /// Enable the session-level profiling, to be called before initModel
+  void setProfiling(bool enable, const std::string& prefix = "onnx-model");
+  /// Stop the profiling and write the profiling file (otherwise written when the session is destroyed)
+  /// \return name of the profiling file, empty if profiling is not enabled
+  std::string endProfiling();
+  const std::string& getExecutionProvider() const { return mSessionSettings.executionProvider; }
 
  private:
   // Environment variables for the ONNX runtime
@@ -153,6 +313,20 @@ class OnnxModel
   std::vector<std::string> mOutputNames;
   std::vector<std::vector<int64_t>> mOutputShapes;
 
+  // Objects cached across inference calls
+  std::vector<const char*> mInputNamesChar;
+  std::vector<const char*> mOutputNamesChar;
+  Ort::MemoryInfo mMemoryInfo{nullptr};
+  Ort::RunOptions mRunOptions{nullptr};
+  std::unique_ptr<Ort::IoBinding> mIoBinding = nullptr;
+  Ort::MemoryInfo mPinnedMemoryInfo{nullptr}; // page-locked host memory, used for GPU execution providers
+  std::unique_ptr<Ort::Allocator> mPinnedAllocator = nullptr;
+  Ort::MemoryAllocation mPinnedInput{nullptr, nullptr, 0};
+  std::size_t mPinnedInputBytes = 0;
+
+  // Settings of the session
+  OnnxSessionSettings mSessionSettings;
+
   // Environment settings
   std::string modelPath;
   int activeThreads = 0;
@@ -0,0 +1,176 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file     sessionRegistry.cxx
+///
+/// \brief    Process-wide registry of ONNX runtime environment, sessions and CCDB model downloads
+///
+
+#include "Tools/ML/sessionRegistry.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+// O2 includes
+#include "Framework/Logger.h"
+
+namespace o2
+{
+
+namespace ml
+{
+
+OnnxSessionRegistry& OnnxSessionRegistry::instance()
+{
+  static OnnxSessionRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<Ort::Env> OnnxSessionRegistry::getEnv()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (!mEnv) {
+    mEnv = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "onnx-model");
+  }
+  return mEnv;
+}
+
+std::shared_ptr<OnnxSession> OnnxSessionRegistry::getSession(const std::string& modelPath, bool enableOptimizations, int threads, uint64_t validFrom, uint64_t validUntil)
+{
+  OnnxSessionSettings settings;
+  settings.enableOptimizations = enableOptimizations;
+  settings.threads = threads;
+  return getSession(modelPath, settings, validFrom, validUntil);
+}
+
+std::shared_ptr<OnnxSession> OnnxSessionRegistry::getSession(const std::string& modelPath, OnnxSessionSettings& settings, uint64_t validFrom, uint64_t validUntil)
+{
+  auto env = getEnv();
+  const std::string key = modelPath + "|" + std::to_string(validFrom) + "|" + std::to_string(validUntil) + "|" + settings.key();
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto& entry = mSessions[key];
+  if (auto session = entry.session.lock()) {
+    LOG(info) << "Reusing ONNX session for " << modelPath;
+    settings.executionProvider = entry.executionProvider;
+    return session;
+  }
+
+  Ort::SessionOptions sessionOptions;
+  sessionOptions.SetIntraOpNumThreads(settings.threads);
+  if (settings.enableOptimizations) {
+    sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+  }
+  if (settings.enableProfiling) {
+    sessionOptions.EnableProfiling(settings.profilingPrefix.c_str());
+  }
+  if (settings.executionProvider != "cpu" && !appendExecutionProvider(sessionOptions, settings)) {
+    settings.executionProvider = "cpu";
+  }
+
+  std::shared_ptr<OnnxSession> session = nullptr;
+  try {
+#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
+    session = std::make_shared<OnnxSession>(*env, modelPath, sessionOptions);
+#else
+    session = std::make_shared<OnnxSession>(*env, modelPath.c_str(), sessionOptions);
+#endif
+  } catch (const Ort::Exception& exception) {
+    if (settings.executionProvider == "cpu") {
+      throw;
+    }
+    LOG(warning) << "Error creating the session with execution provider " << settings.executionProvider << ": " << exception.what() << ". Falling back to CPU.";
+    settings.executionProvider = "cpu";
+    Ort::SessionOptions cpuSessionOptions;
+    cpuSessionOptions.SetIntraOpNumThreads(settings.threads);
+    if (settings.enableOptimizations) {
+      cpuSessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+    }
+    if (settings.enableProfiling) {
+      cpuSessionOptions.EnableProfiling(settings.profilingPrefix.c_str());
+    }
+#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
+    session = std::make_shared<OnnxSession>(*env, modelPath, cpuSessionOptions);
+#else
+    session = std::make_shared<OnnxSession>(*env, modelPath.c_str(), cpuSessionOptions);
+#endif
+  }
+  LOG(info) << "ONNX session for " << modelPath << " created with execution provider " << settings.executionProvider;
+  entry.session = session;
+  entry.executionProvider = settings.executionProvider;
+  return session;
+}
+
+bool OnnxSessionRegistry::appendExecutionProvider(Ort::SessionOptions& sessionOptions, const OnnxSessionSettings& settings)
+{
+  try {
+    if (settings.executionProvider == "cuda") {
+      OrtCUDAProviderOptions options;
+      options.device_id = settings.deviceId;
+      sessionOptions.AppendExecutionProvider_CUDA(options);
+    } else if (settings.executionProvider == "rocm") {
+      OrtROCMProviderOptions options;
+      options.device_id = settings.deviceId;
+      sessionOptions.AppendExecutionProvider_ROCM(options);
+    } else if (settings.executionProvider == "openvino") {
+      OrtOpenVINOProviderOptions options;
+      sessionOptions.AppendExecutionProvider_OpenVINO(options);
+    } else {
+      LOG(warning) << "Unknown execution provider " << settings.executionProvider << ". Falling back to CPU.";
+      return false;
+    }
+  } catch (const Ort::Exception& exception) {
+    LOG(warning) << "Execution provider " << settings.executionProvider << " not available: " << exception.what() << ". Falling back to CPU.";
+    return false;
+  }
+  return true;
+}
+
+bool OnnxSessionRegistry::retrieveModel(const o2::ccdb::CcdbApi& ccdbApi, const std::string& pathCCDB, std::map<std::string, std::string>& metadata, int64_t timestamp, const std::string& localFile, OnnxModelFile& modelFile, const std::string& localDir)
+{
+  const std::string localPath = (localDir == ".") ? localFile : localDir + "/" + localFile;
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto& downloads = mDownloads[pathCCDB];
+  for (const auto& download : downloads) {
+    if (static_cast<uint64_t>(timestamp) >= download.validFrom && static_cast<uint64_t>(timestamp) <= download.validUntil) {
+      LOG(info) << "Model " << pathCCDB << " for timestamp " << timestamp << " already available in " << download.localPath;
+      modelFile = download;
+      return true;
+    }
+  }
+
+  if (!ccdbApi.retrieveBlob(pathCCDB, localDir, metadata, timestamp, false, localFile)) {
+    return false;
+  }
+  auto headers = ccdbApi.retrieveHeaders(pathCCDB, metadata, timestamp);
+  modelFile.localPath = localPath;
+  modelFile.validFrom = strtoul(headers["Valid-From"].c_str(), NULL, 0);
+  modelFile.validUntil = strtoul(headers["Valid-Until"].c_str(), NULL, 0);
+  // a model with unknown validity is not shared
+  if (modelFile.validUntil > modelFile.validFrom) {
+    // a new download overwrites the file of previous validity windows with the same local name
+    downloads.erase(std::remove_if(downloads.begin(), downloads.end(), [&](const OnnxModelFile& download) { return download.localPath == localPath; }), downloads.end());
+    downloads.push_back(modelFile);
+  }
+  return true;
+}
+
+void OnnxSessionRegistry::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mSessions.clear();
+  mDownloads.clear();
+}
+
+} // namespace ml
+
+} // namespace o2
@@ -0,0 +1,137 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file     sessionRegistry.h
+///
+/// \brief    Process-wide registry of ONNX runtime environment, sessions and CCDB model downloads
+///
+
+#ifndef TOOLS_ML_SESSIONREGISTRY_H_
+#define TOOLS_ML_SESSIONREGISTRY_H_
+
+// C++ and system includes
+#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
+#include <onnxruntime/core/session/experimental_onnxruntime_cxx_api.h>
+#else
+#include <onnxruntime_cxx_api.h>
+#endif
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// O2 includes
+#include "CCDB/CcdbApi.h"
+
+namespace o2
+{
+
+namespace ml
+{
+
+#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
+using OnnxSession = Ort::Experimental::Session;
+#else
+using OnnxSession = Ort::Session;
+#endif
+
+/// Model file downloaded from CCDB together with its validity window
+struct OnnxModelFile {
+  std::string localPath = "";
+  uint64_t validFrom = 0;
+  uint64_t validUntil = 0;
+};
+
+/// Settings of an ONNX runtime session
+struct OnnxSessionSettings {
+  bool enableOptimizations = false;           // enable the extended graph optimizations
+  int threads = 0;                            // number of intra-op threads
+  std::string executionProvider = "cpu";      // execution provider: cpu, cuda, rocm or openvino
+  int deviceId = 0;                           // device used by the execution provider
+  bool enableProfiling = false;               // enable the session-level profiling
+  std::string profilingPrefix = "onnx-model"; // prefix of the profiling output file
+
+  /// String representation, used as key of the shared sessions
+  std::string key() const
+  {
+    return std::to_string(enableOptimizations) + "|" + std::to_string(threads) + "|" + executionProvider + "|" + std::to_string(deviceId) + "|" + std::to_string(enableProfiling);
+  }
+};
+
+/// Singleton holding one Ort::Env per process and sharing the sessions (and the CCDB downloads) of identical models
+class OnnxSessionRegistry
+{
+ public:
+  static OnnxSessionRegistry& instance();
+
+  OnnxSessionRegistry(const OnnxSessionRegistry&) = delete;
+  OnnxSessionRegistry& operator=(const OnnxSessionRegistry&) = delete;
+
+  /// Get the process-wide ONNX runtime environment
+  std::shared_ptr<Ort::Env> getEnv();
+
+  /// Get a session for a model file, created only if no session with the same settings is alive
+  /// \param modelPath path to the local .onnx file
+  /// \param enableOptimizations switch to enable the extended graph optimizations
+  /// \param threads number of intra-op threads of the session
+  /// \param validFrom start of the validity of the model file
+  /// \param validUntil end of the validity of the model file
+  /// \return shared session
+  /// \note The validity is part of the key, as the same local file name can be reused for models of different validity
+  std::shared_ptr<OnnxSession> getSession(const std::string& modelPath, bool enableOptimizations, int threads, uint64_t validFrom = 0, uint64_t validUntil = 0);
+
+  /// Get a session for a model file with full session settings
+  /// \param modelPath path to the local .onnx file
+  /// \param settings session settings; executionProvider is set to "cpu" if the requested provider is not available
+  /// \param validFrom start of the validity of the model file
+  /// \param validUntil end of the validity of the model file
+  /// \return shared session
+  std::shared_ptr<OnnxSession> getSession(const std::string& modelPath, OnnxSessionSettings& settings, uint64_t validFrom = 0, uint64_t validUntil = 0);
+
+  /// Download a model from CCDB, only if it was not already downloaded for a validity window including the timestamp
+  /// \param ccdbApi is the CCDB API
+  /// \param pathCCDB is the model path in CCDB
+  /// \param metadata is the CCDB metadata
+  /// \param timestamp is the CCDB timestamp
+  /// \param localFile is the local file name used for a new download
+  /// \param modelFile is filled with the local path and the validity of the model
+  /// \param localDir is the local directory used for a new download
+  /// \return true if the model is available locally
+  bool retrieveModel(const o2::ccdb::CcdbApi& ccdbApi, const std::string& pathCCDB, std::map<std::string, std::string>& metadata, int64_t timestamp, const std::string& localFile, OnnxModelFile& modelFile, const std::string& localDir = ".");
+
+  /// Drop all the cached sessions and downloads
+  void clear();
+
+ private:
+  OnnxSessionRegistry() = default;
+
+  /// Append the requested execution provider to the session options
+  /// \return false if the provider is not available in this onnxruntime build
+  static bool appendExecutionProvider(Ort::SessionOptions& sessionOptions, const OnnxSessionSettings& settings);
+
+  std::mutex mMutex;
+  std::shared_ptr<Ort::Env> mEnv = nullptr;
+  struct SessionEntry {
+    std::weak_ptr<OnnxSession> session;
+    std::string executionProvider; // provider actually used by the session
+  };
+  std::map<std::string, SessionEntry> mSessions;                // sessions keyed on model path, validity and session settings
+  std::map<std::string, std::vector<OnnxModelFile>> mDownloads; // downloaded models keyed on CCDB path
+};
+
+} // namespace ml
+
+} // namespace o2
+
+#endif // TOOLS_ML_SESSIONREGISTRY_H_
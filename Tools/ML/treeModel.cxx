@@ -0,0 +1,152 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file     treeModel.cxx
+///
+/// \brief    Native evaluator of gradient-boosted tree ensembles (XGBoost JSON models), without ONNX runtime
+///
+
+#include "Tools/ML/treeModel.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "rapidjson/document.h"
+#include "rapidjson/filereadstream.h"
+
+// O2 includes
+#include "Framework/Logger.h"
+
+namespace o2
+{
+
+namespace ml
+{
+
+namespace
+{
+/// XGBoost stores the model parameters as strings (e.g. "5E-1" or "[5E-1]")
+float parseParameter(const rapidjson::Value& value)
+{
+  if (value.IsNumber()) {
+    return value.GetFloat();
+  }
+  std::string str = value.GetString();
+  if (!str.empty() && str.front() == '[') {
+    str = str.substr(1, str.size() - 2);
+  }
+  return std::strtof(str.c_str(), nullptr);
+}
+
+bool parseFlag(const rapidjson::Value& value)
+{
+  return value.IsBool() ? value.GetBool() : value.GetInt() != 0;
+}
+} // namespace
+
+void TreeEnsembleModel::initModel(std::string localPath, bool, int, uint64_t from, uint64_t until)
+{
+  assert(from <= until);
+
+  LOG(info) << "--- Tree-ensemble ML model ---";
+  modelPath = localPath;
+
+  FILE* fp = fopen(modelPath.c_str(), "rb");
+  if (!fp) {
+    LOG(fatal) << "Error opening tree-ensemble model file " << modelPath;
+  }
+  char readBuffer[65536];
+  rapidjson::FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+  rapidjson::Document document;
+  document.ParseStream(is);
+  fclose(fp);
+  if (document.HasParseError() || !document.HasMember("learner")) {
+    LOG(fatal) << "File " << modelPath << " is not a valid XGBoost JSON model!";
+  }
+
+  const auto& learner = document["learner"];
+  const auto& learnerParams = learner["learner_model_param"];
+  mNFeatures = static_cast<int>(parseParameter(learnerParams["num_feature"]));
+  const int nClasses = static_cast<int>(parseParameter(learnerParams["num_class"]));
+  const float baseScore = parseParameter(learnerParams["base_score"]);
+
+  const std::string objective = learner["objective"]["name"].GetString();
+  if (objective == "binary:logistic") {
+    mObjective = Objective::Logistic;
+    mNGroups = 1;
+    mNOutputs = 2;
+    mBaseMargin = -std::log(1.f / baseScore - 1.f);
+  } else if (objective == "multi:softprob" || objective == "multi:softmax") {
+    mObjective = Objective::Softmax;
+    mNGroups = nClasses;
+    mNOutputs = nClasses;
+    mBaseMargin = baseScore;
+  } else {
+    LOG(warning) << "Objective " << objective << " not supported, the raw margins are returned";
+    mObjective = Objective::Raw;
+    mNGroups = nClasses > 1 ? nClasses : 1;
+    mNOutputs = mNGroups;
+    mBaseMargin = baseScore;
+  }
+
+  const auto& booster = learner["gradient_booster"];
+  if (std::string(booster["name"].GetString()) != "gbtree") {
+    LOG(fatal) << "Only gbtree boosters are supported, found " << booster["name"].GetString();
+  }
+  const auto& model = booster["model"];
+  const auto& trees = model["trees"].GetArray();
+  const auto& treeInfo = model["tree_info"].GetArray();
+
+  mFeature.clear();
+  mThreshold.clear();
+  mLeft.clear();
+  mRight.clear();
+  mDefaultLeft.clear();
+  mTreeRoots.clear();
+  mTreeGroups.clear();
+
+  for (rapidjson::SizeType iTree{0}; iTree < trees.Size(); ++iTree) {
+    const auto& tree = trees[iTree];
+    const auto& leftChildren = tree["left_children"].GetArray();
+    const auto& rightChildren = tree["right_children"].GetArray();
+    const auto& splitIndices = tree["split_indices"].GetArray();
+    const auto& splitConditions = tree["split_conditions"].GetArray();
+    const auto& defaultLeft = tree["default_left"].GetArray();
+
+    const int32_t offset = mFeature.size();
+    mTreeRoots.push_back(offset);
+    mTreeGroups.push_back(mNGroups > 1 ? treeInfo[iTree].GetInt() : 0);
+    for (rapidjson::SizeType iNode{0}; iNode < leftChildren.Size(); ++iNode) {
+      const int32_t left = leftChildren[iNode].GetInt();
+      const bool isLeaf = (left == -1);
+      mFeature.push_back(isLeaf ? -1 : splitIndices[iNode].GetInt());
+      mThreshold.push_back(splitConditions[iNode].GetFloat());
+      mLeft.push_back(isLeaf ? -1 : offset + left);
+      mRight.push_back(isLeaf ? -1 : offset + rightChildren[iNode].GetInt());
+      mDefaultLeft.push_back(parseFlag(defaultLeft[iNode]));
+    }
+  }
+
+  LOG(info) << "Objective: " << objective << ", number of trees: " << mTreeRoots.size() << ", number of nodes: " << mFeature.size();
+  LOG(info) << "Input features: " << mNFeatures << ", output nodes: " << mNOutputs;
+
+  validFrom = from;
+  validUntil = until;
+
+  LOG(info) << "Model validity - From: " << validFrom << ", Until: " << validUntil;
+
+  LOG(info) << "--- Model initialized! ---";
+}
+
+} // namespace ml
+
+} // namespace o2
@@ -0,0 +1,183 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file     treeModel.h
+///
+/// \brief    Native evaluator of gradient-boosted tree ensembles (XGBoost JSON models), without ONNX runtime
+///
+
+#ifndef TOOLS_ML_TREEMODEL_H_
+#define TOOLS_ML_TREEMODEL_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace o2
+{
+
+namespace ml
+{
+
+class TreeEnsembleModel
+{
+
+ public:
+  TreeEnsembleModel() = default;
+  ~TreeEnsembleModel() = default;
+
+  /// Load the tree ensemble from a XGBoost JSON model file (Booster.save_model("model.json"))
+  void initModel(std::string, bool = false, int = 0, uint64_t = 0, uint64_t = 0);
+
+  /// Inference for one or more candidates (row-major features)
+  /// \return pointer to the output of the first candidate, valid until the next call
+  template <typename T>
+  T* evalModel(std::vector<T>& input)
+  {
+    static_assert(std::is_same_v<T, float>, "TreeEnsembleModel outputs single-precision scores");
+    assert(input.size() % mNFeatures == 0);
+    const std::size_t nRows = input.size() / mNFeatures;
+    mOutput.resize(nRows * mNOutputs);
+    evalModelBatch(input.data(), nRows, mOutput.data());
+    return mOutput.data();
+  }
+
+  /// Batched inference on a contiguous, row-major feature matrix
+  /// \param input pointer to nRows x getNumInputNodes() feature values
+  /// \param nRows number of rows (e.g. candidates) in the batch
+  /// \param output pre-allocated buffer of nRows x getNumOutputNodesLast() values
+  /// \return true if the inference succeeded
+  template <typename T>
+  bool evalModelBatch(const T* input, std::size_t nRows, T* output)
+  {
+    mMargins.assign(nRows * mNGroups, mBaseMargin);
+    // loop over trees outside, so that the nodes of one tree stay in cache for the whole batch
+    for (std::size_t iTree{0}; iTree < mTreeRoots.size(); ++iTree) {
+      const int32_t root = mTreeRoots[iTree];
+      const int32_t group = mTreeGroups[iTree];
+      for (std::size_t iRow{0}; iRow < nRows; ++iRow) {
+        const T* features = input + iRow * mNFeatures;
+        int32_t node = root;
+        while (mFeature[node] >= 0) {
+          const float value = features[mFeature[node]];
+          if (std::isnan(value)) {
+            node = mDefaultLeft[node] ? mLeft[node] : mRight[node];
+          } else {
+            node = value < mThreshold[node] ? mLeft[node] : mRight[node];
+          }
+        }
+        mMargins[iRow * mNGroups + group] += mThreshold[node];
+      }
+    }
+    for (std::size_t iRow{0}; iRow < nRows; ++iRow) {
+      transformOutput(mMargins.data() + iRow * mNGroups, output + iRow * mNOutputs);
+    }
+    return true;
+  }
+
+  template <typename T>
+  bool evalModelBatch(std::vector<T>& input, std::vector<T>& output)
+  {
+    assert(input.size() % mNFeatures == 0);
+    const std::size_t nRows = input.size() / mNFeatures;
+    output.resize(nRows * mNOutputs);
+    return evalModelBatch(input.data(), nRows, output.data());
+  }
+
+  // Getters
+  int getNumInputNodes() const { return mNFeatures; }
+  int getNumOutputNodes() const { return mNOutputs; }
+  int getNumOutputNodesLast() const { return mNOutputs; }
+  std::size_t getNumTrees() const { return mTreeRoots.size(); }
+  uint64_t getValidityFrom() const { return validFrom; }
+  uint64_t getValidityUntil() const { return validUntil; }
+
+ private:
+  enum class Objective : uint8_t {
+    Logistic = 0, // binary classification, output (1 - p, p) as the ONNX probability output
+    Softmax,      // multi-class classification, output the class probabilities
+    Raw           // regression or raw margins, output the margins
+  };
+
+  // Flat node arrays of all the trees, a leaf has mFeature = -1 and its value in mThreshold
+  std::vector<int32_t> mFeature;
+  std::vector<float> mThreshold;
+  std::vector<int32_t> mLeft;
+  std::vector<int32_t> mRight;
+  std::vector<uint8_t> mDefaultLeft;
+  std::vector<int32_t> mTreeRoots;  // index of the root node of each tree
+  std::vector<int32_t> mTreeGroups; // output group (class) of each tree
+
+  Objective mObjective = Objective::Raw;
+  int mNFeatures = 0;
+  int mNGroups = 1;
+  int mNOutputs = 1;
+  float mBaseMargin = 0.f;
+
+  // Buffers reused across calls
+  std::vector<float> mMargins;
+  std::vector<float> mOutput;
+
+  std::string modelPath;
+  uint64_t validFrom = 0;
+  uint64_t validUntil = 0;
+
+  template <typename T>
+  void transformOutput(const float* margins, T* output) const
+  {
+    switch (mObjective) {
+      case Objective::Logistic: {
+        const float prob = 1.f / (1.f + std::exp(-margins[0]));
+        output[0] = 1.f - prob;
+        output[1] = prob;
+        break;
+      }
+      case Objective::Softmax: {
+        float maxMargin = margins[0];
+        for (int iGroup{1}; iGroup < mNGroups; ++iGroup) {
+          maxMargin = std::max(maxMargin, margins[iGroup]);
+        }
+        float sum{0.f};
+        for (int iGroup{0}; iGroup < mNGroups; ++iGroup) {
+          output[iGroup] = std::exp(margins[iGroup] - maxMargin);
+          sum += output[iGroup];
+        }
+        for (int iGroup{0}; iGroup < mNGroups; ++iGroup) {
+          output[iGroup] /= sum;
+        }
+        break;
+      }
+      default: {
+        for (int iGroup{0}; iGroup < mNGroups; ++iGroup) {
+          output[iGroup] = margins[iGroup];
+        }
+      }
+    }
+  }
+};
+
+/// Check whether a model file has to be evaluated with TreeEnsembleModel instead of OnnxModel
+inline bool isTreeModelFile(const std::string& path)
+{
+  const std::string extension = ".json";
+  return path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+} // namespace ml
+
+} // namespace o2
+
+#endif // TOOLS_ML_TREEMODEL_H_
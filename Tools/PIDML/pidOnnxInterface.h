@@ -18,6 +18,7 @@
 #define TOOLS_PIDML_PIDONNXINTERFACE_H_
 
 #include <string>
+#include <algorithm>
 #include <array>
 #include <set>
 #include <vector>
@@ -72,6 +73,19 @@ struct PidONNXInterface {
         mModels.emplace_back(localPath, ccdbPath, useCCDB, ccdbApi, timestamp, pids[i], (PidMLDetector)(kTPCOnly + j), minCertaintiesFilled[i]);
       }
     }
+    // the models with the same detectors and scaling parameters share the input vector in applyModels
+    mInputGroups.resize(mModels.size());
+    for (std::size_t i = 0; i < mModels.size(); i++) {
+      mInputGroups[i] = i;
+      for (std::size_t j = 0; j < i; j++) {
+        if (mModels[j].hasSameInputs(mModels[i])) {
+          mInputGroups[i] = mInputGroups[j];
+          break;
+        }
+      }
+    }
+    mInputs.resize(mModels.size());
+    mInputsBuilt.resize(mModels.size());
   }
   PidONNXInterface() = default;
   PidONNXInterface(PidONNXInterface&&) = default;
@@ -80,6 +94,41 @@ struct PidONNXInterface {
   PidONNXInterface& operator=(const PidONNXInterface&) = delete;
   ~PidONNXInterface() = default;
 
+  /// Certainties of all the output pids for a track, in the order of the pids of the constructor
+  /// The input vector is built once for all the models with the same inputs, -1 for a pid without model at the track pT
+  template <typename T>
+  void applyModels(const T& track, std::vector<float>& certainties)
+  {
+    certainties.resize(mNPids);
+    std::fill(mInputsBuilt.begin(), mInputsBuilt.end(), false);
+    for (std::size_t i = 0; i < mNPids; i++) {
+      const int model = findModel(i, track.pt());
+      if (model < 0) {
+        LOG(error) << "No suitable PID ML model found for track: " << track.globalIndex() << " from collision: " << track.collision().globalIndex() << " and expected pid: " << mModels[i * kNDetectors].mPid;
+        certainties[i] = -1.0f;
+        continue;
+      }
+      const std::size_t group = mInputGroups[model];
+      if (!mInputsBuilt[group]) {
+        mModels[group].createInputs(track, mInputs[group]);
+        mInputsBuilt[group] = true;
+      }
+      certainties[i] = mModels[model].applyModelToInputs(mInputs[group]);
+    }
+  }
+
+  /// Decisions of all the output pids for a track, in the order of the pids of the constructor
+  template <typename T>
+  void applyModelsBoolean(const T& track, std::vector<bool>& accepted)
+  {
+    applyModels(track, mCertainties);
+    accepted.resize(mNPids);
+    for (std::size_t i = 0; i < mNPids; i++) {
+      const int model = findModel(i, track.pt());
+      accepted[i] = model >= 0 && mCertainties[i] >= mModels[model].mMinCertainty;
+    }
+  }
+
   template <typename T>
   float applyModel(const T& track, int pid)
   {
@@ -113,6 +162,17 @@ struct PidONNXInterface {
   }
 
  private:
+  // model of the output pid i for a pT, -1 if none
+  int findModel(std::size_t i, float pt)
+  {
+    for (uint32_t j = 0; j < kNDetectors; j++) {
+      if (pt >= mPTLimits[i][j] && (j == kNDetectors - 1 || pt < mPTLimits[i][j + 1])) {
+        return i * kNDetectors + j;
+      }
+    }
+    return -1;
+  }
+
   void fillDefaultConfiguration(std::vector<double>& minCertainties)
   {
     // FIXME: A more sophisticated strategy should be based on pid values as well
@@ -121,7 +181,11 @@ struct PidONNXInterface {
   }
 
   std::vector<PidONNXModel> mModels;
-  std::size_t mNPids;
+  std::size_t mNPids = 0;
   o2::framework::LabeledArray<double> mPTLimits;
+  std::vector<std::size_t> mInputGroups; // first model with the same inputs, per model
+  std::vector<std::vector<float>> mInputs; // input vector of the current track, per input group
+  std::vector<bool> mInputsBuilt;
+  std::vector<float> mCertainties;
 };
 #endif // TOOLS_PIDML_PIDONNXINTERFACE_H_
@@ -33,6 +33,7 @@
 #include "rapidjson/filereadstream.h"
 
 #include "CCDB/CcdbApi.h"
+#include "Tools/ML/sessionRegistry.h"
 
 enum PidMLDetector {
   kTPCOnly = 0,
@@ -68,14 +69,10 @@ struct PidONNXModel {
     std::string modelFile;
     loadInputFiles(localPath, ccdbPath, useCCDB, ccdbApi, timestamp, pid, modelFile);
 
-    Ort::SessionOptions sessionOptions;
-    mEnv = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "pid-onnx-inferer");
+    // environment and session are shared with the other models of the process
+    mEnv = o2::ml::OnnxSessionRegistry::instance().getEnv();
     LOG(info) << "Loading ONNX model from file: " << modelFile;
-#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-    mSession.reset(new Ort::Experimental::Session{*mEnv, modelFile, sessionOptions});
-#else
-    mSession.reset(new Ort::Session{*mEnv, modelFile.c_str(), sessionOptions});
-#endif
+    mSession = o2::ml::OnnxSessionRegistry::instance().getSession(modelFile, false, 0, mValidFrom, mValidUntil);
     LOG(info) << "ONNX model loaded";
 
 #if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
@@ -131,6 +128,51 @@ struct PidONNXModel {
     return getModelOutput(track) >= mMinCertainty;
   }
 
+  /// Certainty for an input vector built by createInputs, e.g. shared by the models with the same inputs
+  float applyModelToInputs(std::vector<float>& inputValues)
+  {
+    return getModelOutputFromInputs(inputValues);
+  }
+
+  /// Fills the input vector of the model for a track, the existing content is replaced
+  template <typename T>
+  void createInputs(const T& track, std::vector<float>& inputValues) const
+  {
+    // TODO: Hardcoded for now. Planning to implement RowView extension to get runtime access to selected columns
+    // sign is short, trackType and tpcNClsShared uint8_t
+    float scaledX = (track.x() - mScalingParams.at("fX").first) / mScalingParams.at("fX").second;
+    float scaledY = (track.y() - mScalingParams.at("fY").first) / mScalingParams.at("fY").second;
+    float scaledZ = (track.z() - mScalingParams.at("fZ").first) / mScalingParams.at("fZ").second;
+    float scaledAlpha = (track.alpha() - mScalingParams.at("fAlpha").first) / mScalingParams.at("fAlpha").second;
+    float scaledTPCNClsShared = (static_cast<float>(track.tpcNClsShared()) - mScalingParams.at("fTPCNClsShared").first) / mScalingParams.at("fTPCNClsShared").second;
+    float scaledDcaXY = (track.dcaXY() - mScalingParams.at("fDcaXY").first) / mScalingParams.at("fDcaXY").second;
+    float scaledDcaZ = (track.dcaZ() - mScalingParams.at("fDcaZ").first) / mScalingParams.at("fDcaZ").second;
+
+    float scaledTPCSignal = (track.tpcSignal() - mScalingParams.at("fTPCSignal").first) / mScalingParams.at("fTPCSignal").second;
+
+    inputValues.assign({track.px(), track.py(), track.pz(), static_cast<float>(track.sign()), scaledX, scaledY, scaledZ, scaledAlpha, static_cast<float>(track.trackType()), scaledTPCNClsShared, scaledDcaXY, scaledDcaZ, track.p(), scaledTPCSignal});
+
+    if (mDetector >= kTPCTOF) {
+      float scaledTOFSignal = (track.tofSignal() - mScalingParams.at("fTOFSignal").first) / mScalingParams.at("fTOFSignal").second;
+      float scaledBeta = (track.beta() - mScalingParams.at("fBeta").first) / mScalingParams.at("fBeta").second;
+      inputValues.push_back(scaledTOFSignal);
+      inputValues.push_back(scaledBeta);
+    }
+
+    if (mDetector >= kTPCTOFTRD) {
+      float scaledTRDSignal = (track.trdSignal() - mScalingParams.at("fTRDSignal").first) / mScalingParams.at("fTRDSignal").second;
+      float scaledTRDPattern = (track.trdPattern() - mScalingParams.at("fTRDPattern").first) / mScalingParams.at("fTRDPattern").second;
+      inputValues.push_back(scaledTRDSignal);
+      inputValues.push_back(scaledTRDPattern);
+    }
+  }
+
+  /// Whether createInputs gives the same input vector for a track as for the other model
+  bool hasSameInputs(const PidONNXModel& other) const
+  {
+    return mDetector == other.mDetector && mTrainColumns == other.mTrainColumns && mScalingParams == other.mScalingParams;
+  }
+
   PidMLDetector mDetector;
   int mPid;
   double mMinCertainty;
@@ -159,10 +201,16 @@ struct PidONNXModel {
   void downloadFromCCDB(o2::ccdb::CcdbApi& ccdbApi, std::string const& ccdbFile, uint64_t timestamp, std::string const& localDir, std::string const& localFile)
   {
     std::map<std::string, std::string> metadata;
-    bool retrieveSuccess = ccdbApi.retrieveBlob(ccdbFile, localDir, metadata, timestamp, false, localFile);
+    o2::ml::OnnxModelFile downloadedFile;
+    bool retrieveSuccess = o2::ml::OnnxSessionRegistry::instance().retrieveModel(ccdbApi, ccdbFile, metadata, timestamp, localFile, downloadedFile, localDir);
     if (retrieveSuccess) {
-      std::map<std::string, std::string> headers = ccdbApi.retrieveHeaders(ccdbFile, metadata, timestamp);
-      LOG(info) << "Network file downloaded from: " << ccdbFile << " to: " << localDir << "/" << localFile;
+      if (downloadedFile.validFrom > mValidFrom) {
+        mValidFrom = downloadedFile.validFrom;
+      }
+      if (mValidUntil == 0 || downloadedFile.validUntil < mValidUntil) {
+        mValidUntil = downloadedFile.validUntil;
+      }
+      LOG(info) << "Network file downloaded from: " << ccdbFile << " to: " << downloadedFile.localPath;
     } else {
       LOG(fatal) << "Error encountered while fetching/loading the network from CCDB! Maybe the network doesn't exist yet for this run number/timestamp?";
     }
@@ -206,34 +254,8 @@ struct PidONNXModel {
   template <typename T>
   std::vector<float> createInputsSingle(const T& track)
   {
-    // TODO: Hardcoded for now. Planning to implement RowView extension to get runtime access to selected columns
-    // sign is short, trackType and tpcNClsShared uint8_t
-    float scaledX = (track.x() - mScalingParams.at("fX").first) / mScalingParams.at("fX").second;
-    float scaledY = (track.y() - mScalingParams.at("fY").first) / mScalingParams.at("fY").second;
-    float scaledZ = (track.z() - mScalingParams.at("fZ").first) / mScalingParams.at("fZ").second;
-    float scaledAlpha = (track.alpha() - mScalingParams.at("fAlpha").first) / mScalingParams.at("fAlpha").second;
-    float scaledTPCNClsShared = (static_cast<float>(track.tpcNClsShared()) - mScalingParams.at("fTPCNClsShared").first) / mScalingParams.at("fTPCNClsShared").second;
-    float scaledDcaXY = (track.dcaXY() - mScalingParams.at("fDcaXY").first) / mScalingParams.at("fDcaXY").second;
-    float scaledDcaZ = (track.dcaZ() - mScalingParams.at("fDcaZ").first) / mScalingParams.at("fDcaZ").second;
-
-    float scaledTPCSignal = (track.tpcSignal() - mScalingParams.at("fTPCSignal").first) / mScalingParams.at("fTPCSignal").second;
-
-    std::vector<float> inputValues{track.px(), track.py(), track.pz(), static_cast<float>(track.sign()), scaledX, scaledY, scaledZ, scaledAlpha, static_cast<float>(track.trackType()), scaledTPCNClsShared, scaledDcaXY, scaledDcaZ, track.p(), scaledTPCSignal};
-
-    if (mDetector >= kTPCTOF) {
-      float scaledTOFSignal = (track.tofSignal() - mScalingParams.at("fTOFSignal").first) / mScalingParams.at("fTOFSignal").second;
-      float scaledBeta = (track.beta() - mScalingParams.at("fBeta").first) / mScalingParams.at("fBeta").second;
-      inputValues.push_back(scaledTOFSignal);
-      inputValues.push_back(scaledBeta);
-    }
-
-    if (mDetector >= kTPCTOFTRD) {
-      float scaledTRDSignal = (track.trdSignal() - mScalingParams.at("fTRDSignal").first) / mScalingParams.at("fTRDSignal").second;
-      float scaledTRDPattern = (track.trdPattern() - mScalingParams.at("fTRDPattern").first) / mScalingParams.at("fTRDPattern").second;
-      inputValues.push_back(scaledTRDSignal);
-      inputValues.push_back(scaledTRDPattern);
-    }
-
+    std::vector<float> inputValues;
+    createInputs(track, inputValues);
     return inputValues;
   }
 
@@ -247,8 +269,13 @@ struct PidONNXModel {
   template <typename T>
   float getModelOutput(const T& track)
   {
-    auto input_shape = mInputShapes[0];
     std::vector<float> inputTensorValues = createInputsSingle(track);
+    return getModelOutputFromInputs(inputTensorValues);
+  }
+
+  float getModelOutputFromInputs(std::vector<float>& inputTensorValues)
+  {
+    auto input_shape = mInputShapes[0];
     std::vector<Ort::Value> inputTensors;
 #if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
     inputTensors.emplace_back(Ort::Experimental::Value::CreateTensor<float>(inputTensorValues.data(), inputTensorValues.size(), input_shape));
@@ -308,11 +335,9 @@ struct PidONNXModel {
 
   std::shared_ptr<Ort::Env> mEnv = nullptr;
   // No empty constructors for Session, we need a pointer
-#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-  std::shared_ptr<Ort::Experimental::Session> mSession = nullptr;
-#else
-  std::shared_ptr<Ort::Session> mSession = nullptr;
-#endif
+  std::shared_ptr<o2::ml::OnnxSession> mSession = nullptr;
+  uint64_t mValidFrom = 0;  // start of the validity of the downloaded files
+  uint64_t mValidUntil = 0; // end of the validity of the downloaded files
 
   std::vector<std::string> mInputNames;
   std::vector<std::vector<int64_t>> mInputShapes;
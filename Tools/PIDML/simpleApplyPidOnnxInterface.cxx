@@ -22,6 +22,7 @@
 #include "Tools/PIDML/pidOnnxInterface.h"
 
 #include <string>
+#include <vector>
 
 using namespace o2;
 using namespace o2::framework;
@@ -56,6 +57,7 @@ struct SimpleApplyOnnxInterface {
 
   o2::ccdb::CcdbApi ccdbApi;
   int currentRunNumber = -1;
+  std::vector<bool> accepted; // decisions per pid of the current track
 
   Produces<o2::aod::MlPidResults> pidMLResults;
 
@@ -83,11 +85,13 @@ struct SimpleApplyOnnxInterface {
     }
 
     for (auto& track : tracks) {
-      for (int pid : cfgPids.value) {
-        bool accepted = pidInterface.applyModelBoolean(track, pid);
+      // all the pids in one go, the inputs of the models are built once per track
+      pidInterface.applyModelsBoolean(track, accepted);
+      for (std::size_t i = 0; i < cfgPids.value.size(); i++) {
+        int pid = cfgPids.value[i];
         LOGF(info, "collision id: %d track id: %d pid: %d accepted: %d p: %.3f; x: %.3f, y: %.3f, z: %.3f",
-             track.collisionId(), track.index(), pid, accepted, track.p(), track.x(), track.y(), track.z());
-        pidMLResults(track.index(), pid, accepted);
+             track.collisionId(), track.index(), pid, static_cast<bool>(accepted[i]), track.p(), track.x(), track.y(), track.z());
+        pidMLResults(track.index(), pid, accepted[i]);
       }
     }
   }
@@ -96,11 +100,13 @@ struct SimpleApplyOnnxInterface {
   void processTracksOnly(BigTracks const& tracks)
   {
     for (auto& track : tracks) {
-      for (int pid : cfgPids.value) {
-        bool accepted = pidInterface.applyModelBoolean(track, pid);
+      // all the pids in one go, the inputs of the models are built once per track
+      pidInterface.applyModelsBoolean(track, accepted);
+      for (std::size_t i = 0; i < cfgPids.value.size(); i++) {
+        int pid = cfgPids.value[i];
         LOGF(info, "collision id: %d track id: %d pid: %d accepted: %d p: %.3f; x: %.3f, y: %.3f, z: %.3f",
-             track.collisionId(), track.index(), pid, accepted, track.p(), track.x(), track.y(), track.z());
-        pidMLResults(track.index(), pid, accepted);
+             track.collisionId(), track.index(), pid, static_cast<bool>(accepted[i]), track.p(), track.x(), track.y(), track.z());
+        pidMLResults(track.index(), pid, accepted[i]);
       }
     }
   }
@@ -18,6 +18,7 @@
 #include "Common/DataModel/PIDResponse.h"
 #include "Common/DataModel/TrackSelectionTables.h"
 #include "Common/DataModel/EventSelection.h"
+#include "Common/Core/TableHelper.h"
 #include "MathUtils/Utils.h"
 #include "DataModel/LFDerived.h"
 
@@ -39,9 +40,9 @@ struct TPCSpectraProviderTask {
   Configurable<float> trackEtaCut{"trackEtaCut", 0.8f, "Eta range for tracks"};
   Configurable<float> trackPtCut{"trackPtCut", 0.5f, "Pt range for tracks"};
 
-  Configurable<bool> saveTracks{"saveTracks", false, "Save large LF tracks table"};
-  Configurable<bool> saveSmallTracks{"saveSmallTracks", false, "Save small LF tracks table"};
-  Configurable<bool> saveSingleTracks{"saveSingleTracks", false, "Save single species LF tracks table"};
+  Configurable<bool> saveTracks{"saveTracks", false, "Save large LF tracks table (also enabled if the table is required in the workflow)"};
+  Configurable<bool> saveSmallTracks{"saveSmallTracks", false, "Save small LF tracks table (also enabled if the table is required in the workflow)"};
+  Configurable<bool> saveSingleTracks{"saveSingleTracks", false, "Save single species LF tracks table (also enabled if the table is required in the workflow)"};
   Configurable<int> species1{"species1", 0, "First particle species to be kept"};
   Configurable<bool> species1NsigmaSelection{"species1NsigmaSelection", false, "select on species 1 Nsigma"};
   Configurable<float> species1NsigmaLow{"species1NsigmaLow", -3., "species 1 Nsigma Lower Bound"};
@@ -86,6 +87,18 @@ struct TPCSpectraProviderTask {
     }
   }
 
+  void init(InitContext& initContext)
+  {
+    // The three tables are projections of the same selected tracks with fewer and fewer columns:
+    // write each of them only if it is asked for or read downstream (by a task or by the AOD writer)
+    enableFlagIfTableRequired(initContext, "LFTracks", saveTracks);
+    enableFlagIfTableRequired(initContext, "LFSmallTracks", saveSmallTracks);
+    enableFlagIfTableRequired(initContext, "LFSingleTracks", saveSingleTracks);
+    if (!saveTracks && !saveSmallTracks && !saveSingleTracks) {
+      LOG(warning) << "No LF tracks table is saved nor required in the workflow";
+    }
+  }
+
   Filter collisionFilter = nabs(aod::collision::posZ) < vertexZCut;
   Filter trackFilter = (nabs(aod::track::eta) < trackEtaCut) && (aod::track::pt > trackPtCut) && (requireGlobalTrackInFilter());
 